@@ -24,6 +24,7 @@ application.
 #include <esp_matter_client.h>
 #include <esp_matter_cluster.h>
 #include <esp_matter_command.h>
+#include <esp_matter_composition.h>
 #include <esp_matter_core.h>
 #include <esp_matter_endpoint.h>
 #include <esp_matter_event.h>
@@ -88,6 +89,16 @@ typedef enum attribute_flags {
      will not be written to flash immediately. A timer will be started and the attribute value will be written after
      timeout. */
     ATTRIBUTE_FLAG_DEFERRED = ATTRIBUTE_FLAG_NULLABLE << 2, /* 0x200 */
+    /** The reports of the attribute are never held by the ICD report batching
+     (CONFIG_ESP_MATTER_ICD_REPORT_BATCHING), nor rate limited by the min interval of the reporting policy, a change
+     is reported right away with the held ones. Set with `attribute::set_report_priority()`. */
+    ATTRIBUTE_FLAG_URGENT_REPORT = ATTRIBUTE_FLAG_NULLABLE << 3, /* 0x400 */
+    /** The string or array value points to immutable memory, such as rodata or a memory mapped flash partition, and
+     is not copied to the heap. Set with `attribute::set_const_val()`, it is cleared when another value is set. */
+    ATTRIBUTE_FLAG_CONST_VAL = ATTRIBUTE_FLAG_NULLABLE << 4, /* 0x800 */
+    /** The reports of the attribute are bulk telemetry, deferred and coalesced with the other bulk reports
+     (CONFIG_ESP_MATTER_ENABLE_REPORT_PRIORITY). Set with `attribute::set_report_priority()`. */
+    ATTRIBUTE_FLAG_BULK_REPORT = ATTRIBUTE_FLAG_NULLABLE << 5, /* 0x1000 */
 } attribute_flags_t;
 
 /** Command flags */
@@ -16,6 +16,8 @@
 #include <esp_matter_attribute.h>
 #include <esp_matter.h>
 #include <esp_matter_core.h>
+#include <inttypes.h>
+#include <string.h>
 
 static const char *TAG = "esp_matter_attribute";
 
@@ -24,6 +26,83 @@ using namespace chip::app::Clusters;
 namespace esp_matter {
 namespace cluster {
 
+static size_t get_desc_value_size(uint8_t type)
+{
+    switch (type >= ESP_MATTER_VAL_NULLABLE_BASE ? type - ESP_MATTER_VAL_NULLABLE_BASE : type) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+        return sizeof(uint8_t);
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+        return sizeof(uint16_t);
+    case ESP_MATTER_VAL_TYPE_INT32:
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+        return sizeof(uint32_t);
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_UINT64:
+        return sizeof(uint64_t);
+    default:
+        return 0;
+    }
+}
+
+/* The values of the union all start at its beginning, the value of any scalar type is its first bytes */
+static esp_matter_attr_val_t get_desc_val(uint8_t type, size_t size, int64_t value)
+{
+    esp_matter_attr_val_t val = esp_matter_invalid(NULL);
+    val.type = (esp_matter_val_type_t)type;
+    if (size == sizeof(uint8_t)) {
+        val.val.u8 = (uint8_t)value;
+    } else if (size == sizeof(uint16_t)) {
+        val.val.u16 = (uint16_t)value;
+    } else if (size == sizeof(uint32_t)) {
+        val.val.u32 = (uint32_t)value;
+    } else {
+        val.val.i64 = value;
+    }
+    return val;
+}
+
+esp_err_t create_attributes(cluster_t *cluster, const attribute_desc_t *attributes, size_t count, const void *config)
+{
+    if (!cluster || (!attributes && count > 0)) {
+        ESP_LOGE(TAG, "Cluster and attributes cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_OK;
+    for (size_t idx = 0; idx < count; ++idx) {
+        const attribute_desc_t &desc = attributes[idx];
+        size_t size = get_desc_value_size(desc.type);
+        if (size == 0 || (desc.config_offset != k_attribute_desc_no_config && !config)) {
+            ESP_LOGE(TAG, "Cannot create attribute 0x%08" PRIx32 " from its descriptor", desc.id);
+            err = ESP_ERR_INVALID_ARG;
+            continue;
+        }
+        esp_matter_attr_val_t val = get_desc_val(desc.type, size, desc.value);
+        if (desc.config_offset != k_attribute_desc_no_config) {
+            memcpy(&val.val, static_cast<const uint8_t *>(config) + desc.config_offset, size);
+        }
+        attribute_t *attribute = esp_matter::attribute::create(cluster, desc.id, desc.flags, val);
+        if (!attribute) {
+            ESP_LOGE(TAG, "Could not create attribute 0x%08" PRIx32, desc.id);
+            err = ESP_FAIL;
+            continue;
+        }
+        if (desc.bounds) {
+            esp_matter::attribute::add_bounds(attribute, get_desc_val(desc.type, size, desc.bounds->min),
+                                              get_desc_val(desc.type, size, desc.bounds->max));
+        }
+    }
+    return err;
+}
+
 namespace global {
 namespace attribute {
 
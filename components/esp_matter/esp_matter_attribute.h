@@ -16,9 +16,101 @@
 
 #include <esp_matter_core.h>
 
+#include <stddef.h>
+#include <type_traits>
+
 namespace esp_matter {
 namespace cluster {
 
+/** Bounds of an attribute descriptor, in the type of the attribute */
+typedef struct {
+    int64_t min;
+    int64_t max;
+} attribute_desc_bounds_t;
+
+/** Descriptor of a scalar attribute created by create_attributes()
+ *
+ * The value of the attribute is read at config_offset from the config struct of the cluster or feature, or is the
+ * value of the descriptor if config_offset is k_attribute_desc_no_config. Use the ESP_MATTER_ATTRIBUTE_DESC_CONFIG()
+ * and ESP_MATTER_ATTRIBUTE_DESC_VALUE() macros, the tables can then be const and stay in the flash.
+ */
+typedef struct {
+    uint32_t id;
+    uint16_t flags;
+    /** esp_matter_val_type_t of the attribute */
+    uint8_t type;
+    uint16_t config_offset;
+    int64_t value;
+    /** Bounds of the attribute, NULL for none */
+    const attribute_desc_bounds_t *bounds;
+} attribute_desc_t;
+
+constexpr uint16_t k_attribute_desc_no_config = UINT16_MAX;
+
+/** Type of the config field of each value type, so a descriptor cannot read a field of another size */
+template <esp_matter_val_type_t type> struct attribute_desc_field;
+#define ESP_MATTER_ATTRIBUTE_DESC_FIELD(val_type, field_type) \
+    template <> struct attribute_desc_field<val_type> { typedef field_type type; }; \
+    template <> struct attribute_desc_field<(esp_matter_val_type_t)(val_type + ESP_MATTER_VAL_NULLABLE_BASE)> { \
+        typedef nullable<field_type> type; \
+    };
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_BOOLEAN, bool)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_FLOAT, float)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_INT8, int8_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_UINT8, uint8_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_INT16, int16_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_UINT16, uint16_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_INT32, int32_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_UINT32, uint32_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_INT64, int64_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_UINT64, uint64_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_ENUM8, uint8_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_BITMAP8, uint8_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_BITMAP16, uint16_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_BITMAP32, uint32_t)
+ESP_MATTER_ATTRIBUTE_DESC_FIELD(ESP_MATTER_VAL_TYPE_ENUM16, uint16_t)
+#undef ESP_MATTER_ATTRIBUTE_DESC_FIELD
+
+template <typename field_t, esp_matter_val_type_t type>
+constexpr uint16_t attribute_desc_offset(size_t offset)
+{
+    static_assert(std::is_same<field_t, typename attribute_desc_field<type>::type>::value,
+                  "The config field does not match the type of the attribute");
+    return static_cast<uint16_t>(offset);
+}
+
+/** Descriptor of an attribute whose value is the field of a config struct */
+#define ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_type, field, attribute_id, attribute_flags, val_type, bounds) \
+    { attribute_id, (uint16_t)(attribute_flags), (uint8_t)(val_type), \
+      esp_matter::cluster::attribute_desc_offset<decltype(config_type::field), val_type>(offsetof(config_type, field)), \
+      0, bounds }
+
+/** Descriptor of an attribute with a fixed initial value */
+#define ESP_MATTER_ATTRIBUTE_DESC_VALUE(attribute_id, attribute_flags, val_type, initial_value, bounds) \
+    { attribute_id, (uint16_t)(attribute_flags), (uint8_t)(val_type), esp_matter::cluster::k_attribute_desc_no_config, \
+      initial_value, bounds }
+
+/** Create the attributes of a descriptor table
+ *
+ * The attributes are created in the order of the table, as the specific attribute create APIs below would. An
+ * attribute which cannot be created is skipped.
+ *
+ * @param[in] cluster Cluster handle.
+ * @param[in] attributes Descriptors of the attributes.
+ * @param[in] count Number of descriptors.
+ * @param[in] config Config struct the descriptors with a config offset are read from, may be NULL if none has one.
+ *
+ * @return ESP_OK on success.
+ * @return error if some attribute could not be created.
+ */
+esp_err_t create_attributes(cluster_t *cluster, const attribute_desc_t *attributes, size_t count, const void *config);
+
+template <size_t count>
+esp_err_t create_attributes(cluster_t *cluster, const attribute_desc_t (&attributes)[count], const void *config)
+{
+    return create_attributes(cluster, attributes, count, config);
+}
+
 /** Specific attribute create APIs
  *
  * If some standard attribute is not present here, it can be added.
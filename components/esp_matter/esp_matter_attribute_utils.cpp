@@ -17,9 +17,22 @@
 #include <esp_matter_attribute_utils.h>
 #include <esp_matter_console.h>
 #include <esp_matter_core.h>
+#include <esp_matter_e2e_latency.h>
+#include <esp_matter_encode_cache.h>
+#include <esp_matter_callback_offload.h>
+#include <esp_matter_callback_watchdog.h>
+#include <esp_matter_icd_report_batching.h>
+#include <esp_matter_lazy_plugin_init.h>
+#include <esp_matter_report_priority.h>
 #include <esp_matter_mem.h>
+#include <esp_matter_trace.h>
 #include <string.h>
 
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/timers.h>
+
+#include <app-common/zap-generated/ids/Clusters.h>
 #include <app/util/attribute-storage.h>
 #include <app/reporting/reporting.h>
 #include <protocols/interaction_model/Constants.h>
@@ -519,6 +532,10 @@ namespace attribute {
 
 static esp_matter_val_type_t get_val_type_from_attribute_type(int attribute_type);
 static callback_t attribute_callback = NULL;
+#if CONFIG_ESP_MATTER_ENABLE_REPORTING_POLICY
+extern void quantize_reported_val(attribute_t *attribute, esp_matter_attr_val_t *val);
+extern bool should_report(attribute_t *attribute, const esp_matter_attr_val_t *val);
+#endif
 #if CONFIG_ENABLE_CHIP_SHELL
 static esp_matter::console::engine attribute_console;
 
@@ -998,11 +1015,185 @@ esp_err_t set_callback(callback_t callback)
     return ESP_OK;
 }
 
+/* Registered path callbacks, in a chained hash table keyed on the path with the wildcards kept as is. A change is
+ * looked up once for each combination of exact and wildcard ids which has registrations. */
+typedef struct path_callback_entry {
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint16_t endpoint_id;
+    path_callback_t callback;
+    void *ctx;
+    struct path_callback_entry *next;
+} path_callback_entry_t;
+
+constexpr uint32_t k_path_callback_initial_bucket_count = 16;
+constexpr uint8_t k_wildcard_endpoint = 0x1;
+constexpr uint8_t k_wildcard_cluster = 0x2;
+constexpr uint8_t k_wildcard_attribute = 0x4;
+
+static path_callback_entry_t **s_path_callback_buckets = NULL;
+static uint32_t s_path_callback_bucket_count = 0;
+static uint32_t s_path_callback_count = 0;
+/* Number of registrations for each combination of wildcards, indexed by the k_wildcard_* bits */
+static uint16_t s_path_callback_pattern_counts[8] = {0};
+
+static uint8_t get_wildcard_pattern(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    return (endpoint_id == ESP_MATTER_WILDCARD_ENDPOINT_ID ? k_wildcard_endpoint : 0) |
+           (cluster_id == ESP_MATTER_WILDCARD_CLUSTER_ID ? k_wildcard_cluster : 0) |
+           (attribute_id == ESP_MATTER_WILDCARD_ATTRIBUTE_ID ? k_wildcard_attribute : 0);
+}
+
+static uint32_t get_path_hash(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    uint32_t h = endpoint_id;
+    h ^= cluster_id * 0x9E3779B1u;
+    h ^= attribute_id * 0x85EBCA77u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    return h;
+}
+
+static esp_err_t resize_path_callbacks(uint32_t new_bucket_count)
+{
+    path_callback_entry_t **new_buckets = (path_callback_entry_t **)esp_matter_mem_calloc(new_bucket_count,
+                                                                                        sizeof(path_callback_entry_t *));
+    if (!new_buckets) {
+        ESP_LOGE(TAG, "Couldn't allocate %" PRIu32 " path callback buckets", new_bucket_count);
+        return ESP_ERR_NO_MEM;
+    }
+    for (uint32_t index = 0; index < s_path_callback_bucket_count; index++) {
+        path_callback_entry_t *entry = s_path_callback_buckets[index];
+        while (entry) {
+            path_callback_entry_t *next = entry->next;
+            uint32_t bucket = get_path_hash(entry->endpoint_id, entry->cluster_id, entry->attribute_id) &
+                              (new_bucket_count - 1);
+            entry->next = new_buckets[bucket];
+            new_buckets[bucket] = entry;
+            entry = next;
+        }
+    }
+    if (s_path_callback_buckets) {
+        esp_matter_mem_free(s_path_callback_buckets);
+    }
+    s_path_callback_buckets = new_buckets;
+    s_path_callback_bucket_count = new_bucket_count;
+    return ESP_OK;
+}
+
+esp_err_t register_callback(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, path_callback_t callback,
+                            void *ctx)
+{
+    if (!callback) {
+        ESP_LOGE(TAG, "Callback cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Keep the chains short, there are at most two entries per bucket on average */
+    if (s_path_callback_count + 1 > s_path_callback_bucket_count * 2) {
+        uint32_t new_bucket_count = s_path_callback_bucket_count ? s_path_callback_bucket_count * 2 :
+                                    k_path_callback_initial_bucket_count;
+        esp_err_t err = resize_path_callbacks(new_bucket_count);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    path_callback_entry_t *entry = (path_callback_entry_t *)esp_matter_mem_calloc(1, sizeof(path_callback_entry_t));
+    if (!entry) {
+        ESP_LOGE(TAG, "Couldn't allocate path callback entry");
+        return ESP_ERR_NO_MEM;
+    }
+    entry->endpoint_id = endpoint_id;
+    entry->cluster_id = cluster_id;
+    entry->attribute_id = attribute_id;
+    entry->callback = callback;
+    entry->ctx = ctx;
+
+    /* Append, so that the callbacks registered for the same path are called in the registration order */
+    uint32_t bucket = get_path_hash(endpoint_id, cluster_id, attribute_id) & (s_path_callback_bucket_count - 1);
+    path_callback_entry_t **link = &s_path_callback_buckets[bucket];
+    while (*link) {
+        link = &(*link)->next;
+    }
+    *link = entry;
+    s_path_callback_count++;
+    s_path_callback_pattern_counts[get_wildcard_pattern(endpoint_id, cluster_id, attribute_id)]++;
+    return ESP_OK;
+}
+
+esp_err_t unregister_callback(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                              path_callback_t callback, void *ctx)
+{
+    if (!s_path_callback_buckets) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    uint32_t bucket = get_path_hash(endpoint_id, cluster_id, attribute_id) & (s_path_callback_bucket_count - 1);
+    path_callback_entry_t **link = &s_path_callback_buckets[bucket];
+    while (*link) {
+        path_callback_entry_t *entry = *link;
+        if (entry->endpoint_id == endpoint_id && entry->cluster_id == cluster_id &&
+            entry->attribute_id == attribute_id && entry->callback == callback && entry->ctx == ctx) {
+            *link = entry->next;
+            esp_matter_mem_free(entry);
+            s_path_callback_count--;
+            s_path_callback_pattern_counts[get_wildcard_pattern(endpoint_id, cluster_id, attribute_id)]--;
+            return ESP_OK;
+        }
+        link = &entry->next;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+static esp_err_t execute_path_callbacks(callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                                        uint32_t attribute_id, esp_matter_attr_val_t *val, void *priv_data)
+{
+    /* From the exact path to the full wildcard */
+    for (uint8_t pattern = 0; pattern < 8; pattern++) {
+        if (s_path_callback_pattern_counts[pattern] == 0) {
+            continue;
+        }
+        uint16_t key_endpoint_id = (pattern & k_wildcard_endpoint) ? ESP_MATTER_WILDCARD_ENDPOINT_ID : endpoint_id;
+        uint32_t key_cluster_id = (pattern & k_wildcard_cluster) ? ESP_MATTER_WILDCARD_CLUSTER_ID : cluster_id;
+        uint32_t key_attribute_id = (pattern & k_wildcard_attribute) ? ESP_MATTER_WILDCARD_ATTRIBUTE_ID : attribute_id;
+        uint32_t bucket = get_path_hash(key_endpoint_id, key_cluster_id, key_attribute_id) &
+                          (s_path_callback_bucket_count - 1);
+        for (path_callback_entry_t *entry = s_path_callback_buckets[bucket]; entry; entry = entry->next) {
+            if (entry->endpoint_id != key_endpoint_id || entry->cluster_id != key_cluster_id ||
+                entry->attribute_id != key_attribute_id) {
+                continue;
+            }
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+            callback_watchdog::scope watchdog(callback_watchdog::CALLBACK_KIND_ATTRIBUTE, (void *)entry->callback,
+                                              endpoint_id, cluster_id, attribute_id);
+#endif
+            esp_err_t err = entry->callback(type, endpoint_id, cluster_id, attribute_id, val, priv_data, entry->ctx);
+            if (err != ESP_OK && type == PRE_UPDATE) {
+                /* The update is rejected, the other callbacks are not called */
+                return err;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
 static esp_err_t execute_callback(callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
                                   uint32_t attribute_id, esp_matter_attr_val_t *val)
 {
+    if (!attribute_callback && s_path_callback_count == 0) {
+        return ESP_OK;
+    }
+    void *priv_data = endpoint::get_priv_data(endpoint_id);
+    if (s_path_callback_count > 0) {
+        esp_err_t err = execute_path_callbacks(type, endpoint_id, cluster_id, attribute_id, val, priv_data);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
     if (attribute_callback) {
-        void *priv_data = endpoint::get_priv_data(endpoint_id);
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+        callback_watchdog::scope watchdog(callback_watchdog::CALLBACK_KIND_ATTRIBUTE, (void *)attribute_callback,
+                                          endpoint_id, cluster_id, attribute_id);
+#endif
         return attribute_callback(type, endpoint_id, cluster_id, attribute_id, val, priv_data);
     }
     return ESP_OK;
@@ -1014,16 +1205,35 @@ static esp_err_t execute_override_callback(attribute_t *attribute, callback_type
     callback_t override_callback = attribute::get_override_callback(attribute);
     void *priv_data = endpoint::get_priv_data(endpoint_id);
     if (override_callback) {
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+        callback_watchdog::scope watchdog(callback_watchdog::CALLBACK_KIND_OVERRIDE, (void *)override_callback,
+                                          endpoint_id, cluster_id, attribute_id);
+#endif
         return override_callback(type, endpoint_id, cluster_id, attribute_id, val, priv_data);
     } else {
         ESP_LOGI(TAG, "Attribute override callback not set for Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32 ", calling the common callback",
                  endpoint_id, cluster_id, attribute_id);
-        if (attribute_callback)
+        if (attribute_callback) {
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+            callback_watchdog::scope watchdog(callback_watchdog::CALLBACK_KIND_ATTRIBUTE, (void *)attribute_callback,
+                                              endpoint_id, cluster_id, attribute_id);
+#endif
             return attribute_callback(type, endpoint_id, cluster_id, attribute_id, val, priv_data);
+        }
     }
     return ESP_OK;
 }
 
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
+/* Called by the scene recall handler around the recall of a scene */
+void execute_scene_recall_callback(callback_type_t type, uint16_t endpoint_id)
+{
+    esp_matter_attr_val_t val = esp_matter_invalid(NULL);
+    execute_callback(type, endpoint_id, chip::app::Clusters::ScenesManagement::Id, ESP_MATTER_WILDCARD_ATTRIBUTE_ID,
+                     &val);
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
+
 static esp_matter_val_type_t get_val_type_from_attribute_type(int attribute_type)
 {
     switch (attribute_type) {
@@ -1836,8 +2046,16 @@ static esp_err_t get_attr_val_from_data(esp_matter_attr_val_t *val, EmberAfAttri
     return ESP_OK;
 }
 
+static inline bool val_print_enabled()
+{
+    return LOG_LOCAL_LEVEL >= ESP_LOG_INFO && esp_log_level_get(TAG) >= ESP_LOG_INFO;
+}
+
 void val_print(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val, bool is_read)
 {
+    if (!val_print_enabled()) {
+        return;
+    }
     char action = (is_read) ? 'R' :'W';
     if (val_is_null(val)) {
         ESP_LOGI(TAG, "********** %c : Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32 " is null **********", action,
@@ -1895,6 +2113,83 @@ void val_print(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
     }
 }
 
+bool val_is_equal(const esp_matter_attr_val_t *val1, const esp_matter_attr_val_t *val2)
+{
+    if (!val1 || !val2 || val1->type != val2->type) {
+        return false;
+    }
+    size_t size = 0;
+    switch (val1->type) {
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+        if (val1->val.a.s != val2->val.a.s || val1->val.a.n != val2->val.a.n) {
+            return false;
+        }
+        if (val1->val.a.s == 0 || val1->val.a.b == val2->val.a.b) {
+            return true;
+        }
+        if (!val1->val.a.b || !val2->val.a.b) {
+            return false;
+        }
+        return memcmp(val1->val.a.b, val2->val.a.b, val1->val.a.s) == 0;
+
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT8:
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP8:
+        size = sizeof(uint8_t);
+        break;
+
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT16:
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP16:
+        size = sizeof(uint16_t);
+        break;
+
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INTEGER:
+        size = sizeof(int);
+        break;
+
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_FLOAT:
+    case ESP_MATTER_VAL_TYPE_INT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT32:
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP32:
+        size = sizeof(uint32_t);
+        break;
+
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT64:
+    case ESP_MATTER_VAL_TYPE_UINT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT64:
+        size = sizeof(uint64_t);
+        break;
+
+    default:
+        return false;
+    }
+    /* All the scalar members of the union start at the same address */
+    return memcmp(&val1->val, &val2->val, size) == 0;
+}
+
 esp_err_t get_val_raw(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, uint8_t *value,
                       uint16_t attribute_size)
 {
@@ -1918,61 +2213,53 @@ esp_err_t get_val_raw(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attrib
     return err;
 }
 
-esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
-{
-    /* Take lock if not already taken */
-    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
-    if (lock_status == lock::FAILED) {
-        ESP_LOGE(TAG, "Could not get task context");
-        return ESP_FAIL;
-    }
+/* Values up to this size are converted on the stack, larger ones (long strings, arrays) need a heap buffer */
+constexpr uint16_t k_update_scratch_size = 64;
 
+/* The caller holds the chip stack lock */
+static esp_err_t update_locked(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                               esp_matter_attr_val_t *val)
+{
     /* Get size */
     EmberAfAttributeType attribute_type = 0;
     uint16_t attribute_size = 0;
     get_data_from_attr_val(val, &attribute_type, &attribute_size, NULL);
 
     /* Get value */
-    uint8_t *value = (uint8_t *)esp_matter_mem_calloc(1, attribute_size);
-    if (!value) {
-        ESP_LOGE(TAG, "Could not allocate value buffer");
-        if (lock_status == lock::SUCCESS) {
-            lock::chip_stack_unlock();
+    uint8_t scratch[k_update_scratch_size];
+    uint8_t *value = scratch;
+    if (attribute_size > sizeof(scratch)) {
+        value = (uint8_t *)esp_matter_mem_calloc(1, attribute_size);
+        if (!value) {
+            ESP_LOGE(TAG, "Could not allocate value buffer");
+            return ESP_ERR_NO_MEM;
         }
-        return ESP_ERR_NO_MEM;
+    } else {
+        memset(scratch, 0, sizeof(scratch));
     }
     get_data_from_attr_val(val, &attribute_type, &attribute_size, value);
 
     /* Update matter */
-    Status status = Status::Success;
+    esp_err_t err = ESP_OK;
     if (emberAfContainsServer(endpoint_id, cluster_id)) {
-        status = emberAfWriteAttribute(endpoint_id, cluster_id, attribute_id, value, attribute_type);
+        Status status = emberAfWriteAttribute(endpoint_id, cluster_id, attribute_id, value, attribute_type);
         if (status != Status::Success) {
             ESP_LOGE(TAG, "Error updating Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32 " to matter: 0x%X", endpoint_id,
                      cluster_id, attribute_id, static_cast<uint16_t>(status));
-            esp_matter_mem_free(value);
-            if (lock_status == lock::SUCCESS) {
-                lock::chip_stack_unlock();
-            }
-            return ESP_FAIL;
+            err = ESP_FAIL;
         }
+        trace::record(trace::EVENT_ATTRIBUTE_UPDATE, endpoint_id, cluster_id, attribute_id, (uint8_t)status);
     }
-    esp_matter_mem_free(value);
-    if (lock_status == lock::SUCCESS) {
-        lock::chip_stack_unlock();
+    if (value != scratch) {
+        esp_matter_mem_free(value);
     }
-    return ESP_OK;
+    return err;
 }
 
-esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
+/* The caller holds the chip stack lock. changed is set if the value differs from the one in the data model. */
+static esp_err_t report_locked(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                               esp_matter_attr_val_t *val, bool *changed)
 {
-    /* Take lock if not already taken */
-    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
-    if (lock_status == lock::FAILED) {
-        ESP_LOGE(TAG, "Could not get task context");
-        return ESP_FAIL;
-    }
-
     /* Get attribute */
     node_t *node = node::get();
     endpoint_t *endpoint = endpoint::get(node, endpoint_id);
@@ -1981,9 +2268,6 @@ esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_i
     if (!attribute) {
         ESP_LOGE(TAG, "Could not find Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32, endpoint_id, cluster_id,
                  attribute_id);
-        if (lock_status == lock::SUCCESS) {
-            lock::chip_stack_unlock();
-        }
         return ESP_FAIL;
     }
 
@@ -1993,22 +2277,319 @@ esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_i
     if (val->type != raw_val.type) {
         ESP_LOGE(TAG, "Attribute type mismatch when trying to report Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32,
                  endpoint_id, cluster_id, attribute_id);
-        if (lock_status == lock::SUCCESS) {
-            lock::chip_stack_unlock();
-        }
         return ESP_FAIL;
     }
+#if CONFIG_ESP_MATTER_ENABLE_REPORTING_POLICY
+    quantize_reported_val(attribute, val);
+#endif
+    *changed = !val_is_equal(&raw_val, val);
+#if CONFIG_ESP_MATTER_ENABLE_REPORTING_POLICY
+    /* The value is stored anyway, only the report is filtered */
+    if (*changed) {
+        *changed = should_report(attribute, val);
+    }
+#endif
     attribute::set_val(attribute, val);
+    trace::record(trace::EVENT_ATTRIBUTE_REPORT, endpoint_id, cluster_id, attribute_id, (uint8_t)Status::Success);
+    return ESP_OK;
+}
 
-    /* Report attribute */
+/* The caller holds the chip stack lock. Marks the path dirty, unless it is a deferred bulk report or the ICD report
+ * batching holds it. */
+static void report_changed(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+#if CONFIG_ESP_MATTER_ICD_REPORT_BATCHING || CONFIG_ESP_MATTER_ENABLE_REPORT_PRIORITY
+    endpoint_t *endpoint = endpoint::get(node::get(), endpoint_id);
+    attribute_t *attribute = attribute::get(cluster::get(endpoint, cluster_id), attribute_id);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_REPORT_PRIORITY
+    if (report_priority::defer(attribute, endpoint_id, cluster_id, attribute_id)) {
+        return;
+    }
+#endif
+#if CONFIG_ESP_MATTER_ICD_REPORT_BATCHING
+    if (icd_report_batching::hold(attribute, endpoint_id, cluster_id, attribute_id)) {
+        return;
+    }
+#endif
     MatterReportingAttributeChangeCallback(endpoint_id, cluster_id, attribute_id);
+}
+
+esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = update_locked(endpoint_id, cluster_id, attribute_id, val);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    bool changed = false;
+    esp_err_t err = report_locked(endpoint_id, cluster_id, attribute_id, val, &changed);
+
+    /* Report attribute, unchanged values are not reported again */
+    if (err == ESP_OK && changed) {
+        report_changed(endpoint_id, cluster_id, attribute_id);
+    }
 
     if (lock_status == lock::SUCCESS) {
         lock::chip_stack_unlock();
     }
+    return err;
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_UPDATE_QUEUE
+/* Bounded MPSC ring. Producers claim a position with a CAS and publish the slot through its sequence number, the
+ * Matter task is the only consumer. The sequence numbers are stored relative to the slot index so that the zero
+ * initialized ring is valid before anything else runs, even for updates posted from an ISR during boot. */
+constexpr uint32_t k_update_queue_size = CONFIG_ESP_MATTER_ATTRIBUTE_UPDATE_QUEUE_SIZE;
+static_assert((k_update_queue_size & (k_update_queue_size - 1)) == 0, "Update queue size must be a power of two");
+/* Paths which did not fit in the ring are coalesced here, the latest value of each path wins */
+constexpr uint32_t k_update_overflow_size = 8;
+
+typedef struct {
+    std::atomic<uint32_t> sequence;
+    batch_entry_t entry;
+} update_slot_t;
+
+static update_slot_t s_update_slots[k_update_queue_size];
+static std::atomic<uint32_t> s_update_enqueue_pos(0);
+static uint32_t s_update_dequeue_pos = 0;
+static std::atomic<bool> s_update_drain_scheduled(false);
+static batch_entry_t s_update_overflow[k_update_overflow_size];
+static std::atomic<uint32_t> s_update_overflow_count(0);
+static std::atomic<uint32_t> s_update_dropped_count(0);
+static portMUX_TYPE s_update_overflow_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool update_queue_push(const batch_entry_t *entry)
+{
+    uint32_t pos = s_update_enqueue_pos.load(std::memory_order_relaxed);
+    update_slot_t *slot = NULL;
+    while (true) {
+        uint32_t index = pos & (k_update_queue_size - 1);
+        slot = &s_update_slots[index];
+        uint32_t sequence = slot->sequence.load(std::memory_order_acquire) + index;
+        int32_t diff = (int32_t)(sequence - pos);
+        if (diff == 0) {
+            if (s_update_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Full */
+            return false;
+        } else {
+            pos = s_update_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    slot->entry = *entry;
+    slot->sequence.store(pos + 1 - (pos & (k_update_queue_size - 1)), std::memory_order_release);
+    return true;
+}
+
+static bool update_queue_pop(batch_entry_t *entry)
+{
+    uint32_t pos = s_update_dequeue_pos;
+    uint32_t index = pos & (k_update_queue_size - 1);
+    update_slot_t *slot = &s_update_slots[index];
+    if (slot->sequence.load(std::memory_order_acquire) + index != pos + 1) {
+        /* Empty, or the producer has not published the slot yet */
+        return false;
+    }
+    *entry = slot->entry;
+    slot->sequence.store(pos + k_update_queue_size - index, std::memory_order_release);
+    s_update_dequeue_pos = pos + 1;
+    return true;
+}
+
+static bool update_overflow_push(const batch_entry_t *entry)
+{
+    bool pushed = false;
+    portENTER_CRITICAL_SAFE(&s_update_overflow_lock);
+    uint32_t count = s_update_overflow_count.load(std::memory_order_relaxed);
+    for (uint32_t index = 0; index < count; index++) {
+        batch_entry_t *current = &s_update_overflow[index];
+        if (current->endpoint_id == entry->endpoint_id && current->cluster_id == entry->cluster_id &&
+            current->attribute_id == entry->attribute_id) {
+            current->val = entry->val;
+            pushed = true;
+            break;
+        }
+    }
+    if (!pushed && count < k_update_overflow_size) {
+        s_update_overflow[count] = *entry;
+        s_update_overflow_count.store(count + 1, std::memory_order_relaxed);
+        pushed = true;
+    }
+    portEXIT_CRITICAL_SAFE(&s_update_overflow_lock);
+    return pushed;
+}
+
+static void drain_update_queue(intptr_t arg)
+{
+    /* Runs in the Matter task with the stack lock held. Clear the flag first, so that an update posted while
+     * draining schedules another pass instead of being left behind. */
+    s_update_drain_scheduled.store(false);
+    batch_entry_t entry;
+    while (update_queue_pop(&entry)) {
+        update_locked(entry.endpoint_id, entry.cluster_id, entry.attribute_id, &entry.val);
+    }
+    if (s_update_overflow_count.load(std::memory_order_relaxed) > 0) {
+        batch_entry_t overflow[k_update_overflow_size];
+        portENTER_CRITICAL_SAFE(&s_update_overflow_lock);
+        uint32_t count = s_update_overflow_count.load(std::memory_order_relaxed);
+        memcpy(overflow, s_update_overflow, count * sizeof(batch_entry_t));
+        s_update_overflow_count.store(0, std::memory_order_relaxed);
+        portEXIT_CRITICAL_SAFE(&s_update_overflow_lock);
+        for (uint32_t index = 0; index < count; index++) {
+            update_locked(overflow[index].endpoint_id, overflow[index].cluster_id, overflow[index].attribute_id,
+                          &overflow[index].val);
+        }
+    }
+}
+
+static void schedule_drain_from_daemon(void *arg1, uint32_t arg2)
+{
+    if (chip::DeviceLayer::PlatformMgr().ScheduleWork(drain_update_queue) != CHIP_NO_ERROR) {
+        s_update_drain_scheduled.store(false);
+    }
+}
+
+static esp_err_t update_async_common(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                     const esp_matter_attr_val_t *val, BaseType_t *higher_priority_task_woken)
+{
+    if (!val) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        val->type == ESP_MATTER_VAL_TYPE_ARRAY) {
+        /* The buffer is owned by the caller and might be gone before the queue is drained */
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    batch_entry_t entry = {
+        .endpoint_id = endpoint_id,
+        .cluster_id = cluster_id,
+        .attribute_id = attribute_id,
+        .val = *val,
+    };
+    /* Once values have overflowed, keep coalescing there until the next drain to preserve the order per path */
+    bool pushed = s_update_overflow_count.load(std::memory_order_relaxed) == 0 && update_queue_push(&entry);
+    if (!pushed && !update_overflow_push(&entry)) {
+        s_update_dropped_count++;
+        return ESP_ERR_NO_MEM;
+    }
+
+    bool expected = false;
+    if (s_update_drain_scheduled.compare_exchange_strong(expected, true)) {
+        if (higher_priority_task_woken) {
+            /* ScheduleWork() is not ISR safe, hand it over to the timer daemon task */
+            if (xTimerPendFunctionCallFromISR(schedule_drain_from_daemon, NULL, 0, higher_priority_task_woken) !=
+                pdPASS) {
+                s_update_drain_scheduled.store(false);
+            }
+        } else if (chip::DeviceLayer::PlatformMgr().ScheduleWork(drain_update_queue) != CHIP_NO_ERROR) {
+            s_update_drain_scheduled.store(false);
+        }
+    }
     return ESP_OK;
 }
 
+esp_err_t update_async(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                       const esp_matter_attr_val_t *val)
+{
+    return update_async_common(endpoint_id, cluster_id, attribute_id, val, NULL);
+}
+
+esp_err_t update_async_from_isr(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                const esp_matter_attr_val_t *val, BaseType_t *higher_priority_task_woken)
+{
+    BaseType_t woken = pdFALSE;
+    esp_err_t err = update_async_common(endpoint_id, cluster_id, attribute_id, val, &woken);
+    if (higher_priority_task_woken) {
+        *higher_priority_task_woken = woken;
+    }
+    return err;
+}
+
+uint32_t get_update_queue_dropped_count()
+{
+    return s_update_dropped_count.load();
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_UPDATE_QUEUE
+
+esp_err_t update_batch(batch_entry_t *entries, size_t count)
+{
+    if (!entries && count > 0) {
+        ESP_LOGE(TAG, "Entries cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    for (size_t index = 0; index < count; index++) {
+        esp_err_t entry_err = update_locked(entries[index].endpoint_id, entries[index].cluster_id,
+                                            entries[index].attribute_id, &entries[index].val);
+        if (entry_err != ESP_OK) {
+            err = entry_err;
+        }
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t report_batch(batch_entry_t *entries, size_t count)
+{
+    if (!entries && count > 0) {
+        ESP_LOGE(TAG, "Entries cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+
+    /* The reporting engine only runs once the lock is released, so all the changed paths are marked dirty
+     * together and go out in the same reporting pass. */
+    esp_err_t err = ESP_OK;
+    for (size_t index = 0; index < count; index++) {
+        bool changed = false;
+        esp_err_t entry_err = report_locked(entries[index].endpoint_id, entries[index].cluster_id,
+                                            entries[index].attribute_id, &entries[index].val, &changed);
+        if (entry_err != ESP_OK) {
+            err = entry_err;
+        } else if (changed) {
+            report_changed(entries[index].endpoint_id, entries[index].cluster_id, entries[index].attribute_id);
+        }
+    }
+
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
 } /* attribute */
 } /* esp_matter */
 
@@ -2027,7 +2608,13 @@ Status MatterPreAttributeChangeCallback(const chip::app::ConcreteAttributePath &
     attribute::val_print(endpoint_id, cluster_id, attribute_id, &val, false);
 
     /* Callback to application */
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+    e2e_latency::mark(e2e_latency::STAGE_DRIVER);
+#endif
     esp_err_t err = execute_callback(attribute::PRE_UPDATE, endpoint_id, cluster_id, attribute_id, &val);
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+    e2e_latency::mark(e2e_latency::STAGE_DRIVER_DONE);
+#endif
     if (err != ESP_OK) {
         return Status::Failure;
     }
@@ -2037,6 +2624,9 @@ Status MatterPreAttributeChangeCallback(const chip::app::ConcreteAttributePath &
 void MatterPostAttributeChangeCallback(const chip::app::ConcreteAttributePath &path, uint8_t type,
                                        uint16_t size, uint8_t *value)
 {
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+    e2e_latency::mark(e2e_latency::STAGE_POST_ATTRIBUTE_CHANGE);
+#endif
     uint16_t endpoint_id = path.mEndpointId;
     uint32_t cluster_id = path.mClusterId;
     uint32_t attribute_id = path.mAttributeId;
@@ -2046,15 +2636,129 @@ void MatterPostAttributeChangeCallback(const chip::app::ConcreteAttributePath &p
     attribute::get_attr_val_from_data(&val, type, size, value, attribute_metadata);
 
     /* Callback to application */
+#if CONFIG_ESP_MATTER_ENABLE_POST_UPDATE_OFFLOAD
+    if ((attribute_callback || s_path_callback_count > 0) &&
+        callback_offload::post(endpoint_id, cluster_id, attribute_id, &val, execute_callback) == ESP_OK) {
+        return;
+    }
+#endif
     execute_callback(attribute::POST_UPDATE, endpoint_id, cluster_id, attribute_id, &val);
 }
 
+template <typename T>
+static Status encode_numeric(T working_value, bool nullable, uint8_t *buffer, uint16_t max_read_length,
+                             uint16_t *attribute_size)
+{
+    using Traits = chip::app::NumericAttributeTraits<T>;
+    *attribute_size = sizeof(typename Traits::StorageType);
+    if (*attribute_size > max_read_length) {
+        return Status::ResourceExhausted;
+    }
+    typename Traits::StorageType *storage = (typename Traits::StorageType *)buffer;
+    if (nullable && Traits::IsNullValue(*(typename Traits::StorageType *)&working_value)) {
+        Traits::SetNull(*storage);
+    } else {
+        Traits::WorkingToStorage(working_value, *storage);
+    }
+    return Status::Success;
+}
+
+/* Same encoding as get_data_from_attr_val(), done in a single pass with the size checked against the ember
+   buffer before anything is written. The string/array data is copied straight from the attribute storage. */
+static Status encode_attr_val(esp_matter_val_type_t type, const esp_matter_val_t *val, uint8_t *buffer,
+                              uint16_t max_read_length, uint16_t *attribute_size)
+{
+    bool nullable = type & ESP_MATTER_VAL_NULLABLE_BASE;
+    switch (type) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BOOLEAN:
+        return encode_numeric<bool>(val->b, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INTEGER:
+        return encode_numeric<int>(val->i, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_FLOAT:
+        return encode_numeric<float>(val->f, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT8:
+        return encode_numeric<int8_t>(val->i8, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP8:
+        return encode_numeric<uint8_t>(val->u8, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT16:
+        return encode_numeric<int16_t>(val->i16, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP16:
+        return encode_numeric<uint16_t>(val->u16, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_INT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT32:
+        return encode_numeric<int32_t>(val->i32, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP32:
+        return encode_numeric<uint32_t>(val->u32, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT64:
+        return encode_numeric<int64_t>(val->i64, nullable, buffer, max_read_length, attribute_size);
+    case ESP_MATTER_VAL_TYPE_UINT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT64:
+        return encode_numeric<uint64_t>(val->u64, nullable, buffer, max_read_length, attribute_size);
+
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_ARRAY: {
+        /* The length prefix is 1 byte for the short strings and 2 bytes otherwise */
+        size_t data_size_len = val->a.t - val->a.s;
+        uint16_t data_size = val->a.s;
+        if (type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING) {
+            size_t string_len = val->a.b ? strnlen((const char *)val->a.b, val->a.s) : 0;
+            size_t expected_size_len = type == ESP_MATTER_VAL_TYPE_CHAR_STRING ? 1 : 2;
+            if (string_len >= UINT8_MAX || data_size_len != expected_size_len) {
+                return Status::Failure;
+            }
+            data_size = string_len;
+        }
+        if (data_size_len > sizeof(data_size)) {
+            return Status::Failure;
+        }
+        *attribute_size = data_size + data_size_len;
+        if (*attribute_size > max_read_length) {
+            return Status::ResourceExhausted;
+        }
+        /* Little endian length prefix, as in get_data_from_attr_val() */
+        memcpy(buffer, &data_size, data_size_len);
+        if (data_size > 0) {
+            memcpy(buffer + data_size_len, val->a.b, data_size);
+        }
+        return Status::Success;
+    }
+
+    default:
+        ESP_LOGE(TAG, "Unsupported attribute value type: %d", type);
+        *attribute_size = 0;
+        return Status::Failure;
+    }
+}
+
 Status emberAfExternalAttributeReadCallback(EndpointId endpoint_id, ClusterId cluster_id,
                                                    const EmberAfAttributeMetadata *matter_attribute, uint8_t *buffer,
                                                    uint16_t max_read_length)
 {
     /* Get value */
     uint32_t attribute_id = matter_attribute->attributeId;
+    lazy_plugin_init::on_access(cluster_id);
     node_t *node = node::get();
     if (!node) {
         return Status::Failure;
@@ -2062,34 +2766,60 @@ Status emberAfExternalAttributeReadCallback(EndpointId endpoint_id, ClusterId cl
     endpoint_t *endpoint = endpoint::get(node, endpoint_id);
     cluster_t *cluster = cluster::get(endpoint, cluster_id);
     attribute_t *attribute = attribute::get(cluster, attribute_id);
+    if (!attribute) {
+        return Status::Failure;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_ENCODE_CACHE
+    /* The same path is read for every subscriber covering it, convert it once per reporting cycle */
+    if (encode_cache::get(endpoint_id, cluster_id, attribute_id, buffer, max_read_length)) {
+        trace::record(trace::EVENT_ATTRIBUTE_READ, endpoint_id, cluster_id, attribute_id, (uint8_t)Status::Success);
+        return Status::Success;
+    }
+#endif
     esp_matter_attr_val_t val = esp_matter_invalid(NULL);
+    esp_matter_val_type_t type = ESP_MATTER_VAL_TYPE_INVALID;
+    const esp_matter_val_t *value = NULL;
 
     int flags = attribute::get_flags(attribute);
-    if (flags & ATTRIBUTE_FLAG_OVERRIDE) {
+    const esp_matter_attr_val_t *cached_val = NULL;
+    if ((flags & ATTRIBUTE_FLAG_OVERRIDE) && (cached_val = attribute::get_override_cache(attribute))) {
+        type = cached_val->type;
+        value = &cached_val->val;
+    } else if (flags & ATTRIBUTE_FLAG_OVERRIDE) {
         esp_err_t err = execute_override_callback(attribute, attribute::READ, endpoint_id, cluster_id, attribute_id,
                                                   &val);
         if (err != ESP_OK) {
+            trace::record(trace::EVENT_ATTRIBUTE_READ, endpoint_id, cluster_id, attribute_id,
+                          (uint8_t)Status::Failure);
             return Status::Failure;
         }
+        attribute::set_override_cache(attribute, &val);
+        type = val.type;
+        value = &val.val;
     } else {
-        attribute::get_val(attribute, &val);
+        /* Read the value in place, without copying it out of the data model */
+        value = attribute::get_val_storage(attribute, &type);
     }
 
     /* Here, the val_print function gets called on attribute read. */
-    attribute::val_print(endpoint_id, cluster_id, attribute_id, &val, true);
+    if (attribute::val_print_enabled()) {
+        esp_matter_attr_val_t print_val = {.type = type, .val = *value};
+        attribute::val_print(endpoint_id, cluster_id, attribute_id, &print_val, true);
+    }
 
-    /* Get size */
     uint16_t attribute_size = 0;
-    attribute::get_data_from_attr_val(&val, NULL, &attribute_size, NULL);
-    if (attribute_size > max_read_length) {
+    Status status = encode_attr_val(type, value, buffer, max_read_length, &attribute_size);
+    if (status == Status::ResourceExhausted) {
         ESP_LOGE(TAG, "Insufficient space for reading Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 "'s Attribute 0x%08" PRIX32
                 ": required: %" PRIu16 ", max: %" PRIu16 "", endpoint_id, cluster_id, attribute_id, attribute_size, max_read_length);
-        return Status::ResourceExhausted;
     }
-
-    /* Assign value */
-    attribute::get_data_from_attr_val(&val, NULL, &attribute_size, buffer);
-    return Status::Success;
+#if CONFIG_ESP_MATTER_ENABLE_ENCODE_CACHE
+    if (status == Status::Success) {
+        encode_cache::put(endpoint_id, cluster_id, attribute_id, buffer, attribute_size);
+    }
+#endif
+    trace::record(trace::EVENT_ATTRIBUTE_READ, endpoint_id, cluster_id, attribute_id, (uint8_t)status);
+    return status;
 }
 
 Status emberAfExternalAttributeWriteCallback(EndpointId endpoint_id, ClusterId cluster_id,
@@ -2097,6 +2827,7 @@ Status emberAfExternalAttributeWriteCallback(EndpointId endpoint_id, ClusterId c
 {
     /* Get value */
     uint32_t attribute_id = matter_attribute->attributeId;
+    lazy_plugin_init::on_access(cluster_id);
     node_t *node = node::get();
     if (!node) {
         return Status::Failure;
@@ -2115,14 +2846,18 @@ Status emberAfExternalAttributeWriteCallback(EndpointId endpoint_id, ClusterId c
     if (flags & ATTRIBUTE_FLAG_OVERRIDE) {
         esp_err_t err = execute_override_callback(attribute, attribute::WRITE, endpoint_id, cluster_id, attribute_id,
                                                   &val);
+        attribute::invalidate_override_cache(attribute);
         Status status = (err == ESP_OK) ? Status::Success : Status::Failure;
+        trace::record(trace::EVENT_ATTRIBUTE_WRITE, endpoint_id, cluster_id, attribute_id, (uint8_t)status);
         return status;
     }
 
     /* Update val */
     if (val.type == ESP_MATTER_VAL_TYPE_INVALID) {
+        trace::record(trace::EVENT_ATTRIBUTE_WRITE, endpoint_id, cluster_id, attribute_id, (uint8_t)Status::Failure);
         return Status::Failure;
     }
     attribute::set_val(attribute, &val);
+    trace::record(trace::EVENT_ATTRIBUTE_WRITE, endpoint_id, cluster_id, attribute_id, (uint8_t)Status::Success);
     return Status::Success;
 }
@@ -16,9 +16,11 @@
 
 #include <esp_err.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include <app/data-model/Nullable.h>
+#include <freertos/FreeRTOS.h>
 
 /** Remap attribute values
  *
@@ -311,7 +313,11 @@ esp_matter_attr_val_t esp_matter_long_char_str(char *val, uint16_t data_size);
 esp_matter_attr_val_t esp_matter_octet_str(uint8_t *val, uint16_t data_size);
 esp_matter_attr_val_t esp_matter_long_octet_str(uint8_t *val, uint16_t data_size);
 
-/** Array */
+/** Array
+ *
+ * With CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE, the value holds the elements of the list as consecutive
+ * Matter TLV elements with anonymous tags, which are encoded one by one into the reports.
+ */
 esp_matter_attr_val_t esp_matter_array(uint8_t *val, uint16_t data_size, uint16_t count);
 
 namespace esp_matter {
@@ -328,6 +334,12 @@ typedef enum callback_type {
     READ,
     /** Callback for writing the attribute value. This is used when the `ATTRIBUTE_FLAG_OVERRIDE` is set. */
     WRITE,
+    /** Callback before the attribute updates of a scene recall, with the Scenes Management cluster ID and
+     * `ESP_MATTER_WILDCARD_ATTRIBUTE_ID`. This is used when `CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH` is set. */
+    SCENE_RECALL_BEGIN,
+    /** Callback after the attribute updates of a scene recall, the driver can apply them at once. This is used when
+     * `CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH` is set. */
+    SCENE_RECALL_END,
 } callback_type_t;
 
 /** Callback for attribute update
@@ -360,6 +372,89 @@ typedef esp_err_t (*callback_t)(callback_type_t type, uint16_t endpoint_id, uint
  */
 esp_err_t set_callback(callback_t callback);
 
+#if CONFIG_ESP_MATTER_ENABLE_POST_UPDATE_OFFLOAD
+/** Completion callback of the offloaded `POST_UPDATE` callbacks
+ *
+ * @param[in] endpoint_id Endpoint ID of the attribute.
+ * @param[in] cluster_id Cluster ID of the attribute.
+ * @param[in] attribute_id Attribute ID of the attribute.
+ * @param[in] err Error returned by the attribute callbacks.
+ */
+typedef void (*post_update_completion_t)(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                         esp_err_t err);
+
+/** Set completion callback of the offloaded POST_UPDATE callbacks
+ *
+ * With CONFIG_ESP_MATTER_ENABLE_POST_UPDATE_OFFLOAD, the `POST_UPDATE` callbacks of the updates made by the Matter
+ * stack run on a pool of worker tasks instead of the Matter task, so that slow drivers do not delay the network
+ * processing. The callbacks of an endpoint run in order on the same worker, and a pending update of an attribute is
+ * dropped when the attribute changes again, so only its latest value reaches the callbacks. The completion callback
+ * is called on the worker after the attribute callbacks, with their result. Without it, the errors are logged.
+ *
+ * @note: The offloaded callbacks run without the Matter stack lock, they have to use the APIs which take it, such as
+ * `attribute::update()`. When the queue is full, the callbacks are called on the Matter task.
+ *
+ * @note: This should be called before `esp_matter::start()`.
+ *
+ * @param[in] callback Completion callback, NULL to log the errors.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_post_update_completion_callback(post_update_completion_t callback);
+#endif // CONFIG_ESP_MATTER_ENABLE_POST_UPDATE_OFFLOAD
+
+/** Wildcard IDs for `register_callback()` */
+#define ESP_MATTER_WILDCARD_ENDPOINT_ID 0xFFFF
+#define ESP_MATTER_WILDCARD_CLUSTER_ID 0xFFFFFFFF
+#define ESP_MATTER_WILDCARD_ATTRIBUTE_ID 0xFFFFFFFF
+
+/** Callback for the updates of a registered attribute path
+ *
+ * Same as `callback_t`, with the context passed to `register_callback()`.
+ *
+ * @param[in] ctx Context passed to `register_callback()`.
+ */
+typedef esp_err_t (*path_callback_t)(callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                                     uint32_t attribute_id, esp_matter_attr_val_t *val, void *priv_data, void *ctx);
+
+/** Register attribute path callback
+ *
+ * Register an update callback for an attribute path. Any of the IDs can be the corresponding
+ * `ESP_MATTER_WILDCARD_*_ID`. On a `PRE_UPDATE` or `POST_UPDATE`, the callbacks of the matching paths are called,
+ * from the exact path to the full wildcard and in the registration order for the same path, and then the common
+ * callback set with `set_callback()`. If a callback returns an error on `PRE_UPDATE`, the update is rejected and the
+ * following callbacks are not called.
+ *
+ * @note: The callbacks should be registered and unregistered with the Matter stack lock held, or before
+ * `esp_matter::start()`.
+ *
+ * @param[in] endpoint_id Endpoint ID of the attribute, or `ESP_MATTER_WILDCARD_ENDPOINT_ID`.
+ * @param[in] cluster_id Cluster ID of the attribute, or `ESP_MATTER_WILDCARD_CLUSTER_ID`.
+ * @param[in] attribute_id Attribute ID, or `ESP_MATTER_WILDCARD_ATTRIBUTE_ID`.
+ * @param[in] callback Attribute path callback.
+ * @param[in] ctx (Optional) Context passed to the callback.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t register_callback(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, path_callback_t callback,
+                            void *ctx);
+
+/** Unregister attribute path callback
+ *
+ * @param[in] endpoint_id Endpoint ID passed to `register_callback()`.
+ * @param[in] cluster_id Cluster ID passed to `register_callback()`.
+ * @param[in] attribute_id Attribute ID passed to `register_callback()`.
+ * @param[in] callback Callback passed to `register_callback()`.
+ * @param[in] ctx Context passed to `register_callback()`.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the callback is not registered.
+ */
+esp_err_t unregister_callback(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                              path_callback_t callback, void *ctx);
+
 /** Attribute update
  *
  * This API updates the attribute value.
@@ -392,6 +487,86 @@ esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_i
  */
 esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
 
+/** Batch entry for `update_batch()` and `report_batch()` */
+typedef struct {
+    /** Endpoint ID of the attribute */
+    uint16_t endpoint_id;
+    /** Cluster ID of the attribute */
+    uint32_t cluster_id;
+    /** Attribute ID of the attribute */
+    uint32_t attribute_id;
+    /** New value of the attribute */
+    esp_matter_attr_val_t val;
+} batch_entry_t;
+
+/** Attribute batch update
+ *
+ * This API updates several attribute values under a single chip stack lock, with the same callbacks as `update()`
+ * for each of them. All the entries are processed even if some of them fail.
+ *
+ * @param[in] entries Array of batch entries.
+ * @param[in] count Number of entries.
+ *
+ * @return ESP_OK on success.
+ * @return error of the last failed entry in case of failure.
+ */
+esp_err_t update_batch(batch_entry_t *entries, size_t count);
+
+/** Attribute batch report
+ *
+ * This API reports several attribute values under a single chip stack lock, like `report()` does for each of them.
+ * The changed paths are marked dirty together, so they go out in the same reporting pass.
+ *
+ * @param[in] entries Array of batch entries.
+ * @param[in] count Number of entries.
+ *
+ * @return ESP_OK on success.
+ * @return error of the last failed entry in case of failure.
+ */
+esp_err_t report_batch(batch_entry_t *entries, size_t count);
+
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_UPDATE_QUEUE
+/** Attribute asynchronous update
+ *
+ * This API queues an attribute update without taking the chip stack lock, so it never blocks. The queue is drained
+ * by the Matter task, which applies the updates like `update()` does. If the queue is full, the updates are
+ * coalesced to the latest value per path until the next drain.
+ *
+ * @note: String, octet string and array values are not supported since their buffer belongs to the caller.
+ *
+ * @param[in] endpoint_id Endpoint ID of the attribute.
+ * @param[in] cluster_id Cluster ID of the attribute.
+ * @param[in] attribute_id Attribute ID of the attribute.
+ * @param[in] val Pointer to `esp_matter_attr_val_t`. The value is copied.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM if the queue and the overflow table are full.
+ * @return error in case of other failures.
+ */
+esp_err_t update_async(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                       const esp_matter_attr_val_t *val);
+
+/** Attribute asynchronous update from ISR
+ *
+ * Same as `update_async()`, to be called from an interrupt handler.
+ *
+ * @param[in] endpoint_id Endpoint ID of the attribute.
+ * @param[in] cluster_id Cluster ID of the attribute.
+ * @param[in] attribute_id Attribute ID of the attribute.
+ * @param[in] val Pointer to `esp_matter_attr_val_t`. The value is copied.
+ * @param[out] higher_priority_task_woken Set to pdTRUE if a context switch should be requested before the
+ *                                        interrupt exits, can be NULL.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t update_async_from_isr(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                const esp_matter_attr_val_t *val, BaseType_t *higher_priority_task_woken);
+
+/** Get the number of asynchronous updates dropped because the queue was full */
+uint32_t get_update_queue_dropped_count();
+#endif // CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_UPDATE_QUEUE
+
 /** Attribute value print
  *
  * This API prints the attribute value according to the type.
@@ -404,5 +579,27 @@ esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_i
  */
 void val_print(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val, bool is_read);
 
+/** Attribute value compare
+ *
+ * This API compares two attribute values according to their type. Strings, octet strings and arrays are compared by
+ * their contents, floats are compared bitwise so that null values compare equal.
+ *
+ * @param[in] val1 Pointer to the first `esp_matter_attr_val_t`.
+ * @param[in] val2 Pointer to the second `esp_matter_attr_val_t`.
+ *
+ * @return true if the values have the same type and the same value.
+ * @return false otherwise.
+ */
+bool val_is_equal(const esp_matter_attr_val_t *val1, const esp_matter_attr_val_t *val2);
+
+/** Attribute value null check
+ *
+ * @param[in] val Pointer to `esp_matter_attr_val_t`.
+ *
+ * @return true if the value is of a nullable type and is null.
+ * @return false otherwise.
+ */
+bool val_is_null(esp_matter_attr_val_t *val);
+
 } /* attribute */
 } /* esp_matter */
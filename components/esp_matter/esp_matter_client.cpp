@@ -15,9 +15,31 @@
 #include <esp_log.h>
 #include <esp_matter.h>
 #include <esp_matter_core.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_object_pool.h>
 
 #include <app/clusters/bindings/BindingManager.h>
+#include <app/util/binding-table.h>
+#include <esp_timer.h>
 #include <json_to_tlv.h>
+#include <new>
+
+#if CONFIG_ESP_MATTER_ENABLE_BINDING_INDEX
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+#include <transport/SessionHolder.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
+#include <esp_matter_sed_poll.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+#include <lib/address_resolve/AddressResolve.h>
+#include <lib/dnssd/Resolver.h>
+#endif
 
 #if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
 #include <zap-generated/CHIPClusters.h>
@@ -40,6 +62,10 @@ using chip::Messaging::ExchangeManager;
 
 static const char *TAG = "esp_matter_client";
 
+/* The allocations of the client are accounted apart from the data model */
+#undef ESP_MATTER_MEM_SUBSYSTEM
+#define ESP_MATTER_MEM_SUBSYSTEM ESP_MATTER_MEM_SUBSYSTEM_CLIENT
+
 namespace esp_matter {
 namespace client {
 
@@ -48,6 +74,338 @@ static group_command_callback_t client_group_command_callback = NULL;
 static void *command_callback_priv_data;
 static bool initialize_binding_manager = false;
 
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+/* Delay between the binding manager initialization and the connection to the bound peers, so that the network and
+ * the operational discovery are up */
+static constexpr uint32_t k_preconnect_delay_s = 5;
+
+typedef struct {
+    ScopedNodeId peer;
+    /* Cleared by the session manager if the session goes away */
+    chip::SessionHolder session;
+    int64_t last_used_us;
+} session_pool_entry_t;
+
+/* Only accessed with the chip stack lock held */
+static session_pool_entry_t s_session_pool[CONFIG_ESP_MATTER_CLIENT_SESSION_POOL_SIZE];
+static session_pool_stats_t s_session_pool_stats;
+static bool s_idle_timer_running = false;
+
+static session_pool_entry_t *find_pool_entry(const ScopedNodeId &peer)
+{
+    for (session_pool_entry_t &entry : s_session_pool) {
+        if (entry.session && entry.peer == peer) {
+            return &entry;
+        }
+    }
+    return NULL;
+}
+
+static void release_idle_sessions(chip::System::Layer *layer, void *context)
+{
+    int64_t now_us = esp_timer_get_time();
+    int64_t idle_timeout_us = (int64_t)CONFIG_ESP_MATTER_CLIENT_SESSION_POOL_IDLE_TIMEOUT * 1000 * 1000;
+    bool has_sessions = false;
+    for (session_pool_entry_t &entry : s_session_pool) {
+        if (entry.session && now_us - entry.last_used_us >= idle_timeout_us) {
+            entry.session.Release();
+            s_session_pool_stats.idle_releases++;
+        }
+        has_sessions = has_sessions || entry.session;
+    }
+    /* Entries are released between one and two timeouts after their last use */
+    s_idle_timer_running = has_sessions &&
+        chip::DeviceLayer::SystemLayer().StartTimer(
+            chip::System::Clock::Seconds32(CONFIG_ESP_MATTER_CLIENT_SESSION_POOL_IDLE_TIMEOUT), release_idle_sessions,
+            NULL) == CHIP_NO_ERROR;
+}
+
+static void add_to_pool(const SessionHandle &session_handle)
+{
+    ScopedNodeId peer = session_handle->GetPeer();
+    session_pool_entry_t *entry = find_pool_entry(peer);
+    if (!entry) {
+        /* Take a free entry, or the least recently used one */
+        for (session_pool_entry_t &candidate : s_session_pool) {
+            if (!candidate.session) {
+                entry = &candidate;
+                break;
+            }
+            if (!entry || candidate.last_used_us < entry->last_used_us) {
+                entry = &candidate;
+            }
+        }
+        if (entry->session) {
+            s_session_pool_stats.evictions++;
+        }
+        entry->peer = peer;
+    }
+    if (!entry->session.Grab(session_handle)) {
+        return;
+    }
+    entry->last_used_us = esp_timer_get_time();
+    if (!s_idle_timer_running) {
+        s_idle_timer_running = chip::DeviceLayer::SystemLayer().StartTimer(
+            chip::System::Clock::Seconds32(CONFIG_ESP_MATTER_CLIENT_SESSION_POOL_IDLE_TIMEOUT), release_idle_sessions,
+            NULL) == CHIP_NO_ERROR;
+    }
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+typedef struct {
+    ScopedNodeId peer;
+    chip::Transport::PeerAddress address;
+    int64_t expiry_us;
+    int64_t last_used_us;
+    bool valid;
+} address_cache_entry_t;
+
+/* Only accessed with the chip stack lock held */
+static address_cache_entry_t s_address_cache[CONFIG_ESP_MATTER_CLIENT_ADDRESS_CACHE_SIZE];
+static address_cache_stats_t s_address_cache_stats;
+
+static address_cache_entry_t *find_address(const ScopedNodeId &peer)
+{
+    for (address_cache_entry_t &entry : s_address_cache) {
+        if (entry.valid && entry.peer == peer) {
+            return &entry;
+        }
+    }
+    return NULL;
+}
+
+/* Records the address of an established session, the operational records of the peer are valid for the TTL */
+static void cache_address(const SessionHandle &session_handle)
+{
+    if (!session_handle->IsSecureSession()) {
+        return;
+    }
+    const chip::Transport::PeerAddress &address = session_handle->AsSecureSession()->GetPeerAddress();
+    if (address.GetTransportType() != chip::Transport::Type::kUdp) {
+        return;
+    }
+    ScopedNodeId peer = session_handle->GetPeer();
+    address_cache_entry_t *entry = find_address(peer);
+    if (!entry) {
+        /* Take a free entry, or the least recently used one */
+        for (address_cache_entry_t &candidate : s_address_cache) {
+            if (!candidate.valid) {
+                entry = &candidate;
+                break;
+            }
+            if (!entry || candidate.last_used_us < entry->last_used_us) {
+                entry = &candidate;
+            }
+        }
+        entry->peer = peer;
+    }
+    int64_t now_us = esp_timer_get_time();
+    entry->address = address;
+    entry->expiry_us = now_us + (int64_t)CONFIG_ESP_MATTER_CLIENT_ADDRESS_CACHE_TTL * 1000 * 1000;
+    entry->last_used_us = now_us;
+    entry->valid = true;
+}
+
+static void invalidate_address(const ScopedNodeId &peer)
+{
+    address_cache_entry_t *entry = find_address(peer);
+    if (entry) {
+        entry->valid = false;
+        s_address_cache_stats.invalidations++;
+    }
+}
+
+/* Completes the operational discovery started by the session setup with the cached address of the peer, so that the
+ * CASE handshake starts without waiting for the mDNS responses. A stale address fails the session setup, which
+ * invalidates it, and the retry resolves the peer again. */
+static void resolve_from_cache(const ScopedNodeId &peer)
+{
+    if (Server::GetInstance().GetSecureSessionManager().FindSecureSessionForNode(
+            peer, chip::MakeOptional(chip::Transport::SecureSession::Type::kCASE))) {
+        /* The session setup attaches to the existing session without a lookup */
+        return;
+    }
+    address_cache_entry_t *entry = find_address(peer);
+    int64_t now_us = esp_timer_get_time();
+    if (entry && now_us >= entry->expiry_us) {
+        entry->valid = false;
+        s_address_cache_stats.expirations++;
+        entry = NULL;
+    }
+    const FabricInfo *fabric = Server::GetInstance().GetFabricTable().FindFabricWithIndex(peer.GetFabricIndex());
+    if (!entry || !fabric) {
+        s_address_cache_stats.misses++;
+        return;
+    }
+    s_address_cache_stats.hits++;
+    entry->last_used_us = now_us;
+
+    chip::Dnssd::ResolvedNodeData node_data;
+    node_data.operationalData.peerId =
+        chip::PeerId().SetCompressedFabricId(fabric->GetCompressedFabricId()).SetNodeId(peer.GetNodeId());
+    node_data.resolutionData.interfaceId = entry->address.GetInterface();
+    node_data.resolutionData.ipAddress[0] = entry->address.GetIPAddress();
+    node_data.resolutionData.numIPs = 1;
+    node_data.resolutionData.port = entry->address.GetPort();
+    /* The lookups of the address resolver are completed by the results of the operational discovery */
+    chip::Dnssd::OperationalResolveDelegate &resolver =
+        static_cast<chip::AddressResolve::Impl::Resolver &>(chip::AddressResolve::Resolver::Instance());
+    resolver.OnOperationalNodeResolved(node_data);
+}
+
+esp_err_t get_address_cache_stats(address_cache_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    *stats = s_address_cache_stats;
+    stats->entries = 0;
+    for (address_cache_entry_t &entry : s_address_cache) {
+        if (entry.valid) {
+            stats->entries++;
+        }
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+
+static retry_policy_t s_default_retry_policy;
+static retry_stats_t s_retry_stats;
+
+typedef struct retry_state {
+    retry_policy_t policy;
+    /* Number of attempts made so far */
+    uint8_t attempts;
+    int64_t start_us;
+} retry_state_t;
+
+static void retry_start(retry_state_t *state, const retry_policy_t *policy)
+{
+    state->policy = policy ? *policy : retry_policy_t{};
+    state->attempts = 1;
+    state->start_us = esp_timer_get_time();
+}
+
+/* Gets the delay before the next attempt after a failed one. Returns false when the command has to be dropped. */
+static bool retry_next(retry_state_t *state, uint32_t *backoff_ms)
+{
+    const retry_policy_t &policy = state->policy;
+    if (state->attempts >= policy.max_attempts) {
+        if (state->attempts > 1) {
+            s_retry_stats.exhausted++;
+        }
+        return false;
+    }
+    uint64_t backoff = policy.initial_backoff_ms;
+    for (uint8_t index = 1; index < state->attempts && (policy.max_backoff_ms == 0 || backoff < policy.max_backoff_ms);
+         index++) {
+        backoff *= 2;
+    }
+    if (policy.max_backoff_ms > 0 && backoff > policy.max_backoff_ms) {
+        backoff = policy.max_backoff_ms;
+    }
+    if (backoff > UINT32_MAX) {
+        backoff = UINT32_MAX;
+    }
+    if (policy.deadline_ms > 0) {
+        uint64_t elapsed_ms = (esp_timer_get_time() - state->start_us) / 1000;
+        if (elapsed_ms + backoff >= policy.deadline_ms) {
+            s_retry_stats.deadline_exceeded++;
+            return false;
+        }
+    }
+    state->attempts++;
+    s_retry_stats.retries++;
+    *backoff_ms = static_cast<uint32_t>(backoff);
+    return true;
+}
+
+static void retry_succeeded(const retry_state_t *state)
+{
+    if (state->attempts > 1) {
+        s_retry_stats.succeeded_after_retry++;
+    }
+}
+
+esp_err_t set_retry_policy(const retry_policy_t *policy)
+{
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    s_default_retry_policy = policy ? *policy : retry_policy_t{};
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+esp_err_t get_retry_stats(retry_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    *stats = s_retry_stats;
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+/* Connection callbacks of a single connect() call. A callback object can only be queued for one session setup at a
+ * time, so concurrent connections need their own. */
+typedef struct connect_context {
+    connect_context(void (*on_success)(void *, ExchangeManager &, const SessionHandle &),
+                    void (*on_failure)(void *, const ScopedNodeId &, CHIP_ERROR), command_handle_t *cmd) :
+        success_callback(on_success, this), failure_callback(on_failure, this), cmd_handle(cmd) {}
+    Callback<chip::OnDeviceConnected> success_callback;
+    Callback<chip::OnDeviceConnectionFailure> failure_callback;
+    command_handle_t cmd_handle;
+    case_session_mgr_t *case_session_mgr = NULL;
+    ScopedNodeId peer;
+    retry_state_t retry = {};
+} connect_context_t;
+
+/* Command contexts come from fixed-size pools, with the heap as a fallback, so that the common case of a few
+ * commands in flight does not allocate anything */
+static object_pool<command_handle_t, CONFIG_ESP_MATTER_CLIENT_COMMAND_POOL_SIZE> s_command_handle_pool;
+static object_pool<connect_context_t, CONFIG_ESP_MATTER_CLIENT_COMMAND_POOL_SIZE> s_connect_context_pool;
+static object_pool<esp_matter::cluster::custom::command::custom_command_callback,
+                   CONFIG_ESP_MATTER_CLIENT_COMMAND_SENDER_POOL_SIZE> s_command_callback_pool;
+static object_pool<chip::app::CommandSender, CONFIG_ESP_MATTER_CLIENT_COMMAND_SENDER_POOL_SIZE> s_command_sender_pool;
+
+static void free_connect_context(intptr_t arg)
+{
+    s_connect_context_pool.destroy(reinterpret_cast<connect_context_t *>(arg));
+}
+
+/* The session setup still walks its callback lists after calling ours, free the context once it is done */
+static void release_connect_context(connect_context_t *context)
+{
+    if (chip::DeviceLayer::PlatformMgr().ScheduleWork(free_connect_context, reinterpret_cast<intptr_t>(context)) !=
+        CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to schedule the release of the connection context");
+    }
+}
+
 esp_err_t set_command_callback(command_callback_t callback, group_command_callback_t g_callback, void *priv_data)
 {
     client_command_callback = callback;
@@ -59,47 +417,208 @@ esp_err_t set_command_callback(command_callback_t callback, group_command_callba
 void esp_matter_connection_success_callback(void *context, ExchangeManager &exchangeMgr,
                                             const SessionHandle &sessionHandle)
 {
-    command_handle_t *cmd_handle = static_cast<command_handle_t *>(context);
-    if (!cmd_handle) {
+    connect_context_t *connect_ctx = static_cast<connect_context_t *>(context);
+    if (!connect_ctx) {
         ESP_LOGE(TAG, "Failed to call connect_success_callback since the command handle is NULL");
         return;
     }
     ESP_LOGI(TAG, "New connection success");
+    retry_succeeded(&connect_ctx->retry);
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+    add_to_pool(sessionHandle);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+    cache_address(sessionHandle);
+#endif
     // Only unicast binding needs to establish the connection
     if (client_command_callback) {
         OperationalDeviceProxy device(&exchangeMgr, sessionHandle);
-        client_command_callback(&device, cmd_handle, command_callback_priv_data);
+        client_command_callback(&device, &connect_ctx->cmd_handle, command_callback_priv_data);
     }
-    chip::Platform::Delete(cmd_handle);
+    release_connect_context(connect_ctx);
+}
+
+static void connect_retry_timer_callback(chip::System::Layer *layer, void *context)
+{
+    connect_context_t *connect_ctx = static_cast<connect_context_t *>(context);
+    connect_ctx->case_session_mgr->FindOrEstablishSession(connect_ctx->peer, &connect_ctx->success_callback,
+                                                          &connect_ctx->failure_callback);
 }
 
 void esp_matter_connection_failure_callback(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
 {
-    command_handle_t *cmd_handle = static_cast<command_handle_t *>(context);
+    connect_context_t *connect_ctx = static_cast<connect_context_t *>(context);
     ESP_LOGI(TAG, "New connection failure");
-    if (cmd_handle) {
-        chip::Platform::Delete(cmd_handle);
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+    s_session_pool_stats.failures++;
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+    invalidate_address(peerId);
+#endif
+    if (!connect_ctx) {
+        return;
+    }
+    uint32_t backoff_ms = 0;
+    if (connect_ctx->case_session_mgr && retry_next(&connect_ctx->retry, &backoff_ms)) {
+        ESP_LOGI(TAG, "Retrying the connection to 0x%016" PRIX64 " in %" PRIu32 " ms, attempt %u",
+                 peerId.GetNodeId(), backoff_ms, connect_ctx->retry.attempts);
+        /* The session setup is done with the callbacks once the timer fires, they can be queued again */
+        if (chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(backoff_ms),
+                                                        connect_retry_timer_callback, connect_ctx) == CHIP_NO_ERROR) {
+            return;
+        }
+        ESP_LOGE(TAG, "Failed to start the retry timer");
     }
+    release_connect_context(connect_ctx);
 }
 
 esp_err_t connect(case_session_mgr_t *case_session_mgr, uint8_t fabric_index, uint64_t node_id,
                   command_handle_t *cmd_handle)
+{
+    return connect(case_session_mgr, fabric_index, node_id, cmd_handle, &s_default_retry_policy);
+}
+
+esp_err_t connect(case_session_mgr_t *case_session_mgr, uint8_t fabric_index, uint64_t node_id,
+                  command_handle_t *cmd_handle, const retry_policy_t *policy)
 {
     if (!case_session_mgr) {
         return ESP_ERR_INVALID_ARG;
     }
-    static Callback<chip::OnDeviceConnected> success_callback(esp_matter_connection_success_callback, NULL);
-    static Callback<chip::OnDeviceConnectionFailure> failure_callback(esp_matter_connection_failure_callback, NULL);
+#if CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
+    sed_poll::on_activity(sed_poll::ACTIVITY_EXCHANGE);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+    session_pool_entry_t *entry = find_pool_entry(ScopedNodeId(node_id, fabric_index));
+    if (entry) {
+        s_session_pool_stats.hits++;
+        entry->last_used_us = esp_timer_get_time();
+        if (client_command_callback) {
+            OperationalDeviceProxy device(&Server::GetInstance().GetExchangeManager(), entry->session.Get().Value());
+            command_handle_t context(cmd_handle);
+            client_command_callback(&device, &context, command_callback_priv_data);
+        }
+        return ESP_OK;
+    }
+    s_session_pool_stats.misses++;
+#endif
 
-    command_handle_t *context = chip::Platform::New<command_handle_t>(cmd_handle);
+    connect_context_t *context = s_connect_context_pool.create(esp_matter_connection_success_callback,
+                                                               esp_matter_connection_failure_callback, cmd_handle);
     if (!context) {
         ESP_LOGE(TAG, "failed to alloc memory for the command handle");
         return ESP_ERR_NO_MEM;
     }
-    success_callback.mContext = static_cast<void *>(context);
-    failure_callback.mContext = static_cast<void *>(context);
-    case_session_mgr->FindOrEstablishSession(ScopedNodeId(node_id, fabric_index), &success_callback,
-                                             &failure_callback);
+    context->case_session_mgr = case_session_mgr;
+    context->peer = ScopedNodeId(node_id, fabric_index);
+    retry_start(&context->retry, policy);
+    case_session_mgr->FindOrEstablishSession(context->peer, &context->success_callback, &context->failure_callback);
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+    resolve_from_cache(ScopedNodeId(node_id, fabric_index));
+#endif
+    return ESP_OK;
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+static void preconnect_success_callback(void *context, ExchangeManager &exchangeMgr,
+                                        const SessionHandle &sessionHandle)
+{
+    add_to_pool(sessionHandle);
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+    cache_address(sessionHandle);
+#endif
+    release_connect_context(static_cast<connect_context_t *>(context));
+}
+
+static void preconnect_failure_callback(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
+{
+    ESP_LOGW(TAG, "Failed to connect to bound peer 0x%016" PRIX64 ": %" CHIP_ERROR_FORMAT, peerId.GetNodeId(),
+             error.Format());
+    s_session_pool_stats.failures++;
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+    invalidate_address(peerId);
+#endif
+    release_connect_context(static_cast<connect_context_t *>(context));
+}
+
+static void preconnect_bound_peers_locked()
+{
+    case_session_mgr_t *case_session_mgr = Server::GetInstance().GetCASESessionManager();
+    for (const EmberBindingTableEntry &binding : chip::BindingTable::GetInstance()) {
+        if (binding.type != MATTER_UNICAST_BINDING) {
+            continue;
+        }
+        ScopedNodeId peer(binding.nodeId, binding.fabricIndex);
+        if (find_pool_entry(peer)) {
+            continue;
+        }
+        command_handle_t cmd_handle;
+        connect_context_t *context = s_connect_context_pool.create(preconnect_success_callback,
+                                                                   preconnect_failure_callback, &cmd_handle);
+        if (!context) {
+            ESP_LOGE(TAG, "failed to alloc memory for the connection context");
+            return;
+        }
+        case_session_mgr->FindOrEstablishSession(peer, &context->success_callback, &context->failure_callback);
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+        resolve_from_cache(peer);
+#endif
+    }
+}
+
+static void preconnect_timer_callback(chip::System::Layer *layer, void *context)
+{
+    preconnect_bound_peers_locked();
+}
+
+esp_err_t preconnect_bound_peers()
+{
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    preconnect_bound_peers_locked();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+esp_err_t get_session_pool_stats(session_pool_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    *stats = s_session_pool_stats;
+    stats->active_sessions = 0;
+    for (session_pool_entry_t &entry : s_session_pool) {
+        if (entry.session) {
+            stats->active_sessions++;
+        }
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+
+esp_err_t get_command_pool_stats(command_pool_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_command_handle_pool.get_stats(&stats->command_handles);
+    s_connect_context_pool.get_stats(&stats->connect_contexts);
+    s_command_callback_pool.get_stats(&stats->command_callbacks);
+    s_command_sender_pool.get_stats(&stats->command_senders);
     return ESP_OK;
 }
 
@@ -117,6 +636,149 @@ esp_err_t group_command_send(uint8_t fabric_index, command_handle_t *cmd_handle)
     return ESP_OK;
 }
 
+#if CONFIG_ESP_MATTER_ENABLE_BINDING_INDEX
+/* Binding table indexes sorted by local endpoint and cluster, the bindings without cluster sort after the others of
+ * their endpoint with kInvalidClusterId. Only accessed with the chip stack lock held. */
+static uint8_t s_binding_index[CONFIG_ESP_MATTER_BINDING_TABLE_SIZE];
+static uint8_t s_binding_index_size = 0;
+static bool s_binding_index_dirty = true;
+
+static uint32_t get_binding_cluster_id(const EmberBindingTableEntry &binding)
+{
+    return binding.clusterId.HasValue() ? binding.clusterId.Value() : chip::kInvalidClusterId;
+}
+
+static bool binding_key_less(const EmberBindingTableEntry &binding, uint16_t local_endpoint_id, uint32_t cluster_id)
+{
+    return binding.local < local_endpoint_id ||
+        (binding.local == local_endpoint_id && get_binding_cluster_id(binding) < cluster_id);
+}
+
+static void rebuild_binding_index()
+{
+    chip::BindingTable &table = chip::BindingTable::GetInstance();
+    s_binding_index_size = 0;
+    for (auto iter = table.begin(); iter != table.end() && s_binding_index_size < CONFIG_ESP_MATTER_BINDING_TABLE_SIZE;
+         ++iter) {
+        /* Insertion sort, the table is small and is only indexed again when it changes */
+        uint8_t table_index = iter.GetIndex();
+        uint8_t pos = s_binding_index_size++;
+        while (pos > 0 && binding_key_less(*iter, table.GetAt(s_binding_index[pos - 1]).local,
+                                           get_binding_cluster_id(table.GetAt(s_binding_index[pos - 1])))) {
+            s_binding_index[pos] = s_binding_index[pos - 1];
+            pos--;
+        }
+        s_binding_index[pos] = table_index;
+    }
+    s_binding_index_dirty = false;
+}
+
+/* Calls the visitor for the bindings of a local endpoint which match a cluster, the bindings without cluster
+ * included */
+template <typename visitor_t>
+static void for_each_binding(uint16_t local_endpoint_id, uint32_t cluster_id, visitor_t visitor)
+{
+    if (s_binding_index_dirty) {
+        rebuild_binding_index();
+    }
+    chip::BindingTable &table = chip::BindingTable::GetInstance();
+    uint32_t keys[2] = {cluster_id, chip::kInvalidClusterId};
+    for (uint8_t key = 0; key < (cluster_id == chip::kInvalidClusterId ? 1 : 2); key++) {
+        uint8_t low = 0, high = s_binding_index_size;
+        while (low < high) {
+            uint8_t mid = low + (high - low) / 2;
+            if (binding_key_less(table.GetAt(s_binding_index[mid]), local_endpoint_id, keys[key])) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        for (; low < s_binding_index_size; low++) {
+            const EmberBindingTableEntry &binding = table.GetAt(s_binding_index[low]);
+            if (binding.local != local_endpoint_id || get_binding_cluster_id(binding) != keys[key]) {
+                break;
+            }
+            visitor(binding);
+        }
+    }
+}
+
+/* Bindings are stored through the storage given to the binding manager, their keys tell when the index is stale */
+class binding_storage_observer : public chip::PersistentStorageDelegate {
+public:
+    void set_storage(chip::PersistentStorageDelegate *storage) { m_storage = storage; }
+
+    CHIP_ERROR SyncGetKeyValue(const char *key, void *buffer, uint16_t &size)
+    {
+        return m_storage->SyncGetKeyValue(key, buffer, size);
+    }
+
+    CHIP_ERROR SyncSetKeyValue(const char *key, const void *value, uint16_t size)
+    {
+        check_key(key);
+        return m_storage->SyncSetKeyValue(key, value, size);
+    }
+
+    CHIP_ERROR SyncDeleteKeyValue(const char *key)
+    {
+        check_key(key);
+        return m_storage->SyncDeleteKeyValue(key);
+    }
+
+private:
+    void check_key(const char *key)
+    {
+        const char *prefix = chip::DefaultStorageKeyAllocator::BindingTable().KeyName();
+        if (strncmp(key, prefix, strlen(prefix)) == 0) {
+            s_binding_index_dirty = true;
+        }
+    }
+
+    chip::PersistentStorageDelegate *m_storage = nullptr;
+};
+
+static binding_storage_observer s_binding_storage_observer;
+#else
+template <typename visitor_t>
+static void for_each_binding(uint16_t local_endpoint_id, uint32_t cluster_id, visitor_t visitor)
+{
+    for (const EmberBindingTableEntry &binding : chip::BindingTable::GetInstance()) {
+        if (binding.local != local_endpoint_id ||
+            (binding.clusterId.HasValue() && binding.clusterId.Value() != cluster_id)) {
+            continue;
+        }
+        visitor(binding);
+    }
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_BINDING_INDEX
+
+esp_err_t get_binding_count(uint16_t local_endpoint_id, uint32_t cluster_id, uint16_t *unicast_count,
+                            uint16_t *group_count)
+{
+    if (!unicast_count || !group_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    *unicast_count = 0;
+    *group_count = 0;
+    for_each_binding(local_endpoint_id, cluster_id, [&](const EmberBindingTableEntry &binding) {
+        if (binding.type == MATTER_UNICAST_BINDING) {
+            (*unicast_count)++;
+        } else if (binding.type == MATTER_MULTICAST_BINDING) {
+            (*group_count)++;
+        }
+    });
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
 static void esp_matter_command_client_binding_callback(const EmberBindingTableEntry &binding,
                                                        OperationalDeviceProxy *peer_device, void *context)
 {
@@ -126,6 +788,12 @@ static void esp_matter_command_client_binding_callback(const EmberBindingTableEn
         return;
     }
     if (binding.type == MATTER_UNICAST_BINDING && peer_device) {
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+        chip::Optional<SessionHandle> session = peer_device->GetSecureSession();
+        if (session.HasValue()) {
+            add_to_pool(session.Value());
+        }
+#endif
         if (client_command_callback) {
             cmd_handle->endpoint_id = binding.remote;
             client_command_callback(peer_device, cmd_handle, command_callback_priv_data);
@@ -141,13 +809,47 @@ static void esp_matter_command_client_binding_callback(const EmberBindingTableEn
 static void esp_matter_binding_context_release(void *context)
 {
     if (context) {
-        chip::Platform::Delete(static_cast<command_handle_t *>(context));
+        s_command_handle_pool.destroy(static_cast<command_handle_t *>(context));
     }
 }
 
 esp_err_t cluster_update(uint16_t local_endpoint_id, command_handle_t *cmd_handle)
 {
-    command_handle_t *context = chip::Platform::New<command_handle_t>(cmd_handle);
+#if CONFIG_ESP_MATTER_ENABLE_BINDING_INDEX
+    if (!cmd_handle) {
+        ESP_LOGE(TAG, "command handle is null");
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    /* Only the bindings of the endpoint and cluster are visited, instead of the whole binding table */
+    esp_err_t err = ESP_OK;
+    case_session_mgr_t *case_session_mgr = Server::GetInstance().GetCASESessionManager();
+    for_each_binding(local_endpoint_id, cmd_handle->cluster_id, [&](const EmberBindingTableEntry &binding) {
+        command_handle_t binding_cmd_handle(cmd_handle);
+        if (binding.type == MATTER_UNICAST_BINDING) {
+            binding_cmd_handle.endpoint_id = binding.remote;
+            esp_err_t connect_err = connect(case_session_mgr, binding.fabricIndex, binding.nodeId,
+                                            &binding_cmd_handle);
+            err = err == ESP_OK ? connect_err : err;
+        } else if (binding.type == MATTER_MULTICAST_BINDING && client_group_command_callback) {
+            binding_cmd_handle.group_id = binding.groupId;
+            client_group_command_callback(binding.fabricIndex, &binding_cmd_handle, command_callback_priv_data);
+        }
+    });
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "failed to notify the bound cluster changed");
+    }
+    return err;
+#else
+    command_handle_t *context = s_command_handle_pool.create(cmd_handle);
     if (!context) {
         ESP_LOGE(TAG, "failed to alloc memory for the command handle");
         return ESP_ERR_NO_MEM;
@@ -155,26 +857,39 @@ esp_err_t cluster_update(uint16_t local_endpoint_id, command_handle_t *cmd_handl
     if (CHIP_NO_ERROR !=
         chip::BindingManager::GetInstance().NotifyBoundClusterChanged(local_endpoint_id, cmd_handle->cluster_id,
                                                                       static_cast<void *>(context))) {
-        chip::Platform::Delete(context);
+        s_command_handle_pool.destroy(context);
         ESP_LOGE(TAG, "failed to notify the bound cluster changed");
         return ESP_FAIL;
     }
 
     return ESP_OK;
+#endif // CONFIG_ESP_MATTER_ENABLE_BINDING_INDEX
 }
 
 static void __binding_manager_init(intptr_t arg)
 {
     auto &server = chip::Server::GetInstance();
+#if CONFIG_ESP_MATTER_ENABLE_BINDING_INDEX
+    s_binding_storage_observer.set_storage(&server.GetPersistentStorage());
+    s_binding_index_dirty = true;
+#endif
     struct chip::BindingManagerInitParams binding_init_params = {
         .mFabricTable = &server.GetFabricTable(),
         .mCASESessionManager = server.GetCASESessionManager(),
+#if CONFIG_ESP_MATTER_ENABLE_BINDING_INDEX
+        .mStorage = &s_binding_storage_observer,
+#else
         .mStorage = &server.GetPersistentStorage(),
+#endif
     };
 
     chip::BindingManager::GetInstance().Init(binding_init_params);
     chip::BindingManager::GetInstance().RegisterBoundDeviceChangedHandler(esp_matter_command_client_binding_callback);
     chip::BindingManager::GetInstance().RegisterBoundDeviceContextReleaseHandler(esp_matter_binding_context_release);
+#if CONFIG_ESP_MATTER_CLIENT_SESSION_POOL_PRECONNECT
+    chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Seconds32(k_preconnect_delay_s),
+                                                preconnect_timer_callback, NULL);
+#endif
 }
 
 void binding_manager_init()
@@ -189,6 +904,277 @@ void binding_init()
 {
     initialize_binding_manager = true;
 }
+
+typedef enum fan_out_peer_state {
+    FAN_OUT_PEER_PENDING,
+    FAN_OUT_PEER_CONNECTING,
+    /* Waiting for the next attempt, the peer still counts as in flight */
+    FAN_OUT_PEER_BACKOFF,
+    FAN_OUT_PEER_FINISHED,
+} fan_out_peer_state_t;
+
+struct fan_out_job;
+
+typedef struct fan_out_peer {
+    fan_out_peer() : success_callback(NULL, this), failure_callback(NULL, this) {}
+    Callback<chip::OnDeviceConnected> success_callback;
+    Callback<chip::OnDeviceConnectionFailure> failure_callback;
+    struct fan_out_job *job;
+    ScopedNodeId peer;
+    uint16_t remote_endpoint_id;
+    fan_out_peer_state_t state;
+    retry_state_t retry;
+} fan_out_peer_t;
+
+typedef struct fan_out_job {
+    command_handle_t cmd_handle;
+    fan_out_config_t config;
+    retry_policy_t retry_policy;
+    fan_out_done_callback_t done_callback;
+    void *priv_data;
+    fan_out_result_t result;
+    fan_out_peer_t *peers;
+    size_t next_peer;
+    size_t in_flight;
+    bool done;
+} fan_out_job_t;
+
+static void free_fan_out_job(intptr_t arg)
+{
+    fan_out_job_t *job = reinterpret_cast<fan_out_job_t *>(arg);
+    if (job->peers) {
+        for (size_t index = 0; index < job->result.unicast_count; index++) {
+            job->peers[index].~fan_out_peer_t();
+        }
+        esp_matter_mem_free(job->peers);
+    }
+    chip::Platform::Delete(job);
+}
+
+static void fan_out_start_next(fan_out_job_t *job);
+
+/* Called once a peer has been handled. from_connection_callback is set when called from a connection callback, the
+ * session setup still walks its callback lists afterwards so the job cannot be freed right away. */
+static void fan_out_peer_finished(fan_out_job_t *job, bool from_connection_callback)
+{
+    fan_out_start_next(job);
+    if (job->done || job->in_flight > 0 || job->next_peer < job->result.unicast_count) {
+        return;
+    }
+    job->done = true;
+    if (job->done_callback) {
+        job->done_callback(&job->result, job->priv_data);
+    }
+    if (!from_connection_callback) {
+        free_fan_out_job(reinterpret_cast<intptr_t>(job));
+    } else if (chip::DeviceLayer::PlatformMgr().ScheduleWork(free_fan_out_job, reinterpret_cast<intptr_t>(job)) !=
+               CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to schedule the release of the fan-out job");
+    }
+}
+
+static void fan_out_send(fan_out_peer_t *peer, ExchangeManager &exchange_mgr, const SessionHandle &session_handle)
+{
+    if (client_command_callback) {
+        OperationalDeviceProxy device(&exchange_mgr, session_handle);
+        command_handle_t cmd_handle(&peer->job->cmd_handle);
+        cmd_handle.endpoint_id = peer->remote_endpoint_id;
+        client_command_callback(&device, &cmd_handle, command_callback_priv_data);
+    }
+}
+
+static void fan_out_timeout_callback(chip::System::Layer *layer, void *context);
+
+static void fan_out_connect(fan_out_peer_t *peer)
+{
+    peer->state = FAN_OUT_PEER_CONNECTING;
+    uint32_t timeout_ms = peer->job->config.peer_timeout_ms;
+    if (timeout_ms > 0) {
+        chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(timeout_ms),
+                                                    fan_out_timeout_callback, peer);
+    }
+    /* The callbacks may be called right away if the session is already established */
+    Server::GetInstance().GetCASESessionManager()->FindOrEstablishSession(peer->peer, &peer->success_callback,
+                                                                          &peer->failure_callback);
+}
+
+static void fan_out_retry_timer_callback(chip::System::Layer *layer, void *context)
+{
+    fan_out_peer_t *peer = static_cast<fan_out_peer_t *>(context);
+    if (peer->state == FAN_OUT_PEER_BACKOFF) {
+        fan_out_connect(peer);
+    }
+}
+
+/* Returns true if another attempt is scheduled for the peer */
+static bool fan_out_retry(fan_out_peer_t *peer)
+{
+    uint32_t backoff_ms = 0;
+    if (!retry_next(&peer->retry, &backoff_ms)) {
+        return false;
+    }
+    if (chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(backoff_ms),
+                                                    fan_out_retry_timer_callback, peer) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the retry timer");
+        return false;
+    }
+    peer->state = FAN_OUT_PEER_BACKOFF;
+    return true;
+}
+
+static void fan_out_timeout_callback(chip::System::Layer *layer, void *context)
+{
+    fan_out_peer_t *peer = static_cast<fan_out_peer_t *>(context);
+    if (peer->state != FAN_OUT_PEER_CONNECTING) {
+        return;
+    }
+    ESP_LOGW(TAG, "Connection to peer 0x%016" PRIX64 " timed out", peer->peer.GetNodeId());
+    /* Dequeue the callbacks from the session setup, which may still complete for other users */
+    peer->success_callback.Cancel();
+    peer->failure_callback.Cancel();
+    if (fan_out_retry(peer)) {
+        return;
+    }
+    peer->state = FAN_OUT_PEER_FINISHED;
+    peer->job->in_flight--;
+    peer->job->result.timed_out++;
+    fan_out_peer_finished(peer->job, false);
+}
+
+static void fan_out_success_callback(void *context, ExchangeManager &exchange_mgr, const SessionHandle &session_handle)
+{
+    fan_out_peer_t *peer = static_cast<fan_out_peer_t *>(context);
+    chip::DeviceLayer::SystemLayer().CancelTimer(fan_out_timeout_callback, peer);
+    if (peer->state != FAN_OUT_PEER_CONNECTING) {
+        return;
+    }
+    peer->state = FAN_OUT_PEER_FINISHED;
+    peer->job->in_flight--;
+    peer->job->result.succeeded++;
+    retry_succeeded(&peer->retry);
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+    add_to_pool(session_handle);
+#endif
+    fan_out_send(peer, exchange_mgr, session_handle);
+    fan_out_peer_finished(peer->job, true);
+}
+
+static void fan_out_failure_callback(void *context, const ScopedNodeId &peer_id, CHIP_ERROR error)
+{
+    fan_out_peer_t *peer = static_cast<fan_out_peer_t *>(context);
+    chip::DeviceLayer::SystemLayer().CancelTimer(fan_out_timeout_callback, peer);
+    if (peer->state != FAN_OUT_PEER_CONNECTING) {
+        return;
+    }
+    ESP_LOGW(TAG, "Connection to peer 0x%016" PRIX64 " failed: %" CHIP_ERROR_FORMAT, peer_id.GetNodeId(),
+             error.Format());
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+    s_session_pool_stats.failures++;
+#endif
+    if (fan_out_retry(peer)) {
+        return;
+    }
+    peer->state = FAN_OUT_PEER_FINISHED;
+    peer->job->in_flight--;
+    peer->job->result.failed++;
+    fan_out_peer_finished(peer->job, true);
+}
+
+static void fan_out_start_next(fan_out_job_t *job)
+{
+    while (job->in_flight < job->config.max_concurrency && job->next_peer < job->result.unicast_count) {
+        fan_out_peer_t *peer = &job->peers[job->next_peer++];
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+        session_pool_entry_t *entry = find_pool_entry(peer->peer);
+        if (entry) {
+            s_session_pool_stats.hits++;
+            entry->last_used_us = esp_timer_get_time();
+            peer->state = FAN_OUT_PEER_FINISHED;
+            job->result.succeeded++;
+            fan_out_send(peer, Server::GetInstance().GetExchangeManager(), entry->session.Get().Value());
+            continue;
+        }
+        s_session_pool_stats.misses++;
+#endif
+        job->in_flight++;
+        retry_start(&peer->retry, &job->retry_policy);
+        fan_out_connect(peer);
+    }
+}
+
+esp_err_t cluster_update_fan_out(uint16_t local_endpoint_id, command_handle_t *cmd_handle,
+                                 const fan_out_config_t *config, fan_out_done_callback_t done_callback,
+                                 void *priv_data)
+{
+    if (!cmd_handle || !config || config->max_concurrency == 0) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    size_t unicast_count = 0;
+    fan_out_job_t *job = chip::Platform::New<fan_out_job_t>();
+    if (!job) {
+        ESP_LOGE(TAG, "Couldn't allocate the fan-out job");
+        err = ESP_ERR_NO_MEM;
+        goto exit;
+    }
+    job->cmd_handle = command_handle_t(cmd_handle);
+    job->config = *config;
+    job->retry_policy = config->retry_policy ? *config->retry_policy : s_default_retry_policy;
+    job->config.retry_policy = NULL;
+    job->done_callback = done_callback;
+    job->priv_data = priv_data;
+
+    /* Group bindings do not need a session, send to them right away */
+    for_each_binding(local_endpoint_id, cmd_handle->cluster_id, [&](const EmberBindingTableEntry &binding) {
+        if (binding.type == MATTER_UNICAST_BINDING) {
+            unicast_count++;
+        } else if (binding.type == MATTER_MULTICAST_BINDING) {
+            job->result.group_count++;
+            if (client_group_command_callback) {
+                command_handle_t group_cmd_handle(cmd_handle);
+                group_cmd_handle.group_id = binding.groupId;
+                client_group_command_callback(binding.fabricIndex, &group_cmd_handle, command_callback_priv_data);
+            }
+        }
+    });
+    if (unicast_count > 0) {
+        job->peers = static_cast<fan_out_peer_t *>(esp_matter_mem_calloc(unicast_count, sizeof(fan_out_peer_t)));
+        if (!job->peers) {
+            ESP_LOGE(TAG, "Couldn't allocate the fan-out peers");
+            chip::Platform::Delete(job);
+            err = ESP_ERR_NO_MEM;
+            goto exit;
+        }
+        size_t peer_index = 0;
+        for_each_binding(local_endpoint_id, cmd_handle->cluster_id, [&](const EmberBindingTableEntry &binding) {
+            if (binding.type != MATTER_UNICAST_BINDING) {
+                return;
+            }
+            fan_out_peer_t *peer = new (&job->peers[peer_index++]) fan_out_peer_t();
+            peer->success_callback.mCall = fan_out_success_callback;
+            peer->failure_callback.mCall = fan_out_failure_callback;
+            peer->job = job;
+            peer->peer = ScopedNodeId(binding.nodeId, binding.fabricIndex);
+            peer->remote_endpoint_id = binding.remote;
+            peer->state = FAN_OUT_PEER_PENDING;
+        });
+    }
+    job->result.unicast_count = unicast_count;
+    fan_out_peer_finished(job, false);
+
+exit:
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
 } // namespace client
 
 #if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
@@ -212,10 +1198,32 @@ using command_data_tag = chip::app::CommandDataIB::Tag;
 using chip::TLV::ContextTag;
 using chip::TLV::TLVWriter;
 
-esp_err_t send_command(void *ctx, peer_device_t *remote_device, const CommandPathParams &command_path,
-                       const char *command_data_json_str, custom_command_callback::on_success_callback_t on_success,
-                       custom_command_callback::on_error_callback_t on_error,
-                       const Optional<uint16_t> &timed_invoke_timeout_ms, const Optional<Timeout> &response_timeout)
+/* Write the command data from its JSON string, or copy it from its TLV encoding if command_data_json_str is NULL */
+static esp_err_t write_command_data(TLVWriter &writer, const char *command_data_json_str,
+                                    const chip::TLV::TLVReader *command_data)
+{
+    if (command_data_json_str) {
+        return json_to_tlv(command_data_json_str, writer, ContextTag(command_data_tag::kFields));
+    }
+    if (!command_data) {
+        ESP_LOGE(TAG, "No command data");
+        return ESP_ERR_INVALID_ARG;
+    }
+    chip::TLV::TLVReader reader;
+    reader.Init(*command_data);
+    if (writer.CopyElement(ContextTag(command_data_tag::kFields), reader) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to copy the command data");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t send_command_internal(void *ctx, peer_device_t *remote_device, const CommandPathParams &command_path,
+                                       const char *command_data_json_str, const chip::TLV::TLVReader *command_data,
+                                       custom_command_callback::on_success_callback_t on_success,
+                                       custom_command_callback::on_error_callback_t on_error,
+                                       const Optional<uint16_t> &timed_invoke_timeout_ms,
+                                       const Optional<Timeout> &response_timeout)
 {
     if (!remote_device->GetSecureSession().HasValue() || remote_device->GetSecureSession().Value()->IsGroupSession()) {
         ESP_LOGE(TAG, "Invalid Session Type");
@@ -225,18 +1233,18 @@ esp_err_t send_command(void *ctx, peer_device_t *remote_device, const CommandPat
         ESP_LOGE(TAG, "Invalid CommandPathFlags");
         return ESP_ERR_INVALID_ARG;
     }
-    auto decoder = chip::Platform::MakeUnique<custom_command_callback>(ctx, on_success, on_error);
+    auto decoder = client::s_command_callback_pool.make_unique(ctx, on_success, on_error);
     if (decoder == nullptr) {
         ESP_LOGE(TAG, "No memory for command callback");
         return ESP_ERR_NO_MEM;
     }
     auto on_done = [raw_decoder_ptr = decoder.get()](void *context, CommandSender *command_sender) {
-        chip::Platform::Delete(command_sender);
-        chip::Platform::Delete(raw_decoder_ptr);
+        client::s_command_sender_pool.destroy(command_sender);
+        client::s_command_callback_pool.destroy(raw_decoder_ptr);
     };
     decoder->set_on_done_callback(on_done);
 
-    auto command_sender = chip::Platform::MakeUnique<CommandSender>(decoder.get(), remote_device->GetExchangeManager(),
+    auto command_sender = client::s_command_sender_pool.make_unique(decoder.get(), remote_device->GetExchangeManager(),
                                                                     timed_invoke_timeout_ms.HasValue());
     if (command_sender == nullptr) {
         ESP_LOGE(TAG, "No memory for command sender");
@@ -251,7 +1259,7 @@ esp_err_t send_command(void *ctx, peer_device_t *remote_device, const CommandPat
         ESP_LOGE(TAG, "No TLV writer in command sender");
         return ESP_ERR_INVALID_STATE;
     }
-    esp_err_t err = json_to_tlv(command_data_json_str, *writer, ContextTag(command_data_tag::kFields));
+    esp_err_t err = write_command_data(*writer, command_data_json_str, command_data);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to convert json string to TLV");
         return err;
@@ -270,8 +1278,9 @@ esp_err_t send_command(void *ctx, peer_device_t *remote_device, const CommandPat
     return ESP_OK;
 }
 
-esp_err_t send_group_command(const uint8_t fabric_index, const CommandPathParams &command_path,
-                             const char *command_data_json_str)
+static esp_err_t send_group_command_internal(const uint8_t fabric_index, const CommandPathParams &command_path,
+                                             const char *command_data_json_str,
+                                             const chip::TLV::TLVReader *command_data)
 {
     if (!command_path.mFlags.Has(chip::app::CommandPathFlags::kGroupIdValid)) {
         ESP_LOGE(TAG, "Invalid CommandPathFlags");
@@ -279,7 +1288,7 @@ esp_err_t send_group_command(const uint8_t fabric_index, const CommandPathParams
     }
     chip::Transport::OutgoingGroupSession session(command_path.mGroupId, fabric_index);
     chip::Messaging::ExchangeManager *exchange_mgr = chip::app::InteractionModelEngine::GetInstance()->GetExchangeManager();
-    auto command_sender = chip::Platform::MakeUnique<chip::app::CommandSender>(nullptr, exchange_mgr);
+    auto command_sender = client::s_command_sender_pool.make_unique(nullptr, exchange_mgr);
     if (command_sender == nullptr) {
         ESP_LOGE(TAG, "No memory for command sender");
         return ESP_ERR_NO_MEM;
@@ -293,7 +1302,7 @@ esp_err_t send_group_command(const uint8_t fabric_index, const CommandPathParams
         ESP_LOGE(TAG, "No TLV writer in command sender");
         return ESP_ERR_INVALID_STATE;
     }
-    esp_err_t err = json_to_tlv(command_data_json_str, *writer, ContextTag(command_data_tag::kFields));
+    esp_err_t err = write_command_data(*writer, command_data_json_str, command_data);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to convert json string to TLV");
         return err;
@@ -308,6 +1317,246 @@ esp_err_t send_group_command(const uint8_t fabric_index, const CommandPathParams
     }
     return ESP_OK;
 }
+
+esp_err_t send_command(void *ctx, peer_device_t *remote_device, const CommandPathParams &command_path,
+                       const char *command_data_json_str, custom_command_callback::on_success_callback_t on_success,
+                       custom_command_callback::on_error_callback_t on_error,
+                       const Optional<uint16_t> &timed_invoke_timeout_ms, const Optional<Timeout> &response_timeout)
+{
+    return send_command_internal(ctx, remote_device, command_path, command_data_json_str, nullptr, on_success,
+                                 on_error, timed_invoke_timeout_ms, response_timeout);
+}
+
+esp_err_t send_command(void *ctx, peer_device_t *remote_device, const CommandPathParams &command_path,
+                       const chip::TLV::TLVReader &command_data,
+                       custom_command_callback::on_success_callback_t on_success,
+                       custom_command_callback::on_error_callback_t on_error,
+                       const Optional<uint16_t> &timed_invoke_timeout_ms, const Optional<Timeout> &response_timeout)
+{
+    return send_command_internal(ctx, remote_device, command_path, nullptr, &command_data, on_success, on_error,
+                                 timed_invoke_timeout_ms, response_timeout);
+}
+
+esp_err_t send_group_command(const uint8_t fabric_index, const CommandPathParams &command_path,
+                             const char *command_data_json_str)
+{
+    return send_group_command_internal(fabric_index, command_path, command_data_json_str, nullptr);
+}
+
+esp_err_t send_group_command(const uint8_t fabric_index, const CommandPathParams &command_path,
+                             const chip::TLV::TLVReader &command_data)
+{
+    return send_group_command_internal(fabric_index, command_path, nullptr, &command_data);
+}
+
+/* Dispatches the responses of a batched InvokeRequest to the callbacks of the commands, using the command ref */
+class batch_command_callback final : public CommandSender::ExtendableCallback {
+public:
+    batch_command_callback(void *ctx, command_batch::on_error_callback_t on_error) : on_error_cb(on_error),
+        context(ctx) {}
+
+    command_batch::on_response_callback_t on_response_cb[command_batch::k_max_commands];
+    /* Paths of the commands, for the ones without a response */
+    uint16_t endpoint_ids[command_batch::k_max_commands];
+    uint32_t cluster_ids[command_batch::k_max_commands];
+    uint32_t command_ids[command_batch::k_max_commands];
+    bool responded[command_batch::k_max_commands] = {};
+    size_t count = 0;
+
+private:
+    void OnResponse(CommandSender *command_sender, const CommandSender::ResponseData &response_data) override
+    {
+        /* A single command is sent without a command ref */
+        uint16_t command_ref = response_data.commandRef.ValueOr(0);
+        if (command_ref >= count || responded[command_ref]) {
+            return;
+        }
+        responded[command_ref] = true;
+        if (on_response_cb[command_ref]) {
+            on_response_cb[command_ref](context, response_data.path, response_data.statusIB, response_data.data);
+        }
+    }
+
+    void OnNoResponse(CommandSender *command_sender, const CommandSender::NoResponseData &no_response_data) override
+    {
+        uint16_t command_ref = no_response_data.commandRef;
+        if (command_ref >= count || responded[command_ref]) {
+            return;
+        }
+        responded[command_ref] = true;
+        if (on_response_cb[command_ref]) {
+            chip::app::ConcreteCommandPath path(endpoint_ids[command_ref], cluster_ids[command_ref],
+                                                command_ids[command_ref]);
+            on_response_cb[command_ref](context, path, StatusIB(chip::Protocols::InteractionModel::Status::Failure),
+                                        nullptr);
+        }
+    }
+
+    void OnError(const CommandSender *command_sender, const CommandSender::ErrorData &error_data) override
+    {
+        if (error_reported) {
+            return;
+        }
+        error_reported = true;
+        if (on_error_cb) {
+            on_error_cb(context, error_data.error);
+        }
+    }
+
+    void OnDone(CommandSender *command_sender) override
+    {
+        bool all_responded = true;
+        for (size_t index = 0; index < count; index++) {
+            all_responded = all_responded && responded[index];
+        }
+        if (!all_responded) {
+            OnError(command_sender, CommandSender::ErrorData{CHIP_END_OF_TLV});
+        }
+        client::s_command_sender_pool.destroy(command_sender);
+        chip::Platform::Delete(this);
+    }
+
+    command_batch::on_error_callback_t on_error_cb;
+    bool error_reported = false;
+    void *context;
+};
+
+command_batch::entry_t *command_batch::new_entry(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                                                 on_response_callback_t on_response)
+{
+    if (m_count >= k_max_commands) {
+        ESP_LOGE(TAG, "Command batch is full");
+        return NULL;
+    }
+    entry_t *entry = &m_entries[m_count++];
+    entry->endpoint_id = endpoint_id;
+    entry->cluster_id = cluster_id;
+    entry->command_id = command_id;
+    entry->on_response = on_response;
+    entry->data_len = 0;
+    return entry;
+}
+
+esp_err_t command_batch::add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                             const char *command_data_json_str, on_response_callback_t on_response)
+{
+    entry_t *entry = new_entry(endpoint_id, cluster_id, command_id, on_response);
+    if (!entry) {
+        return ESP_ERR_NO_MEM;
+    }
+    TLVWriter writer;
+    writer.Init(entry->data, sizeof(entry->data));
+    esp_err_t err = json_to_tlv(command_data_json_str, writer, chip::TLV::AnonymousTag());
+    if (err != ESP_OK || writer.Finalize() != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to convert json string to TLV");
+        m_count--;
+        return err != ESP_OK ? err : ESP_ERR_INVALID_SIZE;
+    }
+    entry->data_len = writer.GetLengthWritten();
+    return ESP_OK;
+}
+
+esp_err_t command_batch::send_chunk(void *ctx, peer_device_t *remote_device, size_t start, size_t count,
+                                    uint16_t max_paths_per_invoke, on_error_callback_t on_error,
+                                    const Optional<uint16_t> &timed_invoke_timeout_ms,
+                                    const Optional<Timeout> &response_timeout)
+{
+    auto callback = chip::Platform::MakeUnique<batch_command_callback>(ctx, on_error);
+    if (callback == nullptr) {
+        ESP_LOGE(TAG, "No memory for command callback");
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t index = 0; index < count; index++) {
+        const entry_t &entry = m_entries[start + index];
+        callback->on_response_cb[index] = entry.on_response;
+        callback->endpoint_ids[index] = entry.endpoint_id;
+        callback->cluster_ids[index] = entry.cluster_id;
+        callback->command_ids[index] = entry.command_id;
+        callback->count++;
+    }
+    auto command_sender = client::s_command_sender_pool.make_unique(callback.get(), remote_device->GetExchangeManager(),
+                                                                    timed_invoke_timeout_ms.HasValue());
+    if (command_sender == nullptr) {
+        ESP_LOGE(TAG, "No memory for command sender");
+        return ESP_ERR_NO_MEM;
+    }
+    bool batched = count > 1;
+    if (batched) {
+        CommandSender::ConfigParameters config;
+        config.SetRemoteMaxPathsPerInvoke(max_paths_per_invoke);
+        if (command_sender->SetCommandSenderConfig(config) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to configure the command sender for %u commands", (unsigned)count);
+            return ESP_FAIL;
+        }
+    }
+    for (size_t index = 0; index < count; index++) {
+        const entry_t &entry = m_entries[start + index];
+        CommandPathParams command_path(entry.endpoint_id, 0, entry.cluster_id, entry.command_id,
+                                       chip::app::CommandPathFlags::kEndpointIdValid);
+        CommandSender::PrepareCommandParameters prepare_params;
+        prepare_params.SetStartDataStruct(false);
+        if (batched) {
+            prepare_params.SetCommandRef(index);
+        }
+        if (command_sender->PrepareCommand(command_path, prepare_params) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to prepare command");
+            return ESP_FAIL;
+        }
+        TLVWriter *writer = command_sender->GetCommandDataIBTLVWriter();
+        if (writer == nullptr) {
+            ESP_LOGE(TAG, "No TLV writer in command sender");
+            return ESP_ERR_INVALID_STATE;
+        }
+        chip::TLV::TLVReader reader;
+        reader.Init(entry.data, entry.data_len);
+        if (reader.Next() != CHIP_NO_ERROR ||
+            writer->CopyElement(ContextTag(command_data_tag::kFields), reader) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to write the command data");
+            return ESP_FAIL;
+        }
+        CommandSender::FinishCommandParameters finish_params(timed_invoke_timeout_ms);
+        finish_params.SetEndDataStruct(false);
+        if (batched) {
+            finish_params.SetCommandRef(index);
+        }
+        if (command_sender->FinishCommand(finish_params) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to finish command");
+            return ESP_FAIL;
+        }
+    }
+    if (command_sender->SendCommandRequest(remote_device->GetSecureSession().Value(), response_timeout) !=
+        CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to send command request");
+        return ESP_FAIL;
+    }
+    /* Both are deleted by the callback once the InvokeRequest is done */
+    (void)callback.release();
+    (void)command_sender.release();
+    return ESP_OK;
+}
+
+esp_err_t command_batch::send(void *ctx, peer_device_t *remote_device, uint16_t max_paths_per_invoke,
+                              on_error_callback_t on_error, const Optional<uint16_t> &timed_invoke_timeout_ms,
+                              const Optional<Timeout> &response_timeout)
+{
+    if (!remote_device || !remote_device->GetSecureSession().HasValue() ||
+        remote_device->GetSecureSession().Value()->IsGroupSession()) {
+        ESP_LOGE(TAG, "Invalid Session Type");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (m_count == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    size_t chunk_size = max_paths_per_invoke > 1 ? max_paths_per_invoke : 1;
+    esp_err_t err = ESP_OK;
+    for (size_t start = 0; start < m_count && err == ESP_OK; start += chunk_size) {
+        size_t count = m_count - start < chunk_size ? m_count - start : chunk_size;
+        err = send_chunk(ctx, remote_device, start, count, max_paths_per_invoke, on_error, timed_invoke_timeout_ms,
+                         response_timeout);
+    }
+    m_count = 0;
+    return err;
+}
 } // namespace command
 } // namespace custom
 
@@ -105,6 +105,124 @@ esp_err_t send_command(void *ctx, peer_device_t *remote_device, const CommandPat
 esp_err_t send_group_command(const uint8_t fabric_index, const CommandPathParams &command_path,
                              const char *command_data_json_str);
 
+/** Send a command with its data already TLV encoded
+ *
+ * The command data is copied from the reader, which must be positioned on an anonymous structure holding the command
+ * fields, so that a command encoded once can be sent several times without converting a JSON string again.
+ */
+esp_err_t send_command(void *ctx, peer_device_t *remote_device, const CommandPathParams &command_path,
+                       const chip::TLV::TLVReader &command_data,
+                       custom_command_callback::on_success_callback_t on_success,
+                       custom_command_callback::on_error_callback_t on_error,
+                       const Optional<uint16_t> &timed_invoke_timeout_ms,
+                       const Optional<Timeout> &response_timeout = chip::NullOptional);
+
+/** Send a group command with its data already TLV encoded, see `send_command()` */
+esp_err_t send_group_command(const uint8_t fabric_index, const CommandPathParams &command_path,
+                             const chip::TLV::TLVReader &command_data);
+
+/** Command batch
+ *
+ * Builder packing several commands to the same peer in a single InvokeRequest, with a response callback per
+ * command. Peers which support batched commands report it with the MaxPathsPerInvoke attribute of the Basic
+ * Information cluster. If the batch has more commands than that, it is split in several InvokeRequests.
+ *
+ * The command data is encoded when the command is added, so the JSON string or the request object do not need to
+ * outlive `add()`. The builder is emptied by `send()` and can be reused.
+ */
+class command_batch {
+public:
+    using on_response_callback_t = custom_command_callback::on_success_callback_t;
+    using on_error_callback_t = custom_command_callback::on_error_callback_t;
+
+    /** Maximum number of commands in a batch */
+    static constexpr size_t k_max_commands = 8;
+    /** Maximum size of the TLV encoded data of a command */
+    static constexpr size_t k_max_command_data_size = 128;
+
+    /** Add a command with its data as a JSON string, in the format used by `send_command()`
+     *
+     * @param[in] endpoint_id Endpoint ID on the peer.
+     * @param[in] cluster_id Cluster ID of the command.
+     * @param[in] command_id Command ID.
+     * @param[in] command_data_json_str Command data as a JSON string.
+     * @param[in] on_response Callback called with the response of this command, or with a failure status if the
+     *                        peer sent no response for it.
+     *
+     * @return ESP_OK on success.
+     * @return error in case of failure.
+     */
+    esp_err_t add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id, const char *command_data_json_str,
+                  on_response_callback_t on_response);
+
+    /** Add a command from its request object, for example `OnOff::Commands::On::Type`
+     *
+     * @param[in] endpoint_id Endpoint ID on the peer.
+     * @param[in] request Request object of the command.
+     * @param[in] on_response Callback called with the response of this command, or with a failure status if the
+     *                        peer sent no response for it.
+     *
+     * @return ESP_OK on success.
+     * @return error in case of failure.
+     */
+    template <typename RequestT>
+    esp_err_t add(uint16_t endpoint_id, const RequestT &request, on_response_callback_t on_response)
+    {
+        entry_t *entry = new_entry(endpoint_id, RequestT::GetClusterId(), RequestT::GetCommandId(), on_response);
+        if (!entry) {
+            return ESP_ERR_NO_MEM;
+        }
+        chip::TLV::TLVWriter writer;
+        writer.Init(entry->data, sizeof(entry->data));
+        if (chip::app::DataModel::Encode(writer, chip::TLV::AnonymousTag(), request) != CHIP_NO_ERROR ||
+            writer.Finalize() != CHIP_NO_ERROR) {
+            m_count--;
+            return ESP_ERR_INVALID_SIZE;
+        }
+        entry->data_len = writer.GetLengthWritten();
+        return ESP_OK;
+    }
+
+    /** Send the batch
+     *
+     * @param[in] ctx Context passed to the callbacks.
+     * @param[in] remote_device Peer device handle, with a CASE session.
+     * @param[in] max_paths_per_invoke MaxPathsPerInvoke of the peer. 1 sends each command in its own InvokeRequest,
+     *                                 which works with all the peers.
+     * @param[in] on_error Callback called if an InvokeRequest fails as a whole. It is called once per InvokeRequest.
+     * @param[in] timed_invoke_timeout_ms (Optional) Timeout of the timed invoke, for the commands which require it.
+     * @param[in] response_timeout (Optional) Response timeout.
+     *
+     * @return ESP_OK on success.
+     * @return error in case of failure. The InvokeRequests sent before the failure are not cancelled.
+     */
+    esp_err_t send(void *ctx, peer_device_t *remote_device, uint16_t max_paths_per_invoke,
+                   on_error_callback_t on_error, const Optional<uint16_t> &timed_invoke_timeout_ms = chip::NullOptional,
+                   const Optional<Timeout> &response_timeout = chip::NullOptional);
+
+    /** Number of commands in the batch */
+    size_t size() const { return m_count; }
+
+private:
+    typedef struct {
+        uint16_t endpoint_id;
+        uint32_t cluster_id;
+        uint32_t command_id;
+        on_response_callback_t on_response;
+        uint8_t data[k_max_command_data_size];
+        size_t data_len;
+    } entry_t;
+
+    entry_t *new_entry(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                       on_response_callback_t on_response);
+    esp_err_t send_chunk(void *ctx, peer_device_t *remote_device, size_t start, size_t count,
+                         uint16_t max_paths_per_invoke, on_error_callback_t on_error,
+                         const Optional<uint16_t> &timed_invoke_timeout_ms, const Optional<Timeout> &response_timeout);
+
+    entry_t m_entries[k_max_commands];
+    size_t m_count = 0;
+};
+
 } // namespace command
 } // namespace custom
 
@@ -17,6 +17,7 @@
 #include <esp_matter_attribute.h>
 #include <esp_matter_cluster.h>
 #include <esp_matter_core.h>
+#include <esp_matter_lazy_plugin_init.h>
 
 #include <app-common/zap-generated/callback.h>
 #include <app/PluginApplicationCallbacks.h>
@@ -51,13 +52,15 @@ void plugin_init_callback_common()
         while (cluster) {
             /* Plugin server init callback */
             plugin_server_init_callback_t plugin_server_init_callback = get_plugin_server_init_callback(cluster);
-            if (plugin_server_init_callback) {
+            if (plugin_server_init_callback &&
+                !lazy_plugin_init::defer(get_id(cluster), plugin_server_init_callback)) {
                 plugin_server_init_callback();
             }
             cluster = get_next(cluster);
         }
         endpoint = endpoint::get_next(endpoint);
     }
+    lazy_plugin_init::start();
 }
 
 cluster_t *create_default_binding_cluster(endpoint_t *endpoint)
@@ -72,7 +75,7 @@ cluster_t *create_default_binding_cluster(endpoint_t *endpoint)
     return binding::create(endpoint, &config, CLUSTER_FLAG_SERVER);
 }
 
-#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL || CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
 namespace descriptor {
 const function_generic_t *function_list = NULL;
 const int function_flags = CLUSTER_FLAG_NONE;
@@ -179,9 +182,15 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
     if (flags & CLUSTER_FLAG_SERVER) {
         /* Attributes managed internally */
         attribute::create_acl(cluster, NULL, 0, 0);
-        attribute::create_subjects_per_access_control_entry(cluster, 0);
-        attribute::create_access_control_entries_per_fabric(cluster, 0);
-        attribute::create_targets_per_access_control_entry(cluster, 0);
+        static const attribute_desc_t internal_attributes[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(AccessControl::Attributes::SubjectsPerAccessControlEntry::Id,
+                                            ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, 0, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(AccessControl::Attributes::AccessControlEntriesPerFabric::Id,
+                                            ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, 0, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(AccessControl::Attributes::TargetsPerAccessControlEntry::Id,
+                                            ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, 0, NULL),
+        };
+        create_attributes(cluster, internal_attributes, NULL);
 
         /* Attributes updated later */
         global::attribute::create_feature_map(cluster, 0);
@@ -371,10 +380,20 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_update_possible(cluster, config->update_possible);
-            attribute::create_update_state(cluster, config->update_state);
-            attribute::create_update_state_progress(cluster, config->update_state_progress);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, update_possible,
+                                                 OtaSoftwareUpdateRequestor::Attributes::UpdatePossible::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_BOOLEAN, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, update_state,
+                                                 OtaSoftwareUpdateRequestor::Attributes::UpdateState::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, update_state_progress,
+                                                 OtaSoftwareUpdateRequestor::Attributes::UpdateStateProgress::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
         }
@@ -463,9 +482,16 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
         /* Attributes managed internally */
         attribute::create_max_networks(cluster, 0);
         attribute::create_networks(cluster, NULL, 0, 0);
-        attribute::create_scan_max_time_seconds(cluster, 0);
-        attribute::create_connect_max_time_seconds(cluster, 0);
-        attribute::create_interface_enabled(cluster, 0);
+        static const attribute_desc_t internal_attributes[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(NetworkCommissioning::Attributes::ScanMaxTimeSeconds::Id,
+                                            ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT8, 0, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(NetworkCommissioning::Attributes::ConnectMaxTimeSeconds::Id,
+                                            ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT8, 0, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(NetworkCommissioning::Attributes::InterfaceEnabled::Id,
+                                            ATTRIBUTE_FLAG_WRITABLE | ATTRIBUTE_FLAG_NONVOLATILE,
+                                            ESP_MATTER_VAL_TYPE_BOOLEAN, 0, NULL),
+        };
+        create_attributes(cluster, internal_attributes, NULL);
         attribute::create_last_networking_status(cluster, nullable<uint8_t>());
         attribute::create_last_network_id(cluster, NULL, 0);
         attribute::create_last_connect_error_value(cluster, nullable<int32_t>());
@@ -525,10 +551,17 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
     if (flags & CLUSTER_FLAG_SERVER) {
         /* Attributes managed internally */
         attribute::create_network_interfaces(cluster, NULL, 0, 0);
-        attribute::create_reboot_count(cluster, 0);
-        attribute::create_up_time(cluster, 0);
-        attribute::create_test_event_triggers_enabled(cluster, 0);
-        global::attribute::create_feature_map(cluster, 0);
+        static const attribute_desc_t internal_attributes[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(GeneralDiagnostics::Attributes::RebootCount::Id, ATTRIBUTE_FLAG_NONVOLATILE,
+                                            ESP_MATTER_VAL_TYPE_UINT16, 0, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(GeneralDiagnostics::Attributes::UpTime::Id, ATTRIBUTE_FLAG_NONVOLATILE,
+                                            ESP_MATTER_VAL_TYPE_UINT64, 0, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(GeneralDiagnostics::Attributes::TestEventTriggersEnabled::Id,
+                                            ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_BOOLEAN, 0, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(Globals::Attributes::FeatureMap::Id, ATTRIBUTE_FLAG_NONE,
+                                            ESP_MATTER_VAL_TYPE_BITMAP32, 0, NULL),
+        };
+        create_attributes(cluster, internal_attributes, NULL);
 #if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
         global::attribute::create_event_list(cluster, NULL, 0, 0);
 #endif
@@ -575,9 +608,15 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags, uint32_
 #if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
         global::attribute::create_event_list(cluster, NULL, 0, 0);
 #endif
-        attribute::create_window_status(cluster, 0);
-        attribute::create_admin_fabric_index(cluster, 0);
-        attribute::create_admin_vendor_id(cluster, 0);
+        static const attribute_desc_t internal_attributes[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(AdministratorCommissioning::Attributes::WindowStatus::Id,
+                                            ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT8, 0, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(AdministratorCommissioning::Attributes::AdminFabricIndex::Id,
+                                            ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_UINT16, 0, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_VALUE(AdministratorCommissioning::Attributes::AdminVendorId::Id,
+                                            ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_UINT16, 0, NULL),
+        };
+        create_attributes(cluster, internal_attributes, NULL);
 
         /* Attributes not managed internally */
         if (config) {
@@ -1213,9 +1252,16 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_last_configured_by(cluster, 0);
-            attribute::create_scene_table_size(cluster, config->scene_table_size);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_VALUE(ScenesManagement::Attributes::LastConfiguredBy::Id, ATTRIBUTE_FLAG_NONE,
+                                                ESP_MATTER_VAL_TYPE_UINT64, 0, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, scene_table_size,
+                                                 ScenesManagement::Attributes::SceneTableSize::Id, ATTRIBUTE_FLAG_NONE,
+                                                 ESP_MATTER_VAL_TYPE_UINT16, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
             attribute::create_fabric_scene_info(cluster, NULL, 0, 0);
 	} else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
@@ -1332,9 +1378,17 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags, uint32_
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_current_level(cluster, config->current_level);
-            attribute::create_on_level(cluster, config->on_level);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, current_level, LevelControl::Attributes::CurrentLevel::Id,
+                                                 ATTRIBUTE_FLAG_NONVOLATILE | ATTRIBUTE_FLAG_NULLABLE,
+                                                 ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, on_level, LevelControl::Attributes::OnLevel::Id,
+                                                 ATTRIBUTE_FLAG_WRITABLE | ATTRIBUTE_FLAG_NULLABLE,
+                                                 ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
             attribute::create_options(cluster, config->options, 0x0, 0x3);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
@@ -1393,9 +1447,15 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags, uint32_
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_color_mode(cluster, config->color_mode);
-            attribute::create_color_control_options(cluster, config->color_control_options);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, color_mode, ColorControl::Attributes::ColorMode::Id,
+                                                 ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, color_control_options, ColorControl::Attributes::Options::Id,
+                                                 ATTRIBUTE_FLAG_WRITABLE, ESP_MATTER_VAL_TYPE_BITMAP8, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
             attribute::create_enhanced_color_mode(cluster, config->enhanced_color_mode, 0, 3);
             attribute::create_color_capabilities(cluster, config->color_capabilities, 0, 0x001f);
             attribute::create_number_of_primaries(cluster, config->number_of_primaries);
@@ -1574,9 +1634,17 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 
         /* Attributes not managed internally */
 	if (config) {
-	    global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-	    attribute::create_temperature_display_mode(cluster, config->temperature_display_mode);
-	    attribute::create_keypad_lockout(cluster, config->keypad_lockout);
+	    static const attribute_desc_t config_attributes[] = {
+	        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                          ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+	        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, temperature_display_mode,
+                                          ThermostatUserInterfaceConfiguration::Attributes::TemperatureDisplayMode::Id,
+                                          ATTRIBUTE_FLAG_WRITABLE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+	        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, keypad_lockout,
+                                          ThermostatUserInterfaceConfiguration::Attributes::KeypadLockout::Id,
+                                          ATTRIBUTE_FLAG_WRITABLE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+	    };
+	    create_attributes(cluster, config_attributes, config);
 	} else {
 	        ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
 	}
@@ -2317,11 +2385,19 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 #if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
 	global::attribute::create_event_list(cluster, NULL, 0, 0);
 #endif
-	attribute::create_expressed_state(cluster, 0);
-	attribute::create_battery_alert(cluster, 0);
-	attribute::create_test_in_progress(cluster, false);
-	attribute::create_hardware_fault_alert(cluster, false);
-	attribute::create_end_of_service_alert(cluster, 0);
+	static const attribute_desc_t internal_attributes[] = {
+	    ESP_MATTER_ATTRIBUTE_DESC_VALUE(SmokeCoAlarm::Attributes::ExpressedState::Id, ATTRIBUTE_FLAG_NONVOLATILE,
+                                     ESP_MATTER_VAL_TYPE_ENUM8, 0, NULL),
+	    ESP_MATTER_ATTRIBUTE_DESC_VALUE(SmokeCoAlarm::Attributes::BatteryAlert::Id, ATTRIBUTE_FLAG_NONVOLATILE,
+                                     ESP_MATTER_VAL_TYPE_ENUM8, 0, NULL),
+	    ESP_MATTER_ATTRIBUTE_DESC_VALUE(SmokeCoAlarm::Attributes::TestInProgress::Id, ATTRIBUTE_FLAG_NONE,
+                                     ESP_MATTER_VAL_TYPE_BOOLEAN, 0, NULL),
+	    ESP_MATTER_ATTRIBUTE_DESC_VALUE(SmokeCoAlarm::Attributes::HardwareFaultAlert::Id, ATTRIBUTE_FLAG_NONVOLATILE,
+                                     ESP_MATTER_VAL_TYPE_BOOLEAN, 0, NULL),
+	    ESP_MATTER_ATTRIBUTE_DESC_VALUE(SmokeCoAlarm::Attributes::EndOfServiceAlert::Id, ATTRIBUTE_FLAG_NONVOLATILE,
+                                     ESP_MATTER_VAL_TYPE_ENUM8, 0, NULL),
+	};
+	create_attributes(cluster, internal_attributes, NULL);
 
 	/* Attributes not managed internally */
 	if (config) {
@@ -2380,10 +2456,17 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_lock_state(cluster, config->lock_state);
-            attribute::create_lock_type(cluster, config->lock_type);
-            attribute::create_actuator_enabled(cluster, config->actuator_enabled);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, lock_state, DoorLock::Attributes::LockState::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, lock_type, DoorLock::Attributes::LockType::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, actuator_enabled, DoorLock::Attributes::ActuatorEnabled::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_BOOLEAN, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
             attribute::create_operating_mode(cluster, config->operating_mode, 0x0, 0x4);
             attribute::create_supported_operating_modes(cluster, config->supported_operating_modes);
         } else {
@@ -2435,10 +2518,18 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags, uint32_
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_type(cluster, config->type);
-            attribute::create_config_status(cluster, config->config_status);
-            attribute::create_operational_status(cluster, config->operational_status);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, type, WindowCovering::Attributes::Type::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, config_status, WindowCovering::Attributes::ConfigStatus::Id,
+                                                 ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_BITMAP8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, operational_status,
+                                                 WindowCovering::Attributes::OperationalStatus::Id, ATTRIBUTE_FLAG_NONE,
+                                                 ESP_MATTER_VAL_TYPE_BITMAP8, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
             attribute::create_end_product_type(cluster, config->end_product_type);
             attribute::create_mode(cluster, config->mode);
         } else {
@@ -2490,9 +2581,16 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_number_of_positions(cluster, config->number_of_positions);
-            attribute::create_current_position(cluster, config->current_position);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, number_of_positions,
+                                                 Switch::Attributes::NumberOfPositions::Id, ATTRIBUTE_FLAG_NONE,
+                                                 ESP_MATTER_VAL_TYPE_UINT8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, current_position, Switch::Attributes::CurrentPosition::Id,
+                                                 ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_UINT8, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
         }
@@ -2532,10 +2630,20 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_temperature_measured_value(cluster, config->measured_value);
-            attribute::create_temperature_min_measured_value(cluster, config->min_measured_value);
-            attribute::create_temperature_max_measured_value(cluster, config->max_measured_value);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                                 TemperatureMeasurement::Attributes::MeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_INT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                                 TemperatureMeasurement::Attributes::MinMeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_INT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                                 TemperatureMeasurement::Attributes::MaxMeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_INT16, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
         }
@@ -2575,10 +2683,20 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_relative_humidity_measured_value(cluster, config->measured_value);
-            attribute::create_relative_humidity_min_measured_value(cluster, config->min_measured_value);
-            attribute::create_relative_humidity_max_measured_value(cluster, config->max_measured_value);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                                 RelativeHumidityMeasurement::Attributes::MeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                                 RelativeHumidityMeasurement::Attributes::MinMeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                                 RelativeHumidityMeasurement::Attributes::MaxMeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
         }
@@ -2620,10 +2738,19 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_occupancy(cluster, config->occupancy);
-            attribute::create_occupancy_sensor_type(cluster, config->occupancy_sensor_type);
-            attribute::create_occupancy_sensor_type_bitmap(cluster, config->occupancy_sensor_type_bitmap);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, occupancy, OccupancySensing::Attributes::Occupancy::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_BITMAP8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, occupancy_sensor_type,
+                                                 OccupancySensing::Attributes::OccupancySensorType::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, occupancy_sensor_type_bitmap,
+                                                 OccupancySensing::Attributes::OccupancySensorTypeBitmap::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_BITMAP8, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
         }
@@ -2836,10 +2963,20 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 #endif
         /** Attributes not managed internally **/
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_pressure_measured_value(cluster, config->pressure_measured_value);
-            attribute::create_pressure_min_measured_value(cluster, config->pressure_min_measured_value);
-            attribute::create_pressure_max_measured_value(cluster, config->pressure_max_measured_value);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, pressure_measured_value,
+                                                 PressureMeasurement::Attributes::MeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_INT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, pressure_min_measured_value,
+                                                 PressureMeasurement::Attributes::MinMeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_INT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, pressure_max_measured_value,
+                                                 PressureMeasurement::Attributes::MaxMeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_INT16, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
         }
@@ -2877,10 +3014,20 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 #endif
         /** Attributes not managed internally **/
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_flow_measured_value(cluster, config->flow_measured_value);
-            attribute::create_flow_min_measured_value(cluster, config->flow_min_measured_value);
-            attribute::create_flow_max_measured_value(cluster, config->flow_max_measured_value);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, flow_measured_value,
+                                                 FlowMeasurement::Attributes::MeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, flow_min_measured_value,
+                                                 FlowMeasurement::Attributes::MinMeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, flow_max_measured_value,
+                                                 FlowMeasurement::Attributes::MaxMeasuredValue::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
         }
@@ -2928,10 +3075,22 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
             attribute::create_max_pressure(cluster, config->max_pressure);
             attribute::create_max_speed(cluster, config->max_speed);
             attribute::create_max_flow(cluster, config->max_flow);
-            attribute::create_effective_operation_mode(cluster, config->effective_operation_mode);
-            attribute::create_effective_control_mode(cluster, config->effective_control_mode);
-            attribute::create_capacity(cluster, config->capacity);
-            attribute::create_operation_mode(cluster, config->operation_mode);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, effective_operation_mode,
+                                                 PumpConfigurationAndControl::Attributes::EffectiveOperationMode::Id,
+                                                 ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, effective_control_mode,
+                                                 PumpConfigurationAndControl::Attributes::EffectiveControlMode::Id,
+                                                 ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, capacity,
+                                                 PumpConfigurationAndControl::Attributes::Capacity::Id,
+                                                 ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_INT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, operation_mode,
+                                                 PumpConfigurationAndControl::Attributes::OperationMode::Id,
+                                                 ATTRIBUTE_FLAG_WRITABLE | ATTRIBUTE_FLAG_NONVOLATILE,
+                                                 ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
         }
@@ -3144,10 +3303,17 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 
         /* Attributes not managed internally */
         if (config) {
-            global::attribute::create_cluster_revision(cluster, config->cluster_revision);
-            attribute::create_mask(cluster, config->mask);
-            attribute::create_state(cluster, config->state);
-            attribute::create_supported(cluster, config->supported);
+            static const attribute_desc_t config_attributes[] = {
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, cluster_revision, Globals::Attributes::ClusterRevision::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, mask, RefrigeratorAlarm::Attributes::Mask::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT32, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, state, RefrigeratorAlarm::Attributes::State::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT32, NULL),
+                ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, supported, RefrigeratorAlarm::Attributes::Supported::Id,
+                                                 ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT32, NULL),
+            };
+            create_attributes(cluster, config_attributes, config);
         } else {
             ESP_LOGE(TAG, "Config is NULL. Cannot add some attributes.");
         }
@@ -3378,7 +3544,7 @@ cluster_t *create(endpoint_t *endpoint, config_t *config, uint8_t flags)
 //     // ToDo
 // } /* audio_output */
 
-#endif /* CONFIG_ESP_MATTER_ENABLE_DATA_MODEL */
+#endif /* CONFIG_ESP_MATTER_ENABLE_DATA_MODEL || CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL */
 
 } /* cluster */
 } /* esp_matter */
@@ -14,8 +14,17 @@
 
 #include <esp_log.h>
 #include <esp_matter.h>
+#include <esp_matter_callback_watchdog.h>
 #include <esp_matter_command.h>
+#include <esp_matter_command_stats.h>
 #include <esp_matter_core.h>
+#include <esp_matter_e2e_latency.h>
+#include <esp_matter_lazy_plugin_init.h>
+#include <esp_matter_sed_poll.h>
+#include <esp_matter_trace.h>
+#include <esp_timer.h>
+
+#include <lib/support/CHIPMem.h>
 
 #include <app-common/zap-generated/callback.h>
 #include <app/InteractionModelEngine.h>
@@ -26,39 +35,201 @@ using chip::app::CommandHandler;
 using chip::app::DataModel::Decode;
 using chip::TLV::TLVReader;
 
-#if (FIXED_ENDPOINT_COUNT == 0)
+#if (FIXED_ENDPOINT_COUNT == 0) || CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
 
 static const char *TAG = "esp_matter_command";
 
 namespace esp_matter {
 namespace command {
 
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+extern void increment_invoke_count(command_t *command);
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+/* Records the latency of the dispatch when it goes out of scope */
+struct dispatch_timer {
+    dispatch_timer(uint32_t cluster_id, uint32_t command_id) : cluster_id(cluster_id), command_id(command_id),
+        start_us(esp_timer_get_time()) {}
+    ~dispatch_timer()
+    {
+        stats::record(cluster_id, command_id, (uint32_t)(esp_timer_get_time() - start_us), user_us, built_in_us);
+    }
+    uint32_t cluster_id;
+    uint32_t command_id;
+    int64_t start_us;
+    uint32_t user_us = 0;
+    uint32_t built_in_us = 0;
+};
+#endif // CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+/* Timestamps the start and the end of the dispatch for the end-to-end latency */
+struct e2e_dispatch_scope {
+    e2e_dispatch_scope() { e2e_latency::mark(e2e_latency::STAGE_DISPATCH); }
+    ~e2e_dispatch_scope() { e2e_latency::mark(e2e_latency::STAGE_DONE); }
+};
+#endif // CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+
+struct async_handle {
+    async_handle(CommandHandler *command_obj, const ConcreteCommandPath &path) : handle(command_obj),
+        command_path(path) {}
+    /* Holding the handle keeps the command handler, and so the exchange, alive */
+    CommandHandler::Handle handle;
+    ConcreteCommandPath command_path;
+};
+
+/* Must be called with the Matter stack lock held */
+static void finish_async(async_handle_t *async_handle, bool add_status, esp_err_t err)
+{
+    chip::Protocols::InteractionModel::Status status = err == ESP_OK ?
+        chip::Protocols::InteractionModel::Status::Success : chip::Protocols::InteractionModel::Status::Failure;
+    const ConcreteCommandPath &command_path = async_handle->command_path;
+    CommandHandler *command_obj = async_handle->handle.Get();
+    if (!command_obj) {
+        ESP_LOGW(TAG, "Exchange of command 0x%08" PRIX32 " was closed before it completed", command_path.mCommandId);
+    } else if (add_status) {
+        command_obj->AddStatus(command_path, status);
+    }
+    trace::record(trace::EVENT_COMMAND, command_path.mEndpointId, command_path.mClusterId, command_path.mCommandId,
+                  (uint8_t)status);
+    /* Deleting the handle releases it, the response is sent once all the handles are released */
+    chip::Platform::Delete(async_handle);
+}
+
+static esp_err_t finish_async_locked(async_handle_t *async_handle, bool add_status, esp_err_t err)
+{
+    if (!async_handle) {
+        ESP_LOGE(TAG, "Async handle cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    finish_async(async_handle, add_status, err);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+esp_err_t complete_async(async_handle_t *async_handle, esp_err_t err)
+{
+    return finish_async_locked(async_handle, true, err);
+}
+
+esp_err_t release_async(async_handle_t *async_handle)
+{
+    return finish_async_locked(async_handle, false, ESP_OK);
+}
+
+CommandHandler *get_command_handler(async_handle_t *async_handle)
+{
+    if (!async_handle) {
+        ESP_LOGE(TAG, "Async handle cannot be NULL");
+        return NULL;
+    }
+    return async_handle->handle.Get();
+}
+
+static void dispatch_async(const ConcreteCommandPath &command_path, TLVReader &tlv_data, CommandHandler *command_obj,
+                           async_callback_t async_callback)
+{
+    if (!command_obj) {
+        ESP_LOGE(TAG, "Command Object cannot be NULL");
+        return;
+    }
+    async_handle_t *async_handle = chip::Platform::New<async_handle_t>(command_obj, command_path);
+    if (!async_handle) {
+        ESP_LOGE(TAG, "Couldn't allocate async handle");
+        command_obj->AddStatus(command_path, chip::Protocols::InteractionModel::Status::ResourceExhausted);
+        trace::record(trace::EVENT_COMMAND, command_path.mEndpointId, command_path.mClusterId,
+                      command_path.mCommandId, (uint8_t)chip::Protocols::InteractionModel::Status::ResourceExhausted);
+        return;
+    }
+    esp_err_t err = async_callback(command_path, tlv_data, async_handle);
+    if (err != ESP_OK) {
+        /* The dispatch runs with the Matter stack lock held */
+        finish_async(async_handle, true, err);
+    }
+}
+
 void DispatchSingleClusterCommandCommon(const ConcreteCommandPath &command_path, TLVReader &tlv_data, void *opaque_ptr)
 {
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+    e2e_dispatch_scope e2e_scope;
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
+    sed_poll::on_activity(sed_poll::ACTIVITY_COMMAND);
+#endif
     uint16_t endpoint_id = command_path.mEndpointId;
     uint32_t cluster_id = command_path.mClusterId;
     uint32_t command_id = command_path.mCommandId;
+    lazy_plugin_init::on_access(cluster_id);
     ESP_LOGI(TAG, "Received command 0x%08" PRIX32 " for endpoint 0x%04" PRIX16 "'s cluster 0x%08" PRIX32 "", command_id, endpoint_id, cluster_id);
 
-    node_t *node = node::get();
-    endpoint_t *endpoint = endpoint::get(node, endpoint_id);
-    cluster_t *cluster = cluster::get(endpoint, cluster_id);
-    command_t *command = get(cluster, command_id, COMMAND_FLAG_ACCEPTED);
+    command_t *command = get_accepted(endpoint_id, cluster_id, command_id);
     if (!command) {
         ESP_LOGE(TAG, "Command 0x%08" PRIX32 " not found", command_id);
+        trace::record(trace::EVENT_COMMAND, endpoint_id, cluster_id, command_id,
+                      (uint8_t)chip::Protocols::InteractionModel::Status::UnsupportedCommand);
+        return;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+    increment_invoke_count(command);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+    dispatch_timer timer(cluster_id, command_id);
+    int64_t callback_start_us = esp_timer_get_time();
+#endif
+    async_callback_t async_callback = get_async_callback(command);
+    if (async_callback) {
+        dispatch_async(command_path, tlv_data, (CommandHandler *)opaque_ptr, async_callback);
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+        timer.user_us = (uint32_t)(esp_timer_get_time() - callback_start_us);
+#endif
         return;
     }
     esp_err_t err = ESP_OK;
-    TLVReader tlv_reader;
-    tlv_reader.Init(tlv_data);
     callback_t callback = get_user_callback(command);
     if (callback) {
-        err = callback(command_path, tlv_reader, opaque_ptr);
+        /* The user callback gets its own reader so that the built-in callback still decodes from the start */
+        TLVReader tlv_reader;
+        tlv_reader.Init(tlv_data);
+        {
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+            callback_watchdog::scope watchdog(callback_watchdog::CALLBACK_KIND_COMMAND, (void *)callback, endpoint_id,
+                                              cluster_id, command_id);
+#endif
+            err = callback(command_path, tlv_reader, opaque_ptr);
+        }
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+        int64_t now_us = esp_timer_get_time();
+        timer.user_us = (uint32_t)(now_us - callback_start_us);
+        callback_start_us = now_us;
+#endif
     }
     callback = get_callback(command);
     if ((err == ESP_OK) && callback) {
-        err = callback(command_path, tlv_data, opaque_ptr);
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+        e2e_latency::mark(e2e_latency::STAGE_CLUSTER_SERVER);
+#endif
+        {
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+            callback_watchdog::scope watchdog(callback_watchdog::CALLBACK_KIND_COMMAND, (void *)callback, endpoint_id,
+                                              cluster_id, command_id);
+#endif
+            err = callback(command_path, tlv_data, opaque_ptr);
+        }
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+        timer.built_in_us = (uint32_t)(esp_timer_get_time() - callback_start_us);
+#endif
     }
+    trace::record(trace::EVENT_COMMAND, endpoint_id, cluster_id, command_id,
+                  (uint8_t)(err == ESP_OK ? chip::Protocols::InteractionModel::Status::Success :
+                                            chip::Protocols::InteractionModel::Status::Failure));
     int flags = get_flags(command);
     if (flags & COMMAND_FLAG_CUSTOM) {
         chip::app::CommandHandler *command_obj = (chip::app::CommandHandler *)opaque_ptr;
@@ -74,6 +245,8 @@ void DispatchSingleClusterCommandCommon(const ConcreteCommandPath &command_path,
 } /* command */
 } /* esp_matter */
 
+#if !CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
+/* With the hybrid data model, the dispatcher generated from the zap data model serves all the endpoints */
 namespace chip {
 namespace app {
 
@@ -85,6 +258,7 @@ void DispatchSingleClusterCommand(const ConcreteCommandPath &command_path, TLVRe
 
 } /* namespace app */
 } /* namespace chip */
+#endif /* !CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL */
 
 static esp_err_t esp_matter_command_callback_key_set_write(const ConcreteCommandPath &command_path, TLVReader &tlv_data,
                                                            void *opaque_ptr)
@@ -0,0 +1,600 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_matter_composition.h>
+#include <esp_matter_core.h>
+#include <esp_matter_endpoint.h>
+#include <esp_matter_mem.h>
+#include <inttypes.h>
+
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+
+using namespace chip;
+using namespace chip::app::Clusters;
+
+static const char *TAG = "esp_matter_composition";
+
+namespace esp_matter {
+namespace composition {
+
+/* Device types whose mandatory clusters are created with the default configuration. The table is only linked in
+ * with the composition APIs. */
+typedef struct device_type_entry {
+    uint32_t (*get_device_type_id)();
+    esp_err_t (*add)(endpoint_t *endpoint);
+} device_type_entry_t;
+
+template <typename config_t, esp_err_t (*add_device_type)(endpoint_t *, config_t *)>
+static esp_err_t add_with_default_config(endpoint_t *endpoint)
+{
+    config_t config;
+    return add_device_type(endpoint, &config);
+}
+
+#define DEVICE_TYPE_ENTRY(device_type) \
+    { endpoint::device_type::get_device_type_id, \
+      add_with_default_config<endpoint::device_type::config_t, endpoint::device_type::add> }
+
+static const device_type_entry_t k_device_types[] = {
+    DEVICE_TYPE_ENTRY(power_source_device),
+    DEVICE_TYPE_ENTRY(on_off_light),
+    DEVICE_TYPE_ENTRY(dimmable_light),
+    DEVICE_TYPE_ENTRY(color_temperature_light),
+    DEVICE_TYPE_ENTRY(extended_color_light),
+    DEVICE_TYPE_ENTRY(on_off_switch),
+    DEVICE_TYPE_ENTRY(dimmer_switch),
+    DEVICE_TYPE_ENTRY(color_dimmer_switch),
+    DEVICE_TYPE_ENTRY(generic_switch),
+    DEVICE_TYPE_ENTRY(on_off_plugin_unit),
+    DEVICE_TYPE_ENTRY(dimmable_plugin_unit),
+    DEVICE_TYPE_ENTRY(fan),
+    DEVICE_TYPE_ENTRY(thermostat),
+    DEVICE_TYPE_ENTRY(air_quality_sensor),
+    DEVICE_TYPE_ENTRY(air_purifier),
+    DEVICE_TYPE_ENTRY(dish_washer),
+    DEVICE_TYPE_ENTRY(laundry_washer),
+    DEVICE_TYPE_ENTRY(smoke_co_alarm),
+    DEVICE_TYPE_ENTRY(aggregator),
+    DEVICE_TYPE_ENTRY(bridged_node),
+    DEVICE_TYPE_ENTRY(door_lock),
+    DEVICE_TYPE_ENTRY(window_covering_device),
+    DEVICE_TYPE_ENTRY(temperature_sensor),
+    DEVICE_TYPE_ENTRY(humidity_sensor),
+    DEVICE_TYPE_ENTRY(occupancy_sensor),
+    DEVICE_TYPE_ENTRY(contact_sensor),
+    DEVICE_TYPE_ENTRY(light_sensor),
+    DEVICE_TYPE_ENTRY(pressure_sensor),
+    DEVICE_TYPE_ENTRY(flow_sensor),
+    DEVICE_TYPE_ENTRY(pump),
+    DEVICE_TYPE_ENTRY(mode_select_device),
+    DEVICE_TYPE_ENTRY(room_air_conditioner),
+    DEVICE_TYPE_ENTRY(temperature_controlled_cabinet),
+    DEVICE_TYPE_ENTRY(refrigerator),
+    DEVICE_TYPE_ENTRY(robotic_vacuum_cleaner),
+    DEVICE_TYPE_ENTRY(water_leak_detector),
+};
+
+#undef DEVICE_TYPE_ENTRY
+
+/* Calls the visitor with a reader on each element of the array the reader is positioned on */
+template <typename visitor_t>
+static esp_err_t for_each_element(const TLV::TLVReader &array_reader, visitor_t visitor)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType container_type;
+    reader.Init(array_reader);
+    ESP_RETURN_ON_FALSE(reader.GetType() == TLV::kTLVType_Array, ESP_ERR_INVALID_ARG, TAG, "Expected an array");
+    ESP_RETURN_ON_FALSE(reader.EnterContainer(container_type) == CHIP_NO_ERROR, ESP_ERR_INVALID_ARG, TAG,
+                        "Failed to enter container");
+    CHIP_ERROR chip_err = CHIP_NO_ERROR;
+    while ((chip_err = reader.Next()) == CHIP_NO_ERROR) {
+        esp_err_t err = visitor(reader);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    ESP_RETURN_ON_FALSE(chip_err == CHIP_END_OF_TLV, ESP_ERR_INVALID_ARG, TAG, "Failed to decode: %s",
+                        ErrorStr(chip_err));
+    return ESP_OK;
+}
+
+/* Calls the visitor with the tag number and a reader on each context tagged member of the structure the reader is
+ * positioned on */
+template <typename visitor_t>
+static esp_err_t for_each_member(const TLV::TLVReader &structure_reader, visitor_t visitor)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType container_type;
+    reader.Init(structure_reader);
+    ESP_RETURN_ON_FALSE(reader.GetType() == TLV::kTLVType_Structure, ESP_ERR_INVALID_ARG, TAG,
+                        "Expected a structure");
+    ESP_RETURN_ON_FALSE(reader.EnterContainer(container_type) == CHIP_NO_ERROR, ESP_ERR_INVALID_ARG, TAG,
+                        "Failed to enter container");
+    CHIP_ERROR chip_err = CHIP_NO_ERROR;
+    while ((chip_err = reader.Next()) == CHIP_NO_ERROR) {
+        if (!TLV::IsContextTag(reader.GetTag())) {
+            continue;
+        }
+        esp_err_t err = visitor(TLV::TagNumFromTag(reader.GetTag()), reader);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    ESP_RETURN_ON_FALSE(chip_err == CHIP_END_OF_TLV, ESP_ERR_INVALID_ARG, TAG, "Failed to decode: %s",
+                        ErrorStr(chip_err));
+    return ESP_OK;
+}
+
+static uint16_t get_element_count(const TLV::TLVReader &array_reader)
+{
+    uint16_t count = 0;
+    for_each_element(array_reader, [&count](TLV::TLVReader &reader) {
+        count++;
+        return ESP_OK;
+    });
+    return count;
+}
+
+template <typename T>
+static CHIP_ERROR get_number(TLV::TLVReader &reader, bool is_nullable, T &value)
+{
+    if (reader.GetType() == TLV::kTLVType_Null) {
+        VerifyOrReturnError(is_nullable, CHIP_ERROR_WRONG_TLV_TYPE);
+        value = nullable<T>().value();
+        return CHIP_NO_ERROR;
+    }
+    return reader.Get(value);
+}
+
+static CHIP_ERROR get_string(TLV::TLVReader &reader, TLV::TLVType tlv_type, uint8_t **data, uint16_t *size)
+{
+    const uint8_t *ptr = NULL;
+    VerifyOrReturnError(reader.GetType() == tlv_type, CHIP_ERROR_WRONG_TLV_TYPE);
+    VerifyOrReturnError(reader.GetLength() <= UINT16_MAX, CHIP_ERROR_BUFFER_TOO_SMALL);
+    if (reader.GetLength() > 0) {
+        ReturnErrorOnFailure(reader.GetDataPtr(ptr));
+    }
+    /* The value points to the descriptor, attribute::set_val() copies it */
+    *data = const_cast<uint8_t *>(ptr);
+    *size = (uint16_t)reader.GetLength();
+    return CHIP_NO_ERROR;
+}
+
+/* Decodes the element the reader is positioned on as a value of the given type */
+static esp_err_t get_val(TLV::TLVReader &reader, esp_matter_val_type_t type, esp_matter_attr_val_t *val)
+{
+    bool is_nullable = type & ESP_MATTER_VAL_NULLABLE_BASE;
+    CHIP_ERROR chip_err = CHIP_NO_ERROR;
+    uint8_t *data = NULL;
+    uint16_t size = 0;
+
+    val->type = type;
+    switch (type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+        chip_err = get_number(reader, is_nullable, val->val.b);
+        break;
+    case ESP_MATTER_VAL_TYPE_INTEGER: {
+        int32_t value = 0;
+        chip_err = get_number(reader, is_nullable, value);
+        val->val.i = value;
+        break;
+    }
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+        chip_err = get_number(reader, is_nullable, val->val.f);
+        break;
+    case ESP_MATTER_VAL_TYPE_INT8:
+        chip_err = get_number(reader, is_nullable, val->val.i8);
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+        chip_err = get_number(reader, is_nullable, val->val.u8);
+        break;
+    case ESP_MATTER_VAL_TYPE_INT16:
+        chip_err = get_number(reader, is_nullable, val->val.i16);
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+        chip_err = get_number(reader, is_nullable, val->val.u16);
+        break;
+    case ESP_MATTER_VAL_TYPE_INT32:
+        chip_err = get_number(reader, is_nullable, val->val.i32);
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+        chip_err = get_number(reader, is_nullable, val->val.u32);
+        break;
+    case ESP_MATTER_VAL_TYPE_INT64:
+        chip_err = get_number(reader, is_nullable, val->val.i64);
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT64:
+        chip_err = get_number(reader, is_nullable, val->val.u64);
+        break;
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+        chip_err = get_string(reader, TLV::kTLVType_UTF8String, &data, &size);
+        *val = type == ESP_MATTER_VAL_TYPE_CHAR_STRING ? esp_matter_char_str((char *)data, size) :
+                                                         esp_matter_long_char_str((char *)data, size);
+        break;
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+        chip_err = get_string(reader, TLV::kTLVType_ByteString, &data, &size);
+        *val = type == ESP_MATTER_VAL_TYPE_OCTET_STRING ? esp_matter_octet_str(data, size) :
+                                                          esp_matter_long_octet_str(data, size);
+        break;
+    default:
+        ESP_LOGE(TAG, "Unsupported value type %d", type);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    ESP_RETURN_ON_FALSE(chip_err == CHIP_NO_ERROR, ESP_ERR_INVALID_ARG, TAG,
+                        "Failed to decode the value of type %d: %s", type, ErrorStr(chip_err));
+    return ESP_OK;
+}
+
+/* Only the value types which cannot be confused with another one are derived from the TLV */
+static esp_matter_val_type_t get_val_type(const TLV::TLVReader &reader)
+{
+    switch (reader.GetType()) {
+    case TLV::kTLVType_Boolean:
+        return ESP_MATTER_VAL_TYPE_BOOLEAN;
+    case TLV::kTLVType_FloatingPointNumber:
+        return ESP_MATTER_VAL_TYPE_FLOAT;
+    case TLV::kTLVType_UTF8String:
+        return ESP_MATTER_VAL_TYPE_CHAR_STRING;
+    case TLV::kTLVType_ByteString:
+        return ESP_MATTER_VAL_TYPE_OCTET_STRING;
+    default:
+        return ESP_MATTER_VAL_TYPE_INVALID;
+    }
+}
+
+/* The tables of the bulk builder for one cluster record */
+class cluster_tables {
+public:
+    ~cluster_tables()
+    {
+        esp_matter_mem_free(attributes);
+        esp_matter_mem_free(commands);
+        esp_matter_mem_free(event_ids);
+    }
+
+    esp_err_t alloc(uint16_t max_attribute_count, uint16_t command_count, uint16_t event_count)
+    {
+        attributes = (attribute::descriptor_t *)esp_matter_mem_calloc(max_attribute_count,
+                                                                      sizeof(attribute::descriptor_t));
+        commands = command_count ? (command::descriptor_t *)esp_matter_mem_calloc(command_count,
+                                                                                  sizeof(command::descriptor_t)) : NULL;
+        event_ids = event_count ? (uint32_t *)esp_matter_mem_calloc(event_count, sizeof(uint32_t)) : NULL;
+        if (!attributes || (command_count && !commands) || (event_count && !event_ids)) {
+            ESP_LOGE(TAG, "Couldn't allocate the cluster tables");
+            return ESP_ERR_NO_MEM;
+        }
+        return ESP_OK;
+    }
+
+    attribute::descriptor_t *attributes = NULL;
+    command::descriptor_t *commands = NULL;
+    uint32_t *event_ids = NULL;
+};
+
+/* Overrides the value of an existing attribute, or appends the attribute to the table of the new ones */
+static esp_err_t add_attribute(cluster_t *cluster, uint32_t attribute_id, const TLV::TLVReader *value_reader,
+                               esp_matter_val_type_t type, uint16_t flags, uint16_t max_val_size,
+                               attribute::descriptor_t *attributes, uint16_t *attribute_count)
+{
+    TLV::TLVReader reader;
+    attribute_t *attribute = cluster ? attribute::get(cluster, attribute_id) : NULL;
+    if (attribute) {
+        if (!value_reader) {
+            return ESP_OK;
+        }
+        esp_matter_val_type_t current_type = ESP_MATTER_VAL_TYPE_INVALID;
+        attribute::get_val_storage(attribute, &current_type);
+        esp_matter_attr_val_t val = esp_matter_invalid(NULL);
+        reader.Init(*value_reader);
+        ESP_RETURN_ON_ERROR(get_val(reader, current_type, &val), TAG, "Invalid value of attribute 0x%08" PRIX32,
+                            attribute_id);
+        return attribute::set_val(attribute, &val);
+    }
+
+    ESP_RETURN_ON_FALSE(value_reader, ESP_ERR_INVALID_ARG, TAG, "New attribute 0x%08" PRIX32 " needs a value",
+                        attribute_id);
+    if (type == ESP_MATTER_VAL_TYPE_INVALID) {
+        type = get_val_type(*value_reader);
+    }
+    ESP_RETURN_ON_FALSE(type != ESP_MATTER_VAL_TYPE_INVALID, ESP_ERR_INVALID_ARG, TAG,
+                        "New attribute 0x%08" PRIX32 " needs a value type", attribute_id);
+    /* A repeated attribute, or the feature map also given as an attribute, replaces the previous record */
+    attribute::descriptor_t *descriptor = NULL;
+    for (uint16_t index = 0; index < *attribute_count && !descriptor; index++) {
+        descriptor = attributes[index].attribute_id == attribute_id ? &attributes[index] : NULL;
+    }
+    if (!descriptor) {
+        descriptor = &attributes[(*attribute_count)++];
+    }
+    reader.Init(*value_reader);
+    ESP_RETURN_ON_ERROR(get_val(reader, type, &descriptor->val), TAG, "Invalid value of attribute 0x%08" PRIX32,
+                        attribute_id);
+    descriptor->attribute_id = attribute_id;
+    descriptor->flags = flags;
+    descriptor->max_val_size = max_val_size;
+    bool is_string = type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+                     type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING;
+    if (max_val_size == 0 && is_string) {
+        /* Without a maximum size, the string cannot grow beyond its initial value */
+        descriptor->max_val_size = descriptor->val.val.a.s;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t add_attribute_record(const TLV::TLVReader &record_reader, cluster_t *cluster,
+                                      attribute::descriptor_t *attributes, uint16_t *attribute_count)
+{
+    uint32_t attribute_id = kInvalidAttributeId;
+    TLV::TLVReader value_reader;
+    bool has_value = false;
+    uint8_t type = ESP_MATTER_VAL_TYPE_INVALID;
+    uint16_t flags = ATTRIBUTE_FLAG_NONE;
+    uint16_t max_val_size = 0;
+    esp_err_t err = for_each_member(record_reader, [&](uint32_t tag_num, TLV::TLVReader &reader) {
+        CHIP_ERROR chip_err = CHIP_NO_ERROR;
+        switch (tag_num) {
+        case tag::k_attribute_id:
+            chip_err = reader.Get(attribute_id);
+            break;
+        case tag::k_attribute_value:
+            value_reader.Init(reader);
+            has_value = true;
+            break;
+        case tag::k_attribute_type:
+            chip_err = reader.Get(type);
+            break;
+        case tag::k_attribute_flags:
+            chip_err = reader.Get(flags);
+            break;
+        case tag::k_attribute_max_size:
+            chip_err = reader.Get(max_val_size);
+            break;
+        default:
+            break;
+        }
+        ESP_RETURN_ON_FALSE(chip_err == CHIP_NO_ERROR, ESP_ERR_INVALID_ARG, TAG, "Invalid attribute member %" PRIu32,
+                            tag_num);
+        return ESP_OK;
+    });
+    ESP_RETURN_ON_ERROR(err, TAG, "Malformed attribute record");
+    ESP_RETURN_ON_FALSE(attribute_id != kInvalidAttributeId, ESP_ERR_INVALID_ARG, TAG, "Attribute id missing");
+    return add_attribute(cluster, attribute_id, has_value ? &value_reader : NULL, (esp_matter_val_type_t)type, flags,
+                         max_val_size, attributes, attribute_count);
+}
+
+static esp_err_t add_command_record(const TLV::TLVReader &record_reader, command::descriptor_t *descriptor)
+{
+    descriptor->command_id = kInvalidCommandId;
+    descriptor->flags = COMMAND_FLAG_ACCEPTED;
+    descriptor->callback = NULL;
+    esp_err_t err = for_each_member(record_reader, [descriptor](uint32_t tag_num, TLV::TLVReader &reader) {
+        CHIP_ERROR chip_err = CHIP_NO_ERROR;
+        if (tag_num == tag::k_command_id) {
+            chip_err = reader.Get(descriptor->command_id);
+        } else if (tag_num == tag::k_command_flags) {
+            chip_err = reader.Get(descriptor->flags);
+        }
+        ESP_RETURN_ON_FALSE(chip_err == CHIP_NO_ERROR, ESP_ERR_INVALID_ARG, TAG, "Invalid command member %" PRIu32,
+                            tag_num);
+        return ESP_OK;
+    });
+    ESP_RETURN_ON_ERROR(err, TAG, "Malformed command record");
+    ESP_RETURN_ON_FALSE(descriptor->command_id != kInvalidCommandId, ESP_ERR_INVALID_ARG, TAG,
+                        "Command id missing");
+    return ESP_OK;
+}
+
+static esp_err_t add_cluster_record(endpoint_t *endpoint, const TLV::TLVReader &record_reader)
+{
+    cluster::descriptor_t descriptor = {};
+    descriptor.cluster_id = kInvalidClusterId;
+    descriptor.flags = CLUSTER_FLAG_SERVER;
+    TLV::TLVReader attributes_reader, commands_reader, events_reader, feature_map_reader;
+    bool has_attributes = false, has_commands = false, has_events = false, has_feature_map = false;
+    esp_err_t err = for_each_member(record_reader, [&](uint32_t tag_num, TLV::TLVReader &reader) {
+        CHIP_ERROR chip_err = CHIP_NO_ERROR;
+        switch (tag_num) {
+        case tag::k_cluster_id:
+            chip_err = reader.Get(descriptor.cluster_id);
+            break;
+        case tag::k_cluster_flags:
+            chip_err = reader.Get(descriptor.flags);
+            break;
+        case tag::k_feature_map:
+            feature_map_reader.Init(reader);
+            has_feature_map = true;
+            break;
+        case tag::k_attributes:
+            attributes_reader.Init(reader);
+            has_attributes = true;
+            break;
+        case tag::k_commands:
+            commands_reader.Init(reader);
+            has_commands = true;
+            break;
+        case tag::k_events:
+            events_reader.Init(reader);
+            has_events = true;
+            break;
+        default:
+            break;
+        }
+        ESP_RETURN_ON_FALSE(chip_err == CHIP_NO_ERROR, ESP_ERR_INVALID_ARG, TAG, "Invalid cluster member %" PRIu32,
+                            tag_num);
+        return ESP_OK;
+    });
+    ESP_RETURN_ON_ERROR(err, TAG, "Malformed cluster record");
+    ESP_RETURN_ON_FALSE(descriptor.cluster_id != kInvalidClusterId, ESP_ERR_INVALID_ARG, TAG, "Cluster id missing");
+
+    /* Room for the FeatureMap and ClusterRevision of a new cluster */
+    uint16_t max_attribute_count = (has_attributes ? get_element_count(attributes_reader) : 0) + 2;
+    uint16_t command_count = has_commands ? get_element_count(commands_reader) : 0;
+    uint16_t event_count = has_events ? get_element_count(events_reader) : 0;
+    cluster_tables tables;
+    ESP_RETURN_ON_ERROR(tables.alloc(max_attribute_count, command_count, event_count), TAG,
+                        "Failed to allocate the tables of cluster 0x%08" PRIX32, descriptor.cluster_id);
+
+    /* The attributes which already exist are overridden in place, the other ones go to the bulk builder */
+    cluster_t *cluster = cluster::get(endpoint, descriptor.cluster_id);
+    uint16_t attribute_count = 0;
+    if (has_attributes) {
+        err = for_each_element(attributes_reader, [&](TLV::TLVReader &reader) {
+            return add_attribute_record(reader, cluster, tables.attributes, &attribute_count);
+        });
+        ESP_RETURN_ON_ERROR(err, TAG, "Failed to add the attributes of cluster 0x%08" PRIX32, descriptor.cluster_id);
+    }
+    if (has_feature_map) {
+        err = add_attribute(cluster, Globals::Attributes::FeatureMap::Id, &feature_map_reader,
+                            ESP_MATTER_VAL_TYPE_BITMAP32, ATTRIBUTE_FLAG_NONE, 0, tables.attributes, &attribute_count);
+        ESP_RETURN_ON_ERROR(err, TAG, "Failed to set the feature map of cluster 0x%08" PRIX32, descriptor.cluster_id);
+    }
+    if (!cluster) {
+        bool has_feature_map_attribute = false, has_revision_attribute = false;
+        for (uint16_t index = 0; index < attribute_count; index++) {
+            has_feature_map_attribute |= tables.attributes[index].attribute_id == Globals::Attributes::FeatureMap::Id;
+            has_revision_attribute |= tables.attributes[index].attribute_id == Globals::Attributes::ClusterRevision::Id;
+        }
+        if (!has_feature_map_attribute) {
+            tables.attributes[attribute_count++] = {Globals::Attributes::FeatureMap::Id, ATTRIBUTE_FLAG_NONE,
+                                                    esp_matter_bitmap32(0), 0};
+        }
+        if (!has_revision_attribute) {
+            tables.attributes[attribute_count++] = {Globals::Attributes::ClusterRevision::Id, ATTRIBUTE_FLAG_NONE,
+                                                    esp_matter_uint16(1), 0};
+        }
+    }
+    if (has_commands) {
+        uint16_t index = 0;
+        err = for_each_element(commands_reader, [&](TLV::TLVReader &reader) {
+            return add_command_record(reader, &tables.commands[index++]);
+        });
+        ESP_RETURN_ON_ERROR(err, TAG, "Failed to add the commands of cluster 0x%08" PRIX32, descriptor.cluster_id);
+    }
+    if (has_events) {
+        uint16_t index = 0;
+        err = for_each_element(events_reader, [&](TLV::TLVReader &reader) {
+            ESP_RETURN_ON_FALSE(reader.Get(tables.event_ids[index++]) == CHIP_NO_ERROR, ESP_ERR_INVALID_ARG, TAG,
+                                "Invalid event id");
+            return ESP_OK;
+        });
+        ESP_RETURN_ON_ERROR(err, TAG, "Failed to add the events of cluster 0x%08" PRIX32, descriptor.cluster_id);
+    }
+
+    descriptor.attributes = tables.attributes;
+    descriptor.attribute_count = attribute_count;
+    descriptor.commands = tables.commands;
+    descriptor.command_count = command_count;
+    descriptor.event_ids = tables.event_ids;
+    descriptor.event_count = event_count;
+    ESP_RETURN_ON_FALSE(cluster::create(endpoint, &descriptor), ESP_FAIL, TAG, "Failed to create cluster 0x%08" PRIX32,
+                        descriptor.cluster_id);
+    return ESP_OK;
+}
+
+static esp_err_t add_device_type_record(endpoint_t *endpoint, const TLV::TLVReader &record_reader)
+{
+    uint32_t device_type_id = kInvalidDeviceTypeId;
+    uint8_t device_type_version = 1;
+    esp_err_t err = for_each_member(record_reader, [&](uint32_t tag_num, TLV::TLVReader &reader) {
+        CHIP_ERROR chip_err = CHIP_NO_ERROR;
+        if (tag_num == tag::k_device_type_id) {
+            chip_err = reader.Get(device_type_id);
+        } else if (tag_num == tag::k_device_type_version) {
+            chip_err = reader.Get(device_type_version);
+        }
+        ESP_RETURN_ON_FALSE(chip_err == CHIP_NO_ERROR, ESP_ERR_INVALID_ARG, TAG,
+                            "Invalid device type member %" PRIu32, tag_num);
+        return ESP_OK;
+    });
+    ESP_RETURN_ON_ERROR(err, TAG, "Malformed device type record");
+    ESP_RETURN_ON_FALSE(device_type_id != kInvalidDeviceTypeId, ESP_ERR_INVALID_ARG, TAG, "Device type id missing");
+
+    /* The known device types are added with their own version */
+    for (const device_type_entry_t &entry : k_device_types) {
+        if (entry.get_device_type_id() == device_type_id) {
+            return entry.add(endpoint);
+        }
+    }
+    return endpoint::add_device_type(endpoint, device_type_id, device_type_version);
+}
+
+esp_err_t add(endpoint_t *endpoint, const uint8_t *data, size_t size)
+{
+    ESP_RETURN_ON_FALSE(endpoint && data && size, ESP_ERR_INVALID_ARG, TAG, "Endpoint or descriptor cannot be NULL");
+    TLV::TLVReader reader;
+    reader.Init(data, size);
+    ESP_RETURN_ON_FALSE(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()) == CHIP_NO_ERROR,
+                        ESP_ERR_INVALID_ARG, TAG, "The descriptor is not an anonymous structure");
+
+    TLV::TLVReader device_types_reader, clusters_reader;
+    bool has_device_types = false, has_clusters = false;
+    esp_err_t err = for_each_member(reader, [&](uint32_t tag_num, TLV::TLVReader &member_reader) {
+        if (tag_num == tag::k_device_types) {
+            device_types_reader.Init(member_reader);
+            has_device_types = true;
+        } else if (tag_num == tag::k_clusters) {
+            clusters_reader.Init(member_reader);
+            has_clusters = true;
+        }
+        return ESP_OK;
+    });
+    ESP_RETURN_ON_ERROR(err, TAG, "Malformed composition descriptor");
+
+    /* The device types first, so that the clusters complete the ones of the known device types */
+    if (has_device_types) {
+        err = for_each_element(device_types_reader, [endpoint](TLV::TLVReader &record_reader) {
+            return add_device_type_record(endpoint, record_reader);
+        });
+        ESP_RETURN_ON_ERROR(err, TAG, "Failed to add the device types");
+    }
+    if (has_clusters) {
+        err = for_each_element(clusters_reader, [endpoint](TLV::TLVReader &record_reader) {
+            return add_cluster_record(endpoint, record_reader);
+        });
+        ESP_RETURN_ON_ERROR(err, TAG, "Failed to add the clusters");
+    }
+    return ESP_OK;
+}
+
+endpoint_t *create(node_t *node, const uint8_t *data, size_t size, uint8_t flags, void *priv_data)
+{
+    if (!data || !size) {
+        ESP_LOGE(TAG, "Descriptor cannot be NULL");
+        return NULL;
+    }
+    endpoint_t *endpoint = endpoint::create(node, flags, priv_data);
+    if (!endpoint) {
+        return NULL;
+    }
+    if (add(endpoint, data, size) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add the composition descriptor to the endpoint");
+        endpoint::destroy(node, endpoint);
+        return NULL;
+    }
+    return endpoint;
+}
+
+} /* composition */
+} /* esp_matter */
@@ -0,0 +1,117 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+
+/* Runtime endpoint composition
+ *
+ * These APIs build an endpoint from a composition descriptor received at runtime, for example the capabilities of a
+ * bridged device sent by a cloud backend, instead of a sequence of `cluster::*::create()` calls written for every
+ * device type.
+ *
+ * The descriptor is a Matter TLV anonymous structure, which can be produced from JSON with `json_to_tlv()`:
+ *
+ *   {
+ *       0: [ { 0: device type id, 1: device type version }, ... ],
+ *       1: [ { 0: cluster id, 1: cluster flags, 2: feature map,
+ *              3: [ { 0: attribute id, 1: value, 2: esp_matter_val_type_t, 3: attribute flags, 4: max size }, ... ],
+ *              4: [ { 0: command id, 1: command flags }, ... ],
+ *              5: [ event id, ... ] }, ... ]
+ *   }
+ *
+ * All the members are optional except the ids. The device types known by `esp_matter_endpoint.h` are added with their
+ * mandatory clusters and the default configuration, the other ones are only added to the device type list. The
+ * clusters are then created or completed with the bulk builder of `cluster::create(endpoint, descriptor)`:
+ *
+ * - The cluster flags default to `CLUSTER_FLAG_SERVER`.
+ * - The feature map and the attributes which already exist on the endpoint are overridden with the given values.
+ * - The new attributes need their value type, except the booleans, floats and strings whose type is the TLV one.
+ * - The new clusters get the FeatureMap and ClusterRevision global attributes, 0 and 1 unless given.
+ * - The new commands do not have a built-in callback, they are handled by the callback of the command, see
+ *   `command::set_user_callback()`.
+ *
+ * The features of the clusters are not added with their attributes and commands: the descriptor lists them along
+ * with the feature map.
+ */
+namespace esp_matter {
+namespace composition {
+
+/** Context tags of the composition descriptor */
+namespace tag {
+/* Composition */
+constexpr uint8_t k_device_types = 0;
+constexpr uint8_t k_clusters = 1;
+
+/* Device type */
+constexpr uint8_t k_device_type_id = 0;
+constexpr uint8_t k_device_type_version = 1;
+
+/* Cluster */
+constexpr uint8_t k_cluster_id = 0;
+constexpr uint8_t k_cluster_flags = 1;
+constexpr uint8_t k_feature_map = 2;
+constexpr uint8_t k_attributes = 3;
+constexpr uint8_t k_commands = 4;
+constexpr uint8_t k_events = 5;
+
+/* Attribute */
+constexpr uint8_t k_attribute_id = 0;
+constexpr uint8_t k_attribute_value = 1;
+constexpr uint8_t k_attribute_type = 2;
+constexpr uint8_t k_attribute_flags = 3;
+constexpr uint8_t k_attribute_max_size = 4;
+
+/* Command */
+constexpr uint8_t k_command_id = 0;
+constexpr uint8_t k_command_flags = 1;
+} /* tag */
+
+/** Create endpoint from composition descriptor
+ *
+ * This will create a new endpoint and add the device types and the clusters of the descriptor to it. The endpoint is
+ * destroyed if the descriptor cannot be applied.
+ *
+ * @note: The endpoint still has to be enabled with `endpoint::enable()` once the node is started.
+ *
+ * @param[in] node Node handle.
+ * @param[in] data Composition descriptor, Matter TLV encoded.
+ * @param[in] size Size of the descriptor.
+ * @param[in] flags Bitmap of `endpoint_flags_t`.
+ * @param[in] priv_data (Optional) Private data associated with the endpoint.
+ *
+ * @return Endpoint handle on success.
+ * @return NULL in case of failure.
+ */
+endpoint_t *create(node_t *node, const uint8_t *data, size_t size, uint8_t flags, void *priv_data);
+
+/** Add composition descriptor to endpoint
+ *
+ * Add the device types and the clusters of the descriptor to an existing endpoint, which has not been enabled yet.
+ * The elements added before a failure are not removed.
+ *
+ * @param[in] endpoint Endpoint handle.
+ * @param[in] data Composition descriptor, Matter TLV encoded.
+ * @param[in] size Size of the descriptor.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the descriptor is malformed.
+ * @return error in case of failure.
+ */
+esp_err_t add(endpoint_t *endpoint, const uint8_t *data, size_t size);
+
+} /* composition */
+} /* esp_matter */
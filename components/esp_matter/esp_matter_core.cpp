@@ -12,12 +12,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <esp_app_desc.h>
 #include <esp_log.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+#include <esp_timer.h>
 #include <esp_matter.h>
 #include <esp_matter_core.h>
+#include <math.h>
 #include <nvs.h>
+#include <stdlib.h>
+
+#include <limits>
 #if CONFIG_BT_ENABLED
 #include <esp_bt.h>
+#if CONFIG_ESP_MATTER_BLE_MEM_REGION_POOL
+#include <esp_heap_caps_init.h>
+#endif
 #if CONFIG_BT_NIMBLE_ENABLED
 #if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
 #include <esp_nimble_hci.h>
@@ -31,6 +43,7 @@
 #include <app/clusters/general-diagnostics-server/general-diagnostics-server.h>
 #include <app/server/Dnssd.h>
 #include <app/server/Server.h>
+#include <app/reporting/reporting.h>
 #include <app/util/attribute-storage.h>
 #include <credentials/DeviceAttestationCredsProvider.h>
 #include <credentials/FabricTable.h>
@@ -41,10 +54,47 @@
 #include <platform/ESP32/ESP32Utils.h>
 #include <platform/ESP32/NetworkCommissioningDriver.h>
 #include <esp_matter_ota.h>
+#include <esp_matter_ota_provider.h>
 #include <esp_matter_mem.h>
 #include <esp_matter_providers.h>
 
+#include <esp_matter_acl_cache.h>
+#include <esp_matter_arena.h>
+#include <esp_matter_async_reset.h>
+#include <esp_matter_attribute_access.h>
+#include <esp_matter_command_stats.h>
+#include <esp_matter_callback_watchdog.h>
+#include <esp_matter_data_version.h>
+#include <esp_matter_deferred_log.h>
+#include <esp_matter_device_event_registry.h>
+#include <esp_matter_event_store.h>
+#include <esp_matter_e2e_latency.h>
+#include <esp_matter_group_key_cache.h>
+#include <esp_matter_json_export.h>
+#include <esp_matter_hybrid.h>
+#include <esp_matter_icd_report_batching.h>
+#include <esp_matter_report_priority.h>
+#include <esp_matter_journal.h>
+#include <esp_matter_lazy_plugin_init.h>
+#include <esp_matter_load_gen.h>
+#include <esp_matter_lock_stats.h>
+#include <esp_matter_report_sync.h>
+#include <esp_matter_session_resumption.h>
+#include <esp_matter_scene_storage.h>
+#include <esp_matter_sed_poll.h>
+#include <esp_matter_storage_cache.h>
 #include <esp_matter_nvs.h>
+#include <esp_matter_path_index.h>
+#include <esp_matter_rtc_retention.h>
+#include <esp_matter_perf.h>
+#include <esp_matter_pool_stats.h>
+#include <esp_matter_startup_profile.h>
+#include <esp_matter_trace.h>
+#include <esp_matter_wifi_reconnect.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
 
 using chip::CommandId;
 using chip::DataVersion;
@@ -70,6 +120,13 @@ using chip::DeviceLayer::ThreadStackMgr;
 
 static const char *TAG = "esp_matter_core";
 static bool esp_matter_started = false;
+/* The Matter stack is initialized and the network bring-up has started, see start_network() */
+static bool s_network_started = false;
+static bool s_reset_resumed = false;
+/* Set in the Matter context once the server is initialized and the endpoints are enabled */
+static bool s_server_initialized = false;
+/* Startup profile phase from the network bring-up to the first address or Thread attach */
+static int s_network_up_phase = -1;
 
 #ifndef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
 // If Matter Server is disabled, we should have an empty InitDataModelHandler()
@@ -96,6 +153,8 @@ class AppDelegateImpl : public AppDelegate
 public:
     void OnCommissioningSessionStarted()
     {
+        /* The commissioner reads the clusters of the node during the commissioning */
+        lazy_plugin_init::run_all();
         PostEvent(chip::DeviceLayer::DeviceEventType::kCommissioningSessionStarted);
     }
 
@@ -157,7 +216,34 @@ typedef struct _attribute {
     // This is required when creating metadata for char string and long char string types of attributes.
     // The size in the attribute metadata remains constant and is verified during write operations.
     uint16_t max_val_size;
+    // Size of the buffer val.val.a.b points to, for string and array attributes
+    uint16_t val_capacity;
+    // Set while the attribute is in the list of deferred attributes waiting to be stored
+    bool persistence_pending;
+    struct _attribute *next_pending;
     attribute::callback_t override_callback;
+#if CONFIG_ESP_MATTER_ENABLE_OVERRIDE_READ_CACHE
+    /* Reads through the override callback within the TTL are served from val */
+    uint32_t override_cache_ttl_ms;
+    int64_t override_cache_expiry_us;
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_REPORTING_POLICY
+    /* Allocated by set_reporting_policy() */
+    struct reporting_state *reporting_state;
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+    /* Writes beyond the token bucket of the attribute are deferred */
+    uint16_t write_tokens;
+    uint32_t write_refill_ms;
+    uint32_t nvs_write_count;
+#endif
+#if CONFIG_ESP_MATTER_ATTRIBUTE_INLINE_VAL_SIZE > 0
+    uint8_t inline_val[CONFIG_ESP_MATTER_ATTRIBUTE_INLINE_VAL_SIZE] __attribute__((aligned(4)));
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+    /* Odd while val is being written, get_val_lock_free() retries when it changes during the copy */
+    uint32_t val_seq;
+#endif
     struct _attribute *next;
 } _attribute_t;
 
@@ -166,6 +252,10 @@ typedef struct _command {
     uint16_t flags;
     command::callback_t callback;
     command::callback_t user_callback;
+    command::async_callback_t async_callback;
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+    uint32_t invoke_count;
+#endif
     struct _command *next;
 } _command_t;
 
@@ -183,9 +273,39 @@ typedef struct _cluster {
     _attribute_t *attribute_list;
     _command_t *command_list;
     _event_t *event_list;
+    /* Lengths of the lists, kept up to date as the elements are created so that the metadata is sized without
+     * walking them */
+    uint16_t attribute_count;
+    uint16_t accepted_command_count;
+    uint16_t generated_command_count;
+    uint16_t event_count;
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+    /* Accepted commands sorted by ID, built when the endpoint is enabled */
+    _command_t **accepted_command_table;
+    uint16_t accepted_command_table_size;
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_ARENA
+    arena::arena_t *arena;
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+    /* Registered while the endpoint is enabled */
+    attribute_access::cluster_access *attribute_access;
+#endif
     struct _cluster *next;
 } _cluster_t;
 
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+/* Ember metadata used by all the enabled endpoints with the same composition. The attribute default values of the
+ * metadata are the ones of the owner, one of the endpoints using it. */
+typedef struct _shared_metadata {
+    EmberAfEndpointType *endpoint_type;
+    struct _endpoint *owner;
+    uint32_t fingerprint;
+    uint16_t ref_count;
+    struct _shared_metadata *next;
+} _shared_metadata_t;
+#endif
+
 typedef struct _endpoint {
     uint16_t endpoint_id;
     uint8_t device_type_count;
@@ -193,19 +313,69 @@ typedef struct _endpoint {
     uint8_t device_type_versions[ESP_MATTER_MAX_DEVICE_TYPE_COUNT];
     uint16_t flags;
     _cluster_t *cluster_list;
+    uint16_t cluster_count;
     EmberAfEndpointType *endpoint_type;
+    /* Set for endpoints with a fixed composition, the metadata is then used from flash instead of endpoint_type */
+    const EmberAfEndpointType *static_endpoint_type;
     DataVersion *data_versions_ptr;
     EmberAfDeviceType *device_types_ptr;
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+    /* Set while endpoint_type is shared with other endpoints, it is then copied before being changed */
+    _shared_metadata_t *shared_metadata;
+#endif
     uint16_t parent_endpoint_id;
     void *priv_data;
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_ARENA
+    arena::arena_t arena;
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_BRIDGED_ENDPOINT_ENABLE
+    /* Set by enable_all() for bridged endpoints, which are then enabled in the background */
+    bool enable_pending;
+#endif
     struct _endpoint *next;
 } _endpoint_t;
 
 typedef struct _node {
     _endpoint_t *endpoint_list;
     uint16_t min_unused_endpoint_id;
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_TABLE
+    /* Endpoints indexed by endpoint ID, for the IDs below CONFIG_ESP_MATTER_ENDPOINT_TABLE_MAX_SIZE */
+    _endpoint_t **endpoint_table;
+    uint16_t endpoint_table_size;
+    /* Set when the table could not grow, the endpoints are then only found through the list */
+    bool endpoint_table_disabled;
+#endif
 } _node_t;
 
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_ARENA
+#define ENDPOINT_ARENA(endpoint) (&(endpoint)->arena)
+#define CLUSTER_ARENA(cluster) ((cluster)->arena)
+#else
+#define ENDPOINT_ARENA(endpoint) ((arena::arena_t *)NULL)
+#define CLUSTER_ARENA(cluster) ((arena::arena_t *)NULL)
+#endif
+
+/* The data model elements are allocated from the endpoint arena, if it is enabled, else they are placed as configured
+ * for their tag. The Ember metadata is replaced while the endpoint exists, it is always allocated from the heap. */
+static void *dm_calloc(arena::arena_t *endpoint_arena, esp_matter_mem_tag_t tag, size_t n, size_t size)
+{
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_ARENA
+    return arena::allocate(endpoint_arena, n * size);
+#else
+    return esp_matter_mem_calloc_tagged(tag, n, size);
+#endif
+}
+
+static void dm_free(arena::arena_t *endpoint_arena, void *ptr, size_t size)
+{
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_ARENA
+    /* Kept in the arena for the next element of the same type, the blocks are released in endpoint::destroy() */
+    arena::deallocate(endpoint_arena, ptr, size);
+#else
+    esp_matter_mem_free(ptr);
+#endif
+}
+
 namespace node {
 
 static _node_t *node = NULL;
@@ -230,6 +400,17 @@ static esp_err_t store_min_unused_endpoint_id()
     return err;
 }
 
+#if CONFIG_ESP_MATTER_DEFER_ENDPOINT_ID_PERSISTENCE
+/* Stores the minimum unused endpoint_id in a batch of the esp_matter namespace, committed by end_store_batch() */
+static esp_err_t store_min_unused_endpoint_id_in_batch(nvs_handle_t handle)
+{
+    if (!node) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return nvs_set_u16(handle, "min_uu_ep_id", node->min_unused_endpoint_id);
+}
+#endif
+
 static esp_err_t read_min_unused_endpoint_id()
 {
     if (!node || !esp_matter_started) {
@@ -276,57 +457,117 @@ static esp_err_t read_min_unused_endpoint_id()
 
 } /* node */
 
-namespace cluster {
-static int get_count(_cluster_t *current)
+namespace attribute {
+
+extern esp_err_t get_data_from_attr_val(esp_matter_attr_val_t *val, EmberAfAttributeType *attribute_type,
+                                        uint16_t *attribute_size, uint8_t *value);
+
+/* Registers the esp_restart() handler storing the deferred attributes */
+static void register_shutdown_flush();
+
+/* The default values of more than 2 bytes which are not min max are shared by the attributes with the same default,
+ * most of them are the zeroed values of the same types */
+typedef struct shared_default_value {
+    struct shared_default_value *next;
+    uint16_t ref_count;
+    uint16_t size;
+    /* Followed by the value */
+} shared_default_value_t;
+
+static shared_default_value_t *s_shared_default_values = NULL;
+
+/* Values up to this size are encoded on the stack before looking for a shared value */
+static constexpr uint16_t k_default_value_stack_size = 64;
+
+static uint8_t *get_shared_data(shared_default_value_t *shared)
 {
-    int count = 0;
-    while (current) {
-        current = current->next;
-        count++;
-    }
-    return count;
+    return (uint8_t *)(shared + 1);
 }
-} /* cluster */
 
-namespace command {
-static int get_count(_command_t *current, int command_flag)
+static shared_default_value_t *find_shared_default_value(const uint8_t *data, uint16_t size)
 {
-    int count = 0;
-    while (current) {
-        if (current->flags & command_flag) {
-            count++;
+    for (shared_default_value_t *shared = s_shared_default_values; shared; shared = shared->next) {
+        if (shared->size == size && shared->ref_count < UINT16_MAX && memcmp(get_shared_data(shared), data, size) == 0) {
+            return shared;
         }
-        current = current->next;
     }
-    return count;
+    return NULL;
 }
-} /* command */
 
-namespace event {
-static int get_count(_event_t *current)
+static const uint8_t *acquire_shared_default_value(esp_matter_attr_val_t *val, EmberAfAttributeType attribute_type,
+                                                   uint16_t attribute_size)
 {
-    int count = 0;
-    while (current) {
-        count++;
-        current = current->next;
+    uint8_t stack_buffer[k_default_value_stack_size];
+    shared_default_value_t *new_shared = NULL;
+    uint8_t *data = stack_buffer;
+    if (attribute_size > k_default_value_stack_size) {
+        /* Encode the large values in their own block directly and drop it if the value already exists */
+        new_shared = (shared_default_value_t *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_DEFAULT_VALUE, 1,
+                                                                            sizeof(shared_default_value_t) + attribute_size);
+        if (!new_shared) {
+            ESP_LOGE(TAG, "Could not allocate value buffer for default value");
+            return NULL;
+        }
+        data = get_shared_data(new_shared);
     }
-    return count;
+    get_data_from_attr_val(val, &attribute_type, &attribute_size, data);
+
+    shared_default_value_t *shared = find_shared_default_value(data, attribute_size);
+    if (shared) {
+        esp_matter_mem_free(new_shared);
+        shared->ref_count++;
+        return get_shared_data(shared);
+    }
+    if (!new_shared) {
+        new_shared = (shared_default_value_t *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_DEFAULT_VALUE, 1,
+                                                                            sizeof(shared_default_value_t) + attribute_size);
+        if (!new_shared) {
+            ESP_LOGE(TAG, "Could not allocate value buffer for default value");
+            return NULL;
+        }
+        memcpy(get_shared_data(new_shared), data, attribute_size);
+    }
+    new_shared->ref_count = 1;
+    new_shared->size = attribute_size;
+    new_shared->next = s_shared_default_values;
+    s_shared_default_values = new_shared;
+    return get_shared_data(new_shared);
 }
+
+static void release_shared_default_value(const uint8_t *data)
+{
+    for (shared_default_value_t **link = &s_shared_default_values; *link; link = &(*link)->next) {
+        shared_default_value_t *shared = *link;
+        if (get_shared_data(shared) != data) {
+            continue;
+        }
+        if (--shared->ref_count == 0) {
+            *link = shared->next;
+            esp_matter_mem_free(shared);
+        }
+        return;
+    }
 }
 
-namespace attribute {
+static uint16_t get_shared_default_value_ref_count(const uint8_t *data)
+{
+    if (!data) {
+        return 1;
+    }
+    return ((const shared_default_value_t *)data - 1)->ref_count;
+}
 
-extern esp_err_t get_data_from_attr_val(esp_matter_attr_val_t *val, EmberAfAttributeType *attribute_type,
-                                        uint16_t *attribute_size, uint8_t *value);
+/* The bounds, the min max value and the default, min and max values of more than 2 bytes of a min max attribute are
+ * packed in one block. The bounds of the attribute point to it. */
+typedef struct min_max_block {
+    esp_matter_attr_bounds_t bounds;
+    EmberAfAttributeMinMaxValue min_max_value;
+    /* Followed by the default, min and max values when they are more than 2 bytes */
+} min_max_block_t;
 
-static int get_count(_attribute_t *current)
+static size_t get_min_max_block_size(uint16_t attribute_size)
 {
-    int count = 0;
-    while (current) {
-        current = current->next;
-        count++;
-    }
-    return count;
+    return sizeof(min_max_block_t) + (attribute_size > 2 ? 3 * attribute_size : 0);
 }
 
 static esp_err_t free_default_value(attribute_t *attribute)
@@ -337,59 +578,43 @@ static esp_err_t free_default_value(attribute_t *attribute)
     }
     _attribute_t *current_attribute = (_attribute_t *)attribute;
 
-    /* Free value if data is more than 2 bytes or if it is min max attribute */
     if (current_attribute->flags & ATTRIBUTE_FLAG_MIN_MAX) {
-        if (current_attribute->default_value_size > 2) {
-            if (current_attribute->default_value.ptrToMinMaxValue->defaultValue.ptrToDefaultValue) {
-                esp_matter_mem_free((void *)current_attribute->default_value.ptrToMinMaxValue->defaultValue.ptrToDefaultValue);
-            }
-            if (current_attribute->default_value.ptrToMinMaxValue->minValue.ptrToDefaultValue) {
-                esp_matter_mem_free((void *)current_attribute->default_value.ptrToMinMaxValue->minValue.ptrToDefaultValue);
-            }
-            if (current_attribute->default_value.ptrToMinMaxValue->maxValue.ptrToDefaultValue) {
-                esp_matter_mem_free((void *)current_attribute->default_value.ptrToMinMaxValue->maxValue.ptrToDefaultValue);
-            }
-        }
-        esp_matter_mem_free((void *)current_attribute->default_value.ptrToMinMaxValue);
-    } else if (current_attribute->default_value_size > 2) {
-        if (current_attribute->default_value.ptrToDefaultValue) {
-            esp_matter_mem_free((void *)current_attribute->default_value.ptrToDefaultValue);
-        }
+        /* The bounds are in the block */
+        esp_matter_mem_free(current_attribute->bounds);
+        current_attribute->bounds = NULL;
+    } else if (current_attribute->default_value_size > 2 && current_attribute->default_value.ptrToDefaultValue) {
+        release_shared_default_value(current_attribute->default_value.ptrToDefaultValue);
     }
+    current_attribute->default_value.ptrToDefaultValue = NULL;
     return ESP_OK;
 }
 
+/* Encode the value as the default value of the ember metadata, the values of more than 2 bytes are encoded in buffer,
+ * which holds attribute_size bytes */
 static EmberAfDefaultAttributeValue get_default_value_from_data(esp_matter_attr_val_t *val,
                                                                 EmberAfAttributeType attribute_type,
-                                                                uint16_t attribute_size)
+                                                                uint16_t attribute_size, uint8_t *buffer)
 {
-    EmberAfDefaultAttributeValue default_value = (uint16_t)0;
-    uint8_t *value = (uint8_t *)esp_matter_mem_calloc(1, attribute_size);
-    if (!value) {
-        ESP_LOGE(TAG, "Could not allocate value buffer for default value");
-        return default_value;
+    if (attribute_size > 2) {
+        get_data_from_attr_val(val, &attribute_type, &attribute_size, buffer);
+        return EmberAfDefaultAttributeValue(buffer);
     }
+    /* This data is 2 bytes or less. This should be represented as uint16. Copy the bytes appropriately for 0 or 1 or
+    2 bytes to be converted to uint16. */
+    uint8_t value[2] = {0};
     get_data_from_attr_val(val, &attribute_type, &attribute_size, value);
-
-    if (attribute_size > 2) {
-        /* Directly set the pointer */
-        default_value = value;
-    } else {
-        /* This data is 2 bytes or less. This should be represented as uint16. Copy the bytes appropriately
-        for 0 or 1 or 2 bytes to be converted to uint16. Then free the allocated buffer. */
-        uint16_t int_value = 0;
-        if (attribute_size == 2) {
-            memcpy(&int_value, value, attribute_size);
-        } else if (attribute_size == 1) {
-            int_value = (uint16_t)*value;
-        }
-        default_value = int_value;
-        esp_matter_mem_free(value);
+    uint16_t int_value = 0;
+    if (attribute_size == 2) {
+        memcpy(&int_value, value, attribute_size);
+    } else if (attribute_size == 1) {
+        int_value = (uint16_t)*value;
     }
-    return default_value;
+    return EmberAfDefaultAttributeValue(int_value);
 }
 
-static esp_err_t set_default_value_from_current_val(attribute_t *attribute)
+/* Set the default value from the current value, with the bounds as min and max values if they are not NULL. The
+ * previous default value must have been freed. */
+static esp_err_t set_default_value_from_current_val(attribute_t *attribute, const esp_matter_attr_bounds_t *bounds)
 {
     if (!attribute) {
         ESP_LOGE(TAG, "Attribute cannot be NULL");
@@ -404,25 +629,35 @@ static esp_err_t set_default_value_from_current_val(attribute_t *attribute)
     get_data_from_attr_val(val, &attribute_type, &attribute_size, NULL);
 
     /* Get and set value */
-    if (current_attribute->flags & ATTRIBUTE_FLAG_MIN_MAX) {
-        EmberAfAttributeMinMaxValue *temp_value = (EmberAfAttributeMinMaxValue *)esp_matter_mem_calloc(1,
-                                                                                sizeof(EmberAfAttributeMinMaxValue));
-        if (!temp_value) {
-            ESP_LOGE(TAG, "Could not allocate ptrToMinMaxValue for default value");
-            return ESP_FAIL;
+    if (bounds) {
+        min_max_block_t *block = (min_max_block_t *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_BOUNDS, 1,
+                                                                               get_min_max_block_size(attribute_size));
+        if (!block) {
+            ESP_LOGE(TAG, "Could not allocate bounds and ptrToMinMaxValue for default value");
+            current_attribute->flags &= ~ATTRIBUTE_FLAG_MIN_MAX;
+            return ESP_ERR_NO_MEM;
         }
-        temp_value->defaultValue = get_default_value_from_data(val, attribute_type, attribute_size);
-        temp_value->minValue = get_default_value_from_data(&current_attribute->bounds->min, attribute_type,
-                                                           attribute_size);
-        temp_value->maxValue = get_default_value_from_data(&current_attribute->bounds->max, attribute_type,
-                                                           attribute_size);
-        current_attribute->default_value.ptrToMinMaxValue = temp_value;
-    } else if (attribute_size > 2) {
-        EmberAfDefaultAttributeValue temp_value = get_default_value_from_data(val, attribute_type, attribute_size);
-        current_attribute->default_value.ptrToDefaultValue = temp_value.ptrToDefaultValue;
+        block->bounds = *bounds;
+        uint8_t *values = (uint8_t *)(block + 1);
+        EmberAfAttributeMinMaxValue *min_max_value = &block->min_max_value;
+        min_max_value->defaultValue = get_default_value_from_data(val, attribute_type, attribute_size, values);
+        min_max_value->minValue = get_default_value_from_data(&block->bounds.min, attribute_type, attribute_size,
+                                                              values + attribute_size);
+        min_max_value->maxValue = get_default_value_from_data(&block->bounds.max, attribute_type, attribute_size,
+                                                              values + 2 * attribute_size);
+        current_attribute->bounds = &block->bounds;
+        current_attribute->default_value.ptrToMinMaxValue = min_max_value;
+        current_attribute->flags |= ATTRIBUTE_FLAG_MIN_MAX;
     } else {
-        EmberAfDefaultAttributeValue temp_value = get_default_value_from_data(val, attribute_type, attribute_size);
-        current_attribute->default_value.defaultValue = temp_value.defaultValue;
+        /* There cannot be a min max value without bounds */
+        current_attribute->flags &= ~ATTRIBUTE_FLAG_MIN_MAX;
+        if (attribute_size > 2) {
+            current_attribute->default_value.ptrToDefaultValue = acquire_shared_default_value(val, attribute_type,
+                                                                                              attribute_size);
+        } else {
+            current_attribute->default_value.defaultValue =
+                get_default_value_from_data(val, attribute_type, attribute_size, NULL).defaultValue;
+        }
     }
     current_attribute->default_value_size = attribute_size;
     return ESP_OK;
@@ -431,18 +666,45 @@ static esp_err_t set_default_value_from_current_val(attribute_t *attribute)
 
 namespace endpoint {
 
+/* Index of a free dynamic endpoint, the dynamic endpoints follow the fixed endpoints of a zap data model */
 static int get_next_index()
 {
     uint16_t endpoint_id = 0;
-    for (int index = 0; index < MAX_ENDPOINT_COUNT; index++) {
+    uint16_t fixed_count = emberAfFixedEndpointCount();
+    for (int index = fixed_count; index < MAX_ENDPOINT_COUNT; index++) {
         endpoint_id = emberAfEndpointFromIndex(index);
         if (endpoint_id == kInvalidEndpointId) {
-            return index;
+            return index - fixed_count;
         }
     }
     return 0xFFFF;
 }
 
+static void release_endpoint_metadata(_endpoint_t *current_endpoint);
+static void fill_attribute_metadata(_attribute_t *attribute, EmberAfAttributeMetadata *matter_attribute);
+
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+/* Must be called with the chip stack lock, once the endpoint is added to the stack */
+static void register_attribute_access(_endpoint_t *current_endpoint)
+{
+    for (_cluster_t *cluster = current_endpoint->cluster_list; cluster; cluster = cluster->next) {
+        if (cluster->flags & CLUSTER_FLAG_SERVER) {
+            /* The reads of the cluster go through the ember path if it fails */
+            attribute_access::register_cluster(current_endpoint->endpoint_id, (cluster_t *)cluster,
+                                               &cluster->attribute_access);
+        }
+    }
+}
+
+/* Must be called with the chip stack lock, before the endpoint is removed from the stack */
+static void unregister_attribute_access(_endpoint_t *current_endpoint)
+{
+    for (_cluster_t *cluster = current_endpoint->cluster_list; cluster; cluster = cluster->next) {
+        attribute_access::unregister_cluster(&cluster->attribute_access);
+    }
+}
+#endif
+
 static esp_err_t disable(endpoint_t *endpoint)
 {
     if (!endpoint) {
@@ -467,35 +729,31 @@ static esp_err_t disable(endpoint_t *endpoint)
         }
         return ESP_FAIL;
     }
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+    unregister_attribute_access(current_endpoint);
+#endif
     emberAfClearDynamicEndpoint(endpoint_index);
+    acl_cache::invalidate();
 
     if (lock_status == lock::SUCCESS) {
         lock::chip_stack_unlock();
     }
+    if (current_endpoint->static_endpoint_type) {
+        /* The metadata lives in flash, only the data versions and the device types have been allocated */
+        if (current_endpoint->data_versions_ptr) {
+            esp_matter_mem_free(current_endpoint->data_versions_ptr);
+            current_endpoint->data_versions_ptr = NULL;
+        }
+        if (current_endpoint->device_types_ptr) {
+            esp_matter_mem_free(current_endpoint->device_types_ptr);
+            current_endpoint->device_types_ptr = NULL;
+        }
+        return ESP_OK;
+    }
     if (!(current_endpoint->endpoint_type)) {
         ESP_LOGE(TAG, "endpoint %" PRIu16 "'s endpoint_type is NULL", current_endpoint->endpoint_id);
         return ESP_ERR_INVALID_STATE;
     }
-    /* Free all clusters */
-    EmberAfEndpointType *endpoint_type = current_endpoint->endpoint_type;
-    int cluster_count = endpoint_type->clusterCount;
-    for (int cluster_index = 0; cluster_index < cluster_count; cluster_index++) {
-        /* Free attributes */
-        esp_matter_mem_free((void *)endpoint_type->cluster[cluster_index].attributes);
-        /* Free commands */
-        if (endpoint_type->cluster[cluster_index].acceptedCommandList) {
-            esp_matter_mem_free((void *)endpoint_type->cluster[cluster_index].acceptedCommandList);
-        }
-        if (endpoint_type->cluster[cluster_index].generatedCommandList) {
-            esp_matter_mem_free((void *)endpoint_type->cluster[cluster_index].generatedCommandList);
-        }
-        /* Free events */
-        if (endpoint_type->cluster[cluster_index].eventList) {
-            esp_matter_mem_free((void *)endpoint_type->cluster[cluster_index].eventList);
-        }
-    }
-    esp_matter_mem_free((void *)endpoint_type->cluster);
-
     /* Free data versions */
     if (current_endpoint->data_versions_ptr) {
         esp_matter_mem_free(current_endpoint->data_versions_ptr);
@@ -508,1375 +766,4368 @@ static esp_err_t disable(endpoint_t *endpoint)
         current_endpoint->device_types_ptr = NULL;
     }
 
-    /* Free endpoint type */
-    esp_matter_mem_free(endpoint_type);
-    current_endpoint->endpoint_type = NULL;
+    /* Free all clusters and the endpoint type */
+    release_endpoint_metadata(current_endpoint);
 
     return ESP_OK;
 }
 
-esp_err_t enable(endpoint_t *endpoint)
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+static int compare_command_table_entries(const void *a, const void *b)
 {
-    if (!endpoint) {
-        ESP_LOGE(TAG, "Endpoint cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
-    }
-    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    uint32_t a_id = (*(_command_t *const *)a)->command_id;
+    uint32_t b_id = (*(_command_t *const *)b)->command_id;
+    return a_id < b_id ? -1 : (a_id > b_id ? 1 : 0);
+}
 
-    /* Endpoint Type */
-    EmberAfEndpointType *endpoint_type = (EmberAfEndpointType *)esp_matter_mem_calloc(1, sizeof(EmberAfEndpointType));
-    if (!endpoint_type) {
-        ESP_LOGE(TAG, "Couldn't allocate endpoint_type");
-        /* goto cleanup is not used here to avoid 'crosses initialization' of data_versions below */
-        return ESP_ERR_NO_MEM;
+static int compare_command_table_key(const void *key, const void *entry)
+{
+    uint32_t key_id = *(const uint32_t *)key;
+    uint32_t entry_id = (*(_command_t *const *)entry)->command_id;
+    return key_id < entry_id ? -1 : (key_id > entry_id ? 1 : 0);
+}
+
+static void destroy_command_table(_cluster_t *cluster)
+{
+    if (cluster->accepted_command_table) {
+        esp_matter_mem_free(cluster->accepted_command_table);
+        cluster->accepted_command_table = NULL;
     }
-    current_endpoint->endpoint_type = endpoint_type;
+    cluster->accepted_command_table_size = 0;
+}
 
-    /* Device types */
-    EmberAfDeviceType *device_types_ptr = (EmberAfDeviceType *)esp_matter_mem_calloc(current_endpoint->device_type_count, sizeof(EmberAfDeviceType));
-    if (!device_types_ptr) {
-        ESP_LOGE(TAG, "Couldn't allocate device_types");
-        esp_matter_mem_free(endpoint_type);
-        current_endpoint->endpoint_type = NULL;
-        /* goto cleanup is not used here to avoid 'crosses initialization' of device_types below */
-        return ESP_ERR_NO_MEM;
+/* Build the sorted table of the accepted commands of the cluster. It is not part of the ember metadata, so failing to
+ * allocate it is not fatal: the dispatch falls back to walking the command list. */
+static void create_command_table(_cluster_t *cluster)
+{
+    destroy_command_table(cluster);
+    int command_count = cluster->accepted_command_count;
+    if (command_count == 0) {
+        return;
     }
-    for (size_t i = 0; i < current_endpoint->device_type_count; ++i) {
-        device_types_ptr[i].deviceId = current_endpoint->device_type_ids[i];
-        device_types_ptr[i].deviceVersion = current_endpoint->device_type_versions[i];
+    _command_t **table = (_command_t **)esp_matter_mem_calloc(command_count, sizeof(_command_t *));
+    if (!table) {
+        ESP_LOGW(TAG, "Couldn't allocate the command table of cluster 0x%08" PRIX32, cluster->cluster_id);
+        return;
     }
-    chip::Span<EmberAfDeviceType> device_types(device_types_ptr, current_endpoint->device_type_count);
-    current_endpoint->device_types_ptr = device_types_ptr;
-
-    /* Clusters */
-    _cluster_t *cluster = current_endpoint->cluster_list;
-    int cluster_count = cluster::get_count(cluster);
-    int cluster_index = 0;
+    int command_index = 0;
+    for (_command_t *command = cluster->command_list; command; command = command->next) {
+        if (command->flags & COMMAND_FLAG_ACCEPTED) {
+            table[command_index++] = command;
+        }
+    }
+    qsort(table, command_count, sizeof(_command_t *), compare_command_table_entries);
+    cluster->accepted_command_table = table;
+    cluster->accepted_command_table_size = command_count;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
 
-    DataVersion *data_versions_ptr = (DataVersion *)esp_matter_mem_calloc(1, cluster_count * sizeof(DataVersion));
-    if (!data_versions_ptr) {
-        ESP_LOGE(TAG, "Couldn't allocate data_versions");
-        esp_matter_mem_free(data_versions_ptr);
-        esp_matter_mem_free(endpoint_type);
-        current_endpoint->data_versions_ptr = NULL;
-        current_endpoint->endpoint_type = NULL;
-        /* goto cleanup is not used here to avoid 'crosses initialization' of data_versions below */
-        return ESP_ERR_NO_MEM;
+/* The command IDs of the list are the ones of the commands with the flag, in the same order */
+static bool command_list_matches(const CommandId *command_ids, _command_t *command, int command_flag)
+{
+    int command_index = 0;
+    for (; command; command = command->next) {
+        if (command->flags & command_flag) {
+            if (!command_ids || command_ids[command_index] != command->command_id) {
+                return false;
+            }
+            command_index++;
+        }
     }
-    chip::Span<chip::DataVersion> data_versions(data_versions_ptr, cluster_count);
-    current_endpoint->data_versions_ptr = data_versions_ptr;
+    return !command_ids || command_ids[command_index] == kInvalidCommandId;
+}
 
-    /* Variables */
-    /* This is needed to avoid 'crosses initialization' errors because of goto */
-    esp_err_t err = ESP_OK;
-    lock::status_t lock_status = lock::FAILED;
-    CHIP_ERROR status = CHIP_NO_ERROR;
-    EmberAfCluster *matter_clusters = NULL;
-    _attribute_t *attribute = NULL;
-    int attribute_count = 0;
+static bool static_cluster_metadata_matches(_cluster_t *cluster, const EmberAfCluster *matter_cluster)
+{
+    if (matter_cluster->clusterId != cluster->cluster_id || matter_cluster->attributeCount != cluster->attribute_count) {
+        return false;
+    }
     int attribute_index = 0;
-    EmberAfAttributeMetadata *matter_attributes = NULL;
-    CommandId *accepted_command_ids = NULL;
-    CommandId *generated_command_ids = NULL;
-    _command_t *command = NULL;
-    int command_count = 0;
-    int command_index = 0;
-    int command_flag = COMMAND_FLAG_NONE;
-    EventId *event_ids = NULL;
-    _event_t *event = NULL;
-    int event_count = 0;
+    for (_attribute_t *attribute = cluster->attribute_list; attribute; attribute = attribute->next) {
+        /* Compare with the metadata endpoint::enable() would have built */
+        EmberAfAttributeMetadata expected = {EmberAfDefaultOrMinMaxAttributeValue(static_cast<uint32_t>(0))};
+        fill_attribute_metadata(attribute, &expected);
+        const EmberAfAttributeMetadata *matter_attribute = &matter_cluster->attributes[attribute_index++];
+        if (matter_attribute->attributeId != expected.attributeId ||
+            matter_attribute->attributeType != expected.attributeType || matter_attribute->size != expected.size) {
+            ESP_LOGE(TAG, "Static metadata of attribute 0x%08" PRIX32 " does not match", attribute->attribute_id);
+            return false;
+        }
+    }
+    if (!command_list_matches(matter_cluster->acceptedCommandList, cluster->command_list, COMMAND_FLAG_ACCEPTED) ||
+        !command_list_matches(matter_cluster->generatedCommandList, cluster->command_list, COMMAND_FLAG_GENERATED)) {
+        return false;
+    }
     int event_index = 0;
-    int endpoint_index = 0;
-
-    matter_clusters = (EmberAfCluster *)esp_matter_mem_calloc(1, cluster_count * sizeof(EmberAfCluster));
-    if (!matter_clusters) {
-        ESP_LOGE(TAG, "Couldn't allocate matter_clusters");
-        err = ESP_ERR_NO_MEM;
-        goto cleanup;
+    for (_event_t *event = cluster->event_list; event; event = event->next) {
+        if (event_index >= matter_cluster->eventCount || matter_cluster->eventList[event_index] != event->event_id) {
+            return false;
+        }
+        event_index++;
     }
+    return event_index == matter_cluster->eventCount;
+}
 
+static esp_err_t validate_static_metadata(_endpoint_t *current_endpoint, const EmberAfEndpointType *endpoint_type)
+{
+    /* The tables are served as is by the stack, they must describe exactly the elements of the data model */
+    _cluster_t *cluster = current_endpoint->cluster_list;
+    int cluster_index = 0;
     while (cluster) {
-        /* Attributes */
-        attribute = cluster->attribute_list;
-        attribute_count = attribute::get_count(attribute);
-        attribute_index = 0;
-        matter_attributes = (EmberAfAttributeMetadata *)esp_matter_mem_calloc(1, attribute_count * sizeof(EmberAfAttributeMetadata));
-        if (!matter_attributes) {
-            if (attribute_count != 0) {
-                ESP_LOGE(TAG, "Couldn't allocate matter_attributes");
-                err = ESP_ERR_NO_MEM;
-                break;
-            }
-        }
-
-        while (attribute) {
-            matter_attributes[attribute_index].attributeId = attribute->attribute_id;
-            matter_attributes[attribute_index].mask = attribute->flags;
-            matter_attributes[attribute_index].defaultValue = attribute->default_value;
-            attribute::get_data_from_attr_val(&attribute->val, &matter_attributes[attribute_index].attributeType,
-                                              &matter_attributes[attribute_index].size, NULL);
-
-            /* The length is not fixed for string attribute, so set it to the max size (32) to avoid overflow issue 
-             * when writing a longer string.
-             */
-            if (attribute->val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
-                attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING) {
-                // Once the metadata is created, the attribute size becomes fixed and cannot be modified thereafter.
-                // For string and long string types, the size should be the maximum size defined in the specification
-                // plus the size_for_storing_str_len. The length byte is 1 for char string and 2 for long char string.
-                // For example, the maximum size of the Node-Label in the basic information cluster is 32 bytes,
-                // and it is a char string. Therefore, the size should be (32 + 1).
-                uint16_t size_for_storing_str_len = attribute->val.val.a.t - attribute->val.val.a.s;
-                matter_attributes[attribute_index].size = attribute->max_val_size + size_for_storing_str_len;
-            }
-
-            matter_clusters[cluster_index].clusterSize += matter_attributes[attribute_index].size;
-            attribute = attribute->next;
-            attribute_index++;
-        }
-
-        /* Commands */
-        command = NULL;
-        command_count = 0;
-        command_index = 0;
-        command_flag = COMMAND_FLAG_NONE;
-        accepted_command_ids = NULL;
-        generated_command_ids = NULL;
-
-        /* Client Generated Commands */
-        command_flag = COMMAND_FLAG_ACCEPTED;
-        command = cluster->command_list;
-        command_count = command::get_count(command, command_flag);
-        if (command_count > 0) {
-            command_index = 0;
-            accepted_command_ids = (CommandId *)esp_matter_mem_calloc(1, (command_count + 1) * sizeof(CommandId));
-            if (!accepted_command_ids) {
-                ESP_LOGE(TAG, "Couldn't allocate accepted_command_ids");
-                err = ESP_ERR_NO_MEM;
-                break;
-            }
-            while (command) {
-                if (command->flags & command_flag) {
-                    accepted_command_ids[command_index] = command->command_id;
-                    command_index++;
-                }
-                command = command->next;
-            }
-            accepted_command_ids[command_index] = kInvalidCommandId;
-        }
-
-        /* Server Generated Commands */
-        command_flag = COMMAND_FLAG_GENERATED;
-        command = cluster->command_list;
-        command_count = command::get_count(command, command_flag);
-        if (command_count > 0) {
-            command_index = 0;
-            generated_command_ids = (CommandId *)esp_matter_mem_calloc(1, (command_count + 1) * sizeof(CommandId));
-            if (!generated_command_ids) {
-                ESP_LOGE(TAG, "Couldn't allocate generated_command_ids");
-                err = ESP_ERR_NO_MEM;
-                break;
-            }
-            while (command) {
-                if (command->flags & command_flag) {
-                    generated_command_ids[command_index] = command->command_id;
-                    command_index++;
-                }
-                command = command->next;
-            }
-            generated_command_ids[command_index] = kInvalidCommandId;
-        }
-
-        /* Event */
-        event = cluster->event_list;
-        event_count = event::get_count(event);
-        if (event_count > 0) {
-            event_index = 0;
-            event_ids = (EventId *)esp_matter_mem_calloc(1, (event_count + 1) * sizeof(EventId));
-            if (!event_ids) {
-                ESP_LOGE(TAG, "Couldn't allocate event_ids");
-                err = ESP_ERR_NO_MEM;
-                break;
-            }
-            while (event) {
-                event_ids[event_index] = event->event_id;
-                event_index++;
-                event = event->next;
-            }
-            event_ids[event_index] = chip::kInvalidEventId;
+        if (cluster_index >= endpoint_type->clusterCount ||
+            !static_cluster_metadata_matches(cluster, &endpoint_type->cluster[cluster_index])) {
+            ESP_LOGE(TAG, "Static metadata of endpoint %" PRIu16 " does not match cluster 0x%08" PRIX32,
+                     current_endpoint->endpoint_id, cluster->cluster_id);
+            return ESP_ERR_INVALID_STATE;
         }
-
-        /* Fill up the cluster */
-        matter_clusters[cluster_index].clusterId = cluster->cluster_id;
-        matter_clusters[cluster_index].attributes = matter_attributes;
-        matter_clusters[cluster_index].attributeCount = attribute_count;
-        matter_clusters[cluster_index].mask = cluster->flags;
-        matter_clusters[cluster_index].functions = (EmberAfGenericClusterFunction *)cluster->function_list;
-        matter_clusters[cluster_index].acceptedCommandList = accepted_command_ids;
-        matter_clusters[cluster_index].generatedCommandList = generated_command_ids;
-        matter_clusters[cluster_index].eventList = event_ids;
-        matter_clusters[cluster_index].eventCount = event_count;
-
-        /* Get next cluster */
-        endpoint_type->endpointSize += matter_clusters[cluster_index].clusterSize;
         cluster = cluster->next;
         cluster_index++;
-
-        /* This is to avoid double free in case of errors */
-        matter_attributes = NULL;
-        accepted_command_ids = NULL;
-        generated_command_ids = NULL;
-        event_ids = NULL;
     }
+    if (cluster_index != endpoint_type->clusterCount) {
+        ESP_LOGE(TAG, "Static metadata of endpoint %" PRIu16 " has %" PRIu8 " clusters, the endpoint has %d",
+                 current_endpoint->endpoint_id, endpoint_type->clusterCount, cluster_index);
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t enable_static(_endpoint_t *current_endpoint)
+{
+    const EmberAfEndpointType *endpoint_type = current_endpoint->static_endpoint_type;
+    esp_err_t err = validate_static_metadata(current_endpoint, endpoint_type);
     if (err != ESP_OK) {
-        goto cleanup;
+        return err;
     }
 
-    endpoint_type->cluster = matter_clusters;
-    endpoint_type->clusterCount = cluster_count;
+    /* The data versions are written by the stack and the device types are owned by the endpoint, those still need
+     * to be in RAM. */
+    EmberAfDeviceType *device_types_ptr = (EmberAfDeviceType *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_DEVICE_TYPES, current_endpoint->device_type_count, sizeof(EmberAfDeviceType));
+    DataVersion *data_versions_ptr = (DataVersion *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_DATA_VERSION, 1, endpoint_type->clusterCount * sizeof(DataVersion));
+    if (!device_types_ptr || !data_versions_ptr) {
+        ESP_LOGE(TAG, "Couldn't allocate device_types or data_versions");
+        esp_matter_mem_free(device_types_ptr);
+        esp_matter_mem_free(data_versions_ptr);
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t i = 0; i < current_endpoint->device_type_count; ++i) {
+        device_types_ptr[i].deviceId = current_endpoint->device_type_ids[i];
+        device_types_ptr[i].deviceVersion = current_endpoint->device_type_versions[i];
+    }
+    chip::Span<EmberAfDeviceType> device_types(device_types_ptr, current_endpoint->device_type_count);
+    chip::Span<chip::DataVersion> data_versions(data_versions_ptr, endpoint_type->clusterCount);
 
     /* Take lock if not already taken */
-    lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
     if (lock_status == lock::FAILED) {
         ESP_LOGE(TAG, "Could not get task context");
-        goto cleanup;
+        esp_matter_mem_free(device_types_ptr);
+        esp_matter_mem_free(data_versions_ptr);
+        return ESP_FAIL;
     }
 
     /* Add Endpoint */
-    endpoint_index = endpoint::get_next_index();
-    status = emberAfSetDynamicEndpoint(endpoint_index, current_endpoint->endpoint_id, endpoint_type, data_versions,
-                                       device_types, current_endpoint->parent_endpoint_id);
-    if (status != CHIP_NO_ERROR) {
-        ESP_LOGE(TAG, "Error adding dynamic endpoint %" PRIu16 ": %" CHIP_ERROR_FORMAT, current_endpoint->endpoint_id, status.Format());
-        err = ESP_FAIL;
-        if (lock_status == lock::SUCCESS) {
-            lock::chip_stack_unlock();
-        }
-        goto cleanup;
+    int endpoint_index = endpoint::get_next_index();
+    CHIP_ERROR status = emberAfSetDynamicEndpoint(endpoint_index, current_endpoint->endpoint_id, endpoint_type,
+                                                  data_versions, device_types, current_endpoint->parent_endpoint_id);
+    /* The access control entries can target the device types of the endpoint */
+    acl_cache::invalidate();
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+    if (status == CHIP_NO_ERROR) {
+        register_attribute_access(current_endpoint);
+    }
+#endif
+#if CONFIG_ESP_MATTER_PERSIST_DATA_VERSIONS
+    if (status == CHIP_NO_ERROR) {
+        data_version::restore((endpoint_t *)current_endpoint);
     }
+#endif
     if (lock_status == lock::SUCCESS) {
         lock::chip_stack_unlock();
     }
-    ESP_LOGI(TAG, "Dynamic endpoint %" PRIu16 " added", current_endpoint->endpoint_id);
-    return err;
-
-cleanup:
-    if (generated_command_ids) {
-        esp_matter_mem_free(generated_command_ids);
-    }
-    if (accepted_command_ids) {
-        esp_matter_mem_free(accepted_command_ids);
+    if (status != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Error adding dynamic endpoint %" PRIu16 ": %" CHIP_ERROR_FORMAT, current_endpoint->endpoint_id, status.Format());
+        esp_matter_mem_free(device_types_ptr);
+        esp_matter_mem_free(data_versions_ptr);
+        return ESP_FAIL;
     }
-    if (event_ids) {
-        esp_matter_mem_free(event_ids);
+    current_endpoint->device_types_ptr = device_types_ptr;
+    current_endpoint->data_versions_ptr = data_versions_ptr;
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+    for (_cluster_t *cluster = current_endpoint->cluster_list; cluster; cluster = cluster->next) {
+        create_command_table(cluster);
     }
-    if (matter_attributes) {
-        esp_matter_mem_free(matter_attributes);
+#endif
+    ESP_LOGI(TAG, "Dynamic endpoint %" PRIu16 " added with static metadata", current_endpoint->endpoint_id);
+    return ESP_OK;
+}
+
+/* The attributes, the accepted and generated command lists and the events of a cluster are laid out in a single
+ * block, which starts with the attributes. The command and event lists are terminated by an invalid ID. */
+static size_t get_cluster_metadata_size(size_t attribute_count, size_t accepted_command_count,
+                                        size_t generated_command_count, size_t event_count)
+{
+    return attribute_count * sizeof(EmberAfAttributeMetadata) +
+        (accepted_command_count ? (accepted_command_count + 1) * sizeof(CommandId) : 0) +
+        (generated_command_count ? (generated_command_count + 1) * sizeof(CommandId) : 0) +
+        (event_count ? (event_count + 1) * sizeof(EventId) : 0);
+}
+
+static void free_cluster_metadata(EmberAfCluster *matter_cluster)
+{
+    /* The lists are in the block of the attributes */
+    if (matter_cluster->attributes) {
+        esp_matter_mem_free((void *)matter_cluster->attributes);
+    }
+    matter_cluster->attributes = NULL;
+    matter_cluster->acceptedCommandList = NULL;
+    matter_cluster->generatedCommandList = NULL;
+    matter_cluster->eventList = NULL;
+}
+
+static void fill_attribute_metadata(_attribute_t *attribute, EmberAfAttributeMetadata *matter_attribute)
+{
+    matter_attribute->attributeId = attribute->attribute_id;
+    matter_attribute->mask = attribute->flags;
+    matter_attribute->defaultValue = attribute->default_value;
+    attribute::get_data_from_attr_val(&attribute->val, &matter_attribute->attributeType, &matter_attribute->size,
+                                      NULL);
+
+    /* The length is not fixed for string attribute, so set it to the max size (32) to avoid overflow issue 
+     * when writing a longer string.
+     */
+    if (attribute->val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+        attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING) {
+        // Once the metadata is created, the attribute size becomes fixed and cannot be modified thereafter.
+        // For string and long string types, the size should be the maximum size defined in the specification
+        // plus the size_for_storing_str_len. The length byte is 1 for char string and 2 for long char string.
+        // For example, the maximum size of the Node-Label in the basic information cluster is 32 bytes,
+        // and it is a char string. Therefore, the size should be (32 + 1).
+        uint16_t size_for_storing_str_len = attribute->val.val.a.t - attribute->val.val.a.s;
+        matter_attribute->size = attribute->max_val_size + size_for_storing_str_len;
     }
-    if (matter_clusters) {
-        for (int cluster_index = 0; cluster_index < cluster_count; cluster_index++) {
-            /* Free attributes */
-            if (matter_clusters[cluster_index].attributes) {
-                esp_matter_mem_free((void *)matter_clusters[cluster_index].attributes);
-            }
-            /* Free commands */
-            if (matter_clusters[cluster_index].acceptedCommandList) {
-                esp_matter_mem_free((void *)matter_clusters[cluster_index].acceptedCommandList);
-            }
-            if (matter_clusters[cluster_index].generatedCommandList) {
-                esp_matter_mem_free((void *)matter_clusters[cluster_index].generatedCommandList);
-            }
-            /* Free events */
-            if (matter_clusters[cluster_index].eventList) {
-                esp_matter_mem_free((void *)matter_clusters[cluster_index].eventList);
-            }
+}
+
+/* Build the ember metadata of a single cluster, in one pass over each of its lists. On failure, nothing is left
+ * allocated. */
+static esp_err_t create_cluster_metadata(_cluster_t *cluster, EmberAfCluster *matter_cluster)
+{
+    memset(matter_cluster, 0, sizeof(EmberAfCluster));
+    size_t size = get_cluster_metadata_size(cluster->attribute_count, cluster->accepted_command_count,
+                                            cluster->generated_command_count, cluster->event_count);
+    uint8_t *block = NULL;
+    if (size > 0) {
+        block = (uint8_t *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_METADATA, 1, size);
+        if (!block) {
+            ESP_LOGE(TAG, "Couldn't allocate the metadata of cluster 0x%08" PRIX32, cluster->cluster_id);
+            return ESP_ERR_NO_MEM;
         }
-        esp_matter_mem_free(matter_clusters);
     }
-    if (data_versions_ptr) {
-        esp_matter_mem_free(data_versions_ptr);
-        current_endpoint->data_versions_ptr = NULL;
+
+    /* Attributes */
+    EmberAfAttributeMetadata *matter_attributes = (EmberAfAttributeMetadata *)block;
+    int attribute_index = 0;
+    for (_attribute_t *attribute = cluster->attribute_list; attribute; attribute = attribute->next) {
+        fill_attribute_metadata(attribute, &matter_attributes[attribute_index]);
+        matter_cluster->clusterSize += matter_attributes[attribute_index].size;
+        attribute_index++;
+    }
+    matter_cluster->attributes = matter_attributes;
+    matter_cluster->attributeCount = cluster->attribute_count;
+
+    /* Client generated and server generated commands */
+    CommandId *accepted_command_ids = (CommandId *)(block + cluster->attribute_count *
+                                                    sizeof(EmberAfAttributeMetadata));
+    CommandId *generated_command_ids = accepted_command_ids +
+        (cluster->accepted_command_count ? cluster->accepted_command_count + 1 : 0);
+    int accepted_index = 0;
+    int generated_index = 0;
+    for (_command_t *command = cluster->command_list; command; command = command->next) {
+        if (command->flags & COMMAND_FLAG_ACCEPTED) {
+            accepted_command_ids[accepted_index++] = command->command_id;
+        }
+        if (command->flags & COMMAND_FLAG_GENERATED) {
+            generated_command_ids[generated_index++] = command->command_id;
+        }
     }
-    if (device_types_ptr) {
-        esp_matter_mem_free(device_types_ptr);
-        current_endpoint->device_types_ptr = NULL;
+    if (cluster->accepted_command_count) {
+        accepted_command_ids[accepted_index] = kInvalidCommandId;
+        matter_cluster->acceptedCommandList = accepted_command_ids;
     }
-    if (endpoint_type) {
-        esp_matter_mem_free(endpoint_type);
-        current_endpoint->endpoint_type = NULL;
+    if (cluster->generated_command_count) {
+        generated_command_ids[generated_index] = kInvalidCommandId;
+        matter_cluster->generatedCommandList = generated_command_ids;
     }
-    return err;
+
+    /* Events */
+    if (cluster->event_count) {
+        EventId *event_ids = (EventId *)(generated_command_ids +
+                                         (cluster->generated_command_count ? cluster->generated_command_count + 1 : 0));
+        int event_index = 0;
+        for (_event_t *event = cluster->event_list; event; event = event->next) {
+            event_ids[event_index++] = event->event_id;
+        }
+        event_ids[event_index] = chip::kInvalidEventId;
+        matter_cluster->eventList = event_ids;
+        matter_cluster->eventCount = cluster->event_count;
+    }
+
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+    create_command_table(cluster);
+#endif
+
+    /* Fill up the cluster */
+    matter_cluster->clusterId = cluster->cluster_id;
+    matter_cluster->mask = cluster->flags;
+    matter_cluster->functions = (EmberAfGenericClusterFunction *)cluster->function_list;
+    return ESP_OK;
 }
 
-static esp_err_t enable_all()
+/* The cluster array is allocated along with the endpoint type, enable_cluster() replaces it with a separate one */
+static bool has_inline_cluster_array(const EmberAfEndpointType *endpoint_type)
 {
-    node_t *node = node::get();
-    if (!node) {
-        /* Not returning error, since the node will not be initialized for application using the data model from zap */
-        return ESP_OK;
-    }
+    return endpoint_type->cluster == (const EmberAfCluster *)(endpoint_type + 1);
+}
 
-    endpoint_t *endpoint = get_first(node);
-    while (endpoint) {
-        enable(endpoint);
-        endpoint = get_next(endpoint);
+static EmberAfEndpointType *alloc_endpoint_metadata(size_t cluster_count)
+{
+    EmberAfEndpointType *endpoint_type = (EmberAfEndpointType *)esp_matter_mem_calloc_tagged(
+        ESP_MATTER_MEM_TAG_METADATA, 1, sizeof(EmberAfEndpointType) + cluster_count * sizeof(EmberAfCluster));
+    if (endpoint_type) {
+        endpoint_type->cluster = (const EmberAfCluster *)(endpoint_type + 1);
     }
-    return ESP_OK;
+    return endpoint_type;
 }
-} /* endpoint */
 
-namespace lock {
-#define DEFAULT_TICKS (500 / portTICK_PERIOD_MS) /* 500 ms in ticks */
-status_t chip_stack_lock(uint32_t ticks_to_wait)
+static void free_endpoint_metadata(EmberAfEndpointType *endpoint_type)
 {
-#if CHIP_STACK_LOCK_TRACKING_ENABLED
-    if (PlatformMgr().IsChipStackLockedByCurrentThread()) {
-        return ALREADY_TAKEN;
+    for (int cluster_index = 0; cluster_index < endpoint_type->clusterCount; cluster_index++) {
+        free_cluster_metadata((EmberAfCluster *)&endpoint_type->cluster[cluster_index]);
     }
-#endif
-    if (ticks_to_wait == portMAX_DELAY) {
-        /* Special handling for max delay */
-        PlatformMgr().LockChipStack();
-        return SUCCESS;
+    if (!has_inline_cluster_array(endpoint_type)) {
+        esp_matter_mem_free((void *)endpoint_type->cluster);
     }
-    uint32_t ticks_remaining = ticks_to_wait;
-    uint32_t ticks = DEFAULT_TICKS;
-    while (ticks_remaining > 0) {
-        if (PlatformMgr().TryLockChipStack()) {
-            return SUCCESS;
+    esp_matter_mem_free(endpoint_type);
+}
+
+/* Build the ember metadata of all the clusters of the endpoint */
+static esp_err_t create_endpoint_metadata(_endpoint_t *current_endpoint, EmberAfEndpointType **endpoint_type_out)
+{
+    EmberAfEndpointType *endpoint_type = alloc_endpoint_metadata(current_endpoint->cluster_count);
+    if (!endpoint_type) {
+        ESP_LOGE(TAG, "Couldn't allocate endpoint_type");
+        return ESP_ERR_NO_MEM;
+    }
+    EmberAfCluster *matter_clusters = (EmberAfCluster *)endpoint_type->cluster;
+
+    esp_err_t err = ESP_OK;
+    int cluster_index = 0;
+    for (_cluster_t *cluster = current_endpoint->cluster_list; cluster; cluster = cluster->next) {
+        int64_t profile_start_us = startup_profile::now();
+        err = create_cluster_metadata(cluster, &matter_clusters[cluster_index]);
+        startup_profile::aggregate_add(startup_profile::AGGREGATE_CLUSTER_METADATA, profile_start_us);
+        if (err != ESP_OK) {
+            break;
         }
-        ticks = ticks_remaining < DEFAULT_TICKS ? ticks_remaining : DEFAULT_TICKS;
-        ticks_remaining -= ticks;
-        ESP_LOGI(TAG, "Did not get lock yet. Retrying...");
-        vTaskDelay(ticks);
+        endpoint_type->endpointSize += matter_clusters[cluster_index].clusterSize;
+        cluster_index++;
     }
-    ESP_LOGE(TAG, "Could not get lock");
-    return FAILED;
+    /* Only the clusters built so far are freed on failure */
+    endpoint_type->clusterCount = cluster_index;
+    if (err != ESP_OK) {
+        free_endpoint_metadata(endpoint_type);
+        return err;
+    }
+    *endpoint_type_out = endpoint_type;
+    return ESP_OK;
 }
 
-esp_err_t chip_stack_unlock()
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+static _shared_metadata_t *s_shared_metadata_list = NULL;
+
+static uint32_t fingerprint_add(uint32_t fingerprint, uint32_t value)
 {
-    PlatformMgr().UnlockChipStack();
-    return ESP_OK;
+    /* FNV-1a over the bytes of the value */
+    for (int shift = 0; shift < 32; shift += 8) {
+        fingerprint ^= (value >> shift) & 0xFF;
+        fingerprint *= 16777619;
+    }
+    return fingerprint;
 }
-} /* lock */
 
-#ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
-static void deinit_ble_if_commissioned(void)
+/* Fingerprint of the composition, endpoints with different fingerprints never share their metadata */
+static uint32_t get_composition_fingerprint(_endpoint_t *current_endpoint)
 {
-#if CONFIG_BT_ENABLED && CONFIG_USE_BLE_ONLY_FOR_COMMISSIONING
-        if(chip::Server::GetInstance().GetFabricTable().FabricCount() > 0) {
-            esp_err_t err = ESP_OK;
-#if CONFIG_BT_NIMBLE_ENABLED
-            if (!ble_hs_is_enabled()) {
-                ESP_LOGI(TAG, "BLE already deinited");
-                return;
-            }
+    uint32_t fingerprint = 2166136261;
+    for (_cluster_t *cluster = current_endpoint->cluster_list; cluster; cluster = cluster->next) {
+        fingerprint = fingerprint_add(fingerprint, cluster->cluster_id);
+        fingerprint = fingerprint_add(fingerprint, cluster->flags);
+        for (_attribute_t *attribute = cluster->attribute_list; attribute; attribute = attribute->next) {
+            fingerprint = fingerprint_add(fingerprint, attribute->attribute_id);
+            fingerprint = fingerprint_add(fingerprint, attribute->flags);
+            fingerprint = fingerprint_add(fingerprint, attribute->val.type);
+            fingerprint = fingerprint_add(fingerprint, attribute->max_val_size);
+        }
+        for (_command_t *command = cluster->command_list; command; command = command->next) {
+            fingerprint = fingerprint_add(fingerprint, command->command_id);
+            fingerprint = fingerprint_add(fingerprint, command->flags);
+        }
+        for (_event_t *event = cluster->event_list; event; event = event->next) {
+            fingerprint = fingerprint_add(fingerprint, event->event_id);
+        }
+    }
+    return fingerprint;
+}
 
-            if (nimble_port_stop() != 0) {
-                ESP_LOGE(TAG, "nimble_port_stop() failed");
-                return;
-            }
-            nimble_port_deinit();
-#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
-            err = esp_nimble_hci_and_controller_deinit();
-#endif
-#endif /* CONFIG_BT_NIMBLE_ENABLED */
-#if CONFIG_IDF_TARGET_ESP32
-            err |= esp_bt_mem_release(ESP_BT_MODE_BTDM);
-#elif CONFIG_IDF_TARGET_ESP32C2 || CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32S3 || CONFIG_IDF_TARGET_ESP32H2 \
-       || CONFIG_IDF_TARGET_ESP32C6
-            err |= esp_bt_mem_release(ESP_BT_MODE_BLE);
-#endif
-            if (err != ESP_OK) {
-                ESP_LOGE(TAG, "BLE deinit failed");
-                return;
-            }
-            ESP_LOGI(TAG, "BLE deinit successful and memory reclaimed");
-            PostEvent(chip::DeviceLayer::DeviceEventType::kBLEDeinitialized);
+static bool default_value_matches(EmberAfDefaultAttributeValue a, EmberAfDefaultAttributeValue b, uint16_t size)
+{
+    /* Same rules as set_default_value_from_current_val() */
+    if (size > 2) {
+        if (!a.ptrToDefaultValue || !b.ptrToDefaultValue) {
+            return a.ptrToDefaultValue == b.ptrToDefaultValue;
         }
-#endif /* CONFIG_BT_ENABLED && CONFIG_USE_BLE_ONLY_FOR_COMMISSIONING */
+        return memcmp(a.ptrToDefaultValue, b.ptrToDefaultValue, size) == 0;
+    }
+    return a.defaultValue == b.defaultValue;
 }
 
-static void esp_matter_chip_init_task(intptr_t context)
+static bool default_values_match(const _attribute_t *a, const _attribute_t *b)
 {
-    TaskHandle_t task_to_notify = reinterpret_cast<TaskHandle_t>(context);
-    static chip::CommonCaseDeviceServerInitParams initParams;
-    initParams.InitializeStaticResourcesBeforeServerInit();
-    initParams.appDelegate = &s_app_delegate;
-    CHIP_ERROR ret = chip::Server::GetInstance().GetFabricTable().AddFabricDelegate(&s_fabric_delegate);
-    if (ret != CHIP_NO_ERROR)
-    {
-        ESP_LOGE(TAG, "Failed to add fabric delegate, err:%" CHIP_ERROR_FORMAT, ret.Format());
+    uint16_t size = a->default_value_size;
+    if (size != b->default_value_size) {
+        return false;
+    }
+    if (a->flags & ATTRIBUTE_FLAG_MIN_MAX) {
+        const EmberAfAttributeMinMaxValue *a_min_max = a->default_value.ptrToMinMaxValue;
+        const EmberAfAttributeMinMaxValue *b_min_max = b->default_value.ptrToMinMaxValue;
+        if (!a_min_max || !b_min_max) {
+            return a_min_max == b_min_max;
+        }
+        return default_value_matches(a_min_max->defaultValue, b_min_max->defaultValue, size) &&
+            default_value_matches(a_min_max->minValue, b_min_max->minValue, size) &&
+            default_value_matches(a_min_max->maxValue, b_min_max->maxValue, size);
     }
-    chip::Server::GetInstance().Init(initParams);
+    return default_value_matches(EmberAfDefaultAttributeValue(a->default_value.ptrToDefaultValue),
+                                 EmberAfDefaultAttributeValue(b->default_value.ptrToDefaultValue), size);
+}
 
-#if CHIP_DEVICE_CONFIG_ENABLE_THREAD
-    // If Thread is Provisioned, publish the dns service
-    if (chip::DeviceLayer::ConnectivityMgr().IsThreadProvisioned() &&
-        (chip::Server::GetInstance().GetFabricTable().FabricCount() != 0)) {
-        chip::app::DnssdServer::Instance().StartServer();
+static bool cluster_metadata_matches(_cluster_t *cluster, _cluster_t *owner_cluster,
+                                     const EmberAfCluster *matter_cluster)
+{
+    if (matter_cluster->clusterId != cluster->cluster_id ||
+        matter_cluster->mask != (EmberAfClusterMask)cluster->flags ||
+        matter_cluster->functions != (const EmberAfGenericClusterFunction *)cluster->function_list ||
+        matter_cluster->attributeCount != cluster->attribute_count) {
+        return false;
     }
-#endif
-    if (endpoint::enable_all() != ESP_OK) {
-        ESP_LOGE(TAG, "Enable all endpoints failure");
+    int attribute_index = 0;
+    for (_attribute_t *attribute = cluster->attribute_list; attribute; attribute = attribute->next) {
+        const EmberAfAttributeMetadata *shared_attribute = &matter_cluster->attributes[attribute_index++];
+        EmberAfAttributeMetadata matter_attribute = {EmberAfDefaultOrMinMaxAttributeValue(static_cast<uint32_t>(0))};
+        fill_attribute_metadata(attribute, &matter_attribute);
+        if (matter_attribute.attributeId != shared_attribute->attributeId ||
+            matter_attribute.mask != shared_attribute->mask ||
+            matter_attribute.attributeType != shared_attribute->attributeType ||
+            matter_attribute.size != shared_attribute->size) {
+            return false;
+        }
+        /* The default values of the metadata are the ones of the owner */
+        _attribute_t *owner_attribute = (_attribute_t *)attribute::get((cluster_t *)owner_cluster,
+                                                                       attribute->attribute_id);
+        if (!owner_attribute || !default_values_match(attribute, owner_attribute)) {
+            return false;
+        }
     }
-    // The following two events can't be recorded when we start the server because the endpoints are not enabled.
-    // TODO: Find a better way to record the events which should be recorded in matter server init
-    // Record start up event in basic information cluster.
-    PlatformMgr().HandleServerStarted();
-    // Record boot reason evnet in general diagnostics cluster.
-    chip::app::Clusters::GeneralDiagnostics::BootReasonEnum bootReason;
-    if (GetDiagnosticDataProvider().GetBootReason(bootReason) == CHIP_NO_ERROR) {
-        chip::app::Clusters::GeneralDiagnosticsServer::Instance().OnDeviceReboot(bootReason);
+    if (!command_list_matches(matter_cluster->acceptedCommandList, cluster->command_list, COMMAND_FLAG_ACCEPTED) ||
+        !command_list_matches(matter_cluster->generatedCommandList, cluster->command_list, COMMAND_FLAG_GENERATED)) {
+        return false;
     }
-#if CHIP_DEVICE_CONFIG_ENABLE_WIFI
-    {
-        static chip::app::Clusters::NetworkCommissioning::Instance sWiFiNetworkCommissioningInstance(0,
-                                            &(chip::DeviceLayer::NetworkCommissioning::ESPWiFiDriver::GetInstance()));
-        sWiFiNetworkCommissioningInstance.Init();
+    int event_index = 0;
+    for (_event_t *event = cluster->event_list; event; event = event->next) {
+        if (event_index >= matter_cluster->eventCount || matter_cluster->eventList[event_index] != event->event_id) {
+            return false;
+        }
+        event_index++;
     }
-#endif
-#if CHIP_DEVICE_CONFIG_ENABLE_ETHERNET
-    {
-        static chip::app::Clusters::NetworkCommissioning::Instance sEthernetNetworkCommissioningInstance(0,
-                                            &(chip::DeviceLayer::NetworkCommissioning::ESPEthernetDriver::GetInstance()));
-        sEthernetNetworkCommissioningInstance.Init();
+    return event_index == matter_cluster->eventCount;
+}
+
+static bool shared_metadata_matches(_endpoint_t *current_endpoint, const _shared_metadata_t *shared)
+{
+    const EmberAfEndpointType *endpoint_type = shared->endpoint_type;
+    int cluster_index = 0;
+    for (_cluster_t *cluster = current_endpoint->cluster_list; cluster; cluster = cluster->next) {
+        if (cluster_index >= endpoint_type->clusterCount) {
+            return false;
+        }
+        _cluster_t *owner_cluster = (_cluster_t *)cluster::get((endpoint_t *)shared->owner, cluster->cluster_id);
+        if (!owner_cluster ||
+            !cluster_metadata_matches(cluster, owner_cluster, &endpoint_type->cluster[cluster_index])) {
+            return false;
+        }
+        cluster_index++;
     }
-#endif
-    deinit_ble_if_commissioned();
-    xTaskNotifyGive(task_to_notify);
+    return cluster_index == endpoint_type->clusterCount;
 }
-#endif // CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
 
-static void device_callback_internal(const ChipDeviceEvent * event, intptr_t arg)
+static EmberAfEndpointType *acquire_shared_metadata(_endpoint_t *current_endpoint, uint32_t fingerprint)
 {
-    switch (event->Type)
-    {
-    case chip::DeviceLayer::DeviceEventType::kInterfaceIpAddressChanged:
-#if CHIP_DEVICE_CONFIG_ENABLE_WIFI || CHIP_DEVICE_CONFIG_ENABLE_ETHERNET
-        if (event->InterfaceIpAddressChanged.Type == chip::DeviceLayer::InterfaceIpChangeType::kIpV6_Assigned ||
-                event->InterfaceIpAddressChanged.Type == chip::DeviceLayer::InterfaceIpChangeType::kIpV4_Assigned) {
-            chip::app::DnssdServer::Instance().StartServer();
+    for (_shared_metadata_t *shared = s_shared_metadata_list; shared; shared = shared->next) {
+        if (shared->fingerprint == fingerprint && shared_metadata_matches(current_endpoint, shared)) {
+            shared->ref_count++;
+            current_endpoint->shared_metadata = shared;
+            return shared->endpoint_type;
         }
-#endif
-        break;
-#ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
-    case chip::DeviceLayer::DeviceEventType::kDnssdInitialized:
-        esp_matter_ota_requestor_start();
-        /* Initialize binding manager */
-        client::binding_manager_init();
-        break;
+    }
+    return NULL;
+}
 
-    case chip::DeviceLayer::DeviceEventType::kCommissioningComplete:
-        ESP_LOGI(TAG, "Commissioning Complete");
-        break;
+static void add_shared_metadata(_endpoint_t *current_endpoint, EmberAfEndpointType *endpoint_type,
+                                uint32_t fingerprint)
+{
+    _shared_metadata_t *shared = (_shared_metadata_t *)esp_matter_mem_calloc(1, sizeof(_shared_metadata_t));
+    if (!shared) {
+        /* Not fatal, the metadata is then private to the endpoint */
+        ESP_LOGW(TAG, "Couldn't allocate the shared metadata of endpoint %" PRIu16, current_endpoint->endpoint_id);
+        return;
+    }
+    shared->endpoint_type = endpoint_type;
+    shared->owner = current_endpoint;
+    shared->fingerprint = fingerprint;
+    shared->ref_count = 1;
+    shared->next = s_shared_metadata_list;
+    s_shared_metadata_list = shared;
+    current_endpoint->shared_metadata = shared;
+}
 
-    case chip::DeviceLayer::DeviceEventType::kCHIPoBLEConnectionClosed:
-        ESP_LOGI(TAG, "BLE Disconnected");
-        deinit_ble_if_commissioned();
-        break;
-#endif
-    default:
-        break;
+static void remove_shared_metadata(_shared_metadata_t *shared)
+{
+    _shared_metadata_t **entry = &s_shared_metadata_list;
+    while (*entry && *entry != shared) {
+        entry = &(*entry)->next;
     }
+    if (*entry) {
+        *entry = shared->next;
+    }
+    esp_matter_mem_free(shared);
 }
 
-static esp_err_t chip_init(event_callback_t callback, intptr_t callback_arg)
+/* Hand the metadata over to another endpoint using it, before the default values of the owner are freed */
+static void set_next_shared_metadata_owner(_shared_metadata_t *shared)
 {
-    if (chip::Platform::MemoryInit() != CHIP_NO_ERROR) {
-        ESP_LOGE(TAG, "Failed to initialize CHIP memory pool");
-        return ESP_ERR_NO_MEM;
-    }
-    if (PlatformMgr().InitChipStack() != CHIP_NO_ERROR) {
-        ESP_LOGE(TAG, "Failed to initialize CHIP stack");
-        return ESP_FAIL;
+    _node_t *current_node = (_node_t *)node::get();
+    _endpoint_t *owner = current_node ? current_node->endpoint_list : NULL;
+    while (owner && (owner == shared->owner || owner->shared_metadata != shared)) {
+        owner = owner->next;
+    }
+    if (!owner) {
+        return;
+    }
+    /* The default values of both endpoints are the same, only the pointers change */
+    const EmberAfEndpointType *endpoint_type = shared->endpoint_type;
+    for (int cluster_index = 0; cluster_index < endpoint_type->clusterCount; cluster_index++) {
+        const EmberAfCluster *matter_cluster = &endpoint_type->cluster[cluster_index];
+        cluster_t *cluster = cluster::get((endpoint_t *)owner, matter_cluster->clusterId);
+        EmberAfAttributeMetadata *matter_attributes = (EmberAfAttributeMetadata *)matter_cluster->attributes;
+        for (int attribute_index = 0; cluster && attribute_index < matter_cluster->attributeCount; attribute_index++) {
+            _attribute_t *attribute = (_attribute_t *)attribute::get(cluster,
+                                                                     matter_attributes[attribute_index].attributeId);
+            if (attribute) {
+                matter_attributes[attribute_index].defaultValue = attribute->default_value;
+            }
+        }
     }
+    shared->owner = owner;
+}
 
-    setup_providers();
-    // ConnectivityMgr().SetWiFiAPMode(ConnectivityManager::kWiFiAPMode_Enabled);
-    if (PlatformMgr().StartEventLoopTask() != CHIP_NO_ERROR) {
-        chip::Platform::MemoryShutdown();
-        ESP_LOGE(TAG, "Failed to launch Matter main task");
-        return ESP_FAIL;
+/* Replace the lists of a cluster entry copied from the shared metadata with a private copy of its block, the default
+ * values being the ones of the endpoint. On failure, the lists of the entry are cleared. */
+static esp_err_t copy_cluster_metadata(_endpoint_t *current_endpoint, EmberAfCluster *matter_cluster)
+{
+    const CommandId *lists[2] = {matter_cluster->acceptedCommandList, matter_cluster->generatedCommandList};
+    size_t list_counts[2] = {0, 0};
+    for (int list_index = 0; list_index < 2; list_index++) {
+        for (const CommandId *id = lists[list_index]; id && *id != kInvalidCommandId; id++) {
+            list_counts[list_index]++;
+        }
     }
-    PlatformMgr().AddEventHandler(device_callback_internal, static_cast<intptr_t>(NULL));
-    if(callback) {
-       PlatformMgr().AddEventHandler(callback, callback_arg);
+    size_t size = get_cluster_metadata_size(matter_cluster->attributeCount, list_counts[0], list_counts[1],
+                                            matter_cluster->eventList ? matter_cluster->eventCount : 0);
+    if (size == 0) {
+        return ESP_OK;
     }
-#if CHIP_DEVICE_CONFIG_ENABLE_THREAD
-    if (ThreadStackMgr().InitThreadStack() != CHIP_NO_ERROR) {
-        ESP_LOGE(TAG, "Failed to initialize Thread stack");
-        return ESP_FAIL;
+    /* The block of the shared entry has the same layout */
+    uint8_t *block = (uint8_t *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_METADATA, 1, size);
+    if (!block) {
+        ESP_LOGE(TAG, "Couldn't copy the metadata of cluster 0x%08" PRIX32, matter_cluster->clusterId);
+        matter_cluster->attributes = NULL;
+        free_cluster_metadata(matter_cluster);
+        return ESP_ERR_NO_MEM;
     }
-#if CHIP_CONFIG_ENABLE_ICD_SERVER
-    if (ConnectivityMgr().SetThreadDeviceType(ConnectivityManager::kThreadDeviceType_SleepyEndDevice) != CHIP_NO_ERROR) {
-        ESP_LOGE(TAG, "Failed to set the Thread device type");
+    const uint8_t *shared_block = (const uint8_t *)matter_cluster->attributes;
+    memcpy(block, shared_block, size);
+    const uint8_t *shared_lists[3] = {(const uint8_t *)matter_cluster->acceptedCommandList,
+                                      (const uint8_t *)matter_cluster->generatedCommandList,
+                                      (const uint8_t *)matter_cluster->eventList};
+    const uint8_t *copied_lists[3] = {NULL, NULL, NULL};
+    for (int list_index = 0; list_index < 3; list_index++) {
+        if (shared_lists[list_index]) {
+            copied_lists[list_index] = block + (shared_lists[list_index] - shared_block);
+        }
+    }
+    matter_cluster->attributes = (const EmberAfAttributeMetadata *)block;
+    matter_cluster->acceptedCommandList = (const CommandId *)copied_lists[0];
+    matter_cluster->generatedCommandList = (const CommandId *)copied_lists[1];
+    matter_cluster->eventList = (const EventId *)copied_lists[2];
+
+    cluster_t *cluster = cluster::get((endpoint_t *)current_endpoint, matter_cluster->clusterId);
+    EmberAfAttributeMetadata *matter_attributes = (EmberAfAttributeMetadata *)block;
+    for (int attribute_index = 0; cluster && attribute_index < matter_cluster->attributeCount; attribute_index++) {
+        _attribute_t *attribute = (_attribute_t *)attribute::get(cluster,
+                                                                 matter_attributes[attribute_index].attributeId);
+        if (attribute) {
+            matter_attributes[attribute_index].defaultValue = attribute->default_value;
+        }
+    }
+    return ESP_OK;
+}
+
+/* Copy the shared metadata for the endpoint, with its own default values */
+static esp_err_t copy_endpoint_metadata(_endpoint_t *current_endpoint, const EmberAfEndpointType *endpoint_type,
+                                       EmberAfEndpointType **endpoint_type_out)
+{
+    EmberAfEndpointType *copy = alloc_endpoint_metadata(endpoint_type->clusterCount);
+    if (!copy) {
+        ESP_LOGE(TAG, "Couldn't allocate the metadata copy of endpoint %" PRIu16, current_endpoint->endpoint_id);
+        return ESP_ERR_NO_MEM;
+    }
+    EmberAfCluster *matter_clusters = (EmberAfCluster *)copy->cluster;
+    *copy = *endpoint_type;
+    memcpy(matter_clusters, endpoint_type->cluster, endpoint_type->clusterCount * sizeof(EmberAfCluster));
+    copy->cluster = matter_clusters;
+    for (int cluster_index = 0; cluster_index < endpoint_type->clusterCount; cluster_index++) {
+        esp_err_t err = copy_cluster_metadata(current_endpoint, &matter_clusters[cluster_index]);
+        if (err != ESP_OK) {
+            /* The entries after this one still point to the shared lists */
+            copy->clusterCount = cluster_index + 1;
+            free_endpoint_metadata(copy);
+            return err;
+        }
+    }
+    *endpoint_type_out = copy;
+    return ESP_OK;
+}
+
+/* Drop the reference of the endpoint to its shared metadata. Returns the metadata if it is not used anymore. */
+static EmberAfEndpointType *release_shared_metadata(_endpoint_t *current_endpoint)
+{
+    _shared_metadata_t *shared = current_endpoint->shared_metadata;
+    EmberAfEndpointType *endpoint_type = shared->endpoint_type;
+    current_endpoint->shared_metadata = NULL;
+    if (--shared->ref_count > 0) {
+        if (shared->owner == current_endpoint) {
+            set_next_shared_metadata_owner(shared);
+        }
+        return NULL;
+    }
+    remove_shared_metadata(shared);
+    return endpoint_type;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+
+/* Free a copy of the metadata which did not replace the one of the endpoint */
+static void discard_metadata_copy(_endpoint_t *current_endpoint, EmberAfEndpointType *endpoint_type)
+{
+    if (endpoint_type != current_endpoint->endpoint_type) {
+        free_endpoint_metadata(endpoint_type);
+    }
+}
+
+static void release_endpoint_metadata(_endpoint_t *current_endpoint)
+{
+    EmberAfEndpointType *endpoint_type = current_endpoint->endpoint_type;
+    if (!endpoint_type) {
+        return;
+    }
+    current_endpoint->endpoint_type = NULL;
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+    if (current_endpoint->shared_metadata) {
+        endpoint_type = release_shared_metadata(current_endpoint);
+        if (!endpoint_type) {
+            /* Still used by other endpoints */
+            return;
+        }
+    }
+#endif
+    free_endpoint_metadata(endpoint_type);
+}
+
+esp_err_t enable(endpoint_t *endpoint)
+{
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    startup_profile::scoped_phase phase("endpoint_enable", current_endpoint->endpoint_id);
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_BRIDGED_ENDPOINT_ENABLE
+    current_endpoint->enable_pending = false;
+#endif
+    if (current_endpoint->static_endpoint_type) {
+        return enable_static(current_endpoint);
+    }
+
+    /* Device types */
+    EmberAfDeviceType *device_types_ptr = (EmberAfDeviceType *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_DEVICE_TYPES, current_endpoint->device_type_count, sizeof(EmberAfDeviceType));
+    if (!device_types_ptr) {
+        ESP_LOGE(TAG, "Couldn't allocate device_types");
+        /* goto cleanup is not used here to avoid 'crosses initialization' of device_types below */
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t i = 0; i < current_endpoint->device_type_count; ++i) {
+        device_types_ptr[i].deviceId = current_endpoint->device_type_ids[i];
+        device_types_ptr[i].deviceVersion = current_endpoint->device_type_versions[i];
+    }
+    chip::Span<EmberAfDeviceType> device_types(device_types_ptr, current_endpoint->device_type_count);
+    current_endpoint->device_types_ptr = device_types_ptr;
+
+    /* Data versions, they are written by the stack so they are never shared */
+    int cluster_count = current_endpoint->cluster_count;
+    DataVersion *data_versions_ptr = (DataVersion *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_DATA_VERSION, 1, cluster_count * sizeof(DataVersion));
+    if (!data_versions_ptr) {
+        ESP_LOGE(TAG, "Couldn't allocate data_versions");
+        esp_matter_mem_free(device_types_ptr);
+        current_endpoint->device_types_ptr = NULL;
+        /* goto cleanup is not used here to avoid 'crosses initialization' of data_versions below */
+        return ESP_ERR_NO_MEM;
+    }
+    chip::Span<chip::DataVersion> data_versions(data_versions_ptr, cluster_count);
+    current_endpoint->data_versions_ptr = data_versions_ptr;
+
+    /* Variables */
+    /* This is needed to avoid 'crosses initialization' errors because of goto */
+    esp_err_t err = ESP_OK;
+    lock::status_t lock_status = lock::FAILED;
+    CHIP_ERROR status = CHIP_NO_ERROR;
+    EmberAfEndpointType *endpoint_type = NULL;
+    int endpoint_index = 0;
+
+    /* Endpoint type and clusters */
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+    uint32_t fingerprint = get_composition_fingerprint(current_endpoint);
+    endpoint_type = acquire_shared_metadata(current_endpoint, fingerprint);
+    if (endpoint_type) {
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+        /* Built along with the metadata otherwise */
+        for (_cluster_t *cluster = current_endpoint->cluster_list; cluster; cluster = cluster->next) {
+            create_command_table(cluster);
+        }
+#endif
+    }
+#endif
+    if (!endpoint_type) {
+        err = create_endpoint_metadata(current_endpoint, &endpoint_type);
+        if (err != ESP_OK) {
+            goto cleanup;
+        }
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+        add_shared_metadata(current_endpoint, endpoint_type, fingerprint);
+#endif
+    }
+    current_endpoint->endpoint_type = endpoint_type;
+
+    /* Take lock if not already taken */
+    lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        err = ESP_FAIL;
+        goto cleanup;
+    }
+
+    /* Add Endpoint */
+    endpoint_index = endpoint::get_next_index();
+    status = emberAfSetDynamicEndpoint(endpoint_index, current_endpoint->endpoint_id, endpoint_type, data_versions,
+                                       device_types, current_endpoint->parent_endpoint_id);
+    acl_cache::invalidate();
+    if (status != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Error adding dynamic endpoint %" PRIu16 ": %" CHIP_ERROR_FORMAT, current_endpoint->endpoint_id, status.Format());
+        err = ESP_FAIL;
+        if (lock_status == lock::SUCCESS) {
+            lock::chip_stack_unlock();
+        }
+        goto cleanup;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+    register_attribute_access(current_endpoint);
+#endif
+#if CONFIG_ESP_MATTER_PERSIST_DATA_VERSIONS
+    data_version::restore(endpoint);
+#endif
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    ESP_LOGI(TAG, "Dynamic endpoint %" PRIu16 " added", current_endpoint->endpoint_id);
+    return err;
+
+cleanup:
+    release_endpoint_metadata(current_endpoint);
+    if (data_versions_ptr) {
+        esp_matter_mem_free(data_versions_ptr);
+        current_endpoint->data_versions_ptr = NULL;
+    }
+    if (device_types_ptr) {
+        esp_matter_mem_free(device_types_ptr);
+        current_endpoint->device_types_ptr = NULL;
+    }
+    return err;
+}
+
+esp_err_t enable_cluster(endpoint_t *endpoint, cluster_t *cluster)
+{
+    if (!endpoint || !cluster) {
+        ESP_LOGE(TAG, "Endpoint or cluster cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    if (current_cluster->endpoint_id != current_endpoint->endpoint_id) {
+        ESP_LOGE(TAG, "Cluster 0x%08" PRIX32 " does not belong to endpoint %" PRIu16, current_cluster->cluster_id,
+                 current_endpoint->endpoint_id);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (current_endpoint->static_endpoint_type) {
+        ESP_LOGE(TAG, "Endpoint %" PRIu16 " uses static metadata and cannot be changed", current_endpoint->endpoint_id);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    EmberAfEndpointType *endpoint_type = current_endpoint->endpoint_type;
+    if (!endpoint_type) {
+        /* Not enabled yet, the cluster is picked up by the regular enable */
+        return enable(endpoint);
+    }
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+    /* Copy on write: the endpoint changes its own copy of the metadata shared with other endpoints, the shared one is
+     * released once the stack uses the copy */
+    _shared_metadata_t *shared = current_endpoint->shared_metadata;
+    if (shared && shared->ref_count == 1) {
+        /* No other endpoint uses the metadata, it becomes private and is changed in place */
+        remove_shared_metadata(shared);
+        current_endpoint->shared_metadata = NULL;
+    } else if (shared) {
+        esp_err_t err = copy_endpoint_metadata(current_endpoint, shared->endpoint_type, &endpoint_type);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+#endif
+
+    /* Find the entry of the cluster, or append one */
+    int cluster_count = endpoint_type->clusterCount;
+    int cluster_index = 0;
+    while (cluster_index < cluster_count && endpoint_type->cluster[cluster_index].clusterId !=
+           current_cluster->cluster_id) {
+        cluster_index++;
+    }
+    int new_cluster_count = cluster_index < cluster_count ? cluster_count : cluster_count + 1;
+    if (new_cluster_count > UINT8_MAX) {
+        ESP_LOGE(TAG, "Too many clusters on endpoint %" PRIu16, current_endpoint->endpoint_id);
+        discard_metadata_copy(current_endpoint, endpoint_type);
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* The entries of the other clusters are copied as is, their attribute and command arrays are shared */
+    EmberAfCluster *matter_clusters = (EmberAfCluster *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_METADATA, new_cluster_count, sizeof(EmberAfCluster));
+    DataVersion *data_versions_ptr = (DataVersion *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_DATA_VERSION, new_cluster_count, sizeof(DataVersion));
+    if (!matter_clusters || !data_versions_ptr) {
+        ESP_LOGE(TAG, "Couldn't allocate matter_clusters or data_versions");
+        esp_matter_mem_free(matter_clusters);
+        esp_matter_mem_free(data_versions_ptr);
+        discard_metadata_copy(current_endpoint, endpoint_type);
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(matter_clusters, endpoint_type->cluster, cluster_count * sizeof(EmberAfCluster));
+    memcpy(data_versions_ptr, current_endpoint->data_versions_ptr, cluster_count * sizeof(DataVersion));
+    esp_err_t err = create_cluster_metadata(current_cluster, &matter_clusters[cluster_index]);
+    if (err != ESP_OK) {
+        esp_matter_mem_free(matter_clusters);
+        esp_matter_mem_free(data_versions_ptr);
+        discard_metadata_copy(current_endpoint, endpoint_type);
+        return err;
+    }
+
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        free_cluster_metadata(&matter_clusters[cluster_index]);
+        esp_matter_mem_free(matter_clusters);
+        esp_matter_mem_free(data_versions_ptr);
+        discard_metadata_copy(current_endpoint, endpoint_type);
+        return ESP_FAIL;
+    }
+
+    /* Swap the metadata of the endpoint at the same index */
+    int endpoint_index = emberAfGetDynamicIndexFromEndpoint(current_endpoint->endpoint_id);
+    if (endpoint_index == 0xFFFF) {
+        ESP_LOGE(TAG, "Could not find endpoint index");
+        if (lock_status == lock::SUCCESS) {
+            lock::chip_stack_unlock();
+        }
+        free_cluster_metadata(&matter_clusters[cluster_index]);
+        esp_matter_mem_free(matter_clusters);
+        esp_matter_mem_free(data_versions_ptr);
+        discard_metadata_copy(current_endpoint, endpoint_type);
+        return ESP_FAIL;
+    }
+    EmberAfCluster old_cluster = {};
+    if (cluster_index < cluster_count) {
+        old_cluster = endpoint_type->cluster[cluster_index];
+        endpoint_type->endpointSize -= old_cluster.clusterSize;
+    }
+    const EmberAfCluster *old_clusters = endpoint_type->cluster;
+    DataVersion *old_data_versions = current_endpoint->data_versions_ptr;
+    endpoint_type->cluster = matter_clusters;
+    endpoint_type->clusterCount = new_cluster_count;
+    endpoint_type->endpointSize += matter_clusters[cluster_index].clusterSize;
+
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+    /* The stack drops the interfaces of the endpoint when it is cleared */
+    unregister_attribute_access(current_endpoint);
+#endif
+    emberAfClearDynamicEndpoint(endpoint_index);
+    chip::Span<chip::DataVersion> data_versions(data_versions_ptr, new_cluster_count);
+    chip::Span<EmberAfDeviceType> device_types(current_endpoint->device_types_ptr, current_endpoint->device_type_count);
+    CHIP_ERROR status = emberAfSetDynamicEndpoint(endpoint_index, current_endpoint->endpoint_id, endpoint_type,
+                                                  data_versions, device_types, current_endpoint->parent_endpoint_id);
+    if (status == CHIP_NO_ERROR) {
+        /* The stack initializes the data versions of the endpoint, keep the ones of the unchanged clusters so
+         * that the controllers do not need to read them again. */
+        for (int index = 0; index < cluster_count; index++) {
+            if (index != cluster_index) {
+                data_versions_ptr[index] = old_data_versions[index];
+            }
+        }
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+        register_attribute_access(current_endpoint);
+#endif
+    }
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+    if (endpoint_type != current_endpoint->endpoint_type) {
+        /* The stack does not use the shared metadata for this endpoint anymore */
+        EmberAfEndpointType *unused_endpoint_type = release_shared_metadata(current_endpoint);
+        if (unused_endpoint_type) {
+            free_endpoint_metadata(unused_endpoint_type);
+        }
+        current_endpoint->endpoint_type = endpoint_type;
+    }
+#endif
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    if (status != CHIP_NO_ERROR) {
+        /* The endpoint is gone from the stack, keep the new metadata in place so that disable() can free it */
+        ESP_LOGE(TAG, "Error adding dynamic endpoint %" PRIu16 ": %" CHIP_ERROR_FORMAT, current_endpoint->endpoint_id, status.Format());
+        err = ESP_FAIL;
+    }
+
+    /* Free the replaced metadata */
+    free_cluster_metadata(&old_cluster);
+    /* The array allocated along with the endpoint type is freed with it */
+    if (old_clusters != (const EmberAfCluster *)(endpoint_type + 1)) {
+        esp_matter_mem_free((void *)old_clusters);
+    }
+    esp_matter_mem_free(old_data_versions);
+    current_endpoint->data_versions_ptr = data_versions_ptr;
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Cluster 0x%08" PRIX32 " enabled on endpoint %" PRIu16, current_cluster->cluster_id,
+                 current_endpoint->endpoint_id);
+    }
+    return err;
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_BRIDGED_ENDPOINT_ENABLE
+static int64_t s_deferred_enable_start_us = 0;
+static bool s_deferred_enable_running = false;
+
+static void enable_deferred_batch(intptr_t context)
+{
+    node_t *node = node::get();
+    uint16_t enabled_count = 0;
+    bool pending = false;
+    _endpoint_t *current_endpoint = node ? (_endpoint_t *)get_first(node) : NULL;
+    while (current_endpoint) {
+        if (current_endpoint->enable_pending) {
+            if (enabled_count == CONFIG_ESP_MATTER_DEFERRED_ENABLE_BATCH_SIZE) {
+                pending = true;
+                break;
+            }
+            enable((endpoint_t *)current_endpoint);
+            enabled_count++;
+        }
+        current_endpoint = current_endpoint->next;
+    }
+
+    /* Give the other events a chance to run before the next batch */
+    if (pending && PlatformMgr().ScheduleWork(enable_deferred_batch) == CHIP_NO_ERROR) {
+        return;
+    }
+    if (pending) {
+        ESP_LOGE(TAG, "Couldn't schedule the next batch, enabling the remaining bridged endpoints now");
+        for (current_endpoint = (_endpoint_t *)get_first(node); current_endpoint;
+             current_endpoint = current_endpoint->next) {
+            if (current_endpoint->enable_pending) {
+                enable((endpoint_t *)current_endpoint);
+            }
+        }
+    }
+    s_deferred_enable_running = false;
+    ESP_LOGI(TAG, "Deferred enable of the bridged endpoints done in %" PRId64 " ms",
+             (esp_timer_get_time() - s_deferred_enable_start_us) / 1000);
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_DEFERRED_BRIDGED_ENDPOINT_ENABLE
+
+bool is_deferred_enable_complete()
+{
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_BRIDGED_ENDPOINT_ENABLE
+    return !s_deferred_enable_running;
+#else
+    return true;
+#endif
+}
+
+static esp_err_t enable_all()
+{
+    startup_profile::scoped_phase phase("enable_all");
+    node_t *node = node::get();
+    if (!node) {
+        /* Not returning error, since the node will not be initialized for application using the data model from zap */
+        return ESP_OK;
+    }
+
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_BRIDGED_ENDPOINT_ENABLE
+    uint16_t deferred_count = 0;
+#endif
+    endpoint_t *endpoint = get_first(node);
+    while (endpoint) {
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_BRIDGED_ENDPOINT_ENABLE
+        /* Root and aggregator endpoints come up first, so that the node is reachable as soon as possible */
+        _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+        if (current_endpoint->flags & ENDPOINT_FLAG_BRIDGE) {
+            current_endpoint->enable_pending = true;
+            deferred_count++;
+            endpoint = get_next(endpoint);
+            continue;
+        }
+#endif
+        enable(endpoint);
+        endpoint = get_next(endpoint);
+    }
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_BRIDGED_ENDPOINT_ENABLE
+    if (deferred_count > 0) {
+        ESP_LOGI(TAG, "Deferring the enable of %" PRIu16 " bridged endpoints", deferred_count);
+        s_deferred_enable_start_us = esp_timer_get_time();
+        s_deferred_enable_running = true;
+        if (PlatformMgr().ScheduleWork(enable_deferred_batch) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Couldn't schedule the deferred enable, enabling the bridged endpoints now");
+            enable_deferred_batch(0);
+        }
+    }
+#endif
+    return ESP_OK;
+}
+} /* endpoint */
+
+namespace lock {
+#define DEFAULT_TICKS (500 / portTICK_PERIOD_MS) /* 500 ms in ticks */
+status_t chip_stack_lock(uint32_t ticks_to_wait)
+{
+#if CHIP_STACK_LOCK_TRACKING_ENABLED
+    if (PlatformMgr().IsChipStackLockedByCurrentThread()) {
+        return ALREADY_TAKEN;
+    }
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+    void *caller = __builtin_return_address(0);
+    stats::wait_context_t wait_context;
+    stats::wait_begin(&wait_context);
+#endif
+    if (ticks_to_wait == portMAX_DELAY) {
+        /* Special handling for max delay */
+        PlatformMgr().LockChipStack();
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+        stats::acquired(caller, &wait_context);
+#endif
+        return SUCCESS;
+    }
+    uint32_t ticks_remaining = ticks_to_wait;
+    uint32_t ticks = DEFAULT_TICKS;
+    while (ticks_remaining > 0) {
+        if (PlatformMgr().TryLockChipStack()) {
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+            stats::acquired(caller, &wait_context);
+#endif
+            return SUCCESS;
+        }
+        ticks = ticks_remaining < DEFAULT_TICKS ? ticks_remaining : DEFAULT_TICKS;
+        ticks_remaining -= ticks;
+        ESP_LOGI(TAG, "Did not get lock yet. Retrying...");
+        vTaskDelay(ticks);
+    }
+    ESP_LOGE(TAG, "Could not get lock");
+    return FAILED;
+}
+
+esp_err_t chip_stack_unlock()
+{
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+    stats::released();
+#endif
+    PlatformMgr().UnlockChipStack();
+    return ESP_OK;
+}
+} /* lock */
+
+#ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+#if CONFIG_ESP_MATTER_BLE_MEM_REGION_POOL
+/* Sections of the BLE controller and host, as released by esp_bt_mem_release(). They are weak so that the sections
+ * which the linker script of a target or IDF version does not have are NULL. */
+extern "C" {
+extern char _bt_bss_start __attribute__((weak)), _bt_bss_end __attribute__((weak));
+extern char _bt_data_start __attribute__((weak)), _bt_data_end __attribute__((weak));
+extern char _bt_controller_bss_start __attribute__((weak)), _bt_controller_bss_end __attribute__((weak));
+extern char _bt_controller_data_start __attribute__((weak)), _bt_controller_data_end __attribute__((weak));
+extern char _nimble_bss_start __attribute__((weak)), _nimble_bss_end __attribute__((weak));
+extern char _nimble_data_start __attribute__((weak)), _nimble_data_end __attribute__((weak));
+}
+
+static esp_err_t release_bt_mem_to_region_pool()
+{
+    if (esp_bt_controller_get_status() != ESP_BT_CONTROLLER_STATUS_IDLE) {
+        ESP_LOGE(TAG, "The BLE controller is still initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    const struct {
+        char *start;
+        char *end;
+    } sections[] = {
+        {&_bt_controller_bss_start, &_bt_controller_bss_end},
+        {&_bt_controller_data_start, &_bt_controller_data_end},
+        {&_bt_bss_start, &_bt_bss_end},
+        {&_bt_data_start, &_bt_data_end},
+        {&_nimble_bss_start, &_nimble_bss_end},
+        {&_nimble_data_start, &_nimble_data_end},
+    };
+    size_t reclaimed = 0;
+    for (const auto &section : sections) {
+        if (!section.start || section.end <= section.start) {
+            continue;
+        }
+        size_t size = section.end - section.start;
+        if (esp_matter_mem_region_add(ESP_MATTER_MEM_REGION_BLE, section.start, size) == ESP_OK) {
+            reclaimed += size;
+            continue;
+        }
+        /* No room for the region in the pools, or it is too small for a heap of its own */
+        esp_err_t err = heap_caps_add_region((intptr_t)section.start, (intptr_t)section.end);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Could not reclaim the BLE section at %p, err:%d", section.start, err);
+        }
+    }
+    ESP_LOGI(TAG, "%u bytes of the BLE stack added to the \"%s\" memory pool", (unsigned)reclaimed,
+             ESP_MATTER_MEM_REGION_BLE);
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_MATTER_BLE_MEM_REGION_POOL
+
+static void deinit_ble_if_commissioned(void)
+{
+#if CONFIG_BT_ENABLED && CONFIG_USE_BLE_ONLY_FOR_COMMISSIONING
+        if(chip::Server::GetInstance().GetFabricTable().FabricCount() > 0) {
+            esp_err_t err = ESP_OK;
+#if CONFIG_BT_NIMBLE_ENABLED
+            if (!ble_hs_is_enabled()) {
+                ESP_LOGI(TAG, "BLE already deinited");
+                return;
+            }
+
+            if (nimble_port_stop() != 0) {
+                ESP_LOGE(TAG, "nimble_port_stop() failed");
+                return;
+            }
+            nimble_port_deinit();
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+            err = esp_nimble_hci_and_controller_deinit();
+#endif
+#endif /* CONFIG_BT_NIMBLE_ENABLED */
+#if CONFIG_ESP_MATTER_BLE_MEM_REGION_POOL
+            err |= release_bt_mem_to_region_pool();
+#elif CONFIG_IDF_TARGET_ESP32
+            err |= esp_bt_mem_release(ESP_BT_MODE_BTDM);
+#elif CONFIG_IDF_TARGET_ESP32C2 || CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32S3 || CONFIG_IDF_TARGET_ESP32H2 \
+       || CONFIG_IDF_TARGET_ESP32C6
+            err |= esp_bt_mem_release(ESP_BT_MODE_BLE);
+#endif
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "BLE deinit failed");
+                return;
+            }
+            ESP_LOGI(TAG, "BLE deinit successful and memory reclaimed");
+            PostEvent(chip::DeviceLayer::DeviceEventType::kBLEDeinitialized);
+        }
+#endif /* CONFIG_BT_ENABLED && CONFIG_USE_BLE_ONLY_FOR_COMMISSIONING */
+}
+
+static void esp_matter_chip_init_task(intptr_t context)
+{
+    TaskHandle_t task_to_notify = reinterpret_cast<TaskHandle_t>(context);
+    int init_task_phase = startup_profile::phase_begin("chip_init_task", UINT32_MAX);
+    static chip::CommonCaseDeviceServerInitParams initParams;
+    initParams.InitializeStaticResourcesBeforeServerInit();
+#if CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
+    initParams.persistentStorageDelegate = storage_cache::wrap(initParams.persistentStorageDelegate);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_STORAGE
+    initParams.persistentStorageDelegate = scene_storage::wrap(initParams.persistentStorageDelegate);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_GROUP_KEY_CACHE
+    if (chip::Credentials::GroupDataProvider *provider =
+            group_key_cache::get_provider(initParams.persistentStorageDelegate, initParams.sessionKeystore)) {
+        initParams.groupDataProvider = provider;
+    }
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_SYNCHRONIZED_REPORTS
+    initParams.reportScheduler = report_sync::get_scheduler();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ACL_CACHE
+    initParams.accessDelegate = acl_cache::wrap(initParams.accessDelegate);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_SESSION_RESUMPTION_STATS
+    if (chip::SessionResumptionStorage *storage = session_resumption::get_storage(initParams.persistentStorageDelegate)) {
+        initParams.sessionResumptionStorage = storage;
+    }
+#endif
+    initParams.appDelegate = &s_app_delegate;
+    CHIP_ERROR ret = chip::Server::GetInstance().GetFabricTable().AddFabricDelegate(&s_fabric_delegate);
+    if (ret != CHIP_NO_ERROR)
+    {
+        ESP_LOGE(TAG, "Failed to add fabric delegate, err:%" CHIP_ERROR_FORMAT, ret.Format());
+    }
+    {
+        startup_profile::scoped_phase phase("server_init");
+        chip::Server::GetInstance().Init(initParams);
+    }
+#if CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
+    hybrid::plugin_init_dynamic_clusters();
+#endif
+
+#if CHIP_DEVICE_CONFIG_ENABLE_THREAD
+    // If Thread is Provisioned, publish the dns service
+    if (chip::DeviceLayer::ConnectivityMgr().IsThreadProvisioned() &&
+        (chip::Server::GetInstance().GetFabricTable().FabricCount() != 0)) {
+        chip::app::DnssdServer::Instance().StartServer();
+    }
+#endif
+    if (endpoint::enable_all() != ESP_OK) {
+        ESP_LOGE(TAG, "Enable all endpoints failure");
+    }
+#if CONFIG_ESP_MATTER_ICD_REPORT_BATCHING
+    icd_report_batching::init();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
+    sed_poll::init();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+    e2e_latency::init();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
+    scene_storage::init_recall_batch();
+#endif
+#if CONFIG_ESP_MATTER_PERSIST_DATA_VERSIONS
+    data_version::init();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_EVENT_STORE
+    event_store::init();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_POOL_STATS
+    pool_stats::init();
+#endif
+    // The following two events can't be recorded when we start the server because the endpoints are not enabled.
+    // TODO: Find a better way to record the events which should be recorded in matter server init
+    // Record start up event in basic information cluster.
+    PlatformMgr().HandleServerStarted();
+    // Record boot reason evnet in general diagnostics cluster.
+    chip::app::Clusters::GeneralDiagnostics::BootReasonEnum bootReason;
+    if (GetDiagnosticDataProvider().GetBootReason(bootReason) == CHIP_NO_ERROR) {
+        chip::app::Clusters::GeneralDiagnosticsServer::Instance().OnDeviceReboot(bootReason);
+    }
+#if CHIP_DEVICE_CONFIG_ENABLE_WIFI
+    {
+        static chip::app::Clusters::NetworkCommissioning::Instance sWiFiNetworkCommissioningInstance(0,
+                                            &(chip::DeviceLayer::NetworkCommissioning::ESPWiFiDriver::GetInstance()));
+        sWiFiNetworkCommissioningInstance.Init();
+    }
+#endif
+#if CHIP_DEVICE_CONFIG_ENABLE_ETHERNET
+    {
+        static chip::app::Clusters::NetworkCommissioning::Instance sEthernetNetworkCommissioningInstance(0,
+                                            &(chip::DeviceLayer::NetworkCommissioning::ESPEthernetDriver::GetInstance()));
+        sEthernetNetworkCommissioningInstance.Init();
+    }
+#endif
+    deinit_ble_if_commissioned();
+    s_server_initialized = true;
+    startup_profile::phase_end(init_task_phase);
+    startup_profile::complete();
+    xTaskNotifyGive(task_to_notify);
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+
+static void device_callback_internal(const ChipDeviceEvent * event, intptr_t arg)
+{
+    if (s_network_up_phase >= 0 && (event->Type == chip::DeviceLayer::DeviceEventType::kInterfaceIpAddressChanged ||
+                                    event->Type == chip::DeviceLayer::DeviceEventType::kThreadConnectivityChange)) {
+        startup_profile::phase_end(s_network_up_phase);
+        s_network_up_phase = -1;
+    }
+    /* With start_network(), the network may come up before the server is initialized. Server::Init() then starts the
+     * DNS-SD server itself, so the events are only handled once the server is there. */
+    if (!s_server_initialized) {
+        return;
+    }
+    switch (event->Type)
+    {
+    case chip::DeviceLayer::DeviceEventType::kInterfaceIpAddressChanged:
+#if CHIP_DEVICE_CONFIG_ENABLE_WIFI || CHIP_DEVICE_CONFIG_ENABLE_ETHERNET
+        if (event->InterfaceIpAddressChanged.Type == chip::DeviceLayer::InterfaceIpChangeType::kIpV6_Assigned ||
+                event->InterfaceIpAddressChanged.Type == chip::DeviceLayer::InterfaceIpChangeType::kIpV4_Assigned) {
+            chip::app::DnssdServer::Instance().StartServer();
+        }
+#endif
+        break;
+#ifdef CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+    case chip::DeviceLayer::DeviceEventType::kDnssdInitialized:
+        esp_matter_ota_requestor_start();
+        esp_matter_ota_provider_start();
+        /* Initialize binding manager */
+        client::binding_manager_init();
+        break;
+
+    case chip::DeviceLayer::DeviceEventType::kCommissioningComplete:
+        ESP_LOGI(TAG, "Commissioning Complete");
+        break;
+
+    case chip::DeviceLayer::DeviceEventType::kCHIPoBLEConnectionClosed:
+        ESP_LOGI(TAG, "BLE Disconnected");
+        deinit_ble_if_commissioned();
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+static event_callback_t s_app_event_callback = NULL;
+
+static void watched_event_callback(const ChipDeviceEvent *event, intptr_t arg)
+{
+    callback_watchdog::scope watchdog(callback_watchdog::CALLBACK_KIND_EVENT, (void *)s_app_event_callback, 0, 0,
+                                      event->Type);
+    s_app_event_callback(event, arg);
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+
+/* Initializes the Matter stack and starts its event loop, and the Thread task, which starts the network bring-up */
+static esp_err_t chip_init_stack(event_callback_t callback, intptr_t callback_arg)
+{
+    startup_profile::scoped_phase phase("chip_init");
+    if (chip::Platform::MemoryInit() != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to initialize CHIP memory pool");
+        return ESP_ERR_NO_MEM;
+    }
+    if (PlatformMgr().InitChipStack() != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to initialize CHIP stack");
+        return ESP_FAIL;
+    }
+
+    {
+        startup_profile::scoped_phase phase("setup_providers");
+        setup_providers();
+    }
+    // ConnectivityMgr().SetWiFiAPMode(ConnectivityManager::kWiFiAPMode_Enabled);
+    if (PlatformMgr().StartEventLoopTask() != CHIP_NO_ERROR) {
+        chip::Platform::MemoryShutdown();
+        ESP_LOGE(TAG, "Failed to launch Matter main task");
+        return ESP_FAIL;
+    }
+    PlatformMgr().AddEventHandler(device_callback_internal, static_cast<intptr_t>(NULL));
+    if (device_event::init() != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize the device event registry");
+    }
+    if(callback) {
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+       s_app_event_callback = callback;
+       PlatformMgr().AddEventHandler(watched_event_callback, callback_arg);
+#else
+       PlatformMgr().AddEventHandler(callback, callback_arg);
+#endif
+    }
+#if CHIP_DEVICE_CONFIG_ENABLE_THREAD
+    if (ThreadStackMgr().InitThreadStack() != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to initialize Thread stack");
+        return ESP_FAIL;
+    }
+#if CHIP_CONFIG_ENABLE_ICD_SERVER
+    if (ConnectivityMgr().SetThreadDeviceType(ConnectivityManager::kThreadDeviceType_SleepyEndDevice) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to set the Thread device type");
+        return ESP_FAIL;
+    }
+
+#elif CHIP_DEVICE_CONFIG_THREAD_FTD
+    if (ConnectivityMgr().SetThreadDeviceType(ConnectivityManager::kThreadDeviceType_Router) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to set the Thread device type");
+        return ESP_FAIL;
+    }
+#else
+    if (ConnectivityMgr().SetThreadDeviceType(ConnectivityManager::kThreadDeviceType_MinimalEndDevice) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to set the Thread device type");
+        return ESP_FAIL;
+    }
+#endif
+    if (ThreadStackMgr().StartThreadTask() != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to launch Thread task");
+        return ESP_FAIL;
+    }
+#endif // CHIP_DEVICE_CONFIG_ENABLE_THREAD
+    return ESP_OK;
+}
+
+/* Initializes the Matter server and enables the endpoints of the data model, in the Matter context */
+static esp_err_t chip_init_server()
+{
+#if CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+    startup_profile::scoped_phase phase("chip_init_server");
+    PlatformMgr().ScheduleWork(esp_matter_chip_init_task, reinterpret_cast<intptr_t>(xTaskGetCurrentTaskHandle()));
+    // Wait for the matter stack to be initialized
+    xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+#endif // CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+    return ESP_OK;
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_memory_handler(int argc, char **argv)
+{
+    node_t *node = node::get();
+    if (!node) {
+        ESP_LOGE(TAG, "The ESP Matter data model is not used");
+        return ESP_ERR_INVALID_STATE;
+    }
+    node::print_memory_stats(node);
+    return ESP_OK;
+}
+
+#if CONFIG_ESP_MATTER_MEM_TRACE
+static uint32_t s_mem_trace_snapshot = 0;
+
+static esp_err_t console_mem_trace_stats_handler(int argc, char **argv)
+{
+    esp_matter_mem_trace_print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_mem_trace_snapshot_handler(int argc, char **argv)
+{
+    s_mem_trace_snapshot = esp_matter_mem_trace_snapshot();
+    printf("Snapshot %" PRIu32 "\n", s_mem_trace_snapshot);
+    return ESP_OK;
+}
+
+static esp_err_t console_mem_trace_diff_handler(int argc, char **argv)
+{
+    esp_matter_mem_trace_print_diff(s_mem_trace_snapshot);
+    return ESP_OK;
+}
+
+static console::engine mem_trace_console;
+
+static esp_err_t console_mem_trace_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        mem_trace_console.for_each_command(console::print_description, NULL);
+        return ESP_OK;
+    }
+    return mem_trace_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ESP_MATTER_MEM_TRACE
+
+static void register_console_commands()
+{
+    static const console::command_t command = {
+        .name = "memory",
+        .description = "Print the heap used by the data model per endpoint and cluster. Usage: matter esp memory.",
+        .handler = console_memory_handler,
+    };
+    console::add_commands(&command, 1);
+#if CONFIG_ESP_MATTER_MEM_TRACE
+    static const console::command_t mem_trace_command = {
+        .name = "mem_trace",
+        .description = "Allocations per subsystem and leak check. Usage: matter esp mem_trace <stats|snapshot|diff>.",
+        .handler = console_mem_trace_dispatch,
+    };
+    static const console::command_t mem_trace_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the live and peak bytes of each subsystem.",
+            .handler = console_mem_trace_stats_handler,
+        },
+        {
+            .name = "snapshot",
+            .description = "Take a snapshot of the live allocations.",
+            .handler = console_mem_trace_snapshot_handler,
+        },
+        {
+            .name = "diff",
+            .description = "Print the allocations made after the snapshot and not freed yet, per call site.",
+            .handler = console_mem_trace_diff_handler,
+        },
+    };
+    mem_trace_console.register_commands(mem_trace_commands,
+                                        sizeof(mem_trace_commands) / sizeof(console::command_t));
+    console::add_commands(&mem_trace_command, 1);
+#endif
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+/* Phase of the startup which does not need the data model: the Matter stack, then the Wi-Fi or Thread bring-up */
+static esp_err_t start_network_phase(event_callback_t callback, intptr_t callback_arg)
+{
+    startup_profile::scoped_phase phase("start_network");
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_LOG
+    if (deferred_log::init() != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize the deferred log, logging synchronously");
+    }
+#endif
+    esp_err_t err = esp_event_loop_create_default();
+
+    // In case create event loop returns ESP_ERR_INVALID_STATE it is not necessary to fail startup
+    // as of it means that default event loop is already initialized and no additional actions should be done.
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "Error create default event loop");
+        return err;
+    }
+#if CHIP_DEVICE_CONFIG_ENABLE_WIFI
+    if (chip::DeviceLayer::Internal::ESP32Utils::InitWiFiStack() != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Error initializing Wi-Fi stack");
+        return ESP_FAIL;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_WIFI_FAST_RECONNECT
+    if (wifi_reconnect::init() != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize the Wi-Fi fast reconnect");
+    }
+#endif
+#endif
+    /* The storage left by an interrupted factory reset is erased before the Matter stack reads it */
+    s_reset_resumed = async_reset::resume();
+    s_network_up_phase = startup_profile::phase_begin("network_up", UINT32_MAX);
+    err = chip_init_stack(callback, callback_arg);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error initializing matter");
+        return err;
+    }
+    s_network_started = true;
+    return ESP_OK;
+}
+
+esp_err_t start_network(event_callback_t callback, intptr_t callback_arg)
+{
+    if (s_network_started) {
+        ESP_LOGE(TAG, "The network bring-up has started");
+        return ESP_ERR_INVALID_STATE;
+    }
+    return start_network_phase(callback, callback_arg);
+}
+
+esp_err_t start(event_callback_t callback, intptr_t callback_arg)
+{
+    if (esp_matter_started) {
+        ESP_LOGE(TAG, "esp_matter has started");
+        return ESP_ERR_INVALID_STATE;
+    }
+    startup_profile::scoped_phase phase("start");
+    /* The attributes of the node have been created, drop the values preloaded from NVS */
+    attribute::release_nvs_preload();
+#if CONFIG_ESP_MATTER_ENABLE_POWER_FAIL_FLUSH
+    attribute::register_shutdown_flush();
+#endif
+    esp_err_t err = ESP_OK;
+    if (!s_network_started) {
+        err = start_network_phase(callback, callback_arg);
+        if (err != ESP_OK) {
+            return err;
+        }
+    } else if (callback) {
+        ESP_LOGW(TAG, "The event callback of start_network() is used, the one of start() is ignored");
+    }
+    esp_matter_ota_requestor_init();
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+    lock::stats::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+    command::stats::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+    e2e_latency::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_SYNCHRONIZED_REPORTS
+    report_sync::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
+    storage_cache::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_GROUP_KEY_CACHE
+    group_key_cache::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_WIFI_FAST_RECONNECT
+    wifi_reconnect::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
+    sed_poll::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_SESSION_RESUMPTION_STATS
+    session_resumption::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ACL_CACHE
+    acl_cache::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+    callback_watchdog::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_DEVICE_EVENT_REGISTRY
+    device_event::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_JSON_EXPORT
+    json_export::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_TRACE
+    trace::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_PERF_CONSOLE
+    perf::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_POOL_STATS
+    pool_stats::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_LOG
+    deferred_log::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_LOAD_GEN
+    load_gen::register_console_commands();
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+    async_reset::register_console_commands();
+#endif
+#if CONFIG_ENABLE_CHIP_SHELL
+    register_console_commands();
+#endif
+
+    err = chip_init_server();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error initializing matter");
+        return err;
+    }
+    esp_matter_started = true;
+    if (s_reset_resumed) {
+        async_reset::finish_resumed();
+        return ESP_OK;
+    }
+    err = node::read_min_unused_endpoint_id();
+    // If the min_unused_endpoint_id is not found, we will write the current min_unused_endpoint_id in nvs.
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        err = node::store_min_unused_endpoint_id();
+    }
+    return err;
+}
+
+esp_err_t factory_reset()
+{
+#if CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+#if CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
+    storage_cache::discard();
+#endif
+    /* The storage is erased in the background, the reset of the Matter stack at the end restarts the device */
+    return async_reset::start();
+#else
+    esp_err_t err = ESP_OK;
+    node_t *node = node::get();
+    if (node) {
+        /* ESP Matter data model is used. Erase all the data that we have added in nvs. */
+        attribute::close_nvs_handles();
+        nvs_handle_t handle;
+        err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE, &handle);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to open esp_matter nvs partition ");
+        } else {
+            err = nvs_erase_all(handle);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to erase esp_matter nvs namespace");
+            } else {
+                nvs_commit(handle);
+            }
+            nvs_close(handle);
+        }
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_JOURNAL
+        if (journal::erase_all() != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to erase the attribute journal");
+        }
+#endif
+        rtc_retention::erase_all();
+    }
+#if CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
+    /* The pending writes would be committed on the restart, after the erase */
+    storage_cache::discard();
+#endif
+
+    /* Submodule factory reset. This also restarts after completion. */
+    ConfigurationMgr().InitiateFactoryReset();
+    return err;
+#endif // CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+}
+
+namespace attribute {
+static uint32_t s_suppressed_write_count = 0;
+
+/* Release the buffer of a string or array value, unless it is the inline one or a const one */
+static void free_val_buf(_attribute_t *current_attribute)
+{
+    uint8_t *buf = current_attribute->val.val.a.b;
+#if CONFIG_ESP_MATTER_ATTRIBUTE_INLINE_VAL_SIZE > 0
+    if (buf == current_attribute->inline_val) {
+        buf = NULL;
+    }
+#endif
+    if (current_attribute->flags & ATTRIBUTE_FLAG_CONST_VAL) {
+        buf = NULL;
+        current_attribute->flags &= ~ATTRIBUTE_FLAG_CONST_VAL;
+    }
+    if (buf) {
+        esp_matter_mem_free(buf);
+    }
+    current_attribute->val.val.a.b = NULL;
+    current_attribute->val_capacity = 0;
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+constexpr uint16_t k_attribute_write_rate = CONFIG_ESP_MATTER_NVS_WRITE_LIMIT_ATTRIBUTE_RATE;
+constexpr uint16_t k_attribute_write_burst = CONFIG_ESP_MATTER_NVS_WRITE_LIMIT_ATTRIBUTE_BURST;
+constexpr uint16_t k_global_write_rate = CONFIG_ESP_MATTER_NVS_WRITE_LIMIT_GLOBAL_RATE;
+constexpr uint16_t k_global_write_burst = CONFIG_ESP_MATTER_NVS_WRITE_LIMIT_GLOBAL_BURST;
+/* Number of 32 bytes entries in a 4 KB NVS page, the other space is used by the page header and entry bitmap */
+constexpr uint32_t k_nvs_entries_per_page = 126;
+
+static uint16_t s_global_write_tokens = k_global_write_burst;
+static uint32_t s_global_write_refill_ms = 0;
+static persistence::write_stats_t s_write_stats;
+
+/* Token bucket refilled with rate_per_minute tokens per minute, up to burst tokens */
+static bool consume_write_token(uint16_t *tokens, uint32_t *refill_ms, uint16_t rate_per_minute, uint16_t burst,
+                                uint32_t now_ms)
+{
+    uint32_t elapsed_ms = now_ms - *refill_ms;
+    uint32_t refill = (uint32_t)(((uint64_t)elapsed_ms * rate_per_minute) / 60000);
+    if (refill > 0) {
+        if (*tokens + refill >= burst) {
+            *tokens = burst;
+            *refill_ms = now_ms;
+        } else {
+            *tokens += refill;
+            *refill_ms += (uint32_t)(((uint64_t)refill * 60000) / rate_per_minute);
+        }
+    }
+    if (*tokens == 0) {
+        return false;
+    }
+    (*tokens)--;
+    return true;
+}
+
+static bool consume_write_tokens(_attribute_t *attribute)
+{
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    if (!consume_write_token(&attribute->write_tokens, &attribute->write_refill_ms, k_attribute_write_rate,
+                             k_attribute_write_burst, now_ms)) {
+        return false;
+    }
+    return consume_write_token(&s_global_write_tokens, &s_global_write_refill_ms, k_global_write_rate,
+                               k_global_write_burst, now_ms);
+}
+
+static size_t get_nvs_val_size(const esp_matter_attr_val_t &val)
+{
+    switch (val.type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+        return val.val.a.s;
+#if CONFIG_ESP_MATTER_NVS_USE_COMPACT_ATTR_STORAGE
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+        return sizeof(uint8_t);
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+        return sizeof(uint16_t);
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_UINT64:
+        return sizeof(uint64_t);
+    default:
+        return sizeof(uint32_t);
+#else
+    default:
+        return sizeof(esp_matter_attr_val_t);
+#endif
+    }
+}
+
+static void record_nvs_write(_attribute_t *attribute)
+{
+    size_t size = get_nvs_val_size(attribute->val);
+    attribute->nvs_write_count++;
+    s_write_stats.writes++;
+    s_write_stats.bytes_written += size;
+    /* Values up to 8 bytes fit in the entry of the key, the others need a blob index entry and data entries */
+    s_write_stats.entries_written += size <= sizeof(uint64_t) ? 1 : 2 + (size + 31) / 32;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+
+/* Create the attribute and add it after previous_attribute, or at the head of the list if it is NULL. The caller
+ * makes sure that the attribute does not already exist. */
+static _attribute_t *create_after(_cluster_t *current_cluster, _attribute_t *previous_attribute, uint32_t attribute_id,
+                                  uint16_t flags, esp_matter_attr_val_t val, uint16_t max_val_size)
+{
+    /* Allocate */
+    _attribute_t *attribute = (_attribute_t *)dm_calloc(CLUSTER_ARENA(current_cluster), ESP_MATTER_MEM_TAG_DEFAULT, 1, sizeof(_attribute_t));
+    if (!attribute) {
+        ESP_LOGE(TAG, "Couldn't allocate _attribute_t");
+        return NULL;
+    }
+
+    /* Set */
+    attribute->attribute_id = attribute_id;
+    attribute->cluster_id = current_cluster->cluster_id;
+    attribute->endpoint_id = current_cluster->endpoint_id;
+    attribute->flags = flags;
+    attribute->flags |= ATTRIBUTE_FLAG_EXTERNAL_STORAGE;
+    attribute->max_val_size = max_val_size;
+#if CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+    attribute->write_tokens = k_attribute_write_burst;
+    attribute->write_refill_ms = (uint32_t)(esp_timer_get_time() / 1000);
+#endif
+
+    // After reboot, string and array are treated as Invalid. So need to store val.type and size of attribute value.
+    attribute->val.type = val.type;
+    if (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+        val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
+        val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        val.type == ESP_MATTER_VAL_TYPE_ARRAY) {
+        attribute->val.val.a.s = val.val.a.s;
+        attribute->val.val.a.n = val.val.a.n;
+        attribute->val.val.a.t = val.val.a.t;
+    }
+
+    bool attribute_updated = false;
+    if (attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE) {
+        // Lets directly read into attribute->val so that we don't have to set the attribute value again.
+        int64_t profile_start_us = startup_profile::now();
+        esp_err_t err = get_val_from_nvs(attribute->endpoint_id, attribute->cluster_id, attribute->attribute_id,
+                                            attribute->val);
+        startup_profile::aggregate_add(startup_profile::AGGREGATE_NVS_READ, profile_start_us);
+        if (err == ESP_OK) {
+            attribute_updated = true;
+            if (attribute->val.val.a.b) {
+                /* The buffer has been allocated while reading the value */
+                attribute->val_capacity = attribute->val.val.a.s;
+            }
+        }
+    }
+    if (!attribute_updated) {
+        set_val((attribute_t *)attribute, &val);
+    }
+
+    set_default_value_from_current_val((attribute_t *)attribute, NULL);
+
+    /* Add */
+    if (previous_attribute == NULL) {
+        attribute->next = current_cluster->attribute_list;
+        current_cluster->attribute_list = attribute;
+    } else {
+        attribute->next = previous_attribute->next;
+        previous_attribute->next = attribute;
+    }
+    current_cluster->attribute_count++;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    path_index::insert(path_index::ELEMENT_TYPE_ATTRIBUTE, attribute->endpoint_id, attribute->cluster_id,
+                       attribute->attribute_id, attribute);
+#endif
+
+    return attribute;
+}
+
+attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint8_t flags, esp_matter_attr_val_t val,
+                    uint16_t max_val_size)
+{
+    /* Find */
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return NULL;
+    }
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    attribute_t *existing_attribute = get(cluster, attribute_id);
+    if (existing_attribute) {
+        ESP_LOGW(TAG, "Attribute 0x%08" PRIX32 " on cluster 0x%08" PRIX32 " already exists. Not creating again.", attribute_id,
+                 current_cluster->cluster_id);
+        return existing_attribute;
+    }
+
+    /* Find the tail */
+    _attribute_t *previous_attribute = current_cluster->attribute_list;
+    while (previous_attribute && previous_attribute->next) {
+        previous_attribute = previous_attribute->next;
+    }
+    return (attribute_t *)create_after(current_cluster, previous_attribute, attribute_id, flags, val, max_val_size);
+}
+
+constexpr uint32_t k_deferred_attribute_persistence_time_ms = CONFIG_ESP_MATTER_DEFERRED_ATTR_PERSISTENCE_TIME_MS;
+
+/* Deferred attributes changed since the last flush, they are all stored when the persistence window expires */
+static _attribute_t *s_pending_attributes = NULL;
+#if CONFIG_ESP_MATTER_DEFER_ENDPOINT_ID_PERSISTENCE
+/* The minimum unused endpoint_id changed since the last flush, it is stored with the deferred attributes */
+static bool s_min_unused_endpoint_id_pending = false;
+#endif
+
+static bool has_pending_persistence()
+{
+#if CONFIG_ESP_MATTER_DEFER_ENDPOINT_ID_PERSISTENCE
+    if (s_min_unused_endpoint_id_pending) {
+        return true;
+    }
+#endif
+    return s_pending_attributes != NULL;
+}
+
+static void store_pending_attributes()
+{
+    if (!has_pending_persistence()) {
+        return;
+    }
+    _attribute_t *current_attribute = s_pending_attributes;
+    s_pending_attributes = NULL;
+
+    nvs_handle_t handle;
+    esp_err_t err = begin_store_batch(&handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Couldn't open the NVS to store the deferred attributes: %s", esp_err_to_name(err));
+    }
+    uint16_t count = 0;
+    while (current_attribute) {
+        _attribute_t *next_attribute = current_attribute->next_pending;
+        current_attribute->persistence_pending = false;
+        current_attribute->next_pending = NULL;
+        if (err == ESP_OK && store_val_in_batch(handle, current_attribute->endpoint_id, current_attribute->cluster_id,
+                                                current_attribute->attribute_id, current_attribute->val) != ESP_OK) {
+            ESP_LOGE(TAG, "Couldn't store the deferred attribute 0x%" PRIx32 " of cluster 0x%" PRIX32 " on endpoint 0x%" PRIx16,
+                     current_attribute->attribute_id, current_attribute->cluster_id, current_attribute->endpoint_id);
+        }
+#if CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+        if (err == ESP_OK) {
+            record_nvs_write(current_attribute);
+        }
+#endif
+        count++;
+        current_attribute = next_attribute;
+    }
+#if CONFIG_ESP_MATTER_DEFER_ENDPOINT_ID_PERSISTENCE
+    if (s_min_unused_endpoint_id_pending) {
+        s_min_unused_endpoint_id_pending = false;
+        if (err == ESP_OK && node::store_min_unused_endpoint_id_in_batch(handle) != ESP_OK) {
+            ESP_LOGE(TAG, "Couldn't store the minimum unused endpoint_id");
+        }
+    }
+#endif
+    if (err == ESP_OK) {
+        err = end_store_batch(handle);
+    }
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Stored %" PRIu16 " deferred attributes", count);
+    }
+}
+
+static void deferred_attribute_write(chip::System::Layer *layer, void *context)
+{
+    store_pending_attributes();
+}
+
+static void remove_pending_attribute(_attribute_t *attribute)
+{
+    if (!attribute->persistence_pending) {
+        return;
+    }
+    _attribute_t **link = &s_pending_attributes;
+    while (*link && *link != attribute) {
+        link = &(*link)->next_pending;
+    }
+    if (*link) {
+        *link = attribute->next_pending;
+    }
+    attribute->persistence_pending = false;
+    attribute->next_pending = NULL;
+}
+
+static void flush_pending_attributes()
+{
+    chip::DeviceLayer::SystemLayer().CancelTimer(deferred_attribute_write, NULL);
+    store_pending_attributes();
+}
+
+static void register_shutdown_flush()
+{
+    static bool shutdown_handler_registered = false;
+    if (!shutdown_handler_registered) {
+        /* Store the pending values on esp_restart() */
+        shutdown_handler_registered = esp_register_shutdown_handler(store_pending_attributes) == ESP_OK;
+    }
+}
+
+static void start_persistence_window()
+{
+    register_shutdown_flush();
+    /* A single window for all the deferred attributes, started by the first change after a flush */
+    if (!chip::DeviceLayer::SystemLayer().IsTimerActive(deferred_attribute_write, NULL)) {
+        auto & system_layer = chip::DeviceLayer::SystemLayer();
+        system_layer.StartTimer(chip::System::Clock::Milliseconds32(k_deferred_attribute_persistence_time_ms),
+                                deferred_attribute_write, NULL);
+    }
+}
+
+static void defer_val(_attribute_t *current_attribute)
+{
+    if (!current_attribute->persistence_pending) {
+        current_attribute->persistence_pending = true;
+        current_attribute->next_pending = s_pending_attributes;
+        s_pending_attributes = current_attribute;
+    }
+    start_persistence_window();
+}
+
+#if CONFIG_ESP_MATTER_DEFER_ENDPOINT_ID_PERSISTENCE
+static void defer_min_unused_endpoint_id()
+{
+    s_min_unused_endpoint_id_pending = true;
+    start_persistence_window();
+}
+#endif
+
+static void persist_val(_attribute_t *current_attribute)
+{
+    if (current_attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE) {
+        if (current_attribute->flags & ATTRIBUTE_FLAG_DEFERRED) {
+            defer_val(current_attribute);
+            return;
+        }
+#if CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+        if (current_attribute->persistence_pending || !consume_write_tokens(current_attribute)) {
+            /* Over the write rate, the value is stored at the end of the deferred persistence window */
+            if (!current_attribute->persistence_pending) {
+                s_write_stats.limited_writes++;
+            }
+            defer_val(current_attribute);
+            return;
+        }
+#endif
+        esp_err_t err = store_val_in_nvs(current_attribute->endpoint_id, current_attribute->cluster_id,
+                                         current_attribute->attribute_id, current_attribute->val);
+#if CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+        if (err == ESP_OK) {
+            record_nvs_write(current_attribute);
+        }
+#else
+        (void)err;
+#endif
+    }
+}
+
+static esp_err_t destroy(_cluster_t *current_cluster, attribute_t *attribute)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+
+    /* Default value needs to be deleted first since it uses the current val. The bounds are freed with it. */
+    free_default_value(attribute);
+
+    /* Delete val here, if required */
+    if (current_attribute->val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_ARRAY) {
+        /* Free buf */
+        free_val_buf(current_attribute);
+    }
+
+    /* Erase the persistent data */
+    remove_pending_attribute(current_attribute);
+#if CONFIG_ESP_MATTER_ENABLE_REPORTING_POLICY
+    set_reporting_policy(attribute, NULL);
+#endif
+    if (current_attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE) {
+        erase_val_in_nvs(current_attribute->endpoint_id, current_attribute->cluster_id, current_attribute->attribute_id);
+    }
+
+    /* Free */
+    dm_free(CLUSTER_ARENA(current_cluster), current_attribute, sizeof(_attribute_t));
+    return ESP_OK;
+}
+
+attribute_t *get(cluster_t *cluster, uint32_t attribute_id)
+{
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return NULL;
+    }
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    attribute_t *indexed_attribute = (attribute_t *)path_index::find(path_index::ELEMENT_TYPE_ATTRIBUTE,
+                                                                     current_cluster->endpoint_id,
+                                                                     current_cluster->cluster_id, attribute_id);
+    if (indexed_attribute || path_index::is_complete()) {
+        return indexed_attribute;
+    }
+#endif
+    _attribute_t *current_attribute = (_attribute_t *)current_cluster->attribute_list;
+    while (current_attribute) {
+        if (current_attribute->attribute_id == attribute_id) {
+            break;
+        }
+        current_attribute = current_attribute->next;
+    }
+    return (attribute_t *)current_attribute;
+}
+
+attribute_t *get_first(cluster_t *cluster)
+{
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return NULL;
+    }
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    return (attribute_t *)current_cluster->attribute_list;
+}
+
+attribute_t *get_next(attribute_t *attribute)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return NULL;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    return (attribute_t *)current_attribute->next;
+}
+
+uint32_t get_id(attribute_t *attribute)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return kInvalidAttributeId;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    return current_attribute->attribute_id;
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+/* Retries of get_val_lock_free() before it gives up, a write only takes a copy of the value */
+static constexpr int k_lock_free_read_attempts = 64;
+
+void val_write_begin(attribute_t *attribute)
+{
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    /* The writers hold the Matter stack lock, only the readers race with them */
+    __atomic_store_n(&current_attribute->val_seq, current_attribute->val_seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void val_write_end(attribute_t *attribute)
+{
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    __atomic_store_n(&current_attribute->val_seq, current_attribute->val_seq + 1, __ATOMIC_RELEASE);
+}
+
+esp_err_t get_val_lock_free(attribute_t *attribute, esp_matter_attr_val_t *val)
+{
+    if (!attribute || !val) {
+        ESP_LOGE(TAG, "Attribute or val cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    /* The type is set when the attribute is created */
+    esp_matter_val_type_t type = current_attribute->val.type;
+    bool buffer_type = type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        type == ESP_MATTER_VAL_TYPE_ARRAY;
+    uint8_t *buf = buffer_type ? val->val.a.b : NULL;
+    uint16_t buf_size = buffer_type ? val->val.a.s : 0;
+
+    for (int attempt = 0; attempt < k_lock_free_read_attempts; attempt++) {
+        uint32_t seq = __atomic_load_n(&current_attribute->val_seq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            continue;
+        }
+        esp_matter_attr_val_t snapshot;
+        memcpy((void *)&snapshot, (void *)&current_attribute->val, sizeof(esp_matter_attr_val_t));
+        bool fits = true;
+        if (buffer_type) {
+            /* The size, the buffer and its capacity only belong together if no write started since seq was read,
+             * check it before following the pointer */
+            uint8_t *val_buf = __atomic_load_n(&current_attribute->val.val.a.b, __ATOMIC_RELAXED);
+            uint16_t capacity = __atomic_load_n(&current_attribute->val_capacity, __ATOMIC_RELAXED);
+            bool const_val = __atomic_load_n(&current_attribute->flags, __ATOMIC_RELAXED) & ATTRIBUTE_FLAG_CONST_VAL;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&current_attribute->val_seq, __ATOMIC_RELAXED) != seq) {
+                continue;
+            }
+            /* A const value has no capacity, its buffer holds exactly the value */
+            if (!const_val && snapshot.val.a.s > capacity) {
+                snapshot.val.a.s = capacity;
+            }
+            snapshot.val.a.b = val_buf;
+            fits = !val_buf || snapshot.val.a.s <= buf_size;
+            if (val_buf && fits) {
+                /* A write starting now may free the buffer during the copy. The freed heap memory stays mapped and
+                 * the copy is then discarded by the check below. */
+                memcpy(buf, val_buf, snapshot.val.a.s);
+            }
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&current_attribute->val_seq, __ATOMIC_RELAXED) != seq) {
+            continue;
+        }
+        if (!fits) {
+            /* Report the size needed */
+            val->val.a.s = snapshot.val.a.s;
+            return ESP_ERR_INVALID_SIZE;
+        }
+        if (buffer_type) {
+            snapshot.val.a.b = snapshot.val.a.b ? buf : NULL;
+        }
+        memcpy((void *)val, (void *)&snapshot, sizeof(esp_matter_attr_val_t));
+        return ESP_OK;
+    }
+    return ESP_ERR_TIMEOUT;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+
+esp_err_t set_val(attribute_t *attribute, esp_matter_attr_val_t *val)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_FAIL;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    if (val_is_equal(&current_attribute->val, val)) {
+        /* No-op write, skip the copy and the persistence */
+        s_suppressed_write_count++;
+        return ESP_OK;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+    val_write_begin(attribute);
+#endif
+    if (val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
+        val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        val->type == ESP_MATTER_VAL_TYPE_ARRAY) {
+        if (val->val.a.s > 0) {
+            uint8_t *buf = current_attribute->val.val.a.b;
+            if (!buf || val->val.a.s > current_attribute->val_capacity) {
+                /* The current buffer is too small, switch to the inline buffer or a new one */
+                uint8_t *new_buf = NULL;
+                uint16_t new_capacity = val->val.a.s;
+#if CONFIG_ESP_MATTER_ATTRIBUTE_INLINE_VAL_SIZE > 0
+                if (val->val.a.s <= CONFIG_ESP_MATTER_ATTRIBUTE_INLINE_VAL_SIZE) {
+                    new_buf = current_attribute->inline_val;
+                    new_capacity = CONFIG_ESP_MATTER_ATTRIBUTE_INLINE_VAL_SIZE;
+                }
+#endif
+                if (!new_buf) {
+                    new_buf = (uint8_t *)esp_matter_mem_calloc_tagged(ESP_MATTER_MEM_TAG_ATTRIBUTE_VALUE, 1, val->val.a.s);
+                    if (!new_buf) {
+                        ESP_LOGE(TAG, "Could not allocate new buffer");
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+                        val_write_end(attribute);
+#endif
+                        return ESP_ERR_NO_MEM;
+                    }
+                }
+                free_val_buf(current_attribute);
+                buf = new_buf;
+                current_attribute->val_capacity = new_capacity;
+            }
+            /* Copy to the buf and assign. The source can be the current value itself. */
+            if (buf != val->val.a.b) {
+                memmove(buf, val->val.a.b, val->val.a.s);
+            }
+            current_attribute->val.val.a.b = buf;
+            current_attribute->val.val.a.s = val->val.a.s;
+            current_attribute->val.val.a.n = val->val.a.n;
+            current_attribute->val.val.a.t = val->val.a.t;
+        } else {
+            free_val_buf(current_attribute);
+            ESP_LOGD(TAG, "Set val called with string with size 0");
+        }
+    } else {
+        memcpy((void *)&current_attribute->val, (void *)val, sizeof(esp_matter_attr_val_t));
+    }
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+    val_write_end(attribute);
+#endif
+    persist_val(current_attribute);
+    return ESP_OK;
+}
+
+uint32_t get_suppressed_write_count()
+{
+    return s_suppressed_write_count;
+}
+
+esp_matter_val_t *get_val_storage(attribute_t *attribute, esp_matter_val_type_t *type)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return NULL;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    *type = current_attribute->val.type;
+    return &current_attribute->val.val;
+}
+
+esp_err_t commit_val(attribute_t *attribute, bool changed)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!changed) {
+        s_suppressed_write_count++;
+        return ESP_OK;
+    }
+    persist_val((_attribute_t *)attribute);
+    return ESP_OK;
+}
+
+esp_err_t get_val(attribute_t *attribute, esp_matter_attr_val_t *val)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    memcpy((void *)val, (void *)&current_attribute->val, sizeof(esp_matter_attr_val_t));
+    return ESP_OK;
+}
+
+esp_err_t add_bounds(attribute_t *attribute, esp_matter_attr_val_t min, esp_matter_attr_val_t max)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+
+    /* Check if bounds can be set */
+    if (current_attribute->val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_ARRAY) {
+        ESP_LOGE(TAG, "Bounds cannot be set for string/array type attributes");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((current_attribute->val.type != min.type) || (current_attribute->val.type != max.type)) {
+        ESP_LOGE(TAG, "Cannot set bounds because of val type mismatch: expected: %d, min: %d, max: %d",
+                 current_attribute->val.type, min.type, max.type);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Free the default value and the previous bounds before setting the new bounds */
+    esp_matter_attr_bounds_t bounds;
+    memcpy((void *)&bounds.min, (void *)&min, sizeof(esp_matter_attr_val_t));
+    memcpy((void *)&bounds.max, (void *)&max, sizeof(esp_matter_attr_val_t));
+    free_default_value(attribute);
+
+    /* Set the default value again, the bounds are allocated with it */
+    esp_err_t err = set_default_value_from_current_val(attribute, &bounds);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Could not allocate bounds");
+        /* Keep a default value without bounds */
+        set_default_value_from_current_val(attribute, NULL);
+    }
+    return err;
+}
+
+esp_matter_attr_bounds_t *get_bounds(attribute_t *attribute)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return NULL;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    return current_attribute->bounds;
+}
+
+uint16_t get_flags(attribute_t *attribute)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return 0;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    return current_attribute->flags;
+}
+
+esp_err_t set_override_callback(attribute_t *attribute, callback_t callback, uint32_t cache_ttl_ms)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    if (current_attribute->val.type == ESP_MATTER_VAL_TYPE_ARRAY ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING) {
+        // The override callback might allocate memory and we have no way to free the memory
+        // TODO: Add memory-safe override callback for these attribute types
+        ESP_LOGE(TAG, "Cannot set override callback for attribute 0x%" PRIX32 " on cluster 0x%" PRIX32,
+                 current_attribute->attribute_id, current_attribute->cluster_id);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    current_attribute->override_callback = callback;
+    current_attribute->flags |= ATTRIBUTE_FLAG_OVERRIDE;
+#if CONFIG_ESP_MATTER_ENABLE_OVERRIDE_READ_CACHE
+    current_attribute->override_cache_ttl_ms = cache_ttl_ms;
+    current_attribute->override_cache_expiry_us = 0;
+#else
+    if (cache_ttl_ms > 0) {
+        ESP_LOGW(TAG, "Override read cache is disabled, ignoring the TTL for attribute 0x%" PRIX32, current_attribute->attribute_id);
+    }
+#endif
+    return ESP_OK;
+}
+
+callback_t get_override_callback(attribute_t *attribute)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return NULL;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    return current_attribute->override_callback;
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_OVERRIDE_READ_CACHE
+static uint32_t s_override_cache_hits = 0;
+static uint32_t s_override_cache_misses = 0;
+#endif
+
+const esp_matter_attr_val_t *get_override_cache(attribute_t *attribute)
+{
+#if CONFIG_ESP_MATTER_ENABLE_OVERRIDE_READ_CACHE
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    if (!current_attribute || current_attribute->override_cache_ttl_ms == 0) {
+        return NULL;
+    }
+    if (esp_timer_get_time() < current_attribute->override_cache_expiry_us) {
+        s_override_cache_hits++;
+        return &current_attribute->val;
+    }
+    s_override_cache_misses++;
+#endif
+    return NULL;
+}
+
+void set_override_cache(attribute_t *attribute, const esp_matter_attr_val_t *val)
+{
+#if CONFIG_ESP_MATTER_ENABLE_OVERRIDE_READ_CACHE
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    if (!current_attribute || current_attribute->override_cache_ttl_ms == 0) {
+        return;
+    }
+    if (!val || val->type != current_attribute->val.type) {
+        /* Nothing sensible to serve from the cache, the callback is called again on the next read */
+        current_attribute->override_cache_expiry_us = 0;
+        return;
+    }
+    /* Override callbacks are only allowed for scalar attributes, the value has no buffer to manage */
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+    val_write_begin(attribute);
+#endif
+    memcpy(&current_attribute->val, val, sizeof(esp_matter_attr_val_t));
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+    val_write_end(attribute);
+#endif
+    current_attribute->override_cache_expiry_us =
+        esp_timer_get_time() + (int64_t)current_attribute->override_cache_ttl_ms * 1000;
+#endif
+}
+
+void invalidate_override_cache(attribute_t *attribute)
+{
+#if CONFIG_ESP_MATTER_ENABLE_OVERRIDE_READ_CACHE
+    if (attribute) {
+        ((_attribute_t *)attribute)->override_cache_expiry_us = 0;
+    }
+#endif
+}
+
+void get_override_cache_stats(uint32_t *hits, uint32_t *misses)
+{
+#if CONFIG_ESP_MATTER_ENABLE_OVERRIDE_READ_CACHE
+    *hits = s_override_cache_hits;
+    *misses = s_override_cache_misses;
+#else
+    *hits = 0;
+    *misses = 0;
+#endif
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_REPORTING_POLICY
+typedef struct reporting_state {
+    reporting_policy_t policy;
+    /* Last reported value, only valid for numeric values which were not null */
+    double last_reported;
+    bool has_last_reported;
+    bool has_last_report_time;
+    /* A significant change arrived within the minimum interval, it is reported when the interval ends */
+    bool report_pending;
+    int64_t last_report_us;
+} reporting_state_t;
+
+template <typename T>
+static bool get_numeric(T value, bool nullable, double *out)
+{
+    if (nullable && chip::app::NumericAttributeTraits<T>::IsNullValue(value)) {
+        return false;
+    }
+    *out = (double)value;
+    return true;
+}
+
+/* Returns false for the non-numeric types. is_null is set for the null value of nullable types. */
+static bool get_numeric_val(const esp_matter_attr_val_t *val, double *out, bool *is_null)
+{
+    bool nullable = val->type & ESP_MATTER_VAL_NULLABLE_BASE;
+    switch (val->type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+        *is_null = !get_numeric(val->val.i, nullable, out);
+        return true;
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+        *is_null = !get_numeric(val->val.f, nullable, out);
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT8:
+        *is_null = !get_numeric(val->val.i8, nullable, out);
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT8:
+        *is_null = !get_numeric(val->val.u8, nullable, out);
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT16:
+        *is_null = !get_numeric(val->val.i16, nullable, out);
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT16:
+        *is_null = !get_numeric(val->val.u16, nullable, out);
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT32:
+        *is_null = !get_numeric(val->val.i32, nullable, out);
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT32:
+        *is_null = !get_numeric(val->val.u32, nullable, out);
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT64:
+        *is_null = !get_numeric(val->val.i64, nullable, out);
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT64:
+        *is_null = !get_numeric(val->val.u64, nullable, out);
+        return true;
+    default:
+        return false;
+    }
+}
+
+template <typename T>
+static void set_quantized(T *value, double step)
+{
+    double quantized = floor((double)*value / step + 0.5) * step;
+    /* Stay in the range of the type, the nearest step might be just outside of it */
+    if (quantized > (double)std::numeric_limits<T>::max()) {
+        quantized -= step;
+    } else if (quantized < (double)std::numeric_limits<T>::lowest()) {
+        quantized += step;
+    }
+    *value = (T)quantized;
+}
+
+void quantize_reported_val(attribute_t *attribute, esp_matter_attr_val_t *val)
+{
+    reporting_state_t *state = attribute ? ((_attribute_t *)attribute)->reporting_state : NULL;
+    double value;
+    bool is_null;
+    if (!state || state->policy.quantization_step <= 0 || !get_numeric_val(val, &value, &is_null) || is_null) {
+        return;
+    }
+    double step = state->policy.quantization_step;
+    switch (val->type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_INTEGER: set_quantized(&val->val.i, step); break;
+    case ESP_MATTER_VAL_TYPE_FLOAT: set_quantized(&val->val.f, step); break;
+    case ESP_MATTER_VAL_TYPE_INT8: set_quantized(&val->val.i8, step); break;
+    case ESP_MATTER_VAL_TYPE_UINT8: set_quantized(&val->val.u8, step); break;
+    case ESP_MATTER_VAL_TYPE_INT16: set_quantized(&val->val.i16, step); break;
+    case ESP_MATTER_VAL_TYPE_UINT16: set_quantized(&val->val.u16, step); break;
+    case ESP_MATTER_VAL_TYPE_INT32: set_quantized(&val->val.i32, step); break;
+    case ESP_MATTER_VAL_TYPE_UINT32: set_quantized(&val->val.u32, step); break;
+    case ESP_MATTER_VAL_TYPE_INT64: set_quantized(&val->val.i64, step); break;
+    case ESP_MATTER_VAL_TYPE_UINT64: set_quantized(&val->val.u64, step); break;
+    default: break;
+    }
+}
+
+static void set_last_reported(reporting_state_t *state, const esp_matter_attr_val_t *val)
+{
+    double value;
+    bool is_null = false;
+    state->has_last_reported = get_numeric_val(val, &value, &is_null) && !is_null;
+    state->last_reported = state->has_last_reported ? value : 0;
+    state->has_last_report_time = true;
+    state->last_report_us = esp_timer_get_time();
+}
+
+static void pending_report_timer(chip::System::Layer *layer, void *context)
+{
+    _attribute_t *current_attribute = (_attribute_t *)context;
+    reporting_state_t *state = current_attribute->reporting_state;
+    if (!state || !state->report_pending) {
+        return;
+    }
+    state->report_pending = false;
+    set_last_reported(state, &current_attribute->val);
+#if CONFIG_ESP_MATTER_ENABLE_REPORT_PRIORITY
+    if (report_priority::defer(current_attribute, current_attribute->endpoint_id, current_attribute->cluster_id,
+                               current_attribute->attribute_id)) {
+        return;
+    }
+#endif
+#if CONFIG_ESP_MATTER_ICD_REPORT_BATCHING
+    if (icd_report_batching::hold(current_attribute, current_attribute->endpoint_id, current_attribute->cluster_id,
+                                  current_attribute->attribute_id)) {
+        return;
+    }
+#endif
+    MatterReportingAttributeChangeCallback(current_attribute->endpoint_id, current_attribute->cluster_id,
+                                           current_attribute->attribute_id);
+}
+
+bool should_report(attribute_t *attribute, const esp_matter_attr_val_t *val)
+{
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    reporting_state_t *state = current_attribute ? current_attribute->reporting_state : NULL;
+    if (!state) {
+        return true;
+    }
+    const reporting_policy_t *policy = &state->policy;
+    double value;
+    bool is_null = false;
+    bool numeric = get_numeric_val(val, &value, &is_null);
+    bool has_threshold = policy->absolute_threshold > 0 || policy->percent_threshold > 0;
+    /* Transitions to and from null, and the first report, always go out */
+    if (numeric && !is_null && state->has_last_reported && has_threshold) {
+        double delta = fabs(value - state->last_reported);
+        bool significant = false;
+        if (policy->absolute_threshold > 0 && delta >= policy->absolute_threshold) {
+            significant = true;
+        }
+        if (policy->percent_threshold > 0 && delta * 100 >= policy->percent_threshold * fabs(state->last_reported)) {
+            significant = true;
+        }
+        if (!significant) {
+            return false;
+        }
+    }
+    /* The urgent attributes are not rate limited */
+    if (policy->min_interval_ms > 0 && state->has_last_report_time &&
+        !(current_attribute->flags & ATTRIBUTE_FLAG_URGENT_REPORT)) {
+        int64_t elapsed_us = esp_timer_get_time() - state->last_report_us;
+        int64_t min_interval_us = (int64_t)policy->min_interval_ms * 1000;
+        if (elapsed_us < min_interval_us) {
+            if (!state->report_pending) {
+                state->report_pending = true;
+                uint32_t remaining_ms = (uint32_t)((min_interval_us - elapsed_us + 999) / 1000);
+                chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(remaining_ms),
+                                                            pending_report_timer, current_attribute);
+            }
+            return false;
+        }
+    }
+    if (state->report_pending) {
+        chip::DeviceLayer::SystemLayer().CancelTimer(pending_report_timer, current_attribute);
+        state->report_pending = false;
+    }
+    set_last_reported(state, val);
+    return true;
+}
+
+esp_err_t set_reporting_policy(attribute_t *attribute, const reporting_policy_t *policy)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    if (!policy) {
+        if (current_attribute->reporting_state) {
+            if (current_attribute->reporting_state->report_pending) {
+                chip::DeviceLayer::SystemLayer().CancelTimer(pending_report_timer, current_attribute);
+            }
+            esp_matter_mem_free(current_attribute->reporting_state);
+            current_attribute->reporting_state = NULL;
+        }
+        return ESP_OK;
+    }
+    if (policy->absolute_threshold < 0 || policy->percent_threshold < 0 || policy->quantization_step < 0) {
+        ESP_LOGE(TAG, "Reporting policy thresholds and quantization step cannot be negative");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!current_attribute->reporting_state) {
+        current_attribute->reporting_state = (reporting_state_t *)esp_matter_mem_calloc(1, sizeof(reporting_state_t));
+        if (!current_attribute->reporting_state) {
+            ESP_LOGE(TAG, "Couldn't allocate reporting state");
+            return ESP_ERR_NO_MEM;
+        }
+        /* The current value is the one the subscribers know */
+        set_last_reported(current_attribute->reporting_state, &current_attribute->val);
+        current_attribute->reporting_state->has_last_report_time = false;
+    }
+    current_attribute->reporting_state->policy = *policy;
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_REPORTING_POLICY
+
+esp_err_t set_deferred_persistence(attribute_t *attribute)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    if (!(current_attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE)) {
+        ESP_LOGE(TAG, "Attribute should be non-volatile to set a deferred persistence time");
+        return ESP_ERR_INVALID_ARG;
+    }
+    current_attribute->flags |= ATTRIBUTE_FLAG_DEFERRED;
+    return ESP_OK;
+}
+
+esp_err_t set_const_val(attribute_t *attribute, const esp_matter_attr_val_t *val)
+{
+    if (!attribute || !val) {
+        ESP_LOGE(TAG, "Attribute or val cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    if (current_attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE) {
+        ESP_LOGE(TAG, "Attribute should not be non-volatile to set a const value");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (val->type != current_attribute->val.type ||
+        (val->type != ESP_MATTER_VAL_TYPE_CHAR_STRING && val->type != ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING &&
+         val->type != ESP_MATTER_VAL_TYPE_OCTET_STRING && val->type != ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING &&
+         val->type != ESP_MATTER_VAL_TYPE_ARRAY)) {
+        ESP_LOGE(TAG, "Const values are only supported for string and array attributes of the same type");
+        return ESP_ERR_INVALID_ARG;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+    val_write_begin(attribute);
+#endif
+    free_val_buf(current_attribute);
+    /* The capacity stays 0, so that the next set_val() copies the value to a buffer of the attribute */
+    current_attribute->val.val.a.b = val->val.a.s > 0 ? val->val.a.b : NULL;
+    current_attribute->val.val.a.s = val->val.a.s;
+    current_attribute->val.val.a.n = val->val.a.n;
+    current_attribute->val.val.a.t = val->val.a.t;
+    if (current_attribute->val.val.a.b) {
+        current_attribute->flags |= ATTRIBUTE_FLAG_CONST_VAL;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+    val_write_end(attribute);
+#endif
+    return ESP_OK;
+}
+
+esp_err_t set_urgent_report(attribute_t *attribute, bool urgent)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    if (urgent) {
+        current_attribute->flags &= ~ATTRIBUTE_FLAG_BULK_REPORT;
+        current_attribute->flags |= ATTRIBUTE_FLAG_URGENT_REPORT;
+    } else {
+        current_attribute->flags &= ~ATTRIBUTE_FLAG_URGENT_REPORT;
+    }
+    return ESP_OK;
+}
+
+esp_err_t set_report_priority(attribute_t *attribute, report_priority_t priority)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _attribute_t *current_attribute = (_attribute_t *)attribute;
+    current_attribute->flags &= ~(ATTRIBUTE_FLAG_URGENT_REPORT | ATTRIBUTE_FLAG_BULK_REPORT);
+    switch (priority) {
+    case REPORT_PRIORITY_NORMAL:
+        break;
+    case REPORT_PRIORITY_URGENT:
+        current_attribute->flags |= ATTRIBUTE_FLAG_URGENT_REPORT;
+        break;
+    case REPORT_PRIORITY_BULK:
+        current_attribute->flags |= ATTRIBUTE_FLAG_BULK_REPORT;
+        break;
+    default:
+        ESP_LOGE(TAG, "Invalid report priority %d", (int)priority);
+        return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+report_priority_t get_report_priority(attribute_t *attribute)
+{
+    uint16_t flags = get_flags(attribute);
+    if (flags & ATTRIBUTE_FLAG_URGENT_REPORT) {
+        return REPORT_PRIORITY_URGENT;
+    }
+    if (flags & ATTRIBUTE_FLAG_BULK_REPORT) {
+        return REPORT_PRIORITY_BULK;
+    }
+    return REPORT_PRIORITY_NORMAL;
+}
+
+} /* attribute */
+
+namespace persistence {
+
+esp_err_t flush()
+{
+    if (!esp_matter_started) {
+        /* Nothing is deferred before the start */
+        return ESP_OK;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
         return ESP_FAIL;
     }
+    attribute::flush_pending_attributes();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+esp_err_t get_write_stats(write_stats_t *stats)
+{
+    if (!stats) {
+        ESP_LOGE(TAG, "Stats cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    *stats = attribute::s_write_stats;
+    nvs_stats_t nvs_stats;
+    esp_err_t err = nvs_get_stats(ESP_MATTER_NVS_PART_NAME, &nvs_stats);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Couldn't get the NVS stats: %s", esp_err_to_name(err));
+        return err;
+    }
+    stats->nvs_used_entries = nvs_stats.used_entries;
+    stats->nvs_free_entries = nvs_stats.free_entries;
+    /* The writes are spread over all the pages but one, which NVS keeps free for the garbage collection */
+    uint32_t page_count = nvs_stats.total_entries / attribute::k_nvs_entries_per_page;
+    if (page_count > 1) {
+        stats->estimated_erase_count = stats->entries_written / (attribute::k_nvs_entries_per_page * (page_count - 1));
+    }
+    return ESP_OK;
+}
+
+uint32_t get_write_count(attribute_t *attribute)
+{
+    if (!attribute) {
+        ESP_LOGE(TAG, "Attribute cannot be NULL");
+        return 0;
+    }
+    return ((_attribute_t *)attribute)->nvs_write_count;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+
+#if CONFIG_ESP_MATTER_ENABLE_POWER_FAIL_FLUSH
+static TaskHandle_t s_power_fail_task = NULL;
+
+esp_err_t flush_on_power_fail(uint32_t ticks_to_wait)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(ticks_to_wait);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_ERR_TIMEOUT;
+    }
+    attribute::flush_pending_attributes();
+#if CONFIG_ESP_MATTER_PERSIST_DATA_VERSIONS
+    data_version::store_all();
+#endif
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+static void power_fail_task(void *arg)
+{
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        ESP_LOGW(TAG, "Power fail, flushing the deferred attributes");
+        flush_on_power_fail(pdMS_TO_TICKS(CONFIG_ESP_MATTER_POWER_FAIL_FLUSH_LOCK_TIMEOUT_MS));
+    }
+}
+
+static void IRAM_ATTR power_fail_isr(void *arg)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_power_fail_task, &higher_priority_task_woken);
+    if (higher_priority_task_woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+esp_err_t register_power_fail_gpio(gpio_num_t gpio_num, bool active_level)
+{
+    if (s_power_fail_task) {
+        ESP_LOGE(TAG, "Power fail GPIO already registered");
+        return ESP_ERR_INVALID_STATE;
+    }
+    /* The flush runs in its own high priority task, the NVS writes cannot be done from the interrupt */
+    if (xTaskCreatePinnedToCore(power_fail_task, "mtr_pwr_fail", CONFIG_ESP_MATTER_POWER_FAIL_FLUSH_TASK_STACK_SIZE,
+                                NULL, configMAX_PRIORITIES - 1, &s_power_fail_task,
+                                CONFIG_ESP_MATTER_TASK_CORE_ID < 0 ? tskNO_AFFINITY : CONFIG_ESP_MATTER_TASK_CORE_ID)
+        != pdPASS) {
+        ESP_LOGE(TAG, "Couldn't create the power fail task");
+        return ESP_ERR_NO_MEM;
+    }
+    gpio_config_t config = {};
+    config.pin_bit_mask = 1ULL << gpio_num;
+    config.mode = GPIO_MODE_INPUT;
+    config.intr_type = active_level ? GPIO_INTR_POSEDGE : GPIO_INTR_NEGEDGE;
+    esp_err_t err = gpio_config(&config);
+    if (err == ESP_OK) {
+        err = gpio_install_isr_service(0);
+        /* The service might already be installed by the application */
+        if (err == ESP_ERR_INVALID_STATE) {
+            err = ESP_OK;
+        }
+    }
+    if (err == ESP_OK) {
+        err = gpio_isr_handler_add(gpio_num, power_fail_isr, NULL);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Couldn't set up the power fail GPIO %d: %s", gpio_num, esp_err_to_name(err));
+        vTaskDelete(s_power_fail_task);
+        s_power_fail_task = NULL;
+        return err;
+    }
+    attribute::register_shutdown_flush();
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_POWER_FAIL_FLUSH
+
+} /* persistence */
+
+namespace command {
+/* Create the command and add it after previous_command, or at the head of the list if it is NULL. The caller makes
+ * sure that the command does not already exist. */
+static _command_t *create_after(_cluster_t *current_cluster, _command_t *previous_command, uint32_t command_id,
+                                uint8_t flags, callback_t callback)
+{
+    /* Allocate */
+    _command_t *command = (_command_t *)dm_calloc(CLUSTER_ARENA(current_cluster), ESP_MATTER_MEM_TAG_DEFAULT, 1, sizeof(_command_t));
+    if (!command) {
+        ESP_LOGE(TAG, "Couldn't allocate _command_t");
+        return NULL;
+    }
+
+    /* Set */
+    command->command_id = command_id;
+    command->flags = flags;
+    command->callback = callback;
+    command->user_callback = NULL;
+    command->async_callback = NULL;
+
+    /* Add */
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+    /* The table is rebuilt when the cluster is enabled again, until then the dispatch walks the list */
+    destroy_command_table(current_cluster);
+#endif
+    if (previous_command == NULL) {
+        command->next = current_cluster->command_list;
+        current_cluster->command_list = command;
+    } else {
+        command->next = previous_command->next;
+        previous_command->next = command;
+    }
+    if (flags & COMMAND_FLAG_ACCEPTED) {
+        current_cluster->accepted_command_count++;
+    }
+    if (flags & COMMAND_FLAG_GENERATED) {
+        current_cluster->generated_command_count++;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    if (flags & COMMAND_FLAG_ACCEPTED) {
+        path_index::insert(path_index::ELEMENT_TYPE_ACCEPTED_COMMAND, current_cluster->endpoint_id,
+                           current_cluster->cluster_id, command_id, command);
+    }
+    if (flags & COMMAND_FLAG_GENERATED) {
+        path_index::insert(path_index::ELEMENT_TYPE_GENERATED_COMMAND, current_cluster->endpoint_id,
+                           current_cluster->cluster_id, command_id, command);
+    }
+#endif
+
+    return command;
+}
+
+command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callback_t callback)
+{
+    /* Find */
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return NULL;
+    }
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    command_t *existing_command = get(cluster, command_id, flags);
+    if (existing_command) {
+        ESP_LOGW(TAG, "Command 0x%08" PRIX32 " on cluster 0x%08" PRIX32 " already exists. Not creating again.", command_id,
+                 current_cluster->cluster_id);
+        return existing_command;
+    }
 
-#elif CHIP_DEVICE_CONFIG_THREAD_FTD
-    if (ConnectivityMgr().SetThreadDeviceType(ConnectivityManager::kThreadDeviceType_Router) != CHIP_NO_ERROR) {
-        ESP_LOGE(TAG, "Failed to set the Thread device type");
-        return ESP_FAIL;
-    }
-#else
-    if (ConnectivityMgr().SetThreadDeviceType(ConnectivityManager::kThreadDeviceType_MinimalEndDevice) != CHIP_NO_ERROR) {
-        ESP_LOGE(TAG, "Failed to set the Thread device type");
-        return ESP_FAIL;
+    /* Find the tail */
+    _command_t *previous_command = current_cluster->command_list;
+    while (previous_command && previous_command->next) {
+        previous_command = previous_command->next;
     }
-#endif
-    if (ThreadStackMgr().StartThreadTask() != CHIP_NO_ERROR) {
-        ESP_LOGE(TAG, "Failed to launch Thread task");
-        return ESP_FAIL;
+    return (command_t *)create_after(current_cluster, previous_command, command_id, flags, callback);
+}
+
+static esp_err_t destroy(_cluster_t *current_cluster, command_t *command)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
     }
-#endif // CHIP_DEVICE_CONFIG_ENABLE_THREAD
+    _command_t *current_command = (_command_t *)command;
 
-#if CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
-    PlatformMgr().ScheduleWork(esp_matter_chip_init_task, reinterpret_cast<intptr_t>(xTaskGetCurrentTaskHandle()));
-    // Wait for the matter stack to be initialized
-    xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
-#endif // CONFIG_ESP_MATTER_ENABLE_MATTER_SERVER
+    /* Free */
+    dm_free(CLUSTER_ARENA(current_cluster), current_command, sizeof(_command_t));
     return ESP_OK;
 }
 
-esp_err_t start(event_callback_t callback, intptr_t callback_arg)
+command_t *get(cluster_t *cluster, uint32_t command_id, uint16_t flags)
 {
-    if (esp_matter_started) {
-        ESP_LOGE(TAG, "esp_matter has started");
-        return ESP_ERR_INVALID_STATE;
-    }
-    esp_err_t err = esp_event_loop_create_default();
-
-    // In case create event loop returns ESP_ERR_INVALID_STATE it is not necessary to fail startup
-    // as of it means that default event loop is already initialized and no additional actions should be done.
-    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
-        ESP_LOGE(TAG, "Error create default event loop");
-        return err;
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return NULL;
     }
-#if CHIP_DEVICE_CONFIG_ENABLE_WIFI
-    if (chip::DeviceLayer::Internal::ESP32Utils::InitWiFiStack() != CHIP_NO_ERROR) {
-        ESP_LOGE(TAG, "Error initializing Wi-Fi stack");
-        return ESP_FAIL;
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    if (flags & (COMMAND_FLAG_ACCEPTED | COMMAND_FLAG_GENERATED)) {
+        void *indexed_command = NULL;
+        if (flags & COMMAND_FLAG_ACCEPTED) {
+            indexed_command = path_index::find(path_index::ELEMENT_TYPE_ACCEPTED_COMMAND,
+                                               current_cluster->endpoint_id, current_cluster->cluster_id, command_id);
+        }
+        if (!indexed_command && (flags & COMMAND_FLAG_GENERATED)) {
+            indexed_command = path_index::find(path_index::ELEMENT_TYPE_GENERATED_COMMAND,
+                                               current_cluster->endpoint_id, current_cluster->cluster_id, command_id);
+        }
+        if (indexed_command || path_index::is_complete()) {
+            return (command_t *)indexed_command;
+        }
     }
 #endif
-    esp_matter_ota_requestor_init();
-
-    err = chip_init(callback, callback_arg);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Error initializing matter");
-        return err;
-    }
-    esp_matter_started = true;
-    err = node::read_min_unused_endpoint_id();
-    // If the min_unused_endpoint_id is not found, we will write the current min_unused_endpoint_id in nvs.
-    if (err == ESP_ERR_NVS_NOT_FOUND) {
-        err = node::store_min_unused_endpoint_id();
+    _command_t *current_command = (_command_t *)current_cluster->command_list;
+    while (current_command) {
+        if ((current_command->command_id == command_id) && (current_command->flags & flags)) {
+            break;
+        }
+        current_command = current_command->next;
     }
-    return err;
+    return (command_t *)current_command;
 }
 
-esp_err_t factory_reset()
+command_t *get_accepted(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id)
 {
-    esp_err_t err = ESP_OK;
-    node_t *node = node::get();
-    if (node) {
-        /* ESP Matter data model is used. Erase all the data that we have added in nvs. */
-        nvs_handle_t handle;
-        err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE, &handle);
-        if (err != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to open esp_matter nvs partition ");
-        } else {
-            err = nvs_erase_all(handle);
-            if (err != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to erase esp_matter nvs namespace");
-            } else {
-                nvs_commit(handle);
-            }
-            nvs_close(handle);
-        }
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    command_t *indexed_command = (command_t *)path_index::find(path_index::ELEMENT_TYPE_ACCEPTED_COMMAND, endpoint_id,
+                                                               cluster_id, command_id);
+    if (indexed_command || path_index::is_complete()) {
+        return indexed_command;
     }
-
-    /* Submodule factory reset. This also restarts after completion. */
-    ConfigurationMgr().InitiateFactoryReset();
-    return err;
+#endif
+    _node_t *current_node = (_node_t *)node::get();
+    _endpoint_t *current_endpoint = current_node ? current_node->endpoint_list : NULL;
+    while (current_endpoint && current_endpoint->endpoint_id != endpoint_id) {
+        current_endpoint = current_endpoint->next;
+    }
+    _cluster_t *current_cluster = current_endpoint ? current_endpoint->cluster_list : NULL;
+    while (current_cluster && current_cluster->cluster_id != cluster_id) {
+        current_cluster = current_cluster->next;
+    }
+    if (!current_cluster) {
+        return NULL;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+    if (current_cluster->accepted_command_table) {
+        _command_t **entry = (_command_t **)bsearch(&command_id, current_cluster->accepted_command_table,
+                                                    current_cluster->accepted_command_table_size,
+                                                    sizeof(_command_t *), compare_command_table_key);
+        return entry ? (command_t *)*entry : NULL;
+    }
+#endif
+    return get((cluster_t *)current_cluster, command_id, COMMAND_FLAG_ACCEPTED);
 }
 
-namespace attribute {
-attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint8_t flags, esp_matter_attr_val_t val,
-                    uint16_t max_val_size)
+command_t *get_first(cluster_t *cluster)
 {
-    /* Find */
     if (!cluster) {
         ESP_LOGE(TAG, "Cluster cannot be NULL");
         return NULL;
     }
     _cluster_t *current_cluster = (_cluster_t *)cluster;
-    attribute_t *existing_attribute = get(cluster, attribute_id);
-    if (existing_attribute) {
-        ESP_LOGW(TAG, "Attribute 0x%08" PRIX32 " on cluster 0x%08" PRIX32 " already exists. Not creating again.", attribute_id,
-                 current_cluster->cluster_id);
-        return existing_attribute;
+    return (command_t *)current_cluster->command_list;
+}
+
+command_t *get_next(command_t *command)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
+        return NULL;
     }
+    _command_t *current_command = (_command_t *)command;
+    return (command_t *)current_command->next;
+}
 
-    /* Allocate */
-    _attribute_t *attribute = (_attribute_t *)esp_matter_mem_calloc(1, sizeof(_attribute_t));
-    if (!attribute) {
-        ESP_LOGE(TAG, "Couldn't allocate _attribute_t");
+uint32_t get_id(command_t *command)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
+        return kInvalidCommandId;
+    }
+    _command_t *current_command = (_command_t *)command;
+    return current_command->command_id;
+}
+
+callback_t get_callback(command_t *command)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
         return NULL;
     }
+    _command_t *current_command = (_command_t *)command;
+    return current_command->callback;
+}
 
-    /* Set */
-    attribute->attribute_id = attribute_id;
-    attribute->cluster_id = current_cluster->cluster_id;
-    attribute->endpoint_id = current_cluster->endpoint_id;
-    attribute->flags = flags;
-    attribute->flags |= ATTRIBUTE_FLAG_EXTERNAL_STORAGE;
-    attribute->max_val_size = max_val_size;
+callback_t get_user_callback(command_t *command)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
+        return NULL;
+    }
+    _command_t *current_command = (_command_t *)command;
+    return current_command->user_callback;
+}
 
-    // After reboot, string and array are treated as Invalid. So need to store val.type and size of attribute value.
-    attribute->val.type = val.type;
-    if (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
-        val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
-        val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
-        val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
-        val.type == ESP_MATTER_VAL_TYPE_ARRAY) {
-        attribute->val.val.a.s = val.val.a.s;
-        attribute->val.val.a.n = val.val.a.n;
-        attribute->val.val.a.t = val.val.a.t;
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+void increment_invoke_count(command_t *command)
+{
+    if (command) {
+        ((_command_t *)command)->invoke_count++;
     }
+}
 
-    bool attribute_updated = false;
-    if (attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE) {
-        // Lets directly read into attribute->val so that we don't have to set the attribute value again.
-        esp_err_t err = get_val_from_nvs(attribute->endpoint_id, attribute->cluster_id, attribute->attribute_id,
-                                            attribute->val);
-        if (err == ESP_OK) {
-            attribute_updated = true;
-        }
+uint32_t get_invoke_count(command_t *command)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
+        return 0;
     }
-    if (!attribute_updated) {
-        set_val((attribute_t *)attribute, &val);
+    return ((_command_t *)command)->invoke_count;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+
+void set_user_callback(command_t *command, callback_t user_callback)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
     }
+    _command_t *current_command = (_command_t *)command;
+    current_command->user_callback = user_callback;
+}
 
-    set_default_value_from_current_val((attribute_t *)attribute);
+async_callback_t get_async_callback(command_t *command)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
+        return NULL;
+    }
+    _command_t *current_command = (_command_t *)command;
+    return current_command->async_callback;
+}
 
-    /* Add */
-    _attribute_t *previous_attribute = NULL;
-    _attribute_t *current_attribute = current_cluster->attribute_list;
-    while (current_attribute) {
-        previous_attribute = current_attribute;
-        current_attribute = current_attribute->next;
+esp_err_t set_async_callback(command_t *command, async_callback_t async_callback)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
     }
-    if (previous_attribute == NULL) {
-        current_cluster->attribute_list = attribute;
-    } else {
-        previous_attribute->next = attribute;
+    _command_t *current_command = (_command_t *)command;
+    if (!(current_command->flags & COMMAND_FLAG_ACCEPTED)) {
+        ESP_LOGE(TAG, "Command 0x%08" PRIX32 " is not an accepted command", current_command->command_id);
+        return ESP_ERR_INVALID_ARG;
     }
+    current_command->async_callback = async_callback;
+    return ESP_OK;
+}
 
-    return (attribute_t *)attribute;
+uint16_t get_flags(command_t *command)
+{
+    if (!command) {
+        ESP_LOGE(TAG, "Command cannot be NULL");
+        return 0;
+    }
+    _command_t *current_command = (_command_t *)command;
+    return current_command->flags;
 }
 
-static esp_err_t destroy(attribute_t *attribute)
+} /* command */
+
+namespace event {
+
+/* Create the event and add it after previous_event, or at the head of the list if it is NULL. The caller makes sure
+ * that the event does not already exist. */
+static _event_t *create_after(_cluster_t *current_cluster, _event_t *previous_event, uint32_t event_id)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
+    /* Allocate */
+    _event_t *event = (_event_t *)dm_calloc(CLUSTER_ARENA(current_cluster), ESP_MATTER_MEM_TAG_DEFAULT, 1, sizeof(_event_t));
+    if (!event) {
+        ESP_LOGE(TAG, "Couldn't allocate _event_t");
+        return NULL;
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
 
-    /* Default value needs to be deleted first since it uses the current val. */
-    free_default_value(attribute);
+    /* Set */
+    event->event_id = event_id;
 
-    /* Delete val here, if required */
-    if (current_attribute->val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_ARRAY) {
-        /* Free buf */
-        if (current_attribute->val.val.a.b) {
-            esp_matter_mem_free(current_attribute->val.val.a.b);
-        }
+    /* Add */
+    if (previous_event == NULL) {
+        event->next = current_cluster->event_list;
+        current_cluster->event_list = event;
+    } else {
+        event->next = previous_event->next;
+        previous_event->next = event;
+    }
+    current_cluster->event_count++;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    path_index::insert(path_index::ELEMENT_TYPE_EVENT, current_cluster->endpoint_id, current_cluster->cluster_id,
+                       event_id, event);
+#endif
+
+    return event;
+}
+
+event_t *create(cluster_t *cluster, uint32_t event_id)
+{
+    /* Find */
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return NULL;
+    }
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    event_t *existing_event = get(cluster, event_id);
+    if (existing_event) {
+        ESP_LOGW(TAG, "Event 0x%08" PRIX32 " on cluster 0x%08" PRIX32 " already exists. Not creating again.", event_id,
+                 current_cluster->cluster_id);
+        return existing_event;
     }
 
-    /* Free bounds */
-    if (current_attribute->bounds) {
-        esp_matter_mem_free(current_attribute->bounds);
+    /* Find the tail */
+    _event_t *previous_event = current_cluster->event_list;
+    while (previous_event && previous_event->next) {
+        previous_event = previous_event->next;
     }
+    return (event_t *)create_after(current_cluster, previous_event, event_id);
+}
 
-    /* Erase the persistent data */
-    if (current_attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE) {
-        erase_val_in_nvs(current_attribute->endpoint_id, current_attribute->cluster_id, current_attribute->attribute_id);
+static esp_err_t destroy(_cluster_t *current_cluster, event_t *event)
+{
+    if (!event) {
+        ESP_LOGE(TAG, "Event cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
     }
+    _event_t *current_event = (_event_t *)event;
 
     /* Free */
-    esp_matter_mem_free(current_attribute);
+    dm_free(CLUSTER_ARENA(current_cluster), current_event, sizeof(_event_t));
     return ESP_OK;
 }
 
-attribute_t *get(cluster_t *cluster, uint32_t attribute_id)
+event_t *get(cluster_t *cluster, uint32_t event_id)
 {
     if (!cluster) {
         ESP_LOGE(TAG, "Cluster cannot be NULL");
         return NULL;
     }
     _cluster_t *current_cluster = (_cluster_t *)cluster;
-    _attribute_t *current_attribute = (_attribute_t *)current_cluster->attribute_list;
-    while (current_attribute) {
-        if (current_attribute->attribute_id == attribute_id) {
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    event_t *indexed_event = (event_t *)path_index::find(path_index::ELEMENT_TYPE_EVENT, current_cluster->endpoint_id,
+                                                         current_cluster->cluster_id, event_id);
+    if (indexed_event || path_index::is_complete()) {
+        return indexed_event;
+    }
+#endif
+    _event_t *current_event = (_event_t *)current_cluster->event_list;
+    while (current_event) {
+        if (current_event->event_id == event_id) {
             break;
         }
-        current_attribute = current_attribute->next;
+        current_event = current_event->next;
     }
-    return (attribute_t *)current_attribute;
+    return (event_t *)current_event;
 }
 
-attribute_t *get_first(cluster_t *cluster)
+event_t *get_first(cluster_t *cluster)
 {
     if (!cluster) {
         ESP_LOGE(TAG, "Cluster cannot be NULL");
         return NULL;
     }
     _cluster_t *current_cluster = (_cluster_t *)cluster;
-    return (attribute_t *)current_cluster->attribute_list;
+    return (event_t *)current_cluster->event_list;
 }
 
-attribute_t *get_next(attribute_t *attribute)
+event_t *get_next(event_t *event)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
+    if (!event) {
+        ESP_LOGE(TAG, "Event cannot be NULL");
         return NULL;
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-    return (attribute_t *)current_attribute->next;
+    _event_t *current_event = (_event_t *)event;
+    return (event_t *)current_event->next;
 }
 
-uint32_t get_id(attribute_t *attribute)
+uint32_t get_id(event_t *event)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
-        return kInvalidAttributeId;
+    if (!event) {
+        ESP_LOGE(TAG, "Event cannot be NULL");
+        return chip::kInvalidEventId;
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-    return current_attribute->attribute_id;
+    _event_t *current_event = (_event_t *)event;
+    return current_event->event_id;
 }
 
-constexpr uint16_t k_deferred_attribute_persistence_time_ms = CONFIG_ESP_MATTER_DEFERRED_ATTR_PERSISTENCE_TIME_MS;
+} /* event */
 
-static void deferred_attribute_write(chip::System::Layer *layer, void *attribute_ptr)
-{
-    _attribute_t *current_attribute = (_attribute_t *)attribute_ptr;
-    ESP_LOGI(TAG, "Store the deferred attribute 0x%" PRIx32 " of cluster 0x%" PRIX32 " on endpoint 0x%" PRIx16,
-                  current_attribute->attribute_id, current_attribute->cluster_id, current_attribute->endpoint_id);
-    store_val_in_nvs(current_attribute->endpoint_id, current_attribute->cluster_id, current_attribute->attribute_id,
-                     current_attribute->val);
-}
 
-esp_err_t set_val(attribute_t *attribute, esp_matter_attr_val_t *val)
+namespace cluster {
+
+cluster_t *create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
-        return ESP_FAIL;
+    /* Find */
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint cannot be NULL");
+        return NULL;
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-    if (val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
-        val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
-        val->type == ESP_MATTER_VAL_TYPE_ARRAY) {
-        /* Free old buf */
-        if (current_attribute->val.val.a.b) {
-            esp_matter_mem_free(current_attribute->val.val.a.b);
-            current_attribute->val.val.a.b = NULL;
+    if (!(flags & CLUSTER_FLAG_SERVER) && !(flags & CLUSTER_FLAG_CLIENT)) {
+        ESP_LOGE(TAG, "Server or client cluster flag not set");
+        return NULL;
+    }
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    cluster_t *existing_cluster = get(endpoint, cluster_id);
+    if (existing_cluster) {
+        /* If a server already exists, do not create it again */
+        _cluster_t *_existing_cluster = (_cluster_t *)existing_cluster;
+        if ((_existing_cluster->flags & CLUSTER_FLAG_SERVER) && (flags & CLUSTER_FLAG_SERVER)) {
+            ESP_LOGW(TAG, "Server Cluster 0x%08" PRIX32 " on endpoint 0x%04" PRIx16 " already exists. Not creating again.", cluster_id,
+                     current_endpoint->endpoint_id);
+            return existing_cluster;
         }
-        if (val->val.a.s > 0) {
-            /* Alloc new buf */
-            uint8_t *new_buf = (uint8_t *)esp_matter_mem_calloc(1, val->val.a.s);
-            if (!new_buf) {
-                ESP_LOGE(TAG, "Could not allocate new buffer");
-                return ESP_ERR_NO_MEM;
-            }
-            /* Copy to new buf and assign */
-            memcpy(new_buf, val->val.a.b, val->val.a.s);
-            current_attribute->val.val.a.b = new_buf;
-            current_attribute->val.val.a.s = val->val.a.s;
-            current_attribute->val.val.a.n = val->val.a.n;
-            current_attribute->val.val.a.t = val->val.a.t;
-        } else {
-            ESP_LOGD(TAG, "Set val called with string with size 0");
+
+        /* If a client already exists, do not create it again */
+        if ((_existing_cluster->flags & CLUSTER_FLAG_CLIENT) && (flags & CLUSTER_FLAG_CLIENT)) {
+            ESP_LOGW(TAG, "Client Cluster 0x%08" PRIX32 " on endpoint 0x%04" PRIx16 " already exists. Not creating again.", cluster_id,
+                     current_endpoint->endpoint_id);
+            return existing_cluster;
         }
-    } else {
-        memcpy((void *)&current_attribute->val, (void *)val, sizeof(esp_matter_attr_val_t));
+
+        /* The cluster already exists, but is of a different type. Just update the 'Set' part from below. */
+        ESP_LOGI(TAG, "Cluster 0x%08" PRIX32 " on endpoint 0x%04" PRIx16 " already exists. Updating values.", cluster_id,
+                 current_endpoint->endpoint_id);
+        _existing_cluster->flags |= flags;
+        return existing_cluster;
     }
 
-    if (current_attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE) {
-        if (current_attribute->flags & ATTRIBUTE_FLAG_DEFERRED) {
-            if (!chip::DeviceLayer::SystemLayer().IsTimerActive(deferred_attribute_write, current_attribute)) {
-                auto & system_layer = chip::DeviceLayer::SystemLayer();
-                system_layer.StartTimer(chip::System::Clock::Milliseconds16(k_deferred_attribute_persistence_time_ms),
-                                        deferred_attribute_write, current_attribute);
-            }
-        } else {
-            store_val_in_nvs(current_attribute->endpoint_id, current_attribute->cluster_id,
-                             current_attribute->attribute_id, current_attribute->val);
-        }
+    /* Allocate */
+    _cluster_t *cluster = (_cluster_t *)dm_calloc(ENDPOINT_ARENA(current_endpoint), ESP_MATTER_MEM_TAG_DEFAULT, 1, sizeof(_cluster_t));
+    if (!cluster) {
+        ESP_LOGE(TAG, "Couldn't allocate _cluster_t");
+        return NULL;
     }
-    return ESP_OK;
+
+    /* Set */
+    cluster->cluster_id = cluster_id;
+    cluster->endpoint_id = current_endpoint->endpoint_id;
+    cluster->flags = flags;
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_ARENA
+    cluster->arena = &current_endpoint->arena;
+#endif
+
+    /* Add */
+    _cluster_t *previous_cluster = NULL;
+    _cluster_t *current_cluster = current_endpoint->cluster_list;
+    while (current_cluster) {
+        previous_cluster = current_cluster;
+        current_cluster = current_cluster->next;
+    }
+    if (previous_cluster == NULL) {
+        current_endpoint->cluster_list = cluster;
+    } else {
+        previous_cluster->next = cluster;
+    }
+    current_endpoint->cluster_count++;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    path_index::insert(path_index::ELEMENT_TYPE_CLUSTER, cluster->endpoint_id, cluster_id, 0, cluster);
+#endif
+
+    return (cluster_t *)cluster;
 }
 
-esp_err_t get_val(attribute_t *attribute, esp_matter_attr_val_t *val)
+static esp_err_t destroy(cluster_t *cluster)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
         return ESP_ERR_INVALID_ARG;
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-    memcpy((void *)val, (void *)&current_attribute->val, sizeof(esp_matter_attr_val_t));
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+    /* Only left registered if the endpoint was not disabled */
+    attribute_access::unregister_cluster(&current_cluster->attribute_access);
+#endif
+
+    /* Parse and delete all commands */
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+    destroy_command_table(current_cluster);
+#endif
+    _command_t *command = current_cluster->command_list;
+    while (command) {
+        _command_t *next_command = command->next;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+        if (command->flags & COMMAND_FLAG_ACCEPTED) {
+            path_index::remove(path_index::ELEMENT_TYPE_ACCEPTED_COMMAND, current_cluster->endpoint_id,
+                               current_cluster->cluster_id, command->command_id);
+        }
+        if (command->flags & COMMAND_FLAG_GENERATED) {
+            path_index::remove(path_index::ELEMENT_TYPE_GENERATED_COMMAND, current_cluster->endpoint_id,
+                               current_cluster->cluster_id, command->command_id);
+        }
+#endif
+        command::destroy(current_cluster, (command_t *)command);
+        command = next_command;
+    }
+
+    /* Parse and delete all attributes */
+    _attribute_t *attribute = current_cluster->attribute_list;
+    while (attribute) {
+        _attribute_t *next_attribute = attribute->next;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+        path_index::remove(path_index::ELEMENT_TYPE_ATTRIBUTE, current_cluster->endpoint_id,
+                           current_cluster->cluster_id, attribute->attribute_id);
+#endif
+        attribute::destroy(current_cluster, (attribute_t *)attribute);
+        attribute = next_attribute;
+    }
+
+    /* Parse and delete all events */
+    _event_t *event = current_cluster->event_list;
+    while (event) {
+        _event_t *next_event = event->next;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+        path_index::remove(path_index::ELEMENT_TYPE_EVENT, current_cluster->endpoint_id,
+                           current_cluster->cluster_id, event->event_id);
+#endif
+        event::destroy(current_cluster, (event_t *)event);
+        event = next_event;
+    }
+
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    path_index::remove(path_index::ELEMENT_TYPE_CLUSTER, current_cluster->endpoint_id, current_cluster->cluster_id, 0);
+#endif
+    /* Free */
+    dm_free(CLUSTER_ARENA(current_cluster), current_cluster, sizeof(_cluster_t));
     return ESP_OK;
 }
 
-esp_err_t add_bounds(attribute_t *attribute, esp_matter_attr_val_t min, esp_matter_attr_val_t max)
+cluster_t *get(endpoint_t *endpoint, uint32_t cluster_id)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint cannot be NULL");
+        return NULL;
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-
-    /* Check if bounds can be set */
-    if (current_attribute->val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_ARRAY) {
-        ESP_LOGE(TAG, "Bounds cannot be set for string/array type attributes");
-        return ESP_ERR_INVALID_ARG;
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    cluster_t *indexed_cluster = (cluster_t *)path_index::find(path_index::ELEMENT_TYPE_CLUSTER,
+                                                               current_endpoint->endpoint_id, cluster_id, 0);
+    if (indexed_cluster || path_index::is_complete()) {
+        return indexed_cluster;
     }
-    if ((current_attribute->val.type != min.type) || (current_attribute->val.type != max.type)) {
-        ESP_LOGE(TAG, "Cannot set bounds because of val type mismatch: expected: %d, min: %d, max: %d",
-                 current_attribute->val.type, min.type, max.type);
-        return ESP_ERR_INVALID_ARG;
+#endif
+    _cluster_t *current_cluster = (_cluster_t *)current_endpoint->cluster_list;
+    while (current_cluster) {
+        if (current_cluster->cluster_id == cluster_id) {
+            break;
+        }
+        current_cluster = current_cluster->next;
     }
+    return (cluster_t *)current_cluster;
+}
 
-    /* Free the default value before setting the new bounds */
-    free_default_value(attribute);
+cluster_t *get_first(endpoint_t *endpoint)
+{
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint cannot be NULL");
+        return NULL;
+    }
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    return (cluster_t *)current_endpoint->cluster_list;
+}
 
-    /* Allocate and set */
-    current_attribute->bounds = (esp_matter_attr_bounds_t *)esp_matter_mem_calloc(1, sizeof(esp_matter_attr_bounds_t));
-    if (!current_attribute->bounds) {
-        ESP_LOGE(TAG, "Could not allocate bounds");
-        return ESP_ERR_NO_MEM;
+cluster_t *get_next(cluster_t *cluster)
+{
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return NULL;
+    }
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    return (cluster_t *)current_cluster->next;
+}
+
+uint32_t get_id(cluster_t *cluster)
+{
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return kInvalidClusterId;
     }
-    memcpy((void *)&current_attribute->bounds->min, (void *)&min, sizeof(esp_matter_attr_val_t));
-    memcpy((void *)&current_attribute->bounds->max, (void *)&max, sizeof(esp_matter_attr_val_t));
-    current_attribute->flags |= ATTRIBUTE_FLAG_MIN_MAX;
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    return current_cluster->cluster_id;
+}
 
-    /* Set the default value again after setting the bounds and the flag */
-    set_default_value_from_current_val(attribute);
+esp_err_t set_plugin_server_init_callback(cluster_t *cluster, plugin_server_init_callback_t callback)
+{
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    current_cluster->plugin_server_init_callback = callback;
     return ESP_OK;
 }
 
-esp_matter_attr_bounds_t *get_bounds(attribute_t *attribute)
+plugin_server_init_callback_t get_plugin_server_init_callback(cluster_t *cluster)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
         return NULL;
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-    return current_attribute->bounds;
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    return current_cluster->plugin_server_init_callback;
 }
 
-uint16_t get_flags(attribute_t *attribute)
+esp_err_t add_function_list(cluster_t *cluster, const function_generic_t *function_list, int function_flags)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
-        return 0;
+    if (!cluster) {
+        ESP_LOGE(TAG, "Cluster cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-    return current_attribute->flags;
+    _cluster_t *current_cluster = (_cluster_t *)cluster;
+    current_cluster->function_list = function_list;
+    current_cluster->flags |= function_flags;
+    return ESP_OK;
 }
 
-esp_err_t set_override_callback(attribute_t *attribute, callback_t callback)
+/* Append the elements of the descriptor after the given tails of the lists of the cluster. The duplicate checks are
+ * only needed if the cluster already had some elements. */
+static esp_err_t append_elements(_cluster_t *current_cluster, const descriptor_t *descriptor,
+                                 _attribute_t *last_attribute, _command_t *last_command, _event_t *last_event)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
+    /* Attributes */
+    _attribute_t *previous_attribute = last_attribute;
+    for (uint16_t index = 0; index < descriptor->attribute_count; index++) {
+        const attribute::descriptor_t *attribute = &descriptor->attributes[index];
+        if (last_attribute && attribute::get((cluster_t *)current_cluster, attribute->attribute_id)) {
+            continue;
+        }
+        previous_attribute = attribute::create_after(current_cluster, previous_attribute, attribute->attribute_id,
+                                                     attribute->flags, attribute->val, attribute->max_val_size);
+        if (!previous_attribute) {
+            return ESP_ERR_NO_MEM;
+        }
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-    if (current_attribute->val.type == ESP_MATTER_VAL_TYPE_ARRAY ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
-        current_attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING) {
-        // The override callback might allocate memory and we have no way to free the memory
-        // TODO: Add memory-safe override callback for these attribute types
-        ESP_LOGE(TAG, "Cannot set override callback for attribute 0x%" PRIX32 " on cluster 0x%" PRIX32,
-                 current_attribute->attribute_id, current_attribute->cluster_id);
-        return ESP_ERR_NOT_SUPPORTED;
+
+    /* Commands */
+    _command_t *previous_command = last_command;
+    for (uint16_t index = 0; index < descriptor->command_count; index++) {
+        const command::descriptor_t *command = &descriptor->commands[index];
+        if (last_command && command::get((cluster_t *)current_cluster, command->command_id, command->flags)) {
+            continue;
+        }
+        previous_command = command::create_after(current_cluster, previous_command, command->command_id,
+                                                 command->flags, command->callback);
+        if (!previous_command) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    /* Events */
+    _event_t *previous_event = last_event;
+    for (uint16_t index = 0; index < descriptor->event_count; index++) {
+        if (last_event && event::get((cluster_t *)current_cluster, descriptor->event_ids[index])) {
+            continue;
+        }
+        previous_event = event::create_after(current_cluster, previous_event, descriptor->event_ids[index]);
+        if (!previous_event) {
+            return ESP_ERR_NO_MEM;
+        }
     }
-    current_attribute->override_callback = callback;
-    current_attribute->flags |= ATTRIBUTE_FLAG_OVERRIDE;
     return ESP_OK;
 }
 
-callback_t get_override_callback(attribute_t *attribute)
+/* Undo a failed create from descriptor: the elements appended after the given ones are destroyed, and the cluster too
+ * if it has been created. The persisted values are not erased, they are read again by the next attempt. */
+static void discard_appended(_endpoint_t *current_endpoint, _cluster_t *current_cluster, bool created,
+                             _attribute_t *last_attribute, _command_t *last_command, _event_t *last_event)
 {
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
-        return NULL;
+    _attribute_t **attribute = last_attribute ? &last_attribute->next : &current_cluster->attribute_list;
+    while (*attribute) {
+        _attribute_t *current_attribute = *attribute;
+        *attribute = current_attribute->next;
+        current_cluster->attribute_count--;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+        path_index::remove(path_index::ELEMENT_TYPE_ATTRIBUTE, current_cluster->endpoint_id,
+                           current_cluster->cluster_id, current_attribute->attribute_id);
+#endif
+        current_attribute->flags &= ~ATTRIBUTE_FLAG_NONVOLATILE;
+        attribute::destroy(current_cluster, (attribute_t *)current_attribute);
+    }
+
+    _command_t **command = last_command ? &last_command->next : &current_cluster->command_list;
+    while (*command) {
+        _command_t *current_command = *command;
+        *command = current_command->next;
+        if (current_command->flags & COMMAND_FLAG_ACCEPTED) {
+            current_cluster->accepted_command_count--;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+            path_index::remove(path_index::ELEMENT_TYPE_ACCEPTED_COMMAND, current_cluster->endpoint_id,
+                               current_cluster->cluster_id, current_command->command_id);
+#endif
+        }
+        if (current_command->flags & COMMAND_FLAG_GENERATED) {
+            current_cluster->generated_command_count--;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+            path_index::remove(path_index::ELEMENT_TYPE_GENERATED_COMMAND, current_cluster->endpoint_id,
+                               current_cluster->cluster_id, current_command->command_id);
+#endif
+        }
+        command::destroy(current_cluster, (command_t *)current_command);
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-    return current_attribute->override_callback;
-}
 
-esp_err_t set_deferred_persistence(attribute_t *attribute)
-{
-    if (!attribute) {
-        ESP_LOGE(TAG, "Attribute cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
+    _event_t **event = last_event ? &last_event->next : &current_cluster->event_list;
+    while (*event) {
+        _event_t *current_event = *event;
+        *event = current_event->next;
+        current_cluster->event_count--;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+        path_index::remove(path_index::ELEMENT_TYPE_EVENT, current_cluster->endpoint_id, current_cluster->cluster_id,
+                           current_event->event_id);
+#endif
+        event::destroy(current_cluster, (event_t *)current_event);
     }
-    _attribute_t *current_attribute = (_attribute_t *)attribute;
-    if (!(current_attribute->flags & ATTRIBUTE_FLAG_NONVOLATILE)) {
-        ESP_LOGE(TAG, "Attribute should be non-volatile to set a deferred persistence time");
-        return ESP_ERR_INVALID_ARG;
+
+    if (!created) {
+        return;
     }
-    current_attribute->flags |= ATTRIBUTE_FLAG_DEFERRED;
-    return ESP_OK;
+    _cluster_t **cluster = &current_endpoint->cluster_list;
+    while (*cluster && *cluster != current_cluster) {
+        cluster = &(*cluster)->next;
+    }
+    if (*cluster) {
+        *cluster = current_cluster->next;
+        current_endpoint->cluster_count--;
+    }
+    destroy((cluster_t *)current_cluster);
 }
 
-} /* attribute */
-
-namespace command {
-command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callback_t callback)
+cluster_t *create(endpoint_t *endpoint, const descriptor_t *descriptor)
 {
-    /* Find */
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
+    if (!endpoint || !descriptor) {
+        ESP_LOGE(TAG, "Endpoint or descriptor cannot be NULL");
         return NULL;
     }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    command_t *existing_command = get(cluster, command_id, flags);
-    if (existing_command) {
-        ESP_LOGW(TAG, "Command 0x%08" PRIX32 " on cluster 0x%08" PRIX32 " already exists. Not creating again.", command_id,
-                 current_cluster->cluster_id);
-        return existing_command;
+    if ((descriptor->attribute_count && !descriptor->attributes) || (descriptor->command_count && !descriptor->commands)
+        || (descriptor->event_count && !descriptor->event_ids)) {
+        ESP_LOGE(TAG, "Descriptor tables of cluster 0x%08" PRIX32 " cannot be NULL", descriptor->cluster_id);
+        return NULL;
     }
-
-    /* Allocate */
-    _command_t *command = (_command_t *)esp_matter_mem_calloc(1, sizeof(_command_t));
-    if (!command) {
-        ESP_LOGE(TAG, "Couldn't allocate _command_t");
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    uint16_t cluster_count = current_endpoint->cluster_count;
+    _cluster_t *current_cluster = (_cluster_t *)create(endpoint, descriptor->cluster_id, descriptor->flags);
+    if (!current_cluster) {
         return NULL;
     }
+    bool created = current_endpoint->cluster_count != cluster_count;
+    if (descriptor->plugin_server_init_callback) {
+        current_cluster->plugin_server_init_callback = descriptor->plugin_server_init_callback;
+    }
+    if (descriptor->function_list) {
+        add_function_list((cluster_t *)current_cluster, descriptor->function_list, descriptor->function_flags);
+    }
 
-    /* Set */
-    command->command_id = command_id;
-    command->flags = flags;
-    command->callback = callback;
-    command->user_callback = NULL;
-
-    /* Add */
-    _command_t *previous_command = NULL;
-    _command_t *current_command = current_cluster->command_list;
-    while (current_command) {
-        previous_command = current_command;
-        current_command = current_command->next;
+    /* The elements of the descriptor are appended to the tails of the lists */
+    _attribute_t *last_attribute = current_cluster->attribute_list;
+    while (last_attribute && last_attribute->next) {
+        last_attribute = last_attribute->next;
     }
-    if (previous_command == NULL) {
-        current_cluster->command_list = command;
-    } else {
-        previous_command->next = command;
+    _command_t *last_command = current_cluster->command_list;
+    while (last_command && last_command->next) {
+        last_command = last_command->next;
+    }
+    _event_t *last_event = current_cluster->event_list;
+    while (last_event && last_event->next) {
+        last_event = last_event->next;
     }
 
-    return (command_t *)command;
+    if (append_elements(current_cluster, descriptor, last_attribute, last_command, last_event) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create cluster 0x%08" PRIX32 " from descriptor", descriptor->cluster_id);
+        discard_appended(current_endpoint, current_cluster, created, last_attribute, last_command, last_event);
+        return NULL;
+    }
+    return (cluster_t *)current_cluster;
 }
 
-static esp_err_t destroy(command_t *command)
-{
-    if (!command) {
-        ESP_LOGE(TAG, "Command cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
-    }
-    _command_t *current_command = (_command_t *)command;
+} /* cluster */
 
-    /* Free */
-    esp_matter_mem_free(current_command);
-    return ESP_OK;
-}
+namespace endpoint {
 
-command_t *get(cluster_t *cluster, uint32_t command_id, uint16_t flags)
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_TABLE
+/* Set the entry of the endpoint ID in the endpoint table, the table grows up to the minimum unused endpoint ID. The
+ * endpoints with larger IDs are found through the list. */
+static void set_table_entry(_node_t *current_node, uint16_t endpoint_id, _endpoint_t *endpoint)
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
-        return NULL;
+    if (endpoint_id >= CONFIG_ESP_MATTER_ENDPOINT_TABLE_MAX_SIZE || current_node->endpoint_table_disabled) {
+        return;
     }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    _command_t *current_command = (_command_t *)current_cluster->command_list;
-    while (current_command) {
-        if ((current_command->command_id == command_id) && (current_command->flags & flags)) {
-            break;
+    if (endpoint_id >= current_node->endpoint_table_size) {
+        if (!endpoint) {
+            return;
         }
-        current_command = current_command->next;
+        /* Grow by steps of 8 entries to cover the IDs already handed out, so the next endpoints fit */
+        uint32_t new_size = current_node->min_unused_endpoint_id > endpoint_id ? current_node->min_unused_endpoint_id :
+            endpoint_id + 1;
+        new_size = (new_size + 7) & ~7u;
+        if (new_size > CONFIG_ESP_MATTER_ENDPOINT_TABLE_MAX_SIZE) {
+            new_size = CONFIG_ESP_MATTER_ENDPOINT_TABLE_MAX_SIZE;
+        }
+        _endpoint_t **new_table = (_endpoint_t **)esp_matter_mem_realloc(current_node->endpoint_table,
+                                                                         new_size * sizeof(_endpoint_t *));
+        if (!new_table) {
+            /* Disable the table, the lookups go back to the list */
+            ESP_LOGE(TAG, "Couldn't grow the endpoint table");
+            esp_matter_mem_free(current_node->endpoint_table);
+            current_node->endpoint_table = NULL;
+            current_node->endpoint_table_size = 0;
+            current_node->endpoint_table_disabled = true;
+            return;
+        }
+        memset(&new_table[current_node->endpoint_table_size], 0,
+               (new_size - current_node->endpoint_table_size) * sizeof(_endpoint_t *));
+        current_node->endpoint_table = new_table;
+        current_node->endpoint_table_size = (uint16_t)new_size;
     }
-    return (command_t *)current_command;
+    current_node->endpoint_table[endpoint_id] = endpoint;
 }
 
-command_t *get_first(cluster_t *cluster)
+/* Free the endpoint table, the node is going away */
+static void release_table(_node_t *current_node)
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
-        return NULL;
-    }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    return (command_t *)current_cluster->command_list;
+    esp_matter_mem_free(current_node->endpoint_table);
+    current_node->endpoint_table = NULL;
+    current_node->endpoint_table_size = 0;
+    current_node->endpoint_table_disabled = false;
 }
+#endif // CONFIG_ESP_MATTER_ENABLE_ENDPOINT_TABLE
 
-command_t *get_next(command_t *command)
+endpoint_t *create(node_t *node, uint8_t flags, void *priv_data)
 {
-    if (!command) {
-        ESP_LOGE(TAG, "Command cannot be NULL");
+    /* Find */
+    if (!node) {
+        ESP_LOGE(TAG, "Node cannot be NULL");
         return NULL;
     }
-    _command_t *current_command = (_command_t *)command;
-    return (command_t *)current_command->next;
-}
+    _node_t *current_node = (_node_t *)node;
 
-uint32_t get_id(command_t *command)
-{
-    if (!command) {
-        ESP_LOGE(TAG, "Command cannot be NULL");
-        return kInvalidCommandId;
+    if (get_count(node) >= CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT) {
+        ESP_LOGE(TAG, "Dynamic endpoint count cannot be greater than CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT:%u",
+                CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT);
+        return NULL;
     }
-    _command_t *current_command = (_command_t *)command;
-    return current_command->command_id;
-}
 
-callback_t get_callback(command_t *command)
-{
-    if (!command) {
-        ESP_LOGE(TAG, "Command cannot be NULL");
+    /* Allocate */
+    _endpoint_t *endpoint = (_endpoint_t *)esp_matter_mem_calloc(1, sizeof(_endpoint_t));
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Couldn't allocate _endpoint_t");
         return NULL;
     }
-    _command_t *current_command = (_command_t *)command;
-    return current_command->callback;
+
+    /* Set */
+    endpoint->endpoint_id = current_node->min_unused_endpoint_id++;
+    endpoint->device_type_count = 0;
+    endpoint->parent_endpoint_id = chip::kInvalidEndpointId;
+    endpoint->flags = flags;
+    endpoint->priv_data = priv_data;
+
+    /* Store */
+    if (esp_matter_started) {
+#if CONFIG_ESP_MATTER_DEFER_ENDPOINT_ID_PERSISTENCE
+        /* Creating several endpoints costs a single commit, at the end of the persistence window */
+        attribute::defer_min_unused_endpoint_id();
+#else
+        node::store_min_unused_endpoint_id();
+#endif
+    }
+
+    /* Add */
+    _endpoint_t *previous_endpoint = NULL;
+    _endpoint_t *current_endpoint = current_node->endpoint_list;
+    while (current_endpoint) {
+        previous_endpoint = current_endpoint;
+        current_endpoint = current_endpoint->next;
+    }
+    if (previous_endpoint == NULL) {
+        current_node->endpoint_list = endpoint;
+    } else {
+        previous_endpoint->next = endpoint;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    path_index::insert(path_index::ELEMENT_TYPE_ENDPOINT, endpoint->endpoint_id, 0, 0, endpoint);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_TABLE
+    set_table_entry(current_node, endpoint->endpoint_id, endpoint);
+#endif
+
+    return (endpoint_t *)endpoint;
 }
 
-callback_t get_user_callback(command_t *command)
+endpoint_t *resume(node_t *node, uint8_t flags, uint16_t endpoint_id, void *priv_data)
 {
-    if (!command) {
-        ESP_LOGE(TAG, "Command cannot be NULL");
+    /* Find */
+    if (!node) {
+        ESP_LOGE(TAG, "Node cannot be NULL");
         return NULL;
     }
-    _command_t *current_command = (_command_t *)command;
-    return current_command->user_callback;
-}
+    _node_t *current_node = (_node_t *)node;
+    _endpoint_t *previous_endpoint = NULL;
+    _endpoint_t *current_endpoint = current_node->endpoint_list;
+    while (current_endpoint) {
+        if (current_endpoint->endpoint_id == endpoint_id) {
+            ESP_LOGE(TAG, "Could not resume an endpoint that has been added to the node");
+            return NULL;
+        }
+        previous_endpoint = current_endpoint;
+        current_endpoint = current_endpoint->next;
+    }
 
-void set_user_callback(command_t *command, callback_t user_callback)
-{
-    if (!command) {
-        ESP_LOGE(TAG, "Command cannot be NULL");
+    /* Check */
+    if (endpoint_id >= current_node->min_unused_endpoint_id) {
+        ESP_LOGE(TAG, "The endpoint_id of the resumed endpoint should have been used");
+        return NULL;
     }
-    _command_t *current_command = (_command_t *)command;
-    current_command->user_callback = user_callback;
-}
 
-uint16_t get_flags(command_t *command)
-{
-    if (!command) {
-        ESP_LOGE(TAG, "Command cannot be NULL");
-        return 0;
+     /* Allocate */
+     _endpoint_t *endpoint = (_endpoint_t *)esp_matter_mem_calloc(1, sizeof(_endpoint_t));
+     if (!endpoint) {
+         ESP_LOGE(TAG, "Couldn't allocate _endpoint_t");
+         return NULL;
+     }
+
+     /* Set */
+     endpoint->endpoint_id = endpoint_id;
+     endpoint->device_type_count = 0;
+     endpoint->flags = flags;
+     endpoint->priv_data = priv_data;
+
+     /* Add */
+    if (previous_endpoint == NULL) {
+        current_node->endpoint_list = endpoint;
+    } else {
+        previous_endpoint->next = endpoint;
     }
-    _command_t *current_command = (_command_t *)command;
-    return current_command->flags;
-}
-
-} /* command */
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    path_index::insert(path_index::ELEMENT_TYPE_ENDPOINT, endpoint->endpoint_id, 0, 0, endpoint);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_TABLE
+    set_table_entry(current_node, endpoint->endpoint_id, endpoint);
+#endif
 
-namespace event {
+    return (endpoint_t *)endpoint;
+}
 
-event_t *create(cluster_t *cluster, uint32_t event_id)
+esp_err_t destroy(node_t *node, endpoint_t *endpoint)
 {
-    /* Find */
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
-        return NULL;
-    }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    event_t *existing_event = get(cluster, event_id);
-    if (existing_event) {
-        ESP_LOGW(TAG, "Event 0x%08" PRIX32 " on cluster 0x%08" PRIX32 " already exists. Not creating again.", event_id,
-                 current_cluster->cluster_id);
-        return existing_event;
+    if (!node || !endpoint) {
+        ESP_LOGE(TAG, "Node or endpoint cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
     }
+    _node_t *current_node = (_node_t *)node;
+    _endpoint_t *_endpoint = (_endpoint_t *)endpoint;
 
-    /* Allocate */
-    _event_t *event = (_event_t *)esp_matter_mem_calloc(1, sizeof(_event_t));
-    if (!event) {
-        ESP_LOGE(TAG, "Couldn't allocate _event_t");
-        return NULL;
+    if (!(_endpoint->flags & ENDPOINT_FLAG_DESTROYABLE)) {
+        ESP_LOGE(TAG, "This endpoint cannot be deleted since the ENDPOINT_FLAG_DESTROYABLE is not set");
+        return ESP_FAIL;
     }
 
-    /* Set */
-    event->event_id = event_id;
-
-    /* Add */
-    _event_t *previous_event = NULL;
-    _event_t *current_event = current_cluster->event_list;
-    while (current_event) {
-        previous_event = current_event;
-        current_event = current_event->next;
+    /* Find current endpoint and remove from list */
+    _endpoint_t *current_endpoint = current_node->endpoint_list;
+    _endpoint_t *previous_endpoint = NULL;
+    while (current_endpoint) {
+        if (current_endpoint == _endpoint) {
+            break;
+        }
+        previous_endpoint = current_endpoint;
+        current_endpoint = current_endpoint->next;
     }
-    if (previous_event == NULL) {
-        current_cluster->event_list = event;
+    if (current_endpoint == NULL) {
+        ESP_LOGE(TAG, "Could not find the endpoint to delete");
+        return ESP_FAIL;
+    }
+    if (previous_endpoint == NULL) {
+        current_node->endpoint_list = current_endpoint->next;
     } else {
-        previous_event->next = event;
+        previous_endpoint->next = current_endpoint->next;
     }
 
-    return (event_t *)event;
-}
+    /* Disable */
+    disable(endpoint);
 
-static esp_err_t destroy(event_t *event)
-{
-    if (!event) {
-        ESP_LOGE(TAG, "Event cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
+    /* Parse and delete all clusters */
+    _cluster_t *cluster = current_endpoint->cluster_list;
+    while (cluster) {
+        _cluster_t *next_cluster = cluster->next;
+        cluster::destroy((cluster_t *)cluster);
+        cluster = next_cluster;
     }
-    _event_t *current_event = (_event_t *)event;
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    path_index::remove(path_index::ELEMENT_TYPE_ENDPOINT, current_endpoint->endpoint_id, 0, 0);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_TABLE
+    set_table_entry(current_node, current_endpoint->endpoint_id, NULL);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_ARENA
+    /* All the clusters, attributes, commands and events are released at once */
+    arena::release(&current_endpoint->arena);
+#endif
 
     /* Free */
-    esp_matter_mem_free(current_event);
+    esp_matter_mem_free(current_endpoint);
     return ESP_OK;
 }
 
-event_t *get(cluster_t *cluster, uint32_t event_id)
+endpoint_t *get(node_t *node, uint16_t endpoint_id)
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
+    if (!node) {
+        ESP_LOGE(TAG, "Node cannot be NULL");
         return NULL;
     }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    _event_t *current_event = (_event_t *)current_cluster->event_list;
-    while (current_event) {
-        if (current_event->event_id == event_id) {
+    _node_t *current_node = (_node_t *)node;
+    (void)current_node;
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_TABLE
+    if (endpoint_id < current_node->endpoint_table_size) {
+        return (endpoint_t *)current_node->endpoint_table[endpoint_id];
+    }
+    if (endpoint_id < CONFIG_ESP_MATTER_ENDPOINT_TABLE_MAX_SIZE && current_node->endpoint_table) {
+        /* The table covers all the endpoints added with the IDs below its size */
+        return NULL;
+    }
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+    endpoint_t *indexed_endpoint = (endpoint_t *)path_index::find(path_index::ELEMENT_TYPE_ENDPOINT, endpoint_id, 0,
+                                                                  0);
+    if (indexed_endpoint || path_index::is_complete()) {
+        return indexed_endpoint;
+    }
+#endif
+    _endpoint_t *current_endpoint = (_endpoint_t *)current_node->endpoint_list;
+    while (current_endpoint) {
+        if (current_endpoint->endpoint_id == endpoint_id) {
             break;
         }
-        current_event = current_event->next;
+        current_endpoint = current_endpoint->next;
     }
-    return (event_t *)current_event;
+    return (endpoint_t *)current_endpoint;
 }
 
-event_t *get_first(cluster_t *cluster)
+endpoint_t *get_first(node_t *node)
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
+    if (!node) {
+        ESP_LOGE(TAG, "Node cannot be NULL");
         return NULL;
     }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    return (event_t *)current_cluster->event_list;
+    _node_t *current_node = (_node_t *)node;
+    return (endpoint_t *)current_node->endpoint_list;
 }
 
-event_t *get_next(event_t *event)
+endpoint_t *get_next(endpoint_t *endpoint)
 {
-    if (!event) {
-        ESP_LOGE(TAG, "Event cannot be NULL");
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint cannot be NULL");
         return NULL;
     }
-    _event_t *current_event = (_event_t *)event;
-    return (event_t *)current_event->next;
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    return (endpoint_t *)current_endpoint->next;
 }
 
-uint32_t get_id(event_t *event)
+uint16_t get_count(node_t *node)
 {
-    if (!event) {
-        ESP_LOGE(TAG, "Event cannot be NULL");
-        return chip::kInvalidEventId;
+    if (!node) {
+        ESP_LOGE(TAG, "Node cannot be NULL");
+        return 0;
     }
-    _event_t *current_event = (_event_t *)event;
-    return current_event->event_id;
+    uint16_t count = 0;
+    endpoint_t *endpoint = get_first(node);
+    while (endpoint) {
+        count++;
+        endpoint = get_next(endpoint);
+    }
+    return count;
 }
 
-} /* event */
-
+uint16_t get_id(endpoint_t *endpoint)
+{
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint cannot be NULL");
+        return kInvalidEndpointId;
+    }
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    return current_endpoint->endpoint_id;
+}
 
-namespace cluster {
+esp_err_t add_device_type(endpoint_t *endpoint, uint32_t device_type_id, uint8_t device_type_version)
+{
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    if (current_endpoint->device_type_count >= ESP_MATTER_MAX_DEVICE_TYPE_COUNT) {
+        ESP_LOGE(TAG, "Could not add a new device type to the endpoint");
+        return ESP_FAIL;
+    }
+    current_endpoint->device_type_ids[current_endpoint->device_type_count] = device_type_id;
+    current_endpoint->device_type_versions[current_endpoint->device_type_count] = device_type_version;
+    current_endpoint->device_type_count++;
+    return ESP_OK;
+}
 
-cluster_t *create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags)
+uint32_t *get_device_type_ids(endpoint_t *endpoint, uint8_t *device_type_count_ptr)
 {
-    /* Find */
     if (!endpoint) {
         ESP_LOGE(TAG, "Endpoint cannot be NULL");
         return NULL;
     }
-    if (!(flags & CLUSTER_FLAG_SERVER) && !(flags & CLUSTER_FLAG_CLIENT)) {
-        ESP_LOGE(TAG, "Server or client cluster flag not set");
+    if (!device_type_count_ptr) {
+        ESP_LOGE(TAG, "device type count pointer cannot be NULL");
         return NULL;
     }
     _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    cluster_t *existing_cluster = get(endpoint, cluster_id);
-    if (existing_cluster) {
-        /* If a server already exists, do not create it again */
-        _cluster_t *_existing_cluster = (_cluster_t *)existing_cluster;
-        if ((_existing_cluster->flags & CLUSTER_FLAG_SERVER) && (flags & CLUSTER_FLAG_SERVER)) {
-            ESP_LOGW(TAG, "Server Cluster 0x%08" PRIX32 " on endpoint 0x%04" PRIx16 " already exists. Not creating again.", cluster_id,
-                     current_endpoint->endpoint_id);
-            return existing_cluster;
-        }
-
-        /* If a client already exists, do not create it again */
-        if ((_existing_cluster->flags & CLUSTER_FLAG_CLIENT) && (flags & CLUSTER_FLAG_CLIENT)) {
-            ESP_LOGW(TAG, "Client Cluster 0x%08" PRIX32 " on endpoint 0x%04" PRIx16 " already exists. Not creating again.", cluster_id,
-                     current_endpoint->endpoint_id);
-            return existing_cluster;
-        }
+    *device_type_count_ptr = current_endpoint->device_type_count;
+    return current_endpoint->device_type_ids;
+}
 
-        /* The cluster already exists, but is of a different type. Just update the 'Set' part from below. */
-        ESP_LOGI(TAG, "Cluster 0x%08" PRIX32 " on endpoint 0x%04" PRIx16 " already exists. Updating values.", cluster_id,
-                 current_endpoint->endpoint_id);
-        _existing_cluster->flags |= flags;
-        return existing_cluster;
+uint8_t *get_device_type_versions(endpoint_t *endpoint, uint8_t *device_type_count_ptr)
+{
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint cannot be NULL");
+        return NULL;
     }
-
-    /* Allocate */
-    _cluster_t *cluster = (_cluster_t *)esp_matter_mem_calloc(1, sizeof(_cluster_t));
-    if (!cluster) {
-        ESP_LOGE(TAG, "Couldn't allocate _cluster_t");
+    if (!device_type_count_ptr) {
+        ESP_LOGE(TAG, "device type count pointer cannot be NULL");
         return NULL;
     }
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    *device_type_count_ptr = current_endpoint->device_type_count;
+    return current_endpoint->device_type_versions;
+}
+
+esp_err_t set_parent_endpoint(endpoint_t *endpoint, endpoint_t *parent_endpoint)
+{
+    if (!endpoint || !parent_endpoint) {
+        ESP_LOGE(TAG, "Endpoint or parent_endpoint cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    _endpoint_t *current_parent_endpoint = (_endpoint_t *)parent_endpoint;
+    current_endpoint->parent_endpoint_id = current_parent_endpoint->endpoint_id;
+    return ESP_OK;
+}
 
-    /* Set */
-    cluster->cluster_id = cluster_id;
-    cluster->endpoint_id = current_endpoint->endpoint_id;
-    cluster->flags = flags;
+esp_err_t set_parent_endpoint_id(endpoint_t *endpoint, uint16_t parent_endpoint_id)
+{
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    current_endpoint->parent_endpoint_id = parent_endpoint_id;
+    return ESP_OK;
+}
 
-    /* Add */
-    _cluster_t *previous_cluster = NULL;
-    _cluster_t *current_cluster = current_endpoint->cluster_list;
-    while (current_cluster) {
-        previous_cluster = current_cluster;
-        current_cluster = current_cluster->next;
+endpoint_t *create(node_t *node, const descriptor_t *descriptor, uint8_t flags, void *priv_data)
+{
+    if (!descriptor) {
+        ESP_LOGE(TAG, "Descriptor cannot be NULL");
+        return NULL;
     }
-    if (previous_cluster == NULL) {
-        current_endpoint->cluster_list = cluster;
-    } else {
-        previous_cluster->next = cluster;
+    endpoint_t *endpoint = create(node, flags, priv_data);
+    if (!endpoint) {
+        return NULL;
     }
-
-    return (cluster_t *)cluster;
+    if (add(endpoint, descriptor) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add the descriptor to the endpoint");
+        /* The endpoint has not been handed out yet, drop it whatever its flags */
+        ((_endpoint_t *)endpoint)->flags |= ENDPOINT_FLAG_DESTROYABLE;
+        destroy(node, endpoint);
+        return NULL;
+    }
+    return endpoint;
 }
 
-static esp_err_t destroy(cluster_t *cluster)
+esp_err_t add(endpoint_t *endpoint, const descriptor_t *descriptor)
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
+    if (!endpoint || !descriptor) {
+        ESP_LOGE(TAG, "Endpoint or descriptor cannot be NULL");
         return ESP_ERR_INVALID_ARG;
     }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-
-    /* Parse and delete all commands */
-    _command_t *command = current_cluster->command_list;
-    while (command) {
-        _command_t *next_command = command->next;
-        command::destroy((command_t *)command);
-        command = next_command;
+    if (descriptor->cluster_count && !descriptor->clusters) {
+        ESP_LOGE(TAG, "Cluster table cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
     }
-
-    /* Parse and delete all attributes */
-    _attribute_t *attribute = current_cluster->attribute_list;
-    while (attribute) {
-        _attribute_t *next_attribute = attribute->next;
-        attribute::destroy((attribute_t *)attribute);
-        attribute = next_attribute;
+    if (descriptor->static_metadata) {
+        set_static_metadata(endpoint, descriptor->static_metadata);
     }
-
-    /* Parse and delete all events */
-    _event_t *event = current_cluster->event_list;
-    while (event) {
-        _event_t *next_event = event->next;
-        event::destroy((event_t *)event);
-        event = next_event;
+    esp_err_t err = add_device_type(endpoint, descriptor->device_type_id, descriptor->device_type_version);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add device type id:%" PRIu32 ",err: %d", descriptor->device_type_id, err);
+        return err;
+    }
+    for (uint16_t index = 0; index < descriptor->cluster_count; index++) {
+        if (!cluster::create(endpoint, &descriptor->clusters[index])) {
+            ESP_LOGE(TAG, "Failed to create cluster 0x%08" PRIX32, descriptor->clusters[index].cluster_id);
+            return ESP_FAIL;
+        }
     }
-
-    /* Free */
-    esp_matter_mem_free(current_cluster);
     return ESP_OK;
 }
 
-cluster_t *get(endpoint_t *endpoint, uint32_t cluster_id)
+esp_err_t set_static_metadata(endpoint_t *endpoint, const EmberAfEndpointType *endpoint_type)
 {
     if (!endpoint) {
         ESP_LOGE(TAG, "Endpoint cannot be NULL");
-        return NULL;
+        return ESP_ERR_INVALID_ARG;
     }
     _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    _cluster_t *current_cluster = (_cluster_t *)current_endpoint->cluster_list;
-    while (current_cluster) {
-        if (current_cluster->cluster_id == cluster_id) {
-            break;
-        }
-        current_cluster = current_cluster->next;
+    if (current_endpoint->endpoint_type || current_endpoint->data_versions_ptr) {
+        ESP_LOGE(TAG, "Static metadata cannot be set on the enabled endpoint %" PRIu16, current_endpoint->endpoint_id);
+        return ESP_ERR_INVALID_STATE;
     }
-    return (cluster_t *)current_cluster;
+    current_endpoint->static_endpoint_type = endpoint_type;
+    return ESP_OK;
 }
 
-cluster_t *get_first(endpoint_t *endpoint)
+void *get_priv_data(uint16_t endpoint_id)
 {
+    node_t *node = node::get();
+    if (!node) {
+        /* This is not an error, since the node will not be initialized for application using the data model from zap */
+        return NULL;
+    }
+    endpoint_t *endpoint = get(node, endpoint_id);
     if (!endpoint) {
-        ESP_LOGE(TAG, "Endpoint cannot be NULL");
+        ESP_LOGE(TAG, "Endpoint not found");
         return NULL;
     }
     _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    return (cluster_t *)current_endpoint->cluster_list;
+    return current_endpoint->priv_data;
 }
 
-cluster_t *get_next(cluster_t *cluster)
+} /* endpoint */
+
+namespace node {
+
+node_t *create_raw()
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
+    if (node) {
+        ESP_LOGE(TAG, "Node already exists");
+        return (node_t *)node;
+    }
+    node = (_node_t *)esp_matter_mem_calloc(1, sizeof(_node_t));
+    if (!node) {
+        ESP_LOGE(TAG, "Couldn't allocate _node_t");
         return NULL;
     }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    return (cluster_t *)current_cluster->next;
+#if CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
+    /* The ids of the fixed endpoints of the zap data model are taken */
+    node->min_unused_endpoint_id = hybrid::get_first_dynamic_endpoint_id();
+#endif
+    return (node_t *)node;
 }
 
-uint32_t get_id(cluster_t *cluster)
+node_t *get()
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
-        return kInvalidClusterId;
-    }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    return current_cluster->cluster_id;
+    return (node_t *)node;
 }
 
-esp_err_t set_plugin_server_init_callback(cluster_t *cluster, plugin_server_init_callback_t callback)
+} /* node */
+
+static void add_memory_stats(memory_stats_t *stats, const memory_stats_t *other)
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
-    }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    current_cluster->plugin_server_init_callback = callback;
-    return ESP_OK;
+    stats->structs += other->structs;
+    stats->value_buffers += other->value_buffers;
+    stats->bounds += other->bounds;
+    stats->default_values += other->default_values;
+    stats->metadata += other->metadata;
 }
 
-plugin_server_init_callback_t get_plugin_server_init_callback(cluster_t *cluster)
+static size_t get_memory_stats_total(const memory_stats_t *stats)
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
+    return stats->structs + stats->value_buffers + stats->bounds + stats->default_values + stats->metadata;
+}
+
+namespace cluster {
+
+/* Find the ember metadata entry built for the cluster by endpoint::enable() */
+static const EmberAfCluster *get_metadata(_cluster_t *current_cluster)
+{
+    node_t *node = node::get();
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint::get(node, current_cluster->endpoint_id);
+    if (!current_endpoint || !current_endpoint->endpoint_type) {
         return NULL;
     }
-    _cluster_t *current_cluster = (_cluster_t *)cluster;
-    return current_cluster->plugin_server_init_callback;
+    EmberAfEndpointType *endpoint_type = current_endpoint->endpoint_type;
+    for (int index = 0; index < endpoint_type->clusterCount; index++) {
+        if (endpoint_type->cluster[index].clusterId == current_cluster->cluster_id) {
+            return &endpoint_type->cluster[index];
+        }
+    }
+    return NULL;
 }
 
-esp_err_t add_function_list(cluster_t *cluster, const function_generic_t *function_list, int function_flags)
+static size_t get_id_list_size(const CommandId *list)
 {
-    if (!cluster) {
-        ESP_LOGE(TAG, "Cluster cannot be NULL");
+    size_t count = 0;
+    while (list && list[count] != kInvalidCommandId) {
+        count++;
+    }
+    /* Including the terminator */
+    return list ? (count + 1) * sizeof(CommandId) : 0;
+}
+
+esp_err_t get_memory_stats(cluster_t *cluster, memory_stats_t *stats)
+{
+    if (!cluster || !stats) {
+        ESP_LOGE(TAG, "Cluster or stats cannot be NULL");
         return ESP_ERR_INVALID_ARG;
     }
     _cluster_t *current_cluster = (_cluster_t *)cluster;
-    current_cluster->function_list = function_list;
-    current_cluster->flags |= function_flags;
+    memset(stats, 0, sizeof(memory_stats_t));
+    stats->structs += sizeof(_cluster_t);
+
+    for (_attribute_t *attribute = current_cluster->attribute_list; attribute; attribute = attribute->next) {
+        stats->structs += sizeof(_attribute_t);
+        bool inline_val = false;
+#if CONFIG_ESP_MATTER_ATTRIBUTE_INLINE_VAL_SIZE > 0
+        inline_val = attribute->val.val.a.b == attribute->inline_val;
+#endif
+        if ((attribute->val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+             attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+             attribute->val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
+             attribute->val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+             attribute->val.type == ESP_MATTER_VAL_TYPE_ARRAY) && attribute->val.val.a.b && !inline_val) {
+            stats->value_buffers += attribute->val_capacity;
+        }
+        /* Same rules as free_default_value() */
+        if (attribute->flags & ATTRIBUTE_FLAG_MIN_MAX) {
+            stats->bounds += sizeof(esp_matter_attr_bounds_t);
+            stats->default_values += get_min_max_block_size(attribute->default_value_size) -
+                sizeof(esp_matter_attr_bounds_t);
+        } else if (attribute->default_value_size > 2) {
+            /* The shared values are divided among the attributes */
+            stats->default_values += (sizeof(attribute::shared_default_value_t) + attribute->default_value_size) /
+                attribute::get_shared_default_value_ref_count(attribute->default_value.ptrToDefaultValue);
+        }
+    }
+    for (_command_t *command = current_cluster->command_list; command; command = command->next) {
+        stats->structs += sizeof(_command_t);
+    }
+    for (_event_t *event = current_cluster->event_list; event; event = event->next) {
+        stats->structs += sizeof(_event_t);
+    }
+
+    const EmberAfCluster *matter_cluster = get_metadata(current_cluster);
+    if (matter_cluster) {
+        stats->metadata += sizeof(DataVersion);
+    }
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+    /* See endpoint::get_memory_stats() */
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint::get(node::get(), current_cluster->endpoint_id);
+    if (current_endpoint && current_endpoint->shared_metadata && current_endpoint->shared_metadata->owner !=
+        current_endpoint) {
+        matter_cluster = NULL;
+    }
+#endif
+    if (matter_cluster) {
+        stats->metadata += sizeof(EmberAfCluster);
+        stats->metadata += matter_cluster->attributeCount * sizeof(EmberAfAttributeMetadata);
+        stats->metadata += get_id_list_size(matter_cluster->acceptedCommandList);
+        stats->metadata += get_id_list_size(matter_cluster->generatedCommandList);
+        if (matter_cluster->eventList) {
+            stats->metadata += (matter_cluster->eventCount + 1) * sizeof(EventId);
+        }
+    }
     return ESP_OK;
 }
 
@@ -1884,313 +5135,702 @@ esp_err_t add_function_list(cluster_t *cluster, const function_generic_t *functi
 
 namespace endpoint {
 
-endpoint_t *create(node_t *node, uint8_t flags, void *priv_data)
+esp_err_t get_memory_stats(endpoint_t *endpoint, memory_stats_t *stats)
 {
-    /* Find */
-    if (!node) {
-        ESP_LOGE(TAG, "Node cannot be NULL");
-        return NULL;
+    if (!endpoint || !stats) {
+        ESP_LOGE(TAG, "Endpoint or stats cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
     }
-    _node_t *current_node = (_node_t *)node;
-
-    if (get_count(node) >= CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT) {
-        ESP_LOGE(TAG, "Dynamic endpoint count cannot be greater than CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT:%u",
-                CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT);
-        return NULL;
+    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
+    memset(stats, 0, sizeof(memory_stats_t));
+    stats->structs += sizeof(_endpoint_t);
+    bool owns_metadata = true;
+#if CONFIG_ESP_MATTER_ENABLE_SHARED_ENDPOINT_METADATA
+    if (current_endpoint->shared_metadata) {
+        /* The shared metadata is counted once, in the stats of its owner */
+        owns_metadata = current_endpoint->shared_metadata->owner == current_endpoint;
+        if (owns_metadata) {
+            stats->metadata += sizeof(_shared_metadata_t);
+        }
     }
-
-    /* Allocate */
-    _endpoint_t *endpoint = (_endpoint_t *)esp_matter_mem_calloc(1, sizeof(_endpoint_t));
-    if (!endpoint) {
-        ESP_LOGE(TAG, "Couldn't allocate _endpoint_t");
-        return NULL;
+#endif
+    if (current_endpoint->endpoint_type && owns_metadata) {
+        stats->metadata += sizeof(EmberAfEndpointType);
     }
+    if (current_endpoint->device_types_ptr) {
+        stats->metadata += current_endpoint->device_type_count * sizeof(EmberAfDeviceType);
+    }
+    if (current_endpoint->static_endpoint_type && current_endpoint->data_versions_ptr) {
+        /* Only the data versions of the static metadata are in RAM */
+        stats->metadata += current_endpoint->static_endpoint_type->clusterCount * sizeof(DataVersion);
+    }
+    for (_cluster_t *cluster = current_endpoint->cluster_list; cluster; cluster = cluster->next) {
+        memory_stats_t cluster_stats;
+        cluster::get_memory_stats((cluster_t *)cluster, &cluster_stats);
+        add_memory_stats(stats, &cluster_stats);
+    }
+    return ESP_OK;
+}
 
-    /* Set */
-    endpoint->endpoint_id = current_node->min_unused_endpoint_id++;
-    endpoint->device_type_count = 0;
-    endpoint->parent_endpoint_id = chip::kInvalidEndpointId;
-    endpoint->flags = flags;
-    endpoint->priv_data = priv_data;
+} /* endpoint */
 
-    /* Store */
-    if (esp_matter_started) {
-        node::store_min_unused_endpoint_id();
-    }
+namespace node {
 
-    /* Add */
-    _endpoint_t *previous_endpoint = NULL;
-    _endpoint_t *current_endpoint = current_node->endpoint_list;
-    while (current_endpoint) {
-        previous_endpoint = current_endpoint;
-        current_endpoint = current_endpoint->next;
+esp_err_t get_memory_stats(node_t *node, memory_stats_t *stats)
+{
+    if (!node || !stats) {
+        ESP_LOGE(TAG, "Node or stats cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
     }
-    if (previous_endpoint == NULL) {
-        current_node->endpoint_list = endpoint;
-    } else {
-        previous_endpoint->next = endpoint;
+    _node_t *current_node = (_node_t *)node;
+    memset(stats, 0, sizeof(memory_stats_t));
+    stats->structs += sizeof(_node_t);
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_TABLE
+    stats->structs += current_node->endpoint_table_size * sizeof(_endpoint_t *);
+#endif
+    for (_endpoint_t *endpoint = current_node->endpoint_list; endpoint; endpoint = endpoint->next) {
+        memory_stats_t endpoint_stats;
+        endpoint::get_memory_stats((endpoint_t *)endpoint, &endpoint_stats);
+        add_memory_stats(stats, &endpoint_stats);
     }
-
-    return (endpoint_t *)endpoint;
+    return ESP_OK;
 }
 
-endpoint_t *resume(node_t *node, uint8_t flags, uint16_t endpoint_id, void *priv_data)
+void print_memory_stats(node_t *node)
 {
-    /* Find */
     if (!node) {
         ESP_LOGE(TAG, "Node cannot be NULL");
-        return NULL;
+        return;
     }
     _node_t *current_node = (_node_t *)node;
-    _endpoint_t *previous_endpoint = NULL;
-    _endpoint_t *current_endpoint = current_node->endpoint_list;
-    while (current_endpoint) {
-        if (current_endpoint->endpoint_id == endpoint_id) {
-            ESP_LOGE(TAG, "Could not resume an endpoint that has been added to the node");
-            return NULL;
+    memory_stats_t stats;
+    printf("%-24s %8s %8s %8s %8s %8s %8s\n", "", "structs", "values", "bounds", "defaults", "metadata", "total");
+    for (_endpoint_t *endpoint = current_node->endpoint_list; endpoint; endpoint = endpoint->next) {
+        endpoint::get_memory_stats((endpoint_t *)endpoint, &stats);
+        printf("Endpoint 0x%04" PRIX16 "            %8u %8u %8u %8u %8u %8u\n", endpoint->endpoint_id,
+               (unsigned)stats.structs, (unsigned)stats.value_buffers, (unsigned)stats.bounds,
+               (unsigned)stats.default_values, (unsigned)stats.metadata, (unsigned)get_memory_stats_total(&stats));
+        for (_cluster_t *cluster = endpoint->cluster_list; cluster; cluster = cluster->next) {
+            cluster::get_memory_stats((cluster_t *)cluster, &stats);
+            printf("  Cluster 0x%08" PRIX32 "      %8u %8u %8u %8u %8u %8u\n", cluster->cluster_id,
+                   (unsigned)stats.structs, (unsigned)stats.value_buffers, (unsigned)stats.bounds,
+                   (unsigned)stats.default_values, (unsigned)stats.metadata, (unsigned)get_memory_stats_total(&stats));
         }
-        previous_endpoint = current_endpoint;
-        current_endpoint = current_endpoint->next;
     }
+    get_memory_stats(node, &stats);
+    printf("Total                    %8u %8u %8u %8u %8u %8u\n", (unsigned)stats.structs,
+           (unsigned)stats.value_buffers, (unsigned)stats.bounds, (unsigned)stats.default_values,
+           (unsigned)stats.metadata, (unsigned)get_memory_stats_total(&stats));
+}
 
-    /* Check */
-    if (endpoint_id >= current_node->min_unused_endpoint_id) {
-        ESP_LOGE(TAG, "The endpoint_id of the resumed endpoint should have been used");
-        return NULL;
+static bool attribute_filter_matches(const attribute_filter_t *filter, const _attribute_t *attribute)
+{
+    if (!filter) {
+        return true;
     }
+    return (filter->endpoint_id == chip::kInvalidEndpointId || filter->endpoint_id == attribute->endpoint_id) &&
+        (filter->cluster_id == chip::kInvalidClusterId || filter->cluster_id == attribute->cluster_id) &&
+        (filter->attribute_id == chip::kInvalidAttributeId || filter->attribute_id == attribute->attribute_id);
+}
 
-     /* Allocate */
-     _endpoint_t *endpoint = (_endpoint_t *)esp_matter_mem_calloc(1, sizeof(_endpoint_t));
-     if (!endpoint) {
-         ESP_LOGE(TAG, "Couldn't allocate _endpoint_t");
-         return NULL;
-     }
+static bool is_buffer_val(const esp_matter_attr_val_t *val)
+{
+    return val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        val->type == ESP_MATTER_VAL_TYPE_ARRAY;
+}
 
-     /* Set */
-     endpoint->endpoint_id = endpoint_id;
-     endpoint->device_type_count = 0;
-     endpoint->flags = flags;
-     endpoint->priv_data = priv_data;
+/* Must be called with the Matter stack lock held */
+static esp_err_t visit_attributes(_node_t *current_node, const attribute_filter_t *filter,
+                                  attribute_visitor_t visitor, void *priv_data)
+{
+    for (_endpoint_t *endpoint = current_node->endpoint_list; endpoint; endpoint = endpoint->next) {
+        if (filter && filter->endpoint_id != chip::kInvalidEndpointId && filter->endpoint_id != endpoint->endpoint_id) {
+            continue;
+        }
+        for (_cluster_t *cluster = endpoint->cluster_list; cluster; cluster = cluster->next) {
+            for (_attribute_t *attribute = cluster->attribute_list; attribute; attribute = attribute->next) {
+                if (!attribute_filter_matches(filter, attribute)) {
+                    continue;
+                }
+                esp_err_t err = visitor(attribute->endpoint_id, attribute->cluster_id, attribute->attribute_id,
+                                        &attribute->val, priv_data);
+                if (err != ESP_OK) {
+                    return err;
+                }
+            }
+        }
+    }
+    return ESP_OK;
+}
 
-     /* Add */
-    if (previous_endpoint == NULL) {
-        current_node->endpoint_list = endpoint;
-    } else {
-        previous_endpoint->next = endpoint;
+esp_err_t for_each_attribute(node_t *node, const attribute_filter_t *filter, attribute_visitor_t visitor,
+                             void *priv_data)
+{
+    if (!node || !visitor) {
+        ESP_LOGE(TAG, "Node or visitor cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = visit_attributes((_node_t *)node, filter, visitor, priv_data);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+typedef struct snapshot_context {
+    attribute_snapshot_entry_t *entries;
+    size_t count;
+    /* Entries are added from the start of the buffer and the values from the end */
+    size_t entries_end;
+    size_t values_start;
+    size_t required_size;
+    bool full;
+} snapshot_context_t;
+
+static esp_err_t snapshot_visitor(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                  const esp_matter_attr_val_t *val, void *priv_data)
+{
+    snapshot_context_t *context = (snapshot_context_t *)priv_data;
+    size_t value_size = is_buffer_val(val) && val->val.a.b ? val->val.a.s : 0;
+    context->required_size += sizeof(attribute_snapshot_entry_t) + value_size;
+    /* Once an entry does not fit, the next ones are only counted, to keep the order of the entries */
+    if (context->full || context->entries_end + sizeof(attribute_snapshot_entry_t) + value_size >
+                         context->values_start) {
+        context->full = true;
+        return ESP_OK;
     }
-
-    return (endpoint_t *)endpoint;
+    attribute_snapshot_entry_t *entry = &context->entries[context->count++];
+    context->entries_end += sizeof(attribute_snapshot_entry_t);
+    entry->endpoint_id = endpoint_id;
+    entry->cluster_id = cluster_id;
+    entry->attribute_id = attribute_id;
+    memcpy((void *)&entry->val, (void *)val, sizeof(esp_matter_attr_val_t));
+    if (value_size > 0) {
+        context->values_start -= value_size;
+        uint8_t *value = (uint8_t *)context->entries + context->values_start;
+        memcpy(value, val->val.a.b, value_size);
+        entry->val.val.a.b = value;
+    }
+    return ESP_OK;
 }
 
-esp_err_t destroy(node_t *node, endpoint_t *endpoint)
+esp_err_t snapshot_attributes(node_t *node, const attribute_filter_t *filter, void *buffer, size_t size,
+                              attribute_snapshot_entry_t **entries, size_t *count, size_t *required_size)
 {
-    if (!node || !endpoint) {
-        ESP_LOGE(TAG, "Node or endpoint cannot be NULL");
+    if (!node || (!buffer && size > 0) || !entries || !count) {
+        ESP_LOGE(TAG, "Node, buffer, entries or count cannot be NULL");
         return ESP_ERR_INVALID_ARG;
     }
-    _node_t *current_node = (_node_t *)node;
-    _endpoint_t *_endpoint = (_endpoint_t *)endpoint;
-
-    if (!(_endpoint->flags & ENDPOINT_FLAG_DESTROYABLE)) {
-        ESP_LOGE(TAG, "This endpoint cannot be deleted since the ENDPOINT_FLAG_DESTROYABLE is not set");
-        return ESP_FAIL;
+    snapshot_context_t context = {
+        .entries = (attribute_snapshot_entry_t *)buffer,
+        .count = 0,
+        .entries_end = 0,
+        .values_start = size,
+        .required_size = 0,
+        .full = false,
+    };
+    /* The copies are the only work done with the lock held */
+    esp_err_t err = for_each_attribute(node, filter, snapshot_visitor, &context);
+    if (err != ESP_OK) {
+        return err;
+    }
+    *entries = context.entries;
+    *count = context.count;
+    if (required_size) {
+        *required_size = context.required_size;
     }
+    return context.full ? ESP_ERR_INVALID_SIZE : ESP_OK;
+}
 
-    /* Find current endpoint and remove from list */
-    _endpoint_t *current_endpoint = current_node->endpoint_list;
-    _endpoint_t *previous_endpoint = NULL;
-    while (current_endpoint) {
-        if (current_endpoint == _endpoint) {
-            break;
-        }
-        previous_endpoint = current_endpoint;
-        current_endpoint = current_endpoint->next;
+esp_err_t for_each_attribute_snapshot(node_t *node, const attribute_filter_t *filter, void *buffer, size_t size,
+                                      attribute_visitor_t visitor, void *priv_data)
+{
+    if (!visitor) {
+        ESP_LOGE(TAG, "Visitor cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
     }
-    if (current_endpoint == NULL) {
-        ESP_LOGE(TAG, "Could not find the endpoint to delete");
-        return ESP_FAIL;
+    attribute_snapshot_entry_t *entries = NULL;
+    size_t count = 0;
+    size_t required_size = 0;
+    esp_err_t err = snapshot_attributes(node, filter, buffer, size, &entries, &count, &required_size);
+    if (err == ESP_ERR_INVALID_SIZE) {
+        ESP_LOGE(TAG, "Snapshot buffer too small: %u bytes, required %u bytes", (unsigned)size,
+                 (unsigned)required_size);
+        return err;
     }
-    if (previous_endpoint == NULL) {
-        current_node->endpoint_list = current_endpoint->next;
-    } else {
-        previous_endpoint->next = current_endpoint->next;
+    if (err != ESP_OK) {
+        return err;
+    }
+    /* The visitor runs without the Matter stack lock */
+    for (size_t index = 0; index < count; index++) {
+        err = visitor(entries[index].endpoint_id, entries[index].cluster_id, entries[index].attribute_id,
+                      &entries[index].val, priv_data);
+        if (err != ESP_OK) {
+            return err;
+        }
     }
+    return ESP_OK;
+}
 
-    /* Disable */
-    disable(endpoint);
+} /* node */
 
-    /* Parse and delete all clusters */
-    _cluster_t *cluster = current_endpoint->cluster_list;
-    while (cluster) {
-        _cluster_t *next_cluster = cluster->next;
-        cluster::destroy((cluster_t *)cluster);
-        cluster = next_cluster;
-    }
+#if CONFIG_ESP_MATTER_ENABLE_NODE_SNAPSHOT
+namespace node {
 
-    /* Free */
-    esp_matter_mem_free(current_endpoint);
-    return ESP_OK;
+constexpr uint32_t k_snapshot_magic = 0x534E4D45; /* "EMNS" */
+constexpr uint16_t k_snapshot_version = 1;
+
+/* The records hold callback addresses, the image is only valid for the firmware which wrote it */
+typedef struct snapshot_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t endpoint_count;
+    uint8_t elf_sha256[32];
+    uint32_t body_size;
+    uint32_t body_crc;
+    uint16_t min_unused_endpoint_id;
+    uint16_t reserved;
+    uint32_t header_crc;
+} snapshot_header_t;
+
+typedef struct snapshot_endpoint {
+    uint16_t endpoint_id;
+    uint16_t flags;
+    uint16_t parent_endpoint_id;
+    uint16_t cluster_count;
+    uint8_t device_type_count;
+    const EmberAfEndpointType *static_endpoint_type;
+} snapshot_endpoint_t;
+
+typedef struct snapshot_device_type {
+    uint32_t device_type_id;
+    uint8_t device_type_version;
+} snapshot_device_type_t;
+
+typedef struct snapshot_cluster {
+    uint32_t cluster_id;
+    uint16_t flags;
+    uint16_t attribute_count;
+    uint16_t command_count;
+    uint16_t event_count;
+    const cluster::function_generic_t *function_list;
+    cluster::plugin_server_init_callback_t plugin_server_init_callback;
+} snapshot_cluster_t;
+
+typedef struct snapshot_attribute {
+    uint32_t attribute_id;
+    uint16_t flags;
+    uint16_t max_val_size;
+    /* Followed by val.val.a.s bytes for the string and array types */
+    esp_matter_attr_val_t val;
+    bool has_bounds;
+    esp_matter_attr_bounds_t bounds;
+    attribute::callback_t override_callback;
+    uint32_t override_cache_ttl_ms;
+} snapshot_attribute_t;
+
+typedef struct snapshot_command {
+    uint32_t command_id;
+    uint16_t flags;
+    command::callback_t callback;
+    command::callback_t user_callback;
+} snapshot_command_t;
+
+typedef struct snapshot_writer {
+    const esp_partition_t *partition;
+    size_t offset;
+    uint32_t crc;
+    esp_err_t err;
+    size_t buffer_len;
+    uint8_t buffer[256];
+} snapshot_writer_t;
+
+static bool is_array_type(esp_matter_val_type_t type)
+{
+    return type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+           type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+           type == ESP_MATTER_VAL_TYPE_ARRAY;
 }
 
-endpoint_t *get(node_t *node, uint16_t endpoint_id)
+static void snapshot_flush(snapshot_writer_t *writer)
 {
-    if (!node) {
-        ESP_LOGE(TAG, "Node cannot be NULL");
-        return NULL;
+    if (writer->err == ESP_OK && writer->buffer_len > 0) {
+        writer->err = esp_partition_write(writer->partition, writer->offset, writer->buffer, writer->buffer_len);
+        writer->offset += writer->buffer_len;
     }
-    _node_t *current_node = (_node_t *)node;
-    _endpoint_t *current_endpoint = (_endpoint_t *)current_node->endpoint_list;
-    while (current_endpoint) {
-        if (current_endpoint->endpoint_id == endpoint_id) {
-            break;
+    writer->buffer_len = 0;
+}
+
+static void snapshot_write(snapshot_writer_t *writer, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    if (writer->err != ESP_OK) {
+        return;
+    }
+    if (writer->offset + writer->buffer_len + size > writer->partition->size) {
+        ESP_LOGE(TAG, "The node snapshot does not fit in the partition");
+        writer->err = ESP_ERR_INVALID_SIZE;
+        return;
+    }
+    writer->crc = esp_rom_crc32_le(writer->crc, bytes, size);
+    while (size > 0 && writer->err == ESP_OK) {
+        size_t space = sizeof(writer->buffer) - writer->buffer_len;
+        size_t chunk = size < space ? size : space;
+        memcpy(writer->buffer + writer->buffer_len, bytes, chunk);
+        writer->buffer_len += chunk;
+        bytes += chunk;
+        size -= chunk;
+        if (writer->buffer_len == sizeof(writer->buffer)) {
+            snapshot_flush(writer);
         }
-        current_endpoint = current_endpoint->next;
     }
-    return (endpoint_t *)current_endpoint;
 }
 
-endpoint_t *get_first(node_t *node)
+static void snapshot_write_cluster(snapshot_writer_t *writer, _cluster_t *cluster)
 {
-    if (!node) {
-        ESP_LOGE(TAG, "Node cannot be NULL");
-        return NULL;
+    snapshot_cluster_t record;
+    memset(&record, 0, sizeof(record));
+    record.cluster_id = cluster->cluster_id;
+    record.flags = cluster->flags;
+    record.function_list = cluster->function_list;
+    record.plugin_server_init_callback = cluster->plugin_server_init_callback;
+    record.attribute_count = cluster->attribute_count;
+    for (_command_t *command = cluster->command_list; command; command = command->next) {
+        record.command_count++;
+    }
+    record.event_count = cluster->event_count;
+    snapshot_write(writer, &record, sizeof(record));
+
+    for (_attribute_t *attribute = cluster->attribute_list; attribute; attribute = attribute->next) {
+        snapshot_attribute_t attribute_record;
+        memset(&attribute_record, 0, sizeof(attribute_record));
+        attribute_record.attribute_id = attribute->attribute_id;
+        attribute_record.flags = attribute->flags;
+        attribute_record.max_val_size = attribute->max_val_size;
+        attribute_record.val = attribute->val;
+        bool has_data = is_array_type(attribute->val.type) && attribute->val.val.a.b;
+        if (is_array_type(attribute->val.type)) {
+            attribute_record.val.val.a.b = NULL;
+            if (!has_data) {
+                attribute_record.val.val.a.s = 0;
+            }
+        }
+        if (attribute->bounds) {
+            attribute_record.has_bounds = true;
+            attribute_record.bounds = *attribute->bounds;
+        }
+        attribute_record.override_callback = attribute->override_callback;
+#if CONFIG_ESP_MATTER_ENABLE_OVERRIDE_READ_CACHE
+        attribute_record.override_cache_ttl_ms = attribute->override_cache_ttl_ms;
+#endif
+        snapshot_write(writer, &attribute_record, sizeof(attribute_record));
+        if (has_data) {
+            snapshot_write(writer, attribute->val.val.a.b, attribute->val.val.a.s);
+        }
+    }
+    for (_command_t *command = cluster->command_list; command; command = command->next) {
+        snapshot_command_t command_record;
+        memset(&command_record, 0, sizeof(command_record));
+        command_record.command_id = command->command_id;
+        command_record.flags = command->flags;
+        command_record.callback = command->callback;
+        command_record.user_callback = command->user_callback;
+        snapshot_write(writer, &command_record, sizeof(command_record));
+    }
+    for (_event_t *event = cluster->event_list; event; event = event->next) {
+        snapshot_write(writer, &event->event_id, sizeof(event->event_id));
     }
-    _node_t *current_node = (_node_t *)node;
-    return (endpoint_t *)current_node->endpoint_list;
 }
 
-endpoint_t *get_next(endpoint_t *endpoint)
+static const esp_partition_t *get_snapshot_partition()
 {
-    if (!endpoint) {
-        ESP_LOGE(TAG, "Endpoint cannot be NULL");
-        return NULL;
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                                CONFIG_ESP_MATTER_NODE_SNAPSHOT_PARTITION_LABEL);
+    if (!partition) {
+        ESP_LOGE(TAG, "Node snapshot partition %s not found", CONFIG_ESP_MATTER_NODE_SNAPSHOT_PARTITION_LABEL);
     }
-    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    return (endpoint_t *)current_endpoint->next;
+    return partition;
 }
 
-uint16_t get_count(node_t *node)
+esp_err_t snapshot_save()
 {
     if (!node) {
         ESP_LOGE(TAG, "Node cannot be NULL");
-        return 0;
+        return ESP_ERR_INVALID_STATE;
     }
-    uint16_t count = 0;
-    endpoint_t *endpoint = get_first(node);
-    while (endpoint) {
-        count++;
-        endpoint = get_next(endpoint);
+    const esp_partition_t *partition = get_snapshot_partition();
+    if (!partition) {
+        return ESP_ERR_NOT_FOUND;
     }
-    return count;
+    esp_err_t err = esp_partition_erase_range(partition, 0, partition->size);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to erase the node snapshot partition");
+        return err;
+    }
+
+    snapshot_writer_t *writer = (snapshot_writer_t *)esp_matter_mem_calloc(1, sizeof(snapshot_writer_t));
+    if (!writer) {
+        ESP_LOGE(TAG, "Couldn't allocate the snapshot writer");
+        return ESP_ERR_NO_MEM;
+    }
+    writer->partition = partition;
+    writer->offset = sizeof(snapshot_header_t);
+
+    snapshot_header_t header;
+    memset(&header, 0, sizeof(header));
+    for (_endpoint_t *endpoint = node->endpoint_list; endpoint; endpoint = endpoint->next) {
+        snapshot_endpoint_t record;
+        memset(&record, 0, sizeof(record));
+        record.endpoint_id = endpoint->endpoint_id;
+        record.flags = endpoint->flags;
+        record.parent_endpoint_id = endpoint->parent_endpoint_id;
+        record.device_type_count = endpoint->device_type_count;
+        record.static_endpoint_type = endpoint->static_endpoint_type;
+        record.cluster_count = endpoint->cluster_count;
+        snapshot_write(writer, &record, sizeof(record));
+        for (uint8_t index = 0; index < endpoint->device_type_count; index++) {
+            snapshot_device_type_t device_type;
+            memset(&device_type, 0, sizeof(device_type));
+            device_type.device_type_id = endpoint->device_type_ids[index];
+            device_type.device_type_version = endpoint->device_type_versions[index];
+            snapshot_write(writer, &device_type, sizeof(device_type));
+        }
+        for (_cluster_t *cluster = endpoint->cluster_list; cluster; cluster = cluster->next) {
+            snapshot_write_cluster(writer, cluster);
+        }
+        header.endpoint_count++;
+    }
+    snapshot_flush(writer);
+    err = writer->err;
+    header.body_size = writer->offset - sizeof(snapshot_header_t);
+    header.body_crc = writer->crc;
+    esp_matter_mem_free(writer);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write the node snapshot: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    /* The header is written last, an interrupted save leaves no valid image */
+    header.magic = k_snapshot_magic;
+    header.version = k_snapshot_version;
+    header.min_unused_endpoint_id = node->min_unused_endpoint_id;
+    memcpy(header.elf_sha256, esp_app_get_description()->app_elf_sha256, sizeof(header.elf_sha256));
+    header.header_crc = esp_rom_crc32_le(0, (const uint8_t *)&header, offsetof(snapshot_header_t, header_crc));
+    err = esp_partition_write(partition, 0, &header, sizeof(header));
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write the node snapshot header");
+        return err;
+    }
+    ESP_LOGI(TAG, "Node snapshot saved, %u endpoints, %u bytes", header.endpoint_count,
+             (unsigned)(sizeof(header) + header.body_size));
+    return ESP_OK;
 }
 
-uint16_t get_id(endpoint_t *endpoint)
+esp_err_t snapshot_erase()
 {
-    if (!endpoint) {
-        ESP_LOGE(TAG, "Endpoint cannot be NULL");
-        return kInvalidEndpointId;
+    const esp_partition_t *partition = get_snapshot_partition();
+    if (!partition) {
+        return ESP_ERR_NOT_FOUND;
     }
-    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    return current_endpoint->endpoint_id;
+    /* Erasing the sector of the header is enough to invalidate the image */
+    return esp_partition_erase_range(partition, 0, partition->erase_size);
 }
 
-esp_err_t add_device_type(endpoint_t *endpoint, uint32_t device_type_id, uint8_t device_type_version)
+typedef struct snapshot_reader {
+    const uint8_t *data;
+    size_t size;
+    size_t offset;
+} snapshot_reader_t;
+
+static bool snapshot_read(snapshot_reader_t *reader, void *data, size_t size)
 {
-    if (!endpoint) {
-        ESP_LOGE(TAG, "Endpoint cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
+    if (reader->size - reader->offset < size) {
+        return false;
     }
-    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    if (current_endpoint->device_type_count >= ESP_MATTER_MAX_DEVICE_TYPE_COUNT) {
-        ESP_LOGE(TAG, "Could not add a new device type to the endpoint");
-        return ESP_FAIL;
-    }
-    current_endpoint->device_type_ids[current_endpoint->device_type_count] = device_type_id;
-    current_endpoint->device_type_versions[current_endpoint->device_type_count] = device_type_version;
-    current_endpoint->device_type_count++;
-    return ESP_OK;
+    memcpy(data, reader->data + reader->offset, size);
+    reader->offset += size;
+    return true;
 }
 
-uint32_t *get_device_type_ids(endpoint_t *endpoint, uint8_t *device_type_count_ptr)
+static esp_err_t snapshot_restore_cluster(snapshot_reader_t *reader, _endpoint_t *endpoint)
 {
-    if (!endpoint) {
-        ESP_LOGE(TAG, "Endpoint cannot be NULL");
-        return NULL;
+    snapshot_cluster_t record;
+    if (!snapshot_read(reader, &record, sizeof(record))) {
+        return ESP_ERR_INVALID_SIZE;
     }
-    if (!device_type_count_ptr) {
-        ESP_LOGE(TAG, "device type count pointer cannot be NULL");
-        return NULL;
+    _cluster_t *cluster = (_cluster_t *)cluster::create((endpoint_t *)endpoint, record.cluster_id,
+                                                        (uint8_t)record.flags);
+    if (!cluster) {
+        return ESP_FAIL;
     }
-    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    *device_type_count_ptr = current_endpoint->device_type_count;
-    return current_endpoint->device_type_ids;
-}
+    cluster->flags = record.flags;
+    cluster->function_list = record.function_list;
+    cluster->plugin_server_init_callback = record.plugin_server_init_callback;
 
-uint8_t *get_device_type_versions(endpoint_t *endpoint, uint8_t *device_type_count_ptr)
-{
-    if (!endpoint) {
-        ESP_LOGE(TAG, "Endpoint cannot be NULL");
-        return NULL;
+    /* Append in the saved order, without the per-element duplicate lookup of the create APIs */
+    _attribute_t *previous_attribute = NULL;
+    for (uint16_t index = 0; index < record.attribute_count; index++) {
+        snapshot_attribute_t attribute_record;
+        if (!snapshot_read(reader, &attribute_record, sizeof(attribute_record))) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        esp_matter_attr_val_t val = attribute_record.val;
+        if (is_array_type(val.type) && val.val.a.s > 0) {
+            /* create_after() copies the value, point straight into the mapped image */
+            if (reader->size - reader->offset < val.val.a.s) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            val.val.a.b = (uint8_t *)(reader->data + reader->offset);
+            reader->offset += val.val.a.s;
+        }
+        previous_attribute = attribute::create_after(cluster, previous_attribute, attribute_record.attribute_id,
+                                                     attribute_record.flags, val, attribute_record.max_val_size);
+        if (!previous_attribute) {
+            return ESP_ERR_NO_MEM;
+        }
+        if (attribute_record.has_bounds) {
+            attribute::add_bounds((attribute_t *)previous_attribute, attribute_record.bounds.min,
+                                  attribute_record.bounds.max);
+        }
+        if (attribute_record.override_callback) {
+            attribute::set_override_callback((attribute_t *)previous_attribute, attribute_record.override_callback,
+                                             attribute_record.override_cache_ttl_ms);
+        }
     }
-    if (!device_type_count_ptr) {
-        ESP_LOGE(TAG, "device type count pointer cannot be NULL");
-        return NULL;
+    _command_t *previous_command = NULL;
+    for (uint16_t index = 0; index < record.command_count; index++) {
+        snapshot_command_t command_record;
+        if (!snapshot_read(reader, &command_record, sizeof(command_record))) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        previous_command = command::create_after(cluster, previous_command, command_record.command_id,
+                                                 command_record.flags, command_record.callback);
+        if (!previous_command) {
+            return ESP_ERR_NO_MEM;
+        }
+        previous_command->user_callback = command_record.user_callback;
     }
-    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    *device_type_count_ptr = current_endpoint->device_type_count;
-    return current_endpoint->device_type_versions;
+    _event_t *previous_event = NULL;
+    for (uint16_t index = 0; index < record.event_count; index++) {
+        uint32_t event_id;
+        if (!snapshot_read(reader, &event_id, sizeof(event_id))) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        previous_event = event::create_after(cluster, previous_event, event_id);
+        if (!previous_event) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    return ESP_OK;
 }
 
-esp_err_t set_parent_endpoint(endpoint_t *endpoint, endpoint_t *parent_endpoint)
+static esp_err_t snapshot_restore_body(const snapshot_header_t *header, snapshot_reader_t *reader,
+                                       snapshot_priv_data_callback_t priv_data_callback)
 {
-    if (!endpoint || !parent_endpoint) {
-        ESP_LOGE(TAG, "Endpoint or parent_endpoint cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
+    for (uint16_t endpoint_index = 0; endpoint_index < header->endpoint_count; endpoint_index++) {
+        snapshot_endpoint_t record;
+        if (!snapshot_read(reader, &record, sizeof(record)) || record.device_type_count > ESP_MATTER_MAX_DEVICE_TYPE_COUNT) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        void *priv_data = priv_data_callback ? priv_data_callback(record.endpoint_id) : NULL;
+        _endpoint_t *endpoint = (_endpoint_t *)endpoint::resume((node_t *)node, (uint8_t)record.flags,
+                                                                record.endpoint_id, priv_data);
+        if (!endpoint) {
+            return ESP_FAIL;
+        }
+        endpoint->flags = record.flags;
+        endpoint->parent_endpoint_id = record.parent_endpoint_id;
+        endpoint->static_endpoint_type = record.static_endpoint_type;
+        for (uint8_t index = 0; index < record.device_type_count; index++) {
+            snapshot_device_type_t device_type;
+            if (!snapshot_read(reader, &device_type, sizeof(device_type))) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            endpoint->device_type_ids[index] = device_type.device_type_id;
+            endpoint->device_type_versions[index] = device_type.device_type_version;
+        }
+        endpoint->device_type_count = record.device_type_count;
+        for (uint16_t index = 0; index < record.cluster_count; index++) {
+            esp_err_t err = snapshot_restore_cluster(reader, endpoint);
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
     }
-    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    _endpoint_t *current_parent_endpoint = (_endpoint_t *)parent_endpoint;
-    current_endpoint->parent_endpoint_id = current_parent_endpoint->endpoint_id;
     return ESP_OK;
 }
 
-void *get_priv_data(uint16_t endpoint_id)
+node_t *snapshot_restore(snapshot_priv_data_callback_t priv_data_callback)
 {
-    node_t *node = node::get();
-    if (!node) {
-        /* This is not an error, since the node will not be initialized for application using the data model from zap */
+    if (node) {
+        ESP_LOGE(TAG, "Node already exists");
         return NULL;
     }
-    endpoint_t *endpoint = get(node, endpoint_id);
-    if (!endpoint) {
-        ESP_LOGE(TAG, "Endpoint not found");
+    const esp_partition_t *partition = get_snapshot_partition();
+    if (!partition) {
+        return NULL;
+    }
+    const void *image = NULL;
+    esp_partition_mmap_handle_t mmap_handle;
+    esp_err_t err = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &image, &mmap_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to map the node snapshot partition");
         return NULL;
     }
-    _endpoint_t *current_endpoint = (_endpoint_t *)endpoint;
-    return current_endpoint->priv_data;
-}
-
-} /* endpoint */
-
-namespace node {
 
-node_t *create_raw()
-{
-    if (node) {
-        ESP_LOGE(TAG, "Node already exists");
-        return (node_t *)node;
+    snapshot_header_t header;
+    memcpy(&header, image, sizeof(header));
+    const uint8_t *body = (const uint8_t *)image + sizeof(header);
+    if (header.magic != k_snapshot_magic || header.version != k_snapshot_version ||
+        header.header_crc != esp_rom_crc32_le(0, (const uint8_t *)&header, offsetof(snapshot_header_t, header_crc)) ||
+        header.body_size > partition->size - sizeof(header)) {
+        ESP_LOGI(TAG, "No valid node snapshot");
+        esp_partition_munmap(mmap_handle);
+        return NULL;
     }
-    node = (_node_t *)esp_matter_mem_calloc(1, sizeof(_node_t));
-    if (!node) {
-        ESP_LOGE(TAG, "Couldn't allocate _node_t");
+    if (memcmp(header.elf_sha256, esp_app_get_description()->app_elf_sha256, sizeof(header.elf_sha256)) != 0) {
+        ESP_LOGI(TAG, "The node snapshot was saved by another firmware");
+        esp_partition_munmap(mmap_handle);
+        return NULL;
+    }
+    if (header.body_crc != esp_rom_crc32_le(0, body, header.body_size)) {
+        ESP_LOGE(TAG, "Node snapshot CRC mismatch");
+        esp_partition_munmap(mmap_handle);
         return NULL;
     }
-    return (node_t *)node;
-}
 
-node_t *get()
-{
+    if (!create_raw()) {
+        esp_partition_munmap(mmap_handle);
+        return NULL;
+    }
+    node->min_unused_endpoint_id = header.min_unused_endpoint_id;
+    snapshot_reader_t reader = {body, header.body_size, 0};
+    err = snapshot_restore_body(&header, &reader, priv_data_callback);
+    esp_partition_munmap(mmap_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to restore the node snapshot: %s", esp_err_to_name(err));
+        /* Drop the partially restored node, the application builds it from scratch */
+        while (node->endpoint_list) {
+            node->endpoint_list->flags |= ENDPOINT_FLAG_DESTROYABLE;
+            endpoint::destroy((node_t *)node, (endpoint_t *)node->endpoint_list);
+        }
+#if CONFIG_ESP_MATTER_ENABLE_ENDPOINT_TABLE
+        endpoint::release_table(node);
+#endif
+        esp_matter_mem_free(node);
+        node = NULL;
+        return NULL;
+    }
+    ESP_LOGI(TAG, "Node restored from snapshot, %u endpoints", header.endpoint_count);
     return (node_t *)node;
 }
 
 } /* node */
+#endif // CONFIG_ESP_MATTER_ENABLE_NODE_SNAPSHOT
 } /* esp_matter */
@@ -20,6 +20,11 @@
 #include <app/util/af-types.h>
 #include <esp_err.h>
 #include <esp_matter_attribute_utils.h>
+#include <string.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_POWER_FAIL_FLUSH
+#include <driver/gpio.h>
+#endif
 
 using chip::app::ConcreteCommandPath;
 using chip::DeviceLayer::ChipDeviceEvent;
@@ -50,9 +55,27 @@ typedef handle_t event_t;
 /** TODO: Change this */
 typedef void (*event_callback_t)(const ChipDeviceEvent *event, intptr_t arg);
 
+/** ESP Matter Start Network
+ *
+ * Optional first phase of start(). Initializes the Matter stack and starts the Wi-Fi or Thread bring-up, which does
+ * not need the data model, so that the network connects while the application creates the node. Call it after
+ * nvs_flash_init(), set_custom_*_provider() and, for Thread, set_openthread_platform_config(), then create the node
+ * and call start(), which initializes the server.
+ *
+ * @note The event callback passed here is registered, the one passed to start() afterwards is ignored.
+ *
+ * @param[in] callback event callback.
+ * @param[in] callback_arg private data to pass to callback function, optional argument, by default set to NULL.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE if the network bring-up has already started.
+ * @return error in case of failure.
+ */
+esp_err_t start_network(event_callback_t callback, intptr_t callback_arg = static_cast<intptr_t>(NULL));
+
 /** ESP Matter Start
  *
- * Initialize and start the matter thread.
+ * Initialize and start the matter thread. Runs start_network() first if the application has not called it.
  *
  * @param[in] callback event callback.
  * @param[in] callback_arg private data to pass to callback function, optional argument, by default set to NULL.
@@ -64,13 +87,101 @@ esp_err_t start(event_callback_t callback, intptr_t callback_arg = static_cast<i
 
 /** Factory reset
  *
- * Perform factory reset and erase the data stored in the non volatile storage. This also restarts the device.
+ * Perform factory reset and erase the data stored in the non volatile storage. This also restarts the device. With
+ * CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET, the storage is erased in the background and this returns at once.
  *
  * @return ESP_OK on success.
  * @return error in case of failure.
  */
 esp_err_t factory_reset();
 
+#if CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+namespace async_reset {
+
+/** Progress callback of the factory reset, called from the task of the factory reset. */
+typedef void (*progress_callback_t)(uint8_t percent, void *priv_data);
+
+/** Callback dropping the state kept in RAM of a storage, so that it is not written back during the erase. */
+typedef void (*cleanup_callback_t)();
+
+/** Register a storage erased by the factory reset
+ *
+ * An NVS partition which is not the default one is erased whole, a namespace of the default partition is erased
+ * otherwise. The attribute values of the esp_matter data model are always erased.
+ *
+ * @param[in] partition_label Label of the NVS partition.
+ * @param[in] namespace_name Namespace of the storage.
+ * @param[in] cleanup Callback called when the factory reset starts, optional argument.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t register_storage(const char *partition_label, const char *namespace_name, cleanup_callback_t cleanup);
+
+/** Set the progress callback of the factory reset
+ *
+ * @param[in] callback Progress callback, NULL to remove it.
+ * @param[in] priv_data Private data passed to the callback.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_progress_callback(progress_callback_t callback, void *priv_data);
+
+/** Check if a factory reset is running
+ *
+ * @return true if the storage is being erased, the device restarts at the end.
+ */
+bool is_running();
+
+/** Get the progress of the factory reset
+ *
+ * @return Progress, in percent.
+ */
+uint8_t get_progress();
+
+} /* async_reset */
+#endif /* CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET */
+
+#if CONFIG_ESP_MATTER_ENABLE_STARTUP_PROFILE
+namespace startup_profile {
+
+/** Startup phase */
+typedef struct phase {
+    /** Phase name */
+    const char *name;
+    /** Endpoint ID for per endpoint phases, 0xFFFF'FFFF otherwise */
+    uint32_t id;
+    /** Number of occurrences, more than 1 for the aggregated phases like the NVS reads */
+    uint32_t count;
+    /** Time of the (first) occurrence since boot, in microseconds */
+    int64_t start_us;
+    /** Duration (of all the occurrences) in microseconds, -1 if the phase did not end */
+    int64_t duration_us;
+} phase_t;
+
+/** Get startup phases
+ *
+ * Get the phases recorded from `esp_matter::start()` until the Matter server is initialized and all the endpoints
+ * are enabled.
+ *
+ * @param[out] phases Pointer to the phase table.
+ * @param[out] count Number of phases in the table.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE if the startup is not complete yet.
+ */
+esp_err_t get_phases(const phase_t **phases, size_t *count);
+
+/** Print the startup report
+ *
+ * The report is also printed once when the startup completes.
+ */
+void print_report();
+
+} /* startup_profile */
+#endif // CONFIG_ESP_MATTER_ENABLE_STARTUP_PROFILE
+
 namespace lock {
 
 /** Lock status */
@@ -106,6 +217,49 @@ status_t chip_stack_lock(uint32_t ticks_to_wait);
  */
 esp_err_t chip_stack_unlock();
 
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+/** Number of buckets of the wait and hold time histograms: <10us, <100us, <1ms, <10ms, <100ms, <1s and the rest */
+#define LOCK_STATS_BUCKET_COUNT 7
+/** Maximum number of callers tracked */
+#define LOCK_STATS_MAX_CALLERS 16
+
+/** Lock statistics of a caller */
+typedef struct caller_stats {
+    /** Return address of the `chip_stack_lock()` call */
+    void *caller;
+    /** Number of times the lock has been taken */
+    uint32_t count;
+    /** Wait time histogram */
+    uint32_t wait_histogram[LOCK_STATS_BUCKET_COUNT];
+    /** Hold time histogram */
+    uint32_t hold_histogram[LOCK_STATS_BUCKET_COUNT];
+    /** Longest wait in microseconds */
+    uint32_t max_wait_us;
+    /** Longest hold in microseconds */
+    uint32_t max_hold_us;
+    /** Task holding the lock during the longest wait, "(stack)" if it was taken by the Matter stack itself */
+    char max_wait_holder[16];
+} caller_stats_t;
+
+/** Get lock statistics
+ *
+ * Copy the statistics of the callers of `chip_stack_lock()` recorded since boot or the last `reset_stats()`.
+ *
+ * @param[out] stats Array to copy the statistics to.
+ * @param[inout] count Size of the array as input, number of entries copied as output.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_stats(caller_stats_t *stats, size_t *count);
+
+/** Reset lock statistics */
+void reset_stats();
+
+/** Print lock statistics */
+void print_stats();
+#endif // CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+
 } /* lock */
 
 namespace node {
@@ -124,6 +278,54 @@ node_t *create_raw();
  */
 node_t *get();
 
+#if CONFIG_ESP_MATTER_ENABLE_NODE_SNAPSHOT
+/** Private data callback for the restored endpoints
+ *
+ * @param[in] endpoint_id Endpoint ID.
+ *
+ * @return Private data to associate with the endpoint, can be NULL.
+ */
+typedef void *(*snapshot_priv_data_callback_t)(uint16_t endpoint_id);
+
+/** Save node snapshot
+ *
+ * Serialize the node, with all its endpoints, clusters, attributes, commands and events, into a versioned binary
+ * image on the CONFIG_ESP_MATTER_NODE_SNAPSHOT_PARTITION_LABEL partition. This should be called once the data model
+ * has been built, before `esp_matter::start()`, so that the saved values are the default values.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t snapshot_save();
+
+/** Restore node from snapshot
+ *
+ * Create the node from the image saved by `snapshot_save()`, instead of building the data model again. The image is
+ * memory-mapped and each element is created straight from it. The non-volatile attribute values are still read from
+ * NVS. The image is only used if it was saved by the same firmware, as it holds the addresses of the callbacks.
+ *
+ * @note: The attribute and identification callbacks must be set with `attribute::set_callback()` and
+ * `identification::set_callback()`. Setup outside the data model done by the cluster create APIs, like the binding
+ * manager initialization, must be done again by the application.
+ *
+ * @param[in] priv_data_callback (Optional) Callback returning the private data of each restored endpoint.
+ *
+ * @return Node handle on success.
+ * @return NULL if there is no valid snapshot or in case of failure. The application should then build the node and
+ * call `snapshot_save()`.
+ */
+node_t *snapshot_restore(snapshot_priv_data_callback_t priv_data_callback);
+
+/** Erase node snapshot
+ *
+ * Invalidate the saved image, for example when the composition of the node changes.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t snapshot_erase();
+#endif
+
 } /* node */
 
 namespace endpoint {
@@ -276,6 +478,19 @@ uint8_t *get_device_type_versions(endpoint_t *endpoint, uint8_t *device_type_cou
  */
 esp_err_t set_parent_endpoint(endpoint_t *endpoint, endpoint_t *parent_endpoint);
 
+/** Set parent endpoint id
+ *
+ * Set the parent endpoint from its id, for a parent which is not an endpoint of the node, such as a fixed endpoint of
+ * the zap data model with CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL.
+ *
+ * @param[in] endpoint Endpoint handle.
+ * @param[in] parent_endpoint_id Parent endpoint id.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_parent_endpoint_id(endpoint_t *endpoint, uint16_t parent_endpoint_id);
+
 /** Get private data
  *
  * Get the private data passed while creating the endpoint.
@@ -301,6 +516,51 @@ void *get_priv_data(uint16_t endpoint_id);
  */
 esp_err_t enable(endpoint_t *endpoint);
 
+/** Enable cluster
+ *
+ * Enable a cluster which has been created, or changed, on an endpoint that is already enabled. Only the metadata of
+ * this cluster is built again, the metadata and the data versions of the other clusters on the endpoint are kept.
+ * If the endpoint is not enabled yet, this is the same as `enable()`.
+ *
+ * @note: This is not supported for endpoints using static metadata.
+ *
+ * @param[in] endpoint Endpoint handle.
+ * @param[in] cluster Cluster handle of a cluster on the endpoint.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t enable_cluster(endpoint_t *endpoint, cluster_t *cluster);
+
+/** Deferred enable status
+ *
+ * With `CONFIG_ESP_MATTER_ENABLE_DEFERRED_BRIDGED_ENDPOINT_ENABLE`, the bridged endpoints which exist when the Matter
+ * server starts are enabled in batches on the Matter task, after the other endpoints. This can be used to check
+ * whether all of them have been enabled.
+ *
+ * @return true if there is no bridged endpoint left to enable.
+ * @return false otherwise.
+ */
+bool is_deferred_enable_complete();
+
+/** Set static metadata
+ *
+ * Use constant ember metadata for an endpoint whose composition is fixed at compile time. `enable()` then registers
+ * these tables with the stack instead of building the metadata in RAM. The tables can be built with the helpers in
+ * `esp_matter_static_metadata.h` and must match the clusters, attributes, commands and events of the endpoint, in the
+ * same order. `enable()` fails with ESP_ERR_INVALID_STATE if they do not.
+ *
+ * @note: This must be called before the endpoint is enabled. The tables must stay valid until the endpoint is
+ * destroyed.
+ *
+ * @param[in] endpoint Endpoint handle.
+ * @param[in] endpoint_type Ember endpoint type, NULL to build the metadata at runtime again.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_static_metadata(endpoint_t *endpoint, const EmberAfEndpointType *endpoint_type);
+
 } /* endpoint */
 
 namespace cluster {
@@ -486,7 +746,8 @@ uint32_t get_id(attribute_t *attribute);
 
 /** Set attribute val
  *
- * Set/Update the value of the attribute in the database.
+ * Set/Update the value of the attribute in the database. If the value is equal to the current one, nothing is
+ * changed and the value is not stored in NVS again.
  *
  * @note: Once `esp_matter::start()` is done, `attribute::update()` should be used to update the attribute value.
  *
@@ -498,6 +759,15 @@ uint32_t get_id(attribute_t *attribute);
  */
 esp_err_t set_val(attribute_t *attribute, esp_matter_attr_val_t *val);
 
+/** Get suppressed write count
+ *
+ * Writes of a value equal to the current one are not persisted or reported again. This returns the number of such
+ * writes since boot.
+ *
+ * @return Number of suppressed writes.
+ */
+uint32_t get_suppressed_write_count();
+
 /** Get attribute val
  *
  * Get the value of the attribute from the database.
@@ -510,6 +780,178 @@ esp_err_t set_val(attribute_t *attribute, esp_matter_attr_val_t *val);
  */
 esp_err_t get_val(attribute_t *attribute, esp_matter_attr_val_t *val);
 
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+/** Get attribute val without lock
+ *
+ * Get a consistent copy of the value of the attribute from any task, without the Matter stack lock. The copy is
+ * retried when the Matter task writes the value meanwhile, so the reader never blocks and never delays the writer.
+ * String and array values are copied to the buffer of the caller.
+ *
+ * @note: The writes free the replaced string and array buffers right away. A reader racing with such a write can
+ * copy from the freed buffer, the copy is then discarded and retried. This relies on the freed heap memory staying
+ * mapped, which is the case for the internal RAM and the SPIRAM heaps.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[inout] val Pointer to `esp_matter_attr_val_t`. For string and array attributes, `val.a.b` and `val.a.s` are
+ *                   the buffer and its size as input, `val.a.b` is NULL as output if the value is empty.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_SIZE if the buffer is too small, `val.a.s` is set to the size needed.
+ * @return ESP_ERR_TIMEOUT if the value kept changing during the copies, or a write was preempted by the caller
+ *         running on the same core. Try again later.
+ * @return error in case of failure.
+ */
+esp_err_t get_val_lock_free(attribute_t *attribute, esp_matter_attr_val_t *val);
+
+/** Begin attribute val write
+ *
+ * Used by `set()` around the write of the value storage, this should not be called by the application.
+ *
+ * @param[in] attribute Attribute handle.
+ */
+void val_write_begin(attribute_t *attribute);
+
+/** End attribute val write
+ *
+ * Used by `set()` after the write of the value storage, this should not be called by the application.
+ *
+ * @param[in] attribute Attribute handle.
+ */
+void val_write_end(attribute_t *attribute);
+#endif // CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+
+/** Value type traits
+ *
+ * Compile time mapping of the C++ types to the `esp_matter_val_type_t` storage used by `get()` and `set()`. A type
+ * matches the attribute types which are stored in the same member of `esp_matter_val_t`, including the nullable
+ * variants. `ESP_MATTER_VAL_TYPE_INTEGER` and the string/array types are not supported.
+ */
+template <typename T>
+struct val_type_traits {
+    static constexpr bool supported = false;
+};
+
+#define ESP_MATTER_VAL_TYPE_TRAITS(cpp_type, member, ...)                                                             \
+    template <>                                                                                                       \
+    struct val_type_traits<cpp_type> {                                                                                \
+        static constexpr bool supported = true;                                                                       \
+        static constexpr cpp_type esp_matter_val_t::*value = &esp_matter_val_t::member;                              \
+        static constexpr bool accepts(esp_matter_val_type_t type)                                                     \
+        {                                                                                                             \
+            const esp_matter_val_type_t types[] = {__VA_ARGS__};                                                      \
+            esp_matter_val_type_t base_type = (esp_matter_val_type_t)(type & ~ESP_MATTER_VAL_NULLABLE_BASE);          \
+            for (esp_matter_val_type_t accepted_type : types) {                                                       \
+                if (base_type == accepted_type) {                                                                     \
+                    return true;                                                                                      \
+                }                                                                                                     \
+            }                                                                                                         \
+            return false;                                                                                             \
+        }                                                                                                             \
+    };
+
+ESP_MATTER_VAL_TYPE_TRAITS(bool, b, ESP_MATTER_VAL_TYPE_BOOLEAN)
+ESP_MATTER_VAL_TYPE_TRAITS(float, f, ESP_MATTER_VAL_TYPE_FLOAT)
+ESP_MATTER_VAL_TYPE_TRAITS(int8_t, i8, ESP_MATTER_VAL_TYPE_INT8)
+ESP_MATTER_VAL_TYPE_TRAITS(uint8_t, u8, ESP_MATTER_VAL_TYPE_UINT8, ESP_MATTER_VAL_TYPE_ENUM8,
+                           ESP_MATTER_VAL_TYPE_BITMAP8)
+ESP_MATTER_VAL_TYPE_TRAITS(int16_t, i16, ESP_MATTER_VAL_TYPE_INT16)
+ESP_MATTER_VAL_TYPE_TRAITS(uint16_t, u16, ESP_MATTER_VAL_TYPE_UINT16, ESP_MATTER_VAL_TYPE_ENUM16,
+                           ESP_MATTER_VAL_TYPE_BITMAP16)
+ESP_MATTER_VAL_TYPE_TRAITS(int32_t, i32, ESP_MATTER_VAL_TYPE_INT32)
+ESP_MATTER_VAL_TYPE_TRAITS(uint32_t, u32, ESP_MATTER_VAL_TYPE_UINT32, ESP_MATTER_VAL_TYPE_BITMAP32)
+ESP_MATTER_VAL_TYPE_TRAITS(int64_t, i64, ESP_MATTER_VAL_TYPE_INT64)
+ESP_MATTER_VAL_TYPE_TRAITS(uint64_t, u64, ESP_MATTER_VAL_TYPE_UINT64)
+
+#undef ESP_MATTER_VAL_TYPE_TRAITS
+
+/** Get attribute value storage
+ *
+ * Used by `get()` and `set()`, this should not be called by the application.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[out] type Type of the attribute value.
+ *
+ * @return Pointer to the attribute value on success.
+ * @return NULL in case of failure.
+ */
+esp_matter_val_t *get_val_storage(attribute_t *attribute, esp_matter_val_type_t *type);
+
+/** Commit attribute value
+ *
+ * Used by `set()` after writing the value storage, this should not be called by the application. The value is
+ * stored in NVS if the attribute is non-volatile.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] changed Whether the value has been changed.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t commit_val(attribute_t *attribute, bool changed);
+
+/** Get typed attribute val
+ *
+ * Get the value of a scalar attribute without going through `esp_matter_attr_val_t`. The C++ type is mapped to the
+ * value type at compile time, only the type of the attribute is checked at runtime.
+ *
+ * @note: For nullable attributes, the null value is read as is, `nullable<T>` can be used to check it.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[out] value Attribute value.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the attribute is NULL or if its type does not match T.
+ */
+template <typename T>
+esp_err_t get(attribute_t *attribute, T *value)
+{
+    static_assert(val_type_traits<T>::supported, "Unsupported attribute value type");
+    esp_matter_val_type_t type = ESP_MATTER_VAL_TYPE_INVALID;
+    esp_matter_val_t *storage = get_val_storage(attribute, &type);
+    if (!storage || !value || !val_type_traits<T>::accepts(type)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *value = storage->*val_type_traits<T>::value;
+    return ESP_OK;
+}
+
+/** Set typed attribute val
+ *
+ * Same as `set_val()` for a scalar attribute, without going through `esp_matter_attr_val_t`. The value is written
+ * directly in the database. If the value is equal to the current one, nothing is changed.
+ *
+ * @note: Once `esp_matter::start()` is done, `attribute::update()` should be used to update the attribute value.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] value Attribute value.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the attribute is NULL or if its type does not match T.
+ */
+template <typename T>
+esp_err_t set(attribute_t *attribute, T value)
+{
+    static_assert(val_type_traits<T>::supported, "Unsupported attribute value type");
+    esp_matter_val_type_t type = ESP_MATTER_VAL_TYPE_INVALID;
+    esp_matter_val_t *storage = get_val_storage(attribute, &type);
+    if (!storage || !val_type_traits<T>::accepts(type)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    T &current = storage->*val_type_traits<T>::value;
+    /* Compare the bytes, to be consistent with set_val() for NaN floats */
+    bool changed = memcmp(&current, &value, sizeof(T)) != 0;
+    if (changed) {
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+        val_write_begin(attribute);
+#endif
+        current = value;
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_FREE_READ
+        val_write_end(attribute);
+#endif
+    }
+    return commit_val(attribute, changed);
+}
+
 /** Get attribute val raw
  *
  * Get the value of the attribute in the database, without the attribute handle.
@@ -569,13 +1011,18 @@ uint16_t get_flags(attribute_t *attribute);
  * in that component respectively. It can also be used if the attribute value needs to be dynamically fetched and is
  * difficult to maintain in the database.
  *
+ * With `CONFIG_ESP_MATTER_ENABLE_OVERRIDE_READ_CACHE`, a non-zero `cache_ttl_ms` keeps the value read through the
+ * callback in the database for that long, and the reads within this window are served without calling the callback.
+ * A write through the callback invalidates the cached value.
+ *
  * @param[in] attribute Attribute handle.
  * @param[in] callback Override callback.
+ * @param[in] cache_ttl_ms (Optional) Time to live of the read cache in milliseconds, 0 to disable the cache.
  *
  * @return ESP_OK on success.
  * @return error in case of failure.
  */
-esp_err_t set_override_callback(attribute_t *attribute, callback_t callback);
+esp_err_t set_override_callback(attribute_t *attribute, callback_t callback, uint32_t cache_ttl_ms = 0);
 
 /** Get attribute override
  *
@@ -587,11 +1034,89 @@ esp_err_t set_override_callback(attribute_t *attribute, callback_t callback);
  */
 callback_t get_override_callback(attribute_t *attribute);
 
+/** Get cached override value
+ *
+ * Used by the attribute read path, this should not be called by the application. Counts a cache hit or miss.
+ *
+ * @param[in] attribute Attribute handle.
+ *
+ * @return Cached value if it is still valid.
+ * @return NULL if the cache is disabled for the attribute or the value has expired.
+ */
+const esp_matter_attr_val_t *get_override_cache(attribute_t *attribute);
+
+/** Set cached override value
+ *
+ * Used by the attribute read path, this should not be called by the application. Stores the value returned by the
+ * override callback if the cache is enabled for the attribute.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] val Value read through the override callback.
+ */
+void set_override_cache(attribute_t *attribute, const esp_matter_attr_val_t *val);
+
+/** Invalidate cached override value
+ *
+ * The next read calls the override callback again. This can be used by the application when the value it maintains
+ * changes before the cache expires.
+ *
+ * @param[in] attribute Attribute handle.
+ */
+void invalidate_override_cache(attribute_t *attribute);
+
+/** Get override cache statistics
+ *
+ * @param[out] hits Number of reads served from the cache since boot.
+ * @param[out] misses Number of reads of cached attributes which called the override callback since boot.
+ */
+void get_override_cache_stats(uint32_t *hits, uint32_t *misses);
+
+#if CONFIG_ESP_MATTER_ENABLE_ENCODE_CACHE
+/** Get encode cache statistics
+ *
+ * @param[out] hits Number of external attribute reads served from the values encoded in the same reporting cycle
+ *                  since boot.
+ * @param[out] misses Number of external attribute reads which converted the value since boot.
+ */
+void get_encode_cache_stats(uint32_t *hits, uint32_t *misses);
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_REPORTING_POLICY
+/** Attribute reporting policy */
+typedef struct reporting_policy {
+    /** Minimum absolute change from the last reported value, 0 to disable */
+    double absolute_threshold;
+    /** Minimum change from the last reported value, in percent of it, 0 to disable */
+    double percent_threshold;
+    /** Minimum interval between two reports in milliseconds, 0 to disable. A significant change within the interval
+     * is reported when it ends. */
+    uint32_t min_interval_ms;
+    /** The reported values are rounded to a multiple of this step before they are stored, 0 to disable */
+    double quantization_step;
+} reporting_policy_t;
+
+/** Set attribute reporting policy
+ *
+ * Filter the values reported with `attribute::report()` before the attribute path is marked dirty. The values are
+ * always stored, but a report is only generated if the change from the last reported value is above one of the
+ * thresholds and the minimum interval since the last report has elapsed. The thresholds and the quantization only
+ * apply to numeric types, and the changes to or from null are always reported.
+ *
+ * @param[in] attribute Attribute handle.
+ * @param[in] policy Reporting policy, NULL to remove it.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_reporting_policy(attribute_t *attribute, const reporting_policy_t *policy);
+#endif
+
 /** Set attribute deferred persistence
  *
  * Only non-volatile attributes can be set with deferred presistence. If an attribute is configured with deferred
  * presistence, any modifications to it will be enacted in its persistent storage with a specific delay
- * (CONFIG_ESP_MATTER_DEFERRED_ATTR_PERSISTENCE_TIME_MS)
+ * (CONFIG_ESP_MATTER_DEFERRED_ATTR_PERSISTENCE_TIME_MS). The deferred attributes changed within the same window are
+ * stored together, with a single NVS commit.
  *
  * It could be used for the non-volatile attribues which might be changed rapidly, such as CurrentLevel in LevelControl
  * cluster.
@@ -603,81 +1128,275 @@ callback_t get_override_callback(attribute_t *attribute);
  */
 esp_err_t set_deferred_persistence(attribute_t *attribute);
 
-} /* attribute */
-
-namespace command {
-
-/** Command callback
+/** Set attribute const value
  *
- * Command callback which is called when the command is invoked.
+ * Make the value of a string or array attribute point to immutable memory, such as rodata or a memory mapped flash
+ * partition, instead of a copy in the heap. This saves the internal RAM of the large values which are constant for
+ * the lifetime of the firmware, such as the supported modes or the fixed label lists, and the reads encode them
+ * straight from that memory. The heap buffer of the previous value is freed.
  *
- * @note: If the `COMMAND_FLAG_CUSTOM` is set, the default command response is sent internally based on the
- * return value from the callback.
+ * The value is not stored in NVS and is not reported. If another value is set later, it is copied to the heap as
+ * usual and the attribute loses `ATTRIBUTE_FLAG_CONST_VAL`.
  *
- * @param[in] command_path Common structure for endpoint, cluster and commands IDs.
- * @param[in] tlv_data Command data in TLV format.
- * @param[in] opaque_ptr This is a pointer which is used internally.
+ * @note: The attribute default value is the one given to `attribute::create()`, create the attribute with an empty
+ * value to not copy the constant one to the heap.
+ *
+ * @param[in] attribute Attribute handle, which must not be non-volatile.
+ * @param[in] val Value, whose buffer must stay valid and unchanged as long as the attribute uses it.
  *
  * @return ESP_OK on success.
- * @return error in case of failure.
+ * @return ESP_ERR_INVALID_ARG if the attribute is non-volatile or the types do not match.
  */
-typedef esp_err_t (*callback_t)(const ConcreteCommandPath &command_path, TLVReader &tlv_data, void *opaque_ptr);
+esp_err_t set_const_val(attribute_t *attribute, const esp_matter_attr_val_t *val);
 
-/** Create command
- *
- * This will create a new command and add it to the cluster.
+/** Set attribute urgent report
  *
- * @note: For commands which are not defined in the spec the `COMMAND_FLAG_CUSTOM` flag must be set. This
- * will send the command response internally, after the command callback is called.
+ * With CONFIG_ESP_MATTER_ICD_REPORT_BATCHING, the reports of the attributes changed with `attribute::report()` while
+ * the ICD is in idle mode are held until the next active mode, so the reports of all the subscriptions go out in a
+ * single wake. The reports of an urgent attribute, such as an alarm state, are sent right away, together with the
+ * held ones.
  *
- * @param[in] cluster Cluster handle.
- * @param[in] command_id Command ID for the command.
- * @param[in] flags Bitmap of `command_flags_t`.
- * @param[in] callback Command callback
+ * @param[in] attribute Attribute handle.
+ * @param[in] urgent Report the attribute right away.
  *
- * @return Command handle on success.
- * @return NULL in case of failure.
+ * @return ESP_OK on success.
+ * @return error in case of failure.
  */
-command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callback_t callback);
+esp_err_t set_urgent_report(attribute_t *attribute, bool urgent);
 
-/** Get command
+/** Attribute report priority */
+typedef enum report_priority {
+    /** The reports follow the ICD report batching and the reporting policy of the attribute */
+    REPORT_PRIORITY_NORMAL = 0,
+    /** The reports are sent right away, such as the ones of a lock state or an alarm, see `set_urgent_report()` */
+    REPORT_PRIORITY_URGENT,
+    /** The reports are bulk telemetry, such as measurements, deferred and coalesced with the other bulk reports */
+    REPORT_PRIORITY_BULK,
+} report_priority_t;
+
+/** Set attribute report priority
  *
- * Get the command present on the cluster.
+ * The urgent attributes skip the ICD report batching and the min interval of the reporting policy. With
+ * CONFIG_ESP_MATTER_ENABLE_REPORT_PRIORITY, the reports of the bulk attributes are held for
+ * CONFIG_ESP_MATTER_BULK_REPORT_DELAY_MS from the first one and marked dirty together, so a busy node sends the urgent
+ * and normal reports first and the bulk ones in a single later report.
  *
- * @param[in] cluster Cluster handle.
- * @param[in] command_id Command ID for the command.
- * @param[in] flags Command flags for the command to be fetched.
+ * @note: The min interval and the max interval of the subscriptions are always honoured, the priority only changes when
+ * esp_matter marks the attributes dirty.
  *
- * @return Command handle on success.
- * @return NULL in case of failure.
+ * @param[in] attribute Attribute handle.
+ * @param[in] priority Report priority.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
  */
-command_t *get(cluster_t *cluster, uint32_t command_id, uint16_t flags);
+esp_err_t set_report_priority(attribute_t *attribute, report_priority_t priority);
 
-/** Get first command
- *
- * Get the first command present on the cluster.
+/** Get attribute report priority
  *
- * @param[in] cluster Cluster handle.
+ * @param[in] attribute Attribute handle.
  *
- * @return Command handle on success.
- * @return NULL in case of failure.
+ * @return Report priority of the attribute, REPORT_PRIORITY_NORMAL if the attribute is NULL.
  */
-command_t *get_first(cluster_t *cluster);
+report_priority_t get_report_priority(attribute_t *attribute);
 
-/** Get next command
- *
- * Get the next command present on the cluster.
+} /* attribute */
+
+namespace persistence {
+
+/** Flush deferred attributes
  *
- * @param[in] command Command handle.
+ * Store the pending values of the attributes with deferred persistence now, instead of waiting for the end of the
+ * persistence window. The pending values are also stored on `esp_restart()`. With
+ * CONFIG_ESP_MATTER_DEFER_ENDPOINT_ID_PERSISTENCE, the minimum unused endpoint ID is stored as well.
  *
- * @return Command handle on success.
- * @return NULL in case of failure.
+ * @return ESP_OK on success.
+ * @return error in case of failure.
  */
-command_t *get_next(command_t *command);
+esp_err_t flush();
 
-/** Get command ID
+#if CONFIG_ESP_MATTER_ENABLE_POWER_FAIL_FLUSH
+/** Flush deferred attributes on power fail
  *
- * Get the command ID for the command.
+ * Synchronously store the pending values of all the deferred attributes with a single NVS commit. This can be
+ * called from any task, for example from the handler of a low-voltage detector, and waits at most `ticks_to_wait`
+ * for the Matter stack lock. The pending values are also stored on `esp_restart()`.
+ *
+ * @param[in] ticks_to_wait Maximum time to wait for the Matter stack lock.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_TIMEOUT if the lock could not be taken in time.
+ */
+esp_err_t flush_on_power_fail(uint32_t ticks_to_wait);
+
+/** Register power fail GPIO
+ *
+ * Flush the deferred attributes when the output of an external supply supervisor or low-voltage detector, connected
+ * to the GPIO, goes to its active level. The flush runs in a dedicated high priority task.
+ *
+ * @note: The internal brownout detector of the chip resets it right away and cannot be used for this.
+ *
+ * @param[in] gpio_num GPIO connected to the power fail signal.
+ * @param[in] active_level Level of the signal on power fail.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t register_power_fail_gpio(gpio_num_t gpio_num, bool active_level);
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_NVS_WRITE_LIMITER
+/** NVS write statistics, since boot */
+typedef struct write_stats {
+    /** Attribute values written to NVS */
+    uint32_t writes;
+    /** Writes deferred because the attribute or the node was over its write rate */
+    uint32_t limited_writes;
+    /** Bytes of attribute values written */
+    uint64_t bytes_written;
+    /** Estimated number of NVS entries consumed by the writes */
+    uint64_t entries_written;
+    /** Used and free entries of the esp_matter NVS partition */
+    size_t nvs_used_entries;
+    size_t nvs_free_entries;
+    /** Estimated number of erases of each page of the esp_matter NVS partition */
+    uint32_t estimated_erase_count;
+} write_stats_t;
+
+/** Get NVS write statistics
+ *
+ * @param[out] stats Write statistics.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_write_stats(write_stats_t *stats);
+
+/** Get attribute write count
+ *
+ * @param[in] attribute Attribute handle.
+ *
+ * @return Number of times the attribute value has been written to NVS since boot.
+ */
+uint32_t get_write_count(attribute_t *attribute);
+#endif
+
+} /* persistence */
+
+namespace command {
+
+/** Command callback
+ *
+ * Command callback which is called when the command is invoked.
+ *
+ * @note: If the `COMMAND_FLAG_CUSTOM` is set, the default command response is sent internally based on the
+ * return value from the callback.
+ *
+ * @param[in] command_path Common structure for endpoint, cluster and commands IDs.
+ * @param[in] tlv_data Command data in TLV format.
+ * @param[in] opaque_ptr This is a pointer which is used internally.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+typedef esp_err_t (*callback_t)(const ConcreteCommandPath &command_path, TLVReader &tlv_data, void *opaque_ptr);
+
+/** Async command response handle
+ *
+ * Handle of a command whose response is deferred. It keeps the exchange with the invoking controller open until the
+ * command is completed with `complete_async()` or `release_async()`.
+ */
+typedef struct async_handle async_handle_t;
+
+/** Async command callback
+ *
+ * Command callback which is called when the command is invoked, and which may complete the command later from any
+ * task. Use this for handlers which would otherwise block the Matter task, for example while driving a motor or
+ * forwarding the command to another network.
+ *
+ * @note: The built-in callback of the command is not called and no response is sent internally. The command must be
+ * completed with `complete_async()`, or with `release_async()` after adding a response through
+ * `get_command_handler()`.
+ *
+ * @param[in] command_path Common structure for endpoint, cluster and commands IDs.
+ * @param[in] tlv_data Command data in TLV format. It is only valid during the callback.
+ * @param[in] async_handle Handle of the pending command.
+ *
+ * @return ESP_OK if the command is pending. It must then be completed exactly once.
+ * @return error in case of failure. A failure status is sent internally and the handle must not be used.
+ */
+typedef esp_err_t (*async_callback_t)(const ConcreteCommandPath &command_path, TLVReader &tlv_data,
+                                      async_handle_t *async_handle);
+
+/** Create command
+ *
+ * This will create a new command and add it to the cluster.
+ *
+ * @note: For commands which are not defined in the spec the `COMMAND_FLAG_CUSTOM` flag must be set. This
+ * will send the command response internally, after the command callback is called.
+ *
+ * @param[in] cluster Cluster handle.
+ * @param[in] command_id Command ID for the command.
+ * @param[in] flags Bitmap of `command_flags_t`.
+ * @param[in] callback Command callback
+ *
+ * @return Command handle on success.
+ * @return NULL in case of failure.
+ */
+command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callback_t callback);
+
+/** Get command
+ *
+ * Get the command present on the cluster.
+ *
+ * @param[in] cluster Cluster handle.
+ * @param[in] command_id Command ID for the command.
+ * @param[in] flags Command flags for the command to be fetched.
+ *
+ * @return Command handle on success.
+ * @return NULL in case of failure.
+ */
+command_t *get(cluster_t *cluster, uint32_t command_id, uint16_t flags);
+
+/** Get accepted command
+ *
+ * Get the accepted command from its path. This is used by the command dispatch and resolves the command in a single
+ * lookup when the path index or the command dispatch table is enabled.
+ *
+ * @param[in] endpoint_id Endpoint ID of the command.
+ * @param[in] cluster_id Cluster ID of the command.
+ * @param[in] command_id Command ID of the command.
+ *
+ * @return Command handle on success.
+ * @return NULL if the command is not found.
+ */
+command_t *get_accepted(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id);
+
+/** Get first command
+ *
+ * Get the first command present on the cluster.
+ *
+ * @param[in] cluster Cluster handle.
+ *
+ * @return Command handle on success.
+ * @return NULL in case of failure.
+ */
+command_t *get_first(cluster_t *cluster);
+
+/** Get next command
+ *
+ * Get the next command present on the cluster.
+ *
+ * @param[in] command Command handle.
+ *
+ * @return Command handle on success.
+ * @return NULL in case of failure.
+ */
+command_t *get_next(command_t *command);
+
+/** Get command ID
+ *
+ * Get the command ID for the command.
  *
  * @param[in] command Command handle.
  *
@@ -719,6 +1438,67 @@ callback_t get_user_callback(command_t *command);
  */
 void set_user_callback(command_t *command, callback_t user_callback);
 
+/** Get command async_callback
+ *
+ * Get the async callback for the command.
+ *
+ * @param[in] command Command handle.
+ *
+ * @return Command async_callback on success.
+ * @return NULL in case of failure or if the async callback was not set.
+ */
+async_callback_t get_async_callback(command_t *command);
+
+/** Set command async_callback
+ *
+ * Set the async callback for the command. When set, it is called instead of the user_callback and of the built-in
+ * callback of the command.
+ *
+ * @param[in] command Command handle of an accepted command.
+ * @param[in] async_callback Async callback, or NULL to go back to the synchronous callbacks.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_async_callback(command_t *command, async_callback_t async_callback);
+
+/** Complete async command
+ *
+ * Send the status response of a pending command and release its handle. This can be called from any task, the
+ * Matter stack lock is taken internally.
+ *
+ * @param[in] async_handle Handle passed to the async callback.
+ * @param[in] err Result of the command. ESP_OK sends a success status, any error sends a failure status.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t complete_async(async_handle_t *async_handle, esp_err_t err);
+
+/** Get command handler of async command
+ *
+ * Get the command handler of a pending command, to add a data response to it. This must be called with the Matter
+ * stack lock held, and the command must then be completed with `release_async()`.
+ *
+ * @param[in] async_handle Handle passed to the async callback.
+ *
+ * @return Command handler on success.
+ * @return NULL if the exchange has been closed in the meantime, for example because the controller timed out.
+ */
+chip::app::CommandHandler *get_command_handler(async_handle_t *async_handle);
+
+/** Release async command
+ *
+ * Release the handle of a pending command without sending a status response. Use this after adding a response with
+ * `get_command_handler()`. This can be called from any task, the Matter stack lock is taken internally.
+ *
+ * @param[in] async_handle Handle passed to the async callback.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t release_async(async_handle_t *async_handle);
+
 /** Get command flags
  *
  * Get the command flags for the command.
@@ -729,8 +1509,651 @@ void set_user_callback(command_t *command, callback_t user_callback);
  */
 uint16_t get_flags(command_t *command);
 
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_DISPATCH_TABLE
+/** Get command invoke count
+ *
+ * Get the number of times the command has been dispatched since boot, whatever the result of its callbacks.
+ *
+ * @param[in] command Command handle.
+ *
+ * @return Invoke count.
+ */
+uint32_t get_invoke_count(command_t *command);
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+/** Number of buckets of the latency histograms: <128us, <256us, ... <512ms and the rest */
+#define COMMAND_STATS_BUCKET_COUNT 14
+/** Maximum number of (cluster, command) pairs tracked */
+#define COMMAND_STATS_MAX_COMMANDS 32
+
+/** Latency statistics of a command */
+typedef struct command_stats {
+    /** Cluster ID of the command */
+    uint32_t cluster_id;
+    /** Command ID of the command */
+    uint32_t command_id;
+    /** Number of times the command has been dispatched, on any endpoint */
+    uint32_t count;
+    /** Histogram of the time spent in the dispatch */
+    uint32_t total_histogram[COMMAND_STATS_BUCKET_COUNT];
+    /** Histogram of the time spent in the user callback, or in the async callback */
+    uint32_t user_callback_histogram[COMMAND_STATS_BUCKET_COUNT];
+    /** Histogram of the time spent in the built-in callback */
+    uint32_t built_in_callback_histogram[COMMAND_STATS_BUCKET_COUNT];
+    /** Longest dispatch in microseconds */
+    uint32_t max_total_us;
+} command_stats_t;
+
+/** Get command latency statistics
+ *
+ * Copy the latency statistics of the commands dispatched since boot or the last `reset_stats()`. For async commands
+ * only the time spent on the Matter task is accounted for, not the time until the command is completed.
+ *
+ * @param[out] stats Array to copy the statistics to.
+ * @param[inout] count Size of the array as input, number of entries copied as output.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_stats(command_stats_t *stats, size_t *count);
+
+/** Reset command latency statistics */
+void reset_stats();
+
+/** Print command latency statistics */
+void print_stats();
+#endif // CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+
 } /* command */
 
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+namespace e2e_latency {
+
+/** Stages of a command, from the reception of the invoke request to the end of its dispatch. Each stage is timed
+ * from the previous stage reached by the command: a command which does not change an attribute, or reaches the
+ * dispatch without a receive timestamp, skips the stages it does not reach.
+ */
+typedef enum stage {
+    /** Invoke request handed to the interaction model, after the decryption of the message */
+    STAGE_RECEIVE = 0,
+    /** DispatchSingleClusterCommandCommon(), after the decoding and the access control of the interaction model */
+    STAGE_DISPATCH,
+    /** Built-in callback of the cluster server, after the user callback of the command */
+    STAGE_CLUSTER_SERVER,
+    /** Attribute callback of the application with PRE_UPDATE, which usually drives the hardware */
+    STAGE_DRIVER,
+    /** Return of that attribute callback */
+    STAGE_DRIVER_DONE,
+    /** MatterPostAttributeChangeCallback(), after the attribute is stored */
+    STAGE_POST_ATTRIBUTE_CHANGE,
+    /** End of the dispatch, the response is sent after it */
+    STAGE_DONE,
+    STAGE_COUNT,
+} stage_t;
+
+/** Number of buckets of the latency histograms: <32us, <64us, ... <256ms and the rest */
+#define E2E_LATENCY_BUCKET_COUNT 15
+
+/** Latency statistics of a stage */
+typedef struct stage_stats {
+    /** Number of commands which reached the stage */
+    uint32_t count;
+    /** Histogram of the time since the previous stage */
+    uint32_t histogram[E2E_LATENCY_BUCKET_COUNT];
+    /** Longest time since the previous stage in microseconds */
+    uint32_t max_us;
+    /** Sum of the times since the previous stage in microseconds */
+    uint64_t total_us;
+} stage_stats_t;
+
+/** Get end-to-end latency statistics
+ *
+ * Copy the statistics of a stage for the commands dispatched since boot or the last `reset_stats()`. The statistics
+ * of STAGE_RECEIVE are the times from the first stage to STAGE_DONE, the end-to-end time on the device.
+ *
+ * @param[in] stage Stage.
+ * @param[out] stats Statistics of the stage.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the stage or stats is invalid.
+ */
+esp_err_t get_stats(stage_t stage, stage_stats_t *stats);
+
+/** Reset end-to-end latency statistics */
+void reset_stats();
+
+/** Print end-to-end latency statistics */
+void print_stats();
+
+} /* e2e_latency */
+#endif // CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+
+#if CONFIG_ESP_MATTER_ENABLE_SYNCHRONIZED_REPORTS
+namespace report_sync {
+
+/** Statistics of the synchronized reports */
+typedef struct stats {
+    /** Number of times the report timer fired */
+    uint32_t timer_wakes;
+    /** Number of reports sent, for all the subscriptions */
+    uint32_t reports_sent;
+    /** Number of wake windows in which at least one report was sent */
+    uint32_t report_windows;
+    /** Number of reports sent in the wake window of another report, which would have woken the device separately */
+    uint32_t wakes_saved;
+} stats_t;
+
+/** Get synchronized report statistics
+ *
+ * Copy the statistics of the reports sent since boot or the last `reset_stats()`.
+ *
+ * @param[out] stats Statistics.
+ */
+void get_stats(stats_t *stats);
+
+/** Reset synchronized report statistics */
+void reset_stats();
+
+/** Print synchronized report statistics */
+void print_stats();
+
+} /* report_sync */
+#endif // CONFIG_ESP_MATTER_ENABLE_SYNCHRONIZED_REPORTS
+
+#if CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
+namespace sed_poll {
+
+/** Sources of activity which switch the sleepy end device to the fast poll period */
+typedef enum activity {
+    /** Command received from a controller */
+    ACTIVITY_COMMAND = 0,
+    /** Subscription requested, the fast poll period is held until it is primed */
+    ACTIVITY_SUBSCRIPTION,
+    /** Connection to a peer, for the client requests and the bindings */
+    ACTIVITY_EXCHANGE,
+    /** Activity notified with `notify_activity()`, and the boot */
+    ACTIVITY_APPLICATION,
+    ACTIVITY_COUNT,
+} activity_t;
+
+/** Statistics of the adaptive poll period */
+typedef struct stats {
+    /** Time spent with the fast poll period, in milliseconds */
+    uint64_t fast_ms;
+    /** Time spent with the idle poll period, in milliseconds */
+    uint64_t idle_ms;
+    /** Number of switches from the idle to the fast poll period */
+    uint32_t fast_entries;
+    /** Number of activities of each source, including the ones seen in the fast poll period */
+    uint32_t activities[ACTIVITY_COUNT];
+} stats_t;
+
+/** Switch to the fast poll period
+ *
+ * The sleepy end device polls its parent every CONFIG_ESP_MATTER_SED_POLL_FAST_PERIOD_MS while a command is
+ * received, a subscription is primed or a connection to a peer is made, and returns to
+ * CONFIG_ESP_MATTER_SED_POLL_IDLE_PERIOD_MS once there was no activity and no open exchange for
+ * CONFIG_ESP_MATTER_SED_POLL_QUIET_TIMEOUT_MS. Call this when the application expects traffic, for example before
+ * it sends a report to a peer.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t notify_activity();
+
+/** Get adaptive poll statistics
+ *
+ * Copy the statistics since boot or the last `reset_stats()`, including the time of the current mode. The share of
+ * the time with the fast poll period is `fast_ms / (fast_ms + idle_ms)`.
+ *
+ * @param[out] stats Statistics.
+ */
+void get_stats(stats_t *stats);
+
+/** Reset adaptive poll statistics */
+void reset_stats();
+
+/** Print adaptive poll statistics */
+void print_stats();
+
+} /* sed_poll */
+#endif // CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
+
+#if CONFIG_ESP_MATTER_ENABLE_GROUP_KEY_CACHE
+namespace group_key_cache {
+
+/** Statistics of the group key cache */
+typedef struct stats {
+    /** Number of group session lookups, one per group message received */
+    uint32_t lookups;
+    /** Number of group messages dropped as no group of the node uses their session id, without a decryption */
+    uint32_t filtered;
+    /** Number of lookups served from the storage, when the cache is full or in use */
+    uint32_t fallbacks;
+    /** Number of times the operational keys were derived again, after a change of the group data */
+    uint32_t rebuilds;
+} stats_t;
+
+/** Get group key cache statistics
+ *
+ * Copy the statistics of the group session lookups since boot or the last `reset_stats()`.
+ *
+ * @param[out] stats Statistics.
+ */
+void get_stats(stats_t *stats);
+
+/** Reset group key cache statistics */
+void reset_stats();
+
+/** Print group key cache statistics */
+void print_stats();
+
+} /* group_key_cache */
+#endif // CONFIG_ESP_MATTER_ENABLE_GROUP_KEY_CACHE
+
+#if CONFIG_ESP_MATTER_ENABLE_WIFI_FAST_RECONNECT
+namespace wifi_reconnect {
+
+/** Statistics of the Wi-Fi station connections */
+typedef struct stats {
+    /** Number of connections to an access point, at the boot or after the loss of the link */
+    uint32_t connections;
+    /** Number of connections made directly to the BSSID and the channel of the last access point */
+    uint32_t direct;
+    /** Number of direct connections which failed and fell back to a scan of the channels */
+    uint32_t fallbacks;
+    /** Time from the boot or the loss of the link to the last connection, in milliseconds */
+    uint32_t last_latency_ms;
+    /** Longest time to a connection, in milliseconds */
+    uint32_t max_latency_ms;
+    /** Sum of the times to the connections, in milliseconds */
+    uint64_t total_latency_ms;
+} stats_t;
+
+/** Get Wi-Fi reconnect statistics
+ *
+ * Copy the statistics of the station connections since boot or the last `reset_stats()`. The average time to a
+ * connection is `total_latency_ms / connections`.
+ *
+ * @param[out] stats Statistics.
+ */
+void get_stats(stats_t *stats);
+
+/** Reset Wi-Fi reconnect statistics */
+void reset_stats();
+
+/** Print Wi-Fi reconnect statistics */
+void print_stats();
+
+} /* wifi_reconnect */
+#endif // CONFIG_ESP_MATTER_ENABLE_WIFI_FAST_RECONNECT
+
+#if CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
+namespace storage_cache {
+
+/** Statistics of the persistent storage cache */
+typedef struct stats {
+    /** Number of reads of the server storage */
+    uint32_t reads;
+    /** Number of reads served by the cache, including the keys known not to exist */
+    uint32_t hits;
+    /** Number of writes and deletions of the server storage */
+    uint32_t writes;
+    /** Number of writes which did not reach the storage: same value as stored, or replaced before the commit */
+    uint32_t absorbed;
+    /** Number of writes and deletions done on the storage, committed or written through */
+    uint32_t storage_writes;
+    /** Number of commits of the pending writes */
+    uint32_t commits;
+    /** Number of entries evicted to cache other keys */
+    uint32_t evictions;
+} stats_t;
+
+/** Commit the pending writes
+ *
+ * The writes of the server storage are kept in the cache and committed together, in the order of the writes,
+ * CONFIG_ESP_MATTER_STORAGE_CACHE_COMMIT_DELAY_MS after the first one, when the commissioning completes or the
+ * fail-safe expires, and on `esp_restart()`. Call this before the device may lose power, for example before a
+ * deep sleep.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE if the server is not initialized.
+ * @return ESP_FAIL if some writes could not be committed, they are retried at the next commit.
+ */
+esp_err_t commit();
+
+/** Request a commit of the pending writes
+ *
+ * Like `commit()`, but the writes are committed later in the Matter context, so it can be called from the Matter
+ * context, for example from the callbacks of the commissioner at the end of a commissioning stage.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE if the server is not initialized.
+ * @return ESP_FAIL if the commit could not be scheduled.
+ */
+esp_err_t request_commit();
+
+/** Get storage cache statistics
+ *
+ * Copy the statistics of the server storage since boot or the last `reset_stats()`. The hit rate of the cache is
+ * `hits / reads`, and `storage_writes / writes` is the share of the writes which reached the storage.
+ *
+ * @param[out] stats Statistics.
+ */
+void get_stats(stats_t *stats);
+
+/** Reset storage cache statistics */
+void reset_stats();
+
+/** Print storage cache statistics */
+void print_stats();
+
+} /* storage_cache */
+#endif // CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
+
+#if CONFIG_ESP_MATTER_ENABLE_SESSION_RESUMPTION_STATS
+namespace session_resumption {
+
+/** Statistics of the CASE session resumptions */
+typedef struct stats {
+    /** Number of CASE sessions established, with a full handshake or resumed */
+    uint32_t sessions;
+    /** Number of sessions resumed from a stored resumption ID, without the ECDH and the signatures */
+    uint32_t resumed;
+    /** Number of resumption requests with an unknown or evicted resumption ID, which fell back to a full handshake */
+    uint32_t misses;
+    /** Number of entries evicted to keep CONFIG_ESP_MATTER_SESSION_RESUMPTION_FABRIC_DEPTH entries per fabric */
+    uint32_t evictions;
+} stats_t;
+
+/** Get session resumption statistics
+ *
+ * Copy the statistics of the CASE sessions established since boot or the last `reset_stats()`. The hit rate of the
+ * resumption store is `resumed / sessions`.
+ *
+ * @param[out] stats Statistics.
+ */
+void get_stats(stats_t *stats);
+
+/** Reset session resumption statistics */
+void reset_stats();
+
+/** Print session resumption statistics */
+void print_stats();
+
+} /* session_resumption */
+#endif // CONFIG_ESP_MATTER_ENABLE_SESSION_RESUMPTION_STATS
+
+#if CONFIG_ESP_MATTER_ENABLE_ACL_CACHE
+namespace acl_cache {
+
+/** Statistics of the access control decision cache */
+typedef struct stats {
+    /** Number of CASE and group checks answered from the cache */
+    uint32_t hits;
+    /** Number of CASE and group checks which evaluated the entries of the fabric */
+    uint32_t misses;
+    /** Number of times the cache was dropped, on a change of the entries or of the endpoints */
+    uint32_t invalidations;
+} stats_t;
+
+/** Get ACL cache statistics
+ *
+ * Copy the statistics of the access control checks since boot or the last `reset_stats()`. The hit rate of the cache
+ * is `hits / (hits + misses)`.
+ *
+ * @param[out] stats Statistics.
+ */
+void get_stats(stats_t *stats);
+
+/** Reset ACL cache statistics */
+void reset_stats();
+
+/** Print ACL cache statistics */
+void print_stats();
+
+} /* acl_cache */
+#endif // CONFIG_ESP_MATTER_ENABLE_ACL_CACHE
+
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+namespace callback_watchdog {
+
+/** Kind of the application callbacks dispatched by esp_matter */
+typedef enum callback_kind {
+    /** `attribute::callback_t`, set with `esp_matter::start()` or for a path */
+    CALLBACK_KIND_ATTRIBUTE = 0,
+    /** Override callback of an attribute with ATTRIBUTE_FLAG_OVERRIDE */
+    CALLBACK_KIND_OVERRIDE,
+    /** User or built-in command callback */
+    CALLBACK_KIND_COMMAND,
+    /** `event_callback_t` device event callback */
+    CALLBACK_KIND_EVENT,
+} callback_kind_t;
+
+/** Slow callback */
+typedef struct slow_callback {
+    /** Kind of the callback */
+    callback_kind_t kind;
+    /** Address of the callback function */
+    void *callback;
+    /** Endpoint ID of the path, 0 for the event callbacks */
+    uint16_t endpoint_id;
+    /** Cluster ID of the path, 0 for the event callbacks */
+    uint32_t cluster_id;
+    /** Attribute ID or command ID of the path, or the device event type */
+    uint32_t id;
+    /** Number of calls since the callback entered the table */
+    uint32_t count;
+    /** Number of calls over CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_BUDGET_MS */
+    uint32_t overruns;
+    /** Longest call in microseconds */
+    uint32_t max_us;
+} slow_callback_t;
+
+/** Get slowest callbacks
+ *
+ * Copy the CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_TOP_N slowest callbacks, identified by their kind, their function and
+ * their path, recorded since boot or the last `reset_stats()`, the slowest first.
+ *
+ * @param[out] callbacks Array to copy the callbacks to.
+ * @param[inout] count Size of the array as input, number of entries copied as output.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_slowest(slow_callback_t *callbacks, size_t *count);
+
+/** Reset slow callback statistics */
+void reset_stats();
+
+/** Print slow callback statistics */
+void print_stats();
+
+} /* callback_watchdog */
+#endif // CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+
+#if CONFIG_ESP_MATTER_ENABLE_POOL_STATS
+namespace pool_stats {
+
+/** Pools of the Matter stack with a fixed capacity */
+typedef enum pool {
+    /** System packet buffers, used by the messages in flight */
+    POOL_PACKET_BUFFERS = 0,
+    /** Exchange contexts, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS */
+    POOL_EXCHANGES,
+    /** Secure sessions, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE */
+    POOL_SECURE_SESSIONS,
+    /** Read handlers of the reads and subscriptions, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS */
+    POOL_READ_HANDLERS,
+    /** Entries of the retransmission table of the reliable messages, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE */
+    POOL_RETRANSMISSIONS,
+    POOL_COUNT,
+} pool_t;
+
+/** Usage of a pool */
+typedef struct stats {
+    /** False when the usage of the pool cannot be read in this build, the other fields are then 0 */
+    bool available;
+    /** Entries in use at the last sample */
+    uint32_t in_use;
+    /** Highest number of entries in use seen since boot or the last `reset_stats()` */
+    uint32_t high_water;
+    /** Number of entries of the pool, 0 if the entries are allocated from the heap */
+    uint32_t capacity;
+    /** Number of allocations which failed as the pool was empty, only counted for the packet buffers */
+    uint32_t failures;
+} stats_t;
+
+/** Get pool statistics
+ *
+ * Copy the usage of a pool, sampled every CONFIG_ESP_MATTER_POOL_STATS_SAMPLE_INTERVAL_MS in the Matter context. The
+ * high-water mark of the packet buffers is tracked by the SDK or lwIP on each allocation, the other ones are the
+ * highest of the samples.
+ *
+ * @param[in] pool Pool.
+ * @param[out] stats Usage of the pool.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the pool or stats is invalid.
+ */
+esp_err_t get_stats(pool_t pool, stats_t *stats);
+
+/** Reset the high-water marks and the failures to the current usage */
+void reset_stats();
+
+/** Print pool statistics */
+void print_stats();
+
+} /* pool_stats */
+#endif // CONFIG_ESP_MATTER_ENABLE_POOL_STATS
+
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_LOG
+namespace deferred_log {
+
+/** Statistics of the deferred log backend */
+typedef struct stats {
+    /** Number of lines queued to the deferred log task */
+    uint32_t records;
+    /** Number of lines dropped as the ring was full, reported in the output */
+    uint32_t dropped;
+    /** Number of lines cut to CONFIG_ESP_MATTER_DEFERRED_LOG_MAX_RECORD_SIZE */
+    uint32_t truncated;
+    /** Number of lines formatted by the caller, as their format is not in flash or cannot be deferred */
+    uint32_t formatted;
+    /** Highest number of slots of the ring in use */
+    uint32_t high_water;
+    /** Number of slots of the ring, CONFIG_ESP_MATTER_DEFERRED_LOG_SLOT_COUNT */
+    uint32_t capacity;
+} stats_t;
+
+/** Write the queued log lines
+ *
+ * Format and write the lines queued so far from the calling task, for example before entering deep sleep. The lines
+ * are also written before esp_restart().
+ */
+void flush();
+
+/** Get deferred log statistics
+ *
+ * @param[out] stats Statistics since boot or the last `reset_stats()`.
+ */
+void get_stats(stats_t *stats);
+
+/** Reset deferred log statistics, except the dropped lines */
+void reset_stats();
+
+/** Print deferred log statistics */
+void print_stats();
+
+} /* deferred_log */
+#endif // CONFIG_ESP_MATTER_ENABLE_DEFERRED_LOG
+
+#if CONFIG_ESP_MATTER_ENABLE_DEVICE_EVENT_REGISTRY
+namespace device_event {
+
+/** Number of bits of a mask, one per public device event type from kRange_Public, the last one for the others */
+#define DEVICE_EVENT_MASK_BITS 64
+
+/** Mask of device event types */
+typedef uint64_t mask_t;
+
+/** Mask of all the device event types */
+static constexpr mask_t k_mask_all = UINT64_MAX;
+
+/** Bit of a device event type in a mask. The platform specific types, and the public types past the 63rd, share the
+ * last bit.
+ */
+inline constexpr uint8_t get_bit(uint16_t type)
+{
+    return (type >= chip::DeviceLayer::DeviceEventType::kRange_Public &&
+            type - chip::DeviceLayer::DeviceEventType::kRange_Public < DEVICE_EVENT_MASK_BITS - 1)
+        ? type - chip::DeviceLayer::DeviceEventType::kRange_Public : DEVICE_EVENT_MASK_BITS - 1;
+}
+
+/** Mask of a device event type, for example
+ * `get_mask(DeviceEventType::kCommissioningComplete) | get_mask(DeviceEventType::kFabricRemoved)`
+ */
+inline constexpr mask_t get_mask(uint16_t type)
+{
+    return static_cast<mask_t>(1) << get_bit(type);
+}
+
+/** Statistics of the device event registry */
+typedef struct stats {
+    /** Number of events of every type, indexed by `get_bit()` */
+    uint32_t events[DEVICE_EVENT_MASK_BITS];
+    /** Number of events no subscriber was called for */
+    uint32_t unmatched;
+    /** Number of subscriber calls */
+    uint32_t calls;
+    /** Number of subscribers */
+    uint32_t subscribers;
+} stats_t;
+
+/** Subscribe to device events
+ *
+ * The callback is called on the Matter task for the events whose type is in the mask. Subscribing the same callback
+ * and argument again replaces the mask. Can be called before `esp_matter::start()`.
+ *
+ * @param[in] mask Mask of the event types, `get_mask()` of each type or `k_mask_all`.
+ * @param[in] callback event callback.
+ * @param[in] callback_arg private data to pass to callback function, optional argument, by default set to NULL.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM if CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS callbacks are subscribed.
+ * @return error in case of failure.
+ */
+esp_err_t subscribe(mask_t mask, event_callback_t callback, intptr_t callback_arg = static_cast<intptr_t>(NULL));
+
+/** Unsubscribe from device events
+ *
+ * Can be called from the callback itself. Called from another task, the callback may still be running for the event
+ * being dispatched.
+ *
+ * @param[in] callback event callback.
+ * @param[in] callback_arg private data passed to `subscribe()`.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the callback is not subscribed.
+ */
+esp_err_t unsubscribe(event_callback_t callback, intptr_t callback_arg = static_cast<intptr_t>(NULL));
+
+/** Get device event registry statistics
+ *
+ * @param[out] stats Statistics since boot or the last `reset_stats()`.
+ */
+void get_stats(stats_t *stats);
+
+/** Reset device event registry statistics */
+void reset_stats();
+
+/** Print device event registry statistics and the subscribers */
+void print_stats();
+
+} /* device_event */
+#endif // CONFIG_ESP_MATTER_ENABLE_DEVICE_EVENT_REGISTRY
+
 namespace event {
 
 /** Create event
@@ -792,6 +2215,325 @@ uint32_t get_id(event_t *event);
 
 } /* event */
 
+/* Table-driven construction APIs
+ *
+ * These APIs build clusters and endpoints from const descriptor tables in a single linear pass. The elements of a
+ * newly created cluster are appended straight from the table without the per-element duplicate lookup, so the
+ * construction time scales linearly with the size of the endpoint. The tables must not contain duplicate entries.
+ */
+namespace attribute {
+
+/** Attribute descriptor */
+typedef struct descriptor {
+    /** Attribute ID */
+    uint32_t attribute_id;
+    /** Bitmap of `attribute_flags_t` */
+    uint16_t flags;
+    /** Default type and value of the attribute */
+    esp_matter_attr_val_t val;
+    /** Maximum value size for char string and long char string attributes, 0 otherwise */
+    uint16_t max_val_size;
+} descriptor_t;
+
+} /* attribute */
+
+namespace command {
+
+/** Command descriptor */
+typedef struct descriptor {
+    /** Command ID */
+    uint32_t command_id;
+    /** Bitmap of `command_flags_t` */
+    uint8_t flags;
+    /** Command callback, can be NULL */
+    callback_t callback;
+} descriptor_t;
+
+} /* command */
+
+namespace cluster {
+
+/** Cluster descriptor */
+typedef struct descriptor {
+    /** Cluster ID */
+    uint32_t cluster_id;
+    /** Bitmap of `cluster_flags_t` */
+    uint8_t flags;
+    /** Attribute table and its length */
+    const attribute::descriptor_t *attributes;
+    uint16_t attribute_count;
+    /** Command table and its length */
+    const command::descriptor_t *commands;
+    uint16_t command_count;
+    /** Event ID table and its length */
+    const uint32_t *event_ids;
+    uint16_t event_count;
+    /** (Optional) Plugin server init callback */
+    plugin_server_init_callback_t plugin_server_init_callback;
+    /** (Optional) Function list and the corresponding function flags */
+    const function_generic_t *function_list;
+    int function_flags;
+} descriptor_t;
+
+/** Create cluster from descriptor
+ *
+ * This will create the cluster described by the descriptor on the endpoint, along with its attributes, commands and
+ * events. If the cluster already exists on the endpoint, the missing elements are added to it. On failure, the
+ * elements added by this call are removed again, along with the cluster if it has been created by this call.
+ *
+ * @param[in] endpoint Endpoint handle.
+ * @param[in] descriptor Cluster descriptor.
+ *
+ * @return Cluster handle on success.
+ * @return NULL in case of failure.
+ */
+cluster_t *create(endpoint_t *endpoint, const descriptor_t *descriptor);
+
+} /* cluster */
+
+namespace endpoint {
+
+/** Endpoint descriptor */
+typedef struct descriptor {
+    /** Device type ID and version */
+    uint32_t device_type_id;
+    uint8_t device_type_version;
+    /** Cluster table and its length */
+    const cluster::descriptor_t *clusters;
+    uint16_t cluster_count;
+    /** (Optional) Static ember metadata matching the cluster table, see `set_static_metadata()` */
+    const EmberAfEndpointType *static_metadata;
+} descriptor_t;
+
+/** Create endpoint from descriptor
+ *
+ * This will create a new endpoint and add the device type and all the clusters of the descriptor to it. On failure,
+ * the partially built endpoint is destroyed.
+ *
+ * @param[in] node Node handle.
+ * @param[in] descriptor Endpoint descriptor.
+ * @param[in] flags Bitmap of `endpoint_flags_t`.
+ * @param[in] priv_data (Optional) Private data associated with the endpoint.
+ *
+ * @return Endpoint handle on success.
+ * @return NULL in case of failure.
+ */
+endpoint_t *create(node_t *node, const descriptor_t *descriptor, uint8_t flags, void *priv_data);
+
+/** Add descriptor to endpoint
+ *
+ * Add the device type and all the clusters of the descriptor to an existing endpoint.
+ *
+ * @param[in] endpoint Endpoint handle.
+ * @param[in] descriptor Endpoint descriptor.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t add(endpoint_t *endpoint, const descriptor_t *descriptor);
+
+} /* endpoint */
+
+/** Data model memory statistics
+ *
+ * Number of bytes requested from the heap by the data model, not including the allocator overhead.
+ */
+typedef struct memory_stats {
+    /** Endpoint, cluster, attribute, command and event structures */
+    size_t structs;
+    /** Buffers of the string, octet string and array attribute values */
+    size_t value_buffers;
+    /** Attribute bounds */
+    size_t bounds;
+    /** Attribute default values used in the ember metadata, the values shared by several attributes are divided
+     * among them */
+    size_t default_values;
+    /** Ember metadata created by `endpoint::enable()`: endpoint type, clusters, attributes, command and event lists,
+     * data versions and device types */
+    size_t metadata;
+} memory_stats_t;
+
+namespace cluster {
+
+/** Get cluster memory statistics
+ *
+ * @param[in] cluster Cluster handle.
+ * @param[out] stats Memory statistics of the cluster and its attributes, commands and events.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_memory_stats(cluster_t *cluster, memory_stats_t *stats);
+
+} /* cluster */
+
+namespace endpoint {
+
+/** Get endpoint memory statistics
+ *
+ * @param[in] endpoint Endpoint handle.
+ * @param[out] stats Memory statistics of the endpoint and all its clusters.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_memory_stats(endpoint_t *endpoint, memory_stats_t *stats);
+
+} /* endpoint */
+
+namespace node {
+
+/** Get node memory statistics
+ *
+ * @param[in] node Node handle.
+ * @param[out] stats Memory statistics of the node and all its endpoints.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_memory_stats(node_t *node, memory_stats_t *stats);
+
+/** Print node memory statistics
+ *
+ * Print the memory statistics of the node, broken down per endpoint and per cluster.
+ *
+ * @param[in] node Node handle.
+ */
+void print_memory_stats(node_t *node);
+
+/** Attribute filter of `for_each_attribute()` and `snapshot_attributes()`
+ *
+ * `chip::kInvalidEndpointId`, `chip::kInvalidClusterId` and `chip::kInvalidAttributeId` match any ID.
+ */
+typedef struct attribute_filter {
+    /** Endpoint ID of the attributes */
+    uint16_t endpoint_id;
+    /** Cluster ID of the attributes */
+    uint32_t cluster_id;
+    /** Attribute ID of the attributes */
+    uint32_t attribute_id;
+} attribute_filter_t;
+
+/** Attribute visitor
+ *
+ * @param[in] endpoint_id Endpoint ID of the attribute.
+ * @param[in] cluster_id Cluster ID of the attribute.
+ * @param[in] attribute_id Attribute ID.
+ * @param[in] val Value of the attribute, only valid during the call.
+ * @param[in] priv_data Pointer to the private data passed with the visitor.
+ *
+ * @return ESP_OK to continue with the next attribute.
+ * @return error to stop the iteration, the error is returned by the iteration.
+ */
+typedef esp_err_t (*attribute_visitor_t)(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                         const esp_matter_attr_val_t *val, void *priv_data);
+
+/** Iterate over the attributes of the node
+ *
+ * Call the visitor for the attributes which match the filter, endpoint by endpoint and cluster by cluster. The Matter
+ * stack lock is held for the whole iteration, use `for_each_attribute_snapshot()` for long visitors. The values of
+ * the attributes with ATTRIBUTE_FLAG_OVERRIDE are the ones stored in the data model, not the ones of the override
+ * callback.
+ *
+ * @param[in] node Node handle.
+ * @param[in] filter Filter of the attributes, NULL for all the attributes.
+ * @param[in] visitor Visitor called for each attribute.
+ * @param[in] priv_data Private data passed to the visitor.
+ *
+ * @return ESP_OK on success.
+ * @return error returned by the visitor, or in case of failure.
+ */
+esp_err_t for_each_attribute(node_t *node, const attribute_filter_t *filter, attribute_visitor_t visitor,
+                             void *priv_data);
+
+/** Attribute of a snapshot */
+typedef struct attribute_snapshot_entry {
+    /** Endpoint ID of the attribute */
+    uint16_t endpoint_id;
+    /** Cluster ID of the attribute */
+    uint32_t cluster_id;
+    /** Attribute ID */
+    uint32_t attribute_id;
+    /** Value of the attribute, the string and array values point to the snapshot buffer */
+    esp_matter_attr_val_t val;
+} attribute_snapshot_entry_t;
+
+/** Snapshot the attributes of the node
+ *
+ * Copy the attributes which match the filter to the buffer of the caller, with the Matter stack lock held only for
+ * the copies. The entries are at the start of the buffer, in the order of `for_each_attribute()`, and the string and
+ * array values are copied at the end of the buffer. The snapshot can then be read without the lock.
+ *
+ * @param[in] node Node handle.
+ * @param[in] filter Filter of the attributes, NULL for all the attributes.
+ * @param[in] buffer Buffer of the snapshot, aligned for `attribute_snapshot_entry_t`.
+ * @param[in] size Size of the buffer.
+ * @param[out] entries Entries of the snapshot, at the start of the buffer.
+ * @param[out] count Number of entries.
+ * @param[out] required_size Size of the buffer needed for the whole snapshot, can be NULL.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_SIZE if the buffer is too small, the entries which fit are still copied.
+ * @return error in case of failure.
+ */
+esp_err_t snapshot_attributes(node_t *node, const attribute_filter_t *filter, void *buffer, size_t size,
+                              attribute_snapshot_entry_t **entries, size_t *count, size_t *required_size);
+
+/** Iterate over a snapshot of the attributes of the node
+ *
+ * Same as `for_each_attribute()`, but the attributes are first copied with `snapshot_attributes()` to the buffer of
+ * the caller, and the visitor is called without the Matter stack lock held, so it can take its time.
+ *
+ * @param[in] node Node handle.
+ * @param[in] filter Filter of the attributes, NULL for all the attributes.
+ * @param[in] buffer Buffer of the snapshot, aligned for `attribute_snapshot_entry_t`.
+ * @param[in] size Size of the buffer.
+ * @param[in] visitor Visitor called for each attribute.
+ * @param[in] priv_data Private data passed to the visitor.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_SIZE if the buffer is too small, the visitor is not called.
+ * @return error returned by the visitor, or in case of failure.
+ */
+esp_err_t for_each_attribute_snapshot(node_t *node, const attribute_filter_t *filter, void *buffer, size_t size,
+                                      attribute_visitor_t visitor, void *priv_data);
+
+#if CONFIG_ESP_MATTER_ENABLE_JSON_EXPORT
+/** Writer of the JSON export
+ *
+ * @param[in] data Chunk of the JSON document, not NUL terminated.
+ * @param[in] size Size of the chunk.
+ * @param[in] priv_data Pointer to the private data passed to `export_json()`.
+ *
+ * @return ESP_OK to continue the export.
+ * @return error to stop the export, the error is returned by `export_json()`.
+ */
+typedef esp_err_t (*json_writer_t)(const char *data, size_t size, void *priv_data);
+
+/** Export the attributes of the node as JSON
+ *
+ * Write the attributes which match the filter as a compact JSON object, keyed by the decimal endpoint, cluster and
+ * attribute IDs: `{"1":{"6":{"0":true,...},...},...}`. The attributes are copied with `snapshot_attributes()` one
+ * endpoint at a time, or one cluster or attribute at a time when an endpoint does not fit, to a buffer of
+ * CONFIG_ESP_MATTER_JSON_EXPORT_SNAPSHOT_SIZE bytes, and written in chunks of CONFIG_ESP_MATTER_JSON_EXPORT_CHUNK_SIZE
+ * bytes without the Matter stack lock held, so the memory used does not depend on the size of the node. The strings
+ * are JSON strings, the octet strings and the arrays are hex strings, and an attribute which does not fit in the
+ * buffer is written as null. The values of the attributes with ATTRIBUTE_FLAG_OVERRIDE are the ones stored in the
+ * data model.
+ *
+ * @param[in] node Node handle.
+ * @param[in] filter Filter of the attributes, NULL for all the attributes.
+ * @param[in] writer Writer called for each chunk, for example to a file or to `httpd_resp_send_chunk()`.
+ * @param[in] priv_data Private data passed to the writer.
+ *
+ * @return ESP_OK on success.
+ * @return error returned by the writer, or in case of failure.
+ */
+esp_err_t export_json(node_t *node, const attribute_filter_t *filter, json_writer_t writer, void *priv_data);
+#endif // CONFIG_ESP_MATTER_ENABLE_JSON_EXPORT
+
+} /* node */
+
 /* Client APIs */
 namespace client {
 
@@ -856,9 +2598,58 @@ void binding_init();
  */
 void binding_manager_init();
 
+/** Command retry policy
+ *
+ * Only the session establishment is retried, the command send callback is called once the session is ready. A
+ * command is therefore never sent twice by the retries.
+ */
+typedef struct {
+    /** Maximum number of session establishment attempts, including the first one. 0 or 1 disables the retries */
+    uint8_t max_attempts;
+    /** Delay before the first retry, doubled for each following one */
+    uint32_t initial_backoff_ms;
+    /** Upper bound of the delay between two attempts, 0 for no bound */
+    uint32_t max_backoff_ms;
+    /** Time allowed for all the attempts, counted from the first one. 0 for no deadline */
+    uint32_t deadline_ms;
+} retry_policy_t;
+
+/** Command retry statistics */
+typedef struct {
+    /** Session establishment attempts which were retried */
+    uint32_t retries;
+    /** Commands for which the session was established after at least one retry */
+    uint32_t succeeded_after_retry;
+    /** Commands dropped after the maximum number of attempts */
+    uint32_t exhausted;
+    /** Commands dropped because the next attempt would have been past the deadline */
+    uint32_t deadline_exceeded;
+} retry_stats_t;
+
+/** Set default retry policy
+ *
+ * Set the retry policy used by `connect()` and `cluster_update_fan_out()` when none is given for the command.
+ *
+ * @param[in] policy Retry policy, it is copied. NULL to disable the retries.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_retry_policy(const retry_policy_t *policy);
+
+/** Get retry statistics
+ *
+ * @param[out] stats Retry statistics.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_retry_stats(retry_stats_t *stats);
+
 /** Connect
  *
- * Connect to another device on the same fabric to send a command.
+ * Connect to another device on the same fabric to send a command. The default retry policy is applied if the
+ * connection fails.
  *
  * @param[in] case_session_mgr CASE Session Manager to find or establish the session
  * @param[in] fabric_index Fabric index.
@@ -871,6 +2662,22 @@ void binding_manager_init();
 esp_err_t connect(case_session_mgr_t *case_session_mgr, uint8_t fabric_index, uint64_t node_id,
                   command_handle_t *cmd_handle);
 
+/** Connect with retry policy
+ *
+ * Same as `connect()`, with a retry policy for this command.
+ *
+ * @param[in] case_session_mgr CASE Session Manager to find or establish the session
+ * @param[in] fabric_index Fabric index.
+ * @param[in] node_id Node ID of the other device.
+ * @param[in] cmd_handle Command to be sent to the remote device.
+ * @param[in] policy Retry policy, it is copied. NULL to disable the retries.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t connect(case_session_mgr_t *case_session_mgr, uint8_t fabric_index, uint64_t node_id,
+                  command_handle_t *cmd_handle, const retry_policy_t *policy);
+
 /** group_command_send
  *
  * on the same fabric to send a group command.
@@ -912,5 +2719,171 @@ esp_err_t set_command_callback(command_callback_t callback, group_command_callba
  */
 esp_err_t cluster_update(uint16_t local_endpoint_id, command_handle_t *cmd_handle);
 
+/** Get the binding count of a cluster
+ *
+ * Count the bindings of a local endpoint which `cluster_update()` would notify for a cluster, the bindings without
+ * cluster included. With `CONFIG_ESP_MATTER_ENABLE_BINDING_INDEX`, only the matching bindings are visited.
+ *
+ * @param[in] local_endpoint_id The ID of the local endpoint with a binding cluster.
+ * @param[in] cluster_id Cluster ID.
+ * @param[out] unicast_count Number of unicast bindings.
+ * @param[out] group_count Number of group bindings.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_binding_count(uint16_t local_endpoint_id, uint32_t cluster_id, uint16_t *unicast_count,
+                            uint16_t *group_count);
+
+/** Binding fan-out configuration */
+typedef struct {
+    /** Maximum number of sessions being established at the same time */
+    uint8_t max_concurrency;
+    /** Time allowed for each attempt to establish the session to a peer, 0 for the session setup's own timeout */
+    uint32_t peer_timeout_ms;
+    /** (Optional) Retry policy applied to each bound peer, NULL for the default one */
+    const retry_policy_t *retry_policy;
+} fan_out_config_t;
+
+/** Binding fan-out result */
+typedef struct {
+    /** Number of unicast bindings */
+    uint16_t unicast_count;
+    /** Number of group bindings, the group command send callback is called for them right away */
+    uint16_t group_count;
+    /** Unicast peers for which the command send callback has been called */
+    uint16_t succeeded;
+    /** Unicast peers which could not be connected */
+    uint16_t failed;
+    /** Unicast peers whose last attempt could not be connected within the timeout */
+    uint16_t timed_out;
+} fan_out_result_t;
+
+/** Binding fan-out completion callback
+ *
+ * @param[in] result Result of the fan-out.
+ * @param[in] priv_data Private data passed to `cluster_update_fan_out()`.
+ */
+typedef void (*fan_out_done_callback_t)(const fan_out_result_t *result, void *priv_data);
+
+/** Cluster update with parallel fan-out
+ *
+ * Like `cluster_update()`, but the sessions to the bound peers are established in parallel, up to the configured
+ * concurrency, and the command send callback is called for each peer as soon as its session is ready. Peers which
+ * do not connect within the timeout are skipped, so a single unreachable peer does not delay the others.
+ *
+ * @param[in] local_endpoint_id The ID of the local endpoint with a binding cluster.
+ * @param[in] cmd_handle Command information, the endpoint ID is set to the remote endpoint of each binding.
+ * @param[in] config Fan-out configuration.
+ * @param[in] done_callback (Optional) Callback called once all the bound peers have been handled.
+ * @param[in] priv_data (Optional) Private data passed to the completion callback.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t cluster_update_fan_out(uint16_t local_endpoint_id, command_handle_t *cmd_handle,
+                                 const fan_out_config_t *config, fan_out_done_callback_t done_callback,
+                                 void *priv_data);
+
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+/** Client session pool statistics */
+typedef struct {
+    /** `connect()` calls served from a pooled session */
+    uint32_t hits;
+    /** `connect()` calls which had to find or establish a session */
+    uint32_t misses;
+    /** Failed session establishments, including the pre-connections */
+    uint32_t failures;
+    /** Sessions dropped from the pool to make room for another peer */
+    uint32_t evictions;
+    /** Sessions dropped from the pool after the idle timeout */
+    uint32_t idle_releases;
+    /** Sessions currently in the pool */
+    uint8_t active_sessions;
+} session_pool_stats_t;
+
+/** Pre-connect bound peers
+ *
+ * Establish the CASE sessions to all the peers of the unicast bindings which are not in the session pool yet, so
+ * that the first command to them does not wait for the session setup. With
+ * `CONFIG_ESP_MATTER_CLIENT_SESSION_POOL_PRECONNECT`, this is done internally a few seconds after the binding manager
+ * is initialized.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t preconnect_bound_peers();
+
+/** Get session pool statistics
+ *
+ * @param[out] stats Session pool statistics.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_session_pool_stats(session_pool_stats_t *stats);
+#endif // CONFIG_ESP_MATTER_ENABLE_CLIENT_SESSION_POOL
+
+#if CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+/** Client address cache statistics */
+typedef struct {
+    /** Session setups which got the address of the peer from the cache, without waiting for the mDNS responses */
+    uint32_t hits;
+    /** Session setups which had to resolve the peer */
+    uint32_t misses;
+    /** Addresses dropped after a failed session setup to the peer */
+    uint32_t invalidations;
+    /** Addresses dropped at their first use after the TTL */
+    uint32_t expirations;
+    /** Addresses currently in the cache */
+    uint8_t entries;
+} address_cache_stats_t;
+
+/** Get address cache statistics
+ *
+ * @param[out] stats Address cache statistics.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_address_cache_stats(address_cache_stats_t *stats);
+#endif // CONFIG_ESP_MATTER_ENABLE_CLIENT_ADDRESS_CACHE
+
+/** Object pool statistics */
+typedef struct {
+    /** Number of statically allocated objects */
+    uint16_t size;
+    /** Objects of the pool currently in use */
+    uint16_t in_use;
+    /** Maximum number of objects of the pool used at the same time */
+    uint16_t high_water_mark;
+    /** Allocations served from the heap because the pool was exhausted */
+    uint32_t heap_fallbacks;
+} object_pool_stats_t;
+
+/** Client command pool statistics */
+typedef struct {
+    /** Command handles of `cluster_update()`, sized by `CONFIG_ESP_MATTER_CLIENT_COMMAND_POOL_SIZE` */
+    object_pool_stats_t command_handles;
+    /** Connection contexts of `connect()`, sized by `CONFIG_ESP_MATTER_CLIENT_COMMAND_POOL_SIZE` */
+    object_pool_stats_t connect_contexts;
+    /** Response callbacks of the custom commands, sized by `CONFIG_ESP_MATTER_CLIENT_COMMAND_SENDER_POOL_SIZE` */
+    object_pool_stats_t command_callbacks;
+    /** Command senders of the custom commands, sized by `CONFIG_ESP_MATTER_CLIENT_COMMAND_SENDER_POOL_SIZE` */
+    object_pool_stats_t command_senders;
+} command_pool_stats_t;
+
+/** Get command pool statistics
+ *
+ * A growing `heap_fallbacks` count means that more commands are in flight than the pools can hold, `high_water_mark`
+ * gives the size which would have been needed.
+ *
+ * @param[out] stats Command pool statistics.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_command_pool_stats(command_pool_stats_t *stats);
+
 } /* client */
 } /* esp_matter */
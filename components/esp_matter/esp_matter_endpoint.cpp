@@ -1532,7 +1532,10 @@ node_t *create(config_t *config, attribute::callback_t attribute_callback,
         return NULL;
     }
 
+#if !CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
+    /* With the hybrid data model, the root node is a fixed endpoint of the zap data model */
     endpoint::root_node::create(node, &(config->root_node), ENDPOINT_FLAG_NONE, NULL);
+#endif
 
     return node;
 }
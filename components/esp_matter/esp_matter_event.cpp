@@ -14,14 +14,25 @@
 
 #include <esp_log.h>
 #include <esp_matter_event.h>
+#include <esp_matter_mem.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
 
+#include <app-common/zap-generated/attributes/Accessors.h>
+#include <app/EventManagement.h>
 #include <app/clusters/switch-server/switch-server.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/CHIPDeviceLayer.h>
 #include <platform/DeviceControlServer.h>
 
 using chip::EndpointId;
 using chip::DeviceLayer::DeviceControlServer;
+using chip::EventNumber;
+using chip::app::PriorityLevel;
 using namespace chip::app::Clusters;
 
+static const char *TAG = "esp_matter_event";
+
 namespace esp_matter {
 namespace cluster {
 namespace access_control {
@@ -439,6 +450,263 @@ esp_err_t send_multi_press_complete(EndpointId endpoint, uint8_t new_position, u
     return ESP_OK;
 }
 
+namespace press_engine {
+
+/* Edges queued by the button callbacks for the Matter context */
+#define EDGE_QUEUE_SIZE 8
+#define PRESS_POSITION 1
+
+typedef enum state {
+    STATE_IDLE = 0,
+    STATE_PRESSED,
+    STATE_LONG_PRESSED,
+    STATE_RELEASED,
+} state_t;
+
+typedef struct edge {
+    bool pressed;
+    int64_t time_us;
+} edge_t;
+
+typedef struct engine {
+    EndpointId endpoint;
+    config_t config;
+    /* Everything below up to the edges is only accessed in the Matter context */
+    state_t state;
+    uint8_t count;
+    uint8_t multi_press_max;
+    uint32_t feature_map;
+    int64_t press_us;
+    /* Shared with the callers of press() and release() */
+    edge_t edges[EDGE_QUEUE_SIZE];
+    uint8_t edge_head;
+    uint8_t edge_count;
+    bool work_scheduled;
+    stats_t stats;
+    struct engine *next;
+} engine_t;
+
+static engine_t *s_engines = NULL;
+static portMUX_TYPE s_engine_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static engine_t *find(EndpointId endpoint)
+{
+    for (engine_t *engine = s_engines; engine; engine = engine->next) {
+        if (engine->endpoint == endpoint) {
+            return engine;
+        }
+    }
+    return NULL;
+}
+
+static bool has_feature(const engine_t *engine, uint32_t feature_id)
+{
+    return (engine->feature_map & feature_id) != 0;
+}
+
+/* Called before an event is sent, the latency is from the last press edge */
+static void count_event(engine_t *engine)
+{
+    uint32_t latency_us = (uint32_t)(esp_timer_get_time() - engine->press_us);
+    portENTER_CRITICAL(&s_engine_lock);
+    engine->stats.events++;
+    engine->stats.last_latency_us = latency_us;
+    engine->stats.total_latency_us += latency_us;
+    if (latency_us > engine->stats.max_latency_us) {
+        engine->stats.max_latency_us = latency_us;
+    }
+    portEXIT_CRITICAL(&s_engine_lock);
+}
+
+static void complete(engine_t *engine)
+{
+    count_event(engine);
+    send_multi_press_complete(engine->endpoint, PRESS_POSITION, engine->count);
+    engine->state = STATE_IDLE;
+}
+
+static void long_press_timer_cb(chip::System::Layer *layer, void *context)
+{
+    engine_t *engine = (engine_t *)context;
+    if (engine->state != STATE_PRESSED) {
+        return;
+    }
+    engine->state = STATE_LONG_PRESSED;
+    count_event(engine);
+    send_long_press(engine->endpoint, PRESS_POSITION);
+}
+
+static void multi_press_timer_cb(chip::System::Layer *layer, void *context)
+{
+    engine_t *engine = (engine_t *)context;
+    if (engine->state == STATE_RELEASED) {
+        complete(engine);
+    }
+}
+
+static void handle_press(engine_t *engine, int64_t time_us)
+{
+    engine->press_us = time_us;
+    if (engine->state == STATE_RELEASED) {
+        chip::DeviceLayer::SystemLayer().CancelTimer(multi_press_timer_cb, engine);
+        engine->count++;
+        engine->state = STATE_PRESSED;
+        Switch::Attributes::CurrentPosition::Set(engine->endpoint, PRESS_POSITION);
+        count_event(engine);
+        send_multi_press_ongoing(engine->endpoint, PRESS_POSITION, engine->count);
+        return;
+    }
+    if (engine->state != STATE_IDLE) {
+        return;
+    }
+    engine->feature_map = 0;
+    Switch::Attributes::FeatureMap::Get(engine->endpoint, &engine->feature_map);
+    engine->multi_press_max = 2;
+    Switch::Attributes::MultiPressMax::Get(engine->endpoint, &engine->multi_press_max);
+    engine->count = 1;
+    engine->state = STATE_PRESSED;
+    Switch::Attributes::CurrentPosition::Set(engine->endpoint, PRESS_POSITION);
+    count_event(engine);
+    send_initial_press(engine->endpoint, PRESS_POSITION);
+    /* Only the first press of a multi press can be a long press */
+    if (has_feature(engine, feature::momentary_switch_long_press::get_id())) {
+        chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(engine->config.long_press_ms),
+                                                    long_press_timer_cb, engine);
+    }
+}
+
+static void handle_release(engine_t *engine)
+{
+    if (engine->state == STATE_LONG_PRESSED) {
+        /* A long press ends the sequence without a multi press */
+        count_event(engine);
+        Switch::Attributes::CurrentPosition::Set(engine->endpoint, 0);
+        send_long_release(engine->endpoint, PRESS_POSITION);
+        engine->state = STATE_IDLE;
+        return;
+    }
+    if (engine->state != STATE_PRESSED) {
+        return;
+    }
+    chip::DeviceLayer::SystemLayer().CancelTimer(long_press_timer_cb, engine);
+    Switch::Attributes::CurrentPosition::Set(engine->endpoint, 0);
+    bool multi_press = has_feature(engine, feature::momentary_switch_multi_press::get_id());
+    if (has_feature(engine, feature::momentary_switch_release::get_id())) {
+        /* The long press is excluded, no need to wait for the multi press window */
+        count_event(engine);
+        send_short_release(engine->endpoint, PRESS_POSITION);
+    }
+    if (!multi_press) {
+        engine->state = STATE_IDLE;
+        return;
+    }
+    if (engine->count >= engine->multi_press_max) {
+        /* No further press can be counted */
+        complete(engine);
+        return;
+    }
+    engine->state = STATE_RELEASED;
+    chip::DeviceLayer::SystemLayer().StartTimer(
+        chip::System::Clock::Milliseconds32(engine->config.multi_press_window_ms), multi_press_timer_cb, engine);
+}
+
+static void process_edges(intptr_t arg)
+{
+    engine_t *engine = (engine_t *)arg;
+    while (true) {
+        edge_t edge;
+        portENTER_CRITICAL(&s_engine_lock);
+        if (engine->edge_count == 0) {
+            engine->work_scheduled = false;
+            portEXIT_CRITICAL(&s_engine_lock);
+            return;
+        }
+        edge = engine->edges[engine->edge_head];
+        engine->edge_head = (engine->edge_head + 1) % EDGE_QUEUE_SIZE;
+        engine->edge_count--;
+        portEXIT_CRITICAL(&s_engine_lock);
+        if (edge.pressed) {
+            handle_press(engine, edge.time_us);
+        } else {
+            handle_release(engine);
+        }
+    }
+}
+
+static esp_err_t queue_edge(EndpointId endpoint, bool pressed)
+{
+    int64_t time_us = esp_timer_get_time();
+    engine_t *engine = find(endpoint);
+    if (!engine) {
+        ESP_LOGE(TAG, "No press engine for endpoint %u", endpoint);
+        return ESP_ERR_NOT_FOUND;
+    }
+    bool schedule = false;
+    portENTER_CRITICAL(&s_engine_lock);
+    if (engine->edge_count < EDGE_QUEUE_SIZE) {
+        engine->edges[(engine->edge_head + engine->edge_count) % EDGE_QUEUE_SIZE] = {pressed, time_us};
+        engine->edge_count++;
+    }
+    if (!engine->work_scheduled) {
+        engine->work_scheduled = true;
+        schedule = true;
+    }
+    portEXIT_CRITICAL(&s_engine_lock);
+    if (schedule && chip::DeviceLayer::PlatformMgr().ScheduleWork(process_edges, (intptr_t)engine) !=
+            CHIP_NO_ERROR) {
+        portENTER_CRITICAL(&s_engine_lock);
+        engine->work_scheduled = false;
+        portEXIT_CRITICAL(&s_engine_lock);
+        ESP_LOGE(TAG, "Failed to schedule the press edges of endpoint %u", endpoint);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t add(EndpointId endpoint, const config_t *config)
+{
+    if (find(endpoint)) {
+        return ESP_OK;
+    }
+    engine_t *engine = (engine_t *)esp_matter_mem_calloc(1, sizeof(engine_t));
+    if (!engine) {
+        ESP_LOGE(TAG, "Couldn't allocate the press engine of endpoint %u", endpoint);
+        return ESP_ERR_NO_MEM;
+    }
+    engine->endpoint = endpoint;
+    engine->config = config ? *config : config_t();
+    engine->state = STATE_IDLE;
+    portENTER_CRITICAL(&s_engine_lock);
+    engine->next = s_engines;
+    s_engines = engine;
+    portEXIT_CRITICAL(&s_engine_lock);
+    return ESP_OK;
+}
+
+esp_err_t press(EndpointId endpoint)
+{
+    return queue_edge(endpoint, true);
+}
+
+esp_err_t release(EndpointId endpoint)
+{
+    return queue_edge(endpoint, false);
+}
+
+esp_err_t get_stats(EndpointId endpoint, stats_t *stats)
+{
+    engine_t *engine = find(endpoint);
+    if (!engine || !stats) {
+        return engine ? ESP_ERR_INVALID_ARG : ESP_ERR_NOT_FOUND;
+    }
+    portENTER_CRITICAL(&s_engine_lock);
+    *stats = engine->stats;
+    portEXIT_CRITICAL(&s_engine_lock);
+    return ESP_OK;
+}
+
+} // namespace press_engine
+
 } // namespace event
 } // namespace switch_cluster
 
@@ -665,4 +933,152 @@ esp_err_t send_turbine_operation()
 } // namespace pump_configuration_and_control
 
 } // namespace cluster
+
+namespace event {
+
+#if CONFIG_ESP_MATTER_ENABLE_EVENT_BUFFER_STATS
+/* One buffer per priority, in the order of the SDK cascade: debug, info and critical */
+static constexpr size_t k_buffer_count = 3;
+static constexpr size_t k_max_records = 64;
+
+typedef struct {
+    EventNumber number;
+    uint16_t size;
+    uint8_t priority;
+} event_record_t;
+
+typedef struct {
+    event_record_t records[k_max_records];
+    size_t head;
+    size_t count;
+    uint32_t capacity;
+    uint32_t bytes_used;
+    uint32_t evictions;
+} buffer_model_t;
+
+/* Only accessed with the chip stack lock held */
+static buffer_model_t s_buffers[k_buffer_count];
+static bool s_model_started = false;
+static EventNumber s_last_event_number = 0;
+static uint32_t s_bytes_written = 0;
+
+static void push_record(size_t buffer_index, const event_record_t &record)
+{
+    buffer_model_t *buffer = &s_buffers[buffer_index];
+    if (record.size > buffer->capacity) {
+        buffer->evictions++;
+        return;
+    }
+    /* Make room like the SDK does: the oldest events move to the next buffer if their priority is high enough */
+    while (buffer->count > 0 && (buffer->bytes_used + record.size > buffer->capacity || buffer->count == k_max_records)) {
+        event_record_t oldest = buffer->records[buffer->head];
+        buffer->head = (buffer->head + 1) % k_max_records;
+        buffer->count--;
+        buffer->bytes_used -= oldest.size;
+        if (buffer_index + 1 < k_buffer_count && oldest.priority > buffer_index) {
+            push_record(buffer_index + 1, oldest);
+        } else {
+            buffer->evictions++;
+        }
+    }
+    buffer->records[(buffer->head + buffer->count) % k_max_records] = record;
+    buffer->count++;
+    buffer->bytes_used += record.size;
+}
+
+/* Account the events logged since the last call, with the given priority */
+static void sync_model(PriorityLevel priority)
+{
+    EventNumber last_event_number = 0;
+    uint32_t bytes_written = 0;
+    chip::app::EventManagement::GetInstance().SetScheduledEventInfo(last_event_number, bytes_written);
+    if (!s_model_started) {
+        s_buffers[0].capacity = CHIP_DEVICE_CONFIG_EVENT_LOGGING_DEBUG_BUFFER_SIZE;
+        s_buffers[1].capacity = CHIP_DEVICE_CONFIG_EVENT_LOGGING_INFO_BUFFER_SIZE;
+        s_buffers[2].capacity = CHIP_DEVICE_CONFIG_EVENT_LOGGING_CRIT_BUFFER_SIZE;
+        s_model_started = true;
+    } else if (last_event_number > s_last_event_number) {
+        EventNumber event_count = last_event_number - s_last_event_number;
+        uint32_t bytes = bytes_written - s_bytes_written;
+        for (EventNumber index = 0; index < event_count; index++) {
+            /* Only the total is known when several events were logged, split it evenly */
+            uint32_t size = bytes / event_count + (index + 1 == event_count ? bytes % event_count : 0);
+            event_record_t record = {
+                .number = s_last_event_number + index + 1,
+                .size = (uint16_t)(size > UINT16_MAX ? UINT16_MAX : size),
+                .priority = static_cast<uint8_t>(priority),
+            };
+            push_record(0, record);
+        }
+    }
+    s_last_event_number = last_event_number;
+    s_bytes_written = bytes_written;
+}
+
+esp_err_t get_buffer_stats(PriorityLevel priority, buffer_stats_t *stats)
+{
+    if (!stats || static_cast<uint8_t>(priority) >= k_buffer_count) {
+        ESP_LOGE(TAG, "Invalid arguments");
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    sync_model(PriorityLevel::Info);
+    const buffer_model_t *buffer = &s_buffers[static_cast<uint8_t>(priority)];
+    stats->capacity = buffer->capacity;
+    stats->bytes_used = buffer->bytes_used;
+    stats->event_count = buffer->count;
+    stats->evictions = buffer->evictions;
+    stats->oldest_event_number = buffer->count > 0 ? buffer->records[buffer->head].number : 0;
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_EVENT_BUFFER_STATS
+
+esp_err_t send_batch(const batch_entry_t *entries, size_t count)
+{
+    if (!entries && count > 0) {
+        ESP_LOGE(TAG, "Entries cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+
+    /* The reporting engine only runs once the lock is released, so all the events go out in the same reporting
+     * pass. */
+#if CONFIG_ESP_MATTER_ENABLE_EVENT_BUFFER_STATS
+    sync_model(PriorityLevel::Info);
+#endif
+    esp_err_t err = ESP_OK;
+    for (size_t index = 0; index < count; index++) {
+        if (!entries[index].send) {
+            ESP_LOGE(TAG, "Send function of entry %u cannot be NULL", (unsigned)index);
+            err = ESP_ERR_INVALID_ARG;
+            continue;
+        }
+        esp_err_t entry_err = entries[index].send(entries[index].priv_data);
+        if (entry_err != ESP_OK) {
+            err = entry_err;
+        }
+#if CONFIG_ESP_MATTER_ENABLE_EVENT_BUFFER_STATS
+        sync_model(entries[index].priority);
+#endif
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+} // namespace event
 } // namespace esp_matter
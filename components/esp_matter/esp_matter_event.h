@@ -16,6 +16,8 @@
 
 #include <esp_err.h>
 #include <esp_matter.h>
+#include <app/EventLogging.h>
+#include <app/EventLoggingTypes.h>
 #include <platform/DeviceControlServer.h>
 
 namespace esp_matter {
@@ -149,6 +151,79 @@ esp_err_t send_short_release(chip::EndpointId endpoint, uint8_t previous_positio
 esp_err_t send_long_release(chip::EndpointId endpoint, uint8_t previous_position);
 esp_err_t send_multi_press_ongoing(chip::EndpointId endpoint, uint8_t new_position, uint8_t count);
 esp_err_t send_multi_press_complete(chip::EndpointId endpoint, uint8_t new_position, uint8_t count);
+
+/** Press pattern engine of a momentary switch
+ *
+ * Turns the press and release edges of a button into the events of the features of the switch cluster of the
+ * endpoint: InitialPress, ShortRelease, LongPress, LongRelease, MultiPressOngoing and MultiPressComplete. The short
+ * release is reported at the release, as the long press is excluded then, and the multi press completes at the
+ * release of the MultiPressMax-th press, without waiting for the end of the multi press window.
+ */
+namespace press_engine {
+
+typedef struct config {
+    /** Hold time after which a press is a long press, in milliseconds */
+    uint32_t long_press_ms;
+    /** Longest time between a release and the next press of a multi press, in milliseconds */
+    uint32_t multi_press_window_ms;
+    config() : long_press_ms(1000), multi_press_window_ms(400) {}
+} config_t;
+
+/** Latency from the last press to the events, in microseconds */
+typedef struct stats {
+    uint32_t events;
+    uint32_t last_latency_us;
+    uint32_t max_latency_us;
+    uint64_t total_latency_us;
+} stats_t;
+
+/** Add the engine of an endpoint with a switch cluster
+ *
+ * The features and MultiPressMax are read from the cluster when a press starts.
+ *
+ * @param[in] endpoint Endpoint of the switch.
+ * @param[in] config Timings, the defaults if NULL.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t add(chip::EndpointId endpoint, const config_t *config);
+
+/** Report a press edge
+ *
+ * Can be called from any task, for example from a button callback. The time of the edge is taken at the call, the
+ * events are sent in the Matter context at position 1.
+ *
+ * @param[in] endpoint Endpoint of the switch.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if no engine was added for the endpoint.
+ */
+esp_err_t press(chip::EndpointId endpoint);
+
+/** Report a release edge, see `press()`
+ *
+ * @param[in] endpoint Endpoint of the switch.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if no engine was added for the endpoint.
+ */
+esp_err_t release(chip::EndpointId endpoint);
+
+/** Get the latency statistics of an endpoint
+ *
+ * The latency of an event is the time from the last press edge to the event sent to the subscribers. The average is
+ * `total_latency_us / events`.
+ *
+ * @param[in] endpoint Endpoint of the switch.
+ * @param[out] stats Statistics since the engine was added.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if no engine was added for the endpoint.
+ */
+esp_err_t get_stats(chip::EndpointId endpoint, stats_t *stats);
+
+} // namespace press_engine
 } // namespace event
 } // namespace switch_cluster
 
@@ -188,4 +263,172 @@ event_t *create_turbine_operation(cluster_t *cluster);
 } // namespace pump_configuration_and_control
 
 } // namespace cluster
+
+namespace event {
+
+/** Event batch entry for `send_batch()` */
+typedef struct {
+    /** Function logging the event, for example a wrapper around one of the `cluster::<cluster>::event::send_*()`
+     * helpers or around `chip::app::LogEvent()` */
+    esp_err_t (*send)(void *priv_data);
+    /** Private data passed to the send function */
+    void *priv_data;
+    /** Priority of the event. This is only used by the event buffer statistics. */
+    chip::app::PriorityLevel priority;
+} batch_entry_t;
+
+/** Event batch send
+ *
+ * This API logs several events under a single chip stack lock. The reporting engine only runs once the lock is
+ * released, so the events go out in the same reporting pass instead of one report per event. All the entries are
+ * processed even if some of them fail.
+ *
+ * @param[in] entries Array of batch entries.
+ * @param[in] count Number of entries.
+ *
+ * @return ESP_OK on success.
+ * @return error of the last failed entry in case of failure.
+ */
+esp_err_t send_batch(const batch_entry_t *entries, size_t count);
+
+#if CONFIG_ESP_MATTER_ENABLE_EVENT_BUFFER_STATS
+/** Statistics of an event logging buffer */
+typedef struct {
+    /** Size of the buffer in bytes */
+    uint32_t capacity;
+    /** Bytes used by the events retained in the buffer */
+    uint32_t bytes_used;
+    /** Number of events retained in the buffer */
+    uint32_t event_count;
+    /** Number of events dropped from the buffer, and not moved to a higher priority buffer, since boot */
+    uint32_t evictions;
+    /** Event number of the oldest event retained in the buffer, only valid if `event_count` is not 0 */
+    chip::EventNumber oldest_event_number;
+} buffer_stats_t;
+
+/** Get event buffer statistics
+ *
+ * Get the statistics of the event logging buffer of a priority. The SDK logs every event in the debug buffer, the
+ * oldest events are moved to the info and then to the critical buffer when space is needed, if their priority is
+ * high enough, and are dropped otherwise.
+ *
+ * @note: The SDK does not expose its buffers, so the statistics come from a model of them, which starts with the first
+ * call to `send_batch()` or `get_buffer_stats()`. The event numbers and the written bytes are tracked for all the
+ * events, but the priority is only known for the events sent with `send_batch()`. The other events are accounted as
+ * info events.
+ *
+ * @param[in] priority Priority of the buffer.
+ * @param[out] stats Buffer statistics.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t get_buffer_stats(chip::app::PriorityLevel priority, buffer_stats_t *stats);
+#endif // CONFIG_ESP_MATTER_ENABLE_EVENT_BUFFER_STATS
+
+#if CONFIG_ESP_MATTER_ENABLE_EVENT_STORE
+/** Event read from the event store */
+typedef struct {
+    /** Event number given by the SDK when the event was logged */
+    chip::EventNumber number;
+    /** UTC time in seconds when the event was stored, 0 if the time was not known */
+    uint32_t timestamp_s;
+    /** Endpoint ID of the event */
+    uint16_t endpoint_id;
+    /** Cluster ID of the event */
+    uint32_t cluster_id;
+    /** Event ID */
+    uint32_t event_id;
+    /** Priority of the event */
+    chip::app::PriorityLevel priority;
+    /** Size of the payload, the event data encoded as a Matter TLV structure with an anonymous tag */
+    uint16_t payload_size;
+} stored_event_t;
+
+/** Callback for `read_stored()`, returns false to stop the read */
+typedef bool (*stored_event_callback_t)(const stored_event_t *event, const uint8_t *payload, void *priv_data);
+
+/** Store event
+ *
+ * Append an event to the flash-backed event store, which keeps the events across reboots and many more of them than
+ * the event logging buffers of the SDK. The oldest events are dropped a sector at a time when the store is full.
+ *
+ * @note: The events sent with `event::send()` are stored automatically. The events logged with
+ * `chip::app::LogEvent()`, such as the ones of the cluster servers of the SDK, are only in the buffers of the SDK.
+ *
+ * @param[in] endpoint_id Endpoint ID of the event.
+ * @param[in] cluster_id Cluster ID of the event.
+ * @param[in] event_id Event ID.
+ * @param[in] priority Priority of the event.
+ * @param[in] number Event number given by the SDK.
+ * @param[in] payload Event data encoded as a Matter TLV structure.
+ * @param[in] payload_size Size of the payload, up to CONFIG_ESP_MATTER_EVENT_STORE_MAX_PAYLOAD_SIZE.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t event_id, chip::app::PriorityLevel priority,
+                chip::EventNumber number, const uint8_t *payload, uint16_t payload_size);
+
+/** Read stored events
+ *
+ * Stream the stored events from an event number, in order. The events are read from flash one at a time, so the RAM
+ * used does not depend on the number of events. The callback runs in the calling task, which must not hold the chip
+ * stack lock if the callback needs it.
+ *
+ * @param[in] from Event number of the first event to read, 0 for the oldest one.
+ * @param[in] callback Callback called for every event.
+ * @param[in] priv_data Private data passed to the callback.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t read_stored(chip::EventNumber from, stored_event_callback_t callback, void *priv_data);
+#endif // CONFIG_ESP_MATTER_ENABLE_EVENT_STORE
+
+/** Send event
+ *
+ * Log a cluster event with `chip::app::LogEvent()`, and with CONFIG_ESP_MATTER_ENABLE_EVENT_STORE also append it to
+ * the event store. The chip stack lock is taken if it is not already held.
+ *
+ * @param[in] event_data Event data, one of the `chip::app::Clusters::<Cluster>::Events::<Event>::Type` structures.
+ * @param[in] endpoint_id Endpoint ID of the event.
+ * @param[out] event_number (Optional) Event number given by the SDK.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+template <typename T>
+esp_err_t send(const T &event_data, chip::EndpointId endpoint_id, chip::EventNumber *event_number = nullptr)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    chip::EventNumber number = 0;
+    CHIP_ERROR err = chip::app::LogEvent(event_data, endpoint_id, number);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    if (err != CHIP_NO_ERROR) {
+        return ESP_FAIL;
+    }
+    if (event_number) {
+        *event_number = number;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_EVENT_STORE
+    uint8_t payload[CONFIG_ESP_MATTER_EVENT_STORE_MAX_PAYLOAD_SIZE];
+    chip::TLV::TLVWriter writer;
+    writer.Init(payload, sizeof(payload));
+    if (event_data.Encode(writer, chip::TLV::AnonymousTag()) != CHIP_NO_ERROR || writer.Finalize() != CHIP_NO_ERROR) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return store(endpoint_id, T::GetClusterId(), T::GetEventId(), T::GetPriorityLevel(), number, payload,
+                 (uint16_t)writer.GetLengthWritten());
+#else
+    return ESP_OK;
+#endif
+}
+
+} // namespace event
 } // namespace esp_matter
@@ -314,10 +314,20 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     update_feature_map(cluster, get_id());
 
     /* Attributes not managed internally */
-    attribute::create_global_scene_control(cluster, config->global_scene_control);
-    attribute::create_on_time(cluster, config->on_time);
-    attribute::create_off_wait_time(cluster, config->off_wait_time);
-    attribute::create_start_up_on_off(cluster, config->start_up_on_off);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, global_scene_control, OnOff::Attributes::GlobalSceneControl::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_BOOLEAN, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, on_time, OnOff::Attributes::OnTime::Id,
+                                         ATTRIBUTE_FLAG_WRITABLE | ATTRIBUTE_FLAG_NULLABLE,
+                                         ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, off_wait_time, OnOff::Attributes::OffWaitTime::Id,
+                                         ATTRIBUTE_FLAG_WRITABLE | ATTRIBUTE_FLAG_NULLABLE,
+                                         ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, start_up_on_off, OnOff::Attributes::StartUpOnOff::Id,
+                                         ATTRIBUTE_FLAG_WRITABLE | ATTRIBUTE_FLAG_NONVOLATILE | ATTRIBUTE_FLAG_NULLABLE,
+                                         ESP_MATTER_VAL_TYPE_NULLABLE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     /* Commands */
     command::create_off_with_effect(cluster);
@@ -409,10 +419,19 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     update_feature_map(cluster, get_id());
 
     /* Attributes not managed internally */
-    attribute::create_remaining_time(cluster, config->remaining_time);
-    attribute::create_min_level(cluster, config->min_level);
-    attribute::create_max_level(cluster, config->max_level);
-    attribute::create_start_up_current_level(cluster, config->start_up_current_level);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, remaining_time, LevelControl::Attributes::RemainingTime::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_level, LevelControl::Attributes::MinLevel::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT8, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_level, LevelControl::Attributes::MaxLevel::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT8, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, start_up_current_level,
+                                         LevelControl::Attributes::StartUpCurrentLevel::Id,
+                                         ATTRIBUTE_FLAG_WRITABLE | ATTRIBUTE_FLAG_NULLABLE | ATTRIBUTE_FLAG_NONVOLATILE,
+                                         ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -435,9 +454,15 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     update_feature_map(cluster, get_id());
 
     /* Attributes not managed internally */
-    attribute::create_current_frequency(cluster, config->current_frequency);
-    attribute::create_min_frequency(cluster, config->min_frequency);
-    attribute::create_max_frequency(cluster, config->max_frequency);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, current_frequency, LevelControl::Attributes::CurrentFrequency::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_frequency, LevelControl::Attributes::MinFrequency::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_frequency, LevelControl::Attributes::MaxFrequency::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     /* Commands */
     command::create_move_to_closest_frequency(cluster);
@@ -627,11 +652,22 @@ esp_err_t add(cluster_t *cluster, config_t *config)
         update_color_capability(cluster, get_id());
 
         /* Attributes not managed internally */
-        attribute::create_color_loop_active(cluster, config->color_loop_active);
-        attribute::create_color_loop_direction(cluster, config->color_loop_direction);
-        attribute::create_color_loop_time(cluster, config->color_loop_time);
-        attribute::create_color_loop_start_enhanced_hue(cluster, config->color_loop_start_enhanced_hue);
-        attribute::create_color_loop_stored_enhanced_hue(cluster, config->color_loop_stored_enhanced_hue);
+        static const attribute_desc_t config_attributes[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, color_loop_active, ColorControl::Attributes::ColorLoopActive::Id,
+                                             ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_UINT8, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, color_loop_direction,
+                                             ColorControl::Attributes::ColorLoopDirection::Id,
+                                             ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_UINT8, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, color_loop_time, ColorControl::Attributes::ColorLoopTime::Id,
+                                             ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, color_loop_start_enhanced_hue,
+                                             ColorControl::Attributes::ColorLoopStartEnhancedHue::Id,
+                                             ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, color_loop_stored_enhanced_hue,
+                                             ColorControl::Attributes::ColorLoopStoredEnhancedHue::Id,
+                                             ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        };
+        create_attributes(cluster, config_attributes, config);
 
         /* Commands */
         command::create_color_loop_set(cluster);
@@ -712,9 +748,20 @@ esp_err_t add(cluster_t *cluster, config_t *config)
 
         update_feature_map(cluster, get_id());
 
-        attribute::create_current_position_lift_percentage(cluster, config->current_position_lift_percentage);
-        attribute::create_target_position_lift_percent_100ths(cluster, config->target_position_lift_percent_100ths);
-        attribute::create_current_position_lift_percent_100ths(cluster, config->current_position_lift_percent_100ths);
+        static const attribute_desc_t config_attributes[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, current_position_lift_percentage,
+                                             WindowCovering::Attributes::CurrentPositionLiftPercentage::Id,
+                                             ATTRIBUTE_FLAG_NONVOLATILE | ATTRIBUTE_FLAG_NULLABLE,
+                                             ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, target_position_lift_percent_100ths,
+                                             WindowCovering::Attributes::TargetPositionLiftPercent100ths::Id,
+                                             ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, current_position_lift_percent_100ths,
+                                             WindowCovering::Attributes::CurrentPositionLiftPercent100ths::Id,
+                                             ATTRIBUTE_FLAG_NULLABLE | ATTRIBUTE_MASK_NONVOLATILE,
+                                             ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        };
+        create_attributes(cluster, config_attributes, config);
 
         command::create_go_to_lift_percentage(cluster);
 
@@ -763,19 +810,43 @@ esp_err_t add(cluster_t *cluster, config_t *config)
         return ESP_ERR_NOT_SUPPORTED;
     }
     if((get_feature_map_value(cluster) & abs_and_pa_lf_and_lf_feature_map) == abs_and_pa_lf_and_lf_feature_map) {
-        attribute::create_physical_closed_limit_lift(cluster, config->physical_closed_limit_lift);
-        attribute::create_current_position_lift(cluster, config->current_position_lift);
-        attribute::create_installed_open_limit_lift(cluster, config->installed_open_limit_lift);
-        attribute::create_installed_closed_limit_lift(cluster, config->installed_closed_limit_lift);
+        static const attribute_desc_t config_attributes[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, physical_closed_limit_lift,
+                                             WindowCovering::Attributes::PhysicalClosedLimitLift::Id,
+                                             ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, current_position_lift,
+                                             WindowCovering::Attributes::CurrentPositionLift::Id,
+                                             ATTRIBUTE_FLAG_NULLABLE | ATTRIBUTE_FLAG_NONVOLATILE,
+                                             ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, installed_open_limit_lift,
+                                             WindowCovering::Attributes::InstalledOpenLimitLift::Id,
+                                             ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, installed_closed_limit_lift,
+                                             WindowCovering::Attributes::InstalledClosedLimitLift::Id,
+                                             ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        };
+        create_attributes(cluster, config_attributes, config);
     } else {
         ESP_LOGW(TAG, "Lift related attributes were not created because cluster does not support Position_Aware_Lift feature");
     }
 
     if((get_feature_map_value(cluster) & abs_and_pa_tl_and_tl_feature_map) == abs_and_pa_tl_and_tl_feature_map) {
-        attribute::create_physical_closed_limit_tilt(cluster, config->physical_closed_limit_tilt);
-        attribute::create_current_position_tilt(cluster, config->current_position_tilt);
-        attribute::create_installed_open_limit_tilt(cluster, config->installed_open_limit_tilt);
-        attribute::create_installed_closed_limit_tilt(cluster, config->installed_closed_limit_tilt);
+        static const attribute_desc_t config_attributes_2[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, physical_closed_limit_tilt,
+                                             WindowCovering::Attributes::PhysicalClosedLimitTilt::Id,
+                                             ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, current_position_tilt,
+                                             WindowCovering::Attributes::CurrentPositionTilt::Id,
+                                             ATTRIBUTE_FLAG_NULLABLE | ATTRIBUTE_FLAG_NONVOLATILE,
+                                             ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, installed_open_limit_tilt,
+                                             WindowCovering::Attributes::InstalledOpenLimitTilt::Id,
+                                             ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, installed_closed_limit_tilt,
+                                             WindowCovering::Attributes::InstalledClosedLimitTilt::Id,
+                                             ATTRIBUTE_FLAG_NONVOLATILE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        };
+        create_attributes(cluster, config_attributes_2, config);
     } else {
         ESP_LOGW(TAG, "Tilt related attributes were not created because cluster does not support Position_Aware_Tilt feature");
     }
@@ -816,9 +887,20 @@ esp_err_t add(cluster_t *cluster, config_t *config)
 
         update_feature_map(cluster, get_id());
 
-        attribute::create_current_position_tilt_percentage(cluster, config->current_position_tilt_percentage);
-        attribute::create_target_position_tilt_percent_100ths(cluster, config->target_position_tilt_percent_100ths);
-        attribute::create_current_position_tilt_percent_100ths(cluster, config->current_position_tilt_percent_100ths);
+        static const attribute_desc_t config_attributes[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, current_position_tilt_percentage,
+                                             WindowCovering::Attributes::CurrentPositionTiltPercentage::Id,
+                                             ATTRIBUTE_FLAG_NONVOLATILE | ATTRIBUTE_FLAG_NULLABLE,
+                                             ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, target_position_tilt_percent_100ths,
+                                             WindowCovering::Attributes::TargetPositionTiltPercent100ths::Id,
+                                             ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, current_position_tilt_percent_100ths,
+                                             WindowCovering::Attributes::CurrentPositionTiltPercent100ths::Id,
+                                             ATTRIBUTE_FLAG_NULLABLE | ATTRIBUTE_MASK_NONVOLATILE,
+                                             ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        };
+        create_attributes(cluster, config_attributes, config);
 
         command::create_go_to_tilt_percentage(cluster);
 
@@ -1064,11 +1146,24 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_measured_value(cluster, config->measured_value);
-    attribute::create_min_measured_value(cluster, config->min_measured_value);
-    attribute::create_max_measured_value(cluster, config->max_measured_value);
-    attribute::create_uncertainty(cluster, config->uncertainty);
-    attribute::create_measurement_unit(cluster, config->measurement_unit);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, uncertainty,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measurement_unit,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -1205,11 +1300,24 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_measured_value(cluster, config->measured_value);
-    attribute::create_min_measured_value(cluster, config->min_measured_value);
-    attribute::create_max_measured_value(cluster, config->max_measured_value);
-    attribute::create_uncertainty(cluster, config->uncertainty);
-    attribute::create_measurement_unit(cluster, config->measurement_unit);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, uncertainty,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measurement_unit,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -1346,11 +1454,24 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_measured_value(cluster, config->measured_value);
-    attribute::create_min_measured_value(cluster, config->min_measured_value);
-    attribute::create_max_measured_value(cluster, config->max_measured_value);
-    attribute::create_uncertainty(cluster, config->uncertainty);
-    attribute::create_measurement_unit(cluster, config->measurement_unit);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, uncertainty,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measurement_unit,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -1487,11 +1608,24 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_measured_value(cluster, config->measured_value);
-    attribute::create_min_measured_value(cluster, config->min_measured_value);
-    attribute::create_max_measured_value(cluster, config->max_measured_value);
-    attribute::create_uncertainty(cluster, config->uncertainty);
-    attribute::create_measurement_unit(cluster, config->measurement_unit);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, uncertainty,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measurement_unit,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -1628,11 +1762,24 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_measured_value(cluster, config->measured_value);
-    attribute::create_min_measured_value(cluster, config->min_measured_value);
-    attribute::create_max_measured_value(cluster, config->max_measured_value);
-    attribute::create_uncertainty(cluster, config->uncertainty);
-    attribute::create_measurement_unit(cluster, config->measurement_unit);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, uncertainty,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measurement_unit,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -1769,11 +1916,24 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_measured_value(cluster, config->measured_value);
-    attribute::create_min_measured_value(cluster, config->min_measured_value);
-    attribute::create_max_measured_value(cluster, config->max_measured_value);
-    attribute::create_uncertainty(cluster, config->uncertainty);
-    attribute::create_measurement_unit(cluster, config->measurement_unit);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, uncertainty,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measurement_unit,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -1910,11 +2070,24 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_measured_value(cluster, config->measured_value);
-    attribute::create_min_measured_value(cluster, config->min_measured_value);
-    attribute::create_max_measured_value(cluster, config->max_measured_value);
-    attribute::create_uncertainty(cluster, config->uncertainty);
-    attribute::create_measurement_unit(cluster, config->measurement_unit);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, uncertainty,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measurement_unit,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -2051,11 +2224,24 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_measured_value(cluster, config->measured_value);
-    attribute::create_min_measured_value(cluster, config->min_measured_value);
-    attribute::create_max_measured_value(cluster, config->max_measured_value);
-    attribute::create_uncertainty(cluster, config->uncertainty);
-    attribute::create_measurement_unit(cluster, config->measurement_unit);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, uncertainty,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measurement_unit,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -2192,11 +2378,24 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_measured_value(cluster, config->measured_value);
-    attribute::create_min_measured_value(cluster, config->min_measured_value);
-    attribute::create_max_measured_value(cluster, config->max_measured_value);
-    attribute::create_uncertainty(cluster, config->uncertainty);
-    attribute::create_measurement_unit(cluster, config->measurement_unit);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, min_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, max_measured_value,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, uncertainty,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_UINT16, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, measurement_unit,
+                                         CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
@@ -2669,9 +2868,15 @@ esp_err_t add(cluster_t *cluster)
 
     update_feature_map(cluster, get_id());
 
-    attribute::create_smoke_state(cluster, 0);
-    attribute::create_contamination_state(cluster, 0);
-    attribute::create_smoke_sensitivity_level(cluster, 0);
+    static const attribute_desc_t internal_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_VALUE(SmokeCoAlarm::Attributes::SmokeState::Id, ATTRIBUTE_FLAG_NONVOLATILE,
+                                        ESP_MATTER_VAL_TYPE_ENUM8, 0, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_VALUE(SmokeCoAlarm::Attributes::ContaminationState::Id, ATTRIBUTE_FLAG_NONE,
+                                        ESP_MATTER_VAL_TYPE_ENUM8, 0, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_VALUE(SmokeCoAlarm::Attributes::SmokeSensitivityLevel::Id, ATTRIBUTE_FLAG_WRITABLE,
+                                        ESP_MATTER_VAL_TYPE_ENUM8, 0, NULL),
+    };
+    create_attributes(cluster, internal_attributes, NULL);
 
     event::create_smoke_alarm(cluster);
     event::create_interconnect_smoke_alarm(cluster);
@@ -2794,9 +2999,19 @@ esp_err_t add(cluster_t *cluster, config_t *config)
 
     if((get_feature_map_value(cluster) & occ_and_sb_feature_map) == occ_and_sb_feature_map) {
 
-        attribute::create_unoccupied_setback(cluster, config->unoccupied_setback);
-        attribute::create_unoccupied_setback_min(cluster, config->unoccupied_setback_min);
-        attribute::create_unoccupied_setback_max(cluster, config->unoccupied_setback_max);
+        static const attribute_desc_t config_attributes[] = {
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, unoccupied_setback,
+                                             Thermostat::Attributes::UnoccupiedSetback::Id,
+                                             ATTRIBUTE_FLAG_NULLABLE | ATTRIBUTE_FLAG_NONVOLATILE | ATTRIBUTE_FLAG_WRITABLE,
+                                             ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, unoccupied_setback_min,
+                                             Thermostat::Attributes::UnoccupiedSetbackMin::Id, ATTRIBUTE_FLAG_NULLABLE,
+                                             ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+            ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, unoccupied_setback_max,
+                                             Thermostat::Attributes::UnoccupiedSetbackMax::Id, ATTRIBUTE_FLAG_NULLABLE,
+                                             ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+        };
+        create_attributes(cluster, config_attributes, config);
     }
 
     return ESP_OK;
@@ -2820,9 +3035,17 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_start_of_week(cluster, config->start_of_week);
-    attribute::create_number_of_weekly_transitions(cluster, config->number_of_weekly_transitions);
-    attribute::create_number_of_daily_transitions(cluster, config->number_of_daily_transitions);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, start_of_week, Thermostat::Attributes::StartOfWeek::Id,
+                                         ATTRIBUTE_FLAG_NONE, ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, number_of_weekly_transitions,
+                                         Thermostat::Attributes::NumberOfWeeklyTransitions::Id, ATTRIBUTE_FLAG_NONE,
+                                         ESP_MATTER_VAL_TYPE_UINT8, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, number_of_daily_transitions,
+                                         Thermostat::Attributes::NumberOfDailyTransitions::Id, ATTRIBUTE_FLAG_NONE,
+                                         ESP_MATTER_VAL_TYPE_ENUM8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     command::create_set_weekly_schedule(cluster);
     command::create_get_weekly_schedule(cluster);
@@ -2850,9 +3073,16 @@ esp_err_t add(cluster_t *cluster, config_t *config)
     }
     update_feature_map(cluster, get_id());
 
-    attribute::create_occupied_setback(cluster, config->occupied_setback);
-    attribute::create_occupied_setback_min(cluster, config->occupied_setback_min);
-    attribute::create_occupied_setback_max(cluster, config->occupied_setback_max);
+    static const attribute_desc_t config_attributes[] = {
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, occupied_setback, Thermostat::Attributes::OccupiedSetback::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE | ATTRIBUTE_FLAG_NONVOLATILE | ATTRIBUTE_FLAG_WRITABLE,
+                                         ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, occupied_setback_min, Thermostat::Attributes::OccupiedSetbackMin::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+        ESP_MATTER_ATTRIBUTE_DESC_CONFIG(config_t, occupied_setback_max, Thermostat::Attributes::OccupiedSetbackMax::Id,
+                                         ATTRIBUTE_FLAG_NULLABLE, ESP_MATTER_VAL_TYPE_NULLABLE_UINT8, NULL),
+    };
+    create_attributes(cluster, config_attributes, config);
 
     return ESP_OK;
 }
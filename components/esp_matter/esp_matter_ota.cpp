@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <esp_log.h>
+#include <esp_timer.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <app/clusters/ota-requestor/BDXDownloader.h>
@@ -22,6 +24,8 @@
 #include <platform/ESP32/OTAImageProcessorImpl.h>
 
 #include <esp_matter.h>
+#include <esp_matter_ota_image_processor.h>
+#include <esp_matter_ota_stats.h>
 #include <zap-generated/endpoint_config.h>
 
 using chip::BDXDownloader;
@@ -41,6 +45,256 @@ DefaultOTARequestorStorage gRequestorStorage;
 DefaultOTARequestorDriver gRequestorUser;
 BDXDownloader gDownloader;
 OTAImageProcessorImpl gImageProcessor;
+#if CONFIG_ESP_MATTER_OTA_IMAGE_PROCESSOR
+esp_matter::ota::StreamingOTAImageProcessor gStreamingImageProcessor;
+#endif
+
+#if CONFIG_ESP_MATTER_OTA_PIPELINED_DOWNLOAD || CONFIG_ESP_MATTER_OTA_BENCHMARK
+#define OTA_PROXY_IMAGE_PROCESSOR 1
+#if CONFIG_ESP_MATTER_OTA_PIPELINED_DOWNLOAD
+#define OTA_PIPELINE_DEPTH CONFIG_ESP_MATTER_OTA_PIPELINE_DEPTH
+#else
+#define OTA_PIPELINE_DEPTH 1
+#endif
+
+static const char *TAG = "esp_matter_ota";
+
+/*
+ * The image processors write a block to flash in the Matter context and only then ask the downloader for the next
+ * one, so the BDX round trip and the flash write add up. The proxy processor sits between the downloader and the
+ * image processor. With the pipelined download, the next block is requested as soon as a block is received, and the
+ * blocks received while the previous one is still being written are held in OTA_PIPELINE_DEPTH - 1 buffers until
+ * the image processor is done with them. BDX allows a single block request in flight, so the depth only absorbs the
+ * slower writes, such as the ones erasing a sector. With the benchmark, the reception and the processing of each
+ * block are timed.
+ *
+ * The image processor is given the proxy downloader below, its FetchNextData() marks the end of the processing of a
+ * block. All the calls happen in the Matter context.
+ */
+class ProxyOTAImageProcessor;
+
+class ProxyOTADownloader : public chip::OTADownloader
+{
+public:
+    void Init(ProxyOTAImageProcessor *processor, chip::OTADownloader *downloader)
+    {
+        mProcessor = processor;
+        mDownloader = downloader;
+    }
+    CHIP_ERROR BeginPrepareDownload() override { return mDownloader->BeginPrepareDownload(); }
+    CHIP_ERROR OnPreparedForDownload(CHIP_ERROR status) override { return mDownloader->OnPreparedForDownload(status); }
+    void OnDownloadTimeout() override { mDownloader->OnDownloadTimeout(); }
+    void EndDownload(CHIP_ERROR reason = CHIP_NO_ERROR) override;
+    CHIP_ERROR FetchNextData() override;
+    CHIP_ERROR SkipData(uint32_t numBytes) override { return mDownloader->SkipData(numBytes); }
+
+private:
+    ProxyOTAImageProcessor *mProcessor = nullptr;
+    chip::OTADownloader *mDownloader = nullptr;
+};
+
+class ProxyOTAImageProcessor : public chip::OTAImageProcessorInterface
+{
+public:
+    void Init(chip::OTAImageProcessorInterface *processor, chip::OTADownloader *downloader)
+    {
+        mProcessor = processor;
+        mDownloader = downloader;
+        mProxy.Init(this, downloader);
+    }
+
+    /* Downloader to give to the image processor */
+    chip::OTADownloader *GetDownloader() { return &mProxy; }
+
+    CHIP_ERROR PrepareDownload() override
+    {
+        Reset();
+#if CONFIG_ESP_MATTER_OTA_PIPELINED_DOWNLOAD
+        mPending = (uint8_t *)malloc((OTA_PIPELINE_DEPTH - 1) * CONFIG_ESP_MATTER_OTA_MAX_BLOCK_SIZE);
+        VerifyOrReturnError(mPending, CHIP_ERROR_NO_MEMORY);
+#endif
+        mStartUs = esp_timer_get_time();
+        mRequestUs = mStartUs;
+        esp_matter::ota::stats::begin();
+        return mProcessor->PrepareDownload();
+    }
+
+    CHIP_ERROR Finalize() override
+    {
+        if (mProcessorBusy) {
+            // The last blocks are still in the pipeline, the image processor is finalized once they are written
+            mFinalizePending = true;
+            return CHIP_NO_ERROR;
+        }
+        return DoFinalize();
+    }
+
+    CHIP_ERROR Apply() override { return mProcessor->Apply(); }
+
+    CHIP_ERROR Abort() override
+    {
+        Reset();
+        return mProcessor->Abort();
+    }
+
+    CHIP_ERROR ProcessBlock(chip::ByteSpan &block) override
+    {
+        int64_t now_us = esp_timer_get_time();
+        esp_matter::ota::stats::record(esp_matter::ota::stats::STEP_RECEIVE, (uint32_t)(now_us - mRequestUs));
+        esp_matter::ota::stats::block_received(block.size());
+        mDownloadedBytes += block.size();
+        if (!mProcessorBusy) {
+#if CONFIG_ESP_MATTER_OTA_PIPELINED_DOWNLOAD
+            // Request the next block before the image processor schedules the write of this one, so that the
+            // request is sent first and the response is on its way while the flash is written.
+            chip::DeviceLayer::PlatformMgr().ScheduleWork(FetchNextFromDownloader, reinterpret_cast<intptr_t>(this));
+#endif
+            return StartProcessing(block);
+        }
+#if CONFIG_ESP_MATTER_OTA_PIPELINED_DOWNLOAD
+        VerifyOrReturnError(mPendingCount < OTA_PIPELINE_DEPTH - 1, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(block.size() <= CONFIG_ESP_MATTER_OTA_MAX_BLOCK_SIZE, CHIP_ERROR_BUFFER_TOO_SMALL);
+        size_t slot = (mPendingFirst + mPendingCount) % (OTA_PIPELINE_DEPTH - 1);
+        memcpy(mPending + slot * CONFIG_ESP_MATTER_OTA_MAX_BLOCK_SIZE, block.data(), block.size());
+        mPendingSizes[slot] = block.size();
+        mPendingCount++;
+        esp_matter::ota::stats::stall();
+        mStalls++;
+        if (mPendingCount < OTA_PIPELINE_DEPTH - 1) {
+            chip::DeviceLayer::PlatformMgr().ScheduleWork(FetchNextFromDownloader, reinterpret_cast<intptr_t>(this));
+        } else {
+            // All the buffers are in use, the next block is requested when the write in progress is done
+            mFetchOwed = true;
+        }
+        return CHIP_NO_ERROR;
+#else
+        return CHIP_ERROR_INCORRECT_STATE;
+#endif
+    }
+
+    bool IsFirstImageRun() override { return mProcessor->IsFirstImageRun(); }
+    CHIP_ERROR ConfirmCurrentImage() override { return mProcessor->ConfirmCurrentImage(); }
+
+    /* Called by the proxy when the image processor is done with a block */
+    CHIP_ERROR OnBlockWritten()
+    {
+        esp_matter::ota::stats::record(esp_matter::ota::stats::STEP_PROCESS,
+                                       (uint32_t)(esp_timer_get_time() - mProcessStartUs));
+        mProcessorBusy = false;
+#if CONFIG_ESP_MATTER_OTA_PIPELINED_DOWNLOAD
+        if (mPendingCount > 0) {
+            size_t slot = mPendingFirst;
+            chip::ByteSpan block(mPending + slot * CONFIG_ESP_MATTER_OTA_MAX_BLOCK_SIZE, mPendingSizes[slot]);
+            mPendingFirst = (mPendingFirst + 1) % (OTA_PIPELINE_DEPTH - 1);
+            mPendingCount--;
+            // The image processor copies the block, its buffer can be reused once this returns
+            ReturnErrorOnFailure(StartProcessing(block));
+            if (mFetchOwed) {
+                mFetchOwed = false;
+                return FetchNext();
+            }
+            return CHIP_NO_ERROR;
+        }
+#endif
+        if (mFinalizePending) {
+            mFinalizePending = false;
+            return DoFinalize();
+        }
+#if !CONFIG_ESP_MATTER_OTA_PIPELINED_DOWNLOAD
+        return FetchNext();
+#else
+        return CHIP_NO_ERROR;
+#endif
+    }
+
+    void Reset()
+    {
+        free(mPending);
+        mPending = nullptr;
+        mPendingFirst = 0;
+        mPendingCount = 0;
+        mProcessorBusy = false;
+        mFetchOwed = false;
+        mFinalizePending = false;
+        mDownloadedBytes = 0;
+        mStalls = 0;
+    }
+
+private:
+    CHIP_ERROR StartProcessing(chip::ByteSpan &block)
+    {
+        mProcessorBusy = true;
+        mProcessStartUs = esp_timer_get_time();
+        CHIP_ERROR err = mProcessor->ProcessBlock(block);
+        if (err != CHIP_NO_ERROR) {
+            mProcessorBusy = false;
+        }
+        return err;
+    }
+
+    CHIP_ERROR FetchNext()
+    {
+        mRequestUs = esp_timer_get_time();
+        return mDownloader->FetchNextData();
+    }
+
+    static void FetchNextFromDownloader(intptr_t context)
+    {
+        // This fails once the last block has been received, there is nothing left to fetch
+        (void)reinterpret_cast<ProxyOTAImageProcessor *>(context)->FetchNext();
+    }
+
+    CHIP_ERROR DoFinalize()
+    {
+        int64_t elapsed_ms = (esp_timer_get_time() - mStartUs) / 1000;
+        ESP_LOGI(TAG, "OTA image downloaded: %llu bytes in %lld ms, %llu B/s, %lu blocks waited for a flash write",
+                 (unsigned long long)mDownloadedBytes, elapsed_ms,
+                 elapsed_ms > 0 ? (unsigned long long)(mDownloadedBytes * 1000 / elapsed_ms) : 0ULL,
+                 (unsigned long)mStalls);
+        esp_matter::ota::stats::end();
+        free(mPending);
+        mPending = nullptr;
+        return mProcessor->Finalize();
+    }
+
+    chip::OTAImageProcessorInterface *mProcessor = nullptr;
+    chip::OTADownloader *mDownloader = nullptr;
+    ProxyOTADownloader mProxy;
+    /* Ring of the blocks received while the image processor writes the previous one */
+    uint8_t *mPending = nullptr;
+    size_t mPendingSizes[OTA_PIPELINE_DEPTH];
+    size_t mPendingFirst = 0;
+    size_t mPendingCount = 0;
+    /* The image processor holds a block it has not written yet */
+    bool mProcessorBusy = false;
+    /* The next block has not been requested because all the buffers were in use */
+    bool mFetchOwed = false;
+    bool mFinalizePending = false;
+    int64_t mStartUs = 0;
+    int64_t mRequestUs = 0;
+    int64_t mProcessStartUs = 0;
+    uint64_t mDownloadedBytes = 0;
+    uint32_t mStalls = 0;
+};
+
+void ProxyOTADownloader::EndDownload(CHIP_ERROR reason)
+{
+    mProcessor->Reset();
+    mDownloader->EndDownload(reason);
+}
+
+CHIP_ERROR ProxyOTADownloader::FetchNextData()
+{
+    CHIP_ERROR err = mProcessor->OnBlockWritten();
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to process the buffered OTA block: %" CHIP_ERROR_FORMAT, err.Format());
+        EndDownload(err);
+    }
+    return err;
+}
+
+ProxyOTAImageProcessor gProxyImageProcessor;
+#endif // CONFIG_ESP_MATTER_OTA_PIPELINED_DOWNLOAD || CONFIG_ESP_MATTER_OTA_BENCHMARK
 #endif
 
 esp_err_t esp_matter_ota_requestor_init(void)
@@ -74,9 +328,24 @@ void esp_matter_ota_requestor_start(void)
     chip::SetRequestorInstance(&gRequestorCore);
     gRequestorStorage.Init(Server::GetInstance().GetPersistentStorage());
     gRequestorCore.Init(Server::GetInstance(), gRequestorStorage, gRequestorUser, gDownloader);
-    gImageProcessor.SetOTADownloader(&gDownloader);
-    gDownloader.SetImageProcessorDelegate(&gImageProcessor);
-    gRequestorUser.Init(&gRequestorCore, &gImageProcessor);
+#if CONFIG_ESP_MATTER_OTA_IMAGE_PROCESSOR
+    esp_matter::ota::StreamingOTAImageProcessor &image_processor = gStreamingImageProcessor;
+#else
+    OTAImageProcessorImpl &image_processor = gImageProcessor;
+#endif
+#if OTA_PROXY_IMAGE_PROCESSOR
+    gProxyImageProcessor.Init(&image_processor, &gDownloader);
+    image_processor.SetOTADownloader(gProxyImageProcessor.GetDownloader());
+    gDownloader.SetImageProcessorDelegate(&gProxyImageProcessor);
+    gRequestorUser.Init(&gRequestorCore, &gProxyImageProcessor);
+#else
+    image_processor.SetOTADownloader(&gDownloader);
+    gDownloader.SetImageProcessorDelegate(&image_processor);
+    gRequestorUser.Init(&gRequestorCore, &image_processor);
+#endif
+    // The block size is proposed by the requestor in the BDX ReceiveInit, the provider may choose a smaller one
+    gRequestorUser.SetMaxDownloadBlockSize(CONFIG_ESP_MATTER_OTA_MAX_BLOCK_SIZE);
+    esp_matter::ota::stats::register_console_commands();
 #endif
 }
 
@@ -84,7 +353,12 @@ void esp_matter_ota_requestor_start(void)
 esp_err_t esp_matter_ota_requestor_encrypted_init(const char *key, uint16_t size)
 {
     VerifyOrReturnError(key != nullptr, ESP_ERR_INVALID_ARG);
+#if CONFIG_ESP_MATTER_OTA_IMAGE_PROCESSOR
+    VerifyOrReturnError(gStreamingImageProcessor.InitEncryptedOTA(chip::CharSpan{key, size}) == CHIP_NO_ERROR,
+                        ESP_ERR_INVALID_STATE);
+#else
     VerifyOrReturnError(gImageProcessor.InitEncryptedOTA(chip::CharSpan{key, size}) == CHIP_NO_ERROR, ESP_ERR_INVALID_STATE);
+#endif
     return ESP_OK;
 }
 #endif // CONFIG_ENABLE_ENCRYPTED_OTA
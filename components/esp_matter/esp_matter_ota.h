@@ -40,3 +40,46 @@ void esp_matter_ota_requestor_start(void);
 #if CONFIG_ENABLE_ENCRYPTED_OTA
 esp_err_t esp_matter_ota_requestor_encrypted_init(const char *key, uint16_t size);
 #endif // CONFIG_ENABLE_ENCRYPTED_OTA
+
+#if CONFIG_ESP_MATTER_OTA_BENCHMARK
+/** Statistics of the last OTA download */
+typedef struct {
+    /** The download completed, the image was handed to the image processor for finalization */
+    bool complete;
+    /** Largest block received, the block size negotiated with the OTA provider */
+    uint16_t block_size;
+    /** Blocks and bytes received, the Matter OTA image header included */
+    uint32_t blocks;
+    uint64_t bytes;
+    /** Time from the preparation of the download to the last block written, and the resulting throughput */
+    uint32_t duration_ms;
+    uint32_t throughput_bytes_per_sec;
+    /** Time from the request of a block to its reception */
+    uint32_t receive_avg_us;
+    uint32_t receive_max_us;
+    /** Blocks received later than the MRP retransmission interval after their request, most likely retransmitted */
+    uint32_t slow_blocks;
+    /** Time from the reception of a block to the end of its processing by the image processor */
+    uint32_t process_avg_us;
+    uint32_t process_max_us;
+    /** Time spent in the flash writes and the decryption, per block. Only measured by the esp_matter image processor,
+     * enabled by the delta or compressed OTA images, 0 otherwise. */
+    uint32_t flash_write_avg_us;
+    uint32_t flash_write_max_us;
+    uint32_t decrypt_avg_us;
+    uint32_t decrypt_max_us;
+    /** Blocks which waited for the previous block to be written, with the pipelined download */
+    uint32_t stalls;
+} esp_matter_ota_download_stats_t;
+
+/**
+ * @brief Get the statistics of the last OTA download, or of the download in progress
+ *
+ * The statistics are also printed by the "matter esp ota stats" console command.
+ *
+ * @param[out] stats Download statistics.
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if no download was started since boot.
+ */
+esp_err_t esp_matter_ota_get_download_stats(esp_matter_ota_download_stats_t *stats);
+#endif // CONFIG_ESP_MATTER_OTA_BENCHMARK
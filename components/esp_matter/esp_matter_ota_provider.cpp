@@ -0,0 +1,761 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_partition.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <esp_matter.h>
+#include <esp_matter_ota_provider.h>
+
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_ENABLE
+#include <app/CommandHandler.h>
+#include <app/clusters/ota-provider/ota-provider-delegate.h>
+#include <app/clusters/ota-provider/ota-provider.h>
+#include <app/server/Server.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/OTAImageHeader.h>
+#include <protocols/bdx/BdxUri.h>
+#include <protocols/bdx/TransferFacilitator.h>
+#include <zap-generated/endpoint_config.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+using chip::ByteSpan;
+using chip::CharSpan;
+using chip::ScopedNodeId;
+using chip::Server;
+using chip::app::CommandHandler;
+using chip::app::ConcreteCommandPath;
+using chip::bdx::TransferControlFlags;
+using chip::bdx::TransferRole;
+using chip::bdx::TransferSession;
+using chip::Messaging::ExchangeDelegate;
+using chip::Messaging::SendFlags;
+using chip::Messaging::SendMessageFlags;
+using namespace chip::app::Clusters::OtaSoftwareUpdateProvider;
+
+static const char *TAG = "esp_matter_ota_provider";
+
+/*
+ * OTA provider serving one image to several requestors at once. The image is mapped from its flash partition, so the
+ * blocks are given to the BDX transfers straight from the mapping, without a read buffer per transfer. Each transfer
+ * is a BDX responder of a pool, handed the ReceiveInit of a requestor by the unsolicited message handler below. The
+ * QueryImage commands reserve a transfer for the requestor, and the requestors querying while all the transfers are
+ * in use or reserved are told to query again after CONFIG_ESP_MATTER_OTA_PROVIDER_BUSY_DELAY_SEC. All the calls
+ * happen in the Matter context.
+ */
+
+/* BDX protocol timeout of a transfer, and polling of its output */
+static constexpr uint32_t k_bdx_timeout_ms = 5 * 60 * 1000;
+static constexpr uint32_t k_bdx_poll_interval_ms = 20;
+/* Time given to a requestor to start the transfer after its QueryImage */
+static constexpr int64_t k_reservation_timeout_us = 30 * 1000 * 1000;
+static constexpr size_t k_max_sessions = CONFIG_ESP_MATTER_OTA_PROVIDER_MAX_SESSIONS;
+
+typedef struct {
+    bool valid;
+    uint16_t vendor_id;
+    uint16_t product_id;
+    uint32_t software_version;
+    char software_version_string[65];
+    uint32_t min_applicable_version;
+    uint32_t max_applicable_version;
+    /* Matter OTA image header included */
+    uint32_t size;
+} image_info_t;
+
+typedef struct {
+    uint64_t node_id;
+    uint8_t fabric_index;
+    int64_t expiry_us;
+} reservation_t;
+
+static esp_matter_ota_provider_config_t s_config;
+static uint16_t s_endpoint_id = chip::kInvalidEndpointId;
+static bool s_started = false;
+static const esp_partition_t *s_partition = nullptr;
+static const uint8_t *s_image = nullptr;
+static esp_partition_mmap_handle_t s_mmap_handle;
+static image_info_t s_image_info;
+static reservation_t s_reservations[k_max_sessions];
+static esp_matter_ota_provider_stats_t s_stats;
+
+static size_t count_sessions();
+static size_t count_reservations(int64_t now_us);
+static bool take_reservation(uint64_t node_id, uint8_t fabric_index);
+
+class OTABdxSession : public chip::bdx::Responder
+{
+public:
+    bool IsActive() const { return mActive; }
+
+    CHIP_ERROR Prepare()
+    {
+        mActive = true;
+        mAccepted = false;
+        mPacing = false;
+        mOffset = 0;
+        mBytesSent = 0;
+        return PrepareForTransfer(&chip::DeviceLayer::SystemLayer(), TransferRole::kSender,
+                                  chip::BitFlags<TransferControlFlags>(TransferControlFlags::kReceiverDrive),
+                                  CONFIG_ESP_MATTER_OTA_PROVIDER_MAX_BLOCK_SIZE,
+                                  chip::System::Clock::Milliseconds32(k_bdx_timeout_ms),
+                                  chip::System::Clock::Milliseconds32(k_bdx_poll_interval_ms));
+    }
+
+    void GetInfo(esp_matter_ota_provider_session_t *info) const
+    {
+        uint32_t elapsed_ms = GetElapsedMs();
+        info->node_id = mPeer.GetNodeId();
+        info->fabric_index = mPeer.GetFabricIndex();
+        info->offset = mOffset;
+        info->image_size = s_image_info.size;
+        info->elapsed_ms = elapsed_ms;
+        info->throughput_bytes_per_sec = elapsed_ms > 0 ? (uint32_t)(mBytesSent * 1000 / elapsed_ms) : 0;
+    }
+
+    bool IsTransferring() const { return mActive && mAccepted; }
+
+private:
+    void HandleTransferSessionOutput(TransferSession::OutputEvent &event) override
+    {
+        switch (event.EventType) {
+        case TransferSession::OutputEventType::kNone:
+            break;
+        case TransferSession::OutputEventType::kMsgToSend:
+            SendOutput(event);
+            break;
+        case TransferSession::OutputEventType::kInitReceived:
+            HandleInit(event);
+            break;
+        case TransferSession::OutputEventType::kQueryWithSkipReceived:
+            mOffset += (uint32_t)std::min<uint64_t>(event.bytesToSkip.BytesToSkip, s_image_info.size - mOffset);
+            QueueBlock();
+            break;
+        case TransferSession::OutputEventType::kQueryReceived:
+            QueueBlock();
+            break;
+        case TransferSession::OutputEventType::kAckReceived:
+            break;
+        case TransferSession::OutputEventType::kAckEOFReceived:
+            ESP_LOGI(TAG, "Image sent to node 0x%" PRIX64 ": %" PRIu32 " bytes in %" PRIu32 " ms",
+                     mPeer.GetNodeId(), mBytesSent, GetElapsedMs());
+            s_stats.transfers_completed++;
+            Release();
+            break;
+        case TransferSession::OutputEventType::kStatusReceived:
+            ESP_LOGE(TAG, "Transfer aborted by node 0x%" PRIX64 ", status 0x%04x", mPeer.GetNodeId(),
+                     (unsigned)event.statusData.statusCode);
+            Fail();
+            break;
+        case TransferSession::OutputEventType::kInternalError:
+        case TransferSession::OutputEventType::kTransferTimeout:
+            ESP_LOGE(TAG, "Transfer to node 0x%" PRIX64 " failed, %s", mPeer.GetNodeId(),
+                     event.EventType == TransferSession::OutputEventType::kTransferTimeout ? "timeout"
+                                                                                         : "internal error");
+            Fail();
+            break;
+        default:
+            /* A sender receives no Accept or Block message */
+            ESP_LOGE(TAG, "Unexpected BDX event %d", (int)event.EventType);
+            Fail();
+            break;
+        }
+    }
+
+    void SendOutput(TransferSession::OutputEvent &event)
+    {
+        bool status_report = event.msgTypeData.HasMessageType(chip::Protocols::SecureChannel::MsgType::StatusReport);
+        SendFlags flags;
+        /* All the messages of the sender expect a response, except the status report ending the transfer */
+        if (!status_report) {
+            flags.Set(SendMessageFlags::kExpectResponse);
+        }
+        if (!mExchangeCtx) {
+            Fail();
+            return;
+        }
+        CHIP_ERROR err = mExchangeCtx->SendMessage(event.msgTypeData.ProtocolId, event.msgTypeData.MessageType,
+                                                   std::move(event.MsgData), flags);
+        if (err != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to send a BDX message: %" CHIP_ERROR_FORMAT, err.Format());
+            Fail();
+        } else if (status_report) {
+            /* The exchange is closed by the message sent without response */
+            mExchangeCtx = nullptr;
+            Fail();
+        }
+    }
+
+    void HandleInit(TransferSession::OutputEvent &event)
+    {
+        mPeer = mExchangeCtx ? mExchangeCtx->GetSessionHandle()->GetPeer() : ScopedNodeId();
+        const char *designator = s_config.partition_label;
+        if (event.transferInitData.FileDesLength != strlen(designator) ||
+            memcmp(event.transferInitData.FileDesignator, designator, strlen(designator)) != 0) {
+            ESP_LOGE(TAG, "Unknown file designator from node 0x%" PRIX64, mPeer.GetNodeId());
+            mTransfer.AbortTransfer(chip::bdx::StatusCode::kFileDesignatorUnknown);
+            return;
+        }
+        if (!s_image_info.valid || mTransfer.GetStartOffset() >= s_image_info.size) {
+            mTransfer.AbortTransfer(chip::bdx::StatusCode::kStartOffsetNotSupported);
+            return;
+        }
+        /* The transfer of the requestor has been reserved by its QueryImage, a transfer which was not is only
+         * accepted below the limit */
+        if (!take_reservation(mPeer.GetNodeId(), mPeer.GetFabricIndex()) &&
+            count_sessions() + count_reservations(esp_timer_get_time()) >= s_config.max_sessions) {
+            ESP_LOGW(TAG, "Transfer limit reached, node 0x%" PRIX64 " refused", mPeer.GetNodeId());
+            mTransfer.AbortTransfer(chip::bdx::StatusCode::kTransferFailedUnknownError);
+            return;
+        }
+        TransferSession::TransferAcceptData accept;
+        accept.ControlMode = TransferControlFlags::kReceiverDrive;
+        accept.MaxBlockSize = mTransfer.GetTransferBlockSize();
+        accept.StartOffset = mTransfer.GetStartOffset();
+        accept.Length = mTransfer.GetTransferLength();
+        accept.Metadata = nullptr;
+        accept.MetadataLength = 0;
+        if (mTransfer.AcceptTransfer(accept) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to accept the transfer of node 0x%" PRIX64, mPeer.GetNodeId());
+            Fail();
+            return;
+        }
+        mAccepted = true;
+        mOffset = (uint32_t)mTransfer.GetStartOffset();
+        mStartUs = esp_timer_get_time();
+        mLastBlockUs = 0;
+        s_stats.transfers_started++;
+        ESP_LOGI(TAG, "Transfer to node 0x%" PRIX64 " started, blocks of %u bytes from offset %" PRIu32,
+                 mPeer.GetNodeId(), mTransfer.GetTransferBlockSize(), mOffset);
+    }
+
+    /* Sends the block queried now, or once the block interval from the previous one has elapsed */
+    void QueueBlock()
+    {
+        int64_t wait_us = 0;
+        if (s_config.block_interval_ms > 0 && mLastBlockUs > 0) {
+            wait_us = mLastBlockUs + (int64_t)s_config.block_interval_ms * 1000 - esp_timer_get_time();
+        }
+        if (wait_us <= 0) {
+            SendBlock();
+            return;
+        }
+        mPacing = true;
+        if (chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32((wait_us + 999) / 1000),
+                                                        OnPacingTimer, this) != CHIP_NO_ERROR) {
+            mPacing = false;
+            SendBlock();
+        }
+    }
+
+    static void OnPacingTimer(chip::System::Layer *layer, void *context)
+    {
+        OTABdxSession *session = static_cast<OTABdxSession *>(context);
+        session->mPacing = false;
+        session->SendBlock();
+    }
+
+    void SendBlock()
+    {
+        uint32_t remaining = s_image_info.size - mOffset;
+        uint32_t length = std::min<uint32_t>(remaining, mTransfer.GetTransferBlockSize());
+        TransferSession::BlockData block;
+        /* The block is copied from the mapped image into the message */
+        block.Data = s_image + mOffset;
+        block.Length = length;
+        block.IsEof = length == remaining;
+        if (mTransfer.PrepareBlock(block) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to prepare a block for node 0x%" PRIX64, mPeer.GetNodeId());
+            mTransfer.AbortTransfer(chip::bdx::StatusCode::kUnknown);
+            return;
+        }
+        mOffset += length;
+        mBytesSent += length;
+        s_stats.bytes_sent += length;
+        mLastBlockUs = esp_timer_get_time();
+    }
+
+    uint32_t GetElapsedMs() const
+    {
+        return mAccepted ? (uint32_t)((esp_timer_get_time() - mStartUs) / 1000) : 0;
+    }
+
+    void Fail()
+    {
+        /* The transfers refused before their start are not counted */
+        if (mAccepted) {
+            s_stats.transfers_failed++;
+        }
+        Release();
+    }
+
+    void Release()
+    {
+        if (mPacing) {
+            chip::DeviceLayer::SystemLayer().CancelTimer(OnPacingTimer, this);
+            mPacing = false;
+        }
+        ResetTransfer();
+        if (mExchangeCtx) {
+            mExchangeCtx->Close();
+            mExchangeCtx = nullptr;
+        }
+        mActive = false;
+        mAccepted = false;
+    }
+
+    bool mActive = false;
+    bool mAccepted = false;
+    bool mPacing = false;
+    ScopedNodeId mPeer;
+    uint32_t mOffset = 0;
+    uint32_t mBytesSent = 0;
+    int64_t mStartUs = 0;
+    int64_t mLastBlockUs = 0;
+};
+
+static OTABdxSession s_sessions[k_max_sessions];
+
+static size_t count_sessions()
+{
+    size_t count = 0;
+    for (size_t i = 0; i < k_max_sessions; ++i) {
+        if (s_sessions[i].IsTransferring()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static size_t count_reservations(int64_t now_us)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < k_max_sessions; ++i) {
+        if (s_reservations[i].expiry_us > now_us) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static bool reserve(uint64_t node_id, uint8_t fabric_index)
+{
+    int64_t now_us = esp_timer_get_time();
+    reservation_t *free_slot = nullptr;
+    for (size_t i = 0; i < k_max_sessions; ++i) {
+        reservation_t &reservation = s_reservations[i];
+        if (reservation.expiry_us > now_us && reservation.node_id == node_id &&
+            reservation.fabric_index == fabric_index) {
+            reservation.expiry_us = now_us + k_reservation_timeout_us;
+            return true;
+        }
+        if (reservation.expiry_us <= now_us && !free_slot) {
+            free_slot = &reservation;
+        }
+    }
+    if (!free_slot || count_sessions() + count_reservations(now_us) >= s_config.max_sessions) {
+        return false;
+    }
+    free_slot->node_id = node_id;
+    free_slot->fabric_index = fabric_index;
+    free_slot->expiry_us = now_us + k_reservation_timeout_us;
+    return true;
+}
+
+static bool take_reservation(uint64_t node_id, uint8_t fabric_index)
+{
+    int64_t now_us = esp_timer_get_time();
+    for (size_t i = 0; i < k_max_sessions; ++i) {
+        reservation_t &reservation = s_reservations[i];
+        if (reservation.expiry_us > now_us && reservation.node_id == node_id &&
+            reservation.fabric_index == fabric_index) {
+            reservation.expiry_us = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Hands the ReceiveInit of each requestor to a free transfer of the pool */
+class OTABdxServer : public chip::Messaging::UnsolicitedMessageHandler
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const chip::PayloadHeader &payloadHeader,
+                                            ExchangeDelegate *&newDelegate) override
+    {
+        for (size_t i = 0; i < k_max_sessions; ++i) {
+            if (!s_sessions[i].IsActive()) {
+                ReturnErrorOnFailure(s_sessions[i].Prepare());
+                newDelegate = &s_sessions[i];
+                return CHIP_NO_ERROR;
+            }
+        }
+        ESP_LOGW(TAG, "No BDX transfer available");
+        return CHIP_ERROR_NO_MEMORY;
+    }
+};
+
+static OTABdxServer s_bdx_server;
+
+class OTAProviderDelegate : public chip::app::Clusters::OTAProviderDelegate
+{
+public:
+    void HandleQueryImage(CommandHandler *commandObj, const ConcreteCommandPath &commandPath,
+                          const Commands::QueryImage::DecodableType &commandData) override
+    {
+        s_stats.queries++;
+        Commands::QueryImageResponse::Type response;
+        uint64_t node_id = commandObj->GetSubjectDescriptor().subject;
+        uint8_t fabric_index = commandObj->GetAccessingFabricIndex();
+
+        if (!IsApplicable(commandData)) {
+            s_stats.not_available++;
+            response.status = OTAQueryStatus::kNotAvailable;
+            commandObj->AddResponse(commandPath, response);
+            return;
+        }
+        if (!SupportsBdx(commandData)) {
+            s_stats.not_available++;
+            response.status = OTAQueryStatus::kDownloadProtocolNotSupported;
+            commandObj->AddResponse(commandPath, response);
+            return;
+        }
+        if (!reserve(node_id, fabric_index)) {
+            s_stats.busy++;
+            ESP_LOGI(TAG, "Transfers busy, node 0x%" PRIX64 " to query again in %d s", node_id,
+                     CONFIG_ESP_MATTER_OTA_PROVIDER_BUSY_DELAY_SEC);
+            response.status = OTAQueryStatus::kBusy;
+            response.delayedActionTime.SetValue(CONFIG_ESP_MATTER_OTA_PROVIDER_BUSY_DELAY_SEC);
+            commandObj->AddResponse(commandPath, response);
+            return;
+        }
+
+        const chip::FabricInfo *fabric = Server::GetInstance().GetFabricTable().FindFabricWithIndex(fabric_index);
+        char uri_buf[64];
+        chip::MutableCharSpan uri(uri_buf);
+        if (!fabric ||
+            chip::bdx::MakeURI(fabric->GetNodeId(), CharSpan::fromCharString(s_config.partition_label), uri) !=
+                CHIP_NO_ERROR) {
+            take_reservation(node_id, fabric_index);
+            commandObj->AddStatus(commandPath, chip::Protocols::InteractionModel::Status::Failure);
+            return;
+        }
+        uint8_t update_token[8];
+        chip::Crypto::DRBG_get_bytes(update_token, sizeof(update_token));
+
+        s_stats.update_available++;
+        ESP_LOGI(TAG, "Image %s offered to node 0x%" PRIX64 " running version %" PRIu32,
+                 s_image_info.software_version_string, node_id, commandData.softwareVersion);
+        response.status = OTAQueryStatus::kUpdateAvailable;
+        response.delayedActionTime.SetValue(0);
+        response.imageURI.SetValue(uri);
+        response.softwareVersion.SetValue(s_image_info.software_version);
+        response.softwareVersionString.SetValue(CharSpan::fromCharString(s_image_info.software_version_string));
+        response.updateToken.SetValue(ByteSpan(update_token));
+        commandObj->AddResponse(commandPath, response);
+    }
+
+    void HandleApplyUpdateRequest(CommandHandler *commandObj, const ConcreteCommandPath &commandPath,
+                                  const Commands::ApplyUpdateRequest::DecodableType &commandData) override
+    {
+        Commands::ApplyUpdateResponse::Type response;
+        response.action = OTAApplyUpdateAction::kProceed;
+        response.delayedActionTime = 0;
+        commandObj->AddResponse(commandPath, response);
+    }
+
+    void HandleNotifyUpdateApplied(CommandHandler *commandObj, const ConcreteCommandPath &commandPath,
+                                   const Commands::NotifyUpdateApplied::DecodableType &commandData) override
+    {
+        s_stats.updates_applied++;
+        ESP_LOGI(TAG, "Node 0x%" PRIX64 " runs version %" PRIu32, commandObj->GetSubjectDescriptor().subject,
+                 commandData.softwareVersion);
+        commandObj->AddStatus(commandPath, chip::Protocols::InteractionModel::Status::Success);
+    }
+
+private:
+    bool IsApplicable(const Commands::QueryImage::DecodableType &commandData)
+    {
+        return s_image_info.valid && commandData.vendorID == s_image_info.vendor_id &&
+            commandData.productID == s_image_info.product_id &&
+            commandData.softwareVersion < s_image_info.software_version &&
+            commandData.softwareVersion >= s_image_info.min_applicable_version &&
+            commandData.softwareVersion <= s_image_info.max_applicable_version;
+    }
+
+    bool SupportsBdx(const Commands::QueryImage::DecodableType &commandData)
+    {
+        auto iter = commandData.protocolsSupported.begin();
+        while (iter.Next()) {
+            if (iter.GetValue() == OTADownloadProtocol::kBDXSynchronous) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+static OTAProviderDelegate s_delegate;
+
+static void unmap_image()
+{
+    if (s_image) {
+        esp_partition_munmap(s_mmap_handle);
+        s_image = nullptr;
+    }
+    s_image_info.valid = false;
+}
+
+static esp_err_t map_image()
+{
+    unmap_image();
+    const void *image = nullptr;
+    esp_err_t err = esp_partition_mmap(s_partition, 0, s_partition->size, ESP_PARTITION_MMAP_DATA, &image,
+                                       &s_mmap_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to map the partition %s: %s", s_partition->label, esp_err_to_name(err));
+        return err;
+    }
+    s_image = static_cast<const uint8_t *>(image);
+
+    chip::OTAImageHeaderParser parser;
+    chip::OTAImageHeader header;
+    ByteSpan buffer(s_image, s_partition->size);
+    parser.Init();
+    if (parser.AccumulateAndDecode(buffer, header) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "No valid Matter OTA image in the partition %s", s_partition->label);
+        parser.Clear();
+        unmap_image();
+        return ESP_ERR_NOT_FOUND;
+    }
+    uint64_t size = (s_partition->size - buffer.size()) + header.mPayloadSize;
+    if (size > s_partition->size) {
+        ESP_LOGE(TAG, "The OTA image is larger than the partition %s", s_partition->label);
+        parser.Clear();
+        unmap_image();
+        return ESP_ERR_NOT_FOUND;
+    }
+    s_image_info.vendor_id = header.mVendorId;
+    s_image_info.product_id = header.mProductId;
+    s_image_info.software_version = header.mSoftwareVersion;
+    size_t len = std::min(header.mSoftwareVersionString.size(), sizeof(s_image_info.software_version_string) - 1);
+    memcpy(s_image_info.software_version_string, header.mSoftwareVersionString.data(), len);
+    s_image_info.software_version_string[len] = 0;
+    s_image_info.min_applicable_version = header.mMinApplicableVersion.ValueOr(0);
+    s_image_info.max_applicable_version = header.mMaxApplicableVersion.ValueOr(UINT32_MAX);
+    s_image_info.size = (uint32_t)size;
+    s_image_info.valid = true;
+    parser.Clear();
+    ESP_LOGI(TAG, "OTA image %s (%" PRIu32 ") for VID 0x%04x PID 0x%04x, %" PRIu32 " bytes",
+             s_image_info.software_version_string, s_image_info.software_version, s_image_info.vendor_id,
+             s_image_info.product_id, s_image_info.size);
+    return ESP_OK;
+}
+
+static void unlock(esp_matter::lock::status_t lock_status)
+{
+    if (lock_status == esp_matter::lock::SUCCESS) {
+        esp_matter::lock::chip_stack_unlock();
+    }
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_status_handler(int argc, char **argv)
+{
+    esp_matter_ota_provider_stats_t stats;
+    if (esp_matter_ota_provider_get_stats(&stats) != ESP_OK) {
+        printf("The OTA provider is not started\n");
+        return ESP_OK;
+    }
+    printf("Queries: %" PRIu32 ", image offered: %" PRIu32 ", busy: %" PRIu32 ", no image: %" PRIu32 "\n",
+           stats.queries, stats.update_available, stats.busy, stats.not_available);
+    printf("Transfers: %" PRIu32 " started, %" PRIu32 " completed, %" PRIu32 " failed, %u in progress at %" PRIu32
+           " B/s, %llu bytes sent\n",
+           stats.transfers_started, stats.transfers_completed, stats.transfers_failed, stats.active_sessions,
+           stats.throughput_bytes_per_sec, (unsigned long long)stats.bytes_sent);
+    printf("Updates applied: %" PRIu32 "\n", stats.updates_applied);
+    esp_matter_ota_provider_session_t sessions[k_max_sessions];
+    size_t count = 0;
+    esp_matter_ota_provider_get_sessions(sessions, k_max_sessions, &count);
+    for (size_t i = 0; i < count; ++i) {
+        printf("\tnode 0x%" PRIX64 ": %" PRIu32 "/%" PRIu32 " bytes (%" PRIu32 "%%), %" PRIu32 " ms, %" PRIu32
+               " B/s\n",
+               sessions[i].node_id, sessions[i].offset, sessions[i].image_size,
+               sessions[i].image_size > 0 ? (uint32_t)((uint64_t)sessions[i].offset * 100 / sessions[i].image_size)
+                                          : 0,
+               sessions[i].elapsed_ms, sessions[i].throughput_bytes_per_sec);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t console_reload_handler(int argc, char **argv)
+{
+    esp_err_t err = esp_matter_ota_provider_reload_image();
+    printf("Reload: %s\n", esp_err_to_name(err));
+    return err;
+}
+
+static esp_matter::console::engine ota_provider_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        ota_provider_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return ota_provider_console.exec_command(argc, argv);
+}
+
+static void register_console_commands()
+{
+    static const esp_matter::console::command_t command = {
+        .name = "ota-provider",
+        .description = "OTA provider. Usage: matter esp ota-provider <status|reload>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t ota_provider_commands[] = {
+        {
+            .name = "status",
+            .description = "Print the progress of the fleet update and the transfers in progress.",
+            .handler = console_status_handler,
+        },
+        {
+            .name = "reload",
+            .description = "Parse the image of the partition again, once no transfer is in progress.",
+            .handler = console_reload_handler,
+        },
+    };
+    ota_provider_console.register_commands(ota_provider_commands,
+                                           sizeof(ota_provider_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+esp_err_t esp_matter_ota_provider_init(uint16_t endpoint_id, const esp_matter_ota_provider_config_t *config)
+{
+    if (!config || !config->partition_label || config->max_sessions == 0 || config->max_sessions > k_max_sessions) {
+        ESP_LOGE(TAG, "Invalid OTA provider configuration");
+        return ESP_ERR_INVALID_ARG;
+    }
+    const esp_partition_t *partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, config->partition_label);
+    if (!partition) {
+        ESP_LOGE(TAG, "Partition %s not found", config->partition_label);
+        return ESP_ERR_NOT_FOUND;
+    }
+#if FIXED_ENDPOINT_COUNT == 0
+    esp_matter::endpoint_t *endpoint = esp_matter::endpoint::get(esp_matter::node::get(), endpoint_id);
+    if (!endpoint) {
+        ESP_LOGE(TAG, "Endpoint %u not found", endpoint_id);
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (!esp_matter::cluster::get(endpoint, OtaSoftwareUpdateProvider::Id)) {
+        esp_matter::cluster::ota_provider::config_t cluster_config;
+        if (!esp_matter::cluster::ota_provider::create(endpoint, &cluster_config, esp_matter::CLUSTER_FLAG_SERVER)) {
+            return ESP_FAIL;
+        }
+    }
+#endif
+    s_config = *config;
+    s_partition = partition;
+    s_endpoint_id = endpoint_id;
+    return ESP_OK;
+}
+
+void esp_matter_ota_provider_start(void)
+{
+    if (s_partition == nullptr || s_started) {
+        return;
+    }
+    /* Without a valid image the requestors are told that no image is available until it is reloaded */
+    map_image();
+    chip::app::Clusters::OTAProvider::SetDelegate(s_endpoint_id, &s_delegate);
+    CHIP_ERROR err = Server::GetInstance().GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+        chip::Protocols::BDX::MessageType::ReceiveInit, &s_bdx_server);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to register the BDX handler: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    s_started = true;
+#if CONFIG_ENABLE_CHIP_SHELL
+    register_console_commands();
+#endif
+}
+
+esp_err_t esp_matter_ota_provider_reload_image(void)
+{
+    esp_matter::lock::status_t lock_status = esp_matter::lock::chip_stack_lock(portMAX_DELAY);
+    ESP_RETURN_ON_FALSE(lock_status != esp_matter::lock::FAILED, ESP_FAIL, TAG, "Failed to lock the stack");
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+    if (s_started && count_sessions() == 0 && count_reservations(esp_timer_get_time()) == 0) {
+        err = map_image();
+    }
+    unlock(lock_status);
+    return err;
+}
+
+esp_err_t esp_matter_ota_provider_get_stats(esp_matter_ota_provider_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_started) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_matter::lock::status_t lock_status = esp_matter::lock::chip_stack_lock(portMAX_DELAY);
+    ESP_RETURN_ON_FALSE(lock_status != esp_matter::lock::FAILED, ESP_FAIL, TAG, "Failed to lock the stack");
+    *stats = s_stats;
+    stats->active_sessions = 0;
+    stats->throughput_bytes_per_sec = 0;
+    for (size_t i = 0; i < k_max_sessions; ++i) {
+        if (s_sessions[i].IsTransferring()) {
+            esp_matter_ota_provider_session_t info;
+            s_sessions[i].GetInfo(&info);
+            stats->active_sessions++;
+            stats->throughput_bytes_per_sec += info.throughput_bytes_per_sec;
+        }
+    }
+    unlock(lock_status);
+    return ESP_OK;
+}
+
+esp_err_t esp_matter_ota_provider_get_sessions(esp_matter_ota_provider_session_t *sessions, size_t max, size_t *count)
+{
+    if (!sessions || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_started) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_matter::lock::status_t lock_status = esp_matter::lock::chip_stack_lock(portMAX_DELAY);
+    ESP_RETURN_ON_FALSE(lock_status != esp_matter::lock::FAILED, ESP_FAIL, TAG, "Failed to lock the stack");
+    *count = 0;
+    for (size_t i = 0; i < k_max_sessions && *count < max; ++i) {
+        if (s_sessions[i].IsTransferring()) {
+            s_sessions[i].GetInfo(&sessions[(*count)++]);
+        }
+    }
+    unlock(lock_status);
+    return ESP_OK;
+}
+
+#endif // CONFIG_ESP_MATTER_OTA_PROVIDER_ENABLE
@@ -0,0 +1,123 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#if CONFIG_ESP_MATTER_OTA_PROVIDER_ENABLE
+/** Configuration of the OTA provider */
+typedef struct {
+    /** Label of the data partition holding the Matter OTA image, the .ota file created with ota_image_tool.py */
+    const char *partition_label;
+    /** Concurrent BDX transfers, up to CONFIG_ESP_MATTER_OTA_PROVIDER_MAX_SESSIONS. The requestors querying an
+     * image while all the transfers are in use are told to query again later. */
+    uint8_t max_sessions;
+    /** Minimum interval between the blocks of a transfer, 0 to send each block as soon as it is queried. Leaves
+     * room in the Thread network for the other traffic and the other transfers. */
+    uint32_t block_interval_ms;
+} esp_matter_ota_provider_config_t;
+
+#define ESP_MATTER_OTA_PROVIDER_CONFIG_DEFAULT()                                                                       \
+    {                                                                                                                  \
+        .partition_label = CONFIG_ESP_MATTER_OTA_PROVIDER_PARTITION_LABEL,                                             \
+        .max_sessions = CONFIG_ESP_MATTER_OTA_PROVIDER_MAX_SESSIONS,                                                  \
+        .block_interval_ms = CONFIG_ESP_MATTER_OTA_PROVIDER_BLOCK_INTERVAL_MS,                                         \
+    }
+
+/** Progress of the fleet update */
+typedef struct {
+    /** QueryImage commands received, and answered with an image, busy or no image */
+    uint32_t queries;
+    uint32_t update_available;
+    uint32_t busy;
+    uint32_t not_available;
+    /** BDX transfers started, completed and aborted */
+    uint32_t transfers_started;
+    uint32_t transfers_completed;
+    uint32_t transfers_failed;
+    /** NotifyUpdateApplied commands received, the requestors running the new image */
+    uint32_t updates_applied;
+    /** Transfers in progress, and their throughput */
+    uint8_t active_sessions;
+    uint32_t throughput_bytes_per_sec;
+    /** Bytes sent by all the transfers */
+    uint64_t bytes_sent;
+} esp_matter_ota_provider_stats_t;
+
+/** Transfer in progress */
+typedef struct {
+    uint64_t node_id;
+    uint8_t fabric_index;
+    /** Offset of the next block in the image, and size of the image */
+    uint32_t offset;
+    uint32_t image_size;
+    uint32_t elapsed_ms;
+    uint32_t throughput_bytes_per_sec;
+} esp_matter_ota_provider_session_t;
+
+/**
+ * @brief Initialize the OTA provider, called before esp_matter::start()
+ *
+ * The OTA Provider cluster is created on the endpoint when the data model is created at runtime. The image is mapped
+ * and the BDX transfers are accepted once the server is started.
+ *
+ * @param[in] endpoint_id Endpoint of the OTA Provider cluster, usually the root endpoint.
+ * @param[in] config      Configuration, see ESP_MATTER_OTA_PROVIDER_CONFIG_DEFAULT().
+ *
+ * @return ESP_OK on success, appropriate error otherwise
+ */
+esp_err_t esp_matter_ota_provider_init(uint16_t endpoint_id, const esp_matter_ota_provider_config_t *config);
+
+/**
+ * @brief Start the OTA provider, called by esp_matter once the server is started
+ */
+void esp_matter_ota_provider_start(void);
+
+/**
+ * @brief Parse the image of the partition again, after it has been written by the application
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if transfers are in progress, ESP_ERR_NOT_FOUND if the partition
+ *         holds no valid image.
+ */
+esp_err_t esp_matter_ota_provider_reload_image(void);
+
+/**
+ * @brief Get the progress of the fleet update
+ *
+ * The progress is also printed by the "matter esp ota-provider status" console command.
+ *
+ * @param[out] stats Progress since the start of the provider.
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the provider is not started.
+ */
+esp_err_t esp_matter_ota_provider_get_stats(esp_matter_ota_provider_stats_t *stats);
+
+/**
+ * @brief Get the transfers in progress
+ *
+ * @param[out] sessions Transfers.
+ * @param[in]  max      Size of sessions.
+ * @param[out] count    Transfers copied.
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the provider is not started.
+ */
+esp_err_t esp_matter_ota_provider_get_sessions(esp_matter_ota_provider_session_t *sessions, size_t max, size_t *count);
+#else
+static inline void esp_matter_ota_provider_start(void) {}
+#endif // CONFIG_ESP_MATTER_OTA_PROVIDER_ENABLE
@@ -17,6 +17,16 @@
 #include <platform/ESP32/ESP32DeviceInfoProvider.h>
 #include <platform/ESP32/ESP32FactoryDataProvider.h>
 #include <platform/ESP32/ESP32SecureCertDACProvider.h>
+#if CONFIG_ESP_MATTER_CACHE_FACTORY_DATA
+#include <esp_matter_cached_factory_data_provider.h>
+#endif
+#if CONFIG_ESP_MATTER_CACHE_DAC_CREDENTIALS
+#include <esp_matter_cached_dac_provider.h>
+#endif
+#if CONFIG_ESP_MATTER_CACHE_DIAGNOSTICS
+#include <esp_matter_cached_diagnostic_data_provider.h>
+#include <platform/DiagnosticDataProvider.h>
+#endif
 
 using namespace chip::DeviceLayer;
 using namespace chip::Credentials;
@@ -29,6 +39,18 @@ namespace esp_matter {
 static ESP32FactoryDataProvider factory_data_provider;
 #endif
 
+#if CONFIG_ESP_MATTER_CACHE_FACTORY_DATA
+static CachedFactoryDataProvider cached_factory_data_provider;
+#endif
+
+#if CONFIG_ESP_MATTER_CACHE_DAC_CREDENTIALS
+static CachedDACProvider cached_dac_provider;
+#endif
+
+#if CONFIG_ESP_MATTER_CACHE_DIAGNOSTICS
+static CachedDiagnosticDataProvider cached_diagnostic_data_provider;
+#endif
+
 #if CONFIG_ENABLE_ESP32_DEVICE_INFO_PROVIDER
 static ESP32DeviceInfoProvider device_info_provider;
 
@@ -89,8 +111,32 @@ static DeviceAttestationCredentialsProvider *get_dac_provider(void)
 
 void setup_providers()
 {
+#if CONFIG_ESP_MATTER_CACHE_FACTORY_DATA
+    // Read the factory partition once, the getters are then served from RAM
+    CommissionableDataProvider *commissionable_data = NULL;
+    DeviceInstanceInfoProvider *device_instance_info = NULL;
+#if CONFIG_FACTORY_COMMISSIONABLE_DATA_PROVIDER
+    commissionable_data = &factory_data_provider;
+#endif
+#if CONFIG_FACTORY_DEVICE_INSTANCE_INFO_PROVIDER
+    device_instance_info = &factory_data_provider;
+#endif
+    if (cached_factory_data_provider.Load(commissionable_data, device_instance_info) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to cache the factory data, it will be read from the factory partition");
+        commissionable_data = NULL;
+        device_instance_info = NULL;
+    }
+#endif
+
 #if CONFIG_FACTORY_COMMISSIONABLE_DATA_PROVIDER
-    SetCommissionableDataProvider(&factory_data_provider);
+#if CONFIG_ESP_MATTER_CACHE_FACTORY_DATA
+    if (commissionable_data) {
+        SetCommissionableDataProvider(&cached_factory_data_provider);
+    } else
+#endif
+    {
+        SetCommissionableDataProvider(&factory_data_provider);
+    }
 #elif CONFIG_CUSTOM_COMMISSIONABLE_DATA_PROVIDER
     if (s_custom_commissionable_data_provider) {
         SetCommissionableDataProvider(s_custom_commissionable_data_provider);
@@ -100,7 +146,14 @@ void setup_providers()
     // LegacyTemporaryCommissionableDataProvider is set in GenericConfigurationManagerImpl<ConfigClass>::Init()
 
 #if CONFIG_FACTORY_DEVICE_INSTANCE_INFO_PROVIDER
-    SetDeviceInstanceInfoProvider(&factory_data_provider);
+#if CONFIG_ESP_MATTER_CACHE_FACTORY_DATA
+    if (device_instance_info) {
+        SetDeviceInstanceInfoProvider(&cached_factory_data_provider);
+    } else
+#endif
+    {
+        SetDeviceInstanceInfoProvider(&factory_data_provider);
+    }
 #elif CONFIG_CUSTOM_DEVICE_INSTANCE_INFO_PROVIDER
     if (s_custom_device_instance_info_provider) {
         SetDeviceInstanceInfoProvider(s_custom_device_instance_info_provider);
@@ -116,7 +169,24 @@ void setup_providers()
         SetDeviceInfoProvider(s_custom_device_info_provider);
     }
 #endif
-    SetDeviceAttestationCredentialsProvider(get_dac_provider());
+    DeviceAttestationCredentialsProvider *dac_provider = get_dac_provider();
+#if CONFIG_ESP_MATTER_CACHE_DAC_CREDENTIALS
+    // Pre-load the certificates, the commissioning then does not read them from the flash
+    if (cached_dac_provider.Load(dac_provider) == CHIP_NO_ERROR) {
+        dac_provider = &cached_dac_provider;
+    } else {
+        ESP_LOGE(TAG, "Failed to cache the attestation credentials");
+    }
+#endif
+    SetDeviceAttestationCredentialsProvider(dac_provider);
+
+#if CONFIG_ESP_MATTER_CACHE_DIAGNOSTICS
+    // Sample the diagnostics of the platform, the subscriptions to the diagnostics clusters then read the samples
+    if (&GetDiagnosticDataProvider() != &cached_diagnostic_data_provider) {
+        cached_diagnostic_data_provider.SetProvider(&GetDiagnosticDataProvider());
+        SetDiagnosticDataProvider(&cached_diagnostic_data_provider);
+    }
+#endif
 }
 
 } // namespace esp_matter
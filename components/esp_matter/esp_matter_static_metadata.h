@@ -0,0 +1,153 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/util/af-types.h>
+#include <esp_matter.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Static endpoint metadata
+ *
+ * Helpers to describe the ember metadata of an endpoint whose composition is fixed at compile time. The tables built
+ * with these helpers are constexpr and are placed in flash. Pass the endpoint type to
+ * `esp_matter::endpoint::set_static_metadata()` so that `esp_matter::endpoint::enable()` uses them as is instead of
+ * building a copy of the metadata in RAM.
+ *
+ * The tables must match the composition of the esp_matter endpoint: same clusters in the same order, and the same
+ * attributes, commands and events for each cluster, which `esp_matter::endpoint::enable()` checks. The attribute
+ * values are still held by the esp_matter data model.
+ *
+ * Example:
+ *
+ *  static constexpr EmberAfAttributeMetadata on_off_attributes[] = {
+ *      static_metadata::attribute(OnOff::Attributes::OnOff::Id, ZCL_BOOLEAN_ATTRIBUTE_TYPE, 1,
+ *                                 ATTRIBUTE_FLAG_NONVOLATILE),
+ *      static_metadata::attribute(Globals::Attributes::ClusterRevision::Id, ZCL_INT16U_ATTRIBUTE_TYPE, 2),
+ *  };
+ *  static constexpr chip::CommandId on_off_accepted_commands[] = {
+ *      OnOff::Commands::Off::Id, OnOff::Commands::On::Id, OnOff::Commands::Toggle::Id, chip::kInvalidCommandId,
+ *  };
+ *  static constexpr EmberAfCluster light_clusters[] = {
+ *      static_metadata::cluster(OnOff::Id, on_off_attributes, CLUSTER_FLAG_SERVER, NULL, on_off_accepted_commands),
+ *  };
+ *  static constexpr EmberAfEndpointType light_endpoint_type = static_metadata::endpoint_type(light_clusters);
+ */
+
+namespace esp_matter {
+namespace static_metadata {
+
+/** Attribute metadata
+ *
+ * @param[in] attribute_id Attribute ID.
+ * @param[in] type Ember attribute type, `ZCL_*_ATTRIBUTE_TYPE`.
+ * @param[in] size Size of the attribute value. For strings this is the maximum length plus the length prefix.
+ * @param[in] flags Bitmap of `attribute_flags_t`. External storage is always added since the values are held by
+ *                  the esp_matter data model. `ATTRIBUTE_FLAG_MIN_MAX` is dropped as there are no bounds, use
+ *                  `bounded_attribute()` for the attributes with bounds.
+ *
+ * @return Attribute metadata.
+ */
+constexpr EmberAfAttributeMetadata attribute(uint32_t attribute_id, EmberAfAttributeType type, uint16_t size,
+                                             uint8_t flags = ATTRIBUTE_FLAG_NONE)
+{
+    return EmberAfAttributeMetadata{EmberAfDefaultOrMinMaxAttributeValue(static_cast<uint32_t>(0)), attribute_id,
+                                    size, type,
+                                    static_cast<EmberAfAttributeMask>((flags & ~ATTRIBUTE_FLAG_MIN_MAX) |
+                                                                      ATTRIBUTE_FLAG_EXTERNAL_STORAGE)};
+}
+
+/** Attribute metadata with bounds
+ *
+ * The stack checks the writes to the attribute against the bounds.
+ *
+ * @param[in] attribute_id Attribute ID.
+ * @param[in] type Ember attribute type, `ZCL_*_ATTRIBUTE_TYPE`.
+ * @param[in] size Size of the attribute value.
+ * @param[in] min_max Default, minimum and maximum values of the attribute. It must be constexpr as well, so that it
+ *                    stays valid as long as the metadata.
+ * @param[in] flags Bitmap of `attribute_flags_t`. External storage and `ATTRIBUTE_FLAG_MIN_MAX` are always added.
+ *
+ * @return Attribute metadata.
+ */
+constexpr EmberAfAttributeMetadata bounded_attribute(uint32_t attribute_id, EmberAfAttributeType type, uint16_t size,
+                                                     const EmberAfAttributeMinMaxValue *min_max,
+                                                     uint8_t flags = ATTRIBUTE_FLAG_NONE)
+{
+    return EmberAfAttributeMetadata{EmberAfDefaultOrMinMaxAttributeValue(min_max), attribute_id, size, type,
+                                    static_cast<EmberAfAttributeMask>(flags | ATTRIBUTE_FLAG_MIN_MAX |
+                                                                      ATTRIBUTE_FLAG_EXTERNAL_STORAGE)};
+}
+
+/** Cluster size
+ *
+ * @param[in] attributes Attribute metadata table of the cluster.
+ *
+ * @return Sum of the sizes of the attributes.
+ */
+template <size_t N>
+constexpr uint16_t get_cluster_size(const EmberAfAttributeMetadata (&attributes)[N])
+{
+    uint16_t size = 0;
+    for (size_t index = 0; index < N; index++) {
+        size += attributes[index].size;
+    }
+    return size;
+}
+
+/** Cluster metadata
+ *
+ * @param[in] cluster_id Cluster ID.
+ * @param[in] attributes Attribute metadata table of the cluster.
+ * @param[in] flags Bitmap of `cluster_flags_t`.
+ * @param[in] functions (Optional) Cluster function list, matching the function flags.
+ * @param[in] accepted_commands (Optional) Accepted command ID list, terminated by `chip::kInvalidCommandId`.
+ * @param[in] generated_commands (Optional) Generated command ID list, terminated by `chip::kInvalidCommandId`.
+ * @param[in] events (Optional) Event ID list.
+ * @param[in] event_count Number of events in the event ID list.
+ *
+ * @return Cluster metadata.
+ */
+template <size_t N>
+constexpr EmberAfCluster cluster(uint32_t cluster_id, const EmberAfAttributeMetadata (&attributes)[N], uint8_t flags,
+                                 const EmberAfGenericClusterFunction *functions = NULL,
+                                 const chip::CommandId *accepted_commands = NULL,
+                                 const chip::CommandId *generated_commands = NULL,
+                                 const chip::EventId *events = NULL, uint16_t event_count = 0)
+{
+    return EmberAfCluster{cluster_id, attributes, static_cast<uint16_t>(N), get_cluster_size(attributes),
+                          static_cast<EmberAfClusterMask>(flags), functions, accepted_commands, generated_commands,
+                          events, event_count};
+}
+
+/** Endpoint type
+ *
+ * @param[in] clusters Cluster metadata table of the endpoint, in the order the clusters are created.
+ *
+ * @return Endpoint type.
+ */
+template <size_t N>
+constexpr EmberAfEndpointType endpoint_type(const EmberAfCluster (&clusters)[N])
+{
+    static_assert(N <= UINT8_MAX, "Too many clusters for an endpoint");
+    uint16_t size = 0;
+    for (size_t index = 0; index < N; index++) {
+        size += clusters[index].clusterSize;
+    }
+    return EmberAfEndpointType{clusters, static_cast<uint8_t>(N), size};
+}
+
+} /* static_metadata */
+} /* esp_matter */
@@ -0,0 +1,312 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_acl_cache.h>
+#include <esp_matter_core.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_ACL_CACHE
+using chip::FabricIndex;
+using chip::Access::AccessControl;
+using chip::Access::AuthMode;
+using chip::Access::Privilege;
+using chip::Access::RequestPath;
+using chip::Access::SubjectDescriptor;
+
+namespace esp_matter {
+namespace acl_cache {
+
+static const char *TAG = "acl_cache";
+
+typedef struct decision {
+    bool valid;
+    bool granted;
+    FabricIndex fabric_index;
+    AuthMode auth_mode;
+    Privilege privilege;
+    bool is_commissioning;
+    chip::NodeId subject;
+    chip::CATValues cats;
+    chip::EndpointId endpoint;
+    chip::ClusterId cluster;
+} decision_t;
+
+/* Direct mapped, only accessed in the Matter context, the stats are shared with the readers */
+static decision_t s_decisions[CONFIG_ESP_MATTER_ACL_CACHE_SIZE];
+static bool s_evaluating = false;
+static stats_t s_stats;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t hash_add(uint32_t hash, uint64_t value)
+{
+    for (int byte = 0; byte < 8; byte++) {
+        hash = (hash ^ (uint8_t)(value >> (byte * 8))) * 16777619;
+    }
+    return hash;
+}
+
+static decision_t *slot(const SubjectDescriptor &subject, const RequestPath &path, Privilege privilege)
+{
+    uint32_t hash = 2166136261;
+    hash = hash_add(hash, subject.subject);
+    hash = hash_add(hash, ((uint64_t)path.cluster << 24) | ((uint64_t)path.endpoint << 8) | subject.fabricIndex);
+    hash = hash_add(hash, (uint64_t)privilege);
+    return &s_decisions[hash % CONFIG_ESP_MATTER_ACL_CACHE_SIZE];
+}
+
+static bool matches(const decision_t *decision, const SubjectDescriptor &subject, const RequestPath &path,
+                    Privilege privilege)
+{
+    return decision->valid && decision->subject == subject.subject && decision->fabric_index == subject.fabricIndex &&
+           decision->auth_mode == subject.authMode && decision->is_commissioning == subject.isCommissioning &&
+           decision->cats == subject.cats && decision->endpoint == path.endpoint && decision->cluster == path.cluster &&
+           decision->privilege == privilege;
+}
+
+void invalidate()
+{
+    for (decision_t &decision : s_decisions) {
+        decision.valid = false;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.invalidations++;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+/* Forwards everything to the delegate of the server, the changes of the entries drop the cached decisions */
+class caching_delegate : public AccessControl::Delegate {
+public:
+    void set_delegate(AccessControl::Delegate *delegate) { m_delegate = delegate; }
+
+    void Release() override { m_delegate->Release(); }
+
+    CHIP_ERROR GetMaxEntriesPerFabric(size_t &value) const override
+    {
+        return m_delegate->GetMaxEntriesPerFabric(value);
+    }
+
+    CHIP_ERROR GetMaxSubjectsPerEntry(size_t &value) const override
+    {
+        return m_delegate->GetMaxSubjectsPerEntry(value);
+    }
+
+    CHIP_ERROR GetMaxTargetsPerEntry(size_t &value) const override
+    {
+        return m_delegate->GetMaxTargetsPerEntry(value);
+    }
+
+    CHIP_ERROR GetMaxEntryCount(size_t &value) const override { return m_delegate->GetMaxEntryCount(value); }
+
+    CHIP_ERROR GetEntryCount(FabricIndex fabric, size_t &value) const override
+    {
+        return m_delegate->GetEntryCount(fabric, value);
+    }
+
+    CHIP_ERROR GetEntryCount(size_t &value) const override { return m_delegate->GetEntryCount(value); }
+
+    CHIP_ERROR PrepareEntry(AccessControl::Entry &entry) override { return m_delegate->PrepareEntry(entry); }
+
+    CHIP_ERROR CreateEntry(size_t *index, const AccessControl::Entry &entry, FabricIndex *fabric_index) override
+    {
+        invalidate();
+        return m_delegate->CreateEntry(index, entry, fabric_index);
+    }
+
+    CHIP_ERROR ReadEntry(size_t index, AccessControl::Entry &entry, const FabricIndex *fabric_index) const override
+    {
+        return m_delegate->ReadEntry(index, entry, fabric_index);
+    }
+
+    CHIP_ERROR UpdateEntry(size_t index, const AccessControl::Entry &entry, const FabricIndex *fabric_index) override
+    {
+        invalidate();
+        return m_delegate->UpdateEntry(index, entry, fabric_index);
+    }
+
+    CHIP_ERROR DeleteEntry(size_t index, const FabricIndex *fabric_index) override
+    {
+        invalidate();
+        return m_delegate->DeleteEntry(index, fabric_index);
+    }
+
+    CHIP_ERROR Entries(AccessControl::EntryIterator &iterator, const FabricIndex *fabric_index) const override
+    {
+        return m_delegate->Entries(iterator, fabric_index);
+    }
+
+    CHIP_ERROR Init() override
+    {
+        invalidate();
+        return m_delegate->Init();
+    }
+
+    void Finish() override
+    {
+        invalidate();
+        m_delegate->Finish();
+    }
+
+    /* Called by AccessControl::Check() before it evaluates the entries. A miss evaluates them with a nested
+       AccessControl::Check(), for which this returns CHIP_ERROR_NOT_IMPLEMENTED */
+    CHIP_ERROR Check(const SubjectDescriptor &subject, const RequestPath &path, Privilege privilege) override
+    {
+        CHIP_ERROR err = m_delegate->Check(subject, path, privilege);
+        if (err != CHIP_ERROR_NOT_IMPLEMENTED || s_evaluating) {
+            return err;
+        }
+        /* The PASE sessions are granted without an evaluation of the entries */
+        if (subject.authMode != AuthMode::kCase && subject.authMode != AuthMode::kGroup) {
+            return CHIP_ERROR_NOT_IMPLEMENTED;
+        }
+        decision_t *decision = slot(subject, path, privilege);
+        if (matches(decision, subject, path, privilege)) {
+            portENTER_CRITICAL(&s_stats_lock);
+            s_stats.hits++;
+            portEXIT_CRITICAL(&s_stats_lock);
+            return decision->granted ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+        }
+
+        s_evaluating = true;
+        err = chip::Access::GetAccessControl().Check(subject, path, privilege);
+        s_evaluating = false;
+        portENTER_CRITICAL(&s_stats_lock);
+        s_stats.misses++;
+        portEXIT_CRITICAL(&s_stats_lock);
+        /* The other errors are not decisions */
+        if (err == CHIP_NO_ERROR || err == CHIP_ERROR_ACCESS_DENIED) {
+            *decision = {
+                .valid = true,
+                .granted = err == CHIP_NO_ERROR,
+                .fabric_index = subject.fabricIndex,
+                .auth_mode = subject.authMode,
+                .privilege = privilege,
+                .is_commissioning = subject.isCommissioning,
+                .subject = subject.subject,
+                .cats = subject.cats,
+                .endpoint = path.endpoint,
+                .cluster = path.cluster,
+            };
+        }
+        return err;
+    }
+
+private:
+    AccessControl::Delegate *m_delegate = nullptr;
+};
+
+AccessControl::Delegate *wrap(AccessControl::Delegate *delegate)
+{
+    static caching_delegate s_delegate;
+    if (!delegate) {
+        ESP_LOGE(TAG, "No access control delegate to cache");
+        return delegate;
+    }
+    s_delegate.set_delegate(delegate);
+    return &s_delegate;
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats = {};
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    stats_t stats;
+    get_stats(&stats);
+    uint32_t lookups = stats.hits + stats.misses;
+    uint32_t hit_rate = lookups > 0 ? (uint32_t)((uint64_t)stats.hits * 100 / lookups) : 0;
+    printf("ACL checks: %" PRIu32 ", cached: %" PRIu32 " (%" PRIu32 "%%), evaluated: %" PRIu32
+           ", invalidations: %" PRIu32 "\n", lookups, stats.hits, hit_rate, stats.misses, stats.invalidations);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine acl_cache_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        acl_cache_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return acl_cache_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "acl_cache",
+        .description = "Access control decision cache statistics. Usage: matter esp acl_cache <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t acl_cache_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the number of access control checks and the ones answered from the cache.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the ACL cache statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    acl_cache_console.register_commands(acl_cache_commands,
+                                        sizeof(acl_cache_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace acl_cache
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_ACL_CACHE
@@ -0,0 +1,54 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_ACL_CACHE
+#include <access/AccessControl.h>
+
+namespace esp_matter {
+namespace acl_cache {
+
+/**
+ * @brief Wraps the access control delegate of the server with the decision cache. The calls which change the
+ *        entries invalidate the cache. Set in the server init parameters before the server init.
+ *
+ * @param delegate Access control delegate of the server init parameters
+ *
+ * @return Caching delegate, the delegate itself if it is NULL
+ */
+chip::Access::AccessControl::Delegate *wrap(chip::Access::AccessControl::Delegate *delegate);
+
+/**
+ * @brief Drops the cached decisions, called when the device types of the endpoints change, as the entries can
+ *        target a device type.
+ */
+void invalidate();
+
+/**
+ * @brief Registers the ACL cache console commands.
+ */
+void register_console_commands();
+
+} // namespace acl_cache
+} // namespace esp_matter
+#else
+namespace esp_matter {
+namespace acl_cache {
+inline void invalidate() {}
+} // namespace acl_cache
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_ACL_CACHE
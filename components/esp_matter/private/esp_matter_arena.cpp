@@ -0,0 +1,154 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_arena.h>
+#include <esp_matter_mem.h>
+#include <string.h>
+
+#ifdef CONFIG_ESP_MATTER_ENDPOINT_ARENA_BLOCK_SIZE
+#define ARENA_DEFAULT_BLOCK_SIZE CONFIG_ESP_MATTER_ENDPOINT_ARENA_BLOCK_SIZE
+#else
+#define ARENA_DEFAULT_BLOCK_SIZE 1024
+#endif
+
+namespace esp_matter {
+namespace arena {
+
+static const char *TAG = "mtr_arena";
+
+/* 64 bit attribute values are part of the data model elements, keep the allocations 8 bytes aligned */
+constexpr size_t k_alignment = 8;
+
+static inline size_t align_up(size_t size)
+{
+    return (size + k_alignment - 1) & ~(k_alignment - 1);
+}
+
+static const size_t k_header_size = align_up(sizeof(block_t));
+
+static inline uint8_t *block_data(block_t *block)
+{
+    return (uint8_t *)block + k_header_size;
+}
+
+void *allocate(arena_t *arena, size_t size)
+{
+    if (!arena) {
+        return NULL;
+    }
+    if (size == 0) {
+        /* Like calloc(), hand out a unique pointer for empty allocations */
+        size = 1;
+    }
+    size_t aligned_size = align_up(size);
+    for (chunk_t **chunk = &arena->free_chunks; *chunk; chunk = &(*chunk)->next) {
+        if ((*chunk)->size == aligned_size) {
+            void *ptr = *chunk;
+            *chunk = (*chunk)->next;
+            memset(ptr, 0, aligned_size);
+            return ptr;
+        }
+    }
+    block_t *block = arena->blocks;
+    if (!block || block->size - block->used < aligned_size) {
+        size_t block_size = arena->block_size ? arena->block_size : ARENA_DEFAULT_BLOCK_SIZE;
+        if (aligned_size > block_size) {
+            block_size = aligned_size;
+        }
+        block_t *new_block = (block_t *)esp_matter_mem_calloc(1, k_header_size + block_size);
+        if (!new_block) {
+            ESP_LOGE(TAG, "Couldn't allocate arena block of %u bytes", (unsigned)block_size);
+            return NULL;
+        }
+        new_block->size = block_size;
+        new_block->used = 0;
+        if (block && block->size - block->used >= block_size - aligned_size) {
+            /* A dedicated block for a large request would leave less room than the current one, keep serving
+               small requests from the current block. */
+            new_block->next = block->next;
+            block->next = new_block;
+            new_block->used = aligned_size;
+            return block_data(new_block);
+        }
+        new_block->next = block;
+        arena->blocks = new_block;
+        block = new_block;
+    }
+    void *ptr = block_data(block) + block->used;
+    block->used += aligned_size;
+    /* The block comes zeroed from calloc, but the region might have been handed out and given back before */
+    memset(ptr, 0, aligned_size);
+    return ptr;
+}
+
+void deallocate(arena_t *arena, void *ptr, size_t size)
+{
+    if (!arena || !ptr || !arena->blocks) {
+        return;
+    }
+    block_t *block = arena->blocks;
+    size_t aligned_size = align_up(size);
+    if (block->used >= aligned_size && (uint8_t *)ptr == block_data(block) + block->used - aligned_size) {
+        block->used -= aligned_size;
+        return;
+    }
+    if (aligned_size < sizeof(chunk_t)) {
+        /* Too small to be tracked, the memory is reclaimed when the arena is released */
+        return;
+    }
+    chunk_t *chunk = (chunk_t *)ptr;
+    chunk->size = aligned_size;
+    chunk->next = arena->free_chunks;
+    arena->free_chunks = chunk;
+}
+
+void release(arena_t *arena)
+{
+    if (!arena) {
+        return;
+    }
+    block_t *block = arena->blocks;
+    while (block) {
+        block_t *next_block = block->next;
+        esp_matter_mem_free(block);
+        block = next_block;
+    }
+    arena->blocks = NULL;
+    arena->free_chunks = NULL;
+}
+
+size_t get_size(const arena_t *arena)
+{
+    size_t size = 0;
+    for (block_t *block = arena ? arena->blocks : NULL; block; block = block->next) {
+        size += k_header_size + block->size;
+    }
+    return size;
+}
+
+size_t get_used(const arena_t *arena)
+{
+    size_t used = 0;
+    for (block_t *block = arena ? arena->blocks : NULL; block; block = block->next) {
+        used += block->used;
+    }
+    for (chunk_t *chunk = arena ? arena->free_chunks : NULL; chunk; chunk = chunk->next) {
+        used -= chunk->size;
+    }
+    return used;
+}
+
+} // namespace arena
+} // namespace esp_matter
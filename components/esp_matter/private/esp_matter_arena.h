@@ -0,0 +1,93 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace arena {
+
+typedef struct block {
+    struct block *next;
+    size_t size;
+    size_t used;
+} block_t;
+
+/* Header written in the memory given back to the arena, until it is handed out again */
+typedef struct chunk {
+    struct chunk *next;
+    size_t size;
+} chunk_t;
+
+/** Bump arena. A zero-initialized arena_t is a valid empty arena. */
+typedef struct arena {
+    /* The most recently added block is at the head of the list and is the one allocations are served from */
+    block_t *blocks;
+    size_t block_size;
+    /* Memory given back to the arena, reused by the allocations of the same size */
+    chunk_t *free_chunks;
+} arena_t;
+
+/**
+ * @brief Allocates zero-initialized memory from the arena.
+ *
+ * Memory given back with deallocate() is reused first if its size matches. Else the memory is served from the
+ * current block, a new block is allocated with esp_matter_mem_calloc() when the current one is exhausted. Requests
+ * bigger than the block size get a dedicated block of the exact size.
+ *
+ * @param arena Arena
+ * @param size  Number of bytes
+ *
+ * @return Pointer to the allocated memory, NULL in case of failure
+ */
+void *allocate(arena_t *arena, size_t size);
+
+/**
+ * @brief Returns memory to the arena.
+ *
+ * The most recent allocation is given back to its block. Any other allocation is kept for the next allocate() of
+ * the same size, the blocks themselves are only freed when the arena is released.
+ *
+ * @param arena Arena
+ * @param ptr   Pointer returned by allocate()
+ * @param size  Size passed to allocate()
+ */
+void deallocate(arena_t *arena, void *ptr, size_t size);
+
+/**
+ * @brief Releases all the blocks of the arena. The arena can be reused afterwards.
+ *
+ * @param arena Arena
+ */
+void release(arena_t *arena);
+
+/**
+ * @brief Gets the number of bytes allocated from the heap for the arena blocks, including the block headers.
+ *
+ * @param arena Arena
+ */
+size_t get_size(const arena_t *arena);
+
+/**
+ * @brief Gets the number of bytes handed out by the arena and not given back, including the alignment padding.
+ *
+ * @param arena Arena
+ */
+size_t get_used(const arena_t *arena);
+
+} // namespace arena
+} // namespace esp_matter
@@ -0,0 +1,377 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_async_reset.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+#include <esp_bit_defs.h>
+#include <esp_matter_journal.h>
+#include <esp_matter_nvs.h>
+#include <esp_matter_rtc_retention.h>
+#include <esp_partition.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <nvs.h>
+#include <nvs_flash.h>
+#include <string.h>
+
+#include <platform/CHIPDeviceLayer.h>
+#include <platform/ESP32/ESP32Config.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+using chip::DeviceLayer::ConfigurationMgr;
+using chip::DeviceLayer::Internal::ESP32Config;
+
+namespace esp_matter {
+namespace async_reset {
+
+static const char *TAG = "async_reset";
+
+/*
+ * The factory reset erases the registered storage in a background task: an NVS partition which is not the default
+ * one is erased whole, one sector at a time, and a namespace of the default partition with nvs_erase_all(). The
+ * storage sits on the same SPI flash, whose operations are serialized by the flash driver, so the erases run one
+ * after the other, and the task yields between them so that the device keeps answering. The list of the storage and
+ * the ones already erased are kept in the chip-config namespace, which the reset of the Matter stack erases last, so
+ * that a reset interrupted by a restart is resumed at the next boot.
+ */
+
+constexpr size_t k_max_storages = 8;
+constexpr const char *k_marker_name = "mtr-reset";
+
+typedef struct {
+    /* Label of the NVS partition, with the terminating null character */
+    char partition_label[17];
+    /* Namespace erased when the partition is the default one */
+    char namespace_name[NVS_KEY_NAME_MAX_SIZE];
+} storage_t;
+
+typedef struct {
+    uint32_t done_mask;
+    uint8_t count;
+    storage_t storages[k_max_storages];
+} marker_t;
+
+typedef struct {
+    storage_t storage;
+    cleanup_callback_t cleanup;
+} registration_t;
+
+static registration_t s_registrations[k_max_storages];
+static size_t s_registration_count = 0;
+static marker_t s_marker;
+static progress_callback_t s_progress_callback = NULL;
+static void *s_progress_priv_data = NULL;
+static volatile bool s_running = false;
+static volatile uint8_t s_progress = 0;
+
+static const ESP32Config::Key k_marker_key(ESP32Config::kConfigNamespace_ChipConfig, k_marker_name);
+
+static void set_progress(size_t step, size_t step_count, uint32_t done, uint32_t total)
+{
+    uint32_t percent = (uint32_t)(100 * step + (total > 0 ? 100 * done / total : 100)) / step_count;
+    if (percent > 100) {
+        percent = 100;
+    }
+    if (percent == s_progress) {
+        return;
+    }
+    if (percent / 10 != s_progress / 10) {
+        ESP_LOGI(TAG, "Factory reset: %u%%", (unsigned)percent);
+    }
+    s_progress = percent;
+    if (s_progress_callback) {
+        s_progress_callback(s_progress, s_progress_priv_data);
+    }
+}
+
+static void store_marker()
+{
+    CHIP_ERROR err = ESP32Config::WriteConfigValueBin(k_marker_key, (const uint8_t *)&s_marker, sizeof(s_marker));
+    if (err != CHIP_NO_ERROR) {
+        /* The reset goes on, it is only not resumed if the device restarts before its end */
+        ESP_LOGW(TAG, "Failed to store the factory reset progress, err:%" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+static bool is_dedicated(const storage_t *storage)
+{
+    return strcmp(storage->partition_label, NVS_DEFAULT_PART_NAME) != 0;
+}
+
+static esp_err_t erase_partition(const char *label, size_t step, size_t step_count, bool yield)
+{
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_NVS,
+                                                                label);
+    if (!partition) {
+        ESP_LOGE(TAG, "NVS partition %s not found", label);
+        return ESP_ERR_NOT_FOUND;
+    }
+    /* The handles of the partition are invalid from now on, it is initialized again after the restart */
+    nvs_flash_deinit_partition(label);
+    for (uint32_t offset = 0; offset < partition->size; offset += partition->erase_size) {
+        esp_err_t err = esp_partition_erase_range(partition, offset, partition->erase_size);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to erase partition %s at 0x%" PRIx32 ", err:%d", label, offset, err);
+            return err;
+        }
+        set_progress(step, step_count, offset + partition->erase_size, partition->size);
+        if (yield) {
+            vTaskDelay(1);
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t erase_namespace(const storage_t *storage)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(storage->partition_label, storage->namespace_name, NVS_READWRITE, &handle);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        /* Nothing was ever stored in the namespace */
+        return ESP_OK;
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open namespace %s of partition %s, err:%d", storage->namespace_name,
+                 storage->partition_label, err);
+        return err;
+    }
+    err = nvs_erase_all(handle);
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return err;
+}
+
+/* Erases the storage not erased yet, the step after them is the reset of the Matter stack */
+static void erase_storages(bool yield)
+{
+    size_t step_count = s_marker.count + 1;
+    for (size_t index = 0; index < s_marker.count; index++) {
+        const storage_t *storage = &s_marker.storages[index];
+        if (s_marker.done_mask & BIT(index)) {
+            continue;
+        }
+        esp_err_t err = ESP_OK;
+        if (!is_dedicated(storage)) {
+            err = erase_namespace(storage);
+        } else {
+            /* A partition holding several of the storages is erased once */
+            bool erased = false;
+            for (size_t other = 0; other < index && !erased; other++) {
+                erased = (s_marker.done_mask & BIT(other)) && is_dedicated(&s_marker.storages[other]) &&
+                    strcmp(s_marker.storages[other].partition_label, storage->partition_label) == 0;
+            }
+            if (!erased) {
+                err = erase_partition(storage->partition_label, index, step_count, yield);
+            }
+        }
+        if (err != ESP_OK) {
+            /* The other storages are still erased, the Matter stack is reset anyway */
+            ESP_LOGE(TAG, "Failed to erase partition %s namespace %s", storage->partition_label,
+                     storage->namespace_name);
+        }
+        s_marker.done_mask |= BIT(index);
+        store_marker();
+        set_progress(index + 1, step_count, 0, 0);
+        if (yield) {
+            vTaskDelay(1);
+        }
+    }
+}
+
+/* The reset of the Matter stack erases its configuration with the marker, and restarts the device */
+static void reset_matter_stack()
+{
+    if (journal::erase_all() != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to erase the attribute journal");
+    }
+    rtc_retention::erase_all();
+    ESP_LOGI(TAG, "Factory reset: resetting the Matter stack");
+    ConfigurationMgr().InitiateFactoryReset();
+}
+
+static void reset_task(void *arg)
+{
+    erase_storages(true);
+    reset_matter_stack();
+    vTaskDelete(NULL);
+}
+
+esp_err_t register_storage(const char *partition_label, const char *namespace_name, cleanup_callback_t cleanup)
+{
+    if (!partition_label || !namespace_name || strlen(partition_label) >= sizeof(storage_t::partition_label) ||
+        strlen(namespace_name) >= sizeof(storage_t::namespace_name)) {
+        ESP_LOGE(TAG, "Invalid partition label or namespace");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    for (size_t index = 0; index < s_registration_count; index++) {
+        storage_t *storage = &s_registrations[index].storage;
+        if (strcmp(storage->partition_label, partition_label) == 0 &&
+            strcmp(storage->namespace_name, namespace_name) == 0) {
+            s_registrations[index].cleanup = cleanup;
+            return ESP_OK;
+        }
+    }
+    if (s_registration_count >= k_max_storages) {
+        ESP_LOGE(TAG, "No room for the storage of partition %s namespace %s", partition_label, namespace_name);
+        return ESP_ERR_NO_MEM;
+    }
+    registration_t *registration = &s_registrations[s_registration_count++];
+    strlcpy(registration->storage.partition_label, partition_label, sizeof(registration->storage.partition_label));
+    strlcpy(registration->storage.namespace_name, namespace_name, sizeof(registration->storage.namespace_name));
+    registration->cleanup = cleanup;
+    return ESP_OK;
+}
+
+esp_err_t set_progress_callback(progress_callback_t callback, void *priv_data)
+{
+    s_progress_callback = callback;
+    s_progress_priv_data = priv_data;
+    return ESP_OK;
+}
+
+bool is_running()
+{
+    return s_running;
+}
+
+uint8_t get_progress()
+{
+    return s_progress;
+}
+
+esp_err_t start()
+{
+    if (s_running) {
+        ESP_LOGW(TAG, "A factory reset is running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (node::get()) {
+        /* The attribute values of the esp_matter data model */
+        register_storage(CONFIG_ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, attribute::close_nvs_handles);
+    }
+    /* The attribute values are no longer stored from now on, so that the erase is not undone */
+    s_running = true;
+    s_progress = 0;
+    memset(&s_marker, 0, sizeof(s_marker));
+    for (size_t index = 0; index < s_registration_count; index++) {
+        /* The owners of the storage drop what they would write back */
+        if (s_registrations[index].cleanup) {
+            s_registrations[index].cleanup();
+        }
+        s_marker.storages[s_marker.count++] = s_registrations[index].storage;
+    }
+    store_marker();
+    ESP_LOGI(TAG, "Factory reset: erasing %u storages in the background", (unsigned)s_marker.count);
+    if (xTaskCreate(reset_task, "mtr_reset", 3072, NULL, tskIDLE_PRIORITY + 1, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create the factory reset task, erasing the storages now");
+        erase_storages(false);
+        reset_matter_stack();
+    }
+    return ESP_OK;
+}
+
+bool resume()
+{
+    size_t length = 0;
+    memset(&s_marker, 0, sizeof(s_marker));
+    if (ESP32Config::ReadConfigValueBin(k_marker_key, (uint8_t *)&s_marker, sizeof(s_marker), length) !=
+            CHIP_NO_ERROR ||
+        length != sizeof(s_marker) || s_marker.count > k_max_storages) {
+        return false;
+    }
+    ESP_LOGW(TAG, "Resuming the factory reset interrupted by a restart");
+    s_running = true;
+    erase_storages(false);
+    return true;
+}
+
+void finish_resumed()
+{
+    reset_matter_stack();
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_start_handler(int argc, char **argv)
+{
+    return factory_reset();
+}
+
+static esp_err_t console_status_handler(int argc, char **argv)
+{
+    if (!s_running) {
+        printf("Factory reset: not running\n");
+        return ESP_OK;
+    }
+    printf("Factory reset: %u%%, %u/%u storages erased\n", (unsigned)s_progress,
+           (unsigned)__builtin_popcount(s_marker.done_mask), (unsigned)s_marker.count);
+    return ESP_OK;
+}
+
+static esp_matter::console::engine reset_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        reset_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return reset_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "factory_reset",
+        .description = "Factory reset in the background. Usage: matter esp factory_reset <start|status>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t reset_commands[] = {
+        {
+            .name = "start",
+            .description = "Erase the storage and reset the Matter stack, the device restarts at the end. "
+                           "Usage: matter esp factory_reset start",
+            .handler = console_start_handler,
+        },
+        {
+            .name = "status",
+            .description = "Print the progress of the factory reset. Usage: matter esp factory_reset status",
+            .handler = console_status_handler,
+        },
+    };
+    reset_console.register_commands(reset_commands, sizeof(reset_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace async_reset
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
@@ -0,0 +1,56 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+namespace esp_matter {
+namespace async_reset {
+
+#if CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+/**
+ * @brief Starts the factory reset in the background, called by esp_matter::factory_reset().
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if a factory reset is running, appropriate error code otherwise
+ */
+esp_err_t start();
+
+/**
+ * @brief Erases the storage left by a factory reset interrupted by a restart, called before the Matter init.
+ *
+ * @return true if a factory reset is resumed, finish_resumed() must then be called after the Matter init
+ */
+bool resume();
+
+/**
+ * @brief Ends the resumed factory reset, with the reset of the Matter stack which restarts the device.
+ */
+void finish_resumed();
+
+/**
+ * @brief Registers the factory reset console commands.
+ */
+void register_console_commands();
+#else
+inline bool resume()
+{
+    return false;
+}
+inline void finish_resumed() {}
+inline void register_console_commands() {}
+#endif // CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+
+} // namespace async_reset
+} // namespace esp_matter
@@ -0,0 +1,222 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_attribute_access.h>
+#include <esp_matter_core.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_trace.h>
+#include <inttypes.h>
+#include <new>
+#include <string.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+#include <app/AttributeAccessInterface.h>
+#include <app/util/attribute-storage.h>
+#include <lib/core/TLV.h>
+#include <protocols/interaction_model/StatusCode.h>
+
+using chip::app::AttributeValueEncoder;
+using chip::app::ConcreteReadAttributePath;
+using chip::Protocols::InteractionModel::Status;
+
+static const char *TAG = "esp_matter_attribute_access";
+
+namespace esp_matter {
+namespace attribute_access {
+
+template <typename T>
+static CHIP_ERROR encode_numeric(T value, bool nullable, AttributeValueEncoder &encoder)
+{
+    using Traits = chip::app::NumericAttributeTraits<T>;
+    /* The null values are stored as in the ember buffers, see encode_attr_val() */
+    if (nullable && Traits::IsNullValue(*(typename Traits::StorageType *)&value)) {
+        return encoder.EncodeNull();
+    }
+    return encoder.Encode(value);
+}
+
+/* List element copied from the storage of an array attribute, at the position of a reader */
+class tlv_element {
+public:
+    tlv_element(const chip::TLV::TLVReader &reader) : m_reader(reader) {}
+
+    CHIP_ERROR Encode(chip::TLV::TLVWriter &writer, chip::TLV::Tag tag) const
+    {
+        chip::TLV::TLVReader reader;
+        reader.Init(m_reader);
+        return writer.CopyElement(tag, reader);
+    }
+
+private:
+    const chip::TLV::TLVReader &m_reader;
+};
+
+/* The elements are encoded one by one from the storage, the encoder skips the ones already sent when the list is
+ * resumed in the next chunk of the report */
+static CHIP_ERROR encode_list(const esp_matter_val_t *val, AttributeValueEncoder &encoder)
+{
+    return encoder.EncodeList([val](const auto &item_encoder) -> CHIP_ERROR {
+        if (!val->a.b || val->a.s == 0) {
+            return CHIP_NO_ERROR;
+        }
+        chip::TLV::TLVReader reader;
+        reader.Init(val->a.b, val->a.s);
+        CHIP_ERROR err;
+        while ((err = reader.Next()) == CHIP_NO_ERROR) {
+            ReturnErrorOnFailure(item_encoder.Encode(tlv_element(reader)));
+        }
+        return err == CHIP_END_OF_TLV ? CHIP_NO_ERROR : err;
+    });
+}
+
+/* Returns CHIP_ERROR_NOT_IMPLEMENTED without encoding anything for the types which are left to the ember path */
+static CHIP_ERROR encode(esp_matter_val_type_t type, const esp_matter_val_t *val, AttributeValueEncoder &encoder)
+{
+    bool nullable = type & ESP_MATTER_VAL_NULLABLE_BASE;
+    switch (type) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BOOLEAN:
+        return encode_numeric<bool>(val->b, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INTEGER:
+        return encode_numeric<int32_t>(val->i, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_FLOAT:
+        return encode_numeric<float>(val->f, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT8:
+        return encode_numeric<int8_t>(val->i8, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP8:
+        return encode_numeric<uint8_t>(val->u8, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT16:
+        return encode_numeric<int16_t>(val->i16, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP16:
+        return encode_numeric<uint16_t>(val->u16, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_INT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT32:
+        return encode_numeric<int32_t>(val->i32, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP32:
+        return encode_numeric<uint32_t>(val->u32, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT64:
+        return encode_numeric<int64_t>(val->i64, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_UINT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT64:
+        return encode_numeric<uint64_t>(val->u64, nullable, encoder);
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING: {
+        size_t length = val->a.b ? strnlen((const char *)val->a.b, val->a.s) : 0;
+        return encoder.Encode(chip::CharSpan((const char *)val->a.b, length));
+    }
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+        return encoder.Encode(chip::ByteSpan(val->a.b, val->a.b ? val->a.s : 0));
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+        return encode_list(val, encoder);
+    default:
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+}
+
+class cluster_access : public chip::app::AttributeAccessInterface {
+public:
+    cluster_access(uint16_t endpoint_id, cluster_t *cluster)
+        : AttributeAccessInterface(chip::Optional<chip::EndpointId>(endpoint_id), cluster::get_id(cluster)),
+          m_cluster(cluster)
+    {
+    }
+
+    CHIP_ERROR Read(const ConcreteReadAttributePath &path, AttributeValueEncoder &encoder) override
+    {
+        attribute_t *attribute = attribute::get(m_cluster, path.mAttributeId);
+        /* Returning without encoding lets the read go through the ember path: the global attributes built by the
+         * stack, and the attributes with an override callback */
+        if (!attribute || (attribute::get_flags(attribute) & ATTRIBUTE_FLAG_OVERRIDE)) {
+            return CHIP_NO_ERROR;
+        }
+        esp_matter_val_type_t type = ESP_MATTER_VAL_TYPE_INVALID;
+        const esp_matter_val_t *value = attribute::get_val_storage(attribute, &type);
+        if (!value) {
+            return CHIP_NO_ERROR;
+        }
+        CHIP_ERROR err = encode(type, value, encoder);
+        if (err == CHIP_ERROR_NOT_IMPLEMENTED) {
+            return CHIP_NO_ERROR;
+        }
+        trace::record(trace::EVENT_ATTRIBUTE_READ, path.mEndpointId, path.mClusterId, path.mAttributeId,
+                      (uint8_t)(err == CHIP_NO_ERROR ? Status::Success : Status::Failure));
+        return err;
+    }
+
+private:
+    cluster_t *m_cluster;
+};
+
+esp_err_t register_cluster(uint16_t endpoint_id, cluster_t *cluster, cluster_access **access)
+{
+    if (!cluster || !access) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint32_t cluster_id = cluster::get_id(cluster);
+    if (*access || GetAttributeAccessOverride(endpoint_id, cluster_id)) {
+        /* Already registered, or served by the SDK */
+        return ESP_OK;
+    }
+    void *mem = esp_matter_mem_calloc(1, sizeof(cluster_access));
+    if (!mem) {
+        ESP_LOGE(TAG, "Couldn't allocate the attribute access interface of cluster 0x%08" PRIX32, cluster_id);
+        return ESP_ERR_NO_MEM;
+    }
+    cluster_access *new_access = new (mem) cluster_access(endpoint_id, cluster);
+    if (!registerAttributeAccessOverride(new_access)) {
+        ESP_LOGE(TAG, "Couldn't register the attribute access interface of endpoint 0x%04" PRIX16 "'s cluster 0x%08"
+                 PRIX32, endpoint_id, cluster_id);
+        new_access->~cluster_access();
+        esp_matter_mem_free(mem);
+        return ESP_FAIL;
+    }
+    *access = new_access;
+    return ESP_OK;
+}
+
+void unregister_cluster(cluster_access **access)
+{
+    if (!access || !*access) {
+        return;
+    }
+    unregisterAttributeAccessOverride(*access);
+    (*access)->~cluster_access();
+    esp_matter_mem_free(*access);
+    *access = NULL;
+}
+
+} // namespace attribute_access
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
@@ -0,0 +1,53 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace attribute_access {
+
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+/** AttributeAccessInterface of an esp_matter cluster */
+class cluster_access;
+
+/**
+ * @brief Registers the AttributeAccessInterface which encodes the attributes of the cluster straight from the
+ *        esp_matter database, called with the chip stack lock once the endpoint is added to the stack.
+ *
+ * Nothing is registered if an interface of the SDK already serves the cluster on the endpoint, or if the interface
+ * of the cluster is already registered.
+ *
+ * @param endpoint_id Endpoint ID of the cluster
+ * @param cluster     Cluster handle
+ * @param access      Interface of the cluster, set when it is registered
+ *
+ * @return ESP_OK on success, error otherwise
+ */
+esp_err_t register_cluster(uint16_t endpoint_id, cluster_t *cluster, cluster_access **access);
+
+/**
+ * @brief Unregisters and frees the AttributeAccessInterface of a cluster, called with the chip stack lock before the
+ *        endpoint is removed from the stack. Nothing is done if it is not registered.
+ *
+ * @param access Interface of the cluster, reset to NULL
+ */
+void unregister_cluster(cluster_access **access);
+#endif // CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_ACCESS_INTERFACE
+
+} // namespace attribute_access
+} // namespace esp_matter
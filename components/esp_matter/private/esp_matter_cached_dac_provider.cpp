@@ -0,0 +1,192 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <string.h>
+
+#include <credentials/CHIPCert.h>
+#include <credentials/CertificationDeclaration.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
+
+#if CONFIG_ESP_MATTER_CACHE_DAC_KEY
+#include <esp_secure_cert_read.h>
+#include <mbedtls/pk.h>
+#endif
+
+#include <esp_matter_cached_dac_provider.h>
+
+using namespace chip;
+using namespace chip::Credentials;
+
+constexpr char TAG[] = "cached_dac";
+
+namespace esp_matter {
+
+static constexpr size_t k_scratch_size =
+    kMaxDERCertLength > kMaxCMSSignedCDMessage ? kMaxDERCertLength : kMaxCMSSignedCDMessage;
+
+CHIP_ERROR CachedDACProvider::Load(DeviceAttestationCredentialsProvider *provider)
+{
+    VerifyOrReturnError(provider, CHIP_ERROR_INVALID_ARGUMENT);
+    mProvider = provider;
+
+    Platform::ScopedMemoryBuffer<uint8_t> scratch;
+    VerifyOrReturnError(scratch.Alloc(k_scratch_size), CHIP_ERROR_NO_MEMORY);
+    for (size_t id = 0; id < kDataCount; ++id) {
+        MutableByteSpan span(scratch.Get(), k_scratch_size);
+        CHIP_ERROR err = CHIP_ERROR_INTERNAL;
+        switch (id) {
+        case kCertificationDeclaration: err = provider->GetCertificationDeclaration(span); break;
+        case kDeviceAttestationCert: err = provider->GetDeviceAttestationCert(span); break;
+        case kProductAttestationIntermediateCert: err = provider->GetProductAttestationIntermediateCert(span); break;
+        default: break;
+        }
+        Data &data = mData[id];
+        esp_matter_mem_free(data.mBuffer);
+        data.mBuffer = nullptr;
+        data.mLength = 0;
+        data.mError = err;
+        if (err != CHIP_NO_ERROR || span.size() == 0) {
+            continue;
+        }
+        data.mBuffer = (uint8_t *)esp_matter_mem_calloc(1, span.size());
+        if (!data.mBuffer) {
+            // Serve this one from the wrapped provider
+            data.mError = CHIP_ERROR_NO_MEMORY;
+            continue;
+        }
+        memcpy(data.mBuffer, span.data(), span.size());
+        data.mLength = span.size();
+    }
+    ESP_LOGI(TAG, "Attestation certificates cached in %u bytes", (unsigned)GetCacheSize());
+    return CHIP_NO_ERROR;
+}
+
+size_t CachedDACProvider::GetCacheSize() const
+{
+    size_t size = sizeof(*this);
+    for (size_t id = 0; id < kDataCount; ++id) {
+        size += mData[id].mLength;
+    }
+    return size;
+}
+
+CHIP_ERROR CachedDACProvider::CopyData(DataId id, MutableByteSpan &outBuffer) const
+{
+    const Data &data = mData[id];
+    ReturnErrorOnFailure(data.mError);
+    return CopySpanToMutableSpan(ByteSpan(data.mBuffer, data.mLength), outBuffer);
+}
+
+CHIP_ERROR CachedDACProvider::GetCertificationDeclaration(MutableByteSpan &outBuffer)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    if (mData[kCertificationDeclaration].mError == CHIP_ERROR_NO_MEMORY) {
+        return mProvider->GetCertificationDeclaration(outBuffer);
+    }
+    return CopyData(kCertificationDeclaration, outBuffer);
+}
+
+CHIP_ERROR CachedDACProvider::GetFirmwareInformation(MutableByteSpan &outBuffer)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    return mProvider->GetFirmwareInformation(outBuffer);
+}
+
+CHIP_ERROR CachedDACProvider::GetDeviceAttestationCert(MutableByteSpan &outBuffer)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    if (mData[kDeviceAttestationCert].mError == CHIP_ERROR_NO_MEMORY) {
+        return mProvider->GetDeviceAttestationCert(outBuffer);
+    }
+    return CopyData(kDeviceAttestationCert, outBuffer);
+}
+
+CHIP_ERROR CachedDACProvider::GetProductAttestationIntermediateCert(MutableByteSpan &outBuffer)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    if (mData[kProductAttestationIntermediateCert].mError == CHIP_ERROR_NO_MEMORY) {
+        return mProvider->GetProductAttestationIntermediateCert(outBuffer);
+    }
+    return CopyData(kProductAttestationIntermediateCert, outBuffer);
+}
+
+#if CONFIG_ESP_MATTER_CACHE_DAC_KEY
+CHIP_ERROR CachedDACProvider::LoadKeypair()
+{
+    // The public key of the key pair is the one of the DAC
+    uint8_t dac_buf[kMaxDERCertLength];
+    MutableByteSpan dac(dac_buf);
+    ReturnErrorOnFailure(GetDeviceAttestationCert(dac));
+    Crypto::P256PublicKey public_key;
+    ReturnErrorOnFailure(ExtractPubkeyFromX509Cert(dac, public_key));
+
+    char *key = NULL;
+    uint32_t key_len = 0;
+    esp_err_t esp_err = esp_secure_cert_get_priv_key(&key, &key_len);
+    VerifyOrReturnError(esp_err == ESP_OK && key, CHIP_ERROR_READ_FAILED,
+                        ESP_LOGE(TAG, "Failed to read the DAC private key, err:%d", esp_err));
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    Crypto::P256SerializedKeypair serialized;
+    mbedtls_pk_context pk;
+    mbedtls_pk_init(&pk);
+    int ret = mbedtls_pk_parse_key(&pk, (const uint8_t *)key, key_len, NULL, 0, NULL, NULL);
+    esp_secure_cert_free_priv_key(key);
+    if (ret != 0 || mbedtls_pk_get_type(&pk) != MBEDTLS_PK_ECKEY) {
+        ESP_LOGE(TAG, "Failed to parse the DAC private key, ret:-0x%x", (unsigned)-ret);
+        err = CHIP_ERROR_INVALID_ARGUMENT;
+    } else {
+        // The serialized key pair is the uncompressed public key followed by the private scalar
+        uint8_t *out = serialized.Bytes();
+        memcpy(out, public_key.ConstBytes(), public_key.Length());
+        ret = mbedtls_mpi_write_binary(&mbedtls_pk_ec(pk)->MBEDTLS_PRIVATE(d), out + public_key.Length(),
+                                       Crypto::kP256_PrivateKey_Length);
+        err = ret == 0 ? serialized.SetLength(public_key.Length() + Crypto::kP256_PrivateKey_Length)
+                       : CHIP_ERROR_INVALID_ARGUMENT;
+    }
+    mbedtls_pk_free(&pk);
+    if (err == CHIP_NO_ERROR) {
+        err = mKeypair.Deserialize(serialized);
+    }
+    Crypto::ClearSecretData(serialized.Bytes(), serialized.Capacity());
+    ReturnErrorOnFailure(err);
+    mKeypairLoaded = true;
+    return CHIP_NO_ERROR;
+}
+#endif
+
+CHIP_ERROR CachedDACProvider::SignWithDeviceAttestationKey(const ByteSpan &messageToSign,
+                                                          MutableByteSpan &outSignBuffer)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+#if CONFIG_ESP_MATTER_CACHE_DAC_KEY
+    if (!mKeypairLoaded && LoadKeypair() != CHIP_NO_ERROR) {
+        ESP_LOGW(TAG, "Signing with the wrapped provider");
+        return mProvider->SignWithDeviceAttestationKey(messageToSign, outSignBuffer);
+    }
+    Crypto::P256ECDSASignature signature;
+    VerifyOrReturnError(IsSpanUsable(outSignBuffer), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(IsSpanUsable(messageToSign), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(outSignBuffer.size() >= signature.Capacity(), CHIP_ERROR_BUFFER_TOO_SMALL);
+    ReturnErrorOnFailure(mKeypair.ECDSA_sign_msg(messageToSign.data(), messageToSign.size(), signature));
+    return CopySpanToMutableSpan(ByteSpan(signature.ConstBytes(), signature.Length()), outSignBuffer);
+#else
+    return mProvider->SignWithDeviceAttestationKey(messageToSign, outSignBuffer);
+#endif
+}
+
+} // namespace esp_matter
@@ -0,0 +1,74 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <credentials/DeviceAttestationCredsProvider.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/support/Span.h>
+
+namespace esp_matter {
+
+/**
+ * Attestation credentials provider serving the certificates from RAM.
+ *
+ * Load() reads the DAC, the PAI and the Certification Declaration once from the wrapped provider, at boot, and the
+ * getters then copy them from RAM. With CONFIG_ESP_MATTER_CACHE_DAC_KEY the private key of the DAC is read from the
+ * esp_secure_cert partition and parsed at the first signature, the key pair is kept for the next signatures of the
+ * AttestationRequest and the CSRRequest. Otherwise the signatures are forwarded to the wrapped provider.
+ */
+class CachedDACProvider : public chip::Credentials::DeviceAttestationCredentialsProvider
+{
+public:
+    CHIP_ERROR Load(chip::Credentials::DeviceAttestationCredentialsProvider *provider);
+    size_t GetCacheSize() const;
+
+    CHIP_ERROR GetCertificationDeclaration(chip::MutableByteSpan &outBuffer) override;
+    CHIP_ERROR GetFirmwareInformation(chip::MutableByteSpan &outBuffer) override;
+    CHIP_ERROR GetDeviceAttestationCert(chip::MutableByteSpan &outBuffer) override;
+    CHIP_ERROR GetProductAttestationIntermediateCert(chip::MutableByteSpan &outBuffer) override;
+    CHIP_ERROR SignWithDeviceAttestationKey(const chip::ByteSpan &messageToSign,
+                                            chip::MutableByteSpan &outSignBuffer) override;
+
+private:
+    enum DataId : uint8_t
+    {
+        kCertificationDeclaration = 0,
+        kDeviceAttestationCert,
+        kProductAttestationIntermediateCert,
+        kDataCount,
+    };
+
+    struct Data
+    {
+        uint8_t *mBuffer = nullptr;
+        uint16_t mLength = 0;
+        CHIP_ERROR mError = CHIP_ERROR_INCORRECT_STATE;
+    };
+
+    CHIP_ERROR CopyData(DataId id, chip::MutableByteSpan &outBuffer) const;
+#if CONFIG_ESP_MATTER_CACHE_DAC_KEY
+    CHIP_ERROR LoadKeypair();
+
+    chip::Crypto::P256Keypair mKeypair;
+    bool mKeypairLoaded = false;
+#endif
+
+    chip::Credentials::DeviceAttestationCredentialsProvider *mProvider = nullptr;
+    Data mData[kDataCount];
+};
+
+} // namespace esp_matter
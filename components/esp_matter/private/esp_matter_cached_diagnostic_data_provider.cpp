@@ -0,0 +1,294 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <lib/support/CodeUtils.h>
+
+#include <esp_matter_cached_diagnostic_data_provider.h>
+
+#if CONFIG_ESP_MATTER_CACHE_DIAGNOSTICS
+
+using namespace chip;
+using namespace chip::DeviceLayer;
+using namespace chip::app::Clusters;
+
+namespace esp_matter {
+
+static constexpr System::Clock::Milliseconds32 k_sample_period(CONFIG_ESP_MATTER_DIAGNOSTICS_SAMPLE_PERIOD_MS);
+
+bool CachedDiagnosticDataProvider::IsFresh(bool sampled, System::Clock::Timestamp time) const
+{
+    return sampled && System::SystemClock().GetMonotonicTimestamp() - time < k_sample_period;
+}
+
+template <typename T>
+CHIP_ERROR CachedDiagnosticDataProvider::Read(Sample<T> &sample, T &value,
+                                              CHIP_ERROR (DiagnosticDataProvider::*getter)(T &), bool once)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    if (!(once && sample.mSampled) && !IsFresh(sample.mSampled, sample.mTime)) {
+        sample.mError = (mProvider->*getter)(sample.mValue);
+        sample.mTime = System::SystemClock().GetMonotonicTimestamp();
+        sample.mSampled = true;
+    }
+    if (sample.mError == CHIP_NO_ERROR) {
+        value = sample.mValue;
+    }
+    return sample.mError;
+}
+
+bool CachedDiagnosticDataProvider::SupportsWatermarks()
+{
+    return mProvider && mProvider->SupportsWatermarks();
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetCurrentHeapFree(uint64_t &currentHeapFree)
+{
+    return Read(mHeapFree, currentHeapFree, &DiagnosticDataProvider::GetCurrentHeapFree);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetCurrentHeapUsed(uint64_t &currentHeapUsed)
+{
+    return Read(mHeapUsed, currentHeapUsed, &DiagnosticDataProvider::GetCurrentHeapUsed);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetCurrentHeapHighWatermark(uint64_t &currentHeapHighWatermark)
+{
+    return Read(mHeapHighWatermark, currentHeapHighWatermark, &DiagnosticDataProvider::GetCurrentHeapHighWatermark);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::ResetWatermarks()
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    mHeapHighWatermark.mSampled = false;
+    return mProvider->ResetWatermarks();
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetThreadMetrics(ThreadMetrics **threadMetricsOut)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    return mProvider->GetThreadMetrics(threadMetricsOut);
+}
+
+void CachedDiagnosticDataProvider::ReleaseThreadMetrics(ThreadMetrics *threadMetrics)
+{
+    if (mProvider) {
+        mProvider->ReleaseThreadMetrics(threadMetrics);
+    }
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetRebootCount(uint16_t &rebootCount)
+{
+    return Read(mRebootCount, rebootCount, &DiagnosticDataProvider::GetRebootCount, true);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetUpTime(uint64_t &upTime)
+{
+    // Computed from the system clock, and expected to increase at each read
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    return mProvider->GetUpTime(upTime);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetTotalOperationalHours(uint32_t &totalOperationalHours)
+{
+    return Read(mTotalOperationalHours, totalOperationalHours, &DiagnosticDataProvider::GetTotalOperationalHours);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetBootReason(BootReasonType &bootReason)
+{
+    return Read(mBootReason, bootReason, &DiagnosticDataProvider::GetBootReason, true);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetActiveHardwareFaults(GeneralFaults<kMaxHardwareFaults> &hardwareFaults)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    return mProvider->GetActiveHardwareFaults(hardwareFaults);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetActiveRadioFaults(GeneralFaults<kMaxRadioFaults> &radioFaults)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    return mProvider->GetActiveRadioFaults(radioFaults);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetActiveNetworkFaults(GeneralFaults<kMaxNetworkFaults> &networkFaults)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    return mProvider->GetActiveNetworkFaults(networkFaults);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetNetworkInterfaces(NetworkInterface **netifpp)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    return mProvider->GetNetworkInterfaces(netifpp);
+}
+
+void CachedDiagnosticDataProvider::ReleaseNetworkInterfaces(NetworkInterface *netifp)
+{
+    if (mProvider) {
+        mProvider->ReleaseNetworkInterfaces(netifp);
+    }
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetEthPHYRate(EthernetNetworkDiagnostics::PHYRateEnum &pHYRate)
+{
+    return Read(mEthPHYRate, pHYRate, &DiagnosticDataProvider::GetEthPHYRate);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetEthFullDuplex(bool &fullDuplex)
+{
+    return Read(mEthFullDuplex, fullDuplex, &DiagnosticDataProvider::GetEthFullDuplex);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetEthCarrierDetect(bool &carrierDetect)
+{
+    return Read(mEthCarrierDetect, carrierDetect, &DiagnosticDataProvider::GetEthCarrierDetect);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetEthTimeSinceReset(uint64_t &timeSinceReset)
+{
+    // Computed from the system clock, as the up time
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    return mProvider->GetEthTimeSinceReset(timeSinceReset);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetEthPacketRxCount(uint64_t &packetRxCount)
+{
+    return Read(mEthPacketRxCount, packetRxCount, &DiagnosticDataProvider::GetEthPacketRxCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetEthPacketTxCount(uint64_t &packetTxCount)
+{
+    return Read(mEthPacketTxCount, packetTxCount, &DiagnosticDataProvider::GetEthPacketTxCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetEthTxErrCount(uint64_t &txErrCount)
+{
+    return Read(mEthTxErrCount, txErrCount, &DiagnosticDataProvider::GetEthTxErrCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetEthCollisionCount(uint64_t &collisionCount)
+{
+    return Read(mEthCollisionCount, collisionCount, &DiagnosticDataProvider::GetEthCollisionCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetEthOverrunCount(uint64_t &overrunCount)
+{
+    return Read(mEthOverrunCount, overrunCount, &DiagnosticDataProvider::GetEthOverrunCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::ResetEthNetworkDiagnosticsCounts()
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    mEthPacketRxCount.mSampled = false;
+    mEthPacketTxCount.mSampled = false;
+    mEthTxErrCount.mSampled = false;
+    mEthCollisionCount.mSampled = false;
+    mEthOverrunCount.mSampled = false;
+    return mProvider->ResetEthNetworkDiagnosticsCounts();
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiBssId(MutableByteSpan &BssId)
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    if (!IsFresh(mBssIdSampled, mBssIdTime)) {
+        MutableByteSpan bssid(mBssId);
+        mBssIdError = mProvider->GetWiFiBssId(bssid);
+        mBssIdLength = mBssIdError == CHIP_NO_ERROR ? bssid.size() : 0;
+        mBssIdTime = System::SystemClock().GetMonotonicTimestamp();
+        mBssIdSampled = true;
+    }
+    ReturnErrorOnFailure(mBssIdError);
+    return CopySpanToMutableSpan(ByteSpan(mBssId, mBssIdLength), BssId);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiSecurityType(WiFiNetworkDiagnostics::SecurityTypeEnum &securityType)
+{
+    return Read(mWiFiSecurityType, securityType, &DiagnosticDataProvider::GetWiFiSecurityType);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiVersion(WiFiNetworkDiagnostics::WiFiVersionEnum &wiFiVersion)
+{
+    return Read(mWiFiVersion, wiFiVersion, &DiagnosticDataProvider::GetWiFiVersion);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiChannelNumber(uint16_t &channelNumber)
+{
+    return Read(mWiFiChannelNumber, channelNumber, &DiagnosticDataProvider::GetWiFiChannelNumber);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiRssi(int8_t &rssi)
+{
+    return Read(mWiFiRssi, rssi, &DiagnosticDataProvider::GetWiFiRssi);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiBeaconLostCount(uint32_t &beaconLostCount)
+{
+    return Read(mWiFiBeaconLostCount, beaconLostCount, &DiagnosticDataProvider::GetWiFiBeaconLostCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiBeaconRxCount(uint32_t &beaconRxCount)
+{
+    return Read(mWiFiBeaconRxCount, beaconRxCount, &DiagnosticDataProvider::GetWiFiBeaconRxCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiPacketMulticastRxCount(uint32_t &packetMulticastRxCount)
+{
+    return Read(mWiFiPacketMulticastRxCount, packetMulticastRxCount,
+                &DiagnosticDataProvider::GetWiFiPacketMulticastRxCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiPacketMulticastTxCount(uint32_t &packetMulticastTxCount)
+{
+    return Read(mWiFiPacketMulticastTxCount, packetMulticastTxCount,
+                &DiagnosticDataProvider::GetWiFiPacketMulticastTxCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiPacketUnicastRxCount(uint32_t &packetUnicastRxCount)
+{
+    return Read(mWiFiPacketUnicastRxCount, packetUnicastRxCount, &DiagnosticDataProvider::GetWiFiPacketUnicastRxCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiPacketUnicastTxCount(uint32_t &packetUnicastTxCount)
+{
+    return Read(mWiFiPacketUnicastTxCount, packetUnicastTxCount, &DiagnosticDataProvider::GetWiFiPacketUnicastTxCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiCurrentMaxRate(uint64_t &currentMaxRate)
+{
+    return Read(mWiFiCurrentMaxRate, currentMaxRate, &DiagnosticDataProvider::GetWiFiCurrentMaxRate);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::GetWiFiOverrunCount(uint64_t &overrunCount)
+{
+    return Read(mWiFiOverrunCount, overrunCount, &DiagnosticDataProvider::GetWiFiOverrunCount);
+}
+
+CHIP_ERROR CachedDiagnosticDataProvider::ResetWiFiNetworkDiagnosticsCounts()
+{
+    VerifyOrReturnError(mProvider, CHIP_ERROR_INCORRECT_STATE);
+    mWiFiBeaconLostCount.mSampled = false;
+    mWiFiBeaconRxCount.mSampled = false;
+    mWiFiPacketMulticastRxCount.mSampled = false;
+    mWiFiPacketMulticastTxCount.mSampled = false;
+    mWiFiPacketUnicastRxCount.mSampled = false;
+    mWiFiPacketUnicastTxCount.mSampled = false;
+    mWiFiOverrunCount.mSampled = false;
+    return mProvider->ResetWiFiNetworkDiagnosticsCounts();
+}
+
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_CACHE_DIAGNOSTICS
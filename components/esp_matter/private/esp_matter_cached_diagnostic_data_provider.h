@@ -0,0 +1,149 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <platform/DiagnosticDataProvider.h>
+#include <system/SystemClock.h>
+
+namespace esp_matter {
+
+/**
+ * Diagnostic data provider serving the diagnostics attributes from samples of the wrapped provider.
+ *
+ * The General, Wi-Fi and Ethernet Network Diagnostics clusters read every attribute from the provider, and
+ * DiagnosticDataProviderImpl queries the heap, the Wi-Fi driver or the Ethernet driver for each read, for each
+ * subscription report. A value is sampled from the wrapped provider on its first read after
+ * CONFIG_ESP_MATTER_DIAGNOSTICS_SAMPLE_PERIOD_MS, and the reads in between are served from the sample, with the
+ * error of the wrapped provider as well. The reboot count and the boot reason do not change during a boot and are
+ * sampled once.
+ *
+ * The reset of the watermarks and of the network counts is forwarded to the wrapped provider and drops the samples
+ * of the values reset. The thread metrics, the network interfaces and the active faults are lists allocated or
+ * updated by the wrapped provider, they are forwarded.
+ */
+class CachedDiagnosticDataProvider : public chip::DeviceLayer::DiagnosticDataProvider
+{
+public:
+    void SetProvider(chip::DeviceLayer::DiagnosticDataProvider *provider) { mProvider = provider; }
+
+    // General Diagnostics
+    bool SupportsWatermarks() override;
+    CHIP_ERROR GetCurrentHeapFree(uint64_t &currentHeapFree) override;
+    CHIP_ERROR GetCurrentHeapUsed(uint64_t &currentHeapUsed) override;
+    CHIP_ERROR GetCurrentHeapHighWatermark(uint64_t &currentHeapHighWatermark) override;
+    CHIP_ERROR ResetWatermarks() override;
+    CHIP_ERROR GetThreadMetrics(chip::DeviceLayer::ThreadMetrics **threadMetricsOut) override;
+    void ReleaseThreadMetrics(chip::DeviceLayer::ThreadMetrics *threadMetrics) override;
+    CHIP_ERROR GetRebootCount(uint16_t &rebootCount) override;
+    CHIP_ERROR GetUpTime(uint64_t &upTime) override;
+    CHIP_ERROR GetTotalOperationalHours(uint32_t &totalOperationalHours) override;
+    CHIP_ERROR GetBootReason(chip::DeviceLayer::BootReasonType &bootReason) override;
+    CHIP_ERROR GetActiveHardwareFaults(
+        chip::DeviceLayer::GeneralFaults<chip::DeviceLayer::kMaxHardwareFaults> &hardwareFaults) override;
+    CHIP_ERROR GetActiveRadioFaults(
+        chip::DeviceLayer::GeneralFaults<chip::DeviceLayer::kMaxRadioFaults> &radioFaults) override;
+    CHIP_ERROR GetActiveNetworkFaults(
+        chip::DeviceLayer::GeneralFaults<chip::DeviceLayer::kMaxNetworkFaults> &networkFaults) override;
+    CHIP_ERROR GetNetworkInterfaces(chip::DeviceLayer::NetworkInterface **netifpp) override;
+    void ReleaseNetworkInterfaces(chip::DeviceLayer::NetworkInterface *netifp) override;
+
+    // Ethernet Network Diagnostics
+    CHIP_ERROR GetEthPHYRate(chip::app::Clusters::EthernetNetworkDiagnostics::PHYRateEnum &pHYRate) override;
+    CHIP_ERROR GetEthFullDuplex(bool &fullDuplex) override;
+    CHIP_ERROR GetEthCarrierDetect(bool &carrierDetect) override;
+    CHIP_ERROR GetEthTimeSinceReset(uint64_t &timeSinceReset) override;
+    CHIP_ERROR GetEthPacketRxCount(uint64_t &packetRxCount) override;
+    CHIP_ERROR GetEthPacketTxCount(uint64_t &packetTxCount) override;
+    CHIP_ERROR GetEthTxErrCount(uint64_t &txErrCount) override;
+    CHIP_ERROR GetEthCollisionCount(uint64_t &collisionCount) override;
+    CHIP_ERROR GetEthOverrunCount(uint64_t &overrunCount) override;
+    CHIP_ERROR ResetEthNetworkDiagnosticsCounts() override;
+
+    // Wi-Fi Network Diagnostics
+    CHIP_ERROR GetWiFiBssId(chip::MutableByteSpan &BssId) override;
+    CHIP_ERROR
+    GetWiFiSecurityType(chip::app::Clusters::WiFiNetworkDiagnostics::SecurityTypeEnum &securityType) override;
+    CHIP_ERROR GetWiFiVersion(chip::app::Clusters::WiFiNetworkDiagnostics::WiFiVersionEnum &wiFiVersion) override;
+    CHIP_ERROR GetWiFiChannelNumber(uint16_t &channelNumber) override;
+    CHIP_ERROR GetWiFiRssi(int8_t &rssi) override;
+    CHIP_ERROR GetWiFiBeaconLostCount(uint32_t &beaconLostCount) override;
+    CHIP_ERROR GetWiFiBeaconRxCount(uint32_t &beaconRxCount) override;
+    CHIP_ERROR GetWiFiPacketMulticastRxCount(uint32_t &packetMulticastRxCount) override;
+    CHIP_ERROR GetWiFiPacketMulticastTxCount(uint32_t &packetMulticastTxCount) override;
+    CHIP_ERROR GetWiFiPacketUnicastRxCount(uint32_t &packetUnicastRxCount) override;
+    CHIP_ERROR GetWiFiPacketUnicastTxCount(uint32_t &packetUnicastTxCount) override;
+    CHIP_ERROR GetWiFiCurrentMaxRate(uint64_t &currentMaxRate) override;
+    CHIP_ERROR GetWiFiOverrunCount(uint64_t &overrunCount) override;
+    CHIP_ERROR ResetWiFiNetworkDiagnosticsCounts() override;
+
+private:
+    static constexpr size_t kMaxBssIdLength = 6;
+
+    template <typename T>
+    struct Sample
+    {
+        T mValue{};
+        CHIP_ERROR mError = CHIP_ERROR_INCORRECT_STATE;
+        chip::System::Clock::Timestamp mTime = chip::System::Clock::kZero;
+        bool mSampled = false;
+    };
+
+    /* Serve the value from the sample, sampled again with the getter of the wrapped provider once it is too old,
+     * or only once for the values which do not change during a boot */
+    template <typename T>
+    CHIP_ERROR Read(Sample<T> &sample, T &value, CHIP_ERROR (chip::DeviceLayer::DiagnosticDataProvider::*getter)(T &),
+                    bool once = false);
+    bool IsFresh(bool sampled, chip::System::Clock::Timestamp time) const;
+
+    chip::DeviceLayer::DiagnosticDataProvider *mProvider = nullptr;
+
+    Sample<uint64_t> mHeapFree;
+    Sample<uint64_t> mHeapUsed;
+    Sample<uint64_t> mHeapHighWatermark;
+    Sample<uint16_t> mRebootCount;
+    Sample<uint32_t> mTotalOperationalHours;
+    Sample<chip::DeviceLayer::BootReasonType> mBootReason;
+
+    Sample<chip::app::Clusters::EthernetNetworkDiagnostics::PHYRateEnum> mEthPHYRate;
+    Sample<bool> mEthFullDuplex;
+    Sample<bool> mEthCarrierDetect;
+    Sample<uint64_t> mEthPacketRxCount;
+    Sample<uint64_t> mEthPacketTxCount;
+    Sample<uint64_t> mEthTxErrCount;
+    Sample<uint64_t> mEthCollisionCount;
+    Sample<uint64_t> mEthOverrunCount;
+
+    uint8_t mBssId[kMaxBssIdLength];
+    size_t mBssIdLength = 0;
+    CHIP_ERROR mBssIdError = CHIP_ERROR_INCORRECT_STATE;
+    chip::System::Clock::Timestamp mBssIdTime = chip::System::Clock::kZero;
+    bool mBssIdSampled = false;
+    Sample<chip::app::Clusters::WiFiNetworkDiagnostics::SecurityTypeEnum> mWiFiSecurityType;
+    Sample<chip::app::Clusters::WiFiNetworkDiagnostics::WiFiVersionEnum> mWiFiVersion;
+    Sample<uint16_t> mWiFiChannelNumber;
+    Sample<int8_t> mWiFiRssi;
+    Sample<uint32_t> mWiFiBeaconLostCount;
+    Sample<uint32_t> mWiFiBeaconRxCount;
+    Sample<uint32_t> mWiFiPacketMulticastRxCount;
+    Sample<uint32_t> mWiFiPacketMulticastTxCount;
+    Sample<uint32_t> mWiFiPacketUnicastRxCount;
+    Sample<uint32_t> mWiFiPacketUnicastTxCount;
+    Sample<uint64_t> mWiFiCurrentMaxRate;
+    Sample<uint64_t> mWiFiOverrunCount;
+};
+
+} // namespace esp_matter
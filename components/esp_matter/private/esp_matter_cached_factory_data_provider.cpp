@@ -0,0 +1,275 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <string.h>
+
+#include <lib/support/CodeUtils.h>
+#include <platform/ConfigurationManager.h>
+
+#include <esp_matter_cached_factory_data_provider.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer;
+using namespace chip::app::Clusters::BasicInformation;
+
+constexpr char TAG[] = "cached_factory_data";
+
+namespace esp_matter {
+
+/* Size of the buffers the strings are read into, with the NUL character */
+static constexpr size_t k_string_buf_size[] = {
+    ConfigurationManager::kMaxVendorNameLength + 1,   ConfigurationManager::kMaxProductNameLength + 1,
+    ConfigurationManager::kMaxPartNumberLength + 1,   ConfigurationManager::kMaxProductURLLength + 1,
+    ConfigurationManager::kMaxProductLabelLength + 1, ConfigurationManager::kMaxSerialNumberLength + 1,
+    ConfigurationManager::kMaxHardwareVersionStringLength + 1,
+};
+
+CHIP_ERROR CachedFactoryDataProvider::Load(CommissionableDataProvider *commissionable,
+                                           DeviceInstanceInfoProvider *device_instance_info)
+{
+    static_assert(sizeof(k_string_buf_size) / sizeof(k_string_buf_size[0]) == kStringCount,
+                  "A buffer size is needed for each string");
+    mCommissionable = commissionable;
+    mDeviceInstanceInfo = device_instance_info;
+
+    if (commissionable) {
+        mDiscriminator.mError = commissionable->GetSetupDiscriminator(mDiscriminator.mValue);
+        mIterationCount.mError = commissionable->GetSpake2pIterationCount(mIterationCount.mValue);
+        mPasscode.mError = commissionable->GetSetupPasscode(mPasscode.mValue);
+
+        MutableByteSpan salt(mSalt);
+        mSaltError = commissionable->GetSpake2pSalt(salt);
+        mSaltLength = mSaltError == CHIP_NO_ERROR ? salt.size() : 0;
+
+        MutableByteSpan verifier(mVerifier);
+        size_t verifier_length = 0;
+        mVerifierError = commissionable->GetSpake2pVerifier(verifier, verifier_length);
+        mVerifierLength = mVerifierError == CHIP_NO_ERROR ? verifier_length : 0;
+    }
+
+    if (!device_instance_info) {
+        return CHIP_NO_ERROR;
+    }
+    mVendorId.mError = device_instance_info->GetVendorId(mVendorId.mValue);
+    mProductId.mError = device_instance_info->GetProductId(mProductId.mValue);
+    mHardwareVersion.mError = device_instance_info->GetHardwareVersion(mHardwareVersion.mValue);
+    mProductFinish.mError = device_instance_info->GetProductFinish(&mProductFinish.mValue);
+    mPrimaryColor.mError = device_instance_info->GetProductPrimaryColor(&mPrimaryColor.mValue);
+    mManufacturingDateError = device_instance_info->GetManufacturingDate(
+        mManufacturingDate.year, mManufacturingDate.month, mManufacturingDate.day);
+
+    MutableByteSpan unique_id(mUniqueId);
+    mUniqueIdError = device_instance_info->GetRotatingDeviceIdUniqueId(unique_id);
+    mUniqueIdLength = mUniqueIdError == CHIP_NO_ERROR ? unique_id.size() : 0;
+
+    // Read the strings one after the other in a buffer of their maximum lengths, then shrink it to what they use
+    size_t pool_size = 0;
+    for (size_t id = 0; id < kStringCount; ++id) {
+        pool_size += k_string_buf_size[id];
+    }
+    char *pool = (char *)esp_matter_mem_calloc(1, pool_size);
+    VerifyOrReturnError(pool, CHIP_ERROR_NO_MEMORY, ESP_LOGE(TAG, "Failed to allocate the string buffer"));
+    size_t used = 0;
+    for (size_t id = 0; id < kStringCount; ++id) {
+        char *buf = pool + used;
+        size_t size = k_string_buf_size[id];
+        CHIP_ERROR err = CHIP_ERROR_INTERNAL;
+        switch (id) {
+        case kVendorName: err = device_instance_info->GetVendorName(buf, size); break;
+        case kProductName: err = device_instance_info->GetProductName(buf, size); break;
+        case kPartNumber: err = device_instance_info->GetPartNumber(buf, size); break;
+        case kProductURL: err = device_instance_info->GetProductURL(buf, size); break;
+        case kProductLabel: err = device_instance_info->GetProductLabel(buf, size); break;
+        case kSerialNumber: err = device_instance_info->GetSerialNumber(buf, size); break;
+        case kHardwareVersionString: err = device_instance_info->GetHardwareVersionString(buf, size); break;
+        default: break;
+        }
+        mStrings[id].mError = err;
+        mStrings[id].mValue = used;
+        if (err == CHIP_NO_ERROR) {
+            used += strnlen(buf, size - 1) + 1;
+        }
+    }
+    if (used == 0) {
+        esp_matter_mem_free(pool);
+        pool = nullptr;
+    } else {
+        char *shrunk = (char *)esp_matter_mem_realloc(pool, used);
+        pool = shrunk ? shrunk : pool;
+    }
+    esp_matter_mem_free(mStringPool);
+    mStringPool = pool;
+    mStringPoolSize = used;
+    ESP_LOGI(TAG, "Factory data cached in %u bytes", (unsigned)GetCacheSize());
+    return CHIP_NO_ERROR;
+}
+
+size_t CachedFactoryDataProvider::GetCacheSize() const
+{
+    return sizeof(*this) + mStringPoolSize;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::CopyString(StringId id, char *buf, size_t bufSize) const
+{
+    ReturnErrorOnFailure(mStrings[id].mError);
+    VerifyOrReturnError(buf, CHIP_ERROR_INVALID_ARGUMENT);
+    const char *value = mStringPool + mStrings[id].mValue;
+    size_t length = strlen(value);
+    VerifyOrReturnError(length < bufSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+    memcpy(buf, value, length + 1);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetSetupDiscriminator(uint16_t &setupDiscriminator)
+{
+    ReturnErrorOnFailure(mDiscriminator.mError);
+    setupDiscriminator = mDiscriminator.mValue;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::SetSetupDiscriminator(uint16_t setupDiscriminator)
+{
+    VerifyOrReturnError(mCommissionable, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(mCommissionable->SetSetupDiscriminator(setupDiscriminator));
+    mDiscriminator.mValue = setupDiscriminator;
+    mDiscriminator.mError = CHIP_NO_ERROR;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetSpake2pIterationCount(uint32_t &iterationCount)
+{
+    ReturnErrorOnFailure(mIterationCount.mError);
+    iterationCount = mIterationCount.mValue;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetSpake2pSalt(MutableByteSpan &saltBuf)
+{
+    ReturnErrorOnFailure(mSaltError);
+    return CopySpanToMutableSpan(ByteSpan(mSalt, mSaltLength), saltBuf);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetSpake2pVerifier(MutableByteSpan &verifierBuf, size_t &outVerifierLen)
+{
+    ReturnErrorOnFailure(mVerifierError);
+    outVerifierLen = mVerifierLength;
+    return CopySpanToMutableSpan(ByteSpan(mVerifier, mVerifierLength), verifierBuf);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetSetupPasscode(uint32_t &setupPasscode)
+{
+    ReturnErrorOnFailure(mPasscode.mError);
+    setupPasscode = mPasscode.mValue;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::SetSetupPasscode(uint32_t setupPasscode)
+{
+    VerifyOrReturnError(mCommissionable, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(mCommissionable->SetSetupPasscode(setupPasscode));
+    mPasscode.mValue = setupPasscode;
+    mPasscode.mError = CHIP_NO_ERROR;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetVendorName(char *buf, size_t bufSize)
+{
+    return CopyString(kVendorName, buf, bufSize);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetVendorId(uint16_t &vendorId)
+{
+    ReturnErrorOnFailure(mVendorId.mError);
+    vendorId = mVendorId.mValue;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetProductName(char *buf, size_t bufSize)
+{
+    return CopyString(kProductName, buf, bufSize);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetProductId(uint16_t &productId)
+{
+    ReturnErrorOnFailure(mProductId.mError);
+    productId = mProductId.mValue;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetPartNumber(char *buf, size_t bufSize)
+{
+    return CopyString(kPartNumber, buf, bufSize);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetProductURL(char *buf, size_t bufSize)
+{
+    return CopyString(kProductURL, buf, bufSize);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetProductLabel(char *buf, size_t bufSize)
+{
+    return CopyString(kProductLabel, buf, bufSize);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetSerialNumber(char *buf, size_t bufSize)
+{
+    return CopyString(kSerialNumber, buf, bufSize);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetManufacturingDate(uint16_t &year, uint8_t &month, uint8_t &day)
+{
+    ReturnErrorOnFailure(mManufacturingDateError);
+    year = mManufacturingDate.year;
+    month = mManufacturingDate.month;
+    day = mManufacturingDate.day;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetHardwareVersion(uint16_t &hardwareVersion)
+{
+    ReturnErrorOnFailure(mHardwareVersion.mError);
+    hardwareVersion = mHardwareVersion.mValue;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetHardwareVersionString(char *buf, size_t bufSize)
+{
+    return CopyString(kHardwareVersionString, buf, bufSize);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetRotatingDeviceIdUniqueId(MutableByteSpan &uniqueIdSpan)
+{
+    ReturnErrorOnFailure(mUniqueIdError);
+    return CopySpanToMutableSpan(ByteSpan(mUniqueId, mUniqueIdLength), uniqueIdSpan);
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetProductFinish(ProductFinishEnum *finish)
+{
+    ReturnErrorOnFailure(mProductFinish.mError);
+    VerifyOrReturnError(finish, CHIP_ERROR_INVALID_ARGUMENT);
+    *finish = mProductFinish.mValue;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedFactoryDataProvider::GetProductPrimaryColor(ColorEnum *primaryColor)
+{
+    ReturnErrorOnFailure(mPrimaryColor.mError);
+    VerifyOrReturnError(primaryColor, CHIP_ERROR_INVALID_ARGUMENT);
+    *primaryColor = mPrimaryColor.mValue;
+    return CHIP_NO_ERROR;
+}
+
+} // namespace esp_matter
@@ -0,0 +1,130 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <app-common/zap-generated/cluster-enums.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/support/Span.h>
+#include <platform/CommissionableDataProvider.h>
+#include <platform/DeviceInstanceInfoProvider.h>
+
+namespace esp_matter {
+
+/**
+ * Commissionable data and device instance info provider serving the factory data from RAM.
+ *
+ * Load() reads every value once from the wrapped provider, usually ESP32FactoryDataProvider which reads the factory
+ * partition through NVS, and the getters then copy the values from RAM. The error returned by the wrapped provider
+ * for a value is cached as well, a value absent from the factory partition keeps failing the same way. The strings
+ * are packed in a single allocation of their actual length.
+ *
+ * The setters of the discriminator and the passcode are forwarded to the wrapped provider and update the cache.
+ */
+class CachedFactoryDataProvider : public chip::DeviceLayer::CommissionableDataProvider,
+                                  public chip::DeviceLayer::DeviceInstanceInfoProvider
+{
+public:
+    /* Read all the values from the providers, either of them may be NULL */
+    CHIP_ERROR Load(chip::DeviceLayer::CommissionableDataProvider *commissionable,
+                    chip::DeviceLayer::DeviceInstanceInfoProvider *device_instance_info);
+    size_t GetCacheSize() const;
+
+    // CommissionableDataProvider
+    CHIP_ERROR GetSetupDiscriminator(uint16_t &setupDiscriminator) override;
+    CHIP_ERROR SetSetupDiscriminator(uint16_t setupDiscriminator) override;
+    CHIP_ERROR GetSpake2pIterationCount(uint32_t &iterationCount) override;
+    CHIP_ERROR GetSpake2pSalt(chip::MutableByteSpan &saltBuf) override;
+    CHIP_ERROR GetSpake2pVerifier(chip::MutableByteSpan &verifierBuf, size_t &outVerifierLen) override;
+    CHIP_ERROR GetSetupPasscode(uint32_t &setupPasscode) override;
+    CHIP_ERROR SetSetupPasscode(uint32_t setupPasscode) override;
+
+    // DeviceInstanceInfoProvider
+    CHIP_ERROR GetVendorName(char *buf, size_t bufSize) override;
+    CHIP_ERROR GetVendorId(uint16_t &vendorId) override;
+    CHIP_ERROR GetProductName(char *buf, size_t bufSize) override;
+    CHIP_ERROR GetProductId(uint16_t &productId) override;
+    CHIP_ERROR GetPartNumber(char *buf, size_t bufSize) override;
+    CHIP_ERROR GetProductURL(char *buf, size_t bufSize) override;
+    CHIP_ERROR GetProductLabel(char *buf, size_t bufSize) override;
+    CHIP_ERROR GetSerialNumber(char *buf, size_t bufSize) override;
+    CHIP_ERROR GetManufacturingDate(uint16_t &year, uint8_t &month, uint8_t &day) override;
+    CHIP_ERROR GetHardwareVersion(uint16_t &hardwareVersion) override;
+    CHIP_ERROR GetHardwareVersionString(char *buf, size_t bufSize) override;
+    CHIP_ERROR GetRotatingDeviceIdUniqueId(chip::MutableByteSpan &uniqueIdSpan) override;
+    CHIP_ERROR GetProductFinish(chip::app::Clusters::BasicInformation::ProductFinishEnum *finish) override;
+    CHIP_ERROR GetProductPrimaryColor(chip::app::Clusters::BasicInformation::ColorEnum *primaryColor) override;
+
+private:
+    static constexpr size_t kMaxUniqueIdLength = 32;
+
+    enum StringId : uint8_t
+    {
+        kVendorName = 0,
+        kProductName,
+        kPartNumber,
+        kProductURL,
+        kProductLabel,
+        kSerialNumber,
+        kHardwareVersionString,
+        kStringCount,
+    };
+
+    template <typename T>
+    struct Value
+    {
+        T mValue{};
+        CHIP_ERROR mError = CHIP_ERROR_INCORRECT_STATE;
+    };
+
+    CHIP_ERROR CopyString(StringId id, char *buf, size_t bufSize) const;
+
+    chip::DeviceLayer::CommissionableDataProvider *mCommissionable = nullptr;
+    chip::DeviceLayer::DeviceInstanceInfoProvider *mDeviceInstanceInfo = nullptr;
+
+    Value<uint16_t> mDiscriminator;
+    Value<uint32_t> mIterationCount;
+    Value<uint32_t> mPasscode;
+    Value<uint16_t> mVendorId;
+    Value<uint16_t> mProductId;
+    Value<uint16_t> mHardwareVersion;
+    Value<chip::app::Clusters::BasicInformation::ProductFinishEnum> mProductFinish;
+    Value<chip::app::Clusters::BasicInformation::ColorEnum> mPrimaryColor;
+    struct
+    {
+        uint16_t year;
+        uint8_t month;
+        uint8_t day;
+    } mManufacturingDate{};
+    CHIP_ERROR mManufacturingDateError = CHIP_ERROR_INCORRECT_STATE;
+
+    uint8_t mSalt[chip::Crypto::kSpake2p_Max_PBKDF_Salt_Length];
+    uint8_t mSaltLength = 0;
+    CHIP_ERROR mSaltError = CHIP_ERROR_INCORRECT_STATE;
+    uint8_t mVerifier[chip::Crypto::kSpake2p_VerifierSerialized_Length];
+    uint8_t mVerifierLength = 0;
+    CHIP_ERROR mVerifierError = CHIP_ERROR_INCORRECT_STATE;
+    uint8_t mUniqueId[kMaxUniqueIdLength];
+    uint8_t mUniqueIdLength = 0;
+    CHIP_ERROR mUniqueIdError = CHIP_ERROR_INCORRECT_STATE;
+
+    /* Offsets of the strings in mStringPool, which holds them NUL terminated one after the other */
+    Value<uint16_t> mStrings[kStringCount];
+    char *mStringPool = nullptr;
+    size_t mStringPoolSize = 0;
+};
+
+} // namespace esp_matter
@@ -0,0 +1,187 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_callback_offload.h>
+#include <esp_matter_mem.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_POST_UPDATE_OFFLOAD
+
+namespace esp_matter {
+namespace callback_offload {
+
+static const char *TAG = "callback_offload";
+
+typedef struct job {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    /* The buffer of the strings and arrays is owned by the job */
+    esp_matter_attr_val_t val;
+    execute_t execute;
+    bool in_use;
+    /* A later update of the same attribute has been posted, the callbacks are not called for this one */
+    bool superseded;
+} job_t;
+
+static job_t s_jobs[CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_QUEUE_SIZE];
+static QueueHandle_t s_queues[CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_WORKERS];
+static SemaphoreHandle_t s_mutex = NULL;
+static attribute::post_update_completion_t s_completion = NULL;
+
+static inline bool has_buffer(const esp_matter_attr_val_t *val)
+{
+    return val->type == ESP_MATTER_VAL_TYPE_CHAR_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        val->type == ESP_MATTER_VAL_TYPE_OCTET_STRING || val->type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        val->type == ESP_MATTER_VAL_TYPE_ARRAY;
+}
+
+static esp_err_t copy_val(esp_matter_attr_val_t *dst, const esp_matter_attr_val_t *src)
+{
+    *dst = *src;
+    if (has_buffer(src) && src->val.a.b && src->val.a.s > 0) {
+        dst->val.a.b = (uint8_t *)esp_matter_mem_calloc(1, src->val.a.s);
+        if (!dst->val.a.b) {
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(dst->val.a.b, src->val.a.b, src->val.a.s);
+    }
+    return ESP_OK;
+}
+
+static void free_val(esp_matter_attr_val_t *val)
+{
+    if (has_buffer(val) && val->val.a.s > 0) {
+        esp_matter_mem_free(val->val.a.b);
+        val->val.a.b = NULL;
+    }
+}
+
+static void worker_task(void *arg)
+{
+    QueueHandle_t queue = (QueueHandle_t)arg;
+    size_t index;
+    while (xQueueReceive(queue, &index, portMAX_DELAY) == pdTRUE) {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        job_t job = s_jobs[index];
+        s_jobs[index].in_use = false;
+        attribute::post_update_completion_t completion = s_completion;
+        xSemaphoreGive(s_mutex);
+        if (!job.superseded) {
+            esp_err_t err = job.execute(attribute::POST_UPDATE, job.endpoint_id, job.cluster_id, job.attribute_id,
+                                        &job.val);
+            if (completion) {
+                completion(job.endpoint_id, job.cluster_id, job.attribute_id, err);
+            } else if (err != ESP_OK) {
+                ESP_LOGW(TAG, "POST_UPDATE callback of Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32
+                         "'s Attribute 0x%08" PRIX32 " failed: %s", job.endpoint_id, job.cluster_id,
+                         job.attribute_id, esp_err_to_name(err));
+            }
+        }
+        free_val(&job.val);
+    }
+}
+
+static esp_err_t init()
+{
+    s_mutex = xSemaphoreCreateMutex();
+    if (!s_mutex) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (int worker = 0; worker < CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_WORKERS; worker++) {
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "mtr_cb_%d", worker);
+        s_queues[worker] = xQueueCreate(CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_QUEUE_SIZE, sizeof(size_t));
+        if (!s_queues[worker] ||
+            xTaskCreatePinnedToCore(worker_task, name, CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_STACK_SIZE,
+                                    s_queues[worker], CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_PRIORITY, NULL,
+                                    CONFIG_ESP_MATTER_TASK_CORE_ID < 0 ? tskNO_AFFINITY :
+                                                                         CONFIG_ESP_MATTER_TASK_CORE_ID) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to start the callback worker %d", worker);
+            /* The workers already started keep running, the endpoints of this one get their callbacks inline */
+            if (s_queues[worker]) {
+                vQueueDelete(s_queues[worker]);
+                s_queues[worker] = NULL;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t post(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t *val,
+               execute_t execute)
+{
+    if (!s_mutex && init() != ESP_OK) {
+        return ESP_ERR_NO_MEM;
+    }
+    /* A single worker per endpoint keeps the callbacks of the endpoint in order */
+    QueueHandle_t queue = s_queues[endpoint_id % CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_WORKERS];
+    if (!queue) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_matter_attr_val_t copy;
+    esp_err_t err = copy_val(&copy, val);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    size_t index = CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_QUEUE_SIZE;
+    for (size_t current = 0; current < CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_QUEUE_SIZE; current++) {
+        job_t *job = &s_jobs[current];
+        if (!job->in_use) {
+            if (index == CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_QUEUE_SIZE) {
+                index = current;
+            }
+        } else if (job->endpoint_id == endpoint_id && job->cluster_id == cluster_id &&
+                   job->attribute_id == attribute_id) {
+            job->superseded = true;
+        }
+    }
+    if (index < CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_QUEUE_SIZE) {
+        s_jobs[index] = {endpoint_id, cluster_id, attribute_id, copy, execute, true, false};
+    }
+    xSemaphoreGive(s_mutex);
+    if (index == CONFIG_ESP_MATTER_POST_UPDATE_OFFLOAD_QUEUE_SIZE) {
+        ESP_LOGW(TAG, "Callback queue full, calling the POST_UPDATE callback on the Matter task");
+        free_val(&copy);
+        return ESP_ERR_NO_MEM;
+    }
+    /* Every job in use has its index in a queue, so the queue cannot be full */
+    xQueueSend(queue, &index, portMAX_DELAY);
+    return ESP_OK;
+}
+
+} // namespace callback_offload
+
+namespace attribute {
+
+esp_err_t set_post_update_completion_callback(post_update_completion_t callback)
+{
+    /* Set before esp_matter::start(), the workers read it with the mutex once they are started */
+    callback_offload::s_completion = callback;
+    return ESP_OK;
+}
+
+} // namespace attribute
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_POST_UPDATE_OFFLOAD
@@ -0,0 +1,49 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_attribute_utils.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace callback_offload {
+
+#if CONFIG_ESP_MATTER_ENABLE_POST_UPDATE_OFFLOAD
+/** Runs the attribute callbacks of a path, the callbacks of the paths and then the common callback */
+typedef esp_err_t (*execute_t)(attribute::callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                               uint32_t attribute_id, esp_matter_attr_val_t *val);
+
+/**
+ * @brief Posts the POST_UPDATE callbacks of an attribute to the worker of its endpoint, called on the Matter task.
+ *
+ * The value is copied, with the buffer of the strings and arrays. The callbacks of an endpoint run in order on the
+ * same worker, and a pending update of the same attribute is dropped, so the callbacks only see the latest value.
+ * The workers are started by the first call.
+ *
+ * @param endpoint_id  Endpoint ID of the attribute
+ * @param cluster_id   Cluster ID of the attribute
+ * @param attribute_id Attribute ID
+ * @param val          New value of the attribute
+ * @param execute      Function running the callbacks on the worker
+ *
+ * @return ESP_OK if the callbacks are posted, error otherwise and the caller runs them now
+ */
+esp_err_t post(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t *val,
+               execute_t execute);
+#endif // CONFIG_ESP_MATTER_ENABLE_POST_UPDATE_OFFLOAD
+
+} // namespace callback_offload
+} // namespace esp_matter
@@ -0,0 +1,280 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_debug_helpers.h>
+#include <esp_log.h>
+#include <esp_matter_callback_watchdog.h>
+#include <esp_matter_core.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+
+namespace esp_matter {
+namespace callback_watchdog {
+
+static const char *TAG = "callback_watchdog";
+
+static const char *k_kind_names[] = {"attribute", "override", "command", "event"};
+
+static slow_callback_t s_slowest[CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_TOP_N];
+static size_t s_slowest_count = 0;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Outermost callback watched by the budget timer, NULL if none */
+static const scope *s_watched = NULL;
+static esp_timer_handle_t s_timer = NULL;
+
+static inline const char *get_kind_name(callback_kind_t kind)
+{
+    return (unsigned)kind < sizeof(k_kind_names) / sizeof(k_kind_names[0]) ? k_kind_names[kind] : "unknown";
+}
+
+static void log_callback(const char *message, const slow_callback_t *identity, uint32_t duration_us)
+{
+    ESP_LOGW(TAG, "%s: %s callback %p for Endpoint 0x%04" PRIX16 "'s Cluster 0x%08" PRIX32 " 0x%08" PRIX32
+             ", %" PRIu32 " ms", message, get_kind_name(identity->kind), identity->callback, identity->endpoint_id,
+             identity->cluster_id, identity->id, duration_us / 1000);
+}
+
+/* Runs in the esp_timer task while the watched callback still blocks its task */
+static void budget_timer_cb(void *arg)
+{
+    slow_callback_t identity;
+    int64_t start_us = 0;
+    portENTER_CRITICAL(&s_stats_lock);
+    bool watched = s_watched != NULL;
+    if (watched) {
+        identity = s_watched->identity;
+        start_us = s_watched->start_us;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+    if (watched) {
+        log_callback("Callback still running", &identity, (uint32_t)(esp_timer_get_time() - start_us));
+    }
+}
+
+static bool is_same(const slow_callback_t *a, const slow_callback_t *b)
+{
+    return a->kind == b->kind && a->callback == b->callback && a->endpoint_id == b->endpoint_id &&
+        a->cluster_id == b->cluster_id && a->id == b->id;
+}
+
+/* Called in a critical section */
+static void record(const slow_callback_t *identity, uint32_t duration_us, bool overrun)
+{
+    slow_callback_t *entry = NULL;
+    for (size_t index = 0; index < s_slowest_count; index++) {
+        if (is_same(&s_slowest[index], identity)) {
+            entry = &s_slowest[index];
+            break;
+        }
+    }
+    if (!entry) {
+        if (s_slowest_count < CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_TOP_N) {
+            entry = &s_slowest[s_slowest_count++];
+        } else {
+            /* Replace the fastest of the table, if this call is slower */
+            entry = &s_slowest[0];
+            for (size_t index = 1; index < s_slowest_count; index++) {
+                if (s_slowest[index].max_us < entry->max_us) {
+                    entry = &s_slowest[index];
+                }
+            }
+            if (entry->max_us >= duration_us) {
+                return;
+            }
+        }
+        *entry = *identity;
+        entry->count = 0;
+        entry->overruns = 0;
+        entry->max_us = 0;
+    }
+    entry->count++;
+    if (overrun) {
+        entry->overruns++;
+    }
+    if (duration_us > entry->max_us) {
+        entry->max_us = duration_us;
+    }
+}
+
+scope::scope(callback_kind_t kind, void *callback, uint16_t endpoint_id, uint32_t cluster_id, uint32_t id)
+{
+    memset(&identity, 0, sizeof(identity));
+    identity.kind = kind;
+    identity.callback = callback;
+    identity.endpoint_id = endpoint_id;
+    identity.cluster_id = cluster_id;
+    identity.id = id;
+    start_us = esp_timer_get_time();
+
+    if (!s_timer) {
+        const esp_timer_create_args_t args = {
+            .callback = budget_timer_cb,
+            .arg = NULL,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "cb_watchdog",
+            .skip_unhandled_events = true,
+        };
+        if (esp_timer_create(&args, &s_timer) != ESP_OK) {
+            s_timer = NULL;
+            return;
+        }
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    bool arm = s_watched == NULL;
+    if (arm) {
+        s_watched = this;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+    if (arm) {
+        esp_timer_start_once(s_timer, (uint64_t)CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_BUDGET_MS * 1000);
+    }
+}
+
+scope::~scope()
+{
+    uint32_t duration_us = (uint32_t)(esp_timer_get_time() - start_us);
+    bool overrun = duration_us >= (uint32_t)CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_BUDGET_MS * 1000;
+    portENTER_CRITICAL(&s_stats_lock);
+    bool watched = s_watched == this;
+    if (watched) {
+        s_watched = NULL;
+    }
+    record(&identity, duration_us, overrun);
+    portEXIT_CRITICAL(&s_stats_lock);
+    if (watched) {
+        esp_timer_stop(s_timer);
+    }
+    if (overrun) {
+        log_callback("Callback over budget", &identity, duration_us);
+#if CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_BACKTRACE_DEPTH > 0
+        esp_backtrace_print(CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_BACKTRACE_DEPTH);
+#endif
+    }
+}
+
+esp_err_t get_slowest(slow_callback_t *callbacks, size_t *count)
+{
+    if (!callbacks || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    size_t copy_count = *count < s_slowest_count ? *count : s_slowest_count;
+    /* Selection of the slowest first, the table is small */
+    bool taken[CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_TOP_N] = {false};
+    for (size_t out = 0; out < copy_count; out++) {
+        size_t slowest = s_slowest_count;
+        for (size_t index = 0; index < s_slowest_count; index++) {
+            if (!taken[index] && (slowest == s_slowest_count || s_slowest[index].max_us > s_slowest[slowest].max_us)) {
+                slowest = index;
+            }
+        }
+        taken[slowest] = true;
+        callbacks[out] = s_slowest[slowest];
+    }
+    *count = copy_count;
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_slowest_count = 0;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    static slow_callback_t callbacks[CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_TOP_N];
+    size_t count = CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_TOP_N;
+    get_slowest(callbacks, &count);
+    printf("Budget: %d ms\n", CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_BUDGET_MS);
+    for (size_t index = 0; index < count; index++) {
+        printf("%-9s %p endpoint 0x%04" PRIX16 " cluster 0x%08" PRIX32 " id 0x%08" PRIX32 ": count %" PRIu32
+               ", over budget %" PRIu32 ", max %" PRIu32 " us\n", get_kind_name(callbacks[index].kind),
+               callbacks[index].callback, callbacks[index].endpoint_id, callbacks[index].cluster_id,
+               callbacks[index].id, callbacks[index].count, callbacks[index].overruns, callbacks[index].max_us);
+    }
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine callback_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        callback_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return callback_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "callbacks",
+        .description = "Slowest application callbacks. Usage: matter esp callbacks <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t callback_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the slowest attribute, override, command and event callbacks.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the slow callback statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    callback_console.register_commands(callback_commands,
+                                       sizeof(callback_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace callback_watchdog
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
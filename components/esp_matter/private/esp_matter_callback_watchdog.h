@@ -0,0 +1,58 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace callback_watchdog {
+
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+/**
+ * @brief Times an application callback for the lifetime of the object.
+ *
+ * The outermost watched callback arms a timer at CONFIG_ESP_MATTER_CALLBACK_WATCHDOG_BUDGET_MS, which logs the
+ * callback while it still blocks its task. When the callback returns over its budget, it is logged with the backtrace
+ * of the dispatch. Every call is recorded in the table of the slowest callbacks.
+ */
+class scope {
+public:
+    /**
+     * @param kind        Kind of the callback
+     * @param callback    Address of the callback function
+     * @param endpoint_id Endpoint ID of the path, 0 for the event callbacks
+     * @param cluster_id  Cluster ID of the path, 0 for the event callbacks
+     * @param id          Attribute ID or command ID of the path, or the device event type
+     */
+    scope(callback_kind_t kind, void *callback, uint16_t endpoint_id, uint32_t cluster_id, uint32_t id);
+    ~scope();
+
+    scope(const scope &) = delete;
+    scope &operator=(const scope &) = delete;
+
+    slow_callback_t identity;
+    int64_t start_us;
+};
+
+/**
+ * @brief Registers the callback watchdog console commands.
+ */
+void register_console_commands();
+#endif // CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+
+} // namespace callback_watchdog
+} // namespace esp_matter
@@ -0,0 +1,200 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_matter_command_stats.h>
+#include <esp_matter_core.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
+
+namespace esp_matter {
+namespace command {
+
+/* Upper bound of the first bucket, every following bucket doubles it */
+static constexpr uint32_t k_first_bucket_limit_us = 128;
+
+static command_stats_t s_commands[COMMAND_STATS_MAX_COMMANDS];
+static size_t s_command_count = 0;
+static uint32_t s_dropped_count = 0;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint8_t get_bucket(uint32_t duration_us)
+{
+    uint8_t bucket = 0;
+    uint32_t limit_us = k_first_bucket_limit_us;
+    while (bucket < COMMAND_STATS_BUCKET_COUNT - 1 && duration_us >= limit_us) {
+        bucket++;
+        limit_us <<= 1;
+    }
+    return bucket;
+}
+
+static command_stats_t *get_command(uint32_t cluster_id, uint32_t command_id)
+{
+    for (size_t index = 0; index < s_command_count; index++) {
+        if (s_commands[index].cluster_id == cluster_id && s_commands[index].command_id == command_id) {
+            return &s_commands[index];
+        }
+    }
+    if (s_command_count >= COMMAND_STATS_MAX_COMMANDS) {
+        return NULL;
+    }
+    command_stats_t *stats = &s_commands[s_command_count++];
+    memset(stats, 0, sizeof(command_stats_t));
+    stats->cluster_id = cluster_id;
+    stats->command_id = command_id;
+    return stats;
+}
+
+namespace stats {
+
+void record(uint32_t cluster_id, uint32_t command_id, uint32_t total_us, uint32_t user_us, uint32_t built_in_us)
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    command_stats_t *stats = get_command(cluster_id, command_id);
+    if (stats) {
+        stats->count++;
+        stats->total_histogram[get_bucket(total_us)]++;
+        stats->user_callback_histogram[get_bucket(user_us)]++;
+        stats->built_in_callback_histogram[get_bucket(built_in_us)]++;
+        if (total_us > stats->max_total_us) {
+            stats->max_total_us = total_us;
+        }
+    } else {
+        s_dropped_count++;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine command_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        command_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return command_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "command",
+        .description = "Command dispatch latency statistics. Usage: matter esp command <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t command_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the latency histograms of the dispatched commands.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the command latency statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    command_console.register_commands(command_commands,
+                                      sizeof(command_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace stats
+
+esp_err_t get_stats(command_stats_t *stats, size_t *count)
+{
+    if (!stats || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    size_t copy_count = *count < s_command_count ? *count : s_command_count;
+    memcpy(stats, s_commands, copy_count * sizeof(command_stats_t));
+    *count = copy_count;
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_command_count = 0;
+    s_dropped_count = 0;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+static void print_histogram(const char *name, const uint32_t *histogram)
+{
+    printf("\t%s:", name);
+    for (int bucket = 0; bucket < COMMAND_STATS_BUCKET_COUNT; bucket++) {
+        printf(" %" PRIu32, histogram[bucket]);
+    }
+    printf("\n");
+}
+
+void print_stats()
+{
+    static command_stats_t stats[COMMAND_STATS_MAX_COMMANDS];
+    size_t count = COMMAND_STATS_MAX_COMMANDS;
+    get_stats(stats, &count);
+    printf("Bucket upper bounds (us):");
+    for (int bucket = 0; bucket < COMMAND_STATS_BUCKET_COUNT - 1; bucket++) {
+        printf(" %" PRIu32, k_first_bucket_limit_us << bucket);
+    }
+    printf(" inf\n");
+    for (size_t index = 0; index < count; index++) {
+        printf("Cluster 0x%08" PRIX32 " command 0x%08" PRIX32 ": count %" PRIu32 ", max %" PRIu32 " us\n",
+               stats[index].cluster_id, stats[index].command_id, stats[index].count, stats[index].max_total_us);
+        print_histogram("total", stats[index].total_histogram);
+        print_histogram("user", stats[index].user_callback_histogram);
+        print_histogram("built-in", stats[index].built_in_callback_histogram);
+    }
+    if (s_dropped_count > 0) {
+        printf("%" PRIu32 " dispatches of untracked commands\n", s_dropped_count);
+    }
+}
+
+} // namespace command
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_COMMAND_LATENCY_STATS
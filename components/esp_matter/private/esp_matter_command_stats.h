@@ -0,0 +1,42 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace command {
+namespace stats {
+
+/**
+ * @brief Records the latency of a dispatched command.
+ *
+ * @param cluster_id       Cluster Id
+ * @param command_id       Command Id
+ * @param total_us         Time spent in the dispatch
+ * @param user_us          Time spent in the user callback, or in the async callback
+ * @param built_in_us      Time spent in the built-in callback
+ */
+void record(uint32_t cluster_id, uint32_t command_id, uint32_t total_us, uint32_t user_us, uint32_t built_in_us);
+
+/**
+ * @brief Registers the command latency console commands.
+ */
+void register_console_commands();
+
+} // namespace stats
+} // namespace command
+} // namespace esp_matter
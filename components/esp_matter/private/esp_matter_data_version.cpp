@@ -0,0 +1,236 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_data_version.h>
+#include <esp_matter_mem.h>
+#include <esp_system.h>
+#include <inttypes.h>
+#include <nvs.h>
+#include <stdio.h>
+
+#if CONFIG_ESP_MATTER_PERSIST_DATA_VERSIONS
+#include <app/util/attribute-storage.h>
+
+static const char *TAG = "esp_matter_data_version";
+
+/* Separate from the attribute values, so that the preload of the attribute namespace does not read them */
+#define DATA_VERSION_NAMESPACE "esp_matter_dv"
+
+namespace esp_matter {
+namespace data_version {
+
+typedef struct record {
+    uint32_t cluster_id;
+    chip::DataVersion data_version;
+    /* Fingerprint of the attribute values the data version was stored with */
+    uint32_t fingerprint;
+} record_t;
+
+static uint32_t fingerprint_add(uint32_t fingerprint, const void *data, size_t size)
+{
+    /* FNV-1a over the bytes of the value */
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++) {
+        fingerprint ^= bytes[i];
+        fingerprint *= 16777619;
+    }
+    return fingerprint;
+}
+
+static size_t get_scalar_size(esp_matter_val_type_t type)
+{
+    switch ((int)type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+        return sizeof(uint8_t);
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+        return sizeof(uint16_t);
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_UINT64:
+        return sizeof(uint64_t);
+    default:
+        return sizeof(uint32_t);
+    }
+}
+
+/* Returns false if the values of the cluster are not all in the data model, its data version is then not kept */
+static bool get_fingerprint(cluster_t *cluster, uint32_t *fingerprint_out)
+{
+    uint32_t fingerprint = 2166136261;
+    for (attribute_t *attribute = attribute::get_first(cluster); attribute; attribute = attribute::get_next(attribute)) {
+        if (attribute::get_flags(attribute) & ATTRIBUTE_FLAG_OVERRIDE) {
+            return false;
+        }
+        uint32_t attribute_id = attribute::get_id(attribute);
+        esp_matter_val_type_t type = ESP_MATTER_VAL_TYPE_INVALID;
+        const esp_matter_val_t *val = attribute::get_val_storage(attribute, &type);
+        if (!val) {
+            return false;
+        }
+        fingerprint = fingerprint_add(fingerprint, &attribute_id, sizeof(attribute_id));
+        if (type == ESP_MATTER_VAL_TYPE_CHAR_STRING || type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+            type == ESP_MATTER_VAL_TYPE_OCTET_STRING || type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+            type == ESP_MATTER_VAL_TYPE_ARRAY) {
+            fingerprint = fingerprint_add(fingerprint, &val->a.s, sizeof(val->a.s));
+            if (val->a.b) {
+                fingerprint = fingerprint_add(fingerprint, val->a.b, val->a.s);
+            }
+        } else {
+            /* Only the bytes of the member of the type, the rest of the union is not initialized */
+            fingerprint = fingerprint_add(fingerprint, val, get_scalar_size(type));
+        }
+    }
+    *fingerprint_out = fingerprint;
+    return true;
+}
+
+static void get_key(uint16_t endpoint_id, char *key, size_t size)
+{
+    snprintf(key, size, "ep_%04" PRIX16, endpoint_id);
+}
+
+void restore(endpoint_t *endpoint)
+{
+    uint16_t endpoint_id = endpoint::get_id(endpoint);
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    get_key(endpoint_id, key, sizeof(key));
+    nvs_handle_t handle;
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, DATA_VERSION_NAMESPACE, NVS_READWRITE, &handle) !=
+        ESP_OK) {
+        return;
+    }
+    size_t size = 0;
+    if (nvs_get_blob(handle, key, NULL, &size) != ESP_OK || size == 0 || size % sizeof(record_t) != 0) {
+        nvs_close(handle);
+        return;
+    }
+    record_t *records = (record_t *)esp_matter_mem_calloc(1, size);
+    if (!records) {
+        nvs_close(handle);
+        return;
+    }
+    uint16_t restored = 0;
+    if (nvs_get_blob(handle, key, records, &size) == ESP_OK) {
+        size_t record_count = size / sizeof(record_t);
+        for (cluster_t *cluster = cluster::get_first(endpoint); cluster; cluster = cluster::get_next(cluster)) {
+            uint32_t cluster_id = cluster::get_id(cluster);
+            uint32_t fingerprint = 0;
+            chip::DataVersion *data_version =
+                emberAfDataVersionStorage(chip::app::ConcreteClusterPath(endpoint_id, cluster_id));
+            if (!data_version || !get_fingerprint(cluster, &fingerprint)) {
+                continue;
+            }
+            for (size_t i = 0; i < record_count; i++) {
+                if (records[i].cluster_id == cluster_id && records[i].fingerprint == fingerprint) {
+                    *data_version = records[i].data_version;
+                    restored++;
+                    break;
+                }
+            }
+        }
+    }
+    esp_matter_mem_free(records);
+    /* The data versions are only valid until they change, which is not tracked until the next shutdown */
+    nvs_erase_key(handle, key);
+    nvs_commit(handle);
+    nvs_close(handle);
+    ESP_LOGI(TAG, "Restored %" PRIu16 " data versions of endpoint 0x%04" PRIX16, restored, endpoint_id);
+}
+
+static void store(nvs_handle_t handle, endpoint_t *endpoint)
+{
+    uint16_t endpoint_id = endpoint::get_id(endpoint);
+    uint16_t cluster_count = 0;
+    for (cluster_t *cluster = cluster::get_first(endpoint); cluster; cluster = cluster::get_next(cluster)) {
+        cluster_count++;
+    }
+    if (cluster_count == 0) {
+        return;
+    }
+    record_t *records = (record_t *)esp_matter_mem_calloc(cluster_count, sizeof(record_t));
+    if (!records) {
+        return;
+    }
+    uint16_t record_count = 0;
+    for (cluster_t *cluster = cluster::get_first(endpoint); cluster; cluster = cluster::get_next(cluster)) {
+        record_t *record = &records[record_count];
+        record->cluster_id = cluster::get_id(cluster);
+        chip::DataVersion *data_version =
+            emberAfDataVersionStorage(chip::app::ConcreteClusterPath(endpoint_id, record->cluster_id));
+        if (!data_version || !get_fingerprint(cluster, &record->fingerprint)) {
+            continue;
+        }
+        record->data_version = *data_version;
+        record_count++;
+    }
+    if (record_count > 0) {
+        char key[NVS_KEY_NAME_MAX_SIZE];
+        get_key(endpoint_id, key, sizeof(key));
+        if (nvs_set_blob(handle, key, records, record_count * sizeof(record_t)) != ESP_OK) {
+            ESP_LOGE(TAG, "Couldn't store the data versions of endpoint 0x%04" PRIX16, endpoint_id);
+        }
+    }
+    esp_matter_mem_free(records);
+}
+
+void store_all()
+{
+    node_t *node = node::get();
+    if (!node) {
+        return;
+    }
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, DATA_VERSION_NAMESPACE, NVS_READWRITE,
+                                            &handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Couldn't open the NVS to store the data versions: %s", esp_err_to_name(err));
+        return;
+    }
+    for (endpoint_t *endpoint = endpoint::get_first(node); endpoint; endpoint = endpoint::get_next(endpoint)) {
+        /* Only the endpoints added to the stack have data versions */
+        if (emberAfGetDynamicIndexFromEndpoint(endpoint::get_id(endpoint)) != 0xFFFF) {
+            store(handle, endpoint);
+        }
+    }
+    nvs_commit(handle);
+    nvs_close(handle);
+}
+
+esp_err_t init()
+{
+    static bool init_done = false;
+    if (init_done) {
+        return ESP_OK;
+    }
+    esp_err_t err = esp_register_shutdown_handler(store_all);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Couldn't register the data version shutdown handler: %s", esp_err_to_name(err));
+        return err;
+    }
+    init_done = true;
+    return ESP_OK;
+}
+
+} // namespace data_version
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_PERSIST_DATA_VERSIONS
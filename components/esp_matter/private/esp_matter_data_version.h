@@ -0,0 +1,51 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+
+namespace esp_matter {
+namespace data_version {
+
+#if CONFIG_ESP_MATTER_PERSIST_DATA_VERSIONS
+/**
+ * @brief Registers the esp_restart() handler which stores the data versions, called once at startup.
+ *
+ * @return ESP_OK on success, error otherwise
+ */
+esp_err_t init();
+
+/**
+ * @brief Restores the data versions of the clusters of an endpoint stored at the last shutdown, called with the chip
+ *        stack lock once the endpoint is added to the stack.
+ *
+ * A data version is only restored if the values of the attributes of the cluster are the ones it had when it was
+ * stored, the other clusters keep the random data version of the stack. The stored versions are then erased, so that
+ * they cannot be restored again after a reset which did not store them.
+ *
+ * @param endpoint Endpoint handle
+ */
+void restore(endpoint_t *endpoint);
+
+/**
+ * @brief Stores the data versions of all the enabled endpoints, with the fingerprints of their attribute values,
+ *        called at shutdown and on power fail.
+ */
+void store_all();
+#endif // CONFIG_ESP_MATTER_PERSIST_DATA_VERSIONS
+
+} // namespace data_version
+} // namespace esp_matter
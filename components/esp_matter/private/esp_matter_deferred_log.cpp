@@ -0,0 +1,617 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_deferred_log.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_LOG
+#include <esp_memory_utils.h>
+#include <esp_system.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <atomic>
+
+namespace esp_matter {
+namespace deferred_log {
+
+static const char *TAG = "deferred_log";
+
+/* Must be a power of two, the slot index is computed by masking the position */
+constexpr uint32_t k_slot_count = CONFIG_ESP_MATTER_DEFERRED_LOG_SLOT_COUNT;
+static_assert((k_slot_count & (k_slot_count - 1)) == 0, "The deferred log slot count must be a power of two");
+constexpr size_t k_slot_data_size = 60;
+constexpr size_t k_max_record_size = CONFIG_ESP_MATTER_DEFERRED_LOG_MAX_RECORD_SIZE;
+/* Conversion specifications longer than this are formatted synchronously, e.g. "%-08" PRIx32 is 6 */
+constexpr size_t k_max_spec_size = 16;
+
+/*
+ * Bounded multi producer queue of fixed size slots. The sequence of a slot is its position when it is free for the
+ * producers, the position + 1 once it holds a record and goes back to the position of the next lap once consumed. A
+ * record spans consecutive slots, the producers claim all of them at once with a compare and swap of the enqueue
+ * position, so the logging tasks never take a lock or block.
+ */
+typedef struct slot {
+    std::atomic<uint32_t> sequence;
+    uint8_t data[k_slot_data_size];
+} slot_t;
+
+/* Start of a record, followed by the raw arguments of the format, or by the text if the format is NULL */
+typedef struct header {
+    const char *format;
+    uint16_t length;
+    uint8_t slots;
+    bool truncated;
+} header_t;
+
+typedef enum arg_type {
+    ARG_NONE = 0,
+    ARG_INT,
+    ARG_LONG,
+    ARG_LONG_LONG,
+    ARG_INTMAX,
+    ARG_SIZE,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,
+    ARG_POINTER,
+    ARG_STRING,
+    ARG_UNSUPPORTED,
+} arg_type_t;
+
+static slot_t s_slots[k_slot_count];
+static std::atomic<uint32_t> s_enqueue_position(0);
+/* Only advanced by the consumer, holding s_drain_mutex */
+static std::atomic<uint32_t> s_dequeue_position(0);
+static SemaphoreHandle_t s_drain_mutex = NULL;
+static TaskHandle_t s_task = NULL;
+static vprintf_like_t s_previous_vprintf = NULL;
+
+static std::atomic<uint32_t> s_records(0);
+static std::atomic<uint32_t> s_dropped(0);
+static std::atomic<uint32_t> s_truncated(0);
+static std::atomic<uint32_t> s_formatted(0);
+static std::atomic<uint32_t> s_high_water(0);
+/* Dropped lines already reported in the output */
+static uint32_t s_dropped_reported = 0;
+
+/* Formatting buffers of the consumer, used holding s_drain_mutex */
+static uint8_t s_record[k_max_record_size];
+static char s_line[CONFIG_ESP_MATTER_DEFERRED_LOG_LINE_SIZE];
+
+/* Parses the conversion specification at format[0] == '%', returns its length */
+static size_t parse_conversion(const char *format, arg_type_t *type)
+{
+    const char *p = format + 1;
+    *type = ARG_UNSUPPORTED;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+        p++;
+    }
+    /* The '*' width and precision take an additional argument, they are not deferred */
+    while (*p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+    char modifier = 0;
+    if (*p == 'h') {
+        p += (p[1] == 'h') ? 2 : 1;
+        modifier = 'h';
+    } else if (*p == 'l') {
+        modifier = (p[1] == 'l') ? 'L' : 'l';
+        p += (p[1] == 'l') ? 2 : 1;
+    } else if (*p == 'j' || *p == 'z' || *p == 't') {
+        modifier = *p++;
+    } else if (*p == 'L') {
+        /* long double */
+        return p + 1 - format;
+    }
+    if (*p == '\0') {
+        return p - format;
+    }
+    size_t length = p + 1 - format;
+    if (length >= k_max_spec_size) {
+        return length;
+    }
+    switch (*p) {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+        *type = modifier == 'l' ? ARG_LONG : modifier == 'L' ? ARG_LONG_LONG : modifier == 'j' ? ARG_INTMAX :
+            modifier == 'z' ? ARG_SIZE : modifier == 't' ? ARG_PTRDIFF : ARG_INT;
+        break;
+    case 'c':
+        *type = modifier == 0 ? ARG_INT : ARG_UNSUPPORTED;
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        *type = ARG_DOUBLE;
+        break;
+    case 's':
+        *type = modifier == 0 ? ARG_STRING : ARG_UNSUPPORTED;
+        break;
+    case 'p':
+        *type = ARG_POINTER;
+        break;
+    case '%':
+        *type = length == 2 ? ARG_NONE : ARG_UNSUPPORTED;
+        break;
+    default:
+        break;
+    }
+    return length;
+}
+
+template <typename T>
+static bool put(uint8_t *args, size_t capacity, size_t *length, T value)
+{
+    if (*length + sizeof(T) > capacity) {
+        return false;
+    }
+    memcpy(&args[*length], &value, sizeof(T));
+    *length += sizeof(T);
+    return true;
+}
+
+template <typename T>
+static T get(const uint8_t *args, size_t length, size_t *offset)
+{
+    T value = T();
+    if (*offset + sizeof(T) <= length) {
+        memcpy(&value, &args[*offset], sizeof(T));
+    }
+    *offset += sizeof(T);
+    return value;
+}
+
+/* Copies the arguments of the format, false if the format has to be formatted synchronously */
+static bool capture_args(const char *format, va_list args, uint8_t *out, size_t capacity, size_t *length,
+                         bool *truncated)
+{
+    *length = 0;
+    for (const char *p = format; *p; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        arg_type_t type;
+        size_t spec_length = parse_conversion(p, &type);
+        bool fits = true;
+        switch (type) {
+        case ARG_NONE:
+            break;
+        case ARG_INT:
+            fits = put(out, capacity, length, va_arg(args, int));
+            break;
+        case ARG_LONG:
+            fits = put(out, capacity, length, va_arg(args, long));
+            break;
+        case ARG_LONG_LONG:
+            fits = put(out, capacity, length, va_arg(args, long long));
+            break;
+        case ARG_INTMAX:
+            fits = put(out, capacity, length, va_arg(args, intmax_t));
+            break;
+        case ARG_SIZE:
+            fits = put(out, capacity, length, va_arg(args, size_t));
+            break;
+        case ARG_PTRDIFF:
+            fits = put(out, capacity, length, va_arg(args, ptrdiff_t));
+            break;
+        case ARG_DOUBLE:
+            fits = put(out, capacity, length, va_arg(args, double));
+            break;
+        case ARG_POINTER:
+            fits = put(out, capacity, length, va_arg(args, void *));
+            break;
+        case ARG_STRING: {
+            /* The string can be on the stack of the caller, it is copied with its terminator */
+            const char *string = va_arg(args, const char *);
+            if (!string) {
+                string = "(null)";
+            }
+            if (*length >= capacity) {
+                return false;
+            }
+            size_t room = capacity - *length - 1;
+            size_t string_length = strnlen(string, room + 1);
+            if (string_length > room) {
+                string_length = room;
+                *truncated = true;
+            }
+            memcpy(&out[*length], string, string_length);
+            out[*length + string_length] = '\0';
+            *length += string_length + 1;
+            break;
+        }
+        default:
+            return false;
+        }
+        if (!fits) {
+            return false;
+        }
+        p += spec_length - 1;
+    }
+    return true;
+}
+
+/* Formats a record of raw arguments, returns the length of the text */
+static size_t format_args(const char *format, const uint8_t *args, size_t args_length, char *out, size_t size)
+{
+    size_t position = 0;
+    size_t offset = 0;
+    for (const char *p = format; *p && position + 1 < size;) {
+        if (*p != '%') {
+            out[position++] = *p++;
+            continue;
+        }
+        arg_type_t type;
+        size_t spec_length = parse_conversion(p, &type);
+        if (type == ARG_UNSUPPORTED) {
+            /* Not captured by the producer */
+            break;
+        }
+        char spec[k_max_spec_size];
+        memcpy(spec, p, spec_length);
+        spec[spec_length] = '\0';
+        p += spec_length;
+        char *dest = &out[position];
+        size_t room = size - position;
+        int written = 0;
+        switch (type) {
+        case ARG_NONE:
+            written = snprintf(dest, room, "%%");
+            break;
+        case ARG_INT:
+            written = snprintf(dest, room, spec, get<int>(args, args_length, &offset));
+            break;
+        case ARG_LONG:
+            written = snprintf(dest, room, spec, get<long>(args, args_length, &offset));
+            break;
+        case ARG_LONG_LONG:
+            written = snprintf(dest, room, spec, get<long long>(args, args_length, &offset));
+            break;
+        case ARG_INTMAX:
+            written = snprintf(dest, room, spec, get<intmax_t>(args, args_length, &offset));
+            break;
+        case ARG_SIZE:
+            written = snprintf(dest, room, spec, get<size_t>(args, args_length, &offset));
+            break;
+        case ARG_PTRDIFF:
+            written = snprintf(dest, room, spec, get<ptrdiff_t>(args, args_length, &offset));
+            break;
+        case ARG_DOUBLE:
+            written = snprintf(dest, room, spec, get<double>(args, args_length, &offset));
+            break;
+        case ARG_POINTER:
+            written = snprintf(dest, room, spec, get<void *>(args, args_length, &offset));
+            break;
+        case ARG_STRING: {
+            const char *string = offset < args_length ? (const char *)&args[offset] : "";
+            offset += strnlen(string, args_length - offset) + 1;
+            written = snprintf(dest, room, spec, string);
+            break;
+        }
+        default:
+            break;
+        }
+        if (written > 0) {
+            position += ((size_t)written < room) ? (size_t)written : room - 1;
+        }
+    }
+    out[position] = '\0';
+    return position;
+}
+
+static bool enqueue(const uint8_t *record, size_t length)
+{
+    uint32_t slots = (length + k_slot_data_size - 1) / k_slot_data_size;
+    uint32_t position = s_enqueue_position.load(std::memory_order_relaxed);
+    while (true) {
+        bool available = true;
+        for (uint32_t index = 0; index < slots; index++) {
+            uint32_t sequence = s_slots[(position + index) & (k_slot_count - 1)].sequence.load(std::memory_order_acquire);
+            if (sequence != position + index) {
+                available = false;
+                break;
+            }
+        }
+        if (available) {
+            if (s_enqueue_position.compare_exchange_weak(position, position + slots, std::memory_order_relaxed)) {
+                break;
+            }
+            continue;
+        }
+        uint32_t current = s_enqueue_position.load(std::memory_order_relaxed);
+        if (current == position) {
+            /* Full, the consumer has not released the slots of the previous lap */
+            return false;
+        }
+        position = current;
+    }
+    for (uint32_t index = 0; index < slots; index++) {
+        slot_t *slot = &s_slots[(position + index) & (k_slot_count - 1)];
+        size_t offset = index * k_slot_data_size;
+        size_t chunk = (length - offset < k_slot_data_size) ? length - offset : k_slot_data_size;
+        memcpy(slot->data, &record[offset], chunk);
+        slot->sequence.store(position + index + 1, std::memory_order_release);
+    }
+
+    uint32_t in_use = position + slots - s_dequeue_position.load(std::memory_order_relaxed);
+    uint32_t high_water = s_high_water.load(std::memory_order_relaxed);
+    while (in_use > high_water &&
+           !s_high_water.compare_exchange_weak(high_water, in_use, std::memory_order_relaxed)) {
+    }
+    /* Wake the task early when the ring fills up, it otherwise polls at the flush interval */
+    if (in_use > k_slot_count / 2 && s_task && xTaskGetCurrentTaskHandle() != s_task) {
+        xTaskNotifyGive(s_task);
+    }
+    return true;
+}
+
+/* Copies the oldest record into s_record and releases its slots, called holding s_drain_mutex */
+static bool dequeue(header_t *header)
+{
+    uint32_t position = s_dequeue_position.load(std::memory_order_relaxed);
+    slot_t *first = &s_slots[position & (k_slot_count - 1)];
+    if (first->sequence.load(std::memory_order_acquire) != position + 1) {
+        return false;
+    }
+    memcpy(header, first->data, sizeof(header_t));
+    /* The other slots of the record may still be written by its producer */
+    for (uint32_t index = 1; index < header->slots; index++) {
+        slot_t *slot = &s_slots[(position + index) & (k_slot_count - 1)];
+        if (slot->sequence.load(std::memory_order_acquire) != position + index + 1) {
+            return false;
+        }
+    }
+    size_t length = sizeof(header_t) + header->length;
+    for (uint32_t index = 0; index < header->slots; index++) {
+        slot_t *slot = &s_slots[(position + index) & (k_slot_count - 1)];
+        size_t offset = index * k_slot_data_size;
+        size_t chunk = (length - offset < k_slot_data_size) ? length - offset : k_slot_data_size;
+        memcpy(&s_record[offset], slot->data, chunk);
+        slot->sequence.store(position + index + k_slot_count, std::memory_order_release);
+    }
+    s_dequeue_position.store(position + header->slots, std::memory_order_relaxed);
+    return true;
+}
+
+static int write_output(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int written = s_previous_vprintf(format, args);
+    va_end(args);
+    return written;
+}
+
+static void drain()
+{
+    xSemaphoreTake(s_drain_mutex, portMAX_DELAY);
+    header_t header;
+    while (dequeue(&header)) {
+        const uint8_t *payload = &s_record[sizeof(header_t)];
+        if (header.format) {
+            format_args(header.format, payload, header.length, s_line, sizeof(s_line));
+            write_output("%s", s_line);
+        } else {
+            write_output("%.*s", (int)header.length, (const char *)payload);
+        }
+    }
+    uint32_t dropped = s_dropped.load(std::memory_order_relaxed);
+    if (dropped != s_dropped_reported) {
+        write_output("W deferred_log: %" PRIu32 " log lines dropped, the ring was full\n", dropped - s_dropped_reported);
+        s_dropped_reported = dropped;
+    }
+    xSemaphoreGive(s_drain_mutex);
+}
+
+/* vprintf of esp_log, called by the logging tasks with the format of the line and its arguments */
+static int deferred_vprintf(const char *format, va_list args)
+{
+    /* The output of this task and of the restart path is not queued behind itself */
+    if ((s_task && xTaskGetCurrentTaskHandle() == s_task) || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+        return s_previous_vprintf(format, args);
+    }
+    alignas(header_t) uint8_t record[k_max_record_size];
+    header_t *header = (header_t *)record;
+    uint8_t *payload = &record[sizeof(header_t)];
+    size_t capacity = sizeof(record) - sizeof(header_t);
+    size_t length = 0;
+    bool truncated = false;
+
+    /* Only the formats which stay valid, the literals in flash, are kept by pointer */
+    bool deferred = false;
+    if (esp_ptr_in_drom(format)) {
+        va_list copy;
+        va_copy(copy, args);
+        deferred = capture_args(format, copy, payload, capacity, &length, &truncated);
+        va_end(copy);
+    }
+    if (!deferred) {
+        int written = vsnprintf((char *)payload, capacity, format, args);
+        if (written < 0) {
+            return written;
+        }
+        truncated = (size_t)written >= capacity;
+        length = truncated ? capacity - 1 : (size_t)written;
+        s_formatted.fetch_add(1, std::memory_order_relaxed);
+    }
+    header->format = deferred ? format : NULL;
+    header->length = (uint16_t)length;
+    header->slots = (uint8_t)((sizeof(header_t) + length + k_slot_data_size - 1) / k_slot_data_size);
+    header->truncated = truncated;
+    if (!enqueue(record, sizeof(header_t) + length)) {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+    s_records.fetch_add(1, std::memory_order_relaxed);
+    if (truncated) {
+        s_truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+    return (int)length;
+}
+
+static void log_task(void *arg)
+{
+    while (true) {
+        drain();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_ESP_MATTER_DEFERRED_LOG_FLUSH_INTERVAL_MS));
+    }
+}
+
+static void shutdown_handler()
+{
+    flush();
+}
+
+esp_err_t init()
+{
+    if (s_task) {
+        return ESP_OK;
+    }
+    static_assert(k_max_record_size <= UINT8_MAX * k_slot_data_size, "The slots of a record are counted on 8 bits");
+    static_assert(k_max_record_size <= k_slot_count * k_slot_data_size, "A record must fit in the ring");
+    for (uint32_t index = 0; index < k_slot_count; index++) {
+        s_slots[index].sequence.store(index, std::memory_order_relaxed);
+    }
+    s_drain_mutex = xSemaphoreCreateMutex();
+    if (!s_drain_mutex) {
+        ESP_LOGE(TAG, "Couldn't create the deferred log mutex");
+        return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreatePinnedToCore(log_task, "mtr_log", CONFIG_ESP_MATTER_DEFERRED_LOG_TASK_STACK_SIZE, NULL,
+                                CONFIG_ESP_MATTER_DEFERRED_LOG_TASK_PRIORITY, &s_task, tskNO_AFFINITY) != pdPASS) {
+        vSemaphoreDelete(s_drain_mutex);
+        s_drain_mutex = NULL;
+        ESP_LOGE(TAG, "Couldn't create the deferred log task");
+        return ESP_ERR_NO_MEM;
+    }
+    s_previous_vprintf = esp_log_set_vprintf(deferred_vprintf);
+    /* The queued lines are written before the restart */
+    if (esp_register_shutdown_handler(shutdown_handler) != ESP_OK) {
+        ESP_LOGW(TAG, "Couldn't register the deferred log shutdown handler");
+    }
+    ESP_LOGI(TAG, "Log lines are formatted and written by the deferred log task");
+    return ESP_OK;
+}
+
+void flush()
+{
+    if (s_drain_mutex) {
+        drain();
+    }
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    stats->records = s_records.load(std::memory_order_relaxed);
+    stats->dropped = s_dropped.load(std::memory_order_relaxed);
+    stats->truncated = s_truncated.load(std::memory_order_relaxed);
+    stats->formatted = s_formatted.load(std::memory_order_relaxed);
+    stats->high_water = s_high_water.load(std::memory_order_relaxed);
+    stats->capacity = k_slot_count;
+}
+
+void reset_stats()
+{
+    s_records.store(0, std::memory_order_relaxed);
+    s_truncated.store(0, std::memory_order_relaxed);
+    s_formatted.store(0, std::memory_order_relaxed);
+    s_high_water.store(0, std::memory_order_relaxed);
+}
+
+void print_stats()
+{
+    stats_t stats;
+    get_stats(&stats);
+    printf("Deferred log lines: %" PRIu32 ", dropped: %" PRIu32 ", truncated: %" PRIu32
+           ", formatted by the caller: %" PRIu32 "\n",
+           stats.records, stats.dropped, stats.truncated, stats.formatted);
+    printf("Slots in use high-water: %" PRIu32 " of %" PRIu32 "\n", stats.high_water, stats.capacity);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine log_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        log_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return log_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "deferred_log",
+        .description = "Deferred log backend. Usage: matter esp deferred_log <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t log_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the queued, dropped and truncated lines and the high-water mark of the ring.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the statistics, the dropped lines are kept as they are reported in the output.",
+            .handler = console_reset_handler,
+        },
+    };
+    log_console.register_commands(log_commands, sizeof(log_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace deferred_log
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_DEFERRED_LOG
@@ -0,0 +1,42 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+
+namespace esp_matter {
+namespace deferred_log {
+
+#if CONFIG_ESP_MATTER_ENABLE_DEFERRED_LOG
+/**
+ * @brief Installs the deferred log backend with esp_log_set_vprintf() and creates the low priority task which
+ *        formats and writes the queued lines. Called by esp_matter::start(), does nothing if already installed.
+ *
+ * @return ESP_OK on success, error otherwise. The lines are then written synchronously as before.
+ */
+esp_err_t init();
+
+/**
+ * @brief Registers the deferred log console commands.
+ */
+void register_console_commands();
+#else
+inline esp_err_t init() { return ESP_OK; }
+inline void register_console_commands() {}
+#endif // CONFIG_ESP_MATTER_ENABLE_DEFERRED_LOG
+
+} // namespace deferred_log
+} // namespace esp_matter
@@ -0,0 +1,281 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <esp_log.h>
+#include <esp_matter_callback_watchdog.h>
+#include <esp_matter_core.h>
+#include <esp_matter_device_event_registry.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <platform/PlatformManager.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_DEVICE_EVENT_REGISTRY
+
+using chip::DeviceLayer::PlatformMgr;
+
+namespace esp_matter {
+namespace device_event {
+
+static const char *TAG = "device_event";
+
+typedef struct subscriber {
+    event_callback_t callback;
+    intptr_t callback_arg;
+    mask_t mask;
+    uint32_t calls;
+} subscriber_t;
+
+static subscriber_t s_subscribers[CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS];
+/* Union of the masks of the subscribers, the events outside of it are dropped without scanning the table */
+static mask_t s_subscribed_mask = 0;
+static stats_t s_stats;
+static bool s_initialized = false;
+/* The table is changed from any task and read by the dispatcher on the Matter task */
+static portMUX_TYPE s_registry_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void update_subscribed_mask()
+{
+    mask_t mask = 0;
+    uint32_t count = 0;
+    for (size_t index = 0; index < CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS; index++) {
+        if (s_subscribers[index].callback) {
+            mask |= s_subscribers[index].mask;
+            count++;
+        }
+    }
+    s_subscribed_mask = mask;
+    s_stats.subscribers = count;
+}
+
+static void dispatch(const ChipDeviceEvent *event, intptr_t arg)
+{
+    uint8_t bit = get_bit(event->Type);
+    mask_t mask = static_cast<mask_t>(1) << bit;
+    portENTER_CRITICAL(&s_registry_lock);
+    s_stats.events[bit]++;
+    bool subscribed = (s_subscribed_mask & mask) != 0;
+    if (!subscribed) {
+        s_stats.unmatched++;
+    }
+    portEXIT_CRITICAL(&s_registry_lock);
+    if (!subscribed) {
+        return;
+    }
+
+    for (size_t index = 0; index < CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS; index++) {
+        /* Copy the entry, so that the callback can unsubscribe or subscribe others */
+        portENTER_CRITICAL(&s_registry_lock);
+        subscriber_t subscriber = s_subscribers[index];
+        if (subscriber.callback && (subscriber.mask & mask)) {
+            s_subscribers[index].calls++;
+            s_stats.calls++;
+        }
+        portEXIT_CRITICAL(&s_registry_lock);
+        if (!subscriber.callback || !(subscriber.mask & mask)) {
+            continue;
+        }
+#if CONFIG_ESP_MATTER_ENABLE_CALLBACK_WATCHDOG
+        callback_watchdog::scope watchdog(callback_watchdog::CALLBACK_KIND_EVENT, (void *)subscriber.callback, 0, 0,
+                                          event->Type);
+#endif
+        subscriber.callback(event, subscriber.callback_arg);
+    }
+}
+
+esp_err_t init()
+{
+    if (s_initialized) {
+        return ESP_OK;
+    }
+    if (PlatformMgr().AddEventHandler(dispatch, static_cast<intptr_t>(NULL)) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to add the device event dispatcher");
+        return ESP_FAIL;
+    }
+    s_initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t subscribe(mask_t mask, event_callback_t callback, intptr_t callback_arg)
+{
+    if (!callback || mask == 0) {
+        ESP_LOGE(TAG, "Callback cannot be NULL and the mask cannot be empty");
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_ERR_NO_MEM;
+    portENTER_CRITICAL(&s_registry_lock);
+    subscriber_t *free_subscriber = NULL;
+    for (size_t index = 0; index < CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS; index++) {
+        subscriber_t *subscriber = &s_subscribers[index];
+        if (subscriber->callback == callback && subscriber->callback_arg == callback_arg) {
+            subscriber->mask = mask;
+            err = ESP_OK;
+            break;
+        }
+        if (!subscriber->callback && !free_subscriber) {
+            free_subscriber = subscriber;
+        }
+    }
+    if (err != ESP_OK && free_subscriber) {
+        free_subscriber->callback = callback;
+        free_subscriber->callback_arg = callback_arg;
+        free_subscriber->mask = mask;
+        free_subscriber->calls = 0;
+        err = ESP_OK;
+    }
+    if (err == ESP_OK) {
+        update_subscribed_mask();
+    }
+    portEXIT_CRITICAL(&s_registry_lock);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Cannot subscribe more than %d callbacks", CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS);
+    }
+    return err;
+}
+
+esp_err_t unsubscribe(event_callback_t callback, intptr_t callback_arg)
+{
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    portENTER_CRITICAL(&s_registry_lock);
+    for (size_t index = 0; index < CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS; index++) {
+        subscriber_t *subscriber = &s_subscribers[index];
+        if (subscriber->callback && subscriber->callback == callback && subscriber->callback_arg == callback_arg) {
+            memset(subscriber, 0, sizeof(subscriber_t));
+            update_subscribed_mask();
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_registry_lock);
+    return err;
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_registry_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_registry_lock);
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_registry_lock);
+    uint32_t subscribers = s_stats.subscribers;
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.subscribers = subscribers;
+    for (size_t index = 0; index < CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS; index++) {
+        s_subscribers[index].calls = 0;
+    }
+    portEXIT_CRITICAL(&s_registry_lock);
+}
+
+void print_stats()
+{
+    stats_t stats;
+    get_stats(&stats);
+    printf("Device events: %" PRIu32 " subscribers, %" PRIu32 " calls, %" PRIu32 " events without subscriber\n",
+           stats.subscribers, stats.calls, stats.unmatched);
+    for (int bit = 0; bit < DEVICE_EVENT_MASK_BITS; bit++) {
+        if (stats.events[bit] == 0) {
+            continue;
+        }
+        if (bit < DEVICE_EVENT_MASK_BITS - 1) {
+            printf("\ttype 0x%04X: %" PRIu32 "\n", chip::DeviceLayer::DeviceEventType::kRange_Public + bit,
+                   stats.events[bit]);
+        } else {
+            printf("\tother types: %" PRIu32 "\n", stats.events[bit]);
+        }
+    }
+    static subscriber_t subscribers[CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS];
+    portENTER_CRITICAL(&s_registry_lock);
+    memcpy(subscribers, s_subscribers, sizeof(subscribers));
+    portEXIT_CRITICAL(&s_registry_lock);
+    for (size_t index = 0; index < CONFIG_ESP_MATTER_DEVICE_EVENT_MAX_SUBSCRIBERS; index++) {
+        if (subscribers[index].callback) {
+            printf("Subscriber %p arg 0x%08" PRIXPTR ": mask 0x%016" PRIX64 ", %" PRIu32 " calls\n",
+                   (void *)subscribers[index].callback, subscribers[index].callback_arg, subscribers[index].mask,
+                   subscribers[index].calls);
+        }
+    }
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine device_event_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        device_event_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return device_event_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "device_event",
+        .description = "Device event registry statistics. Usage: matter esp device_event <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t device_event_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the number of device events of every type and the subscribers.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the device event statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    device_event_console.register_commands(device_event_commands,
+                                           sizeof(device_event_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace device_event
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_DEVICE_EVENT_REGISTRY
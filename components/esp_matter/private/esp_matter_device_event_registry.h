@@ -0,0 +1,43 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+
+namespace esp_matter {
+namespace device_event {
+
+#if CONFIG_ESP_MATTER_ENABLE_DEVICE_EVENT_REGISTRY
+/**
+ * @brief Adds the dispatcher of the device event subscriptions to the handlers of the platform manager. Called by
+ *        esp_matter::start() once the Matter stack is initialized.
+ *
+ * @return ESP_OK on success, error otherwise.
+ */
+esp_err_t init();
+
+/**
+ * @brief Registers the device event registry console commands.
+ */
+void register_console_commands();
+#else
+inline esp_err_t init() { return ESP_OK; }
+inline void register_console_commands() {}
+#endif // CONFIG_ESP_MATTER_ENABLE_DEVICE_EVENT_REGISTRY
+
+} // namespace device_event
+} // namespace esp_matter
@@ -0,0 +1,257 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_e2e_latency.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+#include <app/InteractionModelEngine.h>
+#include <app/server/Server.h>
+#include <messaging/ExchangeMgr.h>
+#include <protocols/interaction_model/Constants.h>
+
+static const char *TAG = "esp_matter_e2e_latency";
+
+namespace esp_matter {
+namespace e2e_latency {
+
+/* Upper bound of the first bucket, every following bucket doubles it */
+static constexpr uint32_t k_first_bucket_limit_us = 32;
+
+static const char *k_stage_names[STAGE_COUNT] = {
+    "total", "dispatch", "cluster server", "driver", "driver done", "post attribute change", "done",
+};
+
+/* The stages are timestamped on the Matter task, only the histograms are shared with the readers */
+static int64_t s_receive_us = 0;
+static int64_t s_stage_us[STAGE_COUNT];
+static bool s_active = false;
+static stage_stats_t s_stats[STAGE_COUNT];
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint8_t get_bucket(uint32_t duration_us)
+{
+    uint8_t bucket = 0;
+    uint32_t limit_us = k_first_bucket_limit_us;
+    while (bucket < E2E_LATENCY_BUCKET_COUNT - 1 && duration_us >= limit_us) {
+        bucket++;
+        limit_us <<= 1;
+    }
+    return bucket;
+}
+
+static void add_sample(stage_stats_t *stats, uint32_t duration_us)
+{
+    stats->count++;
+    stats->histogram[get_bucket(duration_us)]++;
+    stats->total_us += duration_us;
+    if (duration_us > stats->max_us) {
+        stats->max_us = duration_us;
+    }
+}
+
+/* Must be called with the stats lock held */
+static void record_stages()
+{
+    int64_t first_us = 0;
+    int64_t previous_us = 0;
+    for (int stage = STAGE_RECEIVE; stage < STAGE_COUNT; stage++) {
+        if (s_stage_us[stage] == 0) {
+            continue;
+        }
+        if (previous_us == 0) {
+            first_us = s_stage_us[stage];
+        } else {
+            add_sample(&s_stats[stage], (uint32_t)(s_stage_us[stage] - previous_us));
+        }
+        previous_us = s_stage_us[stage];
+    }
+    /* There is no stage before STAGE_RECEIVE, its statistics are the end-to-end times */
+    add_sample(&s_stats[STAGE_RECEIVE], (uint32_t)(s_stage_us[STAGE_DONE] - first_us));
+}
+
+void mark(stage_t stage)
+{
+    int64_t now_us = esp_timer_get_time();
+    if (stage == STAGE_DISPATCH) {
+        /* The receive timestamp belongs to the first command of the invoke request */
+        memset(s_stage_us, 0, sizeof(s_stage_us));
+        s_stage_us[STAGE_RECEIVE] = s_receive_us;
+        s_receive_us = 0;
+        s_stage_us[STAGE_DISPATCH] = now_us;
+        s_active = true;
+        return;
+    }
+    if (!s_active || s_stage_us[stage] != 0) {
+        return;
+    }
+    s_stage_us[stage] = now_us;
+    if (stage == STAGE_DONE) {
+        s_active = false;
+        portENTER_CRITICAL(&s_stats_lock);
+        record_stages();
+        portEXIT_CRITICAL(&s_stats_lock);
+    }
+}
+
+/* Timestamps the invoke requests before handing them to the interaction model engine. This is the earliest point of
+ * the receive path which does not need changes of the SDK, the message is already decrypted there. */
+class invoke_timestamp_handler : public chip::Messaging::UnsolicitedMessageHandler {
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const chip::PayloadHeader &payload_header,
+                                            chip::Messaging::ExchangeDelegate *&new_delegate)
+    {
+        if (payload_header.HasMessageType(chip::Protocols::InteractionModel::MsgType::InvokeCommandRequest)) {
+            s_receive_us = esp_timer_get_time();
+        }
+        return interaction_model()->OnUnsolicitedMessageReceived(payload_header, new_delegate);
+    }
+
+    void OnExchangeCreationFailed(chip::Messaging::ExchangeDelegate *delegate)
+    {
+        interaction_model()->OnExchangeCreationFailed(delegate);
+    }
+
+private:
+    static chip::Messaging::UnsolicitedMessageHandler *interaction_model()
+    {
+        return chip::app::InteractionModelEngine::GetInstance();
+    }
+};
+
+static invoke_timestamp_handler s_invoke_timestamp_handler;
+
+esp_err_t init()
+{
+    chip::Messaging::ExchangeManager &exchange_manager = chip::Server::GetInstance().GetExchangeManager();
+    exchange_manager.UnregisterUnsolicitedMessageHandlerForProtocol(chip::Protocols::InteractionModel::Id);
+    CHIP_ERROR err = exchange_manager.RegisterUnsolicitedMessageHandlerForProtocol(
+                         chip::Protocols::InteractionModel::Id, &s_invoke_timestamp_handler);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to register the invoke timestamp handler, err:%" CHIP_ERROR_FORMAT, err.Format());
+        /* Give the interaction model its handler back */
+        exchange_manager.RegisterUnsolicitedMessageHandlerForProtocol(chip::Protocols::InteractionModel::Id,
+                                                                      chip::app::InteractionModelEngine::GetInstance());
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t get_stats(stage_t stage, stage_stats_t *stats)
+{
+    if (stage >= STAGE_COUNT || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats[stage];
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    memset(s_stats, 0, sizeof(s_stats));
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    printf("Bucket upper bounds (us):");
+    for (int bucket = 0; bucket < E2E_LATENCY_BUCKET_COUNT - 1; bucket++) {
+        printf(" %" PRIu32, k_first_bucket_limit_us << bucket);
+    }
+    printf(" inf\n");
+    for (int stage = STAGE_RECEIVE; stage < STAGE_COUNT; stage++) {
+        stage_stats_t stats;
+        get_stats((stage_t)stage, &stats);
+        printf("%s: count %" PRIu32 ", avg %" PRIu64 " us, max %" PRIu32 " us\n\t", k_stage_names[stage],
+               stats.count, stats.count ? stats.total_us / stats.count : 0, stats.max_us);
+        for (int bucket = 0; bucket < E2E_LATENCY_BUCKET_COUNT; bucket++) {
+            printf(" %" PRIu32, stats.histogram[bucket]);
+        }
+        printf("\n");
+    }
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine e2e_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        e2e_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return e2e_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "e2e",
+        .description = "End-to-end command latency statistics per stage. Usage: matter esp e2e <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t e2e_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the latency histograms of the stages of the commands, each stage is timed from "
+                           "the previous one reached.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the end-to-end latency statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    e2e_console.register_commands(e2e_commands, sizeof(e2e_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace e2e_latency
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
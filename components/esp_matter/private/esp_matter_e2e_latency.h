@@ -0,0 +1,50 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace e2e_latency {
+
+#if CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+/**
+ * @brief Wraps the unsolicited message handler of the interaction model, to timestamp the invoke requests, called
+ *        after the server init with the chip stack lock.
+ *
+ * @return ESP_OK on success, error otherwise
+ */
+esp_err_t init();
+
+/**
+ * @brief Timestamps a stage of the command being dispatched, called on the Matter task.
+ *
+ * STAGE_DISPATCH starts a command and STAGE_DONE records its stages in the histograms. The other stages are only
+ * timestamped while a command is dispatched, the first time they are reached.
+ *
+ * @param stage Stage reached
+ */
+void mark(stage_t stage);
+
+/**
+ * @brief Registers the end-to-end latency console commands.
+ */
+void register_console_commands();
+#endif // CONFIG_ESP_MATTER_ENABLE_E2E_LATENCY
+
+} // namespace e2e_latency
+} // namespace esp_matter
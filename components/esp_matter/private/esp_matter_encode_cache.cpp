@@ -0,0 +1,141 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_encode_cache.h>
+#include <string.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_ENCODE_CACHE
+#include <app/util/attribute-storage.h>
+#include <platform/CHIPDeviceLayer.h>
+
+static const char *TAG = "esp_matter_encode_cache";
+
+namespace esp_matter {
+namespace encode_cache {
+
+typedef struct entry {
+    uint16_t endpoint_id;
+    uint16_t length;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    chip::DataVersion data_version;
+    uint8_t value[CONFIG_ESP_MATTER_ENCODE_CACHE_MAX_VALUE_SIZE];
+} entry_t;
+
+/* Only used on the Matter task */
+static entry_t s_entries[CONFIG_ESP_MATTER_ENCODE_CACHE_ENTRIES];
+static uint8_t s_entry_count = 0;
+/* Next entry replaced once the cache is full */
+static uint8_t s_next_entry = 0;
+static bool s_clear_scheduled = false;
+static uint32_t s_hits = 0;
+static uint32_t s_misses = 0;
+
+static void clear(intptr_t arg)
+{
+    s_entry_count = 0;
+    s_next_entry = 0;
+    s_clear_scheduled = false;
+}
+
+static bool get_data_version(uint16_t endpoint_id, uint32_t cluster_id, chip::DataVersion *data_version)
+{
+    chip::DataVersion *storage = emberAfDataVersionStorage(chip::app::ConcreteClusterPath(endpoint_id, cluster_id));
+    if (!storage) {
+        return false;
+    }
+    *data_version = *storage;
+    return true;
+}
+
+static entry_t *find(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    for (uint8_t i = 0; i < s_entry_count; i++) {
+        entry_t *entry = &s_entries[i];
+        if (entry->attribute_id == attribute_id && entry->cluster_id == cluster_id &&
+            entry->endpoint_id == endpoint_id) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+bool get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, uint8_t *buffer,
+         uint16_t max_read_length)
+{
+    entry_t *entry = find(endpoint_id, cluster_id, attribute_id);
+    chip::DataVersion data_version;
+    if (!entry || entry->length > max_read_length || !get_data_version(endpoint_id, cluster_id, &data_version) ||
+        entry->data_version != data_version) {
+        s_misses++;
+        return false;
+    }
+    memcpy(buffer, entry->value, entry->length);
+    s_hits++;
+    return true;
+}
+
+void put(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const uint8_t *buffer, uint16_t length)
+{
+    chip::DataVersion data_version;
+    if (length > CONFIG_ESP_MATTER_ENCODE_CACHE_MAX_VALUE_SIZE ||
+        !get_data_version(endpoint_id, cluster_id, &data_version)) {
+        return;
+    }
+    if (!s_clear_scheduled) {
+        /* The event of the reporting engine encodes the reports of all the ReadHandlers, the cache is dropped
+         * after it so the values changed by the next events are encoded again */
+        if (chip::DeviceLayer::PlatformMgr().ScheduleWork(clear, 0) != CHIP_NO_ERROR) {
+            ESP_LOGW(TAG, "Failed to schedule the end of the reporting cycle");
+            return;
+        }
+        s_clear_scheduled = true;
+    }
+    entry_t *entry = find(endpoint_id, cluster_id, attribute_id);
+    if (!entry) {
+        if (s_entry_count < CONFIG_ESP_MATTER_ENCODE_CACHE_ENTRIES) {
+            entry = &s_entries[s_entry_count++];
+        } else {
+            entry = &s_entries[s_next_entry];
+            s_next_entry = (s_next_entry + 1) % CONFIG_ESP_MATTER_ENCODE_CACHE_ENTRIES;
+        }
+    }
+    entry->endpoint_id = endpoint_id;
+    entry->cluster_id = cluster_id;
+    entry->attribute_id = attribute_id;
+    entry->data_version = data_version;
+    entry->length = length;
+    memcpy(entry->value, buffer, length);
+}
+
+} // namespace encode_cache
+
+namespace attribute {
+
+void get_encode_cache_stats(uint32_t *hits, uint32_t *misses)
+{
+    if (hits) {
+        *hits = encode_cache::s_hits;
+    }
+    if (misses) {
+        *misses = encode_cache::s_misses;
+    }
+}
+
+} // namespace attribute
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_ENCODE_CACHE
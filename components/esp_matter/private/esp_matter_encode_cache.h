@@ -0,0 +1,58 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace encode_cache {
+
+#if CONFIG_ESP_MATTER_ENABLE_ENCODE_CACHE
+/**
+ * @brief Copies the value of an attribute encoded earlier in the same reporting cycle, called from the external
+ *        attribute read callback on the Matter task.
+ *
+ * The entries are keyed by the attribute path and the data version of its cluster. They are dropped once the
+ * current event of the Matter task returns, so the reports of all the ReadHandlers generated by the same run of the
+ * reporting engine share them.
+ *
+ * @param endpoint_id     Endpoint ID of the attribute
+ * @param cluster_id      Cluster ID of the attribute
+ * @param attribute_id    Attribute ID
+ * @param buffer          Buffer of the read callback
+ * @param max_read_length Size of the buffer
+ *
+ * @return true if the encoded value is copied to the buffer, false if the caller encodes it
+ */
+bool get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, uint8_t *buffer,
+         uint16_t max_read_length);
+
+/**
+ * @brief Stores the encoded value of an attribute for the rest of the reporting cycle, called from the external
+ *        attribute read callback on the Matter task. The values larger than
+ *        CONFIG_ESP_MATTER_ENCODE_CACHE_MAX_VALUE_SIZE are not stored.
+ *
+ * @param endpoint_id  Endpoint ID of the attribute
+ * @param cluster_id   Cluster ID of the attribute
+ * @param attribute_id Attribute ID
+ * @param buffer       Encoded value
+ * @param length       Length of the encoded value
+ */
+void put(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const uint8_t *buffer, uint16_t length);
+#endif // CONFIG_ESP_MATTER_ENABLE_ENCODE_CACHE
+
+} // namespace encode_cache
+} // namespace esp_matter
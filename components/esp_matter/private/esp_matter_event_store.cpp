@@ -0,0 +1,391 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <esp_matter_event.h>
+#include <esp_matter_event_store.h>
+#include <esp_matter_mem.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_EVENT_STORE
+#include <system/SystemClock.h>
+
+namespace esp_matter {
+namespace event_store {
+
+static const char *TAG = "mtr_event_store";
+
+constexpr uint32_t k_magic = 0x53454D45; /* "EMES" */
+constexpr uint32_t k_version = 1;
+/* The records are padded to this size, which keeps the writes aligned when the partition is encrypted */
+constexpr size_t k_alignment = 16;
+
+typedef struct sector_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sequence;
+    uint32_t reserved;
+    uint64_t first_event_number;
+    uint32_t reserved2;
+    uint32_t crc;
+} sector_header_t;
+
+/* Followed by the payload, padded to k_alignment. The CRC covers the header and the payload. */
+typedef struct record_header {
+    uint64_t event_number;
+    uint32_t timestamp_s;
+    uint32_t cluster_id;
+    uint32_t event_id;
+    uint16_t endpoint_id;
+    uint16_t payload_size;
+    uint8_t priority;
+    uint8_t reserved[3];
+    uint32_t crc;
+} record_header_t;
+
+static_assert(sizeof(sector_header_t) == 32, "The sector header is part of the flash format");
+static_assert(sizeof(record_header_t) == 32, "The record header is part of the flash format");
+
+typedef struct sector {
+    /* 0 if the sector has no valid header */
+    uint32_t sequence;
+    chip::EventNumber first_event_number;
+} sector_t;
+
+static const esp_partition_t *s_partition = NULL;
+static SemaphoreHandle_t s_mutex = NULL;
+static sector_t *s_sectors = NULL;
+static size_t s_sector_count = 0;
+static size_t s_current_sector = 0;
+/* Offset of the next record in the current sector, 0 if no sector has been written yet */
+static size_t s_write_offset = 0;
+
+static inline size_t get_record_size(uint16_t payload_size)
+{
+    return (sizeof(record_header_t) + payload_size + k_alignment - 1) & ~(k_alignment - 1);
+}
+
+static inline size_t get_sector_offset(size_t sector)
+{
+    return sector * s_partition->erase_size;
+}
+
+static uint32_t get_record_crc(const record_header_t *header, const uint8_t *payload)
+{
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)header, offsetof(record_header_t, crc));
+    return esp_rom_crc32_le(crc, payload, header->payload_size);
+}
+
+static bool is_erased(const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t index = 0; index < size; index++) {
+        if (bytes[index] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool read_sector_header(size_t sector, sector_t *out)
+{
+    sector_header_t header;
+    if (esp_partition_read(s_partition, get_sector_offset(sector), &header, sizeof(header)) != ESP_OK) {
+        return false;
+    }
+    if (header.magic != k_magic || header.version != k_version || header.sequence == 0 ||
+        header.crc != esp_rom_crc32_le(0, (const uint8_t *)&header, offsetof(sector_header_t, crc))) {
+        return false;
+    }
+    out->sequence = header.sequence;
+    out->first_event_number = header.first_event_number;
+    return true;
+}
+
+/* Finds the end of the records of the current sector. A record with a corrupted header, most likely a write
+ * interrupted by a reset, ends the sector: its size cannot be trusted. */
+static size_t find_write_offset(size_t sector)
+{
+    size_t offset = sizeof(sector_header_t);
+    while (offset + sizeof(record_header_t) <= s_partition->erase_size) {
+        record_header_t header;
+        if (esp_partition_read(s_partition, get_sector_offset(sector) + offset, &header, sizeof(header)) != ESP_OK ||
+            is_erased(&header, sizeof(header))) {
+            return offset;
+        }
+        size_t record_size = get_record_size(header.payload_size);
+        if (offset + record_size > s_partition->erase_size) {
+            return s_partition->erase_size;
+        }
+        offset += record_size;
+    }
+    return offset;
+}
+
+esp_err_t init()
+{
+    if (s_partition) {
+        return ESP_OK;
+    }
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                                CONFIG_ESP_MATTER_EVENT_STORE_PARTITION_LABEL);
+    if (!partition) {
+        ESP_LOGE(TAG, "Event store partition %s not found", CONFIG_ESP_MATTER_EVENT_STORE_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+    size_t sector_count = partition->size / partition->erase_size;
+    if (sector_count < 2 || get_record_size(CONFIG_ESP_MATTER_EVENT_STORE_MAX_PAYLOAD_SIZE) >
+        partition->erase_size - sizeof(sector_header_t)) {
+        ESP_LOGE(TAG, "Event store partition too small, it needs at least two sectors");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    s_sectors = (sector_t *)esp_matter_mem_calloc(sector_count, sizeof(sector_t));
+    s_mutex = xSemaphoreCreateMutex();
+    if (!s_sectors || !s_mutex) {
+        esp_matter_mem_free(s_sectors);
+        s_sectors = NULL;
+        if (s_mutex) {
+            vSemaphoreDelete(s_mutex);
+            s_mutex = NULL;
+        }
+        return ESP_ERR_NO_MEM;
+    }
+    s_partition = partition;
+    s_sector_count = sector_count;
+
+    uint32_t max_sequence = 0;
+    for (size_t sector = 0; sector < s_sector_count; sector++) {
+        if (read_sector_header(sector, &s_sectors[sector]) && s_sectors[sector].sequence > max_sequence) {
+            max_sequence = s_sectors[sector].sequence;
+            s_current_sector = sector;
+        }
+    }
+    s_write_offset = max_sequence ? find_write_offset(s_current_sector) : 0;
+    ESP_LOGI(TAG, "Event store of %u sectors, current sector %u, %u bytes used", (unsigned)s_sector_count,
+             (unsigned)s_current_sector, (unsigned)s_write_offset);
+    return ESP_OK;
+}
+
+/* Erases the next sector, which drops its events, and makes it the current one */
+static esp_err_t open_next_sector(chip::EventNumber first_event_number)
+{
+    size_t sector = s_write_offset ? (s_current_sector + 1) % s_sector_count : s_current_sector;
+    uint32_t sequence = s_write_offset ? s_sectors[s_current_sector].sequence + 1 : 1;
+    s_sectors[sector].sequence = 0;
+    esp_err_t err = esp_partition_erase_range(s_partition, get_sector_offset(sector), s_partition->erase_size);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to erase the event store sector %u", (unsigned)sector);
+        return err;
+    }
+    sector_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = k_magic;
+    header.version = k_version;
+    header.sequence = sequence;
+    header.first_event_number = first_event_number;
+    header.crc = esp_rom_crc32_le(0, (const uint8_t *)&header, offsetof(sector_header_t, crc));
+    err = esp_partition_write(s_partition, get_sector_offset(sector), &header, sizeof(header));
+    if (err != ESP_OK) {
+        return err;
+    }
+    s_sectors[sector].sequence = sequence;
+    s_sectors[sector].first_event_number = first_event_number;
+    s_current_sector = sector;
+    s_write_offset = sizeof(sector_header_t);
+    return ESP_OK;
+}
+
+static esp_err_t append(const record_header_t *header, const uint8_t *payload)
+{
+    size_t record_size = get_record_size(header->payload_size);
+    if (s_write_offset == 0 || s_write_offset + record_size > s_partition->erase_size) {
+        esp_err_t err = open_next_sector(header->event_number);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    /* The record is written in one go from a padded copy, so that the flash writes stay aligned */
+    uint8_t *record = (uint8_t *)esp_matter_mem_calloc(1, record_size);
+    if (!record) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(record, header, sizeof(record_header_t));
+    memcpy(record + sizeof(record_header_t), payload, header->payload_size);
+    esp_err_t err = esp_partition_write(s_partition, get_sector_offset(s_current_sector) + s_write_offset, record,
+                                        record_size);
+    esp_matter_mem_free(record);
+    /* Don't reuse the space even if the write failed, it might be partially written */
+    s_write_offset += record_size;
+    return err;
+}
+
+/* Sector holding the event number, or the oldest sector if the event number is older than all of them */
+static size_t find_first_sector(chip::EventNumber from, size_t *count)
+{
+    size_t oldest = s_current_sector;
+    *count = 0;
+    for (size_t index = 1; index <= s_sector_count; index++) {
+        /* Walk back from the current sector, the sequence numbers decrease by one */
+        size_t sector = (s_current_sector + s_sector_count - index + 1) % s_sector_count;
+        if (s_sectors[sector].sequence == 0 ||
+            s_sectors[sector].sequence + index - 1 != s_sectors[s_current_sector].sequence) {
+            break;
+        }
+        oldest = sector;
+        (*count)++;
+        if (s_sectors[sector].first_event_number <= from) {
+            break;
+        }
+    }
+    return oldest;
+}
+
+static esp_err_t read_sector(size_t sector, chip::EventNumber from, uint8_t *payload,
+                             event::stored_event_callback_t callback, void *priv_data, bool *stop)
+{
+    size_t end = sector == s_current_sector ? s_write_offset : s_partition->erase_size;
+    size_t offset = sizeof(sector_header_t);
+    while (offset + sizeof(record_header_t) <= end) {
+        record_header_t header;
+        esp_err_t err = esp_partition_read(s_partition, get_sector_offset(sector) + offset, &header, sizeof(header));
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (is_erased(&header, sizeof(header)) || header.payload_size > CONFIG_ESP_MATTER_EVENT_STORE_MAX_PAYLOAD_SIZE) {
+            break;
+        }
+        size_t record_size = get_record_size(header.payload_size);
+        if (offset + record_size > end) {
+            break;
+        }
+        err = esp_partition_read(s_partition, get_sector_offset(sector) + offset + sizeof(header), payload,
+                                 header.payload_size);
+        if (err != ESP_OK) {
+            return err;
+        }
+        offset += record_size;
+        if (header.event_number < from || header.crc != get_record_crc(&header, payload)) {
+            continue;
+        }
+        event::stored_event_t event = {
+            .number = header.event_number,
+            .timestamp_s = header.timestamp_s,
+            .endpoint_id = header.endpoint_id,
+            .cluster_id = header.cluster_id,
+            .event_id = header.event_id,
+            .priority = static_cast<chip::app::PriorityLevel>(header.priority),
+            .payload_size = header.payload_size,
+        };
+        if (!callback(&event, payload, priv_data)) {
+            *stop = true;
+            break;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t erase_all()
+{
+    if (!s_partition) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    esp_err_t err = esp_partition_erase_range(s_partition, 0, s_partition->size);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to erase the event store partition");
+    }
+    memset(s_sectors, 0, s_sector_count * sizeof(sector_t));
+    s_current_sector = 0;
+    s_write_offset = 0;
+    xSemaphoreGive(s_mutex);
+    return err;
+}
+
+} // namespace event_store
+
+namespace event {
+
+esp_err_t store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t event_id, chip::app::PriorityLevel priority,
+                chip::EventNumber number, const uint8_t *payload, uint16_t payload_size)
+{
+    using namespace event_store;
+    if (!s_partition) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if ((!payload && payload_size > 0) || payload_size > CONFIG_ESP_MATTER_EVENT_STORE_MAX_PAYLOAD_SIZE) {
+        ESP_LOGE(TAG, "Invalid event payload of %u bytes", payload_size);
+        return ESP_ERR_INVALID_ARG;
+    }
+    record_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.event_number = number;
+    chip::System::Clock::Microseconds64 now;
+    if (chip::System::SystemClock().GetClock_RealTime(now) == CHIP_NO_ERROR) {
+        header.timestamp_s = (uint32_t)(now.count() / 1000000);
+    }
+    header.cluster_id = cluster_id;
+    header.event_id = event_id;
+    header.endpoint_id = endpoint_id;
+    header.payload_size = payload_size;
+    header.priority = static_cast<uint8_t>(priority);
+    header.crc = get_record_crc(&header, payload);
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    esp_err_t err = append(&header, payload);
+    xSemaphoreGive(s_mutex);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store the event 0x%" PRIx64, (uint64_t)number);
+    }
+    return err;
+}
+
+esp_err_t read_stored(chip::EventNumber from, stored_event_callback_t callback, void *priv_data)
+{
+    using namespace event_store;
+    if (!callback) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_partition) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    uint8_t *payload = (uint8_t *)esp_matter_mem_calloc(1, CONFIG_ESP_MATTER_EVENT_STORE_MAX_PAYLOAD_SIZE);
+    if (!payload) {
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t err = ESP_OK;
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (s_write_offset > 0) {
+        size_t count = 0;
+        size_t sector = find_first_sector(from, &count);
+        bool stop = false;
+        for (size_t index = 0; index < count && !stop && err == ESP_OK; index++) {
+            err = read_sector((sector + index) % s_sector_count, from, payload, callback, priv_data, &stop);
+        }
+    }
+    xSemaphoreGive(s_mutex);
+    esp_matter_mem_free(payload);
+    return err;
+}
+
+} // namespace event
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_EVENT_STORE
@@ -0,0 +1,50 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace event_store {
+
+/*
+ * Append-only, circular event log on a raw data partition.
+ *
+ * Every sector of the partition starts with a header holding a sequence number and the event number of its first
+ * event, followed by variable size, CRC protected records which are appended sequentially. When the current sector is
+ * full, the next one is erased and becomes the current one, which drops the oldest events. Only the sequence numbers
+ * and the first event numbers of the sectors are kept in RAM, the reads seek the sector of an event number with them
+ * and stream the records from flash.
+ */
+
+#if CONFIG_ESP_MATTER_ENABLE_EVENT_STORE
+/**
+ * @brief Finds the partition and scans the sector headers, called once at startup.
+ *
+ * @return ESP_OK on success, error otherwise
+ */
+esp_err_t init();
+
+/**
+ * @brief Erases the event store partition.
+ *
+ * @return ESP_OK on success, error otherwise
+ */
+esp_err_t erase_all();
+#endif // CONFIG_ESP_MATTER_ENABLE_EVENT_STORE
+
+} // namespace event_store
+} // namespace esp_matter
@@ -0,0 +1,480 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_group_key_cache.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_GROUP_KEY_CACHE
+#include <app/server/Server.h>
+#include <credentials/GroupDataProviderImpl.h>
+#include <crypto/CHIPCryptoPAL.h>
+
+using chip::ByteSpan;
+using chip::FabricIndex;
+using chip::GroupId;
+using chip::MutableByteSpan;
+using chip::Credentials::GroupDataProvider;
+
+namespace esp_matter {
+namespace group_key_cache {
+
+static const char *TAG = "group_key_cache";
+/* Bits of the membership bitmap, indexed by the low bits of the group session id */
+static constexpr size_t k_membership_bits = 1024;
+
+/* Operational keys of an epoch key, owned by the cache */
+class CachedKeyContext : public chip::Crypto::SymmetricKeyContext {
+public:
+    uint16_t GetKeyHash() override { return m_hash; }
+
+    CHIP_ERROR MessageEncrypt(const ByteSpan &plaintext, const ByteSpan &aad, const ByteSpan &nonce,
+                              MutableByteSpan &mic, MutableByteSpan &ciphertext) const override
+    {
+        return chip::Crypto::AES_CCM_encrypt(plaintext.data(), plaintext.size(), aad.data(), aad.size(),
+                                             m_encryption_key, nonce.data(), nonce.size(), ciphertext.data(),
+                                             mic.data(), mic.size());
+    }
+
+    CHIP_ERROR MessageDecrypt(const ByteSpan &ciphertext, const ByteSpan &aad, const ByteSpan &nonce,
+                              const ByteSpan &mic, MutableByteSpan &plaintext) const override
+    {
+        return chip::Crypto::AES_CCM_decrypt(ciphertext.data(), ciphertext.size(), aad.data(), aad.size(), mic.data(),
+                                             mic.size(), m_encryption_key, nonce.data(), nonce.size(),
+                                             plaintext.data());
+    }
+
+    CHIP_ERROR PrivacyEncrypt(const ByteSpan &input, const ByteSpan &nonce, MutableByteSpan &output) const override
+    {
+        return chip::Crypto::AES_CTR_crypt(input.data(), input.size(), m_privacy_key, nonce.data(), nonce.size(),
+                                           output.data());
+    }
+
+    CHIP_ERROR PrivacyDecrypt(const ByteSpan &input, const ByteSpan &nonce, MutableByteSpan &output) const override
+    {
+        return chip::Crypto::AES_CTR_crypt(input.data(), input.size(), m_privacy_key, nonce.data(), nonce.size(),
+                                           output.data());
+    }
+
+    /* The contexts are released when the cache is rebuilt */
+    void Release() override {}
+
+    uint16_t m_hash = 0;
+    chip::Crypto::Aes128KeyHandle m_encryption_key;
+    chip::Crypto::Aes128KeyHandle m_privacy_key;
+};
+
+typedef struct cached_key {
+    FabricIndex fabric_index;
+    GroupId group_id;
+    GroupDataProvider::SecurityPolicy policy;
+    CachedKeyContext context;
+} cached_key_t;
+
+/* Everything below is only accessed with the Matter stack lock held, the stats are shared with the readers */
+static cached_key_t s_keys[CONFIG_ESP_MATTER_GROUP_KEY_CACHE_SIZE];
+static size_t s_key_count = 0;
+static uint32_t s_membership[k_membership_bits / 32];
+static chip::Crypto::SessionKeystore *s_keystore = NULL;
+/* The group data changed since the cache was built */
+static bool s_dirty = true;
+/* More keys than the cache holds, the sessions are looked up in the storage */
+static bool s_overflow = false;
+
+static stats_t s_stats;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#define STATS_INCREMENT(field)                 \
+    do {                                       \
+        portENTER_CRITICAL(&s_stats_lock);     \
+        s_stats.field++;                       \
+        portEXIT_CRITICAL(&s_stats_lock);      \
+    } while (0)
+
+static void set_member(uint16_t hash)
+{
+    s_membership[(hash % k_membership_bits) / 32] |= 1u << (hash % 32);
+}
+
+static bool is_member(uint16_t hash)
+{
+    return s_membership[(hash % k_membership_bits) / 32] & (1u << (hash % 32));
+}
+
+static void clear_cache()
+{
+    for (size_t idx = 0; idx < s_key_count; ++idx) {
+        s_keystore->DestroyKey(s_keys[idx].context.m_encryption_key);
+        s_keystore->DestroyKey(s_keys[idx].context.m_privacy_key);
+    }
+    s_key_count = 0;
+    memset(s_membership, 0, sizeof(s_membership));
+    s_overflow = false;
+}
+
+static bool has_endpoint(GroupDataProvider *provider, FabricIndex fabric_index, GroupId group_id)
+{
+    auto iter = provider->IterateEndpoints(fabric_index);
+    if (!iter) {
+        return false;
+    }
+    GroupDataProvider::GroupEndpoint mapping;
+    bool found = false;
+    while (!found && iter->Next(mapping)) {
+        found = mapping.group_id == group_id;
+    }
+    iter->Release();
+    return found;
+}
+
+static bool add_keys(FabricIndex fabric_index, GroupId group_id, const GroupDataProvider::KeySet &keyset,
+                     const ByteSpan &compressed_fabric_id)
+{
+    for (size_t idx = 0; idx < keyset.num_keys_used; ++idx) {
+        if (s_key_count == CONFIG_ESP_MATTER_GROUP_KEY_CACHE_SIZE) {
+            return false;
+        }
+        chip::Crypto::GroupOperationalCredentials credentials;
+        if (chip::Crypto::DeriveGroupOperationalCredentials(ByteSpan(keyset.epoch_keys[idx].key), compressed_fabric_id,
+                                                            credentials) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to derive the keys of group 0x%04" PRIX16, group_id);
+            continue;
+        }
+        cached_key_t &key = s_keys[s_key_count];
+        bool created = s_keystore->CreateKey(credentials.encryption_key, key.context.m_encryption_key) ==
+            CHIP_NO_ERROR;
+        if (created && s_keystore->CreateKey(credentials.privacy_key, key.context.m_privacy_key) != CHIP_NO_ERROR) {
+            s_keystore->DestroyKey(key.context.m_encryption_key);
+            created = false;
+        }
+        chip::Crypto::ClearSecretData(credentials.encryption_key);
+        chip::Crypto::ClearSecretData(credentials.privacy_key);
+        if (!created) {
+            ESP_LOGE(TAG, "Failed to create the keys of group 0x%04" PRIX16, group_id);
+            return false;
+        }
+        key.fabric_index = fabric_index;
+        key.group_id = group_id;
+        key.policy = keyset.policy;
+        key.context.m_hash = credentials.hash;
+        set_member(credentials.hash);
+        s_key_count++;
+    }
+    return true;
+}
+
+/* Derives the operational keys of the groups with endpoints on the node, from the group key maps of the fabrics */
+static void rebuild(GroupDataProvider *provider)
+{
+    clear_cache();
+    s_dirty = false;
+    STATS_INCREMENT(rebuilds);
+    for (const chip::FabricInfo &fabric : chip::Server::GetInstance().GetFabricTable()) {
+        FabricIndex fabric_index = fabric.GetFabricIndex();
+        uint8_t compressed_fabric_id_buf[sizeof(uint64_t)];
+        MutableByteSpan compressed_fabric_id(compressed_fabric_id_buf);
+        if (fabric.GetCompressedFabricIdBytes(compressed_fabric_id) != CHIP_NO_ERROR) {
+            continue;
+        }
+        auto iter = provider->IterateGroupKeys(fabric_index);
+        if (!iter) {
+            continue;
+        }
+        GroupDataProvider::GroupKey mapping;
+        while (!s_overflow && iter->Next(mapping)) {
+            // The messages of the groups without endpoint on the node would be dropped after their decryption
+            if (!has_endpoint(provider, fabric_index, mapping.group_id)) {
+                continue;
+            }
+            GroupDataProvider::KeySet keyset;
+            if (provider->GetKeySet(fabric_index, mapping.keyset_id, keyset) != CHIP_NO_ERROR) {
+                continue;
+            }
+            s_overflow = !add_keys(fabric_index, mapping.group_id, keyset, compressed_fabric_id);
+        }
+        iter->Release();
+        if (s_overflow) {
+            ESP_LOGW(TAG, "More group keys than CONFIG_ESP_MATTER_GROUP_KEY_CACHE_SIZE, they are read from storage");
+            clear_cache();
+            s_overflow = true;
+            return;
+        }
+    }
+    ESP_LOGD(TAG, "Cached %u group keys", (unsigned)s_key_count);
+}
+
+/* Iterates the cached keys of a group session id, one instance as the session manager uses one at a time */
+class CachedSessionIterator : public GroupDataProvider::GroupSessionIterator {
+public:
+    void Start(uint16_t session_id, bool member)
+    {
+        m_session_id = session_id;
+        m_next = member ? 0 : s_key_count;
+        m_in_use = true;
+    }
+
+    bool InUse() const { return m_in_use; }
+
+    size_t Count() override
+    {
+        size_t count = 0;
+        for (size_t idx = m_next; idx < s_key_count; ++idx) {
+            count += s_keys[idx].context.m_hash == m_session_id;
+        }
+        return count;
+    }
+
+    bool Next(GroupDataProvider::GroupSession &output) override
+    {
+        while (m_next < s_key_count) {
+            cached_key_t &key = s_keys[m_next++];
+            if (key.context.m_hash == m_session_id) {
+                output.fabric_index = key.fabric_index;
+                output.group_id = key.group_id;
+                output.security_policy = key.policy;
+                output.keyContext = &key.context;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Release() override { m_in_use = false; }
+
+private:
+    uint16_t m_session_id = 0;
+    size_t m_next = 0;
+    bool m_in_use = false;
+};
+
+static CachedSessionIterator s_session_iterator;
+
+/* The changes of the groups, the endpoints, the key maps and the key sets invalidate the cache */
+class CachedGroupDataProvider : public chip::Credentials::GroupDataProviderImpl {
+public:
+    GroupSessionIterator *IterateGroupSessions(uint16_t session_id) override
+    {
+        STATS_INCREMENT(lookups);
+        // The keys of the iterator in use are kept until it is released
+        if (!s_session_iterator.InUse() && s_dirty) {
+            rebuild(this);
+        }
+        if (s_overflow || s_session_iterator.InUse()) {
+            STATS_INCREMENT(fallbacks);
+            return GroupDataProviderImpl::IterateGroupSessions(session_id);
+        }
+        // Without a key of the session id the iterator is empty, and the message is dropped without a decryption
+        bool member = is_member(session_id);
+        if (!member) {
+            STATS_INCREMENT(filtered);
+        }
+        s_session_iterator.Start(session_id, member);
+        return &s_session_iterator;
+    }
+
+    CHIP_ERROR SetGroupInfo(FabricIndex fabric_index, const GroupInfo &info) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::SetGroupInfo(fabric_index, info);
+    }
+
+    CHIP_ERROR RemoveGroupInfo(FabricIndex fabric_index, GroupId group_id) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::RemoveGroupInfo(fabric_index, group_id);
+    }
+
+    CHIP_ERROR SetGroupInfoAt(FabricIndex fabric_index, size_t index, const GroupInfo &info) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::SetGroupInfoAt(fabric_index, index, info);
+    }
+
+    CHIP_ERROR RemoveGroupInfoAt(FabricIndex fabric_index, size_t index) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::RemoveGroupInfoAt(fabric_index, index);
+    }
+
+    CHIP_ERROR AddEndpoint(FabricIndex fabric_index, GroupId group_id, chip::EndpointId endpoint_id) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::AddEndpoint(fabric_index, group_id, endpoint_id);
+    }
+
+    CHIP_ERROR RemoveEndpoint(FabricIndex fabric_index, GroupId group_id, chip::EndpointId endpoint_id) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::RemoveEndpoint(fabric_index, group_id, endpoint_id);
+    }
+
+    CHIP_ERROR RemoveEndpoint(FabricIndex fabric_index, chip::EndpointId endpoint_id) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::RemoveEndpoint(fabric_index, endpoint_id);
+    }
+
+    CHIP_ERROR SetGroupKeyAt(FabricIndex fabric_index, size_t index, const GroupKey &info) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::SetGroupKeyAt(fabric_index, index, info);
+    }
+
+    CHIP_ERROR RemoveGroupKeyAt(FabricIndex fabric_index, size_t index) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::RemoveGroupKeyAt(fabric_index, index);
+    }
+
+    CHIP_ERROR RemoveGroupKeys(FabricIndex fabric_index) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::RemoveGroupKeys(fabric_index);
+    }
+
+    CHIP_ERROR SetKeySet(FabricIndex fabric_index, const ByteSpan &compressed_fabric_id, const KeySet &keys) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::SetKeySet(fabric_index, compressed_fabric_id, keys);
+    }
+
+    CHIP_ERROR RemoveKeySet(FabricIndex fabric_index, chip::KeysetId keyset_id) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::RemoveKeySet(fabric_index, keyset_id);
+    }
+
+    CHIP_ERROR RemoveFabric(FabricIndex fabric_index) override
+    {
+        s_dirty = true;
+        return GroupDataProviderImpl::RemoveFabric(fabric_index);
+    }
+};
+
+static CachedGroupDataProvider s_provider;
+
+GroupDataProvider *get_provider(chip::PersistentStorageDelegate *storage, chip::Crypto::SessionKeystore *keystore)
+{
+    if (!storage || !keystore) {
+        ESP_LOGE(TAG, "Storage and keystore cannot be NULL");
+        return NULL;
+    }
+    if (s_keystore) {
+        return &s_provider;
+    }
+    s_provider.SetStorageDelegate(storage);
+    s_provider.SetSessionKeystore(keystore);
+    CHIP_ERROR err = s_provider.Init();
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to initialize the group data provider, err:%" CHIP_ERROR_FORMAT, err.Format());
+        return NULL;
+    }
+    s_keystore = keystore;
+    chip::Credentials::SetGroupDataProvider(&s_provider);
+    return &s_provider;
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats = {};
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    stats_t stats;
+    get_stats(&stats);
+    printf("Group session lookups: %" PRIu32 ", filtered: %" PRIu32 ", from storage: %" PRIu32 ", rebuilds: %" PRIu32
+           "\n", stats.lookups, stats.filtered, stats.fallbacks, stats.rebuilds);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine group_key_cache_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        group_key_cache_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return group_key_cache_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "group_keys",
+        .description = "Group key cache statistics. Usage: matter esp group_keys <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t group_key_cache_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the group session lookups, the filtered ones and the rebuilds of the cache.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the group key cache statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    group_key_cache_console.register_commands(group_key_cache_commands, sizeof(group_key_cache_commands) /
+                                              sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace group_key_cache
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_GROUP_KEY_CACHE
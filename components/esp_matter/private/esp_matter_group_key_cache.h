@@ -0,0 +1,48 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_GROUP_KEY_CACHE
+#include <credentials/GroupDataProvider.h>
+#include <crypto/SessionKeystore.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+
+namespace esp_matter {
+namespace group_key_cache {
+
+/**
+ * @brief Returns the group data provider of the server, which keeps the operational keys of the groups with members
+ *        on the node and drops the group messages of the other groups before any crypto operation. Set in the server
+ *        init parameters before the server init.
+ *
+ * @param storage Persistent storage delegate of the server
+ * @param keystore Session keystore of the server
+ *
+ * @return Group data provider, NULL if it cannot be initialized
+ */
+chip::Credentials::GroupDataProvider *get_provider(chip::PersistentStorageDelegate *storage,
+                                                   chip::Crypto::SessionKeystore *keystore);
+
+/**
+ * @brief Registers the group key cache console commands.
+ */
+void register_console_commands();
+
+} // namespace group_key_cache
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_GROUP_KEY_CACHE
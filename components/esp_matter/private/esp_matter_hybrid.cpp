@@ -0,0 +1,84 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_hybrid.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
+#include <app/util/attribute-storage.h>
+#include <inttypes.h>
+#include <zap-generated/endpoint_config.h>
+
+namespace esp_matter {
+namespace hybrid {
+
+static const char *TAG = "esp_matter_hybrid";
+
+/*
+ * The fixed endpoints of the zap data model are served from the tables generated in flash, at the first indexes of
+ * the endpoints of the stack, and the endpoints created with the esp_matter API are added as dynamic endpoints after
+ * them. The esp_matter node only holds the dynamic endpoints, the root node is one of the fixed endpoints.
+ */
+
+#if FIXED_ENDPOINT_COUNT > 0
+static const uint16_t k_fixed_endpoints[] = FIXED_ENDPOINT_ARRAY;
+#endif
+
+uint16_t get_first_dynamic_endpoint_id()
+{
+    uint16_t first = 0;
+#if FIXED_ENDPOINT_COUNT > 0
+    /* The table holds the fixed endpoints before the server init configures them in the stack */
+    for (size_t index = 0; index < sizeof(k_fixed_endpoints) / sizeof(k_fixed_endpoints[0]); index++) {
+        if (k_fixed_endpoints[index] >= first) {
+            first = k_fixed_endpoints[index] + 1;
+        }
+    }
+#endif
+    return first;
+}
+
+static bool is_served_by_fixed_endpoint(uint32_t cluster_id)
+{
+    for (uint16_t index = 0; index < emberAfFixedEndpointCount(); index++) {
+        if (emberAfContainsServer(emberAfEndpointFromIndex(index), cluster_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void plugin_init_dynamic_clusters()
+{
+    node_t *node = node::get();
+    if (!node) {
+        return;
+    }
+    uint16_t count = 0;
+    for (endpoint_t *endpoint = endpoint::get_first(node); endpoint; endpoint = endpoint::get_next(endpoint)) {
+        for (cluster_t *cluster = cluster::get_first(endpoint); cluster; cluster = cluster::get_next(cluster)) {
+            cluster::plugin_server_init_callback_t callback = cluster::get_plugin_server_init_callback(cluster);
+            /* The callbacks are called once, the generated plugin init already ran the ones of the fixed endpoints */
+            if (callback && !is_served_by_fixed_endpoint(cluster::get_id(cluster))) {
+                callback();
+                count++;
+            }
+        }
+    }
+    ESP_LOGI(TAG, "Plugin server inits of the dynamic endpoints: %" PRIu16, count);
+}
+
+} // namespace hybrid
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
@@ -0,0 +1,47 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+namespace esp_matter {
+namespace hybrid {
+
+#if CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
+/**
+ * @brief Returns the first endpoint id after the fixed endpoints of the zap data model, the ids of the dynamic
+ * endpoints start there.
+ *
+ * @return Endpoint id
+ */
+uint16_t get_first_dynamic_endpoint_id();
+
+/**
+ * @brief Runs the plugin server inits of the clusters of the dynamic endpoints, called after the server init.
+ *
+ * The plugin server inits of the clusters of the fixed endpoints ran with the server init, the ones of the clusters
+ * which only the dynamic endpoints have are run here.
+ */
+void plugin_init_dynamic_clusters();
+#else
+inline uint16_t get_first_dynamic_endpoint_id()
+{
+    return 0;
+}
+inline void plugin_init_dynamic_clusters() {}
+#endif // CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
+
+} // namespace hybrid
+} // namespace esp_matter
@@ -0,0 +1,107 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_matter_icd_report_batching.h>
+#include <inttypes.h>
+
+#if CONFIG_ESP_MATTER_ICD_REPORT_BATCHING
+#include <app/reporting/reporting.h>
+#include <app/server/Server.h>
+#if __has_include(<app/icd/server/ICDStateObserver.h>)
+#include <app/icd/server/ICDStateObserver.h>
+#else
+#include <app/icd/ICDStateObserver.h>
+#endif
+
+namespace esp_matter {
+namespace icd_report_batching {
+
+static const char *TAG = "icd_report_batching";
+
+typedef struct {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+} held_path_t;
+
+/* Everything below is only accessed with the chip stack lock */
+static held_path_t s_held_paths[CONFIG_ESP_MATTER_ICD_REPORT_BATCHING_MAX_PATHS];
+static size_t s_held_count = 0;
+/* The ICD starts in active mode */
+static bool s_idle = false;
+
+class ReportBatchingObserver : public chip::app::ICDStateObserver {
+public:
+    void OnEnterActiveMode()
+    {
+        s_idle = false;
+        flush();
+    }
+
+    /* Reports held in the guard time before the idle mode are sent in the next active mode */
+    void OnTransitionToIdle() { s_idle = true; }
+    void OnEnterIdleMode() { s_idle = true; }
+    void OnICDModeChange() {}
+};
+
+static ReportBatchingObserver s_observer;
+
+esp_err_t init()
+{
+    chip::Server::GetInstance().GetICDManager().RegisterObserver(&s_observer);
+    return ESP_OK;
+}
+
+void flush()
+{
+    if (s_held_count == 0) {
+        return;
+    }
+    ESP_LOGD(TAG, "Reporting %u held attributes", (unsigned)s_held_count);
+    /* The reporting engine runs after the lock is released, so all the paths go out in the same reporting pass */
+    for (size_t idx = 0; idx < s_held_count; ++idx) {
+        MatterReportingAttributeChangeCallback(s_held_paths[idx].endpoint_id, s_held_paths[idx].cluster_id,
+                                               s_held_paths[idx].attribute_id);
+    }
+    s_held_count = 0;
+}
+
+bool hold(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    if (!s_idle || (attribute && (attribute::get_flags(attribute) & ATTRIBUTE_FLAG_URGENT_REPORT))) {
+        /* The urgent report wakes the radio anyway, the held ones go out with it */
+        flush();
+        return false;
+    }
+    for (size_t idx = 0; idx < s_held_count; ++idx) {
+        if (s_held_paths[idx].endpoint_id == endpoint_id && s_held_paths[idx].cluster_id == cluster_id &&
+            s_held_paths[idx].attribute_id == attribute_id) {
+            return true;
+        }
+    }
+    if (s_held_count == CONFIG_ESP_MATTER_ICD_REPORT_BATCHING_MAX_PATHS) {
+        ESP_LOGW(TAG, "Held reports full, reporting them before the active mode");
+        flush();
+        return false;
+    }
+    s_held_paths[s_held_count++] = {endpoint_id, cluster_id, attribute_id};
+    return true;
+}
+
+} // namespace icd_report_batching
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ICD_REPORT_BATCHING
@@ -0,0 +1,52 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace icd_report_batching {
+
+/**
+ * @brief Registers the ICD state observer which flushes the held reports, called after the server init.
+ *
+ * @return ESP_OK on success, error otherwise
+ */
+esp_err_t init();
+
+/**
+ * @brief Holds the report of a changed attribute while the ICD is in idle mode, called with the chip stack lock.
+ *
+ * The held paths are marked dirty together when the ICD enters the active mode, so all the reports of all the
+ * subscriptions go out in the same wake. The attributes with ATTRIBUTE_FLAG_URGENT_REPORT are never held.
+ *
+ * @param attribute    Attribute handle
+ * @param endpoint_id  Endpoint ID of the attribute
+ * @param cluster_id   Cluster ID of the attribute
+ * @param attribute_id Attribute ID
+ *
+ * @return true if the report is held, false if the caller reports it now
+ */
+bool hold(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+/**
+ * @brief Marks all the held paths dirty now, called with the chip stack lock.
+ */
+void flush();
+
+} // namespace icd_report_batching
+} // namespace esp_matter
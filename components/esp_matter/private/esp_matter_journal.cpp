@@ -0,0 +1,468 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <esp_matter_journal.h>
+#include <esp_matter_mem.h>
+#include <stddef.h>
+#include <string.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_JOURNAL
+
+namespace esp_matter {
+namespace journal {
+
+static const char *TAG = "mtr_journal";
+
+constexpr uint32_t k_magic = 0x4C4A4D45; /* "EMJL" */
+constexpr uint32_t k_version = 1;
+constexpr uint8_t k_op_store = 0x01;
+constexpr uint8_t k_op_erase = 0x02;
+constexpr size_t k_initial_entry_capacity = 16;
+
+/* The header and the records are 32 bytes, which keeps the writes aligned when the partition is encrypted */
+typedef struct region_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sequence;
+    uint8_t reserved[16];
+    uint32_t crc;
+} region_header_t;
+
+typedef struct record {
+    uint16_t endpoint_id;
+    uint8_t op;
+    uint8_t type;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint32_t reserved;
+    uint64_t value;
+    uint32_t reserved2;
+    uint32_t crc;
+} record_t;
+
+static_assert(sizeof(region_header_t) == 32, "The journal header is part of the flash format");
+static_assert(sizeof(record_t) == 32, "The journal record is part of the flash format");
+
+typedef struct entry {
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint64_t value;
+    uint16_t endpoint_id;
+    uint8_t type;
+} entry_t;
+
+static const esp_partition_t *s_partition = NULL;
+static bool s_initialized = false;
+/* Set when the partition is missing or too small, the journal is then not used until the next boot */
+static bool s_unavailable = false;
+static size_t s_region_size = 0;
+static uint8_t s_active_region = 0;
+static uint32_t s_sequence = 0;
+/* Offset of the next free record in the active region */
+static size_t s_write_offset = 0;
+
+static entry_t *s_entries = NULL;
+static size_t s_entry_count = 0;
+static size_t s_entry_capacity = 0;
+
+static inline size_t get_region_offset(uint8_t region)
+{
+    return region * s_region_size;
+}
+
+static uint32_t get_crc(const void *data, size_t crc_offset)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)data, crc_offset);
+}
+
+static bool is_erased(const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t index = 0; index < size; index++) {
+        if (bytes[index] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static entry_t *find_entry(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    for (size_t index = 0; index < s_entry_count; index++) {
+        entry_t *entry = &s_entries[index];
+        if (entry->endpoint_id == endpoint_id && entry->cluster_id == cluster_id &&
+            entry->attribute_id == attribute_id) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static esp_err_t set_entry(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, uint8_t type,
+                           uint64_t value)
+{
+    entry_t *entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (!entry) {
+        if (s_entry_count == s_entry_capacity) {
+            size_t new_capacity = s_entry_capacity ? s_entry_capacity * 2 : k_initial_entry_capacity;
+            entry_t *new_entries = (entry_t *)esp_matter_mem_realloc(s_entries, new_capacity * sizeof(entry_t));
+            if (!new_entries) {
+                ESP_LOGE(TAG, "Couldn't allocate %u journal entries", (unsigned)new_capacity);
+                return ESP_ERR_NO_MEM;
+            }
+            s_entries = new_entries;
+            s_entry_capacity = new_capacity;
+        }
+        entry = &s_entries[s_entry_count++];
+        entry->endpoint_id = endpoint_id;
+        entry->cluster_id = cluster_id;
+        entry->attribute_id = attribute_id;
+    }
+    entry->type = type;
+    entry->value = value;
+    return ESP_OK;
+}
+
+static void remove_entry(entry_t *entry)
+{
+    /* The order of the entries does not matter, move the last one in the hole */
+    *entry = s_entries[--s_entry_count];
+}
+
+static void release_entries()
+{
+    if (s_entries) {
+        esp_matter_mem_free(s_entries);
+    }
+    s_entries = NULL;
+    s_entry_count = 0;
+    s_entry_capacity = 0;
+}
+
+static bool read_header(uint8_t region, uint32_t *sequence)
+{
+    region_header_t header;
+    if (esp_partition_read(s_partition, get_region_offset(region), &header, sizeof(header)) != ESP_OK) {
+        return false;
+    }
+    if (header.magic != k_magic || header.version != k_version ||
+        header.crc != get_crc(&header, offsetof(region_header_t, crc))) {
+        return false;
+    }
+    *sequence = header.sequence;
+    return true;
+}
+
+static esp_err_t replay(uint8_t region)
+{
+    size_t offset = sizeof(region_header_t);
+    uint32_t corrupted_count = 0;
+    while (offset + sizeof(record_t) <= s_region_size) {
+        record_t record;
+        esp_err_t err = esp_partition_read(s_partition, get_region_offset(region) + offset, &record, sizeof(record));
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to read the journal at 0x%x", (unsigned)offset);
+            return err;
+        }
+        if (is_erased(&record, sizeof(record))) {
+            break;
+        }
+        offset += sizeof(record_t);
+        if (record.crc != get_crc(&record, offsetof(record_t, crc))) {
+            /* Most likely a write interrupted by a reset, the slot is skipped */
+            corrupted_count++;
+            continue;
+        }
+        if (record.op == k_op_store) {
+            err = set_entry(record.endpoint_id, record.cluster_id, record.attribute_id, record.type, record.value);
+            if (err != ESP_OK) {
+                return err;
+            }
+        } else if (record.op == k_op_erase) {
+            entry_t *entry = find_entry(record.endpoint_id, record.cluster_id, record.attribute_id);
+            if (entry) {
+                remove_entry(entry);
+            }
+        }
+    }
+    s_write_offset = offset;
+    if (corrupted_count > 0) {
+        ESP_LOGW(TAG, "Skipped %" PRIu32 " corrupted journal records", corrupted_count);
+    }
+    return ESP_OK;
+}
+
+/* Writes the live entries to the region, then its header. The region is only valid once the header is written. */
+static esp_err_t write_region(uint8_t region, uint32_t sequence)
+{
+    if (sizeof(region_header_t) + s_entry_count * sizeof(record_t) > s_region_size) {
+        ESP_LOGE(TAG, "The journal partition is too small for %u attributes", (unsigned)s_entry_count);
+        return ESP_ERR_NO_MEM;
+    }
+    size_t region_offset = get_region_offset(region);
+    esp_err_t err = esp_partition_erase_range(s_partition, region_offset, s_region_size);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to erase the journal region %u", region);
+        return err;
+    }
+    size_t offset = sizeof(region_header_t);
+    for (size_t index = 0; index < s_entry_count; index++) {
+        record_t record;
+        memset(&record, 0, sizeof(record));
+        record.endpoint_id = s_entries[index].endpoint_id;
+        record.op = k_op_store;
+        record.type = s_entries[index].type;
+        record.cluster_id = s_entries[index].cluster_id;
+        record.attribute_id = s_entries[index].attribute_id;
+        record.value = s_entries[index].value;
+        record.crc = get_crc(&record, offsetof(record_t, crc));
+        err = esp_partition_write(s_partition, region_offset + offset, &record, sizeof(record));
+        if (err != ESP_OK) {
+            return err;
+        }
+        offset += sizeof(record_t);
+    }
+    region_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = k_magic;
+    header.version = k_version;
+    header.sequence = sequence;
+    header.crc = get_crc(&header, offsetof(region_header_t, crc));
+    err = esp_partition_write(s_partition, region_offset, &header, sizeof(header));
+    if (err != ESP_OK) {
+        return err;
+    }
+    s_active_region = region;
+    s_sequence = sequence;
+    s_write_offset = offset;
+    return ESP_OK;
+}
+
+static esp_err_t compact()
+{
+    /* The current region stays valid until the header of the other one is written */
+    esp_err_t err = write_region(s_active_region ^ 1, s_sequence + 1);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to compact the journal");
+        return err;
+    }
+    ESP_LOGI(TAG, "Compacted the journal, %u live attributes", (unsigned)s_entry_count);
+    return ESP_OK;
+}
+
+static esp_err_t init()
+{
+    if (s_initialized) {
+        return ESP_OK;
+    }
+    if (s_unavailable) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    s_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                           CONFIG_ESP_MATTER_ATTRIBUTE_JOURNAL_PARTITION_LABEL);
+    if (!s_partition) {
+        ESP_LOGW(TAG, "Journal partition %s not found, the attributes are stored in NVS",
+                 CONFIG_ESP_MATTER_ATTRIBUTE_JOURNAL_PARTITION_LABEL);
+        s_unavailable = true;
+        return ESP_ERR_NOT_FOUND;
+    }
+    s_region_size = (s_partition->size / 2) & ~(s_partition->erase_size - 1);
+    if (s_region_size < s_partition->erase_size) {
+        ESP_LOGE(TAG, "Journal partition too small, it needs at least two sectors, the attributes are stored in NVS");
+        s_unavailable = true;
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    uint32_t sequences[2] = {0, 0};
+    bool valid[2] = {read_header(0, &sequences[0]), read_header(1, &sequences[1])};
+    esp_err_t err = ESP_OK;
+    if (!valid[0] && !valid[1]) {
+        err = write_region(0, 1);
+    } else {
+        s_active_region = (valid[1] && (!valid[0] || sequences[1] > sequences[0])) ? 1 : 0;
+        s_sequence = sequences[s_active_region];
+        err = replay(s_active_region);
+    }
+    if (err != ESP_OK) {
+        release_entries();
+        return err;
+    }
+    s_initialized = true;
+    ESP_LOGI(TAG, "Journal region %u replayed, %u attributes, %u bytes used", s_active_region,
+             (unsigned)s_entry_count, (unsigned)s_write_offset);
+    return ESP_OK;
+}
+
+static esp_err_t append(const record_t *record)
+{
+    if (s_write_offset + sizeof(record_t) > s_region_size) {
+        esp_err_t err = compact();
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (s_write_offset + sizeof(record_t) > s_region_size) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    esp_err_t err = esp_partition_write(s_partition, get_region_offset(s_active_region) + s_write_offset, record,
+                                        sizeof(record_t));
+    /* Don't reuse the slot even if the write failed, it might be partially written */
+    s_write_offset += sizeof(record_t);
+    return err;
+}
+
+/* Drops the attribute after a failed append. Its records still in the active region would be replayed at the next
+ * boot, over the value written elsewhere, so the live entries are compacted to the other region without it. If that
+ * fails too, the previous entry is kept, so that the value served until the next boot is the one it will restore.
+ */
+static esp_err_t invalidate(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    entry_t *entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (!entry) {
+        return ESP_OK;
+    }
+    entry_t previous = *entry;
+    remove_entry(entry);
+    if (compact() != ESP_OK) {
+        ESP_LOGE(TAG, "The journal still holds endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ","
+                      " attribute_id-0x%" PRIx32 ", its previous value is kept", endpoint_id, cluster_id, attribute_id);
+        set_entry(endpoint_id, cluster_id, attribute_id, previous.type, previous.value);
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
+
+bool is_supported(const esp_matter_attr_val_t & val)
+{
+    switch (val.type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_INVALID:
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+        return false;
+    default:
+        return true;
+    }
+}
+
+esp_err_t store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t & val)
+{
+    if (!is_supported(val)) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    esp_err_t err = init();
+    if (err != ESP_OK) {
+        return err;
+    }
+    /* The fixed size values all fit in the first 8 bytes of the union */
+    uint64_t value = 0;
+    memcpy(&value, &val.val, sizeof(value));
+    entry_t *entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (entry && entry->type == (uint8_t)val.type && entry->value == value) {
+        return ESP_OK;
+    }
+
+    record_t record;
+    memset(&record, 0, sizeof(record));
+    record.endpoint_id = endpoint_id;
+    record.op = k_op_store;
+    record.type = (uint8_t)val.type;
+    record.cluster_id = cluster_id;
+    record.attribute_id = attribute_id;
+    record.value = value;
+    record.crc = get_crc(&record, offsetof(record_t, crc));
+    err = append(&record);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to append to the journal: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ","
+                      " attribute_id-0x%" PRIx32 "", endpoint_id, cluster_id, attribute_id);
+        esp_err_t invalidate_err = invalidate(endpoint_id, cluster_id, attribute_id);
+        return invalidate_err != ESP_OK ? invalidate_err : err;
+    }
+    return set_entry(endpoint_id, cluster_id, attribute_id, record.type, value);
+}
+
+esp_err_t get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t & val)
+{
+    esp_err_t err = init();
+    if (err != ESP_OK) {
+        return err;
+    }
+    entry_t *entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (!entry) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (entry->type != (uint8_t)val.type) {
+        ESP_LOGE(TAG, "Journaled type %u does not match the attribute type %u", entry->type, val.type);
+        return ESP_ERR_INVALID_STATE;
+    }
+    memcpy(&val.val, &entry->value, sizeof(entry->value));
+    return ESP_OK;
+}
+
+esp_err_t erase(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    esp_err_t err = init();
+    if (err != ESP_OK) {
+        return err;
+    }
+    entry_t *entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (!entry) {
+        return ESP_OK;
+    }
+
+    record_t record;
+    memset(&record, 0, sizeof(record));
+    record.endpoint_id = endpoint_id;
+    record.op = k_op_erase;
+    record.cluster_id = cluster_id;
+    record.attribute_id = attribute_id;
+    record.crc = get_crc(&record, offsetof(record_t, crc));
+    err = append(&record);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to append the erase record to the journal");
+        return invalidate(endpoint_id, cluster_id, attribute_id);
+    }
+    entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (entry) {
+        remove_entry(entry);
+    }
+    return ESP_OK;
+}
+
+esp_err_t erase_all()
+{
+    release_entries();
+    s_initialized = false;
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                                CONFIG_ESP_MATTER_ATTRIBUTE_JOURNAL_PARTITION_LABEL);
+    if (!partition) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    esp_err_t err = esp_partition_erase_range(partition, 0, partition->size);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to erase the journal partition");
+    }
+    return err;
+}
+
+} // namespace journal
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_JOURNAL
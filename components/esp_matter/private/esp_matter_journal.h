@@ -0,0 +1,100 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_attribute_utils.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace journal {
+
+/*
+ * Append-only attribute journal on a raw data partition.
+ *
+ * The partition is split in two regions. The active region starts with a header holding a sequence number, followed
+ * by fixed size, CRC protected records which are appended sequentially. The latest value of each journaled attribute
+ * is kept in RAM. When the active region is full, the live values are written to the other region, which becomes
+ * the active one once its header is written. At boot, the region with the highest valid sequence number is replayed.
+ */
+
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_JOURNAL
+/**
+ * @brief Checks if the value can be stored in the journal. Only the fixed size value types are supported.
+ *
+ * @param val Attribute value
+ */
+bool is_supported(const esp_matter_attr_val_t & val);
+
+/**
+ * @brief Appends the attribute value to the journal. Nothing is written if the value is unchanged.
+ *
+ * When the append fails, the attribute is dropped from the journal, in RAM and in flash, so that the value can be
+ * stored elsewhere.
+ *
+ * @param endpoint_id  Endpoint Id
+ * @param cluster_id   Cluster Id
+ * @param attribute_id Attribute Id
+ * @param val          Attribute value
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the previous value could not be dropped from the flash and
+ * would be restored at the next boot, so the value must not be stored elsewhere, appropriate error code otherwise
+ */
+esp_err_t store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t & val);
+
+/**
+ * @brief Gets the latest attribute value from the journal.
+ *
+ * @param endpoint_id  Endpoint Id
+ * @param cluster_id   Cluster Id
+ * @param attribute_id Attribute Id
+ * @param val          Attribute value, its type must be set and match the journaled one
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the attribute is not in the journal, appropriate error code
+ * otherwise
+ */
+esp_err_t get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t & val);
+
+/**
+ * @brief Appends an erase record for the attribute, if it is in the journal. When the append fails, the journal is
+ *        compacted without the attribute.
+ *
+ * @param endpoint_id  Endpoint Id
+ * @param cluster_id   Cluster Id
+ * @param attribute_id Attribute Id
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the journal partition is not available, ESP_ERR_INVALID_STATE if
+ * the value is still in the flash and would be restored at the next boot, appropriate error code otherwise
+ */
+esp_err_t erase(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+/**
+ * @brief Erases the journal partition and drops the values kept in RAM.
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t erase_all();
+#else
+inline bool is_supported(const esp_matter_attr_val_t & val) { return false; }
+inline esp_err_t store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                       const esp_matter_attr_val_t & val) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                     esp_matter_attr_val_t & val) { return ESP_ERR_NOT_FOUND; }
+inline esp_err_t erase(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) { return ESP_OK; }
+inline esp_err_t erase_all() { return ESP_OK; }
+#endif // CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_JOURNAL
+
+} // namespace journal
+} // namespace esp_matter
@@ -0,0 +1,548 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_json_export.h>
+#include <esp_matter_mem.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_JSON_EXPORT
+
+namespace esp_matter {
+
+static const char *TAG = "json_export";
+
+namespace node {
+
+/* Levels at which the node is copied to the snapshot buffer, from the whole endpoints to the single attributes */
+typedef enum export_level {
+    EXPORT_LEVEL_ENDPOINT = 0,
+    EXPORT_LEVEL_CLUSTER,
+    EXPORT_LEVEL_ATTRIBUTE,
+} export_level_t;
+
+typedef struct export_context {
+    node_t *node;
+    json_writer_t writer;
+    void *priv_data;
+    attribute_snapshot_entry_t *snapshot;
+    size_t snapshot_size;
+    char chunk[CONFIG_ESP_MATTER_JSON_EXPORT_CHUNK_SIZE];
+    size_t chunk_length;
+    /* Objects of the endpoint and the cluster being written */
+    bool endpoint_open;
+    bool cluster_open;
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    bool first_endpoint;
+    bool first_cluster;
+    bool first_attribute;
+    uint32_t skipped;
+} export_context_t;
+
+static esp_err_t flush(export_context_t *context)
+{
+    if (context->chunk_length == 0) {
+        return ESP_OK;
+    }
+    esp_err_t err = context->writer(context->chunk, context->chunk_length, context->priv_data);
+    context->chunk_length = 0;
+    return err;
+}
+
+static esp_err_t put(export_context_t *context, const char *data, size_t size)
+{
+    while (size > 0) {
+        size_t space = sizeof(context->chunk) - context->chunk_length;
+        size_t copy_size = size < space ? size : space;
+        memcpy(context->chunk + context->chunk_length, data, copy_size);
+        context->chunk_length += copy_size;
+        data += copy_size;
+        size -= copy_size;
+        if (context->chunk_length == sizeof(context->chunk)) {
+            esp_err_t err = flush(context);
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t put_str(export_context_t *context, const char *str)
+{
+    return put(context, str, strlen(str));
+}
+
+static esp_err_t put_key(export_context_t *context, bool first, uint32_t id)
+{
+    char key[16];
+    int length = snprintf(key, sizeof(key), "%s\"%" PRIu32 "\":", first ? "" : ",", id);
+    return put(context, key, length);
+}
+
+static esp_err_t put_string(export_context_t *context, const char *str, size_t size)
+{
+    esp_err_t err = put(context, "\"", 1);
+    size_t run_start = 0;
+    for (size_t index = 0; index < size && err == ESP_OK; index++) {
+        unsigned char c = (unsigned char)str[index];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        /* Write the characters which need no escape in one go */
+        err = put(context, str + run_start, index - run_start);
+        char escape[8];
+        int length = (c == '"' || c == '\\') ? snprintf(escape, sizeof(escape), "\\%c", c)
+                                             : snprintf(escape, sizeof(escape), "\\u%04x", c);
+        if (err == ESP_OK) {
+            err = put(context, escape, length);
+        }
+        run_start = index + 1;
+    }
+    if (err == ESP_OK) {
+        err = put(context, str + run_start, size - run_start);
+    }
+    return err == ESP_OK ? put(context, "\"", 1) : err;
+}
+
+static esp_err_t put_hex(export_context_t *context, const uint8_t *data, size_t size)
+{
+    static const char k_digits[] = "0123456789abcdef";
+    esp_err_t err = put(context, "\"", 1);
+    char hex[64];
+    size_t length = 0;
+    for (size_t index = 0; index < size && err == ESP_OK; index++) {
+        hex[length++] = k_digits[data[index] >> 4];
+        hex[length++] = k_digits[data[index] & 0xF];
+        if (length == sizeof(hex)) {
+            err = put(context, hex, length);
+            length = 0;
+        }
+    }
+    if (err == ESP_OK) {
+        err = put(context, hex, length);
+    }
+    return err == ESP_OK ? put(context, "\"", 1) : err;
+}
+
+static esp_err_t put_value(export_context_t *context, esp_matter_attr_val_t *val)
+{
+    if (attribute::val_is_null(val)) {
+        return put_str(context, "null");
+    }
+    char number[32];
+    int length = 0;
+    switch (val->type) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BOOLEAN:
+        return put_str(context, val->val.b ? "true" : "false");
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INTEGER:
+        length = snprintf(number, sizeof(number), "%d", val->val.i);
+        break;
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_FLOAT:
+        if (!isfinite(val->val.f)) {
+            return put_str(context, "null");
+        }
+        length = snprintf(number, sizeof(number), "%.9g", (double)val->val.f);
+        break;
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT8:
+        length = snprintf(number, sizeof(number), "%" PRIi8, val->val.i8);
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP8:
+        length = snprintf(number, sizeof(number), "%" PRIu8, val->val.u8);
+        break;
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT16:
+        length = snprintf(number, sizeof(number), "%" PRIi16, val->val.i16);
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP16:
+        length = snprintf(number, sizeof(number), "%" PRIu16, val->val.u16);
+        break;
+    case ESP_MATTER_VAL_TYPE_INT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT32:
+        length = snprintf(number, sizeof(number), "%" PRIi32, val->val.i32);
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP32:
+        length = snprintf(number, sizeof(number), "%" PRIu32, val->val.u32);
+        break;
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT64:
+        length = snprintf(number, sizeof(number), "%" PRIi64, val->val.i64);
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT64:
+        length = snprintf(number, sizeof(number), "%" PRIu64, val->val.u64);
+        break;
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+        return put_string(context, (const char *)val->val.a.b, val->val.a.b ? val->val.a.s : 0);
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+        return put_hex(context, val->val.a.b, val->val.a.b ? val->val.a.s : 0);
+    default:
+        return put_str(context, "null");
+    }
+    return put(context, number, length);
+}
+
+static esp_err_t put_entry(export_context_t *context, attribute_snapshot_entry_t *entry)
+{
+    esp_err_t err = ESP_OK;
+    if (context->endpoint_open && entry->endpoint_id != context->endpoint_id) {
+        err = put_str(context, context->cluster_open ? "}}" : "}");
+        context->endpoint_open = false;
+        context->cluster_open = false;
+    }
+    if (err == ESP_OK && !context->endpoint_open) {
+        err = put_key(context, context->first_endpoint, entry->endpoint_id);
+        if (err == ESP_OK) {
+            err = put(context, "{", 1);
+        }
+        context->endpoint_open = true;
+        context->endpoint_id = entry->endpoint_id;
+        context->first_endpoint = false;
+        context->first_cluster = true;
+    }
+    if (err == ESP_OK && context->cluster_open && entry->cluster_id != context->cluster_id) {
+        err = put(context, "}", 1);
+        context->cluster_open = false;
+    }
+    if (err == ESP_OK && !context->cluster_open) {
+        err = put_key(context, context->first_cluster, entry->cluster_id);
+        if (err == ESP_OK) {
+            err = put(context, "{", 1);
+        }
+        context->cluster_open = true;
+        context->cluster_id = entry->cluster_id;
+        context->first_cluster = false;
+        context->first_attribute = true;
+    }
+    if (err == ESP_OK) {
+        err = put_key(context, context->first_attribute, entry->attribute_id);
+        context->first_attribute = false;
+    }
+    return err == ESP_OK ? put_value(context, &entry->val) : err;
+}
+
+static bool check_id(uint32_t filter_id, uint32_t invalid_id, uint32_t id)
+{
+    return filter_id == invalid_id || filter_id == id;
+}
+
+/* Smallest ID above `after` at the level: the endpoints of the node, the clusters of the endpoint of the filter, or
+ * the attributes of its cluster. The node is walked again for every ID, so that the endpoints added or removed during
+ * the export do not break the iteration.
+ */
+static bool get_next_id(node_t *node, const attribute_filter_t *filter, export_level_t level, int64_t after,
+                        uint32_t *next_id)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return false;
+    }
+    bool found = false;
+    for (endpoint_t *endpoint = endpoint::get_first(node); endpoint; endpoint = endpoint::get_next(endpoint)) {
+        uint32_t id = endpoint::get_id(endpoint);
+        if (!check_id(filter->endpoint_id, chip::kInvalidEndpointId, id)) {
+            continue;
+        }
+        if (level == EXPORT_LEVEL_ENDPOINT) {
+            if ((int64_t)id > after && (!found || id < *next_id)) {
+                *next_id = id;
+                found = true;
+            }
+            continue;
+        }
+        for (cluster_t *cluster = cluster::get_first(endpoint); cluster; cluster = cluster::get_next(cluster)) {
+            id = cluster::get_id(cluster);
+            if (!check_id(filter->cluster_id, chip::kInvalidClusterId, id)) {
+                continue;
+            }
+            if (level == EXPORT_LEVEL_CLUSTER) {
+                if ((int64_t)id > after && (!found || id < *next_id)) {
+                    *next_id = id;
+                    found = true;
+                }
+                continue;
+            }
+            for (attribute_t *attribute = attribute::get_first(cluster); attribute;
+                 attribute = attribute::get_next(attribute)) {
+                id = attribute::get_id(attribute);
+                if (check_id(filter->attribute_id, chip::kInvalidAttributeId, id) && (int64_t)id > after &&
+                    (!found || id < *next_id)) {
+                    *next_id = id;
+                    found = true;
+                }
+            }
+        }
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return found;
+}
+
+static esp_err_t export_level(export_context_t *context, const attribute_filter_t *filter, export_level_t level);
+
+static esp_err_t export_snapshot(export_context_t *context, const attribute_filter_t *filter, export_level_t level)
+{
+    attribute_snapshot_entry_t *entries = NULL;
+    size_t count = 0;
+    esp_err_t err = snapshot_attributes(context->node, filter, context->snapshot, context->snapshot_size, &entries,
+                                        &count, NULL);
+    if (err == ESP_OK) {
+        for (size_t index = 0; index < count && err == ESP_OK; index++) {
+            err = put_entry(context, &entries[index]);
+        }
+        return err;
+    }
+    if (err != ESP_ERR_INVALID_SIZE) {
+        return err;
+    }
+    if (level < EXPORT_LEVEL_ATTRIBUTE) {
+        return export_level(context, filter, (export_level_t)(level + 1));
+    }
+    ESP_LOGW(TAG, "Attribute 0x%08" PRIX32 " of cluster 0x%08" PRIX32 " on endpoint 0x%04" PRIX16
+             " does not fit in the snapshot buffer", filter->attribute_id, filter->cluster_id, filter->endpoint_id);
+    context->skipped++;
+    attribute_snapshot_entry_t entry = {
+        .endpoint_id = filter->endpoint_id,
+        .cluster_id = filter->cluster_id,
+        .attribute_id = filter->attribute_id,
+        .val = esp_matter_invalid(NULL),
+    };
+    return put_entry(context, &entry);
+}
+
+/* Copy the node one ID of the level at a time, in the order of the IDs */
+static esp_err_t export_level(export_context_t *context, const attribute_filter_t *filter, export_level_t level)
+{
+    uint32_t id = 0;
+    for (int64_t after = -1; get_next_id(context->node, filter, level, after, &id); after = id) {
+        attribute_filter_t narrowed = *filter;
+        if (level == EXPORT_LEVEL_ENDPOINT) {
+            narrowed.endpoint_id = id;
+        } else if (level == EXPORT_LEVEL_CLUSTER) {
+            narrowed.cluster_id = id;
+        } else {
+            narrowed.attribute_id = id;
+        }
+        esp_err_t err = export_snapshot(context, &narrowed, level);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t export_json(node_t *node, const attribute_filter_t *filter, json_writer_t writer, void *priv_data)
+{
+    if (!node || !writer) {
+        ESP_LOGE(TAG, "Node or writer cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    export_context_t *context = (export_context_t *)esp_matter_mem_calloc(1, sizeof(export_context_t));
+    size_t entry_count = CONFIG_ESP_MATTER_JSON_EXPORT_SNAPSHOT_SIZE / sizeof(attribute_snapshot_entry_t);
+    attribute_snapshot_entry_t *snapshot =
+        (attribute_snapshot_entry_t *)esp_matter_mem_calloc(entry_count, sizeof(attribute_snapshot_entry_t));
+    if (!context || !snapshot) {
+        ESP_LOGE(TAG, "Could not allocate the JSON export buffers");
+        esp_matter_mem_free(context);
+        esp_matter_mem_free(snapshot);
+        return ESP_ERR_NO_MEM;
+    }
+    context->node = node;
+    context->writer = writer;
+    context->priv_data = priv_data;
+    context->snapshot = snapshot;
+    context->snapshot_size = entry_count * sizeof(attribute_snapshot_entry_t);
+    context->first_endpoint = true;
+
+    attribute_filter_t all = {
+        .endpoint_id = chip::kInvalidEndpointId,
+        .cluster_id = chip::kInvalidClusterId,
+        .attribute_id = chip::kInvalidAttributeId,
+    };
+    esp_err_t err = put(context, "{", 1);
+    if (err == ESP_OK) {
+        err = export_level(context, filter ? filter : &all, EXPORT_LEVEL_ENDPOINT);
+    }
+    if (err == ESP_OK && context->endpoint_open) {
+        err = put_str(context, context->cluster_open ? "}}" : "}");
+    }
+    if (err == ESP_OK) {
+        err = put(context, "}", 1);
+    }
+    if (err == ESP_OK) {
+        err = flush(context);
+    }
+    if (context->skipped > 0) {
+        ESP_LOGW(TAG, "%" PRIu32 " attributes written as null, increase CONFIG_ESP_MATTER_JSON_EXPORT_SNAPSHOT_SIZE",
+                 context->skipped);
+    }
+    esp_matter_mem_free(snapshot);
+    esp_matter_mem_free(context);
+    return err;
+}
+
+} // namespace node
+
+namespace json_export {
+
+#if CONFIG_ENABLE_CHIP_SHELL
+typedef struct console_sink {
+    FILE *file;
+    size_t size;
+} console_sink_t;
+
+static esp_err_t console_writer(const char *data, size_t size, void *priv_data)
+{
+    console_sink_t *sink = (console_sink_t *)priv_data;
+    if (fwrite(data, 1, size, sink->file) != size) {
+        ESP_LOGE(TAG, "Could not write the JSON export");
+        return ESP_FAIL;
+    }
+    sink->size += size;
+    return ESP_OK;
+}
+
+/* Arguments: [<endpoint_id> [<cluster_id>]] */
+static esp_err_t console_export(FILE *file, int argc, char **argv)
+{
+    node::attribute_filter_t filter = {
+        .endpoint_id = argc > 0 ? (uint16_t)strtoul(argv[0], NULL, 0) : chip::kInvalidEndpointId,
+        .cluster_id = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : chip::kInvalidClusterId,
+        .attribute_id = chip::kInvalidAttributeId,
+    };
+    console_sink_t sink = {
+        .file = file,
+        .size = 0,
+    };
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t err = node::export_json(node::get(), &filter, console_writer, &sink);
+    int64_t duration_us = esp_timer_get_time() - start_us;
+    if (file == stdout) {
+        printf("\n");
+    }
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Exported %u bytes in %" PRId64 " us", (unsigned)sink.size, duration_us);
+    }
+    return err;
+}
+
+static esp_err_t console_console_handler(int argc, char **argv)
+{
+    return console_export(stdout, argc, argv);
+}
+
+static esp_err_t console_file_handler(int argc, char **argv)
+{
+    if (argc < 1) {
+        ESP_LOGE(TAG, "The arguments for this command is invalid");
+        return ESP_ERR_INVALID_ARG;
+    }
+    FILE *file = fopen(argv[0], "w");
+    if (!file) {
+        ESP_LOGE(TAG, "Could not open %s", argv[0]);
+        return ESP_FAIL;
+    }
+    esp_err_t err = console_export(file, argc - 1, argv + 1);
+    if (fclose(file) != 0 && err == ESP_OK) {
+        ESP_LOGE(TAG, "Could not write %s", argv[0]);
+        err = ESP_FAIL;
+    }
+    return err;
+}
+
+static esp_matter::console::engine json_export_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        json_export_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return json_export_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "json_export",
+        .description = "Export the attributes of the node as JSON. Usage: matter esp json_export <console|file>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t json_export_commands[] = {
+        {
+            .name = "console",
+            .description = "Write the attributes to the console. "
+                           "Usage: matter esp json_export console [<endpoint_id> [<cluster_id>]]. "
+                           "Example: matter esp json_export console 0x0001.",
+            .handler = console_console_handler,
+        },
+        {
+            .name = "file",
+            .description = "Write the attributes to a file of a mounted file system. "
+                           "Usage: matter esp json_export file <path> [<endpoint_id> [<cluster_id>]]. "
+                           "Example: matter esp json_export file /spiffs/node.json.",
+            .handler = console_file_handler,
+        },
+    };
+    json_export_console.register_commands(json_export_commands,
+                                          sizeof(json_export_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace json_export
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_JSON_EXPORT
@@ -0,0 +1,33 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+namespace esp_matter {
+namespace json_export {
+
+#if CONFIG_ESP_MATTER_ENABLE_JSON_EXPORT
+/**
+ * @brief Registers the JSON export console commands.
+ */
+void register_console_commands();
+#else
+inline void register_console_commands() {}
+#endif // CONFIG_ESP_MATTER_ENABLE_JSON_EXPORT
+
+} // namespace json_export
+} // namespace esp_matter
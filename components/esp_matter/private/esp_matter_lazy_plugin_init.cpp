@@ -0,0 +1,153 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_lazy_plugin_init.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_LAZY_PLUGIN_INIT
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <platform/CHIPDeviceLayer.h>
+
+using namespace chip::app::Clusters;
+
+namespace esp_matter {
+namespace lazy_plugin_init {
+
+static const char *TAG = "lazy_plugin_init";
+
+/*
+ * The plugin server inits of the clusters which are not needed to be commissioned and reached are deferred past the
+ * server init, so the node advertises sooner. A deferred init runs before the first command, attribute read or write
+ * of its cluster reaching esp_matter, when a commissioning session starts, or once the
+ * ESP_MATTER_LAZY_PLUGIN_INIT_DELAY_MS idle period after the server init has elapsed, one cluster per pass of the
+ * Matter task. The init callbacks are called once per cluster, the callbacks of the same cluster on several
+ * endpoints are the same and deferred once.
+ */
+
+/* Clusters whose plugin init is never deferred, used by the commissioning and the session establishment */
+static const uint32_t k_eager_clusters[] = {
+    Descriptor::Id,
+    AccessControl::Id,
+    BasicInformation::Id,
+    GeneralCommissioning::Id,
+    NetworkCommissioning::Id,
+    AdministratorCommissioning::Id,
+    OperationalCredentials::Id,
+    GroupKeyManagement::Id,
+};
+
+typedef struct {
+    uint32_t cluster_id;
+    cluster::plugin_server_init_callback_t callback;
+} deferred_t;
+
+static deferred_t s_deferred[CONFIG_ESP_MATTER_LAZY_PLUGIN_INIT_MAX_CLUSTERS];
+static size_t s_count = 0;
+static int64_t s_start_us = 0;
+
+static bool is_eager(uint32_t cluster_id)
+{
+    for (size_t i = 0; i < sizeof(k_eager_clusters) / sizeof(k_eager_clusters[0]); ++i) {
+        if (k_eager_clusters[i] == cluster_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool defer(uint32_t cluster_id, cluster::plugin_server_init_callback_t callback)
+{
+    if (is_eager(cluster_id)) {
+        return false;
+    }
+    for (size_t i = 0; i < s_count; ++i) {
+        if (s_deferred[i].callback == callback) {
+            return true;
+        }
+    }
+    if (s_count >= CONFIG_ESP_MATTER_LAZY_PLUGIN_INIT_MAX_CLUSTERS) {
+        return false;
+    }
+    s_deferred[s_count++] = {cluster_id, callback};
+    return true;
+}
+
+/* Removes the entry before calling it, the callback may reach the data model of its cluster */
+static void run(size_t index)
+{
+    deferred_t deferred = s_deferred[index];
+    s_deferred[index] = s_deferred[--s_count];
+    int64_t start_us = esp_timer_get_time();
+    deferred.callback();
+    ESP_LOGD(TAG, "Plugin init of cluster 0x%08" PRIX32 " in %lld us", deferred.cluster_id,
+             (long long)(esp_timer_get_time() - start_us));
+    if (s_count == 0) {
+        ESP_LOGI(TAG, "Deferred plugin inits done, %lld ms after the server init",
+                 (long long)((esp_timer_get_time() - s_start_us) / 1000));
+    }
+}
+
+static void run_next(intptr_t arg)
+{
+    if (s_count == 0) {
+        return;
+    }
+    run(s_count - 1);
+    if (s_count > 0) {
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(run_next, 0);
+    }
+}
+
+static void on_idle_timer(chip::System::Layer *layer, void *ctx)
+{
+    run_next(0);
+}
+
+void start()
+{
+    s_start_us = esp_timer_get_time();
+    if (s_count == 0) {
+        return;
+    }
+    ESP_LOGI(TAG, "%u plugin inits deferred", (unsigned)s_count);
+    if (chip::DeviceLayer::SystemLayer().StartTimer(
+            chip::System::Clock::Milliseconds32(CONFIG_ESP_MATTER_LAZY_PLUGIN_INIT_DELAY_MS), on_idle_timer, nullptr) !=
+        CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the timer, running the deferred plugin inits");
+        run_all();
+    }
+}
+
+void on_access(uint32_t cluster_id)
+{
+    for (size_t i = s_count; i > 0; --i) {
+        if (s_deferred[i - 1].cluster_id == cluster_id) {
+            run(i - 1);
+        }
+    }
+}
+
+void run_all()
+{
+    chip::DeviceLayer::SystemLayer().CancelTimer(on_idle_timer, nullptr);
+    while (s_count > 0) {
+        run(s_count - 1);
+    }
+}
+
+} // namespace lazy_plugin_init
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_LAZY_PLUGIN_INIT
@@ -0,0 +1,63 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+namespace esp_matter {
+namespace lazy_plugin_init {
+
+#if CONFIG_ESP_MATTER_ENABLE_LAZY_PLUGIN_INIT
+/**
+ * @brief Defers the plugin server init of a cluster, called by the plugin init at the server init.
+ *
+ * The plugin server inits of the clusters needed for the commissioning and the access control always run at the
+ * server init, as well as the other ones once the deferred list is full.
+ *
+ * @param cluster_id Cluster id
+ * @param callback   Plugin server init callback of the cluster
+ *
+ * @return true if the init is deferred, false if it must run now
+ */
+bool defer(uint32_t cluster_id, cluster::plugin_server_init_callback_t callback);
+
+/**
+ * @brief Starts the timer running the deferred inits, called at the end of the plugin init.
+ */
+void start();
+
+/**
+ * @brief Runs the deferred init of a cluster before reaching it, called with the Matter stack lock held.
+ *
+ * @param cluster_id Cluster id
+ */
+void on_access(uint32_t cluster_id);
+
+/**
+ * @brief Runs all the deferred inits, called when a commissioning session starts.
+ */
+void run_all();
+#else
+inline bool defer(uint32_t cluster_id, cluster::plugin_server_init_callback_t callback)
+{
+    return false;
+}
+inline void start() {}
+inline void on_access(uint32_t cluster_id) {}
+inline void run_all() {}
+#endif // CONFIG_ESP_MATTER_ENABLE_LAZY_PLUGIN_INIT
+
+} // namespace lazy_plugin_init
+} // namespace esp_matter
@@ -0,0 +1,792 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <esp_matter_attribute_utils.h>
+#include <esp_matter_core.h>
+#include <esp_matter_load_gen.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <nvs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <app/ConcreteCommandPath.h>
+#include <json_to_tlv.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_LOAD_GEN
+
+using chip::app::ConcreteCommandPath;
+using chip::TLV::TLVReader;
+using chip::TLV::TLVWriter;
+
+namespace esp_matter {
+namespace command {
+/* Defined in esp_matter_command.cpp, the simulated invokes enter the data model at the same place as the received ones */
+void DispatchSingleClusterCommandCommon(const ConcreteCommandPath &command_path, TLVReader &tlv_data, void *opaque_ptr);
+} // namespace command
+
+namespace load_gen {
+
+static const char *TAG = "esp_matter_load_gen";
+static const char *k_nvs_namespace = "mtr_loadgen";
+
+static constexpr size_t k_max_endpoints = 8;
+static constexpr size_t k_max_fields_size = 128;
+static constexpr uint32_t k_max_rate = 1000;
+static constexpr uint32_t k_max_nvs_size = 4000;
+static constexpr uint32_t k_max_nvs_keys = 16;
+static constexpr uint32_t k_tick_ms = 10;
+/* Log-linear latency histogram: 1 us buckets up to 16 us, then 4 buckets per power of two up to 2^24 us */
+static constexpr size_t k_linear_buckets = 16;
+static constexpr size_t k_bucket_count = k_linear_buckets + 4 * 20;
+
+typedef enum {
+    GENERATOR_UPDATE,
+    GENERATOR_REPORT,
+    GENERATOR_INVOKE,
+    GENERATOR_NVS,
+} generator_type_t;
+
+static const char *k_type_names[] = {"update", "report", "invoke", "nvs"};
+
+typedef struct {
+    uint32_t ops;
+    uint32_t failures;
+    /* Operations not issued because the generator was more than one second behind its rate */
+    uint32_t dropped;
+    uint32_t max_us;
+    uint32_t histogram[k_bucket_count];
+} latency_stats_t;
+
+typedef struct {
+    generator_type_t type;
+    uint32_t rate;
+    uint16_t endpoints[k_max_endpoints];
+    uint8_t endpoint_count;
+    uint8_t next_endpoint;
+    uint32_t cluster_id;
+    /* Attribute id of the update and report generators, command id of the invoke generator */
+    uint32_t id;
+    /* Value toggled by the update and report generators */
+    esp_matter_attr_val_t value;
+    /* Command fields of the invoke generator, blob of the nvs generator */
+    uint8_t *payload;
+    uint32_t payload_len;
+    uint32_t key_count;
+    uint32_t next_key;
+    /* Operations due since the start of the run */
+    uint64_t issued;
+    latency_stats_t stats;
+} generator_t;
+
+typedef struct {
+    int64_t timestamp_us;
+    uint32_t lock_count;
+    /* Acquisitions which waited 100 us or more */
+    uint32_t lock_contended;
+} lock_snapshot_t;
+
+static generator_t s_generators[CONFIG_ESP_MATTER_LOAD_GEN_MAX_GENERATORS];
+static size_t s_generator_count = 0;
+/* Wait for the Matter stack lock measured around the operations of the generators */
+static latency_stats_t s_lock_wait;
+static portMUX_TYPE s_stats_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static TaskHandle_t s_task = NULL;
+static volatile bool s_stop_requested = false;
+static int64_t s_start_us = 0;
+static int64_t s_end_us = 0;
+static uint32_t s_duration_ms = 0;
+static uint32_t s_print_interval_ms = 0;
+static size_t s_heap_at_start = 0;
+static size_t s_heap_lowest = 0;
+static lock_snapshot_t s_lock_at_start;
+static nvs_handle_t s_nvs_handle = 0;
+
+static size_t bucket_index(uint32_t us)
+{
+    if (us < k_linear_buckets) {
+        return us;
+    }
+    uint32_t octave = 31 - __builtin_clz(us);
+    size_t index = k_linear_buckets + (octave - 4) * 4 + ((us >> (octave - 2)) & 3);
+    return index < k_bucket_count ? index : k_bucket_count - 1;
+}
+
+/* Upper bound of the latencies counted in a bucket */
+static uint32_t bucket_upper_us(size_t index)
+{
+    if (index < k_linear_buckets) {
+        return index;
+    }
+    uint32_t octave = (index - k_linear_buckets) / 4 + 4;
+    uint32_t sub = (index - k_linear_buckets) % 4;
+    return (1u << octave) + ((sub + 1) << (octave - 2)) - 1;
+}
+
+static void record(latency_stats_t *stats, uint32_t us, bool failed)
+{
+    portENTER_CRITICAL(&s_stats_mux);
+    stats->ops++;
+    if (failed) {
+        stats->failures++;
+    }
+    if (us > stats->max_us) {
+        stats->max_us = us;
+    }
+    stats->histogram[bucket_index(us)]++;
+    portEXIT_CRITICAL(&s_stats_mux);
+}
+
+static uint32_t percentile_us(const latency_stats_t *stats, uint32_t percent)
+{
+    if (stats->ops == 0) {
+        return 0;
+    }
+    uint64_t target = ((uint64_t)stats->ops * percent + 99) / 100;
+    uint64_t cumulative = 0;
+    for (size_t index = 0; index < k_bucket_count; index++) {
+        cumulative += stats->histogram[index];
+        if (cumulative >= target) {
+            uint32_t upper = bucket_upper_us(index);
+            return upper < stats->max_us ? upper : stats->max_us;
+        }
+    }
+    return stats->max_us;
+}
+
+static void take_lock_snapshot(lock_snapshot_t *snapshot)
+{
+    memset(snapshot, 0, sizeof(lock_snapshot_t));
+    snapshot->timestamp_us = esp_timer_get_time();
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+    static lock::caller_stats_t callers[LOCK_STATS_MAX_CALLERS];
+    size_t caller_count = LOCK_STATS_MAX_CALLERS;
+    if (lock::get_stats(callers, &caller_count) == ESP_OK) {
+        for (size_t index = 0; index < caller_count; index++) {
+            snapshot->lock_count += callers[index].count;
+            for (int bucket = 2; bucket < LOCK_STATS_BUCKET_COUNT; bucket++) {
+                snapshot->lock_contended += callers[index].wait_histogram[bucket];
+            }
+        }
+    }
+#endif
+}
+
+static bool toggle_value(esp_matter_attr_val_t *value)
+{
+    switch (value->type) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BOOLEAN:
+        value->val.b = !value->val.b;
+        return true;
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_FLOAT:
+        value->val.f = value->val.f == 0.0f ? 1.0f : 0.0f;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INTEGER:
+        value->val.i ^= 1;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT8:
+        value->val.i8 ^= 1;
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP8:
+        value->val.u8 ^= 1;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT16:
+        value->val.i16 ^= 1;
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP16:
+        value->val.u16 ^= 1;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT32:
+        value->val.i32 ^= 1;
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP32:
+        value->val.u32 ^= 1;
+        return true;
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT64:
+        value->val.i64 ^= 1;
+        return true;
+    case ESP_MATTER_VAL_TYPE_UINT64:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT64:
+        value->val.u64 ^= 1;
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool run_attribute_op(generator_t *generator)
+{
+    uint16_t endpoint_id = generator->endpoints[generator->next_endpoint];
+    generator->next_endpoint = (generator->next_endpoint + 1) % generator->endpoint_count;
+    toggle_value(&generator->value);
+    esp_matter_attr_val_t value = generator->value;
+    esp_err_t err;
+    if (generator->type == GENERATOR_UPDATE) {
+        err = attribute::update(endpoint_id, generator->cluster_id, generator->id, &value);
+    } else {
+        err = attribute::report(endpoint_id, generator->cluster_id, generator->id, &value);
+    }
+    return err == ESP_OK;
+}
+
+static bool run_invoke_op(generator_t *generator)
+{
+    static const uint8_t k_empty_struct[] = {0x15, 0x18};
+    TLVReader reader;
+    if (generator->payload) {
+        reader.Init(generator->payload, generator->payload_len);
+    } else {
+        reader.Init(k_empty_struct, sizeof(k_empty_struct));
+    }
+    if (reader.Next() != CHIP_NO_ERROR) {
+        return false;
+    }
+    ConcreteCommandPath path(generator->endpoints[0], generator->cluster_id, generator->id);
+    command::DispatchSingleClusterCommandCommon(path, reader, nullptr);
+    return true;
+}
+
+static bool run_nvs_op(generator_t *generator)
+{
+    char key[8];
+    snprintf(key, sizeof(key), "k%" PRIu32, generator->next_key);
+    generator->next_key = (generator->next_key + 1) % generator->key_count;
+    /* Change the blob so that each write is a new entry of the page, as the writes of real values */
+    generator->payload[0]++;
+    if (nvs_set_blob(s_nvs_handle, key, generator->payload, generator->payload_len) != ESP_OK) {
+        return false;
+    }
+    return nvs_commit(s_nvs_handle) == ESP_OK;
+}
+
+static void run_op(generator_t *generator)
+{
+    int64_t start_us = esp_timer_get_time();
+    bool ok;
+    if (generator->type == GENERATOR_NVS) {
+        ok = run_nvs_op(generator);
+    } else {
+        /* The lock is taken here to measure its wait, attribute::update() and report() find it already taken */
+        lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+        if (lock_status == lock::FAILED) {
+            record(&generator->stats, 0, true);
+            return;
+        }
+        record(&s_lock_wait, (uint32_t)(esp_timer_get_time() - start_us), false);
+        ok = generator->type == GENERATOR_INVOKE ? run_invoke_op(generator) : run_attribute_op(generator);
+        if (lock_status == lock::SUCCESS) {
+            lock::chip_stack_unlock();
+        }
+    }
+    record(&generator->stats, (uint32_t)(esp_timer_get_time() - start_us), !ok);
+}
+
+static void print_generator(size_t index, const generator_t *generator, int64_t elapsed_us)
+{
+    printf("\t%u: %-6s ", (unsigned)index, k_type_names[generator->type]);
+    if (generator->type == GENERATOR_NVS) {
+        printf("%" PRIu32 " bytes over %" PRIu32 " keys", generator->payload_len, generator->key_count);
+    } else {
+        printf("cluster 0x%08" PRIX32 " %s 0x%08" PRIX32 " endpoints", generator->cluster_id,
+               generator->type == GENERATOR_INVOKE ? "command" : "attribute", generator->id);
+        for (size_t endpoint = 0; endpoint < generator->endpoint_count; endpoint++) {
+            printf("%s%u", endpoint == 0 ? " " : ",", generator->endpoints[endpoint]);
+        }
+    }
+    printf(", target %" PRIu32 "/s\n", generator->rate);
+    if (elapsed_us <= 0) {
+        return;
+    }
+    latency_stats_t stats;
+    portENTER_CRITICAL(&s_stats_mux);
+    stats = generator->stats;
+    portEXIT_CRITICAL(&s_stats_mux);
+    printf("\t   achieved %" PRIu64 "/s, %" PRIu32 " ops, %" PRIu32 " failed, %" PRIu32 " dropped, latency p50 %" PRIu32
+           " us, p90 %" PRIu32 " us, p99 %" PRIu32 " us, max %" PRIu32 " us\n",
+           (uint64_t)stats.ops * 1000000 / elapsed_us, stats.ops, stats.failures, stats.dropped,
+           percentile_us(&stats, 50), percentile_us(&stats, 90), percentile_us(&stats, 99), stats.max_us);
+}
+
+static void print_report()
+{
+    int64_t now_us = s_task ? esp_timer_get_time() : s_end_us;
+    int64_t elapsed_us = s_start_us ? now_us - s_start_us : 0;
+    if (s_task) {
+        printf("Load generator running for %" PRIi64 " ms:\n", elapsed_us / 1000);
+    } else if (elapsed_us > 0) {
+        printf("Load generator stopped, ran for %" PRIi64 " ms:\n", elapsed_us / 1000);
+    } else {
+        printf("Load generator not started:\n");
+    }
+    for (size_t index = 0; index < s_generator_count; index++) {
+        print_generator(index, &s_generators[index], elapsed_us);
+    }
+    if (elapsed_us <= 0) {
+        return;
+    }
+    latency_stats_t lock_wait;
+    portENTER_CRITICAL(&s_stats_mux);
+    lock_wait = s_lock_wait;
+    portEXIT_CRITICAL(&s_stats_mux);
+    printf("\tlock wait of the generators: p50 %" PRIu32 " us, p99 %" PRIu32 " us, max %" PRIu32 " us\n",
+           percentile_us(&lock_wait, 50), percentile_us(&lock_wait, 99), lock_wait.max_us);
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+    lock_snapshot_t current;
+    take_lock_snapshot(&current);
+    uint32_t lock_delta = current.lock_count - s_lock_at_start.lock_count;
+    printf("\tlock acquisitions of all the tasks: %" PRIu32 " (%" PRIu64 "/s), %" PRIu32 " waited >= 100 us\n",
+           lock_delta, (uint64_t)lock_delta * 1000000 / elapsed_us,
+           current.lock_contended - s_lock_at_start.lock_contended);
+#endif
+    size_t heap_free = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    printf("\theap: free %u, drift %+d since the start, lowest %u\n", (unsigned)heap_free,
+           (int)heap_free - (int)s_heap_at_start, (unsigned)s_heap_lowest);
+}
+
+static void load_task(void *arg)
+{
+    int64_t next_print_us = s_start_us + (int64_t)s_print_interval_ms * 1000;
+    while (!s_stop_requested) {
+        int64_t now_us = esp_timer_get_time();
+        if (s_duration_ms && now_us - s_start_us >= (int64_t)s_duration_ms * 1000) {
+            break;
+        }
+        for (size_t index = 0; index < s_generator_count && !s_stop_requested; index++) {
+            generator_t *generator = &s_generators[index];
+            uint64_t due = (uint64_t)(now_us - s_start_us) * generator->rate / 1000000;
+            if (due - generator->issued > generator->rate) {
+                /* More than one second behind, the target rate is not reachable: drop the backlog */
+                uint32_t dropped = (uint32_t)(due - generator->issued - generator->rate);
+                portENTER_CRITICAL(&s_stats_mux);
+                generator->stats.dropped += dropped;
+                portEXIT_CRITICAL(&s_stats_mux);
+                generator->issued += dropped;
+            }
+            while (generator->issued < due && !s_stop_requested) {
+                run_op(generator);
+                generator->issued++;
+            }
+        }
+        size_t heap_free = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        if (heap_free < s_heap_lowest) {
+            s_heap_lowest = heap_free;
+        }
+        if (s_print_interval_ms && esp_timer_get_time() >= next_print_us) {
+            print_report();
+            next_print_us += (int64_t)s_print_interval_ms * 1000;
+        }
+        vTaskDelay(pdMS_TO_TICKS(k_tick_ms) ? pdMS_TO_TICKS(k_tick_ms) : 1);
+    }
+    s_end_us = esp_timer_get_time();
+    s_task = NULL;
+    print_report();
+    vTaskDelete(NULL);
+}
+
+static void free_generators()
+{
+    for (size_t index = 0; index < s_generator_count; index++) {
+        free(s_generators[index].payload);
+    }
+    memset(s_generators, 0, sizeof(s_generators));
+    s_generator_count = 0;
+    if (s_nvs_handle) {
+        nvs_erase_all(s_nvs_handle);
+        nvs_commit(s_nvs_handle);
+        nvs_close(s_nvs_handle);
+        s_nvs_handle = 0;
+    }
+    s_start_us = 0;
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static attribute_t *get_attribute(endpoint_t *endpoint, uint32_t cluster_id, uint32_t attribute_id)
+{
+    cluster_t *cluster = endpoint ? cluster::get(endpoint, cluster_id) : NULL;
+    return cluster ? attribute::get(cluster, attribute_id) : NULL;
+}
+
+static generator_t *new_generator(generator_type_t type, const char *rate_arg)
+{
+    if (s_task) {
+        printf("Stop the load generator first\n");
+        return NULL;
+    }
+    if (s_generator_count >= CONFIG_ESP_MATTER_LOAD_GEN_MAX_GENERATORS) {
+        printf("No more than %d generators\n", CONFIG_ESP_MATTER_LOAD_GEN_MAX_GENERATORS);
+        return NULL;
+    }
+    uint32_t rate = strtoul(rate_arg, NULL, 0);
+    if (rate == 0 || rate > k_max_rate) {
+        printf("The rate must be between 1 and %" PRIu32 " per second\n", k_max_rate);
+        return NULL;
+    }
+    generator_t *generator = &s_generators[s_generator_count];
+    memset(generator, 0, sizeof(generator_t));
+    generator->type = type;
+    generator->rate = rate;
+    return generator;
+}
+
+/* Called with the Matter stack lock held */
+static esp_err_t add_attribute_generator(generator_type_t type, int argc, char **argv)
+{
+    if (argc < 3) {
+        printf("Usage: matter esp loadgen %s <rate> <cluster_id> <attribute_id> [endpoint_id ...]\n",
+               k_type_names[type]);
+        return ESP_ERR_INVALID_ARG;
+    }
+    generator_t *generator = new_generator(type, argv[0]);
+    if (!generator) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    generator->cluster_id = strtoul(argv[1], NULL, 0);
+    generator->id = strtoul(argv[2], NULL, 0);
+    node_t *node = node::get();
+    if (!node) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    attribute_t *first = NULL;
+    if (argc > 3) {
+        for (int index = 3; index < argc && generator->endpoint_count < k_max_endpoints; index++) {
+            uint16_t endpoint_id = strtoul(argv[index], NULL, 0);
+            attribute_t *attribute = get_attribute(endpoint::get(node, endpoint_id), generator->cluster_id,
+                                                   generator->id);
+            if (!attribute) {
+                printf("Attribute not found on endpoint %u\n", endpoint_id);
+                return ESP_ERR_NOT_FOUND;
+            }
+            first = first ? first : attribute;
+            generator->endpoints[generator->endpoint_count++] = endpoint_id;
+        }
+    } else {
+        /* All the endpoints with the attribute */
+        for (endpoint_t *endpoint = endpoint::get_first(node);
+             endpoint && generator->endpoint_count < k_max_endpoints; endpoint = endpoint::get_next(endpoint)) {
+            attribute_t *attribute = get_attribute(endpoint, generator->cluster_id, generator->id);
+            if (attribute) {
+                first = first ? first : attribute;
+                generator->endpoints[generator->endpoint_count++] = endpoint::get_id(endpoint);
+            }
+        }
+    }
+    if (!first) {
+        printf("Attribute not found\n");
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (attribute::get_val(first, &generator->value) != ESP_OK || !toggle_value(&generator->value)) {
+        printf("Only the boolean, numeric, enum and bitmap attributes can be generated\n");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    s_generator_count++;
+    return ESP_OK;
+}
+
+static esp_err_t console_update_handler(int argc, char **argv)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    esp_err_t err = add_attribute_generator(GENERATOR_UPDATE, argc, argv);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+static esp_err_t console_report_handler(int argc, char **argv)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    esp_err_t err = add_attribute_generator(GENERATOR_REPORT, argc, argv);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+/* Called with the Matter stack lock held */
+static esp_err_t add_invoke_generator(int argc, char **argv)
+{
+    if (argc < 4) {
+        printf("Usage: matter esp loadgen invoke <rate> <endpoint_id> <cluster_id> <command_id> [fields_json]\n");
+        return ESP_ERR_INVALID_ARG;
+    }
+    generator_t *generator = new_generator(GENERATOR_INVOKE, argv[0]);
+    if (!generator) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    generator->endpoints[0] = strtoul(argv[1], NULL, 0);
+    generator->endpoint_count = 1;
+    generator->cluster_id = strtoul(argv[2], NULL, 0);
+    generator->id = strtoul(argv[3], NULL, 0);
+    command_t *command = command::get_accepted(generator->endpoints[0], generator->cluster_id, generator->id);
+    if (!command) {
+        printf("Command not found\n");
+        return ESP_ERR_NOT_FOUND;
+    }
+    /* The invokes are simulated without a command handler, which the built-in callbacks of the clusters need for
+       their responses */
+    if (command::get_callback(command)) {
+        printf("The command is handled by the cluster server, only the commands with a user callback can be "
+               "simulated\n");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (argc > 4) {
+        uint8_t *payload = (uint8_t *)calloc(1, k_max_fields_size);
+        if (!payload) {
+            return ESP_ERR_NO_MEM;
+        }
+        TLVWriter writer;
+        writer.Init(payload, k_max_fields_size);
+        if (json_to_tlv(argv[4], writer, chip::TLV::AnonymousTag()) != ESP_OK || writer.Finalize() != CHIP_NO_ERROR) {
+            printf("Invalid command fields\n");
+            free(payload);
+            return ESP_ERR_INVALID_ARG;
+        }
+        generator->payload = payload;
+        generator->payload_len = writer.GetLengthWritten();
+    }
+    s_generator_count++;
+    return ESP_OK;
+}
+
+static esp_err_t console_invoke_handler(int argc, char **argv)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    esp_err_t err = add_invoke_generator(argc, argv);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+static esp_err_t console_nvs_handler(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("Usage: matter esp loadgen nvs <rate> <size> [key_count]\n");
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint32_t size = strtoul(argv[1], NULL, 0);
+    uint32_t key_count = argc > 2 ? strtoul(argv[2], NULL, 0) : 4;
+    if (size == 0 || size > k_max_nvs_size || key_count == 0 || key_count > k_max_nvs_keys) {
+        printf("The size must be between 1 and %" PRIu32 " bytes and the key count between 1 and %" PRIu32 "\n",
+               k_max_nvs_size, k_max_nvs_keys);
+        return ESP_ERR_INVALID_ARG;
+    }
+    generator_t *generator = new_generator(GENERATOR_NVS, argv[0]);
+    if (!generator) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!s_nvs_handle) {
+        esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, k_nvs_namespace, NVS_READWRITE,
+                                                &s_nvs_handle);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to open the NVS namespace, err: %d", err);
+            return err;
+        }
+    }
+    generator->payload = (uint8_t *)malloc(size);
+    if (!generator->payload) {
+        return ESP_ERR_NO_MEM;
+    }
+    memset(generator->payload, 0xA5, size);
+    generator->payload_len = size;
+    generator->key_count = key_count;
+    s_generator_count++;
+    return ESP_OK;
+}
+
+static esp_err_t console_start_handler(int argc, char **argv)
+{
+    if (s_task) {
+        printf("The load generator is already running\n");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (s_generator_count == 0) {
+        printf("Add a generator first\n");
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_duration_ms = argc >= 1 ? strtoul(argv[0], NULL, 10) * 1000 : 0;
+    s_print_interval_ms = argc >= 2 ? strtoul(argv[1], NULL, 10) * 1000 : 5000;
+    for (size_t index = 0; index < s_generator_count; index++) {
+        s_generators[index].issued = 0;
+        memset(&s_generators[index].stats, 0, sizeof(latency_stats_t));
+    }
+    memset(&s_lock_wait, 0, sizeof(s_lock_wait));
+    take_lock_snapshot(&s_lock_at_start);
+    s_heap_at_start = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    s_heap_lowest = s_heap_at_start;
+    s_stop_requested = false;
+    s_start_us = esp_timer_get_time();
+    if (xTaskCreate(load_task, "mtr_loadgen", CONFIG_ESP_MATTER_LOAD_GEN_TASK_STACK_SIZE, NULL,
+                    CONFIG_ESP_MATTER_LOAD_GEN_TASK_PRIORITY, &s_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create the load generator task");
+        s_task = NULL;
+        s_start_us = 0;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t console_stop_handler(int argc, char **argv)
+{
+    if (!s_task) {
+        printf("The load generator is not running\n");
+        return ESP_ERR_INVALID_STATE;
+    }
+    /* The task prints the final report when it exits */
+    s_stop_requested = true;
+    return ESP_OK;
+}
+
+static esp_err_t console_status_handler(int argc, char **argv)
+{
+    print_report();
+    return ESP_OK;
+}
+
+static esp_err_t console_clear_handler(int argc, char **argv)
+{
+    if (s_task) {
+        printf("Stop the load generator first\n");
+        return ESP_ERR_INVALID_STATE;
+    }
+    free_generators();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine load_gen_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        load_gen_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return load_gen_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "loadgen",
+        .description = "Synthetic attribute, command and NVS load. "
+                       "Usage: matter esp loadgen <update|report|invoke|nvs|start|stop|status|clear>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t load_gen_commands[] = {
+        {
+            .name = "update",
+            .description = "Add an attribute::update() generator, over all the endpoints with the attribute by "
+                           "default. Usage: matter esp loadgen update <rate> <cluster_id> <attribute_id> "
+                           "[endpoint_id ...]",
+            .handler = console_update_handler,
+        },
+        {
+            .name = "report",
+            .description = "Add an attribute::report() generator. Usage: matter esp loadgen report <rate> "
+                           "<cluster_id> <attribute_id> [endpoint_id ...]",
+            .handler = console_report_handler,
+        },
+        {
+            .name = "invoke",
+            .description = "Add a generator of simulated invokes of a command with a user callback. "
+                           "Usage: matter esp loadgen invoke <rate> <endpoint_id> <cluster_id> <command_id> "
+                           "[fields_json]",
+            .handler = console_invoke_handler,
+        },
+        {
+            .name = "nvs",
+            .description = "Add an NVS write generator, with a commit per write. "
+                           "Usage: matter esp loadgen nvs <rate> <size> [key_count]",
+            .handler = console_nvs_handler,
+        },
+        {
+            .name = "start",
+            .description = "Run the generators. Usage: matter esp loadgen start [duration_s] [print_interval_s], "
+                           "until stopped and every 5 s by default, 0 to print only at the end.",
+            .handler = console_start_handler,
+        },
+        {
+            .name = "stop",
+            .description = "Stop the generators and print the final report.",
+            .handler = console_stop_handler,
+        },
+        {
+            .name = "status",
+            .description = "Print the generators and the statistics of the current or last run.",
+            .handler = console_status_handler,
+        },
+        {
+            .name = "clear",
+            .description = "Remove the generators and erase the NVS keys they wrote.",
+            .handler = console_clear_handler,
+        },
+    };
+    load_gen_console.register_commands(load_gen_commands,
+                                       sizeof(load_gen_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace load_gen
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_LOAD_GEN
@@ -0,0 +1,36 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+namespace esp_matter {
+namespace load_gen {
+
+#if CONFIG_ESP_MATTER_ENABLE_LOAD_GEN
+/**
+ * @brief Registers the load generator console commands.
+ *
+ * The generators are configured with "matter esp loadgen update|report|invoke|nvs", then run together in a task of
+ * the component with "matter esp loadgen start", which prints the achieved rates, the latency percentiles, the lock
+ * contention and the heap drift periodically and when the run stops.
+ */
+void register_console_commands();
+#else
+static inline void register_console_commands() {}
+#endif // CONFIG_ESP_MATTER_ENABLE_LOAD_GEN
+
+} // namespace load_gen
+} // namespace esp_matter
@@ -0,0 +1,240 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_lock_stats.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+
+namespace esp_matter {
+namespace lock {
+
+/* Upper bounds of the histogram buckets, the last bucket has no upper bound */
+static const uint32_t k_bucket_limits_us[LOCK_STATS_BUCKET_COUNT - 1] = {10, 100, 1000, 10000, 100000, 1000000};
+
+static caller_stats_t s_callers[LOCK_STATS_MAX_CALLERS];
+static size_t s_caller_count = 0;
+static uint32_t s_dropped_count = 0;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Current holder. Only written by the task holding the chip stack lock. */
+static caller_stats_t *s_holder = NULL;
+static void *s_holder_task = NULL;
+static int64_t s_holder_start_us = 0;
+
+static uint8_t get_bucket(uint32_t duration_us)
+{
+    uint8_t bucket = 0;
+    while (bucket < LOCK_STATS_BUCKET_COUNT - 1 && duration_us >= k_bucket_limits_us[bucket]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+static caller_stats_t *get_caller(void *caller)
+{
+    for (size_t index = 0; index < s_caller_count; index++) {
+        if (s_callers[index].caller == caller) {
+            return &s_callers[index];
+        }
+    }
+    if (s_caller_count >= LOCK_STATS_MAX_CALLERS) {
+        return NULL;
+    }
+    caller_stats_t *stats = &s_callers[s_caller_count++];
+    memset(stats, 0, sizeof(caller_stats_t));
+    stats->caller = caller;
+    return stats;
+}
+
+namespace stats {
+
+void wait_begin(wait_context_t *context)
+{
+    context->start_us = esp_timer_get_time();
+    context->holder_task = s_holder_task;
+}
+
+void acquired(void *caller, const wait_context_t *context)
+{
+    int64_t now_us = esp_timer_get_time();
+    uint32_t wait_us = (uint32_t)(now_us - context->start_us);
+
+    portENTER_CRITICAL(&s_stats_lock);
+    caller_stats_t *stats = get_caller(caller);
+    if (stats) {
+        stats->count++;
+        stats->wait_histogram[get_bucket(wait_us)]++;
+        if (wait_us >= stats->max_wait_us) {
+            stats->max_wait_us = wait_us;
+            const char *holder_name = context->holder_task ? pcTaskGetName((TaskHandle_t)context->holder_task) :
+                                      "(stack)";
+            strncpy(stats->max_wait_holder, holder_name, sizeof(stats->max_wait_holder) - 1);
+            stats->max_wait_holder[sizeof(stats->max_wait_holder) - 1] = '\0';
+        }
+    } else {
+        s_dropped_count++;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    s_holder = stats;
+    s_holder_task = xTaskGetCurrentTaskHandle();
+    s_holder_start_us = now_us;
+}
+
+void released()
+{
+    if (s_holder_task != xTaskGetCurrentTaskHandle()) {
+        /* The lock has been taken directly through the platform manager */
+        return;
+    }
+    uint32_t hold_us = (uint32_t)(esp_timer_get_time() - s_holder_start_us);
+    caller_stats_t *stats = s_holder;
+    s_holder = NULL;
+    s_holder_task = NULL;
+    if (!stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    stats->hold_histogram[get_bucket(hold_us)]++;
+    if (hold_us > stats->max_hold_us) {
+        stats->max_hold_us = hold_us;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine lock_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        lock_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return lock_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "lock",
+        .description = "Chip stack lock contention statistics. Usage: matter esp lock <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t lock_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the wait and hold time histograms of the chip stack lock per caller.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the chip stack lock statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    lock_console.register_commands(lock_commands, sizeof(lock_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace stats
+
+esp_err_t get_stats(caller_stats_t *stats, size_t *count)
+{
+    if (!stats || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    size_t copy_count = *count < s_caller_count ? *count : s_caller_count;
+    memcpy(stats, s_callers, copy_count * sizeof(caller_stats_t));
+    *count = copy_count;
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_caller_count = 0;
+    s_dropped_count = 0;
+    /* The current holder points into the table, do not record its hold time */
+    s_holder = NULL;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    static caller_stats_t stats[LOCK_STATS_MAX_CALLERS];
+    size_t count = LOCK_STATS_MAX_CALLERS;
+    get_stats(stats, &count);
+    printf("Bucket upper bounds (us):");
+    for (int bucket = 0; bucket < LOCK_STATS_BUCKET_COUNT - 1; bucket++) {
+        printf(" %" PRIu32, k_bucket_limits_us[bucket]);
+    }
+    printf(" inf\n");
+    for (size_t index = 0; index < count; index++) {
+        printf("Caller %p: count %" PRIu32 ", max wait %" PRIu32 " us (held by %s), max hold %" PRIu32 " us\n",
+               stats[index].caller, stats[index].count, stats[index].max_wait_us, stats[index].max_wait_holder,
+               stats[index].max_hold_us);
+        printf("\twait:");
+        for (int bucket = 0; bucket < LOCK_STATS_BUCKET_COUNT; bucket++) {
+            printf(" %" PRIu32, stats[index].wait_histogram[bucket]);
+        }
+        printf("\n\thold:");
+        for (int bucket = 0; bucket < LOCK_STATS_BUCKET_COUNT; bucket++) {
+            printf(" %" PRIu32, stats[index].hold_histogram[bucket]);
+        }
+        printf("\n");
+    }
+    if (s_dropped_count > 0) {
+        printf("%" PRIu32 " lock calls from untracked callers\n", s_dropped_count);
+    }
+}
+
+} // namespace lock
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
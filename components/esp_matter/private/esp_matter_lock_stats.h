@@ -0,0 +1,58 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace lock {
+namespace stats {
+
+/** Snapshot taken when a task starts waiting for the lock */
+typedef struct wait_context {
+    int64_t start_us;
+    /* Task which held the lock through lock::chip_stack_lock() when the wait started, NULL if unknown */
+    void *holder_task;
+} wait_context_t;
+
+/**
+ * @brief Marks the beginning of a wait for the chip stack lock.
+ *
+ * @param context Wait context to fill
+ */
+void wait_begin(wait_context_t *context);
+
+/**
+ * @brief Records the wait of a caller which has now acquired the lock, and makes it the current holder.
+ *
+ * @param caller  Return address of the lock::chip_stack_lock() call
+ * @param context Wait context filled by wait_begin()
+ */
+void acquired(void *caller, const wait_context_t *context);
+
+/**
+ * @brief Records the hold time of the current holder, called before the lock is released.
+ */
+void released();
+
+/**
+ * @brief Registers the lock console commands.
+ */
+void register_console_commands();
+
+} // namespace stats
+} // namespace lock
+} // namespace esp_matter
@@ -13,12 +13,18 @@
 // limitations under the License.
 
 #include <esp_err.h>
+#include <esp_idf_version.h>
 #include <esp_log.h>
 #include <nvs.h>
 #include <nvs_flash.h>
 #include <esp_matter_attribute_utils.h>
+#include <esp_matter_core.h>
 #include <esp_matter_mem.h>
+#include <esp_matter_journal.h>
 #include <esp_matter_nvs.h>
+#include <esp_matter_rtc_retention.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <lib/support/Base64.h>
 
@@ -45,10 +51,46 @@ static void get_attribute_key(uint16_t endpoint_id, uint32_t cluster_id, uint32_
      attribute_key[14] = 0;
 }
 
+#if CONFIG_ESP_MATTER_NVS_CACHE_HANDLES
+/* Handle of the esp_matter namespace, kept open for the lifetime of the node */
+static nvs_handle_t s_kvs_handle;
+static bool s_kvs_handle_open = false;
+#endif
+
+static esp_err_t open_namespace(const char *nvs_namespace, nvs_open_mode_t open_mode, nvs_handle_t *handle)
+{
+#if CONFIG_ESP_MATTER_NVS_CACHE_HANDLES
+    if (strcmp(nvs_namespace, ESP_MATTER_KVS_NAMESPACE) == 0) {
+        if (!s_kvs_handle_open) {
+            /* Opened read-write so that the same handle serves the reads and the writes */
+            esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READWRITE,
+                                                    &s_kvs_handle);
+            if (err != ESP_OK) {
+                return err;
+            }
+            s_kvs_handle_open = true;
+        }
+        *handle = s_kvs_handle;
+        return ESP_OK;
+    }
+#endif
+    return nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, open_mode, handle);
+}
+
+static void close_namespace(nvs_handle_t handle)
+{
+#if CONFIG_ESP_MATTER_NVS_CACHE_HANDLES
+    if (s_kvs_handle_open && handle == s_kvs_handle) {
+        return;
+    }
+#endif
+    nvs_close(handle);
+}
+
 static esp_err_t nvs_get_val(const char *nvs_namespace, const char *attribute_key, esp_matter_attr_val_t & val)
 {
     nvs_handle_t handle;
-    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READONLY, &handle);
+    esp_err_t err = open_namespace(nvs_namespace, NVS_READONLY, &handle);
     if (err != ESP_OK) {
         return err;
     }
@@ -183,18 +225,14 @@ static esp_err_t nvs_get_val(const char *nvs_namespace, const char *attribute_ke
         err = nvs_get_blob(handle, attribute_key, &val, &len);
 #endif // CONFIG_ESP_MATTER_NVS_USE_COMPACT_ATTR_STORAGE
     }
-    nvs_close(handle);
+    close_namespace(handle);
     return err;
 }
 
-static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_key, const esp_matter_attr_val_t & val)
+/* Sets the value in the open namespace, the caller commits */
+static esp_err_t nvs_set_val(nvs_handle_t handle, const char *attribute_key, const esp_matter_attr_val_t & val)
 {
-    nvs_handle_t handle;
-    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READWRITE, &handle);
-    if (err != ESP_OK) {
-        return err;
-    }
-
+    esp_err_t err = ESP_OK;
     if (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
         val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
         val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
@@ -203,7 +241,6 @@ static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_
         /* Store only if value is not NULL */
         if (val.val.a.b) {
             err = nvs_set_blob(handle, attribute_key, val.val.a.b, val.val.a.s);
-            nvs_commit(handle);
         } else {
             err = ESP_OK;
         }
@@ -309,26 +346,352 @@ static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_
 #else
         err = nvs_set_blob(handle, attribute_key, &val, sizeof(esp_matter_attr_val_t));
 #endif // CONFIG_ESP_MATTER_NVS_USE_COMPACT_ATTR_STORAGE
+    }
+    return err;
+}
 
-        nvs_commit(handle);
+static esp_err_t nvs_store_val(const char *nvs_namespace, const char *attribute_key, const esp_matter_attr_val_t & val)
+{
+    nvs_handle_t handle;
+    esp_err_t err = open_namespace(nvs_namespace, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        return err;
     }
-    nvs_close(handle);
+    err = nvs_set_val(handle, attribute_key, val);
+    nvs_commit(handle);
+    close_namespace(handle);
     return err;
 }
 
 static esp_err_t nvs_erase_val(const char *nvs_namespace, const char *attribute_key)
 {
     nvs_handle_t handle;
-    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, nvs_namespace, NVS_READWRITE, &handle);
+    esp_err_t err = open_namespace(nvs_namespace, NVS_READWRITE, &handle);
     if (err != ESP_OK) {
         return err;
     }
     err = nvs_erase_key(handle, attribute_key);
     nvs_commit(handle);
-    nvs_close(handle);
+    close_namespace(handle);
     return err;
 }
 
+#if CONFIG_ESP_MATTER_NVS_PRELOAD
+typedef struct preload_entry {
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint16_t endpoint_id;
+    /* Cleared when the value is written or erased after the preload, NVS is read again in that case */
+    bool valid;
+    nvs_type_t type;
+    /* Integer types */
+    uint64_t raw;
+    /* Blob type */
+    uint8_t *data;
+    size_t data_len;
+} preload_entry_t;
+
+typedef enum preload_state {
+    PRELOAD_STATE_NONE = 0,
+    PRELOAD_STATE_LOADED,
+    PRELOAD_STATE_RELEASED,
+} preload_state_t;
+
+static preload_state_t s_preload_state = PRELOAD_STATE_NONE;
+static preload_entry_t *s_preload_entries = NULL;
+static size_t s_preload_count = 0;
+/* A key missing from the preload is missing from NVS, until a new key is written */
+static bool s_preload_complete = false;
+/* Set if namespaces of the previous key format exist, their values are migrated by get_val_from_nvs() */
+static bool s_has_legacy_namespaces = false;
+
+static bool decode_attribute_key(const char *attribute_key, uint16_t *endpoint_id, uint32_t *cluster_id,
+                                 uint32_t *attribute_id)
+{
+    if (strlen(attribute_key) != 14) {
+        return false;
+    }
+    char base64_str[17] = {0};
+    memcpy(base64_str, attribute_key, 14);
+    base64_str[14] = '=';
+    base64_str[15] = '=';
+    uint8_t decode_buf[12] = {0};
+    if (chip::Base64Decode(base64_str, 16, decode_buf) != 10) {
+        return false;
+    }
+    memcpy(endpoint_id, &decode_buf[0], sizeof(*endpoint_id));
+    memcpy(cluster_id, &decode_buf[2], sizeof(*cluster_id));
+    memcpy(attribute_id, &decode_buf[6], sizeof(*attribute_id));
+    return true;
+}
+
+static int compare_preload_entries(const void *a, const void *b)
+{
+    const preload_entry_t *entry_a = (const preload_entry_t *)a;
+    const preload_entry_t *entry_b = (const preload_entry_t *)b;
+    if (entry_a->endpoint_id != entry_b->endpoint_id) {
+        return entry_a->endpoint_id < entry_b->endpoint_id ? -1 : 1;
+    }
+    if (entry_a->cluster_id != entry_b->cluster_id) {
+        return entry_a->cluster_id < entry_b->cluster_id ? -1 : 1;
+    }
+    if (entry_a->attribute_id != entry_b->attribute_id) {
+        return entry_a->attribute_id < entry_b->attribute_id ? -1 : 1;
+    }
+    return 0;
+}
+
+static preload_entry_t *find_preload_entry(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    if (s_preload_state != PRELOAD_STATE_LOADED || !s_preload_entries) {
+        return NULL;
+    }
+    preload_entry_t key = {};
+    key.endpoint_id = endpoint_id;
+    key.cluster_id = cluster_id;
+    key.attribute_id = attribute_id;
+    return (preload_entry_t *)bsearch(&key, s_preload_entries, s_preload_count, sizeof(preload_entry_t),
+                                      compare_preload_entries);
+}
+
+static esp_err_t read_preload_entry(nvs_handle_t handle, const char *attribute_key, preload_entry_t *entry)
+{
+    switch (entry->type) {
+    case NVS_TYPE_U8: {
+        uint8_t value = 0;
+        esp_err_t err = nvs_get_u8(handle, attribute_key, &value);
+        entry->raw = value;
+        return err;
+    }
+    case NVS_TYPE_I8: {
+        int8_t value = 0;
+        esp_err_t err = nvs_get_i8(handle, attribute_key, &value);
+        memcpy(&entry->raw, &value, sizeof(value));
+        return err;
+    }
+    case NVS_TYPE_U16: {
+        uint16_t value = 0;
+        esp_err_t err = nvs_get_u16(handle, attribute_key, &value);
+        entry->raw = value;
+        return err;
+    }
+    case NVS_TYPE_I16: {
+        int16_t value = 0;
+        esp_err_t err = nvs_get_i16(handle, attribute_key, &value);
+        memcpy(&entry->raw, &value, sizeof(value));
+        return err;
+    }
+    case NVS_TYPE_U32: {
+        uint32_t value = 0;
+        esp_err_t err = nvs_get_u32(handle, attribute_key, &value);
+        entry->raw = value;
+        return err;
+    }
+    case NVS_TYPE_I32: {
+        int32_t value = 0;
+        esp_err_t err = nvs_get_i32(handle, attribute_key, &value);
+        memcpy(&entry->raw, &value, sizeof(value));
+        return err;
+    }
+    case NVS_TYPE_U64:
+        return nvs_get_u64(handle, attribute_key, &entry->raw);
+    case NVS_TYPE_I64:
+        return nvs_get_i64(handle, attribute_key, (int64_t *)&entry->raw);
+    case NVS_TYPE_BLOB: {
+        esp_err_t err = nvs_get_blob(handle, attribute_key, NULL, &entry->data_len);
+        if (err != ESP_OK) {
+            return err;
+        }
+        entry->data = (uint8_t *)esp_matter_mem_calloc(1, entry->data_len ? entry->data_len : 1);
+        if (!entry->data) {
+            return ESP_ERR_NO_MEM;
+        }
+        return nvs_get_blob(handle, attribute_key, entry->data, &entry->data_len);
+    }
+    default:
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+}
+
+static size_t get_integer_size(nvs_type_t type)
+{
+    /* The lower nibble of the integer nvs types is their size */
+    return (size_t)type & 0x0F;
+}
+
+/* Same decoding as nvs_get_val(), from the preloaded copy of the entry */
+static esp_err_t get_val_from_preload_entry(const preload_entry_t *entry, esp_matter_attr_val_t & val)
+{
+    if (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING ||
+        val.type == ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING ||
+        val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING ||
+        val.type == ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING ||
+        val.type == ESP_MATTER_VAL_TYPE_ARRAY) {
+        if (entry->type != NVS_TYPE_BLOB) {
+            return ESP_ERR_NVS_TYPE_MISMATCH;
+        }
+        // This function will only be called when recovering the non-volatile attributes during reboot
+        // Add we should not decrease the size of the attribute value
+        size_t len = std::max(entry->data_len, static_cast<size_t>(val.val.a.s));
+        uint8_t *buffer = (uint8_t *)esp_matter_mem_calloc(1, len);
+        if (!buffer) {
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(buffer, entry->data, entry->data_len);
+        val.val.a.b = buffer;
+        val.val.a.n = len;
+        val.val.a.t = len + (val.val.a.t - val.val.a.s);
+        val.val.a.s = len;
+        return ESP_OK;
+    }
+#if CONFIG_ESP_MATTER_NVS_USE_COMPACT_ATTR_STORAGE
+    if (entry->type == NVS_TYPE_BLOB) {
+        /* Floats are stored as blobs */
+        if (val.type != ESP_MATTER_VAL_TYPE_FLOAT && val.type != ESP_MATTER_VAL_TYPE_NULLABLE_FLOAT) {
+            return ESP_ERR_NVS_TYPE_MISMATCH;
+        }
+        memcpy(&val.val.f, entry->data, std::min(entry->data_len, sizeof(val.val.f)));
+        return ESP_OK;
+    }
+    if (val.type == ESP_MATTER_VAL_TYPE_BOOLEAN) {
+        val.val.b = (entry->raw != 0);
+        return ESP_OK;
+    }
+    /* The members of esp_matter_val_t share the same address, copy the stored width */
+    memcpy(&val.val, &entry->raw, std::min(get_integer_size(entry->type), sizeof(val.val.u64)));
+    return ESP_OK;
+#else
+    if (entry->type != NVS_TYPE_BLOB) {
+        return ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+    memcpy(&val, entry->data, std::min(entry->data_len, sizeof(esp_matter_attr_val_t)));
+    return ESP_OK;
+#endif // CONFIG_ESP_MATTER_NVS_USE_COMPACT_ATTR_STORAGE
+}
+
+static void release_preload_entries()
+{
+    for (size_t index = 0; index < s_preload_count; index++) {
+        if (s_preload_entries[index].data) {
+            esp_matter_mem_free(s_preload_entries[index].data);
+        }
+    }
+    if (s_preload_entries) {
+        esp_matter_mem_free(s_preload_entries);
+    }
+    s_preload_entries = NULL;
+    s_preload_count = 0;
+}
+
+static esp_err_t preload()
+{
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    /* First pass over the partition, count the attribute keys and look for the namespaces of the previous format */
+    size_t count = 0;
+    nvs_iterator_t iterator = NULL;
+    esp_err_t err = nvs_entry_find(ESP_MATTER_NVS_PART_NAME, NULL, NVS_TYPE_ANY, &iterator);
+    while (err == ESP_OK) {
+        nvs_entry_info_t info;
+        nvs_entry_info(iterator, &info);
+        if (strcmp(info.namespace_name, ESP_MATTER_KVS_NAMESPACE) == 0) {
+            count++;
+        } else if (strncmp(info.namespace_name, "endpoint_", strlen("endpoint_")) == 0) {
+            s_has_legacy_namespaces = true;
+        }
+        err = nvs_entry_next(&iterator);
+    }
+    nvs_release_iterator(iterator);
+    if (err != ESP_ERR_NVS_NOT_FOUND) {
+        return err;
+    }
+
+    if (count > 0) {
+        s_preload_entries = (preload_entry_t *)esp_matter_mem_calloc(count, sizeof(preload_entry_t));
+        if (!s_preload_entries) {
+            ESP_LOGE(TAG, "Couldn't allocate %u preload entries", (unsigned)count);
+            return ESP_ERR_NO_MEM;
+        }
+        nvs_handle_t handle;
+        err = open_namespace(ESP_MATTER_KVS_NAMESPACE, NVS_READONLY, &handle);
+        if (err != ESP_OK) {
+            release_preload_entries();
+            return err;
+        }
+        iterator = NULL;
+        err = nvs_entry_find(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_TYPE_ANY, &iterator);
+        while (err == ESP_OK && s_preload_count < count) {
+            nvs_entry_info_t info;
+            nvs_entry_info(iterator, &info);
+            preload_entry_t *entry = &s_preload_entries[s_preload_count];
+            /* Skip the other keys of the namespace, like the minimum unused endpoint id */
+            if (decode_attribute_key(info.key, &entry->endpoint_id, &entry->cluster_id, &entry->attribute_id)) {
+                entry->type = info.type;
+                if (read_preload_entry(handle, info.key, entry) == ESP_OK) {
+                    entry->valid = true;
+                    s_preload_count++;
+                } else if (entry->data) {
+                    esp_matter_mem_free(entry->data);
+                }
+                if (!entry->valid) {
+                    memset(entry, 0, sizeof(preload_entry_t));
+                }
+            }
+            err = nvs_entry_next(&iterator);
+        }
+        nvs_release_iterator(iterator);
+        close_namespace(handle);
+        qsort(s_preload_entries, s_preload_count, sizeof(preload_entry_t), compare_preload_entries);
+    }
+    s_preload_complete = true;
+    ESP_LOGI(TAG, "Preloaded %u attribute values", (unsigned)s_preload_count);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/* Returns true if the preload is authoritative for the key, err is then the result of the lookup */
+static bool get_preloaded_val(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                              esp_matter_attr_val_t & val, esp_err_t *err)
+{
+    if (s_preload_state == PRELOAD_STATE_NONE) {
+        s_preload_state = PRELOAD_STATE_LOADED;
+        if (preload() != ESP_OK) {
+            ESP_LOGW(TAG, "Attribute preload failed, reading the attributes one by one");
+            release_preload_entries();
+            s_preload_state = PRELOAD_STATE_RELEASED;
+        }
+    }
+    if (s_preload_state != PRELOAD_STATE_LOADED) {
+        return false;
+    }
+    preload_entry_t *entry = find_preload_entry(endpoint_id, cluster_id, attribute_id);
+    if (entry && entry->valid) {
+        *err = get_val_from_preload_entry(entry, val);
+        return true;
+    }
+    if (!entry && s_preload_complete) {
+        *err = ESP_ERR_NVS_NOT_FOUND;
+        return true;
+    }
+    return false;
+}
+
+/* Keeps the preload consistent with the values written or erased after it */
+static void invalidate_preloaded_val(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, bool erased)
+{
+    if (s_preload_state != PRELOAD_STATE_LOADED) {
+        return;
+    }
+    preload_entry_t *entry = find_preload_entry(endpoint_id, cluster_id, attribute_id);
+    if (entry) {
+        entry->valid = false;
+    } else if (!erased) {
+        s_preload_complete = false;
+    }
+}
+#endif // CONFIG_ESP_MATTER_NVS_PRELOAD
+
 esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t & val)
 {
     /* Get attribute key */
@@ -337,7 +700,27 @@ esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
 
     ESP_LOGD(TAG, "read attribute from nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ","
                   " attribute_id-0x%" PRIx32 "", endpoint_id, cluster_id, attribute_id);
-    esp_err_t err = nvs_get_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val);
+    esp_err_t err = ESP_ERR_NVS_NOT_FOUND;
+    /* On a wake from deep sleep, the retained values are served without reading the flash */
+    if (rtc_retention::get(endpoint_id, cluster_id, attribute_id, val) == ESP_OK) {
+        return ESP_OK;
+    }
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_JOURNAL
+    if (journal::is_supported(val) && journal::get(endpoint_id, cluster_id, attribute_id, val) == ESP_OK) {
+        rtc_retention::store(endpoint_id, cluster_id, attribute_id, val);
+        return ESP_OK;
+    }
+#endif
+    bool preloaded = false;
+#if CONFIG_ESP_MATTER_NVS_PRELOAD
+    preloaded = get_preloaded_val(endpoint_id, cluster_id, attribute_id, val, &err);
+    if (preloaded && err == ESP_ERR_NVS_NOT_FOUND && !s_has_legacy_namespaces) {
+        return err;
+    }
+#endif
+    if (!preloaded) {
+        err = nvs_get_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val);
+    }
     if (err == ESP_ERR_NVS_NOT_FOUND) {
         // If we don't find attribute key in the esp_matter_kvs namespace, we will try to get the attribute value
         // with the previous key from the previous namespace.
@@ -352,11 +735,17 @@ esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
             if (nvs_erase_val(nvs_namespace, old_attribute_key) != ESP_OK) {
                 ESP_LOGE(TAG, "Failed to erase old attribute key");
             }
+#if CONFIG_ESP_MATTER_NVS_PRELOAD
+            invalidate_preloaded_val(endpoint_id, cluster_id, attribute_id, false);
+#endif
             if (nvs_store_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val) != ESP_OK) {
                 ESP_LOGE(TAG, "Failed to store attribute_val with new attribute key");
             }
         }
     }
+    if (err == ESP_OK) {
+        rtc_retention::store(endpoint_id, cluster_id, attribute_id, val);
+    }
     return err;
 }
 
@@ -365,9 +754,112 @@ esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
     /* Get attribute key */
     char attribute_key[16] = {0};
     get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
+#if CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+    /* The storage is being erased by the factory reset */
+    if (async_reset::is_running()) {
+        return ESP_OK;
+    }
+#endif
     ESP_LOGD(TAG, "Store attribute in nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ", attribute_id-0x%" PRIx32 "",
              endpoint_id, cluster_id, attribute_id);
-    return nvs_store_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val);
+#if CONFIG_ESP_MATTER_NVS_PRELOAD
+    invalidate_preloaded_val(endpoint_id, cluster_id, attribute_id, false);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_JOURNAL
+    /* The fixed size values go to the journal, NVS is the fallback if the journal is not usable */
+    if (journal::is_supported(val)) {
+        esp_err_t journal_err = journal::store(endpoint_id, cluster_id, attribute_id, val);
+        if (journal_err == ESP_OK) {
+            rtc_retention::store(endpoint_id, cluster_id, attribute_id, val);
+            return ESP_OK;
+        }
+        if (journal_err == ESP_ERR_INVALID_STATE) {
+            /* The previous value stays in the journal, which is read before NVS */
+            rtc_retention::erase(endpoint_id, cluster_id, attribute_id);
+            return journal_err;
+        }
+    }
+#endif
+    esp_err_t err = nvs_store_val(ESP_MATTER_KVS_NAMESPACE, attribute_key, val);
+    if (err == ESP_OK) {
+        rtc_retention::store(endpoint_id, cluster_id, attribute_id, val);
+    } else {
+        rtc_retention::erase(endpoint_id, cluster_id, attribute_id);
+    }
+    return err;
+}
+
+esp_err_t begin_store_batch(nvs_handle_t *handle)
+{
+    return open_namespace(ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE, handle);
+}
+
+esp_err_t store_val_in_batch(nvs_handle_t handle, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                             const esp_matter_attr_val_t & val)
+{
+    /* Get attribute key */
+    char attribute_key[16] = {0};
+    get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
+#if CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+    if (async_reset::is_running()) {
+        return ESP_OK;
+    }
+#endif
+    ESP_LOGD(TAG, "Store attribute in nvs batch: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ", attribute_id-0x%" PRIx32 "",
+             endpoint_id, cluster_id, attribute_id);
+#if CONFIG_ESP_MATTER_NVS_PRELOAD
+    invalidate_preloaded_val(endpoint_id, cluster_id, attribute_id, false);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_JOURNAL
+    /* The fixed size values go to the journal, NVS is the fallback if the journal is not usable */
+    if (journal::is_supported(val)) {
+        esp_err_t journal_err = journal::store(endpoint_id, cluster_id, attribute_id, val);
+        if (journal_err == ESP_OK) {
+            rtc_retention::store(endpoint_id, cluster_id, attribute_id, val);
+            return ESP_OK;
+        }
+        if (journal_err == ESP_ERR_INVALID_STATE) {
+            /* The previous value stays in the journal, which is read before NVS */
+            rtc_retention::erase(endpoint_id, cluster_id, attribute_id);
+            return journal_err;
+        }
+    }
+#endif
+    esp_err_t err = nvs_set_val(handle, attribute_key, val);
+    if (err == ESP_OK) {
+        rtc_retention::store(endpoint_id, cluster_id, attribute_id, val);
+    } else {
+        rtc_retention::erase(endpoint_id, cluster_id, attribute_id);
+    }
+    return err;
+}
+
+esp_err_t end_store_batch(nvs_handle_t handle)
+{
+    esp_err_t err = nvs_commit(handle);
+    close_namespace(handle);
+    return err;
+}
+
+esp_err_t commit_nvs()
+{
+#if CONFIG_ESP_MATTER_NVS_CACHE_HANDLES
+    if (s_kvs_handle_open) {
+        return nvs_commit(s_kvs_handle);
+    }
+#endif
+    return ESP_OK;
+}
+
+void close_nvs_handles()
+{
+#if CONFIG_ESP_MATTER_NVS_CACHE_HANDLES
+    if (s_kvs_handle_open) {
+        nvs_commit(s_kvs_handle);
+        nvs_close(s_kvs_handle);
+        s_kvs_handle_open = false;
+    }
+#endif
 }
 
 esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
@@ -377,8 +869,26 @@ esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
     get_attribute_key(endpoint_id, cluster_id, attribute_id, attribute_key);
     ESP_LOGD(TAG, "Erase attribute in nvs: endpoint_id-0x%" PRIx16 ", cluster_id-0x%" PRIx32 ", attribute_id-0x%" PRIx32 "",
              endpoint_id, cluster_id, attribute_id);
+#if CONFIG_ESP_MATTER_NVS_PRELOAD
+    invalidate_preloaded_val(endpoint_id, cluster_id, attribute_id, true);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_ATTRIBUTE_JOURNAL
+    esp_err_t journal_err = journal::erase(endpoint_id, cluster_id, attribute_id);
+    if (journal_err != ESP_OK && journal_err != ESP_ERR_NOT_FOUND) {
+        ESP_LOGE(TAG, "Failed to erase the attribute from the journal");
+    }
+#endif
+    rtc_retention::erase(endpoint_id, cluster_id, attribute_id);
     return nvs_erase_val(ESP_MATTER_KVS_NAMESPACE, attribute_key);
 }
 
+void release_nvs_preload()
+{
+#if CONFIG_ESP_MATTER_NVS_PRELOAD
+    release_preload_entries();
+    s_preload_state = PRELOAD_STATE_RELEASED;
+#endif
+}
+
 } // namespace attribute
 } // namespace esp_matter
@@ -16,6 +16,7 @@
 
 #include <esp_err.h>
 #include <esp_matter_attribute_utils.h>
+#include <nvs.h>
 
 namespace esp_matter {
 namespace attribute {
@@ -44,6 +45,52 @@ esp_err_t get_val_from_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
  */
 esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t & val);
 
+/**
+ * @brief Opens the esp_matter namespace to store several attribute values with a single commit.
+ *
+ * @param handle Handle to pass to store_val_in_batch() and end_store_batch()
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t begin_store_batch(nvs_handle_t *handle);
+
+/**
+ * @brief Stores an attribute value in the batch. The value is written to flash by end_store_batch().
+ *
+ * @param handle       Handle returned by begin_store_batch()
+ * @param endpoint_id  Endpoint Id
+ * @param cluster_id   Cluster Id
+ * @param attribute_id Attribute Id
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t store_val_in_batch(nvs_handle_t handle, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                             const esp_matter_attr_val_t & val);
+
+/**
+ * @brief Commits the values stored in the batch and closes the handle.
+ *
+ * @param handle Handle returned by begin_store_batch()
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t end_store_batch(nvs_handle_t handle);
+
+/**
+ * @brief Commits the pending writes of the cached esp_matter namespace handle.
+ *
+ * With CONFIG_ESP_MATTER_NVS_CACHE_HANDLES, the handle of the esp_matter namespace is opened once and kept open,
+ * reads and writes reuse it instead of opening and closing the namespace every time. This is a no-op otherwise.
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t commit_nvs();
+
+/**
+ * @brief Commits and closes the cached esp_matter namespace handle. It is opened again on the next access.
+ */
+void close_nvs_handles();
+
 /**
  * @brief Erases the attribute value in NVS, it generates the key based on endpoint, cluster, and attribute id.
  *
@@ -55,5 +102,14 @@ esp_err_t store_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t a
  */
 esp_err_t erase_val_in_nvs(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
 
+/**
+ * @brief Releases the attribute values preloaded from NVS.
+ *
+ * With CONFIG_ESP_MATTER_NVS_PRELOAD, the first get_val_from_nvs() call scans the esp_matter namespace once and keeps
+ * all the attribute values in RAM, the following calls are served from this copy. This frees it, the attributes
+ * created afterwards read NVS one by one.
+ */
+void release_nvs_preload();
+
 } // namespace attribute
 } // namespace esp_matter
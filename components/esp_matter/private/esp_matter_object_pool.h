@@ -0,0 +1,124 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <lib/support/CHIPMem.h>
+#include <memory>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+namespace esp_matter {
+
+/**
+ * @brief Fixed-size pool of objects of type T, falling back to chip::Platform::New() when all the slots are used.
+ *
+ * Objects must be released with destroy() of the pool they come from. Both can be called from any task.
+ */
+template <typename T, size_t N>
+class object_pool {
+public:
+    struct deleter {
+        object_pool *pool;
+        void operator()(T *object) const { pool->destroy(object); }
+    };
+    using unique_ptr_t = std::unique_ptr<T, deleter>;
+
+    template <typename... Args>
+    T *create(Args &&...args)
+    {
+        void *slot = NULL;
+        portENTER_CRITICAL(&m_lock);
+        for (size_t index = 0; index < N; index++) {
+            if (!m_used[index]) {
+                m_used[index] = true;
+                slot = m_storage[index];
+                break;
+            }
+        }
+        if (slot) {
+            m_in_use++;
+            if (m_in_use > m_high_water_mark) {
+                m_high_water_mark = m_in_use;
+            }
+        } else {
+            m_heap_fallbacks++;
+        }
+        portEXIT_CRITICAL(&m_lock);
+        if (!slot) {
+            return chip::Platform::New<T>(std::forward<Args>(args)...);
+        }
+        return new (slot) T(std::forward<Args>(args)...);
+    }
+
+    /* Same as create(), the object is given back to the pool when the returned pointer goes out of scope */
+    template <typename... Args>
+    unique_ptr_t make_unique(Args &&...args)
+    {
+        return unique_ptr_t(create(std::forward<Args>(args)...), deleter{this});
+    }
+
+    void destroy(T *object)
+    {
+        if (!object) {
+            return;
+        }
+        size_t index = get_index(object);
+        if (index >= N) {
+            chip::Platform::Delete(object);
+            return;
+        }
+        object->~T();
+        portENTER_CRITICAL(&m_lock);
+        m_used[index] = false;
+        m_in_use--;
+        portEXIT_CRITICAL(&m_lock);
+    }
+
+    /* stats_t has the size, in_use, high_water_mark and heap_fallbacks fields */
+    template <typename stats_t>
+    void get_stats(stats_t *stats)
+    {
+        portENTER_CRITICAL(&m_lock);
+        stats->size = N;
+        stats->in_use = m_in_use;
+        stats->high_water_mark = m_high_water_mark;
+        stats->heap_fallbacks = m_heap_fallbacks;
+        portEXIT_CRITICAL(&m_lock);
+    }
+
+private:
+    size_t get_index(const T *object) const
+    {
+        const uint8_t *ptr = reinterpret_cast<const uint8_t *>(object);
+        const uint8_t *begin = m_storage[0];
+        if (N == 0 || ptr < begin || ptr >= begin + sizeof(m_storage)) {
+            return N;
+        }
+        return (ptr - begin) / sizeof(T);
+    }
+
+    /* Keep one slot when the pool is disabled, so that the arrays are valid */
+    alignas(T) uint8_t m_storage[N > 0 ? N : 1][sizeof(T)];
+    bool m_used[N > 0 ? N : 1] = {};
+    uint16_t m_in_use = 0;
+    uint16_t m_high_water_mark = 0;
+    uint32_t m_heap_fallbacks = 0;
+    portMUX_TYPE m_lock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+} // namespace esp_matter
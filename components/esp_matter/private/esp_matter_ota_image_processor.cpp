@@ -0,0 +1,518 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_app_desc.h>
+#include <esp_image_format.h>
+#include <esp_log.h>
+#include <esp_matter_ota_image_processor.h>
+#include <esp_matter_ota_stats.h>
+#include <esp_timer.h>
+#include <esp_system.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <app/clusters/ota-requestor/OTARequestorInterface.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#if CONFIG_ESP_MATTER_OTA_IMAGE_PROCESSOR
+
+using chip::ByteSpan;
+using chip::OTAImageHeader;
+using chip::OTARequestorInterface;
+using chip::DeviceLayer::PlatformMgr;
+
+namespace esp_matter {
+namespace ota {
+
+static const char *TAG = "esp_matter_ota_image";
+
+#if CONFIG_ESP_MATTER_OTA_DELTA_IMAGE
+/* The callbacks of esp_delta_ota have no context, there is a single OTA image processor */
+static StreamingOTAImageProcessor *s_delta_processor = nullptr;
+#endif
+
+CHIP_ERROR StreamingOTAImageProcessor::PrepareDownload()
+{
+    PlatformMgr().ScheduleWork(HandlePrepareDownload, reinterpret_cast<intptr_t>(this));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR StreamingOTAImageProcessor::Finalize()
+{
+    PlatformMgr().ScheduleWork(HandleFinalize, reinterpret_cast<intptr_t>(this));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR StreamingOTAImageProcessor::Apply()
+{
+    PlatformMgr().ScheduleWork(HandleApply, reinterpret_cast<intptr_t>(this));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR StreamingOTAImageProcessor::Abort()
+{
+    PlatformMgr().ScheduleWork(HandleAbort, reinterpret_cast<intptr_t>(this));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR StreamingOTAImageProcessor::ProcessBlock(ByteSpan &block)
+{
+    // The block is only valid during the call, it is written from a scheduled work like the other steps
+    if (block.size() > mBlockCapacity) {
+        uint8_t *buffer = (uint8_t *)realloc(mBlock, block.size());
+        VerifyOrReturnError(buffer, CHIP_ERROR_NO_MEMORY);
+        mBlock = buffer;
+        mBlockCapacity = block.size();
+    }
+    memcpy(mBlock, block.data(), block.size());
+    mBlockSize = block.size();
+    PlatformMgr().ScheduleWork(HandleProcessBlock, reinterpret_cast<intptr_t>(this));
+    return CHIP_NO_ERROR;
+}
+
+bool StreamingOTAImageProcessor::IsFirstImageRun()
+{
+    OTARequestorInterface *requestor = chip::GetRequestorInstance();
+    if (requestor == nullptr) {
+        return false;
+    }
+    return requestor->GetCurrentUpdateState() == OTARequestorInterface::OTAUpdateStateEnum::kApplying;
+}
+
+CHIP_ERROR StreamingOTAImageProcessor::ConfirmCurrentImage()
+{
+    OTARequestorInterface *requestor = chip::GetRequestorInstance();
+    VerifyOrReturnError(requestor, CHIP_ERROR_INTERNAL);
+    uint32_t current_version;
+    ReturnErrorOnFailure(chip::DeviceLayer::ConfigurationMgr().GetSoftwareVersion(current_version));
+    VerifyOrReturnError(current_version == requestor->GetTargetVersion(), CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+}
+
+#if CONFIG_ENABLE_ENCRYPTED_OTA
+CHIP_ERROR StreamingOTAImageProcessor::InitEncryptedOTA(const chip::CharSpan &key)
+{
+    VerifyOrReturnError(key.data() && key.size() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    mKey = key;
+    return CHIP_NO_ERROR;
+}
+#endif
+
+void StreamingOTAImageProcessor::HandlePrepareDownload(intptr_t context)
+{
+    StreamingOTAImageProcessor *processor = reinterpret_cast<StreamingOTAImageProcessor *>(context);
+    processor->Release();
+    processor->mImageValid = false;
+    processor->mPartition = esp_ota_get_next_update_partition(NULL);
+    if (!processor->mPartition) {
+        ESP_LOGE(TAG, "No OTA partition to write the image to");
+        processor->mDownloader->OnPreparedForDownload(CHIP_ERROR_INTERNAL);
+        return;
+    }
+#if CONFIG_ENABLE_ENCRYPTED_OTA
+    if (processor->mKey.size() > 0) {
+        esp_decrypt_cfg_t cfg = {};
+        cfg.rsa_priv_key = processor->mKey.data();
+        cfg.rsa_priv_key_len = processor->mKey.size();
+        processor->mDecryptHandle = esp_encrypted_img_decrypt_start(&cfg);
+        if (!processor->mDecryptHandle) {
+            ESP_LOGE(TAG, "Failed to start the decryption of the OTA image");
+            processor->mDownloader->OnPreparedForDownload(CHIP_ERROR_INTERNAL);
+            return;
+        }
+    }
+#endif
+    esp_err_t err = esp_ota_begin(processor->mPartition, OTA_WITH_SEQUENTIAL_WRITES, &processor->mOTAHandle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_ota_begin failed: %s", esp_err_to_name(err));
+        processor->mOTAHandle = 0;
+        processor->Release();
+        processor->mDownloader->OnPreparedForDownload(CHIP_ERROR_INTERNAL);
+        return;
+    }
+    processor->mHeaderParser.Init();
+    processor->mParams.downloadedBytes = 0;
+    processor->mParams.totalFileBytes = 0;
+    processor->mDownloader->OnPreparedForDownload(CHIP_NO_ERROR);
+}
+
+void StreamingOTAImageProcessor::HandleProcessBlock(intptr_t context)
+{
+    StreamingOTAImageProcessor *processor = reinterpret_cast<StreamingOTAImageProcessor *>(context);
+    ByteSpan block(processor->mBlock, processor->mBlockSize);
+    processor->mParams.downloadedBytes += block.size();
+    if (processor->mHeaderParser.IsInitialized()) {
+        OTAImageHeader header;
+        CHIP_ERROR err = processor->mHeaderParser.Accumulate(block, header);
+        if (err == CHIP_ERROR_BUFFER_TOO_SMALL) {
+            processor->mDownloader->FetchNextData();
+            return;
+        }
+        if (err != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to parse the OTA image header: %" CHIP_ERROR_FORMAT, err.Format());
+            processor->mDownloader->EndDownload(err);
+            return;
+        }
+        processor->mParams.totalFileBytes = header.mPayloadSize;
+        processor->mHeaderParser.Clear();
+    }
+    esp_err_t err = processor->ProcessPayload(block.data(), block.size());
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to write the OTA image: %s", esp_err_to_name(err));
+        processor->Release();
+        processor->mDownloader->EndDownload(CHIP_ERROR_WRITE_FAILED);
+        return;
+    }
+    processor->mDownloader->FetchNextData();
+}
+
+esp_err_t StreamingOTAImageProcessor::ProcessPayload(const uint8_t *data, size_t size)
+{
+#if CONFIG_ENABLE_ENCRYPTED_OTA
+    if (mDecryptHandle) {
+        pre_enc_decrypt_arg_t args = {};
+        args.data_in = (const char *)data;
+        args.data_in_len = size;
+        int64_t start_us = esp_timer_get_time();
+        esp_err_t err = esp_encrypted_img_decrypt_data(mDecryptHandle, &args);
+        stats::record(stats::STEP_DECRYPT, (uint32_t)(esp_timer_get_time() - start_us));
+        if (err != ESP_OK && err != ESP_ERR_NOT_FINISHED) {
+            free(args.data_out);
+            return err;
+        }
+        // The decrypted bytes are processed right away, only the bytes of one block are held
+        err = args.data_out_len > 0 ? WritePayload((const uint8_t *)args.data_out, args.data_out_len) : ESP_OK;
+        free(args.data_out);
+        return err;
+    }
+#endif
+    return WritePayload(data, size);
+}
+
+esp_err_t StreamingOTAImageProcessor::WritePayload(const uint8_t *data, size_t size)
+{
+    if (mMode == Mode::kUnknown && size > 0) {
+        mMode = data[0] == ESP_IMAGE_HEADER_MAGIC ? Mode::kFull : Mode::kPayloadHeader;
+    }
+    if (mMode == Mode::kPayloadHeader) {
+        // The prefix tells the size of the header to accumulate
+        size_t header_size = mPayloadHeaderSize < sizeof(payload_header_prefix_t) ? sizeof(payload_header_prefix_t) :
+            mPayloadHeader.prefix.magic == OTA_COMPRESSED_HEADER_MAGIC ? sizeof(compressed_header_t) :
+            sizeof(delta_header_t);
+        while (size > 0 && mPayloadHeaderSize < header_size) {
+            size_t copy_size = header_size - mPayloadHeaderSize;
+            copy_size = copy_size < size ? copy_size : size;
+            memcpy((uint8_t *)&mPayloadHeader + mPayloadHeaderSize, data, copy_size);
+            mPayloadHeaderSize += copy_size;
+            data += copy_size;
+            size -= copy_size;
+            if (mPayloadHeaderSize == sizeof(payload_header_prefix_t)) {
+                header_size = mPayloadHeader.prefix.magic == OTA_COMPRESSED_HEADER_MAGIC ?
+                    sizeof(compressed_header_t) : sizeof(delta_header_t);
+            }
+        }
+        if (mPayloadHeaderSize < header_size) {
+            return ESP_OK;
+        }
+        esp_err_t err = StartPayload();
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    if (mMode == Mode::kDelta || mMode == Mode::kCompressed) {
+        size_t skip_size = mSkipBytes < size ? mSkipBytes : size;
+        data += skip_size;
+        size -= skip_size;
+        mSkipBytes -= skip_size;
+        if (size == 0) {
+            return ESP_OK;
+        }
+    }
+#if CONFIG_ESP_MATTER_OTA_DELTA_IMAGE
+    if (mMode == Mode::kDelta) {
+        return esp_delta_ota_feed_patch(mDeltaHandle, data, size);
+    }
+#endif
+#if CONFIG_ESP_MATTER_OTA_COMPRESSED_IMAGE
+    if (mMode == Mode::kCompressed) {
+        return Inflate(data, size);
+    }
+#endif
+    return size > 0 ? WriteFlash(data, size) : ESP_OK;
+}
+
+esp_err_t StreamingOTAImageProcessor::WriteFlash(const uint8_t *data, size_t size)
+{
+    int64_t start_us = esp_timer_get_time();
+    esp_err_t err = esp_ota_write(mOTAHandle, data, size);
+    stats::record(stats::STEP_FLASH_WRITE, (uint32_t)(esp_timer_get_time() - start_us));
+    return err;
+}
+
+esp_err_t StreamingOTAImageProcessor::StartPayload()
+{
+    const payload_header_prefix_t *prefix = &mPayloadHeader.prefix;
+    if (prefix->version != OTA_PAYLOAD_HEADER_VERSION) {
+        ESP_LOGE(TAG, "Unsupported payload header version %u", prefix->version);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+#if CONFIG_ESP_MATTER_OTA_DELTA_IMAGE
+    if (prefix->magic == OTA_DELTA_HEADER_MAGIC && prefix->header_size >= sizeof(delta_header_t)) {
+        const esp_app_desc_t *app_desc = esp_app_get_description();
+        if (memcmp(mPayloadHeader.delta.base_elf_sha256, app_desc->app_elf_sha256,
+                   sizeof(mPayloadHeader.delta.base_elf_sha256)) != 0) {
+            ESP_LOGE(TAG, "The delta image does not apply to the running firmware");
+            return ESP_ERR_INVALID_VERSION;
+        }
+        esp_delta_ota_cfg_t cfg = {};
+        cfg.read_cb = ReadBase;
+        cfg.write_cb = WriteReconstructed;
+        mDeltaHandle = esp_delta_ota_init(&cfg);
+        if (!mDeltaHandle) {
+            return ESP_ERR_NO_MEM;
+        }
+        s_delta_processor = this;
+        mExpectedSha256 = mPayloadHeader.delta.target_sha256;
+        mExpectedSize = mPayloadHeader.delta.target_size;
+        mMode = Mode::kDelta;
+    }
+#endif
+#if CONFIG_ESP_MATTER_OTA_COMPRESSED_IMAGE
+    if (prefix->magic == OTA_COMPRESSED_HEADER_MAGIC && prefix->header_size >= sizeof(compressed_header_t)) {
+        mInflator = (tinfl_decompressor *)malloc(sizeof(tinfl_decompressor));
+        mWindow = (uint8_t *)malloc(TINFL_LZ_DICT_SIZE);
+        if (!mInflator || !mWindow) {
+            return ESP_ERR_NO_MEM;
+        }
+        tinfl_init(mInflator);
+        mWindowOffset = 0;
+        mInflateDone = false;
+        mExpectedSha256 = mPayloadHeader.compressed.image_sha256;
+        mExpectedSize = mPayloadHeader.compressed.image_size;
+        mMode = Mode::kCompressed;
+    }
+#endif
+    if (mMode == Mode::kPayloadHeader) {
+        ESP_LOGE(TAG, "The image is neither a full image nor a supported delta or compressed image");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (mExpectedSize > mPartition->size) {
+        ESP_LOGE(TAG, "The image does not fit in the OTA partition");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    ESP_LOGI(TAG, "Downloading a %s image of %" PRIu32 " bytes", mMode == Mode::kDelta ? "delta" : "compressed",
+             mExpectedSize);
+    mbedtls_sha256_init(&mSha);
+    mbedtls_sha256_starts(&mSha, 0);
+    mShaStarted = true;
+    mImageSize = 0;
+    mSkipBytes = prefix->header_size - mPayloadHeaderSize;
+    return ESP_OK;
+}
+
+esp_err_t StreamingOTAImageProcessor::WriteImage(const uint8_t *data, size_t size)
+{
+    if (mImageSize + size > mExpectedSize) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    mbedtls_sha256_update(&mSha, data, size);
+    mImageSize += size;
+    return WriteFlash(data, size);
+}
+
+#if CONFIG_ESP_MATTER_OTA_DELTA_IMAGE
+esp_err_t StreamingOTAImageProcessor::ReadBase(uint8_t *buf, size_t size, int src_offset)
+{
+    if (src_offset < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return esp_partition_read(esp_ota_get_running_partition(), src_offset, buf, size);
+}
+
+esp_err_t StreamingOTAImageProcessor::WriteReconstructed(const uint8_t *buf, size_t size)
+{
+    return s_delta_processor ? s_delta_processor->WriteImage(buf, size) : ESP_ERR_INVALID_STATE;
+}
+#endif
+
+#if CONFIG_ESP_MATTER_OTA_COMPRESSED_IMAGE
+esp_err_t StreamingOTAImageProcessor::Inflate(const uint8_t *data, size_t size)
+{
+    while (!mInflateDone) {
+        size_t in_size = size;
+        size_t out_size = TINFL_LZ_DICT_SIZE - mWindowOffset;
+        // The window wraps around, the inflated bytes are written out before they are overwritten
+        tinfl_status status = tinfl_decompress(mInflator, data, &in_size, mWindow, mWindow + mWindowOffset, &out_size,
+                                               TINFL_FLAG_HAS_MORE_INPUT | TINFL_FLAG_PARSE_ZLIB_HEADER);
+        data += in_size;
+        size -= in_size;
+        if (out_size > 0) {
+            esp_err_t err = WriteImage(mWindow + mWindowOffset, out_size);
+            if (err != ESP_OK) {
+                return err;
+            }
+            mWindowOffset = (mWindowOffset + out_size) & (TINFL_LZ_DICT_SIZE - 1);
+        }
+        if (status < TINFL_STATUS_DONE) {
+            ESP_LOGE(TAG, "Failed to inflate the image: %d", status);
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        mInflateDone = status == TINFL_STATUS_DONE;
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT && size == 0) {
+            break;
+        }
+    }
+    return ESP_OK;
+}
+#endif
+
+esp_err_t StreamingOTAImageProcessor::FinishImage()
+{
+    esp_err_t err = ESP_OK;
+#if CONFIG_ESP_MATTER_OTA_DELTA_IMAGE
+    if (mDeltaHandle) {
+        err = esp_delta_ota_finalize(mDeltaHandle);
+        esp_delta_ota_deinit(mDeltaHandle);
+        mDeltaHandle = nullptr;
+        s_delta_processor = nullptr;
+    }
+#endif
+#if CONFIG_ESP_MATTER_OTA_COMPRESSED_IMAGE
+    if (mMode == Mode::kCompressed && !mInflateDone) {
+        ESP_LOGE(TAG, "The compressed image is truncated");
+        err = ESP_ERR_INVALID_SIZE;
+    }
+#endif
+    uint8_t sha256[32];
+    mbedtls_sha256_finish(&mSha, sha256);
+    mbedtls_sha256_free(&mSha);
+    mShaStarted = false;
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to rebuild the image: %s", esp_err_to_name(err));
+        return err;
+    }
+    if (mImageSize != mExpectedSize || memcmp(sha256, mExpectedSha256, sizeof(sha256)) != 0) {
+        ESP_LOGE(TAG, "The image does not match its payload header");
+        return ESP_ERR_INVALID_CRC;
+    }
+    return ESP_OK;
+}
+
+void StreamingOTAImageProcessor::HandleFinalize(intptr_t context)
+{
+    StreamingOTAImageProcessor *processor = reinterpret_cast<StreamingOTAImageProcessor *>(context);
+    esp_err_t err = ESP_OK;
+#if CONFIG_ENABLE_ENCRYPTED_OTA
+    if (processor->mDecryptHandle) {
+        // This checks the authentication tag of the encrypted image
+        err = esp_encrypted_img_decrypt_end(processor->mDecryptHandle);
+        processor->mDecryptHandle = nullptr;
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to decrypt the OTA image: %s", esp_err_to_name(err));
+        }
+    }
+#endif
+    if (err == ESP_OK) {
+        if (processor->mMode == Mode::kDelta || processor->mMode == Mode::kCompressed) {
+            err = processor->FinishImage();
+        } else if (processor->mMode != Mode::kFull) {
+            ESP_LOGE(TAG, "The OTA image has no payload");
+            err = ESP_ERR_INVALID_SIZE;
+        }
+    }
+    if (err == ESP_OK) {
+        // This verifies the image, and its signature when secure boot is enabled
+        err = esp_ota_end(processor->mOTAHandle);
+        processor->mOTAHandle = 0;
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "esp_ota_end failed: %s", esp_err_to_name(err));
+        }
+    }
+    processor->mImageValid = err == ESP_OK;
+    if (processor->mImageValid) {
+        ESP_LOGI(TAG, "OTA image downloaded to partition %s", processor->mPartition->label);
+    }
+    processor->Release();
+}
+
+void StreamingOTAImageProcessor::HandleApply(intptr_t context)
+{
+    StreamingOTAImageProcessor *processor = reinterpret_cast<StreamingOTAImageProcessor *>(context);
+    if (!processor->mImageValid) {
+        ESP_LOGE(TAG, "No valid OTA image to apply");
+        return;
+    }
+    esp_err_t err = esp_ota_set_boot_partition(processor->mPartition);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_ota_set_boot_partition failed: %s", esp_err_to_name(err));
+        return;
+    }
+    ESP_LOGI(TAG, "Applying, boot partition set to %s", processor->mPartition->label);
+#ifdef CONFIG_OTA_AUTO_REBOOT_ON_APPLY
+    chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(CONFIG_OTA_AUTO_REBOOT_DELAY_MS),
+                                                [](chip::System::Layer *, void *) { esp_restart(); }, nullptr);
+#else
+    ESP_LOGI(TAG, "Please reboot the device manually to apply the new image");
+#endif
+}
+
+void StreamingOTAImageProcessor::HandleAbort(intptr_t context)
+{
+    reinterpret_cast<StreamingOTAImageProcessor *>(context)->Release();
+}
+
+void StreamingOTAImageProcessor::Release()
+{
+#if CONFIG_ENABLE_ENCRYPTED_OTA
+    if (mDecryptHandle) {
+        esp_encrypted_img_decrypt_end(mDecryptHandle);
+        mDecryptHandle = nullptr;
+    }
+#endif
+#if CONFIG_ESP_MATTER_OTA_DELTA_IMAGE
+    if (mDeltaHandle) {
+        esp_delta_ota_deinit(mDeltaHandle);
+        mDeltaHandle = nullptr;
+    }
+    s_delta_processor = nullptr;
+#endif
+#if CONFIG_ESP_MATTER_OTA_COMPRESSED_IMAGE
+    free(mInflator);
+    mInflator = nullptr;
+    free(mWindow);
+    mWindow = nullptr;
+#endif
+    if (mShaStarted) {
+        mbedtls_sha256_free(&mSha);
+        mShaStarted = false;
+    }
+    if (mOTAHandle) {
+        esp_ota_abort(mOTAHandle);
+        mOTAHandle = 0;
+    }
+    free(mBlock);
+    mBlock = nullptr;
+    mBlockSize = 0;
+    mBlockCapacity = 0;
+    mHeaderParser.Clear();
+    mMode = Mode::kUnknown;
+    mPayloadHeaderSize = 0;
+    mSkipBytes = 0;
+}
+
+} // namespace ota
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_OTA_IMAGE_PROCESSOR
@@ -0,0 +1,176 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_ota_ops.h>
+#include <stdint.h>
+
+#include <app/clusters/ota-requestor/OTADownloader.h>
+#include <lib/core/OTAImageHeader.h>
+#include <lib/support/Span.h>
+#include <platform/OTAImageProcessor.h>
+
+#if CONFIG_ESP_MATTER_OTA_IMAGE_PROCESSOR
+#include <mbedtls/sha256.h>
+#if CONFIG_ESP_MATTER_OTA_DELTA_IMAGE
+#include <esp_delta_ota.h>
+#endif
+#if CONFIG_ESP_MATTER_OTA_COMPRESSED_IMAGE
+#include <miniz.h>
+#endif
+#if CONFIG_ENABLE_ENCRYPTED_OTA
+#include <esp_encrypted_img.h>
+#endif
+
+namespace esp_matter {
+namespace ota {
+
+/* "MDTA", first bytes of the payload of a delta image. The payload of a full image starts with the ESP image magic. */
+#define OTA_DELTA_HEADER_MAGIC 0x4154444D
+/* "MZIP", first bytes of the payload of a compressed image */
+#define OTA_COMPRESSED_HEADER_MAGIC 0x50495A4D
+#define OTA_PAYLOAD_HEADER_VERSION 1
+
+/** Common beginning of the payload headers, little endian */
+typedef struct __attribute__((packed)) payload_header_prefix {
+    uint32_t magic;
+    uint16_t version;
+    /* Size of the header, the bytes of newer versions of the header are skipped */
+    uint16_t header_size;
+} payload_header_prefix_t;
+
+/**
+ * Header of the payload of a delta image, after the Matter OTA image header. It is followed by the detools patch, see
+ * tools/ota/create_delta_image.py.
+ */
+typedef struct __attribute__((packed)) delta_header {
+    payload_header_prefix_t prefix;
+    /* ELF SHA-256 of the firmware the patch applies to, from its application description */
+    uint8_t base_elf_sha256[32];
+    /* SHA-256 of the reconstructed image */
+    uint8_t target_sha256[32];
+    /* Size of the reconstructed image */
+    uint32_t target_size;
+} delta_header_t;
+
+/**
+ * Header of the payload of a compressed image, after the Matter OTA image header. It is followed by the zlib stream of
+ * the image, see tools/ota/create_compressed_image.py.
+ */
+typedef struct __attribute__((packed)) compressed_header {
+    payload_header_prefix_t prefix;
+    /* SHA-256 of the decompressed image */
+    uint8_t image_sha256[32];
+    /* Size of the decompressed image */
+    uint32_t image_size;
+} compressed_header_t;
+
+/**
+ * OTA image processor accepting full, delta and compressed images, encrypted or not.
+ *
+ * The payload is processed in a single pass while it is downloaded: it is decrypted when the encrypted OTA is
+ * initialized, then a full image is written to the passive partition as is, a delta image is applied to the running
+ * partition and a compressed image is inflated. The SHA-256 of a reconstructed or decompressed image is checked
+ * against its payload header before esp_ota_end() verifies the image, and its signature when secure boot is enabled.
+ */
+class StreamingOTAImageProcessor : public chip::OTAImageProcessorInterface
+{
+public:
+    CHIP_ERROR PrepareDownload() override;
+    CHIP_ERROR Finalize() override;
+    CHIP_ERROR Apply() override;
+    CHIP_ERROR Abort() override;
+    CHIP_ERROR ProcessBlock(chip::ByteSpan &block) override;
+    bool IsFirstImageRun() override;
+    CHIP_ERROR ConfirmCurrentImage() override;
+
+    void SetOTADownloader(chip::OTADownloader *downloader) { mDownloader = downloader; }
+#if CONFIG_ENABLE_ENCRYPTED_OTA
+    /* The key is not copied, it must stay valid */
+    CHIP_ERROR InitEncryptedOTA(const chip::CharSpan &key);
+#endif
+
+private:
+    enum class Mode : uint8_t {
+        kUnknown,
+        kFull,
+        kPayloadHeader,
+        kDelta,
+        kCompressed,
+    };
+
+    static void HandlePrepareDownload(intptr_t context);
+    static void HandleFinalize(intptr_t context);
+    static void HandleApply(intptr_t context);
+    static void HandleAbort(intptr_t context);
+    static void HandleProcessBlock(intptr_t context);
+
+    esp_err_t ProcessPayload(const uint8_t *data, size_t size);
+    esp_err_t WritePayload(const uint8_t *data, size_t size);
+    esp_err_t StartPayload();
+    esp_err_t WriteImage(const uint8_t *data, size_t size);
+    esp_err_t WriteFlash(const uint8_t *data, size_t size);
+    esp_err_t FinishImage();
+    void Release();
+
+    chip::OTADownloader *mDownloader = nullptr;
+    chip::OTAImageHeaderParser mHeaderParser;
+    const esp_partition_t *mPartition = nullptr;
+    esp_ota_handle_t mOTAHandle = 0;
+    bool mImageValid = false;
+    uint8_t *mBlock = nullptr;
+    size_t mBlockSize = 0;
+    size_t mBlockCapacity = 0;
+
+    Mode mMode = Mode::kUnknown;
+    union {
+        payload_header_prefix_t prefix;
+        delta_header_t delta;
+        compressed_header_t compressed;
+    } mPayloadHeader;
+    size_t mPayloadHeaderSize = 0;
+    /* Bytes of a newer version of the payload header left to skip */
+    size_t mSkipBytes = 0;
+
+    /* Image reconstructed from a delta or decompressed, checked against the payload header */
+    mbedtls_sha256_context mSha;
+    bool mShaStarted = false;
+    const uint8_t *mExpectedSha256 = nullptr;
+    uint32_t mExpectedSize = 0;
+    uint32_t mImageSize = 0;
+
+#if CONFIG_ESP_MATTER_OTA_DELTA_IMAGE
+    static esp_err_t ReadBase(uint8_t *buf, size_t size, int src_offset);
+    static esp_err_t WriteReconstructed(const uint8_t *buf, size_t size);
+    esp_delta_ota_handle_t mDeltaHandle = nullptr;
+#endif
+#if CONFIG_ESP_MATTER_OTA_COMPRESSED_IMAGE
+    esp_err_t Inflate(const uint8_t *data, size_t size);
+    tinfl_decompressor *mInflator = nullptr;
+    /* Sliding window of the inflated stream, TINFL_LZ_DICT_SIZE bytes */
+    uint8_t *mWindow = nullptr;
+    size_t mWindowOffset = 0;
+    bool mInflateDone = false;
+#endif
+#if CONFIG_ENABLE_ENCRYPTED_OTA
+    chip::CharSpan mKey;
+    esp_decrypt_handle_t mDecryptHandle = nullptr;
+#endif
+};
+
+} // namespace ota
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_OTA_IMAGE_PROCESSOR
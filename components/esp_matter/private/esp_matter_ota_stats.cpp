@@ -0,0 +1,202 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_matter_ota_stats.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <messaging/ReliableMessageProtocolConfig.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_OTA_BENCHMARK
+
+namespace esp_matter {
+namespace ota {
+namespace stats {
+
+typedef struct {
+    uint64_t total_us;
+    uint32_t count;
+    uint32_t max_us;
+} step_stats_t;
+
+static bool s_started = false;
+static bool s_complete = false;
+static int64_t s_start_us = 0;
+static int64_t s_end_us = 0;
+static uint16_t s_block_size = 0;
+static uint32_t s_blocks = 0;
+static uint64_t s_bytes = 0;
+static uint32_t s_slow_blocks = 0;
+static uint32_t s_stalls = 0;
+static step_stats_t s_steps[STEP_COUNT];
+
+void begin()
+{
+    s_started = true;
+    s_complete = false;
+    s_start_us = esp_timer_get_time();
+    s_end_us = 0;
+    s_block_size = 0;
+    s_blocks = 0;
+    s_bytes = 0;
+    s_slow_blocks = 0;
+    s_stalls = 0;
+    memset(s_steps, 0, sizeof(s_steps));
+}
+
+void block_received(uint32_t size)
+{
+    s_blocks++;
+    s_bytes += size;
+    if (size > s_block_size) {
+        s_block_size = size;
+    }
+}
+
+void record(step_t step, uint32_t duration_us)
+{
+    step_stats_t *stats = &s_steps[step];
+    stats->total_us += duration_us;
+    stats->count++;
+    if (duration_us > stats->max_us) {
+        stats->max_us = duration_us;
+    }
+    if (step == STEP_RECEIVE) {
+        uint32_t retry_interval_ms =
+            chip::System::Clock::Milliseconds32(CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL).count();
+        if (duration_us > retry_interval_ms * 1000) {
+            s_slow_blocks++;
+        }
+    }
+}
+
+void stall()
+{
+    s_stalls++;
+}
+
+void end()
+{
+    s_complete = true;
+    s_end_us = esp_timer_get_time();
+}
+
+static uint32_t average(const step_stats_t *stats)
+{
+    return stats->count > 0 ? (uint32_t)(stats->total_us / stats->count) : 0;
+}
+
+esp_err_t get(esp_matter_ota_download_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_started) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    int64_t end_us = s_complete ? s_end_us : esp_timer_get_time();
+    stats->complete = s_complete;
+    stats->block_size = s_block_size;
+    stats->blocks = s_blocks;
+    stats->bytes = s_bytes;
+    stats->duration_ms = (uint32_t)((end_us - s_start_us) / 1000);
+    stats->throughput_bytes_per_sec =
+        stats->duration_ms > 0 ? (uint32_t)(s_bytes * 1000 / stats->duration_ms) : 0;
+    stats->receive_avg_us = average(&s_steps[STEP_RECEIVE]);
+    stats->receive_max_us = s_steps[STEP_RECEIVE].max_us;
+    stats->slow_blocks = s_slow_blocks;
+    stats->process_avg_us = average(&s_steps[STEP_PROCESS]);
+    stats->process_max_us = s_steps[STEP_PROCESS].max_us;
+    stats->flash_write_avg_us = average(&s_steps[STEP_FLASH_WRITE]);
+    stats->flash_write_max_us = s_steps[STEP_FLASH_WRITE].max_us;
+    stats->decrypt_avg_us = average(&s_steps[STEP_DECRYPT]);
+    stats->decrypt_max_us = s_steps[STEP_DECRYPT].max_us;
+    stats->stalls = s_stalls;
+    return ESP_OK;
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    esp_matter_ota_download_stats_t stats;
+    if (get(&stats) != ESP_OK) {
+        printf("No OTA download since boot\n");
+        return ESP_OK;
+    }
+    printf("OTA download %s: %" PRIu32 " blocks of up to %u bytes, %llu bytes in %" PRIu32 " ms, %" PRIu32 " B/s\n",
+           stats.complete ? "complete" : "in progress", stats.blocks, stats.block_size,
+           (unsigned long long)stats.bytes, stats.duration_ms, stats.throughput_bytes_per_sec);
+    printf("\treceive: avg %" PRIu32 " us, max %" PRIu32 " us, %" PRIu32 " slow blocks\n", stats.receive_avg_us,
+           stats.receive_max_us, stats.slow_blocks);
+    printf("\tprocess: avg %" PRIu32 " us, max %" PRIu32 " us, %" PRIu32 " stalls\n", stats.process_avg_us,
+           stats.process_max_us, stats.stalls);
+    printf("\tflash write: avg %" PRIu32 " us, max %" PRIu32 " us\n", stats.flash_write_avg_us,
+           stats.flash_write_max_us);
+    printf("\tdecrypt: avg %" PRIu32 " us, max %" PRIu32 " us\n", stats.decrypt_avg_us, stats.decrypt_max_us);
+    return ESP_OK;
+}
+
+static esp_matter::console::engine ota_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        ota_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return ota_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "ota",
+        .description = "OTA download statistics. Usage: matter esp ota stats.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t ota_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the statistics of the last OTA download.",
+            .handler = console_stats_handler,
+        },
+    };
+    ota_console.register_commands(ota_commands, sizeof(ota_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace stats
+} // namespace ota
+} // namespace esp_matter
+
+esp_err_t esp_matter_ota_get_download_stats(esp_matter_ota_download_stats_t *stats)
+{
+    return esp_matter::ota::stats::get(stats);
+}
+
+#endif // CONFIG_ESP_MATTER_OTA_BENCHMARK
@@ -0,0 +1,88 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_ota.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace ota {
+namespace stats {
+
+/** Timed step of the processing of a block */
+typedef enum step {
+    STEP_RECEIVE,
+    STEP_PROCESS,
+    STEP_FLASH_WRITE,
+    STEP_DECRYPT,
+    STEP_COUNT,
+} step_t;
+
+#if CONFIG_ESP_MATTER_OTA_BENCHMARK
+/**
+ * @brief Starts the statistics of a new download. All the functions are called in the Matter context.
+ */
+void begin();
+
+/**
+ * @brief Records a received block.
+ *
+ * @param size Size of the block
+ */
+void block_received(uint32_t size);
+
+/**
+ * @brief Records the duration of a step of the processing of a block.
+ *
+ * @param step        Step
+ * @param duration_us Duration of the step
+ */
+void record(step_t step, uint32_t duration_us);
+
+/**
+ * @brief Records a block which waited for the previous one to be written.
+ */
+void stall();
+
+/**
+ * @brief Marks the download as complete, the duration and the throughput are then fixed.
+ */
+void end();
+
+/**
+ * @brief Copies the statistics of the last download.
+ *
+ * @param stats Statistics to fill
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if no download was started since boot.
+ */
+esp_err_t get(esp_matter_ota_download_stats_t *stats);
+
+/**
+ * @brief Registers the OTA console commands.
+ */
+void register_console_commands();
+#else
+inline void begin() {}
+inline void block_received(uint32_t size) {}
+inline void record(step_t step, uint32_t duration_us) {}
+inline void stall() {}
+inline void end() {}
+inline void register_console_commands() {}
+#endif // CONFIG_ESP_MATTER_OTA_BENCHMARK
+
+} // namespace stats
+} // namespace ota
+} // namespace esp_matter
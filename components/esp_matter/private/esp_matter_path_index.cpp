@@ -0,0 +1,224 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_path_index.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
+
+namespace esp_matter {
+namespace path_index {
+
+static const char *TAG = "mtr_path_index";
+
+/* Must be a power of two, the slot index is computed by masking the hash */
+constexpr uint32_t k_initial_capacity = 64;
+
+typedef struct entry {
+    /* NULL for an empty slot, s_tombstone for a removed slot */
+    void *handle;
+    uint32_t cluster_id;
+    uint32_t element_id;
+    uint16_t endpoint_id;
+    uint8_t type;
+} entry_t;
+
+static uint8_t s_tombstone_marker;
+static void *const s_tombstone = &s_tombstone_marker;
+
+static entry_t *s_entries = NULL;
+static uint32_t s_capacity = 0;
+static uint32_t s_count = 0;
+static uint32_t s_tombstone_count = 0;
+/* Set once an element could not be inserted, it is then only reachable through the lists */
+static bool s_incomplete = false;
+
+static void normalize_key(element_type_t type, uint32_t &cluster_id, uint32_t &element_id)
+{
+    if (type == ELEMENT_TYPE_ENDPOINT) {
+        cluster_id = 0;
+        element_id = 0;
+    } else if (type == ELEMENT_TYPE_CLUSTER) {
+        element_id = 0;
+    }
+}
+
+static uint32_t hash(element_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id)
+{
+    /* Mix the fields with the murmur3 finalizer, which spreads the small, dense ids used by Matter well */
+    uint32_t h = ((uint32_t)type << 16) | endpoint_id;
+    h ^= cluster_id * 0x9E3779B1u;
+    h ^= element_id * 0x85EBCA77u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static bool matches(const entry_t *entry, element_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                    uint32_t element_id)
+{
+    return entry->handle && entry->handle != s_tombstone && entry->type == type &&
+           entry->endpoint_id == endpoint_id && entry->cluster_id == cluster_id && entry->element_id == element_id;
+}
+
+static entry_t *lookup(element_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id)
+{
+    if (!s_entries) {
+        return NULL;
+    }
+    uint32_t mask = s_capacity - 1;
+    uint32_t index = hash(type, endpoint_id, cluster_id, element_id) & mask;
+    for (uint32_t probe = 0; probe < s_capacity; probe++) {
+        entry_t *entry = &s_entries[(index + probe) & mask];
+        if (!entry->handle) {
+            return NULL;
+        }
+        if (matches(entry, type, endpoint_id, cluster_id, element_id)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void place(const entry_t *source)
+{
+    uint32_t mask = s_capacity - 1;
+    uint32_t index = hash((element_type_t)source->type, source->endpoint_id, source->cluster_id,
+                          source->element_id) & mask;
+    while (s_entries[index].handle && s_entries[index].handle != s_tombstone) {
+        index = (index + 1) & mask;
+    }
+    s_entries[index] = *source;
+}
+
+static esp_err_t resize(uint32_t new_capacity)
+{
+    entry_t *new_entries = (entry_t *)esp_matter_mem_calloc(new_capacity, sizeof(entry_t));
+    if (!new_entries) {
+        ESP_LOGE(TAG, "Couldn't allocate %" PRIu32 " path index entries", new_capacity);
+        return ESP_ERR_NO_MEM;
+    }
+    entry_t *old_entries = s_entries;
+    uint32_t old_capacity = s_capacity;
+    s_entries = new_entries;
+    s_capacity = new_capacity;
+    s_tombstone_count = 0;
+    for (uint32_t index = 0; index < old_capacity; index++) {
+        if (old_entries[index].handle && old_entries[index].handle != s_tombstone) {
+            place(&old_entries[index]);
+        }
+    }
+    if (old_entries) {
+        esp_matter_mem_free(old_entries);
+    }
+    return ESP_OK;
+}
+
+esp_err_t insert(element_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, void *handle)
+{
+    if (!handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    normalize_key(type, cluster_id, element_id);
+    entry_t *existing = lookup(type, endpoint_id, cluster_id, element_id);
+    if (existing) {
+        existing->handle = handle;
+        return ESP_OK;
+    }
+
+    /* Keep the load factor (including tombstones) below 3/4 */
+    if ((s_count + s_tombstone_count + 1) * 4 > s_capacity * 3) {
+        uint32_t new_capacity = s_capacity ? s_capacity : k_initial_capacity;
+        /* Grow only when live entries need it, otherwise rehashing in place is enough to drop the tombstones */
+        while ((s_count + 1) * 2 > new_capacity) {
+            new_capacity *= 2;
+        }
+        esp_err_t err = resize(new_capacity);
+        if (err != ESP_OK) {
+            if (!s_incomplete) {
+                ESP_LOGW(TAG, "Path index incomplete, the lookups which miss fall back to the lists");
+            }
+            s_incomplete = true;
+            return err;
+        }
+    }
+
+    uint32_t mask = s_capacity - 1;
+    uint32_t index = hash(type, endpoint_id, cluster_id, element_id) & mask;
+    while (s_entries[index].handle && s_entries[index].handle != s_tombstone) {
+        index = (index + 1) & mask;
+    }
+    if (s_entries[index].handle == s_tombstone) {
+        s_tombstone_count--;
+    }
+    s_entries[index].handle = handle;
+    s_entries[index].type = (uint8_t)type;
+    s_entries[index].endpoint_id = endpoint_id;
+    s_entries[index].cluster_id = cluster_id;
+    s_entries[index].element_id = element_id;
+    s_count++;
+    return ESP_OK;
+}
+
+esp_err_t remove(element_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id)
+{
+    normalize_key(type, cluster_id, element_id);
+    entry_t *entry = lookup(type, endpoint_id, cluster_id, element_id);
+    if (!entry) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    entry->handle = s_tombstone;
+    s_count--;
+    s_tombstone_count++;
+    if (s_count == 0) {
+        /* Release the table once the node is empty */
+        esp_matter_mem_free(s_entries);
+        s_entries = NULL;
+        s_capacity = 0;
+        s_tombstone_count = 0;
+    }
+    return ESP_OK;
+}
+
+void *find(element_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id)
+{
+    normalize_key(type, cluster_id, element_id);
+    entry_t *entry = lookup(type, endpoint_id, cluster_id, element_id);
+    return entry ? entry->handle : NULL;
+}
+
+bool is_complete()
+{
+    return !s_incomplete;
+}
+
+uint32_t get_count()
+{
+    return s_count;
+}
+
+uint32_t get_capacity()
+{
+    return s_capacity;
+}
+
+} // namespace path_index
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_PATH_INDEX
@@ -0,0 +1,94 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace path_index {
+
+/** Kind of the element stored in the path index */
+typedef enum element_type {
+    ELEMENT_TYPE_ENDPOINT = 0,
+    ELEMENT_TYPE_CLUSTER,
+    ELEMENT_TYPE_ATTRIBUTE,
+    ELEMENT_TYPE_ACCEPTED_COMMAND,
+    ELEMENT_TYPE_GENERATED_COMMAND,
+    ELEMENT_TYPE_EVENT,
+} element_type_t;
+
+/**
+ * @brief Adds a data model element to the node-wide path index.
+ *
+ * The index is an open-addressing hash table keyed on (type, endpoint, cluster, element). It grows when the load
+ * factor gets too high. For endpoints, cluster_id and element_id are ignored, for clusters element_id is ignored.
+ *
+ * @param type        Element type
+ * @param endpoint_id Endpoint Id
+ * @param cluster_id  Cluster Id
+ * @param element_id  Attribute/Command/Event Id
+ * @param handle      Element handle to store, cannot be NULL
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t insert(element_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, void *handle);
+
+/**
+ * @brief Removes a data model element from the path index.
+ *
+ * @param type        Element type
+ * @param endpoint_id Endpoint Id
+ * @param cluster_id  Cluster Id
+ * @param element_id  Attribute/Command/Event Id
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the element is not indexed
+ */
+esp_err_t remove(element_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id);
+
+/**
+ * @brief Looks up a data model element in the path index.
+ *
+ * @param type        Element type
+ * @param endpoint_id Endpoint Id
+ * @param cluster_id  Cluster Id
+ * @param element_id  Attribute/Command/Event Id
+ *
+ * @return Element handle on success, NULL if the element is not indexed
+ */
+void *find(element_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id);
+
+/**
+ * @brief Checks if all the inserted elements are in the path index.
+ *
+ * Once an insert has failed, for example when the table could not grow, the index misses elements which are still
+ * linked in the data model. The lookups must then fall back to the lists when find() misses.
+ *
+ * @return true if no insert has failed, false otherwise
+ */
+bool is_complete();
+
+/**
+ * @brief Gets the number of elements currently stored in the path index.
+ */
+uint32_t get_count();
+
+/**
+ * @brief Gets the number of slots currently allocated for the path index.
+ */
+uint32_t get_capacity();
+
+} // namespace path_index
+} // namespace esp_matter
@@ -0,0 +1,334 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_heap_caps.h>
+#include <esp_matter_core.h>
+#include <esp_matter_perf.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+
+#include <app/InteractionModelEngine.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_PERF_CONSOLE
+
+using chip::app::InteractionModelEngine;
+using chip::app::ReadHandler;
+
+namespace esp_matter {
+namespace perf {
+
+/* One counter per trace event, indexed by the event value */
+static constexpr size_t k_event_count = trace::EVENT_COMMAND + 1;
+/* Tasks whose stack is printed when the list of all the tasks is not available */
+static const char *k_known_tasks[] = {"CHIP", "main", "console", "esp_timer", "ot_br", "mtr_pwr_fail"};
+
+static std::atomic<uint32_t> s_events[k_event_count];
+static std::atomic<uint32_t> s_failures[k_event_count];
+
+/* Counters printed by the perf console, the rates are computed from the delta of two snapshots */
+typedef struct {
+    int64_t timestamp_us;
+    uint32_t events[k_event_count];
+    uint32_t failures[k_event_count];
+    uint32_t lock_count;
+    /* Acquisitions which waited 100 us or more */
+    uint32_t lock_contended;
+    uint32_t lock_max_wait_us;
+} snapshot_t;
+
+static snapshot_t s_previous;
+static uint32_t s_watch_interval_ms = 0;
+static uint32_t s_watch_remaining = 0;
+
+void count(trace::event_t event, uint8_t status)
+{
+    if ((size_t)event >= k_event_count) {
+        return;
+    }
+    s_events[event].fetch_add(1, std::memory_order_relaxed);
+    if (status != 0) {
+        s_failures[event].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+static void take_snapshot(snapshot_t *snapshot)
+{
+    memset(snapshot, 0, sizeof(snapshot_t));
+    snapshot->timestamp_us = esp_timer_get_time();
+    for (size_t event = 0; event < k_event_count; event++) {
+        snapshot->events[event] = s_events[event].load(std::memory_order_relaxed);
+        snapshot->failures[event] = s_failures[event].load(std::memory_order_relaxed);
+    }
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+    static lock::caller_stats_t callers[LOCK_STATS_MAX_CALLERS];
+    size_t caller_count = LOCK_STATS_MAX_CALLERS;
+    if (lock::get_stats(callers, &caller_count) == ESP_OK) {
+        for (size_t index = 0; index < caller_count; index++) {
+            snapshot->lock_count += callers[index].count;
+            for (int bucket = 2; bucket < LOCK_STATS_BUCKET_COUNT; bucket++) {
+                snapshot->lock_contended += callers[index].wait_histogram[bucket];
+            }
+            if (callers[index].max_wait_us > snapshot->lock_max_wait_us) {
+                snapshot->lock_max_wait_us = callers[index].max_wait_us;
+            }
+        }
+    }
+#endif
+}
+
+static uint32_t rate_per_sec(uint32_t delta, int64_t elapsed_us)
+{
+    return elapsed_us > 0 ? (uint32_t)((uint64_t)delta * 1000000 / elapsed_us) : 0;
+}
+
+static void print_counters(const snapshot_t *current, const snapshot_t *previous)
+{
+    static const struct {
+        trace::event_t event;
+        const char *name;
+    } k_rows[] = {
+        {trace::EVENT_ATTRIBUTE_READ, "attribute reads"},
+        {trace::EVENT_ATTRIBUTE_WRITE, "attribute writes"},
+        {trace::EVENT_ATTRIBUTE_UPDATE, "attribute updates"},
+        {trace::EVENT_ATTRIBUTE_REPORT, "attribute reports"},
+        {trace::EVENT_COMMAND, "commands"},
+    };
+    int64_t elapsed_us = current->timestamp_us - previous->timestamp_us;
+    printf("Counters over %" PRIi64 " ms:\n", elapsed_us / 1000);
+    for (size_t row = 0; row < sizeof(k_rows) / sizeof(k_rows[0]); row++) {
+        size_t event = k_rows[row].event;
+        uint32_t delta = current->events[event] - previous->events[event];
+        printf("\t%-18s %8" PRIu32 " (%" PRIu32 "/s), %" PRIu32 " failed, %" PRIu32 " total\n", k_rows[row].name,
+               delta, rate_per_sec(delta, elapsed_us), current->failures[event] - previous->failures[event],
+               current->events[event]);
+    }
+#if CONFIG_ESP_MATTER_ENABLE_LOCK_STATS
+    uint32_t lock_delta = current->lock_count - previous->lock_count;
+    printf("\t%-18s %8" PRIu32 " (%" PRIu32 "/s), %" PRIu32 " waited >= 100 us, max wait %" PRIu32 " us\n",
+           "lock acquisitions", lock_delta, rate_per_sec(lock_delta, elapsed_us),
+           current->lock_contended - previous->lock_contended, current->lock_max_wait_us);
+#else
+    printf("\tlock acquisitions  enable CONFIG_ESP_MATTER_ENABLE_LOCK_STATS\n");
+#endif
+}
+
+static void print_heap()
+{
+    printf("Heap:\n");
+    printf("\t%-10s %10s %10s %10s\n", "class", "free", "min free", "largest");
+    static const struct {
+        uint32_t caps;
+        const char *name;
+    } k_classes[] = {
+        {MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, "internal"},
+        {MALLOC_CAP_DMA, "dma"},
+        {MALLOC_CAP_SPIRAM, "spiram"},
+    };
+    for (size_t index = 0; index < sizeof(k_classes) / sizeof(k_classes[0]); index++) {
+        multi_heap_info_t info;
+        heap_caps_get_info(&info, k_classes[index].caps);
+        if (info.total_free_bytes == 0 && info.total_allocated_bytes == 0) {
+            continue;
+        }
+        printf("\t%-10s %10u %10u %10u\n", k_classes[index].name, (unsigned)info.total_free_bytes,
+               (unsigned)info.minimum_free_bytes, (unsigned)info.largest_free_block);
+    }
+    node_t *node = node::get();
+    memory_stats_t stats;
+    if (node && node::get_memory_stats(node, &stats) == ESP_OK) {
+        printf("\tdata model: structs %u, value buffers %u, bounds %u, default values %u, metadata %u\n",
+               (unsigned)stats.structs, (unsigned)stats.value_buffers, (unsigned)stats.bounds,
+               (unsigned)stats.default_values, (unsigned)stats.metadata);
+    }
+}
+
+static void print_stacks()
+{
+    printf("Stack high-water marks (bytes never used):\n");
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY
+    UBaseType_t task_count = uxTaskGetNumberOfTasks();
+    TaskStatus_t *tasks = (TaskStatus_t *)calloc(task_count, sizeof(TaskStatus_t));
+    if (tasks) {
+        task_count = uxTaskGetSystemState(tasks, task_count, NULL);
+        for (UBaseType_t index = 0; index < task_count; index++) {
+            printf("\t%-16s %6u\n", tasks[index].pcTaskName,
+                   (unsigned)(tasks[index].usStackHighWaterMark * sizeof(StackType_t)));
+        }
+        free(tasks);
+        return;
+    }
+#endif
+    for (size_t index = 0; index < sizeof(k_known_tasks) / sizeof(k_known_tasks[0]); index++) {
+        TaskHandle_t task = xTaskGetHandle(k_known_tasks[index]);
+        if (task) {
+            printf("\t%-16s %6u\n", k_known_tasks[index],
+                   (unsigned)(uxTaskGetStackHighWaterMark(task) * sizeof(StackType_t)));
+        }
+    }
+}
+
+/* Called in the Matter context */
+static void print_read_handlers()
+{
+    InteractionModelEngine *engine = InteractionModelEngine::GetInstance();
+    printf("Read handlers: %u reads, %u subscriptions\n",
+           (unsigned)engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Read),
+           (unsigned)engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe));
+}
+
+/* Called in the Matter context */
+static void print_report(bool deltas)
+{
+    snapshot_t current;
+    take_snapshot(&current);
+    if (deltas) {
+        print_counters(&current, &s_previous);
+    } else {
+        snapshot_t boot = {};
+        print_counters(&current, &boot);
+    }
+    s_previous = current;
+    print_heap();
+    print_stacks();
+    print_read_handlers();
+}
+
+static void watch_timer_cb(chip::System::Layer *layer, void *context)
+{
+    print_report(true);
+    if (s_watch_remaining > 0 && --s_watch_remaining == 0) {
+        s_watch_interval_ms = 0;
+        return;
+    }
+    chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(s_watch_interval_ms),
+                                                watch_timer_cb, nullptr);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_show_handler(int argc, char **argv)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    print_report(false);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+static esp_err_t console_watch_handler(int argc, char **argv)
+{
+    uint32_t interval_ms = argc >= 1 ? strtoul(argv[0], NULL, 10) : 1000;
+    uint32_t count = argc >= 2 ? strtoul(argv[1], NULL, 10) : 0;
+    if (interval_ms < 100) {
+        printf("The interval must be at least 100 ms\n");
+        return ESP_ERR_INVALID_ARG;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    take_snapshot(&s_previous);
+    s_watch_interval_ms = interval_ms;
+    s_watch_remaining = count;
+    chip::DeviceLayer::SystemLayer().CancelTimer(watch_timer_cb, nullptr);
+    CHIP_ERROR err = chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(interval_ms),
+                                                                 watch_timer_cb, nullptr);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err == CHIP_NO_ERROR ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t console_stop_handler(int argc, char **argv)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    chip::DeviceLayer::SystemLayer().CancelTimer(watch_timer_cb, nullptr);
+    s_watch_interval_ms = 0;
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+static esp_matter::console::engine perf_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        perf_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return perf_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "perf",
+        .description = "Attribute and command rates, lock contention, heap, stacks and read handlers. "
+                       "Usage: matter esp perf <show|watch|stop>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t perf_commands[] = {
+        {
+            .name = "show",
+            .description = "Print the counters since boot and the current heap, stacks and read handlers.",
+            .handler = console_show_handler,
+        },
+        {
+            .name = "watch",
+            .description = "Print the counter deltas every interval. Usage: matter esp perf watch [interval_ms] "
+                           "[count], 1000 ms and until stopped by default.",
+            .handler = console_watch_handler,
+        },
+        {
+            .name = "stop",
+            .description = "Stop the periodic printing.",
+            .handler = console_stop_handler,
+        },
+    };
+    perf_console.register_commands(perf_commands, sizeof(perf_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace perf
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_PERF_CONSOLE
@@ -0,0 +1,39 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_trace.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace perf {
+
+/**
+ * @brief Counts an attribute or command event. This is lock-free and can be called from any task.
+ *
+ * It is called by trace::record(), so the events are counted at the same places they are traced.
+ *
+ * @param event  Event
+ * @param status Interaction model status code, 0 for success
+ */
+void count(trace::event_t event, uint8_t status);
+
+/**
+ * @brief Registers the perf console commands.
+ */
+void register_console_commands();
+
+} // namespace perf
+} // namespace esp_matter
@@ -0,0 +1,258 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_pool_stats.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_POOL_STATS
+#include <app/InteractionModelEngine.h>
+#include <app/server/Server.h>
+#include <lwip/stats.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/SystemStats.h>
+
+namespace esp_matter {
+namespace pool_stats {
+
+static const char *TAG = "pool_stats";
+
+static const char *const k_pool_names[POOL_COUNT] = {
+    "packet buffers",
+    "exchanges",
+    "secure sessions",
+    "read handlers",
+    "retransmissions",
+};
+
+/* Only written on the Matter task, the stats are shared with the readers */
+static stats_t s_stats[POOL_COUNT];
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool s_sampling = false;
+
+/* Packet buffers in use and their high-water mark and failures counted on each allocation, false if not counted */
+static bool sample_packet_buffers(uint32_t *in_use, uint32_t *high_water, uint32_t *capacity, uint32_t *failures)
+{
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    *in_use = chip::System::Stats::GetResourcesInUse()[chip::System::Stats::kSystemLayer_NumPacketBufs];
+    *high_water = chip::System::Stats::GetHighWatermarks()[chip::System::Stats::kSystemLayer_NumPacketBufs];
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    *capacity = PBUF_POOL_SIZE;
+#else
+    *capacity = CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE;
+#endif
+    *failures = 0;
+#if LWIP_STATS && MEMP_STATS
+    *failures = lwip_stats.memp[MEMP_PBUF_POOL]->err;
+#endif
+    return true;
+#elif LWIP_STATS && MEMP_STATS
+    const struct stats_mem *pool = lwip_stats.memp[MEMP_PBUF_POOL];
+    *in_use = pool->used;
+    *high_water = pool->max;
+    *capacity = pool->avail;
+    *failures = pool->err;
+    return true;
+#else
+    return false;
+#endif
+}
+
+static uint32_t count_secure_sessions()
+{
+    uint32_t count = 0;
+    chip::Server::GetInstance().GetSecureSessionManager().GetSecureSessions().ForEachSession(
+        [&count](chip::Transport::SecureSession *session) {
+            count++;
+            return chip::Loop::Continue;
+        });
+    return count;
+}
+
+/* Called in the Matter context */
+static void sample()
+{
+    uint32_t in_use[POOL_COUNT] = {};
+    chip::Messaging::ExchangeManager &exchange_manager = chip::Server::GetInstance().GetExchangeManager();
+    uint32_t pbuf_high_water = 0, pbuf_capacity = 0, pbuf_failures = 0;
+    bool pbuf_available = sample_packet_buffers(&in_use[POOL_PACKET_BUFFERS], &pbuf_high_water, &pbuf_capacity,
+                                                &pbuf_failures);
+    in_use[POOL_EXCHANGES] = exchange_manager.GetNumActiveExchanges();
+    in_use[POOL_SECURE_SESSIONS] = count_secure_sessions();
+    in_use[POOL_READ_HANDLERS] = chip::app::InteractionModelEngine::GetInstance()->GetNumActiveReadHandlers();
+    in_use[POOL_RETRANSMISSIONS] = exchange_manager.GetReliableMessageMgr()->TestGetCountRetransTable();
+
+    portENTER_CRITICAL(&s_stats_lock);
+    for (size_t pool = 0; pool < POOL_COUNT; pool++) {
+        s_stats[pool].in_use = in_use[pool];
+        if (in_use[pool] > s_stats[pool].high_water) {
+            s_stats[pool].high_water = in_use[pool];
+        }
+    }
+    stats_t &pbufs = s_stats[POOL_PACKET_BUFFERS];
+    pbufs.available = pbuf_available;
+    pbufs.capacity = pbuf_capacity;
+    if (pbuf_high_water > pbufs.high_water) {
+        pbufs.high_water = pbuf_high_water;
+    }
+    pbufs.failures = pbuf_failures;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+static void sample_timer_cb(chip::System::Layer *layer, void *context)
+{
+    sample();
+    chip::DeviceLayer::SystemLayer().StartTimer(
+        chip::System::Clock::Milliseconds32(CONFIG_ESP_MATTER_POOL_STATS_SAMPLE_INTERVAL_MS), sample_timer_cb, nullptr);
+}
+
+void init()
+{
+    s_stats[POOL_EXCHANGES] = {.available = true, .capacity = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS};
+    s_stats[POOL_SECURE_SESSIONS] = {.available = true, .capacity = CHIP_CONFIG_SECURE_SESSION_POOL_SIZE};
+    s_stats[POOL_READ_HANDLERS] = {.available = true,
+                                   .capacity = CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS};
+    s_stats[POOL_RETRANSMISSIONS] = {.available = true, .capacity = CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE};
+    sample();
+    CHIP_ERROR err = chip::DeviceLayer::SystemLayer().StartTimer(
+        chip::System::Clock::Milliseconds32(CONFIG_ESP_MATTER_POOL_STATS_SAMPLE_INTERVAL_MS), sample_timer_cb, nullptr);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the pool sampling timer, err:%" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    s_sampling = true;
+}
+
+esp_err_t get_stats(pool_t pool, stats_t *stats)
+{
+    if (pool >= POOL_COUNT || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats[pool];
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    for (size_t pool = 0; pool < POOL_COUNT; pool++) {
+        s_stats[pool].high_water = s_stats[pool].in_use;
+        s_stats[pool].failures = 0;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    chip::System::Stats::GetHighWatermarks()[chip::System::Stats::kSystemLayer_NumPacketBufs] =
+        s_stats[POOL_PACKET_BUFFERS].in_use;
+#endif
+#if LWIP_STATS && MEMP_STATS
+    lwip_stats.memp[MEMP_PBUF_POOL]->max = lwip_stats.memp[MEMP_PBUF_POOL]->used;
+    lwip_stats.memp[MEMP_PBUF_POOL]->err = 0;
+#endif
+}
+
+void print_stats()
+{
+    if (!s_sampling) {
+        printf("The pools are sampled once the server is started\n");
+        return;
+    }
+    printf("Pool\t\t\tIn use\tHigh-water\tCapacity\tFailures\n");
+    for (size_t pool = 0; pool < POOL_COUNT; pool++) {
+        stats_t stats;
+        get_stats((pool_t)pool, &stats);
+        if (!stats.available) {
+            printf("%-16s\tnot counted in this build\n", k_pool_names[pool]);
+            continue;
+        }
+        printf("%-16s\t%" PRIu32 "\t%" PRIu32 "\t\t%" PRIu32 "\t\t%" PRIu32 "\n", k_pool_names[pool], stats.in_use,
+               stats.high_water, stats.capacity, stats.failures);
+    }
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    /* The SDK and lwIP counters of the packet buffers are updated in the Matter context */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    reset_stats();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+static esp_matter::console::engine pool_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        pool_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return pool_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "pools",
+        .description = "Matter stack pool usage. Usage: matter esp pools <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t pool_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the entries in use, the high-water mark and the capacity of each pool.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the high-water marks to the current usage.",
+            .handler = console_reset_handler,
+        },
+    };
+    pool_console.register_commands(pool_commands, sizeof(pool_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace pool_stats
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_POOL_STATS
@@ -0,0 +1,35 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_POOL_STATS
+namespace esp_matter {
+namespace pool_stats {
+
+/**
+ * @brief Starts sampling the pools, called in the Matter context once the server is initialized.
+ */
+void init();
+
+/**
+ * @brief Registers the pool console commands.
+ */
+void register_console_commands();
+
+} // namespace pool_stats
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_POOL_STATS
@@ -0,0 +1,100 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_matter_icd_report_batching.h>
+#include <esp_matter_report_priority.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_REPORT_PRIORITY
+#include <app/reporting/reporting.h>
+#include <platform/CHIPDeviceLayer.h>
+
+namespace esp_matter {
+namespace report_priority {
+
+static const char *TAG = "report_priority";
+
+typedef struct {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+} deferred_path_t;
+
+/* Everything below is only accessed with the chip stack lock */
+static deferred_path_t s_deferred_paths[CONFIG_ESP_MATTER_BULK_REPORT_MAX_PATHS];
+static size_t s_deferred_count = 0;
+
+static void report_path(const deferred_path_t *path)
+{
+#if CONFIG_ESP_MATTER_ICD_REPORT_BATCHING
+    endpoint_t *endpoint = endpoint::get(node::get(), path->endpoint_id);
+    attribute_t *attribute = attribute::get(cluster::get(endpoint, path->cluster_id), path->attribute_id);
+    if (icd_report_batching::hold(attribute, path->endpoint_id, path->cluster_id, path->attribute_id)) {
+        return;
+    }
+#endif
+    MatterReportingAttributeChangeCallback(path->endpoint_id, path->cluster_id, path->attribute_id);
+}
+
+static void deferred_report_timer(chip::System::Layer *layer, void *context)
+{
+    flush();
+}
+
+void flush()
+{
+    if (s_deferred_count == 0) {
+        return;
+    }
+    chip::DeviceLayer::SystemLayer().CancelTimer(deferred_report_timer, nullptr);
+    ESP_LOGD(TAG, "Reporting %u deferred attributes", (unsigned)s_deferred_count);
+    /* The reporting engine runs after the lock is released, so all the paths go out in the same reporting pass */
+    for (size_t idx = 0; idx < s_deferred_count; ++idx) {
+        report_path(&s_deferred_paths[idx]);
+    }
+    s_deferred_count = 0;
+}
+
+bool defer(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    if (!attribute || !(attribute::get_flags(attribute) & ATTRIBUTE_FLAG_BULK_REPORT)) {
+        return false;
+    }
+    for (size_t idx = 0; idx < s_deferred_count; ++idx) {
+        if (s_deferred_paths[idx].endpoint_id == endpoint_id && s_deferred_paths[idx].cluster_id == cluster_id &&
+            s_deferred_paths[idx].attribute_id == attribute_id) {
+            return true;
+        }
+    }
+    if (s_deferred_count == CONFIG_ESP_MATTER_BULK_REPORT_MAX_PATHS) {
+        ESP_LOGW(TAG, "Deferred reports full, reporting them now");
+        flush();
+    }
+    if (s_deferred_count == 0) {
+        /* The delay runs from the first deferred report, the later ones are coalesced with it */
+        if (chip::DeviceLayer::SystemLayer().StartTimer(
+                chip::System::Clock::Milliseconds32(CONFIG_ESP_MATTER_BULK_REPORT_DELAY_MS), deferred_report_timer,
+                nullptr) != CHIP_NO_ERROR) {
+            return false;
+        }
+    }
+    s_deferred_paths[s_deferred_count++] = {endpoint_id, cluster_id, attribute_id};
+    return true;
+}
+
+} // namespace report_priority
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_REPORT_PRIORITY
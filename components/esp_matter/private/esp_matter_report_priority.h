@@ -0,0 +1,48 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace report_priority {
+
+#if CONFIG_ESP_MATTER_ENABLE_REPORT_PRIORITY
+/**
+ * @brief Defers the report of a changed bulk attribute, called with the chip stack lock.
+ *
+ * The reports of the attributes with ATTRIBUTE_FLAG_BULK_REPORT are held for
+ * CONFIG_ESP_MATTER_BULK_REPORT_DELAY_MS from the first one, and their paths are then marked dirty together, so the
+ * bulk telemetry is coalesced in one report and does not delay the reports of the other attributes.
+ *
+ * @param attribute    Attribute handle
+ * @param endpoint_id  Endpoint ID of the attribute
+ * @param cluster_id   Cluster ID of the attribute
+ * @param attribute_id Attribute ID
+ *
+ * @return true if the report is deferred, false if the caller reports it now
+ */
+bool defer(attribute_t *attribute, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+/**
+ * @brief Marks all the deferred paths dirty now, called with the chip stack lock.
+ */
+void flush();
+#endif // CONFIG_ESP_MATTER_ENABLE_REPORT_PRIORITY
+
+} // namespace report_priority
+} // namespace esp_matter
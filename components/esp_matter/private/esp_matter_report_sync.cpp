@@ -0,0 +1,168 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_matter_core.h>
+#include <esp_matter_report_sync.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_SYNCHRONIZED_REPORTS
+#include <app/ReadHandler.h>
+#include <app/TimerDelegates.h>
+#include <app/reporting/SynchronizedReportSchedulerImpl.h>
+
+namespace esp_matter {
+namespace report_sync {
+
+/* The reports of a timer wake are generated by the same run of the reporting engine, a report sent this long after
+ * the previous one is counted in the same wake window */
+static constexpr int64_t k_wake_window_us = CONFIG_ESP_MATTER_SYNCHRONIZED_REPORTS_WAKE_WINDOW_MS * 1000;
+
+/* The reports are counted on the Matter task, only the stats are shared with the readers */
+static int64_t s_last_report_us = 0;
+static stats_t s_stats;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* The SDK scheduler picks, for every subscription, the earliest time which is within the min and max intervals of as
+ * many subscriptions as possible, and fires a single timer for all of them. This one only counts what it saves. */
+class counting_scheduler : public chip::app::reporting::SynchronizedReportSchedulerImpl {
+public:
+    counting_scheduler(chip::app::reporting::TimerDelegate *timer_delegate)
+        : SynchronizedReportSchedulerImpl(timer_delegate)
+    {
+    }
+
+    void TimerFired() override
+    {
+        portENTER_CRITICAL(&s_stats_lock);
+        s_stats.timer_wakes++;
+        portEXIT_CRITICAL(&s_stats_lock);
+        SynchronizedReportSchedulerImpl::TimerFired();
+    }
+
+    void OnSubscriptionReportSent(chip::app::ReadHandler *read_handler) override
+    {
+        int64_t now_us = esp_timer_get_time();
+        bool same_window = s_last_report_us != 0 && now_us - s_last_report_us < k_wake_window_us;
+        s_last_report_us = now_us;
+        portENTER_CRITICAL(&s_stats_lock);
+        s_stats.reports_sent++;
+        if (same_window) {
+            s_stats.wakes_saved++;
+        } else {
+            s_stats.report_windows++;
+        }
+        portEXIT_CRITICAL(&s_stats_lock);
+        SynchronizedReportSchedulerImpl::OnSubscriptionReportSent(read_handler);
+    }
+};
+
+chip::app::reporting::ReportScheduler *get_scheduler()
+{
+    static chip::app::DefaultTimerDelegate s_timer_delegate;
+    static counting_scheduler s_scheduler(&s_timer_delegate);
+    return &s_scheduler;
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats = {};
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    stats_t stats;
+    get_stats(&stats);
+    printf("Timer wakes: %" PRIu32 ", reports sent: %" PRIu32 ", report windows: %" PRIu32 ", wakes saved: %" PRIu32
+           "\n", stats.timer_wakes, stats.reports_sent, stats.report_windows, stats.wakes_saved);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine report_sync_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        report_sync_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return report_sync_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "reports",
+        .description = "Synchronized report statistics. Usage: matter esp reports <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t report_sync_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the number of reports sent and the wakes saved by sending them together.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the synchronized report statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    report_sync_console.register_commands(report_sync_commands,
+                                          sizeof(report_sync_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace report_sync
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_SYNCHRONIZED_REPORTS
@@ -0,0 +1,40 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_SYNCHRONIZED_REPORTS
+#include <app/reporting/ReportScheduler.h>
+
+namespace esp_matter {
+namespace report_sync {
+
+/**
+ * @brief Returns the report scheduler which aligns the reports of all the subscriptions, set in the server init
+ *        parameters before the server init.
+ *
+ * @return Report scheduler
+ */
+chip::app::reporting::ReportScheduler *get_scheduler();
+
+/**
+ * @brief Registers the synchronized report console commands.
+ */
+void register_console_commands();
+
+} // namespace report_sync
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_SYNCHRONIZED_REPORTS
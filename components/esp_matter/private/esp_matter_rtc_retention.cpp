@@ -0,0 +1,234 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_attr.h>
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_rom_crc.h>
+#include <esp_system.h>
+#include <inttypes.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_rtc_retention.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
+
+#if CONFIG_ESP_MATTER_ENABLE_RTC_RETENTION
+
+namespace esp_matter {
+namespace rtc_retention {
+
+static const char *TAG = "mtr_rtc_retention";
+
+constexpr uint32_t k_magic = 0x52524D45; /* "EMRR" */
+constexpr size_t k_area_size = CONFIG_ESP_MATTER_RTC_RETENTION_SIZE;
+
+typedef struct area_header {
+    uint32_t magic;
+    uint32_t used;
+    uint32_t crc;
+} area_header_t;
+
+/* The records are packed in the area, each one is padded to 4 bytes */
+typedef struct record {
+    uint16_t endpoint_id;
+    uint8_t type;
+    uint8_t len;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint8_t data[];
+} record_t;
+
+typedef enum state {
+    STATE_NONE = 0,
+    STATE_READY,
+} state_t;
+
+/* Not initialized at boot, the content is only trusted after a wake from deep sleep */
+static RTC_NOINIT_ATTR area_header_t s_header;
+static RTC_NOINIT_ATTR uint32_t s_area[k_area_size / sizeof(uint32_t)];
+static state_t s_state = STATE_NONE;
+
+static uint8_t *area()
+{
+    return (uint8_t *)s_area;
+}
+
+static size_t record_size(uint8_t len)
+{
+    return (sizeof(record_t) + len + 3) & ~(size_t)3;
+}
+
+static uint32_t compute_crc()
+{
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)&s_header, offsetof(area_header_t, crc));
+    return esp_rom_crc32_le(crc, area(), s_header.used);
+}
+
+static void clear()
+{
+    s_header.magic = k_magic;
+    s_header.used = 0;
+    s_header.crc = compute_crc();
+}
+
+static void init()
+{
+    if (s_state != STATE_NONE) {
+        return;
+    }
+    s_state = STATE_READY;
+    bool valid = s_header.magic == k_magic && s_header.used <= sizeof(s_area) && s_header.crc == compute_crc();
+    if (esp_reset_reason() == ESP_RST_DEEPSLEEP && valid) {
+        ESP_LOGI(TAG, "Resuming with %" PRIu32 " bytes of retained attribute values", s_header.used);
+        return;
+    }
+    /* After any other reset the values are read from the persistent storage again, and retained as they are */
+    clear();
+}
+
+static record_t *find(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    size_t offset = 0;
+    while (offset < s_header.used) {
+        record_t *record = (record_t *)(area() + offset);
+        if (record->endpoint_id == endpoint_id && record->cluster_id == cluster_id &&
+            record->attribute_id == attribute_id) {
+            return record;
+        }
+        offset += record_size(record->len);
+    }
+    return NULL;
+}
+
+static void remove(record_t *record)
+{
+    size_t offset = (uint8_t *)record - area();
+    size_t size = record_size(record->len);
+    memmove(area() + offset, area() + offset + size, s_header.used - offset - size);
+    s_header.used -= size;
+}
+
+static bool is_string(const esp_matter_attr_val_t & val)
+{
+    switch (val.type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING:
+    case ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool is_supported(const esp_matter_attr_val_t & val)
+{
+    switch (val.type & ~ESP_MATTER_VAL_NULLABLE_BASE) {
+    case ESP_MATTER_VAL_TYPE_INVALID:
+    case ESP_MATTER_VAL_TYPE_ARRAY:
+        return false;
+    default:
+        return !is_string(val) || (val.val.a.b && val.val.a.s <= UINT8_MAX);
+    }
+}
+
+esp_err_t store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t & val)
+{
+    if (!is_supported(val)) {
+        erase(endpoint_id, cluster_id, attribute_id);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    init();
+    /* The fixed size values all fit in the first 8 bytes of the union */
+    const uint8_t *data = is_string(val) ? val.val.a.b : (const uint8_t *)&val.val;
+    uint8_t len = is_string(val) ? (uint8_t)val.val.a.s : sizeof(val.val.u64);
+
+    record_t *record = find(endpoint_id, cluster_id, attribute_id);
+    if (record && record->len == len && record->type == val.type) {
+        if (memcmp(record->data, data, len) == 0) {
+            return ESP_OK;
+        }
+    } else {
+        if (record) {
+            remove(record);
+        }
+        if (s_header.used + record_size(len) > sizeof(s_area)) {
+            s_header.crc = compute_crc();
+            ESP_LOGW(TAG, "RTC retention area full, the attribute 0x%08" PRIx32 " is read from flash on resume",
+                     attribute_id);
+            return ESP_ERR_NO_MEM;
+        }
+        record = (record_t *)(area() + s_header.used);
+        record->endpoint_id = endpoint_id;
+        record->cluster_id = cluster_id;
+        record->attribute_id = attribute_id;
+        record->type = (uint8_t)val.type;
+        record->len = len;
+        s_header.used += record_size(len);
+    }
+    memcpy(record->data, data, len);
+    s_header.crc = compute_crc();
+    return ESP_OK;
+}
+
+esp_err_t get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t & val)
+{
+    init();
+    record_t *record = find(endpoint_id, cluster_id, attribute_id);
+    if (!record) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (record->type != (uint8_t)val.type) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (is_string(val)) {
+        // Same as the NVS read, the size of the attribute value is not decreased
+        size_t len = std::max((size_t)record->len, static_cast<size_t>(val.val.a.s));
+        uint8_t *buffer = (uint8_t *)esp_matter_mem_calloc(1, len ? len : 1);
+        if (!buffer) {
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(buffer, record->data, record->len);
+        val.val.a.b = buffer;
+        val.val.a.n = len;
+        val.val.a.t = len + (val.val.a.t - val.val.a.s);
+        val.val.a.s = len;
+    } else {
+        memcpy(&val.val, record->data, record->len);
+    }
+    return ESP_OK;
+}
+
+void erase(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    init();
+    record_t *record = find(endpoint_id, cluster_id, attribute_id);
+    if (record) {
+        remove(record);
+        s_header.crc = compute_crc();
+    }
+}
+
+void erase_all()
+{
+    init();
+    clear();
+}
+
+} // namespace rtc_retention
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_RTC_RETENTION
@@ -0,0 +1,88 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_attribute_utils.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace rtc_retention {
+
+/*
+ * Copy of the non-volatile attribute values in the RTC memory.
+ *
+ * The values read from or written to the persistent storage are mirrored in a CRC protected area of the RTC memory,
+ * which is kept in deep sleep. On a wake from deep sleep the values are served from it, without reading the flash.
+ * After any other reset, the area is cleared and filled again as the attributes are created.
+ */
+
+#if CONFIG_ESP_MATTER_ENABLE_RTC_RETENTION
+/**
+ * @brief Checks if the value can be retained. The fixed size values and the strings up to 255 bytes are supported.
+ *
+ * @param val Attribute value
+ */
+bool is_supported(const esp_matter_attr_val_t & val);
+
+/**
+ * @brief Copies the attribute value in the RTC memory. The value is not retained if the area is full.
+ *
+ * @param endpoint_id  Endpoint Id
+ * @param cluster_id   Cluster Id
+ * @param attribute_id Attribute Id
+ * @param val          Attribute value
+ *
+ * @return ESP_OK on success, ESP_ERR_NO_MEM if the area is full, appropriate error code otherwise
+ */
+esp_err_t store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, const esp_matter_attr_val_t & val);
+
+/**
+ * @brief Gets the retained attribute value, only after a wake from deep sleep.
+ *
+ * @param endpoint_id  Endpoint Id
+ * @param cluster_id   Cluster Id
+ * @param attribute_id Attribute Id
+ * @param val          Attribute value, its type must be set and match the retained one
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the attribute is not retained, appropriate error code otherwise
+ */
+esp_err_t get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t & val);
+
+/**
+ * @brief Drops the retained attribute value.
+ *
+ * @param endpoint_id  Endpoint Id
+ * @param cluster_id   Cluster Id
+ * @param attribute_id Attribute Id
+ */
+void erase(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+/**
+ * @brief Drops all the retained values.
+ */
+void erase_all();
+#else
+inline bool is_supported(const esp_matter_attr_val_t & val) { return false; }
+inline esp_err_t store(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                       const esp_matter_attr_val_t & val) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t get(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                     esp_matter_attr_val_t & val) { return ESP_ERR_NOT_FOUND; }
+inline void erase(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) {}
+inline void erase_all() {}
+#endif // CONFIG_ESP_MATTER_ENABLE_RTC_RETENTION
+
+} // namespace rtc_retention
+} // namespace esp_matter
@@ -0,0 +1,498 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_scene_storage.h>
+#include <nvs.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
+#include <esp_matter_attribute_utils.h>
+#include <app/CommandHandlerInterface.h>
+#include <app/InteractionModelEngine.h>
+#include <app/clusters/scenes-server/scenes-server.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_STORAGE || CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
+
+static const char *TAG = "esp_matter_scene_storage";
+
+namespace esp_matter {
+
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
+namespace attribute {
+extern void execute_scene_recall_callback(callback_type_t type, uint16_t endpoint_id);
+} // namespace attribute
+#endif
+
+namespace scene_storage {
+
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_STORAGE
+#define ESP_MATTER_NVS_PART_NAME CONFIG_ESP_MATTER_NVS_PART_NAME
+#define SCENE_STORAGE_NAMESPACE "esp_matter_sc"
+
+constexpr uint32_t k_blob_magic = 0x4E435345; /* "ESCN" */
+constexpr uint8_t k_blob_version = 1;
+
+/* Identical scene values are stored once per fabric */
+typedef struct scene_value {
+    struct scene_value *next;
+    uint16_t ref_count;
+    uint16_t size;
+    /* Followed by the value written by the scenes server */
+} scene_value_t;
+
+typedef struct scene_entry {
+    struct scene_entry *next;
+    uint16_t endpoint_id;
+    uint16_t index;
+    scene_value_t *value;
+} scene_entry_t;
+
+typedef struct fabric_scenes {
+    struct fabric_scenes *next;
+    uint8_t fabric_index;
+    scene_entry_t *entries;
+    scene_value_t *values;
+} fabric_scenes_t;
+
+/* Blob of a fabric: the header, the values and then the entries, little endian */
+typedef struct __attribute__((packed)) blob_header {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t value_count;
+    uint16_t entry_count;
+} blob_header_t;
+
+typedef struct __attribute__((packed)) blob_entry {
+    uint16_t endpoint_id;
+    uint16_t index;
+    uint16_t value_index;
+} blob_entry_t;
+
+static fabric_scenes_t *s_fabrics = NULL;
+
+static uint8_t *get_value_data(scene_value_t *value)
+{
+    return (uint8_t *)(value + 1);
+}
+
+static bool parse_scene_key(const char *key, uint8_t *fabric_index, uint16_t *endpoint_id, uint16_t *index)
+{
+    /* Key of a scene of the scene table of the SDK: "f/<fabric>/e/<endpoint>/sc/<index>" */
+    unsigned int fabric = 0, endpoint = 0, scene_index = 0;
+    int consumed = 0;
+    if (strncmp(key, "f/", 2) != 0 ||
+        sscanf(key, "f/%x/e/%x/sc/%x%n", &fabric, &endpoint, &scene_index, &consumed) != 3 || key[consumed] != '\0') {
+        return false;
+    }
+    if (fabric > UINT8_MAX || endpoint > UINT16_MAX || scene_index > UINT16_MAX) {
+        return false;
+    }
+    *fabric_index = (uint8_t)fabric;
+    *endpoint_id = (uint16_t)endpoint;
+    *index = (uint16_t)scene_index;
+    return true;
+}
+
+static void get_blob_key(uint8_t fabric_index, char *key, size_t key_size)
+{
+    snprintf(key, key_size, "f%02x", fabric_index);
+}
+
+static scene_value_t *acquire_value(fabric_scenes_t *fabric, const uint8_t *data, uint16_t size)
+{
+    for (scene_value_t *value = fabric->values; value; value = value->next) {
+        if (value->size == size && value->ref_count < UINT16_MAX && memcmp(get_value_data(value), data, size) == 0) {
+            value->ref_count++;
+            return value;
+        }
+    }
+    scene_value_t *value = (scene_value_t *)esp_matter_mem_calloc(1, sizeof(scene_value_t) + size);
+    if (!value) {
+        return NULL;
+    }
+    memcpy(get_value_data(value), data, size);
+    value->size = size;
+    value->ref_count = 1;
+    value->next = fabric->values;
+    fabric->values = value;
+    return value;
+}
+
+static void release_value(fabric_scenes_t *fabric, scene_value_t *value)
+{
+    if (--value->ref_count > 0) {
+        return;
+    }
+    for (scene_value_t **link = &fabric->values; *link; link = &(*link)->next) {
+        if (*link == value) {
+            *link = value->next;
+            esp_matter_mem_free(value);
+            return;
+        }
+    }
+}
+
+static bool add_entry(fabric_scenes_t *fabric, uint16_t endpoint_id, uint16_t index, scene_value_t *value)
+{
+    scene_entry_t *entry = (scene_entry_t *)esp_matter_mem_calloc(1, sizeof(scene_entry_t));
+    if (!entry) {
+        return false;
+    }
+    entry->endpoint_id = endpoint_id;
+    entry->index = index;
+    entry->value = value;
+    entry->next = fabric->entries;
+    fabric->entries = entry;
+    return true;
+}
+
+static scene_entry_t **find_entry(fabric_scenes_t *fabric, uint16_t endpoint_id, uint16_t index)
+{
+    scene_entry_t **link = &fabric->entries;
+    for (; *link; link = &(*link)->next) {
+        if ((*link)->endpoint_id == endpoint_id && (*link)->index == index) {
+            break;
+        }
+    }
+    return link;
+}
+
+static void clear_fabric(fabric_scenes_t *fabric)
+{
+    while (fabric->entries) {
+        scene_entry_t *entry = fabric->entries;
+        fabric->entries = entry->next;
+        release_value(fabric, entry->value);
+        esp_matter_mem_free(entry);
+    }
+}
+
+static void parse_blob(fabric_scenes_t *fabric, const uint8_t *blob, size_t blob_size)
+{
+    blob_header_t header;
+    if (blob_size < sizeof(header)) {
+        ESP_LOGE(TAG, "Scene blob of fabric %u is truncated", fabric->fabric_index);
+        return;
+    }
+    memcpy(&header, blob, sizeof(header));
+    if (header.magic != k_blob_magic || header.version != k_blob_version) {
+        ESP_LOGE(TAG, "Scene blob of fabric %u has an unknown format", fabric->fabric_index);
+        return;
+    }
+    scene_value_t **values = (scene_value_t **)esp_matter_mem_calloc(header.value_count ? header.value_count : 1,
+                                                                     sizeof(scene_value_t *));
+    if (!values) {
+        ESP_LOGE(TAG, "Could not allocate the values of the scene blob");
+        return;
+    }
+    size_t offset = sizeof(header);
+    bool valid = true;
+    for (uint16_t value_index = 0; valid && value_index < header.value_count; value_index++) {
+        uint16_t size = 0;
+        if (offset + sizeof(size) > blob_size) {
+            valid = false;
+            break;
+        }
+        memcpy(&size, blob + offset, sizeof(size));
+        offset += sizeof(size);
+        if (offset + size > blob_size) {
+            valid = false;
+            break;
+        }
+        /* The values of the blob are unique, acquiring them only adds them */
+        values[value_index] = acquire_value(fabric, blob + offset, size);
+        valid = values[value_index] != NULL;
+        offset += size;
+    }
+    for (uint16_t entry_index = 0; valid && entry_index < header.entry_count; entry_index++) {
+        blob_entry_t blob_entry;
+        if (offset + sizeof(blob_entry) > blob_size) {
+            valid = false;
+            break;
+        }
+        memcpy(&blob_entry, blob + offset, sizeof(blob_entry));
+        offset += sizeof(blob_entry);
+        if (blob_entry.value_index >= header.value_count) {
+            valid = false;
+            break;
+        }
+        scene_value_t *value = values[blob_entry.value_index];
+        value->ref_count++;
+        valid = add_entry(fabric, blob_entry.endpoint_id, blob_entry.index, value);
+        if (!valid) {
+            value->ref_count--;
+        }
+    }
+    /* Drop the references taken while adding the values, only the entries hold them now */
+    for (uint16_t value_index = 0; value_index < header.value_count; value_index++) {
+        if (values[value_index]) {
+            release_value(fabric, values[value_index]);
+        }
+    }
+    esp_matter_mem_free(values);
+    if (!valid) {
+        ESP_LOGE(TAG, "Scene blob of fabric %u is corrupted", fabric->fabric_index);
+        clear_fabric(fabric);
+    }
+}
+
+static fabric_scenes_t *get_fabric(uint8_t fabric_index)
+{
+    for (fabric_scenes_t *fabric = s_fabrics; fabric; fabric = fabric->next) {
+        if (fabric->fabric_index == fabric_index) {
+            return fabric;
+        }
+    }
+    fabric_scenes_t *fabric = (fabric_scenes_t *)esp_matter_mem_calloc(1, sizeof(fabric_scenes_t));
+    if (!fabric) {
+        ESP_LOGE(TAG, "Could not allocate the scenes of fabric %u", fabric_index);
+        return NULL;
+    }
+    fabric->fabric_index = fabric_index;
+
+    /* Load the blob of the fabric the first time it is used */
+    nvs_handle_t handle;
+    if (nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, SCENE_STORAGE_NAMESPACE, NVS_READONLY, &handle) ==
+        ESP_OK) {
+        char key[8];
+        get_blob_key(fabric_index, key, sizeof(key));
+        size_t blob_size = 0;
+        if (nvs_get_blob(handle, key, NULL, &blob_size) == ESP_OK && blob_size > 0) {
+            uint8_t *blob = (uint8_t *)esp_matter_mem_calloc(1, blob_size);
+            if (blob && nvs_get_blob(handle, key, blob, &blob_size) == ESP_OK) {
+                parse_blob(fabric, blob, blob_size);
+            }
+            esp_matter_mem_free(blob);
+        }
+        nvs_close(handle);
+    }
+    fabric->next = s_fabrics;
+    s_fabrics = fabric;
+    return fabric;
+}
+
+static CHIP_ERROR save_fabric(fabric_scenes_t *fabric)
+{
+    uint16_t value_count = 0;
+    uint16_t entry_count = 0;
+    size_t blob_size = sizeof(blob_header_t);
+    for (scene_value_t *value = fabric->values; value; value = value->next) {
+        value_count++;
+        blob_size += sizeof(uint16_t) + value->size;
+    }
+    for (scene_entry_t *entry = fabric->entries; entry; entry = entry->next) {
+        entry_count++;
+        blob_size += sizeof(blob_entry_t);
+    }
+
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, SCENE_STORAGE_NAMESPACE, NVS_READWRITE,
+                                            &handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open the scene storage namespace, err:%d", err);
+        return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+    char key[8];
+    get_blob_key(fabric->fabric_index, key, sizeof(key));
+    if (entry_count == 0) {
+        err = nvs_erase_key(handle, key);
+        err = err == ESP_ERR_NVS_NOT_FOUND ? ESP_OK : err;
+    } else {
+        uint8_t *blob = (uint8_t *)esp_matter_mem_calloc(1, blob_size);
+        if (!blob) {
+            nvs_close(handle);
+            return CHIP_ERROR_NO_MEMORY;
+        }
+        blob_header_t header = {
+            .magic = k_blob_magic,
+            .version = k_blob_version,
+            .reserved = 0,
+            .value_count = value_count,
+            .entry_count = entry_count,
+        };
+        memcpy(blob, &header, sizeof(header));
+        size_t offset = sizeof(header);
+        for (scene_value_t *value = fabric->values; value; value = value->next) {
+            memcpy(blob + offset, &value->size, sizeof(value->size));
+            offset += sizeof(value->size);
+            memcpy(blob + offset, get_value_data(value), value->size);
+            offset += value->size;
+        }
+        for (scene_entry_t *entry = fabric->entries; entry; entry = entry->next) {
+            /* The values are referenced by their position in the blob */
+            uint16_t value_index = 0;
+            for (scene_value_t *value = fabric->values; value != entry->value; value = value->next) {
+                value_index++;
+            }
+            blob_entry_t blob_entry = {
+                .endpoint_id = entry->endpoint_id,
+                .index = entry->index,
+                .value_index = value_index,
+            };
+            memcpy(blob + offset, &blob_entry, sizeof(blob_entry));
+            offset += sizeof(blob_entry);
+        }
+        err = nvs_set_blob(handle, key, blob, blob_size);
+        esp_matter_mem_free(blob);
+    }
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store the scenes of fabric %u, err:%d", fabric->fabric_index, err);
+        return CHIP_ERROR_PERSISTED_STORAGE_FAILED;
+    }
+    return CHIP_NO_ERROR;
+}
+
+class scene_storage_delegate : public chip::PersistentStorageDelegate {
+public:
+    void set_storage(chip::PersistentStorageDelegate *storage) { m_storage = storage; }
+
+    CHIP_ERROR SyncGetKeyValue(const char *key, void *buffer, uint16_t &size)
+    {
+        uint8_t fabric_index;
+        uint16_t endpoint_id, index;
+        fabric_scenes_t *fabric;
+        if (!parse_scene_key(key, &fabric_index, &endpoint_id, &index) || !(fabric = get_fabric(fabric_index))) {
+            return m_storage->SyncGetKeyValue(key, buffer, size);
+        }
+        scene_entry_t *entry = *find_entry(fabric, endpoint_id, index);
+        if (!entry) {
+            /* Stored before the compact storage was enabled */
+            return m_storage->SyncGetKeyValue(key, buffer, size);
+        }
+        uint16_t copy_size = entry->value->size < size ? entry->value->size : size;
+        if (copy_size > 0) {
+            memcpy(buffer, get_value_data(entry->value), copy_size);
+        }
+        CHIP_ERROR err = copy_size < entry->value->size ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+        size = copy_size;
+        return err;
+    }
+
+    CHIP_ERROR SyncSetKeyValue(const char *key, const void *value, uint16_t size)
+    {
+        uint8_t fabric_index;
+        uint16_t endpoint_id, index;
+        fabric_scenes_t *fabric;
+        if (!parse_scene_key(key, &fabric_index, &endpoint_id, &index) || !(fabric = get_fabric(fabric_index))) {
+            return m_storage->SyncSetKeyValue(key, value, size);
+        }
+        scene_value_t *new_value = acquire_value(fabric, (const uint8_t *)value, size);
+        if (!new_value) {
+            return CHIP_ERROR_NO_MEMORY;
+        }
+        scene_entry_t *entry = *find_entry(fabric, endpoint_id, index);
+        if (entry) {
+            release_value(fabric, entry->value);
+            entry->value = new_value;
+        } else if (!add_entry(fabric, endpoint_id, index, new_value)) {
+            release_value(fabric, new_value);
+            return CHIP_ERROR_NO_MEMORY;
+        }
+        CHIP_ERROR err = save_fabric(fabric);
+        if (err == CHIP_NO_ERROR && !entry) {
+            /* Drop the copy stored before the compact storage was enabled, if any */
+            m_storage->SyncDeleteKeyValue(key);
+        }
+        return err;
+    }
+
+    CHIP_ERROR SyncDeleteKeyValue(const char *key)
+    {
+        uint8_t fabric_index;
+        uint16_t endpoint_id, index;
+        fabric_scenes_t *fabric;
+        if (!parse_scene_key(key, &fabric_index, &endpoint_id, &index) || !(fabric = get_fabric(fabric_index))) {
+            return m_storage->SyncDeleteKeyValue(key);
+        }
+        scene_entry_t **link = find_entry(fabric, endpoint_id, index);
+        CHIP_ERROR err = m_storage->SyncDeleteKeyValue(key);
+        if (!*link) {
+            return err;
+        }
+        scene_entry_t *entry = *link;
+        *link = entry->next;
+        release_value(fabric, entry->value);
+        esp_matter_mem_free(entry);
+        return save_fabric(fabric);
+    }
+
+private:
+    chip::PersistentStorageDelegate *m_storage = nullptr;
+};
+
+static scene_storage_delegate s_storage_delegate;
+
+chip::PersistentStorageDelegate *wrap(chip::PersistentStorageDelegate *storage)
+{
+    if (!storage) {
+        return storage;
+    }
+    s_storage_delegate.set_storage(storage);
+    return &s_storage_delegate;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_SCENE_STORAGE
+
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
+using chip::app::Clusters::ScenesManagement::ScenesServer;
+
+/* Forwards the commands to the scenes server, and notifies the application around the recalls */
+class scene_recall_handler : public chip::app::CommandHandlerInterface {
+public:
+    scene_recall_handler() : chip::app::CommandHandlerInterface(chip::NullOptional,
+                                                                chip::app::Clusters::ScenesManagement::Id) {}
+
+    void InvokeCommand(HandlerContext &ctx)
+    {
+        bool recall = ctx.mRequestPath.mCommandId == chip::app::Clusters::ScenesManagement::Commands::RecallScene::Id;
+        if (recall) {
+            attribute::execute_scene_recall_callback(attribute::SCENE_RECALL_BEGIN, ctx.mRequestPath.mEndpointId);
+        }
+        static_cast<chip::app::CommandHandlerInterface &>(ScenesServer::Instance()).InvokeCommand(ctx);
+        if (recall) {
+            attribute::execute_scene_recall_callback(attribute::SCENE_RECALL_END, ctx.mRequestPath.mEndpointId);
+        }
+    }
+};
+
+static scene_recall_handler s_recall_handler;
+
+esp_err_t init_recall_batch()
+{
+    chip::app::InteractionModelEngine *engine = chip::app::InteractionModelEngine::GetInstance();
+    if (engine->UnregisterCommandHandler(&ScenesServer::Instance()) != CHIP_NO_ERROR) {
+        /* There is no scenes server on this node */
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (engine->RegisterCommandHandler(&s_recall_handler) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to register the scene recall handler");
+        engine->RegisterCommandHandler(&ScenesServer::Instance());
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
+
+} // namespace scene_storage
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_SCENE_STORAGE || CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
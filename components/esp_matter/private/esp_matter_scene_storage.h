@@ -0,0 +1,56 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace scene_storage {
+
+/*
+ * Compact storage of the scenes table.
+ *
+ * The scene entries which the scenes server writes to the persistent storage, one key per scene per endpoint per
+ * fabric, are kept in RAM and stored in one NVS blob per fabric instead. The identical scenes, such as the same scene
+ * stored on all the endpoints of a lighting device, share their value in RAM and in the blob. The other keys go to the
+ * wrapped storage, and the scenes which were stored there before are still read from it until they are written
+ * again.
+ */
+
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_STORAGE
+/**
+ * @brief Wraps the persistent storage of the server, called before the server init.
+ *
+ * @param storage Storage of the server, used for all the keys but the scenes
+ *
+ * @return Storage to give to the server
+ */
+chip::PersistentStorageDelegate *wrap(chip::PersistentStorageDelegate *storage);
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_SCENE_RECALL_BATCH
+/**
+ * @brief Wraps the command handler of the scenes server, so the attribute updates of a scene recall are notified
+ *        between the SCENE_RECALL_BEGIN and SCENE_RECALL_END attribute callbacks. Called after the server init.
+ *
+ * @return ESP_OK on success, error otherwise
+ */
+esp_err_t init_recall_batch();
+#endif
+
+} // namespace scene_storage
+} // namespace esp_matter
@@ -0,0 +1,300 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_sed_poll.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
+#include <app/InteractionModelEngine.h>
+#include <app/ReadHandler.h>
+#include <app/server/Server.h>
+#include <esp_openthread.h>
+#include <openthread/link.h>
+#include <platform/CHIPDeviceLayer.h>
+
+namespace esp_matter {
+namespace sed_poll {
+
+static const char *TAG = "sed_poll";
+/* Subscriptions primed at the same time which hold the fast poll period */
+static constexpr size_t k_max_priming = 4;
+/* A subscription which is not primed after this time no longer holds the fast poll period */
+static constexpr int64_t k_max_priming_us = 10 * 1000 * 1000;
+
+/* Everything below is only accessed with the Matter stack lock held, the stats are shared with the readers */
+static bool s_fast = false;
+static const chip::app::ReadHandler *s_priming[k_max_priming];
+static int64_t s_priming_start_us[k_max_priming];
+
+static stats_t s_stats;
+/* Start of the current mode, the time before it is in the stats */
+static int64_t s_mode_start_us = 0;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void set_poll_period(uint32_t period_ms)
+{
+    otInstance *instance = esp_openthread_get_instance();
+    if (!instance) {
+        return;
+    }
+    chip::DeviceLayer::ThreadStackMgr().LockThreadStack();
+    otError err = otLinkSetPollPeriod(instance, period_ms);
+    chip::DeviceLayer::ThreadStackMgr().UnlockThreadStack();
+    if (err != OT_ERROR_NONE) {
+        ESP_LOGW(TAG, "Failed to set the poll period to %" PRIu32 " ms: %d", period_ms, err);
+    }
+}
+
+/* Adds the time of the current mode to the stats and starts the next one */
+static void switch_mode(bool fast)
+{
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_stats_lock);
+    uint64_t elapsed_ms = (uint64_t)(now_us - s_mode_start_us) / 1000;
+    if (s_fast) {
+        s_stats.fast_ms += elapsed_ms;
+    } else {
+        s_stats.idle_ms += elapsed_ms;
+    }
+    s_mode_start_us += elapsed_ms * 1000;
+    s_fast = fast;
+    if (fast) {
+        s_stats.fast_entries++;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+    set_poll_period(fast ? CONFIG_ESP_MATTER_SED_POLL_FAST_PERIOD_MS : CONFIG_ESP_MATTER_SED_POLL_IDLE_PERIOD_MS);
+    ESP_LOGD(TAG, "%s poll period", fast ? "Fast" : "Idle");
+}
+
+static bool is_priming()
+{
+    int64_t now_us = esp_timer_get_time();
+    bool priming = false;
+    for (size_t idx = 0; idx < k_max_priming; ++idx) {
+        if (s_priming[idx] && now_us - s_priming_start_us[idx] >= k_max_priming_us) {
+            s_priming[idx] = nullptr;
+        }
+        priming = priming || s_priming[idx];
+    }
+    return priming;
+}
+
+static void start_quiet_timer();
+
+static void quiet_timer_callback(chip::System::Layer *layer, void *context)
+{
+    // The exchanges still open wait for a response or an acknowledgement, which the fast polls fetch sooner
+    if (is_priming() || chip::Server::GetInstance().GetExchangeManager().GetNumActiveExchanges() > 0) {
+        start_quiet_timer();
+        return;
+    }
+    switch_mode(false);
+}
+
+static void start_quiet_timer()
+{
+    chip::DeviceLayer::SystemLayer().CancelTimer(quiet_timer_callback, nullptr);
+    CHIP_ERROR err = chip::DeviceLayer::SystemLayer().StartTimer(
+        chip::System::Clock::Milliseconds32(CONFIG_ESP_MATTER_SED_POLL_QUIET_TIMEOUT_MS), quiet_timer_callback,
+        nullptr);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the quiet timer, the idle poll period is used");
+        switch_mode(false);
+    }
+}
+
+void on_activity(activity_t activity)
+{
+    if (activity >= ACTIVITY_COUNT) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.activities[activity]++;
+    portEXIT_CRITICAL(&s_stats_lock);
+    if (!s_fast) {
+        switch_mode(true);
+    }
+    start_quiet_timer();
+}
+
+class PrimingCallback : public chip::app::ReadHandler::ApplicationCallback {
+public:
+    CHIP_ERROR OnSubscriptionRequested(chip::app::ReadHandler &read_handler,
+                                       chip::Transport::SecureSession &secure_session) override
+    {
+        for (size_t idx = 0; idx < k_max_priming; ++idx) {
+            if (!s_priming[idx]) {
+                s_priming[idx] = &read_handler;
+                s_priming_start_us[idx] = esp_timer_get_time();
+                break;
+            }
+        }
+        on_activity(ACTIVITY_SUBSCRIPTION);
+        return CHIP_NO_ERROR;
+    }
+
+    /* The quiet timeout starts again once the subscription is primed */
+    void OnSubscriptionEstablished(chip::app::ReadHandler &read_handler) override { primed(read_handler); }
+    void OnSubscriptionTerminated(chip::app::ReadHandler &read_handler) override { primed(read_handler); }
+
+private:
+    void primed(const chip::app::ReadHandler &read_handler)
+    {
+        for (size_t idx = 0; idx < k_max_priming; ++idx) {
+            if (s_priming[idx] == &read_handler) {
+                s_priming[idx] = nullptr;
+                if (s_fast) {
+                    start_quiet_timer();
+                }
+            }
+        }
+    }
+};
+
+static PrimingCallback s_priming_callback;
+
+void init()
+{
+    // The SDK keeps a single callback, the application must not register another one
+    chip::app::InteractionModelEngine::GetInstance()->RegisterReadHandlerAppCallback(&s_priming_callback);
+    portENTER_CRITICAL(&s_stats_lock);
+    s_mode_start_us = esp_timer_get_time();
+    portEXIT_CRITICAL(&s_stats_lock);
+    // The device polls fast while it boots and the controllers reconnect
+    on_activity(ACTIVITY_APPLICATION);
+}
+
+esp_err_t notify_activity()
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    on_activity(ACTIVITY_APPLICATION);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats;
+    uint64_t elapsed_ms = s_mode_start_us > 0 ? (uint64_t)(now_us - s_mode_start_us) / 1000 : 0;
+    if (s_fast) {
+        stats->fast_ms += elapsed_ms;
+    } else {
+        stats->idle_ms += elapsed_ms;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void reset_stats()
+{
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats = {};
+    if (s_mode_start_us > 0) {
+        s_mode_start_us = now_us;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    stats_t stats;
+    get_stats(&stats);
+    uint64_t total_ms = stats.fast_ms + stats.idle_ms;
+    printf("Fast poll: %" PRIu64 " ms (%" PRIu64 "%%), idle poll: %" PRIu64 " ms, fast entries: %" PRIu32 "\n",
+           stats.fast_ms, total_ms > 0 ? stats.fast_ms * 100 / total_ms : 0, stats.idle_ms, stats.fast_entries);
+    printf("Activities: commands: %" PRIu32 ", subscriptions: %" PRIu32 ", exchanges: %" PRIu32
+           ", application: %" PRIu32 "\n", stats.activities[ACTIVITY_COMMAND], stats.activities[ACTIVITY_SUBSCRIPTION],
+           stats.activities[ACTIVITY_EXCHANGE], stats.activities[ACTIVITY_APPLICATION]);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine sed_poll_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        sed_poll_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return sed_poll_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "sed_poll",
+        .description = "Adaptive poll period statistics. Usage: matter esp sed_poll <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t sed_poll_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the time spent with the fast and the idle poll periods, and the activities.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the adaptive poll statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    sed_poll_console.register_commands(sed_poll_commands,
+                                       sizeof(sed_poll_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace sed_poll
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
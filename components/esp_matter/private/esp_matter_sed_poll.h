@@ -0,0 +1,43 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
+namespace esp_matter {
+namespace sed_poll {
+
+/**
+ * @brief Registers the subscription callbacks and sets the idle poll period, called after the server init.
+ */
+void init();
+
+/**
+ * @brief Switches to the fast poll period for activity seen by esp_matter, called with the Matter stack lock held.
+ *
+ * @param activity Source of the activity
+ */
+void on_activity(activity_t activity);
+
+/**
+ * @brief Registers the adaptive poll console commands.
+ */
+void register_console_commands();
+
+} // namespace sed_poll
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_ADAPTIVE_SED_POLL
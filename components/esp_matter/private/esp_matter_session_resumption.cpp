@@ -0,0 +1,204 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_session_resumption.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_SESSION_RESUMPTION_STATS
+#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+
+namespace esp_matter {
+namespace session_resumption {
+
+static const char *TAG = "session_resumption";
+
+static_assert(CONFIG_ESP_MATTER_SESSION_RESUMPTION_FABRIC_DEPTH <= CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE,
+              "The entries of a fabric cannot exceed the session resumption cache of the SDK");
+
+/* Only written on the Matter task, the stats are shared with the readers */
+static stats_t s_stats;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* The SDK storage keeps the resumption state of the last CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE peers of all the
+ * fabrics in the KVS, so it survives the reboots, and drops the oldest one when it is full. This one caps the peers
+ * of each fabric, so that a controller reconnecting many sessions does not evict the other fabrics. */
+class counting_storage : public chip::SimpleSessionResumptionStorage {
+public:
+    CHIP_ERROR FindByResumptionId(ConstResumptionIdView resumption_id, chip::ScopedNodeId &node,
+                                  chip::Crypto::P256ECDHDerivedSecret &shared_secret,
+                                  chip::CATValues &peer_cats) override
+    {
+        CHIP_ERROR err = SimpleSessionResumptionStorage::FindByResumptionId(resumption_id, node, shared_secret,
+                                                                            peer_cats);
+        portENTER_CRITICAL(&s_stats_lock);
+        if (err == CHIP_NO_ERROR) {
+            s_stats.resumed++;
+        } else {
+            s_stats.misses++;
+        }
+        portEXIT_CRITICAL(&s_stats_lock);
+        return err;
+    }
+
+    CHIP_ERROR Save(const chip::ScopedNodeId &node, ConstResumptionIdView resumption_id,
+                    const chip::Crypto::P256ECDHDerivedSecret &shared_secret,
+                    const chip::CATValues &peer_cats) override
+    {
+        evict_oldest_of_fabric(node);
+        portENTER_CRITICAL(&s_stats_lock);
+        s_stats.sessions++;
+        portEXIT_CRITICAL(&s_stats_lock);
+        return SimpleSessionResumptionStorage::Save(node, resumption_id, shared_secret, peer_cats);
+    }
+
+private:
+    /* The index is ordered from the oldest entry, the entry of the node itself is replaced by the save */
+    void evict_oldest_of_fabric(const chip::ScopedNodeId &node)
+    {
+        SessionIndex index;
+        if (LoadIndex(index) != CHIP_NO_ERROR) {
+            return;
+        }
+        size_t count = 0;
+        const chip::ScopedNodeId *oldest = nullptr;
+        for (size_t idx = 0; idx < index.mSize; ++idx) {
+            if (index.mNodes[idx] == node) {
+                return;
+            }
+            if (index.mNodes[idx].GetFabricIndex() == node.GetFabricIndex()) {
+                if (!oldest) {
+                    oldest = &index.mNodes[idx];
+                }
+                count++;
+            }
+        }
+        if (oldest && count >= CONFIG_ESP_MATTER_SESSION_RESUMPTION_FABRIC_DEPTH) {
+            chip::ScopedNodeId evicted = *oldest;
+            if (Delete(evicted) == CHIP_NO_ERROR) {
+                portENTER_CRITICAL(&s_stats_lock);
+                s_stats.evictions++;
+                portEXIT_CRITICAL(&s_stats_lock);
+            }
+        }
+    }
+};
+
+chip::SessionResumptionStorage *get_storage(chip::PersistentStorageDelegate *storage)
+{
+    static counting_storage s_storage;
+    static bool s_initialized = false;
+    if (!s_initialized) {
+        if (!storage || s_storage.Init(storage) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to initialize the session resumption storage");
+            return nullptr;
+        }
+        s_initialized = true;
+    }
+    return &s_storage;
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats = {};
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    stats_t stats;
+    get_stats(&stats);
+    uint32_t hit_rate = stats.sessions > 0 ? stats.resumed * 100 / stats.sessions : 0;
+    printf("Sessions: %" PRIu32 ", resumed: %" PRIu32 " (%" PRIu32 "%%), unknown resumption IDs: %" PRIu32
+           ", evictions: %" PRIu32 "\n", stats.sessions, stats.resumed, hit_rate, stats.misses, stats.evictions);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine resumption_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        resumption_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return resumption_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "resumption",
+        .description = "CASE session resumption statistics. Usage: matter esp resumption <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t resumption_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the number of CASE sessions and the ones resumed without a full handshake.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the session resumption statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    resumption_console.register_commands(resumption_commands,
+                                         sizeof(resumption_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace session_resumption
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_SESSION_RESUMPTION_STATS
@@ -0,0 +1,43 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_SESSION_RESUMPTION_STATS
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <protocols/secure_channel/SessionResumptionStorage.h>
+
+namespace esp_matter {
+namespace session_resumption {
+
+/**
+ * @brief Returns the session resumption storage, persisted in the storage delegate, which limits the entries of each
+ *        fabric and counts the resumptions. Set in the server init parameters before the server init.
+ *
+ * @param storage Persistent storage delegate of the server
+ *
+ * @return Session resumption storage, NULL if it cannot be initialized
+ */
+chip::SessionResumptionStorage *get_storage(chip::PersistentStorageDelegate *storage);
+
+/**
+ * @brief Registers the session resumption console commands.
+ */
+void register_console_commands();
+
+} // namespace session_resumption
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_SESSION_RESUMPTION_STATS
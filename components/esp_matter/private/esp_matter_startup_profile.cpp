@@ -0,0 +1,145 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_startup_profile.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_STARTUP_PROFILE
+
+namespace esp_matter {
+namespace startup_profile {
+
+static const char *TAG = "mtr_startup";
+
+static const char *k_aggregate_names[AGGREGATE_COUNT] = {"nvs_read", "cluster_metadata"};
+
+static phase_t s_phases[CONFIG_ESP_MATTER_STARTUP_PROFILE_MAX_PHASES + AGGREGATE_COUNT];
+static size_t s_phase_count = 0;
+static phase_t s_aggregates[AGGREGATE_COUNT];
+static bool s_complete = false;
+/* Phases are recorded from the application task and the Matter task */
+static portMUX_TYPE s_profile_lock = portMUX_INITIALIZER_UNLOCKED;
+
+int phase_begin(const char *name, uint32_t id)
+{
+    int64_t start_us = esp_timer_get_time();
+    int index = -1;
+    portENTER_CRITICAL(&s_profile_lock);
+    if (!s_complete && s_phase_count < CONFIG_ESP_MATTER_STARTUP_PROFILE_MAX_PHASES) {
+        index = s_phase_count++;
+        s_phases[index].name = name;
+        s_phases[index].id = id;
+        s_phases[index].count = 1;
+        s_phases[index].start_us = start_us;
+        s_phases[index].duration_us = -1;
+    }
+    portEXIT_CRITICAL(&s_profile_lock);
+    return index;
+}
+
+void phase_end(int index)
+{
+    if (index < 0) {
+        return;
+    }
+    int64_t end_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_profile_lock);
+    s_phases[index].duration_us = end_us - s_phases[index].start_us;
+    portEXIT_CRITICAL(&s_profile_lock);
+}
+
+int64_t now()
+{
+    return s_complete ? 0 : esp_timer_get_time();
+}
+
+void aggregate_add(aggregate_t aggregate, int64_t start_us)
+{
+    if (s_complete || start_us == 0) {
+        return;
+    }
+    int64_t end_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_profile_lock);
+    phase_t *phase = &s_aggregates[aggregate];
+    if (phase->count == 0) {
+        phase->name = k_aggregate_names[aggregate];
+        phase->id = UINT32_MAX;
+        phase->start_us = start_us;
+    }
+    phase->count++;
+    phase->duration_us += end_us - start_us;
+    portEXIT_CRITICAL(&s_profile_lock);
+}
+
+void complete()
+{
+    portENTER_CRITICAL(&s_profile_lock);
+    if (s_complete) {
+        portEXIT_CRITICAL(&s_profile_lock);
+        return;
+    }
+    s_complete = true;
+    /* Append the aggregates so that the report is a single table */
+    for (int aggregate = 0; aggregate < AGGREGATE_COUNT; aggregate++) {
+        if (s_aggregates[aggregate].count > 0) {
+            s_phases[s_phase_count++] = s_aggregates[aggregate];
+        }
+    }
+    portEXIT_CRITICAL(&s_profile_lock);
+    print_report();
+}
+
+esp_err_t get_phases(const phase_t **phases, size_t *count)
+{
+    if (!phases || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_complete) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    *phases = s_phases;
+    *count = s_phase_count;
+    return ESP_OK;
+}
+
+void print_report()
+{
+    if (!s_complete) {
+        ESP_LOGW(TAG, "Startup is not complete yet");
+        return;
+    }
+    ESP_LOGI(TAG, "Startup report (us):");
+    for (size_t index = 0; index < s_phase_count; index++) {
+        const phase_t *phase = &s_phases[index];
+        if (phase->id != UINT32_MAX) {
+            ESP_LOGI(TAG, "%-18s 0x%04" PRIX32 " start %10" PRId64 " duration %10" PRId64, phase->name, phase->id,
+                     phase->start_us, phase->duration_us);
+        } else if (phase->count > 1) {
+            ESP_LOGI(TAG, "%-18s x%-5" PRIu32 " first %10" PRId64 " total    %10" PRId64, phase->name, phase->count,
+                     phase->start_us, phase->duration_us);
+        } else {
+            ESP_LOGI(TAG, "%-18s        start %10" PRId64 " duration %10" PRId64, phase->name, phase->start_us,
+                     phase->duration_us);
+        }
+    }
+}
+
+} // namespace startup_profile
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_STARTUP_PROFILE
@@ -0,0 +1,88 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace esp_matter {
+namespace startup_profile {
+
+/** Aggregated phases, which happen too often to be recorded one by one */
+typedef enum aggregate {
+    AGGREGATE_NVS_READ = 0,
+    AGGREGATE_CLUSTER_METADATA,
+    AGGREGATE_COUNT,
+} aggregate_t;
+
+#if CONFIG_ESP_MATTER_ENABLE_STARTUP_PROFILE
+/**
+ * @brief Starts recording a phase.
+ *
+ * @param name Phase name, must be a string literal
+ * @param id   Endpoint Id or any other id, 0xFFFFFFFF if not applicable
+ *
+ * @return Index of the phase, to be passed to phase_end(), or -1 if the table is full or the profile is complete
+ */
+int phase_begin(const char *name, uint32_t id);
+
+/**
+ * @brief Ends recording a phase.
+ *
+ * @param index Index returned by phase_begin()
+ */
+void phase_end(int index);
+
+/**
+ * @brief Adds the duration of an occurrence of an aggregated phase.
+ *
+ * @param aggregate Aggregated phase
+ * @param start_us  esp_timer_get_time() at the beginning of the occurrence
+ */
+void aggregate_add(aggregate_t aggregate, int64_t start_us);
+
+/**
+ * @brief Gets the current time for aggregate_add().
+ */
+int64_t now();
+
+/**
+ * @brief Marks the profile as complete and prints the startup report. Nothing is recorded after this.
+ */
+void complete();
+
+/** Records a phase for the lifetime of the object */
+class scoped_phase {
+public:
+    scoped_phase(const char *name, uint32_t id = UINT32_MAX) : m_index(phase_begin(name, id)) {}
+    ~scoped_phase() { phase_end(m_index); }
+
+private:
+    int m_index;
+};
+#else
+inline int phase_begin(const char *name, uint32_t id) { return -1; }
+inline void phase_end(int index) {}
+inline void aggregate_add(aggregate_t aggregate, int64_t start_us) {}
+inline int64_t now() { return 0; }
+inline void complete() {}
+
+class scoped_phase {
+public:
+    scoped_phase(const char *name, uint32_t id = UINT32_MAX) {}
+};
+#endif // CONFIG_ESP_MATTER_ENABLE_STARTUP_PROFILE
+
+} // namespace startup_profile
+} // namespace esp_matter
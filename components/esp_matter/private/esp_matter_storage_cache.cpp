@@ -0,0 +1,512 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_storage_cache.h>
+#include <esp_system.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <platform/CHIPDeviceLayer.h>
+
+namespace esp_matter {
+namespace storage_cache {
+
+static const char *TAG = "storage_cache";
+
+typedef struct cache_entry {
+    /* Empty for a free entry */
+    char key[chip::PersistentStorageDelegate::kKeyLengthMax + 1];
+    uint8_t *value;
+    uint16_t size;
+    uint16_t capacity;
+    /* The key does not exist in the storage, or is deleted by a write not committed yet */
+    bool absent;
+    /* The value or the deletion is not committed to the storage yet */
+    bool dirty;
+    /* Order of the last access, the least recently used entry is evicted first */
+    uint32_t last_used;
+    /* Order of the last write, the dirty entries are committed in the order of their writes */
+    uint32_t write_seq;
+} cache_entry_t;
+
+/* Only accessed on the Matter task, or with the Matter stack locked */
+static cache_entry_t s_entries[CONFIG_ESP_MATTER_STORAGE_CACHE_ENTRIES];
+static uint32_t s_use_counter = 0;
+static uint32_t s_write_counter = 0;
+static bool s_commit_scheduled = false;
+static chip::PersistentStorageDelegate *s_storage = nullptr;
+
+/* Written on the Matter task, the stats are shared with the readers */
+static stats_t s_stats;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void add_stat(uint32_t &counter)
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    counter++;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+/* The SDK writes the commit marker of the fabric table before the fabric data and deletes it after, to revert a
+ * partial commit on the next boot. The marker writes are fences: the writes before them are committed first and the
+ * marker goes straight to the storage, so the marker is in the storage while the fabric data is committed. */
+static bool is_fence(const char *key)
+{
+    return strcmp(key, chip::DefaultStorageKeyAllocator::FabricTableCommitMarkerKey().KeyName()) == 0;
+}
+
+static cache_entry_t *find_entry(const char *key)
+{
+    for (size_t i = 0; i < CONFIG_ESP_MATTER_STORAGE_CACHE_ENTRIES; ++i) {
+        if (s_entries[i].key[0] != '\0' && strcmp(s_entries[i].key, key) == 0) {
+            s_entries[i].last_used = ++s_use_counter;
+            return &s_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+static void free_entry(cache_entry_t *entry)
+{
+    esp_matter_mem_free(entry->value);
+    memset(entry, 0, sizeof(*entry));
+}
+
+static CHIP_ERROR commit_entry(cache_entry_t *entry)
+{
+    CHIP_ERROR err;
+    if (entry->absent) {
+        err = s_storage->SyncDeleteKeyValue(entry->key);
+        if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) {
+            /* Written and deleted before any commit */
+            err = CHIP_NO_ERROR;
+        }
+    } else {
+        err = s_storage->SyncSetKeyValue(entry->key, entry->value, entry->size);
+    }
+    add_stat(s_stats.storage_writes);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to commit %s, err:%" CHIP_ERROR_FORMAT, entry->key, err.Format());
+        return err;
+    }
+    entry->dirty = false;
+    return CHIP_NO_ERROR;
+}
+
+/* Returns false if some writes could not be committed, they are kept dirty for the next commit */
+static bool commit_all()
+{
+    bool committed = false;
+    bool failed = false;
+    while (true) {
+        cache_entry_t *next = nullptr;
+        for (size_t i = 0; i < CONFIG_ESP_MATTER_STORAGE_CACHE_ENTRIES; ++i) {
+            cache_entry_t *entry = &s_entries[i];
+            if (entry->key[0] != '\0' && entry->dirty && (!next || entry->write_seq < next->write_seq)) {
+                next = entry;
+            }
+        }
+        if (!next || commit_entry(next) != CHIP_NO_ERROR) {
+            failed = next != nullptr;
+            break;
+        }
+        committed = true;
+    }
+    if (committed) {
+        add_stat(s_stats.commits);
+    }
+    return !failed;
+}
+
+static void commit_timer_callback(chip::System::Layer *layer, void *context)
+{
+    s_commit_scheduled = false;
+    commit_all();
+}
+
+static void schedule_commit()
+{
+    if (s_commit_scheduled) {
+        return;
+    }
+    CHIP_ERROR err = chip::DeviceLayer::SystemLayer().StartTimer(
+        chip::System::Clock::Milliseconds32(CONFIG_ESP_MATTER_STORAGE_CACHE_COMMIT_DELAY_MS), commit_timer_callback,
+        nullptr);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the commit timer, err:%" CHIP_ERROR_FORMAT, err.Format());
+        commit_all();
+        return;
+    }
+    s_commit_scheduled = true;
+}
+
+/* Returns a free entry for the key, evicting the least recently used clean entry, or committing the least recently
+ * used dirty one if all the entries are dirty. NULL if the dirty entry cannot be committed. */
+static cache_entry_t *allocate_entry(const char *key)
+{
+    cache_entry_t *victim = nullptr;
+    for (size_t i = 0; i < CONFIG_ESP_MATTER_STORAGE_CACHE_ENTRIES; ++i) {
+        cache_entry_t *entry = &s_entries[i];
+        if (entry->key[0] == '\0') {
+            victim = entry;
+            break;
+        }
+        if (!victim || (victim->dirty && !entry->dirty) ||
+            (victim->dirty == entry->dirty && entry->last_used < victim->last_used)) {
+            victim = entry;
+        }
+    }
+    if (victim->key[0] != '\0') {
+        if (victim->dirty && commit_entry(victim) != CHIP_NO_ERROR) {
+            return nullptr;
+        }
+        free_entry(victim);
+        add_stat(s_stats.evictions);
+    }
+    strlcpy(victim->key, key, sizeof(victim->key));
+    victim->last_used = ++s_use_counter;
+    return victim;
+}
+
+static bool set_entry_value(cache_entry_t *entry, const void *value, uint16_t size)
+{
+    if (size > entry->capacity) {
+        uint8_t *new_value = (uint8_t *)esp_matter_mem_realloc(entry->value, size);
+        if (!new_value) {
+            return false;
+        }
+        entry->value = new_value;
+        entry->capacity = size;
+    }
+    if (size > 0) {
+        memcpy(entry->value, value, size);
+    }
+    entry->size = size;
+    entry->absent = false;
+    return true;
+}
+
+static void drop_entry(const char *key)
+{
+    cache_entry_t *entry = find_entry(key);
+    if (entry) {
+        free_entry(entry);
+    }
+}
+
+class cached_storage : public chip::PersistentStorageDelegate {
+public:
+    CHIP_ERROR SyncGetKeyValue(const char *key, void *buffer, uint16_t &size) override
+    {
+        add_stat(s_stats.reads);
+        cache_entry_t *entry = find_entry(key);
+        if (entry) {
+            add_stat(s_stats.hits);
+            if (entry->absent) {
+                return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+            }
+            uint16_t copy_size = entry->size < size ? entry->size : size;
+            if (copy_size > 0) {
+                memcpy(buffer, entry->value, copy_size);
+            }
+            CHIP_ERROR err = copy_size < entry->size ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+            size = copy_size;
+            return err;
+        }
+        CHIP_ERROR err = s_storage->SyncGetKeyValue(key, buffer, size);
+        if (err == CHIP_NO_ERROR && size <= CONFIG_ESP_MATTER_STORAGE_CACHE_MAX_VALUE_SIZE && !is_fence(key)) {
+            entry = allocate_entry(key);
+            if (entry && !set_entry_value(entry, buffer, size)) {
+                free_entry(entry);
+            }
+        } else if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND && !is_fence(key)) {
+            /* Most of the reads at the boot and during the commissioning look for keys which do not exist */
+            entry = allocate_entry(key);
+            if (entry) {
+                entry->absent = true;
+            }
+        }
+        return err;
+    }
+
+    CHIP_ERROR SyncSetKeyValue(const char *key, const void *value, uint16_t size) override
+    {
+        add_stat(s_stats.writes);
+        if (is_fence(key) || size > CONFIG_ESP_MATTER_STORAGE_CACHE_MAX_VALUE_SIZE) {
+            return write_through(key, value, size);
+        }
+        cache_entry_t *entry = find_entry(key);
+        if (entry && !entry->absent && entry->size == size && (size == 0 || memcmp(entry->value, value, size) == 0)) {
+            add_stat(s_stats.absorbed);
+            return CHIP_NO_ERROR;
+        }
+        if (entry && entry->dirty) {
+            /* Replaces a write which is not committed yet */
+            add_stat(s_stats.absorbed);
+        }
+        if (!entry) {
+            entry = allocate_entry(key);
+        }
+        if (!entry || !set_entry_value(entry, value, size)) {
+            return write_through(key, value, size);
+        }
+        entry->dirty = true;
+        entry->write_seq = ++s_write_counter;
+        schedule_commit();
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SyncDeleteKeyValue(const char *key) override
+    {
+        add_stat(s_stats.writes);
+        if (is_fence(key)) {
+            commit_all();
+            drop_entry(key);
+            add_stat(s_stats.storage_writes);
+            return s_storage->SyncDeleteKeyValue(key);
+        }
+        cache_entry_t *entry = find_entry(key);
+        if (entry && entry->absent) {
+            return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+        }
+        if (entry) {
+            if (entry->dirty) {
+                add_stat(s_stats.absorbed);
+            }
+            entry->absent = true;
+            entry->dirty = true;
+            entry->write_seq = ++s_write_counter;
+            schedule_commit();
+            return CHIP_NO_ERROR;
+        }
+        /* Whether the key exists is not known, the storage tells it */
+        add_stat(s_stats.storage_writes);
+        CHIP_ERROR err = s_storage->SyncDeleteKeyValue(key);
+        if (err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) {
+            entry = allocate_entry(key);
+            if (entry) {
+                entry->absent = true;
+            }
+        }
+        return err;
+    }
+
+private:
+    CHIP_ERROR write_through(const char *key, const void *value, uint16_t size)
+    {
+        if (is_fence(key)) {
+            commit_all();
+        }
+        drop_entry(key);
+        add_stat(s_stats.storage_writes);
+        return s_storage->SyncSetKeyValue(key, value, size);
+    }
+};
+
+static cached_storage s_cached_storage;
+
+static void device_event_handler(const chip::DeviceLayer::ChipDeviceEvent *event, intptr_t arg)
+{
+    switch (event->Type) {
+    case chip::DeviceLayer::DeviceEventType::kCommissioningComplete:
+    case chip::DeviceLayer::DeviceEventType::kFailSafeTimerExpired:
+        /* Commit points: the fabric is committed, or reverted by the fail-safe */
+        commit_all();
+        break;
+    default:
+        break;
+    }
+}
+
+static void shutdown_commit()
+{
+    commit_all();
+}
+
+chip::PersistentStorageDelegate *wrap(chip::PersistentStorageDelegate *storage)
+{
+    if (!storage) {
+        return storage;
+    }
+    if (!s_storage) {
+        if (chip::DeviceLayer::PlatformMgr().AddEventHandler(device_event_handler, 0) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to add the device event handler");
+            return storage;
+        }
+        /* Commit the pending writes on esp_restart() */
+        if (esp_register_shutdown_handler(shutdown_commit) != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to register the shutdown handler, the writes of the last %d ms are lost on restart",
+                     CONFIG_ESP_MATTER_STORAGE_CACHE_COMMIT_DELAY_MS);
+        }
+    }
+    s_storage = storage;
+    return &s_cached_storage;
+}
+
+esp_err_t commit()
+{
+    if (!s_storage) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    bool committed = commit_all();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return committed ? ESP_OK : ESP_FAIL;
+}
+
+static void commit_work(intptr_t arg)
+{
+    if (s_commit_scheduled) {
+        chip::DeviceLayer::SystemLayer().CancelTimer(commit_timer_callback, nullptr);
+        s_commit_scheduled = false;
+    }
+    commit_all();
+}
+
+esp_err_t request_commit()
+{
+    if (!s_storage) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (chip::DeviceLayer::PlatformMgr().ScheduleWork(commit_work, 0) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to schedule the commit");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void discard()
+{
+    if (!s_storage) {
+        return;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    for (size_t i = 0; i < CONFIG_ESP_MATTER_STORAGE_CACHE_ENTRIES; ++i) {
+        free_entry(&s_entries[i]);
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats = {};
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    stats_t stats;
+    get_stats(&stats);
+    uint32_t hit_rate = stats.reads > 0 ? stats.hits * 100 / stats.reads : 0;
+    printf("Reads: %" PRIu32 ", hits: %" PRIu32 " (%" PRIu32 "%%), writes: %" PRIu32 ", absorbed: %" PRIu32
+           ", storage writes: %" PRIu32 ", commits: %" PRIu32 ", evictions: %" PRIu32 "\n", stats.reads, stats.hits,
+           hit_rate, stats.writes, stats.absorbed, stats.storage_writes, stats.commits, stats.evictions);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_commit_handler(int argc, char **argv)
+{
+    return commit();
+}
+
+static esp_matter::console::engine storage_cache_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        storage_cache_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return storage_cache_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "storage",
+        .description = "Persistent storage cache. Usage: matter esp storage <stats|reset|commit>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t storage_cache_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the hit rate of the cache and the writes committed to the storage.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the storage cache statistics.",
+            .handler = console_reset_handler,
+        },
+        {
+            .name = "commit",
+            .description = "Commit the pending writes to the storage.",
+            .handler = console_commit_handler,
+        },
+    };
+    storage_cache_console.register_commands(storage_cache_commands,
+                                            sizeof(storage_cache_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace storage_cache
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
@@ -0,0 +1,46 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+
+namespace esp_matter {
+namespace storage_cache {
+
+/**
+ * @brief Wraps the persistent storage of the server with the cache, called before the server init.
+ *
+ * @param storage Storage of the server
+ *
+ * @return Storage to give to the server
+ */
+chip::PersistentStorageDelegate *wrap(chip::PersistentStorageDelegate *storage);
+
+/**
+ * @brief Drops the cached values and the writes not committed yet, called before a factory reset erases the storage.
+ */
+void discard();
+
+/**
+ * @brief Registers the storage cache console commands.
+ */
+void register_console_commands();
+
+} // namespace storage_cache
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_STORAGE_CACHE
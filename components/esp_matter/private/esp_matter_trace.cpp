@@ -0,0 +1,163 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_err.h>
+#include <esp_matter_perf.h>
+#include <esp_matter_trace.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+namespace esp_matter {
+namespace trace {
+
+#if CONFIG_ESP_MATTER_ENABLE_TRACE
+
+/* Must be a power of two, the slot index is computed by masking the write index */
+constexpr uint32_t k_record_count = CONFIG_ESP_MATTER_TRACE_BUFFER_SIZE;
+static_assert((k_record_count & (k_record_count - 1)) == 0, "The trace buffer size must be a power of two");
+
+/* Bumped when the record layout changes, printed in the dump header for the decoder */
+constexpr int k_format_version = 1;
+
+static record_t s_records[k_record_count];
+static std::atomic<uint32_t> s_write_index(0);
+/* Records written before this index have been cleared */
+static uint32_t s_clear_index = 0;
+/* Set while dumping, so that the records being printed are not overwritten */
+static std::atomic<bool> s_paused(false);
+
+static void add_record(event_t event, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, uint8_t status)
+{
+    if (s_paused.load(std::memory_order_relaxed)) {
+        return;
+    }
+    uint32_t index = s_write_index.fetch_add(1, std::memory_order_relaxed);
+    record_t *slot = &s_records[index & (k_record_count - 1)];
+    slot->timestamp_us = (uint32_t)esp_timer_get_time();
+    slot->cluster_id = cluster_id;
+    slot->element_id = element_id;
+    slot->endpoint_id = endpoint_id;
+    slot->event = (uint8_t)event;
+    slot->status = status;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_TRACE
+
+#if CONFIG_ESP_MATTER_ENABLE_TRACE || CONFIG_ESP_MATTER_ENABLE_PERF_CONSOLE
+void record(event_t event, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, uint8_t status)
+{
+#if CONFIG_ESP_MATTER_ENABLE_PERF_CONSOLE
+    perf::count(event, status);
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_TRACE
+    add_record(event, endpoint_id, cluster_id, element_id, status);
+#endif
+}
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_TRACE
+
+void dump()
+{
+    s_paused.store(true, std::memory_order_relaxed);
+    uint32_t end = s_write_index.load(std::memory_order_acquire);
+    uint32_t count = end - s_clear_index;
+    if (count > k_record_count) {
+        count = k_record_count;
+    }
+    printf("esp_matter_trace begin version=%d count=%" PRIu32 " total=%" PRIu32 "\n", k_format_version, count,
+           end - s_clear_index);
+    for (uint32_t index = end - count; index != end; index++) {
+        const uint8_t *bytes = (const uint8_t *)&s_records[index & (k_record_count - 1)];
+        char line[sizeof(record_t) * 2 + 1];
+        for (size_t offset = 0; offset < sizeof(record_t); offset++) {
+            snprintf(&line[offset * 2], 3, "%02x", bytes[offset]);
+        }
+        printf("esp_matter_trace %s\n", line);
+    }
+    printf("esp_matter_trace end\n");
+    s_paused.store(false, std::memory_order_relaxed);
+}
+
+void clear()
+{
+    s_clear_index = s_write_index.load(std::memory_order_relaxed);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_dump_handler(int argc, char **argv)
+{
+    dump();
+    return ESP_OK;
+}
+
+static esp_err_t console_clear_handler(int argc, char **argv)
+{
+    clear();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine trace_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        trace_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return trace_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "trace",
+        .description = "Binary trace of the attribute and command events. Usage: matter esp trace <dump|clear>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t trace_commands[] = {
+        {
+            .name = "dump",
+            .description = "Print the trace records as hex, decode them with tools/trace/decode_trace.py.",
+            .handler = console_dump_handler,
+        },
+        {
+            .name = "clear",
+            .description = "Drop the trace records.",
+            .handler = console_clear_handler,
+        },
+    };
+    trace_console.register_commands(trace_commands, sizeof(trace_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+#endif // CONFIG_ESP_MATTER_ENABLE_TRACE
+
+} // namespace trace
+} // namespace esp_matter
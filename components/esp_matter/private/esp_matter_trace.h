@@ -0,0 +1,87 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace esp_matter {
+namespace trace {
+
+/** Traced events. The values are part of the binary format, only add new ones at the end. */
+typedef enum event {
+    EVENT_ATTRIBUTE_READ = 1,
+    EVENT_ATTRIBUTE_WRITE,
+    EVENT_ATTRIBUTE_UPDATE,
+    EVENT_ATTRIBUTE_REPORT,
+    EVENT_COMMAND,
+} event_t;
+
+/**
+ * Trace record, 16 bytes, little endian. tools/trace/decode_trace.py decodes the dump of these records.
+ */
+typedef struct record {
+    /* Lower 32 bits of esp_timer_get_time() */
+    uint32_t timestamp_us;
+    uint32_t cluster_id;
+    /* Attribute Id or Command Id */
+    uint32_t element_id;
+    uint16_t endpoint_id;
+    uint8_t event;
+    /* Interaction model status code, 0 for success */
+    uint8_t status;
+} record_t;
+
+static_assert(sizeof(record_t) == 16, "The trace record is part of the binary format");
+
+#if CONFIG_ESP_MATTER_ENABLE_TRACE || CONFIG_ESP_MATTER_ENABLE_PERF_CONSOLE
+/**
+ * @brief Adds a record to the trace ring buffer. This is lock-free and can be called from any task.
+ *
+ * When the ring is full, the oldest records are overwritten. The event is also counted by the perf console.
+ *
+ * @param event       Event
+ * @param endpoint_id Endpoint Id
+ * @param cluster_id  Cluster Id
+ * @param element_id  Attribute Id or Command Id
+ * @param status      Interaction model status code
+ */
+void record(event_t event, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, uint8_t status);
+#else
+inline void record(event_t event, uint16_t endpoint_id, uint32_t cluster_id, uint32_t element_id, uint8_t status) {}
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_TRACE
+/**
+ * @brief Prints the records of the ring buffer, oldest first, as hex lines to be decoded on the host.
+ */
+void dump();
+
+/**
+ * @brief Drops all the records of the ring buffer.
+ */
+void clear();
+
+/**
+ * @brief Registers the trace console commands.
+ */
+void register_console_commands();
+#else
+inline void dump() {}
+inline void clear() {}
+inline void register_console_commands() {}
+#endif // CONFIG_ESP_MATTER_ENABLE_TRACE
+
+} // namespace trace
+} // namespace esp_matter
@@ -0,0 +1,302 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_event.h>
+#include <esp_log.h>
+#include <esp_matter_core.h>
+#include <esp_matter_nvs.h>
+#include <esp_matter_wifi_reconnect.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <nvs.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_WIFI_FAST_RECONNECT
+
+#define ESP_MATTER_NVS_PART_NAME CONFIG_ESP_MATTER_NVS_PART_NAME
+
+namespace esp_matter {
+namespace wifi_reconnect {
+
+static const char *TAG = "wifi_reconnect";
+static const char *k_last_ap_key = "wifi_last_ap";
+
+/* Access point of the last connection, stored when it changes */
+typedef struct last_ap {
+    uint8_t ssid[32];
+    uint8_t bssid[6];
+    uint8_t channel;
+} last_ap_t;
+
+/* Only accessed on the event task, after init() */
+static last_ap_t s_last_ap;
+static bool s_last_ap_valid = false;
+/* The station configuration is pinned to s_last_ap */
+static bool s_pinned = false;
+static bool s_connected = false;
+/* Start of the current connection attempt, the boot or the loss of the link */
+static int64_t s_attempt_start_us = 0;
+
+/* Written on the event task, the stats are shared with the readers */
+static stats_t s_stats;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static esp_err_t load_last_ap()
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READONLY, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    size_t size = sizeof(s_last_ap);
+    err = nvs_get_blob(handle, k_last_ap_key, &s_last_ap, &size);
+    nvs_close(handle);
+    if (err == ESP_OK && size != sizeof(s_last_ap)) {
+        err = ESP_ERR_INVALID_SIZE;
+    }
+    s_last_ap_valid = err == ESP_OK;
+    return err;
+}
+
+static void store_last_ap()
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(ESP_MATTER_NVS_PART_NAME, ESP_MATTER_KVS_NAMESPACE, NVS_READWRITE,
+                                            &handle);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(handle, k_last_ap_key, &s_last_ap, sizeof(s_last_ap));
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store the last access point, err:%d", err);
+    }
+}
+
+/* Pin the station to the BSSID and the channel of the last access point, the driver then connects to it without a
+ * scan of all the channels. The configuration is stored by the driver with the credentials. */
+static void set_pinned(bool pinned)
+{
+    wifi_config_t config;
+    if (esp_wifi_get_config(WIFI_IF_STA, &config) != ESP_OK) {
+        return;
+    }
+    if (pinned) {
+        if (!s_last_ap_valid || memcmp(config.sta.ssid, s_last_ap.ssid, sizeof(s_last_ap.ssid)) != 0) {
+            /* Never connected, or commissioned to another network since the last connection */
+            return;
+        }
+        config.sta.bssid_set = true;
+        memcpy(config.sta.bssid, s_last_ap.bssid, sizeof(config.sta.bssid));
+        config.sta.channel = s_last_ap.channel;
+    } else {
+        config.sta.bssid_set = false;
+        memset(config.sta.bssid, 0, sizeof(config.sta.bssid));
+        config.sta.channel = 0;
+    }
+    esp_err_t err = esp_wifi_set_config(WIFI_IF_STA, &config);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to %s the station configuration, err:%d", pinned ? "pin" : "unpin", err);
+        return;
+    }
+    s_pinned = pinned;
+}
+
+static void on_connected(const wifi_event_sta_connected_t *event)
+{
+    wifi_config_t config;
+    if (esp_wifi_get_config(WIFI_IF_STA, &config) == ESP_OK) {
+        /* The network commissioning driver replaces the configuration when the network changes */
+        s_pinned = config.sta.bssid_set;
+    }
+    uint32_t latency_ms = (uint32_t)((esp_timer_get_time() - s_attempt_start_us) / 1000);
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.connections++;
+    if (s_pinned) {
+        s_stats.direct++;
+    }
+    s_stats.last_latency_ms = latency_ms;
+    if (latency_ms > s_stats.max_latency_ms) {
+        s_stats.max_latency_ms = latency_ms;
+    }
+    s_stats.total_latency_ms += latency_ms;
+    portEXIT_CRITICAL(&s_stats_lock);
+    ESP_LOGI(TAG, "Connected in %" PRIu32 " ms, %s, channel %u", latency_ms, s_pinned ? "direct" : "after a scan",
+             event->channel);
+    s_connected = true;
+
+    last_ap_t ap = {};
+    memcpy(ap.ssid, event->ssid, event->ssid_len < sizeof(ap.ssid) ? event->ssid_len : sizeof(ap.ssid));
+    memcpy(ap.bssid, event->bssid, sizeof(ap.bssid));
+    ap.channel = event->channel;
+    if (!s_last_ap_valid || memcmp(&ap, &s_last_ap, sizeof(ap)) != 0) {
+        s_last_ap = ap;
+        s_last_ap_valid = true;
+        store_last_ap();
+    }
+}
+
+static void on_disconnected(const wifi_event_sta_disconnected_t *event)
+{
+    if (s_connected) {
+        /* The link is lost, the next attempt goes straight to the same access point */
+        s_connected = false;
+        s_attempt_start_us = esp_timer_get_time();
+        if (!s_pinned) {
+            set_pinned(true);
+        }
+        return;
+    }
+    if (s_pinned) {
+        /* The access point moved or is gone, the next attempts scan for the network */
+        ESP_LOGW(TAG, "Direct connection failed, reason %u, falling back to a scan", event->reason);
+        set_pinned(false);
+        portENTER_CRITICAL(&s_stats_lock);
+        s_stats.fallbacks++;
+        portEXIT_CRITICAL(&s_stats_lock);
+    }
+}
+
+static void wifi_event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data)
+{
+    switch (event_id) {
+    case WIFI_EVENT_STA_CONNECTED:
+        on_connected((const wifi_event_sta_connected_t *)event_data);
+        break;
+    case WIFI_EVENT_STA_DISCONNECTED:
+        on_disconnected((const wifi_event_sta_disconnected_t *)event_data);
+        break;
+    default:
+        break;
+    }
+}
+
+esp_err_t init()
+{
+    static bool init_done = false;
+    if (init_done) {
+        return ESP_OK;
+    }
+    s_attempt_start_us = esp_timer_get_time();
+    if (load_last_ap() == ESP_OK) {
+        set_pinned(true);
+    }
+    esp_err_t err = esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_event_handler, NULL);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register the Wi-Fi event handler, err:%d", err);
+        if (s_pinned) {
+            set_pinned(false);
+        }
+        return err;
+    }
+    init_done = true;
+    return ESP_OK;
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats = {};
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void print_stats()
+{
+    stats_t stats;
+    get_stats(&stats);
+    uint32_t average_ms = stats.connections > 0 ? (uint32_t)(stats.total_latency_ms / stats.connections) : 0;
+    printf("Connections: %" PRIu32 ", direct: %" PRIu32 ", fallbacks to a scan: %" PRIu32 ", latency last: %" PRIu32
+           " ms, average: %" PRIu32 " ms, max: %" PRIu32 " ms\n", stats.connections, stats.direct, stats.fallbacks,
+           stats.last_latency_ms, average_ms, stats.max_latency_ms);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t console_stats_handler(int argc, char **argv)
+{
+    print_stats();
+    return ESP_OK;
+}
+
+static esp_err_t console_reset_handler(int argc, char **argv)
+{
+    reset_stats();
+    return ESP_OK;
+}
+
+static esp_matter::console::engine wifi_reconnect_console;
+
+static esp_err_t console_dispatch(int argc, char **argv)
+{
+    if (argc <= 0) {
+        wifi_reconnect_console.for_each_command(esp_matter::console::print_description, NULL);
+        return ESP_OK;
+    }
+    return wifi_reconnect_console.exec_command(argc, argv);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+void register_console_commands()
+{
+#if CONFIG_ENABLE_CHIP_SHELL
+    static bool init_done = false;
+    if (init_done) {
+        return;
+    }
+    static const esp_matter::console::command_t command = {
+        .name = "wifi_reconnect",
+        .description = "Wi-Fi reconnect statistics. Usage: matter esp wifi_reconnect <stats|reset>.",
+        .handler = console_dispatch,
+    };
+    static const esp_matter::console::command_t wifi_reconnect_commands[] = {
+        {
+            .name = "stats",
+            .description = "Print the Wi-Fi connections, the direct ones and the connection latency.",
+            .handler = console_stats_handler,
+        },
+        {
+            .name = "reset",
+            .description = "Reset the Wi-Fi reconnect statistics.",
+            .handler = console_reset_handler,
+        },
+    };
+    wifi_reconnect_console.register_commands(wifi_reconnect_commands,
+                                             sizeof(wifi_reconnect_commands) / sizeof(esp_matter::console::command_t));
+    esp_matter::console::add_commands(&command, 1);
+    init_done = true;
+#endif // CONFIG_ENABLE_CHIP_SHELL
+}
+
+} // namespace wifi_reconnect
+} // namespace esp_matter
+
+#endif // CONFIG_ESP_MATTER_ENABLE_WIFI_FAST_RECONNECT
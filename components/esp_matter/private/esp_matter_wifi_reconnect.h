@@ -0,0 +1,38 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_matter_core.h>
+
+#if CONFIG_ESP_MATTER_ENABLE_WIFI_FAST_RECONNECT
+namespace esp_matter {
+namespace wifi_reconnect {
+
+/**
+ * @brief Pins the station configuration to the access point of the last connection, if it is the configured
+ *        network, and tracks the connections. Called after the Wi-Fi stack init, before the station connects.
+ *
+ * @return ESP_OK on success, error otherwise
+ */
+esp_err_t init();
+
+/**
+ * @brief Registers the Wi-Fi reconnect console commands.
+ */
+void register_console_commands();
+
+} // namespace wifi_reconnect
+} // namespace esp_matter
+#endif // CONFIG_ESP_MATTER_ENABLE_WIFI_FAST_RECONNECT
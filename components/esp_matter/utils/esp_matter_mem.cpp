@@ -12,11 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+/* The functions of this file are defined without the call site macros of the tracing */
+#define ESP_MATTER_MEM_TRACE_IMPL
+
 #include "esp_attr.h"
 #include "esp_heap_caps.h"
 #include "esp_matter_mem.h"
+#include "freertos/FreeRTOS.h"
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+#include "multi_heap.h"
+#endif
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
 
-IRAM_ATTR void *esp_matter_mem_calloc(size_t n, size_t size)
+static IRAM_ATTR void *heap_calloc(size_t n, size_t size)
 {
 #if CONFIG_ESP_MATTER_MEM_ALLOC_MODE_INTERNAL
     return heap_caps_calloc(n, size, MALLOC_CAP_INTERNAL|MALLOC_CAP_8BIT);
@@ -29,7 +39,7 @@ IRAM_ATTR void *esp_matter_mem_calloc(size_t n, size_t size)
 #endif
 }
 
-IRAM_ATTR void *esp_matter_mem_realloc(void *ptr, size_t size)
+static IRAM_ATTR void *heap_realloc(void *ptr, size_t size)
 {
 #if CONFIG_ESP_MATTER_MEM_ALLOC_MODE_INTERNAL
     return heap_caps_realloc(ptr, size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
@@ -42,7 +52,7 @@ IRAM_ATTR void *esp_matter_mem_realloc(void *ptr, size_t size)
 #endif
 }
 
-IRAM_ATTR void esp_matter_mem_free(void *ptr)
+static IRAM_ATTR void heap_free(void *ptr)
 {
 #if CONFIG_ESP_MATTER_MEM_ALLOC_MODE_DEFAULT
     free(ptr);
@@ -50,3 +60,701 @@ IRAM_ATTR void esp_matter_mem_free(void *ptr)
     heap_caps_free(ptr);
 #endif
 }
+
+#if CONFIG_ESP_MATTER_MEM_POOL
+/* Blocks of the pools, a free block holds the next free block of its class. The data used by the IRAM functions is
+ * kept in DRAM. */
+typedef struct free_block {
+    struct free_block *next;
+} free_block_t;
+
+typedef struct {
+    uint8_t *start;
+    uint8_t *end;
+    free_block_t *free_list;
+} size_class_t;
+
+static DRAM_ATTR const uint16_t k_block_sizes[ESP_MATTER_MEM_POOL_CLASS_COUNT] = {16, 32, 64, 128};
+static DRAM_ATTR const uint16_t k_block_counts[ESP_MATTER_MEM_POOL_CLASS_COUNT] = {
+    CONFIG_ESP_MATTER_MEM_POOL_16_COUNT, CONFIG_ESP_MATTER_MEM_POOL_32_COUNT, CONFIG_ESP_MATTER_MEM_POOL_64_COUNT,
+    CONFIG_ESP_MATTER_MEM_POOL_128_COUNT,
+};
+
+static portMUX_TYPE s_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+static size_class_t s_classes[ESP_MATTER_MEM_POOL_CLASS_COUNT];
+/* All the pools are carved out of a single region, so a pointer of the pools is found with two compares */
+static uint8_t *s_region_start = NULL;
+static uint8_t *s_region_end = NULL;
+static uint16_t s_used[ESP_MATTER_MEM_POOL_CLASS_COUNT];
+static uint16_t s_max_used[ESP_MATTER_MEM_POOL_CLASS_COUNT];
+static uint32_t s_fallback_count = 0;
+static volatile bool s_pool_initialized = false;
+
+static void pool_init()
+{
+    size_t region_size = 0;
+    for (size_t idx = 0; idx < ESP_MATTER_MEM_POOL_CLASS_COUNT; ++idx) {
+        region_size += (size_t)k_block_sizes[idx] * k_block_counts[idx];
+    }
+    /* The region is never freed. The heap is not called with the lock held, a concurrent first allocation may
+     * allocate a region too, only one of them is kept. */
+    uint8_t *region = region_size ? (uint8_t *)heap_caps_aligned_calloc(16, 1, region_size,
+                                                                       MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT) : NULL;
+    taskENTER_CRITICAL(&s_pool_lock);
+    if (s_pool_initialized) {
+        taskEXIT_CRITICAL(&s_pool_lock);
+        heap_caps_free(region);
+        return;
+    }
+    if (region) {
+        uint8_t *start = region;
+        for (size_t idx = 0; idx < ESP_MATTER_MEM_POOL_CLASS_COUNT; ++idx) {
+            size_class_t *size_class = &s_classes[idx];
+            size_class->start = start;
+            size_class->end = start + (size_t)k_block_sizes[idx] * k_block_counts[idx];
+            size_class->free_list = NULL;
+            /* Build the free list from the end, so the blocks are handed out in address order */
+            for (uint8_t *block = size_class->end; block > start;) {
+                block -= k_block_sizes[idx];
+                ((free_block_t *)block)->next = size_class->free_list;
+                size_class->free_list = (free_block_t *)block;
+            }
+            start = size_class->end;
+        }
+        s_region_start = region;
+        s_region_end = region + region_size;
+    }
+    /* Without a region, all the allocations use the heap */
+    s_pool_initialized = true;
+    taskEXIT_CRITICAL(&s_pool_lock);
+}
+
+/* Returns NULL if the size does not fit in a block or all the fitting pools are exhausted */
+static IRAM_ATTR void *pool_alloc(size_t size)
+{
+    if (size == 0 || size > k_block_sizes[ESP_MATTER_MEM_POOL_CLASS_COUNT - 1]) {
+        return NULL;
+    }
+    if (!s_pool_initialized) {
+        pool_init();
+    }
+    void *block = NULL;
+    taskENTER_CRITICAL(&s_pool_lock);
+    for (size_t idx = 0; idx < ESP_MATTER_MEM_POOL_CLASS_COUNT && !block; ++idx) {
+        size_class_t *size_class = &s_classes[idx];
+        if (size <= k_block_sizes[idx] && size_class->free_list) {
+            block = size_class->free_list;
+            size_class->free_list = size_class->free_list->next;
+            if (++s_used[idx] > s_max_used[idx]) {
+                s_max_used[idx] = s_used[idx];
+            }
+        }
+    }
+    if (!block) {
+        s_fallback_count++;
+    }
+    taskEXIT_CRITICAL(&s_pool_lock);
+    return block;
+}
+
+/* Returns the class of a block of the pools, or -1 for a pointer of the heap */
+static IRAM_ATTR int pool_class_of(void *ptr)
+{
+    uint8_t *address = (uint8_t *)ptr;
+    if (address < s_region_start || address >= s_region_end) {
+        return -1;
+    }
+    for (int idx = 0; idx < ESP_MATTER_MEM_POOL_CLASS_COUNT; ++idx) {
+        if (address < s_classes[idx].end) {
+            return idx;
+        }
+    }
+    return -1;
+}
+
+static IRAM_ATTR void pool_free(int class_idx, void *ptr)
+{
+    taskENTER_CRITICAL(&s_pool_lock);
+    ((free_block_t *)ptr)->next = s_classes[class_idx].free_list;
+    s_classes[class_idx].free_list = (free_block_t *)ptr;
+    s_used[class_idx]--;
+    taskEXIT_CRITICAL(&s_pool_lock);
+}
+
+void esp_matter_mem_pool_get_stats(esp_matter_mem_pool_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    taskENTER_CRITICAL(&s_pool_lock);
+    for (size_t idx = 0; idx < ESP_MATTER_MEM_POOL_CLASS_COUNT; ++idx) {
+        stats->block_size[idx] = k_block_sizes[idx];
+        stats->block_count[idx] = s_region_start ? k_block_counts[idx] : 0;
+        stats->used[idx] = s_used[idx];
+        stats->max_used[idx] = s_max_used[idx];
+    }
+    stats->fallback_count = s_fallback_count;
+    taskEXIT_CRITICAL(&s_pool_lock);
+}
+#endif // CONFIG_ESP_MATTER_MEM_POOL
+
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+/* Each region is a multi_heap of its own, with its lock. The regions are never removed: an entry is filled before
+ * the count is increased, so the frees find the region of a pointer without taking a lock. */
+typedef struct {
+    char name[ESP_MATTER_MEM_REGION_NAME_LEN];
+    uint8_t *start;
+    uint8_t *end;
+    multi_heap_handle_t heap;
+    portMUX_TYPE lock;
+} mem_region_t;
+
+static portMUX_TYPE s_region_add_lock = portMUX_INITIALIZER_UNLOCKED;
+static DRAM_ATTR mem_region_t s_mem_regions[CONFIG_ESP_MATTER_MEM_REGION_COUNT];
+static DRAM_ATTR size_t s_mem_region_count = 0;
+
+static IRAM_ATTR mem_region_t *region_of(void *ptr)
+{
+    uint8_t *address = (uint8_t *)ptr;
+    size_t count = __atomic_load_n(&s_mem_region_count, __ATOMIC_ACQUIRE);
+    for (size_t idx = 0; idx < count; ++idx) {
+        if (address >= s_mem_regions[idx].start && address < s_mem_regions[idx].end) {
+            return &s_mem_regions[idx];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t esp_matter_mem_region_add(const char *name, void *start, size_t size)
+{
+    if (!name || strlen(name) >= ESP_MATTER_MEM_REGION_NAME_LEN || !start) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* The heap metadata is word aligned */
+    uintptr_t aligned_start = ((uintptr_t)start + 3) & ~(uintptr_t)3;
+    uintptr_t end = (uintptr_t)start + size;
+    if (end <= aligned_start) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    taskENTER_CRITICAL(&s_region_add_lock);
+    size_t idx = s_mem_region_count;
+    if (idx >= CONFIG_ESP_MATTER_MEM_REGION_COUNT) {
+        taskEXIT_CRITICAL(&s_region_add_lock);
+        return ESP_ERR_NO_MEM;
+    }
+    mem_region_t *region = &s_mem_regions[idx];
+    region->heap = multi_heap_register((void *)aligned_start, end - aligned_start);
+    if (!region->heap) {
+        taskEXIT_CRITICAL(&s_region_add_lock);
+        return ESP_ERR_INVALID_ARG;
+    }
+    strlcpy(region->name, name, sizeof(region->name));
+    region->start = (uint8_t *)aligned_start;
+    region->end = (uint8_t *)end;
+    portMUX_INITIALIZE(&region->lock);
+    multi_heap_set_lock(region->heap, &region->lock);
+    __atomic_store_n(&s_mem_region_count, idx + 1, __ATOMIC_RELEASE);
+    taskEXIT_CRITICAL(&s_region_add_lock);
+    return ESP_OK;
+}
+
+/* Returns NULL if the pool has no region with enough free memory */
+static void *region_alloc(const char *name, size_t size)
+{
+    size_t count = __atomic_load_n(&s_mem_region_count, __ATOMIC_ACQUIRE);
+    for (size_t idx = 0; idx < count; ++idx) {
+        mem_region_t *region = &s_mem_regions[idx];
+        if (strcmp(region->name, name) != 0) {
+            continue;
+        }
+        void *ptr = multi_heap_malloc(region->heap, size);
+        if (ptr) {
+            return ptr;
+        }
+    }
+    return NULL;
+}
+
+static IRAM_ATTR void *mem_region_realloc(mem_region_t *region, void *ptr, size_t size)
+{
+    if (size == 0) {
+        multi_heap_free(region->heap, ptr);
+        return NULL;
+    }
+    void *new_ptr = multi_heap_realloc(region->heap, ptr, size);
+    if (new_ptr) {
+        return new_ptr;
+    }
+    /* The region is exhausted, move the allocation to the heap */
+    new_ptr = heap_calloc(1, size);
+    if (new_ptr) {
+        size_t old_size = multi_heap_get_allocated_size(region->heap, ptr);
+        memcpy(new_ptr, ptr, old_size < size ? old_size : size);
+        multi_heap_free(region->heap, ptr);
+    }
+    return new_ptr;
+}
+
+esp_err_t esp_matter_mem_region_get_stats(const char *name, esp_matter_mem_region_stats_t *stats)
+{
+    if (!name || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(stats, 0, sizeof(*stats));
+    size_t count = __atomic_load_n(&s_mem_region_count, __ATOMIC_ACQUIRE);
+    for (size_t idx = 0; idx < count; ++idx) {
+        mem_region_t *region = &s_mem_regions[idx];
+        if (strcmp(region->name, name) != 0) {
+            continue;
+        }
+        multi_heap_info_t info;
+        multi_heap_get_info(region->heap, &info);
+        stats->region_count++;
+        stats->total_bytes += region->end - region->start;
+        stats->free_bytes += info.total_free_bytes;
+        stats->min_free_bytes += info.minimum_free_bytes;
+        if (info.largest_free_block > stats->largest_free_block) {
+            stats->largest_free_block = info.largest_free_block;
+        }
+    }
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_MATTER_MEM_REGION_POOLS
+
+static IRAM_ATTR void *mem_calloc(size_t n, size_t size)
+{
+#if CONFIG_ESP_MATTER_MEM_POOL
+    size_t total = n * size;
+    if (size == 0 || total / size == n) {
+        void *block = pool_alloc(total);
+        if (block) {
+            memset(block, 0, total);
+            return block;
+        }
+    }
+#endif
+    return heap_calloc(n, size);
+}
+
+#if CONFIG_ESP_MATTER_MEM_TAGGED_PLACEMENT
+/* The placements of the cold tags, selected in the menuconfig */
+#if CONFIG_ESP_MATTER_MEM_METADATA_EXTERNAL
+#define METADATA_PLACEMENT ESP_MATTER_MEM_PLACEMENT_EXTERNAL
+#else
+#define METADATA_PLACEMENT ESP_MATTER_MEM_PLACEMENT_DEFAULT
+#endif
+#if CONFIG_ESP_MATTER_MEM_DEVICE_TYPES_EXTERNAL
+#define DEVICE_TYPES_PLACEMENT ESP_MATTER_MEM_PLACEMENT_EXTERNAL
+#else
+#define DEVICE_TYPES_PLACEMENT ESP_MATTER_MEM_PLACEMENT_DEFAULT
+#endif
+#if CONFIG_ESP_MATTER_MEM_BOUNDS_EXTERNAL
+#define BOUNDS_PLACEMENT ESP_MATTER_MEM_PLACEMENT_EXTERNAL
+#else
+#define BOUNDS_PLACEMENT ESP_MATTER_MEM_PLACEMENT_DEFAULT
+#endif
+#if CONFIG_ESP_MATTER_MEM_DEFAULT_VALUE_EXTERNAL
+#define DEFAULT_VALUE_PLACEMENT ESP_MATTER_MEM_PLACEMENT_EXTERNAL
+#else
+#define DEFAULT_VALUE_PLACEMENT ESP_MATTER_MEM_PLACEMENT_DEFAULT
+#endif
+
+/* Indexed by the tag. The hot tags stay in the internal RAM, whatever the memory allocation strategy. */
+static DRAM_ATTR esp_matter_mem_placement_t s_placements[ESP_MATTER_MEM_TAG_COUNT] = {
+    ESP_MATTER_MEM_PLACEMENT_DEFAULT,
+    ESP_MATTER_MEM_PLACEMENT_INTERNAL,
+    ESP_MATTER_MEM_PLACEMENT_INTERNAL,
+    METADATA_PLACEMENT,
+    DEVICE_TYPES_PLACEMENT,
+    BOUNDS_PLACEMENT,
+    DEFAULT_VALUE_PLACEMENT,
+};
+#endif
+
+static IRAM_ATTR void *mem_calloc_tagged(esp_matter_mem_tag_t tag, size_t n, size_t size)
+{
+#if CONFIG_ESP_MATTER_MEM_TAGGED_PLACEMENT
+    esp_matter_mem_placement_t placement = tag < ESP_MATTER_MEM_TAG_COUNT ? s_placements[tag] :
+                                           ESP_MATTER_MEM_PLACEMENT_DEFAULT;
+    if (placement == ESP_MATTER_MEM_PLACEMENT_EXTERNAL) {
+        /* The cold data skips the pools, which are in the internal RAM */
+        void *ptr = heap_caps_calloc(n, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (ptr) {
+            return ptr;
+        }
+    } else if (placement == ESP_MATTER_MEM_PLACEMENT_INTERNAL) {
+#if CONFIG_ESP_MATTER_MEM_POOL
+        size_t total = n * size;
+        if (size == 0 || total / size == n) {
+            void *block = pool_alloc(total);
+            if (block) {
+                memset(block, 0, total);
+                return block;
+            }
+        }
+#endif
+        return heap_caps_calloc(n, size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+#endif
+    return mem_calloc(n, size);
+}
+
+esp_err_t esp_matter_mem_set_placement(esp_matter_mem_tag_t tag, esp_matter_mem_placement_t placement)
+{
+#if CONFIG_ESP_MATTER_MEM_TAGGED_PLACEMENT
+    if (tag >= ESP_MATTER_MEM_TAG_COUNT || placement > ESP_MATTER_MEM_PLACEMENT_EXTERNAL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_placements[tag] = placement;
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+static void *mem_region_calloc(const char *name, size_t n, size_t size)
+{
+    size_t total = n * size;
+    if (name && (size == 0 || total / size == n)) {
+        void *ptr = region_alloc(name, total);
+        if (ptr) {
+            memset(ptr, 0, total);
+            return ptr;
+        }
+    }
+    return mem_calloc(n, size);
+}
+#endif
+
+static IRAM_ATTR void *mem_realloc(void *ptr, size_t size)
+{
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+    mem_region_t *region = ptr ? region_of(ptr) : NULL;
+    if (region) {
+        return mem_region_realloc(region, ptr, size);
+    }
+#endif
+#if CONFIG_ESP_MATTER_MEM_POOL
+    int class_idx = ptr ? pool_class_of(ptr) : -1;
+    if (class_idx >= 0) {
+        if (size == 0) {
+            pool_free(class_idx, ptr);
+            return NULL;
+        }
+        if (size <= k_block_sizes[class_idx]) {
+            return ptr;
+        }
+        /* The block grows out of its class, the new size is larger than the whole block */
+        void *new_ptr = mem_calloc(1, size);
+        if (new_ptr) {
+            memcpy(new_ptr, ptr, k_block_sizes[class_idx]);
+            pool_free(class_idx, ptr);
+        }
+        return new_ptr;
+    }
+    if (!ptr) {
+        return mem_calloc(1, size);
+    }
+#endif
+    return heap_realloc(ptr, size);
+}
+
+static IRAM_ATTR void mem_free(void *ptr)
+{
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+    mem_region_t *region = ptr ? region_of(ptr) : NULL;
+    if (region) {
+        multi_heap_free(region->heap, ptr);
+        return;
+    }
+#endif
+#if CONFIG_ESP_MATTER_MEM_POOL
+    int class_idx = ptr ? pool_class_of(ptr) : -1;
+    if (class_idx >= 0) {
+        pool_free(class_idx, ptr);
+        return;
+    }
+#endif
+    heap_free(ptr);
+}
+
+#if CONFIG_ESP_MATTER_MEM_TRACE
+/* Each traced allocation is preceded by a header, which links it in the list of the live allocations. The size of
+ * the header keeps the alignment of the allocations. */
+typedef struct trace_header {
+    struct trace_header *prev;
+    struct trace_header *next;
+    const char *file;
+    uint32_t size;
+    uint32_t sequence;
+    uint16_t line;
+    uint8_t subsystem;
+    uint8_t reserved;
+} trace_header_t;
+
+static_assert(sizeof(trace_header_t) % 8 == 0, "The trace header must keep the alignment of the allocations");
+
+static const char *k_subsystem_names[ESP_MATTER_MEM_SUBSYSTEM_COUNT] = {
+    "application", "data model", "bridge", "controller", "client", "rainmaker",
+};
+
+static portMUX_TYPE s_trace_lock = portMUX_INITIALIZER_UNLOCKED;
+static trace_header_t *s_live = NULL;
+static uint32_t s_sequence = 0;
+static esp_matter_mem_trace_stats_t s_trace_stats[ESP_MATTER_MEM_SUBSYSTEM_COUNT];
+
+static IRAM_ATTR void trace_link(trace_header_t *header, esp_matter_mem_subsystem_t subsystem, const char *file,
+                                 int line, size_t size)
+{
+    if (subsystem >= ESP_MATTER_MEM_SUBSYSTEM_COUNT) {
+        subsystem = ESP_MATTER_MEM_SUBSYSTEM_APPLICATION;
+    }
+    header->file = file;
+    header->line = (uint16_t)line;
+    header->subsystem = (uint8_t)subsystem;
+    header->size = (uint32_t)size;
+    header->prev = NULL;
+    taskENTER_CRITICAL(&s_trace_lock);
+    header->sequence = ++s_sequence;
+    header->next = s_live;
+    if (s_live) {
+        s_live->prev = header;
+    }
+    s_live = header;
+    esp_matter_mem_trace_stats_t *stats = &s_trace_stats[subsystem];
+    stats->live_bytes += header->size;
+    stats->live_count++;
+    stats->alloc_count++;
+    if (stats->live_bytes > stats->peak_bytes) {
+        stats->peak_bytes = stats->live_bytes;
+    }
+    taskEXIT_CRITICAL(&s_trace_lock);
+}
+
+static IRAM_ATTR void trace_unlink(trace_header_t *header)
+{
+    taskENTER_CRITICAL(&s_trace_lock);
+    if (header->prev) {
+        header->prev->next = header->next;
+    } else {
+        s_live = header->next;
+    }
+    if (header->next) {
+        header->next->prev = header->prev;
+    }
+    esp_matter_mem_trace_stats_t *stats = &s_trace_stats[header->subsystem];
+    stats->live_bytes -= header->size;
+    stats->live_count--;
+    taskEXIT_CRITICAL(&s_trace_lock);
+}
+
+static IRAM_ATTR void *trace_calloc(esp_matter_mem_subsystem_t subsystem, const char *file, int line,
+                                    esp_matter_mem_tag_t tag, size_t n, size_t size)
+{
+    size_t total = n * size;
+    if ((size != 0 && total / size != n) || total > UINT32_MAX - sizeof(trace_header_t)) {
+        return NULL;
+    }
+    trace_header_t *header = (trace_header_t *)mem_calloc_tagged(tag, 1, sizeof(trace_header_t) + total);
+    if (!header) {
+        return NULL;
+    }
+    trace_link(header, subsystem, file, line, total);
+    return header + 1;
+}
+
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+void *esp_matter_mem_trace_region_calloc(esp_matter_mem_subsystem_t subsystem, const char *file, int line,
+                                         const char *name, size_t n, size_t size)
+{
+    size_t total = n * size;
+    if ((size != 0 && total / size != n) || total > UINT32_MAX - sizeof(trace_header_t)) {
+        return NULL;
+    }
+    trace_header_t *header = (trace_header_t *)mem_region_calloc(name, 1, sizeof(trace_header_t) + total);
+    if (!header) {
+        return NULL;
+    }
+    trace_link(header, subsystem, file, line, total);
+    return header + 1;
+}
+#endif
+
+IRAM_ATTR void *esp_matter_mem_trace_calloc(esp_matter_mem_subsystem_t subsystem, const char *file, int line,
+                                            size_t n, size_t size)
+{
+    return trace_calloc(subsystem, file, line, ESP_MATTER_MEM_TAG_DEFAULT, n, size);
+}
+
+IRAM_ATTR void *esp_matter_mem_trace_calloc_tagged(esp_matter_mem_subsystem_t subsystem, const char *file, int line,
+                                                   esp_matter_mem_tag_t tag, size_t n, size_t size)
+{
+    return trace_calloc(subsystem, file, line, tag, n, size);
+}
+
+IRAM_ATTR void *esp_matter_mem_trace_realloc(esp_matter_mem_subsystem_t subsystem, const char *file, int line,
+                                             void *ptr, size_t size)
+{
+    if (!ptr) {
+        return trace_calloc(subsystem, file, line, ESP_MATTER_MEM_TAG_DEFAULT, 1, size);
+    }
+    if (size == 0) {
+        esp_matter_mem_free(ptr);
+        return NULL;
+    }
+    if (size > UINT32_MAX - sizeof(trace_header_t)) {
+        return NULL;
+    }
+    trace_header_t *header = (trace_header_t *)ptr - 1;
+    /* The allocation stays accounted to the subsystem which allocated it, at the call site of the realloc */
+    esp_matter_mem_subsystem_t owner = (esp_matter_mem_subsystem_t)header->subsystem;
+    trace_unlink(header);
+    trace_header_t *new_header = (trace_header_t *)mem_realloc(header, sizeof(trace_header_t) + size);
+    if (!new_header) {
+        trace_link(header, owner, header->file, header->line, header->size);
+        return NULL;
+    }
+    trace_link(new_header, owner, file, line, size);
+    return new_header + 1;
+}
+
+esp_err_t esp_matter_mem_trace_get_stats(esp_matter_mem_subsystem_t subsystem, esp_matter_mem_trace_stats_t *stats)
+{
+    if (subsystem >= ESP_MATTER_MEM_SUBSYSTEM_COUNT || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    taskENTER_CRITICAL(&s_trace_lock);
+    *stats = s_trace_stats[subsystem];
+    taskEXIT_CRITICAL(&s_trace_lock);
+    return ESP_OK;
+}
+
+uint32_t esp_matter_mem_trace_snapshot()
+{
+    taskENTER_CRITICAL(&s_trace_lock);
+    uint32_t sequence = s_sequence;
+    taskEXIT_CRITICAL(&s_trace_lock);
+    return sequence;
+}
+
+void esp_matter_mem_trace_print_stats()
+{
+    printf("%-12s %10s %10s %8s %10s\n", "subsystem", "live", "peak", "count", "allocs");
+    for (int idx = 0; idx < ESP_MATTER_MEM_SUBSYSTEM_COUNT; ++idx) {
+        esp_matter_mem_trace_stats_t stats;
+        esp_matter_mem_trace_get_stats((esp_matter_mem_subsystem_t)idx, &stats);
+        printf("%-12s %10" PRIu32 " %10" PRIu32 " %8" PRIu32 " %10" PRIu32 "\n", k_subsystem_names[idx],
+               stats.live_bytes, stats.peak_bytes, stats.live_count, stats.alloc_count);
+    }
+}
+
+/* Live allocations of a call site, made after the snapshot */
+typedef struct {
+    const char *file;
+    uint16_t line;
+    uint8_t subsystem;
+    uint32_t count;
+    uint32_t bytes;
+} trace_site_t;
+
+#define TRACE_DIFF_MAX_SITES 32
+
+void esp_matter_mem_trace_print_diff(uint32_t snapshot)
+{
+    /* The list is walked with the lock held and the sites are printed after, the allocations of the sites which do
+     * not fit in the table are only counted */
+    trace_site_t sites[TRACE_DIFF_MAX_SITES];
+    size_t site_count = 0;
+    uint32_t other_count = 0;
+    uint32_t other_bytes = 0;
+    taskENTER_CRITICAL(&s_trace_lock);
+    /* The newest allocations are at the head of the list */
+    for (trace_header_t *header = s_live; header && header->sequence > snapshot; header = header->next) {
+        size_t idx = 0;
+        while (idx < site_count && (sites[idx].file != header->file || sites[idx].line != header->line)) {
+            idx++;
+        }
+        if (idx == site_count && site_count < TRACE_DIFF_MAX_SITES) {
+            sites[idx] = {header->file, header->line, header->subsystem, 0, 0};
+            site_count++;
+        }
+        if (idx < site_count) {
+            sites[idx].count++;
+            sites[idx].bytes += header->size;
+        } else {
+            other_count++;
+            other_bytes += header->size;
+        }
+    }
+    taskEXIT_CRITICAL(&s_trace_lock);
+
+    printf("Allocations still live since the snapshot %" PRIu32 ":\n", snapshot);
+    for (size_t idx = 0; idx < site_count; ++idx) {
+        printf("\t%s:%u (%s): %" PRIu32 " allocations, %" PRIu32 " bytes\n", sites[idx].file ? sites[idx].file : "?",
+               sites[idx].line, k_subsystem_names[sites[idx].subsystem], sites[idx].count, sites[idx].bytes);
+    }
+    if (other_count) {
+        printf("\tother sites: %" PRIu32 " allocations, %" PRIu32 " bytes\n", other_count, other_bytes);
+    }
+}
+
+/* The calls compiled without the call site macros, these are accounted to the application */
+IRAM_ATTR void *esp_matter_mem_calloc(size_t n, size_t size)
+{
+    return trace_calloc(ESP_MATTER_MEM_SUBSYSTEM_APPLICATION, NULL, 0, ESP_MATTER_MEM_TAG_DEFAULT, n, size);
+}
+
+IRAM_ATTR void *esp_matter_mem_calloc_tagged(esp_matter_mem_tag_t tag, size_t n, size_t size)
+{
+    return trace_calloc(ESP_MATTER_MEM_SUBSYSTEM_APPLICATION, NULL, 0, tag, n, size);
+}
+
+IRAM_ATTR void *esp_matter_mem_realloc(void *ptr, size_t size)
+{
+    return esp_matter_mem_trace_realloc(ESP_MATTER_MEM_SUBSYSTEM_APPLICATION, NULL, 0, ptr, size);
+}
+
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+void *esp_matter_mem_region_calloc(const char *name, size_t n, size_t size)
+{
+    return esp_matter_mem_trace_region_calloc(ESP_MATTER_MEM_SUBSYSTEM_APPLICATION, NULL, 0, name, n, size);
+}
+#endif
+
+IRAM_ATTR void esp_matter_mem_free(void *ptr)
+{
+    if (ptr) {
+        trace_header_t *header = (trace_header_t *)ptr - 1;
+        trace_unlink(header);
+        mem_free(header);
+    }
+}
+#else
+IRAM_ATTR void *esp_matter_mem_calloc(size_t n, size_t size)
+{
+    return mem_calloc(n, size);
+}
+
+IRAM_ATTR void *esp_matter_mem_calloc_tagged(esp_matter_mem_tag_t tag, size_t n, size_t size)
+{
+    return mem_calloc_tagged(tag, n, size);
+}
+
+IRAM_ATTR void *esp_matter_mem_realloc(void *ptr, size_t size)
+{
+    return mem_realloc(ptr, size);
+}
+
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+void *esp_matter_mem_region_calloc(const char *name, size_t n, size_t size)
+{
+    return mem_region_calloc(name, n, size);
+}
+#endif
+
+IRAM_ATTR void esp_matter_mem_free(void *ptr)
+{
+    mem_free(ptr);
+}
+#endif // CONFIG_ESP_MATTER_MEM_TRACE
@@ -14,6 +14,11 @@
 
 #pragma once
 
+#include <esp_err.h>
+#include <sdkconfig.h>
+#include <stddef.h>
+#include <stdint.h>
+
 /** ESP Matter Memory Allocations
  * @param[in] n number of elements to be allocated
  * @param[in] size size of elements to be allocated
@@ -30,3 +35,221 @@ void esp_matter_mem_free(void *ptr);
  * @param[in] size size to reallocate
  */
 void *esp_matter_mem_realloc(void *ptr, size_t size);
+
+/** Tags of the data model allocations, from the hot data read on every access to the cold data read on the
+ * (re)configuration of an endpoint */
+typedef enum {
+    /** Data model elements and other allocations without a tag */
+    ESP_MATTER_MEM_TAG_DEFAULT = 0,
+    /** Buffers of the string and array attribute values */
+    ESP_MATTER_MEM_TAG_ATTRIBUTE_VALUE,
+    /** Data versions of the clusters */
+    ESP_MATTER_MEM_TAG_DATA_VERSION,
+    /** Ember metadata: endpoint types, clusters, attributes, command and event lists */
+    ESP_MATTER_MEM_TAG_METADATA,
+    /** Device type arrays of the endpoints */
+    ESP_MATTER_MEM_TAG_DEVICE_TYPES,
+    /** Bounds of the attributes */
+    ESP_MATTER_MEM_TAG_BOUNDS,
+    /** Default values of the attributes */
+    ESP_MATTER_MEM_TAG_DEFAULT_VALUE,
+    ESP_MATTER_MEM_TAG_COUNT,
+} esp_matter_mem_tag_t;
+
+/** Placement of the allocations of a tag */
+typedef enum {
+    /** As esp_matter_mem_calloc(), with the memory allocation strategy and the pools */
+    ESP_MATTER_MEM_PLACEMENT_DEFAULT = 0,
+    /** Internal RAM */
+    ESP_MATTER_MEM_PLACEMENT_INTERNAL,
+    /** External SPIRAM, or as ESP_MATTER_MEM_PLACEMENT_DEFAULT if it is exhausted */
+    ESP_MATTER_MEM_PLACEMENT_EXTERNAL,
+} esp_matter_mem_placement_t;
+
+/** ESP Matter Memory Allocations with a tag
+ *
+ * The memory is placed as configured for the tag, and is freed with esp_matter_mem_free(). Without
+ * CONFIG_ESP_MATTER_MEM_TAGGED_PLACEMENT, this is esp_matter_mem_calloc().
+ *
+ * @param[in] tag tag of the allocation
+ * @param[in] n number of elements to be allocated
+ * @param[in] size size of elements to be allocated
+ */
+void *esp_matter_mem_calloc_tagged(esp_matter_mem_tag_t tag, size_t n, size_t size);
+
+/** ESP Matter set the placement of a tag
+ *
+ * The initial placements are set in the menuconfig. The new placement is used for the next allocations of the tag,
+ * the existing ones are not moved.
+ *
+ * @param[in] tag tag of the allocations
+ * @param[in] placement placement of the allocations
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the arguments are invalid.
+ * @return ESP_ERR_NOT_SUPPORTED if CONFIG_ESP_MATTER_MEM_TAGGED_PLACEMENT is disabled.
+ */
+esp_err_t esp_matter_mem_set_placement(esp_matter_mem_tag_t tag, esp_matter_mem_placement_t placement);
+
+#if CONFIG_ESP_MATTER_MEM_POOL
+/** Number of size classes of the pools, of 16, 32, 64 and 128 bytes */
+#define ESP_MATTER_MEM_POOL_CLASS_COUNT 4
+
+/** Statistics of the size-class pools */
+typedef struct {
+    /** Block size, number of blocks, blocks in use and highest number of blocks in use of each class */
+    uint16_t block_size[ESP_MATTER_MEM_POOL_CLASS_COUNT];
+    uint16_t block_count[ESP_MATTER_MEM_POOL_CLASS_COUNT];
+    uint16_t used[ESP_MATTER_MEM_POOL_CLASS_COUNT];
+    uint16_t max_used[ESP_MATTER_MEM_POOL_CLASS_COUNT];
+    /** Small allocations served by the heap because the pools were exhausted */
+    uint32_t fallback_count;
+} esp_matter_mem_pool_stats_t;
+
+/** ESP Matter memory pool statistics
+ * @param[out] stats statistics of the pools.
+ */
+void esp_matter_mem_pool_get_stats(esp_matter_mem_pool_stats_t *stats);
+#endif
+
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+/** Maximum length of the name of a region pool, including the terminating null character */
+#define ESP_MATTER_MEM_REGION_NAME_LEN 16
+
+/** Region pool of the memory of the BLE stack, reclaimed once the device is commissioned, see
+ * CONFIG_ESP_MATTER_BLE_MEM_REGION_POOL */
+#define ESP_MATTER_MEM_REGION_BLE "ble"
+
+/** Statistics of a region pool */
+typedef struct {
+    /** Number of regions of the pool, and the sum of their sizes */
+    uint16_t region_count;
+    size_t total_bytes;
+    /** Free bytes, the largest free block and the lowest number of free bytes since the regions were added */
+    size_t free_bytes;
+    size_t largest_free_block;
+    size_t min_free_bytes;
+} esp_matter_mem_region_stats_t;
+
+/** ESP Matter add a memory region to a named pool
+ *
+ * The region, which must not be in use by anything else, is managed as a heap of its own and is never given back.
+ * A pool can be made of several regions, for example the data and bss sections of a stack which is not used
+ * anymore. The allocations of the pool are freed with esp_matter_mem_free().
+ *
+ * @param[in] name name of the pool, at most ESP_MATTER_MEM_REGION_NAME_LEN - 1 characters
+ * @param[in] start start of the region
+ * @param[in] size size of the region
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the arguments are invalid or the region is too small.
+ * @return ESP_ERR_NO_MEM if CONFIG_ESP_MATTER_MEM_REGION_COUNT regions have already been added.
+ */
+esp_err_t esp_matter_mem_region_add(const char *name, void *start, size_t size);
+
+/** ESP Matter Memory Allocations from a named pool
+ *
+ * The memory is served from the regions of the pool, or as esp_matter_mem_calloc() when the pool has no region or
+ * is exhausted, so the callers do not have to know whether the regions were added. The allocations larger than the
+ * regions, like the bridged endpoints, the subscription buffers or the deferred persistence buffers, are the ones
+ * which benefit from a region which is not fragmented by the rest of the firmware.
+ *
+ * @param[in] name name of the pool
+ * @param[in] n number of elements to be allocated
+ * @param[in] size size of elements to be allocated
+ */
+void *esp_matter_mem_region_calloc(const char *name, size_t n, size_t size);
+
+/** ESP Matter statistics of a named pool
+ *
+ * @param[in] name name of the pool
+ * @param[out] stats statistics of the pool, all 0 if the pool has no region
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the arguments are invalid.
+ */
+esp_err_t esp_matter_mem_region_get_stats(const char *name, esp_matter_mem_region_stats_t *stats);
+#endif // CONFIG_ESP_MATTER_MEM_REGION_POOLS
+
+/** Subsystems of the allocations, for the accounting of the tracing */
+typedef enum {
+    /** Allocations of the application, and of the sources without a subsystem */
+    ESP_MATTER_MEM_SUBSYSTEM_APPLICATION = 0,
+    ESP_MATTER_MEM_SUBSYSTEM_DATA_MODEL,
+    ESP_MATTER_MEM_SUBSYSTEM_BRIDGE,
+    ESP_MATTER_MEM_SUBSYSTEM_CONTROLLER,
+    ESP_MATTER_MEM_SUBSYSTEM_CLIENT,
+    ESP_MATTER_MEM_SUBSYSTEM_RAINMAKER,
+    ESP_MATTER_MEM_SUBSYSTEM_COUNT,
+} esp_matter_mem_subsystem_t;
+
+/** Subsystem of the allocations of a source file. The components define it for their sources, a source file can
+ * redefine it after its includes. */
+#ifndef ESP_MATTER_MEM_SUBSYSTEM
+#define ESP_MATTER_MEM_SUBSYSTEM ESP_MATTER_MEM_SUBSYSTEM_APPLICATION
+#endif
+
+#if CONFIG_ESP_MATTER_MEM_TRACE
+/** Accounting of the allocations of a subsystem */
+typedef struct {
+    /** Bytes allocated and not freed yet, and the highest value they reached */
+    uint32_t live_bytes;
+    uint32_t peak_bytes;
+    /** Allocations not freed yet */
+    uint32_t live_count;
+    /** Allocations since boot, including the reallocations */
+    uint32_t alloc_count;
+} esp_matter_mem_trace_stats_t;
+
+/** ESP Matter traced allocations, called by the esp_matter_mem_* macros below with the call site
+ * @param[in] subsystem subsystem of the allocation
+ * @param[in] file file of the call site
+ * @param[in] line line of the call site
+ */
+void *esp_matter_mem_trace_calloc(esp_matter_mem_subsystem_t subsystem, const char *file, int line, size_t n,
+                                  size_t size);
+void *esp_matter_mem_trace_calloc_tagged(esp_matter_mem_subsystem_t subsystem, const char *file, int line,
+                                         esp_matter_mem_tag_t tag, size_t n, size_t size);
+void *esp_matter_mem_trace_realloc(esp_matter_mem_subsystem_t subsystem, const char *file, int line, void *ptr,
+                                   size_t size);
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+void *esp_matter_mem_trace_region_calloc(esp_matter_mem_subsystem_t subsystem, const char *file, int line,
+                                         const char *name, size_t n, size_t size);
+#endif
+
+/** ESP Matter allocation statistics of a subsystem
+ * @param[in] subsystem subsystem of the allocations
+ * @param[out] stats statistics of the subsystem
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the arguments are invalid.
+ */
+esp_err_t esp_matter_mem_trace_get_stats(esp_matter_mem_subsystem_t subsystem, esp_matter_mem_trace_stats_t *stats);
+
+/** ESP Matter allocation snapshot, for the leak checks
+ *
+ * @return The snapshot, to be passed to esp_matter_mem_trace_print_diff().
+ */
+uint32_t esp_matter_mem_trace_snapshot();
+
+/** ESP Matter print the statistics of all the subsystems */
+void esp_matter_mem_trace_print_stats();
+
+/** ESP Matter print the allocations made after a snapshot and not freed yet, grouped by call site
+ * @param[in] snapshot snapshot from esp_matter_mem_trace_snapshot(), 0 for all the live allocations.
+ */
+void esp_matter_mem_trace_print_diff(uint32_t snapshot);
+
+#ifndef ESP_MATTER_MEM_TRACE_IMPL
+#define esp_matter_mem_calloc(n, size) \
+    esp_matter_mem_trace_calloc(ESP_MATTER_MEM_SUBSYSTEM, __FILE__, __LINE__, n, size)
+#define esp_matter_mem_calloc_tagged(tag, n, size) \
+    esp_matter_mem_trace_calloc_tagged(ESP_MATTER_MEM_SUBSYSTEM, __FILE__, __LINE__, tag, n, size)
+#define esp_matter_mem_realloc(ptr, size) \
+    esp_matter_mem_trace_realloc(ESP_MATTER_MEM_SUBSYSTEM, __FILE__, __LINE__, ptr, size)
+#if CONFIG_ESP_MATTER_MEM_REGION_POOLS
+#define esp_matter_mem_region_calloc(name, n, size) \
+    esp_matter_mem_trace_region_calloc(ESP_MATTER_MEM_SUBSYSTEM, __FILE__, __LINE__, name, n, size)
+#endif
+#endif
+#endif // CONFIG_ESP_MATTER_MEM_TRACE
@@ -13,13 +13,14 @@
 // limitations under the License.
 
 #include <algorithm>
-#include <cJSON.h>
 #include <esp_check.h>
 #include <esp_matter_mem.h>
 #include <json_to_tlv.h>
 #include <lib/support/Base64.h>
 #include <lib/support/SafeInt.h>
 
+#include <errno.h>
+#include <limits>
 #include <stdlib.h>
 
 using namespace chip;
@@ -30,25 +31,49 @@ constexpr uint32_t k_temporary_implicit_profile_id = 0xFF01;
 
 namespace esp_matter {
 
+/*
+ * The JSON document is parsed in place, and each value is written to the TLV writer as soon as it is reached, without
+ * building a cJSON tree or copying the values. The members of a structure must be written in tag order: the member
+ * names are checked first, and if the members are already in order, which is the common case, they are written as they
+ * come. Otherwise an index of the members is allocated and sorted, and the values are written in that order. Arrays
+ * keep the JSON order. The recursion is bounded by k_max_json_depth.
+ */
+
 constexpr size_t k_max_json_name_len = 64;
+constexpr size_t k_max_json_number_len = 64;
+constexpr uint8_t k_max_json_depth = 16;
+
+struct json_cursor {
+    const char *cur;
+    const char *end;
+};
 
-struct element_context {
-    element_context() {}
-    ~element_context() {}
-    char json_name[k_max_json_name_len];
-    TLV::Tag tag = chip::TLV::AnonymousTag();
+struct member_context {
+    TLV::Tag tag;
     TLV::TLVElementType type;
     TLV::TLVElementType sub_type;
+    /* Start of the member value in the JSON document */
+    const char *value;
 };
 
-static int compare_by_tag(const void *a, const void *b)
+static int compare_tags(TLV::Tag a, TLV::Tag b)
 {
-    const element_context *element_a = (const element_context *)a;
-    const element_context *element_b = (const element_context *)b;
-    if (TLV::IsContextTag(element_a->tag) == TLV::IsContextTag(element_b->tag)) {
-        return (int)TLV::TagNumFromTag(element_a->tag) - (int)TLV::TagNumFromTag(element_b->tag);
+    if (TLV::IsContextTag(a) != TLV::IsContextTag(b)) {
+        return TLV::IsContextTag(a) ? 1 : -1;
     }
-    return TLV::IsContextTag(element_a->tag);
+    uint32_t tag_num_a = TLV::TagNumFromTag(a);
+    uint32_t tag_num_b = TLV::TagNumFromTag(b);
+    return tag_num_a < tag_num_b ? -1 : (tag_num_a > tag_num_b ? 1 : 0);
+}
+
+static int compare_by_tag(const void *a, const void *b)
+{
+    return compare_tags(((const member_context *)a)->tag, ((const member_context *)b)->tag);
+}
+
+static bool str_equal(const char *str, size_t len, const char *literal)
+{
+    return len == strlen(literal) && strncmp(str, literal, len) == 0;
 }
 
 static size_t get_char_count(const char *str, char ch)
@@ -180,31 +205,14 @@ static esp_err_t internal_convert_tlv_tag(const uint64_t tag_number, TLV::Tag &t
     return ESP_OK;
 }
 
-static esp_err_t parse_json_name(const char *name, element_context &element_ctx, uint32_t implicit_profile_id)
-{
-    uint64_t tag_number = 0;
-    ESP_RETURN_ON_FALSE(name, ESP_ERR_INVALID_ARG, TAG, "json name cannot be NULL");
-    ESP_RETURN_ON_ERROR(split_json_name(name, tag_number, element_ctx.type, element_ctx.sub_type), TAG,
-                        "Failed to parse json name");
-    ESP_RETURN_ON_ERROR(internal_convert_tlv_tag(tag_number, element_ctx.tag, implicit_profile_id), TAG,
-                        "Failed to convert TLV tag");
-    strncpy(element_ctx.json_name, name, strlen(name));
-    element_ctx.json_name[strlen(name)] = 0;
-    return ESP_OK;
-}
-
-static bool is_valid_base64_str(const char *str)
+static bool is_valid_base64_str(const char *str, size_t len)
 {
     const char *base64_chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    if (!str) {
-        return false;
-    }
-    size_t len = strlen(str);
-    if (len % 4 != 0) {
+    if (!str || len % 4 != 0) {
         return false;
     }
     size_t padding_len = 0;
-    if (str[len - 1] == '=') {
+    if (len > 0 && str[len - 1] == '=') {
         padding_len++;
         if (str[len - 2] == '=') {
             padding_len++;
@@ -218,232 +226,553 @@ static bool is_valid_base64_str(const char *str)
     return true;
 }
 
-static size_t get_object_element_count(const cJSON *json)
+static void skip_whitespace(json_cursor &cursor)
 {
-    ESP_RETURN_ON_FALSE(json->type == cJSON_Object, 0, TAG, "Invalid type");
-    size_t ret = 0;
-    cJSON *current_element = json->child;
-    while (current_element) {
-        current_element = current_element->next;
-        ret++;
+    while (cursor.cur < cursor.end &&
+           (*cursor.cur == ' ' || *cursor.cur == '\t' || *cursor.cur == '\n' || *cursor.cur == '\r')) {
+        cursor.cur++;
     }
-    return ret;
 }
 
-static esp_err_t encode_tlv_element(const cJSON *val, TLV::TLVWriter &writer, const element_context &element_ctx)
+static bool peek_char(json_cursor &cursor, char ch)
 {
-    TLV::Tag tag = element_ctx.tag;
-
-    switch (element_ctx.type) {
-    case TLVElementType::Int8: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint <= INT8_MAX && val->valueint >= INT8_MIN, ESP_ERR_INVALID_ARG, TAG,
-                            "Invalid range");
-        int8_t int8_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, int8_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        break;
-    }
-    case TLVElementType::Int16: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint <= INT16_MAX && val->valueint >= INT16_MIN, ESP_ERR_INVALID_ARG, TAG,
-                            "Invalid range");
-        int16_t int16_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, int16_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        break;
+    skip_whitespace(cursor);
+    return cursor.cur < cursor.end && *cursor.cur == ch;
+}
+
+static bool consume_char(json_cursor &cursor, char ch)
+{
+    if (peek_char(cursor, ch)) {
+        cursor.cur++;
+        return true;
     }
-    case TLVElementType::Int32: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        int32_t int32_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, int32_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        break;
+    return false;
+}
+
+static bool consume_literal(json_cursor &cursor, const char *literal)
+{
+    size_t len = strlen(literal);
+    skip_whitespace(cursor);
+    if ((size_t)(cursor.end - cursor.cur) >= len && strncmp(cursor.cur, literal, len) == 0) {
+        cursor.cur += len;
+        return true;
     }
-    case TLVElementType::Int64: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        int64_t int64_val =
-            (val->valueint < INT32_MAX && val->valueint > INT32_MIN) ? val->valueint : (int64_t)val->valuedouble;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, int64_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        break;
+    return false;
+}
+
+/* Scan a JSON string, str and len are set to the raw characters between the quotes */
+static esp_err_t scan_string(json_cursor &cursor, const char *&str, size_t &len, bool &has_escape)
+{
+    ESP_RETURN_ON_FALSE(consume_char(cursor, '"'), ESP_ERR_INVALID_ARG, TAG, "Expected string");
+    str = cursor.cur;
+    has_escape = false;
+    while (cursor.cur < cursor.end && *cursor.cur != '"') {
+        if (*cursor.cur == '\\') {
+            has_escape = true;
+            cursor.cur++;
+            ESP_RETURN_ON_FALSE(cursor.cur < cursor.end, ESP_ERR_INVALID_ARG, TAG, "Unterminated string");
+        } else {
+            ESP_RETURN_ON_FALSE((uint8_t)*cursor.cur >= 0x20, ESP_ERR_INVALID_ARG, TAG, "Invalid string character");
+        }
+        cursor.cur++;
     }
-    case TLVElementType::UInt8: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint <= UINT8_MAX && val->valueint >= 0, ESP_ERR_INVALID_ARG, TAG,
-                            "Invalid range");
-        uint8_t uint8_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, uint8_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        break;
+    ESP_RETURN_ON_FALSE(cursor.cur < cursor.end, ESP_ERR_INVALID_ARG, TAG, "Unterminated string");
+    len = cursor.cur - str;
+    cursor.cur++;
+    return ESP_OK;
+}
+
+static const char *skip_digits(const char *cur, const char *end)
+{
+    while (cur < end && *cur >= '0' && *cur <= '9') {
+        cur++;
     }
-    case TLVElementType::UInt16: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint <= UINT16_MAX && val->valueint >= 0, ESP_ERR_INVALID_ARG, TAG,
-                            "Invalid range");
-        uint16_t uint16_val = val->valueint;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, uint16_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        break;
+    return cur;
+}
+
+/* Scan a JSON number and copy it to buf as a NULL-terminated string */
+static esp_err_t scan_number(json_cursor &cursor, char (&buf)[k_max_json_number_len + 1], bool &is_integer)
+{
+    skip_whitespace(cursor);
+    const char *start = cursor.cur;
+    const char *cur = start;
+    const char *digits = NULL;
+    is_integer = true;
+    if (cur < cursor.end && *cur == '-') {
+        cur++;
+    }
+    digits = cur;
+    cur = skip_digits(cur, cursor.end);
+    ESP_RETURN_ON_FALSE(cur != digits, ESP_ERR_INVALID_ARG, TAG, "Invalid number");
+    if (cur < cursor.end && *cur == '.') {
+        is_integer = false;
+        digits = ++cur;
+        cur = skip_digits(cur, cursor.end);
+        ESP_RETURN_ON_FALSE(cur != digits, ESP_ERR_INVALID_ARG, TAG, "Invalid number");
+    }
+    if (cur < cursor.end && (*cur == 'e' || *cur == 'E')) {
+        is_integer = false;
+        cur++;
+        if (cur < cursor.end && (*cur == '+' || *cur == '-')) {
+            cur++;
+        }
+        digits = cur;
+        cur = skip_digits(cur, cursor.end);
+        ESP_RETURN_ON_FALSE(cur != digits, ESP_ERR_INVALID_ARG, TAG, "Invalid number");
+    }
+    size_t len = cur - start;
+    ESP_RETURN_ON_FALSE(len <= k_max_json_number_len, ESP_ERR_INVALID_ARG, TAG, "Number too long");
+    memcpy(buf, start, len);
+    buf[len] = 0;
+    cursor.cur = cur;
+    return ESP_OK;
+}
+
+/* Skip a JSON value, checking its syntax but not decoding it */
+static esp_err_t skip_value(json_cursor &cursor, uint8_t depth)
+{
+    ESP_RETURN_ON_FALSE(depth <= k_max_json_depth, ESP_ERR_INVALID_SIZE, TAG, "JSON nested too deep");
+    skip_whitespace(cursor);
+    ESP_RETURN_ON_FALSE(cursor.cur < cursor.end, ESP_ERR_INVALID_ARG, TAG, "Unexpected end of JSON");
+    const char *str = NULL;
+    size_t len = 0;
+    bool flag = false;
+    esp_err_t err = ESP_OK;
+    switch (*cursor.cur) {
+    case '"':
+        return scan_string(cursor, str, len, flag);
+    case '{':
+    case '[': {
+        bool is_object = *cursor.cur == '{';
+        char close = is_object ? '}' : ']';
+        cursor.cur++;
+        if (consume_char(cursor, close)) {
+            return ESP_OK;
+        }
+        do {
+            if (is_object) {
+                ESP_RETURN_ON_ERROR(scan_string(cursor, str, len, flag), TAG, "Invalid member name");
+                ESP_RETURN_ON_FALSE(consume_char(cursor, ':'), ESP_ERR_INVALID_ARG, TAG, "Expected ':'");
+            }
+            if ((err = skip_value(cursor, depth + 1)) != ESP_OK) {
+                return err;
+            }
+        } while (consume_char(cursor, ','));
+        ESP_RETURN_ON_FALSE(consume_char(cursor, close), ESP_ERR_INVALID_ARG, TAG, "Expected '%c'", close);
+        return ESP_OK;
     }
-    case TLVElementType::UInt32: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint >= 0, ESP_ERR_INVALID_ARG, TAG, "Invalid range");
-        uint32_t uint32_val = val->valueint < INT32_MAX ? val->valueint : (uint32_t)val->valuedouble;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, uint32_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        break;
+    case 't':
+    case 'f':
+    case 'n':
+        ESP_RETURN_ON_FALSE(consume_literal(cursor, "true") || consume_literal(cursor, "false") ||
+                                consume_literal(cursor, "null"),
+                            ESP_ERR_INVALID_ARG, TAG, "Invalid literal");
+        return ESP_OK;
+    default: {
+        char buf[k_max_json_number_len + 1];
+        return scan_number(cursor, buf, flag);
     }
-    case TLVElementType::UInt64: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Number, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(val->valueint >= 0, ESP_ERR_INVALID_ARG, TAG, "Invalid range");
-        uint64_t uint64_val = val->valueint < INT32_MAX ? val->valueint : (uint64_t)val->valuedouble;
-        ESP_RETURN_ON_FALSE(writer.Put(tag, uint64_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        break;
     }
-    case TLVElementType::FloatingPointNumber32: {
-        if (val->type == cJSON_Number) {
-            float float_val = val->valuedouble;
-            ESP_RETURN_ON_FALSE(writer.Put(tag, float_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        } else if (val->type == cJSON_String) {
-            if (strcmp(val->valuestring, element_type::k_floating_point_positive_infinity) == 0) {
-                ESP_RETURN_ON_FALSE(writer.Put(tag, std::numeric_limits<float>::infinity()) == CHIP_NO_ERROR, ESP_FAIL,
-                                    TAG, "Failed to encode");
-            } else if (strcmp(val->valuestring, element_type::k_floating_point_negative_infinity) == 0) {
-                ESP_RETURN_ON_FALSE(writer.Put(tag, -std::numeric_limits<float>::infinity()) == CHIP_NO_ERROR, ESP_FAIL,
-                                    TAG, "Failed to encode");
-            } else {
-                return ESP_ERR_INVALID_ARG;
-            }
+}
+
+static esp_err_t parse_hex4(const char *str, uint32_t &code)
+{
+    code = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        char ch = str[i];
+        code <<= 4;
+        if (ch >= '0' && ch <= '9') {
+            code |= ch - '0';
+        } else if (ch >= 'a' && ch <= 'f') {
+            code |= ch - 'a' + 10;
+        } else if (ch >= 'A' && ch <= 'F') {
+            code |= ch - 'A' + 10;
         } else {
-            ESP_LOGE(TAG, "Invalid type");
             return ESP_ERR_INVALID_ARG;
         }
-        break;
     }
-    case TLVElementType::FloatingPointNumber64: {
-        if (val->type == cJSON_Number) {
-            double double_val = val->valuedouble;
-            ESP_RETURN_ON_FALSE(writer.Put(tag, double_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
-        } else if (val->type == cJSON_String) {
-            if (strcmp(val->valuestring, element_type::k_floating_point_positive_infinity) == 0) {
-                ESP_RETURN_ON_FALSE(writer.Put(tag, std::numeric_limits<double>::infinity()) == CHIP_NO_ERROR, ESP_FAIL,
-                                    TAG, "Failed to encode");
-            } else if (strcmp(val->valuestring, element_type::k_floating_point_negative_infinity) == 0) {
-                ESP_RETURN_ON_FALSE(writer.Put(tag, -std::numeric_limits<double>::infinity()) == CHIP_NO_ERROR,
-                                    ESP_FAIL, TAG, "Failed to encode");
+    return ESP_OK;
+}
+
+static size_t encode_utf8(uint32_t code, char *out)
+{
+    if (code < 0x80) {
+        out[0] = code;
+        return 1;
+    } else if (code < 0x800) {
+        out[0] = 0xC0 | (code >> 6);
+        out[1] = 0x80 | (code & 0x3F);
+        return 2;
+    } else if (code < 0x10000) {
+        out[0] = 0xE0 | (code >> 12);
+        out[1] = 0x80 | ((code >> 6) & 0x3F);
+        out[2] = 0x80 | (code & 0x3F);
+        return 3;
+    }
+    out[0] = 0xF0 | (code >> 18);
+    out[1] = 0x80 | ((code >> 12) & 0x3F);
+    out[2] = 0x80 | ((code >> 6) & 0x3F);
+    out[3] = 0x80 | (code & 0x3F);
+    return 4;
+}
+
+/* Decode the escape sequences of a scanned string, out must hold at least len characters */
+static esp_err_t unescape_string(const char *str, size_t len, char *out, size_t &out_len)
+{
+    const char *end = str + len;
+    out_len = 0;
+    while (str < end) {
+        if (*str != '\\') {
+            out[out_len++] = *str++;
+            continue;
+        }
+        str++;
+        switch (*str) {
+        case '"':
+        case '\\':
+        case '/':
+            out[out_len++] = *str;
+            break;
+        case 'b':
+            out[out_len++] = '\b';
+            break;
+        case 'f':
+            out[out_len++] = '\f';
+            break;
+        case 'n':
+            out[out_len++] = '\n';
+            break;
+        case 'r':
+            out[out_len++] = '\r';
+            break;
+        case 't':
+            out[out_len++] = '\t';
+            break;
+        case 'u': {
+            uint32_t code = 0;
+            uint32_t low_surrogate = 0;
+            ESP_RETURN_ON_FALSE(end - str > 4 && parse_hex4(str + 1, code) == ESP_OK, ESP_ERR_INVALID_ARG, TAG,
+                                "Invalid unicode escape");
+            str += 4;
+            if (code >= 0xD800 && code <= 0xDBFF) {
+                ESP_RETURN_ON_FALSE(end - str > 6 && str[1] == '\\' && str[2] == 'u' &&
+                                        parse_hex4(str + 3, low_surrogate) == ESP_OK && low_surrogate >= 0xDC00 &&
+                                        low_surrogate <= 0xDFFF,
+                                    ESP_ERR_INVALID_ARG, TAG, "Invalid surrogate pair");
+                code = 0x10000 + ((code - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                str += 6;
             } else {
-                return ESP_ERR_INVALID_ARG;
+                ESP_RETURN_ON_FALSE(code < 0xDC00 || code > 0xDFFF, ESP_ERR_INVALID_ARG, TAG, "Invalid surrogate pair");
             }
+            out_len += encode_utf8(code, out + out_len);
+            break;
+        }
+        default:
+            ESP_LOGE(TAG, "Invalid escape sequence");
+            return ESP_ERR_INVALID_ARG;
+        }
+        str++;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t parse_member_name(json_cursor &cursor, member_context &member, uint32_t implicit_profile_id)
+{
+    const char *name = NULL;
+    size_t name_len = 0;
+    bool has_escape = false;
+    char name_buf[k_max_json_name_len];
+    uint64_t tag_number = 0;
+    ESP_RETURN_ON_ERROR(scan_string(cursor, name, name_len, has_escape), TAG, "Invalid member name");
+    ESP_RETURN_ON_FALSE(!has_escape && name_len < k_max_json_name_len, ESP_ERR_INVALID_ARG, TAG,
+                        "Invalid json name format");
+    memcpy(name_buf, name, name_len);
+    name_buf[name_len] = 0;
+    ESP_RETURN_ON_ERROR(split_json_name(name_buf, tag_number, member.type, member.sub_type), TAG,
+                        "Failed to parse json name");
+    ESP_RETURN_ON_ERROR(internal_convert_tlv_tag(tag_number, member.tag, implicit_profile_id), TAG,
+                        "Failed to convert TLV tag");
+    ESP_RETURN_ON_FALSE(consume_char(cursor, ':'), ESP_ERR_INVALID_ARG, TAG, "Expected ':'");
+    skip_whitespace(cursor);
+    member.value = cursor.cur;
+    return ESP_OK;
+}
+
+template <typename T>
+static esp_err_t encode_signed(json_cursor &cursor, TLV::TLVWriter &writer, TLV::Tag tag)
+{
+    char buf[k_max_json_number_len + 1];
+    bool is_integer = false;
+    ESP_RETURN_ON_ERROR(scan_number(cursor, buf, is_integer), TAG, "Invalid type");
+    ESP_RETURN_ON_FALSE(is_integer, ESP_ERR_INVALID_ARG, TAG, "Not an integer");
+    errno = 0;
+    long long value = strtoll(buf, NULL, 10);
+    ESP_RETURN_ON_FALSE(errno == 0 && value >= std::numeric_limits<T>::min() && value <= std::numeric_limits<T>::max(),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid range");
+    ESP_RETURN_ON_FALSE(writer.Put(tag, static_cast<T>(value)) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+    return ESP_OK;
+}
+
+template <typename T>
+static esp_err_t encode_unsigned(json_cursor &cursor, TLV::TLVWriter &writer, TLV::Tag tag)
+{
+    char buf[k_max_json_number_len + 1];
+    bool is_integer = false;
+    ESP_RETURN_ON_ERROR(scan_number(cursor, buf, is_integer), TAG, "Invalid type");
+    ESP_RETURN_ON_FALSE(is_integer, ESP_ERR_INVALID_ARG, TAG, "Not an integer");
+    ESP_RETURN_ON_FALSE(buf[0] != '-', ESP_ERR_INVALID_ARG, TAG, "Invalid range");
+    errno = 0;
+    unsigned long long value = strtoull(buf, NULL, 10);
+    ESP_RETURN_ON_FALSE(errno == 0 && value <= std::numeric_limits<T>::max(), ESP_ERR_INVALID_ARG, TAG,
+                        "Invalid range");
+    ESP_RETURN_ON_FALSE(writer.Put(tag, static_cast<T>(value)) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+    return ESP_OK;
+}
+
+template <typename T>
+static esp_err_t encode_floating_point(json_cursor &cursor, TLV::TLVWriter &writer, TLV::Tag tag)
+{
+    T value = 0;
+    if (peek_char(cursor, '"')) {
+        const char *str = NULL;
+        size_t len = 0;
+        bool has_escape = false;
+        ESP_RETURN_ON_ERROR(scan_string(cursor, str, len, has_escape), TAG, "Invalid type");
+        if (str_equal(str, len, element_type::k_floating_point_positive_infinity)) {
+            value = std::numeric_limits<T>::infinity();
+        } else if (str_equal(str, len, element_type::k_floating_point_negative_infinity)) {
+            value = -std::numeric_limits<T>::infinity();
         } else {
-            ESP_LOGE(TAG, "Invalid type");
             return ESP_ERR_INVALID_ARG;
         }
-        break;
+    } else {
+        char buf[k_max_json_number_len + 1];
+        bool is_integer = false;
+        ESP_RETURN_ON_ERROR(scan_number(cursor, buf, is_integer), TAG, "Invalid type");
+        value = static_cast<T>(strtod(buf, NULL));
     }
+    ESP_RETURN_ON_FALSE(writer.Put(tag, value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+    return ESP_OK;
+}
+
+static esp_err_t encode_tlv_element(json_cursor &cursor, TLV::TLVWriter &writer, TLV::Tag tag, TLVElementType type,
+                                    TLVElementType sub_type, uint8_t depth);
+
+static esp_err_t encode_array(json_cursor &cursor, TLV::TLVWriter &writer, TLV::Tag tag, TLVElementType sub_type,
+                              uint8_t depth)
+{
+    TLV::TLVType container_type;
+    esp_err_t err = ESP_OK;
+    ESP_RETURN_ON_FALSE(consume_char(cursor, '['), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+    ESP_RETURN_ON_FALSE(writer.StartContainer(tag, TLV::kTLVType_Array, container_type) == CHIP_NO_ERROR, ESP_FAIL,
+                        TAG, "Failed to start container");
+    if (!consume_char(cursor, ']')) {
+        if (sub_type == TLVElementType::NotSpecified) {
+            ESP_LOGE(TAG, "Invalid array size");
+            err = ESP_ERR_INVALID_ARG;
+        }
+        while (err == ESP_OK) {
+            /* The format has no subtype for the elements of nested arrays */
+            if ((err = encode_tlv_element(cursor, writer, TLV::AnonymousTag(), sub_type, TLVElementType::NotSpecified,
+                                          depth + 1)) != ESP_OK) {
+                break;
+            }
+            if (!consume_char(cursor, ',')) {
+                if (!consume_char(cursor, ']')) {
+                    ESP_LOGE(TAG, "Expected ']'");
+                    err = ESP_ERR_INVALID_ARG;
+                }
+                break;
+            }
+        }
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to encode");
+        writer.EndContainer(container_type);
+        return err;
+    }
+    ESP_RETURN_ON_FALSE(writer.EndContainer(container_type) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to end container");
+    return ESP_OK;
+}
+
+static esp_err_t encode_structure(json_cursor &cursor, TLV::TLVWriter &writer, TLV::Tag tag, uint8_t depth)
+{
+    TLV::TLVType container_type;
+    esp_err_t err = ESP_OK;
+    ESP_RETURN_ON_FALSE(consume_char(cursor, '{'), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+
+    /* Check the member names and the syntax of the values, to know whether the members are in tag order */
+    json_cursor scan = cursor;
+    member_context member;
+    TLV::Tag prev_tag = TLV::AnonymousTag();
+    size_t member_count = 0;
+    bool is_sorted = true;
+    if (!consume_char(scan, '}')) {
+        do {
+            ESP_RETURN_ON_ERROR(parse_member_name(scan, member, writer.ImplicitProfileId), TAG,
+                                "Failed to parse json name");
+            if ((err = skip_value(scan, depth + 1)) != ESP_OK) {
+                return err;
+            }
+            if (member_count > 0 && compare_tags(prev_tag, member.tag) > 0) {
+                is_sorted = false;
+            }
+            prev_tag = member.tag;
+            member_count++;
+        } while (consume_char(scan, ','));
+        ESP_RETURN_ON_FALSE(consume_char(scan, '}'), ESP_ERR_INVALID_ARG, TAG, "Expected '}'");
+    }
+
+    ESP_RETURN_ON_FALSE(writer.StartContainer(tag, TLV::kTLVType_Structure, container_type) == CHIP_NO_ERROR,
+                        ESP_FAIL, TAG, "Failed to start container");
+    if (is_sorted) {
+        for (size_t i = 0; i < member_count && err == ESP_OK; ++i) {
+            if (i > 0) {
+                consume_char(cursor, ',');
+            }
+            if ((err = parse_member_name(cursor, member, writer.ImplicitProfileId)) == ESP_OK) {
+                err = encode_tlv_element(cursor, writer, member.tag, member.type, member.sub_type, depth + 1);
+            }
+        }
+    } else {
+        member_context *members = (member_context *)esp_matter_mem_calloc(member_count, sizeof(member_context));
+        if (!members) {
+            ESP_LOGE(TAG, "No memory for members");
+            err = ESP_ERR_NO_MEM;
+        }
+        for (size_t i = 0; i < member_count && err == ESP_OK; ++i) {
+            if (i > 0) {
+                consume_char(cursor, ',');
+            }
+            if ((err = parse_member_name(cursor, members[i], writer.ImplicitProfileId)) == ESP_OK) {
+                err = skip_value(cursor, depth + 1);
+            }
+        }
+        if (err == ESP_OK) {
+            qsort(members, member_count, sizeof(member_context), compare_by_tag);
+        }
+        for (size_t i = 0; i < member_count && err == ESP_OK; ++i) {
+            json_cursor value_cursor = {members[i].value, cursor.end};
+            err = encode_tlv_element(value_cursor, writer, members[i].tag, members[i].type, members[i].sub_type,
+                                     depth + 1);
+        }
+        esp_matter_mem_free(members);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to encode");
+        writer.EndContainer(container_type);
+        return err;
+    }
+    cursor = scan;
+    ESP_RETURN_ON_FALSE(writer.EndContainer(container_type) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to end container");
+    return ESP_OK;
+}
+
+static esp_err_t encode_tlv_element(json_cursor &cursor, TLV::TLVWriter &writer, TLV::Tag tag, TLVElementType type,
+                                    TLVElementType sub_type, uint8_t depth)
+{
+    ESP_RETURN_ON_FALSE(depth <= k_max_json_depth, ESP_ERR_INVALID_SIZE, TAG, "JSON nested too deep");
+    const char *str = NULL;
+    size_t len = 0;
+    bool has_escape = false;
+
+    switch (type) {
+    case TLVElementType::Int8:
+        return encode_signed<int8_t>(cursor, writer, tag);
+    case TLVElementType::Int16:
+        return encode_signed<int16_t>(cursor, writer, tag);
+    case TLVElementType::Int32:
+        return encode_signed<int32_t>(cursor, writer, tag);
+    case TLVElementType::Int64:
+        return encode_signed<int64_t>(cursor, writer, tag);
+    case TLVElementType::UInt8:
+        return encode_unsigned<uint8_t>(cursor, writer, tag);
+    case TLVElementType::UInt16:
+        return encode_unsigned<uint16_t>(cursor, writer, tag);
+    case TLVElementType::UInt32:
+        return encode_unsigned<uint32_t>(cursor, writer, tag);
+    case TLVElementType::UInt64:
+        return encode_unsigned<uint64_t>(cursor, writer, tag);
+    case TLVElementType::FloatingPointNumber32:
+        return encode_floating_point<float>(cursor, writer, tag);
+    case TLVElementType::FloatingPointNumber64:
+        return encode_floating_point<double>(cursor, writer, tag);
     case TLVElementType::BooleanTrue:
     case TLVElementType::BooleanFalse: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_False || val->type == cJSON_True, ESP_ERR_INVALID_ARG, TAG,
-                            "Invalid type");
-        bool bool_val = (val->type == cJSON_True);
+        bool bool_val = consume_literal(cursor, "true");
+        ESP_RETURN_ON_FALSE(bool_val || consume_literal(cursor, "false"), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
         ESP_RETURN_ON_FALSE(writer.Put(tag, bool_val) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
         break;
     }
     case TLVElementType::ByteString_1ByteLength: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_String && val->valuestring, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        size_t encoded_len = strlen(val->valuestring);
-        ESP_RETURN_ON_FALSE(chip::CanCastTo<uint16_t>(encoded_len), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(is_valid_base64_str(val->valuestring), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_ERROR(scan_string(cursor, str, len, has_escape), TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(!has_escape && chip::CanCastTo<uint16_t>(len), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(is_valid_base64_str(str, len), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        if (len == 0) {
+            ESP_RETURN_ON_FALSE(writer.PutBytes(tag, NULL, 0) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
+            break;
+        }
         Platform::ScopedMemoryBuffer<uint8_t> byte_str;
-        byte_str.Alloc(BASE64_MAX_DECODED_LEN(static_cast<uint16_t>(encoded_len)));
+        byte_str.Alloc(BASE64_MAX_DECODED_LEN(static_cast<uint16_t>(len)));
         ESP_RETURN_ON_FALSE(byte_str.Get(), ESP_ERR_NO_MEM, TAG, "No memory");
-        auto decoded_len = Base64Decode(val->valuestring, static_cast<uint16_t>(encoded_len), byte_str.Get());
+        auto decoded_len = Base64Decode(str, static_cast<uint16_t>(len), byte_str.Get());
+        ESP_RETURN_ON_FALSE(decoded_len != UINT16_MAX, ESP_ERR_INVALID_ARG, TAG, "Invalid base64 string");
         ESP_RETURN_ON_FALSE(writer.PutBytes(tag, byte_str.Get(), decoded_len) == CHIP_NO_ERROR, ESP_FAIL, TAG,
                             "Failed to encode");
         break;
     }
     case TLVElementType::UTF8String_1ByteLength: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_String, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        ESP_RETURN_ON_FALSE(writer.PutString(tag, val->valuestring) == CHIP_NO_ERROR, ESP_FAIL, TAG,
-                            "Failed to encode");
+        ESP_RETURN_ON_ERROR(scan_string(cursor, str, len, has_escape), TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(chip::CanCastTo<uint32_t>(len), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        if (!has_escape) {
+            /* Most strings have no escape sequence and are written straight from the JSON document */
+            ESP_RETURN_ON_FALSE(writer.PutString(tag, str, static_cast<uint32_t>(len)) == CHIP_NO_ERROR, ESP_FAIL,
+                                TAG, "Failed to encode");
+            break;
+        }
+        Platform::ScopedMemoryBuffer<char> unescaped_str;
+        size_t unescaped_len = 0;
+        unescaped_str.Alloc(len);
+        ESP_RETURN_ON_FALSE(unescaped_str.Get(), ESP_ERR_NO_MEM, TAG, "No memory");
+        ESP_RETURN_ON_ERROR(unescape_string(str, len, unescaped_str.Get(), unescaped_len), TAG, "Invalid string");
+        ESP_RETURN_ON_FALSE(writer.PutString(tag, unescaped_str.Get(), static_cast<uint32_t>(unescaped_len)) ==
+                                CHIP_NO_ERROR,
+                            ESP_FAIL, TAG, "Failed to encode");
         break;
     }
     case TLVElementType::Null: {
-        ESP_RETURN_ON_FALSE(val->type == cJSON_NULL, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
+        ESP_RETURN_ON_FALSE(consume_literal(cursor, "null"), ESP_ERR_INVALID_ARG, TAG, "Invalid type");
         ESP_RETURN_ON_FALSE(writer.PutNull(tag) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to encode");
         break;
     }
-    case TLVElementType::Array: {
-        TLV::TLVType container_type;
-        esp_err_t err = ESP_OK;
-        size_t array_size = cJSON_GetArraySize(val);
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Array, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        if (element_ctx.sub_type == TLV::TLVElementType::NotSpecified) {
-            ESP_RETURN_ON_FALSE(array_size == 0, ESP_ERR_INVALID_ARG, TAG, "Invalid array size");
-        }
-        ESP_RETURN_ON_FALSE(writer.StartContainer(tag, TLV::kTLVType_Array, container_type) == CHIP_NO_ERROR, ESP_FAIL,
-                            TAG, "Failed to start container");
-        element_context nested_element_ctx;
-        nested_element_ctx.tag = TLV::AnonymousTag();
-        nested_element_ctx.type = element_ctx.sub_type;
-        for (size_t i = 0; i < array_size; ++i) {
-            if ((err = encode_tlv_element(cJSON_GetArrayItem(val, i), writer, nested_element_ctx)) != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to encode");
-                writer.EndContainer(container_type);
-                return err;
-            }
-        }
-        ESP_RETURN_ON_FALSE(writer.EndContainer(container_type) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to end container");
-        break;
-    }
-    case TLVElementType::Structure: {
-        TLV::TLVType container_type;
-        esp_err_t err = ESP_OK;
-        ESP_RETURN_ON_FALSE(val->type == cJSON_Object, ESP_ERR_INVALID_ARG, TAG, "Invalid type");
-        size_t element_count = get_object_element_count(val);
-        auto element_array = std::make_unique<element_context[]>(element_count);
-        ESP_RETURN_ON_FALSE(element_array.get(), ESP_ERR_NO_MEM, TAG, "No memory for element_array");
-        cJSON *element = val->child;
-        size_t element_idx = 0;
-        while (element && element_idx < element_count) {
-            ESP_RETURN_ON_ERROR(parse_json_name(element->string, element_array[element_idx], writer.ImplicitProfileId),
-                                TAG, "Failed to parse json name");
-            element = element->next;
-            element_idx++;
-        }
-        qsort(element_array.get(), element_count, sizeof(element_context), compare_by_tag);
-        ESP_RETURN_ON_FALSE(writer.StartContainer(tag, TLV::kTLVType_Structure, container_type) == CHIP_NO_ERROR,
-                            ESP_FAIL, TAG, "Failed to start container");
-        for (element_idx = 0; element_idx < element_count; ++element_idx) {
-            if ((err = encode_tlv_element(cJSON_GetObjectItem(val, element_array[element_idx].json_name), writer,
-                                          element_array[element_idx])) != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to encode");
-                writer.EndContainer(container_type);
-                return err;
-            }
-        }
-        ESP_RETURN_ON_FALSE(writer.EndContainer(container_type) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to end container");
-        break;
-    }
+    case TLVElementType::Array:
+        return encode_array(cursor, writer, tag, sub_type, depth);
+    case TLVElementType::Structure:
+        return encode_structure(cursor, writer, tag, depth);
     default:
         break;
     }
     return ESP_OK;
 }
 
-esp_err_t json_to_tlv(const char *json_str, chip::TLV::TLVWriter &writer, chip::TLV::Tag tag)
+esp_err_t json_to_tlv(const char *json_str, size_t json_len, chip::TLV::TLVWriter &writer, chip::TLV::Tag tag)
 {
-    cJSON *json = cJSON_Parse(json_str);
-    if (!json) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    if (json->type != cJSON_Object) {
-        cJSON_Delete(json);
+    ESP_RETURN_ON_FALSE(json_str, ESP_ERR_INVALID_ARG, TAG, "json_str cannot be NULL");
+    json_cursor cursor = {json_str, json_str + json_len};
+    if (!peek_char(cursor, '{')) {
         return ESP_ERR_INVALID_ARG;
     }
-    element_context element_ctx;
-    element_ctx.type = TLVElementType::Structure;
-    element_ctx.sub_type = TLVElementType::NotSpecified;
-    element_ctx.tag = tag;
-    esp_err_t err = encode_tlv_element(json, writer, element_ctx);
+    esp_err_t err = encode_tlv_element(cursor, writer, tag, TLVElementType::Structure, TLVElementType::NotSpecified, 0);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to encode tlv element");
     }
-    cJSON_Delete(json);
     return err;
 }
 
+esp_err_t json_to_tlv(const char *json_str, chip::TLV::TLVWriter &writer, chip::TLV::Tag tag)
+{
+    ESP_RETURN_ON_FALSE(json_str, ESP_ERR_INVALID_ARG, TAG, "json_str cannot be NULL");
+    return json_to_tlv(json_str, strlen(json_str), writer, tag);
+}
+
 } // namespace esp_matter
@@ -45,6 +45,9 @@ const char k_floating_point_negative_infinity[] = "-INF";
 } // namespace element_type
 
 /** Convert a JSON object to the given TLVWriter
+ *
+ * The JSON string is parsed in place and encoded in a single pass, without building an intermediate JSON tree. The
+ * members of the structures are sorted by tag only when they are not already in tag order.
  *
  * @param[in]   json_str The JSON string that represents a TLV structure
  * @param[out]  writer   The TLV output from the JSON object
@@ -55,4 +58,16 @@ const char k_floating_point_negative_infinity[] = "-INF";
  */
 esp_err_t json_to_tlv(const char *json_str, chip::TLV::TLVWriter &writer, chip::TLV::Tag tag);
 
+/** Convert a JSON object which is not NULL-terminated to the given TLVWriter
+ *
+ * @param[in]   json_str The JSON string that represents a TLV structure
+ * @param[in]   json_len The length of the JSON string
+ * @param[out]  writer   The TLV output from the JSON object
+ * @param[in]   tag      The TLV tag of the TLV structure
+ *
+ * @return ESP_OK on success
+ * @return error in case of failure
+ */
+esp_err_t json_to_tlv(const char *json_str, size_t json_len, chip::TLV::TLVWriter &writer, chip::TLV::Tag tag);
+
 } // namespace esp_matter
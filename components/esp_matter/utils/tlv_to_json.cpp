@@ -0,0 +1,374 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <esp_check.h>
+#include <lib/support/Base64.h>
+#include <tlv_to_json.h>
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace chip;
+using chip::TLV::TLVElementType;
+
+constexpr char TAG[] = "TlvToJson";
+
+namespace esp_matter {
+
+/*
+ * The TLV elements are written to a small output buffer which is flushed to the sink when it is full, so that the
+ * sink is not called for every token. The byte strings are base64 encoded in chunks of k_base64_chunk_len bytes.
+ */
+
+constexpr size_t k_output_buf_size = 64;
+constexpr size_t k_base64_chunk_len = 48;
+constexpr uint8_t k_max_tlv_depth = 16;
+
+struct json_output {
+    json_sink_t sink;
+    void *ctx;
+    char buf[k_output_buf_size];
+    size_t len;
+};
+
+struct buffer_sink_context {
+    char *buf;
+    size_t size;
+    size_t len;
+};
+
+static esp_err_t flush_output(json_output &out)
+{
+    esp_err_t err = ESP_OK;
+    if (out.len > 0) {
+        err = out.sink(out.ctx, out.buf, out.len);
+        out.len = 0;
+    }
+    return err;
+}
+
+static esp_err_t write_output(json_output &out, const char *data, size_t len)
+{
+    while (len > 0) {
+        size_t copy_len = std::min(len, k_output_buf_size - out.len);
+        memcpy(out.buf + out.len, data, copy_len);
+        out.len += copy_len;
+        data += copy_len;
+        len -= copy_len;
+        if (out.len == k_output_buf_size) {
+            ESP_RETURN_ON_ERROR(flush_output(out), TAG, "Failed to write the JSON output");
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t write_output(json_output &out, const char *str)
+{
+    return write_output(out, str, strlen(str));
+}
+
+static TLVElementType get_element_type(const TLV::TLVReader &reader)
+{
+    return static_cast<TLVElementType>(reader.GetControlByte() & TLV::kTLVTypeMask);
+}
+
+static const char *element_type_to_str(TLVElementType type)
+{
+    switch (type) {
+    case TLVElementType::Int8:
+        return element_type::k_int8;
+    case TLVElementType::Int16:
+        return element_type::k_int16;
+    case TLVElementType::Int32:
+        return element_type::k_int32;
+    case TLVElementType::Int64:
+        return element_type::k_int64;
+    case TLVElementType::UInt8:
+        return element_type::k_uint8;
+    case TLVElementType::UInt16:
+        return element_type::k_uint16;
+    case TLVElementType::UInt32:
+        return element_type::k_uint32;
+    case TLVElementType::UInt64:
+        return element_type::k_uint64;
+    case TLVElementType::BooleanFalse:
+    case TLVElementType::BooleanTrue:
+        return element_type::k_bool;
+    case TLVElementType::FloatingPointNumber32:
+        return element_type::k_float;
+    case TLVElementType::FloatingPointNumber64:
+        return element_type::k_double;
+    case TLVElementType::UTF8String_1ByteLength:
+    case TLVElementType::UTF8String_2ByteLength:
+    case TLVElementType::UTF8String_4ByteLength:
+    case TLVElementType::UTF8String_8ByteLength:
+        return element_type::k_string;
+    case TLVElementType::ByteString_1ByteLength:
+    case TLVElementType::ByteString_2ByteLength:
+    case TLVElementType::ByteString_4ByteLength:
+    case TLVElementType::ByteString_8ByteLength:
+        return element_type::k_bytes;
+    case TLVElementType::Null:
+        return element_type::k_null;
+    case TLVElementType::Structure:
+        return element_type::k_object;
+    case TLVElementType::Array:
+        return element_type::k_array;
+    default:
+        return NULL;
+    }
+}
+
+/* Write the "<tag>:<type>" name of a structure member or of the top-level element */
+static esp_err_t write_element_name(json_output &out, const TLV::TLVReader &reader)
+{
+    TLV::Tag tag = reader.GetTag();
+    TLVElementType type = get_element_type(reader);
+    const char *type_str = element_type_to_str(type);
+    const char *sub_type_str = NULL;
+    uint32_t tag_number = TLV::IsContextTag(tag) || TLV::IsProfileTag(tag) ? TLV::TagNumFromTag(tag) : 0;
+    char name[32];
+
+    ESP_RETURN_ON_FALSE(type_str, ESP_ERR_NOT_SUPPORTED, TAG, "Unsupported TLV element type 0x%02x",
+                        static_cast<unsigned>(type));
+    if (type == TLVElementType::Array) {
+        /* The subtype is the type of the first element, as the format cannot describe mixed arrays */
+        TLV::TLVReader array_reader;
+        TLV::TLVType container_type;
+        array_reader.Init(reader);
+        ESP_RETURN_ON_FALSE(array_reader.EnterContainer(container_type) == CHIP_NO_ERROR, ESP_FAIL, TAG,
+                            "Failed to enter container");
+        if (array_reader.Next() == CHIP_NO_ERROR) {
+            sub_type_str = element_type_to_str(get_element_type(array_reader));
+            ESP_RETURN_ON_FALSE(sub_type_str, ESP_ERR_NOT_SUPPORTED, TAG, "Unsupported TLV element type");
+        } else {
+            sub_type_str = element_type::k_empty;
+        }
+    }
+    if (sub_type_str) {
+        snprintf(name, sizeof(name), "\"%" PRIu32 ":%s-%s\":", tag_number, type_str, sub_type_str);
+    } else {
+        snprintf(name, sizeof(name), "\"%" PRIu32 ":%s\":", tag_number, type_str);
+    }
+    return write_output(out, name);
+}
+
+static esp_err_t write_escaped_string(json_output &out, const char *str, size_t len)
+{
+    const char *run = str;
+    const char *end = str + len;
+    char escape[7];
+
+    ESP_RETURN_ON_ERROR(write_output(out, "\""), TAG, "Failed to write the JSON output");
+    for (; str < end; ++str) {
+        uint8_t ch = static_cast<uint8_t>(*str);
+        if (ch >= 0x20 && ch != '"' && ch != '\\') {
+            continue;
+        }
+        /* Write the characters which need no escaping at once */
+        ESP_RETURN_ON_ERROR(write_output(out, run, str - run), TAG, "Failed to write the JSON output");
+        run = str + 1;
+        switch (ch) {
+        case '"':
+            strcpy(escape, "\\\"");
+            break;
+        case '\\':
+            strcpy(escape, "\\\\");
+            break;
+        case '\n':
+            strcpy(escape, "\\n");
+            break;
+        case '\r':
+            strcpy(escape, "\\r");
+            break;
+        case '\t':
+            strcpy(escape, "\\t");
+            break;
+        default:
+            snprintf(escape, sizeof(escape), "\\u%04x", ch);
+            break;
+        }
+        ESP_RETURN_ON_ERROR(write_output(out, escape), TAG, "Failed to write the JSON output");
+    }
+    ESP_RETURN_ON_ERROR(write_output(out, run, end - run), TAG, "Failed to write the JSON output");
+    return write_output(out, "\"");
+}
+
+static esp_err_t write_base64(json_output &out, const uint8_t *data, size_t len)
+{
+    char encoded[BASE64_ENCODED_LEN(k_base64_chunk_len)];
+
+    ESP_RETURN_ON_ERROR(write_output(out, "\""), TAG, "Failed to write the JSON output");
+    while (len > 0) {
+        /* The chunk length is a multiple of 3, so only the last chunk is padded */
+        uint16_t chunk_len = static_cast<uint16_t>(std::min(len, k_base64_chunk_len));
+        uint16_t encoded_len = Base64Encode(data, chunk_len, encoded);
+        ESP_RETURN_ON_ERROR(write_output(out, encoded, encoded_len), TAG, "Failed to write the JSON output");
+        data += chunk_len;
+        len -= chunk_len;
+    }
+    return write_output(out, "\"");
+}
+
+static esp_err_t write_floating_point(json_output &out, double value, bool is_double)
+{
+    char buf[32];
+    if (isinf(value)) {
+        snprintf(buf, sizeof(buf), "\"%s\"",
+                 value > 0 ? element_type::k_floating_point_positive_infinity
+                           : element_type::k_floating_point_negative_infinity);
+    } else {
+        ESP_RETURN_ON_FALSE(!isnan(value), ESP_ERR_NOT_SUPPORTED, TAG, "NaN cannot be represented");
+        snprintf(buf, sizeof(buf), is_double ? "%.17g" : "%.9g", value);
+    }
+    return write_output(out, buf);
+}
+
+static esp_err_t write_value(json_output &out, TLV::TLVReader &reader, uint8_t depth)
+{
+    ESP_RETURN_ON_FALSE(depth <= k_max_tlv_depth, ESP_ERR_INVALID_SIZE, TAG, "TLV nested too deep");
+    TLVElementType type = get_element_type(reader);
+    char buf[24];
+
+    switch (type) {
+    case TLVElementType::Int8:
+    case TLVElementType::Int16:
+    case TLVElementType::Int32:
+    case TLVElementType::Int64: {
+        int64_t value = 0;
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to decode");
+        snprintf(buf, sizeof(buf), "%" PRId64, value);
+        return write_output(out, buf);
+    }
+    case TLVElementType::UInt8:
+    case TLVElementType::UInt16:
+    case TLVElementType::UInt32:
+    case TLVElementType::UInt64: {
+        uint64_t value = 0;
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to decode");
+        snprintf(buf, sizeof(buf), "%" PRIu64, value);
+        return write_output(out, buf);
+    }
+    case TLVElementType::BooleanFalse:
+    case TLVElementType::BooleanTrue:
+        return write_output(out, type == TLVElementType::BooleanTrue ? "true" : "false");
+    case TLVElementType::FloatingPointNumber32:
+    case TLVElementType::FloatingPointNumber64: {
+        double value = 0;
+        ESP_RETURN_ON_FALSE(reader.Get(value) == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to decode");
+        return write_floating_point(out, value, type == TLVElementType::FloatingPointNumber64);
+    }
+    case TLVElementType::UTF8String_1ByteLength:
+    case TLVElementType::UTF8String_2ByteLength:
+    case TLVElementType::UTF8String_4ByteLength:
+    case TLVElementType::UTF8String_8ByteLength:
+    case TLVElementType::ByteString_1ByteLength:
+    case TLVElementType::ByteString_2ByteLength:
+    case TLVElementType::ByteString_4ByteLength:
+    case TLVElementType::ByteString_8ByteLength: {
+        const uint8_t *data = NULL;
+        uint32_t len = reader.GetLength();
+        if (len > 0) {
+            ESP_RETURN_ON_FALSE(reader.GetDataPtr(data) == CHIP_NO_ERROR, ESP_FAIL, TAG,
+                                "The string is not contained in a single buffer");
+        }
+        if (reader.GetType() == TLV::kTLVType_UTF8String) {
+            return write_escaped_string(out, reinterpret_cast<const char *>(data), len);
+        }
+        return write_base64(out, data, len);
+    }
+    case TLVElementType::Null:
+        return write_output(out, "null");
+    case TLVElementType::Structure:
+    case TLVElementType::Array: {
+        bool is_structure = type == TLVElementType::Structure;
+        TLV::TLVType container_type;
+        CHIP_ERROR chip_err = CHIP_NO_ERROR;
+        bool is_first = true;
+        ESP_RETURN_ON_FALSE(reader.EnterContainer(container_type) == CHIP_NO_ERROR, ESP_FAIL, TAG,
+                            "Failed to enter container");
+        ESP_RETURN_ON_ERROR(write_output(out, is_structure ? "{" : "["), TAG, "Failed to write the JSON output");
+        while ((chip_err = reader.Next()) == CHIP_NO_ERROR) {
+            if (!is_first) {
+                ESP_RETURN_ON_ERROR(write_output(out, ","), TAG, "Failed to write the JSON output");
+            }
+            is_first = false;
+            if (is_structure) {
+                ESP_RETURN_ON_ERROR(write_element_name(out, reader), TAG, "Failed to write the member name");
+            }
+            esp_err_t err = write_value(out, reader, depth + 1);
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+        ESP_RETURN_ON_FALSE(chip_err == CHIP_END_OF_TLV, ESP_FAIL, TAG, "Failed to decode: %s",
+                            chip::ErrorStr(chip_err));
+        ESP_RETURN_ON_FALSE(reader.ExitContainer(container_type) == CHIP_NO_ERROR, ESP_FAIL, TAG,
+                            "Failed to exit container");
+        return write_output(out, is_structure ? "}" : "]");
+    }
+    default:
+        ESP_LOGE(TAG, "Unsupported TLV element type 0x%02x", static_cast<unsigned>(type));
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+}
+
+esp_err_t tlv_to_json(const TLV::TLVReader &reader, json_sink_t sink, void *ctx)
+{
+    ESP_RETURN_ON_FALSE(sink, ESP_ERR_INVALID_ARG, TAG, "sink cannot be NULL");
+    json_output out;
+    out.sink = sink;
+    out.ctx = ctx;
+    out.len = 0;
+    TLV::TLVReader element_reader;
+    element_reader.Init(reader);
+
+    ESP_RETURN_ON_ERROR(write_output(out, "{"), TAG, "Failed to write the JSON output");
+    ESP_RETURN_ON_ERROR(write_element_name(out, element_reader), TAG, "Failed to write the element name");
+    esp_err_t err = write_value(out, element_reader, 0);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to convert the TLV element");
+        return err;
+    }
+    ESP_RETURN_ON_ERROR(write_output(out, "}"), TAG, "Failed to write the JSON output");
+    return flush_output(out);
+}
+
+static esp_err_t buffer_sink(void *ctx, const char *data, size_t len)
+{
+    buffer_sink_context *buffer = (buffer_sink_context *)ctx;
+    if (buffer->len + len >= buffer->size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(buffer->buf + buffer->len, data, len);
+    buffer->len += len;
+    return ESP_OK;
+}
+
+esp_err_t tlv_to_json(const TLV::TLVReader &reader, char *json_buf, size_t json_buf_size, size_t *json_len)
+{
+    ESP_RETURN_ON_FALSE(json_buf && json_buf_size > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid JSON buffer");
+    buffer_sink_context buffer = {json_buf, json_buf_size, 0};
+    esp_err_t err = tlv_to_json(reader, buffer_sink, &buffer);
+    json_buf[buffer.len] = 0;
+    if (json_len) {
+        *json_len = buffer.len;
+    }
+    return err;
+}
+
+} // namespace esp_matter
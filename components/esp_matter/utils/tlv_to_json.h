@@ -0,0 +1,68 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <json_to_tlv.h>
+#include <lib/core/TLV.h>
+
+namespace esp_matter {
+
+/** Output of the TLV to JSON conversion
+ *
+ * The sink is called with consecutive chunks of the JSON string, which are not NULL-terminated.
+ *
+ * @param[in]   ctx  The context given to tlv_to_json
+ * @param[in]   data The chunk of the JSON string
+ * @param[in]   len  The length of the chunk
+ *
+ * @return ESP_OK on success
+ * @return error in case of failure, which stops the conversion
+ */
+typedef esp_err_t (*json_sink_t)(void *ctx, const char *data, size_t len);
+
+/** Convert a TLV element to compact JSON, streamed to a sink
+ *
+ * The JSON uses the same format as json_to_tlv: the element is written as the single member of a JSON object, named
+ * "<tag>:<type>", with the tag 0 if the element is anonymous. The output can therefore be given back to json_to_tlv,
+ * for example to write an attribute value which was read. The integers keep the width used in the TLV encoding.
+ *
+ * The conversion does not allocate memory. The strings and byte strings are read in place, so the element must be
+ * contained in a single buffer, which is the case for the readers given to the controller callbacks.
+ *
+ * @param[in]   reader The TLV reader positioned on the element, it is not moved
+ * @param[in]   sink   The output of the JSON string
+ * @param[in]   ctx    The context given to the sink
+ *
+ * @return ESP_OK on success
+ * @return error in case of failure
+ */
+esp_err_t tlv_to_json(const chip::TLV::TLVReader &reader, json_sink_t sink, void *ctx);
+
+/** Convert a TLV element to compact JSON, written to a buffer
+ *
+ * @param[in]   reader        The TLV reader positioned on the element, it is not moved
+ * @param[out]  json_buf      The NULL-terminated JSON string
+ * @param[in]   json_buf_size The size of the buffer
+ * @param[out]  json_len      The length of the JSON string, can be NULL
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_SIZE if the buffer is too small
+ * @return error in case of failure
+ */
+esp_err_t tlv_to_json(const chip::TLV::TLVReader &reader, char *json_buf, size_t json_buf_size,
+                      size_t *json_len = nullptr);
+
+} // namespace esp_matter
@@ -14,230 +14,471 @@
 
 #include <esp_log.h>
 #include <esp_matter.h>
+#include <esp_timer.h>
 #include <nvs.h>
 #include <nvs_flash.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <esp_matter_bridge.h>
+#include <esp_matter_bridge_mirror.h>
 #include <esp_matter_mem.h>
 #include <nvs_key_allocator.h>
+
+#include <app/EventLogging.h>
+#include <platform/CHIPDeviceLayer.h>
 #if MAX_BRIDGED_DEVICE_COUNT > 0
 
 static const char *TAG = "esp_matter_bridge";
 
 using namespace esp_matter;
 using namespace esp_matter::endpoint;
+using namespace chip::app::Clusters;
 
 namespace esp_matter_bridge {
 
-static uint16_t bridged_endpoint_id_array[MAX_BRIDGED_DEVICE_COUNT];
+/* Persistent information of the bridged devices, sorted by endpoint ID. The table grows with the number of devices, up
+ * to max_device_count, which cannot be more than the dynamic endpoints left for the bridged devices. */
+static device_persistent_info_t *device_table = NULL;
+static uint16_t device_count = 0;
+static uint16_t device_capacity = 0;
+static uint16_t max_device_count = MAX_BRIDGED_DEVICE_COUNT;
+static uint16_t batch_depth = 0;
+static bool device_table_dirty = false;
 
-/** Persistent Bridged Device Info **/
-static esp_err_t store_device_persistent_info(device_persistent_info_t *persistent_info)
+#define DEVICE_TABLE_VERSION 1
+
+/* The device table is stored as a single blob, the header followed by the persistent info of the used slots */
+typedef struct {
+    uint8_t version;
+    uint8_t entry_size;
+    uint16_t count;
+} device_table_header_t;
+
+/** Device table **/
+static size_t device_table_lower_bound(uint16_t endpoint_id)
 {
-    esp_err_t err = ESP_OK;
+    size_t low = 0;
+    size_t high = device_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (device_table[mid].device_endpoint_id < endpoint_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static device_persistent_info_t *find_device_persistent_info(uint16_t endpoint_id)
+{
+    size_t idx = device_table_lower_bound(endpoint_id);
+    if (idx < device_count && device_table[idx].device_endpoint_id == endpoint_id) {
+        return &device_table[idx];
+    }
+    return NULL;
+}
+
+static esp_err_t reserve_device_table(size_t capacity)
+{
+    if (capacity <= device_capacity) {
+        return ESP_OK;
+    }
+    size_t new_capacity = device_capacity ? device_capacity * 2 : 4;
+    if (new_capacity < capacity) {
+        new_capacity = capacity;
+    }
+    if (new_capacity > MAX_BRIDGED_DEVICE_COUNT) {
+        new_capacity = MAX_BRIDGED_DEVICE_COUNT;
+    }
+    if (new_capacity < capacity) {
+        return ESP_ERR_NO_MEM;
+    }
+    device_persistent_info_t *table = (device_persistent_info_t *)esp_matter_mem_realloc(device_table,
+                                                                     new_capacity * sizeof(device_persistent_info_t));
+    if (!table) {
+        ESP_LOGE(TAG, "Could not grow the device table to %u devices", (unsigned)new_capacity);
+        return ESP_ERR_NO_MEM;
+    }
+    device_table = table;
+    device_capacity = new_capacity;
+    return ESP_OK;
+}
+
+static esp_err_t insert_device_persistent_info(const device_persistent_info_t *persistent_info)
+{
+    size_t idx = device_table_lower_bound(persistent_info->device_endpoint_id);
+    if (idx < device_count && device_table[idx].device_endpoint_id == persistent_info->device_endpoint_id) {
+        device_table[idx] = *persistent_info;
+        return ESP_OK;
+    }
+    if (device_count >= max_device_count) {
+        ESP_LOGE(TAG, "The maximum number of bridged devices (%u) is reached", max_device_count);
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t err = reserve_device_table(device_count + 1);
+    if (err != ESP_OK) {
+        return err;
+    }
+    memmove(&device_table[idx + 1], &device_table[idx], (device_count - idx) * sizeof(device_persistent_info_t));
+    device_table[idx] = *persistent_info;
+    device_count++;
+    return ESP_OK;
+}
+
+static bool remove_device_persistent_info(uint16_t endpoint_id)
+{
+    device_persistent_info_t *persistent_info = find_device_persistent_info(endpoint_id);
     if (!persistent_info) {
-        ESP_LOGE(TAG, "persistent_info cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
+        return false;
     }
+    size_t idx = persistent_info - device_table;
+    memmove(&device_table[idx], &device_table[idx + 1], (device_count - idx - 1) * sizeof(device_persistent_info_t));
+    device_count--;
+    return true;
+}
 
-    nvs_handle_t handle;
-    err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE, NVS_READWRITE,
-                                  &handle);
+static void clear_device_table()
+{
+    esp_matter_mem_free(device_table);
+    device_table = NULL;
+    device_count = 0;
+    device_capacity = 0;
+}
+
+static int compare_device_persistent_info(const void *a, const void *b)
+{
+    uint16_t a_id = ((const device_persistent_info_t *)a)->device_endpoint_id;
+    uint16_t b_id = ((const device_persistent_info_t *)b)->device_endpoint_id;
+    return a_id < b_id ? -1 : (a_id > b_id ? 1 : 0);
+}
+
+/** Persistent Bridged Device Info **/
+static esp_err_t open_bridge_namespace(nvs_open_mode_t mode, nvs_handle_t *handle)
+{
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE, mode,
+                                            handle);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Error opening partition %s namespace %s. Err: %d", CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME,
                  ESP_MATTER_BRIDGE_NAMESPACE, err);
-        return err;
     }
-    uint16_t endpoint_id = persistent_info->device_endpoint_id;
-    err = nvs_set_blob(handle, nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName(),
-                       persistent_info, sizeof(device_persistent_info_t));
+    return err;
+}
+
+static esp_err_t store_device_table()
+{
+    if (batch_depth > 0) {
+        // Written when the batch ends
+        device_table_dirty = true;
+        return ESP_OK;
+    }
+#if CONFIG_ESP_MATTER_DEFER_ENDPOINT_ID_PERSISTENCE
+    // The endpoint IDs of the table must not be handed out again after a restart
+    esp_matter::persistence::flush();
+#endif
+    device_table_header_t header = {
+        .version = DEVICE_TABLE_VERSION,
+        .entry_size = sizeof(device_persistent_info_t),
+        .count = device_count,
+    };
+    size_t len = sizeof(header) + device_count * sizeof(device_persistent_info_t);
+    uint8_t *blob = (uint8_t *)esp_matter_mem_calloc(1, len);
+    if (!blob) {
+        ESP_LOGE(TAG, "Could not allocate the device table blob");
+        device_table_dirty = true;
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(blob, &header, sizeof(header));
+    if (device_count > 0) {
+        memcpy(blob + sizeof(header), device_table, device_count * sizeof(device_persistent_info_t));
+    }
+
+    nvs_handle_t handle;
+    esp_err_t err = open_bridge_namespace(NVS_READWRITE, &handle);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed on nvs_set_blob when storing device_persistent_info");
+        esp_matter_mem_free(blob);
+        return err;
     }
-    err = nvs_commit(handle);
+    err = nvs_set_blob(handle, nvs_key_allocator::device_table().KeyName(), blob, len);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed on nvs_commit when storing device_persistent_info");
+        ESP_LOGE(TAG, "Failed on nvs_set_blob when storing the device table");
+    } else {
+        err = nvs_commit(handle);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed on nvs_commit when storing the device table");
+        }
     }
     nvs_close(handle);
+    esp_matter_mem_free(blob);
+    device_table_dirty = err != ESP_OK;
     return err;
 }
 
-static esp_err_t nvs_get_device_persistent_info(const char *nvs_namespace, const char *nvs_key,
-                                                device_persistent_info_t *persistent_info)
+static esp_err_t read_device_table()
 {
-    esp_err_t err = ESP_OK;
     nvs_handle_t handle;
-    err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, nvs_namespace, NVS_READONLY, &handle);
+    esp_err_t err = open_bridge_namespace(NVS_READONLY, &handle);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Error opening partition %s namespace %s. Err: %d", CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME,
-                 nvs_namespace, err);
         return err;
     }
-    size_t len = sizeof(device_persistent_info_t);
-    err = nvs_get_blob(handle, nvs_key, persistent_info, &len);
+    size_t len = 0;
+    err = nvs_get_blob(handle, nvs_key_allocator::device_table().KeyName(), NULL, &len);
+    if (err != ESP_OK) {
+        nvs_close(handle);
+        return err;
+    }
+    device_table_header_t header;
+    if (len < sizeof(header)) {
+        nvs_close(handle);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    uint8_t *blob = (uint8_t *)esp_matter_mem_calloc(1, len);
+    if (!blob) {
+        nvs_close(handle);
+        ESP_LOGE(TAG, "Could not allocate the device table blob");
+        return ESP_ERR_NO_MEM;
+    }
+    err = nvs_get_blob(handle, nvs_key_allocator::device_table().KeyName(), blob, &len);
     nvs_close(handle);
+    if (err != ESP_OK) {
+        esp_matter_mem_free(blob);
+        return err;
+    }
+    memcpy(&header, blob, sizeof(header));
+    if (header.version != DEVICE_TABLE_VERSION || header.entry_size != sizeof(device_persistent_info_t) ||
+        header.count > MAX_BRIDGED_DEVICE_COUNT || len != sizeof(header) + header.count * header.entry_size) {
+        ESP_LOGE(TAG, "Unsupported device table, version %u", header.version);
+        esp_matter_mem_free(blob);
+        return ESP_ERR_INVALID_VERSION;
+    }
+    clear_device_table();
+    err = reserve_device_table(header.count);
+    if (err == ESP_OK && header.count > 0) {
+        memcpy(device_table, blob + sizeof(header), header.count * sizeof(device_persistent_info_t));
+        device_count = header.count;
+        // The previous releases stored the devices in the order of their slots
+        qsort(device_table, device_count, sizeof(device_persistent_info_t), compare_device_persistent_info);
+    }
+    esp_matter_mem_free(blob);
     return err;
 }
-static esp_err_t read_device_persistent_info(device_persistent_info_t *persistent_info, uint16_t endpoint_id)
+
+esp_err_t begin_persistence_batch()
 {
-    if (!persistent_info) {
-        ESP_LOGE(TAG, "persistent_info cannot be NULL");
-        return ESP_ERR_INVALID_ARG;
-    }
+    batch_depth++;
+    return ESP_OK;
+}
 
-    esp_err_t err = nvs_get_device_persistent_info(ESP_MATTER_BRIDGE_NAMESPACE,
-                                                   nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName(),
-                                                   persistent_info);
-    if (err == ESP_ERR_NVS_NOT_FOUND) {
-        // If we don't find persistent_info key in the bridge namespace, we will try to get the persistent_info
-        // with the previous key from the previous namespace.
-        char nvs_namespace[16] = {0};
-        snprintf(nvs_namespace, 16, "bridge_ep_%X", endpoint_id);
-        err = nvs_get_device_persistent_info(nvs_namespace, "persistent_info", persistent_info);
-        if (err == ESP_OK) {
-            nvs_handle_t handle;
-            // If we get the persistent_info with the previous key, we will erase it and store it in current namespace
-            // with the new persistent_info key.
-            if (nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, nvs_namespace, NVS_READWRITE,
-                                        &handle) != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to open %s namespace", nvs_namespace);
-            } else {
-                if (nvs_erase_key(handle, "persistent_info") != ESP_OK) {
-                    ESP_LOGE(TAG, "Failed to erase persistent_info");
-                } else {
-                    nvs_commit(handle);
-                }
-                nvs_close(handle);
-            }
-            store_device_persistent_info(persistent_info);
-        }
+esp_err_t end_persistence_batch()
+{
+    if (batch_depth == 0) {
+        ESP_LOGE(TAG, "No persistence batch in progress");
+        return ESP_ERR_INVALID_STATE;
     }
-    return err;
+    if (--batch_depth > 0 || !device_table_dirty) {
+        return ESP_OK;
+    }
+    return store_device_table();
 }
 
-static esp_err_t store_bridged_endpoint_ids()
+/** Device info stored by the previous releases, one key per device and a key for the endpoint id array **/
+static esp_err_t nvs_get_blob_from(const char *nvs_namespace, const char *nvs_key, void *value, size_t len)
 {
-    esp_err_t err = ESP_OK;
     nvs_handle_t handle;
-    err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE, NVS_READWRITE,
-                                  &handle);
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, nvs_namespace, NVS_READONLY,
+                                            &handle);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Error opening partition %s namespace %s. Err: %d", CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME,
-                 ESP_MATTER_BRIDGE_NAMESPACE, err);
         return err;
     }
-    err = nvs_set_blob(handle, nvs_key_allocator::endpoint_ids_array().KeyName(), bridged_endpoint_id_array,
-                       sizeof(bridged_endpoint_id_array));
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed on nvs_set_blob when storing bridged_endpoint_ids");
-    }
-    err = nvs_commit(handle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed on nvs_commit when storing bridged_endpoint_ids");
-    }
+    err = nvs_get_blob(handle, nvs_key, value, &len);
     nvs_close(handle);
     return err;
 }
 
-static esp_err_t nvs_get_bridged_endpoint_ids(const char *nvs_namespace, const char *nvs_key)
+static void nvs_erase_legacy_key(const char *nvs_namespace, const char *nvs_key)
 {
-    esp_err_t err = ESP_OK;
     nvs_handle_t handle;
-    err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, nvs_namespace, NVS_READONLY, &handle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Error opening partition %s namespace %s. Err: %d", CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME,
-                 nvs_namespace, err);
-        return err;
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, nvs_namespace, NVS_READWRITE, &handle) !=
+        ESP_OK) {
+        return;
+    }
+    if (nvs_erase_key(handle, nvs_key) == ESP_OK) {
+        nvs_commit(handle);
     }
-    size_t len = sizeof(bridged_endpoint_id_array);
-    err = nvs_get_blob(handle, nvs_key, bridged_endpoint_id_array, &len);
     nvs_close(handle);
+}
+
+static esp_err_t read_legacy_device_persistent_info(device_persistent_info_t *persistent_info, uint16_t endpoint_id)
+{
+    esp_err_t err = nvs_get_blob_from(ESP_MATTER_BRIDGE_NAMESPACE,
+                                      nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName(),
+                                      persistent_info, sizeof(device_persistent_info_t));
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        // The oldest releases stored the persistent_info in a namespace per endpoint
+        char nvs_namespace[16] = {0};
+        snprintf(nvs_namespace, 16, "bridge_ep_%X", endpoint_id);
+        err = nvs_get_blob_from(nvs_namespace, "persistent_info", persistent_info, sizeof(device_persistent_info_t));
+    }
     return err;
 }
 
-static esp_err_t read_bridged_endpoint_ids()
+static void erase_legacy_device_persistent_info(uint16_t endpoint_id)
 {
-    esp_err_t err =
-        nvs_get_bridged_endpoint_ids(ESP_MATTER_BRIDGE_NAMESPACE, nvs_key_allocator::endpoint_ids_array().KeyName());
+    char nvs_namespace[16] = {0};
+    snprintf(nvs_namespace, 16, "bridge_ep_%X", endpoint_id);
+    nvs_erase_legacy_key(nvs_namespace, "persistent_info");
+    nvs_erase_legacy_key(ESP_MATTER_BRIDGE_NAMESPACE,
+                         nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName());
+}
+
+/* Moves the device info stored by the previous releases to the device table */
+static esp_err_t migrate_legacy_device_info()
+{
+    uint16_t endpoint_ids[MAX_BRIDGED_DEVICE_COUNT];
+    esp_err_t err = nvs_get_blob_from(ESP_MATTER_BRIDGE_NAMESPACE, nvs_key_allocator::endpoint_ids_array().KeyName(),
+                                      endpoint_ids, sizeof(endpoint_ids));
     if (err == ESP_ERR_NVS_NOT_FOUND) {
-        err = nvs_get_bridged_endpoint_ids(ESP_MATTER_BRIDGE_NAMESPACE, "ep_id_array");
-        // If we don't find endpoint_ids_array in the bridge namespace, we will try to get the attribute value
-        // with the previous key from the previous namespace.
-        if (err == ESP_OK) {
-            // If we get endpoint_ids_array with the previous key, we will erase it and store it in current namespace
-            // with the new endpoint_ids_array key.
-            nvs_handle_t handle;
-            if (nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE,
-                                        NVS_READWRITE, &handle) != ESP_OK) {
-                ESP_LOGE(TAG, "Failed to open bridge namespace");
-            } else {
-                if (nvs_erase_key(handle, "ep_id_array") != ESP_OK) {
-                    ESP_LOGE(TAG, "Failed to erase old key");
-                } else {
-                    nvs_commit(handle);
-                }
-                nvs_close(handle);
-            }
-            store_bridged_endpoint_ids();
+        err = nvs_get_blob_from(ESP_MATTER_BRIDGE_NAMESPACE, "ep_id_array", endpoint_ids, sizeof(endpoint_ids));
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    clear_device_table();
+    for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
+        if (endpoint_ids[idx] == chip::kInvalidEndpointId) {
+            continue;
+        }
+        device_persistent_info_t persistent_info;
+        if (read_legacy_device_persistent_info(&persistent_info, endpoint_ids[idx]) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to read the persistent info of endpoint %u, dropping it", endpoint_ids[idx]);
+            continue;
+        }
+        persistent_info.device_endpoint_id = endpoint_ids[idx];
+        if (insert_device_persistent_info(&persistent_info) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to move the persistent info of endpoint %u, dropping it", endpoint_ids[idx]);
         }
     }
-    return err;
+    err = store_device_table();
+    if (err != ESP_OK) {
+        return err;
+    }
+    // The device table is stored, the previous keys can be dropped
+    for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
+        if (endpoint_ids[idx] != chip::kInvalidEndpointId) {
+            erase_legacy_device_persistent_info(endpoint_ids[idx]);
+        }
+    }
+    nvs_erase_legacy_key(ESP_MATTER_BRIDGE_NAMESPACE, nvs_key_allocator::endpoint_ids_array().KeyName());
+    nvs_erase_legacy_key(ESP_MATTER_BRIDGE_NAMESPACE, "ep_id_array");
+    ESP_LOGI(TAG, "Moved the info of %u bridged devices to the device table", device_count);
+    return ESP_OK;
 }
 
 esp_err_t get_bridged_endpoint_ids(uint16_t *matter_endpoint_id_array)
 {
     if (!matter_endpoint_id_array) {
-        ESP_LOGE(TAG, "matter_endpoint_id_array is NULL. Failed to copy the bridged_endpoint_id_array to it");
+        ESP_LOGE(TAG, "matter_endpoint_id_array is NULL. Failed to copy the bridged endpoint ids to it");
         return ESP_ERR_INVALID_ARG;
     }
-    memcpy(matter_endpoint_id_array, bridged_endpoint_id_array, sizeof(bridged_endpoint_id_array));
+    for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
+        matter_endpoint_id_array[idx] = idx < device_count ? device_table[idx].device_endpoint_id :
+            chip::kInvalidEndpointId;
+    }
     return ESP_OK;
 }
 
-esp_err_t erase_bridged_device_info(uint16_t endpoint_id)
+uint16_t get_bridged_device_count()
 {
-    // Remove endpoint id from the endpoint id array
-    esp_err_t err = ESP_OK;
-    for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
-        if (bridged_endpoint_id_array[idx] == endpoint_id) {
-            bridged_endpoint_id_array[idx] = chip::kInvalidEndpointId;
-        }
+    return device_count;
+}
+
+esp_err_t set_max_device_count(uint16_t count)
+{
+    if (count == 0 || count > MAX_BRIDGED_DEVICE_COUNT) {
+        ESP_LOGE(TAG, "The maximum number of bridged devices must be between 1 and %d", MAX_BRIDGED_DEVICE_COUNT);
+        return ESP_ERR_INVALID_ARG;
     }
-    err = store_bridged_endpoint_ids();
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "failed to store the endpoint_id array");
-        return err;
+    max_device_count = count;
+    return ESP_OK;
+}
+
+uint16_t get_max_device_count()
+{
+    return max_device_count;
+}
+
+esp_err_t erase_bridged_device_info(uint16_t endpoint_id)
+{
+    // Remove endpoint id and its persistent information from the device table
+    if (endpoint_id == chip::kInvalidEndpointId || !remove_device_persistent_info(endpoint_id)) {
+        return ESP_OK;
     }
-    // Clear the persistent information of the removed endpoint
-    nvs_handle_t handle;
-    err = nvs_open_from_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE, NVS_READWRITE,
-                                  &handle);
+    esp_err_t err = store_device_table();
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Error opening partition %s namespace %s. Err: %d", CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME,
-                 ESP_MATTER_BRIDGE_NAMESPACE, err);
-        return err;
+        ESP_LOGE(TAG, "failed to store the device table");
     }
-    err = nvs_erase_key(handle, nvs_key_allocator::endpoint_pesistent_info(endpoint_id).KeyName());
-    nvs_commit(handle);
-    nvs_close(handle);
     return err;
 }
 
-static esp_err_t plugin_init_callback_endpoint(endpoint_t *endpoint)
+/* Plugin server init callbacks called by a bulk operation, each of them is called once for all the devices */
+typedef struct {
+    cluster::plugin_server_init_callback_t *callbacks;
+    size_t count;
+    size_t capacity;
+} plugin_init_set_t;
+
+static void plugin_init_set_add(plugin_init_set_t *set, cluster::plugin_server_init_callback_t callback)
+{
+    for (size_t idx = 0; idx < set->count; ++idx) {
+        if (set->callbacks[idx] == callback) {
+            return;
+        }
+    }
+    if (set->count == set->capacity) {
+        size_t capacity = set->capacity ? set->capacity * 2 : 8;
+        cluster::plugin_server_init_callback_t *callbacks = (cluster::plugin_server_init_callback_t *)
+            esp_matter_mem_realloc(set->callbacks, capacity * sizeof(cluster::plugin_server_init_callback_t));
+        if (!callbacks) {
+            // Not deduplicated, but still initialized
+            callback();
+            return;
+        }
+        set->callbacks = callbacks;
+        set->capacity = capacity;
+    }
+    set->callbacks[set->count++] = callback;
+}
+
+static void plugin_init_set_run(plugin_init_set_t *set)
+{
+    for (size_t idx = 0; idx < set->count; ++idx) {
+        set->callbacks[idx]();
+    }
+    esp_matter_mem_free(set->callbacks);
+    *set = {};
+}
+
+static esp_err_t plugin_init_callback_endpoint(endpoint_t *endpoint, plugin_init_set_t *set)
 {
     if (!endpoint) {
         ESP_LOGE(TAG, "endpoint cannot be NULL");
         return ESP_ERR_INVALID_ARG;
     }
-    ESP_LOGI(TAG, "Cluster plugin init for the new added endpoint");
+    if (!set) {
+        ESP_LOGI(TAG, "Cluster plugin init for the new added endpoint");
+    }
     cluster_t *cluster = cluster::get_first(endpoint);
     while (cluster) {
         /* Plugin server init callback */
         cluster::plugin_server_init_callback_t plugin_server_init_callback =
             cluster::get_plugin_server_init_callback(cluster);
         if (plugin_server_init_callback) {
-            plugin_server_init_callback();
+            if (set) {
+                plugin_init_set_add(set, plugin_server_init_callback);
+            } else {
+                plugin_server_init_callback();
+            }
         }
         cluster = cluster::get_next(cluster);
     }
@@ -246,7 +487,8 @@ static esp_err_t plugin_init_callback_endpoint(endpoint_t *endpoint)
 
 static bridge_device_type_callback_t device_type_callback;
 
-esp_err_t set_device_type(device_t *bridged_device, uint32_t device_type_id, void *priv_data)
+static esp_err_t apply_device_type(device_t *bridged_device, uint32_t device_type_id, void *priv_data,
+                                   plugin_init_set_t *set)
 {
     esp_err_t err;
 
@@ -257,7 +499,12 @@ esp_err_t set_device_type(device_t *bridged_device, uint32_t device_type_id, voi
     err = device_type_callback(bridged_device->endpoint, device_type_id, priv_data);
     if (err != ESP_OK)
         return err;
-    return plugin_init_callback_endpoint(bridged_device->endpoint);
+    return plugin_init_callback_endpoint(bridged_device->endpoint, set);
+}
+
+esp_err_t set_device_type(device_t *bridged_device, uint32_t device_type_id, void *priv_data)
+{
+    return apply_device_type(bridged_device, device_type_id, priv_data, NULL);
 }
 
 static bool parent_endpoint_is_valid(node_t *node, uint16_t parent_endpoint_id)
@@ -286,16 +533,15 @@ static bool parent_endpoint_is_valid(node_t *node, uint16_t parent_endpoint_id)
     return false;
 }
 
-device_t *create_device(node_t *node, uint16_t parent_endpoint_id, uint32_t device_type_id, void *priv_data)
+static device_t *add_device(node_t *node, uint16_t parent_endpoint_id, uint32_t device_type_id, void *priv_data,
+                            plugin_init_set_t *set)
 {
-    // Check whether the parent endpoint is valid
-    if (!parent_endpoint_is_valid(node, parent_endpoint_id)) {
-        ESP_LOGE(TAG, "Parent endpoint is invalid");
-        return NULL;
-    }
-
     // Create bridged device
     device_t *dev = (device_t *)esp_matter_mem_calloc(1, sizeof(device_t));
+    if (!dev) {
+        ESP_LOGE(TAG, "Could not allocate the bridged device");
+        return NULL;
+    }
     dev->node = node;
     dev->persistent_info.parent_endpoint_id = parent_endpoint_id;
     bridged_node::config_t bridged_node_config;
@@ -306,7 +552,7 @@ device_t *create_device(node_t *node, uint16_t parent_endpoint_id, uint32_t devi
         esp_matter_mem_free(dev);
         return NULL;
     }
-    if (set_device_type(dev, device_type_id, priv_data) != ESP_OK) {
+    if (apply_device_type(dev, device_type_id, priv_data, set) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to add the device type for the bridged device");
         remove_device(dev);
         return NULL;
@@ -318,46 +564,80 @@ device_t *create_device(node_t *node, uint16_t parent_endpoint_id, uint32_t devi
         return NULL;
     }
 
-    // Store the persistent information
+    // Store the persistent information and the endpoint_id in the device table
     dev->persistent_info.device_endpoint_id = esp_matter::endpoint::get_id(dev->endpoint);
     dev->persistent_info.device_type_id = device_type_id;
-    if (store_device_persistent_info(&dev->persistent_info) != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to store the persistent info for the bridged device");
+    if (insert_device_persistent_info(&dev->persistent_info) != ESP_OK) {
+        ESP_LOGE(TAG, "Endpoints are used up");
         remove_device(dev);
         return NULL;
     }
-
-    // Store the endpoint_id in endpoint_id_array
-    size_t idx;
-    for (idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
-        if (bridged_endpoint_id_array[idx] == chip::kInvalidEndpointId) {
-            bridged_endpoint_id_array[idx] = dev->persistent_info.device_endpoint_id;
-            break;
-        }
-    }
-    if (idx == MAX_BRIDGED_DEVICE_COUNT) {
-        ESP_LOGE(TAG, "Endpoints are used up");
+    if (store_device_table() != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store the persistent info for the bridged device");
         remove_device(dev);
         return NULL;
     }
-    store_bridged_endpoint_ids();
     return dev;
 }
 
-device_t *resume_device(node_t *node, uint16_t device_endpoint_id, void *priv_data)
+device_t *create_device(node_t *node, uint16_t parent_endpoint_id, uint32_t device_type_id, void *priv_data)
 {
-    esp_err_t err = ESP_OK;
-    device_persistent_info_t persistent_info;
-    err = read_device_persistent_info(&persistent_info, device_endpoint_id);
+    // Check whether the parent endpoint is valid
+    if (!parent_endpoint_is_valid(node, parent_endpoint_id)) {
+        ESP_LOGE(TAG, "Parent endpoint is invalid");
+        return NULL;
+    }
+    return add_device(node, parent_endpoint_id, device_type_id, priv_data, NULL);
+}
+
+esp_err_t create_devices(node_t *node, uint16_t parent_endpoint_id, const device_spec_t *specs, size_t count,
+                         device_t **devices)
+{
+    if (!specs || !devices) {
+        ESP_LOGE(TAG, "specs and devices cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!parent_endpoint_is_valid(node, parent_endpoint_id)) {
+        ESP_LOGE(TAG, "Parent endpoint is invalid");
+        return ESP_ERR_INVALID_ARG;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    begin_persistence_batch();
+    plugin_init_set_t set = {};
+    size_t created = 0;
+    for (size_t idx = 0; idx < count; ++idx) {
+        devices[idx] = add_device(node, parent_endpoint_id, specs[idx].device_type_id, specs[idx].priv_data, &set);
+        created += devices[idx] ? 1 : 0;
+    }
+    plugin_init_set_run(&set);
+    esp_err_t err = end_persistence_batch();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    ESP_LOGI(TAG, "Created %u of %u bridged devices", (unsigned)created, (unsigned)count);
     if (err != ESP_OK) {
+        return err;
+    }
+    return created == count ? ESP_OK : ESP_FAIL;
+}
+
+static device_t *restore_device(node_t *node, uint16_t device_endpoint_id, void *priv_data, plugin_init_set_t *set)
+{
+    device_persistent_info_t *stored_info = find_device_persistent_info(device_endpoint_id);
+    if (!stored_info) {
         ESP_LOGE(TAG, "Failed to read the persistent info for the resumed device");
         return NULL;
     }
+    device_persistent_info_t persistent_info = *stored_info;
     if (!parent_endpoint_is_valid(node, persistent_info.parent_endpoint_id)) {
         ESP_LOGE(TAG, "Parent endpoint is invalid");
         return NULL;
     }
     device_t *dev = (device_t *)esp_matter_mem_calloc(1, sizeof(device_t));
+    if (!dev) {
+        ESP_LOGE(TAG, "Could not allocate the bridged device");
+        return NULL;
+    }
     dev->node = node;
     dev->persistent_info = persistent_info;
     bridged_node::config_t bridged_node_config;
@@ -369,7 +649,7 @@ device_t *resume_device(node_t *node, uint16_t device_endpoint_id, void *priv_da
         erase_bridged_device_info(device_endpoint_id);
         return NULL;
     }
-    if (set_device_type(dev, persistent_info.device_type_id, priv_data) != ESP_OK) {
+    if (apply_device_type(dev, persistent_info.device_type_id, priv_data, set) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to add the device type for the bridged device");
         remove_device(dev);
         return NULL;
@@ -383,11 +663,221 @@ device_t *resume_device(node_t *node, uint16_t device_endpoint_id, void *priv_da
     return dev;
 }
 
+device_t *resume_device(node_t *node, uint16_t device_endpoint_id, void *priv_data)
+{
+    return restore_device(node, device_endpoint_id, priv_data, NULL);
+}
+
+esp_err_t resume_devices(node_t *node, const uint16_t *device_endpoint_ids, void *const *priv_data, size_t count,
+                         device_t **devices)
+{
+    if (!device_endpoint_ids || !priv_data || !devices) {
+        ESP_LOGE(TAG, "device_endpoint_ids, priv_data and devices cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    // The devices which fail to resume are erased from the device table
+    begin_persistence_batch();
+    plugin_init_set_t set = {};
+    size_t resumed = 0;
+    for (size_t idx = 0; idx < count; ++idx) {
+        devices[idx] = restore_device(node, device_endpoint_ids[idx], priv_data[idx], &set);
+        resumed += devices[idx] ? 1 : 0;
+    }
+    plugin_init_set_run(&set);
+    esp_err_t err = end_persistence_batch();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    ESP_LOGI(TAG, "Resumed %u of %u bridged devices", (unsigned)resumed, (unsigned)count);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return resumed == count ? ESP_OK : ESP_FAIL;
+}
+
+/** Reachability **/
+/* ReachableChanged events waiting for the rate limit, at most one per endpoint since a second change of the same
+ * endpoint cancels the first one */
+typedef struct {
+    uint16_t endpoint_id;
+    bool reachable;
+} reachable_event_t;
+
+static reachable_event_t *pending_reachable_events = NULL;
+static uint16_t pending_reachable_event_count = 0;
+static uint32_t reachable_event_tokens = CONFIG_ESP_MATTER_BRIDGE_REACHABLE_EVENT_BURST;
+static int64_t reachable_event_refill_us = 0;
+static bool reachable_event_timer_started = false;
+
+static void queue_reachable_event(uint16_t endpoint_id, bool reachable)
+{
+    for (uint16_t idx = 0; idx < pending_reachable_event_count; ++idx) {
+        if (pending_reachable_events[idx].endpoint_id == endpoint_id) {
+            // The endpoint is back to the value of the last event, there is nothing to send
+            pending_reachable_events[idx] = pending_reachable_events[--pending_reachable_event_count];
+            return;
+        }
+    }
+    pending_reachable_events[pending_reachable_event_count].endpoint_id = endpoint_id;
+    pending_reachable_events[pending_reachable_event_count].reachable = reachable;
+    pending_reachable_event_count++;
+}
+
+static void drop_reachable_event(uint16_t endpoint_id)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    for (uint16_t idx = 0; idx < pending_reachable_event_count; ++idx) {
+        if (pending_reachable_events[idx].endpoint_id == endpoint_id) {
+            pending_reachable_events[idx] = pending_reachable_events[--pending_reachable_event_count];
+            break;
+        }
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+}
+
+static esp_err_t send_reachable_changed(void *priv_data)
+{
+    reachable_event_t *reachable_event = (reachable_event_t *)priv_data;
+    BridgedDeviceBasicInformation::Events::ReachableChanged::Type event;
+    event.reachableNewValue = reachable_event->reachable;
+    chip::EventNumber event_number;
+    if (chip::app::LogEvent(event, reachable_event->endpoint_id, event_number) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to log the ReachableChanged event of endpoint %u", reachable_event->endpoint_id);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/* Token bucket of the ReachableChanged events, refilled at CONFIG_ESP_MATTER_BRIDGE_REACHABLE_EVENT_RATE */
+static void refill_reachable_event_tokens()
+{
+    constexpr int64_t interval_us = 1000000 / CONFIG_ESP_MATTER_BRIDGE_REACHABLE_EVENT_RATE;
+    int64_t now_us = esp_timer_get_time();
+    int64_t added = (now_us - reachable_event_refill_us) / interval_us;
+    if (added <= 0) {
+        return;
+    }
+    if (reachable_event_tokens + added >= CONFIG_ESP_MATTER_BRIDGE_REACHABLE_EVENT_BURST) {
+        reachable_event_tokens = CONFIG_ESP_MATTER_BRIDGE_REACHABLE_EVENT_BURST;
+        reachable_event_refill_us = now_us;
+    } else {
+        reachable_event_tokens += (uint32_t)added;
+        reachable_event_refill_us += added * interval_us;
+    }
+}
+
+static void send_reachable_events(chip::System::Layer *layer, void *ctx);
+
+/* Sends the pending events allowed by the rate limit, in one batch. The caller holds the Matter stack lock. */
+static void send_pending_reachable_events()
+{
+    refill_reachable_event_tokens();
+    uint16_t count = pending_reachable_event_count < reachable_event_tokens ? pending_reachable_event_count
+                                                                            : (uint16_t)reachable_event_tokens;
+    if (count > 0) {
+        event::batch_entry_t *entries = (event::batch_entry_t *)esp_matter_mem_calloc(count,
+                                                                                      sizeof(event::batch_entry_t));
+        if (!entries) {
+            ESP_LOGE(TAG, "Failed to alloc memory for the ReachableChanged events");
+            count = 0;
+        } else {
+            for (uint16_t idx = 0; idx < count; ++idx) {
+                entries[idx].send = send_reachable_changed;
+                entries[idx].priv_data = &pending_reachable_events[idx];
+                entries[idx].priority = chip::app::PriorityLevel::Info;
+            }
+            event::send_batch(entries, count);
+            esp_matter_mem_free(entries);
+            reachable_event_tokens -= count;
+            pending_reachable_event_count -= count;
+            memmove(pending_reachable_events, pending_reachable_events + count,
+                    pending_reachable_event_count * sizeof(reachable_event_t));
+        }
+    }
+    if (pending_reachable_event_count > 0 && !reachable_event_timer_started) {
+        uint32_t delay_ms = (1000 + CONFIG_ESP_MATTER_BRIDGE_REACHABLE_EVENT_RATE - 1) /
+            CONFIG_ESP_MATTER_BRIDGE_REACHABLE_EVENT_RATE;
+        reachable_event_timer_started = chip::DeviceLayer::SystemLayer().StartTimer(
+            chip::System::Clock::Milliseconds32(delay_ms), send_reachable_events, nullptr) == CHIP_NO_ERROR;
+    }
+}
+
+static void send_reachable_events(chip::System::Layer *layer, void *ctx)
+{
+    reachable_event_timer_started = false;
+    send_pending_reachable_events();
+}
+
+esp_err_t set_reachable(const uint16_t *device_endpoint_ids, size_t count, bool reachable)
+{
+    if (!device_endpoint_ids && count > 0) {
+        ESP_LOGE(TAG, "device_endpoint_ids cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!pending_reachable_events) {
+        pending_reachable_events = (reachable_event_t *)esp_matter_mem_calloc(MAX_BRIDGED_DEVICE_COUNT,
+                                                                              sizeof(reachable_event_t));
+    }
+    attribute::batch_entry_t *entries = (attribute::batch_entry_t *)esp_matter_mem_calloc(
+        count > 0 ? count : 1, sizeof(attribute::batch_entry_t));
+    if (!pending_reachable_events || !entries) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the reachability update");
+        esp_matter_mem_free(entries);
+        return ESP_ERR_NO_MEM;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        esp_matter_mem_free(entries);
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    size_t changed = 0;
+    node_t *node = node::get();
+    for (size_t idx = 0; idx < count; ++idx) {
+        uint16_t endpoint_id = device_endpoint_ids[idx];
+        cluster_t *cluster = cluster::get(endpoint::get(node, endpoint_id), BridgedDeviceBasicInformation::Id);
+        attribute_t *attribute = attribute::get(cluster, BridgedDeviceBasicInformation::Attributes::Reachable::Id);
+        if (!find_device_persistent_info(endpoint_id) || !attribute) {
+            ESP_LOGE(TAG, "Endpoint %u is not a bridged device", endpoint_id);
+            err = ESP_ERR_NOT_FOUND;
+            continue;
+        }
+        esp_matter_attr_val_t val = esp_matter_invalid(NULL);
+        attribute::get_val(attribute, &val);
+        if (val.type != ESP_MATTER_VAL_TYPE_BOOLEAN || val.val.b == reachable) {
+            continue;
+        }
+        entries[changed].endpoint_id = endpoint_id;
+        entries[changed].cluster_id = BridgedDeviceBasicInformation::Id;
+        entries[changed].attribute_id = BridgedDeviceBasicInformation::Attributes::Reachable::Id;
+        entries[changed].val = esp_matter_bool(reachable);
+        changed++;
+        queue_reachable_event(endpoint_id, reachable);
+    }
+    // The attributes are reported without the attribute change callback of the cluster server, which would log one
+    // event per device, the events go through the rate limit instead
+    if (changed > 0) {
+        esp_err_t report_err = attribute::report_batch(entries, changed);
+        err = report_err != ESP_OK ? report_err : err;
+    }
+    send_pending_reachable_events();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    esp_matter_mem_free(entries);
+    return err;
+}
+
 esp_err_t remove_device(device_t *bridged_device)
 {
     if (!bridged_device) {
         return ESP_ERR_INVALID_ARG;
     }
+    drop_reachable_event(bridged_device->persistent_info.device_endpoint_id);
+    mirror::remove(bridged_device->persistent_info.device_endpoint_id);
     erase_bridged_device_info(bridged_device->persistent_info.device_endpoint_id);
     esp_err_t error = endpoint::destroy(bridged_device->node, bridged_device->endpoint);
     if (error != ESP_OK) {
@@ -397,6 +887,15 @@ esp_err_t remove_device(device_t *bridged_device)
     return error;
 }
 
+// The state in RAM of the bridged devices, dropped with their storage
+static void clear_bridge_state()
+{
+    clear_device_table();
+    device_table_dirty = false;
+    pending_reachable_event_count = 0;
+    mirror::clear();
+}
+
 esp_err_t initialize(node_t *node, bridge_device_type_callback_t device_type_cb)
 {
     if (!node) {
@@ -409,33 +908,39 @@ esp_err_t initialize(node_t *node, bridge_device_type_callback_t device_type_cb)
         return ESP_ERR_INVALID_ARG;
     }
     device_type_callback = device_type_cb;
+#if CONFIG_ESP_MATTER_ENABLE_ASYNC_FACTORY_RESET
+    // The device table is erased by esp_matter::factory_reset()
+    if (esp_matter::async_reset::register_storage(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME, ESP_MATTER_BRIDGE_NAMESPACE,
+                                                  clear_bridge_state) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register the bridge storage to the factory reset");
+    }
+#endif
 
     esp_err_t err = nvs_flash_init_partition(CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to initialize the bridge info partition");
         return err;
     }
-    // Read the bridged endpoint array
-    err = read_bridged_endpoint_ids();
+    // Read the device table
+    err = read_device_table();
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        err = migrate_legacy_device_info();
+    }
     if (err == ESP_ERR_NVS_NOT_FOUND) {
-        ESP_LOGI(TAG, "The bridged endpoint id array is not found in partition %s, Try to initialize it",
+        ESP_LOGI(TAG, "The bridged device table is not found in partition %s, Try to initialize it",
                  CONFIG_ESP_MATTER_BRIDGE_INFO_PART_NAME);
-        for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
-            bridged_endpoint_id_array[idx] = chip::kInvalidEndpointId;
-        }
-        if (store_bridged_endpoint_ids() != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to store the initialized endpoint id array");
+        clear_device_table();
+        if (store_device_table() != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to store the initialized device table");
             return err;
         }
         return ESP_OK;
     } else if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to read the bridged endpoint id array");
+        ESP_LOGE(TAG, "Failed to read the bridged device table");
     }
     return err;
 }
 
-// TODO: Add a factory_reset_cb_register so that when we call esp_matter::factory_reset, we can erase other
-// namespaces/partitions.
 esp_err_t factory_reset()
 {
     nvs_handle_t handle;
@@ -449,6 +954,7 @@ esp_err_t factory_reset()
     err = nvs_erase_all(handle);
     nvs_commit(handle);
     nvs_close(handle);
+    clear_bridge_state();
     return err;
 }
 
@@ -21,6 +21,7 @@
 #define MAX_BRIDGED_DEVICE_COUNT \
     CONFIG_ESP_MATTER_MAX_DYNAMIC_ENDPOINT_COUNT - 1 - CONFIG_ESP_MATTER_AGGREGATOR_ENDPOINT_COUNT
 // There is an endpoint reserved as root endpoint
+// This is the upper bound of the bridged devices, the limit used at runtime can be lowered with set_max_device_count()
 
 namespace esp_matter_bridge {
 
@@ -36,10 +37,66 @@ typedef struct device {
     device_persistent_info_t persistent_info;
 } device_t;
 
+/** Bridged device to create with create_devices() */
+typedef struct device_spec {
+    uint32_t device_type_id;
+    void *priv_data;
+} device_spec_t;
+
 typedef esp_err_t (*bridge_device_type_callback_t)(esp_matter::endpoint_t *ep, uint32_t device_type_id, void *priv_data);
 
+/** Gets the endpoint IDs of the bridged devices.
+ *
+ * @param[out] matter_endpoint_id_array Array of MAX_BRIDGED_DEVICE_COUNT entries, filled with the endpoint IDs in
+ *                                      ascending order, followed by chip::kInvalidEndpointId.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
 esp_err_t get_bridged_endpoint_ids(uint16_t *matter_endpoint_id_array);
 
+/** Gets the number of bridged devices in the device table.
+ *
+ * @return Number of bridged devices.
+ */
+uint16_t get_bridged_device_count();
+
+/** Sets the maximum number of bridged devices.
+ *
+ * The device table grows with the devices, up to this limit, so the same firmware can support a different number of
+ * devices per product. The devices already in the table are kept if the limit is lowered below their number, new
+ * devices cannot be created until enough of them are removed.
+ *
+ * @param[in] count Maximum number of bridged devices, from 1 to MAX_BRIDGED_DEVICE_COUNT.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if count is out of range.
+ */
+esp_err_t set_max_device_count(uint16_t count);
+
+/** Gets the maximum number of bridged devices.
+ *
+ * @return Maximum number of bridged devices, MAX_BRIDGED_DEVICE_COUNT unless changed with set_max_device_count().
+ */
+uint16_t get_max_device_count();
+
+/** Starts a batch of persistence updates.
+ *
+ * The bridged device table is written to NVS once, when the outermost batch ends, instead of on every device creation
+ * or removal. Use it around bulk additions or removals of bridged devices.
+ *
+ * @return ESP_OK on success.
+ */
+esp_err_t begin_persistence_batch();
+
+/** Ends a batch of persistence updates, and writes the bridged device table if the batch changed it.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE if no batch was started.
+ * @return error in case of failure.
+ */
+esp_err_t end_persistence_batch();
+
 esp_err_t erase_bridged_device_info(uint16_t matter_endpoint_id);
 
 device_t *create_device(esp_matter::node_t *node, uint16_t parent_endpoint_id, uint32_t device_type_id,
@@ -47,6 +104,57 @@ device_t *create_device(esp_matter::node_t *node, uint16_t parent_endpoint_id, u
 
 device_t *resume_device(esp_matter::node_t *node, uint16_t device_endpoint_id, void *priv_data);
 
+/** Creates bridged devices in bulk.
+ *
+ * The devices are created with the Matter stack lock taken once, the cluster plugin server init callbacks are called
+ * once for all the devices, and the device table is written to NVS once. The endpoints still have to be enabled, as
+ * for create_device().
+ *
+ * @param[in] node Node of the bridge.
+ * @param[in] parent_endpoint_id Aggregator endpoint of the devices.
+ * @param[in] specs Device types and private data of the devices.
+ * @param[in] count Number of devices.
+ * @param[out] devices Created devices, NULL for the devices which could not be created.
+ *
+ * @return ESP_OK if all the devices are created.
+ * @return error in case of failure.
+ */
+esp_err_t create_devices(esp_matter::node_t *node, uint16_t parent_endpoint_id, const device_spec_t *specs,
+                         size_t count, device_t **devices);
+
+/** Resumes bridged devices in bulk, at boot, with the same batching as create_devices().
+ *
+ * @param[in] node Node of the bridge.
+ * @param[in] device_endpoint_ids Endpoint IDs of the devices, from get_bridged_endpoint_ids().
+ * @param[in] priv_data Private data of the devices.
+ * @param[in] count Number of devices.
+ * @param[out] devices Resumed devices, NULL for the devices which could not be resumed.
+ *
+ * @return ESP_OK if all the devices are resumed.
+ * @return error in case of failure.
+ */
+esp_err_t resume_devices(esp_matter::node_t *node, const uint16_t *device_endpoint_ids, void *const *priv_data,
+                         size_t count, device_t **devices);
+
+/** Sets the reachability of bridged devices in one batch.
+ *
+ * Use it when the network behind the bridge goes down or comes back. The Reachable attributes which change are
+ * reported together, in one reporting pass, and their ReachableChanged events are rate limited to
+ * CONFIG_ESP_MATTER_BRIDGE_REACHABLE_EVENT_RATE per second, with bursts of
+ * CONFIG_ESP_MATTER_BRIDGE_REACHABLE_EVENT_BURST.
+ * The events over the limit are sent later, and the event of a device is dropped if its reachability changes back
+ * before the event is sent.
+ *
+ * @param[in] device_endpoint_ids Endpoint IDs of the devices.
+ * @param[in] count Number of devices.
+ * @param[in] reachable New reachability of the devices.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if an endpoint is not a bridged device, the other devices are still updated.
+ * @return error in case of failure.
+ */
+esp_err_t set_reachable(const uint16_t *device_endpoint_ids, size_t count, bool reachable);
+
 esp_err_t set_device_type(device_t *bridged_device, uint32_t device_type_id, void *priv_data);
 
 esp_err_t remove_device(device_t *bridged_device);
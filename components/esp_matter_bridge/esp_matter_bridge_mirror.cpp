@@ -0,0 +1,368 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+
+#include <esp_matter_bridge.h>
+#include <esp_matter_bridge_mirror.h>
+
+#include <platform/CHIPDeviceLayer.h>
+#if MAX_BRIDGED_DEVICE_COUNT > 0
+
+static const char *TAG = "esp_matter_bridge";
+
+using namespace esp_matter;
+
+namespace esp_matter_bridge {
+namespace mirror {
+
+static constexpr size_t k_max_attributes = CONFIG_ESP_MATTER_BRIDGE_MIRROR_MAX_ATTRIBUTES;
+
+typedef struct {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    policy_t policy;
+    uint32_t stale_timeout_ms;
+    /* Time of the last report, or of the addition if the attribute was never reported */
+    int64_t reported_us;
+    /* Last value reported by the device, or written to it */
+    esp_matter_attr_val_t device_val;
+    esp_matter_attr_val_t pending_val;
+    bool has_device_val;
+    bool reported;
+    bool write_pending;
+    bool stale;
+} entry_t;
+
+/* Accessed with the Matter stack lock held */
+static entry_t entries[k_max_attributes];
+static size_t entry_count = 0;
+static write_cb_t write_callback = NULL;
+static bool write_timer_started = false;
+static bool stale_timer_started = false;
+
+static bool is_scalar(esp_matter_val_type_t type)
+{
+    return type != ESP_MATTER_VAL_TYPE_INVALID && type != ESP_MATTER_VAL_TYPE_CHAR_STRING &&
+        type != ESP_MATTER_VAL_TYPE_LONG_CHAR_STRING && type != ESP_MATTER_VAL_TYPE_OCTET_STRING &&
+        type != ESP_MATTER_VAL_TYPE_LONG_OCTET_STRING && type != ESP_MATTER_VAL_TYPE_ARRAY;
+}
+
+static entry_t *find_entry(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    for (size_t idx = 0; idx < entry_count; ++idx) {
+        if (entries[idx].endpoint_id == endpoint_id && entries[idx].cluster_id == cluster_id &&
+            entries[idx].attribute_id == attribute_id) {
+            return &entries[idx];
+        }
+    }
+    return NULL;
+}
+
+static attribute_t *get_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    cluster_t *cluster = cluster::get(endpoint::get(node::get(), endpoint_id), cluster_id);
+    return attribute::get(cluster, attribute_id);
+}
+
+/** Outbound writes **/
+static void flush_writes(chip::System::Layer *layer, void *ctx)
+{
+    write_timer_started = false;
+    // The write callback can feed the mirror back, the entries are looked at by index
+    for (size_t idx = 0; idx < entry_count; ++idx) {
+        entry_t *entry = &entries[idx];
+        if (!entry->write_pending) {
+            continue;
+        }
+        entry->write_pending = false;
+        esp_matter_attr_val_t val = entry->pending_val;
+        if (!write_callback) {
+            ESP_LOGW(TAG, "No mirror write callback, the write of endpoint %u is dropped", entry->endpoint_id);
+            continue;
+        }
+        uint16_t endpoint_id = entry->endpoint_id;
+        uint32_t cluster_id = entry->cluster_id;
+        uint32_t attribute_id = entry->attribute_id;
+        if (write_callback(endpoint_id, cluster_id, attribute_id, &val, endpoint::get_priv_data(endpoint_id)) ==
+            ESP_OK) {
+            entry = find_entry(endpoint_id, cluster_id, attribute_id);
+            if (entry) {
+                entry->device_val = val;
+                entry->has_device_val = true;
+            }
+        }
+    }
+}
+
+static void queue_write(entry_t *entry, const esp_matter_attr_val_t *val)
+{
+    if (entry->has_device_val && attribute::val_is_equal(&entry->device_val, val)) {
+        // The device already has this value, and any queued write is older
+        entry->write_pending = false;
+        return;
+    }
+    entry->pending_val = *val;
+    entry->write_pending = true;
+    if (!write_timer_started) {
+        write_timer_started = chip::DeviceLayer::SystemLayer().StartTimer(
+            chip::System::Clock::Milliseconds32(CONFIG_ESP_MATTER_BRIDGE_MIRROR_WRITE_DELAY_MS), flush_writes,
+            nullptr) == CHIP_NO_ERROR;
+        if (!write_timer_started) {
+            flush_writes(nullptr, nullptr);
+        }
+    }
+}
+
+/** Staleness **/
+static void check_stale_attributes(chip::System::Layer *layer, void *ctx);
+
+static void start_stale_timer()
+{
+    if (stale_timer_started) {
+        return;
+    }
+    for (size_t idx = 0; idx < entry_count; ++idx) {
+        if (entries[idx].stale_timeout_ms > 0) {
+            stale_timer_started = chip::DeviceLayer::SystemLayer().StartTimer(
+                chip::System::Clock::Milliseconds32(CONFIG_ESP_MATTER_BRIDGE_MIRROR_STALE_CHECK_INTERVAL_MS),
+                check_stale_attributes, nullptr) == CHIP_NO_ERROR;
+            return;
+        }
+    }
+}
+
+static void check_stale_attributes(chip::System::Layer *layer, void *ctx)
+{
+    /* Only used in the Matter context, it is kept off the stack of the Matter task */
+    static uint16_t stale_endpoint_ids[k_max_attributes];
+    stale_timer_started = false;
+    int64_t now_us = esp_timer_get_time();
+    size_t stale_count = 0;
+    for (size_t idx = 0; idx < entry_count; ++idx) {
+        entry_t *entry = &entries[idx];
+        if (entry->stale_timeout_ms == 0 || entry->stale ||
+            now_us - entry->reported_us < (int64_t)entry->stale_timeout_ms * 1000) {
+            continue;
+        }
+        entry->stale = true;
+        size_t id_idx = 0;
+        while (id_idx < stale_count && stale_endpoint_ids[id_idx] != entry->endpoint_id) {
+            id_idx++;
+        }
+        if (id_idx == stale_count) {
+            stale_endpoint_ids[stale_count++] = entry->endpoint_id;
+        }
+    }
+    if (stale_count > 0) {
+        ESP_LOGW(TAG, "%u bridged devices have stale attributes, they are set unreachable", (unsigned)stale_count);
+        set_reachable(stale_endpoint_ids, stale_count, false);
+    }
+    start_stale_timer();
+}
+
+static bool has_stale_attribute(uint16_t endpoint_id)
+{
+    for (size_t idx = 0; idx < entry_count; ++idx) {
+        if (entries[idx].endpoint_id == endpoint_id && entries[idx].stale) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** APIs **/
+esp_err_t set_write_callback(write_cb_t callback)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    write_callback = callback;
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+esp_err_t add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, policy_t policy,
+              uint32_t stale_timeout_ms)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    attribute_t *attribute = get_attribute(endpoint_id, cluster_id, attribute_id);
+    esp_matter_attr_val_t val = esp_matter_invalid(NULL);
+    attribute::get_val(attribute, &val);
+    entry_t *entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (!attribute) {
+        ESP_LOGE(TAG, "Endpoint %u has no attribute 0x%08" PRIx32 " in cluster 0x%08" PRIx32, endpoint_id,
+                 attribute_id, cluster_id);
+        err = ESP_ERR_NOT_FOUND;
+    } else if (!is_scalar(val.type)) {
+        ESP_LOGE(TAG, "Only the scalar attributes can be mirrored");
+        err = ESP_ERR_NOT_SUPPORTED;
+    } else if (!entry && entry_count == k_max_attributes) {
+        ESP_LOGE(TAG, "No room to mirror another attribute");
+        err = ESP_ERR_NO_MEM;
+    } else {
+        if (!entry) {
+            entry = &entries[entry_count++];
+            *entry = {};
+            entry->endpoint_id = endpoint_id;
+            entry->cluster_id = cluster_id;
+            entry->attribute_id = attribute_id;
+            entry->reported_us = esp_timer_get_time();
+        }
+        entry->policy = policy;
+        entry->stale_timeout_ms = stale_timeout_ms;
+        start_stale_timer();
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t remove(uint16_t endpoint_id)
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    size_t kept = 0;
+    for (size_t idx = 0; idx < entry_count; ++idx) {
+        if (entries[idx].endpoint_id != endpoint_id) {
+            entries[kept++] = entries[idx];
+        }
+    }
+    entry_count = kept;
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    if (!val || !is_scalar(val->type)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    entry_t *entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (!entry) {
+        err = ESP_ERR_NOT_FOUND;
+    } else {
+        entry->reported_us = esp_timer_get_time();
+        entry->device_val = *val;
+        entry->has_device_val = true;
+        entry->reported = true;
+        if (entry->policy == POLICY_DEVICE) {
+            if (entry->write_pending && attribute::val_is_equal(&entry->pending_val, val)) {
+                entry->write_pending = false;
+            }
+            // The value is reported without the attribute callbacks, it is not written back to the device
+            err = attribute::report(endpoint_id, cluster_id, attribute_id, val);
+        } else {
+            esp_matter_attr_val_t matter_val = esp_matter_invalid(NULL);
+            attribute::get_val(get_attribute(endpoint_id, cluster_id, attribute_id), &matter_val);
+            queue_write(entry, &matter_val);
+        }
+        if (entry->stale) {
+            entry->stale = false;
+            if (!has_stale_attribute(endpoint_id)) {
+                set_reachable(&endpoint_id, 1, true);
+            }
+        }
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t write(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    if (!val || !is_scalar(val->type)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    entry_t *entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (!entry) {
+        err = ESP_ERR_NOT_FOUND;
+    } else {
+        queue_write(entry, val);
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t get_age(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, uint32_t *age_ms)
+{
+    if (!age_ms) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    entry_t *entry = find_entry(endpoint_id, cluster_id, attribute_id);
+    if (!entry) {
+        err = ESP_ERR_NOT_FOUND;
+    } else if (!entry->reported) {
+        *age_ms = UINT32_MAX;
+    } else {
+        int64_t age_us = esp_timer_get_time() - entry->reported_us;
+        *age_ms = age_us / 1000 >= UINT32_MAX ? UINT32_MAX : (uint32_t)(age_us / 1000);
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t clear()
+{
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    entry_count = 0;
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return ESP_OK;
+}
+
+} // namespace mirror
+} // namespace esp_matter_bridge
+
+#endif // MAX_BRIDGED_DEVICE_COUNT > 0
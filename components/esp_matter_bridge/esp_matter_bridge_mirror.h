@@ -0,0 +1,147 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_attribute_utils.h>
+#include <stdint.h>
+
+namespace esp_matter_bridge {
+namespace mirror {
+
+/*
+ * Mirror of the bridged device attributes.
+ *
+ * The value of a mirrored attribute is kept in the esp_matter data model, so the controller reads, and the wildcard
+ * reads, are served by the bridge without reaching the device. The bridge feeds the mirror with the values reported
+ * by the devices with report(), and hands it the Matter writes with write(): the writes are queued, the successive
+ * writes of an attribute are coalesced, the writes of the value the device already has are dropped, and the queue is
+ * flushed to the device through the write callback.
+ *
+ * The time of the last report of each attribute is tracked. A device with an attribute not reported for longer than
+ * its stale timeout is set unreachable with esp_matter_bridge::set_reachable(), and reachable again on its next report.
+ *
+ * Only the scalar attribute types can be mirrored. The APIs take the Matter stack lock if it is not already taken.
+ */
+
+/** Source of truth of a mirrored attribute */
+typedef enum policy {
+    /** The device is the source of truth, its reports update the Matter attribute. */
+    POLICY_DEVICE,
+    /** The Matter attribute is the source of truth, a device report with another value queues a write of the Matter
+     * value back to the device. */
+    POLICY_MATTER,
+} policy_t;
+
+/** Callback writing an attribute to the device, in the Matter context
+ *
+ * @param[in] endpoint_id Endpoint of the bridged device.
+ * @param[in] cluster_id Cluster ID.
+ * @param[in] attribute_id Attribute ID.
+ * @param[in] val Value to write.
+ * @param[in] priv_data Private data of the bridged endpoint.
+ *
+ * @return ESP_OK if the write was sent to the device.
+ * @return error in case of failure, the write is not tried again.
+ */
+typedef esp_err_t (*write_cb_t)(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                esp_matter_attr_val_t *val, void *priv_data);
+
+/** Set the callback writing the queued writes to the devices
+ *
+ * @param[in] callback Write callback.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t set_write_callback(write_cb_t callback);
+
+/** Mirror an attribute of a bridged device
+ *
+ * @param[in] endpoint_id Endpoint of the bridged device.
+ * @param[in] cluster_id Cluster ID.
+ * @param[in] attribute_id Attribute ID.
+ * @param[in] policy Source of truth of the attribute.
+ * @param[in] stale_timeout_ms Time without a report after which the device is unreachable, 0 to not track it.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the attribute does not exist.
+ * @return ESP_ERR_NOT_SUPPORTED if the attribute is not a scalar.
+ * @return ESP_ERR_NO_MEM if CONFIG_ESP_MATTER_BRIDGE_MIRROR_MAX_ATTRIBUTES attributes are already mirrored.
+ */
+esp_err_t add(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, policy_t policy,
+              uint32_t stale_timeout_ms);
+
+/** Stop mirroring the attributes of a bridged device, and drop its queued writes
+ *
+ * It is called by esp_matter_bridge::remove_device().
+ *
+ * @param[in] endpoint_id Endpoint of the bridged device.
+ *
+ * @return ESP_OK on success.
+ */
+esp_err_t remove(uint16_t endpoint_id);
+
+/** Feed the mirror with a value reported by the device
+ *
+ * @param[in] endpoint_id Endpoint of the bridged device.
+ * @param[in] cluster_id Cluster ID.
+ * @param[in] attribute_id Attribute ID.
+ * @param[in] val Reported value.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the attribute is not mirrored.
+ * @return error in case of failure.
+ */
+esp_err_t report(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
+
+/** Queue a Matter write of a mirrored attribute to the device
+ *
+ * Call it from the PRE_UPDATE attribute callback of the application. The write is sent by the write callback after
+ * CONFIG_ESP_MATTER_BRIDGE_MIRROR_WRITE_DELAY_MS, a later write of the same attribute replaces it.
+ *
+ * @param[in] endpoint_id Endpoint of the bridged device.
+ * @param[in] cluster_id Cluster ID.
+ * @param[in] attribute_id Attribute ID.
+ * @param[in] val Written value.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the attribute is not mirrored, the application writes it to the device itself.
+ * @return error in case of failure.
+ */
+esp_err_t write(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
+
+/** Get the time since the last report of a mirrored attribute
+ *
+ * @param[in] endpoint_id Endpoint of the bridged device.
+ * @param[in] cluster_id Cluster ID.
+ * @param[in] attribute_id Attribute ID.
+ * @param[out] age_ms Time since the last report, UINT32_MAX if the attribute was never reported.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the attribute is not mirrored.
+ */
+esp_err_t get_age(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, uint32_t *age_ms);
+
+/** Stop mirroring all the attributes and drop the queued writes
+ *
+ * It is called by esp_matter_bridge::factory_reset().
+ *
+ * @return ESP_OK on success.
+ */
+esp_err_t clear();
+
+} // namespace mirror
+} // namespace esp_matter_bridge
@@ -24,6 +24,10 @@ namespace esp_matter_bridge {
 
 namespace nvs_key_allocator {
 
+inline StorageKeyName device_table()
+{
+    return StorageKeyName::FromConst("b/devtbl");
+}
 inline StorageKeyName endpoint_ids_array()
 {
     return StorageKeyName::FromConst("b/epida");
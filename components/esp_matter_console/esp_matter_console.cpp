@@ -140,7 +140,10 @@ esp_err_t init()
         return err;
     }
     chip::Shell::Engine::Root().Init();
-    if (xTaskCreate(&ChipShellTask, "console", CONFIG_ESP_MATTER_CONSOLE_TASK_STACK, NULL, 5, NULL) != pdPASS) {
+    if (xTaskCreatePinnedToCore(&ChipShellTask, "console", CONFIG_ESP_MATTER_CONSOLE_TASK_STACK, NULL, 5, NULL,
+                                CONFIG_ESP_MATTER_CONSOLE_TASK_CORE_ID < 0 ? tskNO_AFFINITY :
+                                                                             CONFIG_ESP_MATTER_CONSOLE_TASK_CORE_ID)
+        != pdPASS) {
         ESP_LOGE(TAG, "Couldn't create console task");
         err = ESP_FAIL;
     }
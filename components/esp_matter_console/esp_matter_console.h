@@ -128,6 +128,31 @@ esp_err_t add_commands(const command_t *command_set, unsigned count);
  */
 esp_err_t diagnostics_register_commands();
 
+#if CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER
+/** Start the heap sampler
+ *
+ * Samples the free heap, the largest free block, the minimum ever free heap and the allocated and free block counts of
+ * the internal RAM and the SPIRAM into a ring of CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_HISTORY_SIZE samples. The ring
+ * is in RAM which is not initialized at boot, so it survives the software resets, the panics and the watchdog resets,
+ * but not a power loss. It is printed with "matter esp diagnostics heap-history".
+ *
+ * It is started by `diagnostics_register_commands()` with CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_INTERVAL_S.
+ *
+ * @param[in] interval_s Sampling interval in seconds.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t heap_sampler_start(uint32_t interval_s);
+
+/** Stop the heap sampler, the history is kept
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t heap_sampler_stop();
+#endif // CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER
+
 /** Add Wi-Fi Commands
  *
  * Adds the default Wi-Fi commands.
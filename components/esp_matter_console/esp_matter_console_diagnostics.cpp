@@ -12,10 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <esp_attr.h>
 #include <esp_heap_caps.h>
 #include <esp_log.h>
 #include <esp_matter_console.h>
 #include <esp_timer.h>
+#if CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER
+#include <driver/gptimer.h>
+#endif
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <stdlib.h>
 #include <string.h>
 
 namespace esp_matter {
@@ -43,6 +51,356 @@ static esp_err_t up_time_console_handler(int argc, char *argv[])
     return ESP_OK;
 }
 
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS && CONFIG_FREERTOS_USE_TRACE_FACILITY
+#ifndef configRUN_TIME_COUNTER_TYPE
+#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
+/* Run time of the idle tasks, the load of the CPU is the time they did not run */
+static configRUN_TIME_COUNTER_TYPE idle_run_time(configRUN_TIME_COUNTER_TYPE *total_run_time)
+{
+    UBaseType_t task_count = uxTaskGetNumberOfTasks();
+    TaskStatus_t *tasks = (TaskStatus_t *)calloc(task_count, sizeof(TaskStatus_t));
+    if (!tasks) {
+        return 0;
+    }
+    task_count = uxTaskGetSystemState(tasks, task_count, total_run_time);
+    configRUN_TIME_COUNTER_TYPE idle = 0;
+    for (UBaseType_t index = 0; index < task_count; index++) {
+        if (strncmp(tasks[index].pcTaskName, "IDLE", 4) == 0) {
+            idle += tasks[index].ulRunTimeCounter;
+        }
+    }
+    free(tasks);
+    return idle;
+}
+
+static esp_err_t cpu_load_console_handler(int argc, char *argv[])
+{
+    uint32_t interval_ms = argc >= 1 ? strtoul(argv[0], NULL, 10) : 1000;
+    if (interval_ms < 100) {
+        ESP_LOGE(TAG, "The interval must be at least 100 ms");
+        return ESP_ERR_INVALID_ARG;
+    }
+    configRUN_TIME_COUNTER_TYPE total_start = 0, total_end = 0;
+    configRUN_TIME_COUNTER_TYPE idle_start = idle_run_time(&total_start);
+    vTaskDelay(pdMS_TO_TICKS(interval_ms));
+    configRUN_TIME_COUNTER_TYPE idle_end = idle_run_time(&total_end);
+    /* The differences are taken in the counter type so that they survive its wrap. The total run time is counted
+       once for all the cores */
+    uint64_t available = (uint64_t)(configRUN_TIME_COUNTER_TYPE)(total_end - total_start) * portNUM_PROCESSORS;
+    if (available == 0) {
+        return ESP_FAIL;
+    }
+    uint64_t idle = (configRUN_TIME_COUNTER_TYPE)(idle_end - idle_start);
+    uint32_t load = idle >= available ? 0 : (uint32_t)(100 - idle * 100 / available);
+    printf("CPU load: %" PRIu32 "%% over %" PRIu32 " ms\n", load, interval_ms);
+    return ESP_OK;
+}
+#endif // CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS && CONFIG_FREERTOS_USE_TRACE_FACILITY
+
+#if CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER
+/* Bumped when the layout of the history changes, so that a history written by another firmware is dropped */
+#define HEAP_HISTORY_MAGIC 0x48505331
+
+typedef struct {
+    uint32_t free_bytes;
+    uint32_t largest_free_block;
+    uint32_t minimum_free_bytes;
+    uint32_t allocated_blocks;
+    uint32_t free_blocks;
+} heap_class_sample_t;
+
+typedef struct {
+    /* Boot the sample was taken in, counted since the history was created */
+    uint16_t boot;
+    uint32_t uptime_s;
+    heap_class_sample_t internal;
+    heap_class_sample_t spiram;
+} heap_sample_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t boot;
+    uint16_t next;
+    uint16_t used;
+    heap_sample_t samples[CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_HISTORY_SIZE];
+} heap_history_t;
+
+/* Not initialized at boot, so that the history survives the software resets, the panics and the watchdog resets */
+static __NOINIT_ATTR heap_history_t s_heap_history;
+static esp_timer_handle_t s_heap_sampler_timer = NULL;
+static portMUX_TYPE s_heap_history_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void heap_history_init()
+{
+    heap_history_t *history = &s_heap_history;
+    if (history->magic != HEAP_HISTORY_MAGIC || history->next >= CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_HISTORY_SIZE ||
+        history->used > CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_HISTORY_SIZE) {
+        memset(history, 0, sizeof(heap_history_t));
+        history->magic = HEAP_HISTORY_MAGIC;
+        return;
+    }
+    history->boot++;
+}
+
+static void heap_class_sample(heap_class_sample_t *sample, uint32_t caps)
+{
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, caps);
+    sample->free_bytes = info.total_free_bytes;
+    sample->largest_free_block = info.largest_free_block;
+    sample->minimum_free_bytes = info.minimum_free_bytes;
+    sample->allocated_blocks = info.allocated_blocks;
+    sample->free_blocks = info.free_blocks;
+}
+
+static void heap_sampler_cb(void *arg)
+{
+    heap_sample_t sample;
+    sample.uptime_s = (uint32_t)(esp_timer_get_time() / 1000000);
+    heap_class_sample(&sample.internal, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    heap_class_sample(&sample.spiram, MALLOC_CAP_SPIRAM);
+    portENTER_CRITICAL(&s_heap_history_lock);
+    heap_history_t *history = &s_heap_history;
+    sample.boot = history->boot;
+    history->samples[history->next] = sample;
+    history->next = (history->next + 1) % CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_HISTORY_SIZE;
+    if (history->used < CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_HISTORY_SIZE) {
+        history->used++;
+    }
+    portEXIT_CRITICAL(&s_heap_history_lock);
+}
+
+esp_err_t heap_sampler_start(uint32_t interval_s)
+{
+    if (interval_s == 0) {
+        ESP_LOGE(TAG, "The heap sampling interval must not be 0");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_heap_sampler_timer) {
+        heap_history_init();
+        const esp_timer_create_args_t args = {
+            .callback = heap_sampler_cb,
+            .name = "heap_sampler",
+        };
+        esp_err_t err = esp_timer_create(&args, &s_heap_sampler_timer);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create the heap sampler timer: %d", err);
+            return err;
+        }
+    }
+    esp_timer_stop(s_heap_sampler_timer);
+    heap_sampler_cb(NULL);
+    return esp_timer_start_periodic(s_heap_sampler_timer, (uint64_t)interval_s * 1000000);
+}
+
+esp_err_t heap_sampler_stop()
+{
+    if (!s_heap_sampler_timer) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_timer_stop(s_heap_sampler_timer);
+    return ESP_OK;
+}
+
+static void heap_history_print()
+{
+    heap_history_t *history = &s_heap_history;
+    if (history->magic != HEAP_HISTORY_MAGIC) {
+        printf("No heap history, start the sampler with: matter esp diagnostics heap-history start\n");
+        return;
+    }
+    printf("boot\tuptime(s)\tfree\tlargest\tmin\talloc\tfree blk\tspiram free\tlargest\tmin\n");
+    uint16_t first = (history->next + CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_HISTORY_SIZE - history->used) %
+        CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_HISTORY_SIZE;
+    for (uint16_t index = 0; index < history->used; index++) {
+        heap_sample_t sample;
+        portENTER_CRITICAL(&s_heap_history_lock);
+        sample = history->samples[(first + index) % CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_HISTORY_SIZE];
+        portEXIT_CRITICAL(&s_heap_history_lock);
+        printf("%u\t%" PRIu32 "\t\t%" PRIu32 "\t%" PRIu32 "\t%" PRIu32 "\t%" PRIu32 "\t%" PRIu32 "\t\t%" PRIu32
+               "\t\t%" PRIu32 "\t%" PRIu32 "\n", sample.boot, sample.uptime_s, sample.internal.free_bytes,
+               sample.internal.largest_free_block, sample.internal.minimum_free_bytes,
+               sample.internal.allocated_blocks, sample.internal.free_blocks, sample.spiram.free_bytes,
+               sample.spiram.largest_free_block, sample.spiram.minimum_free_bytes);
+    }
+}
+
+static esp_err_t heap_history_console_handler(int argc, char *argv[])
+{
+    if (argc == 0) {
+        heap_history_print();
+        return ESP_OK;
+    }
+    if (strcmp(argv[0], "start") == 0) {
+        uint32_t interval_s = argc >= 2 ? strtoul(argv[1], NULL, 10) :
+            CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_INTERVAL_S;
+        return heap_sampler_start(interval_s);
+    }
+    if (strcmp(argv[0], "stop") == 0) {
+        return heap_sampler_stop();
+    }
+    if (strcmp(argv[0], "clear") == 0) {
+        portENTER_CRITICAL(&s_heap_history_lock);
+        s_heap_history.next = 0;
+        s_heap_history.used = 0;
+        portEXIT_CRITICAL(&s_heap_history_lock);
+        return ESP_OK;
+    }
+    ESP_LOGE(TAG, "Usage: matter esp diagnostics heap-history [start [interval_s]|stop|clear]");
+    return ESP_ERR_INVALID_ARG;
+}
+#endif // CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER
+
+#if CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER
+/* Bumped when the dump format changes, must match tools/relinker/generate_relinker_config.py */
+#define PC_PROFILE_VERSION 1
+/* Entries probed for a free slot before a sample is dropped */
+#define PC_PROFILE_MAX_PROBES 16
+
+typedef struct {
+    uint32_t pc;
+    uint32_t count;
+} pc_profile_entry_t;
+
+static pc_profile_entry_t s_pc_profile[CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER_TABLE_SIZE];
+static uint32_t s_pc_profile_samples = 0;
+static uint32_t s_pc_profile_dropped = 0;
+static gptimer_handle_t s_pc_profile_timer = NULL;
+
+/* The PC the timer interrupt preempted, the interrupt is at level 1 so it did not preempt another interrupt */
+static inline uint32_t IRAM_ATTR interrupted_pc()
+{
+    uint32_t pc;
+#if CONFIG_IDF_TARGET_ARCH_RISCV
+    __asm__ volatile("csrr %0, mepc" : "=r"(pc));
+#else
+    __asm__ volatile("rsr %0, epc1" : "=a"(pc));
+#endif
+    return pc;
+}
+
+static bool IRAM_ATTR pc_profile_on_alarm(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata,
+                                          void *user_ctx)
+{
+    uint32_t pc = interrupted_pc();
+    uint32_t index = (pc >> 1) % CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER_TABLE_SIZE;
+    s_pc_profile_samples++;
+    for (uint32_t probe = 0; probe < PC_PROFILE_MAX_PROBES; probe++) {
+        pc_profile_entry_t *entry = &s_pc_profile[index];
+        if (entry->pc == pc || entry->count == 0) {
+            entry->pc = pc;
+            entry->count++;
+            return false;
+        }
+        index = (index + 1) % CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER_TABLE_SIZE;
+    }
+    s_pc_profile_dropped++;
+    return false;
+}
+
+static esp_err_t pc_profile_stop()
+{
+    if (!s_pc_profile_timer) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    gptimer_stop(s_pc_profile_timer);
+    gptimer_disable(s_pc_profile_timer);
+    gptimer_del_timer(s_pc_profile_timer);
+    s_pc_profile_timer = NULL;
+    return ESP_OK;
+}
+
+static esp_err_t pc_profile_start(uint32_t rate_hz)
+{
+    if (rate_hz == 0 || rate_hz > 10000) {
+        ESP_LOGE(TAG, "The sampling rate must be between 1 and 10000 Hz");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_pc_profile_timer) {
+        pc_profile_stop();
+    }
+    memset(s_pc_profile, 0, sizeof(s_pc_profile));
+    s_pc_profile_samples = 0;
+    s_pc_profile_dropped = 0;
+
+    gptimer_config_t timer_config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = 1000000,
+        /* At the lowest level, so that the interrupted PC is the one of the workload */
+        .intr_priority = 1,
+    };
+    esp_err_t err = gptimer_new_timer(&timer_config, &s_pc_profile_timer);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create the profiler timer: %d", err);
+        return err;
+    }
+    gptimer_event_callbacks_t callbacks = {
+        .on_alarm = pc_profile_on_alarm,
+    };
+    gptimer_alarm_config_t alarm_config = {
+        .alarm_count = 1000000 / rate_hz,
+        .reload_count = 0,
+        .flags = {
+            .auto_reload_on_alarm = true,
+        },
+    };
+    err = gptimer_register_event_callbacks(s_pc_profile_timer, &callbacks, NULL);
+    if (err == ESP_OK) {
+        err = gptimer_set_alarm_action(s_pc_profile_timer, &alarm_config);
+    }
+    if (err == ESP_OK) {
+        err = gptimer_enable(s_pc_profile_timer);
+    }
+    if (err == ESP_OK) {
+        err = gptimer_start(s_pc_profile_timer);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start the profiler timer: %d", err);
+        gptimer_del_timer(s_pc_profile_timer);
+        s_pc_profile_timer = NULL;
+    }
+    return err;
+}
+
+static void pc_profile_dump()
+{
+    /* The ISR stops updating the table while it is printed */
+    pc_profile_stop();
+    uint32_t entries = 0;
+    for (uint32_t index = 0; index < CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER_TABLE_SIZE; index++) {
+        entries += s_pc_profile[index].count ? 1 : 0;
+    }
+    printf("esp_matter_pc_profile begin version=%d samples=%" PRIu32 " dropped=%" PRIu32 " entries=%" PRIu32 "\n",
+           PC_PROFILE_VERSION, s_pc_profile_samples, s_pc_profile_dropped, entries);
+    for (uint32_t index = 0; index < CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER_TABLE_SIZE; index++) {
+        if (s_pc_profile[index].count) {
+            printf("esp_matter_pc_profile %08" PRIx32 " %" PRIu32 "\n", s_pc_profile[index].pc,
+                   s_pc_profile[index].count);
+        }
+    }
+    printf("esp_matter_pc_profile end\n");
+}
+
+static esp_err_t pc_profile_console_handler(int argc, char *argv[])
+{
+    if (argc >= 1 && strcmp(argv[0], "start") == 0) {
+        return pc_profile_start(argc >= 2 ? strtoul(argv[1], NULL, 10) : 1000);
+    }
+    if (argc >= 1 && strcmp(argv[0], "stop") == 0) {
+        return pc_profile_stop();
+    }
+    if (argc >= 1 && strcmp(argv[0], "dump") == 0) {
+        pc_profile_dump();
+        return ESP_OK;
+    }
+    ESP_LOGE(TAG, "Usage: matter esp diagnostics pc-profile start [rate_hz]|stop|dump");
+    return ESP_ERR_INVALID_ARG;
+}
+#endif // CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER
+
 static esp_err_t diagnostics_dispatch(int argc, char **argv)
 {
     if (argc <= 0) {
@@ -71,8 +429,36 @@ esp_err_t diagnostics_register_commands()
             .description = "print the uptime of the device",
             .handler = up_time_console_handler,
         },
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS && CONFIG_FREERTOS_USE_TRACE_FACILITY
+        {
+            .name = "cpu-load",
+            .description = "print the load of the CPU, from the run time of the idle tasks. "
+                           "Usage: matter esp diagnostics cpu-load [interval_ms]",
+            .handler = cpu_load_console_handler,
+        },
+#endif
+#if CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER
+        {
+            .name = "heap-history",
+            .description = "print the heap samples kept across the reboots. "
+                           "Usage: matter esp diagnostics heap-history [start [interval_s]|stop|clear]",
+            .handler = heap_history_console_handler,
+        },
+#endif
+#if CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER
+        {
+            .name = "pc-profile",
+            .description = "sample the program counter to find the hot code, the dump is converted with "
+                           "tools/relinker/generate_relinker_config.py. "
+                           "Usage: matter esp diagnostics pc-profile start [rate_hz]|stop|dump",
+            .handler = pc_profile_console_handler,
+        },
+#endif
     };
     diagnostics_console.register_commands(diagnostics_commands, sizeof(diagnostics_commands)/sizeof(command_t));
+#if CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER
+    heap_sampler_start(CONFIG_ESP_MATTER_CONSOLE_HEAP_SAMPLER_INTERVAL_S);
+#endif
 
     return add_commands(&command, 1);
 }
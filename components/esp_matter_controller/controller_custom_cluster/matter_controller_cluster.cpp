@@ -13,13 +13,17 @@
 // limitations under the License.
 
 #include <esp_check.h>
-#include <esp_crt_bundle.h>
 #include <esp_http_client.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
 #include <esp_matter_controller_utils.h>
 #include <json_generator.h>
 #include <json_parser.h>
 #include <matter_controller_cluster.h>
 #include <matter_controller_device_mgr.h>
+#include <matter_controller_http_client.h>
 #include <mbedtls/base64.h>
 #include <mbedtls/pem.h>
 #include <nvs_flash.h>
@@ -361,14 +365,6 @@ static esp_err_t fetch_rainmaker_group_id(uint16_t endpoint_id, ScopedMemoryBuff
 {
     esp_err_t ret = ESP_OK;
     char url[256] = {0};
-    esp_http_client_config_t config = {
-        .url = url,
-        .transport_type = HTTP_TRANSPORT_OVER_SSL,
-        .buffer_size = 1526,
-        .buffer_size_tx = 2048,
-        .skip_cert_common_name_check = false,
-        .crt_bundle_attach = esp_crt_bundle_attach,
-    };
     esp_http_client_handle_t client = NULL;
     ScopedMemoryBufferWithSize<char> endpoint_url;
     ScopedMemoryBufferWithSize<char> access_token;
@@ -400,14 +396,13 @@ static esp_err_t fetch_rainmaker_group_id(uint16_t endpoint_id, ScopedMemoryBuff
              "user/node_group",
              "node_list=false&sub_groups=false&node_details=false&is_matter=true&fabric_details=false", start_id.Get(),
              num_records);
-    client = esp_http_client_init(&config);
+    client = controller::http_client::acquire(url, HTTP_METHOD_GET);
     ESP_RETURN_ON_FALSE(client, ESP_FAIL, TAG, "Failed to initialise HTTP Client.");
 
     ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "accept", "application/json"), cleanup, TAG,
                       "Failed to set http header accept");
     ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "Authorization", access_token.Get()), cleanup, TAG,
                       "Failed to set http header Authorization");
-    ESP_GOTO_ON_ERROR(esp_http_client_set_method(client, HTTP_METHOD_GET), cleanup, TAG, "Failed to set http method");
 
     // HTTP GET
     ESP_GOTO_ON_ERROR(esp_http_client_open(client, 0), cleanup, TAG, "Failed to open http connection");
@@ -424,17 +419,17 @@ static esp_err_t fetch_rainmaker_group_id(uint16_t endpoint_id, ScopedMemoryBuff
         ESP_LOGE(TAG, "Invalid response for %s", url);
         ESP_LOGE(TAG, "Status = %d, Data = %s", http_status_code, http_len > 0 ? http_payload.Get() : "None");
         ret = ESP_FAIL;
-        goto close;
+        goto cleanup;
     }
     // Parse the response payload
     ESP_LOGI(TAG, "http response:%s", http_payload.Get());
-    ESP_GOTO_ON_FALSE(json_parse_start(&jctx, http_payload.Get(), http_len) == 0, ESP_FAIL, close, TAG,
+    ESP_GOTO_ON_FALSE(json_parse_start(&jctx, http_payload.Get(), http_len) == 0, ESP_FAIL, cleanup, TAG,
                       "Failed to parse the http response json on json_parse_start");
     if (json_obj_get_array(&jctx, "groups", &group_count) != 0) {
         ESP_LOGE(TAG, "Failed to parse the groups array from the http response");
         json_parse_end(&jctx);
         ret = ESP_FAIL;
-        goto close;
+        goto cleanup;
     }
 
     for (group_index = 0; group_index < group_count; ++group_index) {
@@ -467,10 +462,8 @@ static esp_err_t fetch_rainmaker_group_id(uint16_t endpoint_id, ScopedMemoryBuff
     }
     json_parse_end(&jctx);
 
-close:
-    esp_http_client_close(client);
 cleanup:
-    esp_http_client_cleanup(client);
+    controller::http_client::release(client);
     return ret;
 }
 
@@ -583,14 +576,6 @@ static esp_err_t issue_user_noc_request(ScopedMemoryBufferWithSize<char> &csr_pe
 {
     esp_err_t ret = ESP_OK;
     char url[256];
-    esp_http_client_config_t config = {
-        .url = url,
-        .transport_type = HTTP_TRANSPORT_OVER_SSL,
-        .buffer_size = 1024,
-        .buffer_size_tx = 2048,
-        .skip_cert_common_name_check = false,
-        .crt_bundle_attach = esp_crt_bundle_attach,
-    };
     esp_http_client_handle_t client = NULL;
     json_gen_str_t jstr;
     int http_len, http_status_code;
@@ -635,7 +620,7 @@ static esp_err_t issue_user_noc_request(ScopedMemoryBufferWithSize<char> &csr_pe
                         "Failed to get access_token attribute value");
 
     snprintf(url, sizeof(url), "%s/%s/%s", endpoint_url.Get(), HTTP_API_VERSION, "user/node_group");
-    client = esp_http_client_init(&config);
+    client = controller::http_client::acquire(url, HTTP_METHOD_PUT);
     ESP_RETURN_ON_FALSE(client, ESP_FAIL, TAG, "Failed to initialise HTTP Client.");
 
     ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "accept", "application/json"), cleanup, TAG,
@@ -644,7 +629,6 @@ static esp_err_t issue_user_noc_request(ScopedMemoryBufferWithSize<char> &csr_pe
                       "Failed to set http header Authorization");
     ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "Content-Type", "application/json"), cleanup, TAG,
                       "Failed to set http header Content-Type");
-    ESP_GOTO_ON_ERROR(esp_http_client_set_method(client, HTTP_METHOD_PUT), cleanup, TAG, "Failed to set http method");
 
     json_gen_str_start(&jstr, http_payload.Get(), http_payload.AllocatedSize(), NULL, NULL);
     json_gen_start_object(&jstr);
@@ -669,7 +653,7 @@ static esp_err_t issue_user_noc_request(ScopedMemoryBufferWithSize<char> &csr_pe
     if (http_len != strlen(http_payload.Get())) {
         ESP_LOGE(TAG, "Failed to write Payload. Returned len = %d.", http_len);
         ret = ESP_FAIL;
-        goto close;
+        goto cleanup;
     }
     http_len = esp_http_client_fetch_headers(client);
     http_status_code = esp_http_client_get_status_code(client);
@@ -687,13 +671,13 @@ static esp_err_t issue_user_noc_request(ScopedMemoryBufferWithSize<char> &csr_pe
 
     // Parse http response
     noc_pem.Calloc(1024);
-    ESP_GOTO_ON_FALSE(noc_pem.Get(), ESP_ERR_NO_MEM, close, TAG, "Failed to allocate memory for noc_pem");
+    ESP_GOTO_ON_FALSE(noc_pem.Get(), ESP_ERR_NO_MEM, cleanup, TAG, "Failed to allocate memory for noc_pem");
 
     noc_pem_formatted.Calloc(1024);
-    ESP_GOTO_ON_FALSE(noc_pem_formatted.Get(), ESP_ERR_NO_MEM, close, TAG,
+    ESP_GOTO_ON_FALSE(noc_pem_formatted.Get(), ESP_ERR_NO_MEM, cleanup, TAG,
                       "Failed to allocate memory for noc_pem_formatted");
 
-    ESP_GOTO_ON_FALSE(json_parse_start(&jctx, http_payload.Get(), strlen(http_payload.Get())) == 0, ESP_FAIL, close,
+    ESP_GOTO_ON_FALSE(json_parse_start(&jctx, http_payload.Get(), strlen(http_payload.Get())) == 0, ESP_FAIL, cleanup,
                       TAG, "Failed to parse the http response json on json_parse_start");
     if (json_obj_get_array(&jctx, "certificates", &cert_count) == 0 && cert_count == 1) {
         if (json_arr_get_object(&jctx, 0) == 0) {
@@ -716,18 +700,18 @@ static esp_err_t issue_user_noc_request(ScopedMemoryBufferWithSize<char> &csr_pe
     ESP_LOGD(TAG, "new noc_pem :\n%s", noc_pem_formatted.Get());
 
     noc_der.Calloc(chip::Credentials::kMaxDERCertLength);
-    ESP_GOTO_ON_FALSE(noc_der.Get(), ESP_ERR_NO_MEM, close, TAG, "Failed to allocate memory for noc_der");
+    ESP_GOTO_ON_FALSE(noc_der.Get(), ESP_ERR_NO_MEM, cleanup, TAG, "Failed to allocate memory for noc_der");
     noc_der_len = chip::Credentials::kMaxDERCertLength;
 
     // Convert PEM-encoded NOC to DER-encoded NOC
     ESP_GOTO_ON_FALSE(convert_pem_to_der(noc_pem_formatted.Get(),
                                          strnlen(noc_pem_formatted.Get(), noc_pem_formatted.AllocatedSize()),
                                          noc_der.Get(), &noc_der_len) == 0,
-                      ESP_FAIL, close, TAG, "Failed to convert PEM-encoded NOC to DER-encoded NOC");
+                      ESP_FAIL, cleanup, TAG, "Failed to convert PEM-encoded NOC to DER-encoded NOC");
     noc_pem_formatted.Free();
 
     noc_matter_cert.Calloc(chip::Credentials::kMaxCHIPCertLength);
-    ESP_GOTO_ON_FALSE(noc_matter_cert.Get(), ESP_ERR_NO_MEM, close, TAG,
+    ESP_GOTO_ON_FALSE(noc_matter_cert.Get(), ESP_ERR_NO_MEM, cleanup, TAG,
                       "Failed to allocate memory for noc_matter_cert");
 
     matter_cert_noc = MutableByteSpan(noc_matter_cert.Get(), noc_matter_cert.AllocatedSize());
@@ -737,16 +721,14 @@ static esp_err_t issue_user_noc_request(ScopedMemoryBufferWithSize<char> &csr_pe
     // Update NOC
     ESP_GOTO_ON_FALSE(fabric_table.UpdatePendingFabricWithOperationalKeystore(fabric_index, matter_cert_noc,
                                                                               ByteSpan{}) == CHIP_NO_ERROR,
-                      ESP_FAIL, close, TAG, "Failed to update the Fabric NOC");
-    ESP_GOTO_ON_FALSE(fabric_table.CommitPendingFabricData() == CHIP_NO_ERROR, ESP_FAIL, close, TAG,
+                      ESP_FAIL, cleanup, TAG, "Failed to update the Fabric NOC");
+    ESP_GOTO_ON_FALSE(fabric_table.CommitPendingFabricData() == CHIP_NO_ERROR, ESP_FAIL, cleanup, TAG,
                       "Failed to commit the pending Fabric data");
     // Start DNS server to advertise the new node-id of the new NOC
     chip::app::DnssdServer::Instance().StartServer();
 
-close:
-    esp_http_client_close(client);
 cleanup:
-    esp_http_client_cleanup(client);
+    controller::http_client::release(client);
     return ret;
 }
 
@@ -1105,13 +1087,6 @@ static esp_err_t fetch_access_token(ScopedMemoryBufferWithSize<char> &refresh_to
     esp_err_t ret = ESP_OK;
     char url[100];
     snprintf(url, sizeof(url), "%s/%s/%s", endpoint_url.Get(), HTTP_API_VERSION, "login2");
-    esp_http_client_config_t config = {
-        .url = url,
-        .transport_type = HTTP_TRANSPORT_OVER_SSL,
-        .buffer_size = 2048,
-        .skip_cert_common_name_check = false,
-        .crt_bundle_attach = esp_crt_bundle_attach,
-    };
     esp_http_client_handle_t client = NULL;
     ScopedMemoryBufferWithSize<char> http_payload;
     constexpr size_t http_payload_size =
@@ -1122,14 +1097,13 @@ static esp_err_t fetch_access_token(ScopedMemoryBufferWithSize<char> &refresh_to
     jparse_ctx_t jctx;
 
     ESP_RETURN_ON_FALSE(access_token.Get(), ESP_ERR_INVALID_ARG, TAG, "access_token pointer cannot be NULL");
-    client = esp_http_client_init(&config);
+    client = http_client::acquire(url, HTTP_METHOD_POST);
     ESP_RETURN_ON_FALSE(client, ESP_FAIL, TAG, "Failed to initialise HTTP Client.");
 
     ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "accept", "application/json"), cleanup, TAG,
                       "Failed to set http header accept");
     ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "Content-Type", "application/json"), cleanup, TAG,
                       "Failed to set http header Content-Type");
-    ESP_GOTO_ON_ERROR(esp_http_client_set_method(client, HTTP_METHOD_POST), cleanup, TAG, "Failed to set http method");
 
     // Prepare the payload for http write and read
     http_payload.Calloc(http_payload_size);
@@ -1148,7 +1122,7 @@ static esp_err_t fetch_access_token(ScopedMemoryBufferWithSize<char> &refresh_to
     if (http_len != strnlen(http_payload.Get(), http_payload_size)) {
         ESP_LOGE(TAG, "Failed to write Payload. Returned len = %d.", http_len);
         ret = ESP_FAIL;
-        goto close;
+        goto cleanup;
     }
     http_len = esp_http_client_fetch_headers(client);
     http_status_code = esp_http_client_get_status_code(client);
@@ -1162,11 +1136,11 @@ static esp_err_t fetch_access_token(ScopedMemoryBufferWithSize<char> &refresh_to
         ESP_LOGE(TAG, "Invalid response for %s", url);
         ESP_LOGE(TAG, "Status = %d, Data = %s", http_status_code, http_len > 0 ? http_payload.Get() : "None");
         ret = ESP_FAIL;
-        goto close;
+        goto cleanup;
     }
     // Parse the response payload
     ESP_GOTO_ON_FALSE(json_parse_start(&jctx, http_payload.Get(), strnlen(http_payload.Get(), http_payload_size)) == 0,
-                      ESP_FAIL, close, TAG, "Failed to parse the http response json on json_parse_start");
+                      ESP_FAIL, cleanup, TAG, "Failed to parse the http response json on json_parse_start");
     if (json_obj_get_strlen(&jctx, "accesstoken", &access_token_len) != 0 ||
         json_obj_get_string(&jctx, "accesstoken", access_token.Get(), access_token.AllocatedSize()) != 0) {
         ESP_LOGE(TAG, "Failed to parse the access token from the http response json");
@@ -1176,28 +1150,29 @@ static esp_err_t fetch_access_token(ScopedMemoryBufferWithSize<char> &refresh_to
     }
     json_parse_end(&jctx);
 
-close:
-    esp_http_client_close(client);
 cleanup:
-    esp_http_client_cleanup(client);
+    http_client::release(client);
     return ret;
 }
 
-static uint16_t s_access_token_expired_timer_endpoint_id = chip::kInvalidEndpointId;
+// The access token will be expired after one hour
+#define ACCESS_TOKEN_LIFETIME_SECONDS 3600
+#define ACCESS_TOKEN_REFRESH_RETRY_SECONDS 30
+#define ACCESS_TOKEN_REFRESH_TASK_STACK_SIZE 4096
 
-static void access_token_expired_callback(chip::System::Layer *systemLayer, void *appState)
-{
-    uint16_t endpoint_id = s_access_token_expired_timer_endpoint_id;
-    if (cluster::matter_controller::attribute::authorized_attribute_update(endpoint_id, false) != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to update authorized attribute");
-        return;
-    }
-    if (controller_authorize(endpoint_id) != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to do authorizing");
-    }
-}
+static uint16_t s_access_token_endpoint_id = chip::kInvalidEndpointId;
+static bool s_access_token_refreshing = false;
+static access_token_refresh_stats_t s_access_token_refresh_stats = {};
 
-esp_err_t controller_authorize(uint16_t endpoint_id)
+typedef struct {
+    uint16_t endpoint_id;
+    esp_err_t err;
+    uint32_t latency_ms;
+} access_token_refresh_result_t;
+
+static void start_access_token_refresh();
+
+static esp_err_t refresh_access_token(uint16_t endpoint_id)
 {
     ScopedMemoryBufferWithSize<char> refresh_token;
     ScopedMemoryBufferWithSize<char> endpoint_url;
@@ -1221,20 +1196,123 @@ esp_err_t controller_authorize(uint16_t endpoint_id)
     // Fetch the access_token
     ESP_RETURN_ON_ERROR(fetch_access_token(refresh_token, endpoint_url, access_token), TAG,
                         "Failed to fetch access_token for authorizing");
-    // Update the access token
+    // Update the access token, the requests keep using the previous one until it is replaced here
     ESP_RETURN_ON_ERROR(
         cluster::matter_controller::attribute::access_token_attribute_update(endpoint_id, access_token.Get()), TAG,
         "Failed to update access_token");
+    return ESP_OK;
+}
+
+static void access_token_expired_callback(chip::System::Layer *systemLayer, void *appState)
+{
+    uint16_t endpoint_id = s_access_token_endpoint_id;
+    ESP_LOGW(TAG, "The access token expired before it was refreshed");
+    if (cluster::matter_controller::attribute::authorized_attribute_update(endpoint_id, false) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to update authorized attribute");
+    }
+    start_access_token_refresh();
+}
+
+static void access_token_refresh_timer_callback(chip::System::Layer *systemLayer, void *appState)
+{
+    start_access_token_refresh();
+}
+
+static void schedule_access_token_refresh(uint16_t endpoint_id)
+{
+    static_assert(CONFIG_ESP_MATTER_CONTROLLER_ACCESS_TOKEN_REFRESH_LEAD_TIME < ACCESS_TOKEN_LIFETIME_SECONDS,
+                  "The access token refresh lead time should be shorter than the access token lifetime");
+    constexpr uint32_t refresh_delay_seconds =
+        ACCESS_TOKEN_LIFETIME_SECONDS - CONFIG_ESP_MATTER_CONTROLLER_ACCESS_TOKEN_REFRESH_LEAD_TIME;
+    s_access_token_endpoint_id = endpoint_id;
+    SystemLayer().CancelTimer(access_token_expired_callback, NULL);
+    SystemLayer().CancelTimer(access_token_refresh_timer_callback, NULL);
+    SystemLayer().StartTimer(Seconds32(ACCESS_TOKEN_LIFETIME_SECONDS), access_token_expired_callback, NULL);
+    SystemLayer().StartTimer(Seconds32(refresh_delay_seconds), access_token_refresh_timer_callback, NULL);
+}
+
+static void access_token_refresh_done(intptr_t arg)
+{
+    access_token_refresh_result_t *result = reinterpret_cast<access_token_refresh_result_t *>(arg);
+    access_token_refresh_stats_t &stats = s_access_token_refresh_stats;
+    s_access_token_refreshing = false;
+    stats.refresh_count++;
+    stats.last_error = result->err;
+    stats.last_latency_ms = result->latency_ms;
+    if (result->latency_ms > stats.max_latency_ms) {
+        stats.max_latency_ms = result->latency_ms;
+    }
+    if (result->err == ESP_OK) {
+        ESP_LOGI(TAG, "Refreshed the access token in %" PRIu32 " ms", result->latency_ms);
+        if (cluster::matter_controller::attribute::authorized_attribute_update(result->endpoint_id, true) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to update authorized attribute");
+        }
+        schedule_access_token_refresh(result->endpoint_id);
+    } else {
+        // Keep the expiry timer, the current token is used until it expires
+        stats.failure_count++;
+        ESP_LOGE(TAG, "Failed to refresh the access token: %s, retrying in %d seconds", esp_err_to_name(result->err),
+                 ACCESS_TOKEN_REFRESH_RETRY_SECONDS);
+        SystemLayer().StartTimer(Seconds32(ACCESS_TOKEN_REFRESH_RETRY_SECONDS), access_token_refresh_timer_callback,
+                                 NULL);
+    }
+    free(result);
+}
+
+static void access_token_refresh_task(void *arg)
+{
+    access_token_refresh_result_t *result = (access_token_refresh_result_t *)arg;
+    int64_t start_us = esp_timer_get_time();
+    result->err = refresh_access_token(result->endpoint_id);
+    result->latency_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+    if (PlatformMgr().ScheduleWork(access_token_refresh_done, reinterpret_cast<intptr_t>(result)) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to schedule the access token refresh result");
+        free(result);
+        s_access_token_refreshing = false;
+    }
+    vTaskDelete(NULL);
+}
+
+/* Refresh the access token in a background task, the result is applied in the Matter task */
+static void start_access_token_refresh()
+{
+    if (s_access_token_refreshing || s_access_token_endpoint_id == chip::kInvalidEndpointId) {
+        return;
+    }
+    access_token_refresh_result_t *result =
+        (access_token_refresh_result_t *)calloc(1, sizeof(access_token_refresh_result_t));
+    if (result) {
+        result->endpoint_id = s_access_token_endpoint_id;
+        s_access_token_refreshing = true;
+        if (xTaskCreate(access_token_refresh_task, "token_refresh", ACCESS_TOKEN_REFRESH_TASK_STACK_SIZE, result, 5,
+                        NULL) == pdTRUE) {
+            return;
+        }
+        s_access_token_refreshing = false;
+        free(result);
+    }
+    ESP_LOGE(TAG, "Failed to start the access token refresh");
+    s_access_token_refresh_stats.failure_count++;
+    s_access_token_refresh_stats.last_error = ESP_ERR_NO_MEM;
+    SystemLayer().StartTimer(Seconds32(ACCESS_TOKEN_REFRESH_RETRY_SECONDS), access_token_refresh_timer_callback, NULL);
+}
+
+esp_err_t controller_authorize(uint16_t endpoint_id)
+{
+    ESP_RETURN_ON_ERROR(refresh_access_token(endpoint_id), TAG, "Failed to refresh the access token");
     // Update the authorized attribute
     ESP_RETURN_ON_ERROR(cluster::matter_controller::attribute::authorized_attribute_update(endpoint_id, true), TAG,
                         "Failed to update authorized attribute");
-    // The access token will be expired after one hour
-    s_access_token_expired_timer_endpoint_id = endpoint_id;
-    SystemLayer().CancelTimer(access_token_expired_callback, NULL);
-    SystemLayer().StartTimer(Seconds32(3600), access_token_expired_callback, NULL);
-
+    schedule_access_token_refresh(endpoint_id);
     return ESP_OK;
 }
 
+void get_access_token_refresh_stats(access_token_refresh_stats_t *stats)
+{
+    if (stats) {
+        *stats = s_access_token_refresh_stats;
+    }
+}
+
 } // namespace controller
 } // namespace esp_matter
@@ -27,7 +27,20 @@
 namespace esp_matter {
 
 namespace controller {
+/* Statistics of the background access token refreshes */
+typedef struct {
+    uint32_t refresh_count;
+    uint32_t failure_count;
+    uint32_t last_latency_ms;
+    uint32_t max_latency_ms;
+    esp_err_t last_error;
+} access_token_refresh_stats_t;
+
+/* Fetch an access token and refresh it in the background before it expires */
 esp_err_t controller_authorize(uint16_t endpoint_id);
+
+/* Get the access token refresh statistics, should be called in the Matter task */
+void get_access_token_refresh_stats(access_token_refresh_stats_t *stats);
 }
 
 namespace cluster {
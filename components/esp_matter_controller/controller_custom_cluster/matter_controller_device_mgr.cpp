@@ -12,14 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <ctype.h>
 #include <esp_check.h>
-#include <esp_crt_bundle.h>
 #include <esp_http_client.h>
 #include <esp_matter_controller_utils.h>
 #include <json_generator.h>
-#include <json_parser.h>
 #include <matter_controller_cluster.h>
 #include <matter_controller_device_mgr.h>
+#include <matter_controller_http_client.h>
+#include <strings.h>
 
 #include <lib/support/ScopedBuffer.h>
 
@@ -44,6 +45,31 @@ typedef struct {
     void *arg;
 } task_post_t;
 
+/* Entry of s_matter_device_list, the public part is what the clones copy */
+typedef struct {
+    matter_device_t dev;
+    /* The status and metadata were given by the cloud, so the node does not need to be queried for them */
+    bool has_status;
+    bool has_metadata;
+    bool seen;
+} device_entry_t;
+
+#define DEVICE_INDEX_MIN_SIZE 16
+#define ETAG_MAX_LEN 64
+
+/*
+ * Open addressing hash indexes of s_matter_device_list, by Matter node ID and by RainMaker node ID. They are rebuilt
+ * when devices are added or removed, which is rare compared to the lookups.
+ */
+static matter_device_t **s_node_id_index = NULL;
+static matter_device_t **s_rainmaker_id_index = NULL;
+static size_t s_index_size = 0;
+
+/* ETag of the last node list, sent back in If-None-Match so that an unchanged list is not downloaded again */
+static char s_node_list_etag[ETAG_MAX_LEN] = {0};
+static char s_node_list_etag_group_id[ESP_MATTER_RAINMAKER_MAX_GROUP_ID_LEN] = {0};
+static char s_received_etag[ETAG_MAX_LEN] = {0};
+
 class scoped_device_mgr_lock {
 public:
     scoped_device_mgr_lock()
@@ -128,16 +154,91 @@ matter_device_t *get_device_list_clone()
     return ret;
 }
 
+static size_t hash_node_id(uint64_t node_id)
+{
+    node_id ^= node_id >> 33;
+    node_id *= 0xff51afd7ed558ccdULL;
+    node_id ^= node_id >> 33;
+    return (size_t)node_id;
+}
+
+static size_t hash_rainmaker_node_id(const char *rainmaker_node_id)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(((matter_device_t *)0)->rainmaker_node_id) && rainmaker_node_id[i]; ++i) {
+        hash = (hash ^ (uint8_t)rainmaker_node_id[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool rainmaker_node_id_equal(const matter_device_t *dev, const char *rainmaker_node_id)
+{
+    return strncmp(dev->rainmaker_node_id, rainmaker_node_id, sizeof(dev->rainmaker_node_id)) == 0;
+}
+
+static void free_device_index()
+{
+    free(s_node_id_index);
+    free(s_rainmaker_id_index);
+    s_node_id_index = NULL;
+    s_rainmaker_id_index = NULL;
+    s_index_size = 0;
+}
+
+/* Rebuild the indexes, with at least twice as many slots as devices so that the probe sequences stay short */
+static esp_err_t rebuild_device_index()
+{
+    size_t device_count = 0;
+    size_t index_size = DEVICE_INDEX_MIN_SIZE;
+    for (matter_device_t *dev = s_matter_device_list; dev; dev = dev->next) {
+        device_count++;
+    }
+    while (index_size < device_count * 2) {
+        index_size *= 2;
+    }
+    free_device_index();
+    s_node_id_index = (matter_device_t **)calloc(index_size, sizeof(matter_device_t *));
+    s_rainmaker_id_index = (matter_device_t **)calloc(index_size, sizeof(matter_device_t *));
+    if (!s_node_id_index || !s_rainmaker_id_index) {
+        ESP_LOGE(TAG, "Failed to allocate memory for the device index");
+        free_device_index();
+        return ESP_ERR_NO_MEM;
+    }
+    s_index_size = index_size;
+    for (matter_device_t *dev = s_matter_device_list; dev; dev = dev->next) {
+        size_t slot = hash_node_id(dev->node_id) & (index_size - 1);
+        while (s_node_id_index[slot]) {
+            slot = (slot + 1) & (index_size - 1);
+        }
+        s_node_id_index[slot] = dev;
+        slot = hash_rainmaker_node_id(dev->rainmaker_node_id) & (index_size - 1);
+        while (s_rainmaker_id_index[slot]) {
+            slot = (slot + 1) & (index_size - 1);
+        }
+        s_rainmaker_id_index[slot] = dev;
+    }
+    return ESP_OK;
+}
+
 static matter_device_t *get_device(uint64_t node_id)
 {
-    matter_device_t *ret = s_matter_device_list;
-    while (ret) {
-        if (ret->node_id == node_id) {
-            break;
+    if (!s_node_id_index) {
+        /* The index failed to build, fall back to walking the list */
+        matter_device_t *ret = s_matter_device_list;
+        while (ret && ret->node_id != node_id) {
+            ret = ret->next;
         }
-        ret = ret->next;
+        return ret;
     }
-    return ret;
+    size_t slot = hash_node_id(node_id) & (s_index_size - 1);
+    while (s_node_id_index[slot]) {
+        if (s_node_id_index[slot]->node_id == node_id) {
+            return s_node_id_index[slot];
+        }
+        slot = (slot + 1) & (s_index_size - 1);
+    }
+    return NULL;
 }
 
 static matter_device_t *get_device(char *rainmaker_node_id)
@@ -145,59 +246,446 @@ static matter_device_t *get_device(char *rainmaker_node_id)
     if (!rainmaker_node_id) {
         return NULL;
     }
-    matter_device_t *ret = s_matter_device_list;
-    while (ret) {
-        if (strncmp(ret->rainmaker_node_id, rainmaker_node_id,
-                    strnlen(ret->rainmaker_node_id, sizeof(ret->rainmaker_node_id))) == 0) {
-            break;
+    if (!s_rainmaker_id_index) {
+        matter_device_t *ret = s_matter_device_list;
+        while (ret && !rainmaker_node_id_equal(ret, rainmaker_node_id)) {
+            ret = ret->next;
         }
-        ret = ret->next;
+        return ret;
     }
-    return ret;
+    size_t slot = hash_rainmaker_node_id(rainmaker_node_id) & (s_index_size - 1);
+    while (s_rainmaker_id_index[slot]) {
+        if (rainmaker_node_id_equal(s_rainmaker_id_index[slot], rainmaker_node_id)) {
+            return s_rainmaker_id_index[slot];
+        }
+        slot = (slot + 1) & (s_index_size - 1);
+    }
+    return NULL;
 }
 
 matter_device_t *get_device_clone(uint64_t node_id)
 {
-    return clone_device(get_device(node_id));
+    scoped_device_mgr_lock dev_mgr_lock;
+    matter_device_t *dev = get_device(node_id);
+    return dev ? clone_device(dev) : NULL;
 }
 
 matter_device_t *get_device_clone(char *rainmaker_node_id)
 {
-    return clone_device(get_device(rainmaker_node_id));
+    scoped_device_mgr_lock dev_mgr_lock;
+    matter_device_t *dev = get_device(rainmaker_node_id);
+    return dev ? clone_device(dev) : NULL;
+}
+
+/*
+ * Streaming parser of the node_details array of the node list and node metadata responses.
+ *
+ * The response is read in fixed size chunks and tokenized as it arrives, and the fields of the current node element
+ * are stored as they are parsed, so the memory used does not depend on the size of the response. Only the short
+ * string values are kept, the longer ones are skipped.
+ */
+#define NODE_DETAILS_MAX_DEPTH 8
+#define NODE_DETAILS_TOKEN_LEN 64
+#define NODE_DETAILS_READ_CHUNK_SIZE 512
+#define CONTROLLER_NODE_TYPE "Controller"
+
+typedef enum : uint8_t {
+    KEY_OTHER = 0,
+    KEY_NODE_DETAILS,
+    KEY_TYPE,
+    KEY_MATTER_NODE_ID,
+    KEY_NODE_ID,
+    KEY_ID,
+    KEY_STATUS,
+    KEY_CONNECTIVITY,
+    KEY_CONNECTED,
+    KEY_METADATA,
+    KEY_DEVICE_TYPE,
+    KEY_ENDPOINTS_DATA,
+    KEY_IS_RAINMAKER,
+    KEY_COUNT,
+} node_details_key_t;
+
+static const char *const k_node_details_key_names[KEY_COUNT] = {
+    "", "node_details", "type", "matter_node_id", "node_id", "id", "status", "connectivity", "connected",
+    "metadata", "deviceType", "endpointsData", "isRainmaker",
+};
+
+typedef enum {
+    PARSE_VALUE,
+    PARSE_VALUE_OR_ARRAY_END,
+    PARSE_KEY,
+    PARSE_KEY_OR_OBJECT_END,
+    PARSE_COLON,
+    PARSE_COMMA_OR_END,
+    PARSE_STRING,
+    PARSE_STRING_ESCAPE,
+    PARSE_STRING_UNICODE,
+    PARSE_LITERAL,
+    PARSE_DONE,
+} node_details_parse_state_t;
+
+typedef struct {
+    bool is_array;
+    /* Key of the current member of an object */
+    node_details_key_t key;
+    /* Index of the current element of an array */
+    uint16_t index;
+} node_details_frame_t;
+
+/* Node element being parsed */
+typedef struct {
+    device_entry_t details;
+    bool is_controller;
+    bool has_node_id;
+    bool has_device_type;
+    uint32_t device_type;
+    uint16_t endpoint_id;
+} node_element_t;
+
+typedef esp_err_t (*node_element_cb_t)(node_element_t *element, void *ctx);
+
+typedef struct {
+    node_details_parse_state_t state;
+    bool string_is_key;
+    bool token_truncated;
+    uint8_t unicode_digits;
+    uint8_t depth;
+    node_details_frame_t frames[NODE_DETAILS_MAX_DEPTH];
+    char token[NODE_DETAILS_TOKEN_LEN];
+    size_t token_len;
+    bool found_node_details;
+    bool in_element;
+    /* Key of the RainMaker node ID in the node elements */
+    node_details_key_t rainmaker_node_id_key;
+    node_element_t element;
+    node_element_cb_t element_cb;
+    void *ctx;
+} node_details_parser_t;
+
+typedef enum {
+    VALUE_STRING,
+    VALUE_NUMBER,
+    VALUE_BOOL,
+    VALUE_NULL,
+} node_details_value_type_t;
+
+static node_details_key_t get_node_details_key(const char *name)
+{
+    for (uint8_t key = KEY_OTHER + 1; key < KEY_COUNT; ++key) {
+        if (strcmp(name, k_node_details_key_names[key]) == 0) {
+            return (node_details_key_t)key;
+        }
+    }
+    return KEY_OTHER;
 }
 
-static esp_err_t get_node_reachable(jparse_ctx_t *jctx, bool *value)
+static void on_node_details_value(node_details_parser_t *parser, node_details_value_type_t type, bool bool_value)
 {
-    bool value_got = false;
-    if (json_obj_get_object(jctx, "status") == 0) {
-        if (json_obj_get_object(jctx, "connectivity") == 0) {
-            if (json_obj_get_bool(jctx, "connected", value) == 0) {
-                value_got = true;
-            }
-            json_obj_leave_object(jctx);
+    if (!parser->in_element) {
+        return;
+    }
+    node_element_t *element = &parser->element;
+    matter_device_t *dev = &element->details.dev;
+    const node_details_frame_t *frames = parser->frames;
+    if (parser->depth == 3 && type == VALUE_STRING) {
+        if (frames[2].key == KEY_TYPE) {
+            element->is_controller = strncmp(parser->token, CONTROLLER_NODE_TYPE, strlen(CONTROLLER_NODE_TYPE)) == 0;
+        } else if (frames[2].key == KEY_MATTER_NODE_ID && parser->token_len <= 16) {
+            dev->node_id = strtoull(parser->token, NULL, 16);
+            element->has_node_id = true;
+        } else if (frames[2].key == parser->rainmaker_node_id_key &&
+                   parser->token_len < sizeof(dev->rainmaker_node_id)) {
+            memcpy(dev->rainmaker_node_id, parser->token, parser->token_len + 1);
+        }
+    } else if (parser->depth == 4 && frames[2].key == KEY_METADATA) {
+        if (frames[3].key == KEY_DEVICE_TYPE && type == VALUE_NUMBER) {
+            element->device_type = strtoul(parser->token, NULL, 10);
+            element->has_device_type = true;
+        } else if (frames[3].key == KEY_IS_RAINMAKER && type == VALUE_BOOL) {
+            dev->is_rainmaker_device = bool_value;
+        }
+    } else if (parser->depth == 5) {
+        if (frames[2].key == KEY_STATUS && frames[3].key == KEY_CONNECTIVITY && frames[4].key == KEY_CONNECTED &&
+            type == VALUE_BOOL) {
+            dev->reachable = bool_value;
+            element->details.has_status = true;
+        } else if (frames[2].key == KEY_METADATA && frames[3].key == KEY_ENDPOINTS_DATA && frames[4].is_array &&
+                   frames[4].index == 1 && type == VALUE_NUMBER) {
+            element->endpoint_id = strtoul(parser->token, NULL, 10);
+        }
+    }
+}
+
+static esp_err_t open_node_details_container(node_details_parser_t *parser, bool is_array)
+{
+    ESP_RETURN_ON_FALSE(parser->depth < NODE_DETAILS_MAX_DEPTH, ESP_FAIL, TAG, "The response is nested too deeply");
+    const node_details_frame_t *frames = parser->frames;
+    if (parser->depth == 1 && is_array && frames[0].key == KEY_NODE_DETAILS) {
+        parser->found_node_details = true;
+    } else if (parser->depth == 2 && !is_array && frames[0].key == KEY_NODE_DETAILS && frames[1].is_array) {
+        memset(&parser->element, 0, sizeof(parser->element));
+        parser->in_element = true;
+    } else if (parser->in_element && parser->depth == 3 && !is_array && frames[2].key == KEY_METADATA) {
+        parser->element.details.has_metadata = true;
+    } else if (parser->in_element && parser->depth == 4 && is_array && frames[2].key == KEY_METADATA &&
+               frames[3].key == KEY_ENDPOINTS_DATA) {
+        parser->element.endpoint_id = 1;
+    }
+    parser->frames[parser->depth] = {.is_array = is_array, .key = KEY_OTHER, .index = 0};
+    parser->depth++;
+    parser->state = is_array ? PARSE_VALUE_OR_ARRAY_END : PARSE_KEY_OR_OBJECT_END;
+    return ESP_OK;
+}
+
+static esp_err_t close_node_details_container(node_details_parser_t *parser)
+{
+    parser->depth--;
+    parser->state = parser->depth == 0 ? PARSE_DONE : PARSE_COMMA_OR_END;
+    if (parser->in_element && parser->depth == 2) {
+        parser->in_element = false;
+        node_element_t *element = &parser->element;
+        if (element->details.has_metadata && element->has_device_type) {
+            element->details.dev.endpoints[0].endpoint_id = element->endpoint_id;
+            element->details.dev.endpoints[0].device_type_id = element->device_type;
+            element->details.dev.endpoint_count = 1;
         }
-        json_obj_leave_object(jctx);
+        return parser->element_cb(element, parser->ctx);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t end_node_details_literal(node_details_parser_t *parser)
+{
+    parser->token[parser->token_len] = 0;
+    parser->state = parser->depth == 0 ? PARSE_DONE : PARSE_COMMA_OR_END;
+    if (strcmp(parser->token, "true") == 0 || strcmp(parser->token, "false") == 0) {
+        on_node_details_value(parser, VALUE_BOOL, parser->token[0] == 't');
+        return ESP_OK;
+    }
+    if (strcmp(parser->token, "null") == 0) {
+        on_node_details_value(parser, VALUE_NULL, false);
+        return ESP_OK;
     }
-    return value_got ? ESP_OK : ESP_FAIL;
+    char *end = NULL;
+    strtod(parser->token, &end);
+    ESP_RETURN_ON_FALSE(!parser->token_truncated && parser->token_len > 0 && end == parser->token + parser->token_len,
+                        ESP_FAIL, TAG, "Invalid literal in the response");
+    on_node_details_value(parser, VALUE_NUMBER, false);
+    return ESP_OK;
+}
+
+static void append_node_details_token(node_details_parser_t *parser, char c)
+{
+    if (parser->token_len < sizeof(parser->token) - 1) {
+        parser->token[parser->token_len++] = c;
+    } else {
+        parser->token_truncated = true;
+    }
+}
+
+static void start_node_details_token(node_details_parser_t *parser, node_details_parse_state_t state)
+{
+    parser->token_len = 0;
+    parser->token_truncated = false;
+    parser->state = state;
+}
+
+static bool is_json_whitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool is_json_literal_char(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '+' || c == '-' ||
+        c == '.';
 }
 
-static esp_err_t get_metadata(jparse_ctx_t *jctx, matter_device_t *dev)
+static esp_err_t feed_node_details_parser(node_details_parser_t *parser, const char *data, size_t len)
 {
-    if (json_obj_get_object(jctx, "metadata") == 0) {
-        int device_type = 0;
-        if (json_obj_get_int(jctx, "deviceType", &device_type) == 0) {
-            dev->endpoints[0].device_type_id = device_type;
-            int ep_count = 0;
-            int ep_id = 1;
-            if (json_obj_get_array(jctx, "endpointsData", &ep_count) == 0) {
-                json_arr_get_int(jctx, 1, &ep_id);
-                dev->endpoints[0].endpoint_id = ep_id;
-                json_obj_leave_array(jctx);
+    size_t i = 0;
+    while (i < len) {
+        char c = data[i];
+        switch (parser->state) {
+        case PARSE_STRING:
+            if (c == '"') {
+                parser->token[parser->token_len] = 0;
+                if (parser->string_is_key) {
+                    parser->frames[parser->depth - 1].key =
+                        parser->token_truncated ? KEY_OTHER : get_node_details_key(parser->token);
+                    parser->state = PARSE_COLON;
+                } else {
+                    parser->state = parser->depth == 0 ? PARSE_DONE : PARSE_COMMA_OR_END;
+                    if (!parser->token_truncated) {
+                        on_node_details_value(parser, VALUE_STRING, false);
+                    }
+                }
+            } else if (c == '\\') {
+                parser->state = PARSE_STRING_ESCAPE;
+            } else {
+                ESP_RETURN_ON_FALSE((uint8_t)c >= 0x20, ESP_FAIL, TAG, "Invalid character in a string");
+                append_node_details_token(parser, c);
+            }
+            break;
+        case PARSE_STRING_ESCAPE: {
+            static const char k_escapes[] = "\"\"\\\\//b\bf\fn\nr\rt\t";
+            const char *escape = NULL;
+            for (size_t e = 0; e + 1 < sizeof(k_escapes); e += 2) {
+                if (k_escapes[e] == c) {
+                    escape = &k_escapes[e + 1];
+                    break;
+                }
+            }
+            if (c == 'u') {
+                // The node fields are ASCII, the other characters are only kept as a placeholder
+                append_node_details_token(parser, '?');
+                parser->unicode_digits = 0;
+                parser->state = PARSE_STRING_UNICODE;
+            } else {
+                ESP_RETURN_ON_FALSE(escape, ESP_FAIL, TAG, "Invalid escape sequence in a string");
+                append_node_details_token(parser, *escape);
+                parser->state = PARSE_STRING;
+            }
+            break;
+        }
+        case PARSE_STRING_UNICODE:
+            ESP_RETURN_ON_FALSE(isxdigit((unsigned char)c), ESP_FAIL, TAG, "Invalid unicode escape in a string");
+            if (++parser->unicode_digits == 4) {
+                parser->state = PARSE_STRING;
+            }
+            break;
+        case PARSE_LITERAL:
+            if (is_json_literal_char(c)) {
+                append_node_details_token(parser, c);
+                break;
+            }
+            ESP_RETURN_ON_ERROR(end_node_details_literal(parser), TAG, "Failed to parse the response");
+            // The character after the literal is parsed in the new state
+            continue;
+        default:
+            if (is_json_whitespace(c)) {
+                break;
+            }
+            switch (parser->state) {
+            case PARSE_VALUE_OR_ARRAY_END:
+                if (c == ']') {
+                    ESP_RETURN_ON_ERROR(close_node_details_container(parser), TAG, "Failed to parse the response");
+                    break;
+                }
+                // fall through
+            case PARSE_VALUE:
+                if (c == '"') {
+                    parser->string_is_key = false;
+                    start_node_details_token(parser, PARSE_STRING);
+                } else if (c == '{' || c == '[') {
+                    ESP_RETURN_ON_ERROR(open_node_details_container(parser, c == '['), TAG,
+                                        "Failed to parse the response");
+                } else {
+                    ESP_RETURN_ON_FALSE(is_json_literal_char(c), ESP_FAIL, TAG, "Invalid value in the response");
+                    start_node_details_token(parser, PARSE_LITERAL);
+                    append_node_details_token(parser, c);
+                }
+                break;
+            case PARSE_KEY_OR_OBJECT_END:
+                if (c == '}') {
+                    ESP_RETURN_ON_ERROR(close_node_details_container(parser), TAG, "Failed to parse the response");
+                    break;
+                }
+                // fall through
+            case PARSE_KEY:
+                ESP_RETURN_ON_FALSE(c == '"', ESP_FAIL, TAG, "Expected a key in the response");
+                parser->string_is_key = true;
+                start_node_details_token(parser, PARSE_STRING);
+                break;
+            case PARSE_COLON:
+                ESP_RETURN_ON_FALSE(c == ':', ESP_FAIL, TAG, "Expected ':' in the response");
+                parser->state = PARSE_VALUE;
+                break;
+            case PARSE_COMMA_OR_END: {
+                node_details_frame_t *frame = &parser->frames[parser->depth - 1];
+                if (c == ',') {
+                    if (frame->is_array) {
+                        frame->index++;
+                        parser->state = PARSE_VALUE;
+                    } else {
+                        frame->key = KEY_OTHER;
+                        parser->state = PARSE_KEY;
+                    }
+                } else {
+                    ESP_RETURN_ON_FALSE(c == (frame->is_array ? ']' : '}'), ESP_FAIL, TAG,
+                                        "Expected ',' or the end of a container in the response");
+                    ESP_RETURN_ON_ERROR(close_node_details_container(parser), TAG, "Failed to parse the response");
+                }
+                break;
+            }
+            default:
+                ESP_LOGE(TAG, "Unexpected data after the end of the response");
+                return ESP_FAIL;
             }
-            dev->endpoint_count = 1;
+            break;
         }
-        json_obj_get_bool(jctx, "isRainmaker", &(dev->is_rainmaker_device));
-        json_obj_leave_object(jctx);
+        i++;
+    }
+    return ESP_OK;
+}
+
+/* Read the response of the client and call element_cb for each element of its node_details array */
+static esp_err_t read_node_details(esp_http_client_handle_t client, node_details_key_t rainmaker_node_id_key,
+                                   node_element_cb_t element_cb, void *ctx)
+{
+    ScopedMemoryBufferWithSize<node_details_parser_t> parser_buffer;
+    ScopedMemoryBufferWithSize<char> chunk;
+    parser_buffer.Calloc(1);
+    chunk.Alloc(NODE_DETAILS_READ_CHUNK_SIZE);
+    ESP_RETURN_ON_FALSE(parser_buffer.Get() && chunk.Get(), ESP_ERR_NO_MEM, TAG,
+                        "Failed to allocate the response parser");
+    node_details_parser_t *parser = parser_buffer.Get();
+    parser->state = PARSE_VALUE;
+    parser->rainmaker_node_id_key = rainmaker_node_id_key;
+    parser->element_cb = element_cb;
+    parser->ctx = ctx;
+
+    int read_len = 0;
+    do {
+        read_len = esp_http_client_read_response(client, chunk.Get(), chunk.AllocatedSize());
+        ESP_RETURN_ON_FALSE(read_len >= 0, ESP_FAIL, TAG, "Failed to read the http response");
+        ESP_RETURN_ON_ERROR(feed_node_details_parser(parser, chunk.Get(), read_len), TAG,
+                            "Failed to parse the http response");
+    } while (read_len > 0);
+    if (parser->state == PARSE_LITERAL) {
+        ESP_RETURN_ON_ERROR(end_node_details_literal(parser), TAG, "Failed to parse the http response");
+    }
+    ESP_RETURN_ON_FALSE(parser->state == PARSE_DONE, ESP_FAIL, TAG, "The http response is incomplete");
+    if (!parser->found_node_details) {
+        ESP_LOGE(TAG, "Cannot find node_details from the http response");
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
+/* Update the status and the metadata of a device with the ones of a node element */
+static void update_device_details(matter_device_t *dev, const device_entry_t *details)
+{
+    device_entry_t *entry = (device_entry_t *)dev;
+    if (details->has_status) {
+        dev->reachable = details->dev.reachable;
+    }
+    if (details->has_metadata) {
+        dev->endpoint_count = details->dev.endpoint_count;
+        memcpy(dev->endpoints, details->dev.endpoints, sizeof(dev->endpoints));
+        dev->is_rainmaker_device = details->dev.is_rainmaker_device;
+    }
+    // The details missing from the node list are fetched again by fetch_node_metadata()
+    entry->has_status = details->has_status;
+    entry->has_metadata = details->has_metadata;
+}
+
+static esp_err_t update_node_metadata(node_element_t *element, void *ctx)
+{
+    matter_device_t *dev = get_device(element->details.dev.rainmaker_node_id);
+    if (dev) {
+        update_device_details(dev, &element->details);
     }
     return ESP_OK;
 }
@@ -209,37 +697,28 @@ static esp_err_t fetch_node_metadata(ScopedMemoryBufferWithSize<char> &endpoint_
     matter_device_t *dev = s_matter_device_list;
     char url[200];
     int http_len, http_status_code;
-    esp_http_client_config_t config = {
-        .url = url,
-        .transport_type = HTTP_TRANSPORT_OVER_SSL,
-        .buffer_size = 4096,
-        .buffer_size_tx = 2048,
-        .skip_cert_common_name_check = false,
-        .crt_bundle_attach = esp_crt_bundle_attach,
-    };
     esp_http_client_handle_t client = NULL;
-    jparse_ctx_t jctx;
-    int node_count = 0;
-    int node_index = 0;
-    char id_str[24] = {0};
-    int id_str_len = 0;
     ScopedMemoryBufferWithSize<char> http_payload;
-    http_payload.Calloc(4096);
+    http_payload.Calloc(512);
     ESP_RETURN_ON_FALSE(http_payload.Get(), ESP_ERR_NO_MEM, TAG, "Failed to allocate memory for http_payload");
 
     scoped_device_mgr_lock dev_mgr_lock;
     while (dev) {
+        device_entry_t *entry = (device_entry_t *)dev;
+        if (entry->has_status && entry->has_metadata) {
+            // The node list already gave the details of this node
+            dev = dev->next;
+            continue;
+        }
         snprintf(url, sizeof(url), "%s/%s/%s?node_id=%s&%s", endpoint_url.Get(), HTTP_API_VERSION, "user/nodes",
                  dev->rainmaker_node_id, "node_details=true&is_matter=true");
-        client = esp_http_client_init(&config);
+        client = http_client::acquire(url, HTTP_METHOD_GET);
         ESP_RETURN_ON_FALSE(client, ESP_FAIL, TAG, "Failed to initialise HTTP Client.");
 
         ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "accept", "application/json"), cleanup, TAG,
                           "Failed to set http header accept");
         ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "Authorization", access_token.Get()), cleanup, TAG,
                           "Failed to set http header Authorization");
-        ESP_GOTO_ON_ERROR(esp_http_client_set_method(client, HTTP_METHOD_GET), cleanup, TAG,
-                          "Failed to set http method");
 
         // HTTP GET Method
         ESP_GOTO_ON_ERROR(esp_http_client_open(client, 0), cleanup, TAG, "Failed to open http connection");
@@ -248,10 +727,7 @@ static esp_err_t fetch_node_metadata(ScopedMemoryBufferWithSize<char> &endpoint_
         http_status_code = esp_http_client_get_status_code(client);
 
         // Read Response
-        if ((http_len > 0) && (http_status_code == 200)) {
-            http_len = esp_http_client_read_response(client, http_payload.Get(), http_payload.AllocatedSize() - 1);
-            http_payload[http_len] = '\0';
-        } else {
+        if ((http_len <= 0) || (http_status_code != 200)) {
             http_len = esp_http_client_read_response(client, http_payload.Get(), http_payload.AllocatedSize() - 1);
             http_payload[http_len] = '\0';
             ESP_LOGE(TAG, "Invalid response for %s", url);
@@ -260,197 +736,103 @@ static esp_err_t fetch_node_metadata(ScopedMemoryBufferWithSize<char> &endpoint_
                 cluster::matter_controller::attribute::authorized_attribute_update(endpoint_id, false);
             }
             ret = ESP_FAIL;
-            goto close;
+            goto cleanup;
         }
-        ESP_LOGD(TAG, "http response payload: %s", http_payload.Get());
 
         // Parse the http response
-        ESP_GOTO_ON_FALSE(json_parse_start(&jctx, http_payload.Get(), strlen(http_payload.Get())) == 0, ESP_FAIL, close,
-                          TAG, "Failed to parse the http response json on json_parse_start");
-        if (json_obj_get_array(&jctx, "node_details", &node_count) == 0) {
-            for (node_index = 0; node_index < node_count; ++node_index) {
-                if (json_arr_get_object(&jctx, node_index) == 0) {
-                    if (json_obj_get_strlen(&jctx, "id", &id_str_len) == 0 &&
-                        json_obj_get_string(&jctx, "id", id_str, id_str_len + 1) == 0) {
-                        id_str[id_str_len] = '\0';
-                        dev = get_device(id_str);
-                        if (dev) {
-                            get_node_reachable(&jctx, &(dev->reachable));
-                            get_metadata(&jctx, dev);
-                        }
-                    }
-                    json_arr_leave_object(&jctx);
-                }
-            }
-            json_obj_leave_array(&jctx);
+        ret = read_node_details(client, KEY_ID, update_node_metadata, NULL);
+        if (ret == ESP_ERR_NOT_FOUND) {
+            // The node has no details
+            ret = ESP_OK;
         }
-        json_parse_end(&jctx);
+        ESP_GOTO_ON_ERROR(ret, cleanup, TAG, "Failed to parse the node metadata");
         dev = dev->next;
-        esp_http_client_close(client);
-        esp_http_client_cleanup(client);
+        http_client::release(client);
         client = NULL;
     }
     print_device_list(s_matter_device_list);
 
-close:
-    if (client) {
-        esp_http_client_close(client);
-    }
 cleanup:
-    if (client) {
-        esp_http_client_cleanup(client);
-    }
+    http_client::release(client);
     return ret;
 }
 
-#define CONTROLLER_NODE_TYPE "Controller"
-
-typedef enum {
-    FIND_NODE_DETAILS_ARRAY,
-    READ_NODE_STRUCTURE_ELEMENTS,
-    READ_END,
-} read_node_list_status_t;
-
-static const char *find_sub_string(const char *str, const char *sub_str)
+static esp_err_t add_node_list_element(node_element_t *element, void *ctx)
 {
-    if (!str || !sub_str || strlen(str) < strlen(sub_str)) {
-        return nullptr;
-    }
-    while (*str) {
-        if (strncmp(str, sub_str, strlen(sub_str)) == 0) {
-            return str;
-        }
-        str++;
-    }
-    return nullptr;
-}
-
-static char *consume_buffer(char *buffer, size_t buffer_len, size_t consumed_buffer_len)
-{
-    const char *moved_buffer_ptr = buffer + consumed_buffer_len;
-    size_t moved_buffer_len = strlen(moved_buffer_ptr);
-    for (size_t i = 0; i < moved_buffer_len; ++i) {
-        buffer[i] = moved_buffer_ptr[i];
+    matter_device_t **device_list = (matter_device_t **)ctx;
+    if (element->is_controller || !element->has_node_id) {
+        // Skip the controller node
+        return ESP_OK;
     }
-    buffer[moved_buffer_len] = 0;
-    return &buffer[moved_buffer_len];
+    device_entry_t *device_entry = (device_entry_t *)calloc(1, sizeof(device_entry_t));
+    ESP_RETURN_ON_FALSE(device_entry, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for device element");
+    *device_entry = element->details;
+    device_entry->dev.next = *device_list;
+    *device_list = &(device_entry->dev);
+    return ESP_OK;
 }
 
-static const char *get_element_end(const char *element_start)
+static esp_err_t read_node_list(esp_http_client_handle_t client, matter_device_t **device_list)
 {
-    bool in_quotation = false;
-    while (*element_start) {
-        if (*element_start == '}' && !in_quotation) {
-            return element_start;
-        }
-        if (*element_start == '"' && *(element_start - 1) != '\\') {
-            in_quotation = !in_quotation;
-        }
-        element_start++;
-    }
-    return nullptr;
+    return read_node_details(client, KEY_NODE_ID, add_node_list_element, device_list);
 }
 
-static matter_device_t *parse_matter_device_element(const char *element_start, const char *element_end)
+/* Merge the fetched node list into s_matter_device_list, the known devices are updated in place */
+static void merge_device_list(matter_device_t *new_device_list)
 {
-    if (!element_start || !element_end || element_end <= element_start) {
-        return nullptr;
+    bool list_changed = false;
+    for (matter_device_t *dev = s_matter_device_list; dev; dev = dev->next) {
+        ((device_entry_t *)dev)->seen = false;
     }
-    jparse_ctx_t jctx;
-    matter_device_t *device_element = nullptr;
-    int str_len;
-    char node_type_str[32];
-    if (json_parse_start(&jctx, element_start, element_end - element_start + 1) == 0) {
-        if (json_obj_get_strlen(&jctx, "type", &str_len) == 0 &&
-            json_obj_get_string(&jctx, "type", node_type_str, str_len + 1) == 0) {
-            if (strncmp(node_type_str, CONTROLLER_NODE_TYPE, strlen(CONTROLLER_NODE_TYPE)) == 0) {
-                // Skip the controller node
-                json_parse_end(&jctx);
-                return nullptr;
+    while (new_device_list) {
+        matter_device_t *new_dev = new_device_list;
+        device_entry_t *new_entry = (device_entry_t *)new_dev;
+        new_device_list = new_device_list->next;
+        matter_device_t *dev = get_device(new_dev->node_id);
+        if (!dev || ((device_entry_t *)dev)->seen) {
+            // New device, or a node ID listed twice
+            if (dev) {
+                free(new_dev);
+                continue;
             }
+            new_entry->seen = true;
+            new_dev->next = s_matter_device_list;
+            s_matter_device_list = new_dev;
+            list_changed = true;
+            continue;
         }
-        char matter_node_id_str[17];
-        if (json_obj_get_strlen(&jctx, "matter_node_id", &str_len) == 0 &&
-            json_obj_get_string(&jctx, "matter_node_id", matter_node_id_str, str_len + 1) == 0) {
-            matter_node_id_str[str_len] = '\0';
-            device_element = (matter_device_t *)calloc(1, sizeof(matter_device_t));
-            if (!device_element) {
-                ESP_LOGE(TAG, "Failed to alloc memory for device element");
-                json_parse_end(&jctx);
-                return nullptr;
-            }
-            device_element->node_id = strtoull(matter_node_id_str, NULL, 16);
-            if (json_obj_get_strlen(&jctx, "node_id", &str_len) == 0) {
-                json_obj_get_string(&jctx, "node_id", device_element->rainmaker_node_id, str_len + 1);
-            }
+        device_entry_t *entry = (device_entry_t *)dev;
+        entry->seen = true;
+        if (!rainmaker_node_id_equal(dev, new_dev->rainmaker_node_id)) {
+            memcpy(dev->rainmaker_node_id, new_dev->rainmaker_node_id, sizeof(dev->rainmaker_node_id));
+            list_changed = true;
+        }
+        update_device_details(dev, new_entry);
+        free(new_dev);
+    }
+    // Remove the devices which are no longer in the list
+    matter_device_t **prev_next = &s_matter_device_list;
+    while (*prev_next) {
+        matter_device_t *dev = *prev_next;
+        if (((device_entry_t *)dev)->seen) {
+            prev_next = &dev->next;
+            continue;
         }
-        json_parse_end(&jctx);
+        *prev_next = dev->next;
+        free(dev);
+        list_changed = true;
+    }
+    if (list_changed || !s_node_id_index) {
+        rebuild_device_index();
     }
-    return device_element;
 }
 
-static esp_err_t read_node_list(esp_http_client_handle_t client, matter_device_t **device_list)
+static esp_err_t node_list_http_event_handler(esp_http_client_event_t *evt)
 {
-    ScopedMemoryBufferWithSize<char> http_response;
-    http_response.Alloc(1024);
-    ESP_RETURN_ON_FALSE(http_response.Get(), ESP_ERR_NO_MEM, TAG, "Failed to allocate buffer for http response");
-    int buffer_len_to_read = http_response.AllocatedSize() - 1;
-    char *buffer_ptr_to_read = http_response.Get();
-    read_node_list_status_t status = FIND_NODE_DETAILS_ARRAY;
-    bool is_complete_response_received = false;
-
-    do {
-        int read_len = 0;
-        if (!is_complete_response_received) {
-            read_len = esp_http_client_read_response(client, buffer_ptr_to_read, buffer_len_to_read);
-            buffer_ptr_to_read[read_len] = 0;
-        }
-        if (read_len < buffer_len_to_read) {
-            is_complete_response_received = true;
-        }
-        if (status == FIND_NODE_DETAILS_ARRAY) {
-            const char *node_details_ptr = find_sub_string(http_response.Get(), "\"node_details\":[{");
-            if (!node_details_ptr && is_complete_response_received) {
-                ESP_LOGE(TAG, "Cannot find node_details from the http response");
-                return ESP_ERR_NOT_FOUND;
-            }
-            if (node_details_ptr) {
-                status = READ_NODE_STRUCTURE_ELEMENTS;
-            }
-            // If node_details is not found, we need to read more response to the buffer to get to node_details.
-            // Otherwise we should consume the buffer before the first node structure element
-            size_t cusumed_buffer_size =
-                node_details_ptr ? node_details_ptr - http_response.Get() + 15 : http_response.AllocatedSize() - 40;
-            buffer_ptr_to_read =
-                consume_buffer(http_response.Get(), http_response.AllocatedSize() - 1, cusumed_buffer_size);
-        } else if (status == READ_NODE_STRUCTURE_ELEMENTS) {
-            if (http_response[0] == '[' || http_response[0] == ',') {
-                const char *element_start = http_response.Get() + 1;
-                if (*element_start != '{') {
-                    return ESP_FAIL;
-                }
-                const char *element_end = get_element_end(element_start);
-                if (!element_end) {
-                    return ESP_FAIL;
-                }
-                matter_device_t *device_entry = parse_matter_device_element(element_start, element_end);
-                if (device_entry) {
-                    device_entry->next = *device_list;
-                    *device_list = device_entry;
-                }
-                // Consume the parsed node element
-                buffer_ptr_to_read = consume_buffer(http_response.Get(), http_response.AllocatedSize() - 1,
-                                                    element_end + 1 - http_response.Get());
-            } else if (http_response[0] == ']') {
-                // Node elements array ends with ']'
-                status = READ_END;
-            } else {
-                return ESP_FAIL;
-            }
-        }
-        // Try to fill all the buffer in the next response read.
-        buffer_len_to_read = http_response.Get() + http_response.AllocatedSize() - buffer_ptr_to_read - 1;
-    } while (status != READ_END);
+    if (evt->event_id == HTTP_EVENT_ON_HEADER && strcasecmp(evt->header_key, "ETag") == 0) {
+        strncpy(s_received_etag, evt->header_value, sizeof(s_received_etag) - 1);
+        s_received_etag[sizeof(s_received_etag) - 1] = 0;
+    }
     return ESP_OK;
 }
 
@@ -466,30 +848,34 @@ static esp_err_t fetch_node_list(ScopedMemoryBufferWithSize<char> &endpoint_url,
 
     snprintf(url, sizeof(url), "%s/%s/%s=%s&%s", endpoint_url.Get(), HTTP_API_VERSION, "user/node_group?group_id",
              rainmaker_group_id.Get(), "node_details=true&sub_groups=false&node_list=true&is_matter=true");
-    esp_http_client_config_t config = {
-        .url = url,
-        .transport_type = HTTP_TRANSPORT_OVER_SSL,
-        .buffer_size = 1024,
-        .buffer_size_tx = 1536,
-        .skip_cert_common_name_check = false,
-        .crt_bundle_attach = esp_crt_bundle_attach,
-    };
-    esp_http_client_handle_t client = esp_http_client_init(&config);
+    esp_http_client_handle_t client = http_client::acquire(url, HTTP_METHOD_GET, node_list_http_event_handler);
     ESP_RETURN_ON_FALSE(client, ESP_FAIL, TAG, "Failed to initialise HTTP Client.");
+    s_received_etag[0] = 0;
+    if (strncmp(s_node_list_etag_group_id, rainmaker_group_id.Get(), sizeof(s_node_list_etag_group_id)) != 0) {
+        // The ETag is only valid for the group it was received for
+        s_node_list_etag[0] = 0;
+    }
+    if (s_node_list_etag[0]) {
+        ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "If-None-Match", s_node_list_etag), cleanup, TAG,
+                          "Failed to set http header If-None-Match");
+    }
 
     ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "accept", "application/json"), cleanup, TAG,
                       "Failed to set http header accept");
     ESP_GOTO_ON_ERROR(esp_http_client_set_header(client, "Authorization", access_token.Get()), cleanup, TAG,
                       "Failed to set http header Authorization");
-    ESP_GOTO_ON_ERROR(esp_http_client_set_method(client, HTTP_METHOD_GET), cleanup, TAG, "Failed to set http method");
 
     // HTTP GET Method
     ESP_GOTO_ON_ERROR(esp_http_client_open(client, 0), cleanup, TAG, "Failed to open http connection");
 
     http_len = esp_http_client_fetch_headers(client);
     http_status_code = esp_http_client_get_status_code(client);
+    if (http_status_code == 304) {
+        ESP_LOGD(TAG, "The node list is not modified");
+        goto cleanup;
+    }
     http_payload.Calloc(512);
-    ESP_GOTO_ON_FALSE(http_payload.Get(), ESP_ERR_NO_MEM, close, TAG, "Failed to allocate memory for http_payload");
+    ESP_GOTO_ON_FALSE(http_payload.Get(), ESP_ERR_NO_MEM, cleanup, TAG, "Failed to allocate memory for http_payload");
 
     // Read Response
     if ((http_len == 0) || (http_status_code != 200)) {
@@ -501,22 +887,21 @@ static esp_err_t fetch_node_list(ScopedMemoryBufferWithSize<char> &endpoint_url,
             cluster::matter_controller::attribute::authorized_attribute_update(endpoint_id, false);
         }
         ret = ESP_FAIL;
-        goto close;
+        goto cleanup;
     }
 
     // Read the http response
     if (read_node_list(client, &new_device_list) == ESP_OK) {
         scoped_device_mgr_lock dev_mgr_lock;
-        free_device_list(s_matter_device_list);
-        s_matter_device_list = new_device_list;
+        merge_device_list(new_device_list);
+        strncpy(s_node_list_etag, s_received_etag, sizeof(s_node_list_etag));
+        strncpy(s_node_list_etag_group_id, rainmaker_group_id.Get(), sizeof(s_node_list_etag_group_id) - 1);
     } else {
         free_device_list(new_device_list);
     }
 
-close:
-    esp_http_client_close(client);
 cleanup:
-    esp_http_client_cleanup(client);
+    http_client::release(client);
     return ret;
 }
 
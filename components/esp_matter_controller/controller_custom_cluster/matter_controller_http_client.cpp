@@ -0,0 +1,111 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_crt_bundle.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <matter_controller_http_client.h>
+
+#define TAG "controller_http_client"
+
+namespace esp_matter {
+namespace controller {
+namespace http_client {
+
+/* Large enough for the biggest request, the node metadata response and the user NOC request */
+#define HTTP_CLIENT_RX_BUFFER_SIZE 4096
+#define HTTP_CLIENT_TX_BUFFER_SIZE 2048
+
+static esp_http_client_handle_t s_client = NULL;
+static event_cb_t s_event_cb = NULL;
+static SemaphoreHandle_t s_client_mutex = NULL;
+static StaticSemaphore_t s_client_mutex_buffer;
+static portMUX_TYPE s_client_mutex_spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+static esp_err_t http_event_handler(esp_http_client_event_t *evt)
+{
+    return s_event_cb ? s_event_cb(evt) : ESP_OK;
+}
+
+static SemaphoreHandle_t get_client_mutex()
+{
+    portENTER_CRITICAL(&s_client_mutex_spinlock);
+    if (!s_client_mutex) {
+        s_client_mutex = xSemaphoreCreateMutexStatic(&s_client_mutex_buffer);
+    }
+    portEXIT_CRITICAL(&s_client_mutex_spinlock);
+    return s_client_mutex;
+}
+
+esp_http_client_handle_t acquire(const char *url, esp_http_client_method_t method, event_cb_t event_cb)
+{
+    if (!url) {
+        ESP_LOGE(TAG, "url cannot be NULL");
+        return NULL;
+    }
+    SemaphoreHandle_t mutex = get_client_mutex();
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    if (!s_client) {
+        esp_http_client_config_t config = {
+            .url = url,
+            .transport_type = HTTP_TRANSPORT_OVER_SSL,
+            .event_handler = http_event_handler,
+            .buffer_size = HTTP_CLIENT_RX_BUFFER_SIZE,
+            .buffer_size_tx = HTTP_CLIENT_TX_BUFFER_SIZE,
+            .skip_cert_common_name_check = false,
+            .crt_bundle_attach = esp_crt_bundle_attach,
+#if CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+            // Keep the session ticket of the last connection to resume it on the next one
+            .save_client_session = true,
+#endif
+        };
+        s_client = esp_http_client_init(&config);
+        if (!s_client) {
+            ESP_LOGE(TAG, "Failed to initialise HTTP Client.");
+            xSemaphoreGive(mutex);
+            return NULL;
+        }
+    } else if (esp_http_client_set_url(s_client, url) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set the url");
+        xSemaphoreGive(mutex);
+        return NULL;
+    }
+    // The headers are kept by the client, remove the ones which are specific to a request
+    esp_http_client_delete_header(s_client, "Authorization");
+    esp_http_client_delete_header(s_client, "Content-Type");
+    esp_http_client_delete_header(s_client, "If-None-Match");
+    if (esp_http_client_set_method(s_client, method) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set http method");
+        xSemaphoreGive(mutex);
+        return NULL;
+    }
+    s_event_cb = event_cb;
+    return s_client;
+}
+
+void release(esp_http_client_handle_t client)
+{
+    if (!client || client != s_client) {
+        return;
+    }
+    // Closing the connection keeps the TLS session saved in the client
+    esp_http_client_close(client);
+    s_event_cb = NULL;
+    xSemaphoreGive(s_client_mutex);
+}
+
+} // namespace http_client
+} // namespace controller
+} // namespace esp_matter
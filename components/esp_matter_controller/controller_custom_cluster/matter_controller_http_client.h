@@ -0,0 +1,57 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_http_client.h>
+
+namespace esp_matter {
+namespace controller {
+namespace http_client {
+
+/*
+ * Shared HTTPS client of the controller cloud requests.
+ *
+ * The requests to the RainMaker cloud are made one at a time with the same esp_http_client handle, which keeps the
+ * TLS session of the last connection, so that the next connections resume it instead of doing a full handshake.
+ * The client is owned by one request, from acquire() to release().
+ */
+
+typedef esp_err_t (*event_cb_t)(esp_http_client_event_t *evt);
+
+/**
+ * @brief Takes the shared client for a request, waiting for the current request to be released.
+ *
+ * The URL and the method of the request are set, and the Authorization, Content-Type and If-None-Match headers of the
+ * previous request are removed.
+ *
+ * @param url URL of the request
+ * @param method HTTP method of the request
+ * @param event_cb Event handler of the request, can be NULL
+ *
+ * @return The client on success, NULL otherwise
+ */
+esp_http_client_handle_t acquire(const char *url, esp_http_client_method_t method, event_cb_t event_cb = nullptr);
+
+/**
+ * @brief Releases the client taken by acquire(), closing the connection of the request.
+ *
+ * @param client Client returned by acquire(), can be NULL
+ */
+void release(esp_http_client_handle_t client);
+
+} // namespace http_client
+} // namespace controller
+} // namespace esp_matter
@@ -17,6 +17,8 @@
 #include <esp_log.h>
 #include <esp_matter_attestation_trust_store.h>
 #include <esp_spiffs.h>
+#include <esp_timer.h>
+#include <lib/support/ScopedBuffer.h>
 
 const char TAG[] = "spiffs_attestation";
 
@@ -94,42 +96,301 @@ void paa_der_cert_iterator::release()
     }
 }
 
+#define PAA_BASE_PATH "/paa"
+#define PAA_INDEX_FILE PAA_BASE_PATH "/paa_index.bin"
+#define PAA_INDEX_MAGIC 0x58444950 /* "PIDX" */
+#define PAA_INDEX_VERSION 1
+#ifdef CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_CACHE_SIZE
+#define PAA_CACHE_SIZE CONFIG_SPIFFS_ATTESTATION_TRUST_STORE_CACHE_SIZE
+#else
+#define PAA_CACHE_SIZE 0
+#endif
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entry_size;
+    uint32_t count;
+    /* Hash of the names of the certificate files, the index is rebuilt when it changes */
+    uint32_t fingerprint;
+} paa_index_header_t;
+
+static bool is_der_file(const char *filename)
+{
+    return strncmp(get_filename_extension(filename), "der", strlen("der")) == 0;
+}
+
+static uint32_t fnv1a_hash(uint32_t hash, const char *str)
+{
+    while (*str) {
+        hash = (hash ^ (uint8_t)*str++) * 16777619u;
+    }
+    return hash;
+}
+
+static int compare_index_entries(const void *a, const void *b)
+{
+    return memcmp(a, b, Crypto::kSubjectKeyIdentifierLength);
+}
+
+esp_err_t spiffs_attestation_trust_store::load_index(size_t count, uint32_t fingerprint)
+{
+    FILE *file = fopen(PAA_INDEX_FILE, "rb");
+    if (!file) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    paa_index_header_t header;
+    esp_err_t ret = ESP_OK;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != PAA_INDEX_MAGIC ||
+        header.version != PAA_INDEX_VERSION || header.entry_size != sizeof(paa_index_entry_t) ||
+        header.fingerprint != fingerprint || header.count > count) {
+        ret = ESP_ERR_INVALID_VERSION;
+    } else {
+        m_index = (paa_index_entry_t *)calloc(header.count ? header.count : 1, sizeof(paa_index_entry_t));
+        if (!m_index) {
+            ret = ESP_ERR_NO_MEM;
+        } else if (fread(m_index, sizeof(paa_index_entry_t), header.count, file) != header.count) {
+            free(m_index);
+            m_index = nullptr;
+            ret = ESP_ERR_INVALID_SIZE;
+        } else {
+            m_index_count = header.count;
+        }
+    }
+    fclose(file);
+    return ret;
+}
+
+esp_err_t spiffs_attestation_trust_store::build_index(size_t count)
+{
+    m_index = (paa_index_entry_t *)calloc(count ? count : 1, sizeof(paa_index_entry_t));
+    ESP_RETURN_ON_FALSE(m_index, ESP_ERR_NO_MEM, TAG, "Failed to allocate the PAA index");
+    m_index_count = 0;
+    DIR *dir = opendir(PAA_BASE_PATH);
+    ESP_RETURN_ON_FALSE(dir, ESP_FAIL, TAG, "Failed to open the directory");
+    paa_der_cert_t *paa_cert = (paa_der_cert_t *)calloc(1, sizeof(paa_der_cert_t));
+    if (!paa_cert) {
+        closedir(dir);
+        ESP_LOGE(TAG, "Failed to allocate the PAA certificate buffer");
+        return ESP_ERR_NO_MEM;
+    }
+    dirent *entry = NULL;
+    while ((entry = readdir(dir)) != NULL && m_index_count < count) {
+        if (!is_der_file(entry->d_name)) {
+            continue;
+        }
+        paa_index_entry_t &index_entry = m_index[m_index_count];
+        if (strlen(entry->d_name) >= sizeof(index_entry.m_filename)) {
+            ESP_LOGW(TAG, "Skip %s, the name is too long", entry->d_name);
+            continue;
+        }
+        char filename[280] = {0};
+        snprintf(filename, sizeof(filename), "%s/%s", PAA_BASE_PATH, entry->d_name);
+        FILE *file = fopen(filename, "rb");
+        if (!file) {
+            continue;
+        }
+        paa_cert->m_len = fread(paa_cert->m_buffer, sizeof(uint8_t), kMaxDERCertLength, file);
+        fclose(file);
+        MutableByteSpan skid_span{index_entry.m_skid};
+        ByteSpan der_span{paa_cert->m_buffer, paa_cert->m_len};
+        if (CHIP_NO_ERROR != Crypto::ExtractSKIDFromX509Cert(der_span, skid_span) ||
+            skid_span.size() != sizeof(index_entry.m_skid)) {
+            ESP_LOGW(TAG, "Skip %s, failed to extract the subject key ID", entry->d_name);
+            continue;
+        }
+        strcpy(index_entry.m_filename, entry->d_name);
+        m_index_count++;
+    }
+    closedir(dir);
+    free(paa_cert);
+    qsort(m_index, m_index_count, sizeof(paa_index_entry_t), compare_index_entries);
+    return ESP_OK;
+}
+
+void spiffs_attestation_trust_store::store_index(uint32_t fingerprint)
+{
+    paa_index_header_t header = {
+        .magic = PAA_INDEX_MAGIC,
+        .version = PAA_INDEX_VERSION,
+        .entry_size = sizeof(paa_index_entry_t),
+        .count = (uint32_t)m_index_count,
+        .fingerprint = fingerprint,
+    };
+    FILE *file = fopen(PAA_INDEX_FILE, "wb");
+    if (!file) {
+        ESP_LOGW(TAG, "Failed to create the PAA index file, it will be built again on the next boot");
+        return;
+    }
+    if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+        fwrite(m_index, sizeof(paa_index_entry_t), m_index_count, file) != m_index_count) {
+        ESP_LOGW(TAG, "Failed to write the PAA index file");
+        fclose(file);
+        remove(PAA_INDEX_FILE);
+        return;
+    }
+    fclose(file);
+}
+
 esp_err_t spiffs_attestation_trust_store::init()
 {
+    if (m_is_initialized) {
+        return ESP_OK;
+    }
     esp_vfs_spiffs_conf_t conf = {
-        .base_path = "/paa", .partition_label = nullptr, .max_files = 5, .format_if_mount_failed = false};
+        .base_path = PAA_BASE_PATH, .partition_label = nullptr, .max_files = 5, .format_if_mount_failed = false};
     ESP_RETURN_ON_ERROR(esp_vfs_spiffs_register(&conf), TAG, "Failed to initialize SPIFFS");
     size_t total = 0, used = 0;
     ESP_RETURN_ON_ERROR(esp_spiffs_info(conf.partition_label, &total, &used), TAG, "Failed to get SPIFFS info");
     ESP_LOGI(TAG, "Partition size: total: %d, used: %d", total, used);
+
+    // List the certificate files, without reading them, to check whether the stored index is up to date
+    size_t count = 0;
+    uint32_t fingerprint = 2166136261u;
+    DIR *dir = opendir(PAA_BASE_PATH);
+    ESP_RETURN_ON_FALSE(dir, ESP_FAIL, TAG, "Failed to open the directory");
+    dirent *entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+        if (is_der_file(entry->d_name)) {
+            fingerprint = fnv1a_hash(fingerprint, entry->d_name);
+            count++;
+        }
+    }
+    closedir(dir);
+
+    int64_t start_us = esp_timer_get_time();
+    if (load_index(count, fingerprint) == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded the index of %u PAA certificates", (unsigned)m_index_count);
+    } else {
+        ESP_RETURN_ON_ERROR(build_index(count), TAG, "Failed to build the PAA index");
+        store_index(fingerprint);
+        ESP_LOGI(TAG, "Indexed %u PAA certificates in %lld ms", (unsigned)m_index_count,
+                 (esp_timer_get_time() - start_us) / 1000);
+    }
+#if PAA_CACHE_SIZE > 0
+    m_cache = (paa_cache_entry_t *)calloc(PAA_CACHE_SIZE, sizeof(paa_cache_entry_t));
+    if (!m_cache) {
+        ESP_LOGW(TAG, "Failed to allocate the PAA certificate cache");
+    }
+#endif
     m_is_initialized = true;
     return ESP_OK;
 }
 
+const spiffs_attestation_trust_store::paa_index_entry_t *
+spiffs_attestation_trust_store::find_index_entry(const ByteSpan &skid) const
+{
+    if (skid.size() != Crypto::kSubjectKeyIdentifierLength) {
+        return nullptr;
+    }
+    size_t low = 0;
+    size_t high = m_index_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int cmp = memcmp(m_index[mid].m_skid, skid.data(), Crypto::kSubjectKeyIdentifierLength);
+        if (cmp == 0) {
+            return &m_index[mid];
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return nullptr;
+}
+
+CHIP_ERROR spiffs_attestation_trust_store::read_cert(const paa_index_entry_t &entry, paa_der_cert_t &cert) const
+{
+    char filename[280] = {0};
+    snprintf(filename, sizeof(filename), "%s/%s", PAA_BASE_PATH, entry.m_filename);
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        return CHIP_ERROR_CA_CERT_NOT_FOUND;
+    }
+    cert.m_len = fread(cert.m_buffer, sizeof(uint8_t), kMaxDERCertLength, file);
+    fclose(file);
+    // Check the certificate, in case the file was replaced after the index was built
+    uint8_t skid_buf[Crypto::kSubjectKeyIdentifierLength] = {0};
+    MutableByteSpan skid_span{skid_buf};
+    if (CHIP_NO_ERROR != Crypto::ExtractSKIDFromX509Cert(ByteSpan{cert.m_buffer, cert.m_len}, skid_span) ||
+        !ByteSpan{entry.m_skid}.data_equal(skid_span)) {
+        return CHIP_ERROR_CA_CERT_NOT_FOUND;
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR spiffs_attestation_trust_store::find_cert_without_index(const ByteSpan &skid,
+                                                                   MutableByteSpan &outPaaDerBuffer) const
+{
+    paa_der_cert_iterator iter(PAA_BASE_PATH);
+    paa_der_cert_t paa_cert;
+    while (iter.next(paa_cert)) {
+        if (paa_cert.m_len == 0) {
+            continue;
+        }
+        uint8_t skid_buf[Crypto::kSubjectKeyIdentifierLength] = {0};
+        MutableByteSpan skid_span{skid_buf};
+        if (CHIP_NO_ERROR != Crypto::ExtractSKIDFromX509Cert(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, skid_span)) {
+            continue;
+        }
+
+        if (skid.data_equal(skid_span)) {
+            return CopySpanToMutableSpan(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, outPaaDerBuffer);
+        }
+    }
+    return CHIP_ERROR_CA_CERT_NOT_FOUND;
+}
+
 CHIP_ERROR spiffs_attestation_trust_store::GetProductAttestationAuthorityCert(const ByteSpan &skid,
                                                                               MutableByteSpan &outPaaDerBuffer) const
 {
-    if (m_is_initialized) {
-        paa_der_cert_iterator iter("/paa");
-        paa_der_cert_t paa_cert;
-        while (iter.next(paa_cert)) {
-            if (paa_cert.m_len == 0) {
-                continue;
-            }
-            uint8_t skid_buf[Crypto::kSubjectKeyIdentifierLength] = {0};
-            MutableByteSpan skid_span{skid_buf};
-            if (CHIP_NO_ERROR !=
-                Crypto::ExtractSKIDFromX509Cert(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, skid_span)) {
-                continue;
+    if (!m_is_initialized) {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+    const paa_index_entry_t *index_entry = find_index_entry(skid);
+    if (!index_entry) {
+        return CHIP_ERROR_CA_CERT_NOT_FOUND;
+    }
+    paa_cache_entry_t *cache_entry = nullptr;
+#if PAA_CACHE_SIZE > 0
+    if (m_cache) {
+        paa_cache_entry_t *lru_entry = &m_cache[0];
+        for (size_t i = 0; i < PAA_CACHE_SIZE; ++i) {
+            if (m_cache[i].m_cert.m_len > 0 && skid.data_equal(ByteSpan{m_cache[i].m_skid})) {
+                m_cache[i].m_last_used = ++m_cache_clock;
+                return CopySpanToMutableSpan(ByteSpan{m_cache[i].m_cert.m_buffer, m_cache[i].m_cert.m_len},
+                                             outPaaDerBuffer);
             }
-
-            if (skid.data_equal(skid_span)) {
-                return CopySpanToMutableSpan(ByteSpan{paa_cert.m_buffer, paa_cert.m_len}, outPaaDerBuffer);
+            if (m_cache[i].m_last_used < lru_entry->m_last_used) {
+                lru_entry = &m_cache[i];
             }
         }
-        return CHIP_ERROR_CA_CERT_NOT_FOUND;
+        cache_entry = lru_entry;
+    }
+#endif
+    paa_der_cert_t *cert = cache_entry ? &cache_entry->m_cert : nullptr;
+    Platform::ScopedMemoryBuffer<paa_der_cert_t> cert_buffer;
+    if (!cert) {
+        cert_buffer.Calloc(1);
+        VerifyOrReturnError(cert_buffer.Get(), CHIP_ERROR_NO_MEMORY);
+        cert = cert_buffer.Get();
+    }
+    CHIP_ERROR err = read_cert(*index_entry, *cert);
+    if (err != CHIP_NO_ERROR) {
+        if (cache_entry) {
+            cache_entry->m_cert.m_len = 0;
+            cache_entry->m_last_used = 0;
+        }
+        // The index is out of date, look for the certificate in all the files
+        ESP_LOGW(TAG, "The PAA index is out of date, remove %s to rebuild it", PAA_INDEX_FILE);
+        return find_cert_without_index(skid, outPaaDerBuffer);
+    }
+    if (cache_entry) {
+        memcpy(cache_entry->m_skid, index_entry->m_skid, sizeof(cache_entry->m_skid));
+        cache_entry->m_last_used = ++m_cache_clock;
     }
-    return CHIP_ERROR_INCORRECT_STATE;
+    return CopySpanToMutableSpan(ByteSpan{cert->m_buffer, cert->m_len}, outPaaDerBuffer);
 }
 
 const AttestationTrustStore *get_attestation_trust_store()
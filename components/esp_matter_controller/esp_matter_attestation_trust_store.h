@@ -19,6 +19,7 @@
 #include <dirent.h>
 #include <esp_err.h>
 #include <lib/support/IntrusiveList.h>
+#include <sdkconfig.h>
 
 namespace chip {
 namespace Credentials {
@@ -43,6 +44,13 @@ private:
     size_t m_index = 0;
 };
 
+/*
+ * PAA trust store reading the DER certificates of the SPIFFS partition.
+ *
+ * An index of the subject key IDs of the certificates is built by init() and stored in the partition, next to the
+ * certificates, so that it is only rebuilt when the set of certificate files changes. A lookup searches the index
+ * and reads a single certificate, and the last used certificates are kept in a RAM cache.
+ */
 class spiffs_attestation_trust_store : public AttestationTrustStore {
 public:
     spiffs_attestation_trust_store(spiffs_attestation_trust_store &other) = delete;
@@ -60,7 +68,30 @@ public:
     esp_err_t init();
 
 private:
+    typedef struct {
+        uint8_t m_skid[Crypto::kSubjectKeyIdentifierLength];
+        char m_filename[CONFIG_SPIFFS_OBJ_NAME_LEN];
+    } paa_index_entry_t;
+
+    typedef struct {
+        uint8_t m_skid[Crypto::kSubjectKeyIdentifierLength];
+        uint32_t m_last_used;
+        paa_der_cert_t m_cert;
+    } paa_cache_entry_t;
+
+    esp_err_t load_index(size_t count, uint32_t fingerprint);
+    esp_err_t build_index(size_t count);
+    void store_index(uint32_t fingerprint);
+    const paa_index_entry_t *find_index_entry(const ByteSpan &skid) const;
+    CHIP_ERROR read_cert(const paa_index_entry_t &entry, paa_der_cert_t &cert) const;
+    CHIP_ERROR find_cert_without_index(const ByteSpan &skid, MutableByteSpan &outPaaDerBuffer) const;
+
     bool m_is_initialized = false;
+    /* Index entries, sorted by subject key ID */
+    paa_index_entry_t *m_index = nullptr;
+    size_t m_index_count = 0;
+    mutable paa_cache_entry_t *m_cache = nullptr;
+    mutable uint32_t m_cache_clock = 0;
     spiffs_attestation_trust_store() {}
 };
 
@@ -44,30 +44,41 @@ using namespace chip::Controller;
 using namespace chip::Messaging;
 using namespace esp_matter::controller;
 
+/* With CONFIG_ESP_MATTER_CONTROLLER_STORAGE_CACHE_ENABLE, the controller data goes through the storage of the server,
+ * which is wrapped by the storage cache. The controller shares the fabric table and the group keys of the fabrics
+ * with the server, so a single cache keeps both views of these keys coherent. */
 class ControllerServerStorageDelegate : public PersistentStorageDelegate {
     CHIP_ERROR SyncGetKeyValue(const char *key, void *buffer, uint16_t &size) override
     {
-        ChipLogProgress(AppServer, "Retrieving value from controller server storage.");
+        ChipLogDetail(AppServer, "Retrieving %s from controller server storage", key);
+#if CONFIG_ESP_MATTER_CONTROLLER_STORAGE_CACHE_ENABLE
+        return Server::GetInstance().GetPersistentStorage().SyncGetKeyValue(key, buffer, size);
+#else
         size_t bytesRead = 0;
         CHIP_ERROR err = PersistedStorage::KeyValueStoreMgr().Get(key, buffer, size, &bytesRead);
-
-        if (err == CHIP_NO_ERROR) {
-            ChipLogProgress(AppServer, "Retrieved value from server storage.");
-        }
         size = static_cast<uint16_t>(bytesRead);
         return err;
+#endif
     }
 
     CHIP_ERROR SyncSetKeyValue(const char *key, const void *value, uint16_t size) override
     {
-        ChipLogProgress(AppServer, "Stored value in server storage");
+        ChipLogDetail(AppServer, "Storing %s in controller server storage", key);
+#if CONFIG_ESP_MATTER_CONTROLLER_STORAGE_CACHE_ENABLE
+        return Server::GetInstance().GetPersistentStorage().SyncSetKeyValue(key, value, size);
+#else
         return PersistedStorage::KeyValueStoreMgr().Put(key, value, size);
+#endif
     }
 
     CHIP_ERROR SyncDeleteKeyValue(const char *key) override
     {
-        ChipLogProgress(AppServer, "Delete value in server storage");
+        ChipLogDetail(AppServer, "Deleting %s in controller server storage", key);
+#if CONFIG_ESP_MATTER_CONTROLLER_STORAGE_CACHE_ENABLE
+        return Server::GetInstance().GetPersistentStorage().SyncDeleteKeyValue(key);
+#else
         return PersistedStorage::KeyValueStoreMgr().Delete(key);
+#endif
     }
 };
 
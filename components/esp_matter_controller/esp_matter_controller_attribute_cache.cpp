@@ -0,0 +1,204 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter_controller_attribute_cache.h>
+#include <esp_timer.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <new>
+
+using chip::app::AttributePathParams;
+using chip::app::ConcreteAttributePath;
+using chip::app::ConcreteDataAttributePath;
+
+static const char *TAG = "attribute_cache";
+
+namespace esp_matter {
+namespace controller {
+namespace attribute_cache {
+
+static constexpr size_t k_max_size = CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_SIZE;
+static constexpr size_t k_max_value_size = CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_MAX_VALUE_SIZE;
+
+typedef struct entry {
+    struct entry *next;
+    uint64_t node_id;
+    ConcreteAttributePath path;
+    chip::Optional<chip::DataVersion> version;
+    int64_t valid_until_us;
+    int64_t last_used_us;
+    uint16_t size;
+    /* The value follows the entry in the same allocation */
+    uint8_t *data;
+} entry_t;
+
+static entry_t *s_entries = nullptr;
+static stats_t s_stats = {};
+/* The values are copied here first to get their size. Only used in the Matter context. */
+static uint8_t s_scratch[k_max_value_size];
+
+static entry_t **find_link(uint64_t node_id, const ConcreteAttributePath &path)
+{
+    entry_t **link = &s_entries;
+    while (*link && !((*link)->node_id == node_id && (*link)->path == path)) {
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+static void remove_entry(entry_t **link)
+{
+    entry_t *entry = *link;
+    *link = entry->next;
+    s_stats.entry_count--;
+    s_stats.size -= entry->size;
+    chip::Platform::MemoryFree(entry);
+}
+
+static void evict_until_fits(size_t size)
+{
+    while (s_entries && s_stats.size + size > k_max_size) {
+        entry_t **oldest = &s_entries;
+        for (entry_t **link = &s_entries; *link; link = &(*link)->next) {
+            if ((*link)->last_used_us < (*oldest)->last_used_us) {
+                oldest = link;
+            }
+        }
+        remove_entry(oldest);
+        s_stats.evictions++;
+    }
+}
+
+void store(uint64_t node_id, const ConcreteDataAttributePath &path, chip::TLV::TLVReader *data, uint32_t valid_ms)
+{
+    entry_t **link = find_link(node_id, path);
+    if (*link) {
+        remove_entry(link);
+    }
+    if (path.IsListItemOperation() || !data) {
+        return;
+    }
+    chip::TLV::TLVReader reader;
+    reader.Init(*data);
+    chip::TLV::TLVWriter writer;
+    writer.Init(s_scratch, sizeof(s_scratch));
+    if (writer.CopyElement(chip::TLV::AnonymousTag(), reader) != CHIP_NO_ERROR || writer.Finalize() != CHIP_NO_ERROR) {
+        ESP_LOGD(TAG, "Value of attribute 0x%" PRIx32 " too large to be cached", path.mAttributeId);
+        return;
+    }
+    size_t size = writer.GetLengthWritten();
+    evict_until_fits(size);
+    entry_t *entry = (entry_t *)chip::Platform::MemoryAlloc(sizeof(entry_t) + size);
+    if (!entry) {
+        return;
+    }
+    new (entry) entry_t();
+    entry->node_id = node_id;
+    entry->path = path;
+    entry->version = path.mDataVersion;
+    entry->last_used_us = esp_timer_get_time();
+    entry->valid_until_us = entry->last_used_us + (int64_t)valid_ms * 1000;
+    entry->size = size;
+    entry->data = (uint8_t *)(entry + 1);
+    memcpy(entry->data, s_scratch, size);
+    entry->next = s_entries;
+    s_entries = entry;
+    s_stats.entry_count++;
+    s_stats.size += size;
+}
+
+static bool matches(const AttributePathParams &params, const ConcreteAttributePath &path)
+{
+    return (params.HasWildcardEndpointId() || params.mEndpointId == path.mEndpointId) &&
+        (params.HasWildcardClusterId() || params.mClusterId == path.mClusterId) &&
+        (params.HasWildcardAttributeId() || params.mAttributeId == path.mAttributeId);
+}
+
+void refresh(uint64_t node_id, const AttributePathParams *paths, size_t count, uint32_t valid_ms)
+{
+    int64_t valid_until_us = esp_timer_get_time() + (int64_t)valid_ms * 1000;
+    for (entry_t *entry = s_entries; entry; entry = entry->next) {
+        if (entry->node_id != node_id || entry->valid_until_us >= valid_until_us) {
+            continue;
+        }
+        for (size_t index = 0; index < count; index++) {
+            if (matches(paths[index], entry->path)) {
+                entry->valid_until_us = valid_until_us;
+                break;
+            }
+        }
+    }
+}
+
+esp_err_t get(uint64_t node_id, const ConcreteAttributePath &path, chip::TLV::TLVReader &reader,
+              chip::Optional<chip::DataVersion> *version)
+{
+    entry_t *entry = *find_link(node_id, path);
+    int64_t now_us = esp_timer_get_time();
+    if (!entry || entry->valid_until_us < now_us) {
+        s_stats.misses++;
+        return ESP_ERR_NOT_FOUND;
+    }
+    reader.Init(entry->data, entry->size);
+    if (reader.Next() != CHIP_NO_ERROR) {
+        s_stats.misses++;
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (version) {
+        *version = entry->version;
+    }
+    entry->last_used_us = now_us;
+    s_stats.hits++;
+    return ESP_OK;
+}
+
+esp_err_t get_version(uint64_t node_id, const ConcreteAttributePath &path, chip::DataVersion &version)
+{
+    entry_t *entry = *find_link(node_id, path);
+    if (!entry || !entry->version.HasValue()) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    version = entry->version.Value();
+    return ESP_OK;
+}
+
+void invalidate(uint64_t node_id, const ConcreteAttributePath &path)
+{
+    entry_t **link = find_link(node_id, path);
+    if (*link) {
+        remove_entry(link);
+    }
+}
+
+void invalidate_node(uint64_t node_id)
+{
+    entry_t **link = &s_entries;
+    while (*link) {
+        if ((*link)->node_id == node_id) {
+            remove_entry(link);
+        } else {
+            link = &(*link)->next;
+        }
+    }
+}
+
+void get_stats(stats_t *stats)
+{
+    *stats = s_stats;
+}
+
+} // namespace attribute_cache
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,135 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <esp_err.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/TLVReader.h>
+#include <sdkconfig.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace controller {
+namespace attribute_cache {
+
+/*
+ * Controller attribute cache.
+ *
+ * The cache keeps the TLV encoded attribute values received by the read and subscribe commands, keyed by node,
+ * endpoint, cluster and attribute, with the data version of their cluster. A value is fresh for
+ * CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_MAX_AGE seconds after a read, and for the max interval of the
+ * subscription after each report of a subscription covering it. The read commands serve the fresh values locally,
+ * and send DataVersionFilters for the clusters whose values are cached but stale, so that the unchanged clusters are
+ * not sent again. When the cache is full, the least recently used values are dropped.
+ *
+ * All the functions must be called in the Matter context, or with the Matter stack lock held.
+ */
+
+typedef struct {
+    uint32_t entry_count;
+    /* Bytes used by the cached values */
+    uint32_t size;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+} stats_t;
+
+#if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+/**
+ * @brief Stores an attribute value. The list item operations of the chunked reports invalidate the value instead,
+ * since only the full value of a list is cached.
+ *
+ * @param node_id  Remote node ID
+ * @param path     Attribute path, with the data version of the cluster
+ * @param data     Attribute value, positioned on the element
+ * @param valid_ms Time during which the value is fresh
+ */
+void store(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data,
+           uint32_t valid_ms);
+
+/**
+ * @brief Extends the freshness of the cached values matching the paths, which are known to be unchanged.
+ *
+ * @param node_id  Remote node ID
+ * @param paths    Attribute paths, can include wildcards
+ * @param count    Number of paths
+ * @param valid_ms Time during which the values are fresh
+ */
+void refresh(uint64_t node_id, const chip::app::AttributePathParams *paths, size_t count, uint32_t valid_ms);
+
+/**
+ * @brief Gets a fresh attribute value. The reader is valid until the cache is modified.
+ *
+ * @param node_id Remote node ID
+ * @param path    Attribute path
+ * @param reader  Reader positioned on the value
+ * @param version Data version of the cluster when the value was received, can be NULL
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the value is not cached or not fresh
+ */
+esp_err_t get(uint64_t node_id, const chip::app::ConcreteAttributePath &path, chip::TLV::TLVReader &reader,
+              chip::Optional<chip::DataVersion> *version);
+
+/**
+ * @brief Gets the data version of a cached value, fresh or not.
+ *
+ * @param node_id Remote node ID
+ * @param path    Attribute path
+ * @param version Data version of the cluster when the value was received
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the value or its version is not cached
+ */
+esp_err_t get_version(uint64_t node_id, const chip::app::ConcreteAttributePath &path, chip::DataVersion &version);
+
+/**
+ * @brief Drops a cached value.
+ *
+ * @param node_id Remote node ID
+ * @param path    Attribute path
+ */
+void invalidate(uint64_t node_id, const chip::app::ConcreteAttributePath &path);
+
+/**
+ * @brief Drops the cached values of a node.
+ *
+ * @param node_id Remote node ID
+ */
+void invalidate_node(uint64_t node_id);
+
+/**
+ * @brief Gets the cache statistics.
+ *
+ * @param stats Statistics
+ */
+void get_stats(stats_t *stats);
+#else
+inline void store(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data,
+                  uint32_t valid_ms) {}
+inline void refresh(uint64_t node_id, const chip::app::AttributePathParams *paths, size_t count, uint32_t valid_ms) {}
+inline esp_err_t get(uint64_t node_id, const chip::app::ConcreteAttributePath &path, chip::TLV::TLVReader &reader,
+                     chip::Optional<chip::DataVersion> *version) { return ESP_ERR_NOT_FOUND; }
+inline esp_err_t get_version(uint64_t node_id, const chip::app::ConcreteAttributePath &path,
+                             chip::DataVersion &version) { return ESP_ERR_NOT_FOUND; }
+inline void invalidate(uint64_t node_id, const chip::app::ConcreteAttributePath &path) {}
+inline void invalidate_node(uint64_t node_id) {}
+inline void get_stats(stats_t *stats) { *stats = {}; }
+#endif // CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+
+} // namespace attribute_cache
+} // namespace controller
+} // namespace esp_matter
@@ -12,7 +12,6 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <DataModelLogger.h>
 #include <controller/CommissioneeDeviceProxy.h>
 #if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
 #include <esp_matter_commissioner.h>
@@ -21,9 +20,11 @@
 #endif
 #include <esp_check.h>
 #include <esp_matter_controller_cluster_command.h>
+#include <esp_matter_controller_response_decoder.h>
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_mem.h>
 #include <json_parser.h>
+#include <json_to_tlv.h>
 
 #include <crypto/CHIPCryptoPAL.h>
 #include <setup_payload/ManualSetupPayloadGenerator.h>
@@ -36,118 +37,10 @@ static const char *TAG = "cluster_command";
 
 namespace esp_matter {
 
-namespace cluster {
-
-template <typename CommandResponseObjectT>
-esp_err_t decode_command_response(const ConcreteCommandPath &command_path, TLVReader *reader)
-{
-    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "reader cannot be NULL");
-    ESP_RETURN_ON_FALSE(command_path.mClusterId == CommandResponseObjectT::GetClusterId() &&
-                            command_path.mCommandId == CommandResponseObjectT::GetCommandId(),
-                        ESP_ERR_INVALID_ARG, TAG, "Wrong command to decode");
-    CommandResponseObjectT response;
-    ESP_RETURN_ON_FALSE(chip::app::DataModel::Decode(*reader, response) == CHIP_NO_ERROR, ESP_FAIL, TAG,
-                        "Failed to decode response ");
-    char header[64] = {0};
-    snprintf(header, 64, "cluster-0x%" PRIX32 ", command-0x%" PRIX32 " response:", command_path.mClusterId,
-             command_path.mCommandId);
-    DataModelLogger::LogValue(header, 1, response);
-    return ESP_OK;
-}
-
-namespace group_key_management {
-namespace command {
-
-void decode_response(const ConcreteCommandPath &command_path, TLVReader *reader)
-{
-    if (command_path.mCommandId == GroupKeyManagement::Commands::KeySetReadResponse::Id) {
-        decode_command_response<GroupKeyManagement::Commands::KeySetRead::Type::ResponseType>(command_path, reader);
-    }
-}
-
-} // namespace command
-} // namespace group_key_management
-
-namespace groups {
-namespace command {
-
-void decode_response(const ConcreteCommandPath &command_path, TLVReader *reader)
-{
-    if (command_path.mCommandId == Groups::Commands::AddGroupResponse::Id) {
-        decode_command_response<Groups::Commands::AddGroup::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == Groups::Commands::ViewGroupResponse::Id) {
-        decode_command_response<Groups::Commands::ViewGroup::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == Groups::Commands::RemoveGroupResponse::Id) {
-        decode_command_response<Groups::Commands::RemoveGroup::Type::ResponseType>(command_path, reader);
-    }
-}
-
-} // namespace command
-} // namespace groups
-
-namespace scenes_management {
-namespace command {
-
-void decode_response(const ConcreteCommandPath &command_path, TLVReader *reader)
-{
-    if (command_path.mCommandId == ScenesManagement::Commands::AddSceneResponse::Id) {
-        decode_command_response<ScenesManagement::Commands::AddScene::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == ScenesManagement::Commands::ViewSceneResponse::Id) {
-        decode_command_response<ScenesManagement::Commands::ViewScene::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == ScenesManagement::Commands::RemoveSceneResponse::Id) {
-        decode_command_response<ScenesManagement::Commands::RemoveScene::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == ScenesManagement::Commands::RemoveAllScenesResponse::Id) {
-        decode_command_response<ScenesManagement::Commands::RemoveAllScenes::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == ScenesManagement::Commands::StoreSceneResponse::Id) {
-        decode_command_response<ScenesManagement::Commands::StoreScene::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == ScenesManagement::Commands::GetSceneMembershipResponse::Id) {
-        decode_command_response<ScenesManagement::Commands::GetSceneMembership::Type::ResponseType>(command_path, reader);
-    }
-}
-
-} // namespace command
-} // namespace scenes_management
-
-namespace thermostat {
-namespace command {
-
-void decode_response(const ConcreteCommandPath &command_path, TLVReader *reader)
-{
-    if (command_path.mCommandId == Thermostat::Commands::GetWeeklyScheduleResponse::Id) {
-        decode_command_response<Thermostat::Commands::GetWeeklySchedule::Type::ResponseType>(command_path, reader);
-    }
-}
-
-} // namespace command
-} // namespace thermostat
-
-namespace door_lock {
-namespace command {
-
-void decode_response(const ConcreteCommandPath &command_path, TLVReader *reader)
-{
-    if (command_path.mCommandId == DoorLock::Commands::GetWeekDayScheduleResponse::Id) {
-        decode_command_response<DoorLock::Commands::GetWeekDaySchedule::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == DoorLock::Commands::GetYearDayScheduleResponse::Id) {
-        decode_command_response<DoorLock::Commands::GetYearDaySchedule::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == DoorLock::Commands::GetHolidayScheduleResponse::Id) {
-        decode_command_response<DoorLock::Commands::GetHolidaySchedule::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == DoorLock::Commands::GetUserResponse::Id) {
-        decode_command_response<DoorLock::Commands::GetUser::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == DoorLock::Commands::SetCredentialResponse::Id) {
-        decode_command_response<DoorLock::Commands::SetCredential::Type::ResponseType>(command_path, reader);
-    } else if (command_path.mCommandId == DoorLock::Commands::GetCredentialStatusResponse::Id) {
-        decode_command_response<DoorLock::Commands::GetCredentialStatus::Type::ResponseType>(command_path, reader);
-    }
-}
-
-} // namespace command
-} // namespace door_lock
-
-} // namespace cluster
-
 namespace controller {
 
+command_pool::pool<cluster_command> cluster_command::s_pool;
+
 void cluster_command::on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                               const SessionHandle &sessionHandle)
 {
@@ -155,16 +48,19 @@ void cluster_command::on_device_connected_fcn(void *context, ExchangeManager &ex
     chip::OperationalDeviceProxy device_proxy(&exchangeMgr, sessionHandle);
     chip::app::CommandPathParams command_path = {cmd->m_endpoint_id, 0, cmd->m_cluster_id, cmd->m_command_id,
                                                  chip::app::CommandPathFlags::kEndpointIdValid};
-    custom::command::send_command(context, &device_proxy, command_path, cmd->m_command_data_field, cmd->on_success_cb,
-                                  cmd->on_error_cb, chip::NullOptional);
-    chip::Platform::Delete(cmd);
+    TLVReader reader;
+    if (cmd->init_command_data_reader(reader) == ESP_OK) {
+        custom::command::send_command(context, &device_proxy, command_path, reader, cmd->on_success_cb,
+                                      cmd->on_error_cb, chip::NullOptional);
+    }
+    cluster_command::destroy(cmd);
     return;
 }
 
 void cluster_command::on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
 {
     cluster_command *cmd = reinterpret_cast<cluster_command *>(context);
-    chip::Platform::Delete(cmd);
+    cluster_command::destroy(cmd);
     return;
 }
 
@@ -172,31 +68,14 @@ void cluster_command::default_success_fcn(void *ctx, const ConcreteCommandPath &
                                           TLVReader *response_data)
 {
     ESP_LOGI(TAG, "Send command success");
-    ESP_LOGI(TAG,
-             "Some commands of specific clusters will have a reponse which is not NullObject, so we need to handle the "
-             "response data for those commands. Here we print the reponse data.");
-    ESP_LOGI(TAG,
-             "If your command's reponse is not printed here, please register another success callback when creating "
-             "the cluster_command object to handle the reponse data.");
-    switch (command_path.mClusterId) {
-    case GroupKeyManagement::Id:
-        cluster::group_key_management::command::decode_response(command_path, response_data);
-        break;
-    case Groups::Id:
-        cluster::groups::command::decode_response(command_path, response_data);
-        break;
-    case ScenesManagement::Id:
-        cluster::scenes_management::command::decode_response(command_path, response_data);
-        break;
-    case Thermostat::Id:
-        cluster::thermostat::command::decode_response(command_path, response_data);
-        break;
-    case DoorLock::Id:
-        cluster::door_lock::command::decode_response(command_path, response_data);
-        break;
-    default:
-        break;
+    /* Commands without response data have a NULL reader */
+    if (!response_data) {
+        return;
     }
+    const char *name = response_decoder::get_command_name(command_path.mClusterId, command_path.mCommandId);
+    ESP_LOGI(TAG, "cluster-0x%" PRIX32 ", command-0x%" PRIX32 " %s response:", command_path.mClusterId,
+             command_path.mCommandId, name ? name : "");
+    response_decoder::decode_with_default_cb(command_path, response_data);
 }
 
 void cluster_command::default_error_fcn(void *ctx, CHIP_ERROR error)
@@ -204,28 +83,81 @@ void cluster_command::default_error_fcn(void *ctx, CHIP_ERROR error)
     ESP_LOGI(TAG, "Send command failure: err :%" CHIP_ERROR_FORMAT, error.Format());
 }
 
+static uint8_t get_group_fabric_index()
+{
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    return commissioner::get_device_commissioner()->GetFabricIndex();
+#else
+    return get_fabric_index();
+#endif
+}
+
 esp_err_t cluster_command::dispatch_group_command(void *context)
 {
     esp_err_t err = ESP_OK;
     cluster_command *cmd = reinterpret_cast<cluster_command *>(context);
     uint16_t group_id = cmd->m_destination_id & 0xFFFF;
-#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
-    uint8_t fabric_index = commissioner::get_device_commissioner()->GetFabricIndex();
-#else
-    uint8_t fabric_index = get_fabric_index();
-#endif
+    uint8_t fabric_index = get_group_fabric_index();
     chip::app::CommandPathParams command_path = {cmd->m_endpoint_id, group_id, cmd->m_cluster_id, cmd->m_command_id,
                                                  chip::app::CommandPathFlags::kGroupIdValid};
-    err = custom::command::send_group_command(fabric_index, command_path, cmd->m_command_data_field);
-    chip::Platform::Delete(cmd);
+    TLVReader reader;
+    err = cmd->init_command_data_reader(reader);
+    if (err == ESP_OK) {
+        err = custom::command::send_group_command(fabric_index, command_path, reader);
+    }
+    cluster_command::destroy(cmd);
     return err;
 }
 
+esp_err_t cluster_command::init_command_data_reader(TLVReader &reader)
+{
+    reader.Init(m_encoded_buf, m_encoded_len);
+    if (reader.Next() != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to read the encoded command data");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void cluster_command::on_encode_buffer_ready(void *ctx, uint8_t *buf, size_t buf_size)
+{
+    cluster_command *cmd = reinterpret_cast<cluster_command *>(ctx);
+    chip::TLV::TLVWriter writer;
+    cmd->m_encoded_buf = buf;
+    writer.Init(buf, buf_size);
+    if (json_to_tlv(cmd->m_command_data_field, writer, chip::TLV::AnonymousTag()) != ESP_OK ||
+        writer.Finalize() != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to convert json string to TLV");
+        if (cmd->on_error_cb) {
+            cmd->on_error_cb(cmd, CHIP_ERROR_INVALID_ARGUMENT);
+        }
+        cluster_command::destroy(cmd);
+        return;
+    }
+    cmd->m_encoded_len = writer.GetLengthWritten();
+    if (cmd->is_group_command()) {
+        dispatch_group_command(cmd);
+        return;
+    }
+    /* The command is deleted if connect() fails */
+    custom_command_callback::on_error_callback_t on_error = cmd->on_error_cb;
+    if (cmd->connect() != ESP_OK && on_error) {
+        on_error(nullptr, CHIP_ERROR_NOT_CONNECTED);
+    }
+}
+
 esp_err_t cluster_command::send_command()
 {
-    if (is_group_command()) {
-        return dispatch_group_command(reinterpret_cast<void *>(this));
+    /* The command data is encoded once a buffer of the pool is available, which may be later if all are in use */
+    esp_err_t err = encode_buffer_pool::acquire(on_encode_buffer_ready, this);
+    if (err != ESP_OK) {
+        destroy(this);
     }
+    return err;
+}
+
+esp_err_t cluster_command::connect()
+{
 #if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
     if (CHIP_NO_ERROR ==
         commissioner::get_device_commissioner()->GetConnectedDevice(m_destination_id, &on_device_connected_cb,
@@ -238,7 +170,7 @@ esp_err_t cluster_command::send_command()
                                                             &on_device_connected_cb, &on_device_connection_failure_cb);
     return ESP_OK;
 #endif
-    chip::Platform::Delete(this);
+    destroy(this);
     return ESP_FAIL;
 }
 
@@ -250,7 +182,7 @@ esp_err_t send_invoke_cluster_command(uint64_t destination_id, uint16_t endpoint
         return ESP_ERR_INVALID_ARG;
     }
     cluster_command *cmd =
-        chip::Platform::New<cluster_command>(destination_id, endpoint_id, cluster_id, command_id, command_data_field);
+        cluster_command::create(destination_id, endpoint_id, cluster_id, command_id, command_data_field);
     if (!cmd) {
         ESP_LOGE(TAG, "Failed to alloc memory for cluster_command");
         return ESP_ERR_NO_MEM;
@@ -259,5 +191,99 @@ esp_err_t send_invoke_cluster_command(uint64_t destination_id, uint16_t endpoint
     return cmd->send_command();
 }
 
+/* Multi-group dispatch, allocated with the copies of its command data fields */
+typedef struct {
+    size_t count;
+    size_t next;
+    size_t sent;
+    size_t failed;
+    uint32_t interval_ms;
+    group_commands_done_cb_t done_cb;
+    void *ctx;
+    group_command_t *commands;
+} group_fan_out_t;
+
+static void group_fan_out_send_next(chip::System::Layer *layer, void *context)
+{
+    group_fan_out_t *fan_out = static_cast<group_fan_out_t *>(context);
+    uint8_t fabric_index = get_group_fabric_index();
+    /* Without pacing, all the commands are sent in this call */
+    do {
+        const group_command_t &command = fan_out->commands[fan_out->next++];
+        chip::app::CommandPathParams command_path = {0, command.group_id, command.cluster_id, command.command_id,
+                                                     chip::app::CommandPathFlags::kGroupIdValid};
+        if (custom::command::send_group_command(fabric_index, command_path, command.command_data_field) == ESP_OK) {
+            fan_out->sent++;
+        } else {
+            ESP_LOGE(TAG, "Failed to send command 0x%" PRIx32 " to group 0x%04x", command.command_id,
+                     command.group_id);
+            fan_out->failed++;
+        }
+    } while (fan_out->interval_ms == 0 && fan_out->next < fan_out->count);
+
+    if (fan_out->next < fan_out->count &&
+        chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(fan_out->interval_ms),
+                                                    group_fan_out_send_next, fan_out) == CHIP_NO_ERROR) {
+        return;
+    }
+    if (fan_out->next < fan_out->count) {
+        ESP_LOGE(TAG, "Failed to start the group fan-out timer");
+        fan_out->failed += fan_out->count - fan_out->next;
+    }
+    ESP_LOGI(TAG, "Group fan-out done, %u sent, %u failed", (unsigned)fan_out->sent, (unsigned)fan_out->failed);
+    if (fan_out->done_cb) {
+        fan_out->done_cb(fan_out->sent, fan_out->failed, fan_out->ctx);
+    }
+    esp_matter_mem_free(fan_out);
+}
+
+static void group_fan_out_start(intptr_t context)
+{
+    group_fan_out_send_next(&chip::DeviceLayer::SystemLayer(), reinterpret_cast<void *>(context));
+}
+
+esp_err_t send_invoke_group_commands(const group_command_t *commands, size_t count, uint32_t interval_ms,
+                                     group_commands_done_cb_t done_cb, void *ctx)
+{
+    ESP_RETURN_ON_FALSE(commands && count > 0, ESP_ERR_INVALID_ARG, TAG, "The command list cannot be empty");
+    size_t strings_size = 0;
+    for (size_t idx = 0; idx < count; ++idx) {
+        const char *data = commands[idx].command_data_field ? commands[idx].command_data_field
+                                                            : k_empty_command_data_field;
+        ESP_RETURN_ON_FALSE(strlen(data) < k_command_data_field_buffer_size, ESP_ERR_INVALID_ARG, TAG,
+                            "The command data field of group 0x%04x is too long", commands[idx].group_id);
+        ESP_RETURN_ON_FALSE(commands[idx].group_id != chip::kUndefinedGroupId, ESP_ERR_INVALID_ARG, TAG,
+                            "Invalid group id");
+        strings_size += strlen(data) + 1;
+    }
+    /* One allocation holds the dispatch, the commands and their data fields */
+    size_t commands_offset = sizeof(group_fan_out_t);
+    size_t strings_offset = commands_offset + count * sizeof(group_command_t);
+    uint8_t *block = (uint8_t *)esp_matter_mem_calloc(1, strings_offset + strings_size);
+    ESP_RETURN_ON_FALSE(block, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the group fan-out");
+    group_fan_out_t *fan_out = reinterpret_cast<group_fan_out_t *>(block);
+    fan_out->count = count;
+    fan_out->interval_ms = interval_ms;
+    fan_out->done_cb = done_cb;
+    fan_out->ctx = ctx;
+    fan_out->commands = reinterpret_cast<group_command_t *>(block + commands_offset);
+    char *strings = reinterpret_cast<char *>(block + strings_offset);
+    for (size_t idx = 0; idx < count; ++idx) {
+        const char *data = commands[idx].command_data_field ? commands[idx].command_data_field
+                                                            : k_empty_command_data_field;
+        fan_out->commands[idx] = commands[idx];
+        strcpy(strings, data);
+        fan_out->commands[idx].command_data_field = strings;
+        strings += strlen(data) + 1;
+    }
+    if (chip::DeviceLayer::PlatformMgr().ScheduleWork(group_fan_out_start, reinterpret_cast<intptr_t>(fan_out)) !=
+        CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to schedule the group fan-out");
+        esp_matter_mem_free(fan_out);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
 } // namespace controller
 } // namespace esp_matter
@@ -17,6 +17,8 @@
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_matter.h>
 #include <esp_matter_client.h>
+#include <esp_matter_controller_command_pool.h>
+#include <esp_matter_controller_encode_buffer_pool.h>
 #include <esp_matter_mem.h>
 
 namespace esp_matter {
@@ -58,19 +60,43 @@ public:
         }
     }
 
-    ~cluster_command() {}
+    ~cluster_command() { encode_buffer_pool::release(m_encoded_buf); }
+
+    /**
+     * @brief Creates a command, from the pool of the cluster_command objects when one is free.
+     */
+    template <typename... Args>
+    static cluster_command *create(Args &&...args)
+    {
+        return s_pool.create(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys a command created with create().
+     */
+    static void destroy(cluster_command *cmd) { s_pool.destroy(cmd); }
+
+    static const command_pool::stats_t &get_pool_stats() { return s_pool.get_stats(); }
 
     esp_err_t send_command();
 
     bool is_group_command() { return chip::IsGroupId(m_destination_id); }
 
 private:
+    static command_pool::pool<cluster_command> s_pool;
     uint64_t m_destination_id;
     uint16_t m_endpoint_id;
     uint32_t m_cluster_id;
     uint32_t m_command_id;
     char m_command_data_field[k_command_data_field_buffer_size];
+    /* Encoded command data, in a buffer of the encode buffer pool */
+    uint8_t *m_encoded_buf = nullptr;
+    size_t m_encoded_len = 0;
+
+    esp_err_t init_command_data_reader(TLVReader &reader);
+    esp_err_t connect();
 
+    static void on_encode_buffer_ready(void *ctx, uint8_t *buf, size_t buf_size);
     static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                         const SessionHandle &sessionHandle);
     static void on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error);
@@ -92,5 +118,41 @@ private:
 esp_err_t send_invoke_cluster_command(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
                                       const char *command_data_field);
 
+/** Command of a multi-group dispatch */
+typedef struct {
+    uint16_t group_id;
+    uint32_t cluster_id;
+    uint32_t command_id;
+    /* JSON object of the command data fields, NULL for a command without field */
+    const char *command_data_field;
+} group_command_t;
+
+/**
+ * @brief Called from the Matter task once all the commands of a multi-group dispatch were sent.
+ *
+ * @param sent Commands sent
+ * @param failed Commands which could not be sent
+ * @param ctx Context given to send_invoke_group_commands()
+ */
+using group_commands_done_cb_t = void (*)(size_t sent, size_t failed, void *ctx);
+
+/**
+ * @brief Sends a list of group commands, paced in one pass of the Matter task.
+ *
+ * The commands are copied and sent in the order of the list, one every interval_ms, so the group message counter of
+ * the fabric increases in the order the members receive them. The function returns once the dispatch is scheduled.
+ *
+ * @param commands Commands to send
+ * @param count Number of commands
+ * @param interval_ms Time between two commands, CONFIG_ESP_MATTER_CONTROLLER_GROUP_FAN_OUT_INTERVAL_MS by default
+ * @param done_cb Callback called when all the commands were sent, can be NULL
+ * @param ctx Context passed to the callback
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t send_invoke_group_commands(const group_command_t *commands, size_t count,
+                                     uint32_t interval_ms = CONFIG_ESP_MATTER_CONTROLLER_GROUP_FAN_OUT_INTERVAL_MS,
+                                     group_commands_done_cb_t done_cb = nullptr, void *ctx = nullptr);
+
 } // namespace controller
 } // namespace esp_matter
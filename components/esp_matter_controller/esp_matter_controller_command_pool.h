@@ -0,0 +1,94 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <lib/support/CHIPMem.h>
+#include <new>
+#include <sdkconfig.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+namespace esp_matter {
+namespace controller {
+namespace command_pool {
+
+/*
+ * Pools of the controller command objects.
+ *
+ * Each command class has a statically allocated pool of CONFIG_ESP_MATTER_CONTROLLER_COMMAND_POOL_SIZE objects, so
+ * that sending commands continuously does not allocate and free the command objects from the heap. When the pool of
+ * a class is exhausted the commands are allocated from the heap, and counted in the heap_fallbacks of the stats.
+ *
+ * The objects must be created and destroyed in the Matter context, or with the Matter stack lock held.
+ */
+
+static constexpr size_t k_pool_size = CONFIG_ESP_MATTER_CONTROLLER_COMMAND_POOL_SIZE;
+
+typedef struct {
+    uint16_t size;
+    uint16_t in_use;
+    uint16_t high_water_mark;
+    /* Objects allocated from the heap because the pool was full */
+    uint32_t heap_fallbacks;
+} stats_t;
+
+template <typename T, size_t N = k_pool_size>
+class pool {
+public:
+    template <typename... Args>
+    T *create(Args &&...args)
+    {
+        for (size_t index = 0; index < N; index++) {
+            if (!m_in_use[index]) {
+                m_in_use[index] = true;
+                if (++m_stats.in_use > m_stats.high_water_mark) {
+                    m_stats.high_water_mark = m_stats.in_use;
+                }
+                return new (m_storage[index]) T(std::forward<Args>(args)...);
+            }
+        }
+        m_stats.heap_fallbacks++;
+        return chip::Platform::New<T>(std::forward<Args>(args)...);
+    }
+
+    void destroy(T *obj)
+    {
+        if (!obj) {
+            return;
+        }
+        uintptr_t addr = reinterpret_cast<uintptr_t>(obj);
+        uintptr_t start = reinterpret_cast<uintptr_t>(m_storage);
+        if (addr < start || addr >= start + sizeof(m_storage)) {
+            chip::Platform::Delete(obj);
+            return;
+        }
+        obj->~T();
+        m_in_use[(addr - start) / sizeof(m_storage[0])] = false;
+        m_stats.in_use--;
+    }
+
+    const stats_t &get_stats() const { return m_stats; }
+
+private:
+    static_assert(N > 0, "The command pools cannot be empty");
+    alignas(T) uint8_t m_storage[N][sizeof(T)];
+    bool m_in_use[N] = {};
+    stats_t m_stats = {.size = N, .in_use = 0, .high_water_mark = 0, .heap_fallbacks = 0};
+};
+
+} // namespace command_pool
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,356 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <controller/CommissioneeDeviceProxy.h>
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+#include <esp_matter_commissioner.h>
+#else
+#include <app/server/Server.h>
+#endif
+#include <esp_check.h>
+#include <esp_matter_controller_command_template.h>
+#include <esp_matter_controller_utils.h>
+#include <json_to_tlv.h>
+
+#include <string.h>
+
+using chip::ScopedNodeId;
+using chip::SessionHandle;
+using chip::Messaging::ExchangeManager;
+using chip::TLV::TLVReader;
+using chip::TLV::TLVType;
+using chip::TLV::TLVWriter;
+
+static const char *TAG = "command_template";
+
+namespace esp_matter {
+namespace controller {
+
+namespace {
+
+/* Command in flight, holding its own copy of the command data so that the template can be patched again */
+class template_command {
+public:
+    template_command(uint64_t destination_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                     void *ctx, custom_command_callback::on_success_callback_t on_success,
+                     custom_command_callback::on_error_callback_t on_error)
+        : m_destination_id(destination_id)
+        , m_endpoint_id(endpoint_id)
+        , m_cluster_id(cluster_id)
+        , m_command_id(command_id)
+        , m_ctx(ctx)
+        , on_device_connected_cb(on_device_connected_fcn, this)
+        , on_device_connection_failure_cb(on_device_connection_failure_fcn, this)
+        , on_success_cb(on_success)
+        , on_error_cb(on_error)
+    {
+    }
+
+    uint8_t m_data[command_template::k_max_command_data_size];
+    size_t m_data_len = 0;
+
+    esp_err_t send_command();
+
+private:
+    esp_err_t init_reader(TLVReader &reader)
+    {
+        reader.Init(m_data, m_data_len);
+        return reader.Next() == CHIP_NO_ERROR ? ESP_OK : ESP_FAIL;
+    }
+
+    static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
+                                        const SessionHandle &sessionHandle)
+    {
+        template_command *cmd = reinterpret_cast<template_command *>(context);
+        chip::OperationalDeviceProxy device_proxy(&exchangeMgr, sessionHandle);
+        chip::app::CommandPathParams command_path = {cmd->m_endpoint_id, 0, cmd->m_cluster_id, cmd->m_command_id,
+                                                     chip::app::CommandPathFlags::kEndpointIdValid};
+        TLVReader reader;
+        if (cmd->init_reader(reader) != ESP_OK ||
+            cluster::custom::command::send_command(cmd->m_ctx, &device_proxy, command_path, reader, cmd->on_success_cb,
+                                                   cmd->on_error_cb, chip::NullOptional) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to send the command to node 0x%llx", (unsigned long long)cmd->m_destination_id);
+            if (cmd->on_error_cb) {
+                cmd->on_error_cb(cmd->m_ctx, CHIP_ERROR_INTERNAL);
+            }
+        }
+        chip::Platform::Delete(cmd);
+    }
+
+    static void on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
+    {
+        template_command *cmd = reinterpret_cast<template_command *>(context);
+        if (cmd->on_error_cb) {
+            cmd->on_error_cb(cmd->m_ctx, error);
+        }
+        chip::Platform::Delete(cmd);
+    }
+
+    esp_err_t dispatch_group_command()
+    {
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+        uint8_t fabric_index = commissioner::get_device_commissioner()->GetFabricIndex();
+#else
+        uint8_t fabric_index = get_fabric_index();
+#endif
+        chip::app::CommandPathParams command_path = {m_endpoint_id, static_cast<chip::GroupId>(m_destination_id & 0xFFFF),
+                                                     m_cluster_id, m_command_id,
+                                                     chip::app::CommandPathFlags::kGroupIdValid};
+        TLVReader reader;
+        esp_err_t err = init_reader(reader);
+        if (err == ESP_OK) {
+            err = cluster::custom::command::send_group_command(fabric_index, command_path, reader);
+        }
+        chip::Platform::Delete(this);
+        return err;
+    }
+
+    uint64_t m_destination_id;
+    uint16_t m_endpoint_id;
+    uint32_t m_cluster_id;
+    uint32_t m_command_id;
+    void *m_ctx;
+
+    chip::Callback::Callback<chip::OnDeviceConnected> on_device_connected_cb;
+    chip::Callback::Callback<chip::OnDeviceConnectionFailure> on_device_connection_failure_cb;
+
+    custom_command_callback::on_success_callback_t on_success_cb;
+    custom_command_callback::on_error_callback_t on_error_cb;
+};
+
+esp_err_t template_command::send_command()
+{
+    if (chip::IsGroupId(m_destination_id)) {
+        return dispatch_group_command();
+    }
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    if (CHIP_NO_ERROR ==
+        commissioner::get_device_commissioner()->GetConnectedDevice(m_destination_id, &on_device_connected_cb,
+                                                                    &on_device_connection_failure_cb)) {
+        return ESP_OK;
+    }
+#else
+    chip::Server *server = &(chip::Server::GetInstance());
+    server->GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(m_destination_id, get_fabric_index()),
+                                                            &on_device_connected_cb, &on_device_connection_failure_cb);
+    return ESP_OK;
+#endif
+    chip::Platform::Delete(this);
+    return ESP_FAIL;
+}
+
+} // namespace
+
+esp_err_t command_template::compile(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                                    const char *command_data_json_str)
+{
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType container_type;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    m_compiled = false;
+    m_field_count = 0;
+    writer.Init(m_data, sizeof(m_data));
+    ESP_RETURN_ON_ERROR(json_to_tlv(command_data_json_str ? command_data_json_str : "{}", writer,
+                                    chip::TLV::AnonymousTag()),
+                        TAG, "Failed to convert the command data");
+    ESP_RETURN_ON_FALSE(writer.Finalize() == CHIP_NO_ERROR, ESP_ERR_INVALID_SIZE, TAG, "Command data too large");
+    m_data_len = writer.GetLengthWritten();
+
+    /* Index the top-level fields, which are the parameter slots */
+    reader.Init(m_data, m_data_len);
+    ESP_RETURN_ON_FALSE(reader.Next() == CHIP_NO_ERROR && reader.EnterContainer(container_type) == CHIP_NO_ERROR,
+                        ESP_FAIL, TAG, "Failed to read the command data");
+    while ((err = reader.Next()) == CHIP_NO_ERROR) {
+        if (!chip::TLV::IsContextTag(reader.GetTag())) {
+            continue;
+        }
+        ESP_RETURN_ON_FALSE(m_field_count < k_max_fields, ESP_ERR_NO_MEM, TAG, "Too many fields in the command");
+        field_t &field = m_fields[m_field_count++];
+        field.field_id = static_cast<uint8_t>(chip::TLV::TagNumFromTag(reader.GetTag()));
+        field.type = reader.GetType();
+        field.is_float32 = static_cast<chip::TLV::TLVElementType>(reader.GetControlByte() & chip::TLV::kTLVTypeMask) ==
+            chip::TLV::TLVElementType::FloatingPointNumber32;
+        field.is_set = false;
+    }
+    ESP_RETURN_ON_FALSE(err == CHIP_END_OF_TLV, ESP_FAIL, TAG, "Failed to read the command data");
+
+    m_endpoint_id = endpoint_id;
+    m_cluster_id = cluster_id;
+    m_command_id = command_id;
+    m_compiled = true;
+    return ESP_OK;
+}
+
+command_template::field_t *command_template::find_field(uint8_t field_id, TLVType type)
+{
+    for (size_t index = 0; index < m_field_count; index++) {
+        field_t &field = m_fields[index];
+        if (field.field_id != field_id) {
+            continue;
+        }
+        /* Any value can be set to a field compiled as null, and a nullable field can be set to null */
+        if (field.type != type && field.type != chip::TLV::kTLVType_Null && type != chip::TLV::kTLVType_Null) {
+            ESP_LOGE(TAG, "Field %u has another type", field_id);
+            return nullptr;
+        }
+        return &field;
+    }
+    ESP_LOGE(TAG, "Field %u is not in the command template", field_id);
+    return nullptr;
+}
+
+esp_err_t command_template::set_uint(uint8_t field_id, uint64_t value)
+{
+    field_t *field = find_field(field_id, chip::TLV::kTLVType_UnsignedInteger);
+    ESP_RETURN_ON_FALSE(field, ESP_ERR_NOT_FOUND, TAG, "Failed to set field %u", field_id);
+    field->value_type = chip::TLV::kTLVType_UnsignedInteger;
+    field->value.uint_val = value;
+    field->is_set = true;
+    return ESP_OK;
+}
+
+esp_err_t command_template::set_int(uint8_t field_id, int64_t value)
+{
+    field_t *field = find_field(field_id, chip::TLV::kTLVType_SignedInteger);
+    ESP_RETURN_ON_FALSE(field, ESP_ERR_NOT_FOUND, TAG, "Failed to set field %u", field_id);
+    field->value_type = chip::TLV::kTLVType_SignedInteger;
+    field->value.int_val = value;
+    field->is_set = true;
+    return ESP_OK;
+}
+
+esp_err_t command_template::set_bool(uint8_t field_id, bool value)
+{
+    field_t *field = find_field(field_id, chip::TLV::kTLVType_Boolean);
+    ESP_RETURN_ON_FALSE(field, ESP_ERR_NOT_FOUND, TAG, "Failed to set field %u", field_id);
+    field->value_type = chip::TLV::kTLVType_Boolean;
+    field->value.bool_val = value;
+    field->is_set = true;
+    return ESP_OK;
+}
+
+esp_err_t command_template::set_float(uint8_t field_id, double value)
+{
+    field_t *field = find_field(field_id, chip::TLV::kTLVType_FloatingPointNumber);
+    ESP_RETURN_ON_FALSE(field, ESP_ERR_NOT_FOUND, TAG, "Failed to set field %u", field_id);
+    field->value_type = chip::TLV::kTLVType_FloatingPointNumber;
+    field->value.float_val = value;
+    field->is_set = true;
+    return ESP_OK;
+}
+
+esp_err_t command_template::set_string(uint8_t field_id, const char *value)
+{
+    ESP_RETURN_ON_FALSE(value, ESP_ERR_INVALID_ARG, TAG, "value cannot be NULL");
+    size_t len = strnlen(value, k_max_string_param_len + 1);
+    ESP_RETURN_ON_FALSE(len <= k_max_string_param_len, ESP_ERR_INVALID_SIZE, TAG, "String too long");
+    field_t *field = find_field(field_id, chip::TLV::kTLVType_UTF8String);
+    ESP_RETURN_ON_FALSE(field, ESP_ERR_NOT_FOUND, TAG, "Failed to set field %u", field_id);
+    field->value_type = chip::TLV::kTLVType_UTF8String;
+    memcpy(field->string_val, value, len);
+    field->string_val[len] = 0;
+    field->is_set = true;
+    return ESP_OK;
+}
+
+esp_err_t command_template::set_null(uint8_t field_id)
+{
+    field_t *field = find_field(field_id, chip::TLV::kTLVType_Null);
+    ESP_RETURN_ON_FALSE(field, ESP_ERR_NOT_FOUND, TAG, "Failed to set field %u", field_id);
+    field->value_type = chip::TLV::kTLVType_Null;
+    field->is_set = true;
+    return ESP_OK;
+}
+
+void command_template::reset_params()
+{
+    for (size_t index = 0; index < m_field_count; index++) {
+        m_fields[index].is_set = false;
+    }
+}
+
+esp_err_t command_template::encode(uint8_t *buf, size_t buf_size, size_t &len) const
+{
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType reader_container_type;
+    TLVType writer_container_type;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    writer.Init(buf, buf_size);
+    reader.Init(m_data, m_data_len);
+    ESP_RETURN_ON_FALSE(reader.Next() == CHIP_NO_ERROR && reader.EnterContainer(reader_container_type) == CHIP_NO_ERROR,
+                        ESP_FAIL, TAG, "Failed to read the command template");
+    ESP_RETURN_ON_FALSE(writer.StartContainer(chip::TLV::AnonymousTag(), chip::TLV::kTLVType_Structure,
+                                              writer_container_type) == CHIP_NO_ERROR,
+                        ESP_FAIL, TAG, "Failed to start container");
+    /* The fields were indexed in the order of the compiled data, so they are matched while walking it */
+    size_t field_index = 0;
+    while (err == CHIP_NO_ERROR && (err = reader.Next()) == CHIP_NO_ERROR) {
+        chip::TLV::Tag tag = reader.GetTag();
+        const field_t *field = chip::TLV::IsContextTag(tag) ? &m_fields[field_index++] : nullptr;
+        if (!field || !field->is_set) {
+            err = writer.CopyElement(reader);
+            continue;
+        }
+        switch (field->value_type) {
+        case chip::TLV::kTLVType_UnsignedInteger:
+            err = writer.Put(tag, field->value.uint_val);
+            break;
+        case chip::TLV::kTLVType_SignedInteger:
+            err = writer.Put(tag, field->value.int_val);
+            break;
+        case chip::TLV::kTLVType_Boolean:
+            err = writer.PutBoolean(tag, field->value.bool_val);
+            break;
+        case chip::TLV::kTLVType_FloatingPointNumber:
+            err = field->is_float32 ? writer.Put(tag, static_cast<float>(field->value.float_val))
+                                    : writer.Put(tag, field->value.float_val);
+            break;
+        case chip::TLV::kTLVType_UTF8String:
+            err = writer.PutString(tag, field->string_val);
+            break;
+        default:
+            err = writer.PutNull(tag);
+            break;
+        }
+    }
+    ESP_RETURN_ON_FALSE(err == CHIP_END_OF_TLV, ESP_ERR_INVALID_SIZE, TAG, "Failed to encode the command data: %s",
+                        chip::ErrorStr(err));
+    ESP_RETURN_ON_FALSE(writer.EndContainer(writer_container_type) == CHIP_NO_ERROR && writer.Finalize() == CHIP_NO_ERROR,
+                        ESP_ERR_INVALID_SIZE, TAG, "Failed to finalize the command data");
+    len = writer.GetLengthWritten();
+    return ESP_OK;
+}
+
+esp_err_t command_template::invoke(uint64_t destination_id, void *ctx,
+                                   custom_command_callback::on_success_callback_t on_success,
+                                   custom_command_callback::on_error_callback_t on_error)
+{
+    ESP_RETURN_ON_FALSE(m_compiled, ESP_ERR_INVALID_STATE, TAG, "The command template is not compiled");
+    template_command *cmd = chip::Platform::New<template_command>(destination_id, m_endpoint_id, m_cluster_id,
+                                                                  m_command_id, ctx, on_success, on_error);
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for template_command");
+    esp_err_t err = encode(cmd->m_data, sizeof(cmd->m_data), cmd->m_data_len);
+    if (err != ESP_OK) {
+        chip::Platform::Delete(cmd);
+        return err;
+    }
+    return cmd->send_command();
+}
+
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,137 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_client.h>
+#include <lib/core/TLV.h>
+
+namespace esp_matter {
+namespace controller {
+
+using esp_matter::cluster::custom::command::custom_command_callback;
+
+/*
+ * Precompiled command templates.
+ *
+ * A command template is compiled once from the JSON command data used by send_invoke_cluster_command(), and each
+ * top-level field of the command becomes a parameter slot, identified by its field ID. The setters patch the value of
+ * a slot, and invoke() builds the command data by copying the compiled TLV elements and writing the patched values,
+ * without converting any JSON string. The patched values are kept for the next invocations until reset_params().
+ *
+ * The fields which are not in the JSON command data cannot be set, a nullable field can be compiled as null and set
+ * to a value later.
+ */
+class command_template {
+public:
+    static constexpr size_t k_max_command_data_size = 256;
+    static constexpr size_t k_max_fields = 16;
+    static constexpr size_t k_max_string_param_len = 32;
+
+    command_template() {}
+
+    /**
+     * @brief Compiles the command.
+     *
+     * @param endpoint_id Endpoint ID of the command
+     * @param cluster_id Cluster ID of the command
+     * @param command_id Command ID
+     * @param command_data_json_str Command data, in the format of send_invoke_cluster_command()
+     *
+     * @return ESP_OK on success, appropriate error code otherwise
+     */
+    esp_err_t compile(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                      const char *command_data_json_str);
+
+    /**
+     * @brief Patches an unsigned integer field.
+     *
+     * @param field_id Field ID, the context tag of the field in the command data
+     * @param value New value
+     *
+     * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the field is not in the template, ESP_ERR_INVALID_ARG if the
+     *         field has another type
+     */
+    esp_err_t set_uint(uint8_t field_id, uint64_t value);
+
+    /** @brief Patches a signed integer field, see set_uint(). */
+    esp_err_t set_int(uint8_t field_id, int64_t value);
+
+    /** @brief Patches a boolean field, see set_uint(). */
+    esp_err_t set_bool(uint8_t field_id, bool value);
+
+    /** @brief Patches a floating point field, in the precision of the compiled field, see set_uint(). */
+    esp_err_t set_float(uint8_t field_id, double value);
+
+    /** @brief Patches a string field with a copy of the string of up to k_max_string_param_len characters, see
+     * set_uint(). */
+    esp_err_t set_string(uint8_t field_id, const char *value);
+
+    /** @brief Patches a nullable field to null, see set_uint(). */
+    esp_err_t set_null(uint8_t field_id);
+
+    /** @brief Restores the compiled values of all the fields. */
+    void reset_params();
+
+    /**
+     * @brief Sends the command with the patched values.
+     *
+     * The command data is built when this function is called, so the template can be patched again and invoked for
+     * another node right after it returns.
+     *
+     * @param destination_id Node ID, or group ID for a group command
+     * @param ctx Context passed to the callbacks
+     * @param on_success Callback called with the response of the command, can be NULL
+     * @param on_error Callback called if the command fails, can be NULL
+     *
+     * @return ESP_OK on success, appropriate error code otherwise
+     */
+    esp_err_t invoke(uint64_t destination_id, void *ctx = nullptr,
+                     custom_command_callback::on_success_callback_t on_success = nullptr,
+                     custom_command_callback::on_error_callback_t on_error = nullptr);
+
+private:
+    typedef struct {
+        uint8_t field_id;
+        /* TLV type of the compiled value, kTLVType_Null if the field was compiled as null */
+        chip::TLV::TLVType type;
+        bool is_float32;
+        bool is_set;
+        /* TLV type of the patched value */
+        chip::TLV::TLVType value_type;
+        union {
+            uint64_t uint_val;
+            int64_t int_val;
+            bool bool_val;
+            double float_val;
+        } value;
+        char string_val[k_max_string_param_len + 1];
+    } field_t;
+
+    field_t *find_field(uint8_t field_id, chip::TLV::TLVType type);
+    esp_err_t encode(uint8_t *buf, size_t buf_size, size_t &len) const;
+
+    uint16_t m_endpoint_id = 0;
+    uint32_t m_cluster_id = 0;
+    uint32_t m_command_id = 0;
+    bool m_compiled = false;
+    uint8_t m_data[k_max_command_data_size];
+    size_t m_data_len = 0;
+    field_t m_fields[k_max_fields];
+    size_t m_field_count = 0;
+};
+
+} // namespace controller
+} // namespace esp_matter
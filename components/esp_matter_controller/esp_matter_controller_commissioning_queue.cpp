@@ -0,0 +1,465 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <controller/CHIPDeviceController.h>
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_matter_commissioner.h>
+#include <esp_matter_controller_commissioning_queue.h>
+#include <esp_matter_controller_pairing_command.h>
+#include <esp_timer.h>
+
+using chip::NodeId;
+using chip::PeerId;
+using chip::RendezvousParameters;
+using chip::ScopedNodeId;
+using chip::SessionHandle;
+using chip::Controller::CommissioningParameters;
+using chip::Controller::CommissioningStage;
+using chip::Controller::DeviceDiscoveryDelegate;
+using chip::Controller::DevicePairingDelegate;
+using chip::Messaging::ExchangeManager;
+using chip::Transport::PeerAddress;
+using esp_matter::commissioner::get_device_commissioner;
+
+static const char *TAG = "commissioning_queue";
+
+namespace esp_matter {
+namespace controller {
+namespace commissioning_queue {
+
+static constexpr size_t k_queue_size = CONFIG_ESP_MATTER_COMMISSIONING_QUEUE_SIZE;
+static constexpr uint8_t k_max_concurrent = CONFIG_ESP_MATTER_COMMISSIONING_QUEUE_MAX_CONCURRENT;
+static constexpr uint8_t k_max_attempts = CONFIG_ESP_MATTER_COMMISSIONING_QUEUE_MAX_ATTEMPTS;
+static constexpr int64_t k_discovery_timeout_us = CONFIG_ESP_MATTER_COMMISSIONING_QUEUE_DISCOVERY_TIMEOUT * 1000000LL;
+static constexpr uint32_t k_tick_ms = 1000;
+static constexpr uint32_t k_initial_backoff_ms = 1000;
+
+typedef enum {
+    ENTRY_FREE = 0,
+    ENTRY_DISCOVERING,
+    /* Discovered, waiting for the commissioner */
+    ENTRY_READY,
+    ENTRY_BACKOFF,
+    ENTRY_PAIRING,
+    ENTRY_COMMISSIONING,
+    ENTRY_CONNECTING,
+} entry_state_t;
+
+static uint32_t elapsed_ms(int64_t start_us)
+{
+    return (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+}
+
+class entry {
+public:
+    entry()
+        : on_connected_cb(on_connected_fcn, this)
+        , on_connection_failure_cb(on_connection_failure_fcn, this)
+    {
+    }
+
+    entry_state_t state = ENTRY_FREE;
+    /* State to go back to at the end of the backoff */
+    entry_state_t retry_state = ENTRY_FREE;
+    request_t request;
+    PeerAddress peer_address;
+    bool has_address = false;
+    uint8_t attempts = 0;
+    int64_t enqueue_us = 0;
+    int64_t discovery_start_us = 0;
+    int64_t stage_start_us = 0;
+    int64_t backoff_until_us = 0;
+    result_t result;
+
+    chip::Callback::Callback<chip::OnDeviceConnected> on_connected_cb;
+    chip::Callback::Callback<chip::OnDeviceConnectionFailure> on_connection_failure_cb;
+
+private:
+    static void on_connected_fcn(void *context, ExchangeManager &exchangeMgr, const SessionHandle &sessionHandle);
+    static void on_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error);
+};
+
+class queue : public DevicePairingDelegate, public DeviceDiscoveryDelegate {
+public:
+    /****************** DevicePairingDelegate Interface *****************/
+    void OnPairingComplete(CHIP_ERROR error) override;
+    void OnCommissioningComplete(NodeId deviceId, CHIP_ERROR error) override;
+    void OnCommissioningStatusUpdate(PeerId peerId, CommissioningStage stageCompleted, CHIP_ERROR error) override;
+
+    /****************** DeviceDiscoveryDelegate Interface ***************/
+    void OnDiscoveredDevice(const chip::Dnssd::DiscoveredNodeData &nodeData) override;
+
+    esp_err_t enqueue(const request_t *request);
+    uint16_t get_pending_count() const;
+    void on_connected(entry *e);
+    void fail_stage(entry *e, stage_t stage, CHIP_ERROR error);
+
+    done_cb_t done_cb = nullptr;
+
+private:
+    void process();
+    void start_discovery();
+    void start_pairing(entry *e);
+    void start_connect(entry *e);
+    void finish(entry *e, esp_err_t err);
+    void tick();
+    static void tick_timer_callback(chip::System::Layer *layer, void *context);
+
+    entry m_entries[k_queue_size];
+    /* Entry being paired and commissioned, the commissioner handles one at a time */
+    entry *m_active = nullptr;
+    bool m_discovering = false;
+    bool m_ticking = false;
+};
+
+static queue s_queue;
+
+void entry::on_connected_fcn(void *context, ExchangeManager &exchangeMgr, const SessionHandle &sessionHandle)
+{
+    s_queue.on_connected(static_cast<entry *>(context));
+}
+
+void entry::on_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
+{
+    s_queue.fail_stage(static_cast<entry *>(context), STAGE_CASE, error);
+}
+
+esp_err_t queue::enqueue(const request_t *request)
+{
+    entry *e = nullptr;
+    for (size_t index = 0; index < k_queue_size; index++) {
+        if (m_entries[index].state == ENTRY_FREE) {
+            e = &m_entries[index];
+        } else if (m_entries[index].request.node_id == request->node_id) {
+            ESP_LOGE(TAG, "Node 0x%016" PRIX64 " is already queued", request->node_id);
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
+    if (!e) {
+        ESP_LOGE(TAG, "The commissioning queue is full");
+        return ESP_ERR_NO_MEM;
+    }
+    e->request = *request;
+    e->result = {};
+    e->result.node_id = request->node_id;
+    e->has_address = false;
+    e->attempts = 0;
+    e->enqueue_us = esp_timer_get_time();
+    e->discovery_start_us = e->enqueue_us;
+    e->state = ENTRY_DISCOVERING;
+    if (!m_discovering) {
+        start_discovery();
+    }
+    if (!m_ticking) {
+        if (chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(k_tick_ms),
+                                                        tick_timer_callback, this) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to start the commissioning queue timer");
+        }
+        m_ticking = true;
+    }
+    ESP_LOGI(TAG, "Queued node 0x%016" PRIX64 ", %u pending", request->node_id, get_pending_count());
+    return ESP_OK;
+}
+
+uint16_t queue::get_pending_count() const
+{
+    uint16_t count = 0;
+    for (size_t index = 0; index < k_queue_size; index++) {
+        if (m_entries[index].state != ENTRY_FREE) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void queue::start_discovery()
+{
+    chip::Dnssd::DiscoveryFilter filter(chip::Dnssd::DiscoveryFilterType::kNone);
+    get_device_commissioner()->RegisterDeviceDiscoveryDelegate(this);
+    /* Restarting the discovery reports the devices again, including the ones already discovered */
+    if (get_device_commissioner()->DiscoverCommissionableNodes(filter) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to discover commissionable nodes");
+        get_device_commissioner()->RegisterDeviceDiscoveryDelegate(nullptr);
+        m_discovering = false;
+        return;
+    }
+    m_discovering = true;
+}
+
+void queue::OnDiscoveredDevice(const chip::Dnssd::DiscoveredNodeData &nodeData)
+{
+    // Ignore nodes with closed comissioning window
+    VerifyOrReturn(nodeData.commissionData.commissioningMode != 0);
+    VerifyOrReturn(nodeData.resolutionData.numIPs > 0);
+    chip::Inet::InterfaceId interfaceId = nodeData.resolutionData.ipAddress[0].IsIPv6LinkLocal()
+        ? nodeData.resolutionData.interfaceId
+        : chip::Inet::InterfaceId::Null();
+    PeerAddress peer_address =
+        PeerAddress::UDP(nodeData.resolutionData.ipAddress[0], nodeData.resolutionData.port, interfaceId);
+
+    entry *match = nullptr;
+    for (size_t index = 0; index < k_queue_size; index++) {
+        entry *e = &m_entries[index];
+        if (e->state != ENTRY_FREE && e->has_address && e->peer_address == peer_address) {
+            /* Already assigned to another request */
+            return;
+        }
+        if (e->state == ENTRY_DISCOVERING && !match &&
+            (!e->request.has_discriminator || e->request.discriminator == nodeData.commissionData.longDiscriminator)) {
+            match = e;
+        }
+    }
+    if (!match) {
+        return;
+    }
+    char buf[chip::Inet::IPAddress::kMaxStringLength];
+    nodeData.resolutionData.ipAddress[0].ToString(buf);
+    ESP_LOGI(TAG, "Discovered node 0x%016" PRIX64 " at %s:%u", match->request.node_id, buf,
+             nodeData.resolutionData.port);
+    match->peer_address = peer_address;
+    match->has_address = true;
+    match->result.discovery_ms = elapsed_ms(match->discovery_start_us);
+    match->state = ENTRY_READY;
+    process();
+}
+
+void queue::process()
+{
+    if (m_active) {
+        return;
+    }
+    uint8_t in_progress = 0;
+    entry *next = nullptr;
+    for (size_t index = 0; index < k_queue_size; index++) {
+        entry *e = &m_entries[index];
+        if (e->state == ENTRY_CONNECTING) {
+            in_progress++;
+        } else if (e->state == ENTRY_READY && (!next || e->enqueue_us < next->enqueue_us)) {
+            next = e;
+        }
+    }
+    if (next && in_progress < k_max_concurrent) {
+        start_pairing(next);
+    }
+}
+
+void queue::start_pairing(entry *e)
+{
+    m_active = e;
+    e->state = ENTRY_PAIRING;
+    e->stage_start_us = esp_timer_get_time();
+    get_device_commissioner()->RegisterPairingDelegate(this);
+    RendezvousParameters params = RendezvousParameters().SetSetupPINCode(e->request.pincode).SetPeerAddress(
+        e->peer_address);
+    CommissioningParameters commissioning_params = CommissioningParameters();
+    CHIP_ERROR error = get_device_commissioner()->PairDevice(e->request.node_id, params, commissioning_params);
+    if (error != CHIP_NO_ERROR) {
+        m_active = nullptr;
+        fail_stage(e, STAGE_PASE, error);
+    }
+}
+
+void queue::OnPairingComplete(CHIP_ERROR error)
+{
+    entry *e = m_active;
+    VerifyOrReturn(e && e->state == ENTRY_PAIRING);
+    if (error != CHIP_NO_ERROR) {
+        m_active = nullptr;
+        fail_stage(e, STAGE_PASE, error);
+        process();
+        return;
+    }
+    e->result.pase_ms = elapsed_ms(e->stage_start_us);
+    e->state = ENTRY_COMMISSIONING;
+    e->stage_start_us = esp_timer_get_time();
+}
+
+void queue::OnCommissioningStatusUpdate(PeerId peerId, CommissioningStage stageCompleted,
+                                                      CHIP_ERROR error)
+{
+    entry *e = m_active;
+    VerifyOrReturn(e && e->state == ENTRY_COMMISSIONING && error == CHIP_NO_ERROR);
+    if (stageCompleted == CommissioningStage::kAttestationVerification) {
+        e->result.attestation_ms = elapsed_ms(e->stage_start_us);
+    } else if (stageCompleted == CommissioningStage::kSendNOC) {
+        e->result.noc_ms = elapsed_ms(e->stage_start_us);
+    }
+}
+
+void queue::OnCommissioningComplete(NodeId deviceId, CHIP_ERROR error)
+{
+    entry *e = m_active;
+    VerifyOrReturn(e && e->request.node_id == deviceId && e->state == ENTRY_COMMISSIONING);
+    m_active = nullptr;
+    if (error != CHIP_NO_ERROR) {
+        fail_stage(e, STAGE_COMMISSIONING, error);
+    } else {
+        e->result.commissioning_ms = elapsed_ms(e->stage_start_us);
+        e->attempts = 0;
+        start_connect(e);
+    }
+    /* The next device is commissioned while the CASE session of this one is established */
+    process();
+}
+
+void queue::start_connect(entry *e)
+{
+    e->state = ENTRY_CONNECTING;
+    e->stage_start_us = esp_timer_get_time();
+    CHIP_ERROR error = get_device_commissioner()->GetConnectedDevice(e->request.node_id, &e->on_connected_cb,
+                                                                     &e->on_connection_failure_cb);
+    if (error != CHIP_NO_ERROR) {
+        fail_stage(e, STAGE_CASE, error);
+    }
+}
+
+void queue::on_connected(entry *e)
+{
+    VerifyOrReturn(e->state == ENTRY_CONNECTING);
+    e->result.case_ms = elapsed_ms(e->stage_start_us);
+    finish(e, ESP_OK);
+    process();
+}
+
+void queue::fail_stage(entry *e, stage_t stage, CHIP_ERROR error)
+{
+    e->result.failed_stage = stage;
+    e->result.chip_error = error.AsInteger();
+    if (++e->attempts >= k_max_attempts) {
+        finish(e, stage == STAGE_DISCOVERY ? ESP_ERR_TIMEOUT : ESP_FAIL);
+        return;
+    }
+    e->result.retries++;
+    if (stage == STAGE_CASE) {
+        e->retry_state = ENTRY_CONNECTING;
+    } else if (stage == STAGE_PASE && error == CHIP_ERROR_TIMEOUT) {
+        /* The device may have moved, discover it again */
+        e->has_address = false;
+        e->retry_state = ENTRY_DISCOVERING;
+    } else {
+        e->retry_state = ENTRY_READY;
+    }
+    uint32_t backoff_ms = k_initial_backoff_ms << (e->attempts - 1);
+    e->backoff_until_us = esp_timer_get_time() + (int64_t)backoff_ms * 1000;
+    e->state = ENTRY_BACKOFF;
+    ESP_LOGW(TAG, "Stage %d of node 0x%016" PRIX64 " failed: %s, retrying in %" PRIu32 " ms", stage,
+             e->request.node_id, chip::ErrorStr(error), backoff_ms);
+}
+
+void queue::finish(entry *e, esp_err_t err)
+{
+    e->on_connected_cb.Cancel();
+    e->on_connection_failure_cb.Cancel();
+    e->result.err = err;
+    e->result.total_ms = elapsed_ms(e->enqueue_us);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG,
+                 "Node 0x%016" PRIX64 " commissioned in %" PRIu32 " ms: discovery %" PRIu32 " ms, PASE %" PRIu32
+                 " ms, commissioning %" PRIu32 " ms (attestation %" PRIu32 " ms, NOC %" PRIu32 " ms), CASE %" PRIu32
+                 " ms, %u retries",
+                 e->request.node_id, e->result.total_ms, e->result.discovery_ms, e->result.pase_ms,
+                 e->result.commissioning_ms, e->result.attestation_ms, e->result.noc_ms, e->result.case_ms,
+                 e->result.retries);
+    } else {
+        ESP_LOGE(TAG, "Failed to commission node 0x%016" PRIX64 " at stage %d after %u attempts",
+                 e->request.node_id, e->result.failed_stage, e->attempts);
+    }
+    e->state = ENTRY_FREE;
+    if (done_cb) {
+        done_cb(&e->result);
+    }
+}
+
+void queue::tick()
+{
+    int64_t now_us = esp_timer_get_time();
+    bool discovering = false;
+    for (size_t index = 0; index < k_queue_size; index++) {
+        entry *e = &m_entries[index];
+        if (e->state == ENTRY_DISCOVERING && now_us - e->discovery_start_us > k_discovery_timeout_us) {
+            ESP_LOGE(TAG, "Node 0x%016" PRIX64 " not discovered", e->request.node_id);
+            e->result.failed_stage = STAGE_DISCOVERY;
+            e->result.chip_error = CHIP_ERROR_TIMEOUT.AsInteger();
+            finish(e, ESP_ERR_TIMEOUT);
+        } else if (e->state == ENTRY_BACKOFF && now_us >= e->backoff_until_us) {
+            if (e->retry_state == ENTRY_CONNECTING) {
+                start_connect(e);
+            } else {
+                e->state = e->retry_state;
+                if (e->state == ENTRY_DISCOVERING) {
+                    e->discovery_start_us = now_us;
+                    /* Restarted below to report the device again */
+                    m_discovering = false;
+                }
+            }
+        }
+        discovering = discovering || e->state == ENTRY_DISCOVERING;
+    }
+    if (discovering && !m_discovering) {
+        start_discovery();
+    } else if (!discovering && m_discovering) {
+        get_device_commissioner()->RegisterDeviceDiscoveryDelegate(nullptr);
+        m_discovering = false;
+    }
+    process();
+
+    if (get_pending_count() == 0) {
+        get_device_commissioner()->RegisterPairingDelegate(&pairing_command::get_instance());
+        m_ticking = false;
+        return;
+    }
+    if (chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(k_tick_ms),
+                                                    tick_timer_callback, this) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the commissioning queue timer");
+        m_ticking = false;
+    }
+}
+
+void queue::tick_timer_callback(chip::System::Layer *layer, void *context)
+{
+    static_cast<queue *>(context)->tick();
+}
+
+void set_done_cb(done_cb_t done_cb)
+{
+    s_queue.done_cb = done_cb;
+}
+
+esp_err_t enqueue(const request_t *request)
+{
+    if (!request) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = s_queue.enqueue(request);
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+uint16_t get_pending_count()
+{
+    return s_queue.get_pending_count();
+}
+
+} // namespace commissioning_queue
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,99 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace controller {
+namespace commissioning_queue {
+
+/*
+ * On-network commissioning queue.
+ *
+ * The queued devices go through discovery, PASE and commissioning, and a CASE session is then established to check
+ * that they are operational. The devices are discovered all at once, and the CASE sessions of the commissioned
+ * devices are established while the next device is commissioned. The commissioner runs a single PASE session and
+ * commissioning at a time, so the devices are commissioned one after the other. A failed stage is retried with a
+ * backoff, without going through the previous stages again: a PASE failure reuses the discovered address unless it
+ * timed out, and a CASE failure only establishes the session again.
+ *
+ * The queue is the pairing delegate of the commissioner while it is not empty, the single device pairing commands
+ * should not be used at the same time.
+ */
+
+typedef enum {
+    STAGE_DISCOVERY = 0,
+    STAGE_PASE,
+    STAGE_COMMISSIONING,
+    STAGE_CASE,
+} stage_t;
+
+/** Commissioning request */
+typedef struct {
+    uint64_t node_id;
+    uint32_t pincode;
+    /* Long discriminator of the device, to pick it among the discovered ones. Any device is commissioned if not set */
+    bool has_discriminator;
+    uint16_t discriminator;
+} request_t;
+
+/** Commissioning result, with the durations of the stages of the last attempt */
+typedef struct {
+    uint64_t node_id;
+    esp_err_t err;
+    /* Matter error of the failed stage */
+    uint32_t chip_error;
+    stage_t failed_stage;
+    uint8_t retries;
+    uint32_t discovery_ms;
+    uint32_t pase_ms;
+    /* Time from the start of the commissioning to the end of the attestation verification */
+    uint32_t attestation_ms;
+    /* Time from the start of the commissioning to the installation of the NOC */
+    uint32_t noc_ms;
+    uint32_t commissioning_ms;
+    uint32_t case_ms;
+    /* Time from the request to the end, including the time waiting in the queue */
+    uint32_t total_ms;
+} result_t;
+
+using done_cb_t = void (*)(const result_t *result);
+
+/**
+ * @brief Sets the callback called when a queued device is commissioned or failed.
+ *
+ * @param done_cb Callback, can be NULL
+ */
+void set_done_cb(done_cb_t done_cb);
+
+/**
+ * @brief Queues a device for on-network commissioning.
+ *
+ * @param request Commissioning request
+ *
+ * @return ESP_OK on success, ESP_ERR_NO_MEM if the queue is full, appropriate error code otherwise
+ */
+esp_err_t enqueue(const request_t *request);
+
+/**
+ * @brief Gets the number of the queued devices which are not done yet.
+ */
+uint16_t get_pending_count();
+
+} // namespace commissioning_queue
+} // namespace controller
+} // namespace esp_matter
@@ -17,11 +17,22 @@
 
 #include <esp_check.h>
 #include <esp_matter_controller_cluster_command.h>
+#include <esp_matter_controller_commissioning_queue.h>
 #include <esp_matter_controller_console.h>
+#include <esp_matter_controller_encode_buffer_pool.h>
+#if CONFIG_ESP_MATTER_CONTROLLER_FLEET_POLLER_ENABLE
+#include <esp_matter_controller_fleet_poller.h>
+#endif
 #include <esp_matter_controller_group_settings.h>
 #include <esp_matter_controller_pairing_command.h>
 #include <esp_matter_controller_read_command.h>
+#if CONFIG_ESP_MATTER_CONTROLLER_SCRIPT_ENABLE
+#include <esp_matter_controller_script.h>
+#endif
 #include <esp_matter_controller_subscribe_command.h>
+#if CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_ENABLE
+#include <esp_matter_controller_time_series.h>
+#endif
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_controller_write_command.h>
 #include <lib/core/CHIPCore.h>
@@ -183,6 +194,18 @@ static esp_err_t controller_pairing_handler(int argc, char **argv)
         uint64_t nodeId = string_to_uint64(argv[1]);
         uint32_t pincode = string_to_uint32(argv[2]);
         return controller::pairing_on_network(nodeId, pincode);
+    } else if (strncmp(argv[0], "onnetwork-queue", sizeof("onnetwork-queue")) == 0) {
+        if (argc != 3 && argc != 4) {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        controller::commissioning_queue::request_t request = {
+            .node_id = string_to_uint64(argv[1]),
+            .pincode = string_to_uint32(argv[2]),
+            .has_discriminator = argc == 4,
+            .discriminator = argc == 4 ? string_to_uint16(argv[3]) : (uint16_t)0,
+        };
+        return controller::commissioning_queue::enqueue(&request);
 #if CONFIG_ENABLE_ESP32_BLE_CONTROLLER
     } else if (strncmp(argv[0], "ble-wifi", sizeof("ble-wifi")) == 0) {
         if (argc != 6) {
@@ -216,9 +239,44 @@ static esp_err_t controller_pairing_handler(int argc, char **argv)
             ESP_LOGE(TAG, "Pairing over ble failed");
         }
         return result;
+    } else if (strncmp(argv[0], "combined-wifi", sizeof("combined-wifi")) == 0) {
+        if (argc != 6) {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        uint64_t nodeId = string_to_uint64(argv[1]);
+        uint32_t pincode = string_to_uint32(argv[4]);
+        uint16_t disc = string_to_uint16(argv[5]);
+
+        esp_err_t result = controller::pairing_combined_wifi(nodeId, pincode, disc, argv[2], argv[3]);
+        if (result != ESP_OK) {
+            ESP_LOGE(TAG, "Combined pairing failed");
+        }
+        return result;
+    } else if (strncmp(argv[0], "combined-thread", sizeof("combined-thread")) == 0) {
+        if (argc != 5) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        uint8_t dataset_tlvs_buf[254];
+        uint8_t dataset_tlvs_len = sizeof(dataset_tlvs_buf);
+        if (!convert_hex_str_to_bytes(argv[2], dataset_tlvs_buf, dataset_tlvs_len)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        uint64_t node_id = string_to_uint64(argv[1]);
+        uint32_t pincode = string_to_uint32(argv[3]);
+        uint16_t disc = string_to_uint16(argv[4]);
+
+        esp_err_t result =
+            controller::pairing_combined_thread(node_id, pincode, disc, dataset_tlvs_buf, dataset_tlvs_len);
+        if (result != ESP_OK) {
+            ESP_LOGE(TAG, "Combined pairing failed");
+        }
+        return result;
 #else // if !CONFIG_ENABLE_ESP32_BLE_CONTROLLER
     } else if (strncmp(argv[0], "ble-wifi", sizeof("ble-wifi")) == 0 ||
-               strncmp(argv[0], "ble-thread", sizeof("ble-thread")) == 0) {
+               strncmp(argv[0], "ble-thread", sizeof("ble-thread")) == 0 ||
+               strncmp(argv[0], "combined-wifi", sizeof("combined-wifi")) == 0 ||
+               strncmp(argv[0], "combined-thread", sizeof("combined-thread")) == 0) {
         ESP_LOGE(TAG, "Please enable ENABLE_ESP32_BLE_CONTROLLER to use pairing %s command", argv[0]);
         return ESP_ERR_NOT_SUPPORTED;
 #endif // CONFIG_ENABLE_ESP32_BLE_CONTROLLER
@@ -307,6 +365,30 @@ static esp_err_t controller_invoke_command_handler(int argc, char **argv)
                                                    argc > 4 ? argv[4] : NULL);
 }
 
+static esp_err_t controller_invoke_group_commands_handler(int argc, char **argv)
+{
+    if (argc < 4 || argc % 4 != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t count = argc / 4;
+    controller::group_command_t *commands =
+        (controller::group_command_t *)esp_matter_mem_calloc(count, sizeof(controller::group_command_t));
+    if (!commands) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t idx = 0; idx < count; ++idx) {
+        char **args = &argv[idx * 4];
+        commands[idx].group_id = string_to_uint16(args[0]);
+        commands[idx].cluster_id = string_to_uint32(args[1]);
+        commands[idx].command_id = string_to_uint32(args[2]);
+        commands[idx].command_data_field = strcmp(args[3], "-") == 0 ? NULL : args[3];
+    }
+    /* The commands are copied by the dispatch */
+    esp_err_t err = controller::send_invoke_group_commands(commands, count);
+    esp_matter_mem_free(commands);
+    return err;
+}
+
 static esp_err_t controller_read_attr_handler(int argc, char **argv)
 {
     if (argc != 4) {
@@ -339,6 +421,16 @@ static esp_err_t controller_write_attr_handler(int argc, char **argv)
     return controller::send_write_attr_command(node_id, endpoint_id, cluster_id, attribute_id, attribute_val_str);
 }
 
+static esp_err_t controller_write_attrs_handler(int argc, char **argv)
+{
+    if (argc != 2) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint64_t node_id = string_to_uint64(argv[0]);
+    return controller::send_batch_write_attr_command(node_id, argv[1]);
+}
+
 static esp_err_t controller_read_event_handler(int argc, char **argv)
 {
     if (argc != 4) {
@@ -405,6 +497,154 @@ static esp_err_t controller_shutdown_subscription_handler(int argc, char **argv)
     return controller::send_shutdown_subscription(node_id, subscription_id);
 }
 
+static esp_err_t controller_encode_buffer_stats_handler(int argc, char **argv)
+{
+    if (argc != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    controller::encode_buffer_pool::stats_t stats;
+    ESP_RETURN_ON_ERROR(controller::encode_buffer_pool::get_stats(&stats), TAG, "Failed to get the pool stats");
+    printf("Encode buffers: %u in use of %u, high water mark %u\n", stats.in_use, stats.size, stats.high_water_mark);
+    printf("Waiting: %u, max waiting %u\n", stats.waiting, stats.max_waiting);
+    printf("Acquisitions: %" PRIu32 ", waits %" PRIu32 ", queue full %" PRIu32 "\n", stats.acquisitions,
+           stats.waits, stats.queue_full);
+    return ESP_OK;
+}
+
+#if CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_ENABLE
+static bool print_sample(const controller::time_series::sample_t *sample, void *ctx)
+{
+    printf("%" PRId64 " %" PRId32 "e%d\n", sample->time_ms, sample->value, -sample->scale);
+    (*static_cast<size_t *>(ctx))++;
+    return true;
+}
+
+static esp_err_t controller_time_series_handler(int argc, char **argv)
+{
+    if (argc < 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (strncmp(argv[0], "flush", sizeof("flush")) == 0) {
+        return controller::time_series::flush();
+    } else if (strncmp(argv[0], "erase", sizeof("erase")) == 0) {
+        return controller::time_series::erase_all();
+    } else if (strncmp(argv[0], "stats", sizeof("stats")) == 0) {
+        controller::time_series::stats_t stats;
+        controller::time_series::get_stats(&stats);
+        printf("Series: %u, samples: %" PRIu32 ", dropped: %" PRIu32 "\n", stats.series_count, stats.samples,
+               stats.dropped);
+        printf("Blocks written: %" PRIu32 ", sectors erased: %" PRIu32 ", write errors: %" PRIu32 "\n",
+               stats.blocks_written, stats.sectors_erased, stats.write_errors);
+        printf("Flash used: %" PRIu32 " of %" PRIu32 " bytes\n", stats.used_bytes, stats.partition_size);
+        return ESP_OK;
+    }
+    if (argc < 5) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint64_t node_id = string_to_uint64(argv[1]);
+    chip::app::ConcreteAttributePath path(string_to_uint16(argv[2]), string_to_uint32(argv[3]),
+                                          string_to_uint32(argv[4]));
+    if (strncmp(argv[0], "track", sizeof("track")) == 0 && argc <= 6) {
+        int8_t scale = argc == 6 ? (int8_t)strtol(argv[5], nullptr, 0) : 0;
+        return controller::time_series::track(node_id, path, scale);
+    } else if (strncmp(argv[0], "untrack", sizeof("untrack")) == 0 && argc == 5) {
+        return controller::time_series::untrack(node_id, path);
+    } else if (strncmp(argv[0], "query", sizeof("query")) == 0 && argc <= 6) {
+        int64_t to_ms = controller::time_series::get_time_ms();
+        int64_t from_ms = argc == 6 ? to_ms - (int64_t)string_to_uint32(argv[5]) * 1000 : INT64_MIN;
+        size_t count = 0;
+        ESP_RETURN_ON_ERROR(controller::time_series::query(node_id, path, from_ms, to_ms, print_sample, &count), TAG,
+                            "Failed to query the series");
+        printf("%u samples\n", (unsigned)count);
+        return ESP_OK;
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+#endif // CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_ENABLE
+
+#if CONFIG_ESP_MATTER_CONTROLLER_FLEET_POLLER_ENABLE
+static esp_err_t controller_fleet_poll_handler(int argc, char **argv)
+{
+    if (argc < 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (strncmp(argv[0], "start", sizeof("start")) == 0 || strncmp(argv[0], "start-subs", sizeof("start-subs")) == 0) {
+        if (argc < 7) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        size_t node_count = argc - 6;
+        ScopedMemoryBufferWithSize<uint64_t> node_ids;
+        node_ids.Calloc(node_count);
+        ESP_RETURN_ON_FALSE(node_ids.Get(), ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for node IDs");
+        for (size_t idx = 0; idx < node_count; ++idx) {
+            node_ids[idx] = string_to_uint64(argv[6 + idx]);
+        }
+        AttributePathParams attr_path(string_to_uint16(argv[3]), string_to_uint32(argv[4]), string_to_uint32(argv[5]));
+        uint32_t period_ms = string_to_uint32(argv[1]);
+        controller::fleet_poller::config_t config = {
+            .node_ids = node_ids.Get(),
+            .node_count = node_count,
+            .attr_paths = &attr_path,
+            .attr_path_count = 1,
+            .period_ms = period_ms,
+            .jitter_ms = string_to_uint32(argv[2]),
+            .max_concurrent = 0,
+            .use_subscriptions = strncmp(argv[0], "start-subs", sizeof("start-subs")) == 0,
+            .subscription_max_interval = (uint16_t)std::max<uint32_t>(period_ms / 1000, 1),
+        };
+        return controller::fleet_poller::start(&config, nullptr, nullptr);
+    } else if (strncmp(argv[0], "stop", sizeof("stop")) == 0) {
+        return controller::fleet_poller::stop();
+    } else if (strncmp(argv[0], "stats", sizeof("stats")) == 0) {
+        controller::fleet_poller::print_stats();
+        return ESP_OK;
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+#endif // CONFIG_ESP_MATTER_CONTROLLER_FLEET_POLLER_ENABLE
+
+#if CONFIG_ESP_MATTER_CONTROLLER_SCRIPT_ENABLE
+static esp_err_t controller_script_exec(int argc, char **argv)
+{
+    return controller_console.exec_command(argc, argv);
+}
+
+static void controller_script_done(const controller::script::summary_t *summary)
+{
+    controller::script::print_summary(summary);
+}
+
+static esp_err_t controller_script_handler(int argc, char **argv)
+{
+    if (argc < 1) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (strncmp(argv[0], "load", sizeof("load")) == 0) {
+        if (argc != 2) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        return controller::script::load_file(argv[1]);
+    } else if (strncmp(argv[0], "add", sizeof("add")) == 0) {
+        if (argc < 2) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        return controller::script::add_command(argc - 1, &argv[1]);
+    } else if (strncmp(argv[0], "run", sizeof("run")) == 0) {
+        if (argc > 2) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        uint16_t max_concurrent = argc == 2 ? string_to_uint16(argv[1]) : 0;
+        return controller::script::run(controller_script_exec, max_concurrent, controller_script_done);
+    } else if (strncmp(argv[0], "show", sizeof("show")) == 0) {
+        controller::script::print();
+        return ESP_OK;
+    } else if (strncmp(argv[0], "clear", sizeof("clear")) == 0) {
+        return controller::script::clear();
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+#endif // CONFIG_ESP_MATTER_CONTROLLER_SCRIPT_ENABLE
+
 static esp_err_t controller_dispatch(int argc, char **argv)
 {
     if (argc == 0) {
@@ -427,8 +667,11 @@ esp_err_t controller_register_commands()
             .name = "pairing",
             .description = "Pairing a node.\n"
                            "\tUsage: controller pairing onnetwork [nodeid] [pincode] OR\n"
+                           "\tcontroller pairing onnetwork-queue [nodeid] [pincode] [discriminator(optional)] OR\n"
                            "\tcontroller pairing ble-wifi [nodeid] [ssid] [password] [pincode] [discriminator] OR\n"
-                           "\tcontroller pairing ble-thread [nodeid] [dataset] [pincode] [discriminator]",
+                           "\tcontroller pairing ble-thread [nodeid] [dataset] [pincode] [discriminator] OR\n"
+                           "\tcontroller pairing combined-wifi [nodeid] [ssid] [password] [pincode] [discriminator] OR\n"
+                           "\tcontroller pairing combined-thread [nodeid] [dataset] [pincode] [discriminator]",
             .handler = controller_pairing_handler,
         },
         {
@@ -450,6 +693,14 @@ esp_err_t controller_register_commands()
                 "https://docs.espressif.com/projects/esp-matter/en/latest/esp32/developing.html#cluster-commands",
             .handler = controller_invoke_command_handler,
         },
+        {
+            .name = "invoke-group-cmds",
+            .description = "Send a list of commands to groups, paced in one pass.\n"
+                           "\tUsage: controller invoke-group-cmds [group-id] [cluster-id] [command-id] [payload|-] "
+                           "[group-id] [cluster-id] [command-id] [payload|-] ...\n"
+                           "\tNotes: each group-id is the 16-bit group id, '-' is a command without payload.",
+            .handler = controller_invoke_group_commands_handler,
+        },
         {
             .name = "read-attr",
             .description = "Read attributes of the nodes.\n"
@@ -466,6 +717,15 @@ esp_err_t controller_register_commands()
                            "https://docs.espressif.com/projects/esp-matter/en/latest/esp32/developing.html#write-attribute-commands",
             .handler = controller_write_attr_handler,
         },
+        {
+            .name = "write-attrs",
+            .description = "Write several attributes of a node in one write interaction.\n"
+                           "\tUsage: controller write-attrs [node-id] [writes-json]\n"
+                           "\tNotes: writes-json is a JSON object with a \"writes\" array of {\"endpoint\", "
+                           "\"cluster\", \"attribute\", \"value\"} objects, value has the format of the "
+                           "attr-value of write-attr. The status of each path is logged.",
+            .handler = controller_write_attrs_handler,
+        },
         {
             .name = "read-event",
             .description = "Read events of the nodes.\n"
@@ -492,6 +752,54 @@ esp_err_t controller_register_commands()
                            "\tUsage: controller shutdown-subs [node-id] [subscription-id]",
             .handler = controller_shutdown_subscription_handler,
         },
+#if CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_ENABLE
+        {
+            .name = "tseries",
+            .description = "Record the reported values of attributes and query their history.\n"
+                           "\tUsage: controller tseries track [node-id] [endpoint-id] [cluster-id] [attr-id] "
+                           "[scale(optional)] OR\n"
+                           "\tcontroller tseries untrack [node-id] [endpoint-id] [cluster-id] [attr-id] OR\n"
+                           "\tcontroller tseries query [node-id] [endpoint-id] [cluster-id] [attr-id] "
+                           "[last-seconds(optional)] OR\n"
+                           "\tcontroller tseries flush|erase|stats\n"
+                           "\tNotes: the values are recorded from the subscriptions, multiplied by 10^scale.",
+            .handler = controller_time_series_handler,
+        },
+#endif // CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_ENABLE
+#if CONFIG_ESP_MATTER_CONTROLLER_FLEET_POLLER_ENABLE
+        {
+            .name = "fleet-poll",
+            .description = "Poll an attribute of a list of nodes periodically, with a limit on the reads in flight.\n"
+                           "\tUsage: controller fleet-poll start [period-ms] [jitter-ms] [endpoint-id] [cluster-id] "
+                           "[attr-id] [node-id] [node-id...] OR\n"
+                           "\tcontroller fleet-poll start-subs [period-ms] [jitter-ms] [endpoint-id] [cluster-id] "
+                           "[attr-id] [node-id] [node-id...] OR\n"
+                           "\tcontroller fleet-poll stop OR\n"
+                           "\tcontroller fleet-poll stats\n"
+                           "\tNotes: start-subs subscribes to the attribute and only polls the nodes whose "
+                           "subscription is not alive.",
+            .handler = controller_fleet_poll_handler,
+        },
+#endif // CONFIG_ESP_MATTER_CONTROLLER_FLEET_POLLER_ENABLE
+#if CONFIG_ESP_MATTER_CONTROLLER_SCRIPT_ENABLE
+        {
+            .name = "script",
+            .description = "Run a script of controller commands, the read, write and invoke commands concurrently.\n"
+                           "\tUsage: controller script load [path] OR\n"
+                           "\tcontroller script add [command] [args...] OR\n"
+                           "\tcontroller script run [max-concurrent(optional)] OR\n"
+                           "\tcontroller script show OR\n"
+                           "\tcontroller script clear\n"
+                           "\tNotes: 'wait [ms]' lines wait for the commands in flight.",
+            .handler = controller_script_handler,
+        },
+#endif // CONFIG_ESP_MATTER_CONTROLLER_SCRIPT_ENABLE
+        {
+            .name = "encode-buffer-stats",
+            .description = "Print the usage of the encode buffer pool of the write and invoke commands.\n"
+                           "\tUsage: controller encode-buffer-stats",
+            .handler = controller_encode_buffer_stats_handler,
+        },
     };
 
     const static command_t controller_command = {
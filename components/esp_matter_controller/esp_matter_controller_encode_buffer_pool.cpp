@@ -0,0 +1,148 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <app/WriteClient.h>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_encode_buffer_pool.h>
+#include <freertos/FreeRTOS.h>
+#include <platform/PlatformManager.h>
+
+static const char *TAG = "encode_buffer_pool";
+
+namespace esp_matter {
+namespace controller {
+namespace encode_buffer_pool {
+
+static constexpr size_t k_buffer_size = chip::kMaxAppMessageLen;
+static constexpr size_t k_pool_size = CONFIG_ESP_MATTER_CONTROLLER_ENCODE_BUFFER_POOL_SIZE;
+static constexpr size_t k_queue_size = CONFIG_ESP_MATTER_CONTROLLER_ENCODE_BUFFER_QUEUE_SIZE;
+
+typedef struct {
+    buffer_ready_cb_t ready_cb;
+    void *ctx;
+} waiter_t;
+
+typedef struct {
+    bool in_use;
+    /* Waiter the buffer was handed over to, called from the Matter task */
+    waiter_t handover;
+    uint8_t data[k_buffer_size];
+} buffer_t;
+
+static buffer_t s_buffers[k_pool_size];
+static waiter_t s_queue[k_queue_size];
+static size_t s_queue_head = 0;
+static stats_t s_stats = {.size = k_pool_size};
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void handover_work(intptr_t arg)
+{
+    buffer_t *buffer = &s_buffers[arg];
+    buffer->handover.ready_cb(buffer->handover.ctx, buffer->data, k_buffer_size);
+}
+
+esp_err_t acquire(buffer_ready_cb_t ready_cb, void *ctx)
+{
+    ESP_RETURN_ON_FALSE(ready_cb, ESP_ERR_INVALID_ARG, TAG, "ready_cb cannot be NULL");
+    buffer_t *buffer = NULL;
+    esp_err_t err = ESP_OK;
+    portENTER_CRITICAL(&s_lock);
+    for (buffer_t &entry : s_buffers) {
+        if (!entry.in_use) {
+            entry.in_use = true;
+            buffer = &entry;
+            break;
+        }
+    }
+    if (buffer) {
+        s_stats.acquisitions++;
+        s_stats.in_use++;
+        if (s_stats.in_use > s_stats.high_water_mark) {
+            s_stats.high_water_mark = s_stats.in_use;
+        }
+    } else if (s_stats.waiting < k_queue_size) {
+        s_queue[(s_queue_head + s_stats.waiting) % k_queue_size] = {ready_cb, ctx};
+        s_stats.waiting++;
+        s_stats.waits++;
+        if (s_stats.waiting > s_stats.max_waiting) {
+            s_stats.max_waiting = s_stats.waiting;
+        }
+    } else {
+        s_stats.queue_full++;
+        err = ESP_ERR_NO_MEM;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "No encode buffer and the wait queue is full");
+        return err;
+    }
+    if (buffer) {
+        ready_cb(ctx, buffer->data, k_buffer_size);
+    } else {
+        ESP_LOGD(TAG, "No free encode buffer, waiting");
+    }
+    return ESP_OK;
+}
+
+void release(uint8_t *buf)
+{
+    if (!buf) {
+        return;
+    }
+    buffer_t *buffer = NULL;
+    for (buffer_t &entry : s_buffers) {
+        if (entry.data == buf) {
+            buffer = &entry;
+            break;
+        }
+    }
+    if (!buffer) {
+        ESP_LOGE(TAG, "The buffer is not from the pool");
+        return;
+    }
+    bool handed_over = false;
+    portENTER_CRITICAL(&s_lock);
+    if (s_stats.waiting > 0) {
+        /* The buffer goes to the first waiter and stays in use */
+        buffer->handover = s_queue[s_queue_head];
+        s_queue_head = (s_queue_head + 1) % k_queue_size;
+        s_stats.waiting--;
+        s_stats.acquisitions++;
+        handed_over = true;
+    } else {
+        buffer->in_use = false;
+        s_stats.in_use--;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (handed_over) {
+        /* Not called from here, the buffer is usually released by a callback of the previous command */
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(handover_work, static_cast<intptr_t>(buffer - s_buffers));
+    }
+}
+
+esp_err_t get_stats(stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "stats cannot be NULL");
+    portENTER_CRITICAL(&s_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_lock);
+    return ESP_OK;
+}
+
+} // namespace encode_buffer_pool
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,80 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace controller {
+namespace encode_buffer_pool {
+
+/*
+ * Pool of the TLV encode buffers of the write and invoke commands.
+ *
+ * The buffers are statically allocated, so that sending many commands does not allocate and free message sized
+ * buffers from the heap. When all the buffers are in use, the requests wait in a FIFO queue and get the next released
+ * buffer, from the Matter task. This also bounds the number of commands being encoded and sent at the same time.
+ */
+
+typedef struct {
+    uint16_t size;
+    uint16_t in_use;
+    uint16_t high_water_mark;
+    /* Requests currently waiting for a buffer */
+    uint16_t waiting;
+    uint16_t max_waiting;
+    uint32_t acquisitions;
+    /* Acquisitions which had to wait for a buffer */
+    uint32_t waits;
+    /* Requests refused because the wait queue was full */
+    uint32_t queue_full;
+} stats_t;
+
+using buffer_ready_cb_t = void (*)(void *ctx, uint8_t *buf, size_t buf_size);
+
+/**
+ * @brief Gets an encode buffer.
+ *
+ * The callback is called right away if a buffer is free, or from the Matter task when a buffer is released. The
+ * buffer must then be given back with release().
+ *
+ * @param ready_cb Callback called with the buffer
+ * @param ctx Context passed to the callback
+ *
+ * @return ESP_OK on success, ESP_ERR_NO_MEM if the wait queue is full
+ */
+esp_err_t acquire(buffer_ready_cb_t ready_cb, void *ctx);
+
+/**
+ * @brief Gives back an encode buffer, which goes to the first waiting request if any.
+ *
+ * @param buf Buffer given to the callback of acquire()
+ */
+void release(uint8_t *buf);
+
+/**
+ * @brief Gets the pool usage.
+ *
+ * @param stats Pool statistics
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t get_stats(stats_t *stats);
+
+} // namespace encode_buffer_pool
+} // namespace controller
+} // namespace esp_matter
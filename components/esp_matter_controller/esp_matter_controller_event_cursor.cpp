@@ -0,0 +1,233 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_matter_controller_event_cursor.h>
+#include <lib/support/CHIPMem.h>
+#include <nvs.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <string.h>
+
+using chip::EventNumber;
+using chip::app::EventHeader;
+using chip::app::EventPathParams;
+
+static const char *TAG = "event_cursor";
+
+#define EVENT_CURSOR_NVS_NAMESPACE "esp_matter_evt"
+#define EVENT_CURSOR_NVS_KEY "cursors"
+#define EVENT_CURSOR_PERSISTED_VERSION 1
+/* Delay of the NVS writes, so that the events of a report are written at once */
+#define EVENT_CURSOR_FLUSH_DELAY_MS 1000
+
+namespace esp_matter {
+namespace controller {
+namespace event_cursor {
+
+static constexpr size_t k_max_cursors = CONFIG_ESP_MATTER_CONTROLLER_EVENT_CURSOR_MAX_COUNT;
+
+typedef struct {
+    uint64_t node_id;
+    EventNumber event_number;
+    uint32_t cluster_id;
+    uint32_t event_id;
+    uint16_t endpoint_id;
+    uint8_t valid;
+} cursor_t;
+
+typedef struct {
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t count;
+} persisted_header_t;
+
+static cursor_t s_cursors[k_max_cursors];
+/* Order of use of the cursors, the least recently updated one is replaced when the table is full */
+static uint32_t s_last_used[k_max_cursors];
+static uint32_t s_use_counter = 0;
+static bool s_loaded = false;
+static bool s_flush_scheduled = false;
+
+static void load_cursors()
+{
+    s_loaded = true;
+    nvs_handle_t handle;
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, EVENT_CURSOR_NVS_NAMESPACE, NVS_READONLY, &handle) !=
+        ESP_OK) {
+        return;
+    }
+    size_t size = sizeof(persisted_header_t) + sizeof(s_cursors);
+    uint8_t *blob = (uint8_t *)chip::Platform::MemoryAlloc(size);
+    persisted_header_t header;
+    if (blob && nvs_get_blob(handle, EVENT_CURSOR_NVS_KEY, blob, &size) == ESP_OK && size >= sizeof(header)) {
+        memcpy(&header, blob, sizeof(header));
+        if (header.version == EVENT_CURSOR_PERSISTED_VERSION && header.count <= k_max_cursors &&
+            size == sizeof(header) + header.count * sizeof(cursor_t)) {
+            memcpy(s_cursors, blob + sizeof(header), header.count * sizeof(cursor_t));
+        }
+    }
+    chip::Platform::MemoryFree(blob);
+    nvs_close(handle);
+}
+
+static void flush_cursors(chip::System::Layer *layer, void *ctx)
+{
+    s_flush_scheduled = false;
+    uint8_t *blob = (uint8_t *)chip::Platform::MemoryAlloc(sizeof(persisted_header_t) + sizeof(s_cursors));
+    if (!blob) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the event cursors");
+        return;
+    }
+    persisted_header_t header = {.version = EVENT_CURSOR_PERSISTED_VERSION, .reserved = 0, .count = 0};
+    for (size_t index = 0; index < k_max_cursors; index++) {
+        if (s_cursors[index].valid) {
+            memcpy(blob + sizeof(header) + header.count * sizeof(cursor_t), &s_cursors[index], sizeof(cursor_t));
+            header.count++;
+        }
+    }
+    memcpy(blob, &header, sizeof(header));
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, EVENT_CURSOR_NVS_NAMESPACE, NVS_READWRITE,
+                                            &handle);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(handle, EVENT_CURSOR_NVS_KEY, blob, sizeof(header) + header.count * sizeof(cursor_t));
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    chip::Platform::MemoryFree(blob);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store the event cursors: %s", esp_err_to_name(err));
+    }
+}
+
+static void schedule_flush()
+{
+    if (!s_flush_scheduled &&
+        chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(EVENT_CURSOR_FLUSH_DELAY_MS),
+                                                    flush_cursors, nullptr) == CHIP_NO_ERROR) {
+        s_flush_scheduled = true;
+    }
+}
+
+static bool path_matches(const EventPathParams &path, const chip::app::ConcreteEventPath &event_path)
+{
+    return (path.HasWildcardEndpointId() || path.mEndpointId == event_path.mEndpointId) &&
+        (path.HasWildcardClusterId() || path.mClusterId == event_path.mClusterId) &&
+        (path.HasWildcardEventId() || path.mEventId == event_path.mEventId);
+}
+
+static cursor_t *find_cursor(uint64_t node_id, const EventPathParams &path)
+{
+    if (!s_loaded) {
+        load_cursors();
+    }
+    for (size_t index = 0; index < k_max_cursors; index++) {
+        cursor_t &cursor = s_cursors[index];
+        if (cursor.valid && cursor.node_id == node_id && cursor.endpoint_id == path.mEndpointId &&
+            cursor.cluster_id == path.mClusterId && cursor.event_id == path.mEventId) {
+            s_last_used[index] = ++s_use_counter;
+            return &cursor;
+        }
+    }
+    return nullptr;
+}
+
+static cursor_t *add_cursor(uint64_t node_id, const EventPathParams &path)
+{
+    size_t slot = 0;
+    for (size_t index = 0; index < k_max_cursors; index++) {
+        if (!s_cursors[index].valid) {
+            slot = index;
+            break;
+        }
+        if (s_last_used[index] < s_last_used[slot]) {
+            slot = index;
+        }
+    }
+    cursor_t &cursor = s_cursors[slot];
+    cursor.node_id = node_id;
+    cursor.endpoint_id = path.mEndpointId;
+    cursor.cluster_id = path.mClusterId;
+    cursor.event_id = path.mEventId;
+    cursor.event_number = 0;
+    cursor.valid = 1;
+    s_last_used[slot] = ++s_use_counter;
+    return &cursor;
+}
+
+void get_highest_received(uint64_t node_id, const EventPathParams *paths, size_t count,
+                          chip::Optional<EventNumber> &event_number)
+{
+    event_number.ClearValue();
+    for (size_t index = 0; index < count; index++) {
+        cursor_t *cursor = find_cursor(node_id, paths[index]);
+        if (!cursor) {
+            // The events of this path were never received, the whole buffer must be read
+            event_number.ClearValue();
+            return;
+        }
+        if (!event_number.HasValue() || cursor->event_number < event_number.Value()) {
+            event_number.SetValue(cursor->event_number);
+        }
+    }
+}
+
+bool update(uint64_t node_id, const EventPathParams *paths, size_t count, const EventHeader &header)
+{
+    bool is_new = false;
+    bool matched = false;
+    for (size_t index = 0; index < count; index++) {
+        if (!path_matches(paths[index], header.mPath)) {
+            continue;
+        }
+        matched = true;
+        cursor_t *cursor = find_cursor(node_id, paths[index]);
+        if (!cursor) {
+            cursor = add_cursor(node_id, paths[index]);
+        } else if (cursor->event_number >= header.mEventNumber) {
+            continue;
+        }
+        cursor->event_number = header.mEventNumber;
+        is_new = true;
+    }
+    if (is_new) {
+        schedule_flush();
+    }
+    // An event matching none of the paths is not filtered
+    return is_new || !matched;
+}
+
+void reset(uint64_t node_id)
+{
+    if (!s_loaded) {
+        load_cursors();
+    }
+    bool changed = false;
+    for (size_t index = 0; index < k_max_cursors; index++) {
+        if (s_cursors[index].valid && s_cursors[index].node_id == node_id) {
+            s_cursors[index].valid = 0;
+            changed = true;
+        }
+    }
+    if (changed) {
+        schedule_flush();
+    }
+}
+
+} // namespace event_cursor
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,85 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/EventHeader.h>
+#include <app/EventPathParams.h>
+#include <esp_err.h>
+#include <lib/core/Optional.h>
+#include <sdkconfig.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace controller {
+namespace event_cursor {
+
+/*
+ * Event cursors.
+ *
+ * A cursor keeps the highest event number received for an event path of a node, the path being the one of the read
+ * or subscribe request, with its wildcards. The cursors are stored in NVS, and the read and subscribe commands send
+ * the lowest cursor of their paths as the EventMin filter, so that a reconnection, a resubscription or a reboot only
+ * transfers the new events. Since the filter applies to the whole request, the events already received for a path are
+ * dropped when they are reported again for another path of the request.
+ *
+ * All the functions must be called in the Matter context, or with the Matter stack lock held.
+ */
+
+#if CONFIG_ESP_MATTER_CONTROLLER_EVENT_CURSOR_ENABLE
+/**
+ * @brief Gets the highest event number received for all the paths of a request.
+ *
+ * @param node_id      Remote node ID
+ * @param paths        Event paths of the request
+ * @param count        Number of paths
+ * @param event_number Set to the lowest cursor of the paths, or cleared if a path has no cursor
+ */
+void get_highest_received(uint64_t node_id, const chip::app::EventPathParams *paths, size_t count,
+                          chip::Optional<chip::EventNumber> &event_number);
+
+/**
+ * @brief Moves the cursors of the request paths matching a received event.
+ *
+ * @param node_id Remote node ID
+ * @param paths   Event paths of the request
+ * @param count   Number of paths
+ * @param header  Header of the received event
+ *
+ * @return true if the event is new for one of the paths, false if it was already received
+ */
+bool update(uint64_t node_id, const chip::app::EventPathParams *paths, size_t count,
+            const chip::app::EventHeader &header);
+
+/**
+ * @brief Drops the cursors of a node, the next requests fetch the events from the beginning of the remote buffer.
+ *
+ * @param node_id Remote node ID
+ */
+void reset(uint64_t node_id);
+#else
+inline void get_highest_received(uint64_t node_id, const chip::app::EventPathParams *paths, size_t count,
+                                 chip::Optional<chip::EventNumber> &event_number)
+{
+    event_number.ClearValue();
+}
+inline bool update(uint64_t node_id, const chip::app::EventPathParams *paths, size_t count,
+                   const chip::app::EventHeader &header) { return true; }
+inline void reset(uint64_t node_id) {}
+#endif // CONFIG_ESP_MATTER_CONTROLLER_EVENT_CURSOR_ENABLE
+
+} // namespace event_cursor
+} // namespace controller
+} // namespace esp_matter
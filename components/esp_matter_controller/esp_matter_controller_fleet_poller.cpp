@@ -0,0 +1,360 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <crypto/RandUtils.h>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_matter_controller_fleet_poller.h>
+#include <esp_matter_controller_read_command.h>
+#if CONFIG_ESP_MATTER_CONTROLLER_SUBSCRIPTION_MANAGER_ENABLE
+#include <esp_matter_controller_subscription_manager.h>
+#endif
+#include <esp_matter_mem.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "fleet_poller";
+
+namespace esp_matter {
+namespace controller {
+namespace fleet_poller {
+
+static constexpr uint32_t k_tick_ms = 100;
+
+typedef struct {
+    uint64_t node_id;
+    int64_t next_poll_us;
+    int64_t start_us;
+    bool in_flight;
+#if CONFIG_ESP_MATTER_CONTROLLER_SUBSCRIPTION_MANAGER_ENABLE
+    subscription_manager::subscription_handle_t subscription;
+#endif
+    node_stats_t stats;
+} node_t;
+
+static bool s_running = false;
+static node_t *s_nodes = nullptr;
+static size_t s_node_count = 0;
+static AttributePathParams *s_paths = nullptr;
+static size_t s_path_count = 0;
+static uint32_t s_period_ms = 0;
+static uint32_t s_jitter_ms = 0;
+static uint16_t s_max_concurrent = 0;
+static uint16_t s_in_flight = 0;
+/* Node the next tick starts from, so that the due nodes get their turn when the reads are limited */
+static size_t s_cursor = 0;
+static attribute_report_cb_t s_attribute_cb = nullptr;
+static poll_done_cb_t s_done_cb = nullptr;
+
+static int64_t random_delay_us(uint32_t max_ms)
+{
+    return max_ms > 0 ? (int64_t)(chip::Crypto::GetRandU32() % max_ms) * 1000 : 0;
+}
+
+static node_t *find_node(uint64_t node_id)
+{
+    for (size_t idx = 0; idx < s_node_count; ++idx) {
+        if (s_nodes[idx].node_id == node_id) {
+            return &s_nodes[idx];
+        }
+    }
+    return nullptr;
+}
+
+static void complete(uint64_t node_id, CHIP_ERROR error)
+{
+    node_t *node = s_running ? find_node(node_id) : nullptr;
+    if (!node || !node->in_flight) {
+        return;
+    }
+    int64_t now = esp_timer_get_time();
+    uint32_t latency_ms = (now - node->start_us) / 1000;
+    node->in_flight = false;
+    s_in_flight--;
+    node->next_poll_us = node->start_us + (int64_t)s_period_ms * 1000 + random_delay_us(s_jitter_ms);
+    node_stats_t &stats = node->stats;
+    stats.polls++;
+    stats.last_latency_ms = latency_ms;
+    stats.total_latency_ms += latency_ms;
+    if (latency_ms > stats.max_latency_ms) {
+        stats.max_latency_ms = latency_ms;
+    }
+    if (error == CHIP_NO_ERROR) {
+        stats.consecutive_failures = 0;
+    } else {
+        stats.failures++;
+        stats.consecutive_failures++;
+        stats.last_error = error.AsInteger();
+        ESP_LOGW(TAG, "Poll of node 0x%" PRIx64 " failed: %" CHIP_ERROR_FORMAT, node_id, error.Format());
+    }
+    if (s_done_cb) {
+        s_done_cb(node_id, error == CHIP_NO_ERROR ? ESP_OK : ESP_FAIL, latency_ms);
+    }
+}
+
+static void on_read_done(uint64_t node_id, const ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                         const ScopedMemoryBufferWithSize<EventPathParams> &event_paths)
+{
+    complete(node_id, CHIP_NO_ERROR);
+}
+
+static void on_read_failure(uint64_t node_id, CHIP_ERROR error)
+{
+    complete(node_id, error);
+}
+
+static void start_read(node_t *node)
+{
+    node->in_flight = true;
+    node->start_us = esp_timer_get_time();
+    s_in_flight++;
+
+    ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+    ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+    read_command *cmd = nullptr;
+    attr_paths.Alloc(s_path_count);
+    if (attr_paths.Get()) {
+        memcpy(attr_paths.Get(), s_paths, s_path_count * sizeof(AttributePathParams));
+        cmd = read_command::create(node->node_id, std::move(attr_paths), std::move(event_paths), s_attribute_cb,
+                                   on_read_done, nullptr);
+    }
+    if (!cmd) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the read command");
+        complete(node->node_id, CHIP_ERROR_NO_MEMORY);
+        return;
+    }
+    cmd->set_failure_cb(on_read_failure);
+    // send_command() destroys the command when it fails
+    if (cmd->send_command() != ESP_OK) {
+        complete(node->node_id, CHIP_ERROR_INTERNAL);
+    }
+}
+
+#if CONFIG_ESP_MATTER_CONTROLLER_SUBSCRIPTION_MANAGER_ENABLE
+static bool is_subscribed(node_t *node)
+{
+    subscription_manager::node_stats_t stats;
+    node->stats.subscribed = node->subscription != subscription_manager::k_invalid_subscription_handle &&
+        subscription_manager::get_node_stats(node->node_id, &stats) == ESP_OK && stats.alive;
+    return node->stats.subscribed;
+}
+#endif
+
+static void tick(chip::System::Layer *layer, void *context)
+{
+    int64_t now = esp_timer_get_time();
+    for (size_t count = 0; count < s_node_count; ++count) {
+        node_t *node = &s_nodes[(s_cursor + count) % s_node_count];
+        if (node->in_flight || now < node->next_poll_us) {
+            continue;
+        }
+#if CONFIG_ESP_MATTER_CONTROLLER_SUBSCRIPTION_MANAGER_ENABLE
+        if (is_subscribed(node)) {
+            node->stats.subscribed_skips++;
+            node->next_poll_us = now + (int64_t)s_period_ms * 1000 + random_delay_us(s_jitter_ms);
+            continue;
+        }
+#endif
+        if (s_in_flight >= s_max_concurrent) {
+            node->stats.deferred++;
+            // The next tick starts from the first node which could not be polled
+            s_cursor = (s_cursor + count) % s_node_count;
+            break;
+        }
+        start_read(node);
+    }
+    if (s_running &&
+        chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(k_tick_ms), tick, nullptr) !=
+            CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the poll timer");
+    }
+}
+
+static void free_nodes()
+{
+#if CONFIG_ESP_MATTER_CONTROLLER_SUBSCRIPTION_MANAGER_ENABLE
+    for (size_t idx = 0; idx < s_node_count; ++idx) {
+        if (s_nodes[idx].subscription != subscription_manager::k_invalid_subscription_handle) {
+            subscription_manager::remove(s_nodes[idx].subscription);
+        }
+    }
+#endif
+    esp_matter_mem_free(s_nodes);
+    esp_matter_mem_free(s_paths);
+    s_nodes = nullptr;
+    s_paths = nullptr;
+    s_node_count = 0;
+    s_path_count = 0;
+}
+
+static esp_err_t start_internal(const config_t *config)
+{
+    s_nodes = (node_t *)esp_matter_mem_calloc(config->node_count, sizeof(node_t));
+    s_paths = (AttributePathParams *)esp_matter_mem_calloc(config->attr_path_count, sizeof(AttributePathParams));
+    if (!s_nodes || !s_paths) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the fleet");
+        free_nodes();
+        return ESP_ERR_NO_MEM;
+    }
+    s_node_count = config->node_count;
+    s_path_count = config->attr_path_count;
+    memcpy(s_paths, config->attr_paths, s_path_count * sizeof(AttributePathParams));
+    s_period_ms = config->period_ms;
+    s_jitter_ms = config->jitter_ms;
+    s_max_concurrent =
+        config->max_concurrent > 0 ? config->max_concurrent : CONFIG_ESP_MATTER_CONTROLLER_FLEET_POLLER_MAX_CONCURRENT;
+    s_in_flight = 0;
+    s_cursor = 0;
+
+    int64_t now = esp_timer_get_time();
+    for (size_t idx = 0; idx < s_node_count; ++idx) {
+        node_t *node = &s_nodes[idx];
+        node->node_id = config->node_ids[idx];
+        // Spread the first polls over the period
+        node->next_poll_us = now + random_delay_us(s_period_ms);
+#if CONFIG_ESP_MATTER_CONTROLLER_SUBSCRIPTION_MANAGER_ENABLE
+        if (config->use_subscriptions) {
+            subscription_manager::subscription_desc_t desc = {
+                .node_id = node->node_id,
+                .attr_paths = s_paths,
+                .attr_path_count = s_path_count,
+                .event_paths = nullptr,
+                .event_path_count = 0,
+                .min_interval = 0,
+                .max_interval = config->subscription_max_interval,
+                .persistent = false,
+            };
+            if (subscription_manager::add(&desc, s_attribute_cb, nullptr, &node->subscription) != ESP_OK) {
+                ESP_LOGW(TAG, "Failed to subscribe to node 0x%" PRIx64 ", polling it", node->node_id);
+                node->subscription = subscription_manager::k_invalid_subscription_handle;
+            }
+        }
+#endif
+    }
+    s_running = true;
+    if (chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(k_tick_ms), tick, nullptr) !=
+        CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the poll timer");
+        s_running = false;
+        free_nodes();
+        return ESP_FAIL;
+    }
+    ESP_LOGI(TAG, "Polling %u nodes every %" PRIu32 " ms, %u reads at most in flight", (unsigned)s_node_count,
+             s_period_ms, s_max_concurrent);
+    return ESP_OK;
+}
+
+esp_err_t start(const config_t *config, attribute_report_cb_t attribute_cb, poll_done_cb_t done_cb)
+{
+    ESP_RETURN_ON_FALSE(config && config->node_ids && config->node_count > 0 && config->attr_paths &&
+                            config->attr_path_count > 0 && config->period_ms > 0,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid fleet poller config");
+    ESP_RETURN_ON_FALSE(config->node_count <= CONFIG_ESP_MATTER_CONTROLLER_FLEET_POLLER_MAX_NODES,
+                        ESP_ERR_INVALID_ARG, TAG, "At most %d nodes can be polled",
+                        CONFIG_ESP_MATTER_CONTROLLER_FLEET_POLLER_MAX_NODES);
+#if !CONFIG_ESP_MATTER_CONTROLLER_SUBSCRIPTION_MANAGER_ENABLE
+    if (config->use_subscriptions) {
+        ESP_LOGW(TAG, "The subscription manager is disabled, all the nodes are polled");
+    }
+#endif
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+    if (!s_running) {
+        s_attribute_cb = attribute_cb;
+        s_done_cb = done_cb;
+        err = start_internal(config);
+    } else {
+        ESP_LOGE(TAG, "The fleet poller is already running");
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t stop()
+{
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_ERR_INVALID_STATE;
+    if (s_running) {
+        chip::DeviceLayer::SystemLayer().CancelTimer(tick, nullptr);
+        s_running = false;
+        free_nodes();
+        err = ESP_OK;
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t get_node_stats(uint64_t node_id, node_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "stats cannot be NULL");
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    node_t *node = s_running ? find_node(node_id) : nullptr;
+    if (node) {
+        *stats = node->stats;
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return node ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+void print_stats()
+{
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return;
+    }
+    printf("Fleet poller: %s, %u nodes, %u reads in flight\n", s_running ? "running" : "stopped",
+           (unsigned)s_node_count, s_in_flight);
+    for (size_t idx = 0; idx < s_node_count; ++idx) {
+        const node_stats_t &stats = s_nodes[idx].stats;
+        uint32_t avg_ms = stats.polls > 0 ? stats.total_latency_ms / stats.polls : 0;
+        printf("0x%016" PRIx64 ": polls %" PRIu32 ", failures %" PRIu32 " (%" PRIu32 " in a row), latency last %" PRIu32
+               " avg %" PRIu32 " max %" PRIu32 " ms, deferred %" PRIu32 ", subscribed %s (%" PRIu32 " skipped)\n",
+               s_nodes[idx].node_id, stats.polls, stats.failures, stats.consecutive_failures, stats.last_latency_ms,
+               avg_ms, stats.max_latency_ms, stats.deferred, stats.subscribed ? "yes" : "no", stats.subscribed_skips);
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+}
+
+} // namespace fleet_poller
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,120 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <esp_err.h>
+#include <esp_matter_controller_utils.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace controller {
+namespace fleet_poller {
+
+/*
+ * Fleet poller.
+ *
+ * The poller reads the same attribute paths from a list of nodes periodically. Each node is read at most once at a
+ * time, and at most max_concurrent reads are in flight, so that the CASE sessions of the fleet are established a
+ * few at a time and then reused by the next polls. The first poll of each node is spread over the period, and each
+ * next poll is delayed by a random jitter, so that the nodes are not read in bursts.
+ *
+ * When the subscriptions are enabled, a managed subscription to the paths is added for each node, and the node is
+ * only polled while its subscription is not alive, for example for the nodes which do not support it or while it is
+ * re-established.
+ *
+ * The poller is started and stopped with the Matter stack lock held or from the Matter context, and its callbacks are
+ * called in the Matter context.
+ */
+
+/** Poller configuration, the node ids and the paths are copied */
+typedef struct {
+    const uint64_t *node_ids;
+    size_t node_count;
+    const AttributePathParams *attr_paths;
+    size_t attr_path_count;
+    uint32_t period_ms;
+    /* Maximum random delay added to the period of each poll */
+    uint32_t jitter_ms;
+    /* Maximum reads in flight, 0 for CONFIG_ESP_MATTER_CONTROLLER_FLEET_POLLER_MAX_CONCURRENT */
+    uint16_t max_concurrent;
+    /* Subscribe to the paths with the subscription manager, and poll the nodes whose subscription is not alive */
+    bool use_subscriptions;
+    uint16_t subscription_max_interval;
+} config_t;
+
+/** Poll statistics of a node */
+typedef struct {
+    uint32_t polls;
+    uint32_t failures;
+    uint32_t consecutive_failures;
+    /* Matter error of the last failure */
+    uint32_t last_error;
+    uint32_t last_latency_ms;
+    uint32_t max_latency_ms;
+    uint32_t total_latency_ms;
+    /* Polls not sent because the subscription of the node was alive */
+    uint32_t subscribed_skips;
+    /* Polls delayed because max_concurrent reads were in flight */
+    uint32_t deferred;
+    bool subscribed;
+} node_stats_t;
+
+/**
+ * @brief Callback called when a poll of a node is done.
+ *
+ * @param node_id Node id
+ * @param err ESP_OK if the read succeeded, ESP_FAIL otherwise
+ * @param latency_ms Time from the start of the read, including the session establishment, to its end
+ */
+using poll_done_cb_t = void (*)(uint64_t node_id, esp_err_t err, uint32_t latency_ms);
+
+/**
+ * @brief Starts polling the nodes.
+ *
+ * @param config Poller configuration
+ * @param attribute_cb Callback of the attribute data of the polls and of the subscriptions, can be NULL to log it
+ * @param done_cb Callback called when a poll is done, can be NULL
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the poller is already running, appropriate error code otherwise
+ */
+esp_err_t start(const config_t *config, attribute_report_cb_t attribute_cb, poll_done_cb_t done_cb);
+
+/**
+ * @brief Stops polling the nodes and removes their subscriptions. The reads in flight are not reported.
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the poller is not running
+ */
+esp_err_t stop();
+
+/**
+ * @brief Gets the poll statistics of a node.
+ *
+ * @param node_id Node id
+ * @param stats Statistics
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the node is not polled
+ */
+esp_err_t get_node_stats(uint64_t node_id, node_stats_t *stats);
+
+/**
+ * @brief Prints the poll statistics of the nodes.
+ */
+void print_stats();
+
+} // namespace fleet_poller
+} // namespace controller
+} // namespace esp_matter
@@ -16,6 +16,7 @@
 #include <esp_matter_commissioner.h>
 #include <esp_matter_controller_group_settings.h>
 #include <esp_matter_controller_utils.h>
+#include <lib/support/ScopedBuffer.h>
 
 using chip::FabricIndex;
 using chip::KeysetId;
@@ -27,21 +28,39 @@ namespace esp_matter {
 namespace controller {
 namespace group_settings {
 
-static bool find_keyset_id(FabricIndex fabric_index, uint16_t group_id, KeysetId &keyset_id)
-{
-    GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
-    auto iter = group_data_provider->IterateGroupKeys(fabric_index);
-    GroupDataProvider::GroupKey group_key;
-    while (iter->Next(group_key)) {
-        if (group_key.group_id == group_id) {
-            keyset_id = group_key.keyset_id;
-            iter->Release();
-            return true;
+/* Group key map of the fabric, read once from the storage for the lookups of all the groups */
+class group_key_map {
+public:
+    group_key_map(FabricIndex fabric_index)
+    {
+        GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
+        auto iter = group_data_provider->IterateGroupKeys(fabric_index);
+        if (!iter) {
+            return;
+        }
+        if (m_keys.Calloc(iter->Count())) {
+            while (m_count < m_keys.AllocatedSize() && iter->Next(m_keys[m_count])) {
+                m_count++;
+            }
         }
+        iter->Release();
     }
-    iter->Release();
-    return false;
-}
+
+    bool find_keyset_id(uint16_t group_id, KeysetId &keyset_id) const
+    {
+        for (size_t idx = 0; idx < m_count; ++idx) {
+            if (m_keys[idx].group_id == group_id) {
+                keyset_id = m_keys[idx].keyset_id;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    chip::Platform::ScopedMemoryBuffer<GroupDataProvider::GroupKey> m_keys;
+    size_t m_count = 0;
+};
 
 esp_err_t show_groups()
 {
@@ -51,12 +70,13 @@ esp_err_t show_groups()
     ESP_LOGI(TAG, "  | Group Id   |  KeySet Id     |   Group Name                                          |");
     FabricIndex fabric_index = commissioner::get_device_commissioner()->GetFabricIndex();
     GroupDataProvider *group_data_provider = chip::Credentials::GetGroupDataProvider();
+    group_key_map key_map(fabric_index);
     auto iter = group_data_provider->IterateGroupInfo(fabric_index);
     GroupDataProvider::GroupInfo group_info;
     if (iter) {
         while (iter->Next(group_info)) {
             chip::KeysetId keyset_id;
-            if (find_keyset_id(fabric_index, group_info.group_id, keyset_id)) {
+            if (key_map.find_keyset_id(group_info.group_id, keyset_id)) {
                 ESP_LOGI(TAG, "  | 0x%-12x  0x%-13x  %-50s |", group_info.group_id, keyset_id, group_info.name);
             } else {
                 ESP_LOGI(TAG, "  | 0x%-12x  %-15s  %-50s |", group_info.group_id, "None", group_info.name);
@@ -0,0 +1,757 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <app/BufferedReadCallback.h>
+#include <app/InteractionModelEngine.h>
+#include <app/ReadClient.h>
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_matter_mem.h>
+#include <esp_timer.h>
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+#include <esp_matter_commissioner.h>
+#else
+#include <app/server/Server.h>
+#endif
+#include <esp_matter_controller_node_composition.h>
+#include <esp_matter_controller_utils.h>
+#include <lib/support/CHIPMem.h>
+#include <nvs.h>
+#include <string.h>
+
+using chip::ClusterId;
+using chip::DataVersion;
+using chip::DeviceTypeId;
+using chip::EndpointId;
+using chip::ScopedNodeId;
+using chip::SessionHandle;
+using chip::app::AttributePathParams;
+using chip::app::BufferedReadCallback;
+using chip::app::ConcreteDataAttributePath;
+using chip::app::DataVersionFilter;
+using chip::app::InteractionModelEngine;
+using chip::app::ReadClient;
+using chip::app::ReadPrepareParams;
+using chip::Messaging::ExchangeManager;
+using chip::TLV::TLVReader;
+
+static const char *TAG = "node_composition";
+
+#define COMPOSITION_NVS_NAMESPACE "esp_matter_comp"
+#define COMPOSITION_PERSISTED_VERSION 1
+/* Delay of the NVS writes, so that the attributes of a report are written at once */
+#define COMPOSITION_FLUSH_DELAY_MS 1000
+
+namespace esp_matter {
+namespace controller {
+namespace node_composition {
+
+static constexpr ClusterId k_descriptor_cluster_id = 0x001D;
+static constexpr chip::AttributeId k_device_type_list_id = 0x0000;
+static constexpr chip::AttributeId k_server_list_id = 0x0001;
+static constexpr chip::AttributeId k_parts_list_id = 0x0003;
+static constexpr size_t k_max_nodes = CONFIG_ESP_MATTER_CONTROLLER_NODE_COMPOSITION_CACHE_MAX_NODES;
+static constexpr size_t k_max_endpoints = CONFIG_ESP_MATTER_CONTROLLER_NODE_COMPOSITION_CACHE_MAX_ENDPOINTS;
+/* Larger lists are not cached */
+static constexpr size_t k_max_list_count = 128;
+
+enum : uint8_t {
+    ENDPOINT_FLAG_HAS_VERSION = 1 << 0,
+    ENDPOINT_FLAG_DEVICE_TYPES = 1 << 1,
+    ENDPOINT_FLAG_SERVER_LIST = 1 << 2,
+};
+
+typedef struct endpoint_entry {
+    struct endpoint_entry *next;
+    EndpointId endpoint_id;
+    uint8_t flags;
+    uint8_t device_type_count;
+    uint16_t cluster_count;
+    DataVersion version;
+    DeviceTypeId *device_types;
+    ClusterId *clusters;
+} endpoint_entry_t;
+
+typedef struct node_entry {
+    struct node_entry *next;
+    uint64_t node_id;
+    int64_t last_used_us;
+    /* The parts list of the root endpoint is known, so the endpoint list is complete */
+    bool parts_list_known;
+    bool dirty;
+    endpoint_entry_t *endpoints;
+} node_entry_t;
+
+/* Records of the persisted blob, a node header followed by the endpoints and their lists */
+typedef struct {
+    uint8_t version;
+    uint8_t parts_list_known;
+    uint16_t endpoint_count;
+    uint64_t node_id;
+} persisted_node_t;
+
+typedef struct {
+    uint16_t endpoint_id;
+    uint8_t flags;
+    uint8_t device_type_count;
+    uint16_t cluster_count;
+    uint32_t version;
+} persisted_endpoint_t;
+
+static node_entry_t *s_nodes = nullptr;
+static size_t s_node_count = 0;
+static bool s_flush_scheduled = false;
+
+static void get_nvs_key(uint64_t node_id, char *key, size_t size)
+{
+    // The NVS keys are limited to 15 characters, the node ID in the blob resolves the key collisions
+    snprintf(key, size, "n%014llx", (unsigned long long)(node_id & 0x00FFFFFFFFFFFFFFULL));
+}
+
+static void free_endpoint(endpoint_entry_t *endpoint)
+{
+    esp_matter_mem_free(endpoint->device_types);
+    esp_matter_mem_free(endpoint->clusters);
+    esp_matter_mem_free(endpoint);
+}
+
+static void free_node(node_entry_t *node)
+{
+    while (node->endpoints) {
+        endpoint_entry_t *endpoint = node->endpoints;
+        node->endpoints = endpoint->next;
+        free_endpoint(endpoint);
+    }
+    esp_matter_mem_free(node);
+}
+
+static size_t get_endpoint_count(const node_entry_t *node)
+{
+    size_t count = 0;
+    for (const endpoint_entry_t *endpoint = node->endpoints; endpoint; endpoint = endpoint->next) {
+        count++;
+    }
+    return count;
+}
+
+static esp_err_t store_node(node_entry_t *node)
+{
+    size_t size = sizeof(persisted_node_t);
+    for (const endpoint_entry_t *endpoint = node->endpoints; endpoint; endpoint = endpoint->next) {
+        size += sizeof(persisted_endpoint_t) + endpoint->device_type_count * sizeof(DeviceTypeId) +
+            endpoint->cluster_count * sizeof(ClusterId);
+    }
+    uint8_t *blob = (uint8_t *)esp_matter_mem_calloc(1, size);
+    if (!blob) {
+        return ESP_ERR_NO_MEM;
+    }
+    persisted_node_t header = {
+        .version = COMPOSITION_PERSISTED_VERSION,
+        .parts_list_known = node->parts_list_known,
+        .endpoint_count = (uint16_t)get_endpoint_count(node),
+        .node_id = node->node_id,
+    };
+    uint8_t *ptr = blob;
+    memcpy(ptr, &header, sizeof(header));
+    ptr += sizeof(header);
+    for (const endpoint_entry_t *endpoint = node->endpoints; endpoint; endpoint = endpoint->next) {
+        persisted_endpoint_t record = {
+            .endpoint_id = endpoint->endpoint_id,
+            .flags = endpoint->flags,
+            .device_type_count = endpoint->device_type_count,
+            .cluster_count = endpoint->cluster_count,
+            .version = endpoint->version,
+        };
+        memcpy(ptr, &record, sizeof(record));
+        ptr += sizeof(record);
+        memcpy(ptr, endpoint->device_types, endpoint->device_type_count * sizeof(DeviceTypeId));
+        ptr += endpoint->device_type_count * sizeof(DeviceTypeId);
+        memcpy(ptr, endpoint->clusters, endpoint->cluster_count * sizeof(ClusterId));
+        ptr += endpoint->cluster_count * sizeof(ClusterId);
+    }
+    char key[16];
+    get_nvs_key(node->node_id, key, sizeof(key));
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, COMPOSITION_NVS_NAMESPACE, NVS_READWRITE,
+                                            &handle);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(handle, key, blob, size);
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    esp_matter_mem_free(blob);
+    return err;
+}
+
+static void flush_nodes(chip::System::Layer *layer, void *ctx)
+{
+    s_flush_scheduled = false;
+    for (node_entry_t *node = s_nodes; node; node = node->next) {
+        if (node->dirty) {
+            esp_err_t err = store_node(node);
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to store the composition of node 0x%llx: %s", node->node_id,
+                         esp_err_to_name(err));
+            }
+            node->dirty = false;
+        }
+    }
+}
+
+static void mark_dirty(node_entry_t *node)
+{
+    node->dirty = true;
+    if (!s_flush_scheduled &&
+        chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(COMPOSITION_FLUSH_DELAY_MS),
+                                                    flush_nodes, nullptr) == CHIP_NO_ERROR) {
+        s_flush_scheduled = true;
+    }
+}
+
+static endpoint_entry_t *add_endpoint(node_entry_t *node, EndpointId endpoint_id)
+{
+    if (get_endpoint_count(node) >= k_max_endpoints) {
+        ESP_LOGW(TAG, "Node 0x%llx has too many endpoints, endpoint %u is not cached", node->node_id, endpoint_id);
+        return nullptr;
+    }
+    endpoint_entry_t *endpoint = (endpoint_entry_t *)esp_matter_mem_calloc(1, sizeof(endpoint_entry_t));
+    if (endpoint) {
+        endpoint->endpoint_id = endpoint_id;
+        endpoint->next = node->endpoints;
+        node->endpoints = endpoint;
+    }
+    return endpoint;
+}
+
+static node_entry_t *load_node(uint64_t node_id)
+{
+    char key[16];
+    get_nvs_key(node_id, key, sizeof(key));
+    nvs_handle_t handle;
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, COMPOSITION_NVS_NAMESPACE, NVS_READONLY, &handle) !=
+        ESP_OK) {
+        return nullptr;
+    }
+    size_t size = 0;
+    uint8_t *blob = nullptr;
+    node_entry_t *node = nullptr;
+    if (nvs_get_blob(handle, key, nullptr, &size) == ESP_OK && size >= sizeof(persisted_node_t)) {
+        blob = (uint8_t *)esp_matter_mem_calloc(1, size);
+    }
+    if (blob && nvs_get_blob(handle, key, blob, &size) == ESP_OK) {
+        persisted_node_t header;
+        memcpy(&header, blob, sizeof(header));
+        if (header.version == COMPOSITION_PERSISTED_VERSION && header.node_id == node_id) {
+            node = (node_entry_t *)esp_matter_mem_calloc(1, sizeof(node_entry_t));
+        }
+        if (node) {
+            node->node_id = node_id;
+            node->parts_list_known = header.parts_list_known;
+            const uint8_t *ptr = blob + sizeof(header);
+            const uint8_t *end = blob + size;
+            for (uint16_t index = 0; index < header.endpoint_count; index++) {
+                persisted_endpoint_t record;
+                if (ptr + sizeof(record) > end) {
+                    break;
+                }
+                memcpy(&record, ptr, sizeof(record));
+                ptr += sizeof(record);
+                size_t device_types_size = record.device_type_count * sizeof(DeviceTypeId);
+                size_t clusters_size = record.cluster_count * sizeof(ClusterId);
+                if (ptr + device_types_size + clusters_size > end) {
+                    break;
+                }
+                endpoint_entry_t *endpoint = add_endpoint(node, record.endpoint_id);
+                if (!endpoint) {
+                    break;
+                }
+                endpoint->flags = record.flags;
+                endpoint->version = record.version;
+                endpoint->device_types = (DeviceTypeId *)esp_matter_mem_calloc(1, device_types_size ? device_types_size : 1);
+                endpoint->clusters = (ClusterId *)esp_matter_mem_calloc(1, clusters_size ? clusters_size : 1);
+                if (!endpoint->device_types || !endpoint->clusters) {
+                    endpoint->flags &= ~(ENDPOINT_FLAG_DEVICE_TYPES | ENDPOINT_FLAG_SERVER_LIST);
+                } else {
+                    memcpy(endpoint->device_types, ptr, device_types_size);
+                    memcpy(endpoint->clusters, ptr + device_types_size, clusters_size);
+                    endpoint->device_type_count = record.device_type_count;
+                    endpoint->cluster_count = record.cluster_count;
+                }
+                ptr += device_types_size + clusters_size;
+            }
+        }
+    }
+    esp_matter_mem_free(blob);
+    nvs_close(handle);
+    return node;
+}
+
+static void evict_oldest_node()
+{
+    node_entry_t **oldest = &s_nodes;
+    for (node_entry_t **link = &s_nodes; *link; link = &(*link)->next) {
+        if ((*link)->last_used_us < (*oldest)->last_used_us) {
+            oldest = link;
+        }
+    }
+    node_entry_t *node = *oldest;
+    if (node->dirty && store_node(node) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store the composition of node 0x%llx", node->node_id);
+    }
+    *oldest = node->next;
+    s_node_count--;
+    free_node(node);
+}
+
+/* Finds the node in RAM, then in NVS, and creates it if create is set */
+static node_entry_t *get_node(uint64_t node_id, bool create)
+{
+    node_entry_t *node = s_nodes;
+    while (node && node->node_id != node_id) {
+        node = node->next;
+    }
+    if (!node) {
+        node = load_node(node_id);
+        if (!node && create) {
+            node = (node_entry_t *)esp_matter_mem_calloc(1, sizeof(node_entry_t));
+            if (node) {
+                node->node_id = node_id;
+            }
+        }
+        if (!node) {
+            return nullptr;
+        }
+        if (s_node_count >= k_max_nodes) {
+            evict_oldest_node();
+        }
+        node->next = s_nodes;
+        s_nodes = node;
+        s_node_count++;
+    }
+    node->last_used_us = esp_timer_get_time();
+    return node;
+}
+
+static endpoint_entry_t *get_endpoint(node_entry_t *node, EndpointId endpoint_id)
+{
+    endpoint_entry_t *endpoint = node->endpoints;
+    while (endpoint && endpoint->endpoint_id != endpoint_id) {
+        endpoint = endpoint->next;
+    }
+    return endpoint;
+}
+
+/* Decodes a list of unsigned integers, or of structures whose field 0 is an unsigned integer */
+template <typename T>
+static esp_err_t decode_id_list(TLVReader *data, bool struct_items, T **out_ids, size_t *out_count)
+{
+    TLVReader reader;
+    reader.Init(*data);
+    chip::TLV::TLVType outer_type;
+    if (reader.GetType() != chip::TLV::kTLVType_Array || reader.EnterContainer(outer_type) != CHIP_NO_ERROR) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    T ids[k_max_list_count];
+    size_t count = 0;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    while ((err = reader.Next()) == CHIP_NO_ERROR) {
+        if (count >= k_max_list_count) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        if (!struct_items) {
+            if (reader.Get(ids[count]) != CHIP_NO_ERROR) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            count++;
+            continue;
+        }
+        chip::TLV::TLVType struct_type;
+        if (reader.GetType() != chip::TLV::kTLVType_Structure || reader.EnterContainer(struct_type) != CHIP_NO_ERROR) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        bool found = false;
+        while (reader.Next() == CHIP_NO_ERROR) {
+            if (reader.GetTag() == chip::TLV::ContextTag(0) && reader.Get(ids[count]) == CHIP_NO_ERROR) {
+                found = true;
+            }
+        }
+        if (reader.ExitContainer(struct_type) != CHIP_NO_ERROR || !found) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        count++;
+    }
+    if (err != CHIP_END_OF_TLV) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    T *list = (T *)esp_matter_mem_calloc(1, count ? count * sizeof(T) : 1);
+    if (!list) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(list, ids, count * sizeof(T));
+    *out_ids = list;
+    *out_count = count;
+    return ESP_OK;
+}
+
+static void update_parts_list(node_entry_t *node, TLVReader *data)
+{
+    EndpointId *parts = nullptr;
+    size_t count = 0;
+    if (decode_id_list(data, false, &parts, &count) != ESP_OK) {
+        node->parts_list_known = false;
+        return;
+    }
+    // Drop the endpoints which are gone, and add the new ones without their attributes
+    endpoint_entry_t **link = &node->endpoints;
+    while (*link) {
+        endpoint_entry_t *endpoint = *link;
+        bool found = endpoint->endpoint_id == 0;
+        for (size_t index = 0; index < count && !found; index++) {
+            found = parts[index] == endpoint->endpoint_id;
+        }
+        if (found) {
+            link = &endpoint->next;
+        } else {
+            *link = endpoint->next;
+            free_endpoint(endpoint);
+        }
+    }
+    bool complete = true;
+    for (size_t index = 0; index < count; index++) {
+        if (!get_endpoint(node, parts[index]) && !add_endpoint(node, parts[index])) {
+            complete = false;
+        }
+    }
+    node->parts_list_known = complete;
+    esp_matter_mem_free(parts);
+}
+
+void on_attribute_data(uint64_t node_id, const ConcreteDataAttributePath &path, TLVReader *data)
+{
+    if (path.mClusterId != k_descriptor_cluster_id ||
+        (path.mAttributeId != k_device_type_list_id && path.mAttributeId != k_server_list_id &&
+         path.mAttributeId != k_parts_list_id)) {
+        return;
+    }
+    node_entry_t *node = get_node(node_id, true);
+    if (!node) {
+        return;
+    }
+    endpoint_entry_t *endpoint = get_endpoint(node, path.mEndpointId);
+    if (!endpoint && !(endpoint = add_endpoint(node, path.mEndpointId))) {
+        return;
+    }
+    if (path.mDataVersion.HasValue() &&
+        (!(endpoint->flags & ENDPOINT_FLAG_HAS_VERSION) || endpoint->version != path.mDataVersion.Value())) {
+        // The Descriptor cluster changed, the other cached attributes of the endpoint are stale
+        endpoint->flags = ENDPOINT_FLAG_HAS_VERSION;
+        endpoint->version = path.mDataVersion.Value();
+        if (path.mEndpointId == 0) {
+            node->parts_list_known = false;
+        }
+    } else if (!path.mDataVersion.HasValue()) {
+        endpoint->flags &= ~ENDPOINT_FLAG_HAS_VERSION;
+    }
+    if (!data || path.IsListItemOperation()) {
+        // Only the complete lists are cached
+        if (path.mAttributeId == k_device_type_list_id) {
+            endpoint->flags &= ~ENDPOINT_FLAG_DEVICE_TYPES;
+        } else if (path.mAttributeId == k_server_list_id) {
+            endpoint->flags &= ~ENDPOINT_FLAG_SERVER_LIST;
+        } else if (path.mEndpointId == 0) {
+            node->parts_list_known = false;
+        }
+        mark_dirty(node);
+        return;
+    }
+    if (path.mAttributeId == k_device_type_list_id) {
+        DeviceTypeId *device_types = nullptr;
+        size_t count = 0;
+        endpoint->flags &= ~ENDPOINT_FLAG_DEVICE_TYPES;
+        if (decode_id_list(data, true, &device_types, &count) == ESP_OK && count <= UINT8_MAX) {
+            esp_matter_mem_free(endpoint->device_types);
+            endpoint->device_types = device_types;
+            endpoint->device_type_count = (uint8_t)count;
+            endpoint->flags |= ENDPOINT_FLAG_DEVICE_TYPES;
+        } else {
+            esp_matter_mem_free(device_types);
+        }
+    } else if (path.mAttributeId == k_server_list_id) {
+        ClusterId *clusters = nullptr;
+        size_t count = 0;
+        endpoint->flags &= ~ENDPOINT_FLAG_SERVER_LIST;
+        if (decode_id_list(data, false, &clusters, &count) == ESP_OK) {
+            esp_matter_mem_free(endpoint->clusters);
+            endpoint->clusters = clusters;
+            endpoint->cluster_count = (uint16_t)count;
+            endpoint->flags |= ENDPOINT_FLAG_SERVER_LIST;
+        }
+    } else if (path.mEndpointId == 0) {
+        update_parts_list(node, data);
+    }
+    mark_dirty(node);
+}
+
+template <typename T>
+static esp_err_t copy_ids(const T *ids, size_t id_count, T *out_ids, size_t *count)
+{
+    size_t capacity = *count;
+    *count = id_count;
+    if (id_count > capacity || (id_count > 0 && !out_ids)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(out_ids, ids, id_count * sizeof(T));
+    return ESP_OK;
+}
+
+static esp_err_t collect_endpoints(uint64_t node_id, bool filter_cluster, ClusterId cluster_id,
+                                   EndpointId *endpoint_ids, size_t *count)
+{
+    if (!count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    node_entry_t *node = get_node(node_id, false);
+    if (!node || !node->parts_list_known) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    size_t capacity = *count;
+    size_t found = 0;
+    for (const endpoint_entry_t *endpoint = node->endpoints; endpoint; endpoint = endpoint->next) {
+        if (endpoint->endpoint_id == 0 && !filter_cluster) {
+            continue;
+        }
+        if (filter_cluster) {
+            if (!(endpoint->flags & ENDPOINT_FLAG_SERVER_LIST)) {
+                return ESP_ERR_NOT_FOUND;
+            }
+            bool has_cluster = false;
+            for (uint16_t index = 0; index < endpoint->cluster_count && !has_cluster; index++) {
+                has_cluster = endpoint->clusters[index] == cluster_id;
+            }
+            if (!has_cluster) {
+                continue;
+            }
+        }
+        if (found < capacity && endpoint_ids) {
+            endpoint_ids[found] = endpoint->endpoint_id;
+        }
+        found++;
+    }
+    *count = found;
+    return found > capacity ? ESP_ERR_INVALID_SIZE : ESP_OK;
+}
+
+esp_err_t get_endpoints(uint64_t node_id, EndpointId *endpoint_ids, size_t *count)
+{
+    return collect_endpoints(node_id, false, 0, endpoint_ids, count);
+}
+
+esp_err_t find_endpoints(uint64_t node_id, ClusterId cluster_id, EndpointId *endpoint_ids, size_t *count)
+{
+    return collect_endpoints(node_id, true, cluster_id, endpoint_ids, count);
+}
+
+esp_err_t get_server_clusters(uint64_t node_id, EndpointId endpoint_id, ClusterId *cluster_ids, size_t *count)
+{
+    if (!count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    node_entry_t *node = get_node(node_id, false);
+    endpoint_entry_t *endpoint = node ? get_endpoint(node, endpoint_id) : nullptr;
+    if (!endpoint || !(endpoint->flags & ENDPOINT_FLAG_SERVER_LIST)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return copy_ids(endpoint->clusters, endpoint->cluster_count, cluster_ids, count);
+}
+
+esp_err_t get_device_types(uint64_t node_id, EndpointId endpoint_id, DeviceTypeId *device_type_ids, size_t *count)
+{
+    if (!count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    node_entry_t *node = get_node(node_id, false);
+    endpoint_entry_t *endpoint = node ? get_endpoint(node, endpoint_id) : nullptr;
+    if (!endpoint || !(endpoint->flags & ENDPOINT_FLAG_DEVICE_TYPES)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return copy_ids(endpoint->device_types, endpoint->device_type_count, device_type_ids, count);
+}
+
+void invalidate_node(uint64_t node_id)
+{
+    for (node_entry_t **link = &s_nodes; *link; link = &(*link)->next) {
+        if ((*link)->node_id == node_id) {
+            node_entry_t *node = *link;
+            *link = node->next;
+            s_node_count--;
+            free_node(node);
+            break;
+        }
+    }
+    char key[16];
+    get_nvs_key(node_id, key, sizeof(key));
+    nvs_handle_t handle;
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, COMPOSITION_NVS_NAMESPACE, NVS_READWRITE, &handle) ==
+        ESP_OK) {
+        if (nvs_erase_key(handle, key) == ESP_OK) {
+            nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+}
+
+/* Read of the Descriptor clusters of a node, with the data versions of the cached endpoints */
+class sync_command : public ReadClient::Callback {
+public:
+    sync_command(uint64_t node_id, sync_done_cb_t done_cb)
+        : m_node_id(node_id)
+        , m_buffered_read_cb(*this)
+        , m_path(k_descriptor_cluster_id)
+        , m_done_cb(done_cb)
+        , on_device_connected_cb(on_device_connected_fcn, this)
+        , on_device_connection_failure_cb(on_device_connection_failure_fcn, this)
+    {
+    }
+
+    esp_err_t send_command()
+    {
+        node_entry_t *node = get_node(m_node_id, false);
+        size_t filter_count = 0;
+        if (node) {
+            for (const endpoint_entry_t *endpoint = node->endpoints; endpoint; endpoint = endpoint->next) {
+                // Only the complete endpoints can be skipped
+                filter_count += (endpoint->flags == (ENDPOINT_FLAG_HAS_VERSION | ENDPOINT_FLAG_DEVICE_TYPES |
+                                                     ENDPOINT_FLAG_SERVER_LIST)) ? 1 : 0;
+            }
+        }
+        if (filter_count > 0 && m_filters.Alloc(filter_count)) {
+            size_t index = 0;
+            for (const endpoint_entry_t *endpoint = node->endpoints; endpoint; endpoint = endpoint->next) {
+                if (endpoint->flags ==
+                    (ENDPOINT_FLAG_HAS_VERSION | ENDPOINT_FLAG_DEVICE_TYPES | ENDPOINT_FLAG_SERVER_LIST)) {
+                    m_filters[index++] =
+                        DataVersionFilter(endpoint->endpoint_id, k_descriptor_cluster_id, endpoint->version);
+                }
+            }
+        }
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+        if (CHIP_NO_ERROR ==
+            commissioner::get_device_commissioner()->GetConnectedDevice(m_node_id, &on_device_connected_cb,
+                                                                        &on_device_connection_failure_cb)) {
+            return ESP_OK;
+        }
+        chip::Platform::Delete(this);
+        return ESP_FAIL;
+#else
+        chip::Server::GetInstance().GetCASESessionManager()->FindOrEstablishSession(
+            ScopedNodeId(m_node_id, get_fabric_index()), &on_device_connected_cb, &on_device_connection_failure_cb);
+        return ESP_OK;
+#endif
+    }
+
+    void OnAttributeData(const ConcreteDataAttributePath &path, TLVReader *data,
+                         const chip::app::StatusIB &status) override
+    {
+        if (status.ToChipError() != CHIP_NO_ERROR || !data) {
+            return;
+        }
+        on_attribute_data(m_node_id, path, data);
+    }
+
+    void OnError(CHIP_ERROR error) override
+    {
+        ESP_LOGE(TAG, "Failed to sync the composition of node 0x%llx: %s", m_node_id, chip::ErrorStr(error));
+        m_error = ESP_FAIL;
+    }
+
+    void OnDeallocatePaths(ReadPrepareParams &&aReadPrepareParams) override
+    {
+        // The paths and the filters are deleted with the command
+    }
+
+    void OnDone(ReadClient *apReadClient) override
+    {
+        ESP_LOGI(TAG, "Synced the composition of node 0x%llx, %u endpoints skipped", m_node_id,
+                 (unsigned)m_filters.AllocatedSize());
+        done(m_error);
+        chip::Platform::Delete(apReadClient);
+        chip::Platform::Delete(this);
+    }
+
+private:
+    void done(esp_err_t err)
+    {
+        if (m_done_cb) {
+            m_done_cb(m_node_id, err);
+        }
+    }
+
+    static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
+                                        const SessionHandle &sessionHandle)
+    {
+        sync_command *cmd = (sync_command *)context;
+        ReadPrepareParams params(sessionHandle);
+        params.mpAttributePathParamsList = &cmd->m_path;
+        params.mAttributePathParamsListSize = 1;
+        params.mpDataVersionFilterList = cmd->m_filters.Get();
+        params.mDataVersionFilterListSize = cmd->m_filters.AllocatedSize();
+        params.mIsFabricFiltered = 0;
+        ReadClient *client = chip::Platform::New<ReadClient>(InteractionModelEngine::GetInstance(), &exchangeMgr,
+                                                             cmd->m_buffered_read_cb, ReadClient::InteractionType::Read);
+        if (!client) {
+            ESP_LOGE(TAG, "Failed to alloc memory for read client");
+            cmd->done(ESP_ERR_NO_MEM);
+            chip::Platform::Delete(cmd);
+            return;
+        }
+        if (CHIP_NO_ERROR != client->SendRequest(params)) {
+            ESP_LOGE(TAG, "Failed to send read request");
+            cmd->done(ESP_FAIL);
+            chip::Platform::Delete(client);
+            chip::Platform::Delete(cmd);
+        }
+    }
+
+    static void on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
+    {
+        sync_command *cmd = (sync_command *)context;
+        cmd->done(ESP_ERR_TIMEOUT);
+        chip::Platform::Delete(cmd);
+    }
+
+    uint64_t m_node_id;
+    BufferedReadCallback m_buffered_read_cb;
+    AttributePathParams m_path;
+    chip::Platform::ScopedMemoryBufferWithSize<DataVersionFilter> m_filters;
+    sync_done_cb_t m_done_cb;
+    esp_err_t m_error = ESP_OK;
+    chip::Callback::Callback<chip::OnDeviceConnected> on_device_connected_cb;
+    chip::Callback::Callback<chip::OnDeviceConnectionFailure> on_device_connection_failure_cb;
+};
+
+esp_err_t sync(uint64_t node_id, sync_done_cb_t done_cb)
+{
+    sync_command *cmd = chip::Platform::New<sync_command>(node_id, done_cb);
+    if (!cmd) {
+        ESP_LOGE(TAG, "Failed to alloc memory for sync_command");
+        return ESP_ERR_NO_MEM;
+    }
+    return cmd->send_command();
+}
+
+} // namespace node_composition
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,144 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <esp_err.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/TLVReader.h>
+#include <sdkconfig.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace controller {
+namespace node_composition {
+
+/*
+ * Node composition cache.
+ *
+ * The cache keeps the endpoints of the remote nodes, with the device types and the server clusters of each endpoint,
+ * from the Descriptor cluster attributes received by the read and subscribe commands. The compositions are stored in
+ * NVS, so the controller commands can resolve their targets locally after a reboot. Each endpoint keeps the data
+ * version of its Descriptor cluster. A report with another data version drops the other cached attributes of the
+ * endpoint, and sync() reads the Descriptor clusters with DataVersionFilters, so that only the endpoints which changed
+ * are sent again.
+ *
+ * All the functions must be called in the Matter context, or with the Matter stack lock held.
+ */
+
+typedef void (*sync_done_cb_t)(uint64_t node_id, esp_err_t err);
+
+#if CONFIG_ESP_MATTER_CONTROLLER_NODE_COMPOSITION_CACHE_ENABLE
+/**
+ * @brief Updates the composition of a node with a reported attribute, the attributes of the other clusters than the
+ * Descriptor cluster are ignored.
+ *
+ * @param node_id Remote node ID
+ * @param path    Attribute path, with the data version of the cluster
+ * @param data    Attribute value, positioned on the element
+ */
+void on_attribute_data(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                       chip::TLV::TLVReader *data);
+
+/**
+ * @brief Gets the endpoints of a node, except the root endpoint.
+ *
+ * @param node_id      Remote node ID
+ * @param endpoint_ids Endpoint IDs
+ * @param count        Size of endpoint_ids, set to the number of endpoints
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the parts list of the node is not cached, ESP_ERR_INVALID_SIZE if
+ * endpoint_ids is too small
+ */
+esp_err_t get_endpoints(uint64_t node_id, chip::EndpointId *endpoint_ids, size_t *count);
+
+/**
+ * @brief Gets the endpoints of a node having a server cluster.
+ *
+ * @param node_id      Remote node ID
+ * @param cluster_id   Cluster ID
+ * @param endpoint_ids Endpoint IDs
+ * @param count        Size of endpoint_ids, set to the number of endpoints
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the server lists of the endpoints are not all cached,
+ * ESP_ERR_INVALID_SIZE if endpoint_ids is too small
+ */
+esp_err_t find_endpoints(uint64_t node_id, chip::ClusterId cluster_id, chip::EndpointId *endpoint_ids, size_t *count);
+
+/**
+ * @brief Gets the server clusters of an endpoint.
+ *
+ * @param node_id     Remote node ID
+ * @param endpoint_id Endpoint ID
+ * @param cluster_ids Cluster IDs
+ * @param count       Size of cluster_ids, set to the number of clusters
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the server list is not cached, ESP_ERR_INVALID_SIZE if cluster_ids
+ * is too small
+ */
+esp_err_t get_server_clusters(uint64_t node_id, chip::EndpointId endpoint_id, chip::ClusterId *cluster_ids,
+                              size_t *count);
+
+/**
+ * @brief Gets the device types of an endpoint.
+ *
+ * @param node_id         Remote node ID
+ * @param endpoint_id     Endpoint ID
+ * @param device_type_ids Device type IDs
+ * @param count           Size of device_type_ids, set to the number of device types
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the device type list is not cached, ESP_ERR_INVALID_SIZE if
+ * device_type_ids is too small
+ */
+esp_err_t get_device_types(uint64_t node_id, chip::EndpointId endpoint_id, chip::DeviceTypeId *device_type_ids,
+                           size_t *count);
+
+/**
+ * @brief Reads the Descriptor clusters of a node, with DataVersionFilters for the cached endpoints.
+ *
+ * @param node_id Remote node ID
+ * @param done_cb Callback called when the composition is up to date, can be NULL
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t sync(uint64_t node_id, sync_done_cb_t done_cb);
+
+/**
+ * @brief Drops the composition of a node, from RAM and NVS.
+ *
+ * @param node_id Remote node ID
+ */
+void invalidate_node(uint64_t node_id);
+#else
+inline void on_attribute_data(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                              chip::TLV::TLVReader *data) {}
+inline esp_err_t get_endpoints(uint64_t node_id, chip::EndpointId *endpoint_ids, size_t *count)
+{
+    return ESP_ERR_NOT_FOUND;
+}
+inline esp_err_t find_endpoints(uint64_t node_id, chip::ClusterId cluster_id, chip::EndpointId *endpoint_ids,
+                                size_t *count) { return ESP_ERR_NOT_FOUND; }
+inline esp_err_t get_server_clusters(uint64_t node_id, chip::EndpointId endpoint_id, chip::ClusterId *cluster_ids,
+                                     size_t *count) { return ESP_ERR_NOT_FOUND; }
+inline esp_err_t get_device_types(uint64_t node_id, chip::EndpointId endpoint_id,
+                                  chip::DeviceTypeId *device_type_ids, size_t *count) { return ESP_ERR_NOT_FOUND; }
+inline esp_err_t sync(uint64_t node_id, sync_done_cb_t done_cb) { return ESP_ERR_NOT_SUPPORTED; }
+inline void invalidate_node(uint64_t node_id) {}
+#endif // CONFIG_ESP_MATTER_CONTROLLER_NODE_COMPOSITION_CACHE_ENABLE
+
+} // namespace node_composition
+} // namespace controller
+} // namespace esp_matter
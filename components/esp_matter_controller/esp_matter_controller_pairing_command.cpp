@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <esp_check.h>
 #include <esp_matter_commissioner.h>
 #include <esp_matter_controller_pairing_command.h>
+#include <setup_payload/QRCodeSetupPayloadGenerator.h>
+#include <setup_payload/SetupPayload.h>
 
 static const char *TAG = "pairing_command";
 
@@ -26,6 +29,17 @@ namespace controller {
 
 pairing_command pairing_command::instance;
 
+/* Commit the controller data written by the previous stages, the writes of a stage are coalesced by the cache */
+static void commit_storage()
+{
+#if CONFIG_ESP_MATTER_CONTROLLER_STORAGE_CACHE_ENABLE
+    /* The callbacks run in the Matter context, the commit is done after them */
+    if (storage_cache::request_commit() != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to request a commit of the controller storage");
+    }
+#endif
+}
+
 void pairing_command::OnStatusUpdate(DevicePairingDelegate::Status status)
 {
     switch (status) {
@@ -40,6 +54,7 @@ void pairing_command::OnStatusUpdate(DevicePairingDelegate::Status status)
 
 void pairing_command::OnPairingComplete(CHIP_ERROR err)
 {
+    commit_storage();
     if (err == CHIP_NO_ERROR) {
         ESP_LOGI(TAG, "Pairing Success");
     } else {
@@ -58,6 +73,7 @@ void pairing_command::OnPairingDeleted(CHIP_ERROR err)
 
 void pairing_command::OnCommissioningComplete(NodeId nodeId, CHIP_ERROR err)
 {
+    commit_storage();
     if (err == CHIP_NO_ERROR) {
         ESP_LOGI(TAG, "Device commissioning completed with success - getting OperationalDeviceProxy");
         esp_matter::commissioner::get_device_commissioner()->GetConnectedDevice(nodeId, &mOnDeviceConnectedCallback,
@@ -71,6 +87,16 @@ void pairing_command::OnCommissioningComplete(NodeId nodeId, CHIP_ERROR err)
     }
 }
 
+void pairing_command::OnCommissioningStatusUpdate(PeerId peerId, CommissioningStage stageCompleted, CHIP_ERROR err)
+{
+    /* The NOC chain of the commissionee is issued and the fabric data is about to be sent, or the commissioning
+     * stops: the data of the stages before is committed */
+    if (err != CHIP_NO_ERROR || stageCompleted == CommissioningStage::kGenerateNOCChain ||
+        stageCompleted == CommissioningStage::kSendComplete) {
+        commit_storage();
+    }
+}
+
 void pairing_command::OnDeviceConnectedFn(void *context, ExchangeManager &exchangeMgr,
                                           const SessionHandle &sessionHandle)
 {
@@ -170,6 +196,62 @@ esp_err_t pairing_ble_thread(NodeId node_id, uint32_t pincode, uint16_t disc, ui
     get_device_commissioner()->PairDevice(node_id, params, commissioning_params);
     return ESP_OK;
 }
+
+static esp_err_t pairing_combined(NodeId node_id, uint32_t pincode, uint16_t disc,
+                                  const CommissioningParameters &commissioning_params)
+{
+    // The setup code pairer of the commissioner discovers the device over all the transports in the payload at the
+    // same time and pairs with the first one found, so a payload with BLE and on-network rendezvous is built.
+    SetupPayload payload;
+    payload.version = 0;
+    payload.commissioningFlow = CommissioningFlow::kStandard;
+    payload.rendezvousInformation.SetValue(
+        RendezvousInformationFlags(RendezvousInformationFlag::kBLE, RendezvousInformationFlag::kOnNetwork));
+    payload.discriminator.SetLongValue(disc);
+    payload.setUpPINCode = pincode;
+    ESP_RETURN_ON_FALSE(payload.isValidQRCodePayload(), ESP_ERR_INVALID_ARG, TAG, "Invalid passcode or discriminator");
+
+    char qr_code_buf[64];
+    MutableCharSpan qr_code(qr_code_buf);
+    if (QRCodeBasicSetupPayloadGenerator(payload).payloadBase38Representation(qr_code) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to generate the setup payload");
+        return ESP_FAIL;
+    }
+
+    // The setup code pairer is the discovery delegate during the discovery
+    get_device_commissioner()->RegisterDeviceDiscoveryDelegate(nullptr);
+    pairing_command::get_instance().m_pairing_mode = PAIRING_MODE_CODE;
+    pairing_command::get_instance().m_setup_pincode = pincode;
+    pairing_command::get_instance().m_discriminator = disc;
+    pairing_command::get_instance().m_remote_node_id = node_id;
+    CHIP_ERROR err = get_device_commissioner()->PairDevice(node_id, qr_code_buf, commissioning_params,
+                                                           DiscoveryType::kAll);
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the combined pairing: %" CHIP_ERROR_FORMAT, err.Format());
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t pairing_combined_wifi(NodeId node_id, uint32_t pincode, uint16_t disc, const char *ssid, const char *pwd)
+{
+    ESP_RETURN_ON_FALSE(ssid && pwd, ESP_ERR_INVALID_ARG, TAG, "ssid and pwd cannot be NULL");
+    chip::ByteSpan nameSpan(reinterpret_cast<const uint8_t *>(ssid), strlen(ssid));
+    chip::ByteSpan pwdSpan(reinterpret_cast<const uint8_t *>(pwd), strlen(pwd));
+    pairing_command::get_instance().m_pairing_network_type = NETWORK_TYPE_WIFI;
+    return pairing_combined(node_id, pincode, disc,
+                            CommissioningParameters().SetWiFiCredentials(Controller::WiFiCredentials(nameSpan, pwdSpan)));
+}
+
+esp_err_t pairing_combined_thread(NodeId node_id, uint32_t pincode, uint16_t disc, uint8_t *dataset_tlvs,
+                                  uint8_t dataset_len)
+{
+    ESP_RETURN_ON_FALSE(dataset_tlvs, ESP_ERR_INVALID_ARG, TAG, "dataset_tlvs cannot be NULL");
+    chip::ByteSpan dataset_span(dataset_tlvs, dataset_len);
+    pairing_command::get_instance().m_pairing_network_type = NETWORK_TYPE_THREAD;
+    return pairing_combined(node_id, pincode, disc,
+                            CommissioningParameters().SetThreadOperationalDataset(dataset_span));
+}
 #endif
 } // namespace controller
 } // namespace esp_matter
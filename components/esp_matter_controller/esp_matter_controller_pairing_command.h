@@ -56,6 +56,8 @@ public:
     void OnPairingComplete(CHIP_ERROR error) override;
     void OnPairingDeleted(CHIP_ERROR error) override;
     void OnCommissioningComplete(NodeId deviceId, CHIP_ERROR error) override;
+    void OnCommissioningStatusUpdate(chip::PeerId peerId, chip::Controller::CommissioningStage stageCompleted,
+                                     CHIP_ERROR error) override;
 
     /****************** DeviceDiscoveryDelegate Interface ***************/
     void OnDiscoveredDevice(const chip::Dnssd::DiscoveredNodeData &nodeData) override;
@@ -84,6 +86,40 @@ esp_err_t pairing_on_network(NodeId node_id, uint32_t pincode);
 esp_err_t pairing_ble_wifi(NodeId node_id, uint32_t pincode, uint16_t disc, const char *ssid, const char *pwd);
 esp_err_t pairing_ble_thread(NodeId node_id, uint32_t pincode, uint16_t disc, uint8_t *dataset_tlvs,
                              uint8_t dataset_len);
+
+/**
+ * @brief Commissions a device found either over BLE or on the network, whichever is discovered first.
+ *
+ * The BLE scan and the DNS-SD browse of the commissionable nodes run at the same time, and the discovery stops at the
+ * first device advertising the discriminator. The Wi-Fi credentials are only sent to a device found over BLE, a device
+ * found on the network is commissioned without network setup.
+ *
+ * @param node_id Node id given to the device
+ * @param pincode Setup passcode of the device
+ * @param disc Long discriminator of the device
+ * @param ssid SSID of the Wi-Fi network
+ * @param pwd Passphrase of the Wi-Fi network
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t pairing_combined_wifi(NodeId node_id, uint32_t pincode, uint16_t disc, const char *ssid, const char *pwd);
+
+/**
+ * @brief Commissions a device found either over BLE or on the network, whichever is discovered first.
+ *
+ * Same as pairing_combined_wifi(), with the operational dataset of the Thread network sent to a device found over
+ * BLE.
+ *
+ * @param node_id Node id given to the device
+ * @param pincode Setup passcode of the device
+ * @param disc Long discriminator of the device
+ * @param dataset_tlvs Operational dataset TLVs of the Thread network
+ * @param dataset_len Length of the operational dataset TLVs
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t pairing_combined_thread(NodeId node_id, uint32_t pincode, uint16_t disc, uint8_t *dataset_tlvs,
+                                  uint8_t dataset_len);
 #endif
 
 } // namespace controller
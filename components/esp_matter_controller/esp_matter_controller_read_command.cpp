@@ -14,11 +14,14 @@
 
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
 #include <esp_matter_commissioner.h>
 #else
 #include <app/server/Server.h>
 #endif
+#include <esp_matter_controller_attribute_cache.h>
+#include <esp_matter_controller_node_composition.h>
 #include <esp_matter_controller_read_command.h>
 
 #include "DataModelLogger.h"
@@ -34,6 +37,8 @@ static const char *TAG = "read_command";
 namespace esp_matter {
 namespace controller {
 
+command_pool::pool<read_command> read_command::s_pool;
+
 void read_command::on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                            const SessionHandle &sessionHandle)
 {
@@ -42,27 +47,41 @@ void read_command::on_device_connected_fcn(void *context, ExchangeManager &excha
 
     if (cmd->m_attr_paths.AllocatedSize() == 0 && cmd->m_event_paths.AllocatedSize() == 0) {
         ESP_LOGE(TAG, "Cannot send the read command with NULL attribute path and NULL event path");
-        chip::Platform::Delete(cmd);
+        cmd->fail(CHIP_ERROR_INVALID_ARGUMENT);
         return;
     }
+#if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+    /* The paths served from the cache are not requested */
+    params.mpAttributePathParamsList = cmd->m_request_attr_paths.Get();
+    params.mAttributePathParamsListSize = cmd->m_request_attr_paths.AllocatedSize();
+    params.mpDataVersionFilterList = cmd->m_data_version_filters.Get();
+    params.mDataVersionFilterListSize = cmd->m_data_version_filters.AllocatedSize();
+#else
     params.mpAttributePathParamsList = cmd->m_attr_paths.Get();
     params.mAttributePathParamsListSize = cmd->m_attr_paths.AllocatedSize();
+    params.mpDataVersionFilterList = nullptr;
+    params.mDataVersionFilterListSize = 0;
+#endif
     params.mpEventPathParamsList = cmd->m_event_paths.Get();
     params.mEventPathParamsListSize = cmd->m_event_paths.AllocatedSize();
     params.mIsFabricFiltered = 0;
-    params.mpDataVersionFilterList = nullptr;
-    params.mDataVersionFilterListSize = 0;
 
+    /* Without the buffered read callback, the list chunks are not reassembled */
+    ReadClient::Callback &callback =
+        cmd->m_streaming ? static_cast<ReadClient::Callback &>(*cmd) : cmd->m_buffered_read_cb;
     ReadClient *client = chip::Platform::New<ReadClient>(InteractionModelEngine::GetInstance(), &exchangeMgr,
-                                                         cmd->m_buffered_read_cb, ReadClient::InteractionType::Read);
+                                                         callback, ReadClient::InteractionType::Read);
     if (!client) {
         ESP_LOGE(TAG, "Failed to alloc memory for read client");
-        chip::Platform::Delete(cmd);
+        cmd->fail(CHIP_ERROR_NO_MEMORY);
+        return;
     }
-    if (CHIP_NO_ERROR != client->SendRequest(params)) {
+    cmd->m_start_time_us = esp_timer_get_time();
+    CHIP_ERROR err = client->SendRequest(params);
+    if (err != CHIP_NO_ERROR) {
         ESP_LOGE(TAG, "Failed to send read request");
         chip::Platform::Delete(client);
-        chip::Platform::Delete(cmd);
+        cmd->fail(err);
     }
     return;
 }
@@ -70,12 +89,162 @@ void read_command::on_device_connected_fcn(void *context, ExchangeManager &excha
 void read_command::on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
 {
     read_command *cmd = (read_command *)context;
-    chip::Platform::Delete(cmd);
+    cmd->fail(error);
     return;
 }
 
+void read_command::fail(CHIP_ERROR error)
+{
+    if (read_failure_cb) {
+        read_failure_cb(m_node_id, error);
+    }
+    destroy(this);
+}
+
+#if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+static bool is_concrete(const AttributePathParams &path)
+{
+    return !path.HasWildcardEndpointId() && !path.HasWildcardClusterId() && !path.HasWildcardAttributeId() &&
+        path.HasWildcardListIndex();
+}
+
+static bool covers_cluster(const AttributePathParams &path, chip::EndpointId endpoint_id, chip::ClusterId cluster_id)
+{
+    return (path.HasWildcardEndpointId() || path.mEndpointId == endpoint_id) &&
+        (path.HasWildcardClusterId() || path.mClusterId == cluster_id);
+}
+
+esp_err_t read_command::serve_from_cache()
+{
+    size_t path_count = m_attr_paths.AllocatedSize();
+    if (path_count == 0) {
+        return ESP_OK;
+    }
+    ScopedMemoryBufferWithSize<bool> served;
+    if (!served.Calloc(path_count)) {
+        return ESP_ERR_NO_MEM;
+    }
+    size_t request_count = 0;
+    for (size_t index = 0; index < path_count; index++) {
+        const AttributePathParams &attr_path = m_attr_paths[index];
+        chip::TLV::TLVReader reader;
+        chip::app::ConcreteDataAttributePath path(attr_path.mEndpointId, attr_path.mClusterId,
+                                                  attr_path.mAttributeId);
+        if (is_concrete(attr_path) && attribute_cache::get(m_node_id, path, reader, &path.mDataVersion) == ESP_OK) {
+            deliver_attribute(path, &reader);
+            served[index] = true;
+        } else {
+            request_count++;
+        }
+    }
+    if (request_count == 0) {
+        return ESP_OK;
+    }
+    if (!m_request_attr_paths.Alloc(request_count) || !m_reported.Calloc(request_count)) {
+        return ESP_ERR_NO_MEM;
+    }
+    request_count = 0;
+    for (size_t index = 0; index < path_count; index++) {
+        if (!served[index]) {
+            m_request_attr_paths[request_count++] = m_attr_paths[index];
+        }
+    }
+
+    /* A cluster is filtered when all its requested attributes are cached with the same data version, the server then
+     * sends the cluster only if it changed since. */
+    size_t filter_count = 0;
+    ScopedMemoryBufferWithSize<chip::app::DataVersionFilter> filters;
+    if (!filters.Alloc(request_count)) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t index = 0; index < request_count; index++) {
+        const AttributePathParams &attr_path = m_request_attr_paths[index];
+        chip::DataVersion version;
+        if (!is_concrete(attr_path) ||
+            attribute_cache::get_version(m_node_id, chip::app::ConcreteAttributePath(attr_path.mEndpointId,
+                                         attr_path.mClusterId, attr_path.mAttributeId), version) != ESP_OK) {
+            continue;
+        }
+        bool eligible = true;
+        for (size_t other = 0; other < request_count && eligible; other++) {
+            const AttributePathParams &other_path = m_request_attr_paths[other];
+            chip::DataVersion other_version;
+            if (!covers_cluster(other_path, attr_path.mEndpointId, attr_path.mClusterId)) {
+                continue;
+            }
+            /* The cluster was already checked with the first of its paths */
+            eligible = other >= index && is_concrete(other_path) &&
+                attribute_cache::get_version(m_node_id, chip::app::ConcreteAttributePath(other_path.mEndpointId,
+                                             other_path.mClusterId, other_path.mAttributeId),
+                                             other_version) == ESP_OK && other_version == version;
+        }
+        if (eligible) {
+            filters[filter_count++] = chip::app::DataVersionFilter(attr_path.mEndpointId, attr_path.mClusterId, version);
+        }
+    }
+    if (filter_count > 0) {
+        if (!m_data_version_filters.Alloc(filter_count)) {
+            return ESP_ERR_NO_MEM;
+        }
+        for (size_t index = 0; index < filter_count; index++) {
+            m_data_version_filters[index] = filters[index];
+        }
+    }
+    return ESP_OK;
+}
+
+bool read_command::is_filtered(const AttributePathParams &path) const
+{
+    for (size_t index = 0; index < m_data_version_filters.AllocatedSize(); index++) {
+        const chip::app::DataVersionFilter &filter = m_data_version_filters[index];
+        if (filter.mEndpointId == path.mEndpointId && filter.mClusterId == path.mClusterId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void read_command::serve_filtered_from_cache()
+{
+    if (m_failed) {
+        return;
+    }
+    for (size_t index = 0; index < m_request_attr_paths.AllocatedSize(); index++) {
+        const AttributePathParams &attr_path = m_request_attr_paths[index];
+        if (m_reported[index] || !is_filtered(attr_path)) {
+            continue;
+        }
+        attribute_cache::refresh(m_node_id, &attr_path, 1, CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_MAX_AGE * 1000);
+        chip::TLV::TLVReader reader;
+        chip::app::ConcreteDataAttributePath path(attr_path.mEndpointId, attr_path.mClusterId,
+                                                  attr_path.mAttributeId);
+        if (attribute_cache::get(m_node_id, path, reader, &path.mDataVersion) == ESP_OK) {
+            deliver_attribute(path, &reader);
+        }
+    }
+}
+#endif // CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+
 esp_err_t read_command::send_command()
 {
+#if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+    m_start_time_us = esp_timer_get_time();
+    esp_err_t err = serve_from_cache();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the cached read");
+        destroy(this);
+        return err;
+    }
+    if (m_attr_paths.AllocatedSize() > 0 && m_request_attr_paths.AllocatedSize() == 0 &&
+        m_event_paths.AllocatedSize() == 0) {
+        ESP_LOGI(TAG, "read done: %" PRIu32 " records served from the attribute cache", m_record_count);
+        if (read_done_cb) {
+            read_done_cb(m_node_id, m_attr_paths, m_event_paths);
+        }
+        destroy(this);
+        return ESP_OK;
+    }
+#endif
 #if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
     if (CHIP_NO_ERROR ==
         commissioner::get_device_commissioner()->GetConnectedDevice(m_node_id, &on_device_connected_cb,
@@ -89,7 +258,7 @@ esp_err_t read_command::send_command()
     return ESP_OK;
 #endif
 
-    chip::Platform::Delete(this);
+    destroy(this);
     return ESP_FAIL;
 }
 
@@ -107,14 +276,38 @@ void read_command::OnAttributeData(const chip::app::ConcreteDataAttributePath &p
         ESP_LOGE(TAG, "Response Failure: No Data");
         return;
     }
+    node_composition::on_attribute_data(m_node_id, path, data);
+#if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+    attribute_cache::store(m_node_id, path, data, CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_MAX_AGE * 1000);
+    for (size_t index = 0; index < m_request_attr_paths.AllocatedSize(); index++) {
+        const AttributePathParams &attr_path = m_request_attr_paths[index];
+        if (attr_path.mEndpointId == path.mEndpointId && attr_path.mClusterId == path.mClusterId &&
+            attr_path.mAttributeId == path.mAttributeId) {
+            m_reported[index] = true;
+        }
+    }
+#endif
+    deliver_attribute(path, data);
+}
+
+void read_command::deliver_attribute(const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    m_record_count++;
     if (attribute_data_cb) {
+        if (!m_log_attribute_data) {
+            attribute_data_cb(m_node_id, path, data);
+            return;
+        }
         chip::TLV::TLVReader data_cpy;
         data_cpy.Init(*data);
         attribute_data_cb(m_node_id, path, &data_cpy);
     }
-    error = DataModelLogger::LogAttribute(path, data);
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+    if (m_log_attribute_data) {
+        error = DataModelLogger::LogAttribute(path, data);
+        if (CHIP_NO_ERROR != error) {
+            ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+        }
     }
 }
 
@@ -134,20 +327,35 @@ void read_command::OnEventData(const chip::app::EventHeader &event_header, chip:
         ESP_LOGE(TAG, "Response Failure: No Data");
         return;
     }
+    if (!event_cursor::update(m_node_id, m_event_paths.Get(), m_event_paths.AllocatedSize(), event_header)) {
+        // Already received for another path of the request
+        return;
+    }
+    m_record_count++;
     if (event_data_cb) {
+        if (!m_log_event_data) {
+            event_data_cb(m_node_id, event_header, data);
+            return;
+        }
         chip::TLV::TLVReader data_cpy;
         data_cpy.Init(*data);
         event_data_cb(m_node_id, event_header, &data_cpy);
     }
-    error = DataModelLogger::LogEvent(event_header, data);
-    if (CHIP_NO_ERROR != error) {
-        ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+    if (m_log_event_data) {
+        error = DataModelLogger::LogEvent(event_header, data);
+        if (CHIP_NO_ERROR != error) {
+            ESP_LOGE(TAG, "Response Failure: Can not decode Data");
+        }
     }
 }
 
 void read_command::OnError(CHIP_ERROR error)
 {
     ESP_LOGE(TAG, "Read Error: %s", chip::ErrorStr(error));
+    m_error = error;
+#if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+    m_failed = true;
+#endif
 }
 
 void read_command::OnDeallocatePaths(chip::app::ReadPrepareParams &&aReadPrepareParams)
@@ -158,12 +366,20 @@ void read_command::OnDeallocatePaths(chip::app::ReadPrepareParams &&aReadPrepare
 
 void read_command::OnDone(ReadClient *apReadClient)
 {
-    ESP_LOGI(TAG, "read done");
-    if (read_done_cb) {
+#if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+    serve_filtered_from_cache();
+#endif
+    int64_t elapsed_us = esp_timer_get_time() - m_start_time_us;
+    uint32_t records_per_sec = elapsed_us > 0 ? (uint32_t)((uint64_t)m_record_count * 1000000 / elapsed_us) : 0;
+    ESP_LOGI(TAG, "read done: %" PRIu32 " records in %" PRId64 " ms, %" PRIu32 " records/s", m_record_count,
+             elapsed_us / 1000, records_per_sec);
+    if (m_error != CHIP_NO_ERROR && read_failure_cb) {
+        read_failure_cb(m_node_id, m_error);
+    } else if (read_done_cb) {
         read_done_cb(m_node_id, m_attr_paths, m_event_paths);
     }
     chip::Platform::Delete(apReadClient);
-    chip::Platform::Delete(this);
+    destroy(this);
 }
 
 esp_err_t send_read_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
@@ -189,7 +405,7 @@ esp_err_t send_read_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<ui
     }
 
     read_command *cmd =
-        chip::Platform::New<read_command>(node_id, std::move(attr_paths), std::move(event_paths), nullptr, nullptr, nullptr);
+        read_command::create(node_id, std::move(attr_paths), std::move(event_paths), nullptr, nullptr, nullptr);
     if (!cmd) {
         ESP_LOGE(TAG, "Failed to alloc memory for read_command");
         return ESP_ERR_NO_MEM;
@@ -220,7 +436,7 @@ esp_err_t send_read_event_command(uint64_t node_id, ScopedMemoryBufferWithSize<u
     }
 
     read_command *cmd =
-        chip::Platform::New<read_command>(node_id, std::move(attr_paths), std::move(event_paths), nullptr, nullptr, nullptr);
+        read_command::create(node_id, std::move(attr_paths), std::move(event_paths), nullptr, nullptr, nullptr);
     if (!cmd) {
         ESP_LOGE(TAG, "Failed to alloc memory for read_command");
         return ESP_ERR_NO_MEM;
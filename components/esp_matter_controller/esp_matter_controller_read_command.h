@@ -15,8 +15,11 @@
 #pragma once
 
 #include <app/BufferedReadCallback.h>
+#include <app/DataVersionFilter.h>
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_matter.h>
+#include <esp_matter_controller_command_pool.h>
+#include <esp_matter_controller_event_cursor.h>
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_mem.h>
 
@@ -52,6 +55,8 @@ public:
         , attribute_data_cb(attribute_cb)
         , read_done_cb(read_cb_done)
         , event_data_cb(event_cb)
+        , m_log_attribute_data(!attribute_cb)
+        , m_log_event_data(!event_cb)
     {
     }
 
@@ -65,6 +70,8 @@ public:
         , attribute_data_cb(attribute_cb)
         , read_done_cb(read_cb_done)
         , event_data_cb(event_cb)
+        , m_log_attribute_data(!attribute_cb)
+        , m_log_event_data(!event_cb)
     {
         if (command_type == READ_ATTRIBUTE) {
             m_attr_paths.Alloc(1);
@@ -81,8 +88,48 @@ public:
 
     ~read_command() {}
 
+    /**
+     * @brief Creates a command, from the pool of the read_command objects when one is free.
+     */
+    template <typename... Args>
+    static read_command *create(Args &&...args)
+    {
+        return s_pool.create(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys a command created with create().
+     */
+    static void destroy(read_command *cmd) { s_pool.destroy(cmd); }
+
+    static const command_pool::stats_t &get_pool_stats() { return s_pool.get_stats(); }
+
     esp_err_t send_command();
 
+    /**
+     * @brief Deliver the reports to the callbacks chunk by chunk, without reassembling them first. The memory used
+     * stays bounded for large reads, but the list attributes which do not fit in a chunk are reported item by item,
+     * the items having a path with the AppendItem list operation. Must be set before send_command().
+     */
+    void set_streaming(bool streaming) { m_streaming = streaming; }
+
+    /**
+     * @brief Log the decoded attribute and event data. Each kind of data is logged by default only when no callback
+     * of that kind is installed, since decoding the data for the logs is the most expensive part of processing large
+     * reads.
+     */
+    void set_data_logging(bool log_data)
+    {
+        m_log_attribute_data = log_data;
+        m_log_event_data = log_data;
+    }
+
+    /**
+     * @brief Report the failures of the read to a callback, which is then called instead of the read done callback.
+     * The failures of send_command() are only returned by it. Must be set before send_command().
+     */
+    void set_failure_cb(read_failure_cb_t failure_cb) { read_failure_cb = failure_cb; }
+
     // ReadClient Callback Interface
     void OnAttributeData(const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data,
                          const chip::app::StatusIB &status) override;
@@ -90,6 +137,12 @@ public:
     void OnEventData(const chip::app::EventHeader &event_header, chip::TLV::TLVReader *data,
                      const chip::app::StatusIB *status) override;
 
+    CHIP_ERROR GetHighestReceivedEventNumber(chip::Optional<chip::EventNumber> &event_number) override
+    {
+        event_cursor::get_highest_received(m_node_id, m_event_paths.Get(), m_event_paths.AllocatedSize(), event_number);
+        return CHIP_NO_ERROR;
+    }
+
     void OnError(CHIP_ERROR error) override;
 
     void OnDeallocatePaths(chip::app::ReadPrepareParams &&aReadPrepareParams) override;
@@ -97,6 +150,21 @@ public:
     void OnDone(ReadClient *apReadClient) override;
 
 private:
+    static command_pool::pool<read_command> s_pool;
+    void deliver_attribute(const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data);
+#if CONFIG_ESP_MATTER_CONTROLLER_ATTRIBUTE_CACHE_ENABLE
+    /* Serves the fresh cached values and prepares the request for the others */
+    esp_err_t serve_from_cache();
+    /* Serves the values of the clusters which were not reported since their data version matched */
+    void serve_filtered_from_cache();
+    bool is_filtered(const AttributePathParams &path) const;
+
+    ScopedMemoryBufferWithSize<AttributePathParams> m_request_attr_paths;
+    ScopedMemoryBufferWithSize<chip::app::DataVersionFilter> m_data_version_filters;
+    ScopedMemoryBufferWithSize<bool> m_reported;
+    bool m_failed = false;
+#endif
+
     uint64_t m_node_id;
     BufferedReadCallback m_buffered_read_cb;
     ScopedMemoryBufferWithSize<AttributePathParams> m_attr_paths;
@@ -106,6 +174,8 @@ private:
     static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                         const SessionHandle &sessionHandle);
     static void on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error);
+    /* Reports the failure and destroys the command */
+    void fail(CHIP_ERROR error);
 
     chip::Callback::Callback<chip::OnDeviceConnected> on_device_connected_cb;
     chip::Callback::Callback<chip::OnDeviceConnectionFailure> on_device_connection_failure_cb;
@@ -113,7 +183,14 @@ private:
     attribute_report_cb_t attribute_data_cb;
     read_done_cb_t read_done_cb;
     event_report_cb_t event_data_cb;
-    
+    read_failure_cb_t read_failure_cb = nullptr;
+    CHIP_ERROR m_error = CHIP_NO_ERROR;
+
+    bool m_log_attribute_data;
+    bool m_log_event_data;
+    bool m_streaming = false;
+    uint32_t m_record_count = 0;
+    int64_t m_start_time_us = 0;
 };
 
 esp_err_t send_read_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
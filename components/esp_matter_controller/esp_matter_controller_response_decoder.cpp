@@ -0,0 +1,208 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_response_decoder.h>
+#include <inttypes.h>
+#include <lib/core/TLV.h>
+
+#if CONFIG_ESP_MATTER_CONTROLLER_DATA_MODEL_LOGGER_COMPACT
+#include "logger/compact/DataModelLoggerTable.h"
+#endif
+
+using chip::TLV::TLVType;
+
+static const char *TAG = "response_decoder";
+
+namespace esp_matter {
+namespace controller {
+namespace response_decoder {
+
+/* Nesting limit, the data model structures are far from it */
+static constexpr uint8_t k_max_depth = 8;
+
+static field_cb_t s_default_field_cb = log_field;
+static void *s_default_field_ctx = nullptr;
+
+static esp_err_t decode_element(const ConcreteCommandPath &path, TLVReader &reader, field_t &field, field_cb_t field_cb,
+                                void *ctx);
+
+static esp_err_t decode_container(const ConcreteCommandPath &path, TLVReader &reader, uint8_t depth, bool in_list,
+                                  field_cb_t field_cb, void *ctx)
+{
+    ESP_RETURN_ON_FALSE(depth < k_max_depth, ESP_ERR_INVALID_RESPONSE, TAG, "The response is nested too deep");
+    TLVType container_type;
+    ESP_RETURN_ON_FALSE(reader.EnterContainer(container_type) == CHIP_NO_ERROR, ESP_ERR_INVALID_RESPONSE, TAG,
+                        "Failed to enter a container");
+    CHIP_ERROR chip_err;
+    uint32_t index = 0;
+    while ((chip_err = reader.Next()) == CHIP_NO_ERROR) {
+        field_t field = {};
+        field.depth = depth;
+        field.in_list = in_list;
+        if (in_list) {
+            field.tag = index++;
+        } else if (chip::TLV::IsContextTag(reader.GetTag())) {
+            field.tag = chip::TLV::TagNumFromTag(reader.GetTag());
+        }
+        ESP_RETURN_ON_ERROR(decode_element(path, reader, field, field_cb, ctx), TAG, "Failed to decode a field");
+    }
+    ESP_RETURN_ON_FALSE(chip_err == CHIP_END_OF_TLV, ESP_ERR_INVALID_RESPONSE, TAG, "Failed to read a field");
+    ESP_RETURN_ON_FALSE(reader.ExitContainer(container_type) == CHIP_NO_ERROR, ESP_ERR_INVALID_RESPONSE, TAG,
+                        "Failed to exit a container");
+    return ESP_OK;
+}
+
+static esp_err_t decode_element(const ConcreteCommandPath &path, TLVReader &reader, field_t &field, field_cb_t field_cb,
+                                void *ctx)
+{
+    CHIP_ERROR chip_err = CHIP_NO_ERROR;
+    switch (reader.GetType()) {
+    case chip::TLV::kTLVType_SignedInteger:
+        field.type = FIELD_SIGNED;
+        chip_err = reader.Get(field.value.i);
+        break;
+    case chip::TLV::kTLVType_UnsignedInteger:
+        field.type = FIELD_UNSIGNED;
+        chip_err = reader.Get(field.value.u);
+        break;
+    case chip::TLV::kTLVType_Boolean:
+        field.type = FIELD_BOOL;
+        chip_err = reader.Get(field.value.b);
+        break;
+    case chip::TLV::kTLVType_FloatingPointNumber:
+        field.type = FIELD_FLOAT;
+        chip_err = reader.Get(field.value.f);
+        break;
+    case chip::TLV::kTLVType_UTF8String:
+    case chip::TLV::kTLVType_ByteString: {
+        field.type = reader.GetType() == chip::TLV::kTLVType_UTF8String ? FIELD_STRING : FIELD_BYTES;
+        field.value.span.len = reader.GetLength();
+        chip_err = reader.GetDataPtr(field.value.span.data);
+        break;
+    }
+    case chip::TLV::kTLVType_Null:
+        field.type = FIELD_NULL;
+        break;
+    case chip::TLV::kTLVType_Structure:
+    case chip::TLV::kTLVType_Array:
+    case chip::TLV::kTLVType_List: {
+        bool in_list = reader.GetType() != chip::TLV::kTLVType_Structure;
+        field.type = in_list ? FIELD_LIST : FIELD_STRUCT;
+        ESP_RETURN_ON_ERROR(field_cb(path, field, ctx), TAG, "The field callback stopped the decoding");
+        ESP_RETURN_ON_ERROR(decode_container(path, reader, field.depth + 1, in_list, field_cb, ctx), TAG,
+                            "Failed to decode a container");
+        field.type = FIELD_END;
+        field.value.b = in_list;
+        return field_cb(path, field, ctx);
+    }
+    default:
+        ESP_LOGE(TAG, "Unsupported TLV element type %d", (int)reader.GetType());
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    ESP_RETURN_ON_FALSE(chip_err == CHIP_NO_ERROR, ESP_ERR_INVALID_RESPONSE, TAG, "Failed to read a value");
+    return field_cb(path, field, ctx);
+}
+
+esp_err_t decode(const ConcreteCommandPath &path, TLVReader *reader, field_cb_t field_cb, void *ctx)
+{
+    ESP_RETURN_ON_FALSE(reader && field_cb, ESP_ERR_INVALID_ARG, TAG, "reader and field_cb cannot be NULL");
+    /* The fields of the response structure are the top level fields */
+    if (reader->GetType() == chip::TLV::kTLVType_Structure) {
+        return decode_container(path, *reader, 0, false, field_cb, ctx);
+    }
+    field_t field = {};
+    return decode_element(path, *reader, field, field_cb, ctx);
+}
+
+esp_err_t log_field(const ConcreteCommandPath &path, const field_t &field, void *ctx)
+{
+    int indent = 2 + 2 * field.depth;
+    char label[16];
+    if (field.in_list) {
+        snprintf(label, sizeof(label), "[%" PRIu32 "]", field.tag);
+    } else {
+        snprintf(label, sizeof(label), "%" PRIu32 ":", field.tag);
+    }
+    switch (field.type) {
+    case FIELD_SIGNED:
+        ESP_LOGI(TAG, "%*s%s %" PRId64, indent, "", label, field.value.i);
+        break;
+    case FIELD_UNSIGNED:
+        ESP_LOGI(TAG, "%*s%s %" PRIu64, indent, "", label, field.value.u);
+        break;
+    case FIELD_BOOL:
+        ESP_LOGI(TAG, "%*s%s %s", indent, "", label, field.value.b ? "true" : "false");
+        break;
+    case FIELD_FLOAT:
+        ESP_LOGI(TAG, "%*s%s %f", indent, "", label, field.value.f);
+        break;
+    case FIELD_STRING:
+        ESP_LOGI(TAG, "%*s%s \"%.*s\"", indent, "", label, (int)field.value.span.len,
+                 (const char *)field.value.span.data);
+        break;
+    case FIELD_BYTES:
+        ESP_LOGI(TAG, "%*s%s %u bytes", indent, "", label, (unsigned)field.value.span.len);
+        ESP_LOG_BUFFER_HEX_LEVEL(TAG, field.value.span.data, field.value.span.len, ESP_LOG_INFO);
+        break;
+    case FIELD_NULL:
+        ESP_LOGI(TAG, "%*s%s null", indent, "", label);
+        break;
+    case FIELD_STRUCT:
+        ESP_LOGI(TAG, "%*s%s {", indent, "", label);
+        break;
+    case FIELD_LIST:
+        ESP_LOGI(TAG, "%*s%s [", indent, "", label);
+        break;
+    case FIELD_END:
+        ESP_LOGI(TAG, "%*s%s", indent, "", field.value.b ? "]" : "}");
+        break;
+    }
+    return ESP_OK;
+}
+
+void set_default_field_cb(field_cb_t field_cb, void *ctx)
+{
+    s_default_field_cb = field_cb ? field_cb : log_field;
+    s_default_field_ctx = field_cb ? ctx : nullptr;
+}
+
+esp_err_t decode_with_default_cb(const ConcreteCommandPath &path, TLVReader *reader)
+{
+    return decode(path, reader, s_default_field_cb, s_default_field_ctx);
+}
+
+const char *get_command_name(uint32_t cluster_id, uint32_t command_id)
+{
+#if CONFIG_ESP_MATTER_CONTROLLER_DATA_MODEL_LOGGER_COMPACT
+    using namespace data_model_logger;
+    for (size_t index = 0; index < k_cluster_count; index++) {
+        if (k_clusters[index].id != cluster_id) {
+            continue;
+        }
+        for (size_t cmd = 0; cmd < k_clusters[index].command_count; cmd++) {
+            if (k_clusters[index].commands[cmd].id == command_id) {
+                return k_clusters[index].commands[cmd].name;
+            }
+        }
+        break;
+    }
+#endif
+    return nullptr;
+}
+
+} // namespace response_decoder
+} // namespace controller
+} // namespace esp_matter
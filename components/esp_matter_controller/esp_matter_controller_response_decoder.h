@@ -0,0 +1,119 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/ConcreteCommandPath.h>
+#include <esp_err.h>
+#include <lib/core/TLVReader.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Command response decoder. The fields of a response are walked from its TLV encoding, which carries the value types,
+ * and given one by one to a callback, so every response is decoded by the same code, without the per-response decoding
+ * functions and without formatting them with the data model logger.
+ */
+
+namespace esp_matter {
+namespace controller {
+namespace response_decoder {
+
+using chip::app::ConcreteCommandPath;
+using chip::TLV::TLVReader;
+
+typedef enum {
+    FIELD_SIGNED,
+    FIELD_UNSIGNED,
+    FIELD_BOOL,
+    FIELD_FLOAT,
+    FIELD_STRING,
+    FIELD_BYTES,
+    FIELD_NULL,
+    /* Start of a structure, its fields follow at depth + 1 until the matching FIELD_END */
+    FIELD_STRUCT,
+    /* Start of a list, its elements follow at depth + 1 until the matching FIELD_END */
+    FIELD_LIST,
+    FIELD_END,
+} field_type_t;
+
+/** Field of a command response */
+typedef struct {
+    field_type_t type;
+    /* 0 for the fields of the response, + 1 in each structure or list */
+    uint8_t depth;
+    /* The element is in a list, tag is its index */
+    bool in_list;
+    /* Context tag of the field, the field id of the specification, or the index of a list element */
+    uint32_t tag;
+    union {
+        int64_t i;
+        uint64_t u;
+        /* FIELD_BOOL, and FIELD_END where it is true at the end of a list */
+        bool b;
+        double f;
+        /* FIELD_STRING, not NULL terminated, and FIELD_BYTES. Valid during the callback only */
+        struct {
+            const uint8_t *data;
+            size_t len;
+        } span;
+    } value;
+} field_t;
+
+/**
+ * @brief Called for each field of a response, in the order of the encoding.
+ *
+ * @return ESP_OK to continue, the decoding stops and returns the error otherwise
+ */
+using field_cb_t = esp_err_t (*)(const ConcreteCommandPath &path, const field_t &field, void *ctx);
+
+/**
+ * @brief Decodes a command response.
+ *
+ * @param path Path of the response command
+ * @param reader Reader positioned on the response data, as given to the success callback of the command
+ * @param field_cb Called for each field
+ * @param ctx Given to field_cb
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_RESPONSE if the encoding is not valid, or the error of field_cb
+ */
+esp_err_t decode(const ConcreteCommandPath &path, TLVReader *reader, field_cb_t field_cb, void *ctx);
+
+/**
+ * @brief Field callback printing the fields, used by the default success callback of the cluster commands.
+ */
+esp_err_t log_field(const ConcreteCommandPath &path, const field_t &field, void *ctx);
+
+/**
+ * @brief Sets the field callback of the default success callback of the cluster commands.
+ *
+ * @param field_cb Callback, NULL for log_field()
+ * @param ctx Given to field_cb
+ */
+void set_default_field_cb(field_cb_t field_cb, void *ctx);
+
+/**
+ * @brief Decodes a response with the field callback set by set_default_field_cb().
+ */
+esp_err_t decode_with_default_cb(const ConcreteCommandPath &path, TLVReader *reader);
+
+/**
+ * @brief Returns the name of a command, NULL if the names are not built, which they are with the compact data model
+ * logger only.
+ */
+const char *get_command_name(uint32_t cluster_id, uint32_t command_id);
+
+} // namespace response_decoder
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,404 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <ctype.h>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_cluster_command.h>
+#include <esp_matter_controller_command_pool.h>
+#include <esp_matter_controller_read_command.h>
+#include <esp_matter_controller_script.h>
+#include <esp_matter_controller_write_command.h>
+#include <esp_matter_mem.h>
+#include <esp_timer.h>
+#include <inttypes.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "controller_script";
+
+namespace esp_matter {
+namespace controller {
+namespace script {
+
+static constexpr size_t k_max_args = 64;
+static constexpr size_t k_max_line_len = CONFIG_ESP_MATTER_CONTROLLER_JSON_STRING_BUFFER_LEN + 128;
+static constexpr uint32_t k_poll_interval_ms = 10;
+
+typedef enum {
+    KIND_CONCURRENT = 0,
+    KIND_SEQUENTIAL,
+    KIND_WAIT,
+} kind_t;
+
+typedef enum {
+    BLOCK_NONE = 0,
+    BLOCK_LIMIT,
+    BLOCK_BARRIER,
+} block_t;
+
+/* A command and its arguments are held in one allocation */
+typedef struct line {
+    struct line *next;
+    kind_t kind;
+    uint32_t wait_ms;
+    int argc;
+    char **argv;
+} line_t;
+
+static line_t *s_head = nullptr;
+static line_t *s_tail = nullptr;
+static size_t s_count = 0;
+
+static bool s_running = false;
+static line_t *s_next = nullptr;
+static exec_cb_t s_exec_cb = nullptr;
+static done_cb_t s_done_cb = nullptr;
+static uint16_t s_max_concurrent = 0;
+static summary_t s_summary;
+static int64_t s_start_us = 0;
+static int64_t s_wait_until_us = 0;
+static block_t s_block = BLOCK_NONE;
+static int64_t s_block_start_us = 0;
+
+static const char *const k_concurrent_commands[] = {"read-attr", "read-event", "write-attr", "invoke-cmd"};
+
+static kind_t get_kind(const char *name)
+{
+    if (strcmp(name, "wait") == 0) {
+        return KIND_WAIT;
+    }
+    for (size_t idx = 0; idx < sizeof(k_concurrent_commands) / sizeof(k_concurrent_commands[0]); ++idx) {
+        if (strcmp(name, k_concurrent_commands[idx]) == 0) {
+            return KIND_CONCURRENT;
+        }
+    }
+    return KIND_SEQUENTIAL;
+}
+
+/* Splits the line in place, and returns the number of arguments or -1 if the line is invalid */
+static int tokenize(char *buf, char **argv)
+{
+    int argc = 0;
+    char *src = buf;
+    char *dst = buf;
+    while (true) {
+        while (*src && isspace((unsigned char)*src)) {
+            src++;
+        }
+        if (!*src) {
+            break;
+        }
+        if (argc == k_max_args) {
+            ESP_LOGE(TAG, "Too many arguments, at most %u", (unsigned)k_max_args);
+            return -1;
+        }
+        argv[argc++] = dst;
+        bool quoted = false;
+        while (*src && (quoted || !isspace((unsigned char)*src))) {
+            if (*src == '\\' && src[1]) {
+                *dst++ = src[1];
+                src += 2;
+            } else if (*src == '"') {
+                quoted = !quoted;
+                src++;
+            } else {
+                *dst++ = *src++;
+            }
+        }
+        if (quoted) {
+            ESP_LOGE(TAG, "Unterminated quote");
+            return -1;
+        }
+        bool end = *src == '\0';
+        *dst++ = '\0';
+        if (end) {
+            break;
+        }
+        src++;
+    }
+    return argc;
+}
+
+esp_err_t add_command(int argc, char **argv)
+{
+    ESP_RETURN_ON_FALSE(argc > 0 && argv, ESP_ERR_INVALID_ARG, TAG, "The command cannot be empty");
+    ESP_RETURN_ON_FALSE(!s_running, ESP_ERR_INVALID_STATE, TAG, "The script is running");
+    kind_t kind = get_kind(argv[0]);
+    uint32_t wait_ms = 0;
+    if (kind == KIND_WAIT) {
+        char *end = nullptr;
+        wait_ms = argc > 1 ? strtoul(argv[1], &end, 0) : 0;
+        ESP_RETURN_ON_FALSE(argc == 1 || (argc == 2 && *end == '\0'), ESP_ERR_INVALID_ARG, TAG, "Usage: wait [ms]");
+    }
+
+    size_t strings_size = 0;
+    for (int idx = 0; idx < argc; ++idx) {
+        strings_size += strlen(argv[idx]) + 1;
+    }
+    size_t argv_offset = sizeof(line_t);
+    size_t strings_offset = argv_offset + argc * sizeof(char *);
+    uint8_t *block = (uint8_t *)esp_matter_mem_calloc(1, strings_offset + strings_size);
+    ESP_RETURN_ON_FALSE(block, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the command");
+    line_t *entry = reinterpret_cast<line_t *>(block);
+    char *strings = reinterpret_cast<char *>(block + strings_offset);
+    entry->kind = kind;
+    entry->wait_ms = wait_ms;
+    entry->argc = argc;
+    entry->argv = reinterpret_cast<char **>(block + argv_offset);
+    for (int idx = 0; idx < argc; ++idx) {
+        strcpy(strings, argv[idx]);
+        entry->argv[idx] = strings;
+        strings += strlen(argv[idx]) + 1;
+    }
+
+    if (s_tail) {
+        s_tail->next = entry;
+    } else {
+        s_head = entry;
+    }
+    s_tail = entry;
+    s_count++;
+    return ESP_OK;
+}
+
+esp_err_t add_line(const char *line)
+{
+    ESP_RETURN_ON_FALSE(line, ESP_ERR_INVALID_ARG, TAG, "line cannot be NULL");
+    ESP_RETURN_ON_FALSE(!s_running, ESP_ERR_INVALID_STATE, TAG, "The script is running");
+    char *buf = (char *)esp_matter_mem_calloc(1, strlen(line) + 1);
+    ESP_RETURN_ON_FALSE(buf, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the line");
+    strcpy(buf, line);
+
+    char *args[k_max_args];
+    int argc = tokenize(buf, args);
+    esp_err_t err = ESP_OK;
+    if (argc < 0) {
+        err = ESP_ERR_INVALID_ARG;
+    } else if (argc > 0 && args[0][0] != '#') {
+        err = add_command(argc, args);
+    }
+    esp_matter_mem_free(buf);
+    return err;
+}
+
+esp_err_t load_file(const char *path)
+{
+    ESP_RETURN_ON_FALSE(path, ESP_ERR_INVALID_ARG, TAG, "path cannot be NULL");
+    ESP_RETURN_ON_FALSE(!s_running, ESP_ERR_INVALID_STATE, TAG, "The script is running");
+    FILE *file = fopen(path, "r");
+    ESP_RETURN_ON_FALSE(file, ESP_ERR_NOT_FOUND, TAG, "Failed to open %s", path);
+    char *buf = (char *)esp_matter_mem_calloc(1, k_max_line_len);
+    if (!buf) {
+        fclose(file);
+        ESP_LOGE(TAG, "Failed to alloc memory for the line buffer");
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = ESP_OK;
+    size_t count = s_count;
+    unsigned line_no = 0;
+    while (fgets(buf, k_max_line_len, file)) {
+        line_no++;
+        size_t len = strlen(buf);
+        if (len == k_max_line_len - 1 && buf[len - 1] != '\n' && !feof(file)) {
+            ESP_LOGE(TAG, "%s:%u: line too long", path, line_no);
+            err = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+        if ((err = add_line(buf)) != ESP_OK) {
+            ESP_LOGE(TAG, "%s:%u: invalid line", path, line_no);
+            break;
+        }
+    }
+    esp_matter_mem_free(buf);
+    fclose(file);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Loaded %u commands from %s", (unsigned)(s_count - count), path);
+    }
+    return err;
+}
+
+esp_err_t clear()
+{
+    ESP_RETURN_ON_FALSE(!s_running, ESP_ERR_INVALID_STATE, TAG, "The script is running");
+    while (s_head) {
+        line_t *next = s_head->next;
+        esp_matter_mem_free(s_head);
+        s_head = next;
+    }
+    s_tail = nullptr;
+    s_count = 0;
+    return ESP_OK;
+}
+
+size_t get_line_count()
+{
+    return s_count;
+}
+
+void print()
+{
+    unsigned index = 0;
+    for (line_t *line = s_head; line; line = line->next) {
+        printf("%3u %c", ++index, line->kind == KIND_CONCURRENT ? '|' : ' ');
+        for (int idx = 0; idx < line->argc; ++idx) {
+            printf(" %s", line->argv[idx]);
+        }
+        printf("\n");
+    }
+}
+
+void print_summary(const summary_t *summary)
+{
+    if (!summary) {
+        return;
+    }
+    printf("Script: %u commands, %u failed, %" PRIu32 " ms\n", summary->commands, summary->failed,
+           summary->total_ms);
+    printf("Waited %" PRIu32 " ms for the concurrency limit, %" PRIu32 " ms for the commands in flight\n",
+           summary->limit_wait_ms, summary->barrier_wait_ms);
+    printf("Max in flight: %u, max command start: %" PRIu32 " ms\n", summary->max_in_flight,
+           summary->max_issue_ms);
+}
+
+/* The read, write and invoke command objects in use are the commands in flight, the script limit keeps them in the
+ * pools */
+static uint16_t get_in_flight()
+{
+    return cluster_command::get_pool_stats().in_use + read_command::get_pool_stats().in_use +
+        write_command::get_pool_stats().in_use;
+}
+
+static void set_block(block_t block)
+{
+    if (block == s_block) {
+        return;
+    }
+    int64_t now = esp_timer_get_time();
+    uint32_t elapsed_ms = (now - s_block_start_us) / 1000;
+    if (s_block == BLOCK_LIMIT) {
+        s_summary.limit_wait_ms += elapsed_ms;
+    } else if (s_block == BLOCK_BARRIER) {
+        s_summary.barrier_wait_ms += elapsed_ms;
+    }
+    s_block = block;
+    s_block_start_us = now;
+}
+
+static void finish()
+{
+    set_block(BLOCK_NONE);
+    s_summary.total_ms = (esp_timer_get_time() - s_start_us) / 1000;
+    s_running = false;
+    s_next = nullptr;
+    summary_t summary = s_summary;
+    if (s_done_cb) {
+        s_done_cb(&summary);
+    }
+}
+
+static void step(chip::System::Layer *layer, void *context);
+
+static void wait(block_t block)
+{
+    set_block(block);
+    if (chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(k_poll_interval_ms), step,
+                                                    nullptr) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to start the script timer, stopping the script");
+        finish();
+    }
+}
+
+static void step(chip::System::Layer *layer, void *context)
+{
+    while (s_next) {
+        line_t *line = s_next;
+        uint16_t in_flight = get_in_flight();
+        if (line->kind == KIND_CONCURRENT && in_flight >= s_max_concurrent) {
+            return wait(BLOCK_LIMIT);
+        }
+        if (line->kind != KIND_CONCURRENT && in_flight > 0) {
+            return wait(BLOCK_BARRIER);
+        }
+        if (line->kind == KIND_WAIT) {
+            int64_t now = esp_timer_get_time();
+            if (s_wait_until_us == 0) {
+                s_wait_until_us = now + (int64_t)line->wait_ms * 1000;
+            }
+            if (now < s_wait_until_us) {
+                return wait(BLOCK_BARRIER);
+            }
+            s_wait_until_us = 0;
+            s_next = line->next;
+            continue;
+        }
+
+        set_block(BLOCK_NONE);
+        int64_t start_us = esp_timer_get_time();
+        esp_err_t err = s_exec_cb(line->argc, line->argv);
+        uint32_t issue_ms = (esp_timer_get_time() - start_us) / 1000;
+        s_summary.commands++;
+        if (err != ESP_OK) {
+            s_summary.failed++;
+            ESP_LOGE(TAG, "Command %u (%s) failed: %s", s_summary.commands, line->argv[0], esp_err_to_name(err));
+        }
+        if (line->kind == KIND_CONCURRENT) {
+            if (issue_ms > s_summary.max_issue_ms) {
+                s_summary.max_issue_ms = issue_ms;
+            }
+            in_flight = get_in_flight();
+            if (in_flight > s_summary.max_in_flight) {
+                s_summary.max_in_flight = in_flight;
+            }
+        }
+        s_next = line->next;
+    }
+    // All the commands are started, the script is done when the last ones finish
+    if (get_in_flight() > 0) {
+        return wait(BLOCK_BARRIER);
+    }
+    finish();
+}
+
+esp_err_t run(exec_cb_t exec_cb, uint16_t max_concurrent, done_cb_t done_cb)
+{
+    ESP_RETURN_ON_FALSE(exec_cb, ESP_ERR_INVALID_ARG, TAG, "exec_cb cannot be NULL");
+    ESP_RETURN_ON_FALSE(!s_running, ESP_ERR_INVALID_STATE, TAG, "The script is already running");
+    ESP_RETURN_ON_FALSE(s_head, ESP_ERR_INVALID_STATE, TAG, "The script is empty");
+    if (max_concurrent == 0) {
+        max_concurrent = CONFIG_ESP_MATTER_CONTROLLER_SCRIPT_MAX_CONCURRENT;
+    }
+    if (max_concurrent > command_pool::k_pool_size) {
+        ESP_LOGW(TAG, "Concurrency limited to the command pool size %u", (unsigned)command_pool::k_pool_size);
+        max_concurrent = command_pool::k_pool_size;
+    }
+    s_exec_cb = exec_cb;
+    s_done_cb = done_cb;
+    s_max_concurrent = max_concurrent;
+    memset(&s_summary, 0, sizeof(s_summary));
+    s_running = true;
+    s_next = s_head;
+    s_wait_until_us = 0;
+    s_block = BLOCK_NONE;
+    s_start_us = esp_timer_get_time();
+    step(&chip::DeviceLayer::SystemLayer(), nullptr);
+    return ESP_OK;
+}
+
+} // namespace script
+} // namespace controller
+} // namespace esp_matter
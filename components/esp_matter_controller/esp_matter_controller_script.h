@@ -0,0 +1,126 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace controller {
+namespace script {
+
+/*
+ * Controller command scripts.
+ *
+ * A script is a list of controller console commands, one per line, without the "matter esp controller" prefix.
+ * The lines are split into their arguments when they are loaded, with the double quotes grouping the arguments
+ * which contain spaces and a backslash escaping the next character, as the console does. The empty lines and the
+ * lines starting with '#' are skipped.
+ *
+ * The read-attr, read-event, write-attr and invoke-cmd commands only start a transaction, so they are run without
+ * waiting for the previous ones, while the number of read, write and invoke commands in flight is below the limit.
+ * The other commands, such as pairing or group-settings, wait for all the commands in flight to finish. A
+ * "wait [ms]" line waits for all the commands in flight, and then for the given time, for example to let a device
+ * finish its commissioning. The commands to a node which depend on each other should be separated by a "wait".
+ *
+ * The scripts are loaded and run in the Matter context.
+ */
+
+/** Runs a command of the script and returns its result, such as the exec_command of the console engine */
+using exec_cb_t = esp_err_t (*)(int argc, char **argv);
+
+/** Summary of a script run */
+typedef struct {
+    uint16_t commands;
+    uint16_t failed;
+    uint16_t max_in_flight;
+    uint32_t total_ms;
+    /* Time the script was blocked by the concurrency limit */
+    uint32_t limit_wait_ms;
+    /* Time the script waited for the commands in flight before the sequential commands and at the "wait" lines */
+    uint32_t barrier_wait_ms;
+    /* Longest time from the start of a concurrent command to the return of its handler */
+    uint32_t max_issue_ms;
+} summary_t;
+
+using done_cb_t = void (*)(const summary_t *summary);
+
+/**
+ * @brief Parses a line and appends it to the script.
+ *
+ * @param line Command line
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the script is running, appropriate error code otherwise
+ */
+esp_err_t add_line(const char *line);
+
+/**
+ * @brief Appends a command, already split into its arguments, to the script.
+ *
+ * @param argc Number of arguments
+ * @param argv Arguments, starting with the command name
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the script is running, appropriate error code otherwise
+ */
+esp_err_t add_command(int argc, char **argv);
+
+/**
+ * @brief Parses the lines of a file and appends them to the script.
+ *
+ * The file system of the file, such as SPIFFS, should be mounted by the application.
+ *
+ * @param path Path of the file
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the file cannot be opened, appropriate error code otherwise
+ */
+esp_err_t load_file(const char *path);
+
+/**
+ * @brief Removes all the lines of the script.
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the script is running
+ */
+esp_err_t clear();
+
+/**
+ * @brief Gets the number of lines of the script.
+ */
+size_t get_line_count();
+
+/**
+ * @brief Prints the lines of the script.
+ */
+void print();
+
+/**
+ * @brief Starts running the script.
+ *
+ * @param exec_cb Callback running each command
+ * @param max_concurrent Maximum number of read, write and invoke commands in flight, 0 for the default
+ * @param done_cb Callback called with the summary when the script is done, can be NULL
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the script is already running or is empty
+ */
+esp_err_t run(exec_cb_t exec_cb, uint16_t max_concurrent, done_cb_t done_cb);
+
+/**
+ * @brief Prints a script run summary.
+ */
+void print_summary(const summary_t *summary);
+
+} // namespace script
+} // namespace controller
+} // namespace esp_matter
@@ -19,7 +19,10 @@
 #else
 #include <app/server/Server.h>
 #endif
+#include <esp_matter_controller_attribute_cache.h>
+#include <esp_matter_controller_node_composition.h>
 #include <esp_matter_controller_subscribe_command.h>
+#include <esp_matter_controller_time_series.h>
 
 #include "DataModelLogger.h"
 
@@ -36,6 +39,8 @@ static const uint8_t k_max_resubscribe_retries = 2;
 namespace esp_matter {
 namespace controller {
 
+command_pool::pool<subscribe_command> subscribe_command::s_pool;
+
 void subscribe_command::on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                                 const SessionHandle &sessionHandle)
 {
@@ -44,7 +49,7 @@ void subscribe_command::on_device_connected_fcn(void *context, ExchangeManager &
     CHIP_ERROR err = CHIP_NO_ERROR;
     if (cmd->m_attr_paths.AllocatedSize() == 0 && cmd->m_event_paths.AllocatedSize() == 0) {
         ESP_LOGE(TAG, "Cannot send Subscribe command with NULL attribute path and NULL event path");
-        chip::Platform::Delete(cmd);
+        subscribe_command::destroy(cmd);
         return;
     }
 
@@ -64,8 +69,10 @@ void subscribe_command::on_device_connected_fcn(void *context, ExchangeManager &
                                         ReadClient::InteractionType::Subscribe);
     if (!client) {
         ESP_LOGE(TAG, "Failed to alloc memory for read client");
-        chip::Platform::Delete(cmd);
+        subscribe_command::destroy(cmd);
+        return;
     }
+    cmd->m_client = client;
     if (cmd->m_auto_resubscribe) {
         err = client->SendAutoResubscribeRequest(std::move(params));
     } else {
@@ -74,7 +81,7 @@ void subscribe_command::on_device_connected_fcn(void *context, ExchangeManager &
     if (err != CHIP_NO_ERROR) {
         ESP_LOGE(TAG, "Failed to send read request");
         chip::Platform::Delete(client);
-        chip::Platform::Delete(cmd);
+        subscribe_command::destroy(cmd);
     }
     return;
 }
@@ -86,7 +93,7 @@ void subscribe_command::on_device_connection_failure_fcn(void *context, const Sc
     if (cmd->subscribe_failure_cb)
         cmd->subscribe_failure_cb((void *)cmd);
 
-    chip::Platform::Delete(cmd);
+    subscribe_command::destroy(cmd);
     return;
 }
 
@@ -104,7 +111,7 @@ esp_err_t subscribe_command::send_command()
                                                             &on_device_connected_cb, &on_device_connection_failure_cb);
     return ESP_OK;
 #endif
-    chip::Platform::Delete(this);
+    destroy(this);
     return ESP_FAIL;
 }
 
@@ -122,6 +129,11 @@ void subscribe_command::OnAttributeData(const chip::app::ConcreteDataAttributePa
         return;
     }
 
+    /* The value stays fresh until the next report is due */
+    attribute_cache::store(m_node_id, path, data, (uint32_t)m_max_interval * 1000);
+    node_composition::on_attribute_data(m_node_id, path, data);
+    time_series::on_attribute_data(m_node_id, path, data);
+
     chip::TLV::TLVReader log_data;
     log_data.Init(*data);
     error = DataModelLogger::LogAttribute(path, &log_data);
@@ -149,6 +161,10 @@ void subscribe_command::OnEventData(const chip::app::EventHeader &event_header,
         ESP_LOGE(TAG, "Response Failure: No Data");
         return;
     }
+    if (!event_cursor::update(m_node_id, m_event_paths.Get(), m_event_paths.AllocatedSize(), event_header)) {
+        // Already received for another path of the subscription
+        return;
+    }
 
     chip::TLV::TLVReader log_data;
     log_data.Init(*data);
@@ -177,9 +193,20 @@ void subscribe_command::OnSubscriptionEstablished(chip::SubscriptionId subscript
 {
     m_subscription_id = subscriptionId;
     m_resubscribe_retries = 0;
+    uint16_t min_interval = 0;
+    if (!m_client || m_client->GetReportingIntervals(min_interval, m_negotiated_max_interval) != CHIP_NO_ERROR) {
+        m_negotiated_max_interval = m_max_interval;
+    }
     ESP_LOGI(TAG, "Subscription 0x%" PRIx32 " established", subscriptionId);
 }
 
+void subscribe_command::OnReportEnd()
+{
+    /* Every report, including the empty ones, confirms that the subscribed values did not change otherwise */
+    attribute_cache::refresh(m_node_id, m_attr_paths.Get(), m_attr_paths.AllocatedSize(),
+                             (uint32_t)m_negotiated_max_interval * 1000);
+}
+
 CHIP_ERROR subscribe_command::OnResubscriptionNeeded(ReadClient *apReadClient, CHIP_ERROR aTerminationCause)
 {
     m_resubscribe_retries++;
@@ -199,7 +226,7 @@ void subscribe_command::OnDone(ReadClient *apReadClient)
         // This will be called when the subscription is terminated.
         subscribe_done_cb(m_node_id, m_subscription_id);
     }
-    chip::Platform::Delete(this);
+    destroy(this);
 }
 
 esp_err_t send_subscribe_attr_command(uint64_t node_id, ScopedMemoryBufferWithSize<uint16_t> &endpoint_ids,
@@ -225,7 +252,7 @@ esp_err_t send_subscribe_attr_command(uint64_t node_id, ScopedMemoryBufferWithSi
         attr_paths[i] = AttributePathParams(endpoint_ids[i], cluster_ids[i], attribute_ids[i]);
     }
 
-    subscribe_command *cmd = chip::Platform::New<subscribe_command>(
+    subscribe_command *cmd = subscribe_command::create(
         node_id, std::move(attr_paths), std::move(event_paths), min_interval, max_interval, auto_resubscribe);
     if (!cmd) {
         ESP_LOGE(TAG, "Failed to alloc memory for subscribe_command");
@@ -257,7 +284,7 @@ esp_err_t send_subscribe_event_command(uint64_t node_id, ScopedMemoryBufferWithS
         event_paths[i] = EventPathParams(endpoint_ids[i], cluster_ids[i], event_ids[i]);
     }
 
-    subscribe_command *cmd = chip::Platform::New<subscribe_command>(
+    subscribe_command *cmd = subscribe_command::create(
         node_id, std::move(attr_paths), std::move(event_paths), min_interval, max_interval, auto_resubscribe);
     if (!cmd) {
         ESP_LOGE(TAG, "Failed to alloc memory for subscribe_command");
@@ -17,6 +17,8 @@
 #include <app/BufferedReadCallback.h>
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_matter.h>
+#include <esp_matter_controller_command_pool.h>
+#include <esp_matter_controller_event_cursor.h>
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_mem.h>
 
@@ -93,6 +95,22 @@ public:
 
     ~subscribe_command() {}
 
+    /**
+     * @brief Creates a command, from the pool of the subscribe_command objects when one is free.
+     */
+    template <typename... Args>
+    static subscribe_command *create(Args &&...args)
+    {
+        return s_pool.create(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys a command created with create().
+     */
+    static void destroy(subscribe_command *cmd) { s_pool.destroy(cmd); }
+
+    static const command_pool::stats_t &get_pool_stats() { return s_pool.get_stats(); }
+
     esp_err_t send_command();
 
     // ReadClient Callback Interface
@@ -102,6 +120,12 @@ public:
     void OnEventData(const chip::app::EventHeader &event_header, chip::TLV::TLVReader *data,
                      const chip::app::StatusIB *status) override;
 
+    CHIP_ERROR GetHighestReceivedEventNumber(chip::Optional<chip::EventNumber> &event_number) override
+    {
+        event_cursor::get_highest_received(m_node_id, m_event_paths.Get(), m_event_paths.AllocatedSize(), event_number);
+        return CHIP_NO_ERROR;
+    }
+
     void OnError(CHIP_ERROR error) override;
 
     void OnDeallocatePaths(chip::app::ReadPrepareParams &&aReadPrepareParams) override;
@@ -110,9 +134,12 @@ public:
 
     void OnSubscriptionEstablished(chip::SubscriptionId subscriptionId) override;
 
+    void OnReportEnd() override;
+
     CHIP_ERROR OnResubscriptionNeeded(ReadClient *apReadClient, CHIP_ERROR aTerminationCause) override;
 
 private:
+    static command_pool::pool<subscribe_command> s_pool;
     uint64_t m_node_id;
     uint16_t m_min_interval;
     uint16_t m_max_interval;
@@ -120,6 +147,8 @@ private:
     BufferedReadCallback m_buffered_read_cb;
     uint32_t m_subscription_id = 0;
     uint8_t m_resubscribe_retries = 0;
+    ReadClient *m_client = nullptr;
+    uint16_t m_negotiated_max_interval = 0;
     ScopedMemoryBufferWithSize<AttributePathParams> m_attr_paths;
     ScopedMemoryBufferWithSize<EventPathParams> m_event_paths;
 
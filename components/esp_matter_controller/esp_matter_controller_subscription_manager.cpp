@@ -0,0 +1,933 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <app/BufferedReadCallback.h>
+#include <app/InteractionModelEngine.h>
+#include <app/ReadClient.h>
+#include <crypto/RandUtils.h>
+#include <esp_log.h>
+#include <esp_matter.h>
+#include <esp_timer.h>
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+#include <esp_matter_commissioner.h>
+#else
+#include <app/server/Server.h>
+#endif
+#include <esp_matter_controller_attribute_cache.h>
+#include <esp_matter_controller_event_cursor.h>
+#include <esp_matter_controller_node_composition.h>
+#include <esp_matter_controller_subscription_manager.h>
+#include <esp_matter_controller_time_series.h>
+#include <lib/support/CHIPMem.h>
+#include <nvs.h>
+#include <stdio.h>
+
+using chip::ScopedNodeId;
+using chip::SessionHandle;
+using chip::app::BufferedReadCallback;
+using chip::app::ConcreteDataAttributePath;
+using chip::app::EventHeader;
+using chip::app::InteractionModelEngine;
+using chip::app::ReadClient;
+using chip::app::ReadPrepareParams;
+using chip::Messaging::ExchangeManager;
+
+static const char *TAG = "subscription_manager";
+
+#define SUBSCRIPTION_NVS_NAMESPACE "esp_matter_subs"
+#define SUBSCRIPTION_NVS_KEY_FORMAT "sub_%u"
+#define SUBSCRIPTION_PERSISTED_VERSION 1
+
+namespace esp_matter {
+namespace controller {
+namespace subscription_manager {
+
+static constexpr uint32_t k_initial_backoff_ms = 1000;
+static constexpr uint32_t k_max_backoff_ms = CONFIG_ESP_MATTER_CONTROLLER_SUBSCRIPTION_MAX_BACKOFF * 1000;
+static constexpr uint16_t k_max_persistent = CONFIG_ESP_MATTER_CONTROLLER_SUBSCRIPTION_MAX_PERSISTENT;
+static constexpr int16_t k_not_persistent = -1;
+
+typedef struct __attribute__((packed)) {
+    uint8_t version;
+    uint16_t min_interval;
+    uint16_t max_interval;
+    uint16_t attr_path_count;
+    uint16_t event_path_count;
+    uint64_t node_id;
+} persisted_header_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    /* Attribute or event ID */
+    uint32_t id;
+    /* List index of the attribute paths, urgent flag of the event paths */
+    uint16_t extra;
+} persisted_path_t;
+
+typedef struct caller {
+    struct caller *next;
+    subscription_handle_t handle;
+    uint64_t node_id;
+    ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+    ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+    uint16_t min_interval;
+    uint16_t max_interval;
+    attribute_report_cb_t attribute_cb;
+    event_report_cb_t event_cb;
+    /* Restored from NVS and not added again yet */
+    bool restored;
+    int16_t persistent_slot;
+} caller_t;
+
+class node_subscription;
+
+static caller_t *s_callers = nullptr;
+static node_subscription *s_nodes = nullptr;
+static subscription_handle_t s_next_handle = 1;
+static attribute_report_cb_t s_default_attribute_cb = nullptr;
+static event_report_cb_t s_default_event_cb = nullptr;
+
+static bool attribute_path_covers(const AttributePathParams &a, const AttributePathParams &b)
+{
+    return (a.HasWildcardEndpointId() || a.mEndpointId == b.mEndpointId) &&
+        (a.HasWildcardClusterId() || a.mClusterId == b.mClusterId) &&
+        (a.HasWildcardAttributeId() || a.mAttributeId == b.mAttributeId) &&
+        (a.HasWildcardListIndex() || a.mListIndex == b.mListIndex);
+}
+
+static bool attribute_path_matches(const AttributePathParams &a, const ConcreteDataAttributePath &path)
+{
+    return (a.HasWildcardEndpointId() || a.mEndpointId == path.mEndpointId) &&
+        (a.HasWildcardClusterId() || a.mClusterId == path.mClusterId) &&
+        (a.HasWildcardAttributeId() || a.mAttributeId == path.mAttributeId);
+}
+
+static bool event_path_covers(const EventPathParams &a, const EventPathParams &b)
+{
+    return (a.HasWildcardEndpointId() || a.mEndpointId == b.mEndpointId) &&
+        (a.HasWildcardClusterId() || a.mClusterId == b.mClusterId) &&
+        (a.HasWildcardEventId() || a.mEventId == b.mEventId) && (a.mIsUrgentEvent || !b.mIsUrgentEvent);
+}
+
+static bool event_path_matches(const EventPathParams &a, const chip::app::ConcreteEventPath &path)
+{
+    return (a.HasWildcardEndpointId() || a.mEndpointId == path.mEndpointId) &&
+        (a.HasWildcardClusterId() || a.mClusterId == path.mClusterId) &&
+        (a.HasWildcardEventId() || a.mEventId == path.mEventId);
+}
+
+template <typename T, bool (*covers)(const T &, const T &)>
+static bool is_covered(const T &path, const ScopedMemoryBufferWithSize<T> &paths)
+{
+    for (size_t index = 0; index < paths.AllocatedSize(); index++) {
+        if (covers(paths[index], path)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Jittered exponential backoff, between half and the whole of the exponential delay */
+static uint32_t compute_backoff_ms(uint32_t attempt)
+{
+    uint64_t backoff_ms = (uint64_t)k_initial_backoff_ms << (attempt < 16 ? attempt : 16);
+    if (backoff_ms > k_max_backoff_ms) {
+        backoff_ms = k_max_backoff_ms;
+    }
+    uint32_t half = (uint32_t)(backoff_ms / 2);
+    return half + (half > 0 ? chip::Crypto::GetRandU32() % half : 0);
+}
+
+static CHIP_ERROR connect(uint64_t node_id, chip::Callback::Callback<chip::OnDeviceConnected> *on_connected,
+                          chip::Callback::Callback<chip::OnDeviceConnectionFailure> *on_failure)
+{
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    return commissioner::get_device_commissioner()->GetConnectedDevice(node_id, on_connected, on_failure);
+#else
+    chip::Server::GetInstance().GetCASESessionManager()->FindOrEstablishSession(
+        ScopedNodeId(node_id, get_fabric_index()), on_connected, on_failure);
+    return CHIP_NO_ERROR;
+#endif
+}
+
+class node_subscription : public ReadClient::Callback {
+public:
+    node_subscription(uint64_t node_id)
+        : m_node_id(node_id)
+        , m_buffered_read_cb(*this)
+        , m_on_connected_cb(on_connected_fcn, this)
+        , m_on_connection_failure_cb(on_connection_failure_fcn, this)
+    {
+    }
+
+    ~node_subscription()
+    {
+        stop();
+    }
+
+    node_subscription *next = nullptr;
+
+    uint64_t get_node_id() const { return m_node_id; }
+
+    /* Whether the current subscription carries the reports the caller needs */
+    bool serves(const caller_t *caller) const
+    {
+        if (!m_client || caller->max_interval < m_max_interval) {
+            return false;
+        }
+        for (size_t index = 0; index < caller->attr_paths.AllocatedSize(); index++) {
+            if (!is_covered<AttributePathParams, attribute_path_covers>(caller->attr_paths[index], m_attr_paths)) {
+                return false;
+            }
+        }
+        for (size_t index = 0; index < caller->event_paths.AllocatedSize(); index++) {
+            if (!is_covered<EventPathParams, event_path_covers>(caller->event_paths[index], m_event_paths)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* Subscribes again with the union of the paths of the callers */
+    esp_err_t restart()
+    {
+        stop();
+        esp_err_t err = merge_paths();
+        if (err != ESP_OK) {
+            return err;
+        }
+        m_attempts = 0;
+        start();
+        return ESP_OK;
+    }
+
+    void stop()
+    {
+        chip::DeviceLayer::SystemLayer().CancelTimer(retry_timer_callback, this);
+        m_on_connected_cb.Cancel();
+        m_on_connection_failure_cb.Cancel();
+        if (m_client) {
+            /* The publisher drops the subscription when its next report is rejected */
+            chip::Platform::Delete(m_client);
+            m_client = nullptr;
+        }
+        m_state = NODE_STATE_CONNECTING;
+    }
+
+    void get_stats(node_stats_t *stats) const
+    {
+        stats->state = m_state;
+        stats->caller_count = 0;
+        for (const caller_t *caller = s_callers; caller; caller = caller->next) {
+            if (caller->node_id == m_node_id) {
+                stats->caller_count++;
+            }
+        }
+        stats->subscription_id = m_subscription_id;
+        stats->max_interval = m_negotiated_max_interval;
+        stats->report_count = m_report_count;
+        stats->record_count = m_record_count;
+        stats->resubscribe_count = m_resubscribe_count;
+        int64_t now_us = esp_timer_get_time();
+        int64_t established_us = now_us - m_established_us;
+        stats->reports_per_minute = 0;
+        if (m_state == NODE_STATE_ESTABLISHED && established_us > 0) {
+            stats->reports_per_minute = (uint32_t)((uint64_t)m_reports_since_established * 60000000 / established_us);
+        }
+        stats->seconds_since_last_report = UINT32_MAX;
+        if (m_last_report_us > 0) {
+            stats->seconds_since_last_report = (uint32_t)((now_us - m_last_report_us) / 1000000);
+        }
+        stats->alive = m_state == NODE_STATE_ESTABLISHED &&
+            stats->seconds_since_last_report <= m_negotiated_max_interval;
+    }
+
+    // ReadClient Callback Interface
+    void OnReportEnd() override
+    {
+        m_report_count++;
+        m_reports_since_established++;
+        m_last_report_us = esp_timer_get_time();
+        attribute_cache::refresh(m_node_id, m_attr_paths.Get(), m_attr_paths.AllocatedSize(),
+                                 (uint32_t)m_negotiated_max_interval * 1000);
+    }
+
+    void OnAttributeData(const ConcreteDataAttributePath &path, chip::TLV::TLVReader *data,
+                         const chip::app::StatusIB &status) override
+    {
+        CHIP_ERROR error = status.ToChipError();
+        if (CHIP_NO_ERROR != error) {
+            ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(error));
+            return;
+        }
+        if (data == nullptr) {
+            ESP_LOGE(TAG, "Response Failure: No Data");
+            return;
+        }
+        m_record_count++;
+        attribute_cache::store(m_node_id, path, data, (uint32_t)m_max_interval * 1000);
+        node_composition::on_attribute_data(m_node_id, path, data);
+        time_series::on_attribute_data(m_node_id, path, data);
+        for (caller_t *caller = s_callers; caller; caller = caller->next) {
+            attribute_report_cb_t callback = caller->restored ? s_default_attribute_cb : caller->attribute_cb;
+            if (caller->node_id != m_node_id || !callback) {
+                continue;
+            }
+            for (size_t index = 0; index < caller->attr_paths.AllocatedSize(); index++) {
+                if (attribute_path_matches(caller->attr_paths[index], path)) {
+                    chip::TLV::TLVReader data_cpy;
+                    data_cpy.Init(*data);
+                    callback(m_node_id, path, &data_cpy);
+                    break;
+                }
+            }
+        }
+    }
+
+    void OnEventData(const EventHeader &event_header, chip::TLV::TLVReader *data,
+                     const chip::app::StatusIB *status) override
+    {
+        if (status != nullptr && status->ToChipError() != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Response Failure: %s", chip::ErrorStr(status->ToChipError()));
+            return;
+        }
+        if (data == nullptr) {
+            ESP_LOGE(TAG, "Response Failure: No Data");
+            return;
+        }
+        if (!event_cursor::update(m_node_id, m_event_paths.Get(), m_event_paths.AllocatedSize(), event_header)) {
+            // Already received for another path of the subscription
+            return;
+        }
+        m_record_count++;
+        for (caller_t *caller = s_callers; caller; caller = caller->next) {
+            event_report_cb_t callback = caller->restored ? s_default_event_cb : caller->event_cb;
+            if (caller->node_id != m_node_id || !callback) {
+                continue;
+            }
+            for (size_t index = 0; index < caller->event_paths.AllocatedSize(); index++) {
+                if (event_path_matches(caller->event_paths[index], event_header.mPath)) {
+                    chip::TLV::TLVReader data_cpy;
+                    data_cpy.Init(*data);
+                    callback(m_node_id, event_header, &data_cpy);
+                    break;
+                }
+            }
+        }
+    }
+
+    void OnError(CHIP_ERROR error) override
+    {
+        ESP_LOGE(TAG, "Subscription to node 0x%016" PRIX64 " error: %s", m_node_id, chip::ErrorStr(error));
+    }
+
+    void OnDeallocatePaths(ReadPrepareParams &&aReadPrepareParams) override
+    {
+        // Intentionally empty because the path lists are owned by the node_subscription.
+    }
+
+    CHIP_ERROR GetHighestReceivedEventNumber(chip::Optional<chip::EventNumber> &event_number) override
+    {
+        event_cursor::get_highest_received(m_node_id, m_event_paths.Get(), m_event_paths.AllocatedSize(), event_number);
+        return CHIP_NO_ERROR;
+    }
+
+    void OnSubscriptionEstablished(chip::SubscriptionId subscriptionId) override
+    {
+        m_subscription_id = subscriptionId;
+        m_state = NODE_STATE_ESTABLISHED;
+        m_attempts = 0;
+        m_established_us = esp_timer_get_time();
+        m_last_report_us = m_established_us;
+        m_reports_since_established = 0;
+        uint16_t min_interval = 0;
+        if (m_client->GetReportingIntervals(min_interval, m_negotiated_max_interval) != CHIP_NO_ERROR) {
+            m_negotiated_max_interval = m_max_interval;
+        }
+        ESP_LOGI(TAG, "Subscription 0x%" PRIx32 " to node 0x%016" PRIX64 " established", subscriptionId, m_node_id);
+    }
+
+    CHIP_ERROR OnResubscriptionNeeded(ReadClient *apReadClient, CHIP_ERROR aTerminationCause) override
+    {
+        m_state = NODE_STATE_RESUBSCRIBING;
+        m_resubscribe_count++;
+        uint32_t backoff_ms = compute_backoff_ms(apReadClient->GetNumResubscriptionRetries());
+        ESP_LOGW(TAG, "Resubscribing to node 0x%016" PRIX64 " in %" PRIu32 " ms: %s", m_node_id, backoff_ms,
+                 chip::ErrorStr(aTerminationCause));
+        /* A timeout usually means that the session is gone as well */
+        return apReadClient->ScheduleResubscription(backoff_ms, chip::NullOptional,
+                                                    aTerminationCause == CHIP_ERROR_TIMEOUT);
+    }
+
+    void OnDone(ReadClient *apReadClient) override
+    {
+        ESP_LOGW(TAG, "Subscription to node 0x%016" PRIX64 " terminated", m_node_id);
+        chip::Platform::Delete(apReadClient);
+        m_client = nullptr;
+        schedule_retry();
+    }
+
+private:
+    esp_err_t merge_paths()
+    {
+        size_t attr_path_count = 0;
+        size_t event_path_count = 0;
+        uint16_t min_interval = UINT16_MAX;
+        uint16_t max_interval = UINT16_MAX;
+        for (const caller_t *caller = s_callers; caller; caller = caller->next) {
+            if (caller->node_id == m_node_id) {
+                attr_path_count += caller->attr_paths.AllocatedSize();
+                event_path_count += caller->event_paths.AllocatedSize();
+                min_interval = std::min(min_interval, caller->min_interval);
+                max_interval = std::min(max_interval, caller->max_interval);
+            }
+        }
+        m_min_interval = min_interval;
+        m_max_interval = max_interval;
+        m_attr_paths.Free();
+        m_event_paths.Free();
+        ScopedMemoryBufferWithSize<AttributePathParams> attr_paths;
+        ScopedMemoryBufferWithSize<EventPathParams> event_paths;
+        if ((attr_path_count > 0 && !attr_paths.Alloc(attr_path_count)) ||
+            (event_path_count > 0 && !event_paths.Alloc(event_path_count))) {
+            ESP_LOGE(TAG, "Failed to alloc memory for the subscription paths");
+            return ESP_ERR_NO_MEM;
+        }
+        attr_path_count = 0;
+        event_path_count = 0;
+        for (const caller_t *caller = s_callers; caller; caller = caller->next) {
+            if (caller->node_id != m_node_id) {
+                continue;
+            }
+            for (size_t index = 0; index < caller->attr_paths.AllocatedSize(); index++) {
+                attr_paths[attr_path_count++] = caller->attr_paths[index];
+            }
+            for (size_t index = 0; index < caller->event_paths.AllocatedSize(); index++) {
+                event_paths[event_path_count++] = caller->event_paths[index];
+            }
+        }
+        /* Drop the paths covered by another one, keeping the first of the identical ones */
+        size_t attr_count = 0;
+        if (attr_path_count > 0) {
+            for (size_t index = 0; index < attr_path_count; index++) {
+                bool covered = false;
+                for (size_t other = 0; other < attr_path_count && !covered; other++) {
+                    covered = other != index && attribute_path_covers(attr_paths[other], attr_paths[index]) &&
+                        (other < index || !attribute_path_covers(attr_paths[index], attr_paths[other]));
+                }
+                if (!covered) {
+                    attr_paths[attr_count++] = attr_paths[index];
+                }
+            }
+            m_attr_paths.Alloc(attr_count);
+            for (size_t index = 0; index < attr_count && m_attr_paths.Get(); index++) {
+                m_attr_paths[index] = attr_paths[index];
+            }
+        }
+        size_t event_count = 0;
+        if (event_path_count > 0) {
+            for (size_t index = 0; index < event_path_count; index++) {
+                bool covered = false;
+                for (size_t other = 0; other < event_path_count && !covered; other++) {
+                    covered = other != index && event_path_covers(event_paths[other], event_paths[index]) &&
+                        (other < index || !event_path_covers(event_paths[index], event_paths[other]));
+                }
+                if (!covered) {
+                    event_paths[event_count++] = event_paths[index];
+                }
+            }
+            m_event_paths.Alloc(event_count);
+            for (size_t index = 0; index < event_count && m_event_paths.Get(); index++) {
+                m_event_paths[index] = event_paths[index];
+            }
+        }
+        if ((attr_count > 0 && !m_attr_paths.Get()) || (event_count > 0 && !m_event_paths.Get())) {
+            ESP_LOGE(TAG, "Failed to alloc memory for the subscription paths");
+            return ESP_ERR_NO_MEM;
+        }
+        return ESP_OK;
+    }
+
+    void start()
+    {
+        m_state = NODE_STATE_CONNECTING;
+        if (connect(m_node_id, &m_on_connected_cb, &m_on_connection_failure_cb) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to connect to node 0x%016" PRIX64, m_node_id);
+            schedule_retry();
+        }
+    }
+
+    void schedule_retry()
+    {
+        uint32_t backoff_ms = compute_backoff_ms(m_attempts++);
+        m_state = NODE_STATE_BACKOFF;
+        m_resubscribe_count++;
+        ESP_LOGW(TAG, "Subscribing to node 0x%016" PRIX64 " again in %" PRIu32 " ms", m_node_id, backoff_ms);
+        if (chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(backoff_ms),
+                                                        retry_timer_callback, this) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to start the subscription retry timer");
+        }
+    }
+
+    static void retry_timer_callback(chip::System::Layer *layer, void *context)
+    {
+        static_cast<node_subscription *>(context)->start();
+    }
+
+    static void on_connected_fcn(void *context, ExchangeManager &exchangeMgr, const SessionHandle &sessionHandle)
+    {
+        node_subscription *node = static_cast<node_subscription *>(context);
+        node->subscribe(exchangeMgr, sessionHandle);
+    }
+
+    static void on_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
+    {
+        node_subscription *node = static_cast<node_subscription *>(context);
+        ESP_LOGW(TAG, "Failed to connect to node 0x%016" PRIX64 ": %s", peerId.GetNodeId(), chip::ErrorStr(error));
+        node->schedule_retry();
+    }
+
+    void subscribe(ExchangeManager &exchange_mgr, const SessionHandle &session_handle)
+    {
+        if (m_client) {
+            return;
+        }
+        ReadPrepareParams params(session_handle);
+        params.mpAttributePathParamsList = m_attr_paths.Get();
+        params.mAttributePathParamsListSize = m_attr_paths.AllocatedSize();
+        params.mpEventPathParamsList = m_event_paths.Get();
+        params.mEventPathParamsListSize = m_event_paths.AllocatedSize();
+        params.mIsFabricFiltered = 0;
+        params.mMinIntervalFloorSeconds = m_min_interval;
+        params.mMaxIntervalCeilingSeconds = m_max_interval;
+        /* Do not drop the subscriptions of the subscribe commands to the same node */
+        params.mKeepSubscriptions = true;
+
+        m_client = chip::Platform::New<ReadClient>(InteractionModelEngine::GetInstance(), &exchange_mgr,
+                                                   m_buffered_read_cb, ReadClient::InteractionType::Subscribe);
+        if (!m_client) {
+            ESP_LOGE(TAG, "Failed to alloc memory for read client");
+            schedule_retry();
+            return;
+        }
+        m_state = NODE_STATE_SUBSCRIBING;
+        if (m_client->SendAutoResubscribeRequest(std::move(params)) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to send the subscribe request to node 0x%016" PRIX64, m_node_id);
+            chip::Platform::Delete(m_client);
+            m_client = nullptr;
+            schedule_retry();
+        }
+    }
+
+    uint64_t m_node_id;
+    BufferedReadCallback m_buffered_read_cb;
+    chip::Callback::Callback<chip::OnDeviceConnected> m_on_connected_cb;
+    chip::Callback::Callback<chip::OnDeviceConnectionFailure> m_on_connection_failure_cb;
+    ReadClient *m_client = nullptr;
+    ScopedMemoryBufferWithSize<AttributePathParams> m_attr_paths;
+    ScopedMemoryBufferWithSize<EventPathParams> m_event_paths;
+    uint16_t m_min_interval = 0;
+    uint16_t m_max_interval = UINT16_MAX;
+    node_state_t m_state = NODE_STATE_CONNECTING;
+    uint32_t m_attempts = 0;
+    uint32_t m_subscription_id = 0;
+    uint16_t m_negotiated_max_interval = 0;
+    uint32_t m_report_count = 0;
+    uint32_t m_record_count = 0;
+    uint32_t m_reports_since_established = 0;
+    uint32_t m_resubscribe_count = 0;
+    int64_t m_established_us = 0;
+    int64_t m_last_report_us = 0;
+};
+
+static node_subscription *find_node(uint64_t node_id)
+{
+    for (node_subscription *node = s_nodes; node; node = node->next) {
+        if (node->get_node_id() == node_id) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+static void format_key(char *key, size_t size, int16_t slot)
+{
+    snprintf(key, size, SUBSCRIPTION_NVS_KEY_FORMAT, (unsigned)slot);
+}
+
+static esp_err_t store_caller(caller_t *caller)
+{
+    bool used[k_max_persistent] = {};
+    for (const caller_t *other = s_callers; other; other = other->next) {
+        if (other->persistent_slot >= 0) {
+            used[other->persistent_slot] = true;
+        }
+    }
+    int16_t slot = 0;
+    while (slot < k_max_persistent && used[slot]) {
+        slot++;
+    }
+    if (slot >= k_max_persistent) {
+        ESP_LOGE(TAG, "No room left for the persistent subscription");
+        return ESP_ERR_NO_MEM;
+    }
+    size_t path_count = caller->attr_paths.AllocatedSize() + caller->event_paths.AllocatedSize();
+    size_t size = sizeof(persisted_header_t) + path_count * sizeof(persisted_path_t);
+    uint8_t *blob = (uint8_t *)chip::Platform::MemoryCalloc(1, size);
+    if (!blob) {
+        return ESP_ERR_NO_MEM;
+    }
+    persisted_header_t *header = (persisted_header_t *)blob;
+    header->version = SUBSCRIPTION_PERSISTED_VERSION;
+    header->min_interval = caller->min_interval;
+    header->max_interval = caller->max_interval;
+    header->attr_path_count = caller->attr_paths.AllocatedSize();
+    header->event_path_count = caller->event_paths.AllocatedSize();
+    header->node_id = caller->node_id;
+    persisted_path_t *path = (persisted_path_t *)(blob + sizeof(persisted_header_t));
+    for (size_t index = 0; index < caller->attr_paths.AllocatedSize(); index++, path++) {
+        const AttributePathParams &attr_path = caller->attr_paths[index];
+        *path = {attr_path.mEndpointId, attr_path.mClusterId, attr_path.mAttributeId, attr_path.mListIndex};
+    }
+    for (size_t index = 0; index < caller->event_paths.AllocatedSize(); index++, path++) {
+        const EventPathParams &event_path = caller->event_paths[index];
+        *path = {event_path.mEndpointId, event_path.mClusterId, event_path.mEventId,
+                 (uint16_t)event_path.mIsUrgentEvent};
+    }
+
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, SUBSCRIPTION_NVS_NAMESPACE, NVS_READWRITE,
+                                            &handle);
+    if (err == ESP_OK) {
+        char key[16];
+        format_key(key, sizeof(key), slot);
+        err = nvs_set_blob(handle, key, blob, size);
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    chip::Platform::MemoryFree(blob);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to store the subscription: %s", esp_err_to_name(err));
+        return err;
+    }
+    caller->persistent_slot = slot;
+    return ESP_OK;
+}
+
+static void erase_caller(const caller_t *caller)
+{
+    nvs_handle_t handle;
+    if (nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, SUBSCRIPTION_NVS_NAMESPACE, NVS_READWRITE,
+                                &handle) != ESP_OK) {
+        return;
+    }
+    char key[16];
+    format_key(key, sizeof(key), caller->persistent_slot);
+    if (nvs_erase_key(handle, key) == ESP_OK) {
+        nvs_commit(handle);
+    }
+    nvs_close(handle);
+}
+
+static caller_t *create_caller(uint64_t node_id, size_t attr_path_count, size_t event_path_count)
+{
+    caller_t *caller = chip::Platform::New<caller_t>();
+    if (!caller) {
+        return nullptr;
+    }
+    if ((attr_path_count > 0 && !caller->attr_paths.Alloc(attr_path_count)) ||
+        (event_path_count > 0 && !caller->event_paths.Alloc(event_path_count))) {
+        chip::Platform::Delete(caller);
+        return nullptr;
+    }
+    caller->next = nullptr;
+    caller->handle = s_next_handle++;
+    caller->node_id = node_id;
+    caller->attribute_cb = nullptr;
+    caller->event_cb = nullptr;
+    caller->restored = false;
+    caller->persistent_slot = k_not_persistent;
+    return caller;
+}
+
+static caller_t *load_caller(nvs_handle_t handle, int16_t slot)
+{
+    char key[16];
+    format_key(key, sizeof(key), slot);
+    size_t size = 0;
+    if (nvs_get_blob(handle, key, NULL, &size) != ESP_OK || size < sizeof(persisted_header_t)) {
+        return nullptr;
+    }
+    uint8_t *blob = (uint8_t *)chip::Platform::MemoryAlloc(size);
+    if (!blob) {
+        return nullptr;
+    }
+    caller_t *caller = nullptr;
+    const persisted_header_t *header = (const persisted_header_t *)blob;
+    const persisted_path_t *path = (const persisted_path_t *)(blob + sizeof(persisted_header_t));
+    if (nvs_get_blob(handle, key, blob, &size) != ESP_OK || header->version != SUBSCRIPTION_PERSISTED_VERSION ||
+        size != sizeof(persisted_header_t) +
+            (header->attr_path_count + header->event_path_count) * sizeof(persisted_path_t)) {
+        ESP_LOGE(TAG, "Invalid persistent subscription %s", key);
+        goto exit;
+    }
+    caller = create_caller(header->node_id, header->attr_path_count, header->event_path_count);
+    if (!caller) {
+        goto exit;
+    }
+    caller->min_interval = header->min_interval;
+    caller->max_interval = header->max_interval;
+    caller->restored = true;
+    caller->persistent_slot = slot;
+    for (size_t index = 0; index < header->attr_path_count; index++, path++) {
+        AttributePathParams attr_path(path->endpoint_id, path->cluster_id, path->id);
+        attr_path.mListIndex = path->extra;
+        caller->attr_paths[index] = attr_path;
+    }
+    for (size_t index = 0; index < header->event_path_count; index++, path++) {
+        caller->event_paths[index] = EventPathParams(path->endpoint_id, path->cluster_id, path->id, path->extra != 0);
+    }
+exit:
+    chip::Platform::MemoryFree(blob);
+    return caller;
+}
+
+static bool same_paths(const caller_t *caller, const subscription_desc_t *desc)
+{
+    if (caller->node_id != desc->node_id || caller->min_interval != desc->min_interval ||
+        caller->max_interval != desc->max_interval || caller->attr_paths.AllocatedSize() != desc->attr_path_count ||
+        caller->event_paths.AllocatedSize() != desc->event_path_count) {
+        return false;
+    }
+    for (size_t index = 0; index < desc->attr_path_count; index++) {
+        const AttributePathParams &a = caller->attr_paths[index];
+        const AttributePathParams &b = desc->attr_paths[index];
+        if (a.mEndpointId != b.mEndpointId || a.mClusterId != b.mClusterId || a.mAttributeId != b.mAttributeId ||
+            a.mListIndex != b.mListIndex) {
+            return false;
+        }
+    }
+    for (size_t index = 0; index < desc->event_path_count; index++) {
+        const EventPathParams &a = caller->event_paths[index];
+        const EventPathParams &b = desc->event_paths[index];
+        if (a.mEndpointId != b.mEndpointId || a.mClusterId != b.mClusterId || a.mEventId != b.mEventId ||
+            a.mIsUrgentEvent != b.mIsUrgentEvent) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Adds the caller to the subscription of its node, creating or re-establishing it if needed */
+static esp_err_t attach_caller(caller_t *caller)
+{
+    node_subscription *node = find_node(caller->node_id);
+    if (node && node->serves(caller)) {
+        caller->next = s_callers;
+        s_callers = caller;
+        return ESP_OK;
+    }
+    bool new_node = !node;
+    if (new_node) {
+        node = chip::Platform::New<node_subscription>(caller->node_id);
+        if (!node) {
+            ESP_LOGE(TAG, "Failed to alloc memory for the node subscription");
+            return ESP_ERR_NO_MEM;
+        }
+        node->next = s_nodes;
+        s_nodes = node;
+    }
+    caller->next = s_callers;
+    s_callers = caller;
+    return node->restart();
+}
+
+esp_err_t init(attribute_report_cb_t default_attribute_cb, event_report_cb_t default_event_cb)
+{
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    s_default_attribute_cb = default_attribute_cb;
+    s_default_event_cb = default_event_cb;
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open_from_partition(CONFIG_ESP_MATTER_NVS_PART_NAME, SUBSCRIPTION_NVS_NAMESPACE, NVS_READONLY,
+                                            &handle);
+    if (err == ESP_OK) {
+        for (int16_t slot = 0; slot < k_max_persistent; slot++) {
+            caller_t *caller = load_caller(handle, slot);
+            if (caller) {
+                caller->next = s_callers;
+                s_callers = caller;
+            }
+        }
+        nvs_close(handle);
+        /* Subscribe once per node, with the union of the restored paths */
+        for (caller_t *caller = s_callers; caller; caller = caller->next) {
+            if (find_node(caller->node_id)) {
+                continue;
+            }
+            node_subscription *node = chip::Platform::New<node_subscription>(caller->node_id);
+            if (!node) {
+                ESP_LOGE(TAG, "Failed to alloc memory for the node subscription");
+                continue;
+            }
+            node->next = s_nodes;
+            s_nodes = node;
+            if (node->restart() != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to restore the subscription to node 0x%016" PRIX64, caller->node_id);
+            }
+        }
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        /* Nothing stored yet */
+        err = ESP_OK;
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t add(const subscription_desc_t *desc, attribute_report_cb_t attribute_cb, event_report_cb_t event_cb,
+              subscription_handle_t *handle)
+{
+    if (!desc || !handle || (desc->attr_path_count == 0 && desc->event_path_count == 0) ||
+        (desc->attr_path_count > 0 && !desc->attr_paths) || (desc->event_path_count > 0 && !desc->event_paths) ||
+        desc->min_interval > desc->max_interval) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_OK;
+    caller_t *caller = nullptr;
+    /* Take over the matching subscription restored from NVS */
+    for (caller = s_callers; caller; caller = caller->next) {
+        if (caller->restored && desc->persistent && same_paths(caller, desc)) {
+            caller->restored = false;
+            caller->attribute_cb = attribute_cb;
+            caller->event_cb = event_cb;
+            *handle = caller->handle;
+            goto exit;
+        }
+    }
+    caller = create_caller(desc->node_id, desc->attr_path_count, desc->event_path_count);
+    if (!caller) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the subscription");
+        err = ESP_ERR_NO_MEM;
+        goto exit;
+    }
+    for (size_t index = 0; index < desc->attr_path_count; index++) {
+        caller->attr_paths[index] = desc->attr_paths[index];
+    }
+    for (size_t index = 0; index < desc->event_path_count; index++) {
+        caller->event_paths[index] = desc->event_paths[index];
+    }
+    caller->min_interval = desc->min_interval;
+    caller->max_interval = desc->max_interval;
+    caller->attribute_cb = attribute_cb;
+    caller->event_cb = event_cb;
+    if (desc->persistent && (err = store_caller(caller)) != ESP_OK) {
+        chip::Platform::Delete(caller);
+        goto exit;
+    }
+    *handle = caller->handle;
+    /* A failed subscription start is retried, the caller stays attached */
+    attach_caller(caller);
+
+exit:
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t remove(subscription_handle_t handle)
+{
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    caller_t **link = &s_callers;
+    while (*link && (*link)->handle != handle) {
+        link = &(*link)->next;
+    }
+    caller_t *caller = *link;
+    if (caller) {
+        *link = caller->next;
+        if (caller->persistent_slot != k_not_persistent) {
+            erase_caller(caller);
+        }
+        bool node_used = false;
+        for (const caller_t *other = s_callers; other && !node_used; other = other->next) {
+            node_used = other->node_id == caller->node_id;
+        }
+        /* The subscription keeps serving the other callers as is, a superset of their paths is fine */
+        if (!node_used) {
+            node_subscription **node_link = &s_nodes;
+            while (*node_link && (*node_link)->get_node_id() != caller->node_id) {
+                node_link = &(*node_link)->next;
+            }
+            if (*node_link) {
+                node_subscription *node = *node_link;
+                *node_link = node->next;
+                chip::Platform::Delete(node);
+            }
+        }
+        chip::Platform::Delete(caller);
+        err = ESP_OK;
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t get_node_stats(uint64_t node_id, node_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* Take lock if not already taken */
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        ESP_LOGE(TAG, "Could not get task context");
+        return ESP_FAIL;
+    }
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    node_subscription *node = find_node(node_id);
+    if (node) {
+        node->get_stats(stats);
+        err = ESP_OK;
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+} // namespace subscription_manager
+} // namespace controller
+} // namespace esp_matter
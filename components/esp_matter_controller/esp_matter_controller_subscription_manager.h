@@ -0,0 +1,137 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/EventPathParams.h>
+#include <esp_err.h>
+#include <esp_matter_controller_utils.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace controller {
+namespace subscription_manager {
+
+/*
+ * Managed subscriptions.
+ *
+ * The subscription manager keeps one subscription per remote node, shared by all the subscriptions added for that
+ * node. The subscribed paths are the union of the paths of the callers, and the reports are dispatched to the
+ * callers whose paths match. The subscriptions are re-established with a jittered exponential backoff when the
+ * session or the subscription is lost, without a limit on the number of attempts. The persistent subscriptions are
+ * stored in NVS and restored by init().
+ *
+ * The report callbacks are called with the Matter stack lock held, add() and remove() must not be called from them.
+ */
+
+typedef uint32_t subscription_handle_t;
+
+constexpr subscription_handle_t k_invalid_subscription_handle = 0;
+
+/** Subscription descriptor */
+typedef struct {
+    uint64_t node_id;
+    const AttributePathParams *attr_paths;
+    size_t attr_path_count;
+    const EventPathParams *event_paths;
+    size_t event_path_count;
+    uint16_t min_interval;
+    uint16_t max_interval;
+    /* Store the subscription in NVS, so that it is restored by init() after a reboot */
+    bool persistent;
+} subscription_desc_t;
+
+typedef enum {
+    NODE_STATE_CONNECTING = 0,
+    NODE_STATE_SUBSCRIBING,
+    NODE_STATE_ESTABLISHED,
+    NODE_STATE_RESUBSCRIBING,
+    /* Waiting before the next connection attempt */
+    NODE_STATE_BACKOFF,
+} node_state_t;
+
+/** Subscription statistics of a remote node */
+typedef struct {
+    node_state_t state;
+    /* The subscription is established and a report was received within the negotiated max interval */
+    bool alive;
+    uint16_t caller_count;
+    uint32_t subscription_id;
+    uint16_t max_interval;
+    /* Reports received, including the empty keep-alive ones */
+    uint32_t report_count;
+    /* Attribute and event records received */
+    uint32_t record_count;
+    /* Reports per minute since the subscription was last established */
+    uint32_t reports_per_minute;
+    /* Resubscriptions and connection attempts after the first one */
+    uint32_t resubscribe_count;
+    /* Time since the last report in seconds, UINT32_MAX if none was received */
+    uint32_t seconds_since_last_report;
+} node_stats_t;
+
+/**
+ * @brief Initializes the subscription manager and restores the persistent subscriptions.
+ *
+ * The restored subscriptions report to the default callbacks until they are added again with add(), which then
+ * takes them over. Should be called once the controller is initialized.
+ *
+ * @param default_attribute_cb Attribute report callback of the restored subscriptions, can be NULL
+ * @param default_event_cb     Event report callback of the restored subscriptions, can be NULL
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t init(attribute_report_cb_t default_attribute_cb, event_report_cb_t default_event_cb);
+
+/**
+ * @brief Adds a subscription. The paths are copied.
+ *
+ * If the paths are already covered by the subscription to the node, and its max interval is not greater than the
+ * requested one, the subscription is shared as is. Otherwise it is re-established with the new union of the paths.
+ *
+ * @param desc         Subscription descriptor
+ * @param attribute_cb Attribute report callback, can be NULL
+ * @param event_cb     Event report callback, can be NULL
+ * @param handle       Handle of the subscription, to remove it
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t add(const subscription_desc_t *desc, attribute_report_cb_t attribute_cb, event_report_cb_t event_cb,
+              subscription_handle_t *handle);
+
+/**
+ * @brief Removes a subscription, and erases it from NVS if it is persistent. The subscription to the node is
+ * terminated when its last caller is removed.
+ *
+ * @param handle Handle returned by add()
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t remove(subscription_handle_t handle);
+
+/**
+ * @brief Gets the subscription statistics of a remote node.
+ *
+ * @param node_id Node ID of the remote node
+ * @param stats   Statistics
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if there is no subscription to the node
+ */
+esp_err_t get_node_stats(uint64_t node_id, node_stats_t *stats);
+
+} // namespace subscription_manager
+} // namespace controller
+} // namespace esp_matter
@@ -0,0 +1,601 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_matter_controller_time_series.h>
+#include <esp_matter_mem.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include <inttypes.h>
+#include <lib/support/CodeUtils.h>
+#include <math.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <stddef.h>
+#include <string.h>
+#include <system/SystemClock.h>
+
+static const char *TAG = "time_series";
+
+namespace esp_matter {
+namespace controller {
+namespace time_series {
+
+constexpr uint32_t k_magic = 0x53545345; /* "ESTS" */
+constexpr uint32_t k_version = 1;
+/* The records are padded to this size, which keeps the writes aligned when the partition is encrypted */
+constexpr size_t k_alignment = 16;
+constexpr size_t k_block_size = CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_BLOCK_SIZE;
+constexpr size_t k_max_series = CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_MAX_SERIES;
+
+typedef struct sector_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sequence;
+    uint32_t reserved[4];
+    uint32_t crc;
+} sector_header_t;
+
+/* A block of samples of a series, followed by the delta encoded samples after the first one, padded to
+ * k_alignment. The CRC covers the header and the payload. */
+typedef struct record_header {
+    uint64_t node_id;
+    int64_t first_time_ms;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    int32_t first_value;
+    /* Time from the first to the last sample, to skip the blocks out of the queried range */
+    uint32_t span_ms;
+    uint16_t endpoint_id;
+    uint16_t payload_size;
+    uint16_t count;
+    int8_t scale;
+    uint8_t reserved;
+    uint32_t reserved2;
+    uint32_t crc;
+} record_header_t;
+
+static_assert(sizeof(sector_header_t) == 32, "The sector header is part of the flash format");
+static_assert(sizeof(record_header_t) == 48, "The record header is part of the flash format");
+
+typedef struct {
+    bool used;
+    uint64_t node_id;
+    chip::app::ConcreteAttributePath path;
+    int8_t scale;
+    /* Block being filled, empty if count is 0 */
+    uint16_t count;
+    uint16_t payload_size;
+    int64_t first_time_ms;
+    int32_t first_value;
+    int64_t last_time_ms;
+    int32_t last_value;
+    uint8_t payload[k_block_size];
+} series_t;
+
+static const esp_partition_t *s_partition = NULL;
+/* Sequence number of each sector, 0 if the sector has no valid header */
+static uint32_t *s_sequences = NULL;
+static size_t s_sector_count = 0;
+static size_t s_current_sector = 0;
+/* Offset of the next record in the current sector, 0 if no sector has been written yet */
+static size_t s_write_offset = 0;
+static series_t s_series[k_max_series];
+static stats_t s_stats;
+
+static inline size_t get_record_size(uint16_t payload_size)
+{
+    return (sizeof(record_header_t) + payload_size + k_alignment - 1) & ~(k_alignment - 1);
+}
+
+static inline size_t get_sector_offset(size_t sector)
+{
+    return sector * s_partition->erase_size;
+}
+
+static uint32_t get_record_crc(const record_header_t *header, const uint8_t *payload)
+{
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)header, offsetof(record_header_t, crc));
+    return esp_rom_crc32_le(crc, payload, header->payload_size);
+}
+
+static bool is_erased(const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t index = 0; index < size; index++) {
+        if (bytes[index] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t put_varint(uint8_t *buf, uint32_t value)
+{
+    size_t len = 0;
+    while (value >= 0x80) {
+        buf[len++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buf[len++] = (uint8_t)value;
+    return len;
+}
+
+static bool get_varint(const uint8_t *buf, size_t size, size_t *pos, uint32_t *value)
+{
+    uint32_t result = 0;
+    for (uint8_t shift = 0; shift < 35 && *pos < size; shift += 7) {
+        uint8_t byte = buf[(*pos)++];
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline uint32_t zigzag_encode(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int32_t zigzag_decode(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+int64_t get_time_ms()
+{
+    chip::System::Clock::Milliseconds64 now;
+    if (chip::System::SystemClock().GetClock_RealTimeMS(now) != CHIP_NO_ERROR) {
+        now = chip::System::SystemClock().GetMonotonicMilliseconds64();
+    }
+    return (int64_t)now.count();
+}
+
+static bool read_sector_header(size_t sector, uint32_t *sequence)
+{
+    sector_header_t header;
+    if (esp_partition_read(s_partition, get_sector_offset(sector), &header, sizeof(header)) != ESP_OK) {
+        return false;
+    }
+    if (header.magic != k_magic || header.version != k_version || header.sequence == 0 ||
+        header.crc != esp_rom_crc32_le(0, (const uint8_t *)&header, offsetof(sector_header_t, crc))) {
+        return false;
+    }
+    *sequence = header.sequence;
+    return true;
+}
+
+/* Finds the end of the records of the current sector. A record with a corrupted header, most likely a write
+ * interrupted by a reset, ends the sector: its size cannot be trusted. */
+static size_t find_write_offset(size_t sector)
+{
+    size_t offset = sizeof(sector_header_t);
+    while (offset + sizeof(record_header_t) <= s_partition->erase_size) {
+        record_header_t header;
+        if (esp_partition_read(s_partition, get_sector_offset(sector) + offset, &header, sizeof(header)) != ESP_OK ||
+            is_erased(&header, sizeof(header))) {
+            return offset;
+        }
+        size_t record_size = get_record_size(header.payload_size);
+        if (offset + record_size > s_partition->erase_size) {
+            return s_partition->erase_size;
+        }
+        offset += record_size;
+    }
+    return offset;
+}
+
+static void flush_timer_cb(chip::System::Layer *layer, void *context)
+{
+    flush();
+    chip::DeviceLayer::SystemLayer().StartTimer(
+        chip::System::Clock::Seconds32(CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_FLUSH_INTERVAL), flush_timer_cb,
+        nullptr);
+}
+
+static esp_err_t open_store()
+{
+    if (s_partition) {
+        return ESP_OK;
+    }
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_PARTITION_LABEL);
+    ESP_RETURN_ON_FALSE(partition, ESP_ERR_NOT_FOUND, TAG, "Time-series partition %s not found",
+                        CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_PARTITION_LABEL);
+    size_t sector_count = partition->size / partition->erase_size;
+    ESP_RETURN_ON_FALSE(sector_count >= 2 &&
+                            get_record_size(k_block_size) <= partition->erase_size - sizeof(sector_header_t),
+                        ESP_ERR_INVALID_SIZE, TAG, "Time-series partition too small, it needs at least two sectors");
+    s_sequences = (uint32_t *)esp_matter_mem_calloc(sector_count, sizeof(uint32_t));
+    ESP_RETURN_ON_FALSE(s_sequences, ESP_ERR_NO_MEM, TAG, "Failed to alloc memory for the sectors");
+    s_partition = partition;
+    s_sector_count = sector_count;
+
+    uint32_t max_sequence = 0;
+    for (size_t sector = 0; sector < s_sector_count; sector++) {
+        if (read_sector_header(sector, &s_sequences[sector]) && s_sequences[sector] > max_sequence) {
+            max_sequence = s_sequences[sector];
+            s_current_sector = sector;
+        }
+    }
+    s_write_offset = max_sequence ? find_write_offset(s_current_sector) : 0;
+    s_stats.partition_size = s_partition->size;
+    chip::DeviceLayer::SystemLayer().StartTimer(
+        chip::System::Clock::Seconds32(CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_FLUSH_INTERVAL), flush_timer_cb,
+        nullptr);
+    ESP_LOGI(TAG, "Time-series store of %u sectors, current sector %u, %u bytes used", (unsigned)s_sector_count,
+             (unsigned)s_current_sector, (unsigned)s_write_offset);
+    return ESP_OK;
+}
+
+/* Erases the next sector, which drops its blocks, and makes it the current one */
+static esp_err_t open_next_sector()
+{
+    size_t sector = s_write_offset ? (s_current_sector + 1) % s_sector_count : s_current_sector;
+    uint32_t sequence = s_write_offset ? s_sequences[s_current_sector] + 1 : 1;
+    s_sequences[sector] = 0;
+    esp_err_t err = esp_partition_erase_range(s_partition, get_sector_offset(sector), s_partition->erase_size);
+    ESP_RETURN_ON_ERROR(err, TAG, "Failed to erase the time-series sector %u", (unsigned)sector);
+    s_stats.sectors_erased++;
+    sector_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = k_magic;
+    header.version = k_version;
+    header.sequence = sequence;
+    header.crc = esp_rom_crc32_le(0, (const uint8_t *)&header, offsetof(sector_header_t, crc));
+    ESP_RETURN_ON_ERROR(esp_partition_write(s_partition, get_sector_offset(sector), &header, sizeof(header)), TAG,
+                        "Failed to write the time-series sector header");
+    s_sequences[sector] = sequence;
+    s_current_sector = sector;
+    s_write_offset = sizeof(sector_header_t);
+    return ESP_OK;
+}
+
+static esp_err_t append(const record_header_t *header, const uint8_t *payload)
+{
+    size_t record_size = get_record_size(header->payload_size);
+    if (s_write_offset == 0 || s_write_offset + record_size > s_partition->erase_size) {
+        ESP_RETURN_ON_ERROR(open_next_sector(), TAG, "Failed to open the next sector");
+    }
+    /* The record is written in one go from a padded copy, so that the flash writes stay aligned */
+    uint8_t record[sizeof(record_header_t) + k_block_size + k_alignment];
+    memset(record, 0, record_size);
+    memcpy(record, header, sizeof(record_header_t));
+    memcpy(record + sizeof(record_header_t), payload, header->payload_size);
+    esp_err_t err = esp_partition_write(s_partition, get_sector_offset(s_current_sector) + s_write_offset, record,
+                                        record_size);
+    /* Don't reuse the space even if the write failed, it might be partially written */
+    s_write_offset += record_size;
+    return err;
+}
+
+static void fill_header(const series_t *series, record_header_t *header)
+{
+    memset(header, 0, sizeof(record_header_t));
+    header->node_id = series->node_id;
+    header->first_time_ms = series->first_time_ms;
+    header->cluster_id = series->path.mClusterId;
+    header->attribute_id = series->path.mAttributeId;
+    header->first_value = series->first_value;
+    header->span_ms = (uint32_t)(series->last_time_ms - series->first_time_ms);
+    header->endpoint_id = series->path.mEndpointId;
+    header->payload_size = series->payload_size;
+    header->count = series->count;
+    header->scale = series->scale;
+}
+
+static esp_err_t write_block(series_t *series)
+{
+    if (series->count == 0) {
+        return ESP_OK;
+    }
+    record_header_t header;
+    fill_header(series, &header);
+    header.crc = get_record_crc(&header, series->payload);
+    esp_err_t err = append(&header, series->payload);
+    if (err == ESP_OK) {
+        s_stats.blocks_written++;
+    } else {
+        ESP_LOGE(TAG, "Failed to write a block of node 0x%" PRIx64 ": %s", series->node_id, esp_err_to_name(err));
+        s_stats.write_errors++;
+    }
+    series->count = 0;
+    series->payload_size = 0;
+    return err;
+}
+
+static void append_sample(series_t *series, int64_t time_ms, int32_t value)
+{
+    if (series->count > 0) {
+        int64_t time_delta = time_ms - series->last_time_ms;
+        int64_t value_delta = (int64_t)value - series->last_value;
+        /* The samples which cannot be delta encoded, after a clock change, start a new block */
+        if (time_delta >= 0 && time_delta <= UINT32_MAX && value_delta >= INT32_MIN && value_delta <= INT32_MAX &&
+            time_ms - series->first_time_ms <= UINT32_MAX && series->count < UINT16_MAX) {
+            uint8_t encoded[10];
+            size_t len = put_varint(encoded, (uint32_t)time_delta);
+            len += put_varint(encoded + len, zigzag_encode((int32_t)value_delta));
+            if (series->payload_size + len <= k_block_size) {
+                memcpy(series->payload + series->payload_size, encoded, len);
+                series->payload_size += len;
+                series->count++;
+                series->last_time_ms = time_ms;
+                series->last_value = value;
+                return;
+            }
+        }
+        write_block(series);
+    }
+    series->count = 1;
+    series->payload_size = 0;
+    series->first_time_ms = series->last_time_ms = time_ms;
+    series->first_value = series->last_value = value;
+}
+
+static series_t *find_series(uint64_t node_id, const chip::app::ConcreteAttributePath &path)
+{
+    for (size_t idx = 0; idx < k_max_series; ++idx) {
+        if (s_series[idx].used && s_series[idx].node_id == node_id && s_series[idx].path == path) {
+            return &s_series[idx];
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t track(uint64_t node_id, const chip::app::ConcreteAttributePath &path, int8_t scale)
+{
+    ESP_RETURN_ON_ERROR(open_store(), TAG, "Failed to open the time-series store");
+    series_t *series = find_series(node_id, path);
+    if (series) {
+        if (series->scale != scale) {
+            write_block(series);
+            series->scale = scale;
+        }
+        return ESP_OK;
+    }
+    for (size_t idx = 0; idx < k_max_series; ++idx) {
+        if (!s_series[idx].used) {
+            series = &s_series[idx];
+            *series = {};
+            series->used = true;
+            series->node_id = node_id;
+            series->path = path;
+            series->scale = scale;
+            s_stats.series_count++;
+            return ESP_OK;
+        }
+    }
+    ESP_LOGE(TAG, "At most %u series can be tracked", (unsigned)k_max_series);
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t untrack(uint64_t node_id, const chip::app::ConcreteAttributePath &path)
+{
+    series_t *series = find_series(node_id, path);
+    ESP_RETURN_ON_FALSE(series, ESP_ERR_NOT_FOUND, TAG, "The series is not tracked");
+    write_block(series);
+    series->used = false;
+    s_stats.series_count--;
+    return ESP_OK;
+}
+
+static bool get_scaled_value(chip::TLV::TLVReader &reader, int8_t scale, int32_t *value)
+{
+    double raw = 0;
+    switch (reader.GetType()) {
+    case chip::TLV::kTLVType_SignedInteger: {
+        int64_t integer = 0;
+        VerifyOrReturnValue(reader.Get(integer) == CHIP_NO_ERROR, false);
+        raw = (double)integer;
+        break;
+    }
+    case chip::TLV::kTLVType_UnsignedInteger: {
+        uint64_t integer = 0;
+        VerifyOrReturnValue(reader.Get(integer) == CHIP_NO_ERROR, false);
+        raw = (double)integer;
+        break;
+    }
+    case chip::TLV::kTLVType_Boolean: {
+        bool boolean = false;
+        VerifyOrReturnValue(reader.Get(boolean) == CHIP_NO_ERROR, false);
+        raw = boolean ? 1 : 0;
+        break;
+    }
+    case chip::TLV::kTLVType_FloatingPointNumber:
+        VerifyOrReturnValue(reader.Get(raw) == CHIP_NO_ERROR, false);
+        break;
+    default:
+        /* The null values, the strings and the structures are not recorded */
+        return false;
+    }
+    double scaled = round(raw * pow(10, scale));
+    VerifyOrReturnValue(scaled >= INT32_MIN && scaled <= INT32_MAX, false);
+    *value = (int32_t)scaled;
+    return true;
+}
+
+void on_attribute_data(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                       chip::TLV::TLVReader *data)
+{
+    if (!s_partition || !data || path.IsListItemOperation()) {
+        return;
+    }
+    series_t *series = find_series(node_id, path);
+    if (!series) {
+        return;
+    }
+    chip::TLV::TLVReader reader;
+    reader.Init(*data);
+    int32_t value = 0;
+    if (!get_scaled_value(reader, series->scale, &value)) {
+        s_stats.dropped++;
+        return;
+    }
+    append_sample(series, get_time_ms(), value);
+    s_stats.samples++;
+}
+
+/* Streams the samples of a block in the time range, returns false if the callback stopped the query */
+static bool decode_block(const record_header_t *header, const uint8_t *payload, int64_t from_ms, int64_t to_ms,
+                         sample_cb_t cb, void *ctx)
+{
+    sample_t sample = {.time_ms = header->first_time_ms, .value = header->first_value, .scale = header->scale};
+    size_t pos = 0;
+    for (uint16_t idx = 0; idx < header->count; ++idx) {
+        if (idx > 0) {
+            uint32_t time_delta = 0;
+            uint32_t value_delta = 0;
+            if (!get_varint(payload, header->payload_size, &pos, &time_delta) ||
+                !get_varint(payload, header->payload_size, &pos, &value_delta)) {
+                break;
+            }
+            sample.time_ms += time_delta;
+            sample.value += zigzag_decode(value_delta);
+        }
+        if (sample.time_ms > to_ms) {
+            break;
+        }
+        if (sample.time_ms >= from_ms && !cb(&sample, ctx)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool is_block_of(const record_header_t *header, uint64_t node_id, const chip::app::ConcreteAttributePath &path)
+{
+    return header->node_id == node_id && header->endpoint_id == path.mEndpointId &&
+        header->cluster_id == path.mClusterId && header->attribute_id == path.mAttributeId;
+}
+
+static esp_err_t query_sector(size_t sector, uint64_t node_id, const chip::app::ConcreteAttributePath &path,
+                              int64_t from_ms, int64_t to_ms, sample_cb_t cb, void *ctx, bool *stop)
+{
+    size_t end = sector == s_current_sector ? s_write_offset : s_partition->erase_size;
+    size_t offset = sizeof(sector_header_t);
+    uint8_t payload[k_block_size];
+    while (offset + sizeof(record_header_t) <= end) {
+        record_header_t header;
+        ESP_RETURN_ON_ERROR(esp_partition_read(s_partition, get_sector_offset(sector) + offset, &header, sizeof(header)),
+                            TAG, "Failed to read a block header");
+        if (is_erased(&header, sizeof(header)) || header.payload_size > k_block_size) {
+            break;
+        }
+        size_t record_size = get_record_size(header.payload_size);
+        if (offset + record_size > end) {
+            break;
+        }
+        size_t payload_offset = get_sector_offset(sector) + offset + sizeof(header);
+        offset += record_size;
+        /* Only the payloads of the blocks of the series which overlap the range are read */
+        if (!is_block_of(&header, node_id, path) || header.first_time_ms > to_ms ||
+            header.first_time_ms + (int64_t)header.span_ms < from_ms) {
+            continue;
+        }
+        ESP_RETURN_ON_ERROR(esp_partition_read(s_partition, payload_offset, payload, header.payload_size), TAG,
+                            "Failed to read a block");
+        if (header.crc != get_record_crc(&header, payload)) {
+            continue;
+        }
+        if (!decode_block(&header, payload, from_ms, to_ms, cb, ctx)) {
+            *stop = true;
+            break;
+        }
+    }
+    return ESP_OK;
+}
+
+/* Number of the sectors in the log, walking back from the current one while the sequence numbers decrease by one */
+static size_t get_log_sector_count()
+{
+    if (s_write_offset == 0) {
+        return 0;
+    }
+    size_t count = 1;
+    while (count < s_sector_count) {
+        size_t sector = (s_current_sector + s_sector_count - count) % s_sector_count;
+        if (s_sequences[sector] == 0 || s_sequences[sector] + count != s_sequences[s_current_sector]) {
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+esp_err_t query(uint64_t node_id, const chip::app::ConcreteAttributePath &path, int64_t from_ms, int64_t to_ms,
+                sample_cb_t cb, void *ctx)
+{
+    ESP_RETURN_ON_FALSE(cb, ESP_ERR_INVALID_ARG, TAG, "cb cannot be NULL");
+    ESP_RETURN_ON_FALSE(s_partition, ESP_ERR_INVALID_STATE, TAG, "The time-series store is not opened");
+    size_t count = get_log_sector_count();
+    bool stop = false;
+    for (size_t idx = 0; idx < count && !stop; ++idx) {
+        size_t sector = (s_current_sector + s_sector_count - count + 1 + idx) % s_sector_count;
+        ESP_RETURN_ON_ERROR(query_sector(sector, node_id, path, from_ms, to_ms, cb, ctx, &stop), TAG,
+                            "Failed to query sector %u", (unsigned)sector);
+    }
+    series_t *series = find_series(node_id, path);
+    if (!stop && series && series->count > 0) {
+        record_header_t header;
+        fill_header(series, &header);
+        decode_block(&header, series->payload, from_ms, to_ms, cb, ctx);
+    }
+    return ESP_OK;
+}
+
+esp_err_t flush()
+{
+    ESP_RETURN_ON_FALSE(s_partition, ESP_ERR_INVALID_STATE, TAG, "The time-series store is not opened");
+    esp_err_t err = ESP_OK;
+    for (size_t idx = 0; idx < k_max_series; ++idx) {
+        if (s_series[idx].used && write_block(&s_series[idx]) != ESP_OK) {
+            err = ESP_FAIL;
+        }
+    }
+    return err;
+}
+
+esp_err_t erase_all()
+{
+    ESP_RETURN_ON_FALSE(s_partition, ESP_ERR_INVALID_STATE, TAG, "The time-series store is not opened");
+    esp_err_t err = esp_partition_erase_range(s_partition, 0, s_partition->size);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to erase the time-series partition");
+    }
+    memset(s_sequences, 0, s_sector_count * sizeof(uint32_t));
+    s_current_sector = 0;
+    s_write_offset = 0;
+    for (size_t idx = 0; idx < k_max_series; ++idx) {
+        s_series[idx].count = 0;
+        s_series[idx].payload_size = 0;
+    }
+    return err;
+}
+
+void get_stats(stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    *stats = s_stats;
+    size_t count = s_partition ? get_log_sector_count() : 0;
+    stats->used_bytes = count > 0 ? (count - 1) * s_partition->erase_size + s_write_offset : 0;
+}
+
+} // namespace time_series
+} // namespace controller
+} // namespace esp_matter
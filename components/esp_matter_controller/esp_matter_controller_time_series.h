@@ -0,0 +1,152 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <esp_err.h>
+#include <lib/core/TLVReader.h>
+#include <sdkconfig.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace controller {
+namespace time_series {
+
+/*
+ * Controller time-series store.
+ *
+ * The numeric attribute values of the tracked series, received by the subscriptions, are kept as fixed-point
+ * integers, the value multiplied by 10^scale, with their timestamps in milliseconds. The timestamps are the Unix
+ * time when the real time is set, and the time since boot otherwise.
+ *
+ * The samples of each series are delta encoded in a block in RAM: the first sample is kept as is, and the next
+ * ones as the varint encoded time delta and zigzag varint encoded value delta from the previous sample, a slowly
+ * changing value taking 2 or 3 bytes per sample. The full blocks, and all the blocks every
+ * CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_FLUSH_INTERVAL seconds, are appended to a circular log on a raw data
+ * partition, whose oldest sector is erased when the log is full. The range queries stream the blocks of the series
+ * from flash, then the block in RAM, without sending any request to the nodes.
+ *
+ * All the functions must be called in the Matter context, or with the Matter stack lock held. The sector erases are
+ * done in the Matter context when a sector is full.
+ */
+
+/** A sample of a series */
+typedef struct {
+    int64_t time_ms;
+    /* Attribute value multiplied by 10^scale */
+    int32_t value;
+    int8_t scale;
+} sample_t;
+
+/** Called for each sample of a query, in time order within each block, returns false to stop the query */
+using sample_cb_t = bool (*)(const sample_t *sample, void *ctx);
+
+typedef struct {
+    uint16_t series_count;
+    uint32_t samples;
+    /* Reports which were not numeric, or of a value out of the int32 range once scaled */
+    uint32_t dropped;
+    uint32_t blocks_written;
+    uint32_t sectors_erased;
+    uint32_t write_errors;
+    /* Bytes of the partition holding blocks */
+    uint32_t used_bytes;
+    uint32_t partition_size;
+} stats_t;
+
+#if CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_ENABLE
+/**
+ * @brief Starts recording the values of an attribute reported by a node. The store partition is opened by the
+ * first call.
+ *
+ * @param node_id     Remote node ID
+ * @param path        Attribute path
+ * @param scale       Decimal exponent of the fixed-point values, 0 for the integer attributes
+ *
+ * @return ESP_OK on success, ESP_ERR_NO_MEM if CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_MAX_SERIES series are
+ * tracked, ESP_ERR_NOT_FOUND if the partition is not found, appropriate error code otherwise
+ */
+esp_err_t track(uint64_t node_id, const chip::app::ConcreteAttributePath &path, int8_t scale);
+
+/**
+ * @brief Stops recording the values of an attribute. Its samples in RAM are written first, and its samples in
+ * flash stay available to the queries until they are overwritten.
+ *
+ * @param node_id Remote node ID
+ * @param path    Attribute path
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the series is not tracked
+ */
+esp_err_t untrack(uint64_t node_id, const chip::app::ConcreteAttributePath &path);
+
+/**
+ * @brief Records an attribute report, if its series is tracked. Called by the subscribe commands.
+ *
+ * @param node_id Remote node ID
+ * @param path    Attribute path
+ * @param data    Attribute value, positioned on the element
+ */
+void on_attribute_data(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                       chip::TLV::TLVReader *data);
+
+/**
+ * @brief Streams the samples of a series in a time range.
+ *
+ * @param node_id Remote node ID
+ * @param path    Attribute path
+ * @param from_ms Start of the range, included
+ * @param to_ms   End of the range, included
+ * @param cb      Sample callback
+ * @param ctx     Context of the callback
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the store is not opened, appropriate error code otherwise
+ */
+esp_err_t query(uint64_t node_id, const chip::app::ConcreteAttributePath &path, int64_t from_ms, int64_t to_ms,
+                sample_cb_t cb, void *ctx);
+
+/**
+ * @brief Writes the samples in RAM to flash.
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t flush();
+
+/**
+ * @brief Erases the samples in RAM and in flash. The series stay tracked.
+ *
+ * @return ESP_OK on success, appropriate error code otherwise
+ */
+esp_err_t erase_all();
+
+/**
+ * @brief Gets the current time of the store timestamps.
+ */
+int64_t get_time_ms();
+
+/**
+ * @brief Gets the store statistics.
+ *
+ * @param stats Statistics
+ */
+void get_stats(stats_t *stats);
+#else
+inline void on_attribute_data(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                              chip::TLV::TLVReader *data) {}
+#endif // CONFIG_ESP_MATTER_CONTROLLER_TIME_SERIES_ENABLE
+
+} // namespace time_series
+} // namespace controller
+} // namespace esp_matter
@@ -33,8 +33,10 @@ using event_report_cb_t = void (*)(uint64_t remote_node_id, const chip::app::Eve
                                    chip::TLV::TLVReader *data);
 using subscribe_done_cb_t = void (*)(uint64_t remote_node_id, uint32_t subscription_id);
 using subscribe_failure_cb_t = void (*)(void *subscribe_command);
+using write_done_cb_t = void (*)(uint64_t remote_node_id, CHIP_ERROR error);
 using read_done_cb_t = void (*)(uint64_t remote_node_id, const ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
                                 const ScopedMemoryBufferWithSize<EventPathParams> &EventPathParams);
+using read_failure_cb_t = void (*)(uint64_t remote_node_id, CHIP_ERROR error);
 
 #if !CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
 /**
@@ -15,6 +15,8 @@
 #include <esp_check.h>
 #include <esp_matter_controller_utils.h>
 #include <esp_matter_controller_write_command.h>
+#include <inttypes.h>
+#include <json_parser.h>
 #include <json_to_tlv.h>
 #if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
 #include <esp_matter_commissioner.h>
@@ -35,11 +37,12 @@ using chip::TLV::TLVWriter;
 using attribute_data_tag = chip::app::AttributeDataIB::Tag;
 
 static const char *TAG = "write_command";
-static constexpr size_t k_encoded_buf_size = chip::kMaxAppMessageLen;
 
 namespace esp_matter {
 namespace controller {
 
+command_pool::pool<write_command> write_command::s_pool;
+
 esp_err_t write_command::encode_attribute_value(uint8_t *encoded_buf, size_t encoded_buf_size,
                                                 const char *attr_val_json_str, TLVReader &out_reader)
 {
@@ -67,41 +70,30 @@ void write_command::on_device_connected_fcn(void *context, ExchangeManager &exch
     write_command *cmd = (write_command *)context;
     if (cmd->m_attr_path.HasWildcardEndpointId()) {
         ESP_LOGE(TAG, "Endpoint Id Invalid");
-        chip::Platform::Delete(cmd);
+        write_command::destroy(cmd);
         return;
     }
     ConcreteDataAttributePath path(cmd->m_attr_path.mEndpointId, cmd->m_attr_path.mClusterId,
                                    cmd->m_attr_path.mAttributeId);
-    chip::Platform::ScopedMemoryBuffer<uint8_t> encoded_buf;
 
     auto write_client = MakeUnique<WriteClient>(&exchangeMgr, &(cmd->m_chunked_callback), chip::NullOptional, false);
     if (write_client == nullptr) {
         ESP_LOGE(TAG, "Failed to alloc memory for WriteClient");
-        chip::Platform::Delete(cmd);
-        return;
-    }
-    encoded_buf.Alloc(k_encoded_buf_size);
-    if (!encoded_buf.Get()) {
-        ESP_LOGE(TAG, "Failed to alloc memory for encoded_buf");
-        chip::Platform::Delete(cmd);
-        return;
-    }
-    TLVReader attr_val_reader;
-    if (encode_attribute_value(encoded_buf.Get(), k_encoded_buf_size, cmd->m_attr_val_str, attr_val_reader) != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to encode attribute value to a TLV reader");
-        chip::Platform::Delete(cmd);
+        write_command::destroy(cmd);
         return;
     }
-
-    if (write_client->PutPreencodedAttribute(path, attr_val_reader) != CHIP_NO_ERROR) {
+    if (write_client->PutPreencodedAttribute(path, cmd->m_attr_val_reader) != CHIP_NO_ERROR) {
         ESP_LOGE(TAG, "Failed to put pre-encoded attribute value to WriteClient");
-        chip::Platform::Delete(cmd);
+        write_command::destroy(cmd);
         return;
     }
+    /* The value is copied to the write request, give the buffer to the next command */
+    encode_buffer_pool::release(cmd->m_encoded_buf);
+    cmd->m_encoded_buf = nullptr;
 
     if (write_client->SendWriteRequest(sessionHandle) != CHIP_NO_ERROR) {
         ESP_LOGE(TAG, "Failed to Send Write Request");
-        chip::Platform::Delete(cmd);
+        write_command::destroy(cmd);
         return;
     }
     // Release the write_client as it will be managed by the callbacks
@@ -111,11 +103,44 @@ void write_command::on_device_connected_fcn(void *context, ExchangeManager &exch
 void write_command::on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error)
 {
     write_command *cmd = (write_command *)context;
-    chip::Platform::Delete(cmd);
+    if (cmd->write_done_cb) {
+        cmd->write_done_cb(cmd->m_node_id, error);
+    }
+    write_command::destroy(cmd);
     return;
 }
 
+void write_command::on_encode_buffer_ready(void *ctx, uint8_t *buf, size_t buf_size)
+{
+    write_command *cmd = (write_command *)ctx;
+    cmd->m_encoded_buf = buf;
+    if (encode_attribute_value(buf, buf_size, cmd->m_attr_val_str, cmd->m_attr_val_reader) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to encode attribute value to a TLV reader");
+        if (cmd->write_done_cb) {
+            cmd->write_done_cb(cmd->m_node_id, CHIP_ERROR_INVALID_ARGUMENT);
+        }
+        write_command::destroy(cmd);
+        return;
+    }
+    /* The command is deleted if connect() fails */
+    write_done_cb_t done_cb = cmd->write_done_cb;
+    uint64_t node_id = cmd->m_node_id;
+    if (cmd->connect() != ESP_OK && done_cb) {
+        done_cb(node_id, CHIP_ERROR_NOT_CONNECTED);
+    }
+}
+
 esp_err_t write_command::send_command()
+{
+    /* The value is encoded once a buffer of the pool is available, which may be later if all are in use */
+    esp_err_t err = encode_buffer_pool::acquire(on_encode_buffer_ready, this);
+    if (err != ESP_OK) {
+        destroy(this);
+    }
+    return err;
+}
+
+esp_err_t write_command::connect()
 {
 #if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
     if (CHIP_NO_ERROR ==
@@ -129,19 +154,19 @@ esp_err_t write_command::send_command()
                                                             &on_device_connected_cb, &on_device_connection_failure_cb);
     return ESP_OK;
 #endif
-    chip::Platform::Delete(this);
+    destroy(this);
     return ESP_FAIL;
 }
 
 esp_err_t send_write_attr_command(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
-                                  const char *attr_val_json_str)
+                                  const char *attr_val_json_str, write_done_cb_t done_cb)
 {
     if (!attr_val_json_str) {
         ESP_LOGE(TAG, "attribute value json string cannot be NULL");
         return ESP_ERR_INVALID_ARG;
     }
     write_command *cmd =
-        chip::Platform::New<write_command>(node_id, endpoint_id, cluster_id, attribute_id, attr_val_json_str);
+        write_command::create(node_id, endpoint_id, cluster_id, attribute_id, attr_val_json_str, done_cb);
 
     if (!cmd) {
         ESP_LOGE(TAG, "Failed to alloc memory for cluster_command");
@@ -151,5 +176,208 @@ esp_err_t send_write_attr_command(uint64_t node_id, uint16_t endpoint_id, uint32
     return cmd->send_command();
 }
 
+batch_write_command::~batch_write_command()
+{
+    encode_buffer_pool::release(m_encoded_buf);
+    for (size_t index = 0; index < m_count; index++) {
+        esp_matter_mem_free(m_values[index]);
+    }
+}
+
+esp_err_t batch_write_command::parse(const char *json_str)
+{
+    jparse_ctx_t jctx;
+    int count = 0;
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(json_parse_start(&jctx, json_str, strlen(json_str)) == 0, ESP_ERR_INVALID_ARG, TAG,
+                        "Failed to parse the batch write document");
+    ESP_GOTO_ON_FALSE(json_obj_get_array(&jctx, "writes", &count) == 0 && count > 0, ESP_ERR_INVALID_ARG, cleanup,
+                      TAG, "The batch write document must have a non empty \"writes\" array");
+    ESP_GOTO_ON_FALSE(count <= (int)k_batch_write_max_paths, ESP_ERR_INVALID_SIZE, cleanup, TAG,
+                      "At most %u paths can be written in a batch", (unsigned)k_batch_write_max_paths);
+    for (int index = 0; index < count; index++) {
+        int endpoint_id = 0;
+        int64_t cluster_id = 0;
+        int64_t attribute_id = 0;
+        int value_len = 0;
+        ESP_GOTO_ON_FALSE(json_arr_get_object(&jctx, index) == 0, ESP_ERR_INVALID_ARG, cleanup, TAG,
+                          "Write %d is not an object", index);
+        if (json_obj_get_int(&jctx, "endpoint", &endpoint_id) != 0 ||
+            json_obj_get_int64(&jctx, "cluster", &cluster_id) != 0 ||
+            json_obj_get_int64(&jctx, "attribute", &attribute_id) != 0 ||
+            json_obj_get_object_strlen(&jctx, "value", &value_len) != 0) {
+            json_arr_leave_object(&jctx);
+            ESP_LOGE(TAG, "Write %d needs the endpoint, cluster, attribute and value", index);
+            ret = ESP_ERR_INVALID_ARG;
+            goto cleanup;
+        }
+        m_values[index] = (char *)esp_matter_mem_calloc(1, value_len + 1);
+        if (!m_values[index]) {
+            json_arr_leave_object(&jctx);
+            ESP_LOGE(TAG, "Failed to alloc memory for the value of write %d", index);
+            ret = ESP_ERR_NO_MEM;
+            goto cleanup;
+        }
+        m_count = index + 1;
+        json_obj_get_object_str(&jctx, "value", m_values[index], value_len + 1);
+        json_arr_leave_object(&jctx);
+        m_results[index].endpoint_id = (uint16_t)endpoint_id;
+        m_results[index].cluster_id = (uint32_t)cluster_id;
+        m_results[index].attribute_id = (uint32_t)attribute_id;
+        m_results[index].status = CHIP_ERROR_TIMEOUT;
+    }
+cleanup:
+    json_parse_end(&jctx);
+    return ret;
+}
+
+void batch_write_command::OnResponse(const WriteClient *client, const ConcreteDataAttributePath &path,
+                                     StatusIB status)
+{
+    attribute_cache::invalidate(m_node_id, path);
+    CHIP_ERROR error = status.ToChipError();
+    if (CHIP_NO_ERROR != error) {
+        ChipLogError(chipTool, "Response Failure for 0x%04x/0x%08" PRIx32 "/0x%08" PRIx32 ": %s", path.mEndpointId,
+                     path.mClusterId, path.mAttributeId, chip::ErrorStr(error));
+    }
+    /* The same path can be written twice in a batch, the responses come in the order of the request */
+    for (size_t index = 0; index < m_count; index++) {
+        batch_write_result_t &result = m_results[index];
+        if (result.status == CHIP_ERROR_TIMEOUT && result.endpoint_id == path.mEndpointId &&
+            result.cluster_id == path.mClusterId && result.attribute_id == path.mAttributeId) {
+            result.status = error;
+            break;
+        }
+    }
+}
+
+void batch_write_command::done(CHIP_ERROR error)
+{
+    if (write_done_cb) {
+        write_done_cb(m_node_id, m_results, m_count, error);
+        return;
+    }
+    if (error != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Batch write to node 0x%" PRIx64 " failed: %s", m_node_id, chip::ErrorStr(error));
+    }
+    for (size_t index = 0; index < m_count; index++) {
+        ESP_LOGI(TAG, "0x%04x/0x%08" PRIx32 "/0x%08" PRIx32 ": %s", m_results[index].endpoint_id,
+                 m_results[index].cluster_id, m_results[index].attribute_id,
+                 m_results[index].status == CHIP_NO_ERROR ? "success" : chip::ErrorStr(m_results[index].status));
+    }
+}
+
+void batch_write_command::on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
+                                                  const SessionHandle &sessionHandle)
+{
+    batch_write_command *cmd = (batch_write_command *)context;
+    auto write_client = MakeUnique<WriteClient>(&exchangeMgr, &(cmd->m_chunked_callback), chip::NullOptional, false);
+    if (write_client == nullptr) {
+        ESP_LOGE(TAG, "Failed to alloc memory for WriteClient");
+        cmd->done(CHIP_ERROR_NO_MEMORY);
+        chip::Platform::Delete(cmd);
+        return;
+    }
+    /* The values are copied to the write request, so a single encode buffer is enough for all of them */
+    for (size_t index = 0; index < cmd->m_count; index++) {
+        const batch_write_result_t &result = cmd->m_results[index];
+        ConcreteDataAttributePath path(result.endpoint_id, result.cluster_id, result.attribute_id);
+        TLVReader reader;
+        if (write_command::encode_attribute_value(cmd->m_encoded_buf, cmd->m_encoded_buf_size, cmd->m_values[index],
+                                                  reader) != ESP_OK ||
+            write_client->PutPreencodedAttribute(path, reader) != CHIP_NO_ERROR) {
+            ESP_LOGE(TAG, "Failed to put the value of write %u to WriteClient", (unsigned)index);
+            cmd->done(CHIP_ERROR_INVALID_ARGUMENT);
+            chip::Platform::Delete(cmd);
+            return;
+        }
+    }
+    encode_buffer_pool::release(cmd->m_encoded_buf);
+    cmd->m_encoded_buf = nullptr;
+
+    if (write_client->SendWriteRequest(sessionHandle) != CHIP_NO_ERROR) {
+        ESP_LOGE(TAG, "Failed to Send Write Request");
+        cmd->done(CHIP_ERROR_INTERNAL);
+        chip::Platform::Delete(cmd);
+        return;
+    }
+    // Release the write_client as it will be managed by the callbacks
+    write_client.release();
+}
+
+void batch_write_command::on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId,
+                                                           CHIP_ERROR error)
+{
+    batch_write_command *cmd = (batch_write_command *)context;
+    cmd->done(error);
+    chip::Platform::Delete(cmd);
+}
+
+void batch_write_command::on_encode_buffer_ready(void *ctx, uint8_t *buf, size_t buf_size)
+{
+    batch_write_command *cmd = (batch_write_command *)ctx;
+    cmd->m_encoded_buf = buf;
+    cmd->m_encoded_buf_size = buf_size;
+    /* Check all the values before connecting, they are encoded again in the write request */
+    for (size_t index = 0; index < cmd->m_count; index++) {
+        TLVReader reader;
+        if (write_command::encode_attribute_value(buf, buf_size, cmd->m_values[index], reader) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to encode the value of write %u to a TLV reader", (unsigned)index);
+            cmd->done(CHIP_ERROR_INVALID_ARGUMENT);
+            chip::Platform::Delete(cmd);
+            return;
+        }
+    }
+    if (cmd->connect() != ESP_OK) {
+        cmd->done(CHIP_ERROR_NOT_CONNECTED);
+        chip::Platform::Delete(cmd);
+    }
+}
+
+esp_err_t batch_write_command::send_command()
+{
+    esp_err_t err = encode_buffer_pool::acquire(on_encode_buffer_ready, this);
+    if (err != ESP_OK) {
+        chip::Platform::Delete(this);
+    }
+    return err;
+}
+
+esp_err_t batch_write_command::connect()
+{
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    if (CHIP_NO_ERROR ==
+        commissioner::get_device_commissioner()->GetConnectedDevice(m_node_id, &on_device_connected_cb,
+                                                                    &on_device_connection_failure_cb)) {
+        return ESP_OK;
+    }
+    return ESP_FAIL;
+#else
+    chip::Server *server = &(chip::Server::GetInstance());
+    server->GetCASESessionManager()->FindOrEstablishSession(ScopedNodeId(m_node_id, get_fabric_index()),
+                                                            &on_device_connected_cb, &on_device_connection_failure_cb);
+    return ESP_OK;
+#endif
+}
+
+esp_err_t send_batch_write_attr_command(uint64_t node_id, const char *json_str, batch_write_done_cb_t done_cb)
+{
+    if (!json_str) {
+        ESP_LOGE(TAG, "batch write json string cannot be NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    batch_write_command *cmd = chip::Platform::New<batch_write_command>(node_id, done_cb);
+    if (!cmd) {
+        ESP_LOGE(TAG, "Failed to alloc memory for batch_write_command");
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t err = cmd->parse(json_str);
+    if (err != ESP_OK) {
+        chip::Platform::Delete(cmd);
+        return err;
+    }
+    return cmd->send_command();
+}
+
 } // namespace controller
 } // namespace esp_matter
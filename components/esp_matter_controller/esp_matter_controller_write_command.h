@@ -17,6 +17,10 @@
 #include <app/ChunkedWriteCallback.h>
 #include <controller/CommissioneeDeviceProxy.h>
 #include <esp_matter.h>
+#include <esp_matter_controller_attribute_cache.h>
+#include <esp_matter_controller_command_pool.h>
+#include <esp_matter_controller_encode_buffer_pool.h>
+#include <esp_matter_controller_utils.h>
 #include <esp_matter_mem.h>
 
 namespace esp_matter {
@@ -40,12 +44,13 @@ constexpr size_t k_attr_val_str_buf_size = CONFIG_ESP_MATTER_CONTROLLER_JSON_STR
 class write_command : public WriteClient::Callback {
 public:
     write_command(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
-                  const char *attribute_val_str)
+                  const char *attribute_val_str, write_done_cb_t done_cb = nullptr)
         : m_node_id(node_id)
         , m_attr_path(endpoint_id, cluster_id, attribute_id)
         , m_chunked_callback(this)
         , on_device_connected_cb(on_device_connected_fcn, this)
         , on_device_connection_failure_cb(on_device_connection_failure_fcn, this)
+        , write_done_cb(done_cb)
     {
         if (attribute_val_str) {
             strncpy(m_attr_val_str, attribute_val_str, k_attr_val_str_buf_size - 1);
@@ -56,37 +61,68 @@ public:
         }
     }
 
-    ~write_command() {}
+    ~write_command() { encode_buffer_pool::release(m_encoded_buf); }
+
+    /**
+     * @brief Creates a command, from the pool of the write_command objects when one is free.
+     */
+    template <typename... Args>
+    static write_command *create(Args &&...args)
+    {
+        return s_pool.create(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys a command created with create().
+     */
+    static void destroy(write_command *cmd) { s_pool.destroy(cmd); }
+
+    static const command_pool::stats_t &get_pool_stats() { return s_pool.get_stats(); }
 
     esp_err_t send_command();
 
     // WriteClient Callback Interface
     void OnResponse(const WriteClient *client, const ConcreteDataAttributePath &path, StatusIB status) override
     {
+        /* Drop the cached value, so that the next read fetches the written one */
+        attribute_cache::invalidate(m_node_id, path);
         CHIP_ERROR error = status.ToChipError();
         if (CHIP_NO_ERROR != error) {
             ChipLogError(chipTool, "Response Failure: %s", chip::ErrorStr(error));
+            m_error = error;
         }
     }
 
     void OnError(const WriteClient *client, CHIP_ERROR error) override
     {
         ChipLogProgress(chipTool, "Error: %s", chip::ErrorStr(error));
+        m_error = error;
     }
 
     void OnDone(WriteClient *client) override
     {
         ChipLogProgress(chipTool, "Write Done");
+        if (write_done_cb) {
+            write_done_cb(m_node_id, m_error);
+        }
         chip::Platform::Delete(client);
-        chip::Platform::Delete(this);
+        destroy(this);
     }
 
 private:
+    friend class batch_write_command;
+    static command_pool::pool<write_command> s_pool;
     uint64_t m_node_id;
     AttributePathParams m_attr_path;
     ChunkedWriteCallback m_chunked_callback;
     char m_attr_val_str[k_attr_val_str_buf_size];
+    /* Encoded attribute value, in a buffer of the encode buffer pool */
+    uint8_t *m_encoded_buf = nullptr;
+    TLVReader m_attr_val_reader;
+
+    esp_err_t connect();
 
+    static void on_encode_buffer_ready(void *ctx, uint8_t *buf, size_t buf_size);
     static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
                                         const SessionHandle &sessionHandle);
     static void on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error);
@@ -96,10 +132,111 @@ private:
 
     chip::Callback::Callback<chip::OnDeviceConnected> on_device_connected_cb;
     chip::Callback::Callback<chip::OnDeviceConnectionFailure> on_device_connection_failure_cb;
+    write_done_cb_t write_done_cb;
+    CHIP_ERROR m_error = CHIP_NO_ERROR;
 };
 
 esp_err_t send_write_attr_command(uint64_t node_id, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
-                                  const char *attr_val_json_str);
+                                  const char *attr_val_json_str, write_done_cb_t done_cb = nullptr);
+
+constexpr size_t k_batch_write_max_paths = CONFIG_ESP_MATTER_CONTROLLER_BATCH_WRITE_MAX_PATHS;
+
+/** Status of a path of a batch write */
+typedef struct batch_write_result {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    /** Status of the write response of the path, CHIP_ERROR_TIMEOUT if the path got no response */
+    CHIP_ERROR status;
+} batch_write_result_t;
+
+/**
+ * @brief Called once the batch write is done, with the status of each path in the order of the document. error is
+ *        the failure of the whole request, e.g. the session could not be established, CHIP_NO_ERROR otherwise.
+ */
+using batch_write_done_cb_t = void (*)(uint64_t node_id, const batch_write_result_t *results, size_t count,
+                                       CHIP_ERROR error);
+
+/**
+ * Writes several attribute paths of a node in one write interaction. The attribute values are put in a single
+ * WriteClient, which splits them in chunks when they do not fit in one message, so configuring a node does not take
+ * a round trip per attribute.
+ */
+class batch_write_command : public WriteClient::Callback {
+public:
+    batch_write_command(uint64_t node_id, batch_write_done_cb_t done_cb)
+        : m_node_id(node_id)
+        , m_chunked_callback(this)
+        , on_device_connected_cb(on_device_connected_fcn, this)
+        , on_device_connection_failure_cb(on_device_connection_failure_fcn, this)
+        , write_done_cb(done_cb)
+    {
+    }
+
+    ~batch_write_command();
+
+    /**
+     * @brief Adds the paths of the document, see send_batch_write_attr_command().
+     */
+    esp_err_t parse(const char *json_str);
+
+    esp_err_t send_command();
+
+    // WriteClient Callback Interface
+    void OnResponse(const WriteClient *client, const ConcreteDataAttributePath &path, StatusIB status) override;
+
+    void OnError(const WriteClient *client, CHIP_ERROR error) override
+    {
+        ChipLogProgress(chipTool, "Error: %s", chip::ErrorStr(error));
+        m_error = error;
+    }
+
+    void OnDone(WriteClient *client) override
+    {
+        ChipLogProgress(chipTool, "Batch Write Done");
+        done(m_error);
+        chip::Platform::Delete(client);
+        chip::Platform::Delete(this);
+    }
+
+private:
+    uint64_t m_node_id;
+    ChunkedWriteCallback m_chunked_callback;
+    batch_write_result_t m_results[k_batch_write_max_paths];
+    /* JSON values of the paths, allocated with esp_matter_mem */
+    char *m_values[k_batch_write_max_paths] = {};
+    size_t m_count = 0;
+    /* Buffer of the encode buffer pool, reused to encode the values one after the other */
+    uint8_t *m_encoded_buf = nullptr;
+    size_t m_encoded_buf_size = 0;
+
+    esp_err_t connect();
+    void done(CHIP_ERROR error);
+
+    static void on_encode_buffer_ready(void *ctx, uint8_t *buf, size_t buf_size);
+    static void on_device_connected_fcn(void *context, ExchangeManager &exchangeMgr,
+                                        const SessionHandle &sessionHandle);
+    static void on_device_connection_failure_fcn(void *context, const ScopedNodeId &peerId, CHIP_ERROR error);
+
+    chip::Callback::Callback<chip::OnDeviceConnected> on_device_connected_cb;
+    chip::Callback::Callback<chip::OnDeviceConnectionFailure> on_device_connection_failure_cb;
+    batch_write_done_cb_t write_done_cb;
+    CHIP_ERROR m_error = CHIP_NO_ERROR;
+};
+
+/**
+ * @brief Writes several attributes of a node in one write interaction.
+ *
+ * @param node_id  Node Id
+ * @param json_str Paths and values, e.g. {"writes": [{"endpoint": 1, "cluster": 6, "attribute": 16387,
+ *                 "value": {"0:U8": 2}}, ...]}. Each value has the format of the attr-value of write-attr. At most
+ *                 CONFIG_ESP_MATTER_CONTROLLER_BATCH_WRITE_MAX_PATHS paths.
+ * @param done_cb  Called with the status of each path, the statuses are logged if NULL
+ *
+ * @return ESP_OK if the write has been started. done_cb is not called otherwise.
+ */
+esp_err_t send_batch_write_attr_command(uint64_t node_id, const char *json_str,
+                                        batch_write_done_cb_t done_cb = nullptr);
 
 } // namespace controller
 } // namespace esp_matter
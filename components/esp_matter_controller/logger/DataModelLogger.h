@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <sdkconfig.h>
 #include <string>
 
 #include <app-common/zap-generated/cluster-objects.h>
@@ -30,9 +31,22 @@
 class DataModelLogger
 {
 public:
+#if CONFIG_ESP_MATTER_CONTROLLER_DATA_MODEL_LOGGER_NONE
+    static CHIP_ERROR LogAttribute(const chip::app::ConcreteDataAttributePath & path, chip::TLV::TLVReader * data)
+    {
+        return CHIP_NO_ERROR;
+    }
+    static CHIP_ERROR LogCommand(const chip::app::ConcreteCommandPath & path, chip::TLV::TLVReader * data)
+    {
+        return CHIP_NO_ERROR;
+    }
+    static CHIP_ERROR LogEvent(const chip::app::EventHeader & header, chip::TLV::TLVReader * data) { return CHIP_NO_ERROR; }
+#else
+    // Implemented by zap-generated/DataModelLogger.cpp, or by compact/DataModelLogger.cpp for the compact logger
     static CHIP_ERROR LogAttribute(const chip::app::ConcreteDataAttributePath & path, chip::TLV::TLVReader * data);
     static CHIP_ERROR LogCommand(const chip::app::ConcreteCommandPath & path, chip::TLV::TLVReader * data);
     static CHIP_ERROR LogEvent(const chip::app::EventHeader & header, chip::TLV::TLVReader * data);
+#endif
 
     static CHIP_ERROR LogValue(const char * label, size_t indent, bool value)
     {
@@ -0,0 +1,199 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Compact data model logger. The data is printed from its TLV encoding, which carries the value types, so only the
+ * names of the clusters and of their elements are needed. They come from a generated table instead of the per-cluster
+ * decoding code of the ZAP generated logger.
+ */
+
+#include <DataModelLogger.h>
+#include <inttypes.h>
+#include <lib/core/TLV.h>
+#include <stdio.h>
+
+#include "DataModelLoggerTable.h"
+
+using chip::TLV::TLVReader;
+using chip::TLV::TLVType;
+using namespace data_model_logger;
+
+namespace {
+
+/* Nesting limit, the data model structures are far from it */
+constexpr size_t k_max_depth = 8;
+
+enum element_kind {
+    ATTRIBUTE,
+    COMMAND,
+    EVENT,
+};
+
+const cluster_descriptor_t *find_cluster(uint32_t cluster_id)
+{
+    for (size_t index = 0; index < k_cluster_count; index++) {
+        if (k_clusters[index].id == cluster_id) {
+            return &k_clusters[index];
+        }
+    }
+    return nullptr;
+}
+
+const char *find_element(const element_descriptor_t *elements, size_t count, uint32_t id)
+{
+    for (size_t index = 0; index < count; index++) {
+        if (elements[index].id == id) {
+            return elements[index].name;
+        }
+    }
+    return nullptr;
+}
+
+std::string get_element_name(uint32_t cluster_id, uint32_t id, element_kind kind)
+{
+    const char *name = nullptr;
+    const cluster_descriptor_t *cluster = find_cluster(cluster_id);
+    if (cluster) {
+        switch (kind) {
+        case ATTRIBUTE:
+            name = find_element(cluster->attributes, cluster->attribute_count, id);
+            break;
+        case COMMAND:
+            name = find_element(cluster->commands, cluster->command_count, id);
+            break;
+        case EVENT:
+            name = find_element(cluster->events, cluster->event_count, id);
+            break;
+        }
+    }
+    if (!name && kind == ATTRIBUTE) {
+        name = find_element(k_global_attributes, k_global_attribute_count, id);
+    }
+    if (name) {
+        return name;
+    }
+    char buffer[11];
+    snprintf(buffer, sizeof(buffer), "0x%08" PRIX32, id);
+    return buffer;
+}
+
+std::string get_tag_label(const TLVReader &reader, size_t index, bool in_array)
+{
+    if (in_array) {
+        return std::string("[") + std::to_string(index + 1) + "]";
+    }
+    chip::TLV::Tag tag = reader.GetTag();
+    if (chip::TLV::IsContextTag(tag)) {
+        return std::to_string(chip::TLV::TagNumFromTag(tag));
+    }
+    return "";
+}
+
+CHIP_ERROR log_element(const std::string &label, size_t indent, TLVReader &reader, size_t depth)
+{
+    switch (reader.GetType()) {
+    case chip::TLV::kTLVType_SignedInteger: {
+        int64_t value;
+        ReturnErrorOnFailure(reader.Get(value));
+        return DataModelLogger::LogValue(label.c_str(), indent, value);
+    }
+    case chip::TLV::kTLVType_UnsignedInteger: {
+        uint64_t value;
+        ReturnErrorOnFailure(reader.Get(value));
+        return DataModelLogger::LogValue(label.c_str(), indent, value);
+    }
+    case chip::TLV::kTLVType_Boolean: {
+        bool value;
+        ReturnErrorOnFailure(reader.Get(value));
+        return DataModelLogger::LogValue(label.c_str(), indent, value);
+    }
+    case chip::TLV::kTLVType_FloatingPointNumber: {
+        double value;
+        ReturnErrorOnFailure(reader.Get(value));
+        return DataModelLogger::LogValue(label.c_str(), indent, value);
+    }
+    case chip::TLV::kTLVType_UTF8String: {
+        chip::CharSpan value;
+        ReturnErrorOnFailure(reader.Get(value));
+        return DataModelLogger::LogValue(label.c_str(), indent, value);
+    }
+    case chip::TLV::kTLVType_ByteString: {
+        chip::ByteSpan value;
+        ReturnErrorOnFailure(reader.Get(value));
+        return DataModelLogger::LogValue(label.c_str(), indent, value);
+    }
+    case chip::TLV::kTLVType_Null:
+        DataModelLogger::LogString(label, indent, "null");
+        return CHIP_NO_ERROR;
+    case chip::TLV::kTLVType_Structure:
+    case chip::TLV::kTLVType_Array:
+    case chip::TLV::kTLVType_List: {
+        if (depth >= k_max_depth) {
+            return CHIP_ERROR_INVALID_TLV_ELEMENT;
+        }
+        bool in_array = reader.GetType() != chip::TLV::kTLVType_Structure;
+        DataModelLogger::LogString(label, indent, in_array ? "[" : "{");
+        TLVType container_type;
+        ReturnErrorOnFailure(reader.EnterContainer(container_type));
+        CHIP_ERROR err;
+        size_t index = 0;
+        while ((err = reader.Next()) == CHIP_NO_ERROR) {
+            ReturnErrorOnFailure(log_element(get_tag_label(reader, index, in_array), indent + 1, reader, depth + 1));
+            index++;
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        ReturnErrorOnFailure(reader.ExitContainer(container_type));
+        DataModelLogger::LogString(indent, in_array ? "]" : "}");
+        return CHIP_NO_ERROR;
+    }
+    default:
+        return CHIP_ERROR_INVALID_TLV_ELEMENT;
+    }
+}
+
+} // namespace
+
+CHIP_ERROR DataModelLogger::LogAttribute(const chip::app::ConcreteDataAttributePath &path, chip::TLV::TLVReader *data)
+{
+    ChipLogProgress(chipTool,
+                    "Endpoint: %u Cluster: " ChipLogFormatMEI " Attribute " ChipLogFormatMEI " DataVersion: %" PRIu32,
+                    path.mEndpointId, ChipLogValueMEI(path.mClusterId), ChipLogValueMEI(path.mAttributeId),
+                    path.mDataVersion.ValueOr(0));
+    return log_element(get_element_name(path.mClusterId, path.mAttributeId, ATTRIBUTE), 1, *data, 0);
+}
+
+CHIP_ERROR DataModelLogger::LogCommand(const chip::app::ConcreteCommandPath &path, chip::TLV::TLVReader *data)
+{
+    ChipLogProgress(chipTool, "Endpoint: %u Cluster: " ChipLogFormatMEI " Command " ChipLogFormatMEI, path.mEndpointId,
+                    ChipLogValueMEI(path.mClusterId), ChipLogValueMEI(path.mCommandId));
+    return log_element(get_element_name(path.mClusterId, path.mCommandId, COMMAND), 1, *data, 0);
+}
+
+CHIP_ERROR DataModelLogger::LogEvent(const chip::app::EventHeader &header, chip::TLV::TLVReader *data)
+{
+    ChipLogProgress(chipTool, "Endpoint: %u Cluster: " ChipLogFormatMEI " Event " ChipLogFormatMEI,
+                    header.mPath.mEndpointId, ChipLogValueMEI(header.mPath.mClusterId), ChipLogValueMEI(header.mPath.mEventId));
+    ChipLogProgress(chipTool, "  Event number: %" PRIu64, header.mEventNumber);
+    const char *priority = "Unknown";
+    if (header.mPriorityLevel == chip::app::PriorityLevel::Info) {
+        priority = "Info";
+    } else if (header.mPriorityLevel == chip::app::PriorityLevel::Critical) {
+        priority = "Critical";
+    } else if (header.mPriorityLevel == chip::app::PriorityLevel::Debug) {
+        priority = "Debug";
+    }
+    ChipLogProgress(chipTool, "  Priority: %s", priority);
+    ChipLogProgress(chipTool, "  Timestamp: %" PRIu64, header.mTimestamp.mValue);
+    return log_element(get_element_name(header.mPath.mClusterId, header.mPath.mEventId, EVENT), 1, *data, 0);
+}
@@ -0,0 +1,1920 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// THIS FILE IS GENERATED BY tools/controller_logger/generate_logger_table.py
+
+#include <app-common/zap-generated/ids/Attributes.h>
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app-common/zap-generated/ids/Commands.h>
+#include <app-common/zap-generated/ids/Events.h>
+
+#include "DataModelLoggerTable.h"
+
+using namespace chip::app::Clusters;
+
+namespace data_model_logger {
+
+#define ELEMENTS(table) table, sizeof(table) / sizeof(table[0])
+#define NO_ELEMENTS nullptr, 0
+
+const element_descriptor_t k_global_attributes[] = {
+    {Globals::Attributes::GeneratedCommandList::Id, "GeneratedCommandList"},
+    {Globals::Attributes::AcceptedCommandList::Id, "AcceptedCommandList"},
+    {Globals::Attributes::EventList::Id, "EventList"},
+    {Globals::Attributes::AttributeList::Id, "AttributeList"},
+    {Globals::Attributes::FeatureMap::Id, "FeatureMap"},
+    {Globals::Attributes::ClusterRevision::Id, "ClusterRevision"},
+};
+const size_t k_global_attribute_count = sizeof(k_global_attributes) / sizeof(k_global_attributes[0]);
+
+static const element_descriptor_t Identify_attributes[] = {
+    {Identify::Attributes::IdentifyTime::Id, "IdentifyTime"},
+    {Identify::Attributes::IdentifyType::Id, "IdentifyType"},
+};
+
+static const element_descriptor_t Groups_attributes[] = {
+    {Groups::Attributes::NameSupport::Id, "NameSupport"},
+};
+
+static const element_descriptor_t Groups_commands[] = {
+    {Groups::Commands::AddGroupResponse::Id, "AddGroupResponse"},
+    {Groups::Commands::ViewGroupResponse::Id, "ViewGroupResponse"},
+    {Groups::Commands::GetGroupMembershipResponse::Id, "GetGroupMembershipResponse"},
+    {Groups::Commands::RemoveGroupResponse::Id, "RemoveGroupResponse"},
+};
+
+static const element_descriptor_t ScenesManagement_attributes[] = {
+    {ScenesManagement::Attributes::LastConfiguredBy::Id, "LastConfiguredBy"},
+    {ScenesManagement::Attributes::SceneTableSize::Id, "SceneTableSize"},
+    {ScenesManagement::Attributes::FabricSceneInfo::Id, "FabricSceneInfo"},
+};
+
+static const element_descriptor_t ScenesManagement_commands[] = {
+    {ScenesManagement::Commands::AddSceneResponse::Id, "AddSceneResponse"},
+    {ScenesManagement::Commands::ViewSceneResponse::Id, "ViewSceneResponse"},
+    {ScenesManagement::Commands::RemoveSceneResponse::Id, "RemoveSceneResponse"},
+    {ScenesManagement::Commands::RemoveAllScenesResponse::Id, "RemoveAllScenesResponse"},
+    {ScenesManagement::Commands::StoreSceneResponse::Id, "StoreSceneResponse"},
+    {ScenesManagement::Commands::GetSceneMembershipResponse::Id, "GetSceneMembershipResponse"},
+    {ScenesManagement::Commands::CopySceneResponse::Id, "CopySceneResponse"},
+};
+
+static const element_descriptor_t OnOff_attributes[] = {
+    {OnOff::Attributes::OnOff::Id, "OnOff"},
+    {OnOff::Attributes::GlobalSceneControl::Id, "GlobalSceneControl"},
+    {OnOff::Attributes::OnTime::Id, "OnTime"},
+    {OnOff::Attributes::OffWaitTime::Id, "OffWaitTime"},
+    {OnOff::Attributes::StartUpOnOff::Id, "StartUpOnOff"},
+};
+
+static const element_descriptor_t OnOffSwitchConfiguration_attributes[] = {
+    {OnOffSwitchConfiguration::Attributes::SwitchType::Id, "SwitchType"},
+    {OnOffSwitchConfiguration::Attributes::SwitchActions::Id, "SwitchActions"},
+};
+
+static const element_descriptor_t LevelControl_attributes[] = {
+    {LevelControl::Attributes::CurrentLevel::Id, "CurrentLevel"},
+    {LevelControl::Attributes::RemainingTime::Id, "RemainingTime"},
+    {LevelControl::Attributes::MinLevel::Id, "MinLevel"},
+    {LevelControl::Attributes::MaxLevel::Id, "MaxLevel"},
+    {LevelControl::Attributes::CurrentFrequency::Id, "CurrentFrequency"},
+    {LevelControl::Attributes::MinFrequency::Id, "MinFrequency"},
+    {LevelControl::Attributes::MaxFrequency::Id, "MaxFrequency"},
+    {LevelControl::Attributes::Options::Id, "Options"},
+    {LevelControl::Attributes::OnOffTransitionTime::Id, "OnOffTransitionTime"},
+    {LevelControl::Attributes::OnLevel::Id, "OnLevel"},
+    {LevelControl::Attributes::OnTransitionTime::Id, "OnTransitionTime"},
+    {LevelControl::Attributes::OffTransitionTime::Id, "OffTransitionTime"},
+    {LevelControl::Attributes::DefaultMoveRate::Id, "DefaultMoveRate"},
+    {LevelControl::Attributes::StartUpCurrentLevel::Id, "StartUpCurrentLevel"},
+};
+
+static const element_descriptor_t BinaryInputBasic_attributes[] = {
+    {BinaryInputBasic::Attributes::ActiveText::Id, "ActiveText"},
+    {BinaryInputBasic::Attributes::Description::Id, "Description"},
+    {BinaryInputBasic::Attributes::InactiveText::Id, "InactiveText"},
+    {BinaryInputBasic::Attributes::OutOfService::Id, "OutOfService"},
+    {BinaryInputBasic::Attributes::Polarity::Id, "Polarity"},
+    {BinaryInputBasic::Attributes::PresentValue::Id, "PresentValue"},
+    {BinaryInputBasic::Attributes::Reliability::Id, "Reliability"},
+    {BinaryInputBasic::Attributes::StatusFlags::Id, "StatusFlags"},
+    {BinaryInputBasic::Attributes::ApplicationType::Id, "ApplicationType"},
+};
+
+static const element_descriptor_t Descriptor_attributes[] = {
+    {Descriptor::Attributes::DeviceTypeList::Id, "DeviceTypeList"},
+    {Descriptor::Attributes::ServerList::Id, "ServerList"},
+    {Descriptor::Attributes::ClientList::Id, "ClientList"},
+    {Descriptor::Attributes::PartsList::Id, "PartsList"},
+    {Descriptor::Attributes::TagList::Id, "TagList"},
+};
+
+static const element_descriptor_t Binding_attributes[] = {
+    {Binding::Attributes::Binding::Id, "Binding"},
+};
+
+static const element_descriptor_t AccessControl_attributes[] = {
+    {AccessControl::Attributes::Acl::Id, "Acl"},
+    {AccessControl::Attributes::Extension::Id, "Extension"},
+    {AccessControl::Attributes::SubjectsPerAccessControlEntry::Id, "SubjectsPerAccessControlEntry"},
+    {AccessControl::Attributes::TargetsPerAccessControlEntry::Id, "TargetsPerAccessControlEntry"},
+    {AccessControl::Attributes::AccessControlEntriesPerFabric::Id, "AccessControlEntriesPerFabric"},
+};
+
+static const element_descriptor_t AccessControl_events[] = {
+    {AccessControl::Events::AccessControlEntryChanged::Id, "AccessControlEntryChanged"},
+    {AccessControl::Events::AccessControlExtensionChanged::Id, "AccessControlExtensionChanged"},
+};
+
+static const element_descriptor_t Actions_attributes[] = {
+    {Actions::Attributes::ActionList::Id, "ActionList"},
+    {Actions::Attributes::EndpointLists::Id, "EndpointLists"},
+    {Actions::Attributes::SetupURL::Id, "SetupURL"},
+};
+
+static const element_descriptor_t Actions_events[] = {
+    {Actions::Events::StateChanged::Id, "StateChanged"},
+    {Actions::Events::ActionFailed::Id, "ActionFailed"},
+};
+
+static const element_descriptor_t BasicInformation_attributes[] = {
+    {BasicInformation::Attributes::DataModelRevision::Id, "DataModelRevision"},
+    {BasicInformation::Attributes::VendorName::Id, "VendorName"},
+    {BasicInformation::Attributes::VendorID::Id, "VendorID"},
+    {BasicInformation::Attributes::ProductName::Id, "ProductName"},
+    {BasicInformation::Attributes::ProductID::Id, "ProductID"},
+    {BasicInformation::Attributes::NodeLabel::Id, "NodeLabel"},
+    {BasicInformation::Attributes::Location::Id, "Location"},
+    {BasicInformation::Attributes::HardwareVersion::Id, "HardwareVersion"},
+    {BasicInformation::Attributes::HardwareVersionString::Id, "HardwareVersionString"},
+    {BasicInformation::Attributes::SoftwareVersion::Id, "SoftwareVersion"},
+    {BasicInformation::Attributes::SoftwareVersionString::Id, "SoftwareVersionString"},
+    {BasicInformation::Attributes::ManufacturingDate::Id, "ManufacturingDate"},
+    {BasicInformation::Attributes::PartNumber::Id, "PartNumber"},
+    {BasicInformation::Attributes::ProductURL::Id, "ProductURL"},
+    {BasicInformation::Attributes::ProductLabel::Id, "ProductLabel"},
+    {BasicInformation::Attributes::SerialNumber::Id, "SerialNumber"},
+    {BasicInformation::Attributes::LocalConfigDisabled::Id, "LocalConfigDisabled"},
+    {BasicInformation::Attributes::Reachable::Id, "Reachable"},
+    {BasicInformation::Attributes::UniqueID::Id, "UniqueID"},
+    {BasicInformation::Attributes::CapabilityMinima::Id, "CapabilityMinima"},
+    {BasicInformation::Attributes::ProductAppearance::Id, "ProductAppearance"},
+    {BasicInformation::Attributes::SpecificationVersion::Id, "SpecificationVersion"},
+    {BasicInformation::Attributes::MaxPathsPerInvoke::Id, "MaxPathsPerInvoke"},
+};
+
+static const element_descriptor_t BasicInformation_events[] = {
+    {BasicInformation::Events::StartUp::Id, "StartUp"},
+    {BasicInformation::Events::ShutDown::Id, "ShutDown"},
+    {BasicInformation::Events::Leave::Id, "Leave"},
+    {BasicInformation::Events::ReachableChanged::Id, "ReachableChanged"},
+};
+
+static const element_descriptor_t OtaSoftwareUpdateProvider_commands[] = {
+    {OtaSoftwareUpdateProvider::Commands::QueryImageResponse::Id, "QueryImageResponse"},
+    {OtaSoftwareUpdateProvider::Commands::ApplyUpdateResponse::Id, "ApplyUpdateResponse"},
+};
+
+static const element_descriptor_t OtaSoftwareUpdateRequestor_attributes[] = {
+    {OtaSoftwareUpdateRequestor::Attributes::DefaultOTAProviders::Id, "DefaultOTAProviders"},
+    {OtaSoftwareUpdateRequestor::Attributes::UpdatePossible::Id, "UpdatePossible"},
+    {OtaSoftwareUpdateRequestor::Attributes::UpdateState::Id, "UpdateState"},
+    {OtaSoftwareUpdateRequestor::Attributes::UpdateStateProgress::Id, "UpdateStateProgress"},
+};
+
+static const element_descriptor_t OtaSoftwareUpdateRequestor_events[] = {
+    {OtaSoftwareUpdateRequestor::Events::StateTransition::Id, "StateTransition"},
+    {OtaSoftwareUpdateRequestor::Events::VersionApplied::Id, "VersionApplied"},
+    {OtaSoftwareUpdateRequestor::Events::DownloadError::Id, "DownloadError"},
+};
+
+static const element_descriptor_t LocalizationConfiguration_attributes[] = {
+    {LocalizationConfiguration::Attributes::ActiveLocale::Id, "ActiveLocale"},
+    {LocalizationConfiguration::Attributes::SupportedLocales::Id, "SupportedLocales"},
+};
+
+static const element_descriptor_t TimeFormatLocalization_attributes[] = {
+    {TimeFormatLocalization::Attributes::HourFormat::Id, "HourFormat"},
+    {TimeFormatLocalization::Attributes::ActiveCalendarType::Id, "ActiveCalendarType"},
+    {TimeFormatLocalization::Attributes::SupportedCalendarTypes::Id, "SupportedCalendarTypes"},
+};
+
+static const element_descriptor_t UnitLocalization_attributes[] = {
+    {UnitLocalization::Attributes::TemperatureUnit::Id, "TemperatureUnit"},
+};
+
+static const element_descriptor_t PowerSourceConfiguration_attributes[] = {
+    {PowerSourceConfiguration::Attributes::Sources::Id, "Sources"},
+};
+
+static const element_descriptor_t PowerSource_attributes[] = {
+    {PowerSource::Attributes::Status::Id, "Status"},
+    {PowerSource::Attributes::Order::Id, "Order"},
+    {PowerSource::Attributes::Description::Id, "Description"},
+    {PowerSource::Attributes::WiredAssessedInputVoltage::Id, "WiredAssessedInputVoltage"},
+    {PowerSource::Attributes::WiredAssessedInputFrequency::Id, "WiredAssessedInputFrequency"},
+    {PowerSource::Attributes::WiredCurrentType::Id, "WiredCurrentType"},
+    {PowerSource::Attributes::WiredAssessedCurrent::Id, "WiredAssessedCurrent"},
+    {PowerSource::Attributes::WiredNominalVoltage::Id, "WiredNominalVoltage"},
+    {PowerSource::Attributes::WiredMaximumCurrent::Id, "WiredMaximumCurrent"},
+    {PowerSource::Attributes::WiredPresent::Id, "WiredPresent"},
+    {PowerSource::Attributes::ActiveWiredFaults::Id, "ActiveWiredFaults"},
+    {PowerSource::Attributes::BatVoltage::Id, "BatVoltage"},
+    {PowerSource::Attributes::BatPercentRemaining::Id, "BatPercentRemaining"},
+    {PowerSource::Attributes::BatTimeRemaining::Id, "BatTimeRemaining"},
+    {PowerSource::Attributes::BatChargeLevel::Id, "BatChargeLevel"},
+    {PowerSource::Attributes::BatReplacementNeeded::Id, "BatReplacementNeeded"},
+    {PowerSource::Attributes::BatReplaceability::Id, "BatReplaceability"},
+    {PowerSource::Attributes::BatPresent::Id, "BatPresent"},
+    {PowerSource::Attributes::ActiveBatFaults::Id, "ActiveBatFaults"},
+    {PowerSource::Attributes::BatReplacementDescription::Id, "BatReplacementDescription"},
+    {PowerSource::Attributes::BatCommonDesignation::Id, "BatCommonDesignation"},
+    {PowerSource::Attributes::BatANSIDesignation::Id, "BatANSIDesignation"},
+    {PowerSource::Attributes::BatIECDesignation::Id, "BatIECDesignation"},
+    {PowerSource::Attributes::BatApprovedChemistry::Id, "BatApprovedChemistry"},
+    {PowerSource::Attributes::BatCapacity::Id, "BatCapacity"},
+    {PowerSource::Attributes::BatQuantity::Id, "BatQuantity"},
+    {PowerSource::Attributes::BatChargeState::Id, "BatChargeState"},
+    {PowerSource::Attributes::BatTimeToFullCharge::Id, "BatTimeToFullCharge"},
+    {PowerSource::Attributes::BatFunctionalWhileCharging::Id, "BatFunctionalWhileCharging"},
+    {PowerSource::Attributes::BatChargingCurrent::Id, "BatChargingCurrent"},
+    {PowerSource::Attributes::ActiveBatChargeFaults::Id, "ActiveBatChargeFaults"},
+    {PowerSource::Attributes::EndpointList::Id, "EndpointList"},
+};
+
+static const element_descriptor_t PowerSource_events[] = {
+    {PowerSource::Events::WiredFaultChange::Id, "WiredFaultChange"},
+    {PowerSource::Events::BatFaultChange::Id, "BatFaultChange"},
+    {PowerSource::Events::BatChargeFaultChange::Id, "BatChargeFaultChange"},
+};
+
+static const element_descriptor_t GeneralCommissioning_attributes[] = {
+    {GeneralCommissioning::Attributes::Breadcrumb::Id, "Breadcrumb"},
+    {GeneralCommissioning::Attributes::BasicCommissioningInfo::Id, "BasicCommissioningInfo"},
+    {GeneralCommissioning::Attributes::RegulatoryConfig::Id, "RegulatoryConfig"},
+    {GeneralCommissioning::Attributes::LocationCapability::Id, "LocationCapability"},
+    {GeneralCommissioning::Attributes::SupportsConcurrentConnection::Id, "SupportsConcurrentConnection"},
+};
+
+static const element_descriptor_t GeneralCommissioning_commands[] = {
+    {GeneralCommissioning::Commands::ArmFailSafeResponse::Id, "ArmFailSafeResponse"},
+    {GeneralCommissioning::Commands::SetRegulatoryConfigResponse::Id, "SetRegulatoryConfigResponse"},
+    {GeneralCommissioning::Commands::CommissioningCompleteResponse::Id, "CommissioningCompleteResponse"},
+};
+
+static const element_descriptor_t NetworkCommissioning_attributes[] = {
+    {NetworkCommissioning::Attributes::MaxNetworks::Id, "MaxNetworks"},
+    {NetworkCommissioning::Attributes::Networks::Id, "Networks"},
+    {NetworkCommissioning::Attributes::ScanMaxTimeSeconds::Id, "ScanMaxTimeSeconds"},
+    {NetworkCommissioning::Attributes::ConnectMaxTimeSeconds::Id, "ConnectMaxTimeSeconds"},
+    {NetworkCommissioning::Attributes::InterfaceEnabled::Id, "InterfaceEnabled"},
+    {NetworkCommissioning::Attributes::LastNetworkingStatus::Id, "LastNetworkingStatus"},
+    {NetworkCommissioning::Attributes::LastNetworkID::Id, "LastNetworkID"},
+    {NetworkCommissioning::Attributes::LastConnectErrorValue::Id, "LastConnectErrorValue"},
+    {NetworkCommissioning::Attributes::SupportedWiFiBands::Id, "SupportedWiFiBands"},
+    {NetworkCommissioning::Attributes::SupportedThreadFeatures::Id, "SupportedThreadFeatures"},
+    {NetworkCommissioning::Attributes::ThreadVersion::Id, "ThreadVersion"},
+};
+
+static const element_descriptor_t NetworkCommissioning_commands[] = {
+    {NetworkCommissioning::Commands::ScanNetworksResponse::Id, "ScanNetworksResponse"},
+    {NetworkCommissioning::Commands::NetworkConfigResponse::Id, "NetworkConfigResponse"},
+    {NetworkCommissioning::Commands::ConnectNetworkResponse::Id, "ConnectNetworkResponse"},
+    {NetworkCommissioning::Commands::QueryIdentityResponse::Id, "QueryIdentityResponse"},
+};
+
+static const element_descriptor_t DiagnosticLogs_commands[] = {
+    {DiagnosticLogs::Commands::RetrieveLogsResponse::Id, "RetrieveLogsResponse"},
+};
+
+static const element_descriptor_t GeneralDiagnostics_attributes[] = {
+    {GeneralDiagnostics::Attributes::NetworkInterfaces::Id, "NetworkInterfaces"},
+    {GeneralDiagnostics::Attributes::RebootCount::Id, "RebootCount"},
+    {GeneralDiagnostics::Attributes::UpTime::Id, "UpTime"},
+    {GeneralDiagnostics::Attributes::TotalOperationalHours::Id, "TotalOperationalHours"},
+    {GeneralDiagnostics::Attributes::BootReason::Id, "BootReason"},
+    {GeneralDiagnostics::Attributes::ActiveHardwareFaults::Id, "ActiveHardwareFaults"},
+    {GeneralDiagnostics::Attributes::ActiveRadioFaults::Id, "ActiveRadioFaults"},
+    {GeneralDiagnostics::Attributes::ActiveNetworkFaults::Id, "ActiveNetworkFaults"},
+    {GeneralDiagnostics::Attributes::TestEventTriggersEnabled::Id, "TestEventTriggersEnabled"},
+};
+
+static const element_descriptor_t GeneralDiagnostics_commands[] = {
+    {GeneralDiagnostics::Commands::TimeSnapshotResponse::Id, "TimeSnapshotResponse"},
+};
+
+static const element_descriptor_t GeneralDiagnostics_events[] = {
+    {GeneralDiagnostics::Events::HardwareFaultChange::Id, "HardwareFaultChange"},
+    {GeneralDiagnostics::Events::RadioFaultChange::Id, "RadioFaultChange"},
+    {GeneralDiagnostics::Events::NetworkFaultChange::Id, "NetworkFaultChange"},
+    {GeneralDiagnostics::Events::BootReason::Id, "BootReason"},
+};
+
+static const element_descriptor_t SoftwareDiagnostics_attributes[] = {
+    {SoftwareDiagnostics::Attributes::ThreadMetrics::Id, "ThreadMetrics"},
+    {SoftwareDiagnostics::Attributes::CurrentHeapFree::Id, "CurrentHeapFree"},
+    {SoftwareDiagnostics::Attributes::CurrentHeapUsed::Id, "CurrentHeapUsed"},
+    {SoftwareDiagnostics::Attributes::CurrentHeapHighWatermark::Id, "CurrentHeapHighWatermark"},
+};
+
+static const element_descriptor_t SoftwareDiagnostics_events[] = {
+    {SoftwareDiagnostics::Events::SoftwareFault::Id, "SoftwareFault"},
+};
+
+static const element_descriptor_t ThreadNetworkDiagnostics_attributes[] = {
+    {ThreadNetworkDiagnostics::Attributes::Channel::Id, "Channel"},
+    {ThreadNetworkDiagnostics::Attributes::RoutingRole::Id, "RoutingRole"},
+    {ThreadNetworkDiagnostics::Attributes::NetworkName::Id, "NetworkName"},
+    {ThreadNetworkDiagnostics::Attributes::PanId::Id, "PanId"},
+    {ThreadNetworkDiagnostics::Attributes::ExtendedPanId::Id, "ExtendedPanId"},
+    {ThreadNetworkDiagnostics::Attributes::MeshLocalPrefix::Id, "MeshLocalPrefix"},
+    {ThreadNetworkDiagnostics::Attributes::OverrunCount::Id, "OverrunCount"},
+    {ThreadNetworkDiagnostics::Attributes::NeighborTable::Id, "NeighborTable"},
+    {ThreadNetworkDiagnostics::Attributes::RouteTable::Id, "RouteTable"},
+    {ThreadNetworkDiagnostics::Attributes::PartitionId::Id, "PartitionId"},
+    {ThreadNetworkDiagnostics::Attributes::Weighting::Id, "Weighting"},
+    {ThreadNetworkDiagnostics::Attributes::DataVersion::Id, "DataVersion"},
+    {ThreadNetworkDiagnostics::Attributes::StableDataVersion::Id, "StableDataVersion"},
+    {ThreadNetworkDiagnostics::Attributes::LeaderRouterId::Id, "LeaderRouterId"},
+    {ThreadNetworkDiagnostics::Attributes::DetachedRoleCount::Id, "DetachedRoleCount"},
+    {ThreadNetworkDiagnostics::Attributes::ChildRoleCount::Id, "ChildRoleCount"},
+    {ThreadNetworkDiagnostics::Attributes::RouterRoleCount::Id, "RouterRoleCount"},
+    {ThreadNetworkDiagnostics::Attributes::LeaderRoleCount::Id, "LeaderRoleCount"},
+    {ThreadNetworkDiagnostics::Attributes::AttachAttemptCount::Id, "AttachAttemptCount"},
+    {ThreadNetworkDiagnostics::Attributes::PartitionIdChangeCount::Id, "PartitionIdChangeCount"},
+    {ThreadNetworkDiagnostics::Attributes::BetterPartitionAttachAttemptCount::Id, "BetterPartitionAttachAttemptCount"},
+    {ThreadNetworkDiagnostics::Attributes::ParentChangeCount::Id, "ParentChangeCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxTotalCount::Id, "TxTotalCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxUnicastCount::Id, "TxUnicastCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxBroadcastCount::Id, "TxBroadcastCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxAckRequestedCount::Id, "TxAckRequestedCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxAckedCount::Id, "TxAckedCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxNoAckRequestedCount::Id, "TxNoAckRequestedCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxDataCount::Id, "TxDataCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxDataPollCount::Id, "TxDataPollCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxBeaconCount::Id, "TxBeaconCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxBeaconRequestCount::Id, "TxBeaconRequestCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxOtherCount::Id, "TxOtherCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxRetryCount::Id, "TxRetryCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxDirectMaxRetryExpiryCount::Id, "TxDirectMaxRetryExpiryCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxIndirectMaxRetryExpiryCount::Id, "TxIndirectMaxRetryExpiryCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxErrCcaCount::Id, "TxErrCcaCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxErrAbortCount::Id, "TxErrAbortCount"},
+    {ThreadNetworkDiagnostics::Attributes::TxErrBusyChannelCount::Id, "TxErrBusyChannelCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxTotalCount::Id, "RxTotalCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxUnicastCount::Id, "RxUnicastCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxBroadcastCount::Id, "RxBroadcastCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxDataCount::Id, "RxDataCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxDataPollCount::Id, "RxDataPollCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxBeaconCount::Id, "RxBeaconCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxBeaconRequestCount::Id, "RxBeaconRequestCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxOtherCount::Id, "RxOtherCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxAddressFilteredCount::Id, "RxAddressFilteredCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxDestAddrFilteredCount::Id, "RxDestAddrFilteredCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxDuplicatedCount::Id, "RxDuplicatedCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxErrNoFrameCount::Id, "RxErrNoFrameCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxErrUnknownNeighborCount::Id, "RxErrUnknownNeighborCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxErrInvalidSrcAddrCount::Id, "RxErrInvalidSrcAddrCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxErrSecCount::Id, "RxErrSecCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxErrFcsCount::Id, "RxErrFcsCount"},
+    {ThreadNetworkDiagnostics::Attributes::RxErrOtherCount::Id, "RxErrOtherCount"},
+    {ThreadNetworkDiagnostics::Attributes::ActiveTimestamp::Id, "ActiveTimestamp"},
+    {ThreadNetworkDiagnostics::Attributes::PendingTimestamp::Id, "PendingTimestamp"},
+    {ThreadNetworkDiagnostics::Attributes::Delay::Id, "Delay"},
+    {ThreadNetworkDiagnostics::Attributes::SecurityPolicy::Id, "SecurityPolicy"},
+    {ThreadNetworkDiagnostics::Attributes::ChannelPage0Mask::Id, "ChannelPage0Mask"},
+    {ThreadNetworkDiagnostics::Attributes::OperationalDatasetComponents::Id, "OperationalDatasetComponents"},
+    {ThreadNetworkDiagnostics::Attributes::ActiveNetworkFaultsList::Id, "ActiveNetworkFaultsList"},
+};
+
+static const element_descriptor_t ThreadNetworkDiagnostics_events[] = {
+    {ThreadNetworkDiagnostics::Events::ConnectionStatus::Id, "ConnectionStatus"},
+    {ThreadNetworkDiagnostics::Events::NetworkFaultChange::Id, "NetworkFaultChange"},
+};
+
+static const element_descriptor_t WiFiNetworkDiagnostics_attributes[] = {
+    {WiFiNetworkDiagnostics::Attributes::Bssid::Id, "Bssid"},
+    {WiFiNetworkDiagnostics::Attributes::SecurityType::Id, "SecurityType"},
+    {WiFiNetworkDiagnostics::Attributes::WiFiVersion::Id, "WiFiVersion"},
+    {WiFiNetworkDiagnostics::Attributes::ChannelNumber::Id, "ChannelNumber"},
+    {WiFiNetworkDiagnostics::Attributes::Rssi::Id, "Rssi"},
+    {WiFiNetworkDiagnostics::Attributes::BeaconLostCount::Id, "BeaconLostCount"},
+    {WiFiNetworkDiagnostics::Attributes::BeaconRxCount::Id, "BeaconRxCount"},
+    {WiFiNetworkDiagnostics::Attributes::PacketMulticastRxCount::Id, "PacketMulticastRxCount"},
+    {WiFiNetworkDiagnostics::Attributes::PacketMulticastTxCount::Id, "PacketMulticastTxCount"},
+    {WiFiNetworkDiagnostics::Attributes::PacketUnicastRxCount::Id, "PacketUnicastRxCount"},
+    {WiFiNetworkDiagnostics::Attributes::PacketUnicastTxCount::Id, "PacketUnicastTxCount"},
+    {WiFiNetworkDiagnostics::Attributes::CurrentMaxRate::Id, "CurrentMaxRate"},
+    {WiFiNetworkDiagnostics::Attributes::OverrunCount::Id, "OverrunCount"},
+};
+
+static const element_descriptor_t WiFiNetworkDiagnostics_events[] = {
+    {WiFiNetworkDiagnostics::Events::Disconnection::Id, "Disconnection"},
+    {WiFiNetworkDiagnostics::Events::AssociationFailure::Id, "AssociationFailure"},
+    {WiFiNetworkDiagnostics::Events::ConnectionStatus::Id, "ConnectionStatus"},
+};
+
+static const element_descriptor_t EthernetNetworkDiagnostics_attributes[] = {
+    {EthernetNetworkDiagnostics::Attributes::PHYRate::Id, "PHYRate"},
+    {EthernetNetworkDiagnostics::Attributes::FullDuplex::Id, "FullDuplex"},
+    {EthernetNetworkDiagnostics::Attributes::PacketRxCount::Id, "PacketRxCount"},
+    {EthernetNetworkDiagnostics::Attributes::PacketTxCount::Id, "PacketTxCount"},
+    {EthernetNetworkDiagnostics::Attributes::TxErrCount::Id, "TxErrCount"},
+    {EthernetNetworkDiagnostics::Attributes::CollisionCount::Id, "CollisionCount"},
+    {EthernetNetworkDiagnostics::Attributes::OverrunCount::Id, "OverrunCount"},
+    {EthernetNetworkDiagnostics::Attributes::CarrierDetect::Id, "CarrierDetect"},
+    {EthernetNetworkDiagnostics::Attributes::TimeSinceReset::Id, "TimeSinceReset"},
+};
+
+static const element_descriptor_t TimeSynchronization_attributes[] = {
+    {TimeSynchronization::Attributes::UTCTime::Id, "UTCTime"},
+    {TimeSynchronization::Attributes::Granularity::Id, "Granularity"},
+    {TimeSynchronization::Attributes::TimeSource::Id, "TimeSource"},
+    {TimeSynchronization::Attributes::TrustedTimeSource::Id, "TrustedTimeSource"},
+    {TimeSynchronization::Attributes::DefaultNTP::Id, "DefaultNTP"},
+    {TimeSynchronization::Attributes::TimeZone::Id, "TimeZone"},
+    {TimeSynchronization::Attributes::DSTOffset::Id, "DSTOffset"},
+    {TimeSynchronization::Attributes::LocalTime::Id, "LocalTime"},
+    {TimeSynchronization::Attributes::TimeZoneDatabase::Id, "TimeZoneDatabase"},
+    {TimeSynchronization::Attributes::NTPServerAvailable::Id, "NTPServerAvailable"},
+    {TimeSynchronization::Attributes::TimeZoneListMaxSize::Id, "TimeZoneListMaxSize"},
+    {TimeSynchronization::Attributes::DSTOffsetListMaxSize::Id, "DSTOffsetListMaxSize"},
+    {TimeSynchronization::Attributes::SupportsDNSResolve::Id, "SupportsDNSResolve"},
+};
+
+static const element_descriptor_t TimeSynchronization_commands[] = {
+    {TimeSynchronization::Commands::SetTimeZoneResponse::Id, "SetTimeZoneResponse"},
+};
+
+static const element_descriptor_t TimeSynchronization_events[] = {
+    {TimeSynchronization::Events::DSTTableEmpty::Id, "DSTTableEmpty"},
+    {TimeSynchronization::Events::DSTStatus::Id, "DSTStatus"},
+    {TimeSynchronization::Events::TimeZoneStatus::Id, "TimeZoneStatus"},
+    {TimeSynchronization::Events::TimeFailure::Id, "TimeFailure"},
+    {TimeSynchronization::Events::MissingTrustedTimeSource::Id, "MissingTrustedTimeSource"},
+};
+
+static const element_descriptor_t BridgedDeviceBasicInformation_attributes[] = {
+    {BridgedDeviceBasicInformation::Attributes::VendorName::Id, "VendorName"},
+    {BridgedDeviceBasicInformation::Attributes::VendorID::Id, "VendorID"},
+    {BridgedDeviceBasicInformation::Attributes::ProductName::Id, "ProductName"},
+    {BridgedDeviceBasicInformation::Attributes::NodeLabel::Id, "NodeLabel"},
+    {BridgedDeviceBasicInformation::Attributes::HardwareVersion::Id, "HardwareVersion"},
+    {BridgedDeviceBasicInformation::Attributes::HardwareVersionString::Id, "HardwareVersionString"},
+    {BridgedDeviceBasicInformation::Attributes::SoftwareVersion::Id, "SoftwareVersion"},
+    {BridgedDeviceBasicInformation::Attributes::SoftwareVersionString::Id, "SoftwareVersionString"},
+    {BridgedDeviceBasicInformation::Attributes::ManufacturingDate::Id, "ManufacturingDate"},
+    {BridgedDeviceBasicInformation::Attributes::PartNumber::Id, "PartNumber"},
+    {BridgedDeviceBasicInformation::Attributes::ProductURL::Id, "ProductURL"},
+    {BridgedDeviceBasicInformation::Attributes::ProductLabel::Id, "ProductLabel"},
+    {BridgedDeviceBasicInformation::Attributes::SerialNumber::Id, "SerialNumber"},
+    {BridgedDeviceBasicInformation::Attributes::Reachable::Id, "Reachable"},
+    {BridgedDeviceBasicInformation::Attributes::UniqueID::Id, "UniqueID"},
+    {BridgedDeviceBasicInformation::Attributes::ProductAppearance::Id, "ProductAppearance"},
+};
+
+static const element_descriptor_t BridgedDeviceBasicInformation_events[] = {
+    {BridgedDeviceBasicInformation::Events::StartUp::Id, "StartUp"},
+    {BridgedDeviceBasicInformation::Events::ShutDown::Id, "ShutDown"},
+    {BridgedDeviceBasicInformation::Events::Leave::Id, "Leave"},
+    {BridgedDeviceBasicInformation::Events::ReachableChanged::Id, "ReachableChanged"},
+};
+
+static const element_descriptor_t Switch_attributes[] = {
+    {Switch::Attributes::NumberOfPositions::Id, "NumberOfPositions"},
+    {Switch::Attributes::CurrentPosition::Id, "CurrentPosition"},
+    {Switch::Attributes::MultiPressMax::Id, "MultiPressMax"},
+};
+
+static const element_descriptor_t Switch_events[] = {
+    {Switch::Events::SwitchLatched::Id, "SwitchLatched"},
+    {Switch::Events::InitialPress::Id, "InitialPress"},
+    {Switch::Events::LongPress::Id, "LongPress"},
+    {Switch::Events::ShortRelease::Id, "ShortRelease"},
+    {Switch::Events::LongRelease::Id, "LongRelease"},
+    {Switch::Events::MultiPressOngoing::Id, "MultiPressOngoing"},
+    {Switch::Events::MultiPressComplete::Id, "MultiPressComplete"},
+};
+
+static const element_descriptor_t AdministratorCommissioning_attributes[] = {
+    {AdministratorCommissioning::Attributes::WindowStatus::Id, "WindowStatus"},
+    {AdministratorCommissioning::Attributes::AdminFabricIndex::Id, "AdminFabricIndex"},
+    {AdministratorCommissioning::Attributes::AdminVendorId::Id, "AdminVendorId"},
+};
+
+static const element_descriptor_t OperationalCredentials_attributes[] = {
+    {OperationalCredentials::Attributes::NOCs::Id, "NOCs"},
+    {OperationalCredentials::Attributes::Fabrics::Id, "Fabrics"},
+    {OperationalCredentials::Attributes::SupportedFabrics::Id, "SupportedFabrics"},
+    {OperationalCredentials::Attributes::CommissionedFabrics::Id, "CommissionedFabrics"},
+    {OperationalCredentials::Attributes::TrustedRootCertificates::Id, "TrustedRootCertificates"},
+    {OperationalCredentials::Attributes::CurrentFabricIndex::Id, "CurrentFabricIndex"},
+};
+
+static const element_descriptor_t OperationalCredentials_commands[] = {
+    {OperationalCredentials::Commands::AttestationResponse::Id, "AttestationResponse"},
+    {OperationalCredentials::Commands::CertificateChainResponse::Id, "CertificateChainResponse"},
+    {OperationalCredentials::Commands::CSRResponse::Id, "CSRResponse"},
+    {OperationalCredentials::Commands::NOCResponse::Id, "NOCResponse"},
+};
+
+static const element_descriptor_t GroupKeyManagement_attributes[] = {
+    {GroupKeyManagement::Attributes::GroupKeyMap::Id, "GroupKeyMap"},
+    {GroupKeyManagement::Attributes::GroupTable::Id, "GroupTable"},
+    {GroupKeyManagement::Attributes::MaxGroupsPerFabric::Id, "MaxGroupsPerFabric"},
+    {GroupKeyManagement::Attributes::MaxGroupKeysPerFabric::Id, "MaxGroupKeysPerFabric"},
+};
+
+static const element_descriptor_t GroupKeyManagement_commands[] = {
+    {GroupKeyManagement::Commands::KeySetReadResponse::Id, "KeySetReadResponse"},
+    {GroupKeyManagement::Commands::KeySetReadAllIndicesResponse::Id, "KeySetReadAllIndicesResponse"},
+};
+
+static const element_descriptor_t FixedLabel_attributes[] = {
+    {FixedLabel::Attributes::LabelList::Id, "LabelList"},
+};
+
+static const element_descriptor_t UserLabel_attributes[] = {
+    {UserLabel::Attributes::LabelList::Id, "LabelList"},
+};
+
+static const element_descriptor_t BooleanState_attributes[] = {
+    {BooleanState::Attributes::StateValue::Id, "StateValue"},
+};
+
+static const element_descriptor_t BooleanState_events[] = {
+    {BooleanState::Events::StateChange::Id, "StateChange"},
+};
+
+static const element_descriptor_t IcdManagement_attributes[] = {
+    {IcdManagement::Attributes::IdleModeDuration::Id, "IdleModeDuration"},
+    {IcdManagement::Attributes::ActiveModeDuration::Id, "ActiveModeDuration"},
+    {IcdManagement::Attributes::ActiveModeThreshold::Id, "ActiveModeThreshold"},
+    {IcdManagement::Attributes::RegisteredClients::Id, "RegisteredClients"},
+    {IcdManagement::Attributes::ICDCounter::Id, "ICDCounter"},
+    {IcdManagement::Attributes::ClientsSupportedPerFabric::Id, "ClientsSupportedPerFabric"},
+    {IcdManagement::Attributes::UserActiveModeTriggerHint::Id, "UserActiveModeTriggerHint"},
+    {IcdManagement::Attributes::UserActiveModeTriggerInstruction::Id, "UserActiveModeTriggerInstruction"},
+};
+
+static const element_descriptor_t IcdManagement_commands[] = {
+    {IcdManagement::Commands::RegisterClientResponse::Id, "RegisterClientResponse"},
+    {IcdManagement::Commands::StayActiveResponse::Id, "StayActiveResponse"},
+};
+
+static const element_descriptor_t Timer_attributes[] = {
+    {Timer::Attributes::SetTime::Id, "SetTime"},
+    {Timer::Attributes::TimeRemaining::Id, "TimeRemaining"},
+    {Timer::Attributes::TimerState::Id, "TimerState"},
+};
+
+static const element_descriptor_t OvenCavityOperationalState_attributes[] = {
+    {OvenCavityOperationalState::Attributes::PhaseList::Id, "PhaseList"},
+    {OvenCavityOperationalState::Attributes::CurrentPhase::Id, "CurrentPhase"},
+    {OvenCavityOperationalState::Attributes::CountdownTime::Id, "CountdownTime"},
+    {OvenCavityOperationalState::Attributes::OperationalStateList::Id, "OperationalStateList"},
+    {OvenCavityOperationalState::Attributes::OperationalState::Id, "OperationalState"},
+    {OvenCavityOperationalState::Attributes::OperationalError::Id, "OperationalError"},
+};
+
+static const element_descriptor_t OvenCavityOperationalState_commands[] = {
+    {OvenCavityOperationalState::Commands::OperationalCommandResponse::Id, "OperationalCommandResponse"},
+};
+
+static const element_descriptor_t OvenCavityOperationalState_events[] = {
+    {OvenCavityOperationalState::Events::OperationalError::Id, "OperationalError"},
+    {OvenCavityOperationalState::Events::OperationCompletion::Id, "OperationCompletion"},
+};
+
+static const element_descriptor_t OvenMode_attributes[] = {
+    {OvenMode::Attributes::SupportedModes::Id, "SupportedModes"},
+    {OvenMode::Attributes::CurrentMode::Id, "CurrentMode"},
+    {OvenMode::Attributes::StartUpMode::Id, "StartUpMode"},
+    {OvenMode::Attributes::OnMode::Id, "OnMode"},
+};
+
+static const element_descriptor_t OvenMode_commands[] = {
+    {OvenMode::Commands::ChangeToModeResponse::Id, "ChangeToModeResponse"},
+};
+
+static const element_descriptor_t LaundryDryerControls_attributes[] = {
+    {LaundryDryerControls::Attributes::SupportedDrynessLevels::Id, "SupportedDrynessLevels"},
+    {LaundryDryerControls::Attributes::SelectedDrynessLevel::Id, "SelectedDrynessLevel"},
+};
+
+static const element_descriptor_t ModeSelect_attributes[] = {
+    {ModeSelect::Attributes::Description::Id, "Description"},
+    {ModeSelect::Attributes::StandardNamespace::Id, "StandardNamespace"},
+    {ModeSelect::Attributes::SupportedModes::Id, "SupportedModes"},
+    {ModeSelect::Attributes::CurrentMode::Id, "CurrentMode"},
+    {ModeSelect::Attributes::StartUpMode::Id, "StartUpMode"},
+    {ModeSelect::Attributes::OnMode::Id, "OnMode"},
+};
+
+static const element_descriptor_t LaundryWasherMode_attributes[] = {
+    {LaundryWasherMode::Attributes::SupportedModes::Id, "SupportedModes"},
+    {LaundryWasherMode::Attributes::CurrentMode::Id, "CurrentMode"},
+    {LaundryWasherMode::Attributes::StartUpMode::Id, "StartUpMode"},
+    {LaundryWasherMode::Attributes::OnMode::Id, "OnMode"},
+};
+
+static const element_descriptor_t LaundryWasherMode_commands[] = {
+    {LaundryWasherMode::Commands::ChangeToModeResponse::Id, "ChangeToModeResponse"},
+};
+
+static const element_descriptor_t RefrigeratorAndTemperatureControlledCabinetMode_attributes[] = {
+    {RefrigeratorAndTemperatureControlledCabinetMode::Attributes::SupportedModes::Id, "SupportedModes"},
+    {RefrigeratorAndTemperatureControlledCabinetMode::Attributes::CurrentMode::Id, "CurrentMode"},
+    {RefrigeratorAndTemperatureControlledCabinetMode::Attributes::StartUpMode::Id, "StartUpMode"},
+    {RefrigeratorAndTemperatureControlledCabinetMode::Attributes::OnMode::Id, "OnMode"},
+};
+
+static const element_descriptor_t RefrigeratorAndTemperatureControlledCabinetMode_commands[] = {
+    {RefrigeratorAndTemperatureControlledCabinetMode::Commands::ChangeToModeResponse::Id, "ChangeToModeResponse"},
+};
+
+static const element_descriptor_t LaundryWasherControls_attributes[] = {
+    {LaundryWasherControls::Attributes::SpinSpeeds::Id, "SpinSpeeds"},
+    {LaundryWasherControls::Attributes::SpinSpeedCurrent::Id, "SpinSpeedCurrent"},
+    {LaundryWasherControls::Attributes::NumberOfRinses::Id, "NumberOfRinses"},
+    {LaundryWasherControls::Attributes::SupportedRinses::Id, "SupportedRinses"},
+};
+
+static const element_descriptor_t RvcRunMode_attributes[] = {
+    {RvcRunMode::Attributes::SupportedModes::Id, "SupportedModes"},
+    {RvcRunMode::Attributes::CurrentMode::Id, "CurrentMode"},
+};
+
+static const element_descriptor_t RvcRunMode_commands[] = {
+    {RvcRunMode::Commands::ChangeToModeResponse::Id, "ChangeToModeResponse"},
+};
+
+static const element_descriptor_t RvcCleanMode_attributes[] = {
+    {RvcCleanMode::Attributes::SupportedModes::Id, "SupportedModes"},
+    {RvcCleanMode::Attributes::CurrentMode::Id, "CurrentMode"},
+};
+
+static const element_descriptor_t RvcCleanMode_commands[] = {
+    {RvcCleanMode::Commands::ChangeToModeResponse::Id, "ChangeToModeResponse"},
+};
+
+static const element_descriptor_t TemperatureControl_attributes[] = {
+    {TemperatureControl::Attributes::TemperatureSetpoint::Id, "TemperatureSetpoint"},
+    {TemperatureControl::Attributes::MinTemperature::Id, "MinTemperature"},
+    {TemperatureControl::Attributes::MaxTemperature::Id, "MaxTemperature"},
+    {TemperatureControl::Attributes::Step::Id, "Step"},
+    {TemperatureControl::Attributes::SelectedTemperatureLevel::Id, "SelectedTemperatureLevel"},
+    {TemperatureControl::Attributes::SupportedTemperatureLevels::Id, "SupportedTemperatureLevels"},
+};
+
+static const element_descriptor_t RefrigeratorAlarm_attributes[] = {
+    {RefrigeratorAlarm::Attributes::Mask::Id, "Mask"},
+    {RefrigeratorAlarm::Attributes::State::Id, "State"},
+    {RefrigeratorAlarm::Attributes::Supported::Id, "Supported"},
+};
+
+static const element_descriptor_t RefrigeratorAlarm_events[] = {
+    {RefrigeratorAlarm::Events::Notify::Id, "Notify"},
+};
+
+static const element_descriptor_t DishwasherMode_attributes[] = {
+    {DishwasherMode::Attributes::SupportedModes::Id, "SupportedModes"},
+    {DishwasherMode::Attributes::CurrentMode::Id, "CurrentMode"},
+    {DishwasherMode::Attributes::StartUpMode::Id, "StartUpMode"},
+    {DishwasherMode::Attributes::OnMode::Id, "OnMode"},
+};
+
+static const element_descriptor_t DishwasherMode_commands[] = {
+    {DishwasherMode::Commands::ChangeToModeResponse::Id, "ChangeToModeResponse"},
+};
+
+static const element_descriptor_t AirQuality_attributes[] = {
+    {AirQuality::Attributes::AirQuality::Id, "AirQuality"},
+};
+
+static const element_descriptor_t SmokeCoAlarm_attributes[] = {
+    {SmokeCoAlarm::Attributes::ExpressedState::Id, "ExpressedState"},
+    {SmokeCoAlarm::Attributes::SmokeState::Id, "SmokeState"},
+    {SmokeCoAlarm::Attributes::COState::Id, "COState"},
+    {SmokeCoAlarm::Attributes::BatteryAlert::Id, "BatteryAlert"},
+    {SmokeCoAlarm::Attributes::DeviceMuted::Id, "DeviceMuted"},
+    {SmokeCoAlarm::Attributes::TestInProgress::Id, "TestInProgress"},
+    {SmokeCoAlarm::Attributes::HardwareFaultAlert::Id, "HardwareFaultAlert"},
+    {SmokeCoAlarm::Attributes::EndOfServiceAlert::Id, "EndOfServiceAlert"},
+    {SmokeCoAlarm::Attributes::InterconnectSmokeAlarm::Id, "InterconnectSmokeAlarm"},
+    {SmokeCoAlarm::Attributes::InterconnectCOAlarm::Id, "InterconnectCOAlarm"},
+    {SmokeCoAlarm::Attributes::ContaminationState::Id, "ContaminationState"},
+    {SmokeCoAlarm::Attributes::SmokeSensitivityLevel::Id, "SmokeSensitivityLevel"},
+    {SmokeCoAlarm::Attributes::ExpiryDate::Id, "ExpiryDate"},
+};
+
+static const element_descriptor_t SmokeCoAlarm_events[] = {
+    {SmokeCoAlarm::Events::SmokeAlarm::Id, "SmokeAlarm"},
+    {SmokeCoAlarm::Events::COAlarm::Id, "COAlarm"},
+    {SmokeCoAlarm::Events::LowBattery::Id, "LowBattery"},
+    {SmokeCoAlarm::Events::HardwareFault::Id, "HardwareFault"},
+    {SmokeCoAlarm::Events::EndOfService::Id, "EndOfService"},
+    {SmokeCoAlarm::Events::SelfTestComplete::Id, "SelfTestComplete"},
+    {SmokeCoAlarm::Events::AlarmMuted::Id, "AlarmMuted"},
+    {SmokeCoAlarm::Events::MuteEnded::Id, "MuteEnded"},
+    {SmokeCoAlarm::Events::InterconnectSmokeAlarm::Id, "InterconnectSmokeAlarm"},
+    {SmokeCoAlarm::Events::InterconnectCOAlarm::Id, "InterconnectCOAlarm"},
+    {SmokeCoAlarm::Events::AllClear::Id, "AllClear"},
+};
+
+static const element_descriptor_t DishwasherAlarm_attributes[] = {
+    {DishwasherAlarm::Attributes::Mask::Id, "Mask"},
+    {DishwasherAlarm::Attributes::Latch::Id, "Latch"},
+    {DishwasherAlarm::Attributes::State::Id, "State"},
+    {DishwasherAlarm::Attributes::Supported::Id, "Supported"},
+};
+
+static const element_descriptor_t DishwasherAlarm_events[] = {
+    {DishwasherAlarm::Events::Notify::Id, "Notify"},
+};
+
+static const element_descriptor_t MicrowaveOvenMode_attributes[] = {
+    {MicrowaveOvenMode::Attributes::SupportedModes::Id, "SupportedModes"},
+    {MicrowaveOvenMode::Attributes::CurrentMode::Id, "CurrentMode"},
+};
+
+static const element_descriptor_t MicrowaveOvenControl_attributes[] = {
+    {MicrowaveOvenControl::Attributes::CookTime::Id, "CookTime"},
+    {MicrowaveOvenControl::Attributes::PowerSetting::Id, "PowerSetting"},
+    {MicrowaveOvenControl::Attributes::MinPower::Id, "MinPower"},
+    {MicrowaveOvenControl::Attributes::MaxPower::Id, "MaxPower"},
+    {MicrowaveOvenControl::Attributes::PowerStep::Id, "PowerStep"},
+};
+
+static const element_descriptor_t OperationalState_attributes[] = {
+    {OperationalState::Attributes::PhaseList::Id, "PhaseList"},
+    {OperationalState::Attributes::CurrentPhase::Id, "CurrentPhase"},
+    {OperationalState::Attributes::CountdownTime::Id, "CountdownTime"},
+    {OperationalState::Attributes::OperationalStateList::Id, "OperationalStateList"},
+    {OperationalState::Attributes::OperationalState::Id, "OperationalState"},
+    {OperationalState::Attributes::OperationalError::Id, "OperationalError"},
+};
+
+static const element_descriptor_t OperationalState_commands[] = {
+    {OperationalState::Commands::OperationalCommandResponse::Id, "OperationalCommandResponse"},
+};
+
+static const element_descriptor_t OperationalState_events[] = {
+    {OperationalState::Events::OperationalError::Id, "OperationalError"},
+    {OperationalState::Events::OperationCompletion::Id, "OperationCompletion"},
+};
+
+static const element_descriptor_t RvcOperationalState_attributes[] = {
+    {RvcOperationalState::Attributes::PhaseList::Id, "PhaseList"},
+    {RvcOperationalState::Attributes::CurrentPhase::Id, "CurrentPhase"},
+    {RvcOperationalState::Attributes::CountdownTime::Id, "CountdownTime"},
+    {RvcOperationalState::Attributes::OperationalStateList::Id, "OperationalStateList"},
+    {RvcOperationalState::Attributes::OperationalState::Id, "OperationalState"},
+    {RvcOperationalState::Attributes::OperationalError::Id, "OperationalError"},
+};
+
+static const element_descriptor_t RvcOperationalState_commands[] = {
+    {RvcOperationalState::Commands::OperationalCommandResponse::Id, "OperationalCommandResponse"},
+};
+
+static const element_descriptor_t RvcOperationalState_events[] = {
+    {RvcOperationalState::Events::OperationalError::Id, "OperationalError"},
+    {RvcOperationalState::Events::OperationCompletion::Id, "OperationCompletion"},
+};
+
+static const element_descriptor_t HepaFilterMonitoring_attributes[] = {
+    {HepaFilterMonitoring::Attributes::Condition::Id, "Condition"},
+    {HepaFilterMonitoring::Attributes::DegradationDirection::Id, "DegradationDirection"},
+    {HepaFilterMonitoring::Attributes::ChangeIndication::Id, "ChangeIndication"},
+    {HepaFilterMonitoring::Attributes::InPlaceIndicator::Id, "InPlaceIndicator"},
+    {HepaFilterMonitoring::Attributes::LastChangedTime::Id, "LastChangedTime"},
+    {HepaFilterMonitoring::Attributes::ReplacementProductList::Id, "ReplacementProductList"},
+};
+
+static const element_descriptor_t ActivatedCarbonFilterMonitoring_attributes[] = {
+    {ActivatedCarbonFilterMonitoring::Attributes::Condition::Id, "Condition"},
+    {ActivatedCarbonFilterMonitoring::Attributes::DegradationDirection::Id, "DegradationDirection"},
+    {ActivatedCarbonFilterMonitoring::Attributes::ChangeIndication::Id, "ChangeIndication"},
+    {ActivatedCarbonFilterMonitoring::Attributes::InPlaceIndicator::Id, "InPlaceIndicator"},
+    {ActivatedCarbonFilterMonitoring::Attributes::LastChangedTime::Id, "LastChangedTime"},
+    {ActivatedCarbonFilterMonitoring::Attributes::ReplacementProductList::Id, "ReplacementProductList"},
+};
+
+static const element_descriptor_t BooleanStateConfiguration_attributes[] = {
+    {BooleanStateConfiguration::Attributes::CurrentSensitivityLevel::Id, "CurrentSensitivityLevel"},
+    {BooleanStateConfiguration::Attributes::SupportedSensitivityLevels::Id, "SupportedSensitivityLevels"},
+    {BooleanStateConfiguration::Attributes::DefaultSensitivityLevel::Id, "DefaultSensitivityLevel"},
+    {BooleanStateConfiguration::Attributes::AlarmsActive::Id, "AlarmsActive"},
+    {BooleanStateConfiguration::Attributes::AlarmsSuppressed::Id, "AlarmsSuppressed"},
+    {BooleanStateConfiguration::Attributes::AlarmsEnabled::Id, "AlarmsEnabled"},
+    {BooleanStateConfiguration::Attributes::AlarmsSupported::Id, "AlarmsSupported"},
+    {BooleanStateConfiguration::Attributes::SensorFault::Id, "SensorFault"},
+};
+
+static const element_descriptor_t BooleanStateConfiguration_events[] = {
+    {BooleanStateConfiguration::Events::AlarmsStateChanged::Id, "AlarmsStateChanged"},
+    {BooleanStateConfiguration::Events::SensorFault::Id, "SensorFault"},
+};
+
+static const element_descriptor_t ValveConfigurationAndControl_attributes[] = {
+    {ValveConfigurationAndControl::Attributes::OpenDuration::Id, "OpenDuration"},
+    {ValveConfigurationAndControl::Attributes::DefaultOpenDuration::Id, "DefaultOpenDuration"},
+    {ValveConfigurationAndControl::Attributes::AutoCloseTime::Id, "AutoCloseTime"},
+    {ValveConfigurationAndControl::Attributes::RemainingDuration::Id, "RemainingDuration"},
+    {ValveConfigurationAndControl::Attributes::CurrentState::Id, "CurrentState"},
+    {ValveConfigurationAndControl::Attributes::TargetState::Id, "TargetState"},
+    {ValveConfigurationAndControl::Attributes::CurrentLevel::Id, "CurrentLevel"},
+    {ValveConfigurationAndControl::Attributes::TargetLevel::Id, "TargetLevel"},
+    {ValveConfigurationAndControl::Attributes::DefaultOpenLevel::Id, "DefaultOpenLevel"},
+    {ValveConfigurationAndControl::Attributes::ValveFault::Id, "ValveFault"},
+};
+
+static const element_descriptor_t ValveConfigurationAndControl_events[] = {
+    {ValveConfigurationAndControl::Events::ValveStateChanged::Id, "ValveStateChanged"},
+    {ValveConfigurationAndControl::Events::ValveFault::Id, "ValveFault"},
+};
+
+static const element_descriptor_t ElectricalEnergyMeasurement_attributes[] = {
+    {ElectricalEnergyMeasurement::Attributes::Accuracy::Id, "Accuracy"},
+    {ElectricalEnergyMeasurement::Attributes::CumulativeEnergyImported::Id, "CumulativeEnergyImported"},
+    {ElectricalEnergyMeasurement::Attributes::CumulativeEnergyExported::Id, "CumulativeEnergyExported"},
+    {ElectricalEnergyMeasurement::Attributes::PeriodicEnergyImported::Id, "PeriodicEnergyImported"},
+    {ElectricalEnergyMeasurement::Attributes::PeriodicEnergyExported::Id, "PeriodicEnergyExported"},
+};
+
+static const element_descriptor_t ElectricalEnergyMeasurement_events[] = {
+    {ElectricalEnergyMeasurement::Events::CumulativeEnergyMeasured::Id, "CumulativeEnergyMeasured"},
+    {ElectricalEnergyMeasurement::Events::PeriodicEnergyMeasured::Id, "PeriodicEnergyMeasured"},
+};
+
+static const element_descriptor_t DemandResponseLoadControl_attributes[] = {
+    {DemandResponseLoadControl::Attributes::LoadControlPrograms::Id, "LoadControlPrograms"},
+    {DemandResponseLoadControl::Attributes::NumberOfLoadControlPrograms::Id, "NumberOfLoadControlPrograms"},
+    {DemandResponseLoadControl::Attributes::Events::Id, "Events"},
+    {DemandResponseLoadControl::Attributes::ActiveEvents::Id, "ActiveEvents"},
+    {DemandResponseLoadControl::Attributes::NumberOfEventsPerProgram::Id, "NumberOfEventsPerProgram"},
+    {DemandResponseLoadControl::Attributes::NumberOfTransitions::Id, "NumberOfTransitions"},
+    {DemandResponseLoadControl::Attributes::DefaultRandomStart::Id, "DefaultRandomStart"},
+    {DemandResponseLoadControl::Attributes::DefaultRandomDuration::Id, "DefaultRandomDuration"},
+};
+
+static const element_descriptor_t DemandResponseLoadControl_events[] = {
+    {DemandResponseLoadControl::Events::LoadControlEventStatusChange::Id, "LoadControlEventStatusChange"},
+};
+
+static const element_descriptor_t DeviceEnergyManagement_attributes[] = {
+    {DeviceEnergyManagement::Attributes::ESAType::Id, "ESAType"},
+    {DeviceEnergyManagement::Attributes::ESACanGenerate::Id, "ESACanGenerate"},
+    {DeviceEnergyManagement::Attributes::ESAState::Id, "ESAState"},
+    {DeviceEnergyManagement::Attributes::AbsMinPower::Id, "AbsMinPower"},
+    {DeviceEnergyManagement::Attributes::AbsMaxPower::Id, "AbsMaxPower"},
+    {DeviceEnergyManagement::Attributes::PowerAdjustmentCapability::Id, "PowerAdjustmentCapability"},
+    {DeviceEnergyManagement::Attributes::Forecast::Id, "Forecast"},
+};
+
+static const element_descriptor_t DeviceEnergyManagement_events[] = {
+    {DeviceEnergyManagement::Events::PowerAdjustStart::Id, "PowerAdjustStart"},
+    {DeviceEnergyManagement::Events::PowerAdjustEnd::Id, "PowerAdjustEnd"},
+    {DeviceEnergyManagement::Events::Paused::Id, "Paused"},
+    {DeviceEnergyManagement::Events::Resumed::Id, "Resumed"},
+};
+
+static const element_descriptor_t EnergyEvse_attributes[] = {
+    {EnergyEvse::Attributes::State::Id, "State"},
+    {EnergyEvse::Attributes::SupplyState::Id, "SupplyState"},
+    {EnergyEvse::Attributes::FaultState::Id, "FaultState"},
+    {EnergyEvse::Attributes::ChargingEnabledUntil::Id, "ChargingEnabledUntil"},
+    {EnergyEvse::Attributes::DischargingEnabledUntil::Id, "DischargingEnabledUntil"},
+    {EnergyEvse::Attributes::CircuitCapacity::Id, "CircuitCapacity"},
+    {EnergyEvse::Attributes::MinimumChargeCurrent::Id, "MinimumChargeCurrent"},
+    {EnergyEvse::Attributes::MaximumChargeCurrent::Id, "MaximumChargeCurrent"},
+    {EnergyEvse::Attributes::MaximumDischargeCurrent::Id, "MaximumDischargeCurrent"},
+    {EnergyEvse::Attributes::UserMaximumChargeCurrent::Id, "UserMaximumChargeCurrent"},
+    {EnergyEvse::Attributes::RandomizationDelayWindow::Id, "RandomizationDelayWindow"},
+    {EnergyEvse::Attributes::NextChargeStartTime::Id, "NextChargeStartTime"},
+    {EnergyEvse::Attributes::NextChargeTargetTime::Id, "NextChargeTargetTime"},
+    {EnergyEvse::Attributes::NextChargeRequiredEnergy::Id, "NextChargeRequiredEnergy"},
+    {EnergyEvse::Attributes::NextChargeTargetSoC::Id, "NextChargeTargetSoC"},
+    {EnergyEvse::Attributes::ApproximateEVEfficiency::Id, "ApproximateEVEfficiency"},
+    {EnergyEvse::Attributes::StateOfCharge::Id, "StateOfCharge"},
+    {EnergyEvse::Attributes::BatteryCapacity::Id, "BatteryCapacity"},
+    {EnergyEvse::Attributes::VehicleID::Id, "VehicleID"},
+    {EnergyEvse::Attributes::SessionID::Id, "SessionID"},
+    {EnergyEvse::Attributes::SessionDuration::Id, "SessionDuration"},
+    {EnergyEvse::Attributes::SessionEnergyCharged::Id, "SessionEnergyCharged"},
+    {EnergyEvse::Attributes::SessionEnergyDischarged::Id, "SessionEnergyDischarged"},
+};
+
+static const element_descriptor_t EnergyEvse_commands[] = {
+    {EnergyEvse::Commands::GetTargetsResponse::Id, "GetTargetsResponse"},
+};
+
+static const element_descriptor_t EnergyEvse_events[] = {
+    {EnergyEvse::Events::EVConnected::Id, "EVConnected"},
+    {EnergyEvse::Events::EVNotDetected::Id, "EVNotDetected"},
+    {EnergyEvse::Events::EnergyTransferStarted::Id, "EnergyTransferStarted"},
+    {EnergyEvse::Events::EnergyTransferStopped::Id, "EnergyTransferStopped"},
+    {EnergyEvse::Events::Fault::Id, "Fault"},
+    {EnergyEvse::Events::Rfid::Id, "Rfid"},
+};
+
+static const element_descriptor_t EnergyPreference_attributes[] = {
+    {EnergyPreference::Attributes::EnergyBalances::Id, "EnergyBalances"},
+    {EnergyPreference::Attributes::CurrentEnergyBalance::Id, "CurrentEnergyBalance"},
+    {EnergyPreference::Attributes::EnergyPriorities::Id, "EnergyPriorities"},
+    {EnergyPreference::Attributes::LowPowerModeSensitivities::Id, "LowPowerModeSensitivities"},
+    {EnergyPreference::Attributes::CurrentLowPowerModeSensitivity::Id, "CurrentLowPowerModeSensitivity"},
+};
+
+static const element_descriptor_t DoorLock_attributes[] = {
+    {DoorLock::Attributes::LockState::Id, "LockState"},
+    {DoorLock::Attributes::LockType::Id, "LockType"},
+    {DoorLock::Attributes::ActuatorEnabled::Id, "ActuatorEnabled"},
+    {DoorLock::Attributes::DoorState::Id, "DoorState"},
+    {DoorLock::Attributes::DoorOpenEvents::Id, "DoorOpenEvents"},
+    {DoorLock::Attributes::DoorClosedEvents::Id, "DoorClosedEvents"},
+    {DoorLock::Attributes::OpenPeriod::Id, "OpenPeriod"},
+    {DoorLock::Attributes::NumberOfTotalUsersSupported::Id, "NumberOfTotalUsersSupported"},
+    {DoorLock::Attributes::NumberOfPINUsersSupported::Id, "NumberOfPINUsersSupported"},
+    {DoorLock::Attributes::NumberOfRFIDUsersSupported::Id, "NumberOfRFIDUsersSupported"},
+    {DoorLock::Attributes::NumberOfWeekDaySchedulesSupportedPerUser::Id, "NumberOfWeekDaySchedulesSupportedPerUser"},
+    {DoorLock::Attributes::NumberOfYearDaySchedulesSupportedPerUser::Id, "NumberOfYearDaySchedulesSupportedPerUser"},
+    {DoorLock::Attributes::NumberOfHolidaySchedulesSupported::Id, "NumberOfHolidaySchedulesSupported"},
+    {DoorLock::Attributes::MaxPINCodeLength::Id, "MaxPINCodeLength"},
+    {DoorLock::Attributes::MinPINCodeLength::Id, "MinPINCodeLength"},
+    {DoorLock::Attributes::MaxRFIDCodeLength::Id, "MaxRFIDCodeLength"},
+    {DoorLock::Attributes::MinRFIDCodeLength::Id, "MinRFIDCodeLength"},
+    {DoorLock::Attributes::CredentialRulesSupport::Id, "CredentialRulesSupport"},
+    {DoorLock::Attributes::NumberOfCredentialsSupportedPerUser::Id, "NumberOfCredentialsSupportedPerUser"},
+    {DoorLock::Attributes::Language::Id, "Language"},
+    {DoorLock::Attributes::LEDSettings::Id, "LEDSettings"},
+    {DoorLock::Attributes::AutoRelockTime::Id, "AutoRelockTime"},
+    {DoorLock::Attributes::SoundVolume::Id, "SoundVolume"},
+    {DoorLock::Attributes::OperatingMode::Id, "OperatingMode"},
+    {DoorLock::Attributes::SupportedOperatingModes::Id, "SupportedOperatingModes"},
+    {DoorLock::Attributes::DefaultConfigurationRegister::Id, "DefaultConfigurationRegister"},
+    {DoorLock::Attributes::EnableLocalProgramming::Id, "EnableLocalProgramming"},
+    {DoorLock::Attributes::EnableOneTouchLocking::Id, "EnableOneTouchLocking"},
+    {DoorLock::Attributes::EnableInsideStatusLED::Id, "EnableInsideStatusLED"},
+    {DoorLock::Attributes::EnablePrivacyModeButton::Id, "EnablePrivacyModeButton"},
+    {DoorLock::Attributes::LocalProgrammingFeatures::Id, "LocalProgrammingFeatures"},
+    {DoorLock::Attributes::WrongCodeEntryLimit::Id, "WrongCodeEntryLimit"},
+    {DoorLock::Attributes::UserCodeTemporaryDisableTime::Id, "UserCodeTemporaryDisableTime"},
+    {DoorLock::Attributes::SendPINOverTheAir::Id, "SendPINOverTheAir"},
+    {DoorLock::Attributes::RequirePINforRemoteOperation::Id, "RequirePINforRemoteOperation"},
+    {DoorLock::Attributes::ExpiringUserTimeout::Id, "ExpiringUserTimeout"},
+};
+
+static const element_descriptor_t DoorLock_commands[] = {
+    {DoorLock::Commands::GetWeekDayScheduleResponse::Id, "GetWeekDayScheduleResponse"},
+    {DoorLock::Commands::GetYearDayScheduleResponse::Id, "GetYearDayScheduleResponse"},
+    {DoorLock::Commands::GetHolidayScheduleResponse::Id, "GetHolidayScheduleResponse"},
+    {DoorLock::Commands::GetUserResponse::Id, "GetUserResponse"},
+    {DoorLock::Commands::SetCredentialResponse::Id, "SetCredentialResponse"},
+    {DoorLock::Commands::GetCredentialStatusResponse::Id, "GetCredentialStatusResponse"},
+};
+
+static const element_descriptor_t DoorLock_events[] = {
+    {DoorLock::Events::DoorLockAlarm::Id, "DoorLockAlarm"},
+    {DoorLock::Events::DoorStateChange::Id, "DoorStateChange"},
+    {DoorLock::Events::LockOperation::Id, "LockOperation"},
+    {DoorLock::Events::LockOperationError::Id, "LockOperationError"},
+    {DoorLock::Events::LockUserChange::Id, "LockUserChange"},
+};
+
+static const element_descriptor_t WindowCovering_attributes[] = {
+    {WindowCovering::Attributes::Type::Id, "Type"},
+    {WindowCovering::Attributes::PhysicalClosedLimitLift::Id, "PhysicalClosedLimitLift"},
+    {WindowCovering::Attributes::PhysicalClosedLimitTilt::Id, "PhysicalClosedLimitTilt"},
+    {WindowCovering::Attributes::CurrentPositionLift::Id, "CurrentPositionLift"},
+    {WindowCovering::Attributes::CurrentPositionTilt::Id, "CurrentPositionTilt"},
+    {WindowCovering::Attributes::NumberOfActuationsLift::Id, "NumberOfActuationsLift"},
+    {WindowCovering::Attributes::NumberOfActuationsTilt::Id, "NumberOfActuationsTilt"},
+    {WindowCovering::Attributes::ConfigStatus::Id, "ConfigStatus"},
+    {WindowCovering::Attributes::CurrentPositionLiftPercentage::Id, "CurrentPositionLiftPercentage"},
+    {WindowCovering::Attributes::CurrentPositionTiltPercentage::Id, "CurrentPositionTiltPercentage"},
+    {WindowCovering::Attributes::OperationalStatus::Id, "OperationalStatus"},
+    {WindowCovering::Attributes::TargetPositionLiftPercent100ths::Id, "TargetPositionLiftPercent100ths"},
+    {WindowCovering::Attributes::TargetPositionTiltPercent100ths::Id, "TargetPositionTiltPercent100ths"},
+    {WindowCovering::Attributes::EndProductType::Id, "EndProductType"},
+    {WindowCovering::Attributes::CurrentPositionLiftPercent100ths::Id, "CurrentPositionLiftPercent100ths"},
+    {WindowCovering::Attributes::CurrentPositionTiltPercent100ths::Id, "CurrentPositionTiltPercent100ths"},
+    {WindowCovering::Attributes::InstalledOpenLimitLift::Id, "InstalledOpenLimitLift"},
+    {WindowCovering::Attributes::InstalledClosedLimitLift::Id, "InstalledClosedLimitLift"},
+    {WindowCovering::Attributes::InstalledOpenLimitTilt::Id, "InstalledOpenLimitTilt"},
+    {WindowCovering::Attributes::InstalledClosedLimitTilt::Id, "InstalledClosedLimitTilt"},
+    {WindowCovering::Attributes::Mode::Id, "Mode"},
+    {WindowCovering::Attributes::SafetyStatus::Id, "SafetyStatus"},
+};
+
+static const element_descriptor_t BarrierControl_attributes[] = {
+    {BarrierControl::Attributes::BarrierMovingState::Id, "BarrierMovingState"},
+    {BarrierControl::Attributes::BarrierSafetyStatus::Id, "BarrierSafetyStatus"},
+    {BarrierControl::Attributes::BarrierCapabilities::Id, "BarrierCapabilities"},
+    {BarrierControl::Attributes::BarrierOpenEvents::Id, "BarrierOpenEvents"},
+    {BarrierControl::Attributes::BarrierCloseEvents::Id, "BarrierCloseEvents"},
+    {BarrierControl::Attributes::BarrierCommandOpenEvents::Id, "BarrierCommandOpenEvents"},
+    {BarrierControl::Attributes::BarrierCommandCloseEvents::Id, "BarrierCommandCloseEvents"},
+    {BarrierControl::Attributes::BarrierOpenPeriod::Id, "BarrierOpenPeriod"},
+    {BarrierControl::Attributes::BarrierClosePeriod::Id, "BarrierClosePeriod"},
+    {BarrierControl::Attributes::BarrierPosition::Id, "BarrierPosition"},
+};
+
+static const element_descriptor_t PumpConfigurationAndControl_attributes[] = {
+    {PumpConfigurationAndControl::Attributes::MaxPressure::Id, "MaxPressure"},
+    {PumpConfigurationAndControl::Attributes::MaxSpeed::Id, "MaxSpeed"},
+    {PumpConfigurationAndControl::Attributes::MaxFlow::Id, "MaxFlow"},
+    {PumpConfigurationAndControl::Attributes::MinConstPressure::Id, "MinConstPressure"},
+    {PumpConfigurationAndControl::Attributes::MaxConstPressure::Id, "MaxConstPressure"},
+    {PumpConfigurationAndControl::Attributes::MinCompPressure::Id, "MinCompPressure"},
+    {PumpConfigurationAndControl::Attributes::MaxCompPressure::Id, "MaxCompPressure"},
+    {PumpConfigurationAndControl::Attributes::MinConstSpeed::Id, "MinConstSpeed"},
+    {PumpConfigurationAndControl::Attributes::MaxConstSpeed::Id, "MaxConstSpeed"},
+    {PumpConfigurationAndControl::Attributes::MinConstFlow::Id, "MinConstFlow"},
+    {PumpConfigurationAndControl::Attributes::MaxConstFlow::Id, "MaxConstFlow"},
+    {PumpConfigurationAndControl::Attributes::MinConstTemp::Id, "MinConstTemp"},
+    {PumpConfigurationAndControl::Attributes::MaxConstTemp::Id, "MaxConstTemp"},
+    {PumpConfigurationAndControl::Attributes::PumpStatus::Id, "PumpStatus"},
+    {PumpConfigurationAndControl::Attributes::EffectiveOperationMode::Id, "EffectiveOperationMode"},
+    {PumpConfigurationAndControl::Attributes::EffectiveControlMode::Id, "EffectiveControlMode"},
+    {PumpConfigurationAndControl::Attributes::Capacity::Id, "Capacity"},
+    {PumpConfigurationAndControl::Attributes::Speed::Id, "Speed"},
+    {PumpConfigurationAndControl::Attributes::LifetimeRunningHours::Id, "LifetimeRunningHours"},
+    {PumpConfigurationAndControl::Attributes::Power::Id, "Power"},
+    {PumpConfigurationAndControl::Attributes::LifetimeEnergyConsumed::Id, "LifetimeEnergyConsumed"},
+    {PumpConfigurationAndControl::Attributes::OperationMode::Id, "OperationMode"},
+    {PumpConfigurationAndControl::Attributes::ControlMode::Id, "ControlMode"},
+};
+
+static const element_descriptor_t PumpConfigurationAndControl_events[] = {
+    {PumpConfigurationAndControl::Events::SupplyVoltageLow::Id, "SupplyVoltageLow"},
+    {PumpConfigurationAndControl::Events::SupplyVoltageHigh::Id, "SupplyVoltageHigh"},
+    {PumpConfigurationAndControl::Events::PowerMissingPhase::Id, "PowerMissingPhase"},
+    {PumpConfigurationAndControl::Events::SystemPressureLow::Id, "SystemPressureLow"},
+    {PumpConfigurationAndControl::Events::SystemPressureHigh::Id, "SystemPressureHigh"},
+    {PumpConfigurationAndControl::Events::DryRunning::Id, "DryRunning"},
+    {PumpConfigurationAndControl::Events::MotorTemperatureHigh::Id, "MotorTemperatureHigh"},
+    {PumpConfigurationAndControl::Events::PumpMotorFatalFailure::Id, "PumpMotorFatalFailure"},
+    {PumpConfigurationAndControl::Events::ElectronicTemperatureHigh::Id, "ElectronicTemperatureHigh"},
+    {PumpConfigurationAndControl::Events::PumpBlocked::Id, "PumpBlocked"},
+    {PumpConfigurationAndControl::Events::SensorFailure::Id, "SensorFailure"},
+    {PumpConfigurationAndControl::Events::ElectronicNonFatalFailure::Id, "ElectronicNonFatalFailure"},
+    {PumpConfigurationAndControl::Events::ElectronicFatalFailure::Id, "ElectronicFatalFailure"},
+    {PumpConfigurationAndControl::Events::GeneralFault::Id, "GeneralFault"},
+    {PumpConfigurationAndControl::Events::Leakage::Id, "Leakage"},
+    {PumpConfigurationAndControl::Events::AirDetection::Id, "AirDetection"},
+    {PumpConfigurationAndControl::Events::TurbineOperation::Id, "TurbineOperation"},
+};
+
+static const element_descriptor_t Thermostat_attributes[] = {
+    {Thermostat::Attributes::LocalTemperature::Id, "LocalTemperature"},
+    {Thermostat::Attributes::OutdoorTemperature::Id, "OutdoorTemperature"},
+    {Thermostat::Attributes::Occupancy::Id, "Occupancy"},
+    {Thermostat::Attributes::AbsMinHeatSetpointLimit::Id, "AbsMinHeatSetpointLimit"},
+    {Thermostat::Attributes::AbsMaxHeatSetpointLimit::Id, "AbsMaxHeatSetpointLimit"},
+    {Thermostat::Attributes::AbsMinCoolSetpointLimit::Id, "AbsMinCoolSetpointLimit"},
+    {Thermostat::Attributes::AbsMaxCoolSetpointLimit::Id, "AbsMaxCoolSetpointLimit"},
+    {Thermostat::Attributes::PICoolingDemand::Id, "PICoolingDemand"},
+    {Thermostat::Attributes::PIHeatingDemand::Id, "PIHeatingDemand"},
+    {Thermostat::Attributes::HVACSystemTypeConfiguration::Id, "HVACSystemTypeConfiguration"},
+    {Thermostat::Attributes::LocalTemperatureCalibration::Id, "LocalTemperatureCalibration"},
+    {Thermostat::Attributes::OccupiedCoolingSetpoint::Id, "OccupiedCoolingSetpoint"},
+    {Thermostat::Attributes::OccupiedHeatingSetpoint::Id, "OccupiedHeatingSetpoint"},
+    {Thermostat::Attributes::UnoccupiedCoolingSetpoint::Id, "UnoccupiedCoolingSetpoint"},
+    {Thermostat::Attributes::UnoccupiedHeatingSetpoint::Id, "UnoccupiedHeatingSetpoint"},
+    {Thermostat::Attributes::MinHeatSetpointLimit::Id, "MinHeatSetpointLimit"},
+    {Thermostat::Attributes::MaxHeatSetpointLimit::Id, "MaxHeatSetpointLimit"},
+    {Thermostat::Attributes::MinCoolSetpointLimit::Id, "MinCoolSetpointLimit"},
+    {Thermostat::Attributes::MaxCoolSetpointLimit::Id, "MaxCoolSetpointLimit"},
+    {Thermostat::Attributes::MinSetpointDeadBand::Id, "MinSetpointDeadBand"},
+    {Thermostat::Attributes::RemoteSensing::Id, "RemoteSensing"},
+    {Thermostat::Attributes::ControlSequenceOfOperation::Id, "ControlSequenceOfOperation"},
+    {Thermostat::Attributes::SystemMode::Id, "SystemMode"},
+    {Thermostat::Attributes::ThermostatRunningMode::Id, "ThermostatRunningMode"},
+    {Thermostat::Attributes::StartOfWeek::Id, "StartOfWeek"},
+    {Thermostat::Attributes::NumberOfWeeklyTransitions::Id, "NumberOfWeeklyTransitions"},
+    {Thermostat::Attributes::NumberOfDailyTransitions::Id, "NumberOfDailyTransitions"},
+    {Thermostat::Attributes::TemperatureSetpointHold::Id, "TemperatureSetpointHold"},
+    {Thermostat::Attributes::TemperatureSetpointHoldDuration::Id, "TemperatureSetpointHoldDuration"},
+    {Thermostat::Attributes::ThermostatProgrammingOperationMode::Id, "ThermostatProgrammingOperationMode"},
+    {Thermostat::Attributes::ThermostatRunningState::Id, "ThermostatRunningState"},
+    {Thermostat::Attributes::SetpointChangeSource::Id, "SetpointChangeSource"},
+    {Thermostat::Attributes::SetpointChangeAmount::Id, "SetpointChangeAmount"},
+    {Thermostat::Attributes::SetpointChangeSourceTimestamp::Id, "SetpointChangeSourceTimestamp"},
+    {Thermostat::Attributes::OccupiedSetback::Id, "OccupiedSetback"},
+    {Thermostat::Attributes::OccupiedSetbackMin::Id, "OccupiedSetbackMin"},
+    {Thermostat::Attributes::OccupiedSetbackMax::Id, "OccupiedSetbackMax"},
+    {Thermostat::Attributes::UnoccupiedSetback::Id, "UnoccupiedSetback"},
+    {Thermostat::Attributes::UnoccupiedSetbackMin::Id, "UnoccupiedSetbackMin"},
+    {Thermostat::Attributes::UnoccupiedSetbackMax::Id, "UnoccupiedSetbackMax"},
+    {Thermostat::Attributes::EmergencyHeatDelta::Id, "EmergencyHeatDelta"},
+    {Thermostat::Attributes::ACType::Id, "ACType"},
+    {Thermostat::Attributes::ACCapacity::Id, "ACCapacity"},
+    {Thermostat::Attributes::ACRefrigerantType::Id, "ACRefrigerantType"},
+    {Thermostat::Attributes::ACCompressorType::Id, "ACCompressorType"},
+    {Thermostat::Attributes::ACErrorCode::Id, "ACErrorCode"},
+    {Thermostat::Attributes::ACLouverPosition::Id, "ACLouverPosition"},
+    {Thermostat::Attributes::ACCoilTemperature::Id, "ACCoilTemperature"},
+    {Thermostat::Attributes::ACCapacityformat::Id, "ACCapacityformat"},
+};
+
+static const element_descriptor_t Thermostat_commands[] = {
+    {Thermostat::Commands::GetWeeklyScheduleResponse::Id, "GetWeeklyScheduleResponse"},
+};
+
+static const element_descriptor_t FanControl_attributes[] = {
+    {FanControl::Attributes::FanMode::Id, "FanMode"},
+    {FanControl::Attributes::FanModeSequence::Id, "FanModeSequence"},
+    {FanControl::Attributes::PercentSetting::Id, "PercentSetting"},
+    {FanControl::Attributes::PercentCurrent::Id, "PercentCurrent"},
+    {FanControl::Attributes::SpeedMax::Id, "SpeedMax"},
+    {FanControl::Attributes::SpeedSetting::Id, "SpeedSetting"},
+    {FanControl::Attributes::SpeedCurrent::Id, "SpeedCurrent"},
+    {FanControl::Attributes::RockSupport::Id, "RockSupport"},
+    {FanControl::Attributes::RockSetting::Id, "RockSetting"},
+    {FanControl::Attributes::WindSupport::Id, "WindSupport"},
+    {FanControl::Attributes::WindSetting::Id, "WindSetting"},
+    {FanControl::Attributes::AirflowDirection::Id, "AirflowDirection"},
+};
+
+static const element_descriptor_t ThermostatUserInterfaceConfiguration_attributes[] = {
+    {ThermostatUserInterfaceConfiguration::Attributes::TemperatureDisplayMode::Id, "TemperatureDisplayMode"},
+    {ThermostatUserInterfaceConfiguration::Attributes::KeypadLockout::Id, "KeypadLockout"},
+    {ThermostatUserInterfaceConfiguration::Attributes::ScheduleProgrammingVisibility::Id, "ScheduleProgrammingVisibility"},
+};
+
+static const element_descriptor_t ColorControl_attributes[] = {
+    {ColorControl::Attributes::CurrentHue::Id, "CurrentHue"},
+    {ColorControl::Attributes::CurrentSaturation::Id, "CurrentSaturation"},
+    {ColorControl::Attributes::RemainingTime::Id, "RemainingTime"},
+    {ColorControl::Attributes::CurrentX::Id, "CurrentX"},
+    {ColorControl::Attributes::CurrentY::Id, "CurrentY"},
+    {ColorControl::Attributes::DriftCompensation::Id, "DriftCompensation"},
+    {ColorControl::Attributes::CompensationText::Id, "CompensationText"},
+    {ColorControl::Attributes::ColorTemperatureMireds::Id, "ColorTemperatureMireds"},
+    {ColorControl::Attributes::ColorMode::Id, "ColorMode"},
+    {ColorControl::Attributes::Options::Id, "Options"},
+    {ColorControl::Attributes::NumberOfPrimaries::Id, "NumberOfPrimaries"},
+    {ColorControl::Attributes::Primary1X::Id, "Primary1X"},
+    {ColorControl::Attributes::Primary1Y::Id, "Primary1Y"},
+    {ColorControl::Attributes::Primary1Intensity::Id, "Primary1Intensity"},
+    {ColorControl::Attributes::Primary2X::Id, "Primary2X"},
+    {ColorControl::Attributes::Primary2Y::Id, "Primary2Y"},
+    {ColorControl::Attributes::Primary2Intensity::Id, "Primary2Intensity"},
+    {ColorControl::Attributes::Primary3X::Id, "Primary3X"},
+    {ColorControl::Attributes::Primary3Y::Id, "Primary3Y"},
+    {ColorControl::Attributes::Primary3Intensity::Id, "Primary3Intensity"},
+    {ColorControl::Attributes::Primary4X::Id, "Primary4X"},
+    {ColorControl::Attributes::Primary4Y::Id, "Primary4Y"},
+    {ColorControl::Attributes::Primary4Intensity::Id, "Primary4Intensity"},
+    {ColorControl::Attributes::Primary5X::Id, "Primary5X"},
+    {ColorControl::Attributes::Primary5Y::Id, "Primary5Y"},
+    {ColorControl::Attributes::Primary5Intensity::Id, "Primary5Intensity"},
+    {ColorControl::Attributes::Primary6X::Id, "Primary6X"},
+    {ColorControl::Attributes::Primary6Y::Id, "Primary6Y"},
+    {ColorControl::Attributes::Primary6Intensity::Id, "Primary6Intensity"},
+    {ColorControl::Attributes::WhitePointX::Id, "WhitePointX"},
+    {ColorControl::Attributes::WhitePointY::Id, "WhitePointY"},
+    {ColorControl::Attributes::ColorPointRX::Id, "ColorPointRX"},
+    {ColorControl::Attributes::ColorPointRY::Id, "ColorPointRY"},
+    {ColorControl::Attributes::ColorPointRIntensity::Id, "ColorPointRIntensity"},
+    {ColorControl::Attributes::ColorPointGX::Id, "ColorPointGX"},
+    {ColorControl::Attributes::ColorPointGY::Id, "ColorPointGY"},
+    {ColorControl::Attributes::ColorPointGIntensity::Id, "ColorPointGIntensity"},
+    {ColorControl::Attributes::ColorPointBX::Id, "ColorPointBX"},
+    {ColorControl::Attributes::ColorPointBY::Id, "ColorPointBY"},
+    {ColorControl::Attributes::ColorPointBIntensity::Id, "ColorPointBIntensity"},
+    {ColorControl::Attributes::EnhancedCurrentHue::Id, "EnhancedCurrentHue"},
+    {ColorControl::Attributes::EnhancedColorMode::Id, "EnhancedColorMode"},
+    {ColorControl::Attributes::ColorLoopActive::Id, "ColorLoopActive"},
+    {ColorControl::Attributes::ColorLoopDirection::Id, "ColorLoopDirection"},
+    {ColorControl::Attributes::ColorLoopTime::Id, "ColorLoopTime"},
+    {ColorControl::Attributes::ColorLoopStartEnhancedHue::Id, "ColorLoopStartEnhancedHue"},
+    {ColorControl::Attributes::ColorLoopStoredEnhancedHue::Id, "ColorLoopStoredEnhancedHue"},
+    {ColorControl::Attributes::ColorCapabilities::Id, "ColorCapabilities"},
+    {ColorControl::Attributes::ColorTempPhysicalMinMireds::Id, "ColorTempPhysicalMinMireds"},
+    {ColorControl::Attributes::ColorTempPhysicalMaxMireds::Id, "ColorTempPhysicalMaxMireds"},
+    {ColorControl::Attributes::CoupleColorTempToLevelMinMireds::Id, "CoupleColorTempToLevelMinMireds"},
+    {ColorControl::Attributes::StartUpColorTemperatureMireds::Id, "StartUpColorTemperatureMireds"},
+};
+
+static const element_descriptor_t BallastConfiguration_attributes[] = {
+    {BallastConfiguration::Attributes::PhysicalMinLevel::Id, "PhysicalMinLevel"},
+    {BallastConfiguration::Attributes::PhysicalMaxLevel::Id, "PhysicalMaxLevel"},
+    {BallastConfiguration::Attributes::BallastStatus::Id, "BallastStatus"},
+    {BallastConfiguration::Attributes::MinLevel::Id, "MinLevel"},
+    {BallastConfiguration::Attributes::MaxLevel::Id, "MaxLevel"},
+    {BallastConfiguration::Attributes::IntrinsicBallastFactor::Id, "IntrinsicBallastFactor"},
+    {BallastConfiguration::Attributes::BallastFactorAdjustment::Id, "BallastFactorAdjustment"},
+    {BallastConfiguration::Attributes::LampQuantity::Id, "LampQuantity"},
+    {BallastConfiguration::Attributes::LampType::Id, "LampType"},
+    {BallastConfiguration::Attributes::LampManufacturer::Id, "LampManufacturer"},
+    {BallastConfiguration::Attributes::LampRatedHours::Id, "LampRatedHours"},
+    {BallastConfiguration::Attributes::LampBurnHours::Id, "LampBurnHours"},
+    {BallastConfiguration::Attributes::LampAlarmMode::Id, "LampAlarmMode"},
+    {BallastConfiguration::Attributes::LampBurnHoursTripPoint::Id, "LampBurnHoursTripPoint"},
+};
+
+static const element_descriptor_t IlluminanceMeasurement_attributes[] = {
+    {IlluminanceMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {IlluminanceMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {IlluminanceMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {IlluminanceMeasurement::Attributes::Tolerance::Id, "Tolerance"},
+    {IlluminanceMeasurement::Attributes::LightSensorType::Id, "LightSensorType"},
+};
+
+static const element_descriptor_t TemperatureMeasurement_attributes[] = {
+    {TemperatureMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {TemperatureMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {TemperatureMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {TemperatureMeasurement::Attributes::Tolerance::Id, "Tolerance"},
+};
+
+static const element_descriptor_t PressureMeasurement_attributes[] = {
+    {PressureMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {PressureMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {PressureMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {PressureMeasurement::Attributes::Tolerance::Id, "Tolerance"},
+    {PressureMeasurement::Attributes::ScaledValue::Id, "ScaledValue"},
+    {PressureMeasurement::Attributes::MinScaledValue::Id, "MinScaledValue"},
+    {PressureMeasurement::Attributes::MaxScaledValue::Id, "MaxScaledValue"},
+    {PressureMeasurement::Attributes::ScaledTolerance::Id, "ScaledTolerance"},
+    {PressureMeasurement::Attributes::Scale::Id, "Scale"},
+};
+
+static const element_descriptor_t FlowMeasurement_attributes[] = {
+    {FlowMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {FlowMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {FlowMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {FlowMeasurement::Attributes::Tolerance::Id, "Tolerance"},
+};
+
+static const element_descriptor_t RelativeHumidityMeasurement_attributes[] = {
+    {RelativeHumidityMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {RelativeHumidityMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {RelativeHumidityMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {RelativeHumidityMeasurement::Attributes::Tolerance::Id, "Tolerance"},
+};
+
+static const element_descriptor_t OccupancySensing_attributes[] = {
+    {OccupancySensing::Attributes::Occupancy::Id, "Occupancy"},
+    {OccupancySensing::Attributes::OccupancySensorType::Id, "OccupancySensorType"},
+    {OccupancySensing::Attributes::OccupancySensorTypeBitmap::Id, "OccupancySensorTypeBitmap"},
+    {OccupancySensing::Attributes::PIROccupiedToUnoccupiedDelay::Id, "PIROccupiedToUnoccupiedDelay"},
+    {OccupancySensing::Attributes::PIRUnoccupiedToOccupiedDelay::Id, "PIRUnoccupiedToOccupiedDelay"},
+    {OccupancySensing::Attributes::PIRUnoccupiedToOccupiedThreshold::Id, "PIRUnoccupiedToOccupiedThreshold"},
+    {OccupancySensing::Attributes::UltrasonicOccupiedToUnoccupiedDelay::Id, "UltrasonicOccupiedToUnoccupiedDelay"},
+    {OccupancySensing::Attributes::UltrasonicUnoccupiedToOccupiedDelay::Id, "UltrasonicUnoccupiedToOccupiedDelay"},
+    {OccupancySensing::Attributes::UltrasonicUnoccupiedToOccupiedThreshold::Id, "UltrasonicUnoccupiedToOccupiedThreshold"},
+    {OccupancySensing::Attributes::PhysicalContactOccupiedToUnoccupiedDelay::Id, "PhysicalContactOccupiedToUnoccupiedDelay"},
+    {OccupancySensing::Attributes::PhysicalContactUnoccupiedToOccupiedDelay::Id, "PhysicalContactUnoccupiedToOccupiedDelay"},
+    {OccupancySensing::Attributes::PhysicalContactUnoccupiedToOccupiedThreshold::Id, "PhysicalContactUnoccupiedToOccupiedThreshold"},
+};
+
+static const element_descriptor_t CarbonMonoxideConcentrationMeasurement_attributes[] = {
+    {CarbonMonoxideConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {CarbonMonoxideConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t CarbonDioxideConcentrationMeasurement_attributes[] = {
+    {CarbonDioxideConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {CarbonDioxideConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t NitrogenDioxideConcentrationMeasurement_attributes[] = {
+    {NitrogenDioxideConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {NitrogenDioxideConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t OzoneConcentrationMeasurement_attributes[] = {
+    {OzoneConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {OzoneConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {OzoneConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {OzoneConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {OzoneConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {OzoneConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {OzoneConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {OzoneConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {OzoneConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {OzoneConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {OzoneConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t Pm25ConcentrationMeasurement_attributes[] = {
+    {Pm25ConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {Pm25ConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {Pm25ConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {Pm25ConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {Pm25ConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {Pm25ConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {Pm25ConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {Pm25ConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {Pm25ConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {Pm25ConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {Pm25ConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t FormaldehydeConcentrationMeasurement_attributes[] = {
+    {FormaldehydeConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {FormaldehydeConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {FormaldehydeConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {FormaldehydeConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {FormaldehydeConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {FormaldehydeConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {FormaldehydeConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {FormaldehydeConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {FormaldehydeConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {FormaldehydeConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {FormaldehydeConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t Pm1ConcentrationMeasurement_attributes[] = {
+    {Pm1ConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {Pm1ConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {Pm1ConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {Pm1ConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {Pm1ConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {Pm1ConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {Pm1ConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {Pm1ConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {Pm1ConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {Pm1ConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {Pm1ConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t Pm10ConcentrationMeasurement_attributes[] = {
+    {Pm10ConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {Pm10ConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {Pm10ConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {Pm10ConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {Pm10ConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {Pm10ConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {Pm10ConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {Pm10ConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {Pm10ConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {Pm10ConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {Pm10ConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t TotalVolatileOrganicCompoundsConcentrationMeasurement_attributes[] = {
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t RadonConcentrationMeasurement_attributes[] = {
+    {RadonConcentrationMeasurement::Attributes::MeasuredValue::Id, "MeasuredValue"},
+    {RadonConcentrationMeasurement::Attributes::MinMeasuredValue::Id, "MinMeasuredValue"},
+    {RadonConcentrationMeasurement::Attributes::MaxMeasuredValue::Id, "MaxMeasuredValue"},
+    {RadonConcentrationMeasurement::Attributes::PeakMeasuredValue::Id, "PeakMeasuredValue"},
+    {RadonConcentrationMeasurement::Attributes::PeakMeasuredValueWindow::Id, "PeakMeasuredValueWindow"},
+    {RadonConcentrationMeasurement::Attributes::AverageMeasuredValue::Id, "AverageMeasuredValue"},
+    {RadonConcentrationMeasurement::Attributes::AverageMeasuredValueWindow::Id, "AverageMeasuredValueWindow"},
+    {RadonConcentrationMeasurement::Attributes::Uncertainty::Id, "Uncertainty"},
+    {RadonConcentrationMeasurement::Attributes::MeasurementUnit::Id, "MeasurementUnit"},
+    {RadonConcentrationMeasurement::Attributes::MeasurementMedium::Id, "MeasurementMedium"},
+    {RadonConcentrationMeasurement::Attributes::LevelValue::Id, "LevelValue"},
+};
+
+static const element_descriptor_t WakeOnLan_attributes[] = {
+    {WakeOnLan::Attributes::MACAddress::Id, "MACAddress"},
+    {WakeOnLan::Attributes::LinkLocalAddress::Id, "LinkLocalAddress"},
+};
+
+static const element_descriptor_t Channel_attributes[] = {
+    {Channel::Attributes::ChannelList::Id, "ChannelList"},
+    {Channel::Attributes::Lineup::Id, "Lineup"},
+    {Channel::Attributes::CurrentChannel::Id, "CurrentChannel"},
+};
+
+static const element_descriptor_t Channel_commands[] = {
+    {Channel::Commands::ChangeChannelResponse::Id, "ChangeChannelResponse"},
+    {Channel::Commands::ProgramGuideResponse::Id, "ProgramGuideResponse"},
+};
+
+static const element_descriptor_t TargetNavigator_attributes[] = {
+    {TargetNavigator::Attributes::TargetList::Id, "TargetList"},
+    {TargetNavigator::Attributes::CurrentTarget::Id, "CurrentTarget"},
+};
+
+static const element_descriptor_t TargetNavigator_commands[] = {
+    {TargetNavigator::Commands::NavigateTargetResponse::Id, "NavigateTargetResponse"},
+};
+
+static const element_descriptor_t TargetNavigator_events[] = {
+    {TargetNavigator::Events::TargetUpdated::Id, "TargetUpdated"},
+};
+
+static const element_descriptor_t MediaPlayback_attributes[] = {
+    {MediaPlayback::Attributes::CurrentState::Id, "CurrentState"},
+    {MediaPlayback::Attributes::StartTime::Id, "StartTime"},
+    {MediaPlayback::Attributes::Duration::Id, "Duration"},
+    {MediaPlayback::Attributes::SampledPosition::Id, "SampledPosition"},
+    {MediaPlayback::Attributes::PlaybackSpeed::Id, "PlaybackSpeed"},
+    {MediaPlayback::Attributes::SeekRangeEnd::Id, "SeekRangeEnd"},
+    {MediaPlayback::Attributes::SeekRangeStart::Id, "SeekRangeStart"},
+    {MediaPlayback::Attributes::ActiveAudioTrack::Id, "ActiveAudioTrack"},
+    {MediaPlayback::Attributes::AvailableAudioTracks::Id, "AvailableAudioTracks"},
+    {MediaPlayback::Attributes::ActiveTextTrack::Id, "ActiveTextTrack"},
+    {MediaPlayback::Attributes::AvailableTextTracks::Id, "AvailableTextTracks"},
+};
+
+static const element_descriptor_t MediaPlayback_commands[] = {
+    {MediaPlayback::Commands::PlaybackResponse::Id, "PlaybackResponse"},
+};
+
+static const element_descriptor_t MediaPlayback_events[] = {
+    {MediaPlayback::Events::StateChanged::Id, "StateChanged"},
+};
+
+static const element_descriptor_t MediaInput_attributes[] = {
+    {MediaInput::Attributes::InputList::Id, "InputList"},
+    {MediaInput::Attributes::CurrentInput::Id, "CurrentInput"},
+};
+
+static const element_descriptor_t KeypadInput_commands[] = {
+    {KeypadInput::Commands::SendKeyResponse::Id, "SendKeyResponse"},
+};
+
+static const element_descriptor_t ContentLauncher_attributes[] = {
+    {ContentLauncher::Attributes::AcceptHeader::Id, "AcceptHeader"},
+    {ContentLauncher::Attributes::SupportedStreamingProtocols::Id, "SupportedStreamingProtocols"},
+};
+
+static const element_descriptor_t ContentLauncher_commands[] = {
+    {ContentLauncher::Commands::LauncherResponse::Id, "LauncherResponse"},
+};
+
+static const element_descriptor_t AudioOutput_attributes[] = {
+    {AudioOutput::Attributes::OutputList::Id, "OutputList"},
+    {AudioOutput::Attributes::CurrentOutput::Id, "CurrentOutput"},
+};
+
+static const element_descriptor_t ApplicationLauncher_attributes[] = {
+    {ApplicationLauncher::Attributes::CatalogList::Id, "CatalogList"},
+    {ApplicationLauncher::Attributes::CurrentApp::Id, "CurrentApp"},
+};
+
+static const element_descriptor_t ApplicationLauncher_commands[] = {
+    {ApplicationLauncher::Commands::LauncherResponse::Id, "LauncherResponse"},
+};
+
+static const element_descriptor_t ApplicationBasic_attributes[] = {
+    {ApplicationBasic::Attributes::VendorName::Id, "VendorName"},
+    {ApplicationBasic::Attributes::VendorID::Id, "VendorID"},
+    {ApplicationBasic::Attributes::ApplicationName::Id, "ApplicationName"},
+    {ApplicationBasic::Attributes::ProductID::Id, "ProductID"},
+    {ApplicationBasic::Attributes::Application::Id, "Application"},
+    {ApplicationBasic::Attributes::Status::Id, "Status"},
+    {ApplicationBasic::Attributes::ApplicationVersion::Id, "ApplicationVersion"},
+    {ApplicationBasic::Attributes::AllowedVendorList::Id, "AllowedVendorList"},
+};
+
+static const element_descriptor_t AccountLogin_commands[] = {
+    {AccountLogin::Commands::GetSetupPINResponse::Id, "GetSetupPINResponse"},
+};
+
+static const element_descriptor_t AccountLogin_events[] = {
+    {AccountLogin::Events::LoggedOut::Id, "LoggedOut"},
+};
+
+static const element_descriptor_t ContentControl_attributes[] = {
+    {ContentControl::Attributes::Enabled::Id, "Enabled"},
+    {ContentControl::Attributes::OnDemandRatings::Id, "OnDemandRatings"},
+    {ContentControl::Attributes::OnDemandRatingThreshold::Id, "OnDemandRatingThreshold"},
+    {ContentControl::Attributes::ScheduledContentRatings::Id, "ScheduledContentRatings"},
+    {ContentControl::Attributes::ScheduledContentRatingThreshold::Id, "ScheduledContentRatingThreshold"},
+    {ContentControl::Attributes::ScreenDailyTime::Id, "ScreenDailyTime"},
+    {ContentControl::Attributes::RemainingScreenTime::Id, "RemainingScreenTime"},
+    {ContentControl::Attributes::BlockUnrated::Id, "BlockUnrated"},
+};
+
+static const element_descriptor_t ContentControl_commands[] = {
+    {ContentControl::Commands::ResetPINResponse::Id, "ResetPINResponse"},
+};
+
+static const element_descriptor_t ContentControl_events[] = {
+    {ContentControl::Events::RemainingScreenTimeExpired::Id, "RemainingScreenTimeExpired"},
+};
+
+static const element_descriptor_t ContentAppObserver_commands[] = {
+    {ContentAppObserver::Commands::ContentAppMessageResponse::Id, "ContentAppMessageResponse"},
+};
+
+static const element_descriptor_t ElectricalMeasurement_attributes[] = {
+    {ElectricalMeasurement::Attributes::MeasurementType::Id, "MeasurementType"},
+    {ElectricalMeasurement::Attributes::DcVoltage::Id, "DcVoltage"},
+    {ElectricalMeasurement::Attributes::DcVoltageMin::Id, "DcVoltageMin"},
+    {ElectricalMeasurement::Attributes::DcVoltageMax::Id, "DcVoltageMax"},
+    {ElectricalMeasurement::Attributes::DcCurrent::Id, "DcCurrent"},
+    {ElectricalMeasurement::Attributes::DcCurrentMin::Id, "DcCurrentMin"},
+    {ElectricalMeasurement::Attributes::DcCurrentMax::Id, "DcCurrentMax"},
+    {ElectricalMeasurement::Attributes::DcPower::Id, "DcPower"},
+    {ElectricalMeasurement::Attributes::DcPowerMin::Id, "DcPowerMin"},
+    {ElectricalMeasurement::Attributes::DcPowerMax::Id, "DcPowerMax"},
+    {ElectricalMeasurement::Attributes::DcVoltageMultiplier::Id, "DcVoltageMultiplier"},
+    {ElectricalMeasurement::Attributes::DcVoltageDivisor::Id, "DcVoltageDivisor"},
+    {ElectricalMeasurement::Attributes::DcCurrentMultiplier::Id, "DcCurrentMultiplier"},
+    {ElectricalMeasurement::Attributes::DcCurrentDivisor::Id, "DcCurrentDivisor"},
+    {ElectricalMeasurement::Attributes::DcPowerMultiplier::Id, "DcPowerMultiplier"},
+    {ElectricalMeasurement::Attributes::DcPowerDivisor::Id, "DcPowerDivisor"},
+    {ElectricalMeasurement::Attributes::AcFrequency::Id, "AcFrequency"},
+    {ElectricalMeasurement::Attributes::AcFrequencyMin::Id, "AcFrequencyMin"},
+    {ElectricalMeasurement::Attributes::AcFrequencyMax::Id, "AcFrequencyMax"},
+    {ElectricalMeasurement::Attributes::NeutralCurrent::Id, "NeutralCurrent"},
+    {ElectricalMeasurement::Attributes::TotalActivePower::Id, "TotalActivePower"},
+    {ElectricalMeasurement::Attributes::TotalReactivePower::Id, "TotalReactivePower"},
+    {ElectricalMeasurement::Attributes::TotalApparentPower::Id, "TotalApparentPower"},
+    {ElectricalMeasurement::Attributes::Measured1stHarmonicCurrent::Id, "Measured1stHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::Measured3rdHarmonicCurrent::Id, "Measured3rdHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::Measured5thHarmonicCurrent::Id, "Measured5thHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::Measured7thHarmonicCurrent::Id, "Measured7thHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::Measured9thHarmonicCurrent::Id, "Measured9thHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::Measured11thHarmonicCurrent::Id, "Measured11thHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::MeasuredPhase1stHarmonicCurrent::Id, "MeasuredPhase1stHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::MeasuredPhase3rdHarmonicCurrent::Id, "MeasuredPhase3rdHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::MeasuredPhase5thHarmonicCurrent::Id, "MeasuredPhase5thHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::MeasuredPhase7thHarmonicCurrent::Id, "MeasuredPhase7thHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::MeasuredPhase9thHarmonicCurrent::Id, "MeasuredPhase9thHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::MeasuredPhase11thHarmonicCurrent::Id, "MeasuredPhase11thHarmonicCurrent"},
+    {ElectricalMeasurement::Attributes::AcFrequencyMultiplier::Id, "AcFrequencyMultiplier"},
+    {ElectricalMeasurement::Attributes::AcFrequencyDivisor::Id, "AcFrequencyDivisor"},
+    {ElectricalMeasurement::Attributes::PowerMultiplier::Id, "PowerMultiplier"},
+    {ElectricalMeasurement::Attributes::PowerDivisor::Id, "PowerDivisor"},
+    {ElectricalMeasurement::Attributes::HarmonicCurrentMultiplier::Id, "HarmonicCurrentMultiplier"},
+    {ElectricalMeasurement::Attributes::PhaseHarmonicCurrentMultiplier::Id, "PhaseHarmonicCurrentMultiplier"},
+    {ElectricalMeasurement::Attributes::InstantaneousVoltage::Id, "InstantaneousVoltage"},
+    {ElectricalMeasurement::Attributes::InstantaneousLineCurrent::Id, "InstantaneousLineCurrent"},
+    {ElectricalMeasurement::Attributes::InstantaneousActiveCurrent::Id, "InstantaneousActiveCurrent"},
+    {ElectricalMeasurement::Attributes::InstantaneousReactiveCurrent::Id, "InstantaneousReactiveCurrent"},
+    {ElectricalMeasurement::Attributes::InstantaneousPower::Id, "InstantaneousPower"},
+    {ElectricalMeasurement::Attributes::RmsVoltage::Id, "RmsVoltage"},
+    {ElectricalMeasurement::Attributes::RmsVoltageMin::Id, "RmsVoltageMin"},
+    {ElectricalMeasurement::Attributes::RmsVoltageMax::Id, "RmsVoltageMax"},
+    {ElectricalMeasurement::Attributes::RmsCurrent::Id, "RmsCurrent"},
+    {ElectricalMeasurement::Attributes::RmsCurrentMin::Id, "RmsCurrentMin"},
+    {ElectricalMeasurement::Attributes::RmsCurrentMax::Id, "RmsCurrentMax"},
+    {ElectricalMeasurement::Attributes::ActivePower::Id, "ActivePower"},
+    {ElectricalMeasurement::Attributes::ActivePowerMin::Id, "ActivePowerMin"},
+    {ElectricalMeasurement::Attributes::ActivePowerMax::Id, "ActivePowerMax"},
+    {ElectricalMeasurement::Attributes::ReactivePower::Id, "ReactivePower"},
+    {ElectricalMeasurement::Attributes::ApparentPower::Id, "ApparentPower"},
+    {ElectricalMeasurement::Attributes::PowerFactor::Id, "PowerFactor"},
+    {ElectricalMeasurement::Attributes::AverageRmsVoltageMeasurementPeriod::Id, "AverageRmsVoltageMeasurementPeriod"},
+    {ElectricalMeasurement::Attributes::AverageRmsUnderVoltageCounter::Id, "AverageRmsUnderVoltageCounter"},
+    {ElectricalMeasurement::Attributes::RmsExtremeOverVoltagePeriod::Id, "RmsExtremeOverVoltagePeriod"},
+    {ElectricalMeasurement::Attributes::RmsExtremeUnderVoltagePeriod::Id, "RmsExtremeUnderVoltagePeriod"},
+    {ElectricalMeasurement::Attributes::RmsVoltageSagPeriod::Id, "RmsVoltageSagPeriod"},
+    {ElectricalMeasurement::Attributes::RmsVoltageSwellPeriod::Id, "RmsVoltageSwellPeriod"},
+    {ElectricalMeasurement::Attributes::AcVoltageMultiplier::Id, "AcVoltageMultiplier"},
+    {ElectricalMeasurement::Attributes::AcVoltageDivisor::Id, "AcVoltageDivisor"},
+    {ElectricalMeasurement::Attributes::AcCurrentMultiplier::Id, "AcCurrentMultiplier"},
+    {ElectricalMeasurement::Attributes::AcCurrentDivisor::Id, "AcCurrentDivisor"},
+    {ElectricalMeasurement::Attributes::AcPowerMultiplier::Id, "AcPowerMultiplier"},
+    {ElectricalMeasurement::Attributes::AcPowerDivisor::Id, "AcPowerDivisor"},
+    {ElectricalMeasurement::Attributes::OverloadAlarmsMask::Id, "OverloadAlarmsMask"},
+    {ElectricalMeasurement::Attributes::VoltageOverload::Id, "VoltageOverload"},
+    {ElectricalMeasurement::Attributes::CurrentOverload::Id, "CurrentOverload"},
+    {ElectricalMeasurement::Attributes::AcOverloadAlarmsMask::Id, "AcOverloadAlarmsMask"},
+    {ElectricalMeasurement::Attributes::AcVoltageOverload::Id, "AcVoltageOverload"},
+    {ElectricalMeasurement::Attributes::AcCurrentOverload::Id, "AcCurrentOverload"},
+    {ElectricalMeasurement::Attributes::AcActivePowerOverload::Id, "AcActivePowerOverload"},
+    {ElectricalMeasurement::Attributes::AcReactivePowerOverload::Id, "AcReactivePowerOverload"},
+    {ElectricalMeasurement::Attributes::AverageRmsOverVoltage::Id, "AverageRmsOverVoltage"},
+    {ElectricalMeasurement::Attributes::AverageRmsUnderVoltage::Id, "AverageRmsUnderVoltage"},
+    {ElectricalMeasurement::Attributes::RmsExtremeOverVoltage::Id, "RmsExtremeOverVoltage"},
+    {ElectricalMeasurement::Attributes::RmsExtremeUnderVoltage::Id, "RmsExtremeUnderVoltage"},
+    {ElectricalMeasurement::Attributes::RmsVoltageSag::Id, "RmsVoltageSag"},
+    {ElectricalMeasurement::Attributes::RmsVoltageSwell::Id, "RmsVoltageSwell"},
+    {ElectricalMeasurement::Attributes::LineCurrentPhaseB::Id, "LineCurrentPhaseB"},
+    {ElectricalMeasurement::Attributes::ActiveCurrentPhaseB::Id, "ActiveCurrentPhaseB"},
+    {ElectricalMeasurement::Attributes::ReactiveCurrentPhaseB::Id, "ReactiveCurrentPhaseB"},
+    {ElectricalMeasurement::Attributes::RmsVoltagePhaseB::Id, "RmsVoltagePhaseB"},
+    {ElectricalMeasurement::Attributes::RmsVoltageMinPhaseB::Id, "RmsVoltageMinPhaseB"},
+    {ElectricalMeasurement::Attributes::RmsVoltageMaxPhaseB::Id, "RmsVoltageMaxPhaseB"},
+    {ElectricalMeasurement::Attributes::RmsCurrentPhaseB::Id, "RmsCurrentPhaseB"},
+    {ElectricalMeasurement::Attributes::RmsCurrentMinPhaseB::Id, "RmsCurrentMinPhaseB"},
+    {ElectricalMeasurement::Attributes::RmsCurrentMaxPhaseB::Id, "RmsCurrentMaxPhaseB"},
+    {ElectricalMeasurement::Attributes::ActivePowerPhaseB::Id, "ActivePowerPhaseB"},
+    {ElectricalMeasurement::Attributes::ActivePowerMinPhaseB::Id, "ActivePowerMinPhaseB"},
+    {ElectricalMeasurement::Attributes::ActivePowerMaxPhaseB::Id, "ActivePowerMaxPhaseB"},
+    {ElectricalMeasurement::Attributes::ReactivePowerPhaseB::Id, "ReactivePowerPhaseB"},
+    {ElectricalMeasurement::Attributes::ApparentPowerPhaseB::Id, "ApparentPowerPhaseB"},
+    {ElectricalMeasurement::Attributes::PowerFactorPhaseB::Id, "PowerFactorPhaseB"},
+    {ElectricalMeasurement::Attributes::AverageRmsVoltageMeasurementPeriodPhaseB::Id, "AverageRmsVoltageMeasurementPeriodPhaseB"},
+    {ElectricalMeasurement::Attributes::AverageRmsOverVoltageCounterPhaseB::Id, "AverageRmsOverVoltageCounterPhaseB"},
+    {ElectricalMeasurement::Attributes::AverageRmsUnderVoltageCounterPhaseB::Id, "AverageRmsUnderVoltageCounterPhaseB"},
+    {ElectricalMeasurement::Attributes::RmsExtremeOverVoltagePeriodPhaseB::Id, "RmsExtremeOverVoltagePeriodPhaseB"},
+    {ElectricalMeasurement::Attributes::RmsExtremeUnderVoltagePeriodPhaseB::Id, "RmsExtremeUnderVoltagePeriodPhaseB"},
+    {ElectricalMeasurement::Attributes::RmsVoltageSagPeriodPhaseB::Id, "RmsVoltageSagPeriodPhaseB"},
+    {ElectricalMeasurement::Attributes::RmsVoltageSwellPeriodPhaseB::Id, "RmsVoltageSwellPeriodPhaseB"},
+    {ElectricalMeasurement::Attributes::LineCurrentPhaseC::Id, "LineCurrentPhaseC"},
+    {ElectricalMeasurement::Attributes::ActiveCurrentPhaseC::Id, "ActiveCurrentPhaseC"},
+    {ElectricalMeasurement::Attributes::ReactiveCurrentPhaseC::Id, "ReactiveCurrentPhaseC"},
+    {ElectricalMeasurement::Attributes::RmsVoltagePhaseC::Id, "RmsVoltagePhaseC"},
+    {ElectricalMeasurement::Attributes::RmsVoltageMinPhaseC::Id, "RmsVoltageMinPhaseC"},
+    {ElectricalMeasurement::Attributes::RmsVoltageMaxPhaseC::Id, "RmsVoltageMaxPhaseC"},
+    {ElectricalMeasurement::Attributes::RmsCurrentPhaseC::Id, "RmsCurrentPhaseC"},
+    {ElectricalMeasurement::Attributes::RmsCurrentMinPhaseC::Id, "RmsCurrentMinPhaseC"},
+    {ElectricalMeasurement::Attributes::RmsCurrentMaxPhaseC::Id, "RmsCurrentMaxPhaseC"},
+    {ElectricalMeasurement::Attributes::ActivePowerPhaseC::Id, "ActivePowerPhaseC"},
+    {ElectricalMeasurement::Attributes::ActivePowerMinPhaseC::Id, "ActivePowerMinPhaseC"},
+    {ElectricalMeasurement::Attributes::ActivePowerMaxPhaseC::Id, "ActivePowerMaxPhaseC"},
+    {ElectricalMeasurement::Attributes::ReactivePowerPhaseC::Id, "ReactivePowerPhaseC"},
+    {ElectricalMeasurement::Attributes::ApparentPowerPhaseC::Id, "ApparentPowerPhaseC"},
+    {ElectricalMeasurement::Attributes::PowerFactorPhaseC::Id, "PowerFactorPhaseC"},
+    {ElectricalMeasurement::Attributes::AverageRmsVoltageMeasurementPeriodPhaseC::Id, "AverageRmsVoltageMeasurementPeriodPhaseC"},
+    {ElectricalMeasurement::Attributes::AverageRmsOverVoltageCounterPhaseC::Id, "AverageRmsOverVoltageCounterPhaseC"},
+    {ElectricalMeasurement::Attributes::AverageRmsUnderVoltageCounterPhaseC::Id, "AverageRmsUnderVoltageCounterPhaseC"},
+    {ElectricalMeasurement::Attributes::RmsExtremeOverVoltagePeriodPhaseC::Id, "RmsExtremeOverVoltagePeriodPhaseC"},
+    {ElectricalMeasurement::Attributes::RmsExtremeUnderVoltagePeriodPhaseC::Id, "RmsExtremeUnderVoltagePeriodPhaseC"},
+    {ElectricalMeasurement::Attributes::RmsVoltageSagPeriodPhaseC::Id, "RmsVoltageSagPeriodPhaseC"},
+    {ElectricalMeasurement::Attributes::RmsVoltageSwellPeriodPhaseC::Id, "RmsVoltageSwellPeriodPhaseC"},
+};
+
+static const element_descriptor_t ElectricalMeasurement_commands[] = {
+    {ElectricalMeasurement::Commands::GetProfileInfoResponseCommand::Id, "GetProfileInfoResponseCommand"},
+    {ElectricalMeasurement::Commands::GetMeasurementProfileResponseCommand::Id, "GetMeasurementProfileResponseCommand"},
+};
+
+static const element_descriptor_t UnitTesting_attributes[] = {
+    {UnitTesting::Attributes::Boolean::Id, "Boolean"},
+    {UnitTesting::Attributes::Bitmap8::Id, "Bitmap8"},
+    {UnitTesting::Attributes::Bitmap16::Id, "Bitmap16"},
+    {UnitTesting::Attributes::Bitmap32::Id, "Bitmap32"},
+    {UnitTesting::Attributes::Bitmap64::Id, "Bitmap64"},
+    {UnitTesting::Attributes::Int8u::Id, "Int8u"},
+    {UnitTesting::Attributes::Int16u::Id, "Int16u"},
+    {UnitTesting::Attributes::Int24u::Id, "Int24u"},
+    {UnitTesting::Attributes::Int32u::Id, "Int32u"},
+    {UnitTesting::Attributes::Int40u::Id, "Int40u"},
+    {UnitTesting::Attributes::Int48u::Id, "Int48u"},
+    {UnitTesting::Attributes::Int56u::Id, "Int56u"},
+    {UnitTesting::Attributes::Int64u::Id, "Int64u"},
+    {UnitTesting::Attributes::Int8s::Id, "Int8s"},
+    {UnitTesting::Attributes::Int16s::Id, "Int16s"},
+    {UnitTesting::Attributes::Int24s::Id, "Int24s"},
+    {UnitTesting::Attributes::Int32s::Id, "Int32s"},
+    {UnitTesting::Attributes::Int40s::Id, "Int40s"},
+    {UnitTesting::Attributes::Int48s::Id, "Int48s"},
+    {UnitTesting::Attributes::Int56s::Id, "Int56s"},
+    {UnitTesting::Attributes::Int64s::Id, "Int64s"},
+    {UnitTesting::Attributes::Enum8::Id, "Enum8"},
+    {UnitTesting::Attributes::Enum16::Id, "Enum16"},
+    {UnitTesting::Attributes::FloatSingle::Id, "FloatSingle"},
+    {UnitTesting::Attributes::FloatDouble::Id, "FloatDouble"},
+    {UnitTesting::Attributes::OctetString::Id, "OctetString"},
+    {UnitTesting::Attributes::ListInt8u::Id, "ListInt8u"},
+    {UnitTesting::Attributes::ListOctetString::Id, "ListOctetString"},
+    {UnitTesting::Attributes::ListStructOctetString::Id, "ListStructOctetString"},
+    {UnitTesting::Attributes::LongOctetString::Id, "LongOctetString"},
+    {UnitTesting::Attributes::CharString::Id, "CharString"},
+    {UnitTesting::Attributes::LongCharString::Id, "LongCharString"},
+    {UnitTesting::Attributes::EpochUs::Id, "EpochUs"},
+    {UnitTesting::Attributes::EpochS::Id, "EpochS"},
+    {UnitTesting::Attributes::VendorId::Id, "VendorId"},
+    {UnitTesting::Attributes::ListNullablesAndOptionalsStruct::Id, "ListNullablesAndOptionalsStruct"},
+    {UnitTesting::Attributes::EnumAttr::Id, "EnumAttr"},
+    {UnitTesting::Attributes::StructAttr::Id, "StructAttr"},
+    {UnitTesting::Attributes::RangeRestrictedInt8u::Id, "RangeRestrictedInt8u"},
+    {UnitTesting::Attributes::RangeRestrictedInt8s::Id, "RangeRestrictedInt8s"},
+    {UnitTesting::Attributes::RangeRestrictedInt16u::Id, "RangeRestrictedInt16u"},
+    {UnitTesting::Attributes::RangeRestrictedInt16s::Id, "RangeRestrictedInt16s"},
+    {UnitTesting::Attributes::ListLongOctetString::Id, "ListLongOctetString"},
+    {UnitTesting::Attributes::ListFabricScoped::Id, "ListFabricScoped"},
+    {UnitTesting::Attributes::TimedWriteBoolean::Id, "TimedWriteBoolean"},
+    {UnitTesting::Attributes::GeneralErrorBoolean::Id, "GeneralErrorBoolean"},
+    {UnitTesting::Attributes::ClusterErrorBoolean::Id, "ClusterErrorBoolean"},
+    {UnitTesting::Attributes::Unsupported::Id, "Unsupported"},
+    {UnitTesting::Attributes::NullableBoolean::Id, "NullableBoolean"},
+    {UnitTesting::Attributes::NullableBitmap8::Id, "NullableBitmap8"},
+    {UnitTesting::Attributes::NullableBitmap16::Id, "NullableBitmap16"},
+    {UnitTesting::Attributes::NullableBitmap32::Id, "NullableBitmap32"},
+    {UnitTesting::Attributes::NullableBitmap64::Id, "NullableBitmap64"},
+    {UnitTesting::Attributes::NullableInt8u::Id, "NullableInt8u"},
+    {UnitTesting::Attributes::NullableInt16u::Id, "NullableInt16u"},
+    {UnitTesting::Attributes::NullableInt24u::Id, "NullableInt24u"},
+    {UnitTesting::Attributes::NullableInt32u::Id, "NullableInt32u"},
+    {UnitTesting::Attributes::NullableInt40u::Id, "NullableInt40u"},
+    {UnitTesting::Attributes::NullableInt48u::Id, "NullableInt48u"},
+    {UnitTesting::Attributes::NullableInt56u::Id, "NullableInt56u"},
+    {UnitTesting::Attributes::NullableInt64u::Id, "NullableInt64u"},
+    {UnitTesting::Attributes::NullableInt8s::Id, "NullableInt8s"},
+    {UnitTesting::Attributes::NullableInt16s::Id, "NullableInt16s"},
+    {UnitTesting::Attributes::NullableInt24s::Id, "NullableInt24s"},
+    {UnitTesting::Attributes::NullableInt32s::Id, "NullableInt32s"},
+    {UnitTesting::Attributes::NullableInt40s::Id, "NullableInt40s"},
+    {UnitTesting::Attributes::NullableInt48s::Id, "NullableInt48s"},
+    {UnitTesting::Attributes::NullableInt56s::Id, "NullableInt56s"},
+    {UnitTesting::Attributes::NullableInt64s::Id, "NullableInt64s"},
+    {UnitTesting::Attributes::NullableEnum8::Id, "NullableEnum8"},
+    {UnitTesting::Attributes::NullableEnum16::Id, "NullableEnum16"},
+    {UnitTesting::Attributes::NullableFloatSingle::Id, "NullableFloatSingle"},
+    {UnitTesting::Attributes::NullableFloatDouble::Id, "NullableFloatDouble"},
+    {UnitTesting::Attributes::NullableOctetString::Id, "NullableOctetString"},
+    {UnitTesting::Attributes::NullableCharString::Id, "NullableCharString"},
+    {UnitTesting::Attributes::NullableEnumAttr::Id, "NullableEnumAttr"},
+    {UnitTesting::Attributes::NullableStruct::Id, "NullableStruct"},
+    {UnitTesting::Attributes::NullableRangeRestrictedInt8u::Id, "NullableRangeRestrictedInt8u"},
+    {UnitTesting::Attributes::NullableRangeRestrictedInt8s::Id, "NullableRangeRestrictedInt8s"},
+    {UnitTesting::Attributes::NullableRangeRestrictedInt16u::Id, "NullableRangeRestrictedInt16u"},
+    {UnitTesting::Attributes::NullableRangeRestrictedInt16s::Id, "NullableRangeRestrictedInt16s"},
+    {UnitTesting::Attributes::WriteOnlyInt8u::Id, "WriteOnlyInt8u"},
+};
+
+static const element_descriptor_t UnitTesting_commands[] = {
+    {UnitTesting::Commands::TestSpecificResponse::Id, "TestSpecificResponse"},
+    {UnitTesting::Commands::TestAddArgumentsResponse::Id, "TestAddArgumentsResponse"},
+    {UnitTesting::Commands::TestSimpleArgumentResponse::Id, "TestSimpleArgumentResponse"},
+    {UnitTesting::Commands::TestStructArrayArgumentResponse::Id, "TestStructArrayArgumentResponse"},
+    {UnitTesting::Commands::TestListInt8UReverseResponse::Id, "TestListInt8UReverseResponse"},
+    {UnitTesting::Commands::TestEnumsResponse::Id, "TestEnumsResponse"},
+    {UnitTesting::Commands::TestNullableOptionalResponse::Id, "TestNullableOptionalResponse"},
+    {UnitTesting::Commands::TestComplexNullableOptionalResponse::Id, "TestComplexNullableOptionalResponse"},
+    {UnitTesting::Commands::BooleanResponse::Id, "BooleanResponse"},
+    {UnitTesting::Commands::SimpleStructResponse::Id, "SimpleStructResponse"},
+    {UnitTesting::Commands::TestEmitTestEventResponse::Id, "TestEmitTestEventResponse"},
+    {UnitTesting::Commands::TestEmitTestFabricScopedEventResponse::Id, "TestEmitTestFabricScopedEventResponse"},
+};
+
+static const element_descriptor_t UnitTesting_events[] = {
+    {UnitTesting::Events::TestEvent::Id, "TestEvent"},
+    {UnitTesting::Events::TestFabricScopedEvent::Id, "TestFabricScopedEvent"},
+};
+
+static const element_descriptor_t SampleMei_attributes[] = {
+    {SampleMei::Attributes::FlipFlop::Id, "FlipFlop"},
+};
+
+static const element_descriptor_t SampleMei_commands[] = {
+    {SampleMei::Commands::AddArgumentsResponse::Id, "AddArgumentsResponse"},
+};
+
+static const element_descriptor_t SampleMei_events[] = {
+    {SampleMei::Events::PingCountEvent::Id, "PingCountEvent"},
+};
+
+const cluster_descriptor_t k_clusters[] = {
+    {Identify::Id, "Identify", ELEMENTS(Identify_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {Groups::Id, "Groups", ELEMENTS(Groups_attributes), ELEMENTS(Groups_commands), NO_ELEMENTS},
+    {ScenesManagement::Id, "ScenesManagement", ELEMENTS(ScenesManagement_attributes), ELEMENTS(ScenesManagement_commands), NO_ELEMENTS},
+    {OnOff::Id, "OnOff", ELEMENTS(OnOff_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {OnOffSwitchConfiguration::Id, "OnOffSwitchConfiguration", ELEMENTS(OnOffSwitchConfiguration_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {LevelControl::Id, "LevelControl", ELEMENTS(LevelControl_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {BinaryInputBasic::Id, "BinaryInputBasic", ELEMENTS(BinaryInputBasic_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {PulseWidthModulation::Id, "PulseWidthModulation", NO_ELEMENTS, NO_ELEMENTS, NO_ELEMENTS},
+    {Descriptor::Id, "Descriptor", ELEMENTS(Descriptor_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {Binding::Id, "Binding", ELEMENTS(Binding_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {AccessControl::Id, "AccessControl", ELEMENTS(AccessControl_attributes), NO_ELEMENTS, ELEMENTS(AccessControl_events)},
+    {Actions::Id, "Actions", ELEMENTS(Actions_attributes), NO_ELEMENTS, ELEMENTS(Actions_events)},
+    {BasicInformation::Id, "BasicInformation", ELEMENTS(BasicInformation_attributes), NO_ELEMENTS, ELEMENTS(BasicInformation_events)},
+    {OtaSoftwareUpdateProvider::Id, "OtaSoftwareUpdateProvider", NO_ELEMENTS, ELEMENTS(OtaSoftwareUpdateProvider_commands), NO_ELEMENTS},
+    {OtaSoftwareUpdateRequestor::Id, "OtaSoftwareUpdateRequestor", ELEMENTS(OtaSoftwareUpdateRequestor_attributes), NO_ELEMENTS, ELEMENTS(OtaSoftwareUpdateRequestor_events)},
+    {LocalizationConfiguration::Id, "LocalizationConfiguration", ELEMENTS(LocalizationConfiguration_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {TimeFormatLocalization::Id, "TimeFormatLocalization", ELEMENTS(TimeFormatLocalization_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {UnitLocalization::Id, "UnitLocalization", ELEMENTS(UnitLocalization_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {PowerSourceConfiguration::Id, "PowerSourceConfiguration", ELEMENTS(PowerSourceConfiguration_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {PowerSource::Id, "PowerSource", ELEMENTS(PowerSource_attributes), NO_ELEMENTS, ELEMENTS(PowerSource_events)},
+    {GeneralCommissioning::Id, "GeneralCommissioning", ELEMENTS(GeneralCommissioning_attributes), ELEMENTS(GeneralCommissioning_commands), NO_ELEMENTS},
+    {NetworkCommissioning::Id, "NetworkCommissioning", ELEMENTS(NetworkCommissioning_attributes), ELEMENTS(NetworkCommissioning_commands), NO_ELEMENTS},
+    {DiagnosticLogs::Id, "DiagnosticLogs", NO_ELEMENTS, ELEMENTS(DiagnosticLogs_commands), NO_ELEMENTS},
+    {GeneralDiagnostics::Id, "GeneralDiagnostics", ELEMENTS(GeneralDiagnostics_attributes), ELEMENTS(GeneralDiagnostics_commands), ELEMENTS(GeneralDiagnostics_events)},
+    {SoftwareDiagnostics::Id, "SoftwareDiagnostics", ELEMENTS(SoftwareDiagnostics_attributes), NO_ELEMENTS, ELEMENTS(SoftwareDiagnostics_events)},
+    {ThreadNetworkDiagnostics::Id, "ThreadNetworkDiagnostics", ELEMENTS(ThreadNetworkDiagnostics_attributes), NO_ELEMENTS, ELEMENTS(ThreadNetworkDiagnostics_events)},
+    {WiFiNetworkDiagnostics::Id, "WiFiNetworkDiagnostics", ELEMENTS(WiFiNetworkDiagnostics_attributes), NO_ELEMENTS, ELEMENTS(WiFiNetworkDiagnostics_events)},
+    {EthernetNetworkDiagnostics::Id, "EthernetNetworkDiagnostics", ELEMENTS(EthernetNetworkDiagnostics_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {TimeSynchronization::Id, "TimeSynchronization", ELEMENTS(TimeSynchronization_attributes), ELEMENTS(TimeSynchronization_commands), ELEMENTS(TimeSynchronization_events)},
+    {BridgedDeviceBasicInformation::Id, "BridgedDeviceBasicInformation", ELEMENTS(BridgedDeviceBasicInformation_attributes), NO_ELEMENTS, ELEMENTS(BridgedDeviceBasicInformation_events)},
+    {Switch::Id, "Switch", ELEMENTS(Switch_attributes), NO_ELEMENTS, ELEMENTS(Switch_events)},
+    {AdministratorCommissioning::Id, "AdministratorCommissioning", ELEMENTS(AdministratorCommissioning_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {OperationalCredentials::Id, "OperationalCredentials", ELEMENTS(OperationalCredentials_attributes), ELEMENTS(OperationalCredentials_commands), NO_ELEMENTS},
+    {GroupKeyManagement::Id, "GroupKeyManagement", ELEMENTS(GroupKeyManagement_attributes), ELEMENTS(GroupKeyManagement_commands), NO_ELEMENTS},
+    {FixedLabel::Id, "FixedLabel", ELEMENTS(FixedLabel_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {UserLabel::Id, "UserLabel", ELEMENTS(UserLabel_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {ProxyConfiguration::Id, "ProxyConfiguration", NO_ELEMENTS, NO_ELEMENTS, NO_ELEMENTS},
+    {ProxyDiscovery::Id, "ProxyDiscovery", NO_ELEMENTS, NO_ELEMENTS, NO_ELEMENTS},
+    {ProxyValid::Id, "ProxyValid", NO_ELEMENTS, NO_ELEMENTS, NO_ELEMENTS},
+    {BooleanState::Id, "BooleanState", ELEMENTS(BooleanState_attributes), NO_ELEMENTS, ELEMENTS(BooleanState_events)},
+    {IcdManagement::Id, "IcdManagement", ELEMENTS(IcdManagement_attributes), ELEMENTS(IcdManagement_commands), NO_ELEMENTS},
+    {Timer::Id, "Timer", ELEMENTS(Timer_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {OvenCavityOperationalState::Id, "OvenCavityOperationalState", ELEMENTS(OvenCavityOperationalState_attributes), ELEMENTS(OvenCavityOperationalState_commands), ELEMENTS(OvenCavityOperationalState_events)},
+    {OvenMode::Id, "OvenMode", ELEMENTS(OvenMode_attributes), ELEMENTS(OvenMode_commands), NO_ELEMENTS},
+    {LaundryDryerControls::Id, "LaundryDryerControls", ELEMENTS(LaundryDryerControls_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {ModeSelect::Id, "ModeSelect", ELEMENTS(ModeSelect_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {LaundryWasherMode::Id, "LaundryWasherMode", ELEMENTS(LaundryWasherMode_attributes), ELEMENTS(LaundryWasherMode_commands), NO_ELEMENTS},
+    {RefrigeratorAndTemperatureControlledCabinetMode::Id, "RefrigeratorAndTemperatureControlledCabinetMode", ELEMENTS(RefrigeratorAndTemperatureControlledCabinetMode_attributes), ELEMENTS(RefrigeratorAndTemperatureControlledCabinetMode_commands), NO_ELEMENTS},
+    {LaundryWasherControls::Id, "LaundryWasherControls", ELEMENTS(LaundryWasherControls_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {RvcRunMode::Id, "RvcRunMode", ELEMENTS(RvcRunMode_attributes), ELEMENTS(RvcRunMode_commands), NO_ELEMENTS},
+    {RvcCleanMode::Id, "RvcCleanMode", ELEMENTS(RvcCleanMode_attributes), ELEMENTS(RvcCleanMode_commands), NO_ELEMENTS},
+    {TemperatureControl::Id, "TemperatureControl", ELEMENTS(TemperatureControl_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {RefrigeratorAlarm::Id, "RefrigeratorAlarm", ELEMENTS(RefrigeratorAlarm_attributes), NO_ELEMENTS, ELEMENTS(RefrigeratorAlarm_events)},
+    {DishwasherMode::Id, "DishwasherMode", ELEMENTS(DishwasherMode_attributes), ELEMENTS(DishwasherMode_commands), NO_ELEMENTS},
+    {AirQuality::Id, "AirQuality", ELEMENTS(AirQuality_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {SmokeCoAlarm::Id, "SmokeCoAlarm", ELEMENTS(SmokeCoAlarm_attributes), NO_ELEMENTS, ELEMENTS(SmokeCoAlarm_events)},
+    {DishwasherAlarm::Id, "DishwasherAlarm", ELEMENTS(DishwasherAlarm_attributes), NO_ELEMENTS, ELEMENTS(DishwasherAlarm_events)},
+    {MicrowaveOvenMode::Id, "MicrowaveOvenMode", ELEMENTS(MicrowaveOvenMode_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {MicrowaveOvenControl::Id, "MicrowaveOvenControl", ELEMENTS(MicrowaveOvenControl_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {OperationalState::Id, "OperationalState", ELEMENTS(OperationalState_attributes), ELEMENTS(OperationalState_commands), ELEMENTS(OperationalState_events)},
+    {RvcOperationalState::Id, "RvcOperationalState", ELEMENTS(RvcOperationalState_attributes), ELEMENTS(RvcOperationalState_commands), ELEMENTS(RvcOperationalState_events)},
+    {HepaFilterMonitoring::Id, "HepaFilterMonitoring", ELEMENTS(HepaFilterMonitoring_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {ActivatedCarbonFilterMonitoring::Id, "ActivatedCarbonFilterMonitoring", ELEMENTS(ActivatedCarbonFilterMonitoring_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {BooleanStateConfiguration::Id, "BooleanStateConfiguration", ELEMENTS(BooleanStateConfiguration_attributes), NO_ELEMENTS, ELEMENTS(BooleanStateConfiguration_events)},
+    {ValveConfigurationAndControl::Id, "ValveConfigurationAndControl", ELEMENTS(ValveConfigurationAndControl_attributes), NO_ELEMENTS, ELEMENTS(ValveConfigurationAndControl_events)},
+    {ElectricalEnergyMeasurement::Id, "ElectricalEnergyMeasurement", ELEMENTS(ElectricalEnergyMeasurement_attributes), NO_ELEMENTS, ELEMENTS(ElectricalEnergyMeasurement_events)},
+    {DemandResponseLoadControl::Id, "DemandResponseLoadControl", ELEMENTS(DemandResponseLoadControl_attributes), NO_ELEMENTS, ELEMENTS(DemandResponseLoadControl_events)},
+    {DeviceEnergyManagement::Id, "DeviceEnergyManagement", ELEMENTS(DeviceEnergyManagement_attributes), NO_ELEMENTS, ELEMENTS(DeviceEnergyManagement_events)},
+    {EnergyEvse::Id, "EnergyEvse", ELEMENTS(EnergyEvse_attributes), ELEMENTS(EnergyEvse_commands), ELEMENTS(EnergyEvse_events)},
+    {EnergyPreference::Id, "EnergyPreference", ELEMENTS(EnergyPreference_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {DoorLock::Id, "DoorLock", ELEMENTS(DoorLock_attributes), ELEMENTS(DoorLock_commands), ELEMENTS(DoorLock_events)},
+    {WindowCovering::Id, "WindowCovering", ELEMENTS(WindowCovering_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {BarrierControl::Id, "BarrierControl", ELEMENTS(BarrierControl_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {PumpConfigurationAndControl::Id, "PumpConfigurationAndControl", ELEMENTS(PumpConfigurationAndControl_attributes), NO_ELEMENTS, ELEMENTS(PumpConfigurationAndControl_events)},
+    {Thermostat::Id, "Thermostat", ELEMENTS(Thermostat_attributes), ELEMENTS(Thermostat_commands), NO_ELEMENTS},
+    {FanControl::Id, "FanControl", ELEMENTS(FanControl_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {ThermostatUserInterfaceConfiguration::Id, "ThermostatUserInterfaceConfiguration", ELEMENTS(ThermostatUserInterfaceConfiguration_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {ColorControl::Id, "ColorControl", ELEMENTS(ColorControl_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {BallastConfiguration::Id, "BallastConfiguration", ELEMENTS(BallastConfiguration_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {IlluminanceMeasurement::Id, "IlluminanceMeasurement", ELEMENTS(IlluminanceMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {TemperatureMeasurement::Id, "TemperatureMeasurement", ELEMENTS(TemperatureMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {PressureMeasurement::Id, "PressureMeasurement", ELEMENTS(PressureMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {FlowMeasurement::Id, "FlowMeasurement", ELEMENTS(FlowMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {RelativeHumidityMeasurement::Id, "RelativeHumidityMeasurement", ELEMENTS(RelativeHumidityMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {OccupancySensing::Id, "OccupancySensing", ELEMENTS(OccupancySensing_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {CarbonMonoxideConcentrationMeasurement::Id, "CarbonMonoxideConcentrationMeasurement", ELEMENTS(CarbonMonoxideConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {CarbonDioxideConcentrationMeasurement::Id, "CarbonDioxideConcentrationMeasurement", ELEMENTS(CarbonDioxideConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {NitrogenDioxideConcentrationMeasurement::Id, "NitrogenDioxideConcentrationMeasurement", ELEMENTS(NitrogenDioxideConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {OzoneConcentrationMeasurement::Id, "OzoneConcentrationMeasurement", ELEMENTS(OzoneConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {Pm25ConcentrationMeasurement::Id, "Pm25ConcentrationMeasurement", ELEMENTS(Pm25ConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {FormaldehydeConcentrationMeasurement::Id, "FormaldehydeConcentrationMeasurement", ELEMENTS(FormaldehydeConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {Pm1ConcentrationMeasurement::Id, "Pm1ConcentrationMeasurement", ELEMENTS(Pm1ConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {Pm10ConcentrationMeasurement::Id, "Pm10ConcentrationMeasurement", ELEMENTS(Pm10ConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {TotalVolatileOrganicCompoundsConcentrationMeasurement::Id, "TotalVolatileOrganicCompoundsConcentrationMeasurement", ELEMENTS(TotalVolatileOrganicCompoundsConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {RadonConcentrationMeasurement::Id, "RadonConcentrationMeasurement", ELEMENTS(RadonConcentrationMeasurement_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {WakeOnLan::Id, "WakeOnLan", ELEMENTS(WakeOnLan_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {Channel::Id, "Channel", ELEMENTS(Channel_attributes), ELEMENTS(Channel_commands), NO_ELEMENTS},
+    {TargetNavigator::Id, "TargetNavigator", ELEMENTS(TargetNavigator_attributes), ELEMENTS(TargetNavigator_commands), ELEMENTS(TargetNavigator_events)},
+    {MediaPlayback::Id, "MediaPlayback", ELEMENTS(MediaPlayback_attributes), ELEMENTS(MediaPlayback_commands), ELEMENTS(MediaPlayback_events)},
+    {MediaInput::Id, "MediaInput", ELEMENTS(MediaInput_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {LowPower::Id, "LowPower", NO_ELEMENTS, NO_ELEMENTS, NO_ELEMENTS},
+    {KeypadInput::Id, "KeypadInput", NO_ELEMENTS, ELEMENTS(KeypadInput_commands), NO_ELEMENTS},
+    {ContentLauncher::Id, "ContentLauncher", ELEMENTS(ContentLauncher_attributes), ELEMENTS(ContentLauncher_commands), NO_ELEMENTS},
+    {AudioOutput::Id, "AudioOutput", ELEMENTS(AudioOutput_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {ApplicationLauncher::Id, "ApplicationLauncher", ELEMENTS(ApplicationLauncher_attributes), ELEMENTS(ApplicationLauncher_commands), NO_ELEMENTS},
+    {ApplicationBasic::Id, "ApplicationBasic", ELEMENTS(ApplicationBasic_attributes), NO_ELEMENTS, NO_ELEMENTS},
+    {AccountLogin::Id, "AccountLogin", NO_ELEMENTS, ELEMENTS(AccountLogin_commands), ELEMENTS(AccountLogin_events)},
+    {ContentControl::Id, "ContentControl", ELEMENTS(ContentControl_attributes), ELEMENTS(ContentControl_commands), ELEMENTS(ContentControl_events)},
+    {ContentAppObserver::Id, "ContentAppObserver", NO_ELEMENTS, ELEMENTS(ContentAppObserver_commands), NO_ELEMENTS},
+    {ElectricalMeasurement::Id, "ElectricalMeasurement", ELEMENTS(ElectricalMeasurement_attributes), ELEMENTS(ElectricalMeasurement_commands), NO_ELEMENTS},
+    {UnitTesting::Id, "UnitTesting", ELEMENTS(UnitTesting_attributes), ELEMENTS(UnitTesting_commands), ELEMENTS(UnitTesting_events)},
+    {FaultInjection::Id, "FaultInjection", NO_ELEMENTS, NO_ELEMENTS, NO_ELEMENTS},
+    {SampleMei::Id, "SampleMei", ELEMENTS(SampleMei_attributes), ELEMENTS(SampleMei_commands), ELEMENTS(SampleMei_events)},
+};
+const size_t k_cluster_count = sizeof(k_clusters) / sizeof(k_clusters[0]);
+
+} // namespace data_model_logger
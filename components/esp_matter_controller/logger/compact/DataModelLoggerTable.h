@@ -0,0 +1,46 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace data_model_logger {
+
+/** Name of an attribute, a command or an event */
+typedef struct {
+    uint32_t id;
+    const char *name;
+} element_descriptor_t;
+
+/** Names of a cluster and of its elements. The global attributes are in k_global_attributes. */
+typedef struct {
+    uint32_t id;
+    const char *name;
+    const element_descriptor_t *attributes;
+    uint16_t attribute_count;
+    const element_descriptor_t *commands;
+    uint16_t command_count;
+    const element_descriptor_t *events;
+    uint16_t event_count;
+} cluster_descriptor_t;
+
+/* Generated by tools/controller_logger/generate_logger_table.py */
+extern const element_descriptor_t k_global_attributes[];
+extern const size_t k_global_attribute_count;
+extern const cluster_descriptor_t k_clusters[];
+extern const size_t k_cluster_count;
+
+} // namespace data_model_logger
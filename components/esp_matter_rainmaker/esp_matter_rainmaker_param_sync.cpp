@@ -0,0 +1,312 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <esp_matter.h>
+#include <esp_matter_mem.h>
+#include <esp_matter_rainmaker_param_sync.h>
+#include <platform/CHIPDeviceLayer.h>
+
+static const char *TAG = "esp_matter_rainmaker";
+
+namespace esp_matter {
+namespace rainmaker {
+namespace param_sync {
+
+static constexpr uint32_t k_window_ms = CONFIG_ESP_MATTER_RAINMAKER_PARAM_SYNC_WINDOW_MS;
+
+typedef struct binding {
+    esp_rmaker_param_t *param;
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    esp_matter_val_type_t type;
+    /* Write from RainMaker, applied at the end of the window. A later write of the param replaces it. */
+    bool write_pending;
+    esp_matter_attr_val_t write_val;
+} binding_t;
+
+static binding_t *s_bindings = NULL;
+static size_t s_binding_count = 0;
+/* The writes are queued by the RainMaker task and applied by the Matter task */
+static portMUX_TYPE s_write_lock = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t s_report_timer = NULL;
+static esp_timer_handle_t s_write_timer = NULL;
+/* Param of the last change, reporting it publishes all the params updated since the last report */
+static const esp_rmaker_param_t *volatile s_report_param = NULL;
+
+static binding_t *find_attribute(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    for (size_t idx = 0; idx < s_binding_count; ++idx) {
+        if (s_bindings[idx].endpoint_id == endpoint_id && s_bindings[idx].cluster_id == cluster_id &&
+            s_bindings[idx].attribute_id == attribute_id) {
+            return &s_bindings[idx];
+        }
+    }
+    return NULL;
+}
+
+static binding_t *find_param(const esp_rmaker_param_t *param)
+{
+    for (size_t idx = 0; idx < s_binding_count; ++idx) {
+        if (s_bindings[idx].param == param) {
+            return &s_bindings[idx];
+        }
+    }
+    return NULL;
+}
+
+static bool is_supported(esp_matter_val_type_t type)
+{
+    switch (type) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+    case ESP_MATTER_VAL_TYPE_INT8:
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_INT16:
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_INT32:
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_INT64:
+    case ESP_MATTER_VAL_TYPE_UINT64:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static esp_rmaker_param_val_t to_param_val(const esp_matter_attr_val_t *val)
+{
+    switch (val->type) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN: return esp_rmaker_bool(val->val.b);
+    case ESP_MATTER_VAL_TYPE_INTEGER: return esp_rmaker_int(val->val.i);
+    case ESP_MATTER_VAL_TYPE_FLOAT: return esp_rmaker_float(val->val.f);
+    case ESP_MATTER_VAL_TYPE_INT8: return esp_rmaker_int(val->val.i8);
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8: return esp_rmaker_int(val->val.u8);
+    case ESP_MATTER_VAL_TYPE_INT16: return esp_rmaker_int(val->val.i16);
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16: return esp_rmaker_int(val->val.u16);
+    case ESP_MATTER_VAL_TYPE_INT32: return esp_rmaker_int(val->val.i32);
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32: return esp_rmaker_int((int)val->val.u32);
+    case ESP_MATTER_VAL_TYPE_INT64: return esp_rmaker_int((int)val->val.i64);
+    case ESP_MATTER_VAL_TYPE_UINT64: return esp_rmaker_int((int)val->val.u64);
+    default: return esp_rmaker_int(0);
+    }
+}
+
+static esp_err_t to_attr_val(esp_matter_val_type_t type, const esp_rmaker_param_val_t *param_val,
+                             esp_matter_attr_val_t *val)
+{
+    int64_t value = 0;
+    float float_value = 0;
+    switch (param_val->type) {
+    case RMAKER_VAL_TYPE_BOOLEAN:
+        value = param_val->val.b;
+        float_value = param_val->val.b;
+        break;
+    case RMAKER_VAL_TYPE_INTEGER:
+        value = param_val->val.i;
+        float_value = param_val->val.i;
+        break;
+    case RMAKER_VAL_TYPE_FLOAT:
+        value = (int64_t)param_val->val.f;
+        float_value = param_val->val.f;
+        break;
+    default:
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    switch (type) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN: *val = esp_matter_bool(value != 0); break;
+    case ESP_MATTER_VAL_TYPE_INTEGER: *val = esp_matter_int((int)value); break;
+    case ESP_MATTER_VAL_TYPE_FLOAT: *val = esp_matter_float(float_value); break;
+    case ESP_MATTER_VAL_TYPE_INT8: *val = esp_matter_int8((int8_t)value); break;
+    case ESP_MATTER_VAL_TYPE_UINT8: *val = esp_matter_uint8((uint8_t)value); break;
+    case ESP_MATTER_VAL_TYPE_INT16: *val = esp_matter_int16((int16_t)value); break;
+    case ESP_MATTER_VAL_TYPE_UINT16: *val = esp_matter_uint16((uint16_t)value); break;
+    case ESP_MATTER_VAL_TYPE_INT32: *val = esp_matter_int32((int32_t)value); break;
+    case ESP_MATTER_VAL_TYPE_UINT32: *val = esp_matter_uint32((uint32_t)value); break;
+    case ESP_MATTER_VAL_TYPE_INT64: *val = esp_matter_int64(value); break;
+    case ESP_MATTER_VAL_TYPE_UINT64: *val = esp_matter_uint64((uint64_t)value); break;
+    case ESP_MATTER_VAL_TYPE_ENUM8: *val = esp_matter_enum8((uint8_t)value); break;
+    case ESP_MATTER_VAL_TYPE_ENUM16: *val = esp_matter_enum16((uint16_t)value); break;
+    case ESP_MATTER_VAL_TYPE_BITMAP8: *val = esp_matter_bitmap8((uint8_t)value); break;
+    case ESP_MATTER_VAL_TYPE_BITMAP16: *val = esp_matter_bitmap16((uint16_t)value); break;
+    case ESP_MATTER_VAL_TYPE_BITMAP32: *val = esp_matter_bitmap32((uint32_t)value); break;
+    default: return ESP_ERR_NOT_SUPPORTED;
+    }
+    return ESP_OK;
+}
+
+static void report_timer_cb(void *arg)
+{
+    const esp_rmaker_param_t *param = s_report_param;
+    s_report_param = NULL;
+    if (param) {
+        /* All the params updated since the last report go out in the same params update */
+        esp_rmaker_param_report(param);
+    }
+}
+
+/* In the Matter context */
+static void apply_writes(intptr_t arg)
+{
+    size_t count = 0;
+    taskENTER_CRITICAL(&s_write_lock);
+    for (size_t idx = 0; idx < s_binding_count; ++idx) {
+        count += s_bindings[idx].write_pending ? 1 : 0;
+    }
+    taskEXIT_CRITICAL(&s_write_lock);
+    if (count == 0) {
+        return;
+    }
+    attribute::batch_entry_t *entries =
+        (attribute::batch_entry_t *)esp_matter_mem_calloc(count, sizeof(attribute::batch_entry_t));
+    if (!entries) {
+        ESP_LOGE(TAG, "Couldn't allocate the batch of %u param writes", (unsigned)count);
+        return;
+    }
+    size_t used = 0;
+    taskENTER_CRITICAL(&s_write_lock);
+    for (size_t idx = 0; idx < s_binding_count && used < count; ++idx) {
+        binding_t *binding = &s_bindings[idx];
+        if (binding->write_pending) {
+            binding->write_pending = false;
+            entries[used++] = {binding->endpoint_id, binding->cluster_id, binding->attribute_id, binding->write_val};
+        }
+    }
+    taskEXIT_CRITICAL(&s_write_lock);
+    if (attribute::update_batch(entries, used) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to apply some of the %u param writes", (unsigned)used);
+    }
+    esp_matter_mem_free(entries);
+}
+
+static void write_timer_cb(void *arg)
+{
+    chip::DeviceLayer::PlatformMgr().ScheduleWork(apply_writes);
+}
+
+static esp_err_t create_timers()
+{
+    if (s_report_timer) {
+        return ESP_OK;
+    }
+    esp_timer_create_args_t report_args = {};
+    report_args.callback = report_timer_cb;
+    report_args.name = "rmaker_report";
+    ESP_RETURN_ON_ERROR(esp_timer_create(&report_args, &s_report_timer), TAG, "Failed to create the report timer");
+    esp_timer_create_args_t write_args = {};
+    write_args.callback = write_timer_cb;
+    write_args.name = "rmaker_write";
+    esp_err_t err = esp_timer_create(&write_args, &s_write_timer);
+    if (err != ESP_OK) {
+        esp_timer_delete(s_report_timer);
+        s_report_timer = NULL;
+        ESP_LOGE(TAG, "Failed to create the write timer");
+    }
+    return err;
+}
+
+esp_err_t bind(esp_rmaker_param_t *param, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    ESP_RETURN_ON_FALSE(param, ESP_ERR_INVALID_ARG, TAG, "Param cannot be NULL");
+    attribute_t *attribute = attribute::get(cluster::get(endpoint::get(node::get(), endpoint_id), cluster_id),
+                                            attribute_id);
+    ESP_RETURN_ON_FALSE(attribute, ESP_ERR_NOT_FOUND, TAG, "Attribute 0x%08" PRIx32 " not found", attribute_id);
+    esp_matter_attr_val_t val = esp_matter_invalid(NULL);
+    attribute::get_val(attribute, &val);
+    ESP_RETURN_ON_FALSE(is_supported(val.type), ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Only the non-nullable numeric attributes can be synchronized");
+    ESP_RETURN_ON_FALSE(!find_param(param) && !find_attribute(endpoint_id, cluster_id, attribute_id),
+                        ESP_ERR_INVALID_STATE, TAG, "Param or attribute already bound");
+    ESP_RETURN_ON_ERROR(create_timers(), TAG, "Failed to create the timers");
+
+    binding_t *bindings = (binding_t *)esp_matter_mem_realloc(s_bindings, (s_binding_count + 1) * sizeof(binding_t));
+    ESP_RETURN_ON_FALSE(bindings, ESP_ERR_NO_MEM, TAG, "Couldn't allocate the param binding");
+    /* The writes only look at the array under the lock */
+    taskENTER_CRITICAL(&s_write_lock);
+    s_bindings = bindings;
+    s_bindings[s_binding_count] = {param, endpoint_id, cluster_id, attribute_id, val.type, false, {}};
+    s_binding_count++;
+    taskEXIT_CRITICAL(&s_write_lock);
+    return ESP_OK;
+}
+
+esp_err_t attribute_updated(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                            const esp_matter_attr_val_t *val)
+{
+    binding_t *binding = find_attribute(endpoint_id, cluster_id, attribute_id);
+    if (!binding) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    ESP_RETURN_ON_FALSE(val && val->type == binding->type, ESP_ERR_INVALID_ARG, TAG, "Invalid attribute value");
+    if (k_window_ms == 0) {
+        return esp_rmaker_param_update_and_report(binding->param, to_param_val(val));
+    }
+    /* Only the value is updated now, the report of the window publishes it with the other changes */
+    ESP_RETURN_ON_ERROR(esp_rmaker_param_update(binding->param, to_param_val(val)), TAG, "Failed to update the param");
+    s_report_param = binding->param;
+    if (!esp_timer_is_active(s_report_timer)) {
+        esp_timer_start_once(s_report_timer, k_window_ms * 1000);
+    }
+    return ESP_OK;
+}
+
+esp_err_t write_cb(const esp_rmaker_device_t *device, const esp_rmaker_param_t *param,
+                   const esp_rmaker_param_val_t val, void *priv_data, esp_rmaker_write_ctx_t *ctx)
+{
+    taskENTER_CRITICAL(&s_write_lock);
+    binding_t *binding = find_param(param);
+    esp_matter_attr_val_t attr_val = {};
+    esp_err_t err = binding ? to_attr_val(binding->type, &val, &attr_val) : ESP_ERR_NOT_FOUND;
+    uint16_t endpoint_id = binding ? binding->endpoint_id : 0;
+    uint32_t cluster_id = binding ? binding->cluster_id : 0;
+    uint32_t attribute_id = binding ? binding->attribute_id : 0;
+    if (err == ESP_OK && k_window_ms > 0) {
+        binding->write_val = attr_val;
+        binding->write_pending = true;
+    }
+    taskEXIT_CRITICAL(&s_write_lock);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (k_window_ms == 0) {
+        return attribute::update(endpoint_id, cluster_id, attribute_id, &attr_val);
+    }
+    /* The params of a RainMaker batch are written one after the other, they are applied together */
+    if (!esp_timer_is_active(s_write_timer)) {
+        esp_timer_start_once(s_write_timer, k_window_ms * 1000);
+    }
+    return ESP_OK;
+}
+
+} /* param_sync */
+} /* rainmaker */
+} /* esp_matter */
@@ -0,0 +1,82 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter.h>
+#include <esp_rmaker_core.h>
+
+namespace esp_matter {
+namespace rainmaker {
+namespace param_sync {
+
+/*
+ * Batched synchronization of RainMaker params with Matter attributes.
+ *
+ * A bound param follows the value of its attribute. The attribute changes are applied to the params with
+ * esp_rmaker_param_update() and published together, in a single params update, at the end of a window of
+ * CONFIG_ESP_MATTER_RAINMAKER_PARAM_SYNC_WINDOW_MS started by the first change. The params written from RainMaker
+ * within the same window are coalesced, and applied together to the attributes with attribute::update_batch() in the
+ * Matter context.
+ *
+ * Only the boolean, integer and floating point values are synchronized, without conversion. The applications which
+ * need to scale a value, like a level to a brightness percentage, keep their own param handling for it.
+ */
+
+/** Bind a RainMaker param to a Matter attribute
+ *
+ * The device of the param must use `param_sync::write_cb()` as its write callback, or call it from its own one.
+ *
+ * @param[in] param RainMaker param handle.
+ * @param[in] endpoint_id Endpoint ID of the attribute.
+ * @param[in] cluster_id Cluster ID of the attribute.
+ * @param[in] attribute_id Attribute ID of the attribute.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t bind(esp_rmaker_param_t *param, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+/** Notify an attribute change
+ *
+ * Call it from the attribute callback of the application, on `POST_UPDATE`. Nothing is done if the attribute is not
+ * bound.
+ *
+ * @param[in] endpoint_id Endpoint ID of the attribute.
+ * @param[in] cluster_id Cluster ID of the attribute.
+ * @param[in] attribute_id Attribute ID of the attribute.
+ * @param[in] val New value of the attribute.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the attribute is not bound.
+ * @return error in case of failure.
+ */
+esp_err_t attribute_updated(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                            const esp_matter_attr_val_t *val);
+
+/** RainMaker device write callback
+ *
+ * Queue the write of a bound param, the writes of the window are applied to the attributes together.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if the param is not bound.
+ * @return error in case of failure.
+ */
+esp_err_t write_cb(const esp_rmaker_device_t *device, const esp_rmaker_param_t *param,
+                   const esp_rmaker_param_val_t val, void *priv_data, esp_rmaker_write_ctx_t *ctx);
+
+} /* param_sync */
+} /* rainmaker */
+} /* esp_matter */
@@ -14,6 +14,12 @@
 
 #include <esp_matter_thread_br_console.h>
 #include <esp_matter_thread_br_launcher.h>
+#if CONFIG_OPENTHREAD_BR_SRP_COALESCED_PUBLISH
+#include <esp_matter_thread_br_srp_publisher.h>
+#endif
+#include <esp_matter_thread_br_telemetry.h>
+#include <inttypes.h>
+#include <stdlib.h>
 
 namespace esp_matter {
 namespace console {
@@ -46,5 +52,89 @@ esp_err_t thread_br_cli_register_command()
     return add_commands(&command, 1);
 }
 
+static esp_err_t thread_br_telemetry_handler(int argc, char **argv)
+{
+    if (argc >= 1 && strcmp(argv[0], "start") == 0) {
+        uint32_t interval_ms = argc >= 2 ? strtoul(argv[1], NULL, 10) : 1000;
+        return thread_br_telemetry::start(interval_ms);
+    } else if (argc == 1 && strcmp(argv[0], "stop") == 0) {
+        return thread_br_telemetry::stop();
+    } else if (argc >= 1 && strcmp(argv[0], "dump") == 0) {
+        size_t max_count = argc >= 2 ? strtoul(argv[1], NULL, 10) : CONFIG_OPENTHREAD_BR_TELEMETRY_SAMPLE_COUNT;
+        if (max_count == 0 || max_count > CONFIG_OPENTHREAD_BR_TELEMETRY_SAMPLE_COUNT) {
+            max_count = CONFIG_OPENTHREAD_BR_TELEMETRY_SAMPLE_COUNT;
+        }
+        thread_br_telemetry::sample_t *samples =
+            (thread_br_telemetry::sample_t *)calloc(max_count, sizeof(thread_br_telemetry::sample_t));
+        if (!samples) {
+            return ESP_ERR_NO_MEM;
+        }
+        size_t count = thread_br_telemetry::get_samples(samples, max_count);
+        // The newest samples are the last ones of the ring
+        for (size_t idx = 0; idx < count; ++idx) {
+            const thread_br_telemetry::sample_t &sample = samples[idx];
+            printf("THREAD_BR_TELEMETRY {\"t_us\":%" PRId64 ",\"rcp_latency_us\":%" PRIu32 ",\"tx_fps\":%" PRIu32
+                   ",\"rx_fps\":%" PRIu32 ",\"radio_busy\":%.1f,\"ot_load\":%d,\"br_in\":%" PRIu64
+                   ",\"br_out\":%" PRIu64 ",\"nat64_4to6\":%" PRIu64 ",\"nat64_6to4\":%" PRIu64 "}\n",
+                   sample.timestamp_us, sample.rcp_latency_us, sample.tx_frames_per_sec, sample.rx_frames_per_sec,
+                   sample.radio_busy_ratio * 100.0 / 0xFFFF,
+                   sample.ot_task_load == THREAD_BR_TELEMETRY_LOAD_UNAVAILABLE ? -1 : sample.ot_task_load,
+                   sample.br_inbound_packets, sample.br_outbound_packets, sample.nat64_4to6_packets,
+                   sample.nat64_6to4_packets);
+        }
+        free(samples);
+        return ESP_OK;
+    }
+    printf("Usage: matter esp ot_telemetry start [interval_ms] | stop | dump [count]\n");
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t thread_br_telemetry_register_command()
+{
+    static const command_t command = {
+        .name = "ot_telemetry",
+        .description = "Thread Border Router telemetry. Usage: matter esp ot_telemetry start [interval_ms] | stop | "
+                       "dump [count].",
+        .handler = thread_br_telemetry_handler,
+    };
+
+    return add_commands(&command, 1);
+}
+
+#if CONFIG_OPENTHREAD_BR_SRP_COALESCED_PUBLISH
+static esp_err_t thread_br_srp_publish_handler(int argc, char **argv)
+{
+    if (argc == 1 && strcmp(argv[0], "reset") == 0) {
+        thread_br_srp_publisher::reset_stats();
+        return ESP_OK;
+    } else if (argc == 0 || (argc == 1 && strcmp(argv[0], "stats") == 0)) {
+        thread_br_srp_publisher::stats_t stats;
+        thread_br_srp_publisher::get_stats(&stats);
+        uint32_t publications = stats.published + stats.failed;
+        printf("THREAD_BR_SRP_PUBLISH {\"updates\":%" PRIu32 ",\"coalesced\":%" PRIu32 ",\"published\":%" PRIu32
+               ",\"failed\":%" PRIu32 ",\"expired\":%" PRIu32 ",\"batches\":%" PRIu32 ",\"queue_depth\":%u"
+               ",\"max_queue_depth\":%u,\"last_latency_ms\":%" PRIu32 ",\"max_latency_ms\":%" PRIu32
+               ",\"avg_latency_ms\":%" PRIu64 "}\n",
+               stats.updates, stats.coalesced, stats.published, stats.failed, stats.expired, stats.batches,
+               stats.queue_depth, stats.max_queue_depth, stats.last_latency_ms, stats.max_latency_ms,
+               publications ? stats.total_latency_ms / publications : 0);
+        return ESP_OK;
+    }
+    printf("Usage: matter esp ot_srp_publish [stats] | reset\n");
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t thread_br_srp_publish_register_command()
+{
+    static const command_t command = {
+        .name = "ot_srp_publish",
+        .description = "Coalesced SRP publisher metrics. Usage: matter esp ot_srp_publish [stats] | reset.",
+        .handler = thread_br_srp_publish_handler,
+    };
+
+    return add_commands(&command, 1);
+}
+#endif // CONFIG_OPENTHREAD_BR_SRP_COALESCED_PUBLISH
+
 } // namespace console
 } // namespace esp_matter
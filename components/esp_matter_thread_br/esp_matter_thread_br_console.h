@@ -20,5 +20,28 @@ namespace console {
 
 esp_err_t thread_br_cli_register_command();
 
+/** Register the `matter esp ot_telemetry` command
+ *
+ * It starts and stops the sampling of the Thread Border Router telemetry, and dumps the samples as
+ * `THREAD_BR_TELEMETRY` JSON lines, with the radio busy ratio in percent and the load of the OpenThread task in
+ * percent of a core, -1 if it is not available.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t thread_br_telemetry_register_command();
+
+#if CONFIG_OPENTHREAD_BR_SRP_COALESCED_PUBLISH
+/** Register the `matter esp ot_srp_publish` command
+ *
+ * It prints the metrics of the coalesced SRP publisher as a `THREAD_BR_SRP_PUBLISH` JSON line, with the queue depth
+ * and the publish latencies, or resets them.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t thread_br_srp_publish_register_command();
+#endif
+
 } // namespace console
 } // namespace esp_matter
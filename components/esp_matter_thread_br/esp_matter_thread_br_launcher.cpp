@@ -14,6 +14,9 @@
 
 #include <esp_check.h>
 #include <esp_matter_thread_br_launcher.h>
+#if CONFIG_OPENTHREAD_BR_SRP_COALESCED_PUBLISH
+#include <esp_matter_thread_br_srp_publisher.h>
+#endif
 #include <esp_netif.h>
 #include <esp_openthread_border_router.h>
 #include <esp_openthread_cli.h>
@@ -21,10 +24,15 @@
 #include <esp_openthread_netif_glue.h>
 #include <esp_openthread_types.h>
 #if CONFIG_OPENTHREAD_BR_AUTO_UPDATE_RCP
+#include <dirent.h>
 #include <esp_spiffs.h>
+#include <esp_timer.h>
+#include <sys/stat.h>
 #endif
 #include <esp_vfs_dev.h>
 #include <esp_vfs_eventfd.h>
+#include <freertos/ringbuf.h>
+#include <inttypes.h>
 #include <memory>
 #include <string.h>
 
@@ -32,6 +40,8 @@
 #include <openthread/logging.h>
 
 #define TAG "thread_br_launcher"
+#define THREAD_BR_TASK_CORE_ID \
+    (CONFIG_OPENTHREAD_BR_TASK_CORE_ID < 0 ? tskNO_AFFINITY : CONFIG_OPENTHREAD_BR_TASK_CORE_ID)
 
 namespace esp_matter {
 
@@ -42,61 +52,216 @@ public:
 };
 
 #if CONFIG_OPENTHREAD_CLI
+/* Time the OpenThread task waits for room in the output ring, before the output is dropped */
+#define CLI_OUTPUT_SEND_TIMEOUT_MS 100
+/* Written to the output ring when the prompt is printed, it ends the output of the running command */
+#define CLI_OUTPUT_END_MARKER '\0'
+
+/* Command in the input ring, followed by its NULL terminated command line */
+typedef struct {
+    cli_output_cb_t output_cb;
+    cli_done_cb_t done_cb;
+    void *ctx;
+} cli_session_t;
+
 static TaskHandle_t cli_transmit_task = NULL;
-static QueueHandle_t cli_transmit_task_queue = NULL;
+static RingbufHandle_t cli_input_ring = NULL;
+static RingbufHandle_t cli_output_ring = NULL;
+static volatile uint32_t cli_dropped_output = 0;
+
+static void console_output(const char *data, size_t len, void *ctx)
+{
+    fwrite(data, 1, len, stdout);
+}
 
+static void cli_output_write(const char *data, size_t len)
+{
+    if (xRingbufferSend(cli_output_ring, data, len, pdMS_TO_TICKS(CLI_OUTPUT_SEND_TIMEOUT_MS)) != pdTRUE) {
+        cli_dropped_output += len;
+    }
+    xTaskNotifyGive(cli_transmit_task);
+}
+
+/* Called in the OpenThread task, the output is formatted once and streamed to the CLI worker */
 static int cli_output_callback(void *context, const char *format, va_list args)
 {
-    int ret = 0;
-    char prompt_check[3];
-    vsnprintf(prompt_check, sizeof(prompt_check), format, args);
-    if (!strncmp(prompt_check, "> ", sizeof(prompt_check))) {
-        if (cli_transmit_task) {
-            xTaskNotifyGive(cli_transmit_task);
+    /* Only used in the OpenThread task */
+    static char line[OPENTHREAD_CLI_BUFFER_LENGTH + 1];
+    va_list args_copy;
+    va_copy(args_copy, args);
+    int len = vsnprintf(line, sizeof(line), format, args);
+    char *output = line;
+    if (len >= (int)sizeof(line)) {
+        // The outputs longer than a line are formatted again in an allocated buffer, instead of being truncated
+        output = (char *)malloc(len + 1);
+        if (output) {
+            vsnprintf(output, len + 1, format, args_copy);
+        } else {
+            output = line;
+            len = sizeof(line) - 1;
         }
-    } else {
-        ret = vprintf(format, args);
     }
-    return ret;
+    va_end(args_copy);
+    if (len > 0) {
+        if (!cli_transmit_task) {
+            fwrite(output, 1, len, stdout);
+        } else if (len == 2 && !strncmp(output, "> ", 2)) {
+            const char marker = CLI_OUTPUT_END_MARKER;
+            cli_output_write(&marker, 1);
+        } else {
+            cli_output_write(output, len);
+        }
+    }
+    if (output != line) {
+        free(output);
+    }
+    return len;
 }
 
 static void cli_transmit_worker(void *context)
 {
-    cli_transmit_task_queue = xQueueCreate(4, sizeof(ot_cli_buffer_t));
-    if (!cli_transmit_task_queue) {
-        vTaskDelete(NULL);
-        return;
-    }
+    static const cli_session_t console_session = {.output_cb = console_output, .done_cb = NULL, .ctx = NULL};
+    cli_session_t running_session;
+    const cli_session_t *session = NULL;
     while (true) {
-        ot_cli_buffer_t buffer;
-        if (xQueueReceive(cli_transmit_task_queue, &buffer, portMAX_DELAY) == pdTRUE) {
-            esp_openthread_cli_input(buffer.buf);
-            xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t dropped = cli_dropped_output;
+        if (dropped > 0) {
+            cli_dropped_output -= dropped;
+            ESP_LOGW(TAG, "%" PRIu32 " bytes of the CLI output were dropped", dropped);
+        }
+        // The output is sent to the session from the ring, without copies
+        size_t size = 0;
+        char *data = NULL;
+        while ((data = (char *)xRingbufferReceive(cli_output_ring, &size, 0)) != NULL) {
+            size_t offset = 0;
+            while (offset < size) {
+                // The output between two commands, such as the ping replies, goes to the console
+                const cli_session_t *sink = session ? session : &console_session;
+                char *marker = (char *)memchr(data + offset, CLI_OUTPUT_END_MARKER, size - offset);
+                size_t len = marker ? marker - (data + offset) : size - offset;
+                if (len > 0) {
+                    sink->output_cb(data + offset, len, sink->ctx);
+                }
+                offset += len;
+                if (marker) {
+                    offset++;
+                    if (session && session->done_cb) {
+                        session->done_cb(session->ctx);
+                    }
+                    session = NULL;
+                }
+            }
+            vRingbufferReturnItem(cli_output_ring, data);
+        }
+        // The next command is sent once the prompt of the running one is printed
+        while (!session) {
+            char *item = (char *)xRingbufferReceive(cli_input_ring, &size, 0);
+            if (!item) {
+                break;
+            }
+            memcpy(&running_session, item, sizeof(running_session));
+            esp_err_t err = esp_openthread_cli_input(item + sizeof(cli_session_t));
+            vRingbufferReturnItem(cli_input_ring, item);
+            if (err == ESP_OK) {
+                session = &running_session;
+            } else {
+                ESP_LOGE(TAG, "Failed to input the CLI command: %s", esp_err_to_name(err));
+                if (running_session.done_cb) {
+                    running_session.done_cb(running_session.ctx);
+                }
+            }
         }
     }
 }
 
-esp_err_t cli_transmit_task_post(ot_cli_buffer_t &cli_buf)
+static esp_err_t cli_transmit_init()
 {
-    if (!cli_transmit_task_queue || xQueueSend(cli_transmit_task_queue, &cli_buf, portMAX_DELAY) != pdTRUE) {
-        return ESP_FAIL;
+    cli_input_ring = xRingbufferCreate(CONFIG_OPENTHREAD_BR_CLI_INPUT_RING_SIZE, RINGBUF_TYPE_NOSPLIT);
+    cli_output_ring = xRingbufferCreate(CONFIG_OPENTHREAD_BR_CLI_OUTPUT_RING_SIZE, RINGBUF_TYPE_BYTEBUF);
+    if (!cli_input_ring || !cli_output_ring ||
+        xTaskCreatePinnedToCore(cli_transmit_worker, "ot_cli_task", 3072, NULL, 5, &cli_transmit_task,
+                                THREAD_BR_TASK_CORE_ID) != pdTRUE) {
+        ESP_LOGE(TAG, "Failed to create the CLI transport, the CLI output is printed directly");
+        return ESP_ERR_NO_MEM;
     }
     return ESP_OK;
 }
+
+esp_err_t cli_transmit_task_post_async(const char *command, cli_output_cb_t output_cb, cli_done_cb_t done_cb,
+                                       void *ctx)
+{
+    ESP_RETURN_ON_FALSE(command && output_cb, ESP_ERR_INVALID_ARG, TAG, "command and output_cb cannot be NULL");
+    ESP_RETURN_ON_FALSE(cli_transmit_task, ESP_ERR_INVALID_STATE, TAG, "The CLI transport is not initialized");
+    size_t len = strlen(command) + 1;
+    void *item = NULL;
+    ESP_RETURN_ON_FALSE(xRingbufferSendAcquire(cli_input_ring, &item, sizeof(cli_session_t) + len, portMAX_DELAY) ==
+                            pdTRUE,
+                        ESP_ERR_NO_MEM, TAG, "The CLI command does not fit in the input ring");
+    cli_session_t session = {.output_cb = output_cb, .done_cb = done_cb, .ctx = ctx};
+    memcpy(item, &session, sizeof(session));
+    memcpy((char *)item + sizeof(session), command, len);
+    xRingbufferSendComplete(cli_input_ring, item);
+    xTaskNotifyGive(cli_transmit_task);
+    return ESP_OK;
+}
+
+esp_err_t cli_transmit_task_post(ot_cli_buffer_t &cli_buf)
+{
+    cli_buf.buf[OPENTHREAD_CLI_BUFFER_LENGTH] = '\0';
+    return cli_transmit_task_post_async(cli_buf.buf, console_output, NULL, NULL);
+}
 #endif // CONFIG_OPENTHREAD_CLI
 
 #if CONFIG_OPENTHREAD_BR_AUTO_UPDATE_RCP
 #define RCP_VERSION_MAX_SIZE 100
 
+#define RCP_FIRMWARE_PATH_MAX_SIZE 64
+
+/* Size of the RCP image being flashed, the sum of the files of its firmware directory */
+static size_t get_rcp_image_size(void)
+{
+    char path[RCP_FIRMWARE_PATH_MAX_SIZE];
+    snprintf(path, sizeof(path), "%s_%d", esp_rcp_get_firmware_dir(), esp_rcp_get_update_seq());
+    DIR *dir = opendir(path);
+    if (!dir) {
+        return 0;
+    }
+    size_t size = 0;
+    size_t dir_len = strlen(path);
+    struct dirent *entry = NULL;
+    while ((entry = readdir(dir)) != NULL) {
+        struct stat file_stat;
+        snprintf(path + dir_len, sizeof(path) - dir_len, "/%s", entry->d_name);
+        if (stat(path, &file_stat) == 0 && S_ISREG(file_stat.st_mode)) {
+            size += file_stat.st_size;
+        }
+        path[dir_len] = '\0';
+    }
+    closedir(dir);
+    return size;
+}
+
 static void update_rcp(void)
 {
     // Deinit uart to transfer UART to the serial loader
     esp_openthread_rcp_deinit();
-    if (esp_rcp_update() == ESP_OK) {
-        esp_rcp_mark_image_verified(true);
-    } else {
-        esp_rcp_mark_image_verified(false);
+    size_t image_size = get_rcp_image_size();
+    esp_err_t err = ESP_FAIL;
+    // A transfer error is retried with the same image, before it is marked as not verified and the next one is tried
+    for (int attempt = 0; attempt <= CONFIG_OPENTHREAD_BR_RCP_UPDATE_RETRY_COUNT && err != ESP_OK; ++attempt) {
+        if (attempt > 0) {
+            ESP_LOGW(TAG, "RCP update failed, retry %d/%d", attempt, CONFIG_OPENTHREAD_BR_RCP_UPDATE_RETRY_COUNT);
+        }
+        int64_t start_us = esp_timer_get_time();
+        err = esp_rcp_update();
+        int64_t elapsed_ms = (esp_timer_get_time() - start_us) / 1000;
+        if (err == ESP_OK) {
+            ESP_LOGI(TAG, "RCP updated in %" PRId64 " ms, %u bytes, %" PRId64 " bytes/s", elapsed_ms,
+                     (unsigned)image_size, elapsed_ms > 0 ? (int64_t)image_size * 1000 / elapsed_ms : 0);
+        }
     }
+    esp_rcp_mark_image_verified(err == ESP_OK);
     esp_restart();
 }
 
@@ -130,7 +295,14 @@ static void rcp_failure_handler(void)
 
 esp_err_t thread_rcp_update_init(const esp_rcp_update_config_t *update_config)
 {
+    ESP_RETURN_ON_FALSE(update_config, ESP_ERR_INVALID_ARG, TAG, "update_config cannot be NULL");
+#if CONFIG_OPENTHREAD_BR_RCP_UPDATE_BAUDRATE > 0
+    esp_rcp_update_config_t config = *update_config;
+    config.update_baudrate = CONFIG_OPENTHREAD_BR_RCP_UPDATE_BAUDRATE;
+    return esp_rcp_update_init(&config);
+#else
     return esp_rcp_update_init(update_config);
+#endif
 }
 
 #endif // CONFIG_OPENTHREAD_BR_AUTO_UPDATE_RCP
@@ -161,6 +333,11 @@ static void ot_task_worker(void *aContext)
     (void)otLoggingSetLevel(CONFIG_LOG_DEFAULT_LEVEL);
 #endif
     otInstance *instance = esp_openthread_get_instance();
+#if CONFIG_OPENTHREAD_BR_SRP_COALESCED_PUBLISH
+    if (thread_br_srp_publisher::init(instance) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start the coalesced SRP publisher");
+    }
+#endif
     if (otDatasetIsCommissioned(instance)) {
         (void)otIp6SetEnabled(instance, true);
         (void)otThreadSetEnabled(instance, true);
@@ -169,7 +346,7 @@ static void ot_task_worker(void *aContext)
     free(config);
 
 #if CONFIG_OPENTHREAD_CLI
-    xTaskCreate(cli_transmit_worker, "ot_cli_task", 3072, NULL, 5, &cli_transmit_task);
+    cli_transmit_init();
 #endif
     esp_openthread_launch_mainloop();
     // Clean up
@@ -218,7 +395,8 @@ esp_err_t thread_br_init(esp_openthread_platform_config_t *config)
         return ESP_ERR_NO_MEM;
     }
     memcpy(config_copy, config, sizeof(esp_openthread_platform_config_t));
-    if (xTaskCreate(ot_task_worker, "ot_br", 8192, config_copy, 5, NULL) != pdTRUE) {
+    if (xTaskCreatePinnedToCore(ot_task_worker, "ot_br", 8192, config_copy, 5, NULL, THREAD_BR_TASK_CORE_ID) !=
+        pdTRUE) {
         free(config_copy);
         return ESP_FAIL;
     }
@@ -42,5 +42,43 @@ esp_err_t get_thread_dataset_tlvs(otOperationalDatasetTlvs *dataset_tlvs);
 
 uint8_t get_thread_role();
 
+/** Callback receiving the output of a CLI command, in the CLI task
+ *
+ * @param[in] data Output, not NULL terminated. It is only valid during the call.
+ * @param[in] len Length of the output.
+ * @param[in] ctx Context of the session.
+ */
+typedef void (*cli_output_cb_t)(const char *data, size_t len, void *ctx);
+
+/** Callback called in the CLI task when the command is done, after its last output
+ *
+ * @param[in] ctx Context of the session.
+ */
+typedef void (*cli_done_cb_t)(void *ctx);
+
+/** Send a command to the OpenThread CLI, with its output printed to the console
+ *
+ * @param[in] cli_buf Command line.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
 esp_err_t cli_transmit_task_post(ot_cli_buffer_t &cli_buf);
+
+/** Send a command to the OpenThread CLI, with its output streamed to a callback
+ *
+ * The commands are run one after the other, the function returns once the command is queued. The output of the
+ * command is streamed to output_cb as it is printed, without truncation, until the CLI prompt is printed again and
+ * done_cb is called. It can be used to run remote CLI sessions, with the output sent back over Matter.
+ *
+ * @param[in] command NULL terminated command line, it is copied.
+ * @param[in] output_cb Callback receiving the output.
+ * @param[in] done_cb Callback called when the command is done, can be NULL.
+ * @param[in] ctx Context passed to the callbacks.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t cli_transmit_task_post_async(const char *command, cli_output_cb_t output_cb, cli_done_cb_t done_cb,
+                                       void *ctx);
 }
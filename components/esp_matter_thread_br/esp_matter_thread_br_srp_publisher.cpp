@@ -0,0 +1,370 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <esp_check.h>
+#include <esp_matter_thread_br_srp_publisher.h>
+#include <esp_openthread_lock.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <mdns.h>
+#include <memory>
+#include <string.h>
+
+#include <openthread/dns.h>
+#include <openthread/srp_server.h>
+
+#define TAG "thread_br_srp_publisher"
+#define THREAD_BR_TASK_CORE_ID \
+    (CONFIG_OPENTHREAD_BR_TASK_CORE_ID < 0 ? tskNO_AFFINITY : CONFIG_OPENTHREAD_BR_TASK_CORE_ID)
+/* Updates of a host merged in one publication, a further update of the host is queued after it */
+#define MAX_MERGED_UPDATES 4
+/* An update is dropped when the SRP server is about to time it out, as the server then releases its host */
+#define UPDATE_EXPIRY_MARGIN_MS 50
+#define MAX_HOST_ADDRESSES 8
+#define MAX_TXT_ENTRIES 16
+/* Size of the buffers of the DNS labels, without the terminator a label is at most 63 bytes */
+#define LABEL_BUFFER_SIZE 64
+
+namespace esp_matter {
+namespace thread_br_srp_publisher {
+
+static constexpr size_t k_queue_size = CONFIG_OPENTHREAD_BR_SRP_PUBLISH_QUEUE_SIZE;
+
+typedef struct {
+    /* Updates of the host, in the order they were received */
+    otSrpServerServiceUpdateId ids[MAX_MERGED_UPDATES];
+    uint8_t id_count;
+    /* Host of the last update, valid until its result is given to the SRP server or the update times out */
+    const otSrpServerHost *host;
+    /* Reception and timeout of the first update */
+    int64_t received_us;
+    int64_t expiry_us;
+} pending_host_t;
+
+/* Only used with the OpenThread lock held */
+static pending_host_t s_queue[k_queue_size];
+static size_t s_queue_len = 0;
+static otInstance *s_instance = NULL;
+static TaskHandle_t s_publish_task = NULL;
+
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static stats_t s_stats = {};
+
+/* Copies the first label of a name, such as the host of "host.default.service.arpa." */
+static bool copy_first_label(const char *name, char *label, size_t size)
+{
+    const char *end = strchr(name, '.');
+    size_t len = end ? end - name : strlen(name);
+    if (len == 0 || len >= size) {
+        return false;
+    }
+    memcpy(label, name, len);
+    label[len] = '\0';
+    return true;
+}
+
+static otError to_ot_error(esp_err_t err)
+{
+    switch (err) {
+    case ESP_OK:
+        return OT_ERROR_NONE;
+    case ESP_ERR_NO_MEM:
+        return OT_ERROR_NO_BUFS;
+    default:
+        return OT_ERROR_FAILED;
+    }
+}
+
+static esp_err_t publish_service(const char *hostname, const otSrpServerService *service)
+{
+    // The instance name is the instance label followed by the service name, "_matter._tcp.default.service.arpa."
+    const char *instance_name = otSrpServerServiceGetInstanceName(service);
+    const char *service_name = otSrpServerServiceGetServiceName(service);
+    size_t instance_len = strlen(instance_name);
+    size_t service_len = strlen(service_name);
+    char instance[LABEL_BUFFER_SIZE];
+    char type[LABEL_BUFFER_SIZE];
+    char proto[LABEL_BUFFER_SIZE];
+    ESP_RETURN_ON_FALSE(instance_len > service_len + 1 && instance_len - service_len - 1 < sizeof(instance),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid service instance %s", instance_name);
+    memcpy(instance, instance_name, instance_len - service_len - 1);
+    instance[instance_len - service_len - 1] = '\0';
+    ESP_RETURN_ON_FALSE(copy_first_label(service_name, type, sizeof(type)) &&
+                            copy_first_label(service_name + strlen(type) + 1, proto, sizeof(proto)),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid service %s", service_name);
+
+    if (otSrpServerServiceIsDeleted(service)) {
+        // The service may not have been published yet
+        (void)mdns_service_remove_for_host(instance, type, proto, hostname);
+        return ESP_OK;
+    }
+
+    uint16_t txt_len = 0;
+    const uint8_t *txt_data = otSrpServerServiceGetTxtData(service, &txt_len);
+    // The keys and the values are copied with their terminators, they are not NULL terminated in the TXT data
+    std::unique_ptr<char[]> txt_strings(new (std::nothrow) char[txt_len + 2 * MAX_TXT_ENTRIES]);
+    ESP_RETURN_ON_FALSE(txt_strings, ESP_ERR_NO_MEM, TAG, "Failed to allocate the TXT entries");
+    mdns_txt_item_t txt[MAX_TXT_ENTRIES];
+    size_t txt_count = 0;
+    char *next = txt_strings.get();
+    otDnsTxtEntryIterator iterator;
+    otDnsTxtEntry entry;
+    otDnsInitTxtEntryIterator(&iterator, txt_data, txt_len);
+    while (txt_count < MAX_TXT_ENTRIES && otDnsGetNextTxtEntry(&iterator, &entry) == OT_ERROR_NONE) {
+        if (!entry.mKey) {
+            // The key is longer than the iterator buffer
+            continue;
+        }
+        size_t key_len = strlen(entry.mKey);
+        uint16_t value_len = entry.mValue ? entry.mValueLength : 0;
+        memcpy(next, entry.mKey, key_len + 1);
+        txt[txt_count].key = next;
+        next += key_len + 1;
+        memcpy(next, entry.mValue, value_len);
+        next[value_len] = '\0';
+        txt[txt_count].value = next;
+        next += value_len + 1;
+        txt_count++;
+    }
+
+    uint16_t port = otSrpServerServiceGetPort(service);
+    esp_err_t err = ESP_OK;
+    if (mdns_service_exists_with_instance(instance, type, proto, hostname)) {
+        err = mdns_service_port_set_for_host(instance, type, proto, hostname, port);
+        if (err == ESP_OK) {
+            err = mdns_service_txt_set_for_host(instance, type, proto, hostname, txt_count ? txt : NULL, txt_count);
+        }
+    } else {
+        err = mdns_service_add_for_host(instance, type, proto, hostname, port, txt_count ? txt : NULL, txt_count);
+    }
+    ESP_RETURN_ON_ERROR(err, TAG, "Failed to publish %s", instance_name);
+
+    for (uint16_t idx = 0; idx < otSrpServerServiceGetNumberOfSubTypes(service); ++idx) {
+        const char *subtype_name = otSrpServerServiceGetSubTypeServiceNameAt(service, idx);
+        char subtype[LABEL_BUFFER_SIZE];
+        if (subtype_name &&
+            otSrpServerParseSubTypeServiceName(subtype_name, subtype, sizeof(subtype)) == OT_ERROR_NONE) {
+            // The subtypes are added again with each update, an existing subtype is not an error
+            (void)mdns_service_subtype_add_for_host(instance, type, proto, hostname, subtype);
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t publish_host(const otSrpServerHost *host)
+{
+    char hostname[LABEL_BUFFER_SIZE];
+    ESP_RETURN_ON_FALSE(copy_first_label(otSrpServerHostGetFullName(host), hostname, sizeof(hostname)),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid host %s", otSrpServerHostGetFullName(host));
+    if (otSrpServerHostIsDeleted(host)) {
+        // The services of a delegated host are removed with it
+        return mdns_hostname_exists(hostname) ? mdns_delegate_hostname_remove(hostname) : ESP_OK;
+    }
+
+    uint8_t address_count = 0;
+    const otIp6Address *addresses = otSrpServerHostGetAddresses(host, &address_count);
+    ESP_RETURN_ON_FALSE(address_count > 0, ESP_ERR_INVALID_ARG, TAG, "Host %s has no address", hostname);
+    if (address_count > MAX_HOST_ADDRESSES) {
+        address_count = MAX_HOST_ADDRESSES;
+    }
+    mdns_ip_addr_t address_list[MAX_HOST_ADDRESSES];
+    memset(address_list, 0, sizeof(address_list));
+    for (uint8_t idx = 0; idx < address_count; ++idx) {
+        address_list[idx].addr.type = ESP_IPADDR_TYPE_V6;
+        memcpy(address_list[idx].addr.u_addr.ip6.addr, addresses[idx].mFields.m8, sizeof(addresses[idx].mFields.m8));
+        address_list[idx].next = idx + 1 < address_count ? &address_list[idx + 1] : NULL;
+    }
+    // The address list is copied by the mdns component
+    esp_err_t err = mdns_hostname_exists(hostname) ? mdns_delegate_hostname_set_address(hostname, address_list)
+                                                   : mdns_delegate_hostname_add(hostname, address_list);
+    ESP_RETURN_ON_ERROR(err, TAG, "Failed to publish the host %s", hostname);
+
+    const otSrpServerService *service = NULL;
+    while ((service = otSrpServerHostGetNextService(host, service)) != NULL) {
+        ESP_RETURN_ON_ERROR(publish_service(hostname, service), TAG, "Failed to publish the services of %s", hostname);
+    }
+    return ESP_OK;
+}
+
+/* Called with the OpenThread lock held */
+static void publish_pending(const pending_host_t &pending)
+{
+    int64_t now_us = esp_timer_get_time();
+    if (now_us + UPDATE_EXPIRY_MARGIN_MS * 1000 >= pending.expiry_us) {
+        // The host may already be released, the SRP server answers the client with an error on the timeout
+        ESP_LOGW(TAG, "SRP update %" PRIu32 " expired before it was published", pending.ids[0]);
+        portENTER_CRITICAL(&s_stats_lock);
+        s_stats.expired += pending.id_count;
+        portEXIT_CRITICAL(&s_stats_lock);
+        return;
+    }
+    otError error = to_ot_error(publish_host(pending.host));
+    // The updates are committed by the server in the order they were received, the host of the last one is kept
+    for (uint8_t idx = 0; idx < pending.id_count; ++idx) {
+        otSrpServerHandleServiceUpdateResult(s_instance, pending.ids[idx], error);
+    }
+
+    uint32_t latency_ms = (uint32_t)((esp_timer_get_time() - pending.received_us) / 1000);
+    portENTER_CRITICAL(&s_stats_lock);
+    if (error == OT_ERROR_NONE) {
+        s_stats.published++;
+    } else {
+        s_stats.failed++;
+    }
+    s_stats.last_latency_ms = latency_ms;
+    s_stats.total_latency_ms += latency_ms;
+    if (latency_ms > s_stats.max_latency_ms) {
+        s_stats.max_latency_ms = latency_ms;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+static void set_queue_depth(size_t depth)
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.queue_depth = depth;
+    if (depth > s_stats.max_queue_depth) {
+        s_stats.max_queue_depth = depth;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+/* Called with the OpenThread lock held, returns whether hosts are still queued */
+static bool publish_batch()
+{
+    if (s_queue_len == 0) {
+        return false;
+    }
+    // The hosts which would expire before the next batch are published with this one, beyond the burst
+    int64_t next_batch_us =
+        esp_timer_get_time() + (CONFIG_OPENTHREAD_BR_SRP_PUBLISH_INTERVAL_MS + UPDATE_EXPIRY_MARGIN_MS) * 1000;
+    size_t published = 0;
+    size_t kept = 0;
+    for (size_t idx = 0; idx < s_queue_len; ++idx) {
+        if (published < CONFIG_OPENTHREAD_BR_SRP_PUBLISH_BURST || s_queue[idx].expiry_us <= next_batch_us) {
+            publish_pending(s_queue[idx]);
+            published++;
+        } else {
+            s_queue[kept++] = s_queue[idx];
+        }
+    }
+    s_queue_len = kept;
+    set_queue_depth(kept);
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.batches++;
+    portEXIT_CRITICAL(&s_stats_lock);
+    return kept > 0;
+}
+
+/* Called by the SRP server in the OpenThread task */
+static void handle_service_update(otSrpServerServiceUpdateId id, const otSrpServerHost *host, uint32_t timeout,
+                                  void *context)
+{
+    int64_t now_us = esp_timer_get_time();
+    const char *name = otSrpServerHostGetFullName(host);
+    bool coalesced = false;
+    // Only the last queued entry of the host is merged, so the hosts are never published out of order
+    for (size_t idx = s_queue_len; idx > 0; --idx) {
+        pending_host_t &pending = s_queue[idx - 1];
+        if (strcmp(otSrpServerHostGetFullName(pending.host), name) == 0) {
+            if (pending.id_count < MAX_MERGED_UPDATES) {
+                pending.ids[pending.id_count++] = id;
+                pending.host = host;
+                coalesced = true;
+            }
+            break;
+        }
+    }
+    if (!coalesced) {
+        if (s_queue_len == k_queue_size) {
+            // The oldest host is published at once to make room, without the rate limit
+            publish_pending(s_queue[0]);
+            memmove(&s_queue[0], &s_queue[1], (k_queue_size - 1) * sizeof(s_queue[0]));
+            s_queue_len--;
+        }
+        pending_host_t &pending = s_queue[s_queue_len++];
+        pending.ids[0] = id;
+        pending.id_count = 1;
+        pending.host = host;
+        pending.received_us = now_us;
+        pending.expiry_us = now_us + (int64_t)timeout * 1000;
+    }
+
+    portENTER_CRITICAL(&s_stats_lock);
+    s_stats.updates++;
+    if (coalesced) {
+        s_stats.coalesced++;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+    set_queue_depth(s_queue_len);
+    xTaskNotifyGive(s_publish_task);
+}
+
+static void publish_worker(void *context)
+{
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        // The updates received during the window are published with the first batch
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_OPENTHREAD_BR_SRP_PUBLISH_WINDOW_MS));
+        bool queued = true;
+        while (queued) {
+            esp_openthread_lock_acquire(portMAX_DELAY);
+            queued = publish_batch();
+            esp_openthread_lock_release();
+            // Also after the last batch, so the next window starts at least an interval after it
+            vTaskDelay(pdMS_TO_TICKS(CONFIG_OPENTHREAD_BR_SRP_PUBLISH_INTERVAL_MS));
+        }
+    }
+}
+
+esp_err_t init(otInstance *instance)
+{
+    ESP_RETURN_ON_FALSE(instance, ESP_ERR_INVALID_ARG, TAG, "instance cannot be NULL");
+    if (s_publish_task) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_FALSE(xTaskCreatePinnedToCore(publish_worker, "ot_br_srp_pub", 4096, NULL, 4, &s_publish_task,
+                                                THREAD_BR_TASK_CORE_ID) == pdTRUE,
+                        ESP_ERR_NO_MEM, TAG, "Failed to create the SRP publisher task");
+    s_instance = instance;
+    otSrpServerSetServiceUpdateHandler(instance, handle_service_update, NULL);
+    ESP_LOGI(TAG, "SRP publisher started, %d hosts every %d ms", CONFIG_OPENTHREAD_BR_SRP_PUBLISH_BURST,
+             CONFIG_OPENTHREAD_BR_SRP_PUBLISH_INTERVAL_MS);
+    return ESP_OK;
+}
+
+esp_err_t get_stats(stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "stats cannot be NULL");
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats;
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+void reset_stats()
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    uint16_t queue_depth = s_stats.queue_depth;
+    s_stats = {};
+    s_stats.queue_depth = queue_depth;
+    s_stats.max_queue_depth = queue_depth;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+} // namespace thread_br_srp_publisher
+} // namespace esp_matter
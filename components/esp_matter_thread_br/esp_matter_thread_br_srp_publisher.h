@@ -0,0 +1,80 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+#include <openthread/instance.h>
+
+namespace esp_matter {
+namespace thread_br_srp_publisher {
+
+/** Metrics of the coalesced SRP publisher
+ *
+ * The latencies are measured from the SRP update received by the server to its records published on the
+ * infrastructure link, including the coalescing window and the rate limit.
+ */
+typedef struct {
+    /** SRP updates received by the server */
+    uint32_t updates;
+    /** Updates merged with a queued update of the same host, published once */
+    uint32_t coalesced;
+    /** Hosts published, each publication covers one or more updates */
+    uint32_t published;
+    /** Publications which failed, the SRP client is answered with an error */
+    uint32_t failed;
+    /** Updates dropped as the SRP server timed them out before they were published */
+    uint32_t expired;
+    /** Batches published */
+    uint32_t batches;
+    /** Hosts waiting to be published, and the highest number since the reset */
+    uint16_t queue_depth;
+    uint16_t max_queue_depth;
+    uint32_t last_latency_ms;
+    uint32_t max_latency_ms;
+    uint64_t total_latency_ms;
+} stats_t;
+
+/** Publish the SRP registrations of the Thread devices in batches, called by the Thread BR launcher
+ *
+ * It replaces the service update handler of the SRP server: the updates are queued, the updates of the same host
+ * are merged, and the hosts are published with the espressif mdns component, at most
+ * CONFIG_OPENTHREAD_BR_SRP_PUBLISH_BURST hosts every CONFIG_OPENTHREAD_BR_SRP_PUBLISH_INTERVAL_MS. When many devices
+ * rejoin at once it spreads the mDNS announcements, instead of publishing each service as it is registered.
+ * Called in the OpenThread task, with the OpenThread lock held.
+ *
+ * @param[in] instance OpenThread instance.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t init(otInstance *instance);
+
+/** Get the metrics of the publisher
+ *
+ * @param[out] stats Metrics.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if stats is NULL.
+ */
+esp_err_t get_stats(stats_t *stats);
+
+/** Reset the metrics of the publisher, the queue depth is kept */
+void reset_stats();
+
+} // namespace thread_br_srp_publisher
+} // namespace esp_matter
@@ -0,0 +1,176 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <esp_check.h>
+#include <esp_matter_thread_br_telemetry.h>
+#include <esp_openthread.h>
+#include <esp_openthread_lock.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <string.h>
+
+#include <openthread/ip6.h>
+#include <openthread/link.h>
+#include <openthread/platform/radio.h>
+#if CONFIG_OPENTHREAD_NAT64
+#include <openthread/nat64.h>
+#endif
+
+#define TAG "thread_br_telemetry"
+#define THREAD_BR_TASK_CORE_ID \
+    (CONFIG_OPENTHREAD_BR_TASK_CORE_ID < 0 ? tskNO_AFFINITY : CONFIG_OPENTHREAD_BR_TASK_CORE_ID)
+/* Task of the OpenThread main loop, created by thread_br_init() */
+#define OT_TASK_NAME "ot_br"
+
+namespace esp_matter {
+namespace thread_br_telemetry {
+
+static constexpr size_t k_sample_count = CONFIG_OPENTHREAD_BR_TELEMETRY_SAMPLE_COUNT;
+
+/* Counters of the previous sample, to compute the rates */
+typedef struct {
+    int64_t timestamp_us;
+    uint32_t tx_frames;
+    uint32_t rx_frames;
+    uint32_t ot_task_run_time;
+} previous_counters_t;
+
+static portMUX_TYPE samples_lock = portMUX_INITIALIZER_UNLOCKED;
+static sample_t samples[k_sample_count];
+static size_t sample_next = 0;
+static size_t sample_used = 0;
+static TaskHandle_t sampling_task = NULL;
+static volatile uint32_t sampling_interval_ms = 0;
+static volatile bool sampling_stopped = false;
+
+static uint32_t rate_per_sec(uint32_t delta, int64_t elapsed_us)
+{
+    return elapsed_us > 0 ? (uint32_t)((uint64_t)delta * 1000000 / elapsed_us) : 0;
+}
+
+/* Called with the OpenThread lock held */
+static void take_sample(otInstance *instance, previous_counters_t *previous, sample_t *sample)
+{
+    int64_t start_us = esp_timer_get_time();
+    // The RSSI is read from the radio on each call, through the spinel link for an RCP
+    (void)otPlatRadioGetRssi(instance);
+    sample->timestamp_us = esp_timer_get_time();
+    sample->rcp_latency_us = (uint32_t)(sample->timestamp_us - start_us);
+
+    int64_t elapsed_us = sample->timestamp_us - previous->timestamp_us;
+    const otMacCounters *mac_counters = otLinkGetCounters(instance);
+    sample->tx_frames_per_sec = rate_per_sec(mac_counters->mTxTotal - previous->tx_frames, elapsed_us);
+    sample->rx_frames_per_sec = rate_per_sec(mac_counters->mRxTotal - previous->rx_frames, elapsed_us);
+    previous->tx_frames = mac_counters->mTxTotal;
+    previous->rx_frames = mac_counters->mRxTotal;
+    sample->radio_busy_ratio = otLinkGetCcaFailureRate(instance);
+
+    const otBorderRoutingCounters *br_counters = otIp6GetBorderRoutingCounters(instance);
+    sample->br_inbound_packets = br_counters->mInboundUnicast.mPackets + br_counters->mInboundMulticast.mPackets;
+    sample->br_outbound_packets = br_counters->mOutboundUnicast.mPackets + br_counters->mOutboundMulticast.mPackets;
+#if CONFIG_OPENTHREAD_NAT64
+    otNat64ProtocolCounters nat64_counters;
+    otNat64GetCounters(instance, &nat64_counters);
+    sample->nat64_4to6_packets = nat64_counters.mTotal.m4To6Packets;
+    sample->nat64_6to4_packets = nat64_counters.mTotal.m6To4Packets;
+#else
+    sample->nat64_4to6_packets = 0;
+    sample->nat64_6to4_packets = 0;
+#endif
+
+    sample->ot_task_load = THREAD_BR_TELEMETRY_LOAD_UNAVAILABLE;
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    TaskHandle_t ot_task = xTaskGetHandle(OT_TASK_NAME);
+    if (ot_task) {
+        // The run time counter of the task is in microseconds, from esp_timer
+        uint32_t run_time = ulTaskGetRunTimeCounter(ot_task);
+        if (previous->timestamp_us > 0 && elapsed_us > 0) {
+            uint64_t load = (uint64_t)(run_time - previous->ot_task_run_time) * 100 / elapsed_us;
+            sample->ot_task_load = load > 100 ? 100 : (uint8_t)load;
+        }
+        previous->ot_task_run_time = run_time;
+    }
+#endif
+    previous->timestamp_us = sample->timestamp_us;
+}
+
+static void sampling_worker(void *context)
+{
+    previous_counters_t previous = {};
+    bool first = true;
+    TickType_t last_wake = xTaskGetTickCount();
+    while (!sampling_stopped) {
+        sample_t sample;
+        otInstance *instance = NULL;
+        esp_openthread_lock_acquire(portMAX_DELAY);
+        instance = esp_openthread_get_instance();
+        if (instance) {
+            take_sample(instance, &previous, &sample);
+        }
+        esp_openthread_lock_release();
+        // The first sample only sets the counters the rates are computed from
+        if (instance && !first) {
+            taskENTER_CRITICAL(&samples_lock);
+            samples[sample_next] = sample;
+            sample_next = (sample_next + 1) % k_sample_count;
+            if (sample_used < k_sample_count) {
+                sample_used++;
+            }
+            taskEXIT_CRITICAL(&samples_lock);
+        }
+        first = first && !instance;
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(sampling_interval_ms));
+    }
+    sampling_task = NULL;
+    vTaskDelete(NULL);
+}
+
+esp_err_t start(uint32_t interval_ms)
+{
+    ESP_RETURN_ON_FALSE(interval_ms >= 100, ESP_ERR_INVALID_ARG, TAG, "The sampling interval must be at least 100 ms");
+    sampling_interval_ms = interval_ms;
+    sampling_stopped = false;
+    if (sampling_task) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_FALSE(xTaskCreatePinnedToCore(sampling_worker, "ot_br_telemetry", 3072, NULL, 1, &sampling_task,
+                                                THREAD_BR_TASK_CORE_ID) == pdTRUE,
+                        ESP_ERR_NO_MEM, TAG, "Failed to create the telemetry task");
+    return ESP_OK;
+}
+
+esp_err_t stop()
+{
+    sampling_stopped = true;
+    return ESP_OK;
+}
+
+size_t get_samples(sample_t *out, size_t max_count)
+{
+    if (!out) {
+        return 0;
+    }
+    taskENTER_CRITICAL(&samples_lock);
+    size_t count = sample_used < max_count ? sample_used : max_count;
+    size_t first = (sample_next + k_sample_count - count) % k_sample_count;
+    for (size_t idx = 0; idx < count; ++idx) {
+        out[idx] = samples[(first + idx) % k_sample_count];
+    }
+    taskEXIT_CRITICAL(&samples_lock);
+    return count;
+}
+
+} // namespace thread_br_telemetry
+} // namespace esp_matter
@@ -0,0 +1,80 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace esp_matter {
+namespace thread_br_telemetry {
+
+/** The load of the OpenThread task is not available, CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS is disabled */
+#define THREAD_BR_TELEMETRY_LOAD_UNAVAILABLE 0xFF
+
+/** Telemetry sample of the Thread Border Router
+ *
+ * The timestamp uses the esp_timer clock, as the Matter logs, so the samples can be lined up with the Matter traffic.
+ * The rates and the load are averaged over the sampling interval, the packet counters are totals since boot.
+ */
+typedef struct {
+    /** Time of the sample, in microseconds since boot */
+    int64_t timestamp_us;
+    /** Round trip of a radio property read, through the spinel link with an RCP */
+    uint32_t rcp_latency_us;
+    /** 802.15.4 frames sent and received per second */
+    uint32_t tx_frames_per_sec;
+    uint32_t rx_frames_per_sec;
+    /** Ratio of the clear channel assessments which found the channel busy, 0xFFFF for 100% */
+    uint16_t radio_busy_ratio;
+    /** Load of the OpenThread task in percent of a core, or THREAD_BR_TELEMETRY_LOAD_UNAVAILABLE */
+    uint8_t ot_task_load;
+    /** Packets forwarded by the border routing between the infrastructure and Thread networks */
+    uint64_t br_inbound_packets;
+    uint64_t br_outbound_packets;
+    /** Packets translated by NAT64, 0 if CONFIG_OPENTHREAD_NAT64 is disabled */
+    uint64_t nat64_4to6_packets;
+    uint64_t nat64_6to4_packets;
+} sample_t;
+
+/** Start sampling the telemetry of the Thread Border Router
+ *
+ * The samples are taken by a low priority task, with the OpenThread lock held, and kept in a ring of the last
+ * CONFIG_OPENTHREAD_BR_TELEMETRY_SAMPLE_COUNT samples. Starting it again changes the interval.
+ *
+ * @param[in] interval_ms Sampling interval, at least 100 ms.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t start(uint32_t interval_ms);
+
+/** Stop sampling, the samples already taken are kept
+ *
+ * @return ESP_OK on success.
+ */
+esp_err_t stop();
+
+/** Copy the samples of the ring, from the oldest to the newest
+ *
+ * @param[out] samples Array receiving the samples.
+ * @param[in] max_count Number of entries of the array.
+ *
+ * @return Number of samples copied.
+ */
+size_t get_samples(sample_t *samples, size_t max_count);
+
+} // namespace thread_br_telemetry
+} // namespace esp_matter
@@ -0,0 +1,221 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <button_event_queue.h>
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+#define BUTTON_QUEUE_MAX_BUTTONS 8
+#define DEFAULT_DEBOUNCE_MS 20
+#define DEFAULT_MULTI_PRESS_MS 300
+#define DEFAULT_LONG_PRESS_MS 1000
+#define NO_DEADLINE INT64_MAX
+
+static const char *TAG = "button_queue";
+
+/* Edge queued by the interrupt */
+typedef struct {
+    uint8_t index;
+    int64_t timestamp_us;
+} button_edge_t;
+
+typedef struct {
+    button_queue_config_t config;
+    /* Debounced state */
+    bool pressed;
+    /* An edge is waiting for the level to be stable */
+    bool settling;
+    int64_t first_edge_us;
+    int64_t last_edge_us;
+    /* Presses of the current sequence */
+    uint8_t press_count;
+    int64_t press_us;
+    int64_t release_us;
+    bool long_press_sent;
+} button_state_t;
+
+static QueueHandle_t edge_queue = NULL;
+static button_state_t buttons[BUTTON_QUEUE_MAX_BUTTONS];
+static volatile uint8_t button_count = 0;
+static portMUX_TYPE buttons_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void IRAM_ATTR button_isr(void *arg)
+{
+    button_edge_t edge = {
+        .index = (uint8_t)(uintptr_t)arg,
+        .timestamp_us = esp_timer_get_time(),
+    };
+    BaseType_t woken = pdFALSE;
+    /* A full queue drops the edge, the level is read again after the debounce anyway */
+    xQueueSendFromISR(edge_queue, &edge, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void button_emit(button_state_t *button, button_queue_event_type_t type, int64_t timestamp_us)
+{
+    button_queue_event_t event = {
+        .type = type,
+        .gpio_num = button->config.gpio_num,
+        .press_count = button->press_count,
+        .timestamp_us = timestamp_us,
+    };
+    button->config.callback(&event, button->config.arg);
+}
+
+/* Run the state machine of the button, returns its next deadline */
+static int64_t button_process(button_state_t *button, int64_t now_us)
+{
+    const button_queue_config_t *config = &button->config;
+    if (button->settling && now_us - button->last_edge_us >= config->debounce_ms * 1000) {
+        button->settling = false;
+        bool pressed = gpio_get_level(config->gpio_num) == config->active_level;
+        if (pressed != button->pressed) {
+            button->pressed = pressed;
+            if (pressed) {
+                button->press_us = button->first_edge_us;
+                button->long_press_sent = false;
+                button_emit(button, BUTTON_QUEUE_EVENT_PRESS, button->first_edge_us);
+            } else {
+                button->release_us = button->first_edge_us;
+                if (!button->long_press_sent) {
+                    button->press_count++;
+                }
+                button_emit(button, BUTTON_QUEUE_EVENT_RELEASE, button->first_edge_us);
+            }
+        }
+    }
+    if (button->pressed && !button->long_press_sent && now_us - button->press_us >= config->long_press_ms * 1000) {
+        button->long_press_sent = true;
+        button->press_count = 0;
+        button_emit(button, BUTTON_QUEUE_EVENT_LONG_PRESS, button->press_us);
+    }
+    if (!button->pressed && !button->settling && button->press_count > 0 &&
+        now_us - button->release_us >= config->multi_press_ms * 1000) {
+        button_emit(button, BUTTON_QUEUE_EVENT_CLICK, button->release_us);
+        button->press_count = 0;
+    }
+
+    int64_t deadline = NO_DEADLINE;
+    if (button->settling) {
+        deadline = button->last_edge_us + config->debounce_ms * 1000;
+    }
+    if (button->pressed && !button->long_press_sent) {
+        int64_t long_press_us = button->press_us + config->long_press_ms * 1000;
+        deadline = long_press_us < deadline ? long_press_us : deadline;
+    }
+    if (!button->pressed && button->press_count > 0) {
+        int64_t sequence_end_us = button->release_us + config->multi_press_ms * 1000;
+        deadline = sequence_end_us < deadline ? sequence_end_us : deadline;
+    }
+    return deadline;
+}
+
+static void button_queue_task(void *arg)
+{
+    int64_t deadline = NO_DEADLINE;
+    while (true) {
+        TickType_t timeout = portMAX_DELAY;
+        if (deadline != NO_DEADLINE) {
+            int64_t wait_us = deadline - esp_timer_get_time();
+            timeout = wait_us > 0 ? pdMS_TO_TICKS((wait_us + 999) / 1000) + 1 : 0;
+        }
+        button_edge_t edge;
+        /* The edges of a bounce are taken in one run, the level is read once they settle */
+        while (xQueueReceive(edge_queue, &edge, timeout) == pdTRUE) {
+            if (edge.index < button_count) {
+                button_state_t *button = &buttons[edge.index];
+                if (!button->settling) {
+                    button->settling = true;
+                    button->first_edge_us = edge.timestamp_us;
+                }
+                button->last_edge_us = edge.timestamp_us;
+            }
+            timeout = 0;
+        }
+        int64_t now_us = esp_timer_get_time();
+        deadline = NO_DEADLINE;
+        for (uint8_t i = 0; i < button_count; i++) {
+            int64_t button_deadline = button_process(&buttons[i], now_us);
+            deadline = button_deadline < deadline ? button_deadline : deadline;
+        }
+    }
+}
+
+esp_err_t button_queue_init(const button_queue_task_config_t *config)
+{
+    if (edge_queue) {
+        return ESP_OK;
+    }
+    button_queue_task_config_t default_config = BUTTON_QUEUE_TASK_CONFIG_DEFAULT();
+    if (!config) {
+        config = &default_config;
+    }
+    edge_queue = xQueueCreate(config->queue_length, sizeof(button_edge_t));
+    ESP_RETURN_ON_FALSE(edge_queue, ESP_ERR_NO_MEM, TAG, "Failed to create the edge queue");
+    if (xTaskCreate(button_queue_task, "button_queue", config->task_stack_size, NULL, config->task_priority, NULL) !=
+        pdPASS) {
+        ESP_LOGE(TAG, "Failed to create the button task");
+        vQueueDelete(edge_queue);
+        edge_queue = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t button_queue_add(const button_queue_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(config && config->callback, ESP_ERR_INVALID_ARG, TAG, "The callback cannot be NULL");
+    ESP_RETURN_ON_FALSE(edge_queue, ESP_ERR_INVALID_STATE, TAG, "button_queue_init() must be called first");
+    ESP_RETURN_ON_FALSE(button_count < BUTTON_QUEUE_MAX_BUTTONS, ESP_ERR_NO_MEM, TAG, "Too many buttons");
+
+    gpio_config_t gpio_cfg = {
+        .pin_bit_mask = 1ULL << config->gpio_num,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = config->active_level ? GPIO_PULLUP_DISABLE : GPIO_PULLUP_ENABLE,
+        .pull_down_en = config->active_level ? GPIO_PULLDOWN_ENABLE : GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_ANYEDGE,
+    };
+    ESP_RETURN_ON_ERROR(gpio_config(&gpio_cfg), TAG, "Failed to configure GPIO %d", config->gpio_num);
+    esp_err_t err = gpio_install_isr_service(0);
+    ESP_RETURN_ON_FALSE(err == ESP_OK || err == ESP_ERR_INVALID_STATE, err, TAG, "Failed to install the ISR service");
+
+    taskENTER_CRITICAL(&buttons_lock);
+    uint8_t index = button_count;
+    button_state_t *button = &buttons[index];
+    button->config = *config;
+    if (button->config.debounce_ms == 0) {
+        button->config.debounce_ms = DEFAULT_DEBOUNCE_MS;
+    }
+    if (button->config.multi_press_ms == 0) {
+        button->config.multi_press_ms = DEFAULT_MULTI_PRESS_MS;
+    }
+    if (button->config.long_press_ms == 0) {
+        button->config.long_press_ms = DEFAULT_LONG_PRESS_MS;
+    }
+    button->pressed = gpio_get_level(config->gpio_num) == config->active_level;
+    button_count = index + 1;
+    taskEXIT_CRITICAL(&buttons_lock);
+
+    err = gpio_isr_handler_add(config->gpio_num, button_isr, (void *)(uintptr_t)index);
+    ESP_RETURN_ON_ERROR(err, TAG, "Failed to add the ISR of GPIO %d", config->gpio_num);
+    return ESP_OK;
+}
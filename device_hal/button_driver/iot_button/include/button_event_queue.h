@@ -0,0 +1,109 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Button event queue.
+ *
+ * The edges of the button GPIOs are timestamped in the GPIO interrupt and queued to a consumer task, which debounces
+ * them, combines the presses of a multi-press sequence and calls the event callbacks. The callbacks run in the
+ * consumer task, they can take the Matter stack lock without blocking the interrupts or the esp_timer task.
+ */
+
+typedef enum {
+    /** The button is pressed, after the debounce */
+    BUTTON_QUEUE_EVENT_PRESS = 0,
+    /** The button is released, after the debounce */
+    BUTTON_QUEUE_EVENT_RELEASE,
+    /** End of a sequence of presses, press_count is the number of presses */
+    BUTTON_QUEUE_EVENT_CLICK,
+    /** The button is held for the long press time, the release does not end in a click */
+    BUTTON_QUEUE_EVENT_LONG_PRESS,
+} button_queue_event_type_t;
+
+typedef struct {
+    button_queue_event_type_t type;
+    /** GPIO of the button */
+    int gpio_num;
+    /** Number of presses of the sequence, for BUTTON_QUEUE_EVENT_CLICK */
+    uint8_t press_count;
+    /** Time of the first edge of the event in the interrupt, in microseconds since boot */
+    int64_t timestamp_us;
+} button_queue_event_t;
+
+typedef void (*button_queue_cb_t)(const button_queue_event_t *event, void *arg);
+
+typedef struct {
+    /** Priority of the consumer task */
+    uint8_t task_priority;
+    /** Stack size of the consumer task, include what the callbacks need */
+    uint32_t task_stack_size;
+    /** Number of edges the queue holds between two runs of the task */
+    uint16_t queue_length;
+} button_queue_task_config_t;
+
+#define BUTTON_QUEUE_TASK_CONFIG_DEFAULT() \
+    {                                      \
+        .task_priority = 5,                \
+        .task_stack_size = 4096,           \
+        .queue_length = 32,                \
+    }
+
+typedef struct {
+    int gpio_num;
+    /** Level of the GPIO when the button is pressed */
+    uint8_t active_level;
+    /** Time the level has to be stable to be taken, 0 for 20 ms */
+    uint16_t debounce_ms;
+    /** Longest time between a release and the next press of a sequence, 0 for 300 ms */
+    uint16_t multi_press_ms;
+    /** Time held for a long press, 0 for 1000 ms */
+    uint16_t long_press_ms;
+    button_queue_cb_t callback;
+    void *arg;
+} button_queue_config_t;
+
+/** Create the queue and the consumer task
+ *
+ * @param[in] config Configuration of the task, NULL for BUTTON_QUEUE_TASK_CONFIG_DEFAULT().
+ *
+ * @return ESP_OK on success, or if it is already initialized.
+ * @return error in case of failure.
+ */
+esp_err_t button_queue_init(const button_queue_task_config_t *config);
+
+/** Add a button to the queue
+ *
+ * The GPIO is configured as an input with the pull towards the inactive level, and its interrupt is enabled on both
+ * edges. The GPIO ISR service is installed if it is not already.
+ *
+ * @param[in] config Configuration of the button.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t button_queue_add(const button_queue_config_t *config);
+
+#ifdef __cplusplus
+}
+#endif
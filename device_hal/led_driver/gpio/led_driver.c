@@ -14,6 +14,7 @@
 #include <driver/ledc.h>
 #include <esp_log.h>
 #include <hal/ledc_types.h>
+#include <soc/soc_caps.h>
 
 #include <led_driver.h>
 
@@ -53,10 +54,22 @@ led_driver_handle_t led_driver_init(led_driver_config_t *config)
         ESP_LOGE(TAG, "ledc_channel_config failed");
     }
 
+    /* The brightness transitions are run by the LEDC fade, the service is shared by the channels */
+    err = ledc_fade_func_install(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "ledc_fade_func_install failed");
+    }
+
     /* Using (channel + 1) as handle */
     return (led_driver_handle_t)(config->channel + 1);
 }
 
+led_driver_handle_t led_driver_add_segment(led_driver_handle_t handle, uint16_t first_pixel, uint16_t pixel_count)
+{
+    ESP_LOGE(TAG, "LED segments are not supported");
+    return NULL;
+}
+
 esp_err_t led_driver_set_power(led_driver_handle_t handle, bool power)
 {
     current_power = power;
@@ -79,6 +92,10 @@ esp_err_t led_driver_set_brightness(led_driver_handle_t handle, uint8_t brightne
         brightness = 0;
     }
 
+#if SOC_LEDC_SUPPORT_FADE_STOP
+    /* Else the duty is set at the end of the running transition */
+    ledc_fade_stop(LEDC_LOW_SPEED_MODE, channel);
+#endif
     err = ledc_set_duty(LEDC_LOW_SPEED_MODE, channel, brightness);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "ledc_set_duty failed");
@@ -105,3 +122,51 @@ esp_err_t led_driver_set_temperature(led_driver_handle_t handle, uint32_t temper
 {
     return ESP_ERR_NOT_SUPPORTED;
 }
+
+esp_err_t led_driver_set_brightness_transition(led_driver_handle_t handle, uint8_t brightness, uint32_t transition_ms)
+{
+    esp_err_t err;
+    int channel = (int)handle - 1;
+    if (channel < 0) {
+        ESP_LOGE(TAG, "Invalid handle");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (transition_ms == 0) {
+        return led_driver_set_brightness(handle, brightness);
+    }
+
+    if (brightness != 0) {
+        current_brightness = brightness;
+    }
+    if (!current_power) {
+        brightness = 0;
+    }
+
+    /* The hardware fades from the current duty, without waking the CPU on each step */
+    err = ledc_set_fade_with_time(LEDC_LOW_SPEED_MODE, channel, brightness, transition_ms);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "ledc_set_fade_with_time failed");
+        return err;
+    }
+    err = ledc_fade_start(LEDC_LOW_SPEED_MODE, channel, LEDC_FADE_NO_WAIT);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "ledc_fade_start failed");
+    }
+    return err;
+}
+
+esp_err_t led_driver_set_hue_transition(led_driver_handle_t handle, uint16_t hue, uint32_t transition_ms)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t led_driver_set_saturation_transition(led_driver_handle_t handle, uint8_t saturation, uint32_t transition_ms)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t led_driver_set_temperature_transition(led_driver_handle_t handle, uint32_t temperature,
+                                                uint32_t transition_ms)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
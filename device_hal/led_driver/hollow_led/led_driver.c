@@ -25,6 +25,12 @@ led_driver_handle_t led_driver_init(led_driver_config_t *config)
     return NULL;
 }
 
+led_driver_handle_t led_driver_add_segment(led_driver_handle_t handle, uint16_t first_pixel, uint16_t pixel_count)
+{
+    ESP_LOGE(TAG, "LED segments are not supported");
+    return NULL;
+}
+
 esp_err_t led_driver_set_power(led_driver_handle_t handle, bool power)
 {
     ESP_LOGI(TAG, "Setting power to: %d", power);
@@ -64,3 +70,24 @@ esp_err_t led_driver_set_temperature(led_driver_handle_t handle, uint32_t temper
 
     return ESP_OK;
 }
+
+esp_err_t led_driver_set_brightness_transition(led_driver_handle_t handle, uint8_t brightness, uint32_t transition_ms)
+{
+    return led_driver_set_brightness(handle, brightness);
+}
+
+esp_err_t led_driver_set_hue_transition(led_driver_handle_t handle, uint16_t hue, uint32_t transition_ms)
+{
+    return led_driver_set_hue(handle, hue);
+}
+
+esp_err_t led_driver_set_saturation_transition(led_driver_handle_t handle, uint8_t saturation, uint32_t transition_ms)
+{
+    return led_driver_set_saturation(handle, saturation);
+}
+
+esp_err_t led_driver_set_temperature_transition(led_driver_handle_t handle, uint32_t temperature,
+                                                uint32_t transition_ms)
+{
+    return led_driver_set_temperature(handle, temperature);
+}
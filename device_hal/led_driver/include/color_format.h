@@ -12,6 +12,7 @@
 // limitations under the License
 
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -29,10 +30,18 @@ typedef struct {
     uint8_t blue;
 } RGB_color_t;
 
+/* The color temperature is in K, the colors between the 100 K steps of the table are interpolated */
 void temp_to_hs(uint32_t temperature, HS_color_t *HS);
 
+/* The saturation and the brightness are in percent, the RGB channels in the 0 - 255 range */
 void hsv_to_rgb(HS_color_t HS, uint8_t brightness, RGB_color_t *RGB);
 
+/* Convert count pixels sharing the same brightness, for the LED strips */
+void hsv_to_rgb_array(const HS_color_t *HS, uint8_t brightness, RGB_color_t *RGB, size_t count);
+
+/* Same as temp_to_hs() followed by hsv_to_rgb() */
+void temp_to_rgb(uint32_t temperature, uint8_t brightness, RGB_color_t *RGB);
+
 #ifdef __cplusplus
 }
 #endif
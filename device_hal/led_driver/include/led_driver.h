@@ -23,17 +23,35 @@ extern "C" {
 typedef struct {
     int gpio;
     int channel;
+    /* Number of pixels of a LED strip, 0 for a single LED. Only used by the ws2812 driver. */
+    uint16_t pixel_count;
+    /* Period at which the changes are pushed to a LED strip, in ms, 0 to push each change at once. The changes
+     * between two refreshes are pushed in one frame. Only used by the ws2812 driver. */
+    uint16_t refresh_period_ms;
 } led_driver_config_t;
 
 typedef void *led_driver_handle_t;
 
 led_driver_handle_t led_driver_init(led_driver_config_t *config);
+/* Drive the pixels [first_pixel, first_pixel + pixel_count) of the strip of handle as a separate light, for
+ * instance on another endpoint. The handle of led_driver_init() drives the whole strip. Only supported by the ws2812
+ * driver, NULL is returned by the others. */
+led_driver_handle_t led_driver_add_segment(led_driver_handle_t handle, uint16_t first_pixel, uint16_t pixel_count);
 esp_err_t led_driver_set_power(led_driver_handle_t handle, bool power);
 esp_err_t led_driver_set_brightness(led_driver_handle_t handle, uint8_t brightness);
 esp_err_t led_driver_set_hue(led_driver_handle_t handle, uint16_t hue);
 esp_err_t led_driver_set_saturation(led_driver_handle_t handle, uint8_t saturation);
 esp_err_t led_driver_set_temperature(led_driver_handle_t handle, uint32_t temperature);
 
+/* Set the value over transition_ms, the driver runs the transition itself and the call returns at once. A call
+ * during a transition of the same value starts a new one from the current value, a call of the setters without the
+ * transition stops it. 0 sets the value at once. The drivers without transitions set the value at once. */
+esp_err_t led_driver_set_brightness_transition(led_driver_handle_t handle, uint8_t brightness, uint32_t transition_ms);
+esp_err_t led_driver_set_hue_transition(led_driver_handle_t handle, uint16_t hue, uint32_t transition_ms);
+esp_err_t led_driver_set_saturation_transition(led_driver_handle_t handle, uint8_t saturation, uint32_t transition_ms);
+esp_err_t led_driver_set_temperature_transition(led_driver_handle_t handle, uint32_t temperature,
+                                                uint32_t transition_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,65 +13,92 @@
 
 #include <color_format.h>
 
-void hsv_to_rgb(HS_color_t HS, uint8_t brightness, RGB_color_t *RGB)
+/* x / 255 without a divide, exact for x < 65535, the products of two 8-bit values */
+#define DIV_255(x) (((x) + 1 + ((x) >> 8)) >> 8)
+/* x / 100 with a reciprocal, exact for x < 43699 */
+#define DIV_100(x) (((x) * 41944) >> 22)
+
+/* Percent to the 0 - 255 range, clamped to 100 % */
+static const uint8_t percent_to_255[101] = {
+    0, 3, 5, 8, 10, 13, 15, 18, 20, 23, 26, 28, 31, 33, 36, 38, 41, 43, 46, 48, 51,
+    54, 56, 59, 61, 64, 66, 69, 71, 74, 77, 79, 82, 84, 87, 89, 92, 94, 97, 99, 102, 105,
+    107, 110, 112, 115, 117, 120, 122, 125, 128, 130, 133, 135, 138, 140, 143, 145, 148, 150, 153, 156, 158,
+    161, 163, 166, 168, 171, 173, 176, 179, 181, 184, 186, 189, 191, 194, 196, 199, 201, 204, 207, 209, 212,
+    214, 217, 219, 222, 224, 227, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255};
+
+static inline uint8_t percent_scale(uint8_t percent)
+{
+    return percent_to_255[percent > 100 ? 100 : percent];
+}
+
+/* The saturation and the value are in the 0 - 255 range, the hue is below 360 */
+static inline void hsv_to_rgb_fixed(uint16_t hue, uint8_t saturation, uint8_t value, RGB_color_t *RGB)
 {
-    uint16_t hue = HS.hue % 360;
-    uint16_t hi = (hue / 60) % 6;
-    uint16_t F = 100 * hue / 60 - 100 * hi;
-    uint16_t P = brightness * (100 - HS.saturation) / 100;
-    uint16_t Q = brightness * (10000 - F * HS.saturation) / 10000;
-    uint16_t T = brightness * (10000 - HS.saturation * (100 - F)) / 10000;
-
-    switch (hi) {
+    /* hue / 60 with a reciprocal, exact below 360 */
+    uint32_t sector = ((uint32_t)hue * 1093) >> 16;
+    /* Position in the sector, (hue % 60) * 255 / 60 */
+    uint32_t fraction = (((uint32_t)hue - sector * 60) * 17) >> 2;
+    uint8_t p = DIV_255(value * (255 - saturation));
+    uint8_t q = DIV_255(value * (255 - DIV_255(saturation * fraction)));
+    uint8_t t = DIV_255(value * (255 - DIV_255(saturation * (255 - fraction))));
+
+    switch (sector) {
     case 0:
-        RGB->red = brightness;
-        RGB->green = T;
-        RGB->blue = P;
+        RGB->red = value;
+        RGB->green = t;
+        RGB->blue = p;
         break;
 
     case 1:
-        RGB->red = Q;
-        RGB->green = brightness;
-        RGB->blue = P;
+        RGB->red = q;
+        RGB->green = value;
+        RGB->blue = p;
         break;
 
     case 2:
-        RGB->red = P;
-        RGB->green = brightness;
-        RGB->blue = T;
+        RGB->red = p;
+        RGB->green = value;
+        RGB->blue = t;
         break;
 
     case 3:
-        RGB->red = P;
-        RGB->green = Q;
-        RGB->blue = brightness;
+        RGB->red = p;
+        RGB->green = q;
+        RGB->blue = value;
         break;
 
     case 4:
-        RGB->red = T;
-        RGB->green = P;
-        RGB->blue = brightness;
-        break;
-
-    case 5:
-        RGB->red = brightness;
-        RGB->green = P;
-        RGB->blue = Q;
+        RGB->red = t;
+        RGB->green = p;
+        RGB->blue = value;
         break;
 
     default:
+        RGB->red = value;
+        RGB->green = p;
+        RGB->blue = q;
         break;
     }
+}
+
+void hsv_to_rgb(HS_color_t HS, uint8_t brightness, RGB_color_t *RGB)
+{
+    uint16_t hue = HS.hue < 360 ? HS.hue : HS.hue % 360;
+    hsv_to_rgb_fixed(hue, percent_scale(HS.saturation), percent_scale(brightness), RGB);
+}
 
-    RGB->red = RGB->red * 255 / 100;
-    RGB->green = RGB->green * 255 / 100;
-    RGB->blue = RGB->blue * 255 / 100;
+void hsv_to_rgb_array(const HS_color_t *HS, uint8_t brightness, RGB_color_t *RGB, size_t count)
+{
+    uint8_t value = percent_scale(brightness);
+    for (size_t i = 0; i < count; i++) {
+        uint16_t hue = HS[i].hue < 360 ? HS[i].hue : HS[i].hue % 360;
+        hsv_to_rgb_fixed(hue, percent_scale(HS[i].saturation), value, &RGB[i]);
+    }
 }
 
 // A Table from color temperature to hue and saturation.
-// hue = temp_table[(temp - 600) / 100].hue
-// saturation= temp_table[(temp - 600) / 100].saturation
-// 600<= temp <= 10000
+// The entry i is the color of 600 + 100 * i K, the colors in between are interpolated.
+// 600 <= temp <= 10000
 const HS_color_t temp_table[] = {
     {4, 100},  {8, 100},  {11, 100}, {14, 100}, {16, 100}, {18, 100}, {20, 100}, {22, 100}, {24, 100}, {25, 100},
     {27, 100}, {28, 100}, {30, 100}, {31, 100}, {31, 95},  {30, 89},  {30, 85},  {29, 80},  {29, 76},  {29, 73},
@@ -84,6 +111,8 @@ const HS_color_t temp_table[] = {
     {223, 16}, {223, 17}, {223, 17}, {223, 17}, {222, 18}, {222, 18}, {222, 19}, {222, 19}, {222, 19}, {222, 19},
     {222, 20}, {222, 20}, {222, 20}, {222, 21}, {222, 21}};
 
+#define TEMP_TABLE_SIZE (sizeof(temp_table) / sizeof(temp_table[0]))
+
 void temp_to_hs(uint32_t temperature, HS_color_t *HS)
 {
     if (temperature < 600) {
@@ -91,11 +120,39 @@ void temp_to_hs(uint32_t temperature, HS_color_t *HS)
         HS->saturation = 100;
         return;
     }
-    if (temperature > 10000) {
+    if (temperature >= 10000) {
         HS->hue = 222;
         HS->saturation = 21 + (temperature - 10000) * 41 / 990000;
         return;
     }
-    HS->hue = temp_table[(temperature - 600) / 100].hue;
-    HS->saturation = temp_table[(temperature - 600) / 100].saturation;
+    uint32_t offset = temperature - 600;
+    uint32_t index = DIV_100(offset);
+    uint32_t step = offset - index * 100;
+    const HS_color_t *low = &temp_table[index];
+    const HS_color_t *high = &temp_table[index + 1 < TEMP_TABLE_SIZE ? index + 1 : index];
+
+    /* The hue goes the short way around the circle, it wraps near the white point */
+    int32_t hue_delta = (int32_t)high->hue - (int32_t)low->hue;
+    if (hue_delta > 180) {
+        hue_delta -= 360;
+    } else if (hue_delta < -180) {
+        hue_delta += 360;
+    }
+    int32_t hue = low->hue * 100 + hue_delta * (int32_t)step;
+    if (hue < 0) {
+        hue += 360 * 100;
+    }
+    HS->hue = DIV_100((uint32_t)hue + 50);
+    if (HS->hue >= 360) {
+        HS->hue -= 360;
+    }
+    int32_t saturation = low->saturation * 100 + ((int32_t)high->saturation - (int32_t)low->saturation) * (int32_t)step;
+    HS->saturation = DIV_100((uint32_t)saturation + 50);
+}
+
+void temp_to_rgb(uint32_t temperature, uint8_t brightness, RGB_color_t *RGB)
+{
+    HS_color_t HS;
+    temp_to_hs(temperature, &HS);
+    hsv_to_rgb_fixed(HS.hue, percent_scale(HS.saturation), percent_scale(brightness), RGB);
 }
@@ -14,20 +14,190 @@
 #include <color_format.h>
 #include <driver/rmt.h>
 #include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <led_strip.h>
 #include <led_driver.h>
+#include <stdlib.h>
+
+/* Refresh period used for the transitions when refresh_period_ms is not configured, 50 Hz */
+#define TRANSITION_REFRESH_PERIOD_MS 20
 
 static const char *TAG = "led_driver_ws2812";
-static bool current_power = false;
-static uint8_t current_brightness = 0;
-static uint32_t current_temp = 0;
-static HS_color_t current_HS = {0, 0};
-static RGB_color_t mRGB;
+
+typedef struct strip_driver strip_driver_t;
+
+typedef enum {
+    RAMP_BRIGHTNESS = 0,
+    RAMP_HUE,
+    RAMP_SATURATION,
+    RAMP_TEMPERATURE,
+    RAMP_COUNT,
+} ramp_id_t;
+
+/* Transition of a value, interpolated by the refresh task */
+typedef struct {
+    bool active;
+    int64_t start_us;
+    int64_t duration_us;
+    int32_t from;
+    int32_t to;
+} ramp_t;
+
+/* Pixels of the strip driven as one light, the handle of the driver APIs */
+typedef struct segment {
+    strip_driver_t *strip;
+    uint16_t first_pixel;
+    uint16_t pixel_count;
+    bool power;
+    uint8_t brightness;
+    /* Last brightness other than 0, restored when the power is set */
+    uint8_t last_brightness;
+    uint32_t temperature;
+    HS_color_t HS;
+    ramp_t ramps[RAMP_COUNT];
+    struct segment *next;
+} segment_t;
+
+struct strip_driver {
+    led_strip_t *strip;
+    uint16_t pixel_count;
+    uint16_t refresh_period_ms;
+    uint16_t task_period_ms;
+    /* Frame the segments draw into, pushed to the strip by the refresh task or on each change */
+    RGB_color_t *frame;
+    bool dirty;
+    /* Protects the frame and the state of the segments */
+    portMUX_TYPE frame_lock;
+    TaskHandle_t refresh_task;
+    segment_t segment;
+};
+
+static esp_err_t push_frame(strip_driver_t *driver)
+{
+    led_strip_t *strip = driver->strip;
+    esp_err_t err = ESP_OK;
+    taskENTER_CRITICAL(&driver->frame_lock);
+    driver->dirty = false;
+    for (uint16_t i = 0; i < driver->pixel_count && err == ESP_OK; i++) {
+        RGB_color_t *pixel = &driver->frame[i];
+        err = strip->set_pixel(strip, i, pixel->red, pixel->green, pixel->blue);
+    }
+    taskEXIT_CRITICAL(&driver->frame_lock);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "strip_set_pixel failed");
+        return err;
+    }
+    err = strip->refresh(strip, 100);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "strip_refresh failed");
+    }
+    return err;
+}
+
+/* Called with the frame lock held */
+static void draw_segment(segment_t *segment)
+{
+    strip_driver_t *driver = segment->strip;
+    RGB_color_t RGB;
+    hsv_to_rgb(segment->HS, segment->power ? segment->brightness : 0, &RGB);
+    for (uint16_t i = 0; i < segment->pixel_count; i++) {
+        driver->frame[segment->first_pixel + i] = RGB;
+    }
+    driver->dirty = true;
+}
+
+/* Called with the frame lock held */
+static void set_value(segment_t *segment, ramp_id_t id, int32_t value)
+{
+    switch (id) {
+    case RAMP_BRIGHTNESS:
+        segment->brightness = value;
+        if (value != 0) {
+            segment->last_brightness = value;
+        }
+        break;
+    case RAMP_HUE:
+        segment->HS.hue = (value % 360 + 360) % 360;
+        break;
+    case RAMP_SATURATION:
+        segment->HS.saturation = value;
+        break;
+    case RAMP_TEMPERATURE:
+        segment->temperature = value;
+        temp_to_hs(segment->temperature, &segment->HS);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Called with the frame lock held, returns true if the segment has a running transition */
+static bool step_ramps(segment_t *segment, int64_t now_us)
+{
+    bool changed = false;
+    bool running = false;
+    for (int id = 0; id < RAMP_COUNT; id++) {
+        ramp_t *ramp = &segment->ramps[id];
+        if (!ramp->active) {
+            continue;
+        }
+        int64_t elapsed_us = now_us - ramp->start_us;
+        int32_t value = ramp->to;
+        if (elapsed_us < ramp->duration_us) {
+            value = ramp->from + (int32_t)((int64_t)(ramp->to - ramp->from) * elapsed_us / ramp->duration_us);
+            running = true;
+        } else {
+            ramp->active = false;
+        }
+        set_value(segment, (ramp_id_t)id, value);
+        changed = true;
+    }
+    if (changed) {
+        draw_segment(segment);
+    }
+    return running;
+}
+
+static void refresh_task(void *arg)
+{
+    strip_driver_t *driver = (strip_driver_t *)arg;
+    TickType_t last_wake = xTaskGetTickCount();
+    while (true) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(driver->task_period_ms));
+        int64_t now_us = esp_timer_get_time();
+        taskENTER_CRITICAL(&driver->frame_lock);
+        for (segment_t *segment = &driver->segment; segment; segment = segment->next) {
+            step_ramps(segment, now_us);
+        }
+        taskEXIT_CRITICAL(&driver->frame_lock);
+        // The frame is pushed once per tick, whatever the number of changes since the last one
+        if (driver->dirty) {
+            push_frame(driver);
+        }
+    }
+}
+
+static esp_err_t start_refresh_task(strip_driver_t *driver, uint16_t period_ms)
+{
+    if (driver->refresh_task) {
+        return ESP_OK;
+    }
+    driver->task_period_ms = period_ms;
+    if (xTaskCreate(refresh_task, "led_refresh", 2048, driver, 5, &driver->refresh_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create the refresh task");
+        driver->refresh_task = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
 
 led_driver_handle_t led_driver_init(led_driver_config_t *config)
 {
     ESP_LOGI(TAG, "Initializing light driver");
     esp_err_t err = ESP_OK;
+    uint16_t pixel_count = config->pixel_count > 0 ? config->pixel_count : 1;
     rmt_config_t rmt_cfg = RMT_DEFAULT_CONFIG_TX(config->gpio, config->channel);
     rmt_cfg.clk_div = 2;
     err = rmt_config(&rmt_cfg);
@@ -41,76 +211,171 @@ led_driver_handle_t led_driver_init(led_driver_config_t *config)
         return NULL;
     }
 
-    led_strip_config_t strip_config = LED_STRIP_DEFAULT_CONFIG(1, (led_strip_dev_t)rmt_cfg.channel);
+    led_strip_config_t strip_config = LED_STRIP_DEFAULT_CONFIG(pixel_count, (led_strip_dev_t)rmt_cfg.channel);
     led_strip_t *strip = led_strip_new_rmt_ws2812(&strip_config);
     if (!strip) {
         ESP_LOGE(TAG, "W2812 driver install failed");
         return NULL;
     }
-    return (led_driver_handle_t)strip;
+
+    strip_driver_t *driver = (strip_driver_t *)calloc(1, sizeof(strip_driver_t));
+    RGB_color_t *frame = (RGB_color_t *)calloc(pixel_count, sizeof(RGB_color_t));
+    if (!driver || !frame) {
+        ESP_LOGE(TAG, "Failed to allocate the frame buffer of %u pixels", pixel_count);
+        free(driver);
+        free(frame);
+        strip->del(strip);
+        return NULL;
+    }
+    driver->strip = strip;
+    driver->pixel_count = pixel_count;
+    driver->refresh_period_ms = config->refresh_period_ms;
+    driver->frame = frame;
+    portMUX_INITIALIZE(&driver->frame_lock);
+    /* The handle of the init is the segment of the whole strip */
+    driver->segment.strip = driver;
+    driver->segment.first_pixel = 0;
+    driver->segment.pixel_count = pixel_count;
+
+    if (driver->refresh_period_ms > 0 && start_refresh_task(driver, driver->refresh_period_ms) != ESP_OK) {
+        ESP_LOGE(TAG, "The strip is refreshed on each change");
+        driver->refresh_period_ms = 0;
+    }
+    return (led_driver_handle_t)&driver->segment;
 }
 
-esp_err_t led_driver_set_power(led_driver_handle_t handle, bool power)
+led_driver_handle_t led_driver_add_segment(led_driver_handle_t handle, uint16_t first_pixel, uint16_t pixel_count)
 {
-    current_power = power;
-    return led_driver_set_brightness(handle, current_brightness);
+    if (!handle) {
+        ESP_LOGE(TAG, "led driver handle cannot be NULL");
+        return NULL;
+    }
+    strip_driver_t *driver = ((segment_t *)handle)->strip;
+    if (pixel_count == 0 || first_pixel >= driver->pixel_count || pixel_count > driver->pixel_count - first_pixel) {
+        ESP_LOGE(TAG, "Segment %u+%u is out of the %u pixels of the strip", first_pixel, pixel_count,
+                 driver->pixel_count);
+        return NULL;
+    }
+    segment_t *segment = (segment_t *)calloc(1, sizeof(segment_t));
+    if (!segment) {
+        ESP_LOGE(TAG, "Failed to allocate the segment");
+        return NULL;
+    }
+    segment->strip = driver;
+    segment->first_pixel = first_pixel;
+    segment->pixel_count = pixel_count;
+    /* Kept in a list for the lifetime of the driver, after the segment of the whole strip */
+    taskENTER_CRITICAL(&driver->frame_lock);
+    segment->next = driver->segment.next;
+    driver->segment.next = segment;
+    taskEXIT_CRITICAL(&driver->frame_lock);
+    return (led_driver_handle_t)segment;
 }
 
-esp_err_t led_driver_set_RGB(led_driver_handle_t handle)
+/* Set a value of the segment at once, or over transition_ms, and draw it */
+static esp_err_t set_segment_value(led_driver_handle_t handle, ramp_id_t id, int32_t value, uint32_t transition_ms)
 {
-    esp_err_t err = ESP_OK;
     if (!handle) {
         ESP_LOGE(TAG, "led driver handle cannot be NULL");
-        err = ESP_FAIL;
+        return ESP_FAIL;
+    }
+    segment_t *segment = (segment_t *)handle;
+    strip_driver_t *driver = segment->strip;
+    if (transition_ms > 0 && start_refresh_task(driver, TRANSITION_REFRESH_PERIOD_MS) != ESP_OK) {
+        transition_ms = 0;
+    }
+
+    taskENTER_CRITICAL(&driver->frame_lock);
+    ramp_t *ramp = &segment->ramps[id];
+    if (transition_ms == 0) {
+        ramp->active = false;
+        set_value(segment, id, value);
+        draw_segment(segment);
     } else {
-        led_strip_t *strip = (led_strip_t *)handle;
-        err = strip->set_pixel(strip, 0, mRGB.red, mRGB.green, mRGB.blue);
-        if (err != ESP_OK) {
-            ESP_LOGE(TAG, "strip_set_pixel failed");
-            return err;
+        // A transition started during another one starts from the current value
+        switch (id) {
+        case RAMP_BRIGHTNESS: ramp->from = segment->brightness; break;
+        case RAMP_HUE: ramp->from = segment->HS.hue; break;
+        case RAMP_SATURATION: ramp->from = segment->HS.saturation; break;
+        default: ramp->from = segment->temperature ? segment->temperature : value; break;
         }
-        ESP_LOGI(TAG, "led set r:%d, g:%d, b:%d", mRGB.red, mRGB.green, mRGB.blue);
-        err = strip->refresh(strip, 100);
-        if (err != ESP_OK) {
-            ESP_LOGE(TAG, "strip_refresh failed");
+        if (id == RAMP_HUE) {
+            // The hue goes the short way around the circle
+            if (value - ramp->from > 180) {
+                value -= 360;
+            } else if (ramp->from - value > 180) {
+                value += 360;
+            }
         }
+        ramp->to = value;
+        ramp->start_us = esp_timer_get_time();
+        ramp->duration_us = (int64_t)transition_ms * 1000;
+        ramp->active = true;
     }
-    return err;
+    RGB_color_t RGB = driver->frame[segment->first_pixel];
+    taskEXIT_CRITICAL(&driver->frame_lock);
+
+    if (transition_ms > 0) {
+        return ESP_OK;
+    }
+    ESP_LOGI(TAG, "led set r:%d, g:%d, b:%d on pixels %u+%u", RGB.red, RGB.green, RGB.blue, segment->first_pixel,
+             segment->pixel_count);
+    if (driver->refresh_period_ms > 0) {
+        return ESP_OK;
+    }
+    return push_frame(driver);
 }
 
-esp_err_t led_driver_set_brightness(led_driver_handle_t handle, uint8_t brightness)
+esp_err_t led_driver_set_power(led_driver_handle_t handle, bool power)
 {
-    if (brightness != 0) {
-        current_brightness = brightness;
-    }
-    if (!current_power) {
-        brightness = 0;
+    if (!handle) {
+        ESP_LOGE(TAG, "led driver handle cannot be NULL");
+        return ESP_FAIL;
     }
-    hsv_to_rgb(current_HS, brightness, &mRGB);
-    return led_driver_set_RGB(handle);
+    segment_t *segment = (segment_t *)handle;
+    taskENTER_CRITICAL(&segment->strip->frame_lock);
+    segment->power = power;
+    taskEXIT_CRITICAL(&segment->strip->frame_lock);
+    return set_segment_value(handle, RAMP_BRIGHTNESS, segment->last_brightness, 0);
+}
+
+esp_err_t led_driver_set_brightness(led_driver_handle_t handle, uint8_t brightness)
+{
+    return set_segment_value(handle, RAMP_BRIGHTNESS, brightness, 0);
 }
 
 esp_err_t led_driver_set_hue(led_driver_handle_t handle, uint16_t hue)
 {
-    uint8_t brightness = current_power ? current_brightness : 0;
-    current_HS.hue = hue;
-    hsv_to_rgb(current_HS, brightness, &mRGB);
-    return led_driver_set_RGB(handle);
+    return set_segment_value(handle, RAMP_HUE, hue, 0);
 }
 
 esp_err_t led_driver_set_saturation(led_driver_handle_t handle, uint8_t saturation)
 {
-    uint8_t brightness = current_power ? current_brightness : 0;
-    current_HS.saturation = saturation;
-    hsv_to_rgb(current_HS, brightness, &mRGB);
-    return led_driver_set_RGB(handle);
+    return set_segment_value(handle, RAMP_SATURATION, saturation, 0);
 }
 
 esp_err_t led_driver_set_temperature(led_driver_handle_t handle, uint32_t temperature)
 {
-    uint8_t brightness = current_power ? current_brightness : 0;
-    current_temp = temperature;
-    temp_to_hs(current_temp, &current_HS);
-    hsv_to_rgb(current_HS, brightness, &mRGB);
-    return led_driver_set_RGB(handle);
+    return set_segment_value(handle, RAMP_TEMPERATURE, temperature, 0);
+}
+
+esp_err_t led_driver_set_brightness_transition(led_driver_handle_t handle, uint8_t brightness, uint32_t transition_ms)
+{
+    return set_segment_value(handle, RAMP_BRIGHTNESS, brightness, transition_ms);
+}
+
+esp_err_t led_driver_set_hue_transition(led_driver_handle_t handle, uint16_t hue, uint32_t transition_ms)
+{
+    return set_segment_value(handle, RAMP_HUE, hue % 360, transition_ms);
+}
+
+esp_err_t led_driver_set_saturation_transition(led_driver_handle_t handle, uint8_t saturation, uint32_t transition_ms)
+{
+    return set_segment_value(handle, RAMP_SATURATION, saturation, transition_ms);
+}
+
+esp_err_t led_driver_set_temperature_transition(led_driver_handle_t handle, uint32_t temperature,
+                                                uint32_t transition_ms)
+{
+    return set_segment_value(handle, RAMP_TEMPERATURE, temperature, transition_ms);
 }
@@ -113,6 +113,9 @@ static struct esp_ble_mesh_key {
     uint8_t  app_key[16];
 } prov_key;
 
+/* Transaction identifier of the group messages, the nodes ignore a message repeating the last identifier */
+static uint8_t s_group_tid = 0;
+
 typedef struct {
     uint8_t  uuid[16];
     uint16_t unicast;
@@ -287,6 +290,48 @@ esp_err_t app_ble_mesh_onoff_set(uint16_t blemesh_addr, bool onoff)
     return err;
 }
 
+esp_err_t app_ble_mesh_group_onoff_set(uint16_t group_addr, bool onoff)
+{
+    esp_ble_mesh_client_common_param_t common = {0};
+    esp_ble_mesh_generic_client_set_state_t set_state = {0};
+
+    if (!ESP_BLE_MESH_ADDR_IS_GROUP(group_addr)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    /* The Set is not acknowledged, so that the members of the group do not all answer with a status message */
+    ble_mesh_set_msg_common(&common, group_addr, onoff_client.model, ESP_BLE_MESH_MODEL_OP_GEN_ONOFF_SET_UNACK);
+    set_state.onoff_set.op_en = false;
+    set_state.onoff_set.onoff = onoff;
+    set_state.onoff_set.tid = s_group_tid++;
+
+    return esp_ble_mesh_generic_client_set_state(&common, &set_state);
+}
+
+esp_err_t app_ble_mesh_group_subscribe(uint16_t blemesh_addr, uint16_t group_addr, bool subscribe)
+{
+    esp_ble_mesh_client_common_param_t common = {0};
+    esp_ble_mesh_cfg_client_set_state_t set_state = {0};
+
+    if (!ESP_BLE_MESH_ADDR_IS_UNICAST(blemesh_addr) || !ESP_BLE_MESH_ADDR_IS_GROUP(group_addr)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (subscribe) {
+        ble_mesh_set_msg_common(&common, blemesh_addr, config_client.model, ESP_BLE_MESH_MODEL_OP_MODEL_SUB_ADD);
+        set_state.model_sub_add.element_addr = blemesh_addr;
+        set_state.model_sub_add.sub_addr = group_addr;
+        set_state.model_sub_add.model_id = ESP_BLE_MESH_MODEL_ID_GEN_ONOFF_SRV;
+        set_state.model_sub_add.company_id = ESP_BLE_MESH_CID_NVAL;
+    } else {
+        ble_mesh_set_msg_common(&common, blemesh_addr, config_client.model, ESP_BLE_MESH_MODEL_OP_MODEL_SUB_DELETE);
+        set_state.model_sub_delete.element_addr = blemesh_addr;
+        set_state.model_sub_delete.sub_addr = group_addr;
+        set_state.model_sub_delete.model_id = ESP_BLE_MESH_MODEL_ID_GEN_ONOFF_SRV;
+        set_state.model_sub_delete.company_id = ESP_BLE_MESH_CID_NVAL;
+    }
+
+    return esp_ble_mesh_config_client_set_state(&common, &set_state);
+}
+
 static void ble_mesh_ble_cb(esp_ble_mesh_ble_cb_event_t event, esp_ble_mesh_ble_cb_param_t *param)
 {
     switch (event) {
@@ -31,6 +31,30 @@ esp_err_t app_ble_mesh_init(void);
  */
 esp_err_t app_ble_mesh_onoff_set(uint16_t blemesh_addr, bool onoff);
 
+/** Publish a Generic OnOff Set Unacknowledged message to a group address
+ *
+ * @param[in] group_addr Group address, subscribed by the nodes with app_ble_mesh_group_subscribe().
+ * @param[in] onoff OnOff state.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_ble_mesh_group_onoff_set(uint16_t group_addr, bool onoff);
+
+/** Subscribe the Generic OnOff Server of a node to a group address, or remove the subscription
+ *
+ * The Generic OnOff messages published to the group address with app_ble_mesh_group_onoff_set() are then received
+ * by all the subscribed nodes.
+ *
+ * @param[in] blemesh_addr Unicast address of the node.
+ * @param[in] group_addr Group address.
+ * @param[in] subscribe true to add the subscription, false to delete it.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_ble_mesh_group_subscribe(uint16_t blemesh_addr, uint16_t group_addr, bool subscribe);
+
 /**
  * @brief
  *
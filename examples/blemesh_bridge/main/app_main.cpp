@@ -85,6 +85,9 @@ esp_err_t create_bridge_devices(esp_matter::endpoint_t *ep, uint32_t device_type
     case ESP_MATTER_ON_OFF_LIGHT_DEVICE_TYPE_ID: {
         on_off_light::config_t on_off_light_conf;
         err = on_off_light::add(ep, &on_off_light_conf);
+        if (err == ESP_OK) {
+            err = blemesh_bridge_add_command_callbacks(ep);
+        }
         break;
     }
     case ESP_MATTER_DIMMABLE_LIGHT_DEVICE_TYPE_ID: {
@@ -18,6 +18,10 @@
 #include <blemesh_bridge.h>
 #include <app_blemesh.h>
 
+#include <app/CommandHandler.h>
+#include <lib/core/NodeId.h>
+#include <platform/CHIPDeviceLayer.h>
+
 static const char *TAG = "blemesh_bridge";
 
 using namespace chip::app::Clusters;
@@ -25,6 +29,33 @@ using namespace esp_matter;
 using namespace esp_matter::cluster;
 extern uint16_t aggregator_endpoint_id;
 
+#define BLEMESH_BRIDGE_MAX_GROUP_MEMBERSHIPS CONFIG_BLEMESH_BRIDGE_MAX_GROUP_MEMBERSHIPS
+/* The Matter groups are mapped to the group addresses 0xC000 - 0xFEFF, the fixed group addresses are not used */
+#define BLEMESH_GROUP_ADDR_BASE 0xC000
+#define BLEMESH_GROUP_ADDR_COUNT 0x3F00
+
+/* Matter group membership of a bridged device, mirrored as a subscription of the BLE Mesh node */
+typedef struct {
+    uint16_t blemesh_addr;
+    uint16_t group_id;
+} group_membership_t;
+
+/* Matter group command being dispatched to the bridged endpoints */
+typedef struct {
+    /* Endpoint which received the command, the OnOff attribute of which is updated right after */
+    uint16_t endpoint_id;
+    uint16_t group_id;
+    /* The group address was published with this value, the other members of the group are not sent a message */
+    bool published;
+    bool onoff;
+} group_dispatch_t;
+
+/* Accessed in the Matter context only */
+static group_membership_t s_group_memberships[BLEMESH_BRIDGE_MAX_GROUP_MEMBERSHIPS];
+static size_t s_group_membership_count = 0;
+static group_dispatch_t s_group_dispatch = {chip::kInvalidEndpointId, 0, false, false};
+static bool s_group_dispatch_clear_scheduled = false;
+
 
 /** Mesh Spec 4.2.1: "The Composition Data state contains information about a node, 
  * the elements it includes, and the supported models. Composition Data Page 0 is mandatory." 
@@ -68,6 +99,171 @@ esp_err_t blemesh_bridge_match_bridged_onoff_light(uint8_t *composition_data, ui
     return ESP_OK;
 }
 
+/** Matter groups **/
+static uint16_t get_group_addr(uint16_t group_id)
+{
+    return BLEMESH_GROUP_ADDR_BASE + group_id % BLEMESH_GROUP_ADDR_COUNT;
+}
+
+/* A group is published to its group address if the node is subscribed to it, and if no other mirrored group shares
+ * the address: the members of such groups get unicast messages */
+static bool can_publish_group(uint16_t blemesh_addr, uint16_t group_id)
+{
+    bool is_member = false;
+    for (size_t index = 0; index < s_group_membership_count; index++) {
+        const group_membership_t *membership = &s_group_memberships[index];
+        if (membership->group_id == group_id) {
+            is_member |= membership->blemesh_addr == blemesh_addr;
+        } else if (get_group_addr(membership->group_id) == get_group_addr(group_id)) {
+            return false;
+        }
+    }
+    return is_member;
+}
+
+static void clear_group_dispatch(intptr_t arg)
+{
+    s_group_dispatch = {chip::kInvalidEndpointId, 0, false, false};
+    s_group_dispatch_clear_scheduled = false;
+}
+
+static void schedule_group_dispatch_clear()
+{
+    /* All the endpoints of a group command are updated in the same Matter event */
+    if (!s_group_dispatch_clear_scheduled &&
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(clear_group_dispatch, 0) == CHIP_NO_ERROR) {
+        s_group_dispatch_clear_scheduled = true;
+    }
+}
+
+static esp_err_t on_off_command_cb(const ConcreteCommandPath &command_path, TLVReader &tlv_data, void *opaque_ptr)
+{
+    chip::app::CommandHandler *command_obj = (chip::app::CommandHandler *)opaque_ptr;
+    if (!command_obj) {
+        return ESP_OK;
+    }
+    chip::Access::SubjectDescriptor subject = command_obj->GetSubjectDescriptor();
+    if (subject.authMode != chip::Access::AuthMode::kGroup) {
+        s_group_dispatch.endpoint_id = chip::kInvalidEndpointId;
+        return ESP_OK;
+    }
+    uint16_t group_id = chip::GroupIdFromNodeId(subject.subject);
+    if (group_id != s_group_dispatch.group_id) {
+        s_group_dispatch.group_id = group_id;
+        s_group_dispatch.published = false;
+    }
+    s_group_dispatch.endpoint_id = command_path.mEndpointId;
+    schedule_group_dispatch_clear();
+    return ESP_OK;
+}
+
+/* Returns true if the update was sent to the group address of the current group command */
+static bool publish_group_update(uint16_t endpoint_id, uint16_t blemesh_addr, bool onoff)
+{
+    if (s_group_dispatch.endpoint_id != endpoint_id) {
+        return false;
+    }
+    s_group_dispatch.endpoint_id = chip::kInvalidEndpointId;
+    if (!can_publish_group(blemesh_addr, s_group_dispatch.group_id)) {
+        return false;
+    }
+    if (s_group_dispatch.published) {
+        /* The members of a group toggled from different states are corrected with a unicast message */
+        return s_group_dispatch.onoff == onoff;
+    }
+    uint16_t group_addr = get_group_addr(s_group_dispatch.group_id);
+    if (app_ble_mesh_group_onoff_set(group_addr, onoff) != ESP_OK) {
+        return false;
+    }
+    ESP_LOGD(TAG, "Published group 0x%04x to the group address 0x%04x", s_group_dispatch.group_id, group_addr);
+    s_group_dispatch.published = true;
+    s_group_dispatch.onoff = onoff;
+    return true;
+}
+
+static void remove_group_memberships(uint16_t blemesh_addr, bool all_groups, uint16_t group_id)
+{
+    size_t index = 0;
+    while (index < s_group_membership_count) {
+        group_membership_t *membership = &s_group_memberships[index];
+        if (membership->blemesh_addr == blemesh_addr && (all_groups || membership->group_id == group_id)) {
+            app_ble_mesh_group_subscribe(blemesh_addr, get_group_addr(membership->group_id), false);
+            *membership = s_group_memberships[--s_group_membership_count];
+        } else {
+            index++;
+        }
+    }
+}
+
+static esp_err_t groups_command_cb(const ConcreteCommandPath &command_path, TLVReader &tlv_data, void *opaque_ptr)
+{
+    app_bridged_device_t *blemesh_device =
+        (app_bridged_device_t *)esp_matter::endpoint::get_priv_data(command_path.mEndpointId);
+    if (!blemesh_device || blemesh_device->dev_type != ESP_MATTER_BRIDGED_DEVICE_TYPE_BLEMESH) {
+        return ESP_OK;
+    }
+    uint16_t blemesh_addr = blemesh_device->dev_addr.blemesh_addr;
+    if (command_path.mCommandId == Groups::Commands::RemoveAllGroups::Id) {
+        remove_group_memberships(blemesh_addr, true, 0);
+        return ESP_OK;
+    }
+    uint16_t group_id = 0;
+    if (command_path.mCommandId == Groups::Commands::AddGroup::Id) {
+        Groups::Commands::AddGroup::DecodableType command_data;
+        if (chip::app::DataModel::Decode(tlv_data, command_data) != CHIP_NO_ERROR) {
+            return ESP_OK;
+        }
+        group_id = command_data.groupID;
+    } else {
+        Groups::Commands::RemoveGroup::DecodableType command_data;
+        if (chip::app::DataModel::Decode(tlv_data, command_data) != CHIP_NO_ERROR) {
+            return ESP_OK;
+        }
+        group_id = command_data.groupID;
+    }
+    remove_group_memberships(blemesh_addr, false, group_id);
+    if (command_path.mCommandId == Groups::Commands::AddGroup::Id) {
+        if (s_group_membership_count == BLEMESH_BRIDGE_MAX_GROUP_MEMBERSHIPS) {
+            /* The group commands of this device are sent as unicast messages */
+            ESP_LOGW(TAG, "No room to mirror group 0x%04x to the BLE Mesh node 0x%04x", group_id, blemesh_addr);
+            return ESP_OK;
+        }
+        if (app_ble_mesh_group_subscribe(blemesh_addr, get_group_addr(group_id), true) != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to subscribe the BLE Mesh node 0x%04x to group 0x%04x", blemesh_addr, group_id);
+            return ESP_OK;
+        }
+        group_membership_t *membership = &s_group_memberships[s_group_membership_count++];
+        membership->blemesh_addr = blemesh_addr;
+        membership->group_id = group_id;
+    }
+    return ESP_OK;
+}
+
+esp_err_t blemesh_bridge_add_command_callbacks(endpoint_t *endpoint)
+{
+    static const uint32_t on_off_commands[] = {OnOff::Commands::Off::Id, OnOff::Commands::On::Id,
+                                               OnOff::Commands::Toggle::Id};
+    static const uint32_t groups_commands[] = {Groups::Commands::AddGroup::Id, Groups::Commands::RemoveGroup::Id,
+                                               Groups::Commands::RemoveAllGroups::Id};
+    cluster_t *on_off_cluster = cluster::get(endpoint, OnOff::Id);
+    cluster_t *groups_cluster = cluster::get(endpoint, Groups::Id);
+    ESP_RETURN_ON_FALSE(on_off_cluster && groups_cluster, ESP_ERR_INVALID_ARG, TAG,
+                        "The endpoint has no OnOff or Groups cluster");
+    for (uint32_t command_id : on_off_commands) {
+        command_t *command = command::get(on_off_cluster, command_id, COMMAND_FLAG_ACCEPTED);
+        if (command) {
+            command::set_user_callback(command, on_off_command_cb);
+        }
+    }
+    for (uint32_t command_id : groups_commands) {
+        command_t *command = command::get(groups_cluster, command_id, COMMAND_FLAG_ACCEPTED);
+        if (command) {
+            command::set_user_callback(command, groups_command_cb);
+        }
+    }
+    return ESP_OK;
+}
+
 esp_err_t blemesh_bridge_attribute_update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
                                           esp_matter_attr_val_t *val, app_bridged_device_t *bridged_device)
 {
@@ -76,7 +272,10 @@ esp_err_t blemesh_bridge_attribute_update(uint16_t endpoint_id, uint32_t cluster
             if (attribute_id == OnOff::Attributes::OnOff::Id) {
                 ESP_LOGD(TAG, "Update Bridged Device, ep: 0x%x, cluster: 0x%lx, att: 0x%lx", endpoint_id, cluster_id,
                          attribute_id);
-                app_ble_mesh_onoff_set(bridged_device->dev_addr.blemesh_addr, val->val.b);
+                uint16_t blemesh_addr = bridged_device->dev_addr.blemesh_addr;
+                if (!publish_group_update(endpoint_id, blemesh_addr, val->val.b)) {
+                    app_ble_mesh_onoff_set(blemesh_addr, val->val.b);
+                }
             }
         }
     }
@@ -35,4 +35,19 @@ esp_err_t blemesh_bridge_attribute_update(uint16_t endpoint_id, uint32_t cluster
 
 #ifdef __cplusplus
 }
+
+#include <esp_matter_core.h>
+
+/** Add the callbacks mirroring the Matter group memberships of a bridged On/Off light to the BLE Mesh node
+ *
+ * Each Matter group joined by the endpoint is mapped to a BLE Mesh group address, which the node subscribes to. An
+ * On/Off command sent to the Matter group is then published once to the group address, instead of a unicast message
+ * to each member of the group.
+ *
+ * @param[in] endpoint Bridged endpoint, with the OnOff and Groups clusters.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t blemesh_bridge_add_command_callbacks(esp_matter::endpoint_t *endpoint);
 #endif
@@ -0,0 +1,479 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <esp_matter.h>
+#include <esp_matter_bridge.h>
+#include <esp_matter_console.h>
+
+#include <app/util/attribute-storage.h>
+
+#include <app_bridge_benchmark.h>
+
+using namespace esp_matter;
+using namespace chip::app::Clusters;
+using chip::Protocols::InteractionModel::Status;
+
+static const char *TAG = "app_bridge_benchmark";
+
+static constexpr size_t k_max_devices = MAX_BRIDGED_DEVICE_COUNT;
+static constexpr size_t k_max_samples = CONFIG_BRIDGE_BENCHMARK_MAX_SAMPLES;
+
+typedef struct {
+    size_t free_heap;
+    size_t free_internal;
+} heap_snapshot_t;
+
+typedef struct {
+    bool running;
+    bool stop;
+    uint32_t rate;
+    uint32_t duration_s;
+    uint32_t issued;
+    uint32_t failed;
+    /* Reports issued more than a period after their schedule */
+    uint32_t late;
+    uint32_t sample_count;
+    uint32_t *latencies_us;
+    uint32_t *lock_waits_us;
+    size_t free_heap_min;
+} report_run_t;
+
+static node_t *s_node = nullptr;
+static uint16_t s_aggregator_endpoint_id = chip::kInvalidEndpointId;
+static esp_matter_bridge::device_t *s_devices[k_max_devices];
+static size_t s_device_count = 0;
+static report_run_t s_report;
+static uint8_t s_read_buffer[512];
+
+static heap_snapshot_t bench_heap_snapshot()
+{
+    heap_snapshot_t snapshot = {
+        .free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT),
+        .free_internal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT),
+    };
+    return snapshot;
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t la = *(const uint32_t *)a;
+    uint32_t lb = *(const uint32_t *)b;
+    return la < lb ? -1 : (la > lb ? 1 : 0);
+}
+
+/* The samples must be sorted */
+static uint32_t percentile(const uint32_t *samples, uint32_t count, uint32_t percent)
+{
+    if (count == 0) {
+        return 0;
+    }
+    /* Nearest rank */
+    uint32_t rank = (percent * count + 99) / 100;
+    return samples[rank > 0 ? rank - 1 : 0];
+}
+
+static uint32_t average(const uint32_t *samples, uint32_t count)
+{
+    uint64_t sum = 0;
+    for (uint32_t index = 0; index < count; index++) {
+        sum += samples[index];
+    }
+    return count > 0 ? (uint32_t)(sum / count) : 0;
+}
+
+/* Prints the distribution of the samples as a JSON object, the samples are sorted */
+static void print_distribution(const char *name, uint32_t *samples, uint32_t count)
+{
+    qsort(samples, count, sizeof(uint32_t), compare_u32);
+    printf("\"%s\":{\"min\":%" PRIu32 ",\"avg\":%" PRIu32 ",\"p50\":%" PRIu32 ",\"p90\":%" PRIu32 ",\"p99\":%" PRIu32
+           ",\"max\":%" PRIu32 "}", name, count > 0 ? samples[0] : 0, average(samples, count),
+           percentile(samples, count, 50), percentile(samples, count, 90), percentile(samples, count, 99),
+           count > 0 ? samples[count - 1] : 0);
+}
+
+static void print_heap(const heap_snapshot_t &start)
+{
+    heap_snapshot_t end = bench_heap_snapshot();
+    printf("\"heap\":{\"free_start\":%u,\"free_end\":%u,\"used\":%d,\"internal_used\":%d,\"lifetime_free_min\":%u}",
+           (unsigned)start.free_heap, (unsigned)end.free_heap, (int)(start.free_heap - end.free_heap),
+           (int)(start.free_internal - end.free_internal), (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+}
+
+static esp_err_t bench_enable_device(esp_matter_bridge::device_t *device)
+{
+    esp_err_t err = endpoint::enable(device->endpoint);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to enable the bridged endpoint %u", device->persistent_info.device_endpoint_id);
+        esp_matter_bridge::remove_device(device);
+        return err;
+    }
+    s_devices[s_device_count++] = device;
+    return ESP_OK;
+}
+
+esp_err_t app_bridge_benchmark_init(node_t *node, uint16_t aggregator_endpoint_id)
+{
+    s_node = node;
+    s_aggregator_endpoint_id = aggregator_endpoint_id;
+    int64_t start_us = esp_timer_get_time();
+    heap_snapshot_t heap_start = bench_heap_snapshot();
+
+    uint16_t *endpoint_ids = (uint16_t *)calloc(k_max_devices, sizeof(uint16_t));
+    esp_matter_bridge::device_t **devices =
+        (esp_matter_bridge::device_t **)calloc(k_max_devices, sizeof(esp_matter_bridge::device_t *));
+    /* The virtual devices have no private data */
+    void **priv_data = (void **)calloc(k_max_devices, sizeof(void *));
+    if (!endpoint_ids || !devices || !priv_data) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the bridged devices");
+        free(endpoint_ids);
+        free(devices);
+        free(priv_data);
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t err = esp_matter_bridge::get_bridged_endpoint_ids(endpoint_ids);
+    size_t count = 0;
+    while (err == ESP_OK && count < k_max_devices && endpoint_ids[count] != chip::kInvalidEndpointId) {
+        count++;
+    }
+    if (count > 0) {
+        /* The devices which failed to resume are NULL, they are skipped below */
+        esp_matter_bridge::resume_devices(node, endpoint_ids, priv_data, count, devices);
+    }
+    int64_t resumed_us = esp_timer_get_time();
+    for (size_t index = 0; index < count; index++) {
+        if (devices[index]) {
+            bench_enable_device(devices[index]);
+        }
+    }
+    int64_t enabled_us = esp_timer_get_time();
+    free(endpoint_ids);
+    free(devices);
+    free(priv_data);
+
+    printf("BRIDGE_BENCH_RESULT {\"op\":\"boot\",\"stored\":%u,\"devices\":%u,\"matter_started_ms\":%" PRIu32
+           ",\"resume_ms\":%" PRIu32 ",\"enable_ms\":%" PRIu32 ",\"boot_ms\":%" PRIu32 ",",
+           (unsigned)count, (unsigned)s_device_count, (uint32_t)(start_us / 1000),
+           (uint32_t)((resumed_us - start_us) / 1000), (uint32_t)((enabled_us - resumed_us) / 1000),
+           (uint32_t)(enabled_us / 1000));
+    print_heap(heap_start);
+    printf("}\n");
+    return err;
+}
+
+static uint32_t bench_device_type(const char *type, uint32_t index)
+{
+    if (strcmp(type, "light") == 0) {
+        return ESP_MATTER_ON_OFF_LIGHT_DEVICE_TYPE_ID;
+    } else if (strcmp(type, "sensor") == 0) {
+        return ESP_MATTER_TEMPERATURE_SENSOR_DEVICE_TYPE_ID;
+    } else if (strcmp(type, "mixed") == 0) {
+        return index % 2 == 0 ? ESP_MATTER_ON_OFF_LIGHT_DEVICE_TYPE_ID : ESP_MATTER_TEMPERATURE_SENSOR_DEVICE_TYPE_ID;
+    }
+    return 0;
+}
+
+static esp_err_t bench_create(uint32_t count, const char *type, bool bulk)
+{
+    if (s_report.running) {
+        ESP_LOGE(TAG, "The devices cannot be created while the reports are running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    size_t max_count = esp_matter_bridge::get_max_device_count();
+    size_t available = max_count > s_device_count ? max_count - s_device_count : 0;
+    if (count == 0 || count > available || bench_device_type(type, 0) == 0) {
+        ESP_LOGE(TAG, "Invalid device count or type, %u more devices can be created", (unsigned)available);
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint32_t *latencies_us = (uint32_t *)calloc(count, sizeof(uint32_t));
+    esp_matter_bridge::device_spec_t *specs =
+        bulk ? (esp_matter_bridge::device_spec_t *)calloc(count, sizeof(esp_matter_bridge::device_spec_t)) : nullptr;
+    esp_matter_bridge::device_t **devices =
+        bulk ? (esp_matter_bridge::device_t **)calloc(count, sizeof(esp_matter_bridge::device_t *)) : nullptr;
+    if (!latencies_us || (bulk && (!specs || !devices))) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the benchmark");
+        free(latencies_us);
+        free(specs);
+        free(devices);
+        return ESP_ERR_NO_MEM;
+    }
+
+    heap_snapshot_t heap_start = bench_heap_snapshot();
+    int64_t start_us = esp_timer_get_time();
+    uint32_t created = 0;
+    if (bulk) {
+        for (uint32_t index = 0; index < count; index++) {
+            specs[index].device_type_id = bench_device_type(type, index);
+        }
+        esp_matter_bridge::create_devices(s_node, s_aggregator_endpoint_id, specs, count, devices);
+        for (uint32_t index = 0; index < count; index++) {
+            int64_t device_start_us = esp_timer_get_time();
+            if (devices[index] && bench_enable_device(devices[index]) == ESP_OK) {
+                /* The creation is done for all the devices at once, only the enable time is per device */
+                latencies_us[created++] = (uint32_t)(esp_timer_get_time() - device_start_us);
+            }
+        }
+    } else {
+        for (uint32_t index = 0; index < count; index++) {
+            int64_t device_start_us = esp_timer_get_time();
+            esp_matter_bridge::device_t *device = esp_matter_bridge::create_device(
+                s_node, s_aggregator_endpoint_id, bench_device_type(type, index), nullptr);
+            if (device && bench_enable_device(device) == ESP_OK) {
+                latencies_us[created++] = (uint32_t)(esp_timer_get_time() - device_start_us);
+            }
+        }
+    }
+    uint32_t duration_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+
+    printf("BRIDGE_BENCH_RESULT {\"op\":\"create\",\"type\":\"%s\",\"bulk\":%s,\"count\":%" PRIu32
+           ",\"created\":%" PRIu32 ",\"devices\":%u,\"duration_ms\":%" PRIu32 ",", type, bulk ? "true" : "false",
+           count, created, (unsigned)s_device_count, duration_ms);
+    print_distribution("latency_us", latencies_us, created);
+    printf(",");
+    print_heap(heap_start);
+    printf("}\n");
+    free(latencies_us);
+    free(specs);
+    free(devices);
+    return created == count ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t bench_clear()
+{
+    if (s_report.running) {
+        ESP_LOGE(TAG, "The devices cannot be removed while the reports are running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    heap_snapshot_t heap_start = bench_heap_snapshot();
+    int64_t start_us = esp_timer_get_time();
+    size_t count = s_device_count;
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    esp_matter_bridge::begin_persistence_batch();
+    while (s_device_count > 0) {
+        esp_matter_bridge::remove_device(s_devices[--s_device_count]);
+    }
+    esp_err_t err = esp_matter_bridge::end_persistence_batch();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    printf("BRIDGE_BENCH_RESULT {\"op\":\"clear\",\"removed\":%u,\"duration_ms\":%" PRIu32 ",", (unsigned)count,
+           (uint32_t)((esp_timer_get_time() - start_us) / 1000));
+    print_heap(heap_start);
+    printf("}\n");
+    return err;
+}
+
+static esp_err_t bench_report_device(esp_matter_bridge::device_t *device, uint32_t round, uint32_t *lock_wait_us)
+{
+    int64_t start_us = esp_timer_get_time();
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    *lock_wait_us = (uint32_t)(esp_timer_get_time() - start_us);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    uint16_t endpoint_id = device->persistent_info.device_endpoint_id;
+    esp_err_t err = ESP_ERR_NOT_SUPPORTED;
+    if (device->persistent_info.device_type_id == ESP_MATTER_ON_OFF_LIGHT_DEVICE_TYPE_ID) {
+        esp_matter_attr_val_t val = esp_matter_bool(round % 2 == 1);
+        err = attribute::update(endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val);
+    } else if (device->persistent_info.device_type_id == ESP_MATTER_TEMPERATURE_SENSOR_DEVICE_TYPE_ID) {
+        /* 20.00 to 24.99 degrees Celsius */
+        esp_matter_attr_val_t val = esp_matter_nullable_int16((int16_t)(2000 + round % 500));
+        err = attribute::update(endpoint_id, TemperatureMeasurement::Id,
+                                TemperatureMeasurement::Attributes::MeasuredValue::Id, &val);
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+static void bench_report_task(void *arg)
+{
+    heap_snapshot_t heap_start = bench_heap_snapshot();
+    int64_t period_us = 1000000 / s_report.rate;
+    int64_t start_us = esp_timer_get_time();
+    int64_t end_us = start_us + (int64_t)s_report.duration_s * 1000000;
+    int64_t next_us = start_us;
+    s_report.free_heap_min = heap_start.free_heap;
+
+    while (!s_report.stop && next_us < end_us) {
+        int64_t now_us = esp_timer_get_time();
+        if (now_us < next_us) {
+            /* The reports due during the delay are issued back to back when the tick period exceeds the rate */
+            TickType_t ticks = pdMS_TO_TICKS((next_us - now_us) / 1000);
+            vTaskDelay(ticks > 0 ? ticks : 1);
+            continue;
+        }
+        if (now_us - next_us > period_us) {
+            s_report.late++;
+        }
+        esp_matter_bridge::device_t *device = s_devices[s_report.issued % s_device_count];
+        uint32_t round = s_report.issued / s_device_count;
+        uint32_t lock_wait_us = 0;
+        esp_err_t err = bench_report_device(device, round, &lock_wait_us);
+        uint32_t latency_us = (uint32_t)(esp_timer_get_time() - now_us);
+        s_report.issued++;
+        if (err != ESP_OK) {
+            s_report.failed++;
+        } else if (s_report.sample_count < k_max_samples) {
+            s_report.latencies_us[s_report.sample_count] = latency_us;
+            s_report.lock_waits_us[s_report.sample_count] = lock_wait_us;
+            s_report.sample_count++;
+        }
+        size_t free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        if (free_heap < s_report.free_heap_min) {
+            s_report.free_heap_min = free_heap;
+        }
+        next_us += period_us;
+    }
+
+    uint32_t duration_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+    printf("BRIDGE_BENCH_RESULT {\"op\":\"report\",\"devices\":%u,\"rate\":%" PRIu32 ",\"issued\":%" PRIu32
+           ",\"failed\":%" PRIu32 ",\"late\":%" PRIu32 ",\"samples\":%" PRIu32 ",\"duration_ms\":%" PRIu32
+           ",\"reports_per_sec\":%.2f,", (unsigned)s_device_count, s_report.rate, s_report.issued, s_report.failed,
+           s_report.late, s_report.sample_count, duration_ms,
+           duration_ms > 0 ? (double)s_report.issued * 1000 / duration_ms : 0.0);
+    print_distribution("latency_us", s_report.latencies_us, s_report.sample_count);
+    printf(",");
+    print_distribution("lock_wait_us", s_report.lock_waits_us, s_report.sample_count);
+    printf(",\"heap_free_min\":%u,", (unsigned)s_report.free_heap_min);
+    print_heap(heap_start);
+    printf("}\n");
+
+    free(s_report.latencies_us);
+    free(s_report.lock_waits_us);
+    s_report.latencies_us = nullptr;
+    s_report.lock_waits_us = nullptr;
+    s_report.running = false;
+    vTaskDelete(NULL);
+}
+
+static esp_err_t bench_report_start(uint32_t rate, uint32_t duration_s)
+{
+    if (s_report.running) {
+        ESP_LOGE(TAG, "The reports are already running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (s_device_count == 0 || rate == 0 || rate > 1000000 || duration_s == 0) {
+        ESP_LOGE(TAG, "Create the devices first, the rate and the duration cannot be 0");
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(&s_report, 0, sizeof(s_report));
+    s_report.rate = rate;
+    s_report.duration_s = duration_s;
+    s_report.latencies_us = (uint32_t *)calloc(k_max_samples, sizeof(uint32_t));
+    s_report.lock_waits_us = (uint32_t *)calloc(k_max_samples, sizeof(uint32_t));
+    if (!s_report.latencies_us || !s_report.lock_waits_us) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the report samples");
+        free(s_report.latencies_us);
+        free(s_report.lock_waits_us);
+        return ESP_ERR_NO_MEM;
+    }
+    s_report.running = true;
+    if (xTaskCreate(bench_report_task, "bridge_bench", CONFIG_BRIDGE_BENCHMARK_REPORT_TASK_STACK_SIZE, nullptr,
+                    CONFIG_BRIDGE_BENCHMARK_REPORT_TASK_PRIORITY, nullptr) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create the report task");
+        free(s_report.latencies_us);
+        free(s_report.lock_waits_us);
+        s_report.running = false;
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/* Reads all the attributes of the server clusters of the bridged endpoints from the data model, with the Matter stack
+ * lock held for the whole walk, as the reporting engine does when it builds the report of a wildcard read */
+static esp_err_t bench_read()
+{
+    uint32_t read = 0;
+    uint32_t failed = 0;
+    uint32_t clusters = 0;
+    int64_t start_us = esp_timer_get_time();
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    int64_t locked_us = esp_timer_get_time();
+    for (size_t index = 0; index < s_device_count; index++) {
+        uint16_t endpoint_id = s_devices[index]->persistent_info.device_endpoint_id;
+        cluster_t *cluster = cluster::get_first(s_devices[index]->endpoint);
+        for (; cluster; cluster = cluster::get_next(cluster)) {
+            uint32_t cluster_id = cluster::get_id(cluster);
+            if (!emberAfContainsServer(endpoint_id, cluster_id)) {
+                continue;
+            }
+            clusters++;
+            attribute_t *attribute = attribute::get_first(cluster);
+            for (; attribute; attribute = attribute::get_next(attribute)) {
+                Status status = emberAfReadAttribute(endpoint_id, cluster_id, attribute::get_id(attribute),
+                                                     s_read_buffer, sizeof(s_read_buffer));
+                if (status == Status::Success) {
+                    read++;
+                } else {
+                    failed++;
+                }
+            }
+        }
+    }
+    int64_t end_us = esp_timer_get_time();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    printf("BRIDGE_BENCH_RESULT {\"op\":\"read\",\"devices\":%u,\"clusters\":%" PRIu32 ",\"attributes\":%" PRIu32
+           ",\"failed\":%" PRIu32 ",\"lock_wait_us\":%" PRIu32 ",\"duration_us\":%" PRIu32 "}\n",
+           (unsigned)s_device_count, clusters, read, failed, (uint32_t)(locked_us - start_us),
+           (uint32_t)(end_us - locked_us));
+    return ESP_OK;
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t bench_console_handler(int argc, char **argv)
+{
+    if (argc >= 3 && argc <= 4 && strcmp(argv[0], "create") == 0) {
+        if (argc == 4 && strcmp(argv[3], "bulk") != 0) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        return bench_create(strtoul(argv[1], nullptr, 10), argv[2], argc == 4);
+    } else if (argc == 3 && strcmp(argv[0], "report") == 0) {
+        return bench_report_start(strtoul(argv[1], nullptr, 10), strtoul(argv[2], nullptr, 10));
+    } else if (argc == 2 && strcmp(argv[0], "report") == 0 && strcmp(argv[1], "stop") == 0) {
+        s_report.stop = true;
+        return ESP_OK;
+    } else if (argc == 1 && strcmp(argv[0], "read") == 0) {
+        return bench_read();
+    } else if (argc == 1 && strcmp(argv[0], "clear") == 0) {
+        return bench_clear();
+    }
+    ESP_LOGE(TAG, "Usage: matter esp bench <create|report|read|clear> ...");
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t app_bridge_benchmark_register_commands()
+{
+    static const esp_matter::console::command_t bench_command = {
+        .name = "bench",
+        .description = "Benchmark the bridged devices. Usage:\n"
+                       "\tmatter esp bench create <count> <light|sensor|mixed> [bulk]\n"
+                       "\tmatter esp bench report <reports_per_sec> <duration_s>\n"
+                       "\tmatter esp bench report stop\n"
+                       "\tmatter esp bench read\n"
+                       "\tmatter esp bench clear",
+        .handler = bench_console_handler,
+    };
+    return esp_matter::console::add_commands(&bench_command, 1);
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
@@ -0,0 +1,37 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+
+/** Resume the bridged devices stored in NVS.
+ *
+ * The devices are resumed and enabled, and the time since boot, the resume and enable durations and the heap usage
+ * are printed as a `BRIDGE_BENCH_RESULT` JSON line. The bridge must be initialized and Matter started.
+ *
+ * @param[in] node Node of the bridge.
+ * @param[in] aggregator_endpoint_id Aggregator endpoint of the bridged devices.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_bridge_benchmark_init(esp_matter::node_t *node, uint16_t aggregator_endpoint_id);
+
+/** Register the `matter esp bench` console command.
+ *
+ * The command creates virtual bridged lights and sensors, simulates their reports at a given rate, and walks the
+ * attributes of all the bridged endpoints as a wildcard read does. The creation time, the heap usage, the Matter stack
+ * lock wait and the report latencies are printed as `BRIDGE_BENCH_RESULT` JSON lines, to compare them as the number
+ * of bridged devices grows.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_bridge_benchmark_register_commands();
@@ -0,0 +1,112 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#include <esp_err.h>
+#include <esp_log.h>
+#include <nvs_flash.h>
+#include <esp_matter.h>
+#include <esp_matter_bridge.h>
+#include <esp_matter_console.h>
+#include <common_macros.h>
+#include <app_bridge_benchmark.h>
+
+static const char *TAG = "app_main";
+
+using namespace esp_matter;
+using namespace esp_matter::attribute;
+using namespace esp_matter::endpoint;
+
+static void app_event_cb(const ChipDeviceEvent *event, intptr_t arg)
+{
+    switch (event->Type) {
+    case chip::DeviceLayer::DeviceEventType::kCommissioningComplete:
+        ESP_LOGI(TAG, "Commissioning complete");
+        break;
+
+    case chip::DeviceLayer::DeviceEventType::kFailSafeTimerExpired:
+        ESP_LOGI(TAG, "Commissioning failed, fail safe timer expired");
+        break;
+
+    default:
+        break;
+    }
+}
+
+// The bridged devices are virtual, there is nothing to identify.
+static esp_err_t app_identification_cb(identification::callback_type_t type, uint16_t endpoint_id, uint8_t effect_id,
+                                       uint8_t effect_variant, void *priv_data)
+{
+    ESP_LOGI(TAG, "Identification callback: type: %d, effect: %d", type, effect_id);
+    return ESP_OK;
+}
+
+// The bridged devices are virtual, the attribute updates have no driver to reach.
+static esp_err_t app_attribute_update_cb(attribute::callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                                         uint32_t attribute_id, esp_matter_attr_val_t *val, void *priv_data)
+{
+    return ESP_OK;
+}
+
+static esp_err_t create_bridge_devices(esp_matter::endpoint_t *ep, uint32_t device_type_id, void *priv_data)
+{
+    esp_err_t err = ESP_OK;
+
+    switch (device_type_id) {
+    case ESP_MATTER_ON_OFF_LIGHT_DEVICE_TYPE_ID: {
+        on_off_light::config_t on_off_light_conf;
+        err = on_off_light::add(ep, &on_off_light_conf);
+        break;
+    }
+    case ESP_MATTER_TEMPERATURE_SENSOR_DEVICE_TYPE_ID: {
+        temperature_sensor::config_t temperature_sensor_conf;
+        err = temperature_sensor::add(ep, &temperature_sensor_conf);
+        break;
+    }
+    default: {
+        ESP_LOGE(TAG, "Unsupported bridged matter device type");
+        return ESP_ERR_INVALID_ARG;
+    }
+    }
+    return err;
+}
+
+extern "C" void app_main()
+{
+    esp_err_t err = ESP_OK;
+
+    /* Initialize the ESP NVS layer */
+    nvs_flash_init();
+
+    /* Create a Matter node and add the mandatory Root Node device type on endpoint 0 */
+    node::config_t node_config;
+    node_t *node = node::create(&node_config, app_attribute_update_cb, app_identification_cb);
+    ABORT_APP_ON_FAILURE(node != nullptr, ESP_LOGE(TAG, "Failed to create Matter node"));
+
+    aggregator::config_t aggregator_config;
+    endpoint_t *aggregator = endpoint::aggregator::create(node, &aggregator_config, ENDPOINT_FLAG_NONE, NULL);
+    ABORT_APP_ON_FAILURE(aggregator != nullptr, ESP_LOGE(TAG, "Failed to create aggregator endpoint"));
+
+    uint16_t aggregator_endpoint_id = endpoint::get_id(aggregator);
+    ESP_LOGI(TAG, "Aggregator created with endpoint id %d", aggregator_endpoint_id);
+
+    /* Matter start */
+    err = esp_matter::start(app_event_cb);
+    ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to start Matter, err:%d", err));
+
+    err = esp_matter_bridge::initialize(node, create_bridge_devices);
+    ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to initialize the bridge, err:%d", err));
+
+    err = app_bridge_benchmark_init(node, aggregator_endpoint_id);
+    ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to resume the bridged endpoints: %d", err));
+
+#if CONFIG_ENABLE_CHIP_SHELL
+    esp_matter::console::diagnostics_register_commands();
+    app_bridge_benchmark_register_commands();
+    esp_matter::console::init();
+#endif
+}
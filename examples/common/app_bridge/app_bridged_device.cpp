@@ -45,6 +45,126 @@ static const char *TAG = "app_bridged_device";
 app_bridged_device_t *g_bridged_device_list = NULL;
 static uint8_t g_current_bridged_device_count = 0;
 
+/** Bridged Device Indexes **/
+
+/* Open addressing tables, at most half full, of the devices by protocol address and by Matter endpoint ID, so that
+ * translating the reports of the bridged devices does not walk the device list. */
+static constexpr size_t index_capacity(size_t count)
+{
+    size_t capacity = 1;
+    while (capacity < 2 * count) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+static constexpr size_t k_index_capacity = index_capacity(MAX_BRIDGED_DEVICE_COUNT);
+static app_bridged_device_t *s_address_index[k_index_capacity];
+static app_bridged_device_t *s_endpoint_index[k_index_capacity];
+
+static uint32_t app_bridge_address_hash(app_bridged_device_type_t dev_type, const app_bridged_device_address_t &addr)
+{
+    // FNV-1a of the device type and the bytes of the address used by the lookups
+    uint32_t hash = 2166136261u ^ (uint32_t)dev_type;
+    hash *= 16777619u;
+    const uint8_t *bytes = NULL;
+    size_t len = 0;
+    switch (dev_type) {
+    case ESP_MATTER_BRIDGED_DEVICE_TYPE_ZIGBEE:
+        bytes = (const uint8_t *)&addr.zigbee_shortaddr;
+        len = sizeof(addr.zigbee_shortaddr);
+        break;
+    case ESP_MATTER_BRIDGED_DEVICE_TYPE_BLEMESH:
+        bytes = (const uint8_t *)&addr.blemesh_addr;
+        len = sizeof(addr.blemesh_addr);
+        break;
+    case ESP_MATTER_BRIDGED_DEVICE_TYPE_ESPNOW:
+        bytes = addr.espnow_macaddr;
+        len = sizeof(addr.espnow_macaddr);
+        break;
+    }
+    for (size_t idx = 0; idx < len; ++idx) {
+        hash = (hash ^ bytes[idx]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool app_bridge_address_equal(app_bridged_device_type_t dev_type, const app_bridged_device_address_t &a,
+                                     const app_bridged_device_address_t &b)
+{
+    switch (dev_type) {
+    case ESP_MATTER_BRIDGED_DEVICE_TYPE_ZIGBEE:
+        return a.zigbee_shortaddr == b.zigbee_shortaddr;
+    case ESP_MATTER_BRIDGED_DEVICE_TYPE_BLEMESH:
+        return a.blemesh_addr == b.blemesh_addr;
+    case ESP_MATTER_BRIDGED_DEVICE_TYPE_ESPNOW:
+        return !memcmp(a.espnow_macaddr, b.espnow_macaddr, sizeof(a.espnow_macaddr));
+    }
+    return false;
+}
+
+static uint32_t app_bridge_endpoint_hash(uint16_t endpoint_id)
+{
+    return (uint32_t)endpoint_id * 2654435761u;
+}
+
+static app_bridged_device_t **app_bridge_find_address_slot(app_bridged_device_type_t dev_type,
+                                                           const app_bridged_device_address_t &addr)
+{
+    size_t slot = app_bridge_address_hash(dev_type, addr) & (k_index_capacity - 1);
+    while (s_address_index[slot] && !(s_address_index[slot]->dev_type == dev_type &&
+                                      app_bridge_address_equal(dev_type, s_address_index[slot]->dev_addr, addr))) {
+        slot = (slot + 1) & (k_index_capacity - 1);
+    }
+    return &s_address_index[slot];
+}
+
+static app_bridged_device_t **app_bridge_find_endpoint_slot(uint16_t endpoint_id)
+{
+    size_t slot = app_bridge_endpoint_hash(endpoint_id) & (k_index_capacity - 1);
+    while (s_endpoint_index[slot] && endpoint::get_id(s_endpoint_index[slot]->dev->endpoint) != endpoint_id) {
+        slot = (slot + 1) & (k_index_capacity - 1);
+    }
+    return &s_endpoint_index[slot];
+}
+
+/* A new device replaces the indexed device with the same address, as the head of the device list. */
+static void app_bridge_index_device(app_bridged_device_t *bridged_device)
+{
+    *app_bridge_find_address_slot(bridged_device->dev_type, bridged_device->dev_addr) = bridged_device;
+    *app_bridge_find_endpoint_slot(endpoint::get_id(bridged_device->dev->endpoint)) = bridged_device;
+}
+
+/* The removals are rare, so the indexes are rebuilt rather than using tombstones. */
+static void app_bridge_rebuild_index()
+{
+    memset(s_address_index, 0, sizeof(s_address_index));
+    memset(s_endpoint_index, 0, sizeof(s_endpoint_index));
+    for (app_bridged_device_t *current_dev = g_bridged_device_list; current_dev; current_dev = current_dev->next) {
+        app_bridged_device_t **slot = app_bridge_find_address_slot(current_dev->dev_type, current_dev->dev_addr);
+        if (!*slot) {
+            *slot = current_dev;
+        }
+        slot = app_bridge_find_endpoint_slot(endpoint::get_id(current_dev->dev->endpoint));
+        if (!*slot) {
+            *slot = current_dev;
+        }
+    }
+}
+
+static app_bridged_device_t *app_bridge_get_device_by_address(app_bridged_device_type_t dev_type,
+                                                              const app_bridged_device_address_t &addr)
+{
+    return *app_bridge_find_address_slot(dev_type, addr);
+}
+
+static app_bridged_device_t *app_bridge_get_device_by_endpointid(app_bridged_device_type_t dev_type,
+                                                                 uint16_t matter_endpointid)
+{
+    app_bridged_device_t *bridged_device = *app_bridge_find_endpoint_slot(matter_endpointid);
+    return bridged_device && bridged_device->dev_type == dev_type ? bridged_device : NULL;
+}
+
 /** Persistent Bridged Device Info **/
 
 static esp_err_t app_bridge_store_bridged_device_info(app_bridged_device_t *bridged_device)
@@ -172,7 +292,7 @@ app_bridged_device_t *app_bridge_create_bridged_device(node_t *node, uint16_t pa
                                                        app_bridged_device_address_t bridged_device_address,
                                                        void *priv_data)
 {
-    if (g_current_bridged_device_count >= MAX_BRIDGED_DEVICE_COUNT) {
+    if (g_current_bridged_device_count >= esp_matter_bridge::get_max_device_count()) {
         ESP_LOGE(TAG, "The device list is full, could not add bridged device");
         return NULL;
     }
@@ -190,6 +310,7 @@ app_bridged_device_t *app_bridge_create_bridged_device(node_t *node, uint16_t pa
     new_dev->next = g_bridged_device_list;
     g_bridged_device_list = new_dev;
     g_current_bridged_device_count++;
+    app_bridge_index_device(new_dev);
 
     if (ESP_OK != app_bridge_store_bridged_device_info(new_dev)) {
         ESP_LOGW(TAG, "Failed to store the bridged device information");
@@ -211,6 +332,10 @@ esp_err_t app_bridge_initialize(node_t *node, esp_matter_bridge::bridge_device_t
 
     uint16_t matter_endpoint_id_array[MAX_BRIDGED_DEVICE_COUNT];
     esp_matter_bridge::get_bridged_endpoint_ids(matter_endpoint_id_array);
+    uint16_t resume_endpoint_ids[MAX_BRIDGED_DEVICE_COUNT];
+    void *resume_devs[MAX_BRIDGED_DEVICE_COUNT];
+    esp_matter_bridge::device_t *resumed_devs[MAX_BRIDGED_DEVICE_COUNT];
+    size_t resume_count = 0;
     for (size_t idx = 0; idx < MAX_BRIDGED_DEVICE_COUNT; ++idx) {
         if (matter_endpoint_id_array[idx] != chip::kInvalidEndpointId) {
             app_bridged_device_type_t device_type;
@@ -228,21 +353,37 @@ esp_err_t app_bridge_initialize(node_t *node, esp_matter_bridge::bridge_device_t
                 ESP_LOGE(TAG, "Failed to alloc memory for the resumed bridged device");
                 continue;
             }
-            new_dev->dev = esp_matter_bridge::resume_device(node, matter_endpoint_id_array[idx], new_dev);
-            if (!(new_dev->dev)) {
-                ESP_LOGE(TAG, "Failed to resume the bridged device");
-                esp_matter_mem_free(new_dev);
-                continue;
-            }
             new_dev->dev_type = device_type;
             new_dev->dev_addr = device_addr;
-            new_dev->next = g_bridged_device_list;
-            g_bridged_device_list = new_dev;
-            g_current_bridged_device_count++;
+            resume_endpoint_ids[resume_count] = matter_endpoint_id_array[idx];
+            resume_devs[resume_count++] = new_dev;
+        }
+    }
+    if (resume_count == 0) {
+        return ESP_OK;
+    }
 
-            // Enable the resumed endpoint
-            esp_matter::endpoint::enable(new_dev->dev->endpoint);
+    // Resume all the devices at once, then enable their endpoints in one pass
+    esp_matter_bridge::resume_devices(node, resume_endpoint_ids, resume_devs, resume_count, resumed_devs);
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    for (size_t idx = 0; idx < resume_count; ++idx) {
+        app_bridged_device_t *new_dev = (app_bridged_device_t *)resume_devs[idx];
+        new_dev->dev = resumed_devs[idx];
+        if (!(new_dev->dev)) {
+            ESP_LOGE(TAG, "Failed to resume the bridged device");
+            esp_matter_mem_free(new_dev);
+            continue;
         }
+        new_dev->next = g_bridged_device_list;
+        g_bridged_device_list = new_dev;
+        g_current_bridged_device_count++;
+        app_bridge_index_device(new_dev);
+
+        // Enable the resumed endpoint
+        esp_matter::endpoint::enable(new_dev->dev->endpoint);
+    }
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
     }
     return ESP_OK;
 }
@@ -272,6 +413,9 @@ esp_err_t app_bridge_remove_device(app_bridged_device_t *bridged_device)
         }
     }
 
+    g_current_bridged_device_count--;
+    app_bridge_rebuild_index();
+
     uint16_t endpoint_id = endpoint::get_id(bridged_device->dev->endpoint);
     app_bridge_erase_bridged_device_info(endpoint_id);
 
@@ -288,120 +432,63 @@ esp_err_t app_bridge_remove_device(app_bridged_device_t *bridged_device)
 /** ZigBee Device APIs */
 app_bridged_device_t *app_bridge_get_device_by_zigbee_shortaddr(uint16_t zigbee_shortaddr)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if (current_dev->dev_type == ESP_MATTER_BRIDGED_DEVICE_TYPE_ZIGBEE && current_dev->dev &&
-            current_dev->dev_addr.zigbee_shortaddr == zigbee_shortaddr) {
-            return current_dev;
-        }
-        current_dev = current_dev->next;
-    }
-    return NULL;
+    return app_bridge_get_device_by_address(ESP_MATTER_BRIDGED_DEVICE_TYPE_ZIGBEE,
+                                            app_bridge_zigbee_address(0, zigbee_shortaddr));
 }
 
 uint16_t app_bridge_get_matter_endpointid_by_zigbee_shortaddr(uint16_t zigbee_shortaddr)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if (current_dev->dev_type == ESP_MATTER_BRIDGED_DEVICE_TYPE_ZIGBEE && current_dev->dev &&
-            current_dev->dev_addr.zigbee_shortaddr == zigbee_shortaddr) {
-            return esp_matter::endpoint::get_id(current_dev->dev->endpoint);
-        }
-        current_dev = current_dev->next;
-    }
-    return 0xFFFF;
+    app_bridged_device_t *current_dev = app_bridge_get_device_by_zigbee_shortaddr(zigbee_shortaddr);
+    return current_dev ? esp_matter::endpoint::get_id(current_dev->dev->endpoint) : 0xFFFF;
 }
 
 uint16_t app_bridge_get_zigbee_shortaddr_by_matter_endpointid(uint16_t matter_endpointid)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if ((current_dev->dev_type == ESP_MATTER_BRIDGED_DEVICE_TYPE_ZIGBEE) && current_dev->dev &&
-            (esp_matter::endpoint::get_id(current_dev->dev->endpoint) == matter_endpointid)) {
-            return current_dev->dev_addr.zigbee_shortaddr;
-        }
-        current_dev = current_dev->next;
-    }
-    return 0xFFFF;
+    app_bridged_device_t *current_dev =
+        app_bridge_get_device_by_endpointid(ESP_MATTER_BRIDGED_DEVICE_TYPE_ZIGBEE, matter_endpointid);
+    return current_dev ? current_dev->dev_addr.zigbee_shortaddr : 0xFFFF;
 }
 
 /** BLE Mesh Device APIs */
 app_bridged_device_t *app_bridge_get_device_by_blemesh_addr(uint16_t blemesh_addr)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if ((current_dev->dev_type == ESP_MATTER_BRIDGED_DEVICE_TYPE_BLEMESH) && current_dev->dev &&
-            (current_dev->dev_addr.blemesh_addr == blemesh_addr)) {
-            return current_dev;
-        }
-        current_dev = current_dev->next;
-    }
-    return NULL;
+    return app_bridge_get_device_by_address(ESP_MATTER_BRIDGED_DEVICE_TYPE_BLEMESH,
+                                            app_bridge_blemesh_address(blemesh_addr));
 }
 
 uint16_t app_bridge_get_matter_endpointid_by_blemesh_addr(uint16_t blemesh_addr)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if ((current_dev->dev_type == ESP_MATTER_BRIDGED_DEVICE_TYPE_BLEMESH) && current_dev->dev &&
-            (current_dev->dev_addr.blemesh_addr == blemesh_addr)) {
-            return esp_matter::endpoint::get_id(current_dev->dev->endpoint);
-        }
-        current_dev = current_dev->next;
-    }
-    return 0xFFFF;
+    app_bridged_device_t *current_dev = app_bridge_get_device_by_blemesh_addr(blemesh_addr);
+    return current_dev ? esp_matter::endpoint::get_id(current_dev->dev->endpoint) : 0xFFFF;
 }
 
 uint16_t app_bridge_get_blemesh_addr_by_matter_endpointid(uint16_t matter_endpointid)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if ((current_dev->dev_type == ESP_MATTER_BRIDGED_DEVICE_TYPE_BLEMESH) && current_dev->dev &&
-            (esp_matter::endpoint::get_id(current_dev->dev->endpoint) == matter_endpointid)) {
-            return current_dev->dev_addr.blemesh_addr;
-        }
-        current_dev = current_dev->next;
-    }
-    return 0xFFFF;
+    app_bridged_device_t *current_dev =
+        app_bridge_get_device_by_endpointid(ESP_MATTER_BRIDGED_DEVICE_TYPE_BLEMESH, matter_endpointid);
+    return current_dev ? current_dev->dev_addr.blemesh_addr : 0xFFFF;
 }
 
 /** ESP-NOW Device APIs */
 app_bridged_device_t *app_bridge_get_device_by_espnow_macaddr(uint8_t espnow_macaddr[6])
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if ((current_dev->dev_type == ESP_MATTER_BRIDGED_DEVICE_TYPE_ESPNOW) && current_dev->dev &&
-            !memcmp(current_dev->dev_addr.espnow_macaddr, espnow_macaddr, 6)) {
-            return current_dev;
-        }
-        current_dev = current_dev->next;
-    }
-    return NULL;
+    app_bridged_device_address_t addr = {
+        .espnow_macaddr = {0},
+    };
+    memcpy(addr.espnow_macaddr, espnow_macaddr, sizeof(addr.espnow_macaddr));
+    return app_bridge_get_device_by_address(ESP_MATTER_BRIDGED_DEVICE_TYPE_ESPNOW, addr);
 }
 
 uint16_t app_bridge_get_matter_endpointid_by_espnow_macaddr(uint8_t espnow_macaddr[6])
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if ((current_dev->dev_type == ESP_MATTER_BRIDGED_DEVICE_TYPE_ESPNOW) && current_dev->dev &&
-            !memcmp(current_dev->dev_addr.espnow_macaddr, espnow_macaddr, 6)) {
-            return esp_matter::endpoint::get_id(current_dev->dev->endpoint);
-        }
-        current_dev = current_dev->next;
-    }
-    return chip::kInvalidEndpointId;
+    app_bridged_device_t *current_dev = app_bridge_get_device_by_espnow_macaddr(espnow_macaddr);
+    return current_dev ? esp_matter::endpoint::get_id(current_dev->dev->endpoint) : chip::kInvalidEndpointId;
 }
 
 uint8_t *app_bridge_get_espnow_macaddr_by_matter_endpointid(uint16_t matter_endpointid)
 {
-    app_bridged_device_t *current_dev = g_bridged_device_list;
-    while (current_dev) {
-        if ((current_dev->dev_type == ESP_MATTER_BRIDGED_DEVICE_TYPE_ESPNOW) && current_dev->dev &&
-            (esp_matter::endpoint::get_id(current_dev->dev->endpoint) == matter_endpointid)) {
-            return current_dev->dev_addr.espnow_macaddr;
-        }
-        current_dev = current_dev->next;
-    }
-    return NULL;
+    app_bridged_device_t *current_dev =
+        app_bridge_get_device_by_endpointid(ESP_MATTER_BRIDGED_DEVICE_TYPE_ESPNOW, matter_endpointid);
+    return current_dev ? current_dev->dev_addr.espnow_macaddr : NULL;
 }
 #endif
@@ -0,0 +1,201 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#include <esp_log.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <app_driver_binding.h>
+
+static const char *TAG = "app_driver_binding";
+
+#define EMPTY_SLOT 0xFF
+/* Number of seeds tried for a table size before the table is doubled */
+#define MAX_SEED_TRIES 64
+
+struct app_driver_binding {
+    const app_driver_binding_entry_t *entries;
+    uint32_t seed;
+    uint32_t mask;
+    /* Index of the entry of each slot of the hash table */
+    uint8_t *slots;
+};
+
+static inline uint32_t binding_hash(uint32_t cluster_id, uint32_t attribute_id, uint32_t seed)
+{
+    uint32_t hash = (cluster_id * 0x9E3779B1u) ^ ((attribute_id + seed) * 0x85EBCA77u);
+    return hash ^ (hash >> 15);
+}
+
+/* Place all the entries in the slots with the seed, false on a collision */
+static bool binding_place(struct app_driver_binding *binding, size_t count)
+{
+    memset(binding->slots, EMPTY_SLOT, binding->mask + 1);
+    for (size_t i = 0; i < count; i++) {
+        const app_driver_binding_entry_t *entry = &binding->entries[i];
+        uint32_t slot = binding_hash(entry->cluster_id, entry->attribute_id, binding->seed) & binding->mask;
+        if (binding->slots[slot] != EMPTY_SLOT) {
+            return false;
+        }
+        binding->slots[slot] = i;
+    }
+    return true;
+}
+
+app_driver_binding_handle_t app_driver_binding_create(const app_driver_binding_entry_t *entries, size_t count)
+{
+    if (!entries || count == 0 || count >= EMPTY_SLOT) {
+        ESP_LOGE(TAG, "Invalid binding table");
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        bool remap_by_zero = entries[i].transform == APP_DRIVER_BINDING_TRANSFORM_REMAP && entries[i].from == 0;
+        if (!entries[i].callback || remap_by_zero) {
+            ESP_LOGE(TAG, "Invalid binding of attribute 0x%08" PRIx32, entries[i].attribute_id);
+            return NULL;
+        }
+        for (size_t j = i + 1; j < count; j++) {
+            if (entries[i].cluster_id == entries[j].cluster_id && entries[i].attribute_id == entries[j].attribute_id) {
+                ESP_LOGE(TAG, "Attribute 0x%08" PRIx32 " of cluster 0x%08" PRIx32 " is bound twice",
+                         entries[i].attribute_id, entries[i].cluster_id);
+                return NULL;
+            }
+        }
+    }
+
+    /* Start with twice as many slots as entries, the table is doubled until a seed without collisions is found */
+    size_t size = 2;
+    while (size < count * 2) {
+        size <<= 1;
+    }
+    for (; size <= count * 64; size <<= 1) {
+        struct app_driver_binding *binding = (struct app_driver_binding *)calloc(1, sizeof(*binding) + size);
+        if (!binding) {
+            ESP_LOGE(TAG, "Failed to allocate the binding");
+            return NULL;
+        }
+        binding->entries = entries;
+        binding->mask = size - 1;
+        binding->slots = (uint8_t *)(binding + 1);
+        for (binding->seed = 0; binding->seed < MAX_SEED_TRIES; binding->seed++) {
+            if (binding_place(binding, count)) {
+                ESP_LOGD(TAG, "%u bindings in %u slots, seed %" PRIu32, (unsigned)count, (unsigned)size, binding->seed);
+                return binding;
+            }
+        }
+        free(binding);
+    }
+    ESP_LOGE(TAG, "Failed to build the binding lookup");
+    return NULL;
+}
+
+/* Integer value of the attribute, false if it is null or of another type */
+static bool binding_get_value(esp_matter_attr_val_t *val, int32_t *value, esp_err_t *err)
+{
+    *err = ESP_OK;
+    switch (val->type) {
+    case ESP_MATTER_VAL_TYPE_BOOLEAN:
+        *value = val->val.b;
+        return true;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BOOLEAN:
+        *value = val->val.b;
+        return !nullable<bool>(val->val.b).is_null();
+    case ESP_MATTER_VAL_TYPE_INTEGER:
+        *value = val->val.i;
+        return true;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INTEGER:
+        *value = val->val.i;
+        return !nullable<int>(val->val.i).is_null();
+    case ESP_MATTER_VAL_TYPE_INT8:
+        *value = val->val.i8;
+        return true;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT8:
+        *value = val->val.i8;
+        return !nullable<int8_t>(val->val.i8).is_null();
+    case ESP_MATTER_VAL_TYPE_UINT8:
+    case ESP_MATTER_VAL_TYPE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_BITMAP8:
+        *value = val->val.u8;
+        return true;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM8:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP8:
+        *value = val->val.u8;
+        return !nullable<uint8_t>(val->val.u8).is_null();
+    case ESP_MATTER_VAL_TYPE_INT16:
+        *value = val->val.i16;
+        return true;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT16:
+        *value = val->val.i16;
+        return !nullable<int16_t>(val->val.i16).is_null();
+    case ESP_MATTER_VAL_TYPE_UINT16:
+    case ESP_MATTER_VAL_TYPE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_BITMAP16:
+        *value = val->val.u16;
+        return true;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_ENUM16:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP16:
+        *value = val->val.u16;
+        return !nullable<uint16_t>(val->val.u16).is_null();
+    case ESP_MATTER_VAL_TYPE_INT32:
+        *value = val->val.i32;
+        return true;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT32:
+        *value = val->val.i32;
+        return !nullable<int32_t>(val->val.i32).is_null();
+    case ESP_MATTER_VAL_TYPE_UINT32:
+    case ESP_MATTER_VAL_TYPE_BITMAP32:
+        *value = (int32_t)val->val.u32;
+        return true;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT32:
+    case ESP_MATTER_VAL_TYPE_NULLABLE_BITMAP32:
+        *value = (int32_t)val->val.u32;
+        return !nullable<uint32_t>(val->val.u32).is_null();
+    default:
+        *err = ESP_ERR_NOT_SUPPORTED;
+        return false;
+    }
+}
+
+esp_err_t app_driver_binding_dispatch(app_driver_binding_handle_t binding, void *handle, uint32_t cluster_id,
+                                      uint32_t attribute_id, esp_matter_attr_val_t *val)
+{
+    if (!binding || !val) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint8_t index = binding->slots[binding_hash(cluster_id, attribute_id, binding->seed) & binding->mask];
+    if (index == EMPTY_SLOT) {
+        return ESP_OK;
+    }
+    const app_driver_binding_entry_t *entry = &binding->entries[index];
+    if (entry->cluster_id != cluster_id || entry->attribute_id != attribute_id) {
+        return ESP_OK;
+    }
+
+    int32_t value = 0;
+    esp_err_t err = ESP_OK;
+    if (!binding_get_value(val, &value, &err)) {
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Type %d of attribute 0x%08" PRIx32 " cannot be bound", val->type, attribute_id);
+        }
+        return err;
+    }
+    switch (entry->transform) {
+    case APP_DRIVER_BINDING_TRANSFORM_REMAP:
+        value = REMAP_TO_RANGE((int64_t)value, entry->from, entry->to);
+        break;
+    case APP_DRIVER_BINDING_TRANSFORM_REMAP_INVERSE:
+        value = REMAP_TO_RANGE_INVERSE(value, entry->to);
+        break;
+    default:
+        break;
+    }
+    return entry->callback(handle, value);
+}
@@ -0,0 +1,83 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_attribute_utils.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Driver function of a bound attribute
+ *
+ * @param[in] handle Driver handle given to app_driver_binding_dispatch().
+ * @param[in] value Attribute value, after the transform of the binding.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+typedef esp_err_t (*app_driver_binding_cb_t)(void *handle, int32_t value);
+
+/** Transform of the attribute value before it is given to the driver */
+typedef enum {
+    /** The value as is */
+    APP_DRIVER_BINDING_TRANSFORM_NONE = 0,
+    /** REMAP_TO_RANGE(value, from, to) */
+    APP_DRIVER_BINDING_TRANSFORM_REMAP,
+    /** REMAP_TO_RANGE_INVERSE(value, factor), the factor is in the to field */
+    APP_DRIVER_BINDING_TRANSFORM_REMAP_INVERSE,
+} app_driver_binding_transform_t;
+
+/** Binding of an attribute to a driver function, use the APP_DRIVER_BINDING* macros to fill it */
+typedef struct {
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    app_driver_binding_transform_t transform;
+    int32_t from;
+    int32_t to;
+    app_driver_binding_cb_t callback;
+} app_driver_binding_entry_t;
+
+#define APP_DRIVER_BINDING(cluster_id, attribute_id, callback) \
+    { cluster_id, attribute_id, APP_DRIVER_BINDING_TRANSFORM_NONE, 0, 0, callback }
+#define APP_DRIVER_BINDING_REMAP(cluster_id, attribute_id, from, to, callback) \
+    { cluster_id, attribute_id, APP_DRIVER_BINDING_TRANSFORM_REMAP, from, to, callback }
+#define APP_DRIVER_BINDING_REMAP_INVERSE(cluster_id, attribute_id, factor, callback) \
+    { cluster_id, attribute_id, APP_DRIVER_BINDING_TRANSFORM_REMAP_INVERSE, 0, factor, callback }
+
+typedef struct app_driver_binding *app_driver_binding_handle_t;
+
+/** Create the lookup of a binding table
+ *
+ * A perfect hash of the (cluster, attribute) pairs of the table is built, so a dispatch is one hash and one compare,
+ * whatever the number of bindings. The table is not copied and must outlive the handle, it is usually a static const.
+ *
+ * @param[in] entries Binding table, each (cluster, attribute) pair at most once.
+ * @param[in] count Number of entries, at most 254.
+ *
+ * @return Handle on success.
+ * @return NULL in case of failure.
+ */
+app_driver_binding_handle_t app_driver_binding_create(const app_driver_binding_entry_t *entries, size_t count);
+
+/** Call the driver function bound to an attribute
+ *
+ * This is usually called from `app_driver_attribute_update()`. The attributes without binding, and the null values of
+ * the nullable attributes, are ignored.
+ *
+ * @param[in] binding Handle returned by app_driver_binding_create().
+ * @param[in] handle Driver handle given to the driver function.
+ * @param[in] cluster_id Cluster ID of the attribute.
+ * @param[in] attribute_id Attribute ID of the attribute.
+ * @param[in] val Attribute value, of a boolean, integer, enum or bitmap type.
+ *
+ * @return ESP_OK on success, or if the attribute is not bound.
+ * @return error returned by the driver function, or ESP_ERR_NOT_SUPPORTED for a value of another type.
+ */
+esp_err_t app_driver_binding_dispatch(app_driver_binding_handle_t binding, void *handle, uint32_t cluster_id,
+                                      uint32_t attribute_id, esp_matter_attr_val_t *val);
@@ -0,0 +1,379 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+/* The sensors are kept in a hashed timer wheel: a sensor due in `delta` ticks is put in the slot of that tick, with
+ * the number of full turns of the wheel left before it is due. The task sleeps until the next slot which is not
+ * empty, so tens of sensors with the same interval cost a single wake per interval, and their updates go out in one
+ * batch under a single chip stack lock.
+ */
+
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <app_sensor_sampler.h>
+
+#define APP_SENSOR_SAMPLER_TASK_STACK 4096
+#define APP_SENSOR_SAMPLER_TASK_PRIORITY (tskIDLE_PRIORITY + 2)
+#define APP_SENSOR_SAMPLER_WHEEL_SLOTS 64
+
+static const char *TAG = "app_sensor_sampler";
+
+struct app_sensor {
+    app_sensor_config_t config;
+    uint32_t period_ticks;
+    /* Turns of the wheel left before the sensor is due */
+    uint32_t rounds;
+    uint16_t slot;
+    float samples[APP_SENSOR_SAMPLER_MAX_WINDOW];
+    uint8_t sample_count;
+    float ema;
+    bool has_ema;
+    float last_value;
+    int64_t last_update_us;
+    bool has_update;
+    struct app_sensor *next;
+};
+
+static app_sensor_handle_t s_wheel[APP_SENSOR_SAMPLER_WHEEL_SLOTS];
+static uint32_t s_sensor_count = 0;
+static uint32_t s_current_tick = 0;
+static TickType_t s_tick_period = 0;
+static uint32_t s_tick_ms = 0;
+static TaskHandle_t s_task = NULL;
+static SemaphoreHandle_t s_mutex = NULL;
+static app_sensor_sampler_stats_t s_stats;
+static esp_matter::attribute::batch_entry_t s_batch[APP_SENSOR_SAMPLER_MAX_SENSORS];
+
+static void wheel_insert(app_sensor_handle_t sensor, uint32_t delta)
+{
+    sensor->slot = (s_current_tick + delta) % APP_SENSOR_SAMPLER_WHEEL_SLOTS;
+    sensor->rounds = (delta - 1) / APP_SENSOR_SAMPLER_WHEEL_SLOTS;
+    sensor->next = s_wheel[sensor->slot];
+    s_wheel[sensor->slot] = sensor;
+}
+
+static bool wheel_remove(app_sensor_handle_t sensor)
+{
+    app_sensor_handle_t *link = &s_wheel[sensor->slot];
+    while (*link && *link != sensor) {
+        link = &(*link)->next;
+    }
+    if (!*link) {
+        return false;
+    }
+    *link = sensor->next;
+    sensor->next = NULL;
+    return true;
+}
+
+/* Ticks until the next slot with a sensor, 0 if there is none */
+static uint32_t ticks_to_next_slot()
+{
+    for (uint32_t delta = 1; delta <= APP_SENSOR_SAMPLER_WHEEL_SLOTS; delta++) {
+        if (s_wheel[(s_current_tick + delta) % APP_SENSOR_SAMPLER_WHEEL_SLOTS]) {
+            return delta;
+        }
+    }
+    return 0;
+}
+
+static int compare_float(const void *a, const void *b)
+{
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+static float filter_samples(app_sensor_handle_t sensor)
+{
+    switch (sensor->config.filter) {
+    case APP_SENSOR_FILTER_MEDIAN: {
+        float sorted[APP_SENSOR_SAMPLER_MAX_WINDOW];
+        memcpy(sorted, sensor->samples, sensor->sample_count * sizeof(float));
+        qsort(sorted, sensor->sample_count, sizeof(float), compare_float);
+        uint8_t middle = sensor->sample_count / 2;
+        return (sensor->sample_count % 2) ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2;
+    }
+    case APP_SENSOR_FILTER_EMA:
+        return sensor->ema;
+    case APP_SENSOR_FILTER_MEAN:
+    default: {
+        float sum = 0;
+        for (uint8_t index = 0; index < sensor->sample_count; index++) {
+            sum += sensor->samples[index];
+        }
+        return sum / sensor->sample_count;
+    }
+    }
+}
+
+static float clamp(float value, float min, float max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+/* The null values of the nullable types are left out of their range */
+static bool get_attribute_val(const app_sensor_config_t *config, float value, esp_matter_attr_val_t *val)
+{
+    float scaled = roundf(value * config->scale);
+    switch (config->val_type) {
+    case ESP_MATTER_VAL_TYPE_FLOAT:
+        *val = esp_matter_float(value * config->scale);
+        break;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_FLOAT:
+        *val = esp_matter_nullable_float(value * config->scale);
+        break;
+    case ESP_MATTER_VAL_TYPE_INT8:
+        *val = esp_matter_int8((int8_t)clamp(scaled, INT8_MIN, INT8_MAX));
+        break;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT8:
+        *val = esp_matter_nullable_int8((int8_t)clamp(scaled, INT8_MIN + 1, INT8_MAX));
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT8:
+        *val = esp_matter_uint8((uint8_t)clamp(scaled, 0, UINT8_MAX));
+        break;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT8:
+        *val = esp_matter_nullable_uint8((uint8_t)clamp(scaled, 0, UINT8_MAX - 1));
+        break;
+    case ESP_MATTER_VAL_TYPE_INT16:
+        *val = esp_matter_int16((int16_t)clamp(scaled, INT16_MIN, INT16_MAX));
+        break;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT16:
+        *val = esp_matter_nullable_int16((int16_t)clamp(scaled, INT16_MIN + 1, INT16_MAX));
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT16:
+        *val = esp_matter_uint16((uint16_t)clamp(scaled, 0, UINT16_MAX));
+        break;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT16:
+        *val = esp_matter_nullable_uint16((uint16_t)clamp(scaled, 0, UINT16_MAX - 1));
+        break;
+    case ESP_MATTER_VAL_TYPE_INT32:
+        *val = esp_matter_int32((int32_t)clamp(scaled, (float)INT32_MIN, (float)INT32_MAX));
+        break;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_INT32:
+        *val = esp_matter_nullable_int32((int32_t)clamp(scaled, (float)(INT32_MIN + 1), (float)INT32_MAX));
+        break;
+    case ESP_MATTER_VAL_TYPE_UINT32:
+        *val = esp_matter_uint32((uint32_t)clamp(scaled, 0, (float)UINT32_MAX));
+        break;
+    case ESP_MATTER_VAL_TYPE_NULLABLE_UINT32:
+        *val = esp_matter_nullable_uint32((uint32_t)clamp(scaled, 0, (float)(UINT32_MAX - 1)));
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+/* Reads a sample, and adds an entry to the batch when the window is full and the filtered value is due */
+static void sample_sensor(app_sensor_handle_t sensor, size_t *batch_count)
+{
+    const app_sensor_config_t *config = &sensor->config;
+    float value = 0;
+    s_stats.sample_count++;
+    if (config->read_cb(&value, config->priv_data) != ESP_OK || isnan(value)) {
+        s_stats.read_error_count++;
+        return;
+    }
+    sensor->samples[sensor->sample_count++] = value;
+    sensor->ema = sensor->has_ema ? sensor->ema + config->ema_alpha * (value - sensor->ema) : value;
+    sensor->has_ema = true;
+    if (sensor->sample_count < config->window) {
+        return;
+    }
+    float filtered = filter_samples(sensor);
+    sensor->sample_count = 0;
+
+    int64_t now_us = esp_timer_get_time();
+    bool moved = !sensor->has_update || fabsf(filtered - sensor->last_value) >= config->min_delta;
+    bool stale = config->max_interval_ms > 0 &&
+        now_us - sensor->last_update_us >= (int64_t)config->max_interval_ms * 1000;
+    if (!moved && !stale) {
+        return;
+    }
+    esp_matter::attribute::batch_entry_t *entry = &s_batch[*batch_count];
+    if (!get_attribute_val(config, filtered, &entry->val)) {
+        return;
+    }
+    entry->endpoint_id = config->endpoint_id;
+    entry->cluster_id = config->cluster_id;
+    entry->attribute_id = config->attribute_id;
+    (*batch_count)++;
+    sensor->last_value = filtered;
+    sensor->last_update_us = now_us;
+    sensor->has_update = true;
+}
+
+/* Processes the slot of the current tick */
+static void process_slot(size_t *batch_count)
+{
+    app_sensor_handle_t due = NULL;
+    app_sensor_handle_t *link = &s_wheel[s_current_tick % APP_SENSOR_SAMPLER_WHEEL_SLOTS];
+    while (*link) {
+        app_sensor_handle_t sensor = *link;
+        if (sensor->rounds > 0) {
+            sensor->rounds--;
+            link = &sensor->next;
+            continue;
+        }
+        *link = sensor->next;
+        sensor->next = due;
+        due = sensor;
+    }
+    while (due) {
+        app_sensor_handle_t sensor = due;
+        due = sensor->next;
+        sample_sensor(sensor, batch_count);
+        wheel_insert(sensor, sensor->period_ticks);
+    }
+}
+
+static void sampler_task(void *arg)
+{
+    TickType_t tick_time = xTaskGetTickCount();
+    while (true) {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        uint32_t delta = ticks_to_next_slot();
+        xSemaphoreGive(s_mutex);
+
+        /* Woken early by app_sensor_sampler_add(), the ticks already elapsed are caught up below */
+        TickType_t timeout = portMAX_DELAY;
+        if (delta > 0) {
+            TickType_t next_time = tick_time + delta * s_tick_period;
+            TickType_t now = xTaskGetTickCount();
+            timeout = (TickType_t)(next_time - now) <= delta * s_tick_period ? next_time - now : 0;
+        }
+        ulTaskNotifyTake(pdTRUE, timeout);
+
+        size_t batch_count = 0;
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        s_stats.wake_count++;
+        TickType_t now = xTaskGetTickCount();
+        while ((TickType_t)(now - tick_time) >= s_tick_period) {
+            tick_time += s_tick_period;
+            s_current_tick++;
+            process_slot(&batch_count);
+        }
+        if (batch_count > 0) {
+            s_stats.update_count += batch_count;
+            s_stats.batch_count++;
+        }
+        xSemaphoreGive(s_mutex);
+
+        /* Outside of the sampler mutex, so that a sensor can be added while holding the chip stack lock */
+        if (batch_count > 0) {
+            if (esp_matter::attribute::update_batch(s_batch, batch_count) != ESP_OK) {
+                ESP_LOGW(TAG, "Failed to update some of the %u sensor attributes", (unsigned)batch_count);
+            }
+        }
+    }
+}
+
+esp_err_t app_sensor_sampler_init(uint32_t tick_ms)
+{
+    if (s_task) {
+        ESP_LOGE(TAG, "Sampler already initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_tick_period = pdMS_TO_TICKS(tick_ms);
+    if (s_tick_period == 0) {
+        ESP_LOGE(TAG, "The tick should be at least one FreeRTOS tick");
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_tick_ms = tick_ms;
+    s_mutex = xSemaphoreCreateMutex();
+    if (!s_mutex) {
+        ESP_LOGE(TAG, "Couldn't create the sampler mutex");
+        return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreate(sampler_task, "sensor_sampler", APP_SENSOR_SAMPLER_TASK_STACK, NULL,
+                    APP_SENSOR_SAMPLER_TASK_PRIORITY, &s_task) != pdPASS) {
+        ESP_LOGE(TAG, "Couldn't create the sampler task");
+        vSemaphoreDelete(s_mutex);
+        s_mutex = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+app_sensor_handle_t app_sensor_sampler_add(const app_sensor_config_t *config)
+{
+    if (!s_task) {
+        ESP_LOGE(TAG, "Sampler not initialized");
+        return NULL;
+    }
+    esp_matter_attr_val_t val;
+    if (!config || !config->read_cb || config->window == 0 || config->window > APP_SENSOR_SAMPLER_MAX_WINDOW ||
+        config->scale == 0 || !get_attribute_val(config, 0, &val) ||
+        (config->filter == APP_SENSOR_FILTER_EMA && (config->ema_alpha <= 0 || config->ema_alpha > 1))) {
+        ESP_LOGE(TAG, "Invalid sensor configuration");
+        return NULL;
+    }
+    app_sensor_handle_t sensor = (app_sensor_handle_t)calloc(1, sizeof(struct app_sensor));
+    if (!sensor) {
+        ESP_LOGE(TAG, "Couldn't allocate the sensor");
+        return NULL;
+    }
+    sensor->config = *config;
+    sensor->period_ticks = (config->sample_interval_ms + s_tick_ms - 1) / s_tick_ms;
+    if (sensor->period_ticks == 0) {
+        sensor->period_ticks = 1;
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (s_sensor_count >= APP_SENSOR_SAMPLER_MAX_SENSORS) {
+        xSemaphoreGive(s_mutex);
+        ESP_LOGE(TAG, "Sensor count cannot be greater than %d", APP_SENSOR_SAMPLER_MAX_SENSORS);
+        free(sensor);
+        return NULL;
+    }
+    wheel_insert(sensor, 1);
+    s_sensor_count++;
+    xSemaphoreGive(s_mutex);
+    /* The task may be sleeping until a later slot, or without a timeout */
+    xTaskNotifyGive(s_task);
+    return sensor;
+}
+
+esp_err_t app_sensor_sampler_remove(app_sensor_handle_t sensor)
+{
+    if (!s_task || !sensor) {
+        ESP_LOGE(TAG, "Sampler not initialized or sensor is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    bool removed = wheel_remove(sensor);
+    if (removed) {
+        s_sensor_count--;
+    }
+    xSemaphoreGive(s_mutex);
+    if (!removed) {
+        ESP_LOGE(TAG, "Sensor not found");
+        return ESP_ERR_NOT_FOUND;
+    }
+    free(sensor);
+    return ESP_OK;
+}
+
+esp_err_t app_sensor_sampler_get_stats(app_sensor_sampler_stats_t *stats)
+{
+    if (!s_task || !stats) {
+        ESP_LOGE(TAG, "Sampler not initialized or stats is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    *stats = s_stats;
+    xSemaphoreGive(s_mutex);
+    return ESP_OK;
+}
@@ -0,0 +1,132 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter.h>
+
+/** Maximum number of sensors, they are updated together in one `esp_matter::attribute::update_batch()` */
+#ifndef APP_SENSOR_SAMPLER_MAX_SENSORS
+#define APP_SENSOR_SAMPLER_MAX_SENSORS 32
+#endif
+
+/** Maximum number of samples filtered into one value */
+#define APP_SENSOR_SAMPLER_MAX_WINDOW 16
+
+/** Sensor read callback
+ *
+ * Called from the sampler task, the read should be short since the other sensors of the tick wait for it.
+ *
+ * @param[out] value The value read, in the unit of the sensor.
+ * @param[in] priv_data Private data of the sensor.
+ *
+ * @return ESP_OK on success, the sample is skipped otherwise.
+ */
+typedef esp_err_t (*app_sensor_read_cb_t)(float *value, void *priv_data);
+
+/** Filter of the samples */
+typedef enum {
+    /** Mean of the samples of the window */
+    APP_SENSOR_FILTER_MEAN = 0,
+    /** Median of the samples of the window, which drops the outliers */
+    APP_SENSOR_FILTER_MEDIAN,
+    /** Exponential moving average of all the samples, taken at the end of each window */
+    APP_SENSOR_FILTER_EMA,
+} app_sensor_filter_t;
+
+/** Sensor configuration */
+typedef struct {
+    /** Endpoint ID of the attribute updated with the filtered value */
+    uint16_t endpoint_id;
+    /** Cluster ID of the attribute */
+    uint32_t cluster_id;
+    /** Attribute ID of the attribute */
+    uint32_t attribute_id;
+    /** Value type of the attribute: the integer types, nullable or not, and float */
+    esp_matter_val_type_t val_type;
+    /** The attribute value is the filtered value multiplied by the scale and rounded, such as 100 for a temperature
+     * in degrees Celsius stored in 0.01 degrees Celsius */
+    float scale;
+    /** Interval between two samples, rounded up to a multiple of the tick of the sampler */
+    uint32_t sample_interval_ms;
+    /** Number of samples filtered into one value, from 1 to APP_SENSOR_SAMPLER_MAX_WINDOW */
+    uint8_t window;
+    /** Filter of the samples */
+    app_sensor_filter_t filter;
+    /** Weight of the new sample for APP_SENSOR_FILTER_EMA, between 0 and 1 */
+    float ema_alpha;
+    /** The attribute is only updated when the filtered value moved by at least this delta, in the unit of the
+     * sensor, since the last update */
+    float min_delta;
+    /** The attribute is updated at least at this interval even if the value did not move, 0 to disable */
+    uint32_t max_interval_ms;
+    /** Read callback */
+    app_sensor_read_cb_t read_cb;
+    /** Private data passed to the read callback */
+    void *priv_data;
+} app_sensor_config_t;
+
+/** Sensor handle */
+typedef struct app_sensor *app_sensor_handle_t;
+
+/** Sampler statistics */
+typedef struct {
+    /** Wakes of the sampler task */
+    uint32_t wake_count;
+    /** Samples read */
+    uint32_t sample_count;
+    /** Failed reads */
+    uint32_t read_error_count;
+    /** Attribute updates */
+    uint32_t update_count;
+    /** Batches of attribute updates */
+    uint32_t batch_count;
+} app_sensor_sampler_stats_t;
+
+/** Initialize the sensor sampler
+ *
+ * The sensors are scheduled on a timer wheel with a slot per tick, and a single task reads all the sensors due at a
+ * tick, filters the samples and updates the changed attributes with one `esp_matter::attribute::update_batch()`. The
+ * task only wakes at the ticks where a sensor is due.
+ *
+ * @param[in] tick_ms Tick of the timer wheel, the resolution of the sample intervals.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_sensor_sampler_init(uint32_t tick_ms);
+
+/** Add a sensor to the sampler
+ *
+ * The first sample is read at the next tick.
+ *
+ * @param[in] config Sensor configuration, copied.
+ *
+ * @return Handle on success.
+ * @return NULL in case of failure.
+ */
+app_sensor_handle_t app_sensor_sampler_add(const app_sensor_config_t *config);
+
+/** Remove a sensor from the sampler
+ *
+ * @param[in] sensor Handle returned by app_sensor_sampler_add().
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_sensor_sampler_remove(app_sensor_handle_t sensor);
+
+/** Get the sampler statistics
+ *
+ * @param[out] stats Statistics since the init.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_sensor_sampler_get_stats(app_sensor_sampler_stats_t *stats);
@@ -74,6 +74,10 @@
 #define CHIP_ADV_DATA_FLAGS 0x06
 #define CHIP_ADV_DATA_TYPE_SERVICE_DATA 0x16
 
+#ifndef CONFIG_BLEMESH_BRIDGE_BLE_PREFERRED_MTU
+#define CONFIG_BLEMESH_BRIDGE_BLE_PREFERRED_MTU 247
+#endif
+
 using namespace ::chip;
 using namespace ::chip::Ble;
 
@@ -115,6 +119,22 @@ SemaphoreHandle_t semaphoreHandle = NULL;
 // (see Bluetooth® Core Specification 4.2 Vol 6, Part B, Section 1.3.2.1 "Static device address")
 uint8_t own_addr_type = BLE_OWN_ADDR_RANDOM;
 
+// Commissioning timings, the commissioning starts with the first CHIPoBLE connection and completes with the
+// kCommissioningComplete event, after the BLE connection has been closed for the operational network.
+System::Clock::Timestamp sCommissioningStart = System::Clock::kZero;
+System::Clock::Timestamp sBleConnectionStart = System::Clock::kZero;
+System::Clock::Milliseconds32 sBleConnectionTime = System::Clock::kZero;
+uint16_t sBleMtu = BLE_ATT_MTU_DFLT;
+
+int OnMTUExchanged(uint16_t conn_handle, const struct ble_gatt_error * error, uint16_t mtu, void * arg)
+{
+    if (error->status != 0)
+    {
+        ChipLogError(DeviceLayer, "MTU exchange failed (con %u status %u)", conn_handle, error->status);
+    }
+    return 0;
+}
+
 } // unnamed namespace
 
 BLEManagerImpl BLEManagerImpl::sInstance;
@@ -316,6 +336,24 @@ void BLEManagerImpl::_OnPlatformEvent(const ChipDeviceEvent * event)
         HandleConnectionError(event->CHIPoBLEConnectionError.ConId, event->CHIPoBLEConnectionError.Reason);
         break;
 
+    case DeviceEventType::kCommissioningComplete:
+        if (sCommissioningStart != System::Clock::kZero)
+        {
+            System::Clock::Milliseconds32 total = std::chrono::duration_cast<System::Clock::Milliseconds32>(
+                System::SystemClock().GetMonotonicTimestamp() - sCommissioningStart);
+            ChipLogProgress(DeviceLayer, "Time to commission: %" PRIu32 " ms, over BLE: %" PRIu32 " ms, MTU %u",
+                            total.count(), sBleConnectionTime.count(), sBleMtu);
+        }
+        sCommissioningStart = System::Clock::kZero;
+        sBleConnectionTime  = System::Clock::kZero;
+        break;
+
+    case DeviceEventType::kFailSafeTimerExpired:
+        // The commissioning failed, time the next attempt from its own connection.
+        sCommissioningStart = System::Clock::kZero;
+        sBleConnectionTime  = System::Clock::kZero;
+        break;
+
     case DeviceEventType::kServiceProvisioningChange:
     case DeviceEventType::kWiFiConnectivityChange:
         // Force the advertising configuration to be refreshed to reflect new provisioning state.
@@ -700,6 +738,13 @@ CHIP_ERROR BLEManagerImpl::InitESPBleLayer(void)
     ble_hs_cfg.sm_our_key_dist   = BLE_SM_PAIR_KEY_DIST_ENC | BLE_SM_PAIR_KEY_DIST_ID;
     ble_hs_cfg.sm_their_key_dist = BLE_SM_PAIR_KEY_DIST_ENC | BLE_SM_PAIR_KEY_DIST_ID;
 
+    err = MapBLEError(ble_att_set_preferred_mtu(CONFIG_BLEMESH_BRIDGE_BLE_PREFERRED_MTU));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "ble_att_set_preferred_mtu failed: %s", ErrorStr(err));
+        ExitNow();
+    }
+
     // Register the CHIPoBLE GATT attributes with the ESP BLE layer if needed.
     if (mServiceMode == ConnectivityManager::kCHIPoBLEServiceMode_Enabled)
     {
@@ -957,6 +1002,39 @@ CHIP_ERROR BLEManagerImpl::HandleGAPConnect(struct ble_gap_event * gapEvent)
 
     // Track the number of active GAP connections.
     mNumGAPCons++;
+
+    if (gapEvent->connect.status == 0)
+    {
+        uint16_t conn_handle = gapEvent->connect.conn_handle;
+
+        sBleConnectionStart = System::SystemClock().GetMonotonicTimestamp();
+        if (sCommissioningStart == System::Clock::kZero)
+        {
+            sCommissioningStart = sBleConnectionStart;
+        }
+
+        // The BTP fragments are sized from the ATT MTU, so exchange it now rather than waiting for the commissioner.
+        int rc = ble_gattc_exchange_mtu(conn_handle, OnMTUExchanged, NULL);
+        if (rc != 0)
+        {
+            ChipLogError(DeviceLayer, "ble_gattc_exchange_mtu failed: %d", rc);
+        }
+
+#if CONFIG_BLEMESH_BRIDGE_BLE_CONN_UPDATE
+        // BTP waits for the confirmation of each indication, one connection event per fragment.
+        struct ble_gap_upd_params params = {};
+        params.itvl_min            = BLE_GAP_CONN_ITVL_MS(CONFIG_BLEMESH_BRIDGE_BLE_CONN_ITVL_MIN_MS);
+        params.itvl_max            = BLE_GAP_CONN_ITVL_MS(CONFIG_BLEMESH_BRIDGE_BLE_CONN_ITVL_MAX_MS);
+        params.latency             = 0;
+        params.supervision_timeout = BLE_GAP_SUPERVISION_TIMEOUT_MS(CONFIG_BLEMESH_BRIDGE_BLE_CONN_SUPERVISION_TIMEOUT_MS);
+        rc                         = ble_gap_update_params(conn_handle, &params);
+        if (rc != 0)
+        {
+            ChipLogError(DeviceLayer, "ble_gap_update_params failed: %d", rc);
+        }
+#endif
+    }
+
     err = SetSubscribed(gapEvent->connect.conn_handle);
     VerifyOrExit(err != CHIP_ERROR_NO_MEMORY, err = CHIP_NO_ERROR);
     SuccessOrExit(err);
@@ -979,6 +1057,13 @@ CHIP_ERROR BLEManagerImpl::HandleGAPDisconnect(struct ble_gap_event * gapEvent)
         mNumGAPCons--;
     }
 
+    if (sBleConnectionStart != System::Clock::kZero)
+    {
+        sBleConnectionTime += std::chrono::duration_cast<System::Clock::Milliseconds32>(
+            System::SystemClock().GetMonotonicTimestamp() - sBleConnectionStart);
+        sBleConnectionStart = System::Clock::kZero;
+    }
+
     if (UnsetSubscribed(gapEvent->disconnect.conn.conn_handle))
     {
         CHIP_ERROR disconReason;
@@ -1103,6 +1188,20 @@ int BLEManagerImpl::ble_svr_gap_event(struct ble_gap_event * event, void * arg)
 
     case BLE_GAP_EVENT_MTU:
         ESP_LOGD(TAG, "BLE_GAP_EVENT_MTU = %d channel id = %d", event->mtu.value, event->mtu.channel_id);
+        sBleMtu = event->mtu.value;
+        break;
+
+    case BLE_GAP_EVENT_CONN_UPDATE:
+        if (event->conn_update.status == 0)
+        {
+            struct ble_gap_conn_desc desc;
+            if (ble_gap_conn_find(event->conn_update.conn_handle, &desc) == 0)
+            {
+                ChipLogProgress(DeviceLayer, "BLE connection updated (con %u interval %u.%02u ms latency %u timeout %u ms)",
+                                event->conn_update.conn_handle, (desc.conn_itvl * 125) / 100, (desc.conn_itvl * 125) % 100,
+                                desc.conn_latency, desc.supervision_timeout * 10);
+            }
+        }
         break;
 
     default:
@@ -0,0 +1,483 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#include <sdkconfig.h>
+
+#if CONFIG_CONTROLLER_BENCHMARK_ENABLE
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <esp_matter.h>
+#include <esp_matter_console.h>
+#include <esp_matter_controller_cluster_command.h>
+#include <esp_matter_controller_read_command.h>
+#include <esp_matter_controller_subscribe_command.h>
+#include <esp_matter_controller_utils.h>
+#include <esp_matter_controller_write_command.h>
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+#include <esp_matter_commissioner.h>
+#include <esp_matter_controller_commissioning_queue.h>
+#endif
+
+#include <app/InteractionModelEngine.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#include <app_benchmark.h>
+
+using namespace esp_matter;
+using namespace esp_matter::controller;
+
+static const char *TAG = "app_benchmark";
+
+static constexpr size_t k_max_nodes = CONFIG_CONTROLLER_BENCHMARK_MAX_NODES;
+static constexpr uint32_t k_tick_ms = 100;
+
+typedef enum {
+    BENCH_OP_READ = 0,
+    BENCH_OP_WRITE,
+    BENCH_OP_INVOKE,
+    BENCH_OP_SUBSCRIBE,
+    BENCH_OP_COMMISSION,
+} bench_op_t;
+
+static const char *k_op_names[] = {"read", "write", "invoke", "subscribe", "commission"};
+
+typedef struct {
+    uint64_t node_id;
+    /* Only used by the commission operation */
+    uint32_t pincode;
+    bool has_discriminator;
+    uint16_t discriminator;
+    bool busy;
+    int64_t start_us;
+} bench_slot_t;
+
+typedef struct {
+    bench_op_t op;
+    bool running;
+    uint32_t count;
+    uint32_t issued;
+    uint32_t succeeded;
+    uint32_t failed;
+    uint32_t timed_out;
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    /* Attribute or command ID */
+    uint32_t id;
+    uint16_t min_interval;
+    uint16_t max_interval;
+    char payload[CONFIG_ESP_MATTER_CONTROLLER_JSON_STRING_BUFFER_LEN];
+    bench_slot_t slots[k_max_nodes];
+    size_t slot_count;
+    uint32_t *latencies_ms;
+    int64_t start_us;
+    size_t free_heap_start;
+    size_t free_heap_min;
+    size_t free_internal_min;
+} bench_run_t;
+
+static bench_run_t s_run;
+static uint32_t s_timeout_ms = CONFIG_CONTROLLER_BENCHMARK_OP_TIMEOUT_MS;
+
+static void bench_issue(size_t slot_index);
+
+static void bench_sample_heap()
+{
+    size_t free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    size_t free_internal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (free_heap < s_run.free_heap_min) {
+        s_run.free_heap_min = free_heap;
+    }
+    if (free_internal < s_run.free_internal_min) {
+        s_run.free_internal_min = free_internal;
+    }
+}
+
+static int compare_latency(const void *a, const void *b)
+{
+    uint32_t la = *(const uint32_t *)a;
+    uint32_t lb = *(const uint32_t *)b;
+    return la < lb ? -1 : (la > lb ? 1 : 0);
+}
+
+static uint32_t percentile(uint32_t percent)
+{
+    if (s_run.succeeded == 0) {
+        return 0;
+    }
+    /* Nearest rank */
+    uint32_t rank = (percent * s_run.succeeded + 99) / 100;
+    return s_run.latencies_ms[rank > 0 ? rank - 1 : 0];
+}
+
+static void bench_report()
+{
+    uint32_t duration_ms = (uint32_t)((esp_timer_get_time() - s_run.start_us) / 1000);
+    qsort(s_run.latencies_ms, s_run.succeeded, sizeof(uint32_t), compare_latency);
+    uint64_t latency_sum = 0;
+    for (uint32_t index = 0; index < s_run.succeeded; index++) {
+        latency_sum += s_run.latencies_ms[index];
+    }
+    uint32_t finished = s_run.succeeded + s_run.failed + s_run.timed_out;
+    /* Machine-readable result on a single line */
+    printf("BENCH_RESULT {\"op\":\"%s\",\"nodes\":%u,\"count\":%" PRIu32 ",\"succeeded\":%" PRIu32
+           ",\"failed\":%" PRIu32 ",\"timed_out\":%" PRIu32 ",\"failure_rate\":%.4f,\"duration_ms\":%" PRIu32
+           ",\"ops_per_sec\":%.2f,\"latency_ms\":{\"min\":%" PRIu32 ",\"avg\":%" PRIu32 ",\"p50\":%" PRIu32
+           ",\"p90\":%" PRIu32 ",\"p99\":%" PRIu32 ",\"max\":%" PRIu32 "},\"heap\":{\"free_start\":%u,"
+           "\"free_min\":%u,\"free_end\":%u,\"peak_used\":%u,\"internal_free_min\":%u,\"lifetime_free_min\":%u}}\n",
+           k_op_names[s_run.op], (unsigned)s_run.slot_count, s_run.count, s_run.succeeded, s_run.failed,
+           s_run.timed_out, finished > 0 ? (double)(s_run.failed + s_run.timed_out) / finished : 0.0, duration_ms,
+           duration_ms > 0 ? (double)s_run.succeeded * 1000 / duration_ms : 0.0,
+           s_run.succeeded > 0 ? s_run.latencies_ms[0] : 0,
+           s_run.succeeded > 0 ? (uint32_t)(latency_sum / s_run.succeeded) : 0, percentile(50), percentile(90),
+           percentile(99), s_run.succeeded > 0 ? s_run.latencies_ms[s_run.succeeded - 1] : 0,
+           (unsigned)s_run.free_heap_start, (unsigned)s_run.free_heap_min,
+           (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+           (unsigned)(s_run.free_heap_start - s_run.free_heap_min), (unsigned)s_run.free_internal_min,
+           (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+    free(s_run.latencies_ms);
+    s_run.latencies_ms = nullptr;
+    s_run.running = false;
+}
+
+static void bench_check_done()
+{
+    if (s_run.running && s_run.succeeded + s_run.failed + s_run.timed_out >= s_run.count) {
+        bench_report();
+    }
+}
+
+static void bench_issue_work(intptr_t arg)
+{
+    bench_issue((size_t)arg);
+}
+
+static void bench_complete_slot(size_t slot_index, bool success)
+{
+    bench_slot_t *slot = &s_run.slots[slot_index];
+    if (!s_run.running || !slot->busy) {
+        /* Late completion of an operation which timed out */
+        return;
+    }
+    slot->busy = false;
+    bench_sample_heap();
+    if (success) {
+        s_run.latencies_ms[s_run.succeeded++] = (uint32_t)((esp_timer_get_time() - slot->start_us) / 1000);
+    } else {
+        s_run.failed++;
+    }
+    bench_check_done();
+    /* Issued from a new context, the completion callbacks are called from the middle of the operations */
+    if (s_run.running) {
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(bench_issue_work, (intptr_t)slot_index);
+    }
+}
+
+static void bench_complete(uint64_t node_id, bool success)
+{
+    for (size_t index = 0; index < s_run.slot_count; index++) {
+        if (s_run.slots[index].node_id == node_id && s_run.slots[index].busy) {
+            bench_complete_slot(index, success);
+            return;
+        }
+    }
+}
+
+static void bench_read_done_cb(uint64_t node_id, const ScopedMemoryBufferWithSize<AttributePathParams> &attr_paths,
+                               const ScopedMemoryBufferWithSize<EventPathParams> &event_paths)
+{
+    bench_complete(node_id, true);
+}
+
+static void bench_read_attribute_cb(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                                    chip::TLV::TLVReader *data)
+{
+    // Intentionally empty, the data callback disables the data logging of the read command
+}
+
+static void bench_write_done_cb(uint64_t node_id, CHIP_ERROR error)
+{
+    bench_complete(node_id, error == CHIP_NO_ERROR);
+}
+
+static void bench_shutdown_subscription_work(intptr_t arg)
+{
+    uint64_t node_id = s_run.slots[(size_t)arg].node_id;
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    chip::FabricIndex fabric_index = commissioner::get_device_commissioner()->GetFabricIndex();
+#else
+    chip::FabricIndex fabric_index = get_fabric_index();
+#endif
+    chip::app::InteractionModelEngine::GetInstance()->ShutdownSubscriptions(fabric_index, node_id);
+}
+
+static void bench_subscribe_attribute_cb(uint64_t node_id, const chip::app::ConcreteDataAttributePath &path,
+                                         chip::TLV::TLVReader *data)
+{
+    for (size_t index = 0; index < s_run.slot_count; index++) {
+        if (s_run.slots[index].node_id == node_id && s_run.slots[index].busy) {
+            /* The first report of the priming data completes the operation. The subscription is shut down before
+             * the next operation is issued on the node. */
+            chip::DeviceLayer::PlatformMgr().ScheduleWork(bench_shutdown_subscription_work, (intptr_t)index);
+            bench_complete_slot(index, true);
+            return;
+        }
+    }
+}
+
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+static void bench_commission_done_cb(const commissioning_queue::result_t *result)
+{
+    bench_complete(result->node_id, result->err == ESP_OK);
+}
+#endif
+
+static esp_err_t bench_start_operation(bench_slot_t *slot)
+{
+    uint64_t node_id = slot->node_id;
+    switch (s_run.op) {
+    case BENCH_OP_READ: {
+        read_command *cmd = read_command::create(node_id, s_run.endpoint_id, s_run.cluster_id, s_run.id, READ_ATTRIBUTE,
+                                                 bench_read_attribute_cb, bench_read_done_cb, nullptr);
+        return cmd ? cmd->send_command() : ESP_ERR_NO_MEM;
+    }
+    case BENCH_OP_WRITE:
+        return send_write_attr_command(node_id, s_run.endpoint_id, s_run.cluster_id, s_run.id, s_run.payload,
+                                       bench_write_done_cb);
+    case BENCH_OP_INVOKE: {
+        cluster_command *cmd = cluster_command::create(
+            node_id, s_run.endpoint_id, s_run.cluster_id, s_run.id, s_run.payload[0] ? s_run.payload : nullptr,
+            [node_id](void *ctx, const ConcreteCommandPath &command_path, const StatusIB &status,
+                      TLVReader *response_data) { bench_complete(node_id, status.IsSuccess()); },
+            [node_id](void *ctx, CHIP_ERROR error) { bench_complete(node_id, false); });
+        return cmd ? cmd->send_command() : ESP_ERR_NO_MEM;
+    }
+    case BENCH_OP_SUBSCRIBE: {
+        subscribe_command *cmd = subscribe_command::create(
+            node_id, s_run.endpoint_id, s_run.cluster_id, s_run.id, SUBSCRIBE_ATTRIBUTE, s_run.min_interval,
+            s_run.max_interval, false, bench_subscribe_attribute_cb);
+        return cmd ? cmd->send_command() : ESP_ERR_NO_MEM;
+    }
+    case BENCH_OP_COMMISSION: {
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+        commissioning_queue::request_t request = {
+            .node_id = node_id,
+            .pincode = slot->pincode,
+            .has_discriminator = slot->has_discriminator,
+            .discriminator = slot->discriminator,
+        };
+        return commissioning_queue::enqueue(&request);
+#else
+        return ESP_ERR_NOT_SUPPORTED;
+#endif
+    }
+    default:
+        break;
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+static void bench_issue(size_t slot_index)
+{
+    bench_slot_t *slot = &s_run.slots[slot_index];
+    while (s_run.running && !slot->busy && s_run.issued < s_run.count) {
+        s_run.issued++;
+        slot->busy = true;
+        slot->start_us = esp_timer_get_time();
+        if (bench_start_operation(slot) == ESP_OK) {
+            return;
+        }
+        /* The operation could not be started, count it and issue the next one */
+        slot->busy = false;
+        s_run.failed++;
+    }
+    bench_check_done();
+}
+
+static void bench_tick_timer_callback(chip::System::Layer *layer, void *context)
+{
+    if (!s_run.running) {
+        return;
+    }
+    bench_sample_heap();
+    int64_t now_us = esp_timer_get_time();
+    for (size_t index = 0; index < s_run.slot_count; index++) {
+        bench_slot_t *slot = &s_run.slots[index];
+        if (slot->busy && now_us - slot->start_us > (int64_t)s_timeout_ms * 1000) {
+            ESP_LOGW(TAG, "%s operation on node 0x%016" PRIX64 " timed out", k_op_names[s_run.op], slot->node_id);
+            slot->busy = false;
+            s_run.timed_out++;
+            bench_issue(index);
+        }
+    }
+    bench_check_done();
+    if (s_run.running) {
+        chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(k_tick_ms),
+                                                    bench_tick_timer_callback, nullptr);
+    }
+}
+
+static esp_err_t bench_start()
+{
+    s_run.latencies_ms = (uint32_t *)calloc(s_run.count, sizeof(uint32_t));
+    if (!s_run.latencies_ms) {
+        ESP_LOGE(TAG, "Failed to alloc memory for the latencies");
+        return ESP_ERR_NO_MEM;
+    }
+    s_run.issued = 0;
+    s_run.succeeded = 0;
+    s_run.failed = 0;
+    s_run.timed_out = 0;
+    s_run.free_heap_start = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    s_run.free_heap_min = s_run.free_heap_start;
+    s_run.free_internal_min = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    s_run.start_us = esp_timer_get_time();
+    s_run.running = true;
+#if CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
+    if (s_run.op == BENCH_OP_COMMISSION) {
+        commissioning_queue::set_done_cb(bench_commission_done_cb);
+    }
+#endif
+    ESP_LOGI(TAG, "Running %" PRIu32 " %s operations on %u nodes", s_run.count, k_op_names[s_run.op],
+             (unsigned)s_run.slot_count);
+    for (size_t index = 0; index < s_run.slot_count; index++) {
+        s_run.slots[index].busy = false;
+        bench_issue(index);
+    }
+    if (s_run.running) {
+        chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(k_tick_ms),
+                                                    bench_tick_timer_callback, nullptr);
+    }
+    return ESP_OK;
+}
+
+/* Parses a comma separated list of node IDs, or of node_id:pincode[:discriminator] for the commission operation */
+static esp_err_t bench_parse_nodes(char *nodes, bool commission)
+{
+    s_run.slot_count = 0;
+    for (char *save = nullptr, *token = strtok_r(nodes, ",", &save); token; token = strtok_r(nullptr, ",", &save)) {
+        if (s_run.slot_count >= k_max_nodes) {
+            ESP_LOGE(TAG, "At most %u nodes are supported", (unsigned)k_max_nodes);
+            return ESP_ERR_INVALID_ARG;
+        }
+        bench_slot_t *slot = &s_run.slots[s_run.slot_count++];
+        memset(slot, 0, sizeof(*slot));
+        char *field_save = nullptr;
+        slot->node_id = string_to_uint64(strtok_r(token, ":", &field_save));
+        if (commission) {
+            char *pincode = strtok_r(nullptr, ":", &field_save);
+            char *discriminator = strtok_r(nullptr, ":", &field_save);
+            if (!pincode) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            slot->pincode = string_to_uint32(pincode);
+            slot->has_discriminator = discriminator != nullptr;
+            slot->discriminator = discriminator ? string_to_uint16(discriminator) : 0;
+        }
+    }
+    return s_run.slot_count > 0 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+static esp_err_t bench_console_handler(int argc, char **argv)
+{
+    if (argc == 2 && strcmp(argv[0], "timeout") == 0) {
+        s_timeout_ms = string_to_uint32(argv[1]);
+        return ESP_OK;
+    }
+    if (argc < 2) {
+        ESP_LOGE(TAG, "Usage: matter esp bench <read|write|invoke|subscribe|commission|timeout> ...");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_run.running) {
+        ESP_LOGE(TAG, "A benchmark is already running");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    size_t op_index = 0;
+    while (op_index < sizeof(k_op_names) / sizeof(k_op_names[0]) && strcmp(argv[0], k_op_names[op_index]) != 0) {
+        op_index++;
+    }
+    s_run.op = (bench_op_t)op_index;
+    s_run.payload[0] = 0;
+    esp_err_t err = ESP_OK;
+    switch (s_run.op) {
+    case BENCH_OP_COMMISSION:
+        if (argc != 2 || bench_parse_nodes(argv[1], true) != ESP_OK) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        s_run.count = s_run.slot_count;
+        break;
+    case BENCH_OP_READ:
+    case BENCH_OP_WRITE:
+    case BENCH_OP_INVOKE:
+    case BENCH_OP_SUBSCRIBE:
+        if (argc < 6 || bench_parse_nodes(argv[2], false) != ESP_OK) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        s_run.count = string_to_uint32(argv[1]);
+        s_run.endpoint_id = string_to_uint16(argv[3]);
+        s_run.cluster_id = string_to_uint32(argv[4]);
+        s_run.id = string_to_uint32(argv[5]);
+        if (s_run.op == BENCH_OP_WRITE || s_run.op == BENCH_OP_INVOKE) {
+            if (argc > 7 || (s_run.op == BENCH_OP_WRITE && argc != 7)) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            if (argc == 7) {
+                strlcpy(s_run.payload, argv[6], sizeof(s_run.payload));
+            }
+        } else if (s_run.op == BENCH_OP_SUBSCRIBE) {
+            if (argc != 8) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            s_run.min_interval = string_to_uint16(argv[6]);
+            s_run.max_interval = string_to_uint16(argv[7]);
+        } else if (argc != 6) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        break;
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_run.count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    lock::status_t lock_status = lock::chip_stack_lock(portMAX_DELAY);
+    if (lock_status == lock::FAILED) {
+        return ESP_FAIL;
+    }
+    err = bench_start();
+    if (lock_status == lock::SUCCESS) {
+        lock::chip_stack_unlock();
+    }
+    return err;
+}
+
+esp_err_t app_benchmark_register_commands()
+{
+    static const esp_matter::console::command_t bench_command = {
+        .name = "bench",
+        .description = "Benchmark the controller commands. Usage:\n"
+                       "\tmatter esp bench read <count> <node_ids> <endpoint_id> <cluster_id> <attribute_id>\n"
+                       "\tmatter esp bench write <count> <node_ids> <endpoint_id> <cluster_id> <attribute_id> "
+                       "<value>\n"
+                       "\tmatter esp bench invoke <count> <node_ids> <endpoint_id> <cluster_id> <command_id> "
+                       "[payload]\n"
+                       "\tmatter esp bench subscribe <count> <node_ids> <endpoint_id> <cluster_id> <attribute_id> "
+                       "<min_interval> <max_interval>\n"
+                       "\tmatter esp bench commission <node_id:pincode[:discriminator],...>\n"
+                       "\tmatter esp bench timeout <ms>\n"
+                       "\tnode_ids is a comma separated list, the nodes run one operation at a time each.",
+        .handler = bench_console_handler,
+    };
+    return esp_matter::console::add_commands(&bench_command, 1);
+}
+#endif // CONFIG_CONTROLLER_BENCHMARK_ENABLE
@@ -0,0 +1,22 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#pragma once
+
+#include <esp_err.h>
+
+/** Register the `matter esp bench` console command.
+ *
+ * The command runs a number of read, write, invoke, subscribe or commission operations against a set of nodes, one
+ * operation in flight per node, and prints the latency percentiles, the failure rate and the heap usage as a
+ * `BENCH_RESULT` JSON line, to compare the results across releases.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_benchmark_register_commands();
@@ -27,6 +27,7 @@
 #endif // CONFIG_OPENTHREAD_BORDER_ROUTER
 #include <common_macros.h>
 #include <app_reset.h>
+#include <app_benchmark.h>
 
 #include <app/server/Server.h>
 #include <credentials/FabricTable.h>
@@ -82,8 +83,15 @@ extern "C" void app_main()
 #if CONFIG_ESP_MATTER_CONTROLLER_ENABLE
     esp_matter::console::controller_register_commands();
 #endif // CONFIG_ESP_MATTER_CONTROLLER_ENABLE
+#if CONFIG_CONTROLLER_BENCHMARK_ENABLE
+    app_benchmark_register_commands();
+#endif // CONFIG_CONTROLLER_BENCHMARK_ENABLE
 #if CONFIG_OPENTHREAD_BORDER_ROUTER && CONFIG_OPENTHREAD_CLI
     esp_matter::console::thread_br_cli_register_command();
+    esp_matter::console::thread_br_telemetry_register_command();
+#if CONFIG_OPENTHREAD_BR_SRP_COALESCED_PUBLISH
+    esp_matter::console::thread_br_srp_publish_register_command();
+#endif
 #endif // CONFIG_OPENTHREAD_BORDER_ROUTER && CONFIG_OPENTHREAD_CLI
 #endif // CONFIG_ENABLE_CHIP_SHELL
 #if !CONFIG_ESP_MATTER_COMMISSIONER_ENABLE
@@ -0,0 +1,634 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#include <esp_check.h>
+#include <esp_cpu.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <esp_matter.h>
+#include <esp_matter_console.h>
+
+#include <app-common/zap-generated/callback.h>
+#include <app/InteractionModelEngine.h>
+#include <app/util/attribute-storage.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/core/TLV.h>
+
+#include <app_dm_benchmark.h>
+
+using namespace esp_matter;
+using namespace chip::app::Clusters;
+using chip::Protocols::InteractionModel::Status;
+
+static const char *TAG = "app_dm_benchmark";
+
+/* Timing of a run of a benchmark, the time spent between pause_timing() and resume_timing() is not measured. The
+ * cycles are counted by the core running the benchmarks, the task of the benchmarks is pinned to it. */
+typedef struct {
+    uint32_t iterations;
+    int64_t paused_us;
+    int64_t pause_start_us;
+    uint32_t paused_cycles;
+    uint32_t pause_start_cycles;
+} bench_state_t;
+
+typedef esp_err_t (*bench_fn_t)(bench_state_t *state);
+
+typedef struct {
+    const char *name;
+    bench_fn_t fn;
+    /* The endpoint benchmarks use an endpoint id per iteration, they are limited to a few iterations */
+    uint32_t max_iterations;
+} benchmark_t;
+
+#if CONFIG_DM_BENCHMARK_DEVICE_TYPE_EXTENDED_COLOR_LIGHT
+#define DM_BENCHMARK_DEVICE_TYPE_NAME "extended_color_light"
+#else
+#define DM_BENCHMARK_DEVICE_TYPE_NAME "on_off_light"
+#endif
+
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+#define DM_BENCHMARK_DATA_MODEL_NAME "dynamic"
+#elif CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL
+#define DM_BENCHMARK_DATA_MODEL_NAME "hybrid"
+#else
+#define DM_BENCHMARK_DATA_MODEL_NAME "zap"
+#endif
+
+static uint16_t s_endpoint_id = chip::kInvalidEndpointId;
+#if DM_BENCHMARK_DYNAMIC_ENDPOINTS
+static node_t *s_node = nullptr;
+static attribute_t *s_on_off = nullptr;
+#endif
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+static uint8_t s_tlv_buffer[16];
+static uint32_t s_tlv_length = 0;
+#endif
+
+static void pause_timing(bench_state_t *state)
+{
+    state->pause_start_cycles = esp_cpu_get_cycle_count();
+    state->pause_start_us = esp_timer_get_time();
+}
+
+static void resume_timing(bench_state_t *state)
+{
+    state->paused_us += esp_timer_get_time() - state->pause_start_us;
+    state->paused_cycles += esp_cpu_get_cycle_count() - state->pause_start_cycles;
+}
+
+/* The Matter stack lock is held by the loops of the benchmarks running in the Matter context */
+class scoped_lock {
+public:
+    scoped_lock() : m_status(lock::chip_stack_lock(portMAX_DELAY)) {}
+    ~scoped_lock()
+    {
+        if (m_status == lock::SUCCESS) {
+            lock::chip_stack_unlock();
+        }
+    }
+    bool failed() const { return m_status == lock::FAILED; }
+
+private:
+    lock::status_t m_status;
+};
+
+#if DM_BENCHMARK_DYNAMIC_ENDPOINTS
+endpoint_t *app_dm_benchmark_create_endpoint(node_t *node, uint8_t flags)
+{
+#if CONFIG_DM_BENCHMARK_DEVICE_TYPE_EXTENDED_COLOR_LIGHT
+    endpoint::extended_color_light::config_t config;
+    return endpoint::extended_color_light::create(node, &config, flags, NULL);
+#else
+    endpoint::on_off_light::config_t config;
+    return endpoint::on_off_light::create(node, &config, flags, NULL);
+#endif
+}
+
+static esp_err_t bench_endpoint_create(bench_state_t *state)
+{
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        endpoint_t *endpoint = app_dm_benchmark_create_endpoint(s_node, ENDPOINT_FLAG_DESTROYABLE);
+        ESP_RETURN_ON_FALSE(endpoint, ESP_ERR_NO_MEM, TAG, "Failed to create the endpoint");
+        ESP_RETURN_ON_ERROR(endpoint::destroy(s_node, endpoint), TAG, "Failed to destroy the endpoint");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_endpoint_enable(bench_state_t *state)
+{
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        pause_timing(state);
+        endpoint_t *endpoint = app_dm_benchmark_create_endpoint(s_node, ENDPOINT_FLAG_DESTROYABLE);
+        ESP_RETURN_ON_FALSE(endpoint, ESP_ERR_NO_MEM, TAG, "Failed to create the endpoint");
+        resume_timing(state);
+        esp_err_t err = endpoint::enable(endpoint);
+        pause_timing(state);
+        endpoint::destroy(s_node, endpoint);
+        resume_timing(state);
+        ESP_RETURN_ON_ERROR(err, TAG, "Failed to enable the endpoint");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_attribute_lookup(bench_state_t *state)
+{
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        endpoint_t *endpoint = endpoint::get(s_node, s_endpoint_id);
+        cluster_t *cluster = cluster::get(endpoint, OnOff::Id);
+        ESP_RETURN_ON_FALSE(attribute::get(cluster, OnOff::Attributes::OnOff::Id), ESP_ERR_NOT_FOUND, TAG,
+                            "Failed to find the attribute");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_attribute_get_val(bench_state_t *state)
+{
+    esp_matter_attr_val_t val = esp_matter_invalid(NULL);
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        ESP_RETURN_ON_ERROR(attribute::get_val(s_on_off, &val), TAG, "Failed to get the value");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_attribute_set_val(bench_state_t *state)
+{
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        esp_matter_attr_val_t val = esp_matter_bool(idx & 1);
+        ESP_RETURN_ON_ERROR(attribute::set_val(s_on_off, &val), TAG, "Failed to set the value");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_attribute_report(bench_state_t *state)
+{
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        esp_matter_attr_val_t val = esp_matter_bool(idx & 1);
+        ESP_RETURN_ON_ERROR(attribute::report(s_endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val), TAG,
+                            "Failed to report the value");
+    }
+    return ESP_OK;
+}
+
+/* The read of the attribute storage of esp_matter, without the ember lookup of the attribute */
+static esp_err_t bench_external_read_callback(bench_state_t *state)
+{
+    scoped_lock lock;
+    ESP_RETURN_ON_FALSE(!lock.failed(), ESP_FAIL, TAG, "Failed to take the Matter stack lock");
+    const EmberAfAttributeMetadata *metadata = emberAfLocateAttributeMetadata(s_endpoint_id, OnOff::Id,
+                                                                              OnOff::Attributes::OnOff::Id);
+    ESP_RETURN_ON_FALSE(metadata, ESP_ERR_NOT_FOUND, TAG, "Failed to find the attribute metadata");
+    uint8_t buffer[4];
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        Status status = emberAfExternalAttributeReadCallback(s_endpoint_id, OnOff::Id, metadata, buffer,
+                                                             sizeof(buffer));
+        ESP_RETURN_ON_FALSE(status == Status::Success, ESP_FAIL, TAG, "Failed to read the attribute");
+    }
+    return ESP_OK;
+}
+#endif // DM_BENCHMARK_DYNAMIC_ENDPOINTS
+
+/* The benchmarks below also run on the fixed endpoint of the zap data model, where the attributes are stored by the
+ * ember layer, to compare the data models */
+static esp_err_t bench_attribute_update(bench_state_t *state)
+{
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        esp_matter_attr_val_t val = esp_matter_bool(idx & 1);
+        ESP_RETURN_ON_ERROR(attribute::update(s_endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val), TAG,
+                            "Failed to update the value");
+    }
+    return ESP_OK;
+}
+
+/* The ember lookup of the attribute metadata, in the generated tables or in the metadata of the dynamic endpoints */
+static esp_err_t bench_ember_lookup(bench_state_t *state)
+{
+    scoped_lock lock;
+    ESP_RETURN_ON_FALSE(!lock.failed(), ESP_FAIL, TAG, "Failed to take the Matter stack lock");
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        ESP_RETURN_ON_FALSE(emberAfLocateAttributeMetadata(s_endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id),
+                            ESP_ERR_NOT_FOUND, TAG, "Failed to find the attribute metadata");
+    }
+    return ESP_OK;
+}
+
+/* The ember reads and writes of the interaction model, served by the external attribute callbacks of the dynamic
+ * endpoints and by the ember storage of the fixed endpoints */
+static esp_err_t bench_external_read(bench_state_t *state)
+{
+    scoped_lock lock;
+    ESP_RETURN_ON_FALSE(!lock.failed(), ESP_FAIL, TAG, "Failed to take the Matter stack lock");
+    uint8_t buffer[4];
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        Status status = emberAfReadAttribute(s_endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, buffer,
+                                             sizeof(buffer));
+        ESP_RETURN_ON_FALSE(status == Status::Success, ESP_FAIL, TAG, "Failed to read the attribute");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_external_write(bench_state_t *state)
+{
+    scoped_lock lock;
+    ESP_RETURN_ON_FALSE(!lock.failed(), ESP_FAIL, TAG, "Failed to take the Matter stack lock");
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        uint8_t value = idx & 1;
+        Status status = emberAfWriteAttribute(s_endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &value,
+                                              ZCL_BOOLEAN_ATTRIBUTE_TYPE);
+        ESP_RETURN_ON_FALSE(status == Status::Success, ESP_FAIL, TAG, "Failed to write the attribute");
+    }
+    return ESP_OK;
+}
+
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+/* The commands of the zap and hybrid data models are dispatched by the generated dispatcher, without the vendor
+ * specific cluster */
+static esp_err_t bench_command_dispatch(bench_state_t *state)
+{
+    scoped_lock lock;
+    ESP_RETURN_ON_FALSE(!lock.failed(), ESP_FAIL, TAG, "Failed to take the Matter stack lock");
+    chip::app::ConcreteCommandPath path(s_endpoint_id, DM_BENCHMARK_CLUSTER_ID, DM_BENCHMARK_COMMAND_ID);
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        /* The reader is positioned on the fields of the command, as the interaction model does */
+        chip::TLV::TLVReader reader;
+        reader.Init(s_tlv_buffer, s_tlv_length);
+        ESP_RETURN_ON_FALSE(reader.Next() == CHIP_NO_ERROR, ESP_FAIL, TAG, "Failed to decode the command fields");
+        chip::app::DispatchSingleClusterCommand(path, reader, nullptr);
+    }
+    return ESP_OK;
+}
+#endif // CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+
+/* Crypto of the CASE session establishment and of the message encryption, through the crypto PAL of the SDK. The
+ * PAL uses mbedTLS, which runs on the AES, SHA, MPI and ECC peripherals with the CONFIG_MBEDTLS_HARDWARE_* options
+ * of ESP-IDF, build with sdkconfig.defaults.sw_crypto to compare with the software implementations. */
+static const uint8_t k_crypto_message[128] = {0};
+static const uint8_t k_crypto_nonce[chip::Crypto::kAES_CCM128_Nonce_Length] = {0};
+
+static esp_err_t bench_crypto_p256_keygen(bench_state_t *state)
+{
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        chip::Crypto::P256Keypair keypair;
+        ESP_RETURN_ON_FALSE(keypair.Initialize(chip::Crypto::ECPKeyTarget::ECDH) == CHIP_NO_ERROR, ESP_FAIL, TAG,
+                            "Failed to generate the key pair");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_crypto_p256_ecdh(bench_state_t *state)
+{
+    chip::Crypto::P256Keypair keypair;
+    chip::Crypto::P256Keypair peer;
+    ESP_RETURN_ON_FALSE(keypair.Initialize(chip::Crypto::ECPKeyTarget::ECDH) == CHIP_NO_ERROR &&
+                            peer.Initialize(chip::Crypto::ECPKeyTarget::ECDH) == CHIP_NO_ERROR,
+                        ESP_FAIL, TAG, "Failed to generate the key pairs");
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        chip::Crypto::P256ECDHDerivedSecret secret;
+        ESP_RETURN_ON_FALSE(keypair.ECDH_derive_secret(peer.Pubkey(), secret) == CHIP_NO_ERROR, ESP_FAIL, TAG,
+                            "Failed to derive the shared secret");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_crypto_p256_sign(bench_state_t *state)
+{
+    chip::Crypto::P256Keypair keypair;
+    ESP_RETURN_ON_FALSE(keypair.Initialize(chip::Crypto::ECPKeyTarget::ECDSA) == CHIP_NO_ERROR, ESP_FAIL, TAG,
+                        "Failed to generate the key pair");
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        chip::Crypto::P256ECDSASignature signature;
+        ESP_RETURN_ON_FALSE(keypair.ECDSA_sign_msg(k_crypto_message, sizeof(k_crypto_message), signature) ==
+                                CHIP_NO_ERROR,
+                            ESP_FAIL, TAG, "Failed to sign the message");
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_crypto_p256_verify(bench_state_t *state)
+{
+    chip::Crypto::P256Keypair keypair;
+    chip::Crypto::P256ECDSASignature signature;
+    ESP_RETURN_ON_FALSE(keypair.Initialize(chip::Crypto::ECPKeyTarget::ECDSA) == CHIP_NO_ERROR &&
+                            keypair.ECDSA_sign_msg(k_crypto_message, sizeof(k_crypto_message), signature) ==
+                                CHIP_NO_ERROR,
+                        ESP_FAIL, TAG, "Failed to sign the message");
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        ESP_RETURN_ON_FALSE(keypair.Pubkey().ECDSA_validate_msg_signature(k_crypto_message, sizeof(k_crypto_message),
+                                                                          signature) == CHIP_NO_ERROR,
+                            ESP_FAIL, TAG, "Failed to verify the signature");
+    }
+    return ESP_OK;
+}
+
+/* The public key operations of a CASE responder: the ephemeral key pair and the shared secret, the signature of
+ * Sigma2, and the verification of the Sigma3 signature and of the NOC and ICAC of the initiator. The hashes and the
+ * key derivations of the handshake are small next to them. */
+static esp_err_t bench_crypto_case_responder(bench_state_t *state)
+{
+    chip::Crypto::P256Keypair operational;
+    chip::Crypto::P256Keypair initiator;
+    chip::Crypto::P256ECDSASignature signature;
+    ESP_RETURN_ON_FALSE(operational.Initialize(chip::Crypto::ECPKeyTarget::ECDSA) == CHIP_NO_ERROR &&
+                            initiator.Initialize(chip::Crypto::ECPKeyTarget::ECDH) == CHIP_NO_ERROR &&
+                            initiator.ECDSA_sign_msg(k_crypto_message, sizeof(k_crypto_message), signature) ==
+                                CHIP_NO_ERROR,
+                        ESP_FAIL, TAG, "Failed to set up the key pairs");
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        chip::Crypto::P256Keypair ephemeral;
+        chip::Crypto::P256ECDHDerivedSecret secret;
+        chip::Crypto::P256ECDSASignature sigma2_signature;
+        ESP_RETURN_ON_FALSE(ephemeral.Initialize(chip::Crypto::ECPKeyTarget::ECDH) == CHIP_NO_ERROR &&
+                                ephemeral.ECDH_derive_secret(initiator.Pubkey(), secret) == CHIP_NO_ERROR &&
+                                operational.ECDSA_sign_msg(k_crypto_message, sizeof(k_crypto_message),
+                                                           sigma2_signature) == CHIP_NO_ERROR,
+                            ESP_FAIL, TAG, "Failed to build Sigma2");
+        for (int verify = 0; verify < 3; ++verify) {
+            ESP_RETURN_ON_FALSE(initiator.Pubkey().ECDSA_validate_msg_signature(
+                                    k_crypto_message, sizeof(k_crypto_message), signature) == CHIP_NO_ERROR,
+                                ESP_FAIL, TAG, "Failed to verify Sigma3");
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bench_crypto_sha256(bench_state_t *state)
+{
+    uint8_t digest[chip::Crypto::kSHA256_Hash_Length];
+    for (uint32_t idx = 0; idx < state->iterations; ++idx) {
+        ESP_RETURN_ON_FALSE(chip::Crypto::Hash_SHA256(k_crypto_message, sizeof(k_crypto_message), digest) ==
+                                CHIP_NO_ERROR,
+                            ESP_FAIL, TAG, "Failed to hash the message");
+    }
+    return ESP_OK;
+}
+
+/* The encryption of a message of a session, 128 bytes of payload with the header as additional data */
+static esp_err_t bench_crypto_aes_ccm(bench_state_t *state, bool encrypt)
+{
+    chip::Crypto::DefaultSessionKeystore keystore;
+    chip::Crypto::Aes128KeyHandle key;
+    chip::Crypto::Symmetric128BitsKeyByteArray key_bytes = {0};
+    ESP_RETURN_ON_FALSE(keystore.CreateKey(key_bytes, key) == CHIP_NO_ERROR, ESP_FAIL, TAG,
+                        "Failed to create the key");
+    uint8_t ciphertext[sizeof(k_crypto_message)];
+    uint8_t plaintext[sizeof(k_crypto_message)];
+    uint8_t tag[chip::Crypto::kAES_CCM128_Tag_Length];
+    esp_err_t err = ESP_OK;
+    if (chip::Crypto::AES_CCM_encrypt(k_crypto_message, sizeof(k_crypto_message), k_crypto_message, 8, key,
+                                      k_crypto_nonce, sizeof(k_crypto_nonce), ciphertext, tag, sizeof(tag)) !=
+        CHIP_NO_ERROR) {
+        err = ESP_FAIL;
+    }
+    for (uint32_t idx = 0; idx < state->iterations && err == ESP_OK; ++idx) {
+        CHIP_ERROR chip_err = encrypt ?
+            chip::Crypto::AES_CCM_encrypt(k_crypto_message, sizeof(k_crypto_message), k_crypto_message, 8, key,
+                                          k_crypto_nonce, sizeof(k_crypto_nonce), ciphertext, tag, sizeof(tag)) :
+            chip::Crypto::AES_CCM_decrypt(ciphertext, sizeof(ciphertext), k_crypto_message, 8, tag, sizeof(tag), key,
+                                          k_crypto_nonce, sizeof(k_crypto_nonce), plaintext);
+        if (chip_err != CHIP_NO_ERROR) {
+            err = ESP_FAIL;
+        }
+    }
+    keystore.DestroyKey(key);
+    ESP_RETURN_ON_ERROR(err, TAG, "Failed to %s the message", encrypt ? "encrypt" : "decrypt");
+    return ESP_OK;
+}
+
+static esp_err_t bench_crypto_aes_ccm_encrypt(bench_state_t *state)
+{
+    return bench_crypto_aes_ccm(state, true);
+}
+
+static esp_err_t bench_crypto_aes_ccm_decrypt(bench_state_t *state)
+{
+    return bench_crypto_aes_ccm(state, false);
+}
+
+static const benchmark_t k_benchmarks[] = {
+#if DM_BENCHMARK_DYNAMIC_ENDPOINTS
+    {"endpoint_create_destroy", bench_endpoint_create, 64},
+    {"endpoint_enable", bench_endpoint_enable, 64},
+    {"attribute_lookup", bench_attribute_lookup, UINT32_MAX},
+    {"attribute_get_val", bench_attribute_get_val, UINT32_MAX},
+    {"attribute_set_val", bench_attribute_set_val, UINT32_MAX},
+#endif
+    {"attribute_update", bench_attribute_update, UINT32_MAX},
+#if DM_BENCHMARK_DYNAMIC_ENDPOINTS
+    {"attribute_report", bench_attribute_report, UINT32_MAX},
+    {"external_read_callback", bench_external_read_callback, UINT32_MAX},
+#endif
+    {"ember_lookup", bench_ember_lookup, UINT32_MAX},
+    {"external_read", bench_external_read, UINT32_MAX},
+    {"external_write", bench_external_write, UINT32_MAX},
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+    {"command_dispatch", bench_command_dispatch, UINT32_MAX},
+#endif
+    {"crypto_p256_keygen", bench_crypto_p256_keygen, UINT32_MAX},
+    {"crypto_p256_ecdh", bench_crypto_p256_ecdh, UINT32_MAX},
+    {"crypto_p256_sign", bench_crypto_p256_sign, UINT32_MAX},
+    {"crypto_p256_verify", bench_crypto_p256_verify, UINT32_MAX},
+    {"crypto_case_responder", bench_crypto_case_responder, UINT32_MAX},
+    {"crypto_sha256", bench_crypto_sha256, UINT32_MAX},
+    {"crypto_aes_ccm_encrypt", bench_crypto_aes_ccm_encrypt, UINT32_MAX},
+    {"crypto_aes_ccm_decrypt", bench_crypto_aes_ccm_decrypt, UINT32_MAX},
+};
+
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+/* The benchmark command has nothing to do, only the dispatch is measured */
+static esp_err_t benchmark_command_callback(const ConcreteCommandPath &command_path, TLVReader &tlv_data,
+                                            void *opaque_ptr)
+{
+    return ESP_OK;
+}
+#endif
+
+esp_err_t app_dm_benchmark_init(node_t *node, uint16_t light_endpoint_id)
+{
+#if DM_BENCHMARK_DYNAMIC_ENDPOINTS
+    ESP_RETURN_ON_FALSE(node, ESP_ERR_INVALID_ARG, TAG, "Node cannot be NULL");
+    endpoint_t *endpoint = endpoint::get(node, light_endpoint_id);
+    cluster_t *on_off_cluster = cluster::get(endpoint, OnOff::Id);
+    s_on_off = attribute::get(on_off_cluster, OnOff::Attributes::OnOff::Id);
+    ESP_RETURN_ON_FALSE(s_on_off, ESP_ERR_NOT_FOUND, TAG, "The endpoint %u is not an On/Off Light",
+                        light_endpoint_id);
+    s_node = node;
+#endif
+    s_endpoint_id = light_endpoint_id;
+
+#if CONFIG_ESP_MATTER_ENABLE_DATA_MODEL
+    cluster_t *cluster = cluster::create(endpoint, DM_BENCHMARK_CLUSTER_ID, CLUSTER_FLAG_SERVER);
+    ESP_RETURN_ON_FALSE(cluster, ESP_ERR_NO_MEM, TAG, "Failed to create the benchmark cluster");
+    ESP_RETURN_ON_FALSE(command::create(cluster, DM_BENCHMARK_COMMAND_ID, COMMAND_FLAG_ACCEPTED,
+                                        benchmark_command_callback),
+                        ESP_ERR_NO_MEM, TAG, "Failed to create the benchmark command");
+
+    /* The fields of the command: an empty structure */
+    chip::TLV::TLVWriter writer;
+    chip::TLV::TLVType outer;
+    writer.Init(s_tlv_buffer, sizeof(s_tlv_buffer));
+    ESP_RETURN_ON_FALSE(writer.StartContainer(chip::TLV::AnonymousTag(), chip::TLV::kTLVType_Structure, outer) ==
+                            CHIP_NO_ERROR && writer.EndContainer(outer) == CHIP_NO_ERROR &&
+                            writer.Finalize() == CHIP_NO_ERROR,
+                        ESP_FAIL, TAG, "Failed to encode the command fields");
+    s_tlv_length = writer.GetLengthWritten();
+#endif
+    return ESP_OK;
+}
+
+void app_dm_benchmark_print_memory()
+{
+    size_t data_model_heap = 0;
+#if DM_BENCHMARK_DYNAMIC_ENDPOINTS
+    memory_stats_t stats = {};
+    if (s_node && node::get_memory_stats(s_node, &stats) == ESP_OK) {
+        data_model_heap = stats.structs + stats.value_buffers + stats.bounds + stats.default_values + stats.metadata;
+    }
+#endif
+    printf("DM_BENCH_MEMORY {\"target\":\"%s\",\"data_model\":\"%s\",\"device_type\":\"%s\",\"free_heap\":%u,"
+           "\"min_free_heap\":%u,\"data_model_heap\":%u}\n", CONFIG_IDF_TARGET, DM_BENCHMARK_DATA_MODEL_NAME,
+           DM_BENCHMARK_DEVICE_TYPE_NAME, (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+           (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT), (unsigned)data_model_heap);
+}
+
+/* Run a benchmark with more iterations until it lasts the minimum time, as Google Benchmark does */
+static esp_err_t run_benchmark(const benchmark_t *benchmark)
+{
+    const int64_t min_time_us = (int64_t)CONFIG_DM_BENCHMARK_MIN_TIME_MS * 1000;
+    bench_state_t state = {};
+    state.iterations = 1;
+    int64_t elapsed_us = 0;
+    uint32_t elapsed_cycles = 0;
+    size_t free_start = 0;
+    while (true) {
+        state.paused_us = 0;
+        state.paused_cycles = 0;
+        free_start = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        int64_t start_us = esp_timer_get_time();
+        uint32_t start_cycles = esp_cpu_get_cycle_count();
+        ESP_RETURN_ON_ERROR(benchmark->fn(&state), TAG, "%s failed", benchmark->name);
+        /* The 32-bit cycle counter wraps after 17 s at 240 MHz, far above the time of a run */
+        elapsed_cycles = esp_cpu_get_cycle_count() - start_cycles - state.paused_cycles;
+        elapsed_us = esp_timer_get_time() - start_us - state.paused_us;
+        if (elapsed_us >= min_time_us || state.iterations >= benchmark->max_iterations) {
+            break;
+        }
+        /* Aim 40% above the minimum time, growing at most 10 times per run */
+        uint64_t next = elapsed_us > 0 ? (uint64_t)state.iterations * min_time_us * 14 / 10 / elapsed_us :
+                                         (uint64_t)state.iterations * 10;
+        next = next > (uint64_t)state.iterations * 10 ? (uint64_t)state.iterations * 10 : next;
+        next = next <= state.iterations ? state.iterations + 1 : next;
+        state.iterations = next > benchmark->max_iterations ? benchmark->max_iterations : (uint32_t)next;
+    }
+    int heap_delta = (int)free_start - (int)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    uint64_t ns_per_op = (uint64_t)elapsed_us * 1000 / state.iterations;
+    uint32_t cycles_per_op = elapsed_cycles / state.iterations;
+    printf("%-26s %12" PRIu64 " ns %10" PRIu32 " cycles %12" PRIu32 "\n", benchmark->name, ns_per_op, cycles_per_op,
+           state.iterations);
+    printf("DM_BENCH_RESULT {\"target\":\"%s\",\"data_model\":\"%s\",\"name\":\"%s\",\"iterations\":%" PRIu32
+           ",\"ns_per_op\":%" PRIu64 ",\"cycles_per_op\":%" PRIu32 ",\"heap_delta\":%d}\n", CONFIG_IDF_TARGET,
+           DM_BENCHMARK_DATA_MODEL_NAME, benchmark->name, state.iterations, ns_per_op, cycles_per_op, heap_delta);
+    return ESP_OK;
+}
+
+typedef struct {
+    const char *filter;
+    esp_err_t err;
+    SemaphoreHandle_t done;
+} run_request_t;
+
+static void run_benchmarks_task(void *arg)
+{
+    run_request_t *request = (run_request_t *)arg;
+    /* The logs of the data model would be measured with it */
+    esp_log_level_set("*", ESP_LOG_WARN);
+    printf("Target: %s, CPU: %d MHz, data model: %s, endpoints: %d, device type: %s\n", CONFIG_IDF_TARGET,
+           CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, DM_BENCHMARK_DATA_MODEL_NAME, DM_BENCHMARK_ENDPOINTS,
+           DM_BENCHMARK_DEVICE_TYPE_NAME);
+    printf("%-26s %15s %17s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+    size_t run = 0;
+    esp_err_t err = ESP_OK;
+    for (size_t idx = 0; idx < sizeof(k_benchmarks) / sizeof(k_benchmarks[0]) && err == ESP_OK; ++idx) {
+        if (request->filter && !strstr(k_benchmarks[idx].name, request->filter)) {
+            continue;
+        }
+        err = run_benchmark(&k_benchmarks[idx]);
+        run++;
+    }
+    esp_log_level_set("*", (esp_log_level_t)CONFIG_LOG_DEFAULT_LEVEL);
+    if (err == ESP_OK && run == 0) {
+        ESP_LOGE(TAG, "No benchmark matches %s", request->filter);
+        err = ESP_ERR_NOT_FOUND;
+    }
+    request->err = err;
+    xSemaphoreGive(request->done);
+    vTaskDelete(NULL);
+}
+
+esp_err_t app_dm_benchmark_run(const char *filter)
+{
+    ESP_RETURN_ON_FALSE(s_endpoint_id != chip::kInvalidEndpointId, ESP_ERR_INVALID_STATE, TAG,
+                        "The benchmarks are not initialized");
+    run_request_t request = {.filter = filter, .err = ESP_OK, .done = xSemaphoreCreateBinary()};
+    ESP_RETURN_ON_FALSE(request.done, ESP_ERR_NO_MEM, TAG, "Failed to create the semaphore");
+    /* The cycle counter is per core, the task of the benchmarks does not migrate */
+    if (xTaskCreatePinnedToCore(run_benchmarks_task, "dm_bench", CONFIG_DM_BENCHMARK_TASK_STACK_SIZE, &request,
+                                CONFIG_DM_BENCHMARK_TASK_PRIORITY, NULL, xPortGetCoreID()) != pdPASS) {
+        vSemaphoreDelete(request.done);
+        ESP_LOGE(TAG, "Failed to create the benchmark task");
+        return ESP_ERR_NO_MEM;
+    }
+    xSemaphoreTake(request.done, portMAX_DELAY);
+    vSemaphoreDelete(request.done);
+    return request.err;
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t dm_bench_console_handler(int argc, char **argv)
+{
+    if (argc == 1 && strcmp(argv[0], "list") == 0) {
+        for (size_t idx = 0; idx < sizeof(k_benchmarks) / sizeof(k_benchmarks[0]); ++idx) {
+            printf("%s\n", k_benchmarks[idx].name);
+        }
+        return ESP_OK;
+    } else if (argc == 1 && strcmp(argv[0], "memory") == 0) {
+        app_dm_benchmark_print_memory();
+        return ESP_OK;
+    } else if (argc <= 1) {
+        return app_dm_benchmark_run(argc == 1 ? argv[0] : NULL);
+    }
+    ESP_LOGE(TAG, "Usage: matter esp dm_bench [list|memory|<filter>]");
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t app_dm_benchmark_register_commands()
+{
+    static const esp_matter::console::command_t dm_bench_command = {
+        .name = "dm_bench",
+        .description = "Benchmark the data model. Usage:\n"
+                       "\tmatter esp dm_bench\n"
+                       "\tmatter esp dm_bench <filter>\n"
+                       "\tmatter esp dm_bench list\n"
+                       "\tmatter esp dm_bench memory",
+        .handler = dm_bench_console_handler,
+    };
+    return esp_matter::console::add_commands(&dm_bench_command, 1);
+}
+#else
+esp_err_t app_dm_benchmark_register_commands()
+{
+    return ESP_OK;
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
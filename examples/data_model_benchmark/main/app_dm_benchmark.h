@@ -0,0 +1,81 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#pragma once
+
+#include <esp_err.h>
+#include <esp_matter_core.h>
+
+/** Vendor specific cluster and command used to benchmark the command dispatch */
+#define DM_BENCHMARK_CLUSTER_ID 0xFFF1FC00
+#define DM_BENCHMARK_COMMAND_ID 0x00
+
+/** The endpoints of the zap data model are fixed, only the benchmarks of the stack run on them */
+#define DM_BENCHMARK_DYNAMIC_ENDPOINTS (CONFIG_ESP_MATTER_ENABLE_DATA_MODEL || CONFIG_ESP_MATTER_ENABLE_HYBRID_DATA_MODEL)
+
+#if DM_BENCHMARK_DYNAMIC_ENDPOINTS
+#define DM_BENCHMARK_ENDPOINTS CONFIG_DM_BENCHMARK_ENDPOINT_COUNT
+#else
+/** The Extended Color Light endpoint of the lighting-app zap data model */
+#define DM_BENCHMARK_ZAP_LIGHT_ENDPOINT_ID 1
+#define DM_BENCHMARK_ENDPOINTS 1
+#endif
+
+#if DM_BENCHMARK_DYNAMIC_ENDPOINTS
+/** Create an endpoint of the device type of the node shape, CONFIG_DM_BENCHMARK_DEVICE_TYPE.
+ *
+ * @param[in] node Node of the endpoint.
+ * @param[in] flags Flags of the endpoint.
+ *
+ * @return Endpoint on success.
+ * @return NULL in case of failure.
+ */
+esp_matter::endpoint_t *app_dm_benchmark_create_endpoint(esp_matter::node_t *node, uint8_t flags);
+#endif
+
+/** Set up the fixtures of the benchmarks.
+ *
+ * The light endpoint is the target of the attribute benchmarks, and gets the vendor specific cluster with the no-op
+ * command of the dispatch benchmark with the esp_matter data model. Call it before esp_matter::start(), so the cluster
+ * is enabled with the endpoint.
+ *
+ * @param[in] node Node of the benchmarks, where the endpoints are created and destroyed, NULL with the zap data model.
+ * @param[in] light_endpoint_id Endpoint with an On/Off cluster, from app_dm_benchmark_create_endpoint(), or
+ *                              DM_BENCHMARK_ZAP_LIGHT_ENDPOINT_ID with the zap data model.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_dm_benchmark_init(esp_matter::node_t *node, uint16_t light_endpoint_id);
+
+/** Print the memory used with the data model, as a `DM_BENCH_MEMORY` JSON line.
+ *
+ * The free heap after esp_matter::start() and the heap of the esp_matter data model, to compare the data models with
+ * the static memory and the flash reported by `idf.py size`.
+ */
+void app_dm_benchmark_print_memory();
+
+/** Run the benchmarks whose name contains a filter.
+ *
+ * The benchmarks run in a task pinned to the core of the caller, which counts the CPU cycles with
+ * esp_cpu_get_cycle_count(). The results are printed as a table, and as `DM_BENCH_RESULT` JSON lines with the target,
+ * to compare them across releases, targets and configurations.
+ *
+ * @param[in] filter Part of the name of the benchmarks to run, NULL to run all of them.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NOT_FOUND if no benchmark matches the filter.
+ */
+esp_err_t app_dm_benchmark_run(const char *filter);
+
+/** Register the `matter esp dm_bench` console command.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t app_dm_benchmark_register_commands();
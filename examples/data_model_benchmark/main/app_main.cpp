@@ -0,0 +1,89 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#include <esp_err.h>
+#include <esp_log.h>
+#include <nvs_flash.h>
+#include <esp_matter.h>
+#include <esp_matter_console.h>
+#include <common_macros.h>
+#include <app_dm_benchmark.h>
+
+static const char *TAG = "app_main";
+
+using namespace esp_matter;
+using namespace esp_matter::attribute;
+using namespace esp_matter::endpoint;
+
+static void app_event_cb(const ChipDeviceEvent *event, intptr_t arg)
+{
+    switch (event->Type) {
+    case chip::DeviceLayer::DeviceEventType::kCommissioningComplete:
+        ESP_LOGI(TAG, "Commissioning complete");
+        break;
+
+    default:
+        break;
+    }
+}
+
+// The endpoints are virtual, there is nothing to identify.
+static esp_err_t app_identification_cb(identification::callback_type_t type, uint16_t endpoint_id, uint8_t effect_id,
+                                       uint8_t effect_variant, void *priv_data)
+{
+    return ESP_OK;
+}
+
+// The endpoints are virtual, the attribute updates have no driver to reach and only the data model is measured.
+static esp_err_t app_attribute_update_cb(attribute::callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                                         uint32_t attribute_id, esp_matter_attr_val_t *val, void *priv_data)
+{
+    return ESP_OK;
+}
+
+extern "C" void app_main()
+{
+    esp_err_t err = ESP_OK;
+
+    /* Initialize the ESP NVS layer */
+    nvs_flash_init();
+
+#if DM_BENCHMARK_DYNAMIC_ENDPOINTS
+    /* Create a Matter node and add the mandatory Root Node device type on endpoint 0, with the hybrid data model the
+     * root node and the light of the zap data model are fixed endpoints and the endpoints created follow them */
+    node::config_t node_config;
+    node_t *node = node::create(&node_config, app_attribute_update_cb, app_identification_cb);
+    ABORT_APP_ON_FAILURE(node != nullptr, ESP_LOGE(TAG, "Failed to create Matter node"));
+
+    /* The shape of the node, the last endpoint is the target of the attribute and command benchmarks */
+    endpoint_t *light = nullptr;
+    for (int idx = 0; idx < CONFIG_DM_BENCHMARK_ENDPOINT_COUNT; idx++) {
+        light = app_dm_benchmark_create_endpoint(node, ENDPOINT_FLAG_NONE);
+        ABORT_APP_ON_FAILURE(light != nullptr, ESP_LOGE(TAG, "Failed to create the light endpoint"));
+    }
+
+    err = app_dm_benchmark_init(node, endpoint::get_id(light));
+#else
+    /* The endpoints are the fixed endpoints of the lighting-app zap data model */
+    attribute::set_callback(app_attribute_update_cb);
+    identification::set_callback(app_identification_cb);
+    err = app_dm_benchmark_init(nullptr, DM_BENCHMARK_ZAP_LIGHT_ENDPOINT_ID);
+#endif
+    ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to set up the benchmarks, err:%d", err));
+
+    /* Matter start */
+    err = esp_matter::start(app_event_cb);
+    ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to start Matter, err:%d", err));
+    app_dm_benchmark_print_memory();
+
+#if CONFIG_ENABLE_CHIP_SHELL
+    esp_matter::console::diagnostics_register_commands();
+    app_dm_benchmark_register_commands();
+    esp_matter::console::init();
+#endif
+}
@@ -28,6 +28,7 @@
 #include "freertos/ringbuf.h"
 #include "epaper.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 static const char* TAG = "epaper";
 uint8_t _buffer[4000] = {0x00};
@@ -39,6 +40,13 @@ int16_t iot_current_page;
 #define EPAPER_1S_NS            1000000000
 #define EPAPER_QUE_SIZE_DEFAULT 10
 
+/* Changed pixels closer than this to a dirty rectangle extend it instead of starting a new one */
+#define EPAPER_DIRTY_MERGE_DISTANCE 8
+/* The partial waveform leaves some ghosting, it is cleaned with a full refresh after this many partial refreshes */
+#define EPAPER_FULL_REFRESH_INTERVAL 20
+/* Typical power drawn by the 2.13" panel while it refreshes, for the energy estimate of the logs */
+#define EPAPER_REFRESH_POWER_MW 12
+
 const unsigned char lut_partial[] =
 {
   0x0, 0x40, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
@@ -71,12 +79,23 @@ typedef struct {
     uint8_t dc_level;
 } epaper_dc_t;
 
+/* Rectangle in panel pixels, before the rotation of the paint */
+typedef struct {
+    uint16_t x0;
+    uint16_t y0;
+    uint16_t x1;
+    uint16_t y1;
+} epaper_rect_t;
+
 typedef struct {
     spi_device_handle_t bus;
     epaper_conf_t pin;       /* EPD properties */
     epaper_paint_t paint;   /* Paint properties */
     epaper_dc_t dc;
     SemaphoreHandle_t spi_mux;
+    epaper_rect_t dirty[EPAPER_MAX_DIRTY_RECTS]; /* Regions of the frame buffer changed since the last refresh */
+    uint8_t dirty_count;
+    uint16_t partial_refresh_count; /* Partial refreshes since the last full refresh */
 } epaper_dev_t;
 
 /*This function is called (in irq context!) just before a transmission starts.
@@ -338,20 +357,91 @@ void iot_epaper_draw_string(epaper_handle_t dev, int x, int y, const char* text,
     xSemaphoreGiveRecursive(device->spi_mux);
 }
 
+typedef struct {
+    const epaper_font_t *font;
+    char ascii_char;
+    uint8_t first_row;
+    uint8_t row_count;
+    uint32_t last_use;
+    uint8_t data[EPAPER_GLYPH_MAX_SIZE];    /* Inked rows, in the row layout of the FontEdit tables */
+} epaper_glyph_t;
+
+static epaper_glyph_t s_glyph_cache[EPAPER_GLYPH_CACHE_SIZE];
+static uint32_t s_glyph_use_count = 0;
+
+/**
+ *  @brief: find the glyph of a packed font in the cache, or decode it in place of the least recently used one
+ */
+static const epaper_glyph_t *iot_epaper_get_glyph(const epaper_font_t *font, char ascii_char)
+{
+    const epaper_packed_font_t *packed = font->packed;
+    if ((uint8_t)ascii_char < packed->first_char || (uint8_t)ascii_char > packed->last_char) {
+        return NULL;
+    }
+    epaper_glyph_t *glyph = &s_glyph_cache[0];
+    for (int index = 0; index < EPAPER_GLYPH_CACHE_SIZE; index++) {
+        epaper_glyph_t *entry = &s_glyph_cache[index];
+        if (entry->font == font && entry->ascii_char == ascii_char) {
+            entry->last_use = ++s_glyph_use_count;
+            return entry;
+        }
+        if (entry->last_use < glyph->last_use) {
+            glyph = entry;
+        }
+    }
+    const uint8_t *src = &packed->glyphs[packed->offsets[(uint8_t)ascii_char - packed->first_char]];
+    uint16_t stride = (font->width + 7) / 8;
+    if (src[1] * stride > EPAPER_GLYPH_MAX_SIZE) {
+        ESP_LOGE(TAG, "Glyph of %ux%u font too large for the cache", font->width, font->height);
+        return NULL;
+    }
+    glyph->font = font;
+    glyph->ascii_char = ascii_char;
+    glyph->first_row = src[0];
+    glyph->row_count = src[1];
+    glyph->last_use = ++s_glyph_use_count;
+    memset(glyph->data, 0, glyph->row_count * stride);
+    const uint8_t *bits = &src[2];
+    uint32_t bit = 0;
+    for (uint16_t row = 0; row < glyph->row_count; row++) {
+        for (uint16_t column = 0; column < font->width; column++, bit++) {
+            if (bits[bit / 8] & (0x80 >> (bit % 8))) {
+                glyph->data[row * stride + column / 8] |= 0x80 >> (column % 8);
+            }
+        }
+    }
+    return glyph;
+}
+
 /**
  *  @brief: this draws a charactor on the frame buffer but not refresh
  */
 void iot_epaper_draw_char(epaper_handle_t dev, int x, int y, char ascii_char, epaper_font_t* font, int colored)
 {
     int i, j;
-    unsigned int char_offset = (ascii_char - ' ') * font->height * (font->width / 8 + (font->width % 8 ? 1 : 0));
-    const unsigned char* ptr = &font->font_table[char_offset];
+    int first_row = 0;
+    int row_count = font->height;
+    const unsigned char* ptr;
     epaper_dev_t* device = (epaper_dev_t*) dev;
     xSemaphoreTakeRecursive(device->spi_mux, portMAX_DELAY);
-    for (j = 0; j < font->height; j++) {
+    if (font->packed) {
+        /* Only the inked rows are drawn */
+        const epaper_glyph_t *glyph = iot_epaper_get_glyph(font, ascii_char);
+        if (!glyph) {
+            xSemaphoreGiveRecursive(device->spi_mux);
+            return;
+        }
+        ptr = glyph->data;
+        first_row = glyph->first_row;
+        row_count = glyph->row_count;
+    } else {
+        unsigned int char_offset = (ascii_char - ' ') * font->height * (font->width / 8 + (font->width % 8 ? 1 : 0));
+        ptr = &font->font_table[char_offset];
+    }
+    for (j = 0; j < row_count; j++) {
         for (i = 0; i < font->width; i++) {
             if (*ptr & (0x80 >> (i % 8))) {
-                iot_drawPixel(dev, x + i, y + j, colored);
+                iot_drawPixel(dev, x + i, y + first_row + j, colored);
             }
             if (i % 8 == 7) {
                 ptr++;
@@ -716,6 +806,89 @@ void iot_Init_Part(epaper_handle_t dev,uint8_t em)
   //iot_PowerOn(dev);         //bug here?
 }
 
+static uint32_t rect_area(const epaper_rect_t *rect)
+{
+    return (uint32_t)(rect->x1 - rect->x0 + 1) * (rect->y1 - rect->y0 + 1);
+}
+
+static void rect_extend(epaper_rect_t *rect, uint16_t x, uint16_t y)
+{
+    rect->x0 = x < rect->x0 ? x : rect->x0;
+    rect->x1 = x > rect->x1 ? x : rect->x1;
+    rect->y0 = y < rect->y0 ? y : rect->y0;
+    rect->y1 = y > rect->y1 ? y : rect->y1;
+}
+
+/**
+ * @brief  Add a changed pixel, in panel coordinates, to the dirty rectangles
+ */
+static void iot_epaper_mark_dirty(epaper_dev_t *device, uint16_t x, uint16_t y)
+{
+    for (uint8_t index = 0; index < device->dirty_count; index++) {
+        epaper_rect_t *rect = &device->dirty[index];
+        if (x + EPAPER_DIRTY_MERGE_DISTANCE >= rect->x0 && x <= rect->x1 + EPAPER_DIRTY_MERGE_DISTANCE &&
+            y + EPAPER_DIRTY_MERGE_DISTANCE >= rect->y0 && y <= rect->y1 + EPAPER_DIRTY_MERGE_DISTANCE) {
+            rect_extend(rect, x, y);
+            return;
+        }
+    }
+    if (device->dirty_count < EPAPER_MAX_DIRTY_RECTS) {
+        epaper_rect_t *rect = &device->dirty[device->dirty_count++];
+        rect->x0 = rect->x1 = x;
+        rect->y0 = rect->y1 = y;
+        return;
+    }
+    /* All the rectangles are used, grow the one which grows the least */
+    uint8_t best = 0;
+    uint32_t best_growth = UINT32_MAX;
+    for (uint8_t index = 0; index < device->dirty_count; index++) {
+        epaper_rect_t grown = device->dirty[index];
+        rect_extend(&grown, x, y);
+        uint32_t growth = rect_area(&grown) - rect_area(&device->dirty[index]);
+        if (growth < best_growth) {
+            best_growth = growth;
+            best = index;
+        }
+    }
+    rect_extend(&device->dirty[best], x, y);
+}
+
+void iot_epaper_clear_dirty(epaper_handle_t dev)
+{
+    epaper_dev_t* device = (epaper_dev_t*) dev;
+    device->dirty_count = 0;
+}
+
+int iot_epaper_update_dirty(epaper_handle_t dev)
+{
+    epaper_dev_t* device = (epaper_dev_t*) dev;
+    xSemaphoreTakeRecursive(device->spi_mux, portMAX_DELAY);
+    int count = device->dirty_count;
+    if (count == 0) {
+        xSemaphoreGiveRecursive(device->spi_mux);
+        return 0;
+    }
+    int64_t start_us = esp_timer_get_time();
+    uint32_t pixels = 0;
+    if (++device->partial_refresh_count >= EPAPER_FULL_REFRESH_INTERVAL) {
+        iot_epaper_update(dev);
+        pixels = GxDEPG0213BN_WIDTH * GxDEPG0213BN_HEIGHT;
+        ESP_LOGI(TAG, "Full refresh to clean the ghosting of the partial refreshes");
+    } else {
+        for (uint8_t index = 0; index < device->dirty_count; index++) {
+            epaper_rect_t *rect = &device->dirty[index];
+            iot_epaper_updateWindow(dev, rect->x0, rect->y0, rect->x1 - rect->x0 + 1, rect->y1 - rect->y0 + 1, false);
+            pixels += rect_area(rect);
+        }
+    }
+    device->dirty_count = 0;
+    uint32_t elapsed_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+    ESP_LOGI(TAG, "Refreshed %d regions, %lu pixels, in %lu ms, ~%lu mJ", count, (unsigned long)pixels,
+             (unsigned long)elapsed_ms, (unsigned long)(elapsed_ms * EPAPER_REFRESH_POWER_MW / 1000));
+    xSemaphoreGiveRecursive(device->spi_mux);
+    return count;
+}
+
 /**
  * @brief  Draw a pixel of the display
  */
@@ -756,10 +929,15 @@ void iot_drawPixel(epaper_handle_t dev, int16_t x, int16_t y, uint16_t color)
     i = x / 8 + y * GxDEPG0213BN_WIDTH / 8;
   }
 
+  uint8_t previous = _buffer[i];
   if (!color)
     _buffer[i] = (_buffer[i] | (1 << (7 - x % 8)));
   else
     _buffer[i] = (_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+  if (_buffer[i] != previous && iot_current_page < 1)
+  {
+    iot_epaper_mark_dirty((epaper_dev_t*) dev, x, y);
+  }
 }
 
 /**
@@ -820,7 +998,7 @@ void iot_epaper_updateWindow(epaper_handle_t dev,uint16_t x, uint16_t y, uint16_
     }
   }
   iot_Update_Part(dev);
-  esp_rom_delay_us(300000);
+  vTaskDelay(pdMS_TO_TICKS(300));
 
   // update previous buffer
   iot_SetRamArea(dev, xs_d8, xe_d8, y % 256, y / 256, ye % 256, ye / 256); // X-source area,Y-gate area
@@ -836,7 +1014,7 @@ void iot_epaper_updateWindow(epaper_handle_t dev,uint16_t x, uint16_t y, uint16_
       iot_epaper_send_byte(dev,(~data));
     }
   }
-  esp_rom_delay_us(300000);
+  vTaskDelay(pdMS_TO_TICKS(300));
 }
 
 /**
@@ -844,6 +1022,7 @@ void iot_epaper_updateWindow(epaper_handle_t dev,uint16_t x, uint16_t y, uint16_
  */
 void iot_epaper_update(epaper_handle_t dev)
 {
+    epaper_dev_t* device = (epaper_dev_t*) dev;
     //iot_epaper_reset(dev);
 
     iot_Init_Full(dev,0x03);
@@ -875,6 +1054,8 @@ void iot_epaper_update(epaper_handle_t dev)
     //power off
     iot_PowerOff(dev);
     //iot_current_page = -1;
+    device->dirty_count = 0;
+    device->partial_refresh_count = 0;
 }
 
 /**
@@ -0,0 +1,1132 @@
+// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by tools/pack_fonts.py from epaper_font.c, do not edit.
+
+#include "epaper_fonts.h"
+
+/* 5x8, 760 bytes unpacked */
+static const uint8_t font_8_glyphs[] = {
+    0x00, 0x00, 0x00, 0x06, 0x21, 0x08, 0x40, 0x10, 0x00, 0x02, 0x52, 0x80, 0x00, 0x07, 0x2A, 0xBE,
+    0xAF, 0xAA, 0x80, 0x00, 0x07, 0x21, 0x98, 0x61, 0x30, 0x80, 0x00, 0x06, 0x21, 0x06, 0xC1, 0x08,
+    0x01, 0x05, 0x39, 0x18, 0xA7, 0x80, 0x00, 0x03, 0x21, 0x08, 0x00, 0x07, 0x11, 0x08, 0x42, 0x10,
+    0x40, 0x00, 0x07, 0x41, 0x08, 0x42, 0x11, 0x00, 0x00, 0x04, 0x23, 0x88, 0xA0, 0x01, 0x05, 0x21,
+    0x3E, 0x42, 0x00, 0x04, 0x03, 0x11, 0x08, 0x03, 0x01, 0x70, 0x05, 0x01, 0x20, 0x00, 0x07, 0x11,
+    0x08, 0x44, 0x22, 0x00, 0x00, 0x06, 0x22, 0x94, 0xA5, 0x10, 0x00, 0x06, 0x61, 0x08, 0x42, 0x7C,
+    0x00, 0x06, 0x22, 0x88, 0x44, 0x38, 0x00, 0x06, 0x22, 0x84, 0x41, 0x30, 0x00, 0x06, 0x11, 0x94,
+    0xF1, 0x1C, 0x00, 0x06, 0x72, 0x18, 0x25, 0x10, 0x00, 0x06, 0x32, 0x18, 0xA5, 0x30, 0x00, 0x06,
+    0x72, 0x84, 0x42, 0x10, 0x00, 0x06, 0x22, 0x88, 0xA5, 0x10, 0x00, 0x06, 0x32, 0x94, 0x61, 0x30,
+    0x02, 0x04, 0x20, 0x00, 0x40, 0x02, 0x04, 0x10, 0x04, 0x40, 0x01, 0x05, 0x11, 0x30, 0x41, 0x00,
+    0x01, 0x03, 0x70, 0x1C, 0x01, 0x05, 0x41, 0x06, 0x44, 0x00, 0x00, 0x06, 0x22, 0x84, 0x40, 0x10,
+    0x00, 0x07, 0x32, 0x52, 0xB4, 0xA0, 0xE0, 0x00, 0x06, 0x61, 0x14, 0xE8, 0xEC, 0x00, 0x06, 0xF2,
+    0x5C, 0x94, 0xF8, 0x00, 0x06, 0x72, 0x90, 0x84, 0x18, 0x00, 0x06, 0xF2, 0x52, 0x94, 0xF8, 0x00,
+    0x06, 0xFA, 0x58, 0x84, 0xFC, 0x00, 0x06, 0xFA, 0x58, 0x84, 0x70, 0x00, 0x06, 0x72, 0x10, 0xB5,
+    0x18, 0x00, 0x06, 0xEA, 0x5E, 0x94, 0xF4, 0x00, 0x06, 0x71, 0x08, 0x42, 0x38, 0x00, 0x06, 0x38,
+    0x84, 0xA5, 0x10, 0x00, 0x06, 0xDA, 0x98, 0xE5, 0x6C, 0x00, 0x06, 0xE2, 0x10, 0x84, 0xFC, 0x00,
+    0x06, 0xDE, 0xF7, 0x58, 0xEC, 0x00, 0x06, 0xDB, 0x5A, 0xB5, 0xF4, 0x00, 0x06, 0x32, 0x52, 0x94,
+    0x98, 0x00, 0x06, 0xF2, 0x52, 0xE4, 0x70, 0x00, 0x07, 0x32, 0x52, 0x94, 0x98, 0x60, 0x00, 0x06,
+    0xF2, 0x52, 0xE4, 0xF4, 0x00, 0x06, 0x72, 0x88, 0x25, 0x38, 0x00, 0x06, 0xFD, 0x48, 0x42, 0x38,
+    0x00, 0x06, 0xDA, 0x52, 0x94, 0x98, 0x00, 0x06, 0xDC, 0x52, 0xA5, 0x18, 0x00, 0x06, 0xDC, 0x6B,
+    0x5A, 0xA8, 0x00, 0x06, 0xDA, 0x88, 0x45, 0x6C, 0x00, 0x06, 0xDC, 0x54, 0x42, 0x38, 0x00, 0x06,
+    0x7A, 0x44, 0x44, 0xBC, 0x00, 0x07, 0x31, 0x08, 0x42, 0x10, 0xC0, 0x00, 0x07, 0x82, 0x10, 0x42,
+    0x10, 0x40, 0x00, 0x07, 0x61, 0x08, 0x42, 0x11, 0x80, 0x00, 0x03, 0x21, 0x14, 0x07, 0x01, 0xF8,
+    0x00, 0x02, 0x20, 0x80, 0x02, 0x04, 0x30, 0x9C, 0xF0, 0x00, 0x06, 0xC2, 0x1C, 0x94, 0xF8, 0x02,
+    0x04, 0x72, 0x10, 0xE0, 0x00, 0x06, 0x18, 0x4E, 0x94, 0x9C, 0x02, 0x04, 0x73, 0x90, 0x60, 0x00,
+    0x06, 0x11, 0x1C, 0x42, 0x38, 0x02, 0x06, 0x3A, 0x52, 0x70, 0x98, 0x00, 0x06, 0xC2, 0x1C, 0x94,
+    0xF4, 0x00, 0x06, 0x20, 0x18, 0x42, 0x38, 0x00, 0x08, 0x20, 0x1C, 0x21, 0x08, 0x4E, 0x00, 0x06,
+    0xC2, 0x16, 0xE5, 0x6C, 0x00, 0x06, 0x61, 0x08, 0x42, 0x38, 0x02, 0x04, 0xD5, 0x6B, 0x50, 0x02,
+    0x04, 0xF2, 0x53, 0x90, 0x02, 0x04, 0x32, 0x52, 0x60, 0x02, 0x06, 0xF2, 0x52, 0xE4, 0x70, 0x02,
+    0x06, 0x3A, 0x52, 0x70, 0x8C, 0x02, 0x04, 0x79, 0x08, 0xE0, 0x02, 0x04, 0x31, 0x04, 0xC0, 0x01,
+    0x05, 0x47, 0x90, 0x93, 0x00, 0x02, 0x04, 0xDA, 0x52, 0x70, 0x02, 0x04, 0xCA, 0x4C, 0x60, 0x02,
+    0x04, 0xDD, 0x6A, 0xA0, 0x02, 0x04, 0x49, 0x8C, 0x90, 0x02, 0x06, 0xDA, 0x94, 0x42, 0x30, 0x02,
+    0x04, 0x7A, 0x8A, 0xF0, 0x00, 0x07, 0x11, 0x08, 0xC2, 0x10, 0x40, 0x00, 0x07, 0x21, 0x08, 0x42,
+    0x10, 0x80, 0x00, 0x07, 0x41, 0x08, 0x62, 0x11, 0x00, 0x03, 0x02, 0x2A, 0x80,
+};
+
+static const uint16_t font_8_offsets[] = {
+    0, 2, 8, 12, 19, 26, 32, 38, 42, 49, 56, 61,
+    67, 71, 74, 77, 84, 90, 96, 102, 108, 114, 120, 126,
+    132, 138, 144, 149, 154, 160, 164, 170, 176, 183, 189, 195,
+    201, 207, 213, 219, 225, 231, 237, 243, 249, 255, 261, 267,
+    273, 279, 286, 292, 298, 304, 310, 316, 322, 328, 334, 340,
+    347, 354, 361, 365, 368, 372, 377, 383, 388, 394, 399, 405,
+    411, 417, 423, 430, 436, 442, 447, 452, 457, 463, 469, 474,
+    479, 485, 490, 495, 500, 505, 511, 516, 523, 530, 537,
+};
+
+static const epaper_packed_font_t font_8_packed = {
+    font_8_glyphs,
+    font_8_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_8 = {
+    5, /* width */
+    8, /* height */
+    NULL,
+    &font_8_packed,
+};
+
+/* 7x12, 1140 bytes unpacked */
+static const uint8_t font_12_glyphs[] = {
+    0x00, 0x00, 0x01, 0x08, 0x10, 0x20, 0x40, 0x81, 0x00, 0x00, 0x08, 0x01, 0x03, 0x6C, 0x91, 0x20,
+    0x01, 0x09, 0x14, 0x28, 0xA3, 0xE2, 0x8F, 0x8A, 0x28, 0x50, 0x01, 0x09, 0x10, 0x71, 0x02, 0x03,
+    0x89, 0x1C, 0x08, 0x10, 0x01, 0x08, 0x20, 0xA0, 0x80, 0x67, 0x01, 0x05, 0x04, 0x03, 0x06, 0x18,
+    0x40, 0x82, 0xA4, 0x86, 0x80, 0x01, 0x04, 0x10, 0x20, 0x40, 0x80, 0x01, 0x0A, 0x08, 0x10, 0x40,
+    0x81, 0x02, 0x04, 0x08, 0x08, 0x10, 0x01, 0x0A, 0x20, 0x40, 0x40, 0x81, 0x02, 0x04, 0x08, 0x20,
+    0x40, 0x01, 0x05, 0x10, 0xF8, 0x41, 0x42, 0x80, 0x02, 0x07, 0x10, 0x20, 0x47, 0xF1, 0x02, 0x04,
+    0x00, 0x07, 0x04, 0x18, 0x20, 0xC1, 0x00, 0x05, 0x01, 0x7C, 0x07, 0x02, 0x30, 0x60, 0x01, 0x09,
+    0x04, 0x08, 0x20, 0x41, 0x02, 0x08, 0x10, 0x40, 0x01, 0x08, 0x38, 0x89, 0x12, 0x24, 0x48, 0x91,
+    0x1C, 0x01, 0x08, 0x30, 0x20, 0x40, 0x81, 0x02, 0x04, 0x3E, 0x01, 0x08, 0x38, 0x88, 0x10, 0x41,
+    0x04, 0x11, 0x3E, 0x01, 0x08, 0x38, 0x88, 0x10, 0xC0, 0x40, 0x91, 0x1C, 0x01, 0x08, 0x0C, 0x28,
+    0x51, 0x24, 0x4F, 0xC1, 0x07, 0x01, 0x08, 0x3C, 0x40, 0x81, 0xC0, 0x40, 0x91, 0x1C, 0x01, 0x08,
+    0x1C, 0x41, 0x03, 0xC4, 0x48, 0x91, 0x1C, 0x01, 0x08, 0x7C, 0x88, 0x10, 0x40, 0x81, 0x04, 0x08,
+    0x01, 0x08, 0x38, 0x89, 0x11, 0xC4, 0x48, 0x91, 0x1C, 0x01, 0x08, 0x38, 0x89, 0x12, 0x23, 0xC0,
+    0x82, 0x38, 0x03, 0x06, 0x30, 0x60, 0x00, 0x03, 0x06, 0x00, 0x03, 0x07, 0x18, 0x30, 0x00, 0x01,
+    0x86, 0x08, 0x00, 0x02, 0x07, 0x0C, 0x21, 0x84, 0x06, 0x02, 0x03, 0x00, 0x04, 0x03, 0x7C, 0x01,
+    0xF0, 0x02, 0x07, 0xC0, 0x40, 0x60, 0x21, 0x84, 0x30, 0x00, 0x02, 0x07, 0x18, 0x48, 0x10, 0x41,
+    0x00, 0x0C, 0x00, 0x00, 0x0A, 0x38, 0x89, 0x12, 0x65, 0x4A, 0x93, 0x20, 0x44, 0x70, 0x01, 0x08,
+    0x30, 0x20, 0xA1, 0x42, 0x8F, 0x91, 0x77, 0x01, 0x08, 0xF8, 0x89, 0x13, 0xC4, 0x48, 0x91, 0x7C,
+    0x01, 0x08, 0x3C, 0x89, 0x02, 0x04, 0x08, 0x11, 0x1C, 0x01, 0x08, 0xF0, 0x91, 0x12, 0x24, 0x48,
+    0x92, 0x78, 0x01, 0x08, 0xFC, 0x89, 0x43, 0x85, 0x08, 0x11, 0x7E, 0x01, 0x08, 0x7E, 0x44, 0xA1,
+    0xC2, 0x84, 0x08, 0x38, 0x01, 0x08, 0x3C, 0x89, 0x02, 0x04, 0xE8, 0x91, 0x1C, 0x01, 0x08, 0xEE,
+    0x89, 0x13, 0xE4, 0x48, 0x91, 0x77, 0x01, 0x08, 0x7C, 0x20, 0x40, 0x81, 0x02, 0x04, 0x3E, 0x01,
+    0x08, 0x3C, 0x10, 0x20, 0x44, 0x89, 0x12, 0x18, 0x01, 0x08, 0xEE, 0x89, 0x22, 0x87, 0x09, 0x11,
+    0x73, 0x01, 0x08, 0x70, 0x40, 0x81, 0x02, 0x04, 0x89, 0x3E, 0x01, 0x08, 0xEE, 0xD9, 0xB2, 0xA5,
+    0x48, 0x91, 0x77, 0x01, 0x08, 0xEE, 0xC9, 0x92, 0xA5, 0x4A, 0x93, 0x76, 0x01, 0x08, 0x38, 0x89,
+    0x12, 0x24, 0x48, 0x91, 0x1C, 0x01, 0x08, 0x78, 0x48, 0x91, 0x23, 0x84, 0x08, 0x38, 0x01, 0x09,
+    0x38, 0x89, 0x12, 0x24, 0x48, 0x91, 0x1C, 0x1C, 0x01, 0x08, 0xF8, 0x89, 0x12, 0x27, 0x89, 0x11,
+    0x71, 0x01, 0x08, 0x34, 0x99, 0x01, 0xC0, 0x40, 0x99, 0x2C, 0x01, 0x08, 0xFF, 0x24, 0x40, 0x81,
+    0x02, 0x04, 0x1C, 0x01, 0x08, 0xEE, 0x89, 0x12, 0x24, 0x48, 0x91, 0x1C, 0x01, 0x08, 0xEE, 0x89,
+    0x11, 0x42, 0x85, 0x04, 0x08, 0x01, 0x08, 0xEE, 0x89, 0x12, 0xA5, 0x4A, 0x95, 0x14, 0x01, 0x08,
+    0xC6, 0x88, 0xA0, 0x81, 0x05, 0x11, 0x63, 0x01, 0x08, 0xEE, 0x88, 0xA1, 0x41, 0x02, 0x04, 0x1C,
+    0x01, 0x08, 0x7C, 0x88, 0x20, 0x81, 0x04, 0x11, 0x3E, 0x01, 0x0A, 0x38, 0x40, 0x81, 0x02, 0x04,
+    0x08, 0x10, 0x20, 0x70, 0x01, 0x09, 0x40, 0x40, 0x81, 0x01, 0x02, 0x02, 0x04, 0x08, 0x01, 0x0A,
+    0x38, 0x10, 0x20, 0x40, 0x81, 0x02, 0x04, 0x08, 0x70, 0x01, 0x04, 0x10, 0x20, 0xA2, 0x20, 0x0B,
+    0x01, 0xFE, 0x01, 0x02, 0x10, 0x10, 0x03, 0x06, 0x38, 0x88, 0xF2, 0x24, 0x47, 0xC0, 0x01, 0x08,
+    0xC0, 0x81, 0x63, 0x24, 0x48, 0x91, 0x7C, 0x03, 0x06, 0x3C, 0x89, 0x02, 0x04, 0x47, 0x00, 0x01,
+    0x08, 0x0C, 0x08, 0xD2, 0x64, 0x48, 0x91, 0x1F, 0x03, 0x06, 0x38, 0x89, 0xF2, 0x04, 0x07, 0x80,
+    0x01, 0x08, 0x1C, 0x41, 0xF1, 0x02, 0x04, 0x08, 0x3E, 0x03, 0x08, 0x36, 0x99, 0x12, 0x24, 0x47,
+    0x81, 0x1C, 0x01, 0x08, 0xC0, 0x81, 0x63, 0x24, 0x48, 0x91, 0x77, 0x01, 0x08, 0x10, 0x01, 0xC0,
+    0x81, 0x02, 0x04, 0x3E, 0x01, 0x0A, 0x10, 0x01, 0xE0, 0x40, 0x81, 0x02, 0x04, 0x08, 0xE0, 0x01,
+    0x08, 0xC0, 0x81, 0x72, 0x47, 0x0A, 0x12, 0x6E, 0x01, 0x08, 0x30, 0x20, 0x40, 0x81, 0x02, 0x04,
+    0x3E, 0x03, 0x06, 0xE8, 0xA9, 0x52, 0xA5, 0x5F, 0xC0, 0x03, 0x06, 0xD8, 0xC9, 0x12, 0x24, 0x5D,
+    0xC0, 0x03, 0x06, 0x38, 0x89, 0x12, 0x24, 0x47, 0x00, 0x03, 0x08, 0xD8, 0xC9, 0x12, 0x24, 0x4F,
+    0x10, 0x70, 0x03, 0x08, 0x36, 0x99, 0x12, 0x24, 0x47, 0x81, 0x07, 0x03, 0x06, 0x6C, 0x60, 0x81,
+    0x02, 0x0F, 0x80, 0x03, 0x06, 0x3C, 0x88, 0xE0, 0x24, 0x4F, 0x00, 0x02, 0x07, 0x20, 0xF8, 0x81,
+    0x02, 0x04, 0x47, 0x00, 0x03, 0x06, 0xCC, 0x89, 0x12, 0x24, 0xC6, 0xC0, 0x03, 0x06, 0xEE, 0x89,
+    0x11, 0x42, 0x82, 0x00, 0x03, 0x06, 0xEE, 0x89, 0x52, 0xA5, 0x45, 0x00, 0x03, 0x06, 0xCC, 0x90,
+    0xC1, 0x84, 0x99, 0x80, 0x03, 0x08, 0xEE, 0x88, 0x91, 0x41, 0x82, 0x04, 0x3C, 0x03, 0x06, 0x7C,
+    0x90, 0x41, 0x04, 0x4F, 0x80, 0x01, 0x0A, 0x08, 0x20, 0x40, 0x81, 0x04, 0x04, 0x08, 0x10, 0x10,
+    0x01, 0x09, 0x10, 0x20, 0x40, 0x81, 0x02, 0x04, 0x08, 0x10, 0x01, 0x0A, 0x20, 0x20, 0x40, 0x81,
+    0x01, 0x04, 0x08, 0x10, 0x40, 0x05, 0x02, 0x24, 0xB0,
+};
+
+static const uint16_t font_12_offsets[] = {
+    0, 2, 11, 16, 26, 36, 45, 53, 59, 70, 81, 88,
+    97, 103, 106, 110, 120, 129, 138, 147, 156, 165, 174, 183,
+    192, 201, 210, 218, 227, 236, 241, 250, 259, 270, 279, 288,
+    297, 306, 315, 324, 333, 342, 351, 360, 369, 378, 387, 396,
+    405, 414, 424, 433, 442, 451, 460, 469, 478, 487, 496, 505,
+    516, 526, 537, 543, 546, 550, 558, 567, 575, 584, 592, 601,
+    610, 619, 628, 639, 648, 657, 665, 673, 681, 690, 699, 707,
+    715, 724, 732, 740, 748, 756, 765, 773, 784, 794, 805,
+};
+
+static const epaper_packed_font_t font_12_packed = {
+    font_12_glyphs,
+    font_12_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_12 = {
+    7, /* width */
+    12, /* height */
+    NULL,
+    &font_12_packed,
+};
+
+/* 11x16, 3040 bytes unpacked */
+static const uint8_t font_16_glyphs[] = {
+    0x00, 0x00, 0x01, 0x0A, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x00,
+    0x01, 0x80, 0x02, 0x05, 0x1D, 0xC3, 0xB8, 0x22, 0x04, 0x40, 0x88, 0x01, 0x0B, 0x0D, 0x81, 0xB0,
+    0x36, 0x06, 0xC3, 0xFC, 0x36, 0x0F, 0xF0, 0xD8, 0x1B, 0x03, 0x60, 0x6C, 0x00, 0x00, 0x0D, 0x04,
+    0x03, 0xF0, 0xC6, 0x18, 0xC3, 0x80, 0x3C, 0x03, 0xC0, 0x1C, 0x31, 0x86, 0x30, 0xFC, 0x02, 0x00,
+    0x40, 0x01, 0x0A, 0x18, 0x04, 0x80, 0x90, 0x0C, 0x60, 0x78, 0x3C, 0x0C, 0x60, 0x12, 0x02, 0x40,
+    0x30, 0x02, 0x09, 0x0F, 0x03, 0x00, 0x60, 0x0C, 0x00, 0xC0, 0x3B, 0x0D, 0xC1, 0x98, 0x1D, 0x80,
+    0x02, 0x05, 0x07, 0x00, 0xE0, 0x08, 0x01, 0x00, 0x20, 0x01, 0x0C, 0x03, 0x00, 0x60, 0x18, 0x07,
+    0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0E, 0x00, 0xC0, 0x0C, 0x01, 0x80, 0x01, 0x0C, 0x18, 0x03,
+    0x00, 0x30, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x01, 0x80, 0x70, 0x0C, 0x00, 0x01,
+    0x07, 0x06, 0x00, 0xC0, 0xFF, 0x1F, 0xE0, 0xF0, 0x3F, 0x06, 0x60, 0x03, 0x07, 0x04, 0x00, 0x80,
+    0x10, 0x1F, 0xC0, 0x40, 0x08, 0x01, 0x00, 0x09, 0x05, 0x06, 0x00, 0x80, 0x30, 0x04, 0x00, 0x80,
+    0x06, 0x01, 0x3F, 0x80, 0x09, 0x02, 0x0C, 0x01, 0x80, 0x00, 0x0D, 0x00, 0xC0, 0x18, 0x06, 0x00,
+    0xC0, 0x30, 0x06, 0x01, 0x80, 0x60, 0x0C, 0x03, 0x00, 0x60, 0x18, 0x03, 0x00, 0x01, 0x0A, 0x0E,
+    0x03, 0x60, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0x0C, 0x61, 0x8C, 0x1B, 0x01, 0xC0, 0x01, 0x0A, 0x06,
+    0x07, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x07, 0xF8, 0x01, 0x0A, 0x0F,
+    0x03, 0x30, 0xC6, 0x18, 0xC0, 0x30, 0x0C, 0x03, 0x00, 0xC0, 0x30, 0x07, 0xF0, 0x01, 0x0A, 0x3F,
+    0x0C, 0x30, 0x06, 0x01, 0x81, 0xF0, 0x07, 0x00, 0x60, 0x0C, 0x61, 0x87, 0xE0, 0x01, 0x0A, 0x07,
+    0x00, 0xE0, 0x3C, 0x05, 0x81, 0xB0, 0x26, 0x0C, 0xC1, 0xFC, 0x03, 0x01, 0xF0, 0x01, 0x0A, 0x1F,
+    0x83, 0x00, 0x60, 0x0C, 0x01, 0xF0, 0x23, 0x00, 0x60, 0x0C, 0x21, 0x83, 0xE0, 0x01, 0x0A, 0x07,
+    0x83, 0x80, 0x60, 0x18, 0x03, 0x70, 0x73, 0x0C, 0x61, 0x8C, 0x19, 0x81, 0xE0, 0x01, 0x0A, 0x7F,
+    0x08, 0x60, 0x0C, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x60, 0x0C, 0x01, 0x80, 0x01, 0x0A, 0x1F,
+    0x06, 0x30, 0xC6, 0x18, 0xC1, 0xF0, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x83, 0xE0, 0x01, 0x0A, 0x1E,
+    0x06, 0x60, 0xC6, 0x18, 0xC3, 0x38, 0x3B, 0x00, 0x60, 0x18, 0x07, 0x07, 0x80, 0x04, 0x07, 0x0C,
+    0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x18, 0x03, 0x00, 0x04, 0x09, 0x03, 0x00, 0x60, 0x00, 0x00,
+    0x00, 0x00, 0x0C, 0x01, 0x00, 0x40, 0x08, 0x00, 0x02, 0x09, 0x00, 0xC0, 0x60, 0x10, 0x0C, 0x06,
+    0x00, 0x30, 0x01, 0x00, 0x18, 0x00, 0xC0, 0x05, 0x03, 0x7F, 0xC0, 0x01, 0xFF, 0x00, 0x02, 0x09,
+    0x60, 0x03, 0x00, 0x10, 0x01, 0x80, 0x0C, 0x06, 0x01, 0x00, 0xC0, 0x60, 0x00, 0x02, 0x09, 0x1F,
+    0x06, 0x30, 0xC6, 0x00, 0xC0, 0x70, 0x18, 0x03, 0x00, 0x00, 0x0C, 0x00, 0x01, 0x0B, 0x0E, 0x02,
+    0x20, 0x84, 0x10, 0x82, 0x70, 0x52, 0x0A, 0x41, 0x38, 0x20, 0x02, 0x20, 0x38, 0x00, 0x02, 0x09,
+    0x3F, 0x01, 0xE0, 0x24, 0x0C, 0xC1, 0x98, 0x3F, 0x0C, 0x31, 0x86, 0x79, 0xE0, 0x02, 0x09, 0x7F,
+    0x06, 0x30, 0xC6, 0x18, 0xC3, 0xF0, 0x63, 0x0C, 0x61, 0x8C, 0x7F, 0x00, 0x02, 0x09, 0x1F, 0x46,
+    0x19, 0x81, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x11, 0x84, 0x1F, 0x00, 0x02, 0x09, 0x7F, 0x06, 0x30,
+    0xC3, 0x18, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x8C, 0x7F, 0x00, 0x02, 0x09, 0x7F, 0x86, 0x10, 0xC2,
+    0x19, 0x03, 0xE0, 0x64, 0x0C, 0x21, 0x84, 0x7F, 0x80, 0x02, 0x09, 0x7F, 0xC6, 0x08, 0xC1, 0x19,
+    0x03, 0xE0, 0x64, 0x0C, 0x01, 0x80, 0x7C, 0x00, 0x02, 0x09, 0x1E, 0x86, 0x31, 0x82, 0x30, 0x06,
+    0x00, 0xCF, 0x98, 0x61, 0x8C, 0x1F, 0x00, 0x02, 0x09, 0x7B, 0xC6, 0x30, 0xC6, 0x18, 0xC3, 0xF8,
+    0x63, 0x0C, 0x61, 0x8C, 0x7B, 0xC0, 0x02, 0x09, 0x3F, 0xC0, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C,
+    0x01, 0x80, 0x30, 0x3F, 0xC0, 0x02, 0x09, 0x1F, 0xC0, 0x60, 0x0C, 0x01, 0x80, 0x30, 0xC6, 0x18,
+    0xC3, 0x18, 0x3E, 0x00, 0x02, 0x09, 0x7B, 0xC6, 0x30, 0xCC, 0x1B, 0x03, 0xC0, 0x7C, 0x0C, 0xC1,
+    0x8C, 0x79, 0xC0, 0x02, 0x09, 0x7E, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x86, 0x10, 0xC2,
+    0x7F, 0xC0, 0x02, 0x09, 0xE0, 0xEC, 0x19, 0xC7, 0x3D, 0xE6, 0xAC, 0xDD, 0x99, 0x33, 0x06, 0xFB,
+    0xE0, 0x02, 0x09, 0x73, 0xC6, 0x30, 0xE6, 0x1E, 0xC3, 0x58, 0x6F, 0x0C, 0xE1, 0x8C, 0x79, 0x80,
+    0x02, 0x09, 0x1F, 0x06, 0x31, 0x83, 0x30, 0x66, 0x0C, 0xC1, 0x98, 0x31, 0x8C, 0x1F, 0x00, 0x02,
+    0x09, 0x7F, 0x06, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x7E, 0x0C, 0x01, 0x80, 0x7E, 0x00, 0x02, 0x0B,
+    0x1F, 0x06, 0x31, 0x83, 0x30, 0x66, 0x0C, 0xC1, 0x98, 0x31, 0x8C, 0x1F, 0x01, 0x98, 0x7E, 0x00,
+    0x02, 0x09, 0x7F, 0x06, 0x30, 0xC6, 0x18, 0xC3, 0xE0, 0x66, 0x0C, 0x61, 0x8C, 0x7C, 0xE0, 0x02,
+    0x09, 0x1F, 0x86, 0x30, 0xC6, 0x1C, 0x01, 0xF0, 0x07, 0x0C, 0x61, 0x8C, 0x3F, 0x00, 0x02, 0x09,
+    0x7F, 0x89, 0x91, 0x32, 0x26, 0x40, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x3F, 0x00, 0x02, 0x09, 0x7B,
+    0xC6, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0x0C, 0x61, 0x8C, 0x1F, 0x00, 0x02, 0x09, 0x7B, 0xC6,
+    0x30, 0xC6, 0x0D, 0x81, 0xB0, 0x36, 0x02, 0x80, 0x70, 0x0E, 0x00, 0x02, 0x09, 0xFB, 0xEC, 0x19,
+    0x93, 0x37, 0x66, 0xEC, 0x55, 0x0E, 0xE1, 0xDC, 0x31, 0x80, 0x02, 0x09, 0x7B, 0xC6, 0x30, 0x6C,
+    0x07, 0x00, 0xE0, 0x1C, 0x06, 0xC1, 0x8C, 0x7B, 0xC0, 0x02, 0x09, 0x79, 0xE6, 0x18, 0x66, 0x07,
+    0x80, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x1F, 0x80, 0x02, 0x09, 0x3F, 0x84, 0x30, 0x8C, 0x03, 0x00,
+    0x40, 0x18, 0x06, 0x21, 0x84, 0x3F, 0x80, 0x01, 0x0C, 0x07, 0x80, 0xC0, 0x18, 0x03, 0x00, 0x60,
+    0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0xC0, 0x00, 0x0D, 0x30, 0x06, 0x00, 0x60,
+    0x0C, 0x00, 0xC0, 0x18, 0x01, 0x80, 0x18, 0x03, 0x00, 0x30, 0x06, 0x00, 0x60, 0x0C, 0x01, 0x0C,
+    0x1E, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x0F,
+    0x00, 0x00, 0x06, 0x04, 0x01, 0x40, 0x28, 0x08, 0x82, 0x08, 0x41, 0x00, 0x0F, 0x01, 0xFF, 0xE0,
+    0x00, 0x03, 0x08, 0x00, 0x80, 0x08, 0x00, 0x04, 0x07, 0x1F, 0x00, 0x30, 0x06, 0x0F, 0xC3, 0x18,
+    0x67, 0x07, 0x70, 0x01, 0x0A, 0x70, 0x06, 0x00, 0xC0, 0x1B, 0x83, 0x98, 0x61, 0x8C, 0x31, 0x86,
+    0x39, 0x8E, 0xE0, 0x04, 0x07, 0x1E, 0x86, 0x31, 0x82, 0x30, 0x06, 0x08, 0x63, 0x07, 0xC0, 0x01,
+    0x0A, 0x03, 0x80, 0x30, 0x06, 0x0E, 0xC3, 0x38, 0xC3, 0x18, 0x63, 0x0C, 0x33, 0x83, 0xB8, 0x04,
+    0x07, 0x1F, 0x06, 0x31, 0x83, 0x3F, 0xE6, 0x00, 0x61, 0x87, 0xE0, 0x01, 0x0A, 0x07, 0xE1, 0x80,
+    0x30, 0x1F, 0xC0, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x07, 0xF0, 0x04, 0x0A, 0x1D, 0xC6, 0x71,
+    0x86, 0x30, 0xC6, 0x18, 0x67, 0x07, 0x60, 0x0C, 0x01, 0x83, 0xE0, 0x01, 0x0A, 0x70, 0x06, 0x00,
+    0xC0, 0x1B, 0x83, 0x98, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x8F, 0x78, 0x01, 0x0A, 0x06, 0x00, 0xC0,
+    0x00, 0x0F, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x07, 0xF8, 0x01, 0x0D, 0x06, 0x00, 0xC0,
+    0x00, 0x1F, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x83, 0xE0, 0x01,
+    0x0A, 0x70, 0x06, 0x00, 0xC0, 0x1B, 0xC3, 0x60, 0x78, 0x0F, 0x01, 0xB0, 0x33, 0x0E, 0xF8, 0x01,
+    0x0A, 0x1E, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x07, 0xF8, 0x04,
+    0x07, 0x7F, 0x86, 0xD8, 0xDB, 0x1B, 0x63, 0x6C, 0x6D, 0x9D, 0xB8, 0x04, 0x07, 0x77, 0x07, 0x30,
+    0xC6, 0x18, 0xC3, 0x18, 0x63, 0x1E, 0xF0, 0x04, 0x07, 0x1F, 0x06, 0x31, 0x83, 0x30, 0x66, 0x0C,
+    0x63, 0x07, 0xC0, 0x04, 0x0A, 0x77, 0x07, 0x30, 0xC3, 0x18, 0x63, 0x0C, 0x73, 0x0D, 0xC1, 0x80,
+    0x30, 0x0F, 0x80, 0x04, 0x0A, 0x1D, 0xC6, 0x71, 0x86, 0x30, 0xC6, 0x18, 0x67, 0x07, 0x60, 0x0C,
+    0x01, 0x80, 0xF8, 0x04, 0x07, 0x7B, 0x83, 0x98, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x1F, 0xC0, 0x04,
+    0x07, 0x1F, 0x86, 0x30, 0xF0, 0x0F, 0x80, 0x38, 0x63, 0x0F, 0xC0, 0x01, 0x0A, 0x18, 0x03, 0x00,
+    0x60, 0x3F, 0x81, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x81, 0xE0, 0x04, 0x07, 0x73, 0x86, 0x30,
+    0xC6, 0x18, 0xC3, 0x18, 0x67, 0x07, 0x70, 0x04, 0x07, 0x7B, 0xC6, 0x30, 0xC6, 0x0D, 0x81, 0xB0,
+    0x1C, 0x03, 0x80, 0x04, 0x07, 0xF1, 0xEC, 0x19, 0x93, 0x37, 0x63, 0xB8, 0x77, 0x0C, 0x60, 0x04,
+    0x07, 0x7B, 0xC3, 0x60, 0x38, 0x07, 0x00, 0xE0, 0x36, 0x1E, 0xF0, 0x04, 0x0A, 0x79, 0xE6, 0x18,
+    0x66, 0x0C, 0xC0, 0xB0, 0x1E, 0x01, 0x80, 0x30, 0x0C, 0x07, 0xC0, 0x04, 0x07, 0x3F, 0x84, 0x30,
+    0x0C, 0x07, 0x01, 0x80, 0x61, 0x0F, 0xE0, 0x01, 0x0C, 0x06, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0,
+    0x18, 0x06, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x03, 0x00, 0x01, 0x0C, 0x06, 0x00, 0xC0, 0x18,
+    0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x01, 0x0C, 0x0C,
+    0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x00, 0xC0, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x06, 0x00,
+    0x05, 0x03, 0x18, 0x04, 0x90, 0x0C, 0x00,
+};
+
+static const uint16_t font_16_offsets[] = {
+    0, 2, 18, 27, 45, 65, 81, 96, 105, 124, 143, 155,
+    167, 176, 180, 185, 205, 221, 237, 253, 269, 285, 301, 317,
+    333, 349, 365, 377, 392, 407, 414, 429, 444, 462, 477, 492,
+    507, 522, 537, 552, 567, 582, 597, 612, 627, 642, 657, 672,
+    687, 702, 720, 735, 750, 765, 780, 795, 810, 825, 840, 855,
+    874, 894, 913, 924, 928, 935, 947, 963, 975, 991, 1003, 1019,
+    1035, 1051, 1067, 1087, 1103, 1119, 1131, 1143, 1155, 1171, 1187, 1199,
+    1211, 1227, 1239, 1251, 1263, 1275, 1291, 1303, 1322, 1341, 1360,
+};
+
+static const epaper_packed_font_t font_16_packed = {
+    font_16_glyphs,
+    font_16_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_16 = {
+    11, /* width */
+    16, /* height */
+    NULL,
+    &font_16_packed,
+};
+
+/* 14x20, 3800 bytes unpacked */
+static const uint8_t font_20_glyphs[] = {
+    0x00, 0x00, 0x01, 0x0D, 0x07, 0x00, 0x1C, 0x00, 0x70, 0x01, 0xC0, 0x07, 0x00, 0x1C, 0x00, 0x70,
+    0x00, 0x80, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0xC0, 0x07, 0x00, 0x02, 0x06, 0x1C, 0xE0, 0x73,
+    0x81, 0xCE, 0x02, 0x10, 0x08, 0x40, 0x21, 0x00, 0x00, 0x10, 0x0C, 0xC0, 0x33, 0x00, 0xCC, 0x03,
+    0x30, 0x0C, 0xC0, 0xFF, 0xC3, 0xFF, 0x03, 0x30, 0x0C, 0xC0, 0xFF, 0xC3, 0xFF, 0x03, 0x30, 0x0C,
+    0xC0, 0x33, 0x00, 0xCC, 0x03, 0x30, 0x00, 0x10, 0x03, 0x00, 0x0C, 0x00, 0x7E, 0x03, 0xF8, 0x18,
+    0x60, 0x60, 0x01, 0xF0, 0x03, 0xF0, 0x00, 0xE0, 0x61, 0x81, 0x86, 0x07, 0xF0, 0x1F, 0x80, 0x0C,
+    0x00, 0x30, 0x00, 0xC0, 0x01, 0x0D, 0x1C, 0x00, 0x88, 0x02, 0x20, 0x08, 0x80, 0x1C, 0x60, 0x07,
+    0x80, 0xF8, 0x0F, 0x00, 0x31, 0xC0, 0x08, 0x80, 0x22, 0x00, 0x88, 0x01, 0xC0, 0x03, 0x0B, 0x03,
+    0xE0, 0x3F, 0x80, 0xC0, 0x03, 0x00, 0x06, 0x00, 0x3C, 0xC1, 0xFF, 0x06, 0x78, 0x18, 0xC0, 0x7F,
+    0xC0, 0x7B, 0x00, 0x02, 0x06, 0x03, 0x80, 0x0E, 0x00, 0x38, 0x00, 0x40, 0x01, 0x00, 0x04, 0x00,
+    0x01, 0x10, 0x00, 0xC0, 0x03, 0x00, 0x18, 0x00, 0x60, 0x01, 0x80, 0x0C, 0x00, 0x30, 0x00, 0xC0,
+    0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0x60, 0x01, 0x80, 0x06, 0x00, 0x0C, 0x00, 0x30, 0x01, 0x10,
+    0x0C, 0x00, 0x30, 0x00, 0x60, 0x01, 0x80, 0x06, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00,
+    0x0C, 0x00, 0x30, 0x01, 0x80, 0x06, 0x00, 0x18, 0x00, 0xC0, 0x03, 0x00, 0x01, 0x09, 0x03, 0x00,
+    0x0C, 0x00, 0x30, 0x06, 0xD8, 0x1F, 0xE0, 0x1E, 0x00, 0x78, 0x03, 0xF0, 0x0C, 0xC0, 0x03, 0x0A,
+    0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x3F, 0xF0, 0xFF, 0xC0, 0x30, 0x00, 0xC0, 0x03, 0x00,
+    0x0C, 0x00, 0x0B, 0x06, 0x03, 0x80, 0x0C, 0x00, 0x30, 0x01, 0x80, 0x06, 0x00, 0x10, 0x00, 0x07,
+    0x02, 0x3F, 0xE0, 0xFF, 0x80, 0x0B, 0x03, 0x03, 0x80, 0x0E, 0x00, 0x38, 0x00, 0x00, 0x10, 0x00,
+    0x60, 0x01, 0x80, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x06, 0x00, 0x18, 0x00, 0xC0, 0x03, 0x00, 0x18,
+    0x00, 0x60, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x01, 0x80, 0x06, 0x00, 0x01, 0x0D, 0x0F, 0x80, 0x7F,
+    0x01, 0x8C, 0x0C, 0x18, 0x30, 0x60, 0xC1, 0x83, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC1, 0x81, 0x8C,
+    0x07, 0xF0, 0x0F, 0x80, 0x01, 0x0D, 0x03, 0x00, 0x7C, 0x01, 0xF0, 0x00, 0xC0, 0x03, 0x00, 0x0C,
+    0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x07, 0xF8, 0x1F, 0xE0, 0x01, 0x0D, 0x0F,
+    0x80, 0x7F, 0x03, 0x8E, 0x0C, 0x18, 0x00, 0x60, 0x03, 0x00, 0x18, 0x00, 0xC0, 0x06, 0x00, 0x30,
+    0x01, 0x80, 0x0F, 0xF8, 0x3F, 0xE0, 0x01, 0x0D, 0x0F, 0x80, 0xFF, 0x03, 0x0E, 0x00, 0x18, 0x00,
+    0xE0, 0x1F, 0x00, 0x7C, 0x00, 0x38, 0x00, 0x60, 0x01, 0x86, 0x0E, 0x1F, 0xF0, 0x3F, 0x80, 0x01,
+    0x0D, 0x01, 0xC0, 0x0F, 0x00, 0x3C, 0x01, 0xB0, 0x0C, 0xC0, 0x33, 0x01, 0x8C, 0x0C, 0x30, 0x3F,
+    0xE0, 0xFF, 0x80, 0x0C, 0x00, 0xF8, 0x03, 0xE0, 0x01, 0x0D, 0x1F, 0xC0, 0x7F, 0x01, 0x80, 0x06,
+    0x00, 0x1F, 0x80, 0x7F, 0x01, 0x8E, 0x00, 0x18, 0x00, 0x60, 0x01, 0x83, 0x0E, 0x0F, 0xF0, 0x1F,
+    0x80, 0x01, 0x0D, 0x03, 0xE0, 0x3F, 0x81, 0xE0, 0x06, 0x00, 0x38, 0x00, 0xDE, 0x03, 0xFC, 0x0E,
+    0x38, 0x30, 0x60, 0xC1, 0x81, 0x8E, 0x07, 0xF0, 0x07, 0x80, 0x01, 0x0D, 0x3F, 0xE0, 0xFF, 0x83,
+    0x06, 0x00, 0x18, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x60, 0x01, 0x80, 0x06, 0x00, 0x30, 0x00,
+    0xC0, 0x03, 0x00, 0x01, 0x0D, 0x0F, 0x80, 0x7F, 0x03, 0x8E, 0x0C, 0x18, 0x38, 0xE0, 0x7F, 0x01,
+    0xFC, 0x0E, 0x38, 0x30, 0x60, 0xC1, 0x83, 0x8E, 0x07, 0xF0, 0x0F, 0x80, 0x01, 0x0D, 0x0F, 0x00,
+    0x7F, 0x03, 0x8C, 0x0C, 0x18, 0x30, 0x60, 0xE3, 0x81, 0xFE, 0x03, 0xD8, 0x00, 0xE0, 0x03, 0x00,
+    0x3C, 0x0F, 0xE0, 0x3E, 0x00, 0x05, 0x09, 0x03, 0x80, 0x0E, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x38, 0x00, 0xE0, 0x03, 0x80, 0x05, 0x0B, 0x01, 0xC0, 0x07, 0x00, 0x1C, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0xC0, 0x06, 0x00, 0x18, 0x00, 0x40, 0x00, 0x03, 0x0B, 0x00,
+    0x30, 0x03, 0xC0, 0x3C, 0x01, 0xC0, 0x1C, 0x01, 0xE0, 0x01, 0xC0, 0x01, 0xC0, 0x03, 0xC0, 0x03,
+    0xC0, 0x03, 0x00, 0x05, 0x06, 0x7F, 0xF1, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x7F, 0xF1, 0xFF, 0xC0,
+    0x03, 0x0B, 0x30, 0x00, 0xF0, 0x00, 0xF0, 0x00, 0xE0, 0x00, 0xE0, 0x01, 0xE0, 0x0E, 0x00, 0xE0,
+    0x0F, 0x00, 0xF0, 0x03, 0x00, 0x00, 0x02, 0x0C, 0x0F, 0x80, 0x7F, 0x01, 0x86, 0x06, 0x18, 0x00,
+    0x60, 0x07, 0x00, 0x38, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x70, 0x01, 0xC0, 0x01, 0x0E, 0x03,
+    0x80, 0x32, 0x00, 0x84, 0x04, 0x10, 0x10, 0x40, 0x47, 0x01, 0x24, 0x04, 0x90, 0x12, 0x40, 0x47,
+    0x01, 0x00, 0x02, 0x00, 0x08, 0x40, 0x1E, 0x00, 0x02, 0x0C, 0x1F, 0x80, 0x7E, 0x00, 0x38, 0x01,
+    0xB0, 0x06, 0xC0, 0x33, 0x00, 0xC6, 0x07, 0xF8, 0x1F, 0xE0, 0xC0, 0xC7, 0x87, 0x9E, 0x1E, 0x02,
+    0x0C, 0x3F, 0x80, 0xFF, 0x01, 0x86, 0x06, 0x18, 0x18, 0xE0, 0x7F, 0x01, 0xFE, 0x06, 0x1C, 0x18,
+    0x30, 0x60, 0xC3, 0xFF, 0x0F, 0xF8, 0x02, 0x0C, 0x07, 0xB0, 0x3F, 0xC1, 0xC7, 0x0E, 0x0C, 0x30,
+    0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x38, 0x30, 0x71, 0xC0, 0xFE, 0x01, 0xF0, 0x02, 0x0C, 0x7F,
+    0x81, 0xFF, 0x03, 0x0E, 0x0C, 0x1C, 0x30, 0x30, 0xC0, 0xC3, 0x03, 0x0C, 0x0C, 0x30, 0x70, 0xC3,
+    0x87, 0xFC, 0x1F, 0xE0, 0x02, 0x0C, 0x3F, 0xF0, 0xFF, 0xC1, 0x83, 0x06, 0x0C, 0x19, 0x80, 0x7E,
+    0x01, 0xF8, 0x06, 0x60, 0x18, 0x30, 0x60, 0xC3, 0xFF, 0x0F, 0xFC, 0x02, 0x0C, 0x3F, 0xF0, 0xFF,
+    0xC1, 0x83, 0x06, 0x0C, 0x19, 0x80, 0x7E, 0x01, 0xF8, 0x06, 0x60, 0x18, 0x00, 0x60, 0x03, 0xF0,
+    0x0F, 0xC0, 0x02, 0x0C, 0x07, 0xB0, 0x7F, 0xC1, 0x87, 0x0C, 0x0C, 0x30, 0x00, 0xC0, 0x03, 0x1F,
+    0x8C, 0x7E, 0x30, 0x30, 0x60, 0xC1, 0xFF, 0x01, 0xF0, 0x02, 0x0C, 0x3C, 0xF0, 0xF3, 0xC1, 0x86,
+    0x06, 0x18, 0x18, 0x60, 0x7F, 0x81, 0xFE, 0x06, 0x18, 0x18, 0x60, 0x61, 0x83, 0xCF, 0x0F, 0x3C,
+    0x02, 0x0C, 0x1F, 0xE0, 0x7F, 0x80, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0,
+    0x03, 0x00, 0x0C, 0x01, 0xFE, 0x07, 0xF8, 0x02, 0x0C, 0x03, 0xF8, 0x0F, 0xE0, 0x06, 0x00, 0x18,
+    0x00, 0x60, 0x01, 0x83, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC3, 0x83, 0xFC, 0x03, 0xE0, 0x02, 0x0C,
+    0x3E, 0xF8, 0xFB, 0xE1, 0x8E, 0x06, 0x60, 0x1B, 0x00, 0x7C, 0x01, 0xD8, 0x06, 0x30, 0x18, 0xC0,
+    0x61, 0x83, 0xE7, 0x8F, 0x8E, 0x02, 0x0C, 0x3F, 0x00, 0xFC, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00,
+    0x30, 0x00, 0xC0, 0x03, 0x0C, 0x0C, 0x30, 0x30, 0xC3, 0xFF, 0x0F, 0xFC, 0x02, 0x0C, 0x78, 0x79,
+    0xE1, 0xE3, 0x87, 0x0F, 0x3C, 0x34, 0xB0, 0xDE, 0xC3, 0x7B, 0x0C, 0xCC, 0x33, 0x30, 0xC0, 0xC7,
+    0xCF, 0x9F, 0x3E, 0x02, 0x0C, 0x39, 0xF0, 0xF7, 0xC1, 0xC6, 0x07, 0x98, 0x1E, 0x60, 0x6D, 0x81,
+    0xB6, 0x06, 0x78, 0x19, 0xE0, 0x63, 0x83, 0xEE, 0x0F, 0x98, 0x02, 0x0C, 0x07, 0x80, 0x3F, 0x01,
+    0xCE, 0x0E, 0x1C, 0x30, 0x30, 0xC0, 0xC3, 0x03, 0x0C, 0x0C, 0x38, 0x70, 0x73, 0x80, 0xFC, 0x01,
+    0xE0, 0x02, 0x0C, 0x3F, 0xC0, 0xFF, 0x81, 0x87, 0x06, 0x0C, 0x18, 0x30, 0x61, 0xC1, 0xFE, 0x07,
+    0xF0, 0x18, 0x00, 0x60, 0x03, 0xF0, 0x0F, 0xC0, 0x02, 0x0F, 0x07, 0x80, 0x3F, 0x01, 0xCE, 0x0E,
+    0x1C, 0x30, 0x30, 0xC0, 0xC3, 0x03, 0x0C, 0x0C, 0x38, 0x70, 0x73, 0x80, 0xFC, 0x01, 0xE0, 0x07,
+    0xB0, 0x3F, 0xC0, 0xCE, 0x00, 0x02, 0x0C, 0x3F, 0xC0, 0xFF, 0x81, 0x87, 0x06, 0x0C, 0x18, 0x70,
+    0x7F, 0x81, 0xFC, 0x06, 0x38, 0x18, 0x60, 0x61, 0xC3, 0xE3, 0x8F, 0x86, 0x02, 0x0C, 0x0F, 0xB0,
+    0x7F, 0xC3, 0x87, 0x0C, 0x0C, 0x38, 0x00, 0x7E, 0x00, 0x7E, 0x00, 0x1C, 0x30, 0x30, 0xE1, 0xC3,
+    0xFE, 0x0D, 0xF0, 0x02, 0x0C, 0x3F, 0xF0, 0xFF, 0xC3, 0x33, 0x0C, 0xCC, 0x33, 0x30, 0x0C, 0x00,
+    0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0xFC, 0x03, 0xF0, 0x02, 0x0C, 0x3C, 0xF0, 0xF3, 0xC1,
+    0x86, 0x06, 0x18, 0x18, 0x60, 0x61, 0x81, 0x86, 0x06, 0x18, 0x18, 0x60, 0x73, 0x80, 0xFC, 0x01,
+    0xE0, 0x02, 0x0C, 0x78, 0xF1, 0xE3, 0xC3, 0x06, 0x0C, 0x18, 0x18, 0xC0, 0x63, 0x00, 0xD8, 0x03,
+    0x60, 0x0D, 0x80, 0x1C, 0x00, 0x70, 0x01, 0xC0, 0x02, 0x0C, 0x7C, 0x7D, 0xF1, 0xF3, 0x01, 0x8C,
+    0xE6, 0x33, 0x98, 0xCE, 0x63, 0x6D, 0x85, 0xB4, 0x1C, 0x70, 0x71, 0xC1, 0xC7, 0x06, 0x0C, 0x02,
+    0x0C, 0x78, 0xF1, 0xE3, 0xC3, 0x06, 0x06, 0x30, 0x0D, 0x80, 0x1C, 0x00, 0x70, 0x03, 0x60, 0x18,
+    0xC0, 0xC1, 0x87, 0x8F, 0x1E, 0x3C, 0x02, 0x0C, 0x3C, 0xF0, 0xF3, 0xC1, 0x86, 0x03, 0x30, 0x07,
+    0x80, 0x1E, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0xFC, 0x03, 0xF0, 0x02, 0x0C, 0x1F,
+    0xE0, 0x7F, 0x81, 0x86, 0x06, 0x30, 0x01, 0x80, 0x0C, 0x00, 0x30, 0x01, 0x80, 0x0C, 0x60, 0x61,
+    0x81, 0xFE, 0x07, 0xF8, 0x01, 0x10, 0x03, 0xC0, 0x0F, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C,
+    0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x3C,
+    0x00, 0xF0, 0x00, 0x10, 0x18, 0x00, 0x60, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x60,
+    0x00, 0xC0, 0x03, 0x00, 0x06, 0x00, 0x18, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x06, 0x00, 0x18,
+    0x01, 0x10, 0x0F, 0x00, 0x3C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0,
+    0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0xF0, 0x03, 0xC0, 0x01, 0x06,
+    0x02, 0x00, 0x1C, 0x00, 0xD8, 0x06, 0x30, 0x30, 0x60, 0x80, 0x80, 0x12, 0x02, 0xFF, 0xFF, 0xFF,
+    0xF0, 0x01, 0x03, 0x04, 0x00, 0x0C, 0x00, 0x08, 0x00, 0x05, 0x09, 0x0F, 0xC0, 0x7F, 0x80, 0x06,
+    0x03, 0xF8, 0x1F, 0xE0, 0xE1, 0x83, 0x0E, 0x0F, 0xFC, 0x1F, 0x70, 0x01, 0x0D, 0x70, 0x01, 0xC0,
+    0x03, 0x00, 0x0C, 0x00, 0x37, 0x80, 0xFF, 0x83, 0x86, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC3, 0x86,
+    0x1F, 0xF8, 0x77, 0x80, 0x05, 0x09, 0x07, 0xB0, 0x7F, 0xC1, 0x83, 0x0C, 0x0C, 0x30, 0x00, 0xC0,
+    0x03, 0x83, 0x07, 0xFC, 0x0F, 0xC0, 0x01, 0x0D, 0x00, 0x70, 0x01, 0xC0, 0x03, 0x00, 0x0C, 0x07,
+    0xB0, 0x7F, 0xC1, 0x87, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC3, 0x87, 0x07, 0xFE, 0x07, 0xB8, 0x05,
+    0x09, 0x07, 0x80, 0x7F, 0x81, 0x86, 0x0F, 0xFC, 0x3F, 0xF0, 0xC0, 0x01, 0x83, 0x07, 0xFC, 0x07,
+    0xC0, 0x01, 0x0D, 0x03, 0xF0, 0x1F, 0xC0, 0x60, 0x01, 0x80, 0x1F, 0xE0, 0x7F, 0x80, 0x60, 0x01,
+    0x80, 0x06, 0x00, 0x18, 0x00, 0x60, 0x07, 0xF8, 0x1F, 0xE0, 0x05, 0x0D, 0x07, 0xB8, 0x7F, 0xE1,
+    0x87, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC1, 0x87, 0x07, 0xFC, 0x07, 0xB0, 0x00, 0xC0, 0x07, 0x03,
+    0xF8, 0x0F, 0xC0, 0x01, 0x0D, 0x38, 0x00, 0xE0, 0x01, 0x80, 0x06, 0x00, 0x1B, 0xC0, 0x7F, 0x81,
+    0xC6, 0x06, 0x18, 0x18, 0x60, 0x61, 0x81, 0x86, 0x0F, 0x3C, 0x3C, 0xF0, 0x01, 0x0D, 0x03, 0x00,
+    0x0C, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x7C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00,
+    0x30, 0x07, 0xF8, 0x1F, 0xE0, 0x01, 0x11, 0x03, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xC0,
+    0x7F, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00,
+    0x1C, 0x0F, 0xE0, 0x3F, 0x00, 0x01, 0x0D, 0x38, 0x00, 0xE0, 0x01, 0x80, 0x06, 0x00, 0x1B, 0xE0,
+    0x6F, 0x81, 0xB0, 0x07, 0x80, 0x1E, 0x00, 0x6C, 0x01, 0x98, 0x0E, 0x7C, 0x39, 0xF0, 0x01, 0x0D,
+    0x1F, 0x00, 0x7C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00,
+    0x0C, 0x00, 0x30, 0x07, 0xF8, 0x1F, 0xE0, 0x05, 0x09, 0x7E, 0xE1, 0xFF, 0xC3, 0x33, 0x0C, 0xCC,
+    0x33, 0x30, 0xCC, 0xC3, 0x33, 0x1E, 0xEE, 0x7B, 0xB8, 0x05, 0x09, 0x3B, 0xC0, 0xFF, 0x81, 0xC6,
+    0x06, 0x18, 0x18, 0x60, 0x61, 0x81, 0x86, 0x0F, 0x3C, 0x3C, 0xF0, 0x05, 0x09, 0x07, 0x80, 0x7F,
+    0x81, 0x86, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC1, 0x86, 0x07, 0xF8, 0x07, 0x80, 0x05, 0x0D, 0x77,
+    0x81, 0xFF, 0x83, 0x86, 0x0C, 0x0C, 0x30, 0x30, 0xC0, 0xC3, 0x86, 0x0F, 0xF8, 0x37, 0x80, 0xC0,
+    0x03, 0x00, 0x1F, 0x00, 0x7C, 0x00, 0x05, 0x0D, 0x07, 0xB8, 0x7F, 0xE1, 0x87, 0x0C, 0x0C, 0x30,
+    0x30, 0xC0, 0xC1, 0x87, 0x07, 0xFC, 0x07, 0xB0, 0x00, 0xC0, 0x03, 0x00, 0x3E, 0x00, 0xF8, 0x05,
+    0x09, 0x3C, 0xE0, 0xF7, 0xC0, 0xF3, 0x03, 0x80, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x0F, 0xF0, 0x3F,
+    0xC0, 0x05, 0x09, 0x07, 0xE0, 0x7F, 0x81, 0x86, 0x07, 0x80, 0x0F, 0xC0, 0x07, 0x81, 0x86, 0x07,
+    0xF8, 0x1F, 0x80, 0x02, 0x0C, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x0F, 0xF8, 0x3F, 0xE0, 0x30, 0x00,
+    0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0xC0, 0xFF, 0x01, 0xF0, 0x05, 0x09, 0x38, 0xE0, 0xE3, 0x81,
+    0x86, 0x06, 0x18, 0x18, 0x60, 0x61, 0x81, 0x8E, 0x07, 0xFC, 0x0F, 0x70, 0x05, 0x09, 0x78, 0xF1,
+    0xE3, 0xC3, 0x06, 0x06, 0x30, 0x18, 0xC0, 0x36, 0x00, 0xD8, 0x01, 0xC0, 0x07, 0x00, 0x05, 0x09,
+    0x78, 0xF1, 0xE3, 0xC3, 0x26, 0x0C, 0x98, 0x37, 0xE0, 0x77, 0x01, 0xDC, 0x06, 0x30, 0x18, 0xC0,
+    0x05, 0x09, 0x3C, 0xF0, 0xF3, 0xC0, 0xCC, 0x01, 0xE0, 0x03, 0x00, 0x1E, 0x00, 0xCC, 0x0F, 0x3C,
+    0x3C, 0xF0, 0x05, 0x0D, 0x78, 0xF1, 0xE3, 0xC3, 0x06, 0x06, 0x30, 0x18, 0xC0, 0x36, 0x00, 0xF8,
+    0x01, 0xC0, 0x06, 0x00, 0x18, 0x00, 0xC0, 0x1F, 0xC0, 0x7F, 0x00, 0x05, 0x09, 0x1F, 0xE0, 0x7F,
+    0x81, 0x8C, 0x00, 0x60, 0x03, 0x00, 0x18, 0x00, 0xC6, 0x07, 0xF8, 0x1F, 0xE0, 0x01, 0x10, 0x01,
+    0xC0, 0x0F, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x01, 0xC0, 0x0E, 0x00, 0x1C,
+    0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x3C, 0x00, 0x70, 0x01, 0x10, 0x03, 0x00, 0x0C,
+    0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30,
+    0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x30, 0x00, 0xC0, 0x01, 0x10, 0x1C, 0x00, 0x78, 0x00, 0x60,
+    0x01, 0x80, 0x06, 0x00, 0x18, 0x00, 0x60, 0x01, 0xC0, 0x03, 0x80, 0x1C, 0x00, 0x60, 0x01, 0x80,
+    0x06, 0x00, 0x18, 0x01, 0xE0, 0x07, 0x00, 0x06, 0x04, 0x0E, 0x00, 0xFC, 0xC3, 0x3F, 0x00, 0x78,
+};
+
+static const uint16_t font_20_offsets[] = {
+    0, 2, 27, 40, 70, 100, 125, 147, 160, 190, 220, 238,
+    258, 271, 277, 285, 315, 340, 365, 390, 415, 440, 465, 490,
+    515, 540, 565, 583, 605, 627, 640, 662, 685, 712, 735, 758,
+    781, 804, 827, 850, 873, 896, 919, 942, 965, 988, 1011, 1034,
+    1057, 1080, 1109, 1132, 1155, 1178, 1201, 1224, 1247, 1270, 1293, 1316,
+    1346, 1376, 1406, 1419, 1425, 1433, 1451, 1476, 1494, 1519, 1537, 1562,
+    1587, 1612, 1637, 1669, 1694, 1719, 1737, 1755, 1773, 1798, 1823, 1841,
+    1859, 1882, 1900, 1918, 1936, 1954, 1979, 1997, 2027, 2057, 2087,
+};
+
+static const epaper_packed_font_t font_20_packed = {
+    font_20_glyphs,
+    font_20_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_20 = {
+    14, /* width */
+    20, /* height */
+    NULL,
+    &font_20_packed,
+};
+
+/* 17x24, 6840 bytes unpacked */
+static const uint8_t font_24_glyphs[] = {
+    0x00, 0x00, 0x02, 0x0F, 0x03, 0x80, 0x01, 0xC0, 0x00, 0xE0, 0x00, 0x70, 0x00, 0x38, 0x00, 0x1C,
+    0x00, 0x0E, 0x00, 0x07, 0x00, 0x03, 0x80, 0x00, 0x80, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x1C, 0x00, 0x0E, 0x00, 0x03, 0x07, 0x0E, 0x70, 0x07, 0x38, 0x03, 0x9C, 0x00, 0x84, 0x00, 0x42,
+    0x00, 0x21, 0x00, 0x10, 0x80, 0x02, 0x10, 0x06, 0x60, 0x03, 0x30, 0x01, 0x98, 0x00, 0xCC, 0x00,
+    0x66, 0x01, 0xFF, 0xC0, 0xFF, 0xE0, 0x0C, 0xC0, 0x0C, 0xC0, 0x1F, 0xFC, 0x0F, 0xFE, 0x01, 0x98,
+    0x00, 0xCC, 0x00, 0x66, 0x00, 0x33, 0x00, 0x19, 0x80, 0x01, 0x13, 0x01, 0x80, 0x00, 0xC0, 0x01,
+    0xEC, 0x01, 0xFE, 0x01, 0x87, 0x00, 0xC3, 0x80, 0x70, 0x00, 0x1F, 0x00, 0x07, 0xE0, 0x00, 0x78,
+    0x06, 0x0C, 0x03, 0x86, 0x01, 0xC7, 0x00, 0xFF, 0x00, 0x6F, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00,
+    0xC0, 0x00, 0x60, 0x00, 0x02, 0x0F, 0x07, 0x80, 0x07, 0xE0, 0x07, 0x38, 0x03, 0x0C, 0x01, 0x86,
+    0x00, 0xE7, 0x00, 0x3F, 0xE0, 0x0F, 0xC0, 0x1F, 0xF0, 0x03, 0x9C, 0x01, 0x86, 0x00, 0xC3, 0x00,
+    0x73, 0x80, 0x1F, 0x80, 0x07, 0x80, 0x04, 0x0D, 0x03, 0xF0, 0x03, 0xF8, 0x03, 0x18, 0x01, 0x80,
+    0x00, 0xC0, 0x00, 0x30, 0x00, 0x1C, 0x00, 0x1F, 0x38, 0x1D, 0xFC, 0x0C, 0x78, 0x06, 0x1C, 0x01,
+    0xFF, 0x80, 0x7D, 0xC0, 0x03, 0x07, 0x03, 0x80, 0x01, 0xC0, 0x00, 0xE0, 0x00, 0x20, 0x00, 0x10,
+    0x00, 0x08, 0x00, 0x04, 0x00, 0x02, 0x12, 0x00, 0x18, 0x00, 0x1C, 0x00, 0x1C, 0x00, 0x1E, 0x00,
+    0x0E, 0x00, 0x07, 0x00, 0x07, 0x00, 0x03, 0x80, 0x01, 0xC0, 0x00, 0xE0, 0x00, 0x70, 0x00, 0x38,
+    0x00, 0x0E, 0x00, 0x07, 0x00, 0x01, 0xC0, 0x00, 0xE0, 0x00, 0x38, 0x00, 0x0C, 0x00, 0x02, 0x12,
+    0x18, 0x00, 0x0E, 0x00, 0x03, 0x80, 0x01, 0xC0, 0x00, 0x70, 0x00, 0x38, 0x00, 0x0E, 0x00, 0x07,
+    0x00, 0x03, 0x80, 0x01, 0xC0, 0x00, 0xE0, 0x00, 0x70, 0x00, 0x70, 0x00, 0x38, 0x00, 0x3C, 0x00,
+    0x1C, 0x00, 0x1C, 0x00, 0x0C, 0x00, 0x00, 0x02, 0x0A, 0x01, 0x80, 0x00, 0xC0, 0x00, 0x60, 0x03,
+    0xB7, 0x01, 0xFF, 0x80, 0x3F, 0x00, 0x0F, 0x00, 0x07, 0x80, 0x06, 0x60, 0x03, 0x30, 0x00, 0x04,
+    0x0C, 0x01, 0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x01, 0xFF, 0xE0, 0xFF, 0xF0,
+    0x03, 0x00, 0x01, 0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x0E, 0x07, 0x00, 0xE0, 0x00,
+    0x60, 0x00, 0x70, 0x00, 0x30, 0x00, 0x18, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x09, 0x02, 0x1F, 0xF8,
+    0x0F, 0xFC, 0x00, 0x0E, 0x03, 0x03, 0xC0, 0x01, 0xE0, 0x00, 0xF0, 0x00, 0x00, 0x14, 0x00, 0x18,
+    0x00, 0x0C, 0x00, 0x0E, 0x00, 0x06, 0x00, 0x07, 0x00, 0x03, 0x00, 0x01, 0x80, 0x01, 0x80, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x60, 0x00, 0x30, 0x00, 0x30, 0x00, 0x18, 0x00, 0x1C, 0x00,
+    0x0C, 0x00, 0x0E, 0x00, 0x06, 0x00, 0x03, 0x00, 0x00, 0x02, 0x0F, 0x03, 0xC0, 0x03, 0xF0, 0x03,
+    0x0C, 0x01, 0x86, 0x01, 0x81, 0x80, 0xC0, 0xC0, 0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x0C, 0x0C,
+    0x06, 0x06, 0x01, 0x86, 0x00, 0xC3, 0x00, 0x3F, 0x00, 0x0F, 0x00, 0x02, 0x0F, 0x00, 0x80, 0x03,
+    0xC0, 0x07, 0xE0, 0x03, 0xB0, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80,
+    0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0xFF, 0xC0, 0x7F, 0xE0, 0x02, 0x0F, 0x07,
+    0xC0, 0x0F, 0xF8, 0x0E, 0x0C, 0x06, 0x03, 0x03, 0x01, 0x80, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0xC0,
+    0x01, 0xC0, 0x01, 0xC0, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0xFF, 0xC0, 0xFF, 0xE0, 0x02,
+    0x0F, 0x03, 0xC0, 0x07, 0xF0, 0x03, 0x1C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x03, 0x00, 0x0F, 0x00,
+    0x07, 0xC0, 0x00, 0x70, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x01, 0x83, 0x80, 0xFF, 0x80, 0x3F,
+    0x00, 0x02, 0x0F, 0x00, 0xE0, 0x00, 0xF0, 0x00, 0x78, 0x00, 0x6C, 0x00, 0x66, 0x00, 0x33, 0x00,
+    0x31, 0x80, 0x18, 0xC0, 0x18, 0x60, 0x18, 0x30, 0x0F, 0xFE, 0x07, 0xFF, 0x00, 0x06, 0x00, 0x1F,
+    0xC0, 0x0F, 0xE0, 0x02, 0x0F, 0x1F, 0xF0, 0x0F, 0xF8, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00,
+    0xDE, 0x00, 0x7F, 0xC0, 0x38, 0x60, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x03, 0x03,
+    0x01, 0xFF, 0x80, 0x3F, 0x00, 0x02, 0x0F, 0x00, 0xF8, 0x01, 0xFC, 0x01, 0xC0, 0x01, 0xC0, 0x00,
+    0xC0, 0x00, 0xC0, 0x00, 0x6F, 0x00, 0x3F, 0xE0, 0x1C, 0x30, 0x0C, 0x0C, 0x06, 0x06, 0x03, 0x03,
+    0x00, 0xC3, 0x80, 0x7F, 0x80, 0x0F, 0x80, 0x02, 0x0F, 0x1F, 0xF8, 0x0F, 0xFC, 0x06, 0x06, 0x03,
+    0x07, 0x00, 0x03, 0x00, 0x01, 0x80, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x70, 0x00, 0x30,
+    0x00, 0x18, 0x00, 0x1C, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x02, 0x0F, 0x07, 0xE0, 0x07, 0xF8, 0x07,
+    0x0E, 0x03, 0x03, 0x01, 0x81, 0x80, 0x61, 0x80, 0x1F, 0x80, 0x0F, 0xC0, 0x0C, 0x30, 0x0C, 0x0C,
+    0x06, 0x06, 0x03, 0x03, 0x01, 0xC3, 0x80, 0x7F, 0x80, 0x1F, 0x80, 0x02, 0x0F, 0x07, 0xC0, 0x07,
+    0xF8, 0x07, 0x0C, 0x03, 0x03, 0x01, 0x81, 0x80, 0xC0, 0xC0, 0x30, 0xE0, 0x1F, 0xF0, 0x03, 0xD8,
+    0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0E, 0x00, 0x0E, 0x00, 0xFE, 0x00, 0x7C, 0x00, 0x06, 0x0B, 0x03,
+    0xC0, 0x01, 0xE0, 0x00, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0xC0, 0x01, 0xE0, 0x00, 0xF0, 0x00, 0x06, 0x0D, 0x00, 0xF0, 0x00, 0x78, 0x00, 0x3C, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xC0, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0x60,
+    0x00, 0x60, 0x00, 0x20, 0x00, 0x04, 0x0D, 0x00, 0x1C, 0x00, 0x1E, 0x00, 0x3C, 0x00, 0x78, 0x00,
+    0xF0, 0x01, 0xE0, 0x03, 0xC0, 0x00, 0x78, 0x00, 0x0F, 0x00, 0x01, 0xE0, 0x00, 0x3C, 0x00, 0x07,
+    0x80, 0x01, 0xC0, 0x07, 0x06, 0x7F, 0xFC, 0x3F, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xC3,
+    0xFF, 0xE0, 0x04, 0x0D, 0x70, 0x00, 0x3C, 0x00, 0x07, 0x80, 0x00, 0xF0, 0x00, 0x1E, 0x00, 0x03,
+    0xC0, 0x00, 0x78, 0x00, 0xF0, 0x01, 0xE0, 0x03, 0xC0, 0x07, 0x80, 0x0F, 0x00, 0x07, 0x00, 0x00,
+    0x03, 0x0E, 0x07, 0xC0, 0x07, 0xF0, 0x06, 0x1C, 0x03, 0x06, 0x01, 0x83, 0x00, 0x03, 0x80, 0x03,
+    0x80, 0x07, 0x80, 0x03, 0x80, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x38, 0x00,
+    0x02, 0x11, 0x03, 0xE0, 0x03, 0xF8, 0x03, 0x8E, 0x01, 0x83, 0x01, 0x87, 0x80, 0xC7, 0xC0, 0x67,
+    0x60, 0x33, 0x30, 0x19, 0x98, 0x0C, 0xCC, 0x06, 0x3E, 0x03, 0x0F, 0x01, 0x80, 0x00, 0x60, 0x00,
+    0x38, 0x60, 0x0F, 0xF0, 0x03, 0xE0, 0x00, 0x03, 0x0E, 0x1F, 0x80, 0x0F, 0xE0, 0x00, 0x70, 0x00,
+    0x6C, 0x00, 0x36, 0x00, 0x31, 0x80, 0x18, 0xC0, 0x18, 0x60, 0x0F, 0xF8, 0x0F, 0xFC, 0x06, 0x03,
+    0x06, 0x01, 0x8F, 0xC7, 0xF7, 0xE3, 0xF8, 0x03, 0x0E, 0x7F, 0xE0, 0x3F, 0xF8, 0x06, 0x0E, 0x03,
+    0x03, 0x01, 0x81, 0x80, 0xC1, 0xC0, 0x7F, 0xC0, 0x3F, 0xF0, 0x18, 0x1C, 0x0C, 0x06, 0x06, 0x03,
+    0x03, 0x01, 0x87, 0xFF, 0x83, 0xFF, 0x80, 0x03, 0x0E, 0x03, 0xEC, 0x07, 0xFE, 0x07, 0x07, 0x03,
+    0x01, 0x83, 0x00, 0xC1, 0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x06, 0x03,
+    0x03, 0x83, 0x80, 0xFF, 0x80, 0x1F, 0x80, 0x03, 0x0E, 0x7F, 0xC0, 0x3F, 0xF8, 0x06, 0x0E, 0x03,
+    0x03, 0x01, 0x80, 0xC0, 0xC0, 0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x0C, 0x0C, 0x06, 0x06, 0x06,
+    0x03, 0x07, 0x07, 0xFF, 0x03, 0xFF, 0x00, 0x03, 0x0E, 0x7F, 0xF8, 0x3F, 0xFC, 0x06, 0x06, 0x03,
+    0x03, 0x01, 0x99, 0x80, 0xCC, 0x00, 0x7E, 0x00, 0x3F, 0x00, 0x19, 0x80, 0x0C, 0xCC, 0x06, 0x06,
+    0x03, 0x03, 0x07, 0xFF, 0x83, 0xFF, 0xC0, 0x03, 0x0E, 0x3F, 0xFC, 0x1F, 0xFE, 0x03, 0x03, 0x01,
+    0x81, 0x80, 0xCC, 0xC0, 0x66, 0x00, 0x3F, 0x00, 0x1F, 0x80, 0x0C, 0xC0, 0x06, 0x60, 0x03, 0x00,
+    0x01, 0x80, 0x03, 0xFC, 0x01, 0xFE, 0x00, 0x03, 0x0E, 0x03, 0xEC, 0x07, 0xFE, 0x07, 0x07, 0x03,
+    0x01, 0x83, 0x00, 0xC1, 0x80, 0x00, 0xC0, 0x00, 0x61, 0xFC, 0x30, 0xFE, 0x18, 0x06, 0x0E, 0x03,
+    0x03, 0x83, 0x80, 0xFF, 0xC0, 0x1F, 0x80, 0x03, 0x0E, 0x7E, 0x7E, 0x3F, 0x3F, 0x06, 0x06, 0x03,
+    0x03, 0x01, 0x81, 0x80, 0xC0, 0xC0, 0x7F, 0xE0, 0x3F, 0xF0, 0x18, 0x18, 0x0C, 0x0C, 0x06, 0x06,
+    0x03, 0x03, 0x07, 0xE7, 0xE3, 0xF3, 0xF0, 0x03, 0x0E, 0x1F, 0xF8, 0x0F, 0xFC, 0x00, 0x60, 0x00,
+    0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0xC0, 0x00, 0x60,
+    0x00, 0x30, 0x01, 0xFF, 0x80, 0xFF, 0xC0, 0x03, 0x0E, 0x07, 0xFE, 0x03, 0xFF, 0x00, 0x0C, 0x00,
+    0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0xC0, 0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x0C, 0x0C,
+    0x06, 0x0C, 0x03, 0xFE, 0x00, 0x7C, 0x00, 0x03, 0x0E, 0x7F, 0x3E, 0x3F, 0x9F, 0x06, 0x0C, 0x03,
+    0x0C, 0x01, 0x8C, 0x00, 0xCC, 0x00, 0x6E, 0x00, 0x3F, 0x80, 0x1C, 0xE0, 0x0C, 0x38, 0x06, 0x0C,
+    0x03, 0x07, 0x07, 0xF1, 0xF3, 0xF8, 0xF8, 0x03, 0x0E, 0x7F, 0x80, 0x3F, 0xC0, 0x03, 0x00, 0x01,
+    0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x0C, 0x06, 0x06, 0x03, 0x03,
+    0x01, 0x81, 0x87, 0xFF, 0xC3, 0xFF, 0xE0, 0x03, 0x0E, 0xF0, 0x0F, 0x7C, 0x0F, 0x8E, 0x07, 0x07,
+    0x87, 0x83, 0xC3, 0xC1, 0xB3, 0x60, 0xD9, 0xB0, 0x67, 0x98, 0x33, 0xCC, 0x18, 0xC6, 0x0C, 0x03,
+    0x06, 0x01, 0x8F, 0xE7, 0xF7, 0xF3, 0xF8, 0x03, 0x0E, 0x78, 0xFE, 0x3C, 0x7F, 0x07, 0x06, 0x03,
+    0xC3, 0x01, 0xF1, 0x80, 0xD8, 0xC0, 0x6E, 0x60, 0x33, 0xB0, 0x18, 0xD8, 0x0C, 0x7C, 0x06, 0x1E,
+    0x03, 0x07, 0x07, 0xF1, 0x83, 0xF8, 0xC0, 0x03, 0x0E, 0x03, 0xC0, 0x07, 0xF8, 0x07, 0x0E, 0x03,
+    0x03, 0x03, 0x81, 0xC1, 0x80, 0x60, 0xC0, 0x30, 0x60, 0x18, 0x30, 0x0C, 0x1C, 0x0E, 0x06, 0x06,
+    0x03, 0x87, 0x00, 0xFF, 0x00, 0x1E, 0x00, 0x03, 0x0E, 0x3F, 0xF0, 0x1F, 0xFC, 0x03, 0x07, 0x01,
+    0x81, 0x80, 0xC0, 0xC0, 0x60, 0x60, 0x30, 0x60, 0x1F, 0xF0, 0x0F, 0xE0, 0x06, 0x00, 0x03, 0x00,
+    0x01, 0x80, 0x03, 0xFC, 0x01, 0xFE, 0x00, 0x03, 0x11, 0x03, 0xC0, 0x07, 0xF8, 0x07, 0x0E, 0x03,
+    0x03, 0x03, 0x81, 0xC1, 0x80, 0x60, 0xC0, 0x30, 0x60, 0x18, 0x30, 0x0C, 0x1C, 0x0E, 0x06, 0x06,
+    0x03, 0x87, 0x00, 0xFF, 0x00, 0x3E, 0x00, 0x1F, 0x30, 0x1F, 0xF8, 0x0C, 0x38, 0x00, 0x03, 0x0E,
+    0x7F, 0xE0, 0x3F, 0xF8, 0x06, 0x0E, 0x03, 0x03, 0x01, 0x81, 0x80, 0xC1, 0xC0, 0x7F, 0xC0, 0x3F,
+    0x80, 0x18, 0xE0, 0x0C, 0x38, 0x06, 0x0C, 0x03, 0x07, 0x07, 0xF1, 0xE3, 0xF8, 0x70, 0x03, 0x0E,
+    0x07, 0xD8, 0x07, 0xFC, 0x07, 0x0E, 0x03, 0x03, 0x01, 0x81, 0x80, 0xF0, 0x00, 0x3F, 0x00, 0x07,
+    0xE0, 0x00, 0x78, 0x0C, 0x0C, 0x06, 0x06, 0x03, 0x87, 0x01, 0xFF, 0x00, 0xDF, 0x00, 0x03, 0x0E,
+    0x3F, 0xFC, 0x1F, 0xFE, 0x0C, 0x63, 0x06, 0x31, 0x83, 0x18, 0xC1, 0x8C, 0x60, 0x06, 0x00, 0x03,
+    0x00, 0x01, 0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0xFF, 0x00, 0x7F, 0x80, 0x03, 0x0E,
+    0x7E, 0x7E, 0x3F, 0x3F, 0x06, 0x06, 0x03, 0x03, 0x01, 0x81, 0x80, 0xC0, 0xC0, 0x60, 0x60, 0x30,
+    0x30, 0x18, 0x18, 0x0C, 0x0C, 0x06, 0x06, 0x01, 0x86, 0x00, 0xFF, 0x00, 0x1E, 0x00, 0x03, 0x0E,
+    0x7F, 0x7F, 0x3F, 0xBF, 0x86, 0x03, 0x01, 0x83, 0x00, 0xC1, 0x80, 0x60, 0xC0, 0x18, 0xC0, 0x0C,
+    0x60, 0x03, 0x60, 0x01, 0xB0, 0x00, 0xD8, 0x00, 0x38, 0x00, 0x1C, 0x00, 0x04, 0x00, 0x03, 0x0E,
+    0xFE, 0x3F, 0xFF, 0x1F, 0xCC, 0x01, 0x86, 0x00, 0xC3, 0x08, 0x60, 0xCE, 0x60, 0x67, 0x30, 0x36,
+    0xD8, 0x1B, 0x6C, 0x0F, 0x3E, 0x03, 0x8E, 0x01, 0xC7, 0x00, 0xC1, 0x80, 0x60, 0xC0, 0x03, 0x0E,
+    0x7E, 0x7E, 0x3F, 0x3F, 0x06, 0x06, 0x01, 0x86, 0x00, 0x66, 0x00, 0x1E, 0x00, 0x06, 0x00, 0x03,
+    0x00, 0x03, 0xC0, 0x03, 0x30, 0x03, 0x0C, 0x03, 0x03, 0x07, 0xE7, 0xE3, 0xF3, 0xF0, 0x03, 0x0E,
+    0x7C, 0x7E, 0x3E, 0x3F, 0x06, 0x06, 0x01, 0x86, 0x00, 0x66, 0x00, 0x33, 0x00, 0x0F, 0x00, 0x03,
+    0x00, 0x01, 0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0xFF, 0x00, 0x7F, 0x80, 0x03, 0x0E,
+    0x1F, 0xF8, 0x0F, 0xFC, 0x06, 0x06, 0x03, 0x06, 0x01, 0x86, 0x00, 0xC6, 0x00, 0x06, 0x00, 0x06,
+    0x00, 0x06, 0x18, 0x06, 0x0C, 0x06, 0x06, 0x06, 0x03, 0x03, 0xFF, 0x81, 0xFF, 0xC0, 0x02, 0x12,
+    0x01, 0xF0, 0x00, 0xF8, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03,
+    0x00, 0x01, 0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00,
+    0x03, 0x00, 0x01, 0xF0, 0x00, 0xF8, 0x00, 0x00, 0x14, 0x18, 0x00, 0x0C, 0x00, 0x07, 0x00, 0x01,
+    0x80, 0x00, 0xE0, 0x00, 0x30, 0x00, 0x18, 0x00, 0x06, 0x00, 0x03, 0x00, 0x00, 0xC0, 0x00, 0x60,
+    0x00, 0x18, 0x00, 0x0C, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0xE0, 0x00, 0x30, 0x00, 0x1C, 0x00,
+    0x06, 0x00, 0x03, 0x00, 0x02, 0x12, 0x0F, 0x80, 0x07, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18,
+    0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00,
+    0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x0F, 0x80, 0x07, 0xC0, 0x00, 0x01, 0x08, 0x00,
+    0x80, 0x00, 0xE0, 0x00, 0xF8, 0x00, 0xEE, 0x00, 0x63, 0x00, 0x60, 0xC0, 0x60, 0x30, 0x20, 0x08,
+    0x16, 0x02, 0xFF, 0xFF, 0x7F, 0xFF, 0x80, 0x01, 0x04, 0x03, 0x00, 0x01, 0xC0, 0x00, 0x38, 0x00,
+    0x0C, 0x00, 0x06, 0x0B, 0x0F, 0xC0, 0x0F, 0xF0, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x7F, 0x00, 0xFF,
+    0x80, 0xE0, 0xC0, 0x60, 0x60, 0x30, 0x70, 0x0F, 0xFE, 0x03, 0xEF, 0x00, 0x02, 0x0F, 0x78, 0x00,
+    0x3C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0xBE, 0x00, 0xFF, 0xC0, 0x70, 0x60, 0x30, 0x18, 0x18,
+    0x0C, 0x0C, 0x06, 0x06, 0x03, 0x03, 0x01, 0x81, 0xC1, 0x83, 0xFF, 0xC1, 0xEF, 0x80, 0x06, 0x0B,
+    0x03, 0xEC, 0x07, 0xFE, 0x07, 0x07, 0x07, 0x01, 0x83, 0x00, 0xC1, 0x80, 0x00, 0xC0, 0x00, 0x70,
+    0x18, 0x1C, 0x1C, 0x07, 0xFC, 0x00, 0xFC, 0x00, 0x02, 0x0F, 0x00, 0x78, 0x00, 0x3C, 0x00, 0x06,
+    0x00, 0x03, 0x00, 0x7D, 0x80, 0xFF, 0xC0, 0x60, 0xE0, 0x60, 0x30, 0x30, 0x18, 0x18, 0x0C, 0x0C,
+    0x06, 0x06, 0x03, 0x01, 0x83, 0x80, 0xFF, 0xF0, 0x1F, 0x78, 0x06, 0x0B, 0x07, 0xE0, 0x0F, 0xFC,
+    0x06, 0x06, 0x06, 0x01, 0x83, 0xFF, 0xC1, 0xFF, 0xE0, 0xC0, 0x00, 0x60, 0x00, 0x18, 0x0C, 0x0F,
+    0xFE, 0x01, 0xFC, 0x00, 0x02, 0x0F, 0x01, 0xFC, 0x01, 0xFE, 0x01, 0x80, 0x00, 0xC0, 0x03, 0xFF,
+    0x81, 0xFF, 0xC0, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0xC0, 0x00,
+    0x60, 0x01, 0xFF, 0x80, 0xFF, 0xC0, 0x06, 0x10, 0x07, 0xDE, 0x0F, 0xFF, 0x06, 0x0E, 0x06, 0x03,
+    0x03, 0x01, 0x81, 0x80, 0xC0, 0xC0, 0x60, 0x60, 0x30, 0x18, 0x38, 0x0F, 0xFC, 0x01, 0xF6, 0x00,
+    0x03, 0x00, 0x01, 0x80, 0x01, 0xC0, 0x3F, 0xC0, 0x1F, 0x80, 0x02, 0x0F, 0x78, 0x00, 0x3C, 0x00,
+    0x06, 0x00, 0x03, 0x00, 0x01, 0xBE, 0x00, 0xFF, 0x80, 0x70, 0xE0, 0x30, 0x30, 0x18, 0x18, 0x0C,
+    0x0C, 0x06, 0x06, 0x03, 0x03, 0x01, 0x81, 0x83, 0xF3, 0xF1, 0xF9, 0xF8, 0x02, 0x0F, 0x01, 0x80,
+    0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x01, 0xF8, 0x00, 0xFC, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01,
+    0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x01, 0xFF, 0xE0, 0xFF, 0xF0, 0x02, 0x14,
+    0x00, 0xC0, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x01, 0xFF, 0x00, 0xFF, 0x80, 0x00, 0xC0, 0x00,
+    0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0xC0,
+    0x00, 0x60, 0x00, 0x30, 0x00, 0x38, 0x07, 0xF8, 0x03, 0xF0, 0x00, 0x02, 0x0F, 0x3C, 0x00, 0x1E,
+    0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0xCF, 0x80, 0x67, 0xC0, 0x33, 0x00, 0x1B, 0x00, 0x0F, 0x80,
+    0x07, 0x80, 0x03, 0xE0, 0x01, 0xB8, 0x00, 0xCE, 0x01, 0xE3, 0xE0, 0xF1, 0xF0, 0x02, 0x0F, 0x1F,
+    0x80, 0x0F, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00,
+    0x01, 0x80, 0x00, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x01, 0xFF, 0xE0, 0xFF, 0xF0, 0x06,
+    0x0B, 0xF7, 0x78, 0x7F, 0xFE, 0x0E, 0x73, 0x06, 0x31, 0x83, 0x18, 0xC1, 0x8C, 0x60, 0xC6, 0x30,
+    0x63, 0x18, 0x31, 0x8C, 0x7E, 0xF7, 0xBF, 0x7B, 0xC0, 0x06, 0x0B, 0x7B, 0xE0, 0x3F, 0xF8, 0x07,
+    0x0E, 0x03, 0x03, 0x01, 0x81, 0x80, 0xC0, 0xC0, 0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x3F, 0x3F,
+    0x1F, 0x9F, 0x80, 0x06, 0x0B, 0x03, 0xC0, 0x07, 0xF8, 0x07, 0x0E, 0x07, 0x03, 0x83, 0x00, 0xC1,
+    0x80, 0x60, 0xC0, 0x30, 0x70, 0x38, 0x1C, 0x38, 0x07, 0xF8, 0x00, 0xF0, 0x00, 0x06, 0x10, 0x7B,
+    0xE0, 0x3F, 0xFC, 0x07, 0x06, 0x03, 0x01, 0x81, 0x80, 0xC0, 0xC0, 0x60, 0x60, 0x30, 0x30, 0x18,
+    0x1C, 0x18, 0x0F, 0xFC, 0x06, 0xF8, 0x03, 0x00, 0x01, 0x80, 0x00, 0xC0, 0x01, 0xFC, 0x00, 0xFE,
+    0x00, 0x06, 0x10, 0x07, 0xDE, 0x0F, 0xFF, 0x06, 0x0E, 0x06, 0x03, 0x03, 0x01, 0x81, 0x80, 0xC0,
+    0xC0, 0x60, 0x60, 0x30, 0x18, 0x38, 0x0F, 0xFC, 0x01, 0xF6, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00,
+    0xC0, 0x03, 0xF8, 0x01, 0xFC, 0x06, 0x0B, 0x3E, 0x78, 0x1F, 0x7E, 0x01, 0xF3, 0x00, 0xE0, 0x00,
+    0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x1F, 0xF8, 0x0F, 0xFC, 0x00, 0x06,
+    0x0B, 0x07, 0xF8, 0x07, 0xFC, 0x06, 0x06, 0x03, 0x03, 0x01, 0xF8, 0x00, 0x7F, 0x80, 0x03, 0xE0,
+    0x30, 0x30, 0x18, 0x38, 0x0F, 0xF8, 0x07, 0xF8, 0x00, 0x02, 0x0F, 0x0C, 0x00, 0x06, 0x00, 0x03,
+    0x00, 0x01, 0x80, 0x03, 0xFF, 0x01, 0xFF, 0x80, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00,
+    0x03, 0x00, 0x01, 0x80, 0x00, 0xC1, 0xC0, 0x3F, 0xE0, 0x0F, 0xC0, 0x06, 0x0B, 0x78, 0x78, 0x3C,
+    0x3C, 0x06, 0x06, 0x03, 0x03, 0x01, 0x81, 0x80, 0xC0, 0xC0, 0x60, 0x60, 0x30, 0x30, 0x18, 0x38,
+    0x07, 0xFF, 0x01, 0xF7, 0x80, 0x06, 0x0B, 0x7C, 0x3E, 0x3E, 0x1F, 0x06, 0x06, 0x03, 0x03, 0x00,
+    0xC3, 0x00, 0x61, 0x80, 0x19, 0x80, 0x0C, 0xC0, 0x07, 0xE0, 0x01, 0xE0, 0x00, 0xF0, 0x00, 0x06,
+    0x0B, 0x78, 0x3C, 0x3C, 0x1E, 0x0C, 0x46, 0x06, 0x73, 0x03, 0x39, 0x80, 0xD5, 0x80, 0x7B, 0xC0,
+    0x3D, 0xE0, 0x1C, 0x60, 0x06, 0x30, 0x03, 0x18, 0x00, 0x06, 0x0B, 0x3E, 0x7C, 0x1F, 0x3E, 0x03,
+    0x0C, 0x00, 0xCC, 0x00, 0x3C, 0x00, 0x0C, 0x00, 0x0F, 0x00, 0x0C, 0xC0, 0x0C, 0x30, 0x1F, 0x3E,
+    0x0F, 0x9F, 0x00, 0x06, 0x10, 0x7E, 0x1F, 0x3F, 0x0F, 0x86, 0x03, 0x01, 0x83, 0x00, 0xC1, 0x80,
+    0x31, 0x80, 0x18, 0xC0, 0x06, 0xC0, 0x03, 0xE0, 0x00, 0xE0, 0x00, 0x30, 0x00, 0x30, 0x00, 0x18,
+    0x00, 0x18, 0x00, 0xFF, 0x00, 0x7F, 0x80, 0x06, 0x0B, 0x1F, 0xF8, 0x0F, 0xFC, 0x06, 0x0C, 0x03,
+    0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x00, 0x0C, 0x30, 0x0C, 0x18, 0x0F, 0xFC, 0x07, 0xFE,
+    0x00, 0x02, 0x12, 0x00, 0xE0, 0x00, 0xF0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00,
+    0x06, 0x00, 0x03, 0x00, 0x03, 0x80, 0x03, 0x80, 0x00, 0xE0, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C,
+    0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0xE0, 0x00, 0x70, 0x00, 0x02, 0x12, 0x01, 0x80, 0x00, 0xC0,
+    0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00,
+    0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80,
+    0x00, 0xC0, 0x00, 0x02, 0x12, 0x07, 0x00, 0x03, 0xC0, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00,
+    0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0xC0, 0x00, 0x70, 0x00, 0x70, 0x00, 0x30, 0x00, 0x18,
+    0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x07, 0x80, 0x03, 0x80, 0x00, 0x08, 0x05, 0x0E, 0x00,
+    0x0F, 0x8C, 0x0E, 0xEE, 0x06, 0x3E, 0x00, 0x0E, 0x00,
+};
+
+static const uint16_t font_24_offsets[] = {
+    0, 2, 36, 53, 89, 132, 166, 196, 213, 254, 295, 319,
+    347, 364, 371, 380, 425, 459, 493, 527, 561, 595, 629, 663,
+    697, 731, 765, 791, 821, 851, 866, 896, 928, 967, 999, 1031,
+    1063, 1095, 1127, 1159, 1191, 1223, 1255, 1287, 1319, 1351, 1383, 1415,
+    1447, 1479, 1518, 1550, 1582, 1614, 1646, 1678, 1710, 1742, 1774, 1806,
+    1847, 1892, 1933, 1952, 1959, 1970, 1996, 2030, 2056, 2090, 2116, 2150,
+    2186, 2220, 2254, 2299, 2333, 2367, 2393, 2419, 2445, 2481, 2517, 2543,
+    2569, 2603, 2629, 2655, 2681, 2707, 2743, 2769, 2810, 2851, 2892,
+};
+
+static const epaper_packed_font_t font_24_packed = {
+    font_24_glyphs,
+    font_24_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_24 = {
+    17, /* width */
+    24, /* height */
+    NULL,
+    &font_24_packed,
+};
+
+/* 7x10, 950 bytes unpacked */
+static const uint8_t font_meslo_7_glyphs[] = {
+    0x00, 0x00, 0x01, 0x07, 0x20, 0x40, 0x81, 0x00, 0x00, 0x08, 0x00, 0x01, 0x02, 0x50, 0xA0, 0x01,
+    0x07, 0x28, 0x51, 0xE2, 0x8F, 0x8A, 0x38, 0x00, 0x01, 0x08, 0x20, 0xE1, 0xA3, 0x03, 0x8D, 0x1C,
+    0x10, 0x02, 0x06, 0x61, 0x43, 0xA6, 0xC2, 0x83, 0x00, 0x01, 0x07, 0x70, 0x81, 0x83, 0x0B, 0x9B,
+    0x1E, 0x00, 0x01, 0x02, 0x20, 0x40, 0x01, 0x08, 0x10, 0x40, 0x81, 0x02, 0x04, 0x08, 0x08, 0x01,
+    0x08, 0x60, 0x40, 0xC1, 0x83, 0x06, 0x08, 0x30, 0x01, 0x05, 0x21, 0xD0, 0xC7, 0xC2, 0x00, 0x03,
+    0x05, 0x20, 0x43, 0xE1, 0x02, 0x00, 0x06, 0x03, 0x20, 0x40, 0x80, 0x05, 0x01, 0xF8, 0x07, 0x01,
+    0x20, 0x01, 0x08, 0x08, 0x20, 0x41, 0x02, 0x08, 0x10, 0x40, 0x01, 0x07, 0x70, 0xB1, 0x63, 0x44,
+    0x8B, 0x1C, 0x00, 0x01, 0x07, 0x70, 0xE0, 0xC1, 0x83, 0x06, 0x1E, 0x00, 0x01, 0x07, 0x71, 0x30,
+    0x60, 0x82, 0x08, 0x3E, 0x00, 0x01, 0x07, 0x70, 0xB0, 0x61, 0x81, 0x83, 0x1C, 0x00, 0x01, 0x07,
+    0x10, 0x61, 0x42, 0x8F, 0x82, 0x04, 0x00, 0x01, 0x07, 0x70, 0x81, 0x03, 0x81, 0x83, 0x1C, 0x00,
+    0x01, 0x07, 0x38, 0x81, 0xC2, 0xC4, 0x89, 0x1C, 0x00, 0x01, 0x07, 0x78, 0x20, 0x41, 0x82, 0x04,
+    0x18, 0x00, 0x01, 0x07, 0x70, 0xB1, 0x61, 0x84, 0x89, 0x1C, 0x00, 0x01, 0x07, 0x70, 0xB3, 0x62,
+    0xC7, 0x83, 0x1C, 0x00, 0x04, 0x04, 0x20, 0x00, 0x01, 0x00, 0x03, 0x06, 0x20, 0x00, 0x01, 0x02,
+    0x04, 0x00, 0x03, 0x05, 0x18, 0xE3, 0x01, 0xC0, 0x80, 0x04, 0x03, 0xF8, 0x03, 0xE0, 0x03, 0x05,
+    0xC0, 0x70, 0x67, 0x08, 0x00, 0x01, 0x07, 0x70, 0xB0, 0x41, 0x82, 0x00, 0x08, 0x00, 0x01, 0x08,
+    0x30, 0x92, 0xE5, 0x4A, 0x97, 0x10, 0x3C, 0x01, 0x07, 0x30, 0x61, 0x42, 0x87, 0x89, 0x32, 0x00,
+    0x01, 0x07, 0x70, 0xB1, 0x23, 0x84, 0x89, 0x1E, 0x00, 0x01, 0x07, 0x38, 0x91, 0x02, 0x04, 0x09,
+    0x0E, 0x00, 0x01, 0x07, 0x70, 0xB1, 0x22, 0x44, 0x8B, 0x1C, 0x00, 0x01, 0x07, 0x78, 0x81, 0x03,
+    0xC4, 0x08, 0x1E, 0x00, 0x01, 0x07, 0x78, 0x81, 0x03, 0xC4, 0x08, 0x10, 0x00, 0x01, 0x07, 0x38,
+    0x91, 0x02, 0xC4, 0x89, 0x0E, 0x00, 0x01, 0x07, 0x48, 0x91, 0x23, 0xC4, 0x89, 0x12, 0x00, 0x01,
+    0x07, 0x78, 0x40, 0x81, 0x02, 0x04, 0x1E, 0x00, 0x01, 0x07, 0x30, 0x20, 0x40, 0x81, 0x12, 0x3C,
+    0x00, 0x01, 0x07, 0x58, 0xA1, 0x83, 0x85, 0x0B, 0x12, 0x00, 0x01, 0x07, 0x40, 0x81, 0x02, 0x04,
+    0x08, 0x1E, 0x00, 0x01, 0x07, 0xD9, 0xB3, 0xE7, 0x4C, 0x99, 0x32, 0x00, 0x01, 0x07, 0x48, 0x91,
+    0xA3, 0x45, 0x8B, 0x16, 0x00, 0x01, 0x07, 0x70, 0xB3, 0x26, 0x4C, 0x8B, 0x1C, 0x00, 0x01, 0x07,
+    0x70, 0x91, 0x23, 0xC4, 0x08, 0x10, 0x00, 0x01, 0x08, 0x70, 0xB3, 0x26, 0x4C, 0x8B, 0x1C, 0x0C,
+    0x01, 0x07, 0x70, 0xB1, 0x63, 0x85, 0x0B, 0x12, 0x00, 0x01, 0x07, 0x78, 0x91, 0x03, 0x81, 0x8B,
+    0x1C, 0x00, 0x01, 0x07, 0xF8, 0x40, 0x81, 0x02, 0x04, 0x08, 0x00, 0x01, 0x07, 0xC9, 0x93, 0x26,
+    0x4C, 0x8B, 0x1C, 0x00, 0x01, 0x07, 0xC8, 0x91, 0x62, 0x85, 0x0E, 0x0C, 0x00, 0x01, 0x07, 0x89,
+    0x12, 0xA5, 0xC7, 0x8B, 0x16, 0x00, 0x01, 0x07, 0xC8, 0xA0, 0xC1, 0x07, 0x0A, 0x32, 0x00, 0x01,
+    0x07, 0xC8, 0xB1, 0xC1, 0x82, 0x04, 0x08, 0x00, 0x01, 0x07, 0x78, 0x30, 0x41, 0x86, 0x08, 0x3E,
+    0x00, 0x01, 0x08, 0x30, 0x40, 0x81, 0x02, 0x04, 0x08, 0x18, 0x01, 0x08, 0xC0, 0x80, 0x81, 0x01,
+    0x02, 0x04, 0x04, 0x01, 0x08, 0x70, 0x60, 0xC1, 0x83, 0x06, 0x0C, 0x38, 0x01, 0x03, 0x30, 0xA2,
+    0x20, 0x09, 0x01, 0xF8, 0x00, 0x02, 0x40, 0x40, 0x03, 0x05, 0x70, 0x91, 0xE6, 0xC6, 0x80, 0x01,
+    0x07, 0x40, 0x81, 0xC2, 0x44, 0x89, 0x1C, 0x00, 0x03, 0x05, 0x38, 0x91, 0x02, 0x43, 0x80, 0x01,
+    0x07, 0x18, 0x31, 0xE6, 0xCD, 0x9B, 0x1E, 0x00, 0x03, 0x05, 0x70, 0x93, 0xE2, 0x07, 0x80, 0x01,
+    0x07, 0x38, 0x41, 0xE1, 0x02, 0x04, 0x08, 0x00, 0x03, 0x07, 0x68, 0xB3, 0x22, 0xC6, 0x83, 0x1C,
+    0x00, 0x01, 0x07, 0x40, 0x81, 0xC2, 0xC5, 0x8B, 0x16, 0x00, 0x01, 0x07, 0x30, 0x01, 0xC1, 0x83,
+    0x06, 0x1E, 0x00, 0x01, 0x09, 0x30, 0x01, 0xC1, 0x83, 0x06, 0x0C, 0x18, 0x60, 0x01, 0x07, 0x40,
+    0x81, 0x63, 0x87, 0x0A, 0x12, 0x00, 0x01, 0x07, 0xE0, 0x40, 0x81, 0x02, 0x04, 0x0E, 0x00, 0x03,
+    0x05, 0xF9, 0x52, 0xA5, 0x4A, 0x80, 0x03, 0x05, 0x70, 0xB1, 0x62, 0xC5, 0x80, 0x03, 0x05, 0x70,
+    0xB3, 0x22, 0xC7, 0x00, 0x03, 0x07, 0x70, 0x91, 0x22, 0x47, 0x08, 0x10, 0x00, 0x03, 0x07, 0x79,
+    0xB3, 0x66, 0xC7, 0x83, 0x06, 0x00, 0x03, 0x05, 0x78, 0xC1, 0x83, 0x06, 0x00, 0x03, 0x05, 0x70,
+    0x91, 0xC0, 0xC7, 0x00, 0x01, 0x07, 0x20, 0x43, 0xE1, 0x02, 0x04, 0x0E, 0x00, 0x03, 0x05, 0x58,
+    0xB1, 0x62, 0xC7, 0x80, 0x03, 0x05, 0xC8, 0xB1, 0x43, 0x83, 0x00, 0x03, 0x05, 0x89, 0x52, 0xA2,
+    0xC5, 0x80, 0x03, 0x05, 0xD8, 0xE0, 0x83, 0x8D, 0x80, 0x03, 0x07, 0xC8, 0xB1, 0x41, 0x83, 0x04,
+    0x18, 0x00, 0x03, 0x05, 0x78, 0x20, 0x83, 0x07, 0x80, 0x01, 0x08, 0x38, 0x40, 0x81, 0x06, 0x04,
+    0x08, 0x1C, 0x01, 0x09, 0x20, 0x40, 0x81, 0x02, 0x04, 0x08, 0x10, 0x20, 0x01, 0x08, 0x60, 0x40,
+    0x81, 0x01, 0x84, 0x08, 0x30, 0x04, 0x03, 0x41, 0x52, 0x60,
+};
+
+static const uint16_t font_meslo_7_offsets[] = {
+    0, 2, 11, 15, 24, 33, 41, 50, 54, 63, 72, 79,
+    86, 91, 94, 97, 106, 115, 124, 133, 142, 151, 160, 169,
+    178, 187, 196, 202, 210, 217, 222, 229, 238, 247, 256, 265,
+    274, 283, 292, 301, 310, 319, 328, 337, 346, 355, 364, 373,
+    382, 391, 400, 409, 418, 427, 436, 445, 454, 463, 472, 481,
+    490, 499, 508, 513, 516, 520, 527, 536, 543, 552, 559, 568,
+    577, 586, 595, 605, 614, 623, 630, 637, 644, 653, 662, 669,
+    676, 685, 692, 699, 706, 713, 722, 729, 738, 748, 757,
+};
+
+static const epaper_packed_font_t font_meslo_7_packed = {
+    font_meslo_7_glyphs,
+    font_meslo_7_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_meslo_7 = {
+    7, /* width */
+    10, /* height */
+    NULL,
+    &font_meslo_7_packed,
+};
+
+/* 7x12, 1140 bytes unpacked */
+static const uint8_t font_meslo_8_glyphs[] = {
+    0x00, 0x00, 0x01, 0x08, 0x10, 0x20, 0x40, 0x81, 0x00, 0x00, 0x08, 0x01, 0x03, 0x68, 0xD1, 0xA0,
+    0x01, 0x08, 0x34, 0x59, 0xF9, 0x42, 0x9F, 0x96, 0x28, 0x01, 0x0A, 0x10, 0x21, 0xE2, 0xA7, 0x03,
+    0x97, 0x3C, 0x10, 0x20, 0x01, 0x08, 0x61, 0x62, 0x43, 0x23, 0x99, 0x84, 0x86, 0x01, 0x08, 0x38,
+    0xD1, 0x83, 0x8D, 0x7B, 0xB3, 0x3F, 0x01, 0x03, 0x10, 0x20, 0x40, 0x01, 0x0A, 0x18, 0x20, 0xC1,
+    0x83, 0x06, 0x0C, 0x18, 0x10, 0x30, 0x01, 0x0A, 0x20, 0x60, 0x40, 0x81, 0x83, 0x04, 0x08, 0x30,
+    0x40, 0x01, 0x06, 0x11, 0x29, 0xE1, 0xCD, 0x42, 0x00, 0x02, 0x06, 0x10, 0x20, 0x47, 0xE1, 0x02,
+    0x00, 0x08, 0x03, 0x30, 0x60, 0x80, 0x05, 0x01, 0x7C, 0x07, 0x02, 0x30, 0x60, 0x01, 0x09, 0x04,
+    0x10, 0x20, 0x81, 0x04, 0x08, 0x30, 0x40, 0x01, 0x08, 0x38, 0xD9, 0x32, 0xE6, 0xCD, 0x9B, 0x1C,
+    0x01, 0x08, 0x70, 0xE0, 0x40, 0x81, 0x02, 0x04, 0x3E, 0x01, 0x08, 0x78, 0x98, 0x30, 0x41, 0x86,
+    0x18, 0x3E, 0x01, 0x08, 0x78, 0x98, 0x31, 0x80, 0xC1, 0x93, 0x3C, 0x01, 0x08, 0x18, 0x30, 0xA3,
+    0x44, 0x8F, 0x82, 0x04, 0x01, 0x08, 0x78, 0x81, 0x03, 0xC4, 0xC1, 0x93, 0x3C, 0x01, 0x08, 0x3C,
+    0xC9, 0x03, 0xC6, 0xC8, 0x9B, 0x1C, 0x01, 0x08, 0x7C, 0x18, 0x20, 0xC1, 0x06, 0x0C, 0x30, 0x01,
+    0x08, 0x38, 0xD9, 0x31, 0xC6, 0xC9, 0x9B, 0x1C, 0x01, 0x08, 0x78, 0x99, 0x32, 0x67, 0xC1, 0x92,
+    0x3C, 0x03, 0x06, 0x30, 0x60, 0x00, 0x03, 0x06, 0x00, 0x04, 0x07, 0x30, 0x60, 0x00, 0x03, 0x06,
+    0x08, 0x00, 0x03, 0x05, 0x0C, 0x73, 0x03, 0x80, 0xC0, 0x04, 0x03, 0xFC, 0x03, 0xF0, 0x03, 0x05,
+    0xC0, 0xF0, 0x31, 0xEE, 0x00, 0x01, 0x08, 0x78, 0x98, 0x30, 0xC3, 0x06, 0x00, 0x18, 0x02, 0x09,
+    0x38, 0xCB, 0x75, 0xAA, 0x54, 0xB7, 0x20, 0x3C, 0x01, 0x08, 0x38, 0x70, 0xB3, 0x66, 0xCF, 0x93,
+    0x62, 0x01, 0x08, 0x78, 0x99, 0x33, 0xC4, 0xC8, 0x93, 0x3C, 0x01, 0x08, 0x3C, 0xF9, 0x83, 0x06,
+    0x0C, 0x1F, 0x1E, 0x01, 0x08, 0x78, 0x99, 0x32, 0x64, 0xC9, 0x93, 0x3C, 0x01, 0x08, 0x7C, 0x81,
+    0x03, 0xE4, 0x08, 0x10, 0x3E, 0x01, 0x08, 0x7C, 0xC1, 0x83, 0xE6, 0x0C, 0x18, 0x30, 0x01, 0x08,
+    0x3C, 0xC9, 0x02, 0x04, 0xC8, 0x99, 0x1E, 0x01, 0x08, 0x4C, 0x99, 0x33, 0xE4, 0xC9, 0x93, 0x26,
+    0x01, 0x08, 0x7C, 0x20, 0x40, 0x81, 0x02, 0x04, 0x3E, 0x01, 0x08, 0x38, 0x10, 0x20, 0x40, 0x81,
+    0x16, 0x3C, 0x01, 0x08, 0x4C, 0x91, 0x43, 0x87, 0x8B, 0x13, 0x23, 0x01, 0x08, 0x60, 0xC1, 0x83,
+    0x06, 0x0C, 0x18, 0x3E, 0x01, 0x08, 0xCD, 0xDB, 0xB7, 0xAD, 0x58, 0xB1, 0x62, 0x01, 0x08, 0x64,
+    0xC9, 0x92, 0xA5, 0x4A, 0x93, 0x26, 0x01, 0x08, 0x38, 0xD9, 0x32, 0x6C, 0xC9, 0x9B, 0x1C, 0x01,
+    0x08, 0x78, 0x99, 0x12, 0x67, 0xC8, 0x10, 0x20, 0x01, 0x09, 0x38, 0xD9, 0x32, 0x6C, 0xC9, 0x9B,
+    0x1C, 0x0C, 0x01, 0x08, 0x78, 0x99, 0x32, 0x67, 0x8B, 0x13, 0x23, 0x01, 0x08, 0x3C, 0xC9, 0x03,
+    0x81, 0xC1, 0x93, 0x3C, 0x01, 0x08, 0xFC, 0x20, 0x40, 0x81, 0x02, 0x04, 0x08, 0x01, 0x08, 0x4C,
+    0x99, 0x32, 0x64, 0xC9, 0x9B, 0x3C, 0x01, 0x08, 0xC4, 0x99, 0x33, 0x46, 0x85, 0x0E, 0x1C, 0x01,
+    0x08, 0x87, 0x8B, 0x57, 0xA7, 0x4D, 0x9B, 0x36, 0x01, 0x08, 0xCC, 0xD8, 0xE1, 0x83, 0x07, 0x1B,
+    0x62, 0x01, 0x08, 0xC6, 0x99, 0xA1, 0xC3, 0x02, 0x04, 0x08, 0x01, 0x08, 0x7C, 0x18, 0x60, 0xC3,
+    0x0C, 0x18, 0x3E, 0x01, 0x0A, 0x38, 0x60, 0xC1, 0x83, 0x06, 0x0C, 0x18, 0x30, 0x70, 0x01, 0x09,
+    0x40, 0xC0, 0x81, 0x01, 0x02, 0x02, 0x04, 0x04, 0x01, 0x0A, 0x30, 0x20, 0x40, 0x81, 0x02, 0x04,
+    0x08, 0x10, 0x60, 0x01, 0x03, 0x30, 0xF3, 0x30, 0x0A, 0x01, 0xFE, 0x00, 0x02, 0x60, 0x20, 0x03,
+    0x06, 0x78, 0x99, 0xF6, 0x64, 0xCF, 0x80, 0x01, 0x08, 0x40, 0x81, 0xE3, 0xE4, 0x48, 0x9F, 0x3C,
+    0x03, 0x06, 0x3C, 0xC9, 0x83, 0x06, 0x47, 0x80, 0x01, 0x08, 0x0C, 0x19, 0xF3, 0x64, 0xD9, 0x9B,
+    0x3E, 0x03, 0x06, 0x7C, 0x99, 0xF2, 0x06, 0x4F, 0x80, 0x01, 0x08, 0x1C, 0x61, 0xF1, 0x83, 0x06,
+    0x0C, 0x18, 0x03, 0x08, 0x7C, 0xD9, 0x32, 0x66, 0xC7, 0x83, 0x3C, 0x01, 0x08, 0x40, 0x81, 0x63,
+    0x64, 0xC9, 0x93, 0x26, 0x00, 0x09, 0x30, 0x60, 0x03, 0xC1, 0x83, 0x06, 0x0C, 0x7C, 0x00, 0x0B,
+    0x18, 0x00, 0x03, 0xC1, 0x83, 0x06, 0x0C, 0x18, 0x21, 0xC0, 0x01, 0x08, 0x60, 0xC1, 0xB3, 0xC7,
+    0x0F, 0x1A, 0x36, 0x01, 0x08, 0xF0, 0x60, 0xC1, 0x83, 0x06, 0x0C, 0x0E, 0x03, 0x06, 0xFD, 0xAB,
+    0x56, 0xAD, 0x5A, 0x80, 0x03, 0x06, 0x58, 0xD9, 0x32, 0x64, 0xC9, 0x80, 0x03, 0x06, 0x38, 0xD9,
+    0x32, 0x66, 0xC7, 0x00, 0x03, 0x08, 0x58, 0xD9, 0x12, 0x26, 0xCB, 0x10, 0x20, 0x03, 0x08, 0x7C,
+    0xD9, 0x36, 0x66, 0xCF, 0x83, 0x06, 0x03, 0x06, 0x7C, 0xC9, 0x93, 0x06, 0x0C, 0x00, 0x03, 0x06,
+    0x78, 0xC9, 0xC0, 0xE4, 0xCF, 0x00, 0x01, 0x08, 0x30, 0x61, 0xF1, 0x83, 0x06, 0x0C, 0x0E, 0x03,
+    0x06, 0x4C, 0x99, 0x32, 0x66, 0xCF, 0x80, 0x03, 0x06, 0xCC, 0x99, 0xA1, 0x43, 0x86, 0x00, 0x03,
+    0x06, 0x87, 0x8B, 0xD3, 0xA6, 0xCD, 0x80, 0x03, 0x06, 0xEC, 0x70, 0xC1, 0xC6, 0x99, 0x80, 0x03,
+    0x08, 0xCC, 0xD9, 0xA1, 0xC3, 0x82, 0x0C, 0x30, 0x03, 0x06, 0x7C, 0x18, 0x61, 0x86, 0x0F, 0x80,
+    0x01, 0x0A, 0x1C, 0x20, 0x40, 0x83, 0x0C, 0x0C, 0x08, 0x10, 0x38, 0x01, 0x0B, 0x10, 0x20, 0x40,
+    0x81, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x01, 0x0A, 0x70, 0x60, 0x40, 0x81, 0x03, 0x84, 0x08,
+    0x10, 0xE0, 0x04, 0x03, 0x61, 0x6C, 0x70,
+};
+
+static const uint16_t font_meslo_8_offsets[] = {
+    0, 2, 11, 16, 25, 36, 45, 54, 59, 70, 81, 89,
+    97, 102, 105, 109, 119, 128, 137, 146, 155, 164, 173, 182,
+    191, 200, 209, 217, 226, 233, 238, 245, 254, 264, 273, 282,
+    291, 300, 309, 318, 327, 336, 345, 354, 363, 372, 381, 390,
+    399, 408, 418, 427, 436, 445, 454, 463, 472, 481, 490, 499,
+    510, 520, 531, 536, 539, 543, 551, 560, 568, 577, 585, 594,
+    603, 612, 622, 634, 643, 652, 660, 668, 676, 685, 694, 702,
+    710, 719, 727, 735, 743, 751, 760, 768, 779, 791, 802,
+};
+
+static const epaper_packed_font_t font_meslo_8_packed = {
+    font_meslo_8_glyphs,
+    font_meslo_8_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_meslo_8 = {
+    7, /* width */
+    12, /* height */
+    NULL,
+    &font_meslo_8_packed,
+};
+
+/* 9x14, 2660 bytes unpacked */
+static const uint8_t font_meslo_9_glyphs[] = {
+    0x00, 0x00, 0x02, 0x09, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x80, 0x00, 0x00, 0x10, 0x00, 0x02,
+    0x03, 0x6C, 0x36, 0x1B, 0x00, 0x02, 0x09, 0x16, 0x1A, 0x1F, 0x85, 0x82, 0x87, 0xF1, 0x20, 0xB0,
+    0x58, 0x00, 0x01, 0x0B, 0x10, 0x1E, 0x1D, 0x0E, 0x07, 0x01, 0xE0, 0x70, 0x28, 0x5C, 0x3E, 0x04,
+    0x00, 0x02, 0x09, 0x60, 0x68, 0x24, 0x0E, 0xC1, 0x87, 0x70, 0x68, 0x34, 0x0C, 0x00, 0x02, 0x09,
+    0x38, 0x34, 0x18, 0x0E, 0x05, 0x26, 0xD3, 0x38, 0xD8, 0x7E, 0x00, 0x02, 0x03, 0x10, 0x08, 0x04,
+    0x00, 0x01, 0x0B, 0x08, 0x0C, 0x04, 0x06, 0x03, 0x01, 0x80, 0xC0, 0x60, 0x10, 0x0C, 0x02, 0x00,
+    0x01, 0x0B, 0x20, 0x08, 0x04, 0x03, 0x01, 0x80, 0xC0, 0x60, 0x30, 0x10, 0x08, 0x08, 0x00, 0x02,
+    0x07, 0x10, 0x49, 0x1F, 0x03, 0x07, 0xC4, 0x90, 0x40, 0x03, 0x07, 0x10, 0x08, 0x04, 0x1F, 0xC1,
+    0x00, 0x80, 0x40, 0x09, 0x04, 0x18, 0x0C, 0x0C, 0x06, 0x00, 0x07, 0x01, 0x7E, 0x00, 0x09, 0x02,
+    0x18, 0x0C, 0x00, 0x02, 0x0A, 0x06, 0x02, 0x02, 0x01, 0x01, 0x00, 0x80, 0xC0, 0x40, 0x60, 0x20,
+    0x00, 0x02, 0x09, 0x38, 0x36, 0x1B, 0x0D, 0x85, 0x63, 0x21, 0x90, 0xD8, 0x38, 0x00, 0x02, 0x09,
+    0x78, 0x3C, 0x06, 0x03, 0x01, 0x80, 0xC0, 0x60, 0xFC, 0x7E, 0x00, 0x02, 0x09, 0x78, 0x36, 0x03,
+    0x01, 0x80, 0x80, 0xC0, 0xC0, 0xC0, 0x7C, 0x00, 0x02, 0x09, 0x78, 0x26, 0x03, 0x07, 0x00, 0xC0,
+    0x20, 0x10, 0x98, 0x78, 0x00, 0x02, 0x09, 0x0C, 0x0E, 0x0F, 0x05, 0x84, 0xC3, 0xF1, 0xF8, 0x18,
+    0x0C, 0x00, 0x02, 0x09, 0x7C, 0x30, 0x18, 0x0F, 0x04, 0xC0, 0x20, 0x10, 0x98, 0x78, 0x00, 0x02,
+    0x09, 0x3C, 0x3A, 0x18, 0x0B, 0x86, 0xC3, 0x31, 0x98, 0xD8, 0x38, 0x00, 0x02, 0x09, 0x7C, 0x06,
+    0x03, 0x01, 0x01, 0x80, 0xC0, 0x40, 0x60, 0x30, 0x00, 0x02, 0x09, 0x38, 0x36, 0x19, 0x07, 0x06,
+    0xC2, 0x21, 0x10, 0xD8, 0x38, 0x00, 0x02, 0x09, 0x38, 0x36, 0x11, 0x0D, 0x87, 0xC0, 0x20, 0x30,
+    0xB8, 0x78, 0x00, 0x05, 0x06, 0x18, 0x0C, 0x00, 0x00, 0x01, 0x80, 0xC0, 0x05, 0x08, 0x18, 0x0C,
+    0x00, 0x00, 0x01, 0x80, 0xC0, 0xC0, 0x60, 0x04, 0x06, 0x06, 0x0E, 0x1C, 0x0C, 0x03, 0xC0, 0x30,
+    0x05, 0x04, 0x7E, 0x00, 0x00, 0x0F, 0xC0, 0x04, 0x06, 0x40, 0x3C, 0x03, 0x81, 0xC7, 0x83, 0x00,
+    0x02, 0x09, 0x38, 0x36, 0x01, 0x01, 0x81, 0x80, 0x80, 0x40, 0x00, 0x10, 0x00, 0x03, 0x0A, 0x3C,
+    0x33, 0x37, 0x96, 0xCA, 0x25, 0xB2, 0x79, 0x80, 0x62, 0x1F, 0x00, 0x02, 0x09, 0x38, 0x1C, 0x0A,
+    0x05, 0x86, 0xC3, 0xE1, 0xF0, 0x8C, 0xC6, 0x00, 0x02, 0x09, 0x7C, 0x26, 0x11, 0x08, 0x87, 0x82,
+    0x31, 0x18, 0x9C, 0x7C, 0x00, 0x02, 0x09, 0x1C, 0x1A, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x80, 0x68,
+    0x1C, 0x00, 0x02, 0x09, 0x78, 0x36, 0x19, 0x0C, 0xC6, 0x63, 0x31, 0x90, 0xD8, 0x78, 0x00, 0x02,
+    0x09, 0x7C, 0x30, 0x18, 0x0C, 0x07, 0xC3, 0x01, 0x80, 0xC0, 0x7C, 0x00, 0x02, 0x09, 0x7E, 0x30,
+    0x18, 0x0C, 0x07, 0xC3, 0x01, 0x80, 0xC0, 0x60, 0x00, 0x02, 0x09, 0x3C, 0x3A, 0x18, 0x0C, 0x04,
+    0xE3, 0x31, 0x98, 0xEC, 0x3C, 0x00, 0x02, 0x09, 0x64, 0x32, 0x19, 0x0C, 0x87, 0xC3, 0x21, 0x90,
+    0xC8, 0x64, 0x00, 0x02, 0x09, 0x7C, 0x08, 0x04, 0x02, 0x01, 0x00, 0x80, 0x40, 0x20, 0x7C, 0x00,
+    0x02, 0x09, 0x3C, 0x06, 0x03, 0x01, 0x80, 0xC0, 0x61, 0x30, 0xB8, 0x78, 0x00, 0x02, 0x09, 0x46,
+    0x26, 0x16, 0x0E, 0x07, 0x83, 0xC1, 0x30, 0x98, 0x46, 0x00, 0x02, 0x09, 0x60, 0x30, 0x18, 0x0C,
+    0x06, 0x03, 0x01, 0x80, 0xFC, 0x7E, 0x00, 0x02, 0x09, 0xE6, 0x77, 0x3B, 0x9D, 0xCD, 0xE6, 0xB3,
+    0x19, 0x8C, 0xC6, 0x00, 0x02, 0x09, 0x66, 0x33, 0x19, 0x8A, 0xC5, 0x62, 0xF1, 0x38, 0x9C, 0x4E,
+    0x00, 0x02, 0x09, 0x38, 0x36, 0x19, 0x08, 0xC4, 0x62, 0x31, 0x90, 0xD8, 0x38, 0x00, 0x02, 0x09,
+    0x7C, 0x37, 0x19, 0x8C, 0xC7, 0xC3, 0x01, 0x80, 0xC0, 0x60, 0x00, 0x02, 0x0B, 0x38, 0x36, 0x19,
+    0x08, 0xC4, 0x62, 0x31, 0x90, 0xD8, 0x38, 0x06, 0x01, 0x00, 0x02, 0x09, 0x7C, 0x36, 0x19, 0x0D,
+    0x87, 0x83, 0x61, 0xB0, 0xCC, 0x66, 0x00, 0x02, 0x09, 0x3C, 0x36, 0x10, 0x0E, 0x03, 0xC0, 0x60,
+    0x18, 0xD8, 0x7C, 0x00, 0x02, 0x09, 0x7E, 0x08, 0x04, 0x02, 0x01, 0x00, 0x80, 0x40, 0x20, 0x10,
+    0x00, 0x02, 0x09, 0x46, 0x23, 0x11, 0x88, 0xC4, 0x62, 0x31, 0x18, 0xF8, 0x3C, 0x00, 0x02, 0x09,
+    0xC6, 0x23, 0x19, 0x0D, 0x86, 0xC1, 0x60, 0xA0, 0x70, 0x38, 0x00, 0x02, 0x09, 0xC2, 0x61, 0x34,
+    0x9B, 0xC7, 0xE3, 0x71, 0xB0, 0xD8, 0x64, 0x00, 0x02, 0x09, 0xC6, 0x36, 0x0B, 0x07, 0x01, 0x81,
+    0xC0, 0xB0, 0xD8, 0xC6, 0x00, 0x02, 0x09, 0xC6, 0x32, 0x1B, 0x07, 0x03, 0x80, 0x80, 0x40, 0x20,
+    0x10, 0x00, 0x02, 0x09, 0x7E, 0x03, 0x03, 0x03, 0x01, 0x81, 0x81, 0x80, 0xC0, 0x7E, 0x00, 0x01,
+    0x0B, 0x38, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x80, 0xC0, 0x60, 0x30, 0x18, 0x0E, 0x00, 0x02, 0x0A,
+    0x40, 0x30, 0x08, 0x06, 0x01, 0x00, 0x80, 0x20, 0x10, 0x04, 0x03, 0x00, 0x01, 0x0B, 0x38, 0x0C,
+    0x06, 0x03, 0x01, 0x80, 0xC0, 0x60, 0x30, 0x18, 0x0C, 0x0E, 0x00, 0x02, 0x04, 0x18, 0x1C, 0x1B,
+    0x18, 0xC0, 0x0D, 0x01, 0xFE, 0x00, 0x00, 0x03, 0x60, 0x10, 0x04, 0x00, 0x04, 0x07, 0x7C, 0x36,
+    0x01, 0x0F, 0xC6, 0x63, 0x71, 0xD8, 0x01, 0x0A, 0x60, 0x30, 0x18, 0x0F, 0x86, 0xC3, 0x31, 0x98,
+    0xCC, 0x6C, 0x3E, 0x00, 0x04, 0x07, 0x3C, 0x3A, 0x18, 0x0C, 0x06, 0x03, 0xA0, 0xF0, 0x01, 0x0A,
+    0x04, 0x02, 0x01, 0x06, 0x86, 0xC2, 0x21, 0x10, 0x88, 0x6C, 0x1A, 0x00, 0x04, 0x07, 0x38, 0x36,
+    0x11, 0x8F, 0xC4, 0x03, 0x20, 0xF0, 0x01, 0x0A, 0x1C, 0x0C, 0x04, 0x0F, 0x81, 0x00, 0x80, 0x40,
+    0x20, 0x10, 0x08, 0x00, 0x04, 0x0A, 0x34, 0x36, 0x11, 0x08, 0x84, 0x43, 0x60, 0xD0, 0x08, 0x6C,
+    0x3C, 0x00, 0x01, 0x0A, 0x60, 0x30, 0x18, 0x0F, 0x86, 0xC3, 0x21, 0x90, 0xC8, 0x64, 0x32, 0x00,
+    0x01, 0x0A, 0x18, 0x0C, 0x00, 0x0F, 0x01, 0x80, 0xC0, 0x60, 0x30, 0x18, 0x3F, 0x00, 0x01, 0x0D,
+    0x18, 0x0C, 0x00, 0x07, 0x01, 0x80, 0xC0, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x07, 0x00, 0x01,
+    0x0A, 0x60, 0x30, 0x18, 0x0D, 0xC6, 0x83, 0xC1, 0xE0, 0xD8, 0x6C, 0x33, 0x00, 0x01, 0x0A, 0x70,
+    0x18, 0x0C, 0x06, 0x03, 0x01, 0x80, 0xC0, 0x60, 0x38, 0x0E, 0x00, 0x04, 0x07, 0xFC, 0x6F, 0x35,
+    0x9A, 0xCD, 0x66, 0xB3, 0x58, 0x04, 0x07, 0x7C, 0x36, 0x19, 0x0C, 0x86, 0x43, 0x21, 0x90, 0x04,
+    0x07, 0x38, 0x36, 0x11, 0x88, 0xC4, 0x63, 0x60, 0xE0, 0x04, 0x0A, 0x7C, 0x36, 0x19, 0x8C, 0xC6,
+    0x63, 0x61, 0xF0, 0xC0, 0x60, 0x30, 0x00, 0x04, 0x0A, 0x34, 0x36, 0x11, 0x08, 0x84, 0x43, 0x60,
+    0xD0, 0x08, 0x04, 0x02, 0x00, 0x04, 0x07, 0x2E, 0x1D, 0x0C, 0x04, 0x02, 0x01, 0x00, 0x80, 0x04,
+    0x07, 0x3C, 0x36, 0x18, 0x07, 0x80, 0x43, 0x61, 0xF0, 0x02, 0x09, 0x30, 0x18, 0x1F, 0x06, 0x03,
+    0x01, 0x80, 0xC0, 0x60, 0x1C, 0x00, 0x04, 0x07, 0x6C, 0x36, 0x1B, 0x0D, 0x86, 0xC3, 0x60, 0xF0,
+    0x04, 0x07, 0xC6, 0x32, 0x1B, 0x05, 0x82, 0x81, 0xC0, 0xE0, 0x04, 0x07, 0xC2, 0x61, 0x35, 0x8B,
+    0xC6, 0xC3, 0x61, 0xB0, 0x04, 0x07, 0x6E, 0x16, 0x0E, 0x03, 0x03, 0x83, 0x63, 0x98, 0x04, 0x0A,
+    0xC6, 0x32, 0x1B, 0x05, 0x83, 0x81, 0xC0, 0x60, 0x20, 0x30, 0x30, 0x00, 0x04, 0x07, 0x7C, 0x06,
+    0x03, 0x03, 0x03, 0x03, 0x01, 0xF0, 0x01, 0x0C, 0x1C, 0x0C, 0x04, 0x02, 0x01, 0x03, 0x80, 0xC0,
+    0x20, 0x10, 0x08, 0x06, 0x03, 0x80, 0x01, 0x0D, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x80, 0x40,
+    0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x01, 0x0C, 0x70, 0x18, 0x04, 0x02, 0x01, 0x80, 0x60,
+    0x60, 0x20, 0x10, 0x08, 0x04, 0x0E, 0x00, 0x06, 0x03, 0x60, 0x69, 0x07, 0x00,
+};
+
+static const uint16_t font_meslo_9_offsets[] = {
+    0, 2, 15, 21, 34, 49, 62, 75, 81, 96, 111, 121,
+    131, 138, 142, 147, 161, 174, 187, 200, 213, 226, 239, 252,
+    265, 278, 291, 300, 311, 320, 327, 336, 349, 363, 376, 389,
+    402, 415, 428, 441, 454, 467, 480, 493, 506, 519, 532, 545,
+    558, 571, 586, 599, 612, 625, 638, 651, 664, 677, 690, 703,
+    718, 732, 747, 754, 758, 764, 774, 788, 798, 812, 822, 836,
+    850, 864, 878, 895, 909, 923, 933, 943, 953, 967, 981, 991,
+    1001, 1014, 1024, 1034, 1044, 1054, 1068, 1078, 1094, 1111, 1127,
+};
+
+static const epaper_packed_font_t font_meslo_9_packed = {
+    font_meslo_9_glyphs,
+    font_meslo_9_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_meslo_9 = {
+    9, /* width */
+    14, /* height */
+    NULL,
+    &font_meslo_9_packed,
+};
+
+/* 8x15, 1425 bytes unpacked */
+static const uint8_t font_meslo_10_glyphs[] = {
+    0x00, 0x00, 0x02, 0x0A, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x02, 0x04,
+    0x64, 0x64, 0x64, 0x64, 0x02, 0x0A, 0x12, 0x16, 0x7F, 0x7F, 0x24, 0x2C, 0xFE, 0xFE, 0x68, 0x58,
+    0x01, 0x0D, 0x10, 0x10, 0x3C, 0x7C, 0x70, 0x70, 0x3C, 0x16, 0x16, 0x7E, 0x7C, 0x10, 0x10, 0x02,
+    0x0A, 0x60, 0xF0, 0x90, 0xF2, 0x6C, 0x34, 0x4E, 0x09, 0x0F, 0x0E, 0x02, 0x0A, 0x3C, 0x7C, 0x60,
+    0x30, 0x70, 0x5B, 0xCF, 0xCE, 0x7E, 0x3B, 0x02, 0x04, 0x18, 0x18, 0x18, 0x18, 0x01, 0x0D, 0x0C,
+    0x08, 0x18, 0x18, 0x10, 0x30, 0x30, 0x30, 0x10, 0x18, 0x18, 0x08, 0x0C, 0x01, 0x0D, 0x30, 0x10,
+    0x18, 0x18, 0x18, 0x08, 0x08, 0x08, 0x18, 0x18, 0x18, 0x10, 0x30, 0x02, 0x08, 0x10, 0x92, 0xD6,
+    0x3C, 0x3C, 0xF6, 0x92, 0x10, 0x03, 0x08, 0x18, 0x18, 0x18, 0xFE, 0xFE, 0x18, 0x18, 0x18, 0x09,
+    0x05, 0x18, 0x18, 0x18, 0x10, 0x30, 0x07, 0x02, 0x7E, 0x7E, 0x09, 0x03, 0x18, 0x18, 0x18, 0x02,
+    0x0C, 0x06, 0x04, 0x04, 0x0C, 0x08, 0x18, 0x10, 0x30, 0x20, 0x20, 0x60, 0x40, 0x02, 0x0A, 0x3C,
+    0x7C, 0x66, 0x6E, 0x6E, 0x76, 0x66, 0x66, 0x7C, 0x3C, 0x02, 0x0A, 0x38, 0x78, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x7E, 0x7E, 0x02, 0x0A, 0x7C, 0x7C, 0x46, 0x06, 0x0C, 0x18, 0x38, 0x30, 0x7E,
+    0x7E, 0x02, 0x0A, 0x7C, 0x7E, 0x06, 0x3C, 0x3C, 0x06, 0x06, 0x06, 0x7E, 0x7C, 0x02, 0x0A, 0x0C,
+    0x1C, 0x1C, 0x3C, 0x6C, 0x4C, 0x7E, 0x7E, 0x0C, 0x0C, 0x02, 0x0A, 0x7C, 0x7C, 0x60, 0x7C, 0x7C,
+    0x06, 0x06, 0x06, 0x7C, 0x78, 0x02, 0x0A, 0x1E, 0x3E, 0x60, 0x7C, 0x7E, 0x66, 0x66, 0x66, 0x7E,
+    0x3C, 0x02, 0x0A, 0x7E, 0x7E, 0x04, 0x0C, 0x0C, 0x18, 0x18, 0x18, 0x30, 0x30, 0x02, 0x0A, 0x3C,
+    0x7E, 0x66, 0x7C, 0x3C, 0x66, 0x66, 0x66, 0x7E, 0x3C, 0x02, 0x0A, 0x3C, 0x7C, 0x66, 0x66, 0x7E,
+    0x3E, 0x06, 0x06, 0x7C, 0x78, 0x04, 0x08, 0x18, 0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x18, 0x04,
+    0x0A, 0x18, 0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x18, 0x10, 0x30, 0x04, 0x07, 0x02, 0x1E, 0x78,
+    0x40, 0x78, 0x1E, 0x02, 0x05, 0x05, 0x7E, 0x7E, 0x00, 0x7E, 0x7E, 0x04, 0x07, 0x40, 0x70, 0x1E,
+    0x02, 0x1E, 0x78, 0x40, 0x02, 0x0A, 0x3C, 0x7E, 0x46, 0x04, 0x0C, 0x18, 0x18, 0x10, 0x10, 0x10,
+    0x02, 0x0C, 0x3C, 0x7E, 0x42, 0xDE, 0x9E, 0xB2, 0xB2, 0x92, 0xDE, 0x60, 0x7E, 0x1E, 0x02, 0x0A,
+    0x18, 0x38, 0x3C, 0x3C, 0x2C, 0x64, 0x7E, 0x7E, 0x46, 0xC3, 0x02, 0x0A, 0x7C, 0x7E, 0x66, 0x7E,
+    0x7C, 0x66, 0x66, 0x66, 0x7E, 0x7C, 0x02, 0x0A, 0x1E, 0x3E, 0x62, 0x60, 0x60, 0x60, 0x60, 0x62,
+    0x3E, 0x1E, 0x02, 0x0A, 0x78, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7C, 0x78, 0x02, 0x0A,
+    0x7E, 0x7E, 0x60, 0x60, 0x7E, 0x7E, 0x60, 0x60, 0x7E, 0x7E, 0x02, 0x0A, 0x7E, 0x7E, 0x60, 0x60,
+    0x7E, 0x7E, 0x60, 0x60, 0x60, 0x60, 0x02, 0x0A, 0x1E, 0x3E, 0x62, 0x60, 0x6E, 0x6E, 0x62, 0x62,
+    0x3E, 0x1E, 0x02, 0x0A, 0x66, 0x66, 0x66, 0x7E, 0x7E, 0x66, 0x66, 0x66, 0x66, 0x66, 0x02, 0x0A,
+    0x7E, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E, 0x7E, 0x02, 0x0A, 0x3C, 0x3C, 0x04, 0x04,
+    0x04, 0x04, 0x04, 0x4C, 0x7C, 0x78, 0x02, 0x0A, 0x67, 0x6E, 0x6C, 0x78, 0x78, 0x78, 0x6C, 0x6C,
+    0x66, 0x67, 0x02, 0x0A, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x7E, 0x7E, 0x02, 0x0A,
+    0x66, 0x66, 0x6E, 0x5A, 0x5A, 0x5A, 0x42, 0x42, 0x42, 0x42, 0x02, 0x0A, 0x66, 0x66, 0x76, 0x56,
+    0x56, 0x5E, 0x4E, 0x4E, 0x46, 0x46, 0x02, 0x0A, 0x3C, 0x7E, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x7E, 0x3C, 0x02, 0x0A, 0x7C, 0x7E, 0x66, 0x66, 0x7E, 0x7C, 0x60, 0x60, 0x60, 0x60, 0x02, 0x0C,
+    0x3C, 0x7E, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7E, 0x3C, 0x06, 0x04, 0x02, 0x0A, 0x7C, 0x7E,
+    0x66, 0x66, 0x7C, 0x7C, 0x6C, 0x66, 0x66, 0x63, 0x02, 0x0A, 0x3C, 0x7E, 0x62, 0x60, 0x78, 0x1E,
+    0x06, 0x46, 0x7E, 0x7C, 0x02, 0x0A, 0x7E, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x02, 0x0A, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7E, 0x3C, 0x02, 0x0A, 0xC6, 0x66,
+    0x66, 0x66, 0x64, 0x2C, 0x3C, 0x3C, 0x3C, 0x38, 0x02, 0x0A, 0xC3, 0xC3, 0xDB, 0xDA, 0x5A, 0x5A,
+    0x7E, 0x66, 0x66, 0x66, 0x02, 0x0A, 0xC7, 0x66, 0x3C, 0x3C, 0x18, 0x18, 0x3C, 0x2C, 0x66, 0xC7,
+    0x02, 0x0A, 0xC3, 0x66, 0x66, 0x3C, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x18, 0x02, 0x0A, 0x7E, 0x7E,
+    0x0E, 0x0C, 0x18, 0x18, 0x30, 0x60, 0x7E, 0x7E, 0x01, 0x0D, 0x1C, 0x1C, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x1C, 0x1C, 0x02, 0x0C, 0x40, 0x60, 0x20, 0x30, 0x10, 0x18, 0x08,
+    0x08, 0x0C, 0x04, 0x06, 0x02, 0x01, 0x0D, 0x38, 0x38, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x38, 0x38, 0x02, 0x04, 0x18, 0x3C, 0x64, 0xC6, 0x0D, 0x02, 0xFF, 0xFF, 0x00, 0x03,
+    0x60, 0x30, 0x18, 0x04, 0x08, 0x3C, 0x7E, 0x06, 0x3E, 0x7E, 0x66, 0x66, 0x7E, 0x01, 0x0B, 0x60,
+    0x60, 0x60, 0x7C, 0x7E, 0x66, 0x66, 0x66, 0x66, 0x7E, 0x7C, 0x04, 0x08, 0x1E, 0x3E, 0x60, 0x60,
+    0x60, 0x60, 0x3E, 0x1E, 0x01, 0x0B, 0x06, 0x06, 0x06, 0x36, 0x7E, 0x66, 0x46, 0x46, 0x66, 0x7E,
+    0x36, 0x04, 0x08, 0x3C, 0x7E, 0x66, 0x7E, 0x7E, 0x60, 0x7E, 0x3E, 0x01, 0x0B, 0x1E, 0x1E, 0x18,
+    0x7E, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x04, 0x0B, 0x3E, 0x7E, 0x66, 0x66, 0x66, 0x66,
+    0x7E, 0x3E, 0x06, 0x7E, 0x7C, 0x01, 0x0B, 0x60, 0x60, 0x60, 0x7C, 0x7E, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x01, 0x0B, 0x18, 0x18, 0x00, 0x78, 0x78, 0x18, 0x18, 0x18, 0x18, 0x7E, 0x7E, 0x01,
+    0x0E, 0x08, 0x08, 0x00, 0x38, 0x38, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x18, 0x78, 0x78, 0x01,
+    0x0B, 0x60, 0x60, 0x60, 0x66, 0x6C, 0x78, 0x78, 0x6C, 0x6C, 0x66, 0x67, 0x01, 0x0B, 0x70, 0x70,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x1E, 0x1E, 0x04, 0x08, 0x76, 0x7E, 0x5A, 0x5A, 0x5A,
+    0x5A, 0x5A, 0x5A, 0x04, 0x08, 0x7C, 0x7E, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x04, 0x08, 0x3C,
+    0x7E, 0x66, 0x66, 0x66, 0x66, 0x7E, 0x3C, 0x04, 0x0B, 0x7C, 0x7E, 0x66, 0x66, 0x66, 0x66, 0x7E,
+    0x7C, 0x60, 0x60, 0x60, 0x04, 0x0B, 0x36, 0x7E, 0x66, 0x46, 0x46, 0x66, 0x7E, 0x36, 0x06, 0x06,
+    0x06, 0x04, 0x08, 0x3E, 0x3E, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x04, 0x08, 0x3C, 0x7C, 0x60,
+    0x78, 0x1C, 0x06, 0x7E, 0x7C, 0x02, 0x0A, 0x10, 0x10, 0x7E, 0x7E, 0x10, 0x10, 0x10, 0x10, 0x1E,
+    0x1E, 0x04, 0x08, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7E, 0x36, 0x04, 0x08, 0x66, 0x66, 0x66,
+    0x64, 0x2C, 0x3C, 0x38, 0x18, 0x04, 0x08, 0xC3, 0xC3, 0xDA, 0x5A, 0x5A, 0x5A, 0x6E, 0x66, 0x04,
+    0x08, 0x66, 0x6C, 0x3C, 0x18, 0x18, 0x3C, 0x66, 0xE6, 0x04, 0x0B, 0xC6, 0x66, 0x66, 0x2C, 0x3C,
+    0x3C, 0x18, 0x18, 0x18, 0x70, 0x70, 0x04, 0x08, 0x7E, 0x7E, 0x0C, 0x18, 0x38, 0x30, 0x7E, 0x7E,
+    0x01, 0x0E, 0x0E, 0x1E, 0x18, 0x18, 0x18, 0x18, 0x70, 0x78, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x0E,
+    0x01, 0x0E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x01, 0x0E, 0x70, 0x78, 0x18, 0x18, 0x18, 0x18, 0x0E, 0x1E, 0x18, 0x18, 0x18, 0x18, 0x78, 0x70,
+    0x06, 0x04, 0x70, 0xF3, 0x9E, 0x0E,
+};
+
+static const uint16_t font_meslo_10_offsets[] = {
+    0, 2, 14, 20, 32, 47, 59, 71, 77, 92, 107, 117,
+    127, 134, 138, 143, 157, 169, 181, 193, 205, 217, 229, 241,
+    253, 265, 277, 287, 299, 308, 315, 324, 336, 350, 362, 374,
+    386, 398, 410, 422, 434, 446, 458, 470, 482, 494, 506, 518,
+    530, 542, 556, 568, 580, 592, 604, 616, 628, 640, 652, 664,
+    679, 693, 708, 714, 718, 723, 733, 746, 756, 769, 779, 792,
+    805, 818, 831, 847, 860, 873, 883, 893, 903, 916, 929, 939,
+    949, 961, 971, 981, 991, 1001, 1014, 1024, 1040, 1056, 1072,
+};
+
+static const epaper_packed_font_t font_meslo_10_packed = {
+    font_meslo_10_glyphs,
+    font_meslo_10_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_meslo_10 = {
+    8, /* width */
+    15, /* height */
+    NULL,
+    &font_meslo_10_packed,
+};
+
+/* 11x18, 3420 bytes unpacked */
+static const uint8_t font_meslo_11_glyphs[] = {
+    0x00, 0x00, 0x02, 0x0C, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x10, 0x02, 0x00, 0x40, 0x00,
+    0x00, 0x00, 0x30, 0x06, 0x00, 0x02, 0x04, 0x36, 0x06, 0xC0, 0xD8, 0x1B, 0x00, 0x02, 0x0C, 0x19,
+    0x03, 0x60, 0x6C, 0x3F, 0xC7, 0xF8, 0x6C, 0x0D, 0x87, 0xF8, 0xFF, 0x0C, 0x81, 0xB0, 0x36, 0x00,
+    0x02, 0x0F, 0x08, 0x01, 0x00, 0xF8, 0x1F, 0x06, 0x90, 0xD0, 0x0F, 0x00, 0xF8, 0x0B, 0x09, 0x61,
+    0xFC, 0x1F, 0x00, 0x80, 0x10, 0x02, 0x00, 0x02, 0x0C, 0x70, 0x0F, 0x03, 0x60, 0x6C, 0x07, 0x98,
+    0xEE, 0x07, 0x03, 0x38, 0x4F, 0x81, 0x90, 0x3E, 0x03, 0x80, 0x02, 0x0C, 0x1E, 0x07, 0xC0, 0xC0,
+    0x18, 0x03, 0x00, 0xF0, 0x1F, 0x66, 0x6C, 0xC7, 0x9C, 0xE1, 0xFC, 0x1E, 0xC0, 0x02, 0x04, 0x08,
+    0x01, 0x00, 0x20, 0x04, 0x00, 0x02, 0x0E, 0x06, 0x01, 0x80, 0x30, 0x0C, 0x01, 0x80, 0x30, 0x06,
+    0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x06, 0x00, 0xC0, 0x0C, 0x00, 0x02, 0x0E, 0x30, 0x03, 0x00,
+    0x60, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x0C, 0x01, 0x80, 0x60,
+    0x00, 0x02, 0x09, 0x08, 0x01, 0x03, 0x26, 0x3F, 0x01, 0xC0, 0x7C, 0x32, 0xE0, 0x40, 0x08, 0x00,
+    0x04, 0x09, 0x08, 0x01, 0x00, 0x20, 0x04, 0x0F, 0xF9, 0xFF, 0x02, 0x00, 0x40, 0x08, 0x00, 0x0B,
+    0x05, 0x1C, 0x03, 0x80, 0x60, 0x0C, 0x01, 0x00, 0x08, 0x02, 0x7F, 0x8F, 0xF0, 0x0B, 0x03, 0x1C,
+    0x03, 0x80, 0x70, 0x00, 0x02, 0x0D, 0x03, 0x00, 0x60, 0x18, 0x03, 0x00, 0x40, 0x18, 0x02, 0x00,
+    0xC0, 0x10, 0x06, 0x00, 0xC0, 0x30, 0x06, 0x00, 0x02, 0x0C, 0x1C, 0x07, 0xC1, 0xDC, 0x33, 0x86,
+    0x70, 0xD6, 0x1A, 0xC3, 0x98, 0x73, 0x0E, 0xE0, 0xF8, 0x0E, 0x00, 0x02, 0x0C, 0x3C, 0x07, 0x80,
+    0xB0, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x81, 0xFC, 0x3F, 0x80, 0x02, 0x0C,
+    0x7C, 0x0F, 0xC1, 0x1C, 0x01, 0x80, 0x70, 0x0C, 0x03, 0x00, 0xE0, 0x38, 0x0E, 0x01, 0xFC, 0x3F,
+    0x80, 0x02, 0x0C, 0x7C, 0x0F, 0xC1, 0x1C, 0x01, 0x80, 0x70, 0x3C, 0x07, 0x80, 0x18, 0x03, 0x08,
+    0x61, 0xFC, 0x3F, 0x00, 0x02, 0x0C, 0x06, 0x01, 0xC0, 0x78, 0x0B, 0x03, 0x60, 0x4C, 0x19, 0x83,
+    0xF8, 0x7F, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x02, 0x0C, 0x7E, 0x0F, 0xC1, 0x80, 0x30, 0x07, 0xC0,
+    0xFC, 0x11, 0xC0, 0x18, 0x03, 0x08, 0xE1, 0xF8, 0x3E, 0x00, 0x02, 0x0C, 0x1F, 0x07, 0xE0, 0xC4,
+    0x30, 0x07, 0xE0, 0xFE, 0x1C, 0xC3, 0x18, 0x63, 0x0E, 0x60, 0xFC, 0x0F, 0x00, 0x02, 0x0C, 0x7F,
+    0x0F, 0xE0, 0x1C, 0x03, 0x00, 0x60, 0x18, 0x03, 0x00, 0x60, 0x18, 0x03, 0x00, 0x60, 0x18, 0x00,
+    0x02, 0x0C, 0x1C, 0x07, 0xC1, 0x8C, 0x31, 0x86, 0x30, 0x7C, 0x0F, 0x83, 0x18, 0x63, 0x0C, 0x61,
+    0xFC, 0x1F, 0x00, 0x02, 0x0C, 0x3C, 0x0F, 0xC1, 0x9C, 0x31, 0x86, 0x30, 0xCE, 0x1F, 0xC1, 0xD8,
+    0x03, 0x08, 0xE1, 0xF8, 0x3E, 0x00, 0x06, 0x08, 0x1C, 0x03, 0x80, 0x70, 0x00, 0x00, 0x00, 0x38,
+    0x07, 0x00, 0xE0, 0x05, 0x0B, 0x1C, 0x03, 0x80, 0x70, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0xE0,
+    0x1C, 0x03, 0x00, 0x60, 0x00, 0x05, 0x08, 0x01, 0x01, 0xE0, 0xF0, 0x38, 0x07, 0x00, 0x7C, 0x03,
+    0xC0, 0x08, 0x06, 0x06, 0x7F, 0x0F, 0xE0, 0x00, 0x00, 0x07, 0xF0, 0xFE, 0x00, 0x05, 0x08, 0x40,
+    0x0F, 0x00, 0x78, 0x03, 0x80, 0x70, 0x7C, 0x1E, 0x02, 0x00, 0x02, 0x0C, 0x3E, 0x07, 0xE0, 0x8C,
+    0x01, 0x80, 0x60, 0x18, 0x07, 0x00, 0xC0, 0x18, 0x00, 0x00, 0x60, 0x0C, 0x00, 0x02, 0x0E, 0x1E,
+    0x07, 0xE1, 0x8C, 0x20, 0x8C, 0xF1, 0xBE, 0x36, 0x46, 0x88, 0xD9, 0x1B, 0xE1, 0x3C, 0x30, 0x03,
+    0xF0, 0x3E, 0x00, 0x02, 0x0C, 0x1C, 0x03, 0x80, 0x50, 0x1B, 0x03, 0x60, 0x6C, 0x0D, 0x83, 0xF8,
+    0x7F, 0x0C, 0x61, 0x8C, 0x70, 0xC0, 0x02, 0x0C, 0x7E, 0x0F, 0xE1, 0x8C, 0x31, 0x86, 0x30, 0xFC,
+    0x1F, 0xC3, 0x18, 0x63, 0x0C, 0x61, 0xFC, 0x3F, 0x00, 0x02, 0x0C, 0x1F, 0x07, 0xE0, 0xC4, 0x38,
+    0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x70, 0x06, 0x20, 0xFC, 0x0F, 0x80, 0x02, 0x0C, 0x7C, 0x0F,
+    0xC1, 0x9C, 0x31, 0x86, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0x0C, 0xE1, 0xF8, 0x3E, 0x00, 0x02,
+    0x0C, 0x7F, 0x0F, 0xE1, 0x80, 0x30, 0x06, 0x00, 0xFE, 0x1F, 0xC3, 0x00, 0x60, 0x0C, 0x01, 0xFC,
+    0x3F, 0x80, 0x02, 0x0C, 0x7F, 0x0F, 0xE1, 0xC0, 0x38, 0x07, 0x00, 0xFE, 0x1F, 0xC3, 0x80, 0x70,
+    0x0E, 0x01, 0xC0, 0x38, 0x00, 0x02, 0x0C, 0x1F, 0x07, 0xE1, 0xC4, 0x30, 0x06, 0x00, 0xCE, 0x19,
+    0xC3, 0x18, 0x63, 0x0E, 0x60, 0xFC, 0x0F, 0x00, 0x02, 0x0C, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x86,
+    0x30, 0xFE, 0x1F, 0xC3, 0x18, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x80, 0x02, 0x0C, 0x7F, 0x0F, 0xE0,
+    0x70, 0x0E, 0x01, 0xC0, 0x38, 0x07, 0x00, 0xE0, 0x1C, 0x03, 0x81, 0xFC, 0x3F, 0x80, 0x02, 0x0C,
+    0x1E, 0x03, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x08, 0xC1, 0xF8, 0x3E,
+    0x00, 0x02, 0x0C, 0x63, 0x8C, 0xE1, 0x98, 0x36, 0x07, 0xC0, 0xF8, 0x1F, 0x03, 0x70, 0x66, 0x0C,
+    0xE1, 0x8C, 0x31, 0xC0, 0x02, 0x0C, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01,
+    0x80, 0x30, 0x06, 0x00, 0xFC, 0x1F, 0x80, 0x02, 0x0C, 0xE3, 0x1E, 0xE3, 0xDC, 0x6A, 0x8D, 0x51,
+    0xBA, 0x37, 0x46, 0x48, 0xC1, 0x18, 0x23, 0x04, 0x60, 0x80, 0x02, 0x0C, 0x63, 0x0E, 0x61, 0xCC,
+    0x39, 0x87, 0xB0, 0xD6, 0x1A, 0xC3, 0x78, 0x67, 0x0C, 0xE1, 0x9C, 0x31, 0x80, 0x02, 0x0C, 0x1C,
+    0x07, 0xC1, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0x0C, 0x60, 0xF8, 0x0E, 0x00,
+    0x02, 0x0C, 0x7E, 0x0F, 0xE1, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x1F, 0xC3, 0xE0, 0x60, 0x0C, 0x01,
+    0x80, 0x30, 0x00, 0x02, 0x0E, 0x1C, 0x07, 0xC1, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x18, 0xC3, 0x18,
+    0x63, 0x0C, 0x60, 0xF8, 0x0F, 0x00, 0x70, 0x04, 0x00, 0x02, 0x0C, 0x7E, 0x0F, 0xE1, 0x8C, 0x31,
+    0x86, 0x30, 0xFC, 0x1F, 0x03, 0x30, 0x66, 0x0C, 0x61, 0x8C, 0x31, 0xC0, 0x02, 0x0C, 0x3E, 0x0F,
+    0xE1, 0x84, 0x30, 0x07, 0x00, 0x7C, 0x07, 0xC0, 0x38, 0x03, 0x08, 0x61, 0xFC, 0x1F, 0x00, 0x02,
+    0x0C, 0x7F, 0x0F, 0xE0, 0x70, 0x0E, 0x01, 0xC0, 0x38, 0x07, 0x00, 0xE0, 0x1C, 0x03, 0x80, 0x70,
+    0x0E, 0x00, 0x02, 0x0C, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x63,
+    0x0C, 0x61, 0xFC, 0x1F, 0x00, 0x02, 0x0C, 0xE3, 0x8C, 0x61, 0x8C, 0x31, 0x86, 0x30, 0x6C, 0x0D,
+    0x81, 0xB0, 0x36, 0x06, 0xC0, 0x70, 0x0E, 0x00, 0x02, 0x0C, 0xC1, 0x98, 0x33, 0x06, 0x66, 0xC5,
+    0xD8, 0xBA, 0x15, 0x43, 0xA8, 0x75, 0x0E, 0xE1, 0xDC, 0x31, 0x80, 0x02, 0x0C, 0xE3, 0x8C, 0x60,
+    0xD8, 0x1B, 0x01, 0xC0, 0x38, 0x07, 0x00, 0xE0, 0x36, 0x06, 0xE1, 0x8C, 0x71, 0xC0, 0x02, 0x0C,
+    0xE3, 0x8C, 0x61, 0x8C, 0x1B, 0x03, 0x60, 0x38, 0x07, 0x00, 0xE0, 0x1C, 0x03, 0x80, 0x70, 0x0E,
+    0x00, 0x02, 0x0C, 0x7F, 0x0F, 0xE0, 0x1C, 0x03, 0x00, 0xE0, 0x18, 0x07, 0x01, 0xC0, 0x30, 0x0E,
+    0x01, 0xFE, 0x3F, 0xC0, 0x02, 0x0F, 0x1E, 0x03, 0xC0, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00,
+    0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x3C, 0x07, 0x80, 0x02, 0x0D, 0x60, 0x0C, 0x00,
+    0xC0, 0x18, 0x01, 0x00, 0x30, 0x02, 0x00, 0x60, 0x04, 0x00, 0xC0, 0x18, 0x01, 0x80, 0x30, 0x02,
+    0x0F, 0x3C, 0x07, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30,
+    0x06, 0x00, 0xC0, 0x78, 0x0F, 0x00, 0x02, 0x05, 0x1C, 0x03, 0x80, 0xD8, 0x31, 0x8C, 0x18, 0x0F,
+    0x02, 0xFF, 0x9F, 0xF0, 0x01, 0x03, 0x70, 0x03, 0x00, 0x30, 0x00, 0x05, 0x09, 0x3E, 0x0F, 0xE1,
+    0x0C, 0x1F, 0x87, 0xF0, 0xC6, 0x18, 0xC3, 0xF8, 0x3B, 0x00, 0x02, 0x0C, 0x60, 0x0C, 0x01, 0x80,
+    0x37, 0x07, 0xF0, 0xE6, 0x18, 0xC3, 0x18, 0x63, 0x0E, 0x61, 0xFC, 0x37, 0x00, 0x05, 0x09, 0x1E,
+    0x07, 0xE0, 0xC4, 0x38, 0x06, 0x00, 0xE0, 0x0C, 0x41, 0xF8, 0x1E, 0x00, 0x02, 0x0C, 0x03, 0x00,
+    0x60, 0x0C, 0x1D, 0x87, 0xF0, 0xCE, 0x18, 0xC3, 0x18, 0x63, 0x0C, 0xE1, 0xFC, 0x1D, 0x80, 0x05,
+    0x09, 0x1E, 0x0F, 0xE1, 0x8C, 0x3F, 0x87, 0xF0, 0xC0, 0x18, 0x43, 0xF8, 0x1F, 0x00, 0x02, 0x0C,
+    0x0F, 0x03, 0xE0, 0x60, 0x3F, 0x87, 0xF0, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C,
+    0x00, 0x05, 0x0C, 0x3B, 0x0F, 0xE1, 0x9C, 0x31, 0x86, 0x30, 0xC6, 0x19, 0xC3, 0xF8, 0x3B, 0x00,
+    0x60, 0xFC, 0x1F, 0x00, 0x02, 0x0C, 0x60, 0x0C, 0x01, 0x80, 0x37, 0x07, 0xF0, 0xE6, 0x18, 0xC3,
+    0x18, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x80, 0x01, 0x0D, 0x0C, 0x01, 0x80, 0x30, 0x00, 0x03, 0xC0,
+    0x78, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x3F, 0xC7, 0xF8, 0x00, 0x11, 0x0C, 0x01, 0x80,
+    0x30, 0x00, 0x00, 0x00, 0x78, 0x0F, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18,
+    0x03, 0x03, 0xE0, 0x78, 0x00, 0x02, 0x0C, 0x60, 0x0C, 0x01, 0x80, 0x31, 0xC6, 0x60, 0xD8, 0x1F,
+    0x03, 0xE0, 0x76, 0x0C, 0xC1, 0x8C, 0x31, 0xC0, 0x02, 0x0C, 0x78, 0x0F, 0x00, 0x60, 0x0C, 0x01,
+    0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x7C, 0x07, 0x80, 0x05, 0x09, 0xDF, 0x1F, 0xE3,
+    0x24, 0x64, 0x8C, 0x91, 0x92, 0x32, 0x46, 0x48, 0xC9, 0x00, 0x05, 0x09, 0x6E, 0x0F, 0xE1, 0xCC,
+    0x31, 0x86, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0x00, 0x05, 0x09, 0x1C, 0x07, 0xE1, 0x8C, 0x31,
+    0x86, 0x30, 0xC6, 0x18, 0xC1, 0xF8, 0x1C, 0x00, 0x05, 0x0C, 0x6E, 0x0F, 0xE1, 0xCC, 0x31, 0x86,
+    0x30, 0xC6, 0x1C, 0xC3, 0xF8, 0x6E, 0x0C, 0x01, 0x80, 0x30, 0x00, 0x05, 0x0C, 0x3B, 0x0F, 0xE1,
+    0x9C, 0x31, 0x86, 0x30, 0xC6, 0x19, 0xC3, 0xF8, 0x3B, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x05, 0x09,
+    0x37, 0x07, 0xE0, 0xE4, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x00, 0x05, 0x09, 0x3E,
+    0x0F, 0xC1, 0x84, 0x38, 0x03, 0xE0, 0x0E, 0x10, 0xC3, 0xF8, 0x3E, 0x00, 0x02, 0x0C, 0x18, 0x03,
+    0x00, 0x60, 0x3F, 0x87, 0xF0, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x7C, 0x07, 0x80, 0x05,
+    0x09, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x19, 0xC3, 0xF8, 0x3B, 0x00, 0x05, 0x09,
+    0x63, 0x0C, 0x61, 0x8C, 0x1B, 0x03, 0x60, 0x6C, 0x0D, 0x80, 0xE0, 0x1C, 0x00, 0x05, 0x09, 0xC1,
+    0x98, 0x33, 0x26, 0x2E, 0x85, 0x50, 0xEE, 0x1D, 0xC3, 0xB8, 0x77, 0x00, 0x05, 0x09, 0x63, 0x06,
+    0xC0, 0xD8, 0x0E, 0x01, 0xC0, 0x38, 0x0D, 0x83, 0xB8, 0xE3, 0x80, 0x05, 0x0C, 0xE3, 0x8C, 0x61,
+    0xCC, 0x1B, 0x03, 0x60, 0x7C, 0x07, 0x00, 0xE0, 0x0C, 0x03, 0x01, 0xE0, 0x38, 0x00, 0x05, 0x09,
+    0x7F, 0x0F, 0xE0, 0x18, 0x07, 0x01, 0xC0, 0x70, 0x0C, 0x03, 0xF8, 0x7F, 0x00, 0x02, 0x0F, 0x0F,
+    0x01, 0xE0, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x06, 0x03, 0xC0, 0x78, 0x03, 0x00, 0x30, 0x06, 0x00,
+    0xC0, 0x1E, 0x03, 0xC0, 0x02, 0x10, 0x08, 0x01, 0x00, 0x20, 0x04, 0x00, 0x80, 0x10, 0x02, 0x00,
+    0x40, 0x08, 0x01, 0x00, 0x20, 0x04, 0x00, 0x80, 0x10, 0x02, 0x00, 0x40, 0x02, 0x0F, 0x78, 0x0F,
+    0x00, 0x60, 0x0C, 0x01, 0x80, 0x10, 0x03, 0x00, 0x78, 0x0F, 0x01, 0x80, 0x60, 0x0C, 0x01, 0x80,
+    0xF0, 0x1E, 0x00, 0x07, 0x05, 0x30, 0x0F, 0x23, 0x66, 0x47, 0x80, 0x60,
+};
+
+static const uint16_t font_meslo_11_offsets[] = {
+    0, 2, 21, 29, 48, 71, 90, 109, 117, 139, 161, 176,
+    191, 200, 205, 212, 232, 251, 270, 289, 308, 327, 346, 365,
+    384, 403, 422, 435, 453, 466, 477, 490, 509, 531, 550, 569,
+    588, 607, 626, 645, 664, 683, 702, 721, 740, 759, 778, 797,
+    816, 835, 857, 876, 895, 914, 933, 952, 971, 990, 1009, 1028,
+    1051, 1071, 1094, 1103, 1108, 1115, 1130, 1149, 1164, 1183, 1198, 1217,
+    1236, 1255, 1275, 1301, 1320, 1339, 1354, 1369, 1384, 1403, 1422, 1437,
+    1452, 1471, 1486, 1501, 1516, 1531, 1550, 1565, 1588, 1612, 1635,
+};
+
+static const epaper_packed_font_t font_meslo_11_packed = {
+    font_meslo_11_glyphs,
+    font_meslo_11_offsets,
+    0x20,
+    0x7E,
+};
+
+epaper_font_t epaper_font_meslo_11 = {
+    11, /* width */
+    18, /* height */
+    NULL,
+    &font_meslo_11_packed,
+};
@@ -20,13 +20,28 @@ extern "C"
 #endif
 #include "driver/spi_master.h"
 
+/* Font packed by tools/pack_fonts.py: each glyph is its first inked row, its inked row count, then the inked rows
+ * with `width` bits each, MSB first */
+typedef struct
+{
+    const uint8_t *glyphs;
+    const uint16_t *offsets;    /* Offset of each glyph in glyphs */
+    uint8_t first_char;
+    uint8_t last_char;
+} epaper_packed_font_t;
+
 typedef struct
 {
     uint16_t width;
     uint16_t height;
-    const uint8_t *font_table;
+    const uint8_t *font_table;  /* FontEdit table, NULL for a packed font */
+    const epaper_packed_font_t *packed;
 } epaper_font_t;
 
+/* Glyphs of the packed fonts decoded in RAM, for the characters drawn recently */
+#define EPAPER_GLYPH_CACHE_SIZE 8
+#define EPAPER_GLYPH_MAX_SIZE   128
+
 #define BLACK_COLORED   0
 #define RED_COLORED     1
 #define UNCOLORED       2
@@ -83,6 +98,9 @@ typedef struct
 
 #define pgm_read_byte(addr) (*(const unsigned char *)(addr))
 
+/* Maximum number of dirty rectangles tracked between two refreshes */
+#define EPAPER_MAX_DIRTY_RECTS 4
+
 #define GxEPD_WHITE     0xFFFF
 #define GxEPD_BLACK     0x0000
 
@@ -474,6 +492,27 @@ void iot_PowerOff(epaper_handle_t dev);
  */
 void iot_epaper_update(epaper_handle_t dev);
 
+/**
+ * @brief  Refresh the regions of the frame buffer changed since the last refresh
+ *
+ * The pixels whose value changed are tracked in up to EPAPER_MAX_DIRTY_RECTS rectangles, and only those rectangles
+ * are refreshed, with the partial waveform. A full refresh is done instead once in a while to clean the ghosting.
+ * The refresh time and the estimated energy are logged.
+ *
+ * @param  dev object handle of epaper
+ *
+ * @return
+ *     - number of regions refreshed, 0 if nothing changed
+ */
+int iot_epaper_update_dirty(epaper_handle_t dev);
+
+/**
+ * @brief  Forget the changed regions of the frame buffer without refreshing them
+ *
+ * @param  dev object handle of epaper
+ */
+void iot_epaper_clear_dirty(epaper_handle_t dev);
+
 /**
  * @brief  Exchange data in preparation for the screen rotation.
  *
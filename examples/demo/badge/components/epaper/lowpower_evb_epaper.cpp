@@ -109,9 +109,9 @@ void epaper_show_page_loop()           //Partial refresh
 
     sprintf(string_show, "Time:%d", time);
     time++;
-    iot_epaper_draw_string(epaper, 50, 110, string_show, &epaper_font_16, 0x0000);
-    iot_epaper_updateWindow(epaper, 50, 110,  100,  18, true);
     iot_drawBitmapBM(epaper, Whiteboard, 50, 110, 100, 18, GxEPD_BLACK, true);
+    iot_epaper_draw_string(epaper, 50, 110, string_show, &epaper_font_16, 0x0000);
+    iot_epaper_update_dirty(epaper);    // only the digits which changed
 
 }
 void epaper_matter_code(void)       //Display Matter pairing
@@ -119,7 +119,7 @@ void epaper_matter_code(void)       //Display Matter pairing
     iot_drawBitmapBM(epaper, Whiteboard, 0, 0, 250, 128, GxEPD_BLACK, true);           //clean paint
     iot_drawBitmapBM(epaper, matter_comminsion, 0, 11, 250, 110, GxEPD_BLACK, true);
     //iot_epaper_update(epaper);                          
-    iot_epaper_updateWindow(epaper, 0, 0,  250,  128, true);   //make screen pure!
+    iot_epaper_update_dirty(epaper);
 }
 
 void epaper_show_page_init(void)   //Display the initial interface
@@ -127,14 +127,14 @@ void epaper_show_page_init(void)   //Display the initial interface
     iot_drawBitmapBM(epaper, matter_logo, 0, 0, 250, 122, GxEPD_BLACK, true);
     iot_epaper_draw_string(epaper, 40, 90, "Badge-Demo", &epaper_font_24, GxEPD_BLACK);
     //iot_epaper_update(epaper);                                
-    iot_epaper_updateWindow(epaper, 0, 0,  250,  128, true);   //make screen pure!
+    iot_epaper_update_dirty(epaper);
 }
 
 void epaper_display_espressif_logo(void)
 {
     // iot_drawBitmapBM(epaper, Whiteboard, 0, 0, 250, 128, GxEPD_BLACK, true);
     iot_drawBitmapBM(epaper, esp_logo, 0, 0, 250, 122, GxEPD_BLACK, true);
-    iot_epaper_updateWindow(epaper, 0, 0,  250,  128, true);   //make screen pure!
+    iot_epaper_update_dirty(epaper);
 }
 
 void epaper_light_power(bool power)
@@ -143,12 +143,12 @@ void epaper_light_power(bool power)
         iot_drawBitmapBM(epaper, Whiteboard, 0, -7, 250, 128, GxEPD_BLACK, true);
         iot_drawBitmapBM(epaper, matter_light_on, 0, 0, 250, 122, GxEPD_BLACK, true);
         iot_epaper_draw_string(epaper, 40, 90, "light On", &epaper_font_24, GxEPD_BLACK);
-        iot_epaper_updateWindow(epaper, 0, 0, 250, 122, true);
+        iot_epaper_update_dirty(epaper);
     } else {
         iot_drawBitmapBM(epaper, Whiteboard, 0, -7, 250, 128, GxEPD_BLACK, true);
         iot_drawBitmapBM(epaper, matter_light_off, 0, 0, 250, 122, GxEPD_BLACK, true);
         iot_epaper_draw_string(epaper, 40, 90, "light Off", &epaper_font_24, GxEPD_BLACK);
-        iot_epaper_updateWindow(epaper, 0, 0, 250, 122, true);
+        iot_epaper_update_dirty(epaper);
     }
 }
 
@@ -156,7 +156,7 @@ void display_commission_qr_code()
 {
     iot_drawBitmapBM(epaper, Whiteboard, 0, 0, 250, 122, GxEPD_BLACK, true);
     iot_drawBitmapBM(epaper, qr_code, 0, -7, 250, 122, GxEPD_BLACK, true);
-    iot_epaper_updateWindow(epaper, 0, 0, 250, 122, true);
+    iot_epaper_update_dirty(epaper);
 }
 
 void display_vcard(char *vcard, uint32_t x_offset, uint32_t y_offset)
@@ -172,12 +172,10 @@ void display_vcard(char *vcard, uint32_t x_offset, uint32_t y_offset)
     }
 }
 
+/* The whole badge is drawn again in the frame buffer, only the text and vCard regions which changed are refreshed */
 void epaper_display_badge(char *name, char *company_name, char *email, char *contact, char *event_name)
 {
     iot_drawBitmapBM(epaper, Whiteboard, 0, -7, 250, 122, GxEPD_BLACK, true);
-    iot_epaper_updateWindow(epaper, 0, 0, 250, 122, true);
-    iot_drawBitmapBM(epaper, Whiteboard, 0, -7, 250, 122, GxEPD_BLACK, true);
-    iot_epaper_updateWindow(epaper, 0, 0, 250, 122, true);
     char *vcard;// = (char*) malloc(sizeof(char) * vcard_size);
     asprintf(&vcard,"BEGIN:VCARD\nVERSION:3.0\nN:%s\nORG:%s\nEMAIL:%s\nTEL;TYPE=voice,work,pref:%s\nEND:VCARD", name, company_name, email, contact);
     display_vcard(vcard, 137, 60);
@@ -195,7 +193,7 @@ void epaper_display_badge(char *name, char *company_name, char *email, char *con
         iot_epaper_draw_string(epaper, 5, 85, event_name_2, &epaper_font_meslo_8, GxEPD_BLACK);
     }
     iot_drawBitmapBM(epaper, esp_logo_1, 195, 60, 53, 53, GxEPD_BLACK, true);
-    iot_epaper_updateWindow(epaper, 0, 0, 250, 122, true);
+    iot_epaper_update_dirty(epaper);
     free(vcard);
 }
 
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Script to generate the packed fonts of the e-paper component from the FontEdit tables of epaper_font.c.
+
+The glyph rows of the FontEdit tables are padded to whole bytes and keep the blank rows above and below the glyph.
+The packed glyphs only keep the rows between the first and the last inked row, with `width` bits per row, which
+roughly halves the size of the fonts. epaper_font.c stays the source of the fonts and is not built, run the script
+again after adding or changing a font there.
+
+Usage: pack_fonts.py [epaper_font.c] [-o epaper_font_packed.c]
+"""
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+FIRST_CHAR = 0x20
+HEADER = '''// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by tools/pack_fonts.py from epaper_font.c, do not edit.
+
+#include "epaper_fonts.h"
+'''
+
+
+def strip_comments(source):
+    source = re.sub(r'/\*.*?\*/', '', source, flags=re.S)
+    return re.sub(r'//[^\n]*', '', source)
+
+
+def parse_fonts(source):
+    source = strip_comments(source)
+    tables = {}
+    for match in re.finditer(r'const\s+uint8_t\s+(\w+)\s*\[\s*\]\s*=\s*\{(.*?)\};', source, flags=re.S):
+        tables[match.group(1)] = [int(value, 16) for value in re.findall(r'0[xX][0-9a-fA-F]+', match.group(2))]
+    fonts = []
+    for match in re.finditer(r'epaper_font_t\s+(\w+)\s*=\s*\{\s*(\d+)\s*,\s*(\d+)\s*,\s*(\w+)\s*,?\s*\};', source):
+        name, width, height, table = match.group(1), int(match.group(2)), int(match.group(3)), match.group(4)
+        if table not in tables:
+            sys.exit('Table {} of font {} not found'.format(table, name))
+        fonts.append((name, width, height, tables[table]))
+    return fonts
+
+
+def pack_glyph(rows, width, stride):
+    """ first inked row, inked row count, then the inked rows with `width` bits each, MSB first """
+    values = [int.from_bytes(bytes(row), 'big') >> (stride * 8 - width) for row in rows]
+    inked = [index for index, value in enumerate(values) if value]
+    if not inked:
+        return [0, 0]
+    first, last = inked[0], inked[-1]
+    bits = ''.join(format(value, '0{}b'.format(width)) for value in values[first:last + 1])
+    bits += '0' * (-len(bits) % 8)
+    return [first, last - first + 1] + [int(bits[index:index + 8], 2) for index in range(0, len(bits), 8)]
+
+
+def format_array(values, per_line, value_format):
+    lines = []
+    for index in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(value_format.format(value) for value in values[index:index + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def generate(fonts):
+    output = [HEADER]
+    total_raw = total_packed = 0
+    for name, width, height, table in fonts:
+        stride = (width + 7) // 8
+        glyph_size = stride * height
+        if len(table) % glyph_size:
+            sys.exit('Table of font {} is not a whole number of glyphs'.format(name))
+        glyph_count = len(table) // glyph_size
+        glyphs = []
+        offsets = []
+        for glyph in range(glyph_count):
+            data = table[glyph * glyph_size:(glyph + 1) * glyph_size]
+            offsets.append(len(glyphs))
+            glyphs += pack_glyph([data[row * stride:(row + 1) * stride] for row in range(height)], width, stride)
+        if len(glyphs) > 0xFFFF:
+            sys.exit('Packed font {} is too large for the 16-bit offsets'.format(name))
+        total_raw += len(table)
+        total_packed += len(glyphs) + 2 * len(offsets)
+        short_name = 'font_' + (name[len('epaper_font_'):] if name.startswith('epaper_font_') else name)
+        output.append('''
+/* {width}x{height}, {raw} bytes unpacked */
+static const uint8_t {short}_glyphs[] = {{
+{glyphs}
+}};
+
+static const uint16_t {short}_offsets[] = {{
+{offsets}
+}};
+
+static const epaper_packed_font_t {short}_packed = {{
+    {short}_glyphs,
+    {short}_offsets,
+    0x{first:02X},
+    0x{last:02X},
+}};
+
+epaper_font_t {name} = {{
+    {width}, /* width */
+    {height}, /* height */
+    NULL,
+    &{short}_packed,
+}};
+'''.format(width=width, height=height, raw=len(table), short=short_name, name=name,
+           glyphs=format_array(glyphs, 16, '0x{:02X}'), offsets=format_array(offsets, 12, '{}'),
+           first=FIRST_CHAR, last=FIRST_CHAR + glyph_count - 1))
+    return ''.join(output), total_raw, total_packed
+
+
+def main():
+    component_dir = Path(__file__).resolve().parent.parent
+    parser = argparse.ArgumentParser(description='Generate the packed e-paper fonts')
+    parser.add_argument('source', nargs='?', default=str(component_dir / 'epaper_font.c'),
+                        help='FontEdit tables and their epaper_font_t definitions')
+    parser.add_argument('-o', '--output', default=str(component_dir / 'epaper_font_packed.c'),
+                        help='generated source')
+    args = parser.parse_args()
+
+    fonts = parse_fonts(Path(args.source).read_text())
+    if not fonts:
+        sys.exit('No epaper_font_t definition found in {}'.format(args.source))
+    output, total_raw, total_packed = generate(fonts)
+    Path(args.output).write_text(output)
+    print('Packed {} fonts: {} bytes, {} bytes unpacked'.format(len(fonts), total_packed, total_raw))
+
+
+if __name__ == '__main__':
+    main()
@@ -7,6 +7,8 @@
 */
 
 #include <esp_log.h>
+#include <esp_timer.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
 #include <led_driver.h>
@@ -18,6 +20,8 @@
 #include "espnow_ctrl.h"
 #include "app_espnow.h"
 
+#include <platform/CHIPDeviceLayer.h>
+
 #ifdef CONFIG_ESPNOW_BRIDGE_APP_PS_ENABLE
 #include <esp_wifi.h>
 #endif
@@ -30,10 +34,38 @@ static bool light_status = false;
 extern uint16_t light_endpoint_id;
 extern uint16_t aggregator_endpoint_id;
 
+#define ESPNOW_BRIDGE_AGGREGATION_WINDOW_MS CONFIG_ESPNOW_BRIDGE_APP_AGGREGATION_WINDOW_MS
+#define ESPNOW_BRIDGE_DUPLICATE_WINDOW_MS CONFIG_ESPNOW_BRIDGE_APP_DUPLICATE_WINDOW_MS
+#define ESPNOW_BRIDGE_MAX_PENDING_INITIATORS CONFIG_ESPNOW_BRIDGE_APP_MAX_PENDING_INITIATORS
+
+/* Control frames of an initiator waiting for the end of the aggregation window */
+typedef struct {
+    espnow_addr_t src_addr;
+    /* Index of the last frame of the initiator in the window, each frame toggles the light */
+    uint32_t last_frame;
+} pending_initiator_t;
+
+/* Last control frame received from an initiator, to drop its retransmissions */
+typedef struct {
+    espnow_addr_t src_addr;
+    espnow_attribute_t initiator_attribute;
+    espnow_attribute_t responder_attribute;
+    uint32_t value;
+    int64_t time_us;
+} recent_frame_t;
+
+static portMUX_TYPE s_pending_frame_lock = portMUX_INITIALIZER_UNLOCKED;
+static pending_initiator_t s_pending_initiators[ESPNOW_BRIDGE_MAX_PENDING_INITIATORS];
+static size_t s_pending_initiator_count = 0;
+static uint32_t s_pending_frame_count = 0;
+static uint32_t s_dropped_frame_count = 0;
+/* Only used in the ESP-NOW task */
+static recent_frame_t s_recent_frames[ESPNOW_BRIDGE_MAX_PENDING_INITIATORS];
+static size_t s_recent_frame_count = 0;
+static size_t s_recent_frame_next = 0;
+
 static void espnow_ctrl_onoff(espnow_addr_t src_addr, bool status)
 {
-    ESP_LOGI(TAG, "ESP-NOW button pressed");
-
     // Update bound light
     client::command_handle_t cmd_handle;
     cmd_handle.cluster_id = OnOff::Id;
@@ -46,29 +78,89 @@ static void espnow_ctrl_onoff(espnow_addr_t src_addr, bool status)
     ESP_LOGI(TAG, "Using bridge endpoint: %d", bridged_switch_endpoint_id);
 
     if (bridged_switch_endpoint_id != chip::kInvalidEndpointId) {
-        lock::chip_stack_lock(portMAX_DELAY);
         client::cluster_update(bridged_switch_endpoint_id, &cmd_handle);
-        lock::chip_stack_unlock();
     } else {
         ESP_LOGE(TAG, "Can't find endpoint for bridged device: " MACSTR, MAC2STR(src_addr));
     }
+}
+
+static void apply_pending_frames(chip::System::Layer *layer, void *ctx)
+{
+    /* Only used in the Matter context, they are kept off the stack of the Matter task */
+    static pending_initiator_t initiators[ESPNOW_BRIDGE_MAX_PENDING_INITIATORS];
+    taskENTER_CRITICAL(&s_pending_frame_lock);
+    size_t initiator_count = s_pending_initiator_count;
+    memcpy(initiators, s_pending_initiators, initiator_count * sizeof(pending_initiator_t));
+    uint32_t frame_count = s_pending_frame_count;
+    uint32_t dropped = s_dropped_frame_count;
+    s_pending_initiator_count = 0;
+    s_pending_frame_count = 0;
+    s_dropped_frame_count = 0;
+    taskEXIT_CRITICAL(&s_pending_frame_lock);
+    if (dropped > 0) {
+        ESP_LOGW(TAG, "%" PRIu32 " ESP-NOW frames were dropped, too many initiators are pending", dropped);
+    }
+    if (frame_count == 0) {
+        return;
+    }
+
+    /* Each initiator gets the state the light had after its last frame, the bound lights only get the last one */
+    bool initial_status = light_status;
+    for (size_t index = 0; index < initiator_count; index++) {
+        bool toggled = (initiators[index].last_frame % 2) == 0;
+        espnow_ctrl_onoff(initiators[index].src_addr, toggled ? !initial_status : initial_status);
+    }
+    light_status = (frame_count % 2) == 1 ? !initial_status : initial_status;
+    ESP_LOGI(TAG, "%" PRIu32 " ESP-NOW frames applied, toggle Status to %d", frame_count, light_status);
 
     // Update local light
-    uint16_t endpoint_id = light_endpoint_id;
-    uint32_t cluster_id = OnOff::Id;
-    uint32_t attribute_id = OnOff::Attributes::OnOff::Id;
+    attribute::batch_entry_t entry = {
+        .endpoint_id = light_endpoint_id,
+        .cluster_id = OnOff::Id,
+        .attribute_id = OnOff::Attributes::OnOff::Id,
+        .val = esp_matter_bool(light_status),
+    };
+    attribute::update_batch(&entry, 1);
+}
 
-    node_t *node = node::get();
-    endpoint_t *endpoint = endpoint::get(node, endpoint_id);
-    cluster_t *cluster = cluster::get(endpoint, cluster_id);
-    attribute_t *attribute = attribute::get(cluster, attribute_id);
+static void start_aggregation_window(intptr_t arg)
+{
+    if (chip::DeviceLayer::SystemLayer().StartTimer(
+            chip::System::Clock::Milliseconds32(ESPNOW_BRIDGE_AGGREGATION_WINDOW_MS), apply_pending_frames, nullptr) !=
+        CHIP_NO_ERROR) {
+        apply_pending_frames(nullptr, nullptr);
+    }
+}
 
-    esp_matter_attr_val_t val = esp_matter_invalid(NULL);
-    attribute::get_val(attribute, &val);
-    if (val.type == ESP_MATTER_VAL_TYPE_BOOLEAN) {
-        val.val.b = status;
-        attribute::update(endpoint_id, cluster_id, attribute_id, &val);
+static bool is_duplicate_frame(espnow_addr_t src_addr, espnow_ctrl_data_t *data)
+{
+    int64_t now_us = esp_timer_get_time();
+    size_t index = 0;
+    while (index < s_recent_frame_count && memcmp(s_recent_frames[index].src_addr, src_addr, ESPNOW_ADDR_LEN) != 0) {
+        index++;
     }
+    if (index < s_recent_frame_count) {
+        recent_frame_t *frame = &s_recent_frames[index];
+        bool duplicate = frame->initiator_attribute == data->initiator_attribute &&
+            frame->responder_attribute == data->responder_attribute && frame->value == data->responder_value_i &&
+            now_us - frame->time_us < ESPNOW_BRIDGE_DUPLICATE_WINDOW_MS * 1000LL;
+        if (duplicate) {
+            return true;
+        }
+    } else if (s_recent_frame_count < ESPNOW_BRIDGE_MAX_PENDING_INITIATORS) {
+        index = s_recent_frame_count++;
+    } else {
+        /* The oldest initiator is replaced */
+        index = s_recent_frame_next;
+        s_recent_frame_next = (s_recent_frame_next + 1) % ESPNOW_BRIDGE_MAX_PENDING_INITIATORS;
+    }
+    recent_frame_t *frame = &s_recent_frames[index];
+    memcpy(frame->src_addr, src_addr, ESPNOW_ADDR_LEN);
+    frame->initiator_attribute = data->initiator_attribute;
+    frame->responder_attribute = data->responder_attribute;
+    frame->value = data->responder_value_i;
+    frame->time_us = now_us;
+    return false;
 }
 
 static void espnow_ctrl_responder_raw_data_cb(espnow_addr_t src_addr, espnow_ctrl_data_t *data, wifi_pkt_rx_ctrl_t *rx_ctrl)
@@ -80,9 +172,32 @@ static void espnow_ctrl_responder_raw_data_cb(espnow_addr_t src_addr, espnow_ctr
         data->responder_attribute,
         data->responder_value_i);
 
-    light_status = !light_status;
-    ESP_LOGI(TAG, "Toggle Status to %d", light_status);
-    espnow_ctrl_onoff(src_addr, light_status);
+    if (ESPNOW_BRIDGE_DUPLICATE_WINDOW_MS > 0 && is_duplicate_frame(src_addr, data)) {
+        ESP_LOGD(TAG, "Duplicate frame from " MACSTR " dropped", MAC2STR(src_addr));
+        return;
+    }
+
+    bool start_window = false;
+    taskENTER_CRITICAL(&s_pending_frame_lock);
+    size_t index = 0;
+    while (index < s_pending_initiator_count &&
+           memcmp(s_pending_initiators[index].src_addr, src_addr, ESPNOW_ADDR_LEN) != 0) {
+        index++;
+    }
+    if (index == s_pending_initiator_count && s_pending_initiator_count < ESPNOW_BRIDGE_MAX_PENDING_INITIATORS) {
+        memcpy(s_pending_initiators[s_pending_initiator_count++].src_addr, src_addr, ESPNOW_ADDR_LEN);
+    }
+    if (index < s_pending_initiator_count) {
+        start_window = s_pending_frame_count == 0;
+        s_pending_initiators[index].last_frame = s_pending_frame_count++;
+    } else {
+        s_dropped_frame_count++;
+    }
+    taskEXIT_CRITICAL(&s_pending_frame_lock);
+    if (start_window) {
+        /* The frames are applied in the Matter context, the ESP-NOW task never waits for the Matter stack lock */
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(start_aggregation_window, 0);
+    }
 }
 
 static void espnow_ctrl_responder_data_cb(espnow_attribute_t initiator_attribute,
@@ -45,95 +45,23 @@ static void app_driver_button_switch_latched(void *arg, void *data)
 }
 #endif
 #if CONFIG_GENERIC_SWITCH_TYPE_MOMENTARY
-static void app_driver_button_initial_pressed(void *arg, void *data)
+// The press engine derives the events of the switch features from the edges, see app_main.cpp
+static void app_driver_button_press_down(void *arg, void *data)
 {
-    ESP_LOGI(TAG, "Initial button pressed");
     gpio_button * button = (gpio_button*)data;
-    int switch_endpoint_id = (button != NULL) ? get_endpoint(button) : 1;
-    // Press moves Position from 0 (idle) to 1 (press)
-    uint8_t newPosition = 1;
-    lock::chip_stack_lock(portMAX_DELAY);
-    chip::app::Clusters::Switch::Attributes::CurrentPosition::Set(switch_endpoint_id, newPosition);
-    // InitialPress event takes newPosition as event data
-    switch_cluster::event::send_initial_press(switch_endpoint_id, newPosition);
-    lock::chip_stack_unlock();
-}
-
-static void app_driver_button_release(void *arg, void *data)
-{
-    gpio_button *button = (gpio_button *)data;
-    int switch_endpoint_id = (button != NULL) ? get_endpoint(button) : 1;
-    if(iot_button_get_ticks_time((button_handle_t)arg) < 5000){
-    ESP_LOGI(TAG, "Short button release");
-    // Release moves Position from 1 (press) to 0 (idle)
-    uint8_t previousPosition = 1;
-    uint8_t newPosition = 0;
-    lock::chip_stack_lock(portMAX_DELAY);
-    chip::app::Clusters::Switch::Attributes::CurrentPosition::Set(switch_endpoint_id, newPosition);
-    // ShortRelease event takes previousPosition as event data
-    switch_cluster::event::send_short_release(switch_endpoint_id, previousPosition);
-    lock::chip_stack_unlock();
-    }
-    else{
-    ESP_LOGI(TAG, "Long button release");
-    // Release moves Position from 1 (press) to 0 (idle)
-    uint8_t previousPosition = 1;
-    uint8_t newPosition = 0;
-    lock::chip_stack_lock(portMAX_DELAY);
-    chip::app::Clusters::Switch::Attributes::CurrentPosition::Set(switch_endpoint_id, newPosition);
-    // LongRelease event takes previousPositionPosition as event data
-    switch_cluster::event::send_long_release(switch_endpoint_id, previousPosition);
-    lock::chip_stack_unlock();
+    int switch_endpoint_id = get_endpoint(button);
+    if (switch_endpoint_id >= 0) {
+        switch_cluster::event::press_engine::press(switch_endpoint_id);
     }
 }
 
-static void app_driver_button_long_pressed(void *arg, void *data)
+static void app_driver_button_press_up(void *arg, void *data)
 {
-    ESP_LOGI(TAG, "Long button pressed ");
-    gpio_button *button = (gpio_button *)data;
-    int switch_endpoint_id = (button != NULL) ? get_endpoint(button) : 1;
-    // Press moves Position from 0 (idle) to 1 (press)
-    uint8_t newPosition = 1;
-    lock::chip_stack_lock(portMAX_DELAY);
-    chip::app::Clusters::Switch::Attributes::CurrentPosition::Set(switch_endpoint_id, newPosition);
-    // LongPress event takes newPosition as event data
-    switch_cluster::event::send_long_press(switch_endpoint_id, newPosition);
-    lock::chip_stack_unlock();
-}
-
-static int current_number_of_presses_counted = 1;
-
-static void app_driver_button_multipress_ongoing(void *arg, void *data)
-{
-    ESP_LOGI(TAG, "Multipress Ongoing");
-    gpio_button * button = (gpio_button *)data;
-    int switch_endpoint_id = (button != NULL) ? get_endpoint(button) : 1;
-    // Press moves Position from 0 (idle) to 1 (press)
-    uint8_t newPosition = 1;
-    current_number_of_presses_counted++;
-    lock::chip_stack_lock(portMAX_DELAY);
-    chip::app::Clusters::Switch::Attributes::CurrentPosition::Set(switch_endpoint_id, newPosition);
-    // MultiPress Ongoing event takes newPosition and current_number_of_presses_counted as event data
-    switch_cluster::event::send_multi_press_ongoing(switch_endpoint_id, newPosition, current_number_of_presses_counted);
-    lock::chip_stack_unlock();
-}
-
-static void app_driver_button_multipress_complete(void *arg, void *data)
-{
-    ESP_LOGI(TAG, "Multipress Complete");
-    gpio_button * button = (gpio_button *)data;
-    int switch_endpoint_id = (button != NULL) ? get_endpoint(button) : 1;
-    // Press moves Position from 0 (idle) to 1 (press)
-    uint8_t previousPosition = 1;
-    uint8_t newPosition = 0;
-    static int total_number_of_presses_counted = current_number_of_presses_counted;
-    lock::chip_stack_lock(portMAX_DELAY);
-    chip::app::Clusters::Switch::Attributes::CurrentPosition::Set(switch_endpoint_id, newPosition);
-    // MultiPress Complete event takes previousPosition and total_number_of_presses_counted as event data
-    switch_cluster::event::send_multi_press_complete(switch_endpoint_id, previousPosition, total_number_of_presses_counted);
-    // Reset current_number_of_presses_counted to initial value
-    current_number_of_presses_counted = 1;
-    lock::chip_stack_unlock();
+    gpio_button * button = (gpio_button*)data;
+    int switch_endpoint_id = get_endpoint(button);
+    if (switch_endpoint_id >= 0) {
+        switch_cluster::event::press_engine::release(switch_endpoint_id);
+    }
 }
 #endif
 
@@ -154,11 +82,8 @@ app_driver_handle_t app_driver_button_init(gpio_button * button)
 #endif
 
 #if CONFIG_GENERIC_SWITCH_TYPE_MOMENTARY
-    iot_button_register_cb(handle, BUTTON_PRESS_DOWN, app_driver_button_initial_pressed, button);
-    iot_button_register_cb(handle, BUTTON_PRESS_UP, app_driver_button_release, button);
-    iot_button_register_cb(handle, BUTTON_LONG_PRESS_START, app_driver_button_long_pressed, button);
-    iot_button_register_cb(handle, BUTTON_PRESS_REPEAT, app_driver_button_multipress_ongoing, button);
-    iot_button_register_cb(handle, BUTTON_PRESS_REPEAT_DONE, app_driver_button_multipress_complete, button);
+    iot_button_register_cb(handle, BUTTON_PRESS_DOWN, app_driver_button_press_down, button);
+    iot_button_register_cb(handle, BUTTON_PRESS_UP, app_driver_button_press_up, button);
 #endif
     return (app_driver_handle_t)handle;
 }
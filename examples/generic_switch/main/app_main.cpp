@@ -179,6 +179,16 @@ static esp_err_t create_button(struct gpio_button* button, node_t* node)
 
 #if CONFIG_GENERIC_SWITCH_TYPE_MOMENTARY
     cluster::switch_cluster::feature::momentary_switch::add(cluster);
+    cluster::switch_cluster::feature::momentary_switch_release::add(cluster);
+    cluster::switch_cluster::feature::momentary_switch_long_press::add(cluster);
+    cluster::switch_cluster::feature::momentary_switch_multi_press::config_t multi_press_config;
+    multi_press_config.multi_press_max = CONFIG_GENERIC_SWITCH_MULTI_PRESS_MAX;
+    cluster::switch_cluster::feature::momentary_switch_multi_press::add(cluster, &multi_press_config);
+
+    cluster::switch_cluster::event::press_engine::config_t press_config;
+    press_config.long_press_ms = CONFIG_GENERIC_SWITCH_LONG_PRESS_MS;
+    press_config.multi_press_window_ms = CONFIG_GENERIC_SWITCH_MULTI_PRESS_WINDOW_MS;
+    err = cluster::switch_cluster::event::press_engine::add(generic_switch_endpoint_id, &press_config);
 #endif
 
     return err;
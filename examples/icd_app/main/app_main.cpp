@@ -15,9 +15,13 @@
 
 #include <esp_matter.h>
 #include <esp_matter_ota.h>
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
 
 #include <common_macros.h>
 #include <app_priv.h>
+#include <icd_profiler.h>
 #if CHIP_DEVICE_CONFIG_ENABLE_THREAD
 #include <platform/ESP32/OpenthreadLauncher.h>
 #endif
@@ -51,10 +55,12 @@ static void app_event_cb(const ChipDeviceEvent *event, intptr_t arg)
 
     case chip::DeviceLayer::DeviceEventType::kCommissioningSessionStarted:
         ESP_LOGI(TAG, "Commissioning session started");
+        icd_profiler_mark(ICD_PROFILER_WAKE_CRYPTO, true);
         break;
 
     case chip::DeviceLayer::DeviceEventType::kCommissioningSessionStopped:
         ESP_LOGI(TAG, "Commissioning session stopped");
+        icd_profiler_unmark(ICD_PROFILER_WAKE_CRYPTO);
         break;
 
     case chip::DeviceLayer::DeviceEventType::kCommissioningWindowOpened:
@@ -118,6 +124,7 @@ static esp_err_t app_attribute_update_cb(attribute::callback_type_t type, uint16
 
     if (type == PRE_UPDATE) {
         /* Driver update */
+        icd_profiler_mark(ICD_PROFILER_WAKE_APPLICATION);
     }
 
     return err;
@@ -140,6 +147,9 @@ extern "C" void app_main()
     };
     err = esp_pm_configure(&pm_config);
 #endif
+    err = icd_profiler_init();
+    ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to start the ICD profiler, err:%d", err));
+
     /* Create a Matter node and add the mandatory Root Node device type on endpoint 0 */
     node::config_t node_config;
     node_t *node = node::create(&node_config, app_attribute_update_cb, app_identification_cb);
@@ -162,4 +172,12 @@ extern "C" void app_main()
     /* Matter start */
     err = esp_matter::start(app_event_cb);
     ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to start Matter, err:%d", err));
+
+    err = icd_profiler_start_icd_observer();
+    ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to start the ICD observer, err:%d", err));
+
+#if CONFIG_ENABLE_CHIP_SHELL
+    esp_matter::console::diagnostics_register_commands();
+    esp_matter::console::init();
+#endif
 }
@@ -0,0 +1,263 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#include <sdkconfig.h>
+
+#if CONFIG_ICD_APP_POWER_PROFILER
+#include <esp_attr.h>
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_pm.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <esp_matter.h>
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+#include <icd_profiler.h>
+
+#include <app/server/Server.h>
+#if CHIP_CONFIG_ENABLE_ICD_SERVER
+#if __has_include(<app/icd/server/ICDStateObserver.h>)
+#include <app/icd/server/ICDStateObserver.h>
+#else
+#include <app/icd/ICDStateObserver.h>
+#endif
+#endif
+#if CHIP_DEVICE_CONFIG_ENABLE_THREAD
+#include <esp_openthread.h>
+#include <esp_openthread_lock.h>
+#include <openthread/link.h>
+#endif
+
+/* The run time of the Matter task is read from the sleep callback, it must not be in the flash */
+#define PROFILER_TASK_RUN_TIME (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS && !CONFIG_FREERTOS_PLACE_FUNCTIONS_INTO_FLASH)
+#define MATTER_TASK_NAME "CHIP"
+/* Run time of the Matter task from which a wake without other mark is a report */
+#define MATTER_TASK_REPORT_MIN_US 1000
+
+static const char *TAG = "icd_profiler";
+
+static const char *k_reason_names[ICD_PROFILER_WAKE_REASON_COUNT] = {
+    "poll", "report", "check-in", "crypto", "application",
+};
+
+/* The statistics are updated by the sleep callbacks, with the interrupts disabled, and read under the lock */
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static icd_profiler_stats_t s_stats[ICD_PROFILER_WAKE_REASON_COUNT];
+static uint64_t s_sleep_us = 0;
+static int64_t s_wake_start_us = 0;
+static uint32_t s_marks = 0;
+static uint32_t s_sticky_marks = 0;
+#if PROFILER_TASK_RUN_TIME
+static TaskHandle_t s_matter_task = NULL;
+static uint32_t s_matter_task_run_time = 0;
+#endif
+
+void icd_profiler_mark(icd_profiler_wake_reason_t reason, bool sticky)
+{
+    __atomic_fetch_or(sticky ? &s_sticky_marks : &s_marks, 1u << reason, __ATOMIC_RELAXED);
+}
+
+void icd_profiler_unmark(icd_profiler_wake_reason_t reason)
+{
+    __atomic_fetch_and(&s_sticky_marks, ~(1u << reason), __ATOMIC_RELAXED);
+}
+
+/* The wake ends: account its active time to the highest reason marked since it started */
+static IRAM_ATTR esp_err_t sleep_enter_cb(int64_t sleep_time_us, void *arg)
+{
+    int64_t now_us = esp_timer_get_time();
+    uint32_t marks = __atomic_exchange_n(&s_marks, 0, __ATOMIC_RELAXED) | s_sticky_marks;
+
+    portENTER_CRITICAL_ISR(&s_lock);
+    uint32_t matter_task_us = 0;
+#if PROFILER_TASK_RUN_TIME
+    if (s_matter_task) {
+        // The run time counter of the task is in microseconds, from esp_timer
+        uint32_t run_time = ulTaskGetRunTimeCounter(s_matter_task);
+        matter_task_us = run_time - s_matter_task_run_time;
+        s_matter_task_run_time = run_time;
+    }
+    // The reports are sent by the Matter task, which barely runs on the wakes of the radio polls
+    if (matter_task_us >= MATTER_TASK_REPORT_MIN_US) {
+        marks |= 1u << ICD_PROFILER_WAKE_REPORT;
+    }
+#endif
+    uint32_t reason = ICD_PROFILER_WAKE_POLL;
+    for (uint32_t idx = ICD_PROFILER_WAKE_REASON_COUNT - 1; idx > ICD_PROFILER_WAKE_POLL; --idx) {
+        if (marks & (1u << idx)) {
+            reason = idx;
+            break;
+        }
+    }
+    uint32_t active_us = (uint32_t)(now_us - s_wake_start_us);
+    icd_profiler_stats_t *stats = &s_stats[reason];
+    stats->wakes++;
+    stats->active_us += active_us;
+    stats->matter_task_us += matter_task_us;
+    if (active_us > stats->max_active_us) {
+        stats->max_active_us = active_us;
+    }
+    portEXIT_CRITICAL_ISR(&s_lock);
+    return ESP_OK;
+}
+
+static IRAM_ATTR esp_err_t sleep_exit_cb(int64_t sleep_time_us, void *arg)
+{
+    portENTER_CRITICAL_ISR(&s_lock);
+    s_sleep_us += sleep_time_us;
+    s_wake_start_us = esp_timer_get_time();
+    portEXIT_CRITICAL_ISR(&s_lock);
+    return ESP_OK;
+}
+
+esp_err_t icd_profiler_get_stats(icd_profiler_wake_reason_t reason, icd_profiler_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(reason < ICD_PROFILER_WAKE_REASON_COUNT && stats, ESP_ERR_INVALID_ARG, TAG,
+                        "Invalid arguments");
+    portENTER_CRITICAL(&s_lock);
+    *stats = s_stats[reason];
+    portEXIT_CRITICAL(&s_lock);
+    // The charge is computed here, the sleep callbacks only accumulate the times
+    stats->charge_uc = stats->active_us * CONFIG_ICD_APP_PROFILER_ACTIVE_CURRENT_UA / 1000000;
+    return ESP_OK;
+}
+
+void icd_profiler_get_sleep_stats(uint64_t *sleep_us, uint64_t *charge_uc)
+{
+    portENTER_CRITICAL(&s_lock);
+    uint64_t total_us = s_sleep_us;
+    portEXIT_CRITICAL(&s_lock);
+    if (sleep_us) {
+        *sleep_us = total_us;
+    }
+    if (charge_uc) {
+        *charge_uc = total_us * CONFIG_ICD_APP_PROFILER_SLEEP_CURRENT_UA / 1000000;
+    }
+}
+
+void icd_profiler_reset()
+{
+    portENTER_CRITICAL(&s_lock);
+    memset(s_stats, 0, sizeof(s_stats));
+    s_sleep_us = 0;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void icd_profiler_log()
+{
+    uint64_t total_charge_uc = 0;
+    for (uint32_t idx = 0; idx < ICD_PROFILER_WAKE_REASON_COUNT; ++idx) {
+        icd_profiler_stats_t stats;
+        icd_profiler_get_stats((icd_profiler_wake_reason_t)idx, &stats);
+        total_charge_uc += stats.charge_uc;
+        ESP_LOGI(TAG, "%-11s wakes: %" PRIu32 ", active: %" PRIu64 " ms (avg %" PRIu64 " us, max %" PRIu32
+                 " us), matter task: %" PRIu64 " ms, charge: %" PRIu64 " uC", k_reason_names[idx], stats.wakes,
+                 stats.active_us / 1000, stats.wakes ? stats.active_us / stats.wakes : 0, stats.max_active_us,
+                 stats.matter_task_us / 1000, stats.charge_uc);
+    }
+    uint64_t sleep_us, sleep_charge_uc;
+    icd_profiler_get_sleep_stats(&sleep_us, &sleep_charge_uc);
+    total_charge_uc += sleep_charge_uc;
+    ESP_LOGI(TAG, "sleep       %" PRIu64 " ms, charge: %" PRIu64 " uC, total charge: %" PRIu64 " uC",
+             sleep_us / 1000, sleep_charge_uc, total_charge_uc);
+#if CHIP_DEVICE_CONFIG_ENABLE_THREAD
+    esp_openthread_lock_acquire(portMAX_DELAY);
+    otInstance *instance = esp_openthread_get_instance();
+    if (instance) {
+        const otMacCounters *counters = otLinkGetCounters(instance);
+        ESP_LOGI(TAG, "radio       data polls: %" PRIu32 ", tx: %" PRIu32 ", rx: %" PRIu32 ", tx retries: %" PRIu32,
+                 counters->mTxDataPoll, counters->mTxTotal, counters->mRxTotal, counters->mTxRetry);
+    }
+    esp_openthread_lock_release();
+#endif
+}
+
+#if CHIP_CONFIG_ENABLE_ICD_SERVER
+/* The check-in messages are sent when the ICD enters the active mode */
+class ProfilerICDObserver : public chip::app::ICDStateObserver {
+public:
+    void OnEnterActiveMode() { icd_profiler_mark(ICD_PROFILER_WAKE_CHECK_IN); }
+
+    void OnTransitionToIdle()
+    {
+        if (CONFIG_ICD_APP_PROFILER_LOG_IDLE_COUNT > 0 && ++mIdleCount >= CONFIG_ICD_APP_PROFILER_LOG_IDLE_COUNT) {
+            mIdleCount = 0;
+            icd_profiler_log();
+        }
+    }
+
+    void OnEnterIdleMode() {}
+    void OnICDModeChange() {}
+
+private:
+    uint32_t mIdleCount = 0;
+};
+
+static ProfilerICDObserver s_icd_observer;
+#endif // CHIP_CONFIG_ENABLE_ICD_SERVER
+
+esp_err_t icd_profiler_start_icd_observer()
+{
+#if CHIP_CONFIG_ENABLE_ICD_SERVER
+    esp_matter::lock::chip_stack_lock(portMAX_DELAY);
+    chip::Server::GetInstance().GetICDManager().RegisterObserver(&s_icd_observer);
+    esp_matter::lock::chip_stack_unlock();
+#endif
+#if PROFILER_TASK_RUN_TIME
+    TaskHandle_t matter_task = xTaskGetHandle(MATTER_TASK_NAME);
+    uint32_t run_time = matter_task ? ulTaskGetRunTimeCounter(matter_task) : 0;
+    portENTER_CRITICAL(&s_lock);
+    s_matter_task_run_time = run_time;
+    s_matter_task = matter_task;
+    portEXIT_CRITICAL(&s_lock);
+#endif
+    return ESP_OK;
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+static esp_err_t profiler_console_handler(int argc, char **argv)
+{
+    if (argc == 0) {
+        icd_profiler_log();
+        return ESP_OK;
+    } else if (argc == 1 && strcmp(argv[0], "reset") == 0) {
+        icd_profiler_reset();
+        return ESP_OK;
+    }
+    ESP_LOGE(TAG, "Usage: matter esp icd_profile [reset]");
+    return ESP_ERR_INVALID_ARG;
+}
+#endif // CONFIG_ENABLE_CHIP_SHELL
+
+esp_err_t icd_profiler_init()
+{
+    s_wake_start_us = esp_timer_get_time();
+    esp_pm_sleep_cbs_register_config_t cbs_config = {};
+    cbs_config.enter_cb = sleep_enter_cb;
+    cbs_config.exit_cb = sleep_exit_cb;
+    ESP_RETURN_ON_ERROR(esp_pm_light_sleep_register_cbs(&cbs_config), TAG, "Failed to register the sleep callbacks");
+#if CONFIG_ENABLE_CHIP_SHELL
+    static const esp_matter::console::command_t profiler_command = {
+        .name = "icd_profile",
+        .description = "Statistics of the wakes per reason. Usage:\n"
+                       "\tmatter esp icd_profile\n"
+                       "\tmatter esp icd_profile reset",
+        .handler = profiler_console_handler,
+    };
+    ESP_RETURN_ON_ERROR(esp_matter::console::add_commands(&profiler_command, 1), TAG,
+                        "Failed to add the console command");
+#endif
+    return ESP_OK;
+}
+#endif // CONFIG_ICD_APP_POWER_PROFILER
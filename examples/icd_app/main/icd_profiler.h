@@ -0,0 +1,112 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#pragma once
+
+#include <esp_err.h>
+#include <stdint.h>
+
+/*
+ * ICD power profiler.
+ *
+ * A wake is the time between two light sleeps. The profiler timestamps the wake and sleep transitions from the light
+ * sleep callbacks of the power management, and gives each wake a reason from the marks set while the device is awake:
+ * the highest reason marked wins, and a wake with no mark is a radio poll (the Thread SED wakes up on its poll timer).
+ * The active time, the time of the Matter task and the estimated charge are accumulated per reason, they are kept
+ * until icd_profiler_reset() and can be read at any time with icd_profiler_get_stats() or logged with
+ * icd_profiler_log().
+ */
+
+/** Reason of a wake, from the lowest to the highest priority */
+typedef enum {
+    /** Radio poll of the parent, or any wake with no mark */
+    ICD_PROFILER_WAKE_POLL = 0,
+    /** Subscription report, or other work of the Matter task */
+    ICD_PROFILER_WAKE_REPORT,
+    /** Entry in the ICD active mode, which sends the check-in messages */
+    ICD_PROFILER_WAKE_CHECK_IN,
+    /** Session establishment */
+    ICD_PROFILER_WAKE_CRYPTO,
+    /** Work of the application on the attribute updates */
+    ICD_PROFILER_WAKE_APPLICATION,
+    ICD_PROFILER_WAKE_REASON_COUNT,
+} icd_profiler_wake_reason_t;
+
+/** Statistics of the wakes of a reason */
+typedef struct {
+    /** Number of wakes */
+    uint32_t wakes;
+    /** Total and longest active time */
+    uint64_t active_us;
+    uint32_t max_active_us;
+    /** Run time of the Matter task during the wakes, 0 if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS is disabled */
+    uint64_t matter_task_us;
+    /** Charge of the active time, from CONFIG_ICD_APP_PROFILER_ACTIVE_CURRENT_UA */
+    uint64_t charge_uc;
+} icd_profiler_stats_t;
+
+#if CONFIG_ICD_APP_POWER_PROFILER
+/** Start profiling the wakes
+ *
+ * Call it after esp_pm_configure(), before esp_matter::start().
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t icd_profiler_init();
+
+/** Register the ICD state observer of the profiler, in the Matter context, after esp_matter::start()
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t icd_profiler_start_icd_observer();
+
+/** Mark the current wake with a reason
+ *
+ * It can be called from any task. A sticky mark is kept on all the wakes until icd_profiler_unmark() is called.
+ *
+ * @param[in] reason Reason of the wake.
+ * @param[in] sticky Keep the mark on the next wakes.
+ */
+void icd_profiler_mark(icd_profiler_wake_reason_t reason, bool sticky = false);
+
+/** Clear a sticky mark
+ *
+ * @param[in] reason Reason of the sticky mark.
+ */
+void icd_profiler_unmark(icd_profiler_wake_reason_t reason);
+
+/** Get the statistics of a wake reason
+ *
+ * @param[in] reason Reason of the wakes.
+ * @param[out] stats Statistics of the wakes.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_ARG if the arguments are invalid.
+ */
+esp_err_t icd_profiler_get_stats(icd_profiler_wake_reason_t reason, icd_profiler_stats_t *stats);
+
+/** Get the time and the charge of the light sleeps
+ *
+ * @param[out] sleep_us Total time in light sleep.
+ * @param[out] charge_uc Charge of the sleeps, from CONFIG_ICD_APP_PROFILER_SLEEP_CURRENT_UA.
+ */
+void icd_profiler_get_sleep_stats(uint64_t *sleep_us, uint64_t *charge_uc);
+
+/** Log the statistics of all the wake reasons, and the radio counters of the Thread interface */
+void icd_profiler_log();
+
+/** Clear the statistics */
+void icd_profiler_reset();
+#else
+static inline esp_err_t icd_profiler_init() { return ESP_OK; }
+static inline esp_err_t icd_profiler_start_icd_observer() { return ESP_OK; }
+static inline void icd_profiler_mark(icd_profiler_wake_reason_t reason, bool sticky = false) {}
+static inline void icd_profiler_unmark(icd_profiler_wake_reason_t reason) {}
+#endif // CONFIG_ICD_APP_POWER_PROFILER
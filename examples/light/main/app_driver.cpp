@@ -7,12 +7,14 @@
 */
 
 #include <esp_log.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <esp_matter.h>
 #include "bsp/esp-bsp.h"
 
+#include <app_driver_binding.h>
 #include <app_priv.h>
 
 using namespace chip::app::Clusters;
@@ -21,73 +23,89 @@ using namespace esp_matter;
 static const char *TAG = "app_driver";
 extern uint16_t light_endpoint_id;
 
-/* Do any conversions/remapping for the actual value here */
-static esp_err_t app_driver_light_set_power(led_indicator_handle_t handle, esp_matter_attr_val_t *val)
+/* The values are remapped by the binding table below */
+static esp_err_t app_driver_light_set_power(void *handle, int32_t value)
 {
 #if CONFIG_BSP_LEDS_NUM > 0
     esp_err_t err = ESP_OK;
-    if (val->val.b) {
-        err = led_indicator_start(handle, BSP_LED_ON);
+    if (value) {
+        err = led_indicator_start((led_indicator_handle_t)handle, BSP_LED_ON);
     } else {
-        err = led_indicator_start(handle, BSP_LED_OFF);
+        err = led_indicator_start((led_indicator_handle_t)handle, BSP_LED_OFF);
     }
     return err;
 #else
-    ESP_LOGI(TAG, "LED set power: %d", val->val.b);
+    ESP_LOGI(TAG, "LED set power: %" PRId32, value);
     return ESP_OK;
 #endif
 }
 
-static esp_err_t app_driver_light_set_brightness(led_indicator_handle_t handle, esp_matter_attr_val_t *val)
+static esp_err_t app_driver_light_set_brightness(void *handle, int32_t value)
 {
-    int value = REMAP_TO_RANGE(val->val.u8, MATTER_BRIGHTNESS, STANDARD_BRIGHTNESS);
 #if CONFIG_BSP_LEDS_NUM > 0
-    return led_indicator_set_brightness(handle, value);
+    return led_indicator_set_brightness((led_indicator_handle_t)handle, value);
 #else
-    ESP_LOGI(TAG, "LED set brightness: %d", value);
+    ESP_LOGI(TAG, "LED set brightness: %" PRId32, value);
     return ESP_OK;
 #endif
 }
 
-static esp_err_t app_driver_light_set_hue(led_indicator_handle_t handle, esp_matter_attr_val_t *val)
+static esp_err_t app_driver_light_set_hue(void *handle, int32_t value)
 {
-    int value = REMAP_TO_RANGE(val->val.u8, MATTER_HUE, STANDARD_HUE);
 #if CONFIG_BSP_LEDS_NUM > 0
     led_indicator_ihsv_t hsv;
-    hsv.value = led_indicator_get_hsv(handle);
+    hsv.value = led_indicator_get_hsv((led_indicator_handle_t)handle);
     hsv.h = value;
-    return led_indicator_set_hsv(handle, hsv.value);
+    return led_indicator_set_hsv((led_indicator_handle_t)handle, hsv.value);
 #else
-    ESP_LOGI(TAG, "LED set hue: %d", value);
+    ESP_LOGI(TAG, "LED set hue: %" PRId32, value);
     return ESP_OK;
 #endif
 }
 
-static esp_err_t app_driver_light_set_saturation(led_indicator_handle_t handle, esp_matter_attr_val_t *val)
+static esp_err_t app_driver_light_set_saturation(void *handle, int32_t value)
 {
-    int value = REMAP_TO_RANGE(val->val.u8, MATTER_SATURATION, STANDARD_SATURATION);
 #if CONFIG_BSP_LEDS_NUM > 0
     led_indicator_ihsv_t hsv;
-    hsv.value = led_indicator_get_hsv(handle);
+    hsv.value = led_indicator_get_hsv((led_indicator_handle_t)handle);
     hsv.s = value;
-    return led_indicator_set_hsv(handle, hsv.value);
+    return led_indicator_set_hsv((led_indicator_handle_t)handle, hsv.value);
 #else
-    ESP_LOGI(TAG, "LED set saturation: %d", value);
+    ESP_LOGI(TAG, "LED set saturation: %" PRId32, value);
     return ESP_OK;
 #endif
 }
 
-static esp_err_t app_driver_light_set_temperature(led_indicator_handle_t handle, esp_matter_attr_val_t *val)
+static esp_err_t app_driver_light_set_temperature(void *handle, int32_t value)
 {
-    uint32_t value = REMAP_TO_RANGE_INVERSE(val->val.u16, STANDARD_TEMPERATURE_FACTOR);
 #if CONFIG_BSP_LEDS_NUM > 0
-    return led_indicator_set_color_temperature(handle, value);
+    return led_indicator_set_color_temperature((led_indicator_handle_t)handle, value);
 #else
-    ESP_LOGI(TAG, "LED set temperature: %ld", value);
+    ESP_LOGI(TAG, "LED set temperature: %" PRId32, value);
     return ESP_OK;
 #endif
 }
 
+/* Attributes of the light endpoint, with the remapping of their values and the driver functions they are set with */
+static const app_driver_binding_entry_t light_bindings[] = {
+    APP_DRIVER_BINDING(OnOff::Id, OnOff::Attributes::OnOff::Id, app_driver_light_set_power),
+    APP_DRIVER_BINDING_REMAP(LevelControl::Id, LevelControl::Attributes::CurrentLevel::Id, MATTER_BRIGHTNESS,
+                             STANDARD_BRIGHTNESS, app_driver_light_set_brightness),
+    APP_DRIVER_BINDING_REMAP(ColorControl::Id, ColorControl::Attributes::CurrentHue::Id, MATTER_HUE, STANDARD_HUE,
+                             app_driver_light_set_hue),
+    APP_DRIVER_BINDING_REMAP(ColorControl::Id, ColorControl::Attributes::CurrentSaturation::Id, MATTER_SATURATION,
+                             STANDARD_SATURATION, app_driver_light_set_saturation),
+    APP_DRIVER_BINDING_REMAP_INVERSE(ColorControl::Id, ColorControl::Attributes::ColorTemperatureMireds::Id,
+                                     STANDARD_TEMPERATURE_FACTOR, app_driver_light_set_temperature),
+};
+
+static app_driver_binding_handle_t app_driver_light_binding()
+{
+    static app_driver_binding_handle_t binding =
+        app_driver_binding_create(light_bindings, sizeof(light_bindings) / sizeof(light_bindings[0]));
+    return binding;
+}
+
 static void app_driver_button_toggle_cb(void *arg, void *data)
 {
     ESP_LOGI(TAG, "Toggle button pressed");
@@ -111,24 +129,7 @@ esp_err_t app_driver_attribute_update(app_driver_handle_t driver_handle, uint16_
 {
     esp_err_t err = ESP_OK;
     if (endpoint_id == light_endpoint_id) {
-        led_indicator_handle_t handle = (led_indicator_handle_t)driver_handle;
-        if (cluster_id == OnOff::Id) {
-            if (attribute_id == OnOff::Attributes::OnOff::Id) {
-                err = app_driver_light_set_power(handle, val);
-            }
-        } else if (cluster_id == LevelControl::Id) {
-            if (attribute_id == LevelControl::Attributes::CurrentLevel::Id) {
-                err = app_driver_light_set_brightness(handle, val);
-            }
-        } else if (cluster_id == ColorControl::Id) {
-            if (attribute_id == ColorControl::Attributes::CurrentHue::Id) {
-                err = app_driver_light_set_hue(handle, val);
-            } else if (attribute_id == ColorControl::Attributes::CurrentSaturation::Id) {
-                err = app_driver_light_set_saturation(handle, val);
-            } else if (attribute_id == ColorControl::Attributes::ColorTemperatureMireds::Id) {
-                err = app_driver_light_set_temperature(handle, val);
-            }
-        }
+        err = app_driver_binding_dispatch(app_driver_light_binding(), driver_handle, cluster_id, attribute_id, val);
     }
     return err;
 }
@@ -137,7 +138,7 @@ esp_err_t app_driver_light_set_defaults(uint16_t endpoint_id)
 {
     esp_err_t err = ESP_OK;
     void *priv_data = endpoint::get_priv_data(endpoint_id);
-    led_indicator_handle_t handle = (led_indicator_handle_t)priv_data;
+    app_driver_binding_handle_t binding = app_driver_light_binding();
     node_t *node = node::get();
     endpoint_t *endpoint = endpoint::get(node, endpoint_id);
     cluster_t *cluster = NULL;
@@ -148,7 +149,8 @@ esp_err_t app_driver_light_set_defaults(uint16_t endpoint_id)
     cluster = cluster::get(endpoint, LevelControl::Id);
     attribute = attribute::get(cluster, LevelControl::Attributes::CurrentLevel::Id);
     attribute::get_val(attribute, &val);
-    err |= app_driver_light_set_brightness(handle, &val);
+    err |= app_driver_binding_dispatch(binding, priv_data, LevelControl::Id, LevelControl::Attributes::CurrentLevel::Id,
+                                      &val);
 
     /* Setting color */
     cluster = cluster::get(endpoint, ColorControl::Id);
@@ -158,16 +160,19 @@ esp_err_t app_driver_light_set_defaults(uint16_t endpoint_id)
         /* Setting hue */
         attribute = attribute::get(cluster, ColorControl::Attributes::CurrentHue::Id);
         attribute::get_val(attribute, &val);
-        err |= app_driver_light_set_hue(handle, &val);
+        err |= app_driver_binding_dispatch(binding, priv_data, ColorControl::Id,
+                                          ColorControl::Attributes::CurrentHue::Id, &val);
         /* Setting saturation */
         attribute = attribute::get(cluster, ColorControl::Attributes::CurrentSaturation::Id);
         attribute::get_val(attribute, &val);
-        err |= app_driver_light_set_saturation(handle, &val);
+        err |= app_driver_binding_dispatch(binding, priv_data, ColorControl::Id,
+                                          ColorControl::Attributes::CurrentSaturation::Id, &val);
     } else if (val.val.u8 == (uint8_t)ColorControl::ColorMode::kColorTemperature) {
         /* Setting temperature */
         attribute = attribute::get(cluster, ColorControl::Attributes::ColorTemperatureMireds::Id);
         attribute::get_val(attribute, &val);
-        err |= app_driver_light_set_temperature(handle, &val);
+        err |= app_driver_binding_dispatch(binding, priv_data, ColorControl::Id,
+                                          ColorControl::Attributes::ColorTemperatureMireds::Id, &val);
     } else {
         ESP_LOGE(TAG, "Color mode not supported");
     }
@@ -176,7 +181,7 @@ esp_err_t app_driver_light_set_defaults(uint16_t endpoint_id)
     cluster = cluster::get(endpoint, OnOff::Id);
     attribute = attribute::get(cluster, OnOff::Attributes::OnOff::Id);
     attribute::get_val(attribute, &val);
-    err |= app_driver_light_set_power(handle, &val);
+    err |= app_driver_binding_dispatch(binding, priv_data, OnOff::Id, OnOff::Attributes::OnOff::Id, &val);
 
     return err;
 }
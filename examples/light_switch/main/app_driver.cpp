@@ -10,6 +10,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if __has_include(<button_event_queue.h>)
+#include <button_event_queue.h>
+#define APP_DRIVER_BUTTON_QUEUE 1
+#endif
 #include <device.h>
 #include <esp_matter.h>
 #include <esp_matter_console.h>
@@ -241,12 +245,36 @@ static void app_driver_button_toggle_cb(void *arg, void *data)
     lock::chip_stack_unlock();
 }
 
+#if APP_DRIVER_BUTTON_QUEUE
+/* Runs in the task of the button queue, waiting for the Matter lock does not hold the esp_timer task */
+static void app_driver_button_event_cb(const button_queue_event_t *event, void *arg)
+{
+    if (event->type == BUTTON_QUEUE_EVENT_PRESS) {
+        app_driver_button_toggle_cb(NULL, arg);
+    }
+}
+#endif
+
 app_driver_handle_t app_driver_switch_init()
 {
     /* Initialize button */
     button_config_t config = button_driver_get_config();
     button_handle_t handle = iot_button_create(&config);
+#if APP_DRIVER_BUTTON_QUEUE
+    /* The iot_button handle is kept for the factory reset, the toggle goes through the button queue */
+    button_queue_config_t queue_config = {
+        .gpio_num = config.gpio_button_config.gpio_num,
+        .active_level = config.gpio_button_config.active_level,
+        .callback = app_driver_button_event_cb,
+    };
+    if (config.type != BUTTON_TYPE_GPIO || button_queue_init(NULL) != ESP_OK ||
+        button_queue_add(&queue_config) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add the button to the button queue");
+        iot_button_register_cb(handle, BUTTON_PRESS_DOWN, app_driver_button_toggle_cb, NULL);
+    }
+#else
     iot_button_register_cb(handle, BUTTON_PRESS_DOWN, app_driver_button_toggle_cb, NULL);
+#endif
 
     /* Other initializations */
 #if CONFIG_ENABLE_CHIP_SHELL
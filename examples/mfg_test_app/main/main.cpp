@@ -13,6 +13,8 @@
 #include <esp_secure_boot.h>
 #include <nvs_flash.h>
 
+#include <mfg_rf_test.h>
+
 #include <crypto/CHIPCryptoPAL.h>
 #include <credentials/attestation_verifier/DeviceAttestationVerifier.h>
 #include <credentials/CHIPCert.h>
@@ -305,4 +307,11 @@ extern "C" void app_main()
     VerifyOrReturn(status, ESP_LOGE(TAG, "ERROR: Failed to validate attestation cert chain (DAC -> PAI -> PAA)"));
 
     test_security_bits();
+
+#if CONFIG_MFG_RF_TEST
+    // Measure the RF performance against the reference station
+    if (mfg_rf_test_run() != ESP_OK) {
+        ESP_LOGE(TAG, "ERROR: RF test failed");
+    }
+#endif
 }
@@ -0,0 +1,250 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#include <sdkconfig.h>
+
+#if CONFIG_MFG_RF_TEST
+#include <esp_event.h>
+#include <esp_log.h>
+#include <esp_netif.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <lwip/sockets.h>
+#include <nvs_flash.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <mfg_rf_test.h>
+
+namespace {
+const char *TAG = "MFG-RF-TEST";
+
+#define CONNECT_TIMEOUT_MS 15000
+#define ECHO_TIMEOUT_MS 1000
+#define ECHO_PAYLOAD_SIZE 64
+#define THROUGHPUT_CHUNK_SIZE 1460
+#define CLOSE_TIMEOUT_MS 5000
+
+#define GOT_IP_BIT BIT0
+
+EventGroupHandle_t s_wifi_events;
+bool s_passed = true;
+
+void report(const char *test, int32_t value, int32_t limit, const char *unit, bool passed)
+{
+    printf("MFG_RF_TEST %s value=%" PRIi32 " limit=%" PRIi32 " unit=%s result=%s\n", test, value, limit, unit,
+           passed ? "PASS" : "FAIL");
+    s_passed = s_passed && passed;
+}
+
+void wifi_event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, void *event_data)
+{
+    if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
+        esp_wifi_connect();
+    } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
+        xEventGroupSetBits(s_wifi_events, GOT_IP_BIT);
+    }
+}
+
+esp_err_t wifi_connect()
+{
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        nvs_flash_erase();
+        err = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(err);
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+    esp_netif_create_default_wifi_sta();
+
+    s_wifi_events = xEventGroupCreate();
+    ESP_ERROR_CHECK(esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_event_handler, NULL));
+    ESP_ERROR_CHECK(esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP, wifi_event_handler, NULL));
+
+    wifi_init_config_t init_config = WIFI_INIT_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_wifi_init(&init_config));
+    wifi_config_t wifi_config = {};
+    strncpy((char *)wifi_config.sta.ssid, CONFIG_MFG_RF_TEST_WIFI_SSID, sizeof(wifi_config.sta.ssid));
+    strncpy((char *)wifi_config.sta.password, CONFIG_MFG_RF_TEST_WIFI_PASSWORD, sizeof(wifi_config.sta.password));
+    ESP_ERROR_CHECK(esp_wifi_set_storage(WIFI_STORAGE_RAM));
+    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
+    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
+    /* The power save would add the DTIM interval to the round-trip times */
+    ESP_ERROR_CHECK(esp_wifi_set_ps(WIFI_PS_NONE));
+    ESP_ERROR_CHECK(esp_wifi_start());
+
+    EventBits_t bits = xEventGroupWaitBits(s_wifi_events, GOT_IP_BIT, pdFALSE, pdTRUE,
+                                           pdMS_TO_TICKS(CONNECT_TIMEOUT_MS));
+    if (!(bits & GOT_IP_BIT)) {
+        ESP_LOGE(TAG, "ERROR: Failed to connect to %s", CONFIG_MFG_RF_TEST_WIFI_SSID);
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+void test_rssi()
+{
+    wifi_ap_record_t ap_info;
+    if (esp_wifi_sta_get_ap_info(&ap_info) != ESP_OK) {
+        ESP_LOGE(TAG, "ERROR: Failed to get the access point info");
+        report("wifi_rssi", 0, CONFIG_MFG_RF_TEST_MIN_RSSI, "dBm", false);
+        return;
+    }
+    report("wifi_rssi", ap_info.rssi, CONFIG_MFG_RF_TEST_MIN_RSSI, "dBm", ap_info.rssi >= CONFIG_MFG_RF_TEST_MIN_RSSI);
+}
+
+bool station_address(uint16_t port, struct sockaddr_in *address)
+{
+    memset(address, 0, sizeof(*address));
+    address->sin_family = AF_INET;
+    address->sin_port = htons(port);
+    if (inet_pton(AF_INET, CONFIG_MFG_RF_TEST_STATION_IP, &address->sin_addr) != 1) {
+        ESP_LOGE(TAG, "ERROR: Invalid station address %s", CONFIG_MFG_RF_TEST_STATION_IP);
+        return false;
+    }
+    return true;
+}
+
+esp_err_t test_udp_echo()
+{
+    struct sockaddr_in address;
+    if (!station_address(CONFIG_MFG_RF_TEST_ECHO_PORT, &address)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        ESP_LOGE(TAG, "ERROR: Failed to create the UDP socket, errno %d", errno);
+        return ESP_FAIL;
+    }
+    struct timeval timeout = {
+        .tv_sec = 0,
+        .tv_usec = ECHO_TIMEOUT_MS * 1000,
+    };
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (connect(sock, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        ESP_LOGE(TAG, "ERROR: Failed to connect the UDP socket, errno %d", errno);
+        close(sock);
+        return ESP_FAIL;
+    }
+
+    uint8_t request[ECHO_PAYLOAD_SIZE];
+    uint8_t response[ECHO_PAYLOAD_SIZE];
+    uint32_t received = 0;
+    int64_t total_us = 0, min_us = INT64_MAX, max_us = 0;
+    for (uint32_t sequence = 0; sequence < CONFIG_MFG_RF_TEST_ECHO_COUNT; sequence++) {
+        memset(request, sequence & 0xFF, sizeof(request));
+        memcpy(request, &sequence, sizeof(sequence));
+        int64_t start = esp_timer_get_time();
+        if (send(sock, request, sizeof(request), 0) != sizeof(request)) {
+            continue;
+        }
+        /* A late response of an earlier request is skipped */
+        while (true) {
+            int length = recv(sock, response, sizeof(response), 0);
+            if (length < 0) {
+                break;
+            }
+            if (length == sizeof(response) && memcmp(request, response, sizeof(request)) == 0) {
+                int64_t rtt_us = esp_timer_get_time() - start;
+                total_us += rtt_us;
+                min_us = rtt_us < min_us ? rtt_us : min_us;
+                max_us = rtt_us > max_us ? rtt_us : max_us;
+                received++;
+                break;
+            }
+        }
+    }
+    close(sock);
+
+    uint32_t loss_percent = (CONFIG_MFG_RF_TEST_ECHO_COUNT - received) * 100 / CONFIG_MFG_RF_TEST_ECHO_COUNT;
+    report("udp_loss", loss_percent, CONFIG_MFG_RF_TEST_MAX_LOSS_PERCENT, "%",
+           loss_percent <= CONFIG_MFG_RF_TEST_MAX_LOSS_PERCENT);
+    if (received == 0) {
+        report("udp_rtt_avg", -1, CONFIG_MFG_RF_TEST_MAX_RTT_MS * 1000, "us", false);
+        return ESP_OK;
+    }
+    int32_t avg_us = (int32_t)(total_us / received);
+    report("udp_rtt_avg", avg_us, CONFIG_MFG_RF_TEST_MAX_RTT_MS * 1000, "us",
+           avg_us <= CONFIG_MFG_RF_TEST_MAX_RTT_MS * 1000);
+    printf("MFG_RF_TEST udp_rtt_min value=%" PRIi32 " unit=us\n", (int32_t)min_us);
+    printf("MFG_RF_TEST udp_rtt_max value=%" PRIi32 " unit=us\n", (int32_t)max_us);
+    return ESP_OK;
+}
+
+esp_err_t test_tcp_throughput()
+{
+    struct sockaddr_in address;
+    if (!station_address(CONFIG_MFG_RF_TEST_SINK_PORT, &address)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock < 0) {
+        ESP_LOGE(TAG, "ERROR: Failed to create the TCP socket, errno %d", errno);
+        return ESP_FAIL;
+    }
+    struct timeval timeout = {
+        .tv_sec = CLOSE_TIMEOUT_MS / 1000,
+        .tv_usec = 0,
+    };
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (connect(sock, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        ESP_LOGE(TAG, "ERROR: Failed to connect to the TCP sink, errno %d", errno);
+        close(sock);
+        return ESP_FAIL;
+    }
+
+    static uint8_t chunk[THROUGHPUT_CHUNK_SIZE];
+    memset(chunk, 0x5A, sizeof(chunk));
+    const uint32_t total = CONFIG_MFG_RF_TEST_THROUGHPUT_KB * 1024;
+    uint32_t sent = 0;
+    int64_t start = esp_timer_get_time();
+    while (sent < total) {
+        size_t length = total - sent < sizeof(chunk) ? total - sent : sizeof(chunk);
+        int written = send(sock, chunk, length, 0);
+        if (written <= 0) {
+            ESP_LOGE(TAG, "ERROR: TCP send failed after %" PRIu32 " bytes, errno %d", sent, errno);
+            break;
+        }
+        sent += written;
+    }
+    /* Wait for the station to close, so that the data in flight is counted */
+    shutdown(sock, SHUT_WR);
+    while (recv(sock, chunk, sizeof(chunk), 0) > 0) {
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    close(sock);
+
+    int32_t kbps = elapsed_us > 0 ? (int32_t)((int64_t)sent * 8 * 1000 / elapsed_us) : 0;
+    report("tcp_throughput", sent == total ? kbps : 0, CONFIG_MFG_RF_TEST_MIN_THROUGHPUT_KBPS, "kbps",
+           sent == total && kbps >= CONFIG_MFG_RF_TEST_MIN_THROUGHPUT_KBPS);
+    return ESP_OK;
+}
+
+}
+
+esp_err_t mfg_rf_test_run()
+{
+    esp_err_t err = wifi_connect();
+    if (err == ESP_OK) {
+        test_rssi();
+        err = test_udp_echo();
+    }
+    if (err == ESP_OK) {
+        err = test_tcp_throughput();
+    }
+    bool passed = err == ESP_OK && s_passed;
+    printf("MFG_RF_TEST summary result=%s\n", passed ? "PASS" : "FAIL");
+    if (err != ESP_OK) {
+        return err;
+    }
+    return passed ? ESP_OK : ESP_FAIL;
+}
+#endif // CONFIG_MFG_RF_TEST
@@ -0,0 +1,26 @@
+/*
+   This example code is in the Public Domain (or CC0 licensed, at your option.)
+
+   Unless required by applicable law or agreed to in writing, this
+   software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+   CONDITIONS OF ANY KIND, either express or implied.
+*/
+
+#pragma once
+
+#include <esp_err.h>
+
+/** Run the Wi-Fi RF test against the reference station
+ *
+ * Connects to the reference access point, then measures the RSSI, the UDP echo round-trip time and loss and the TCP
+ * throughput. Each result is printed on a line for the test fixture:
+ *
+ *     MFG_RF_TEST <test> value=<value> limit=<limit> unit=<unit> result=<PASS|FAIL>
+ *
+ * followed by "MFG_RF_TEST summary result=<PASS|FAIL>".
+ *
+ * @return ESP_OK if all the results are within their limits.
+ * @return ESP_FAIL if a result is out of its limit.
+ * @return error if a test could not run.
+ */
+esp_err_t mfg_rf_test_run();
@@ -0,0 +1,253 @@
+# SPDX-License-Identifier: CC0-1.0
+
+# Multi-controller subscription stress test of the light example.
+#
+# The DUT is commissioned into several fabrics with chip-tool, each fabric opens wildcard subscriptions, and the
+# attributes of the light are changed from the device console during a soak. The report latency of the changes, the
+# dropped subscriptions, the minimum heap and the CPU load are collected into stress_report.json, in the log
+# directory of the session.
+#
+# The CPU load needs CONFIG_FREERTOS_USE_TRACE_FACILITY and CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS in the firmware,
+# it is left out of the report otherwise. The test is long, it is not run with -m esp_matter_dut:
+#
+#   pytest examples/pytest_esp_matter_light_stress.py --target esp32c6 -m esp_matter_stress
+#
+# The shape of the run is set with the environment:
+#   STRESS_FABRICS              fabrics the DUT is commissioned into (3)
+#   STRESS_SUBSCRIPTIONS        wildcard subscriptions per fabric (3, the minimum a device supports per fabric)
+#   STRESS_SOAK_S               duration of the attribute churn (1800)
+#   STRESS_CHURN_INTERVAL_S     interval between two attribute changes (1)
+#   STRESS_SAMPLE_INTERVAL_S    interval between two heap and CPU samples (30)
+#   STRESS_MAX_P99_MS           maximum 99th percentile of the report latency (2000)
+#   STRESS_MIN_FREE_HEAP        minimum free internal heap ever reached (20000)
+
+import json
+import math
+import os
+import pathlib
+import re
+import subprocess
+import threading
+import time
+from typing import Dict, List, Optional
+
+import pexpect
+import pytest
+from pytest_embedded import Dut
+
+CURRENT_DIR_LIGHT = str(pathlib.Path(__file__).parent)+'/light'
+CHIP_TOOL_EXE = str(pathlib.Path(__file__).parent)+ '/../connectedhomeip/connectedhomeip/out/host/chip-tool'
+pytest_build_dir = CURRENT_DIR_LIGHT
+
+NODE_ID = 1
+LIGHT_ENDPOINT = 1
+# The commissioner names of chip-tool, a fabric each
+COMMISSIONERS = ['alpha', 'beta', 'gamma', '4', '5']
+
+FABRICS = int(os.getenv('STRESS_FABRICS', '3'))
+SUBSCRIPTIONS_PER_FABRIC = int(os.getenv('STRESS_SUBSCRIPTIONS', '3'))
+SOAK_S = int(os.getenv('STRESS_SOAK_S', '1800'))
+CHURN_INTERVAL_S = float(os.getenv('STRESS_CHURN_INTERVAL_S', '1'))
+SAMPLE_INTERVAL_S = int(os.getenv('STRESS_SAMPLE_INTERVAL_S', '30'))
+MAX_P99_MS = int(os.getenv('STRESS_MAX_P99_MS', '2000'))
+MIN_FREE_HEAP = int(os.getenv('STRESS_MIN_FREE_HEAP', '20000'))
+# Reports of a change which arrive later than this are counted as missing
+REPORT_TIMEOUT_S = 10
+# The maximum interval of the subscriptions, a subscription not reporting within it is dropped by the controller
+MAX_INTERVAL_S = 30
+
+ONOFF_REPORT = re.compile(r'Endpoint: {} Cluster: 0x0000_0006 Attribute 0x0000_0000 DataVersion'.format(LIGHT_ENDPOINT))
+SUBSCRIPTION_ESTABLISHED = re.compile(r'Subscription established with SubscriptionID = (0x[0-9a-fA-F]+)')
+SUBSCRIPTION_DROPPED = re.compile(r'Subscription Liveness timeout with SubscriptionID = (0x[0-9a-fA-F]+)')
+
+
+def run_chip_tool(args: str) -> str:
+    out_str = subprocess.getoutput(CHIP_TOOL_EXE + ' ' + args)
+    print(out_str)
+    assert len(re.findall(r'Run command failure', str(out_str))) == 0
+    return out_str
+
+
+def commission_fabrics(light: Dut) -> None:
+    light.expect(r'chip\[DL\]\: Configuring CHIPoBLE advertising', timeout=20)
+    time.sleep(5)
+    run_chip_tool('pairing ble-wifi {} ChipTEH2 chiptest123 20202021 3840'.format(NODE_ID))
+    for commissioner in COMMISSIONERS[1:FABRICS]:
+        time.sleep(3)
+        out_str = run_chip_tool('pairing open-commissioning-window {} 1 300 1000 3840'.format(NODE_ID))
+        code = re.findall(r'Manual pairing code: \[(\d+)\]', out_str)
+        assert len(code) == 1
+        time.sleep(3)
+        run_chip_tool('pairing code {} {} --commissioner-name {}'.format(NODE_ID, code[0], commissioner))
+
+
+# Nearest-rank percentile
+def percentile(values: List[float], percent: int) -> Optional[float]:
+    if not values:
+        return None
+    ordered = sorted(values)
+    rank = max(1, math.ceil(percent / 100 * len(ordered)))
+    return round(ordered[rank - 1], 1)
+
+
+class SubscriptionMonitor:
+    """ Keeps the subscriptions in one interactive chip-tool and timestamps the OnOff reports they receive """
+
+    def __init__(self) -> None:
+        self.child = pexpect.spawn(CHIP_TOOL_EXE + ' interactive start', encoding='utf-8', timeout=None)
+        self.lock = threading.Lock()
+        self.established: Dict[str, float] = {}
+        self.dropped: List[str] = []
+        self.reports: List[float] = []
+        self.running = True
+        self.thread = threading.Thread(target=self._read_output, daemon=True)
+        self.thread.start()
+
+    def _read_output(self) -> None:
+        while self.running:
+            try:
+                line = self.child.readline()
+            except (pexpect.EOF, pexpect.TIMEOUT):
+                break
+            if not line:
+                continue
+            now = time.monotonic()
+            with self.lock:
+                if ONOFF_REPORT.search(line):
+                    self.reports.append(now)
+                established = SUBSCRIPTION_ESTABLISHED.search(line)
+                if established:
+                    self.established[established.group(1)] = now
+                dropped = SUBSCRIPTION_DROPPED.search(line)
+                if dropped:
+                    self.dropped.append(dropped.group(1))
+
+    def subscribe(self, commissioner: str) -> None:
+        # Wildcard cluster and attribute on all the endpoints, with a min interval of 0 to measure the latency
+        self.child.sendline('any subscribe-by-id 0xFFFFFFFF 0xFFFFFFFF 0 {} {} 0xFFFF --keepSubscriptions true '
+                            '--commissioner-name {}'.format(MAX_INTERVAL_S, NODE_ID, commissioner))
+
+    def established_count(self) -> int:
+        with self.lock:
+            return len(self.established)
+
+    def reports_since(self, start: float) -> List[float]:
+        with self.lock:
+            return [report for report in self.reports if report >= start]
+
+    def close(self) -> None:
+        self.running = False
+        self.child.sendline('quit()')
+        self.child.close(force=True)
+
+
+def sample_device(light: Dut, samples: List[Dict]) -> None:
+    sample: Dict = {'time_s': round(time.monotonic(), 1)}
+    light.write('matter esp diagnostics mem-dump')
+    sample['free_heap'] = int(light.expect(r'Current Free Memory\s+(\d+)', timeout=5)[1].decode())
+    sample['min_free_heap'] = int(light.expect(r'Min\. Ever Free Size\s+(\d+)', timeout=5)[1].decode())
+    light.write('matter esp diagnostics cpu-load 1000')
+    try:
+        sample['cpu_load'] = int(light.expect(r'CPU load: (\d+)%', timeout=5)[1].decode())
+    except Exception:
+        # The firmware is built without the run time stats of FreeRTOS
+        sample['cpu_load'] = None
+    samples.append(sample)
+
+
+def write_report(report: Dict, log_dir: str) -> None:
+    path = pathlib.Path(log_dir) / 'stress_report.json'
+    with open(path, 'w') as report_file:
+        json.dump(report, report_file, indent=2)
+    print('Stress report ({}):'.format(path))
+    print('\tfabrics {}, subscriptions {}/{} established, {} dropped'.format(
+        report['fabrics'], report['subscriptions_established'], report['subscriptions_expected'],
+        report['subscriptions_dropped']))
+    print('\tchanges {}, reports {}/{} received, latency p50 {} ms, p90 {} ms, p99 {} ms, max {} ms'.format(
+        report['changes'], report['reports_received'], report['reports_expected'], report['latency_p50_ms'],
+        report['latency_p90_ms'], report['latency_p99_ms'], report['latency_max_ms']))
+    print('\theap min free {}, drift {}, CPU load max {}%'.format(
+        report['min_free_heap'], report['heap_drift'], report['cpu_load_max']))
+
+
+@pytest.mark.esp32c6
+@pytest.mark.esp_matter_stress
+@pytest.mark.timeout(SOAK_S + 30 * 60)
+@pytest.mark.parametrize(
+    ' count, app_path, target, erase_all', [
+        ( 1, pytest_build_dir, 'esp32c6', 'y'),
+    ],
+    indirect=True,
+)
+
+# Subscriptions of several fabrics under attribute churn
+def test_matter_subscription_stress_c6(dut:Dut, session_tempdir:str) -> None:
+    light = dut
+    commission_fabrics(light)
+    monitor = SubscriptionMonitor()
+    try:
+        expected = FABRICS * SUBSCRIPTIONS_PER_FABRIC
+        for commissioner in COMMISSIONERS[:FABRICS]:
+            for _ in range(SUBSCRIPTIONS_PER_FABRIC):
+                monitor.subscribe(commissioner)
+                time.sleep(2)
+        deadline = time.monotonic() + 60
+        while monitor.established_count() < expected and time.monotonic() < deadline:
+            time.sleep(1)
+        established = monitor.established_count()
+
+        samples: List[Dict] = []
+        sample_device(light, samples)
+        latencies_ms: List[float] = []
+        missing = 0
+        changes = 0
+        value = 0
+        soak_end = time.monotonic() + SOAK_S
+        next_sample = time.monotonic() + SAMPLE_INTERVAL_S
+        while time.monotonic() < soak_end:
+            # Each subscription gets one report of the OnOff change
+            value ^= 1
+            start = time.monotonic()
+            light.write('matter esp attribute set 0x{:x} 0x6 0x0 {}'.format(LIGHT_ENDPOINT, value))
+            light.write('matter esp attribute set 0x{:x} 0x8 0x0 {}'.format(LIGHT_ENDPOINT, 1 + changes % 254))
+            changes += 1
+            live = established - len(set(monitor.dropped))
+            while len(monitor.reports_since(start)) < live and time.monotonic() - start < REPORT_TIMEOUT_S:
+                time.sleep(0.01)
+            reports = monitor.reports_since(start)[:live]
+            latencies_ms += [(report - start) * 1000 for report in reports]
+            missing += max(0, live - len(reports))
+            if time.monotonic() >= next_sample:
+                sample_device(light, samples)
+                next_sample += SAMPLE_INTERVAL_S
+            time.sleep(max(0.0, CHURN_INTERVAL_S - (time.monotonic() - start)))
+        sample_device(light, samples)
+
+        cpu_loads = [sample['cpu_load'] for sample in samples if sample['cpu_load'] is not None]
+        report = {
+            'fabrics': FABRICS,
+            'subscriptions_expected': expected,
+            'subscriptions_established': established,
+            'subscriptions_dropped': len(set(monitor.dropped)),
+            'soak_s': SOAK_S,
+            'changes': changes,
+            'reports_expected': len(latencies_ms) + missing,
+            'reports_received': len(latencies_ms),
+            'latency_p50_ms': percentile(latencies_ms, 50),
+            'latency_p90_ms': percentile(latencies_ms, 90),
+            'latency_p99_ms': percentile(latencies_ms, 99),
+            'latency_max_ms': round(max(latencies_ms), 1) if latencies_ms else None,
+            'min_free_heap': min(sample['min_free_heap'] for sample in samples),
+            'heap_drift': samples[-1]['free_heap'] - samples[0]['free_heap'],
+            'cpu_load_max': max(cpu_loads) if cpu_loads else None,
+            'samples': samples,
+        }
+        write_report(report, session_tempdir)
+
+        assert established == expected
+        assert report['subscriptions_dropped'] == 0
+        assert missing == 0
+        assert report['latency_p99_ms'] is not None and report['latency_p99_ms'] <= MAX_P99_MS
+        assert report['min_free_heap'] >= MIN_FREE_HEAP
+    finally:
+        monitor.close()
@@ -14,6 +14,7 @@
 #include <esp_matter.h>
 #include <led_driver.h>
 
+#include <app_driver_binding.h>
 #include <app_priv.h>
 
 using namespace chip::app::Clusters;
@@ -22,10 +23,21 @@ using namespace esp_matter;
 static const char *TAG = "app_driver";
 extern uint16_t room_air_conditioner_endpoint_id;
 
-/* Do any conversions/remapping for the actual value here */
-static esp_err_t app_driver_room_air_conditioner_set_power(led_driver_handle_t handle, esp_matter_attr_val_t *val)
+/* Do any conversions/remapping for the actual value in the binding table below */
+static esp_err_t app_driver_room_air_conditioner_set_power(void *handle, int32_t value)
 {
-    return led_driver_set_power(handle, val->val.b);
+    return led_driver_set_power((led_driver_handle_t)handle, value);
+}
+
+static const app_driver_binding_entry_t room_air_conditioner_bindings[] = {
+    APP_DRIVER_BINDING(OnOff::Id, OnOff::Attributes::OnOff::Id, app_driver_room_air_conditioner_set_power),
+};
+
+static app_driver_binding_handle_t app_driver_room_air_conditioner_binding()
+{
+    static const size_t count = sizeof(room_air_conditioner_bindings) / sizeof(room_air_conditioner_bindings[0]);
+    static app_driver_binding_handle_t binding = app_driver_binding_create(room_air_conditioner_bindings, count);
+    return binding;
 }
 
 static void app_driver_button_toggle_cb(void *arg, void *data)
@@ -51,12 +63,8 @@ esp_err_t app_driver_attribute_update(app_driver_handle_t driver_handle, uint16_
 {
     esp_err_t err = ESP_OK;
     if (endpoint_id == room_air_conditioner_endpoint_id) {
-        led_driver_handle_t handle = (led_driver_handle_t)driver_handle;
-        if (cluster_id == OnOff::Id) {
-            if (attribute_id == OnOff::Attributes::OnOff::Id) {
-                err = app_driver_room_air_conditioner_set_power(handle, val);
-            }
-        }
+        err = app_driver_binding_dispatch(app_driver_room_air_conditioner_binding(), driver_handle, cluster_id,
+                                          attribute_id, val);
     }
     return err;
 }
@@ -65,7 +73,6 @@ esp_err_t app_driver_room_air_conditioner_set_defaults(uint16_t endpoint_id)
 {
     esp_err_t err = ESP_OK;
     void *priv_data = endpoint::get_priv_data(endpoint_id);
-    led_driver_handle_t handle = (led_driver_handle_t)priv_data;
     node_t *node = node::get();
     endpoint_t *endpoint = endpoint::get(node, endpoint_id);
     cluster_t *cluster = NULL;
@@ -76,7 +83,8 @@ esp_err_t app_driver_room_air_conditioner_set_defaults(uint16_t endpoint_id)
     cluster = cluster::get(endpoint, OnOff::Id);
     attribute = attribute::get(cluster, OnOff::Attributes::OnOff::Id);
     attribute::get_val(attribute, &val);
-    err |= app_driver_room_air_conditioner_set_power(handle, &val);
+    err |= app_driver_binding_dispatch(app_driver_room_air_conditioner_binding(), priv_data, OnOff::Id,
+                                       OnOff::Attributes::OnOff::Id, &val);
 
     return err;
 }
@@ -98,11 +98,27 @@ void esp_zb_app_signal_handler(esp_zb_app_signal_t *signal_struct)
     }
 }
 
+static esp_err_t zb_action_handler(esp_zb_core_action_callback_id_t callback_id, const void *message)
+{
+    esp_err_t ret = ESP_OK;
+    switch (callback_id) {
+    case ESP_ZB_CORE_REPORT_ATTR_CB_ID:
+        ret = zigbee_bridge_report_attribute((const esp_zb_zcl_report_attr_message_t *)message);
+        break;
+    default:
+        ESP_LOGD(TAG, "Receive Zigbee action(0x%x) callback", callback_id);
+        break;
+    }
+    return ret;
+}
+
 static void zboss_task(void *pvParameters)
 {
     /* initialize Zigbee stack with Zigbee coordinator config */
     esp_zb_cfg_t zb_nwk_cfg = ESP_ZB_ZC_CONFIG();
     esp_zb_init(&zb_nwk_cfg);
+    /* The attribute reports of the bridged devices are applied to the Matter data model */
+    esp_zb_core_action_handler_register(zb_action_handler);
     /* initiate Zigbee Stack start without zb_send_no_autostart_signal auto-start */
     esp_zb_set_primary_network_channel_set(ESP_ZB_PRIMARY_CHANNEL_MASK);
     ESP_ERROR_CHECK(esp_zb_start(false));
@@ -12,8 +12,14 @@
 #include <esp_log.h>
 #include <esp_matter.h>
 #include <esp_matter_bridge.h>
+#include <freertos/FreeRTOS.h>
+#include <string.h>
 #include <zigbee_bridge.h>
 
+#include <app/CommandHandler.h>
+#include <lib/core/NodeId.h>
+#include <platform/CHIPDeviceLayer.h>
+
 static const char *TAG = "zigbee_bridge";
 
 using namespace chip::app::Clusters;
@@ -22,6 +28,52 @@ using namespace esp_matter::cluster;
 
 extern uint16_t aggregator_endpoint_id;
 
+#define ZIGBEE_BRIDGE_COALESCE_WINDOW_MS CONFIG_ZIGBEE_BRIDGE_COALESCE_WINDOW_MS
+#define ZIGBEE_BRIDGE_MAX_PENDING_COMMANDS CONFIG_ZIGBEE_BRIDGE_MAX_PENDING_COMMANDS
+#define ZIGBEE_BRIDGE_MAX_GROUP_MEMBERSHIPS CONFIG_ZIGBEE_BRIDGE_MAX_GROUP_MEMBERSHIPS
+#define ZIGBEE_BRIDGE_REPORT_BATCH_SIZE CONFIG_ZIGBEE_BRIDGE_REPORT_BATCH_SIZE
+
+/* On/Off command waiting for the end of the coalescing window, the last command of a device wins */
+typedef struct {
+    uint16_t short_addr;
+    uint8_t dst_endpoint;
+    uint8_t src_endpoint;
+    /* Matter group of the command, 0 for a unicast command */
+    uint16_t group_id;
+    uint8_t cmd_id;
+    bool has_cmd;
+} pending_command_t;
+
+/* Matter group membership of a bridged device, mirrored to the Zigbee device */
+typedef struct {
+    uint16_t short_addr;
+    uint8_t endpoint;
+    uint16_t group_id;
+} group_membership_t;
+
+/* Zigbee attribute report waiting to be applied to the data model */
+typedef struct {
+    uint16_t short_addr;
+    uint16_t cluster_id;
+    uint16_t attribute_id;
+    bool value;
+} pending_report_t;
+
+/* Accessed in the Matter context only */
+static pending_command_t s_pending_commands[ZIGBEE_BRIDGE_MAX_PENDING_COMMANDS];
+static size_t s_pending_command_count = 0;
+static bool s_command_timer_started = false;
+static group_membership_t s_group_memberships[ZIGBEE_BRIDGE_MAX_GROUP_MEMBERSHIPS];
+static size_t s_group_membership_count = 0;
+/* Set while the Zigbee reports are applied, so that they are not sent back to the devices */
+static bool s_ingesting_reports = false;
+
+/* Filled in the Zigbee task, drained in the Matter context */
+static pending_report_t s_pending_reports[ZIGBEE_BRIDGE_REPORT_BATCH_SIZE];
+static size_t s_pending_report_count = 0;
+static uint32_t s_dropped_report_count = 0;
+static portMUX_TYPE s_pending_report_lock = portMUX_INITIALIZER_UNLOCKED;
+
 void zigbee_bridge_find_bridged_on_off_light_cb(esp_zb_zdp_status_t zdo_status, uint16_t addr, uint8_t endpoint, void *user_ctx)
 {
     ESP_LOGI(TAG, "on_off_light found: address:0x%" PRIx16 ", endpoint:%" PRId8 ", response_status:%d", addr, endpoint, zdo_status);
@@ -49,21 +101,125 @@ void zigbee_bridge_find_bridged_on_off_light_cb(esp_zb_zdp_status_t zdo_status,
     }
 }
 
+/** Outgoing commands **/
+static void send_on_off_command(uint16_t addr, uint8_t dst_endpoint, uint8_t src_endpoint,
+                                esp_zb_zcl_address_mode_t address_mode, uint8_t cmd_id)
+{
+    esp_zb_zcl_on_off_cmd_t cmd_req;
+    cmd_req.zcl_basic_cmd.dst_addr_u.addr_short = addr;
+    cmd_req.zcl_basic_cmd.dst_endpoint = dst_endpoint;
+    cmd_req.zcl_basic_cmd.src_endpoint = src_endpoint;
+    cmd_req.address_mode = address_mode;
+    cmd_req.on_off_cmd_id = cmd_id;
+    esp_zb_zcl_on_off_cmd_req(&cmd_req);
+}
+
+static size_t count_group_members(uint16_t group_id)
+{
+    size_t count = 0;
+    for (size_t index = 0; index < s_group_membership_count; index++) {
+        if (s_group_memberships[index].group_id == group_id) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/* A group is sent as a single group cast if all the Zigbee members of the group got the same command */
+static bool can_group_cast(const pending_command_t *commands, size_t count, uint16_t group_id, uint8_t cmd_id)
+{
+    size_t members = 0;
+    for (size_t index = 0; index < count; index++) {
+        if (commands[index].group_id != group_id || !commands[index].has_cmd) {
+            continue;
+        }
+        if (commands[index].cmd_id != cmd_id) {
+            return false;
+        }
+        members++;
+    }
+    return members > 1 && members == count_group_members(group_id);
+}
+
+static void flush_pending_commands(chip::System::Layer *layer, void *ctx)
+{
+    s_command_timer_started = false;
+    for (size_t index = 0; index < s_pending_command_count; index++) {
+        pending_command_t *command = &s_pending_commands[index];
+        if (!command->has_cmd) {
+            continue;
+        }
+        if (command->group_id != 0 &&
+            can_group_cast(s_pending_commands, s_pending_command_count, command->group_id, command->cmd_id)) {
+            ESP_LOGD(TAG, "Group cast of command %u to group 0x%04" PRIx16, command->cmd_id, command->group_id);
+            send_on_off_command(command->group_id, 0, command->src_endpoint,
+                                ESP_ZB_APS_ADDR_MODE_16_GROUP_ENDP_NOT_PRESENT, command->cmd_id);
+            for (size_t member = index; member < s_pending_command_count; member++) {
+                if (s_pending_commands[member].group_id == command->group_id) {
+                    s_pending_commands[member].has_cmd = false;
+                }
+            }
+            continue;
+        }
+        send_on_off_command(command->short_addr, command->dst_endpoint, command->src_endpoint,
+                            ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT, command->cmd_id);
+    }
+    s_pending_command_count = 0;
+}
+
+static pending_command_t *get_pending_command(app_bridged_device_t *zigbee_device)
+{
+    for (size_t index = 0; index < s_pending_command_count; index++) {
+        if (s_pending_commands[index].short_addr == zigbee_device->dev_addr.zigbee_shortaddr &&
+            s_pending_commands[index].dst_endpoint == zigbee_device->dev_addr.zigbee_endpointid) {
+            return &s_pending_commands[index];
+        }
+    }
+    if (s_pending_command_count == ZIGBEE_BRIDGE_MAX_PENDING_COMMANDS) {
+        /* Make room for the new device */
+        flush_pending_commands(nullptr, nullptr);
+    }
+    pending_command_t *command = &s_pending_commands[s_pending_command_count++];
+    command->short_addr = zigbee_device->dev_addr.zigbee_shortaddr;
+    command->dst_endpoint = zigbee_device->dev_addr.zigbee_endpointid;
+    command->src_endpoint = esp_matter::endpoint::get_id(zigbee_device->dev->endpoint);
+    command->group_id = 0;
+    command->has_cmd = false;
+    if (!s_command_timer_started) {
+        s_command_timer_started = chip::DeviceLayer::SystemLayer().StartTimer(
+            chip::System::Clock::Milliseconds32(ZIGBEE_BRIDGE_COALESCE_WINDOW_MS), flush_pending_commands,
+            nullptr) == CHIP_NO_ERROR;
+    }
+    return command;
+}
+
 esp_err_t zigbee_bridge_attribute_update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
                                          esp_matter_attr_val_t *val, app_bridged_device_t *zigbee_device)
 {
+    if (s_ingesting_reports) {
+        /* The value comes from the device */
+        return ESP_OK;
+    }
     if (zigbee_device && zigbee_device->dev && zigbee_device->dev->endpoint) {
         if (cluster_id == OnOff::Id) {
             if (attribute_id == OnOff::Attributes::OnOff::Id) {
                 ESP_LOGD(TAG, "Update Bridged Device, ep: %" PRId16 ", cluster: %" PRId32 ", att: %" PRId32 "", endpoint_id, cluster_id,
                          attribute_id);
-                esp_zb_zcl_on_off_cmd_t cmd_req;
-                cmd_req.zcl_basic_cmd.dst_addr_u.addr_short = zigbee_device->dev_addr.zigbee_shortaddr;
-                cmd_req.zcl_basic_cmd.dst_endpoint = zigbee_device->dev_addr.zigbee_endpointid;
-                cmd_req.zcl_basic_cmd.src_endpoint = esp_matter::endpoint::get_id(zigbee_device->dev->endpoint);
-                cmd_req.address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT;
-                cmd_req.on_off_cmd_id = val->val.b ? ESP_ZB_ZCL_CMD_ON_OFF_ON_ID : ESP_ZB_ZCL_CMD_ON_OFF_OFF_ID;
-                esp_zb_zcl_on_off_cmd_req(&cmd_req);
+                uint8_t cmd_id = val->val.b ? ESP_ZB_ZCL_CMD_ON_OFF_ON_ID : ESP_ZB_ZCL_CMD_ON_OFF_OFF_ID;
+                if (ZIGBEE_BRIDGE_COALESCE_WINDOW_MS == 0) {
+                    send_on_off_command(zigbee_device->dev_addr.zigbee_shortaddr,
+                                        zigbee_device->dev_addr.zigbee_endpointid,
+                                        esp_matter::endpoint::get_id(zigbee_device->dev->endpoint),
+                                        ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT, cmd_id);
+                    return ESP_OK;
+                }
+                pending_command_t *command = get_pending_command(zigbee_device);
+                command->cmd_id = cmd_id;
+                command->has_cmd = true;
+                if (!s_command_timer_started) {
+                    /* The window could not be started, the commands are sent right away */
+                    flush_pending_commands(nullptr, nullptr);
+                }
             }
         }
     }
@@ -72,3 +228,206 @@ esp_err_t zigbee_bridge_attribute_update(uint16_t endpoint_id, uint32_t cluster_
     }
     return ESP_OK;
 }
+
+/** Matter groups **/
+static esp_err_t on_off_command_cb(const ConcreteCommandPath &command_path, TLVReader &tlv_data, void *opaque_ptr)
+{
+    chip::app::CommandHandler *command_obj = (chip::app::CommandHandler *)opaque_ptr;
+    app_bridged_device_t *zigbee_device =
+        (app_bridged_device_t *)esp_matter::endpoint::get_priv_data(command_path.mEndpointId);
+    if (!command_obj || !zigbee_device || ZIGBEE_BRIDGE_COALESCE_WINDOW_MS == 0) {
+        return ESP_OK;
+    }
+    /* A group command is received for all the endpoints of the group, the OnOff server updates the attribute of each
+     * of them right after this callback */
+    chip::Access::SubjectDescriptor subject = command_obj->GetSubjectDescriptor();
+    pending_command_t *command = get_pending_command(zigbee_device);
+    command->group_id = subject.authMode == chip::Access::AuthMode::kGroup ? chip::GroupIdFromNodeId(subject.subject)
+                                                                            : 0;
+    return ESP_OK;
+}
+
+static void send_group_command(const group_membership_t *membership, uint8_t src_endpoint, bool add)
+{
+    esp_zb_zcl_groups_cmd_t cmd_req;
+    cmd_req.zcl_basic_cmd.dst_addr_u.addr_short = membership->short_addr;
+    cmd_req.zcl_basic_cmd.dst_endpoint = membership->endpoint;
+    cmd_req.zcl_basic_cmd.src_endpoint = src_endpoint;
+    cmd_req.address_mode = ESP_ZB_APS_ADDR_MODE_16_ENDP_PRESENT;
+    cmd_req.group_id = membership->group_id;
+    if (add) {
+        esp_zb_zcl_groups_add_group_cmd_req(&cmd_req);
+    } else {
+        esp_zb_zcl_groups_remove_group_cmd_req(&cmd_req);
+    }
+}
+
+static void remove_group_memberships(app_bridged_device_t *zigbee_device, bool all_groups, uint16_t group_id)
+{
+    size_t index = 0;
+    while (index < s_group_membership_count) {
+        group_membership_t *membership = &s_group_memberships[index];
+        if (membership->short_addr == zigbee_device->dev_addr.zigbee_shortaddr &&
+            membership->endpoint == zigbee_device->dev_addr.zigbee_endpointid &&
+            (all_groups || membership->group_id == group_id)) {
+            send_group_command(membership, esp_matter::endpoint::get_id(zigbee_device->dev->endpoint), false);
+            *membership = s_group_memberships[--s_group_membership_count];
+        } else {
+            index++;
+        }
+    }
+}
+
+static esp_err_t groups_command_cb(const ConcreteCommandPath &command_path, TLVReader &tlv_data, void *opaque_ptr)
+{
+    app_bridged_device_t *zigbee_device =
+        (app_bridged_device_t *)esp_matter::endpoint::get_priv_data(command_path.mEndpointId);
+    if (!zigbee_device) {
+        return ESP_OK;
+    }
+    if (command_path.mCommandId == Groups::Commands::RemoveAllGroups::Id) {
+        remove_group_memberships(zigbee_device, true, 0);
+        return ESP_OK;
+    }
+    uint16_t group_id = 0;
+    if (command_path.mCommandId == Groups::Commands::AddGroup::Id) {
+        Groups::Commands::AddGroup::DecodableType command_data;
+        if (chip::app::DataModel::Decode(tlv_data, command_data) != CHIP_NO_ERROR) {
+            return ESP_OK;
+        }
+        group_id = command_data.groupID;
+    } else {
+        Groups::Commands::RemoveGroup::DecodableType command_data;
+        if (chip::app::DataModel::Decode(tlv_data, command_data) != CHIP_NO_ERROR) {
+            return ESP_OK;
+        }
+        group_id = command_data.groupID;
+    }
+    remove_group_memberships(zigbee_device, false, group_id);
+    if (command_path.mCommandId == Groups::Commands::AddGroup::Id) {
+        if (s_group_membership_count == ZIGBEE_BRIDGE_MAX_GROUP_MEMBERSHIPS) {
+            /* The group commands of this device are sent as unicast commands */
+            ESP_LOGW(TAG, "No room to mirror group 0x%04" PRIx16 " to the Zigbee device", group_id);
+            return ESP_OK;
+        }
+        group_membership_t *membership = &s_group_memberships[s_group_membership_count++];
+        membership->short_addr = zigbee_device->dev_addr.zigbee_shortaddr;
+        membership->endpoint = zigbee_device->dev_addr.zigbee_endpointid;
+        membership->group_id = group_id;
+        send_group_command(membership, esp_matter::endpoint::get_id(zigbee_device->dev->endpoint), true);
+    }
+    return ESP_OK;
+}
+
+esp_err_t zigbee_bridge_add_command_callbacks(endpoint_t *endpoint)
+{
+    static const uint32_t on_off_commands[] = {OnOff::Commands::Off::Id, OnOff::Commands::On::Id,
+                                               OnOff::Commands::Toggle::Id};
+    static const uint32_t groups_commands[] = {Groups::Commands::AddGroup::Id, Groups::Commands::RemoveGroup::Id,
+                                               Groups::Commands::RemoveAllGroups::Id};
+    cluster_t *on_off_cluster = cluster::get(endpoint, OnOff::Id);
+    cluster_t *groups_cluster = cluster::get(endpoint, Groups::Id);
+    ESP_RETURN_ON_FALSE(on_off_cluster && groups_cluster, ESP_ERR_INVALID_ARG, TAG,
+                        "The endpoint has no OnOff or Groups cluster");
+    for (uint32_t command_id : on_off_commands) {
+        command_t *command = command::get(on_off_cluster, command_id, COMMAND_FLAG_ACCEPTED);
+        if (command) {
+            command::set_user_callback(command, on_off_command_cb);
+        }
+    }
+    for (uint32_t command_id : groups_commands) {
+        command_t *command = command::get(groups_cluster, command_id, COMMAND_FLAG_ACCEPTED);
+        if (command) {
+            command::set_user_callback(command, groups_command_cb);
+        }
+    }
+    return ESP_OK;
+}
+
+/** Incoming reports **/
+static void apply_pending_reports(chip::System::Layer *layer, void *ctx)
+{
+    /* Only used in the Matter context, they are kept off the stack of the Matter task */
+    static pending_report_t reports[ZIGBEE_BRIDGE_REPORT_BATCH_SIZE];
+    static attribute::batch_entry_t entries[ZIGBEE_BRIDGE_REPORT_BATCH_SIZE];
+    taskENTER_CRITICAL(&s_pending_report_lock);
+    size_t count = s_pending_report_count;
+    memcpy(reports, s_pending_reports, count * sizeof(pending_report_t));
+    s_pending_report_count = 0;
+    uint32_t dropped = s_dropped_report_count;
+    s_dropped_report_count = 0;
+    taskEXIT_CRITICAL(&s_pending_report_lock);
+    if (dropped > 0) {
+        ESP_LOGW(TAG, "%" PRIu32 " Zigbee reports were dropped, the report batch is full", dropped);
+    }
+
+    size_t entry_count = 0;
+    for (size_t index = 0; index < count; index++) {
+        uint16_t endpoint_id = app_bridge_get_matter_endpointid_by_zigbee_shortaddr(reports[index].short_addr);
+        if (endpoint_id == chip::kInvalidEndpointId) {
+            continue;
+        }
+        if (reports[index].cluster_id == ESP_ZB_ZCL_CLUSTER_ID_ON_OFF &&
+            reports[index].attribute_id == ESP_ZB_ZCL_ATTR_ON_OFF_ON_OFF_ID) {
+            entries[entry_count].endpoint_id = endpoint_id;
+            entries[entry_count].cluster_id = OnOff::Id;
+            entries[entry_count].attribute_id = OnOff::Attributes::OnOff::Id;
+            entries[entry_count].val = esp_matter_bool(reports[index].value);
+            entry_count++;
+        }
+    }
+    if (entry_count > 0) {
+        s_ingesting_reports = true;
+        attribute::update_batch(entries, entry_count);
+        s_ingesting_reports = false;
+    }
+}
+
+static void start_report_window(intptr_t arg)
+{
+    if (chip::DeviceLayer::SystemLayer().StartTimer(
+            chip::System::Clock::Milliseconds32(ZIGBEE_BRIDGE_COALESCE_WINDOW_MS), apply_pending_reports, nullptr) !=
+        CHIP_NO_ERROR) {
+        apply_pending_reports(nullptr, nullptr);
+    }
+}
+
+esp_err_t zigbee_bridge_report_attribute(const esp_zb_zcl_report_attr_message_t *message)
+{
+    ESP_RETURN_ON_FALSE(message, ESP_ERR_INVALID_ARG, TAG, "Empty report message");
+    if (message->status != ESP_ZB_ZCL_STATUS_SUCCESS || message->cluster != ESP_ZB_ZCL_CLUSTER_ID_ON_OFF ||
+        message->attribute.id != ESP_ZB_ZCL_ATTR_ON_OFF_ON_OFF_ID ||
+        message->attribute.data.type != ESP_ZB_ZCL_ATTR_TYPE_BOOL || !message->attribute.data.value) {
+        return ESP_OK;
+    }
+    pending_report_t report = {
+        .short_addr = message->src_address.u.short_addr,
+        .cluster_id = message->cluster,
+        .attribute_id = message->attribute.id,
+        .value = *(bool *)message->attribute.data.value,
+    };
+    bool start_window = false;
+    taskENTER_CRITICAL(&s_pending_report_lock);
+    size_t index = 0;
+    while (index < s_pending_report_count &&
+           (s_pending_reports[index].short_addr != report.short_addr ||
+            s_pending_reports[index].cluster_id != report.cluster_id ||
+            s_pending_reports[index].attribute_id != report.attribute_id)) {
+        index++;
+    }
+    if (index < s_pending_report_count) {
+        /* The last report of the path wins */
+        s_pending_reports[index] = report;
+    } else if (s_pending_report_count < ZIGBEE_BRIDGE_REPORT_BATCH_SIZE) {
+        start_window = s_pending_report_count == 0;
+        s_pending_reports[s_pending_report_count++] = report;
+    } else {
+        s_dropped_report_count++;
+    }
+    taskEXIT_CRITICAL(&s_pending_report_lock);
+    if (start_window) {
+        /* The reports are applied in the Matter context, the Zigbee task never waits for the Matter stack lock */
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(start_report_window, 0);
+    }
+    return ESP_OK;
+}
@@ -18,3 +18,27 @@ void zigbee_bridge_find_bridged_on_off_light_cb(esp_zb_zdp_status_t zdo_status,
 
 esp_err_t zigbee_bridge_attribute_update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
                                          esp_matter_attr_val_t *val, app_bridged_device_t *zigbee_device);
+
+/** Add the callbacks mirroring the Matter group commands of a bridged On/Off light to the Zigbee device
+ *
+ * The Groups commands of the endpoint are forwarded to the Zigbee device, so that the On/Off commands sent to a
+ * Matter group are sent as a single Zigbee group cast when all the Zigbee members of the group get the same command.
+ *
+ * @param[in] endpoint Bridged endpoint, with the OnOff and Groups clusters.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t zigbee_bridge_add_command_callbacks(esp_matter::endpoint_t *endpoint);
+
+/** Apply a Zigbee attribute report to the bridged device
+ *
+ * Called in the Zigbee task. The reports received during CONFIG_ZIGBEE_BRIDGE_COALESCE_WINDOW_MS are applied
+ * together, in the Matter context, with a single batched attribute update.
+ *
+ * @param[in] message Attribute report received by the Zigbee stack.
+ *
+ * @return ESP_OK on success.
+ * @return error in case of failure.
+ */
+esp_err_t zigbee_bridge_report_attribute(const esp_zb_zcl_report_attr_message_t *message);
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Script to generate the manifest of the cluster servers used by an application, for
+CONFIG_ESP_MATTER_CLUSTER_SERVER_PRUNING.
+
+Build the application once without the pruning, then run the script on its ELF file. The linker keeps only the
+cluster::<name>::create() functions the application calls, with the plugin init and the command callbacks of their
+cluster servers, so these symbols give the cluster servers in use. They are mapped to the server directories of the
+SDK with src/app/zap_cluster_list.json. Run it again when the application creates other clusters.
+
+Usage: generate_cluster_manifest.py build/app.elf [-o cluster_manifest.txt] [--sdk connectedhomeip/connectedhomeip]
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+from pathlib import Path
+
+try:
+    from elftools.elf.elffile import ELFFile
+    from elftools.elf.sections import SymbolTableSection
+except ImportError:
+    print('pyelftools is needed, it is installed in the ESP-IDF environment', file=sys.stderr)
+    sys.exit(1)
+
+ESP_MATTER_PATH = Path(__file__).parent.parent.parent.absolute()
+DEFAULT_SDK = ESP_MATTER_PATH / 'connectedhomeip' / 'connectedhomeip'
+
+# Plugin init of a cluster server, and the callbacks of its commands and server init, skipping the weak
+# emberAf<Cluster>ClusterInitCallback stubs of zap_common/app/callback-stub.cpp which are all linked
+PATTERNS = [
+    re.compile(r'Matter(\w+?)PluginServerInitCallback'),
+    re.compile(r'emberAf(\w+?)Cluster(?!InitCallback)\w+Callback'),
+]
+
+
+def normalize(name):
+    return name.replace('_', '').lower()
+
+
+def load_server_directories(sdk):
+    with open(Path(sdk) / 'src' / 'app' / 'zap_cluster_list.json') as f:
+        servers = json.load(f)['ServerDirectories']
+    # ON_OFF_CLUSTER -> onoff, matched with the CamelCase names of the symbols
+    return {normalize(key[:-len('_CLUSTER')] if key.endswith('_CLUSTER') else key): dirs
+            for key, dirs in servers.items()}
+
+
+def find_clusters(elf_path):
+    clusters = set()
+    with open(elf_path, 'rb') as f:
+        elf = ELFFile(f)
+        for section in elf.iter_sections():
+            if not isinstance(section, SymbolTableSection):
+                continue
+            for symbol in section.iter_symbols():
+                if symbol['st_info']['type'] != 'STT_FUNC' or symbol['st_shndx'] == 'SHN_UNDEF':
+                    continue
+                for pattern in PATTERNS:
+                    match = pattern.search(symbol.name)
+                    if match:
+                        clusters.add(match.group(1))
+                        break
+    return clusters
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the manifest of the cluster servers used by an application')
+    parser.add_argument('elf', help='ELF file of the application built without the pruning')
+    parser.add_argument('-o', '--output', default='cluster_manifest.txt', help='Generated manifest')
+    parser.add_argument('--sdk', default=os.environ.get('MATTER_SDK_PATH', DEFAULT_SDK), help='Matter SDK path')
+    args = parser.parse_args()
+
+    directories = load_server_directories(args.sdk)
+    clusters = find_clusters(args.elf)
+    if not clusters:
+        print(f'No cluster server found in {args.elf}', file=sys.stderr)
+        return 1
+    used = set()
+    for cluster in sorted(clusters):
+        dirs = directories.get(normalize(cluster))
+        if dirs is None:
+            print(f'No server directory for {cluster}, add it to the manifest if it has one', file=sys.stderr)
+            continue
+        used.update(dirs)
+    with open(args.output, 'w') as f:
+        f.write(f'# Cluster servers of {Path(args.elf).name}, generated by generate_cluster_manifest.py\n')
+        for directory in sorted(used):
+            f.write(directory + '\n')
+    print(f'{len(used)} cluster server directories written to {args.output}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Script to generate the descriptor table of the compact controller data model logger.
+
+The clusters, attributes, commands and events are taken from the ZAP generated DataModelLogger.cpp, so the table
+follows the same data model version. Run it again after regenerating that file.
+
+Usage: generate_logger_table.py [-i zap-generated/DataModelLogger.cpp] [-o compact/DataModelLoggerTable.cpp]
+"""
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+LOGGER_DIR = Path(__file__).parent.parent.parent.absolute() / 'components' / 'esp_matter_controller' / 'logger'
+DEFAULT_INPUT = LOGGER_DIR / 'zap-generated' / 'DataModelLogger.cpp'
+DEFAULT_OUTPUT = LOGGER_DIR / 'compact' / 'DataModelLoggerTable.cpp'
+
+FUNCTIONS = {
+    'LogAttribute': 'Attributes',
+    'LogCommand': 'Commands',
+    'LogEvent': 'Events',
+}
+
+FUNCTION_RE = re.compile(r'^CHIP_ERROR DataModelLogger::(\w+)\(')
+CLUSTER_RE = re.compile(r'^    case (\w+)::Id: \{')
+ELEMENT_RE = re.compile(r'^        case (\w+)::(Attributes|Commands|Events)::(\w+)::Id: \{')
+
+# Global attributes are the same for all the clusters, they are kept in a single table
+GLOBAL_ATTRIBUTES = [
+    'GeneratedCommandList',
+    'AcceptedCommandList',
+    'EventList',
+    'AttributeList',
+    'FeatureMap',
+    'ClusterRevision',
+]
+
+HEADER = '''// Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// THIS FILE IS GENERATED BY tools/controller_logger/generate_logger_table.py
+
+#include <app-common/zap-generated/ids/Attributes.h>
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app-common/zap-generated/ids/Commands.h>
+#include <app-common/zap-generated/ids/Events.h>
+
+#include "DataModelLoggerTable.h"
+
+using namespace chip::app::Clusters;
+
+namespace data_model_logger {
+
+#define ELEMENTS(table) table, sizeof(table) / sizeof(table[0])
+#define NO_ELEMENTS nullptr, 0
+'''
+
+FOOTER = '''
+} // namespace data_model_logger
+'''
+
+
+def parse(input_path):
+    clusters = {}
+    order = []
+    kind = None
+    cluster = None
+    with open(input_path) as f:
+        for line in f:
+            match = FUNCTION_RE.match(line)
+            if match:
+                kind = FUNCTIONS.get(match.group(1))
+                cluster = None
+                continue
+            if not kind:
+                continue
+            match = CLUSTER_RE.match(line)
+            if match:
+                cluster = match.group(1)
+                if cluster not in clusters:
+                    clusters[cluster] = {'Attributes': [], 'Commands': [], 'Events': []}
+                    order.append(cluster)
+                continue
+            match = ELEMENT_RE.match(line)
+            if match and match.group(1) == cluster and match.group(2) == kind:
+                name = match.group(3)
+                if kind == 'Attributes' and name in GLOBAL_ATTRIBUTES:
+                    continue
+                clusters[cluster][kind].append(name)
+    return clusters, order
+
+
+def generate(clusters, order):
+    out = [HEADER]
+    out.append('const element_descriptor_t k_global_attributes[] = {')
+    for name in GLOBAL_ATTRIBUTES:
+        out.append(f'    {{Globals::Attributes::{name}::Id, "{name}"}},')
+    out.append('};')
+    out.append('const size_t k_global_attribute_count = sizeof(k_global_attributes) / sizeof(k_global_attributes[0]);')
+
+    for cluster in order:
+        for kind, elements in clusters[cluster].items():
+            if not elements:
+                continue
+            out.append('')
+            out.append(f'static const element_descriptor_t {cluster}_{kind.lower()}[] = {{')
+            for name in elements:
+                out.append(f'    {{{cluster}::{kind}::{name}::Id, "{name}"}},')
+            out.append('};')
+
+    out.append('')
+    out.append('const cluster_descriptor_t k_clusters[] = {')
+    for cluster in order:
+        entry = [f'{cluster}::Id', f'"{cluster}"']
+        for kind, elements in clusters[cluster].items():
+            entry.append(f'ELEMENTS({cluster}_{kind.lower()})' if elements else 'NO_ELEMENTS')
+        out.append('    {' + ', '.join(entry) + '},')
+    out.append('};')
+    out.append('const size_t k_cluster_count = sizeof(k_clusters) / sizeof(k_clusters[0]);')
+    out.append(FOOTER)
+    return '\n'.join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the compact data model logger table')
+    parser.add_argument('-i', '--input', default=DEFAULT_INPUT, help='ZAP generated DataModelLogger.cpp')
+    parser.add_argument('-o', '--output', default=DEFAULT_OUTPUT, help='Generated table')
+    args = parser.parse_args()
+
+    clusters, order = parse(args.input)
+    if not order:
+        print(f'No cluster found in {args.input}', file=sys.stderr)
+        return 1
+    with open(args.output, 'w') as f:
+        f.write(generate(clusters, order))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Script to create the payload of a compressed OTA image, for the OTA requestors built with
+CONFIG_ESP_MATTER_OTA_COMPRESSED_IMAGE.
+
+The payload is the esp_matter compressed header followed by the zlib stream of the firmware. Encrypt it with
+esp_enc_img_gen.py for the encrypted OTA, then wrap it in a Matter OTA image with the ota_image_tool.py of the
+connectedhomeip repository, as a full image:
+
+    create_compressed_image.py new.bin compressed.bin
+    ota_image_tool.py create -v <vendor_id> -p <product_id> -vn <version> -vs <version_string> -da sha256 \\
+        compressed.bin compressed.ota
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+import zlib
+
+# Must match esp_matter::ota::compressed_header_t
+HEADER_MAGIC = 0x50495A4D
+HEADER_VERSION = 1
+HEADER_FORMAT = '<IHH32sI'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+
+ESP_IMAGE_MAGIC = 0xE9
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Create the payload of an esp-matter compressed OTA image')
+    parser.add_argument('image', help='Firmware to compress')
+    parser.add_argument('output', help='Payload of the compressed image')
+    args = parser.parse_args()
+
+    with open(args.image, 'rb') as image_file:
+        image = image_file.read()
+    if image[0] != ESP_IMAGE_MAGIC:
+        sys.exit('Not an ESP application image: {}'.format(args.image))
+
+    # The device inflates with a 32 KB window, the largest zlib window
+    compressor = zlib.compressobj(level=9, wbits=15)
+    compressed = compressor.compress(image) + compressor.flush()
+
+    header = struct.pack(HEADER_FORMAT, HEADER_MAGIC, HEADER_VERSION, HEADER_SIZE, hashlib.sha256(image).digest(),
+                         len(image))
+    with open(args.output, 'wb') as output:
+        output.write(header)
+        output.write(compressed)
+    print('Compressed payload of {} bytes, {:.0f}% of the {} bytes image'.format(
+        HEADER_SIZE + len(compressed), 100.0 * (HEADER_SIZE + len(compressed)) / len(image), len(image)))
+
+
+if __name__ == '__main__':
+    main()
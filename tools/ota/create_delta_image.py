@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Script to create the payload of a delta OTA image, for the OTA requestors built with
+CONFIG_ESP_MATTER_OTA_DELTA_IMAGE.
+
+The payload is the esp_matter delta header followed by a detools patch from the base firmware to the new firmware.
+Encrypt it with esp_enc_img_gen.py for the encrypted OTA, then wrap it in a Matter OTA image with the
+ota_image_tool.py of the connectedhomeip repository, as a full image:
+
+    create_delta_image.py base.bin new.bin delta.bin
+    ota_image_tool.py create -v <vendor_id> -p <product_id> -vn <version> -vs <version_string> -da sha256 \\
+        delta.bin delta.ota
+
+Requires detools: pip install detools
+"""
+
+import argparse
+import hashlib
+import io
+import struct
+import sys
+
+try:
+    import detools
+except ImportError:
+    sys.exit('detools is required: pip install detools')
+
+# Must match esp_matter::ota::delta_header_t
+HEADER_MAGIC = 0x4154444D
+HEADER_VERSION = 1
+HEADER_FORMAT = '<IHH32s32sI'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+
+ESP_IMAGE_MAGIC = 0xE9
+# The application description follows the image header (24 bytes) and the header of the first segment (8 bytes)
+APP_DESC_OFFSET = 24 + 8
+APP_DESC_MAGIC = 0xABCD5432
+# Offset of app_elf_sha256 in esp_app_desc_t
+APP_ELF_SHA256_OFFSET = 144
+
+
+def get_elf_sha256(image):
+    if image[0] != ESP_IMAGE_MAGIC:
+        sys.exit('Not an ESP application image')
+    magic, = struct.unpack_from('<I', image, APP_DESC_OFFSET)
+    if magic != APP_DESC_MAGIC:
+        sys.exit('The application description was not found in the image')
+    offset = APP_DESC_OFFSET + APP_ELF_SHA256_OFFSET
+    return image[offset:offset + 32]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Create the payload of an esp-matter delta OTA image')
+    parser.add_argument('base', help='Firmware running on the devices, the patch applies to it')
+    parser.add_argument('new', help='New firmware')
+    parser.add_argument('output', help='Payload of the delta image')
+    args = parser.parse_args()
+
+    with open(args.base, 'rb') as base_file:
+        base = base_file.read()
+    with open(args.new, 'rb') as new_file:
+        new = new_file.read()
+    if new[0] != ESP_IMAGE_MAGIC:
+        sys.exit('Not an ESP application image: {}'.format(args.new))
+
+    # esp_delta_ota applies heatshrink compressed sequential patches
+    patch = io.BytesIO()
+    detools.create_patch(io.BytesIO(base), io.BytesIO(new), patch, compression='heatshrink')
+
+    header = struct.pack(HEADER_FORMAT, HEADER_MAGIC, HEADER_VERSION, HEADER_SIZE, get_elf_sha256(base),
+                         hashlib.sha256(new).digest(), len(new))
+    with open(args.output, 'wb') as output:
+        output.write(header)
+        output.write(patch.getvalue())
+    print('Delta payload of {} bytes, the full image is {} bytes'.format(HEADER_SIZE + len(patch.getvalue()),
+                                                                         len(new)))
+
+
+if __name__ == '__main__':
+    main()
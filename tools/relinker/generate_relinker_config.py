@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Script to generate the relinker configuration from the output of the "matter esp diagnostics pc-profile dump"
+console command.
+
+The samples are attributed to the functions of the profiled firmware with its ELF and linker map files. Starting from
+the hand-maintained configuration (examples/common/relinker/<target>), the hot functions are kept in IRAM up to the
+IRAM budget, the hottest first:
+
+- The functions of an IRAM object of object.csv which the relinker moved to flash are kept in IRAM by a row in
+  function.csv.
+- The other functions in flash, the Matter attribute accessors or the crypto for example, are placed in IRAM by a
+  linker fragment, to add to the LDFRAGMENTS of a component of the application.
+
+All the other functions of the objects of object.csv stay moved to flash by the relinker. The rows of the
+hand-maintained function.csv are kept as they are, since they also keep the functions which must run while the cache
+is disabled, the cold ones are only reported.
+
+Usage: generate_relinker_config.py --elf build/app.elf --map build/app.map --output-dir relinker [log_file], reads
+the standard input if no log file is given.
+"""
+
+import argparse
+import bisect
+import csv
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+SUPPORTED_VERSION = 1
+
+BEGIN_RE = re.compile(r'esp_matter_pc_profile begin version=(\d+) samples=(\d+) dropped=(\d+)')
+SAMPLE_RE = re.compile(r'esp_matter_pc_profile ([0-9a-f]{8}) (\d+)')
+
+# Input section of the linker map, the section name is on its own line when it is long
+SECTION_RE = re.compile(r'^ (\.\S+)?\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+\.a)\((\S+)\)$')
+SECTION_NAME_RE = re.compile(r'^ (\.\S+)$')
+OUTPUT_SECTION_RE = re.compile(r'^(\.\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)')
+
+FLASH_SECTION = '.flash.text'
+IRAM_SECTION = '.iram0.text'
+
+
+def parse_profile(lines):
+    samples = {}
+    total = dropped = None
+    for line in lines:
+        match = BEGIN_RE.search(line)
+        if match:
+            if int(match.group(1)) != SUPPORTED_VERSION:
+                sys.exit('Unsupported profile format version {}'.format(match.group(1)))
+            total, dropped = int(match.group(2)), int(match.group(3))
+            samples = {}
+            continue
+        match = SAMPLE_RE.search(line)
+        if match:
+            samples[int(match.group(1), 16)] = int(match.group(2))
+    if total is None:
+        sys.exit('No PC profile found in the log')
+    return samples, total, dropped
+
+
+def parse_map(path):
+    """Returns the input sections as (start, end, section, library, object) and the output section ranges"""
+    sections = []
+    output_sections = {}
+    pending_name = None
+    with open(path, 'r', errors='replace') as map_file:
+        for line in map_file:
+            line = line.rstrip('\n')
+            match = OUTPUT_SECTION_RE.match(line)
+            if match:
+                start = int(match.group(2), 16)
+                output_sections[match.group(1)] = (start, start + int(match.group(3), 16))
+                continue
+            match = SECTION_NAME_RE.match(line)
+            if match:
+                pending_name = match.group(1)
+                continue
+            match = SECTION_RE.match(line)
+            if match:
+                name = match.group(1) or pending_name
+                start, size = int(match.group(2), 16), int(match.group(3), 16)
+                if name and size:
+                    sections.append((start, start + size, name, os.path.basename(match.group(4)), match.group(5)))
+            pending_name = None
+    sections.sort()
+    return sections, output_sections
+
+
+def parse_symbols(nm, elf):
+    output = subprocess.check_output([nm, '-S', '--defined-only', elf], universal_newlines=True)
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in 'tTwW':
+            symbols.append((int(fields[0], 16), int(fields[1], 16), fields[3]))
+    symbols.sort()
+    return symbols
+
+
+def find(intervals, starts, address):
+    index = bisect.bisect_right(starts, address) - 1
+    if index >= 0 and address < intervals[index][0] + intervals[index][1]:
+        return intervals[index]
+    return None
+
+
+def read_csv(path):
+    with open(path, newline='') as csv_file:
+        return list(csv.reader(csv_file))
+
+
+def object_stem(name):
+    for suffix in ('.c.obj', '.cpp.obj', '.cc.obj', '.S.obj', '.obj', '.o'):
+        if name.endswith(suffix):
+            return name[:-len(suffix)]
+    return name
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the relinker configuration from a PC profile')
+    parser.add_argument('log_file', nargs='?', help='Console log containing the pc-profile dump')
+    parser.add_argument('--elf', required=True, help='ELF file of the profiled firmware')
+    parser.add_argument('--map', required=True, help='Linker map file of the profiled firmware')
+    parser.add_argument('--base-dir', default=os.path.join(os.path.dirname(__file__), '..', '..', 'examples',
+                                                           'common', 'relinker', 'esp32c2'),
+                        help='Hand-maintained relinker configuration, default: examples/common/relinker/esp32c2')
+    parser.add_argument('--output-dir', required=True,
+                        help='Directory of the generated configuration, for '
+                             'CONFIG_CU_RELINKER_CUSTOMIZED_CONFIGURATION_FILES_PATH')
+    parser.add_argument('--nm', default='riscv32-esp-elf-nm', help='nm of the toolchain')
+    parser.add_argument('--iram-budget', type=int, default=4096,
+                        help='Bytes of code kept in IRAM in addition to the base configuration, default: 4096')
+    parser.add_argument('--min-share', type=float, default=0.2,
+                        help='Minimum share of the samples, in percent, of a hot function, default: 0.2')
+    args = parser.parse_args()
+
+    if args.log_file:
+        with open(args.log_file, 'r', errors='replace') as log:
+            samples, total, dropped = parse_profile(log)
+    else:
+        samples, total, dropped = parse_profile(sys.stdin)
+
+    sections, output_sections = parse_map(args.map)
+    section_starts = [section[0] for section in sections]
+    section_intervals = [(start, end - start, name, library, obj) for start, end, name, library, obj in sections]
+    symbols = parse_symbols(args.nm, args.elf)
+    symbol_starts = [symbol[0] for symbol in symbols]
+    flash = output_sections.get(FLASH_SECTION, (0, 0))
+    iram = output_sections.get(IRAM_SECTION, (0, 0))
+
+    # Samples per function
+    functions = {}
+    unresolved = 0
+    for pc, count in samples.items():
+        symbol = find(symbols, symbol_starts, pc)
+        if not symbol:
+            unresolved += count
+            continue
+        entry = functions.setdefault(symbol[2], {'address': symbol[0], 'size': symbol[1], 'samples': 0})
+        entry['samples'] += count
+
+    print('# {} samples, {} dropped by the firmware, {} outside of the functions'.format(total, dropped, unresolved))
+    if dropped:
+        print('# Increase CONFIG_ESP_MATTER_CONSOLE_PC_PROFILER_TABLE_SIZE to count the dropped samples')
+
+    base_objects = {(row[0], row[1]) for row in read_csv(os.path.join(args.base_dir, 'object.csv'))[1:]}
+    function_rows = read_csv(os.path.join(args.base_dir, 'function.csv'))
+    base_functions = {(row[0], row[1], row[2]): row for row in function_rows[1:]}
+
+    hot = [(name, entry) for name, entry in functions.items()
+           if entry['samples'] * 100.0 >= args.min_share * total and flash[0] <= entry['address'] < flash[1]]
+    hot.sort(key=lambda item: item[1]['samples'], reverse=True)
+
+    budget = args.iram_budget
+    fragments = {}
+    for name, entry in hot:
+        section = find(section_intervals, section_starts, entry['address'])
+        if not section:
+            continue
+        _, _, section_name, library, obj = section
+        if entry['size'] > budget:
+            print('# {} ({} samples, {} bytes) exceeds the remaining IRAM budget'.format(name, entry['samples'],
+                                                                                        entry['size']))
+            continue
+        key = (library, obj, name)
+        if (library, obj) in base_objects and (section_name.startswith('.iram') or key in base_functions):
+            # IRAM code which the relinker moved to flash
+            if key in base_functions:
+                base_functions[key][3] = ''
+            else:
+                row = [library, obj, name, '']
+                base_functions[key] = row
+                function_rows.append(row)
+        elif section_name == '.text.' + name:
+            fragments.setdefault(library, []).append('{}:{}'.format(object_stem(obj), name))
+        else:
+            continue
+        budget -= entry['size']
+        print('hot\t{}\t{}\t{}\t{}'.format(entry['samples'], entry['size'], library, name))
+
+    # Not moved, they may have to run while the cache is disabled
+    addresses = {symbol[2]: symbol[0] for symbol in symbols}
+    for key, row in sorted(base_functions.items()):
+        if row[3] == '' and key[2] not in functions and iram[0] <= addresses.get(key[2], -1) < iram[1]:
+            print('cold\t0\t{}\t{}'.format(key[0], key[2]))
+
+    if not os.path.isdir(args.output_dir):
+        os.makedirs(args.output_dir)
+    for name in ('library.csv', 'object.csv'):
+        shutil.copyfile(os.path.join(args.base_dir, name), os.path.join(args.output_dir, name))
+    with open(os.path.join(args.output_dir, 'function.csv'), 'w', newline='') as csv_file:
+        csv.writer(csv_file, lineterminator='\n').writerows(function_rows)
+    with open(os.path.join(args.output_dir, 'relinker_hot.lf'), 'w') as lf_file:
+        lf_file.write('# Generated by tools/relinker/generate_relinker_config.py, hot functions placed in IRAM\n')
+        for library, entries in sorted(fragments.items()):
+            lf_file.write('\n[mapping:hot_{}]\narchive: {}\nentries:\n'.format(
+                re.sub(r'\W', '_', library[:-2]), library))
+            for entity in entries:
+                lf_file.write('    {} (noflash)\n'.format(entity))
+    print('# {} of {} bytes of the IRAM budget used, configuration written to {}'.format(
+        args.iram_budget - budget, args.iram_budget, args.output_dir))
+
+
+if __name__ == '__main__':
+    main()
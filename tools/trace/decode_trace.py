@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 Espressif Systems (Shanghai) PTE LTD
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Script to decode the output of the "matter esp trace dump" console command.
+
+Usage: decode_trace.py [log_file], reads the standard input if no file is given.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SUPPORTED_VERSION = 1
+
+# Must match esp_matter::trace::record_t
+RECORD_FORMAT = '<IIIHBB'
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+EVENTS = {
+    1: 'attribute_read',
+    2: 'attribute_write',
+    3: 'attribute_update',
+    4: 'attribute_report',
+    5: 'command',
+}
+
+BEGIN_RE = re.compile(r'esp_matter_trace begin version=(\d+) count=(\d+) total=(\d+)')
+RECORD_RE = re.compile(r'esp_matter_trace ([0-9a-f]{%d})' % (RECORD_SIZE * 2))
+
+
+def decode(lines):
+    records = []
+    for line in lines:
+        match = BEGIN_RE.search(line)
+        if match:
+            version = int(match.group(1))
+            if version != SUPPORTED_VERSION:
+                sys.exit('Unsupported trace format version {}'.format(version))
+            dropped = int(match.group(3)) - int(match.group(2))
+            if dropped > 0:
+                print('# {} older records were overwritten'.format(dropped))
+            records = []
+            continue
+        match = RECORD_RE.search(line)
+        if match:
+            records.append(struct.unpack(RECORD_FORMAT, bytes.fromhex(match.group(1))))
+    return records
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the esp-matter binary trace dump')
+    parser.add_argument('log_file', nargs='?', help='Console log containing the trace dump')
+    args = parser.parse_args()
+
+    if args.log_file:
+        with open(args.log_file, 'r', errors='replace') as log:
+            records = decode(log)
+    else:
+        records = decode(sys.stdin)
+
+    if not records:
+        return
+    # The timestamps are the lower 32 bits of esp_timer, unwrap them relative to the first record
+    first_timestamp = records[0][0]
+    previous = first_timestamp
+    offset = 0
+    for timestamp, cluster_id, element_id, endpoint_id, event, status in records:
+        if timestamp < previous:
+            offset += 1 << 32
+        previous = timestamp
+        relative_us = timestamp + offset - first_timestamp
+        print('{:>12.6f}s {:<17} endpoint 0x{:04x} cluster 0x{:08x} {} 0x{:08x} status 0x{:02x}'.format(
+            relative_us / 1e6, EVENTS.get(event, 'unknown({})'.format(event)), endpoint_id, cluster_id,
+            'command' if event == 5 else 'attribute', element_id, status))
+
+
+if __name__ == '__main__':
+    main()